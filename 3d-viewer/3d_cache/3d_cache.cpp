@@ -25,7 +25,10 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <chrono>
+#include <future>
 #include <mutex>
+#include <thread>
 #include <utility>
 
 #include <wx/datetime.h>
@@ -49,6 +52,7 @@
 
 #include <advanced_config.h>
 #include <common.h>     // For ExpandEnvVarSubstitutions
+#include <core/thread_pool.h>
 #include <filename_resolver.h>
 #include <paths.h>
 #include <pgm_base.h>
@@ -56,6 +60,7 @@
 #include <settings/common_settings.h>
 #include <settings/settings_manager.h>
 #include <wx_filename.h>
+#include <kiplatform/io.h>
 
 
 #define MASK_3D_CACHE "3D_CACHE"
@@ -135,6 +140,9 @@ public:
     SCENEGRAPH*   sceneData;
     S3DMODEL*     renderData;
 
+    /// Held while the entry is loaded, so that each model is loaded by a single thread
+    std::mutex    loadLock;
+
 private:
     // prohibit assignment and default copy constructor
     S3D_CACHE_ENTRY( const S3D_CACHE_ENTRY& source );
@@ -218,57 +226,76 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, const wxString& aBasePa
     }
 
     // check cache if file is already loaded
-    std::lock_guard<std::mutex> lock( mutex3D_cache );
-
-    std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString >::iterator mi;
-    mi = m_CacheMap.find( full3Dpath );
+    S3D_CACHE_ENTRY* ep = nullptr;
+    bool             created = false;
 
-    if( mi != m_CacheMap.end() )
     {
-        wxFileName fname( full3Dpath );
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
 
-        if( fname.FileExists() )    // Only check if file exists. If not, it will
-        {                           // use the same model in cache.
-            bool       reload = ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache;
-            wxDateTime fmdate = fname.GetModificationTime();
+        std::map< wxString, S3D_CACHE_ENTRY*, rsort_wxString >::iterator mi;
+        mi = m_CacheMap.find( full3Dpath );
 
-            if( fmdate != mi->second->modTime )
-            {
-                unsigned char hashSum[20];
-                getSHA1( full3Dpath, hashSum );
-                mi->second->modTime = fmdate;
+        if( mi != m_CacheMap.end() )
+        {
+            ep = mi->second;
+        }
+        else
+        {
+            ep = new S3D_CACHE_ENTRY;
+            m_CacheList.push_back( ep );
+            m_CacheMap.emplace( full3Dpath, ep );
+            created = true;
+        }
+    }
 
-                if( !isSHA1Same( hashSum, mi->second->sha1sum ) )
-                {
-                    mi->second->SetSHA1( hashSum );
-                    reload = true;
-                }
-            }
+    // The cache lock is not held while the model loads, so that other models can be loaded
+    // at the same time; a thread asking for this model waits for it here
+    std::lock_guard<std::mutex> entryLock( ep->loadLock );
 
-            if( reload )
-            {
-                if( nullptr != mi->second->sceneData )
-                {
-                    S3D::DestroyNode( mi->second->sceneData );
-                    mi->second->sceneData = nullptr;
-                }
+    if( nullptr != aCachePtr )
+        *aCachePtr = ep;
+
+    // a cache item did not exist; search the Filename->Cachename map
+    if( created )
+        return checkCache( full3Dpath, ep );
+
+    wxFileName fname( full3Dpath );
 
-                if( nullptr != mi->second->renderData )
-                    S3D::Destroy3DModel( &mi->second->renderData );
+    if( fname.FileExists() )    // Only check if file exists. If not, it will
+    {                           // use the same model in cache.
+        bool       reload = ADVANCED_CFG::GetCfg().m_Skip3DModelMemoryCache;
+        wxDateTime fmdate = fname.GetModificationTime();
+
+        if( fmdate != ep->modTime )
+        {
+            unsigned char hashSum[20];
+            getSHA1( full3Dpath, hashSum );
+            ep->modTime = fmdate;
 
-                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
-                                                                mi->second->pluginInfo );
+            if( !isSHA1Same( hashSum, ep->sha1sum ) )
+            {
+                ep->SetSHA1( hashSum );
+                reload = true;
             }
         }
 
-        if( nullptr != aCachePtr )
-            *aCachePtr = mi->second;
+        if( reload )
+        {
+            if( nullptr != ep->sceneData )
+            {
+                S3D::DestroyNode( ep->sceneData );
+                ep->sceneData = nullptr;
+            }
+
+            if( nullptr != ep->renderData )
+                S3D::Destroy3DModel( &ep->renderData );
 
-        return mi->second->sceneData;
+            std::lock_guard<std::mutex> pluginLock( m_pluginLock );
+            ep->sceneData = m_Plugins->Load3DModel( full3Dpath, ep->pluginInfo );
+        }
     }
 
-    // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return ep->sceneData;
 }
 
 
@@ -278,70 +305,38 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile, const wxString& aBasePa
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aEntry )
 {
-    if( aCachePtr )
-        *aCachePtr = nullptr;
-
-    unsigned char    sha1sum[20];
-    S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-    m_CacheList.push_back( ep );
-    wxFileName fname( aFileName );
-    ep->modTime = fname.GetModificationTime();
+    unsigned char sha1sum[20];
+    wxFileName    fname( aFileName );
+    aEntry->modTime = fname.GetModificationTime();
 
     if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
     {
         // just in case we can't get a hash digest (for example, on access issues)
-        // or we do not have a configured cache file directory, we create an
+        // or we do not have a configured cache file directory, we keep the empty
         // entry to prevent further attempts at loading the file
-
-        if( m_CacheMap.emplace( aFileName, ep ).second == false )
-        {
-            wxLogTrace( MASK_3D_CACHE,
-                        wxT( "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'" ),
-                        __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-            m_CacheList.pop_back();
-            delete ep;
-        }
-        else
-        {
-            if( aCachePtr )
-                *aCachePtr = ep;
-        }
-
-        return nullptr;
-    }
-
-    if( m_CacheMap.emplace( aFileName, ep ).second == false )
-    {
-        wxLogTrace( MASK_3D_CACHE,
-                    wxT( "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'" ),
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-        m_CacheList.pop_back();
-        delete ep;
         return nullptr;
     }
 
-    if( aCachePtr )
-        *aCachePtr = ep;
-
-    ep->SetSHA1( sha1sum );
+    aEntry->SetSHA1( sha1sum );
 
-    wxString bname = ep->GetCacheBaseName();
+    wxString bname = aEntry->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
     if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && wxFileName::FileExists( cachename )
-        && loadCacheData( ep ) )
-        return ep->sceneData;
+        && loadCacheData( aEntry ) )
+        return aEntry->sceneData;
 
-    ep->sceneData = m_Plugins->Load3DModel( aFileName, ep->pluginInfo );
+    // The plugins are not reentrant, and writing a cache file renumbers the scene graph nodes
+    std::lock_guard<std::mutex> pluginLock( m_pluginLock );
 
-    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != ep->sceneData )
-        saveCacheData( ep );
+    aEntry->sceneData = m_Plugins->Load3DModel( aFileName, aEntry->pluginInfo );
 
-    return ep->sceneData;
+    if( !ADVANCED_CFG::GetCfg().m_Skip3DModelFileCache && nullptr != aEntry->sceneData )
+        saveCacheData( aEntry );
+
+    return aEntry->sceneData;
 }
 
 
@@ -432,7 +427,20 @@ bool S3D_CACHE::loadCacheData( S3D_CACHE_ENTRY* aCacheItem )
     if( nullptr != aCacheItem->sceneData )
         S3D::DestroyNode( (SGNODE*) aCacheItem->sceneData );
 
-    aCacheItem->sceneData = (SCENEGRAPH*)S3D::ReadCache( fname.ToUTF8(), m_Plugins, checkTag );
+    KIPLATFORM::IO::MAPPED_FILE mapped;
+
+    if( KIPLATFORM::IO::MapFile( fname, mapped ) )
+    {
+        aCacheItem->sceneData = (SCENEGRAPH*) S3D::ReadCache( mapped.m_data, mapped.m_size,
+                                                              fname.ToUTF8(), m_Plugins,
+                                                              checkTag );
+        KIPLATFORM::IO::UnmapFile( mapped );
+    }
+    else
+    {
+        aCacheItem->sceneData = (SCENEGRAPH*) S3D::ReadCache( fname.ToUTF8(), m_Plugins,
+                                                              checkTag );
+    }
 
     if( nullptr == aCacheItem->sceneData )
         return false;
@@ -648,21 +656,69 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName, const wxString& a
         return nullptr;
     }
 
+    std::lock_guard<std::mutex> entryLock( cp->loadLock );
+
     if( cp->renderData )
         return cp->renderData;
 
-    S3DMODEL* mp = S3D::GetModel( sp );
+    S3DMODEL* mp = S3D::GetModel( cp->sceneData );
     cp->renderData = mp;
 
     return mp;
 }
 
+
+void S3D_CACHE::PreloadModels( const std::vector<std::pair<wxString, wxString>>& aModels,
+                               const std::function<void( size_t, S3DMODEL* )>& aOnLoaded )
+{
+    thread_pool&                        tp = GetKiCadThreadPool();
+    std::vector<std::future<S3DMODEL*>> returns;
+
+    returns.reserve( aModels.size() );
+
+    for( const std::pair<wxString, wxString>& model : aModels )
+    {
+        returns.emplace_back( tp.submit(
+                [this, &model]()
+                {
+                    return GetModel( model.first, model.second );
+                } ) );
+    }
+
+    // Hand the models over as they finish, so that the caller can use them while the others
+    // are still loading
+    std::vector<bool> done( returns.size(), false );
+    size_t            remaining = returns.size();
+
+    while( remaining > 0 )
+    {
+        for( size_t ii = 0; ii < returns.size(); ++ii )
+        {
+            if( done[ii]
+                    || returns[ii].wait_for( std::chrono::seconds( 0 ) )
+                               != std::future_status::ready )
+            {
+                continue;
+            }
+
+            done[ii] = true;
+            --remaining;
+
+            S3DMODEL* model = returns[ii].get();
+
+            if( aOnLoaded )
+                aOnLoaded( ii, model );
+        }
+
+        if( remaining > 0 )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    }
+}
+
 void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
 {
     wxDir         dir;
-    wxString      fileSpec = wxT( "*.3dc" );
-    wxArrayString fileList; // Holds list of ".3dc" files found in cache directory
-    size_t        numFilesFound = 0;
+    wxArrayString fileList; // Holds list of cache files found in cache directory
 
     wxFileName thisFile;
     wxDateTime lastAccess, thresholdDate;
@@ -677,10 +733,12 @@ void S3D_CACHE::CleanCacheDir( int aNumDaysOld )
     {
         thisFile.SetPath( m_CacheDir ); // Set the base path to the cache folder
 
-        // Get a list of all the ".3dc" files in the cache directory
-        numFilesFound = dir.GetAllFiles( m_CacheDir, &fileList, fileSpec );
+        // Get a list of all the ".3dc" files in the cache directory, and of the ".xbf" models
+        // cached by the STEP exporter
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.3dc" ) );
+        dir.GetAllFiles( m_CacheDir, &fileList, wxT( "*.xbf" ) );
 
-        for( unsigned int i = 0; i < numFilesFound; i++ )
+        for( unsigned int i = 0; i < fileList.size(); i++ )
         {
             // Completes path to specific file so we can get its "last access" date
             thisFile.SetFullName( fileList[i] );
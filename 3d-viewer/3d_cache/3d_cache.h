@@ -32,8 +32,12 @@
 #include "3d_info.h"
 #include <core/typeinfo.h>
 #include "string_utils.h"
+#include <functional>
 #include <list>
 #include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -127,6 +131,24 @@ public:
      */
     S3DMODEL* GetModel( const wxString& aModelFileName, const wxString& aBasePath );
 
+    /**
+     * Load several models at once, each one by a single thread of the KiCad thread pool.
+     *
+     * The calling thread waits for the models and calls \a aOnLoaded for each one as soon as
+     * it is ready, so the models can be used while the others are still loading.  GetModel()
+     * then returns the models without loading them again.
+     *
+     * Must not be called from a thread pool task, nor while the cache is being flushed.
+     *
+     * @param aModels are the partial or full paths of the models, with the path to search for
+     *                any relative files.
+     * @param aOnLoaded is called on the calling thread, in the order the models finish, with the
+     *                  index of a model in \a aModels and its render data (NULL if the model
+     *                  could not be loaded).
+     */
+    void PreloadModels( const std::vector<std::pair<wxString, wxString>>& aModels,
+                        const std::function<void( size_t aIndex, S3DMODEL* aModel )>& aOnLoaded );
+
     /**
      * Delete up old cache files in cache directory.
      *
@@ -138,16 +160,16 @@ public:
 
 private:
     /**
-     * Find or create cache entry for file name
+     * Fill a new cache entry for file name
      *
-     * Searches the cache list for the given filename and retrieves the cache data; a cache
-     * entry is created if one does not already exist.
+     * Retrieves the cache data of the given filename from its cache file, or loads it through
+     * the plugins and writes the cache file.
      *
-     * @param aFileName  is the file name (full or partial path).
-     * @param aCachePtr is an optional return address for cache entry pointer.
+     * @param aFileName  is the file name (full path).
+     * @param aEntry is the new cache entry of the file, locked by the caller.
      * @return SCENEGRAPH object associated with file name or NULL on error.
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = nullptr );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY* aEntry );
 
     /**
      * Calculate the SHA1 hash of the given file.
@@ -177,6 +199,9 @@ private:
 
     S3D_PLUGIN_MANAGER* m_Plugins;
 
+    /// Serializes the calls to the plugins, which are not reentrant
+    std::mutex          m_pluginLock;
+
     PROJECT*            m_project;
     wxString            m_CacheDir;
     wxString            m_ConfigDir;       /// base configuration path for 3D items
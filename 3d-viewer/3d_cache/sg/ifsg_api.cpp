@@ -39,7 +39,8 @@
 
 
 // version format of the cache file
-#define SG_VERSION_TAG "VERSION:2"
+// VERSION:3 writes single precision points, quantized normals and delta coded indices
+#define SG_VERSION_TAG "VERSION:3"
 
 
 static void formatMaterial( SMATERIAL& mat, SGAPPEARANCE const* app )
@@ -218,33 +219,36 @@ bool S3D::WriteCache( const char* aFileName, bool overwrite, SGNODE* aNode,
 }
 
 
-SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
-                        bool (*aTagCheck)( const char*, void* ) )
+/**
+ * A read only stream buffer over a block of memory, to parse cache files mapped in memory
+ * with the same code as the files read through a stream.
+ */
+class MEMORY_STREAMBUF : public std::streambuf
 {
-    if( nullptr == aFileName || aFileName[0] == 0 )
-        return nullptr;
-
-    wxString ofile = wxString::FromUTF8Unchecked( aFileName );
-
-    if( !wxFileName::FileExists( aFileName ) )
+public:
+    MEMORY_STREAMBUF( const char* aData, size_t aSize )
     {
-        wxLogTrace( MASK_3D_SG, wxT( "%s:%s:%d * [INFO] no such file '%s'" ),
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-        return nullptr;
+        char* data = const_cast<char*>( aData );
+        setg( data, data, data + aSize );
     }
 
-    std::unique_ptr<SGNODE> np = std::make_unique<SCENEGRAPH>( nullptr );
-
-    OPEN_ISTREAM( file, aFileName );
-
-    if( file.fail() )
+protected:
+    // Only reports the position, for the error messages
+    pos_type seekoff( off_type aOff, std::ios_base::seekdir aDir,
+                      std::ios_base::openmode aWhich ) override
     {
-        wxLogTrace( MASK_3D_SG, wxT( "%s:%s:%d * [INFO] failed to open file '%s'" ),
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
+        if( aDir != std::ios_base::cur || aOff != 0 || !( aWhich & std::ios_base::in ) )
+            return pos_type( off_type( -1 ) );
 
-        return nullptr;
+        return pos_type( gptr() - eback() );
     }
+};
+
+
+static SGNODE* readCache( std::istream& file, const char* aName, void* aPluginMgr,
+                          bool (*aTagCheck)( const char*, void* ) )
+{
+    std::unique_ptr<SGNODE> np = std::make_unique<SCENEGRAPH>( nullptr );
 
     // from SG_VERSION_TAG 1, read the version tag; if it's not the expected tag
     // then we fail to read the cache file
@@ -261,7 +265,6 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
                         __FILE__, __FUNCTION__, __LINE__,
                         static_cast<int>( file.tellg() ) );
 
-            CLOSE_STREAM( file );
             return nullptr;
         }
 
@@ -275,7 +278,6 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
 
         if( name.compare( SG_VERSION_TAG ) )
         {
-            CLOSE_STREAM( file );
             return nullptr;
         }
 
@@ -296,7 +298,6 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
                         __FILE__, __FUNCTION__, __LINE__,
                         static_cast<int>( file.tellg() ) );
 
-            CLOSE_STREAM( file );
             return nullptr;
         }
 
@@ -312,21 +313,19 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
         if( nullptr != aTagCheck && nullptr != aPluginMgr
           && !aTagCheck( name.c_str(), aPluginMgr ) )
         {
-            CLOSE_STREAM( file );
             return nullptr;
         }
 
     } while( 0 );
 
     bool rval = np->ReadCache( file, nullptr );
-    CLOSE_STREAM( file );
 
     if( !rval )
     {
         wxLogTrace( MASK_3D_SG, wxT( "%s:%s:%d * [INFO] problems encountered reading cache file "
                                      "'%s'" ),
                     __FILE__, __FUNCTION__, __LINE__,
-                    aFileName );
+                    aName );
 
         return nullptr;
     }
@@ -335,6 +334,52 @@ SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
 }
 
 
+SGNODE* S3D::ReadCache( const char* aFileName, void* aPluginMgr,
+                        bool (*aTagCheck)( const char*, void* ) )
+{
+    if( nullptr == aFileName || aFileName[0] == 0 )
+        return nullptr;
+
+    wxString ofile = wxString::FromUTF8Unchecked( aFileName );
+
+    if( !wxFileName::FileExists( aFileName ) )
+    {
+        wxLogTrace( MASK_3D_SG, wxT( "%s:%s:%d * [INFO] no such file '%s'" ),
+                    __FILE__, __FUNCTION__, __LINE__, aFileName );
+
+        return nullptr;
+    }
+
+    OPEN_ISTREAM( file, aFileName );
+
+    if( file.fail() )
+    {
+        wxLogTrace( MASK_3D_SG, wxT( "%s:%s:%d * [INFO] failed to open file '%s'" ),
+                    __FILE__, __FUNCTION__, __LINE__, aFileName );
+
+        return nullptr;
+    }
+
+    SGNODE* np = readCache( file, aFileName, aPluginMgr, aTagCheck );
+    CLOSE_STREAM( file );
+
+    return np;
+}
+
+
+SGNODE* S3D::ReadCache( const char* aData, size_t aSize, const char* aName, void* aPluginMgr,
+                        bool (*aTagCheck)( const char*, void* ) )
+{
+    if( nullptr == aData || 0 == aSize )
+        return nullptr;
+
+    MEMORY_STREAMBUF buf( aData, aSize );
+    std::istream     file( &buf );
+
+    return readCache( file, aName, aPluginMgr, aTagCheck );
+}
+
+
 S3DMODEL* S3D::GetModel( SCENEGRAPH* aNode )
 {
     if( nullptr == aNode )
@@ -269,13 +269,8 @@ bool SGCOORDS::WriteCache( std::ostream& aFile, SGNODE* parentNode )
     }
 
     aFile << "[" << GetName() << "]";
-    size_t npts = coords.size();
-    aFile.write( (char*)&npts, sizeof(size_t) );
 
-    for( size_t i = 0; i < npts; ++i )
-        S3D::WritePoint( aFile, coords[i] );
-
-    if( aFile.fail() )
+    if( !S3D::WritePoints( aFile, coords ) )
         return false;
 
     m_written = true;
@@ -287,22 +282,7 @@ bool SGCOORDS::ReadCache( std::istream& aFile, SGNODE* parentNode )
 {
     wxCHECK( coords.empty(), false );
 
-    size_t npts;
-    aFile.read( (char*) &npts, sizeof( size_t ) );
-    SGPOINT tmp;
-
-    if( aFile.fail() )
-        return false;
-
-    for( size_t i = 0; i < npts; ++i )
-    {
-        if( !S3D::ReadPoint( aFile, tmp ) || aFile.fail() )
-            return false;
-
-        coords.push_back( tmp );
-    }
-
-    return true;
+    return S3D::ReadPoints( aFile, coords );
 }
 
 
@@ -23,6 +23,9 @@
  */
 
 
+#include <climits>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -264,6 +267,85 @@ S3D::SGTYPES S3D::ReadTag( std::istream& aFile, std::string& aName )
 }
 
 
+// The lists are read by blocks, so that a corrupt count fails at the end of the file rather than
+// allocating a huge list
+static const size_t CACHE_BLOCK_SIZE = 65536;
+
+
+bool S3D::WritePoints( std::ostream& aFile, const std::vector<SGPOINT>& aPoints )
+{
+    uint32_t           npts = static_cast<uint32_t>( aPoints.size() );
+    std::vector<float> data;
+
+    data.reserve( 3 * aPoints.size() );
+
+    for( const SGPOINT& pt : aPoints )
+    {
+        data.push_back( static_cast<float>( pt.x ) );
+        data.push_back( static_cast<float>( pt.y ) );
+        data.push_back( static_cast<float>( pt.z ) );
+    }
+
+    aFile.write( (char*) &npts, sizeof( npts ) );
+    aFile.write( (char*) data.data(), data.size() * sizeof( float ) );
+
+    return !aFile.fail();
+}
+
+
+bool S3D::WriteNormals( std::ostream& aFile, const std::vector<SGVECTOR>& aNormals )
+{
+    uint32_t             npts = static_cast<uint32_t>( aNormals.size() );
+    std::vector<int16_t> data;
+
+    data.reserve( 3 * aNormals.size() );
+
+    for( const SGVECTOR& norm : aNormals )
+    {
+        double x, y, z;
+        norm.GetVector( x, y, z );
+
+        for( double v : { x, y, z } )
+            data.push_back( static_cast<int16_t>( std::lround( std::clamp( v, -1.0, 1.0 )
+                                                               * INT16_MAX ) ) );
+    }
+
+    aFile.write( (char*) &npts, sizeof( npts ) );
+    aFile.write( (char*) data.data(), data.size() * sizeof( int16_t ) );
+
+    return !aFile.fail();
+}
+
+
+bool S3D::WriteIndices( std::ostream& aFile, const std::vector<int>& aIndices )
+{
+    uint32_t    count = static_cast<uint32_t>( aIndices.size() );
+    std::string data;
+    int64_t     prev = 0;
+
+    // The indices of a face are close to each other, so most differences fit in a byte
+    for( int idx : aIndices )
+    {
+        int64_t  delta = idx - prev;
+        uint64_t value = ( static_cast<uint64_t>( delta ) << 1 ) ^ ( delta < 0 ? ~0ULL : 0ULL );
+
+        while( value >= 0x80 )
+        {
+            data.push_back( static_cast<char>( ( value & 0x7F ) | 0x80 ) );
+            value >>= 7;
+        }
+
+        data.push_back( static_cast<char>( value ) );
+        prev = idx;
+    }
+
+    aFile.write( (char*) &count, sizeof( count ) );
+    aFile.write( data.data(), data.size() );
+
+    return !aFile.fail();
+}
+
+
 bool S3D::ReadPoint( std::istream& aFile, SGPOINT& aPoint )
 {
     aFile.read( (char*) &aPoint.x, sizeof( aPoint.x ) );
@@ -292,6 +374,114 @@ bool S3D::ReadVector( std::istream& aFile, SGVECTOR& aVector )
 }
 
 
+bool S3D::ReadPoints( std::istream& aFile, std::vector<SGPOINT>& aPoints )
+{
+    uint32_t npts = 0;
+    aFile.read( (char*) &npts, sizeof( npts ) );
+
+    if( aFile.fail() )
+        return false;
+
+    std::vector<float> data;
+
+    for( size_t done = 0; done < npts; )
+    {
+        size_t block = std::min<size_t>( npts - done, CACHE_BLOCK_SIZE );
+
+        data.resize( 3 * block );
+        aFile.read( (char*) data.data(), data.size() * sizeof( float ) );
+
+        if( aFile.fail() )
+            return false;
+
+        for( size_t i = 0; i < block; ++i )
+            aPoints.emplace_back( data[3 * i], data[3 * i + 1], data[3 * i + 2] );
+
+        done += block;
+    }
+
+    return true;
+}
+
+
+bool S3D::ReadNormals( std::istream& aFile, std::vector<SGVECTOR>& aNormals )
+{
+    uint32_t npts = 0;
+    aFile.read( (char*) &npts, sizeof( npts ) );
+
+    if( aFile.fail() )
+        return false;
+
+    std::vector<int16_t> data;
+
+    for( size_t done = 0; done < npts; )
+    {
+        size_t block = std::min<size_t>( npts - done, CACHE_BLOCK_SIZE );
+
+        data.resize( 3 * block );
+        aFile.read( (char*) data.data(), data.size() * sizeof( int16_t ) );
+
+        if( aFile.fail() )
+            return false;
+
+        // SGVECTOR normalizes the vector again
+        for( size_t i = 0; i < block; ++i )
+        {
+            aNormals.emplace_back( data[3 * i] / double( INT16_MAX ),
+                                   data[3 * i + 1] / double( INT16_MAX ),
+                                   data[3 * i + 2] / double( INT16_MAX ) );
+        }
+
+        done += block;
+    }
+
+    return true;
+}
+
+
+bool S3D::ReadIndices( std::istream& aFile, std::vector<int>& aIndices )
+{
+    uint32_t count = 0;
+    aFile.read( (char*) &count, sizeof( count ) );
+
+    if( aFile.fail() )
+        return false;
+
+    aIndices.reserve( std::min<size_t>( count, CACHE_BLOCK_SIZE ) );
+
+    int64_t prev = 0;
+
+    for( uint32_t i = 0; i < count; ++i )
+    {
+        uint64_t value = 0;
+        int      shift = 0;
+        int      byte;
+
+        do
+        {
+            byte = aFile.get();
+
+            if( byte == std::char_traits<char>::eof() || shift > 35 )
+                return false;
+
+            value |= static_cast<uint64_t>( byte & 0x7F ) << shift;
+            shift += 7;
+        } while( byte & 0x80 );
+
+        int64_t delta = static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
+        int64_t idx = prev + delta;
+
+        if( idx < INT_MIN || idx > INT_MAX )
+            return false;
+
+        aIndices.push_back( static_cast<int>( idx ) );
+        prev = idx;
+    }
+
+    return true;
+}
+
+
 bool S3D::ReadColor( std::istream& aFile, SGCOLOR& aColor )
 {
     float r, g, b;
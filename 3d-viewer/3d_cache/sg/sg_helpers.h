@@ -250,6 +250,15 @@ namespace S3D
     // write out an RGB color
     bool WriteColor( std::ostream& aFile, const SGCOLOR& aColor );
 
+    // write out a list of XYZ vertices as single precision floats, the precision of the renderers
+    bool WritePoints( std::ostream& aFile, const std::vector<SGPOINT>& aPoints );
+
+    // write out a list of unit vectors with their components quantized to 16 bits
+    bool WriteNormals( std::ostream& aFile, const std::vector<SGVECTOR>& aNormals );
+
+    // write out a list of indices as variable length differences from the previous index
+    bool WriteIndices( std::ostream& aFile, const std::vector<int>& aIndices );
+
     /**
      * Read the text tag of a binary cache file which is the NodeTag and unique ID number combined.
      *
@@ -268,6 +277,15 @@ namespace S3D
 
     // read an RGB color
     bool ReadColor( std::istream& aFile, SGCOLOR& aColor );
+
+    // read a list of XYZ vertices written by WritePoints()
+    bool ReadPoints( std::istream& aFile, std::vector<SGPOINT>& aPoints );
+
+    // read a list of unit vectors written by WriteNormals()
+    bool ReadNormals( std::istream& aFile, std::vector<SGVECTOR>& aNormals );
+
+    // read a list of indices written by WriteIndices()
+    bool ReadIndices( std::istream& aFile, std::vector<int>& aIndices );
 }
 
 #endif  // SG_HELPERS_H
@@ -27,6 +27,7 @@
 #include <wx/log.h>
 
 #include "3d_cache/sg/sg_index.h"
+#include "3d_cache/sg/sg_helpers.h"
 
 
 SGINDEX::SGINDEX( SGNODE* aParent ) : SGNODE( aParent )
@@ -290,13 +291,8 @@ bool SGINDEX::WriteCache( std::ostream& aFile, SGNODE* parentNode )
     }
 
     aFile << "[" << GetName() << "]";
-    size_t npts = index.size();
-    aFile.write( (char*)&npts, sizeof(size_t) );
 
-    for( size_t i = 0; i < npts; ++i )
-        aFile.write( (char*)&index[i], sizeof(int) );
-
-    if( aFile.fail() )
+    if( !S3D::WriteIndices( aFile, index ) )
         return false;
 
     m_written = true;
@@ -308,22 +304,5 @@ bool SGINDEX::ReadCache( std::istream& aFile, SGNODE* parentNode )
 {
     wxCHECK( index.empty(), false );
 
-    size_t npts;
-    aFile.read( (char*)&npts, sizeof(size_t) );
-    int tmp;
-
-    if( aFile.fail() )
-        return false;
-
-    for( size_t i = 0; i < npts; ++i )
-    {
-        aFile.read( (char*) &tmp, sizeof( int ) );
-
-        if( aFile.fail() )
-            return false;
-
-        index.push_back( tmp );
-    }
-
-    return true;
+    return S3D::ReadIndices( aFile, index );
 }
@@ -262,13 +262,8 @@ bool SGNORMALS::WriteCache( std::ostream& aFile, SGNODE* parentNode )
     }
 
     aFile << "[" << GetName() << "]";
-    size_t npts = norms.size();
-    aFile.write( (char*)&npts, sizeof(size_t) );
 
-    for( size_t i = 0; i < npts; ++i )
-        S3D::WriteVector( aFile, norms[i] );
-
-    if( aFile.fail() )
+    if( !S3D::WriteNormals( aFile, norms ) )
         return false;
 
     m_written = true;
@@ -280,20 +275,5 @@ bool SGNORMALS::ReadCache( std::istream& aFile, SGNODE* parentNode )
 {
     wxCHECK( norms.empty(), false );
 
-    size_t npts;
-    aFile.read( (char*) &npts, sizeof( size_t ) );
-    SGVECTOR tmp;
-
-    if( aFile.fail() )
-        return false;
-
-    for( size_t i = 0; i < npts; ++i )
-    {
-        if( !S3D::ReadVector( aFile, tmp ) || aFile.fail() )
-            return false;
-
-        norms.push_back( tmp );
-    }
-
-    return true;
+    return S3D::ReadNormals( aFile, norms );
 }
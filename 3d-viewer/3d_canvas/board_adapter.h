@@ -343,6 +343,14 @@ private:
      */
     bool createBoardPolygon( wxString* aErrorMsg );
     void createLayers( REPORTER* aStatusReporter );
+
+    /**
+     * Build the objects and contours of a technical layer.  Only touches \a aDstContainer and
+     * \a aLayerPoly, so several layers can be built at the same time.
+     */
+    void createTechLayer( PCB_LAYER_ID aLayer, BVH_CONTAINER_2D* aDstContainer,
+                          SHAPE_POLY_SET& aLayerPoly,
+                          const std::bitset<LAYER_3D_END>& aVisibilityFlags );
     void destroyLayers();
 
     // Helper functions to create the board
@@ -44,11 +44,11 @@
 #include <zone.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <trigo.h>
+#include <mutex>
 #include <vector>
-#include <thread>
 #include <core/arraydim.h>
+#include <core/thread_pool.h>
 #include <algorithm>
-#include <atomic>
 #include <wx/log.h>
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
@@ -259,31 +259,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Create tracks and vias" ) );
 
-    // Create tracks as objects and add it to container
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
-        for( const PCB_TRACK* track : trackList )
-        {
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( layer ) )
-                continue;
-
-            // Skip vias annulus when not flashed on this layer
-            if( track->Type() == PCB_VIA_T
-                    && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-            {
-                continue;
-            }
-
-            // Add object item to layer container
-            createTrack( track, layerContainer );
-        }
-    }
-
     // Create VIAS and THTs objects and add it to holes containers
     for( PCB_LAYER_ID layer : layer_ids )
     {
@@ -448,38 +423,6 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Creates vertical outline contours of the tracks and add it to the poly of the layer
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
-
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
-
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-            {
-                const PCB_TRACK *track = trackList[trackIdx];
-
-                if( !track->IsOnLayer( layer ) )
-                    continue;
-
-                // Skip vias annulus when not flashed on this layer
-                if( track->Type() == PCB_VIA_T
-                        && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
-                {
-                    continue;
-                }
-
-                // Add the track/via contour
-                track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-            }
-        }
-    }
-
     // Add holes of footprints
     for( FOOTPRINT* footprint : m_board->Footprints() )
     {
@@ -543,144 +486,143 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
     }
 
-    // Add footprints PADs objects to containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
-
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
-
-        // ADD PADS
-        for( FOOTPRINT* footprint : m_board->Footprints() )
-        {
-            addPads( footprint, layerContainer, layer, cfg.differentiate_plated_copper, false );
-
-            // Micro-wave footprints may have items on copper layers
-            addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
-        }
-    }
-
-    // Add footprints PADs poly contours (vertical outlines)
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+    if( aStatusReporter )
+        aStatusReporter->Report( _( "Create copper layers" ) );
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+    const bool buildCopperPolys = cfg.opengl_copper_thickness
+                                  && cfg.engine == RENDER_ENGINE::OPENGL;
 
-            // Add pads to polygon list
-            for( FOOTPRINT* footprint : m_board->Footprints() )
+    // Each copper layer only gets items added to its own container and polygon set, so the
+    // layers are built in parallel.
+    ParallelFor( layer_ids.size(),
+            [&]( size_t aIndex )
             {
-                // Note: NPTH pads are not drawn on copper layers when the pad has same shape as
-                // its hole
-                footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE,
-                                                   true, cfg.differentiate_plated_copper, false );
+                const PCB_LAYER_ID layer = layer_ids[aIndex];
+                BVH_CONTAINER_2D*  layerContainer = m_layerMap.at( layer );
+                SHAPE_POLY_SET*    layerPoly = buildCopperPolys ? m_layers_poly.at( layer )
+                                                                : nullptr;
 
-                transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError, ERROR_INSIDE );
-            }
-        }
+                // ADD TRACKS
+                for( const PCB_TRACK* track : trackList )
+                {
+                    // NOTE: Vias can be on multiple layers
+                    if( !track->IsOnLayer( layer ) )
+                        continue;
 
-        if( cfg.differentiate_plated_copper )
-        {
-            // ADD PLATED PADS contours
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                footprint->TransformPadsToPolySet( *m_frontPlatedPadPolys, F_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
+                    // Skip vias annulus when not flashed on this layer
+                    if( track->Type() == PCB_VIA_T
+                            && !static_cast<const PCB_VIA*>( track )->FlashLayer( layer ) )
+                    {
+                        continue;
+                    }
 
-                footprint->TransformPadsToPolySet( *m_backPlatedPadPolys, B_Cu, 0, maxError,
-                                                   ERROR_INSIDE, true, false, true );
-            }
-        }
-    }
+                    // Add object item to layer container
+                    createTrack( track, layerContainer );
 
-    // Add graphic item on copper layers to object containers
-    for( PCB_LAYER_ID layer : layer_ids )
-    {
-        wxASSERT( m_layerMap.find( layer ) != m_layerMap.end() );
+                    // Add the track/via contour
+                    if( layerPoly )
+                        track->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                        ERROR_INSIDE );
+                }
 
-        BVH_CONTAINER_2D *layerContainer = m_layerMap[layer];
+                // ADD PADS
+                for( FOOTPRINT* footprint : m_board->Footprints() )
+                {
+                    addPads( footprint, layerContainer, layer, cfg.differentiate_plated_copper,
+                             false );
 
-        // Add graphic items on copper layers (texts and other graphics)
-        for( BOARD_ITEM* item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( layer ) )
-                continue;
+                    // Micro-wave footprints may have items on copper layers
+                    addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
 
-            switch( item->Type() )
-            {
-            case PCB_SHAPE_T:
-                addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                break;
-
-            case PCB_TEXT_T:
-                addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                break;
+                    if( layerPoly )
+                    {
+                        // Note: NPTH pads are not drawn on copper layers when the pad has same
+                        // shape as its hole
+                        footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError,
+                                                           ERROR_INSIDE, true,
+                                                           cfg.differentiate_plated_copper,
+                                                           false );
+
+                        transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError,
+                                                    ERROR_INSIDE );
+                    }
+                }
 
-            case PCB_TEXTBOX_T:
-                addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                break;
+                // Add graphic items on copper layers (texts and other graphics)
+                for( BOARD_ITEM* item : m_board->Drawings() )
+                {
+                    if( !item->IsOnLayer( layer ) )
+                        continue;
 
-            case PCB_DIM_ALIGNED_T:
-            case PCB_DIM_CENTER_T:
-            case PCB_DIM_RADIAL_T:
-            case PCB_DIM_ORTHOGONAL_T:
-            case PCB_DIM_LEADER_T:
-                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                break;
+                    switch( item->Type() )
+                    {
+                    case PCB_SHAPE_T:
+                        addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
+                        break;
 
-            default:
-                wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-                break;
-            }
-        }
-    }
+                    case PCB_TEXT_T:
+                        addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
+                        break;
 
-    // Add graphic item on copper layers to poly contours (vertical outlines)
-    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL )
-    {
-        for( PCB_LAYER_ID layer : layer_ids )
-        {
-            wxASSERT( m_layers_poly.find( layer ) != m_layers_poly.end() );
+                    case PCB_TEXTBOX_T:
+                        addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
+                        break;
 
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[layer];
+                    case PCB_DIM_ALIGNED_T:
+                    case PCB_DIM_CENTER_T:
+                    case PCB_DIM_RADIAL_T:
+                    case PCB_DIM_ORTHOGONAL_T:
+                    case PCB_DIM_LEADER_T:
+                        addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer,
+                                  item );
+                        break;
 
-            // Add graphic items on copper layers (texts and other )
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
+                    default:
+                        wxLogTrace( m_logTrace,
+                                    wxT( "createLayers: item type: %d not implemented" ),
+                                    item->Type() );
+                        break;
+                    }
 
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
+                    if( !layerPoly )
+                        continue;
 
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+                    // Add graphic item contours (vertical outlines)
+                    switch( item->Type() )
+                    {
+                    case PCB_SHAPE_T:
+                        item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError,
+                                                       ERROR_INSIDE );
+                        break;
 
-                    text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
+                    case PCB_TEXT_T:
+                        static_cast<PCB_TEXT*>( item )->TransformTextToPolySet( *layerPoly, 0,
+                                                                                maxError,
+                                                                                ERROR_INSIDE );
+                        break;
 
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+                    case PCB_TEXTBOX_T:
+                        static_cast<PCB_TEXTBOX*>( item )->TransformTextToPolySet( *layerPoly, 0,
+                                                                                   maxError,
+                                                                                   ERROR_INSIDE );
+                        break;
 
-                    textbox->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
+                    default:
+                        break;
+                    }
                 }
+            } );
 
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                                item->Type() );
-                    break;
-                }
-            }
+    // ADD PLATED PADS contours
+    if( buildCopperPolys && cfg.differentiate_plated_copper )
+    {
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            footprint->TransformPadsToPolySet( *m_frontPlatedPadPolys, F_Cu, 0, maxError,
+                                               ERROR_INSIDE, true, false, true );
+
+            footprint->TransformPadsToPolySet( *m_backPlatedPadPolys, B_Cu, 0, maxError,
+                                               ERROR_INSIDE, true, false, true );
         }
     }
 
@@ -713,26 +655,11 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         }
 
         // Add zones objects
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::min<size_t>( zones.size(),
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ) );
-
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < zones.size();
-                            areaId = nextZone.fetch_add( 1 ) )
+        ParallelFor( zones.size(),
+                [&]( size_t aIndex )
                 {
-                    ZONE* zone = zones[areaId].first;
-
-                    if( zone == nullptr )
-                        break;
-
-                    PCB_LAYER_ID layer = zones[areaId].second;
+                    ZONE*        zone = zones[aIndex].first;
+                    PCB_LAYER_ID layer = zones[aIndex].second;
 
                     auto layerContainer = m_layerMap.find( layer );
                     auto layerPolyContainer = m_layers_poly.find( layer );
@@ -740,32 +667,27 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
                     if( layerContainer != m_layerMap.end() )
                         addSolidAreasShapes( zone, layerContainer->second, layer );
 
-                    if( cfg.opengl_copper_thickness && cfg.engine == RENDER_ENGINE::OPENGL
-                            && layerPolyContainer != m_layers_poly.end() )
+                    if( buildCopperPolys && layerPolyContainer != m_layers_poly.end() )
                     {
                         auto mut_it = layer_lock.find( layer );
 
                         std::lock_guard< std::mutex > lock( *( mut_it->second ) );
-                        zone->TransformSolidAreasShapesToPolygon( layer, *layerPolyContainer->second );
+                        zone->TransformSolidAreasShapesToPolygon( layer,
+                                                                  *layerPolyContainer->second );
                     }
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                } );
     }
     // End Build Copper layers
 
     // This will make a union of all added contours
-    m_TH_ODPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_NPTH_ODPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_viaTH_ODPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_viaAnnuliPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+    SHAPE_POLY_SET* holePolys[] = { &m_TH_ODPolys, &m_NPTH_ODPolys, &m_viaTH_ODPolys,
+                                    &m_viaAnnuliPolys };
+
+    ParallelFor( arrayDim( holePolys ),
+            [&]( size_t aIndex )
+            {
+                holePolys[aIndex]->Simplify( SHAPE_POLY_SET::PM_FAST );
+            } );
 
     // Build Tech layers
     // Based on:
@@ -800,199 +722,27 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         enabledFlags.set( LAYER_3D_SOLDERMASK_BOTTOM );
     }
 
+    std::vector<PCB_LAYER_ID> techLayers;
+
     for( PCB_LAYER_ID layer : LSET::AllNonCuMask().Seq( techLayerList, arrayDim( techLayerList ) ) )
     {
-        if( aStatusReporter )
-            aStatusReporter->Report( wxString::Format( _( "Build Tech layer %d" ), (int) layer ) );
-
         if( !Is3dLayerEnabled( layer, enabledFlags ) )
             continue;
 
-        BVH_CONTAINER_2D *layerContainer = new BVH_CONTAINER_2D;
-        m_layerMap[layer] = layerContainer;
-
-        SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
-        m_layers_poly[layer] = layerPoly;
-
-        if( Is3dLayerEnabled( layer, visibilityFlags ) )
-        {
-            // Add drawing objects
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
-
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    addShape( static_cast<PCB_SHAPE*>( item ), layerContainer, item );
-                    break;
-
-                case PCB_TEXT_T:
-                    addText( static_cast<PCB_TEXT*>( item ), layerContainer, item );
-                    break;
-
-                case PCB_TEXTBOX_T:
-                    addShape( static_cast<PCB_TEXTBOX*>( item ), layerContainer, item );
-                    break;
-
-                case PCB_DIM_ALIGNED_T:
-                case PCB_DIM_CENTER_T:
-                case PCB_DIM_RADIAL_T:
-                case PCB_DIM_ORTHOGONAL_T:
-                case PCB_DIM_LEADER_T:
-                    addShape( static_cast<PCB_DIMENSION_BASE*>( item ), layerContainer, item );
-                    break;
-
-                default:
-                    break;
-                }
-            }
-
-            // Add via tech layers
-            if( ( layer == F_Mask || layer == B_Mask ) && !m_board->GetTentVias() )
-            {
-                int maskExpansion = GetBoard()->GetDesignSettings().m_SolderMaskExpansion;
-
-                for( PCB_TRACK* track : m_board->Tracks() )
-                {
-                    if( track->Type() == PCB_VIA_T
-                            && static_cast<const PCB_VIA*>( track )->FlashLayer( layer )  )
-                    {
-                        createViaWithMargin( track, layerContainer, maskExpansion );
-                    }
-                }
-            }
-
-            // Add footprints tech layers - objects
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                if( layer == F_SilkS || layer == B_SilkS )
-                {
-                    int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
-
-                    for( PAD* pad : footprint->Pads() )
-                    {
-                        if( !pad->IsOnLayer( layer ) )
-                            continue;
-
-                        buildPadOutlineAsSegments( pad, layerContainer, linewidth );
-                    }
-                }
-                else
-                {
-                    addPads( footprint, layerContainer, layer, false, false );
-                }
-
-                addFootprintShapes( footprint, layerContainer, layer, visibilityFlags );
-            }
-
-            // Draw non copper zones
-            if( cfg.show_zones )
-            {
-                for( ZONE* zone : m_board->Zones() )
-                {
-                    if( zone->IsOnLayer( layer ) )
-                        addSolidAreasShapes( zone, layerContainer, layer );
-                }
-            }
-        }
-
-        // Add item contours.  We need these if we're building vertical walls or if this is a
-        // mask layer and we're differentiating copper from plated copper.
-        if( ( cfg.engine == RENDER_ENGINE::OPENGL && cfg.opengl_copper_thickness )
-                || ( cfg.differentiate_plated_copper && ( layer == F_Mask || layer == B_Mask ) ) )
-        {
-            // DRAWINGS
-            for( BOARD_ITEM* item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( layer ) )
-                    continue;
-
-                switch( item->Type() )
-                {
-                case PCB_SHAPE_T:
-                    item->TransformShapeToPolygon( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                    break;
-
-                case PCB_TEXT_T:
-                {
-                    PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
-
-                    text->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
-
-                case PCB_TEXTBOX_T:
-                {
-                    PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
-
-                    textbox->TransformTextToPolySet( *layerPoly, 0, maxError, ERROR_INSIDE );
-                    break;
-                }
-
-                default:
-                    break;
-                }
-            }
-
-            // NON-TENTED VIAS
-            if( ( layer == F_Mask || layer == B_Mask ) && !m_board->GetTentVias() )
-            {
-                int maskExpansion = GetBoard()->GetDesignSettings().m_SolderMaskExpansion;
-
-                for( PCB_TRACK* track : m_board->Tracks() )
-                {
-                    if( track->Type() == PCB_VIA_T
-                            && static_cast<const PCB_VIA*>( track )->FlashLayer( layer )  )
-                    {
-                        track->TransformShapeToPolygon( *layerPoly, layer, maskExpansion, maxError,
-                                                        ERROR_INSIDE );
-                    }
-                }
-            }
-
-            // FOOTPRINT CHILDREN
-            for( FOOTPRINT* footprint : m_board->Footprints() )
-            {
-                if( layer == F_SilkS || layer == B_SilkS )
-                {
-                    int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
-
-                    for( PAD* pad : footprint->Pads() )
-                    {
-                        if( pad->IsOnLayer( layer ) )
-                        {
-                            buildPadOutlineAsPolygon( pad, *layerPoly, linewidth, maxError,
-                                                      ERROR_INSIDE );
-                        }
-                    }
-                }
-                else
-                {
-                    footprint->TransformPadsToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-                }
-
-                // On tech layers, use a poor circle approximation, only for texts (stroke font)
-                footprint->TransformFPTextToPolySet( *layerPoly, layer, 0, maxError, ERROR_INSIDE );
-
-                // Add the remaining things with dynamic seg count for circles
-                transformFPShapesToPolySet( footprint, layer, *layerPoly, maxError, ERROR_INSIDE );
-            }
+        techLayers.push_back( layer );
+        m_layerMap[layer] = new BVH_CONTAINER_2D;
+        m_layers_poly[layer] = new SHAPE_POLY_SET;
+    }
 
-            if( cfg.show_zones || layer == F_Mask || layer == B_Mask )
+    // The tech layers are independent from each other, so they are built in parallel too
+    ParallelFor( techLayers.size(),
+            [&]( size_t aIndex )
             {
-                for( ZONE* zone : m_board->Zones() )
-                {
-                    if( zone->IsOnLayer( layer ) )
-                        zone->TransformSolidAreasShapesToPolygon( layer, *layerPoly );
-                }
-            }
+                const PCB_LAYER_ID layer = techLayers[aIndex];
 
-            // This will make a union of all added contours
-            layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
-        }
-    }
+                createTechLayer( layer, m_layerMap.at( layer ), *m_layers_poly.at( layer ),
+                                 visibilityFlags );
+            } );
     // End Build Tech layers
 
     // If we're rendering off-board silk, also render pads of footprints which are entirely
@@ -1102,39 +852,17 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
                                                            (int) selected_layer_id.size() ) );
             }
 
-            std::atomic<size_t> nextItem( 0 );
-            std::atomic<size_t> threadsFinished( 0 );
-
-            size_t parallelThreadCount = std::min<size_t>(
-                    std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                    selected_layer_id.size() );
+            ParallelFor( selected_layer_id.size(),
+                    [&]( size_t aIndex )
+                    {
+                        auto layerPoly = m_layers_poly.find( selected_layer_id[aIndex] );
 
-            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-            {
-                std::thread t = std::thread(
-                        [&nextItem, &threadsFinished, &selected_layer_id, this]()
+                        if( layerPoly != m_layers_poly.end() )
                         {
-                            for( size_t i = nextItem.fetch_add( 1 );
-                                        i < selected_layer_id.size();
-                                        i = nextItem.fetch_add( 1 ) )
-                            {
-                                auto layerPoly = m_layers_poly.find( selected_layer_id[i] );
-
-                                if( layerPoly != m_layers_poly.end() )
-                                {
-                                    // This will make a union of all added contours
-                                    layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
-                                }
-                            }
-
-                            threadsFinished++;
-                        } );
-
-                t.detach();
-            }
-
-            while( threadsFinished < parallelThreadCount )
-                std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+                            // This will make a union of all added contours
+                            layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
+                        }
+                    } );
         }
     }
 
@@ -1142,41 +870,237 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
     if( aStatusReporter )
         aStatusReporter->Report( _( "Simplify holes contours" ) );
 
+    std::vector<SHAPE_POLY_SET*> layerHolePolys;
+
     for( PCB_LAYER_ID layer : layer_ids )
     {
         if( m_layerHoleOdPolys.find( layer ) != m_layerHoleOdPolys.end() )
         {
             // found
-            SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            layerHolePolys.push_back( m_layerHoleOdPolys[layer] );
 
             wxASSERT( m_layerHoleIdPolys.find( layer ) != m_layerHoleIdPolys.end() );
 
-            polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            layerHolePolys.push_back( m_layerHoleIdPolys[layer] );
         }
     }
 
+    ParallelFor( layerHolePolys.size(),
+            [&]( size_t aIndex )
+            {
+                layerHolePolys[aIndex]->Simplify( SHAPE_POLY_SET::PM_FAST );
+            } );
+
     // Build BVH (Bounding volume hierarchy) for holes and vias
 
     if( aStatusReporter )
         aStatusReporter->Report( _( "Build BVH for holes and vias" ) );
 
-    m_TH_IDs.BuildBVH();
-    m_TH_ODs.BuildBVH();
-    m_viaAnnuli.BuildBVH();
+    std::vector<BVH_CONTAINER_2D*> bvhContainers = { &m_TH_IDs, &m_TH_ODs, &m_viaAnnuli };
 
-    if( !m_layerHoleMap.empty() )
-    {
-        for( std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& hole : m_layerHoleMap )
-            hole.second->BuildBVH();
-    }
+    for( std::pair<const PCB_LAYER_ID, BVH_CONTAINER_2D*>& hole : m_layerHoleMap )
+        bvhContainers.push_back( hole.second );
 
     // We only need the Solder mask to initialize the BVH
     // because..?
     if( m_layerMap[B_Mask] )
-        m_layerMap[B_Mask]->BuildBVH();
+        bvhContainers.push_back( m_layerMap[B_Mask] );
 
     if( m_layerMap[F_Mask] )
-        m_layerMap[F_Mask]->BuildBVH();
+        bvhContainers.push_back( m_layerMap[F_Mask] );
+
+    ParallelFor( bvhContainers.size(),
+            [&]( size_t aIndex )
+            {
+                bvhContainers[aIndex]->BuildBVH();
+            } );
+}
+
+
+void BOARD_ADAPTER::createTechLayer( PCB_LAYER_ID aLayer, BVH_CONTAINER_2D* aDstContainer,
+                                     SHAPE_POLY_SET& aLayerPoly,
+                                     const std::bitset<LAYER_3D_END>& aVisibilityFlags )
+{
+    EDA_3D_VIEWER_SETTINGS::RENDER_SETTINGS& cfg = m_Cfg->m_Render;
+
+    int maxError = m_board->GetDesignSettings().m_MaxError;
+
+    if( Is3dLayerEnabled( aLayer, aVisibilityFlags ) )
+    {
+        // Add drawing objects
+        for( BOARD_ITEM* item : m_board->Drawings() )
+        {
+            if( !item->IsOnLayer( aLayer ) )
+                continue;
+
+            switch( item->Type() )
+            {
+            case PCB_SHAPE_T:
+                addShape( static_cast<PCB_SHAPE*>( item ), aDstContainer, item );
+                break;
+
+            case PCB_TEXT_T:
+                addText( static_cast<PCB_TEXT*>( item ), aDstContainer, item );
+                break;
+
+            case PCB_TEXTBOX_T:
+                addShape( static_cast<PCB_TEXTBOX*>( item ), aDstContainer, item );
+                break;
+
+            case PCB_DIM_ALIGNED_T:
+            case PCB_DIM_CENTER_T:
+            case PCB_DIM_RADIAL_T:
+            case PCB_DIM_ORTHOGONAL_T:
+            case PCB_DIM_LEADER_T:
+                addShape( static_cast<PCB_DIMENSION_BASE*>( item ), aDstContainer, item );
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        // Add via tech layers
+        if( ( aLayer == F_Mask || aLayer == B_Mask ) && !m_board->GetTentVias() )
+        {
+            int maskExpansion = GetBoard()->GetDesignSettings().m_SolderMaskExpansion;
+
+            for( PCB_TRACK* track : m_board->Tracks() )
+            {
+                if( track->Type() == PCB_VIA_T
+                        && static_cast<const PCB_VIA*>( track )->FlashLayer( aLayer )  )
+                {
+                    createViaWithMargin( track, aDstContainer, maskExpansion );
+                }
+            }
+        }
+
+        // Add footprints tech layers - objects
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            if( aLayer == F_SilkS || aLayer == B_SilkS )
+            {
+                int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
+
+                for( PAD* pad : footprint->Pads() )
+                {
+                    if( !pad->IsOnLayer( aLayer ) )
+                        continue;
+
+                    buildPadOutlineAsSegments( pad, aDstContainer, linewidth );
+                }
+            }
+            else
+            {
+                addPads( footprint, aDstContainer, aLayer, false, false );
+            }
+
+            addFootprintShapes( footprint, aDstContainer, aLayer, aVisibilityFlags );
+        }
+
+        // Draw non copper zones
+        if( cfg.show_zones )
+        {
+            for( ZONE* zone : m_board->Zones() )
+            {
+                if( zone->IsOnLayer( aLayer ) )
+                    addSolidAreasShapes( zone, aDstContainer, aLayer );
+            }
+        }
+    }
+
+    // Add item contours.  We need these if we're building vertical walls or if this is a
+    // mask aLayer and we're differentiating copper from plated copper.
+    if( ( cfg.engine == RENDER_ENGINE::OPENGL && cfg.opengl_copper_thickness )
+            || ( cfg.differentiate_plated_copper && ( aLayer == F_Mask || aLayer == B_Mask ) ) )
+    {
+        // DRAWINGS
+        for( BOARD_ITEM* item : m_board->Drawings() )
+        {
+            if( !item->IsOnLayer( aLayer ) )
+                continue;
+
+            switch( item->Type() )
+            {
+            case PCB_SHAPE_T:
+                item->TransformShapeToPolygon( aLayerPoly, aLayer, 0, maxError, ERROR_INSIDE );
+                break;
+
+            case PCB_TEXT_T:
+            {
+                PCB_TEXT* text = static_cast<PCB_TEXT*>( item );
+
+                text->TransformTextToPolySet( aLayerPoly, 0, maxError, ERROR_INSIDE );
+                break;
+            }
+
+            case PCB_TEXTBOX_T:
+            {
+                PCB_TEXTBOX* textbox = static_cast<PCB_TEXTBOX*>( item );
+
+                textbox->TransformTextToPolySet( aLayerPoly, 0, maxError, ERROR_INSIDE );
+                break;
+            }
+
+            default:
+                break;
+            }
+        }
+
+        // NON-TENTED VIAS
+        if( ( aLayer == F_Mask || aLayer == B_Mask ) && !m_board->GetTentVias() )
+        {
+            int maskExpansion = GetBoard()->GetDesignSettings().m_SolderMaskExpansion;
+
+            for( PCB_TRACK* track : m_board->Tracks() )
+            {
+                if( track->Type() == PCB_VIA_T
+                        && static_cast<const PCB_VIA*>( track )->FlashLayer( aLayer )  )
+                {
+                    track->TransformShapeToPolygon( aLayerPoly, aLayer, maskExpansion, maxError,
+                                                    ERROR_INSIDE );
+                }
+            }
+        }
+
+        // FOOTPRINT CHILDREN
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            if( aLayer == F_SilkS || aLayer == B_SilkS )
+            {
+                int linewidth = m_board->GetDesignSettings().m_LineThickness[ LAYER_CLASS_SILK ];
+
+                for( PAD* pad : footprint->Pads() )
+                {
+                    if( pad->IsOnLayer( aLayer ) )
+                    {
+                        buildPadOutlineAsPolygon( pad, aLayerPoly, linewidth, maxError,
+                                                  ERROR_INSIDE );
+                    }
+                }
+            }
+            else
+            {
+                footprint->TransformPadsToPolySet( aLayerPoly, aLayer, 0, maxError, ERROR_INSIDE );
+            }
+
+            // On tech layers, use a poor circle approximation, only for texts (stroke font)
+            footprint->TransformFPTextToPolySet( aLayerPoly, aLayer, 0, maxError, ERROR_INSIDE );
+
+            // Add the remaining things with dynamic seg count for circles
+            transformFPShapesToPolySet( footprint, aLayer, aLayerPoly, maxError, ERROR_INSIDE );
+        }
+
+        if( cfg.show_zones || aLayer == F_Mask || aLayer == B_Mask )
+        {
+            for( ZONE* zone : m_board->Zones() )
+            {
+                if( zone->IsOnLayer( aLayer ) )
+                    zone->TransformSolidAreasShapesToPolygon( aLayer, aLayerPoly );
+            }
+        }
+
+        // This will make a union of all added contours
+        aLayerPoly.Simplify( SHAPE_POLY_SET::PM_FAST );
+    }
 }
@@ -36,6 +36,8 @@
 #include <thread>
 #include <chrono>
 
+#include <core/thread_pool.h>
+
 
 #ifndef CLAMP
 #define CLAMP( n, min, max ) {if( n < min ) n=min; else if( n > max ) n = max;}
@@ -479,13 +481,15 @@ void IMAGE::EfxFilter( IMAGE* aInImg, IMAGE_FILTER aFilterType )
     m_wraping         = IMAGE_WRAP::CLAMP;
 
     std::atomic<size_t> nextRow( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
 
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+    size_t parallelThreadCount = GetThreadBudget( THREAD_SUBSYSTEM::RAYTRACE );
+
+    thread_pool&           tp = GetKiCadThreadPool();
+    BS::multi_future<void> futures;
 
     for( size_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        std::thread t = std::thread( [&]()
+        futures.push_back( tp.submit( [&]()
         {
             for( size_t iy = nextRow.fetch_add( 1 ); iy < m_height; iy = nextRow.fetch_add( 1 ) )
             {
@@ -512,15 +516,10 @@ void IMAGE::EfxFilter( IMAGE* aInImg, IMAGE_FILTER aFilterType )
                     m_pixels[ix + iy * m_width] = v;
                 }
             }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
+        } ) );
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    futures.wait();
 }
 
 
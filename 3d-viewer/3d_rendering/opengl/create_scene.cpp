@@ -34,6 +34,7 @@
 #include <fp_lib_table.h>
 #include <eda_3d_viewer_frame.h>
 #include <project_pcb.h>
+#include <set>
 
 
 void RENDER_3D_OPENGL::addObjectTriangles( const FILLED_CIRCLE_2D* aCircle,
@@ -922,9 +923,26 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
           && !m_boardAdapter.m_Cfg->m_Render.show_footprints_insert
           && !m_boardAdapter.m_Cfg->m_Render.show_footprints_virtual )
     {
+        // Load3dModelsIfNeeded() loads them all again when footprints are shown
+        free3dModels();
         return;
     }
 
+    S3D_CACHE*          cacheMgr = m_boardAdapter.Get3dCacheManager();
+    const MATERIAL_MODE materialMode = m_boardAdapter.m_Cfg->m_Render.material_mode;
+    std::set<wxString>  queued;
+
+    // Models to load, with the path to search for their relative files
+    std::vector<std::pair<wxString, wxString>> toLoad;
+
+    // The models are kept from one reload of the board to the next, unless their materials
+    // change: editing the board mostly moves the same models around.
+    if( materialMode != m_3dModelsMaterialMode )
+    {
+        free3dModels();
+        m_3dModelsMaterialMode = materialMode;
+    }
+
     // Go for all footprints
     for( const FOOTPRINT* footprint : m_boardAdapter.GetBoard()->Footprints() )
     {
@@ -951,35 +969,74 @@ void RENDER_3D_OPENGL::load3dModels( REPORTER* aStatusReporter )
 
         for( const FP_3DMODEL& fp_model : footprint->Models() )
         {
-            if( fp_model.m_Show && !fp_model.m_Filename.empty() )
+            if( !fp_model.m_Show || fp_model.m_Filename.empty() )
+                continue;
+
+            if( !queued.insert( fp_model.m_Filename ).second )
+                continue;
+
+            // A model kept from the previous reload is still good if the cache gives the same
+            // data for it, i.e. its file was not modified since
+            auto kept = m_3dModelMap.find( fp_model.m_Filename );
+
+            if( kept != m_3dModelMap.end() )
             {
+                const S3DMODEL* modelPtr = cacheMgr->GetModel( fp_model.m_Filename,
+                                                               footprintBasePath );
+
+                if( modelPtr && modelPtr == m_3dModelSources[fp_model.m_Filename] )
+                    continue;
+
+                delete kept->second;
+                m_3dModelMap.erase( kept );
+                m_3dModelSources.erase( fp_model.m_Filename );
+            }
+
+            toLoad.emplace_back( fp_model.m_Filename, footprintBasePath );
+        }
+    }
+
+    // The models load in parallel; the GPU buffers of each one are created here, on the main
+    // thread, as soon as it is ready
+    size_t loadedCount = 0;
+
+    cacheMgr->PreloadModels( toLoad,
+            [&]( size_t aIndex, S3DMODEL* aModel )
+            {
+                const wxString& filename = toLoad[aIndex].first;
+
+                ++loadedCount;
+
                 if( aStatusReporter )
                 {
                     // Display the short filename of the 3D fp_model loaded:
                     // (the full name is usually too long to be displayed)
-                    wxFileName fn( fp_model.m_Filename );
-                    aStatusReporter->Report( wxString::Format( _( "Loading %s..." ),
-                                                               fn.GetFullName() ) );
+                    wxFileName fn( filename );
+                    aStatusReporter->Report( wxString::Format( _( "Loaded %s (%zu of %zu)" ),
+                                                               fn.GetFullName(), loadedCount,
+                                                               toLoad.size() ) );
                 }
 
-                // Check if the fp_model is not present in our cache map
-                // (Not already loaded in memory)
-                if( m_3dModelMap.find( fp_model.m_Filename ) == m_3dModelMap.end() )
+                // only add it if the return is not NULL
+                if( aModel )
                 {
-                    // It is not present, try get it from cache
-                    const S3DMODEL* modelPtr =
-                            m_boardAdapter.Get3dCacheManager()->GetModel( fp_model.m_Filename, footprintBasePath );
-
-                    // only add it if the return is not NULL
-                    if( modelPtr )
-                    {
-                        MATERIAL_MODE materialMode = m_boardAdapter.m_Cfg->m_Render.material_mode;
-                        MODEL_3D*     model        = new MODEL_3D( *modelPtr, materialMode );
-
-                        m_3dModelMap[ fp_model.m_Filename ] = model;
-                    }
+                    m_3dModelMap[ filename ] = new MODEL_3D( *aModel, m_3dModelsMaterialMode );
+                    m_3dModelSources[ filename ] = aModel;
                 }
-            }
+            } );
+
+    // Drop the models no footprint uses anymore
+    for( auto it = m_3dModelMap.begin(); it != m_3dModelMap.end(); )
+    {
+        if( queued.count( it->first ) )
+        {
+            ++it;
+        }
+        else
+        {
+            delete it->second;
+            m_3dModelSources.erase( it->first );
+            it = m_3dModelMap.erase( it );
         }
     }
 }
@@ -76,6 +76,7 @@ RENDER_3D_OPENGL::RENDER_3D_OPENGL( EDA_3D_CANVAS* aCanvas, BOARD_ADAPTER& aAdap
     m_boardWithHoles = nullptr;
 
     m_3dModelMap.clear();
+    m_3dModelsMaterialMode = MATERIAL_MODE::NORMAL;
 }
 
 
@@ -84,6 +85,7 @@ RENDER_3D_OPENGL::~RENDER_3D_OPENGL()
     wxLogTrace( m_logTrace, wxT( "RENDER_3D_OPENGL::RENDER_3D_OPENGL" ) );
 
     freeAllLists();
+    free3dModels();
 
     glDeleteTextures( 1, &m_circleTexture );
 }
@@ -878,8 +880,6 @@ void RENDER_3D_OPENGL::freeAllLists()
 
     m_triangles.clear();
 
-    DELETE_AND_FREE_MAP( m_3dModelMap )
-
     m_3dModelMatrixMap.clear();
 
     DELETE_AND_FREE( m_board )
@@ -895,6 +895,16 @@ void RENDER_3D_OPENGL::freeAllLists()
 }
 
 
+void RENDER_3D_OPENGL::free3dModels()
+{
+    for( auto& [ filename, model ] : m_3dModelMap )
+        delete model;
+
+    m_3dModelMap.clear();
+    m_3dModelSources.clear();
+}
+
+
 void RENDER_3D_OPENGL::renderSolderMaskLayer( PCB_LAYER_ID aLayerID, float aZPos,
                                               bool aShowThickness, bool aSkipRenderHoles )
 {
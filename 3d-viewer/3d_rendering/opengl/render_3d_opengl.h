@@ -193,8 +193,11 @@ private:
 
     void setArrowMaterial();
 
+    /// Free the lists of the board, keeping the 3D models which don't depend on it.
     void freeAllLists();
 
+    void free3dModels();
+
     struct
     {
         SMATERIAL m_Paste;
@@ -233,6 +236,8 @@ private:
 
     // Caches
     std::map<wxString, MODEL_3D*>           m_3dModelMap;
+    std::map<wxString, const S3DMODEL*>     m_3dModelSources;  ///< Data each model was built from
+    MATERIAL_MODE                           m_3dModelsMaterialMode;
     std::map<std::vector<float>, glm::mat4> m_3dModelMatrixMap;
 
     BOARD_ITEM*         m_currentRollOverItem;
@@ -78,6 +78,8 @@ private:
      */
     SFVEC3F giColorCurve( const SFVEC3F& aColor ) const;
 
+    friend class POST_SHADER_SSAO_GPU;
+
     SFVEC3F* m_shadedBuffer;
 
     bool m_isUsingShadows;
@@ -0,0 +1,365 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file post_shader_ssao_gpu.cpp
+ * @brief Implement the screen space ambient occlusion post shader as a compute shader.
+ */
+
+#include <gal/opengl/kiglew.h>    // Must be included first
+
+#include "post_shader_ssao_gpu.h"
+
+#include <vector>
+
+#include <wx/log.h>
+
+
+static const wxChar* traceSsaoGpu = wxT( "KI_TRACE_3D_SSAO_GPU" );
+
+
+/// Side of the work groups, in pixels
+static constexpr int GROUP_SIZE = 8;
+
+
+// Same computations as POST_SHADER_SSAO::Shade().  The colors are stored as float triplets,
+// since std430 arrays of vec3 have a 16 byte stride.
+static const char ssaoComputeShader[] = R"SHADER(
+#version 430
+
+layout( local_size_x = 8, local_size_y = 8 ) in;
+
+layout( std430, binding = 0 ) readonly buffer NORMALS { float normals[]; };
+layout( std430, binding = 1 ) readonly buffer COLORS { float colors[]; };
+layout( std430, binding = 2 ) readonly buffer POSITIONS { float positions[]; };
+layout( std430, binding = 3 ) readonly buffer DEPTHS { float depths[]; };
+layout( std430, binding = 4 ) readonly buffer SHADOWS { float shadows[]; };
+layout( std430, binding = 5 ) writeonly buffer SHADED { float shaded[]; };
+
+uniform ivec2 u_size;
+uniform bool  u_useShadows;
+
+const float FLT_EPSILON = 1.19209290e-07;
+const int   ROUNDS = 3;
+
+uint g_seed;
+
+int nextRand()
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return int( ( g_seed >> 16 ) & 0x7FFFu );
+}
+
+int indexAt( ivec2 aPos )
+{
+    ivec2 p = clamp( aPos, ivec2( 0 ), u_size - ivec2( 1 ) );
+    return p.x + u_size.x * p.y;
+}
+
+vec3 fetch3( int aIndex, int aBuffer )
+{
+    int i = aIndex * 3;
+
+    if( aBuffer == 0 )
+        return vec3( normals[i], normals[i + 1], normals[i + 2] );
+    else if( aBuffer == 1 )
+        return vec3( colors[i], colors[i + 1], colors[i + 2] );
+
+    return vec3( positions[i], positions[i + 1], positions[i + 2] );
+}
+
+vec3 normalAt( ivec2 aPos ) { return fetch3( indexAt( aPos ), 0 ); }
+vec3 colorAt( ivec2 aPos ) { return fetch3( indexAt( aPos ), 1 ); }
+vec3 positionAt( ivec2 aPos ) { return fetch3( indexAt( aPos ), 2 ); }
+float shadowAt( ivec2 aPos ) { return shadows[indexAt( aPos )]; }
+
+float aoFF( ivec2 aPos, vec3 aDiff, vec3 aNormal, float aShadowAtSample, float aShadowAtCenter,
+            ivec2 aOffset )
+{
+    const float shadowGain = 0.60;
+    const float aoGain = 1.0;
+
+    float shadowFactorAtSample = ( 1.0 - aShadowAtSample ) * shadowGain;
+    float shadowFactorAtCenter = ( 1.0 - aShadowAtCenter ) * shadowGain;
+
+    float rd = length( aDiff );
+
+    if( rd >= 2.0 || rd <= FLT_EPSILON )
+        return shadowFactorAtCenter;
+
+    vec3  vv = normalize( aDiff );
+    float attDistFactor = 1.0 / ( rd * rd * 8.0 + 1.0 );
+
+    float sampledNormalFactor = max( dot( normalAt( aPos + aOffset ), aNormal ), 0.0 );
+    sampledNormalFactor = max( 1.0 - sampledNormalFactor * sampledNormalFactor, 0.0 );
+
+    float shadowAttDistFactor = max( min( rd * 5.0 - 0.25, 1.0 ), 0.0 );
+    float shadowAttFactor = min( sampledNormalFactor + shadowAttDistFactor, 1.0 );
+    float shadowFactor = mix( shadowFactorAtSample, shadowFactorAtCenter, shadowAttFactor );
+
+    const float dotThreshold = 0.15;
+
+    float localNormalFactor = dot( aNormal, vv );
+    float localNormalFactorWithThreshold =
+            ( max( localNormalFactor, dotThreshold ) - dotThreshold ) / ( 1.0 - dotThreshold );
+
+    return min( localNormalFactorWithThreshold * aoGain * attDistFactor + shadowFactor, 1.0 );
+}
+
+float giFF( ivec2 aPos, vec3 aDiff, vec3 aNormal, float aShadow, ivec2 aOffset )
+{
+    if( aDiff.x > FLT_EPSILON || aDiff.y > FLT_EPSILON || aDiff.z > FLT_EPSILON )
+    {
+        vec3  vv = normalize( aDiff );
+        float rd = length( aDiff );
+        float attDistFactor = 1.0 / ( rd * rd + 1.0 );
+
+        return ( clamp( dot( normalAt( aPos + aOffset ), -vv ), 0.0, 1.0 )
+                 * clamp( dot( aNormal, vv ), 0.0, 1.0 ) * attDistFactor )
+               * ( 0.03 + aShadow ) * 3.0;
+    }
+
+    return 0.0;
+}
+
+vec3 giColorCurve( vec3 aColor )
+{
+    return vec3( 1.0 ) - ( vec3( 1.0 ) / ( aColor * 9.0 + vec3( 1.0 ) ) ) + aColor * 0.10;
+}
+
+vec3 shade( ivec2 aPos )
+{
+    float cdepth = depths[indexAt( aPos )];
+
+    if( cdepth <= FLT_EPSILON )
+        return vec3( 0.0 );
+
+    cdepth = 30.0 / ( cdepth * 2.0 + 1.0 );
+
+    vec3  n = normalAt( aPos );
+    vec3  p = positionAt( aPos );
+    float shadowAt0 = shadowAt( aPos );
+
+    float ao = 0.0;
+    vec3  gi = vec3( 0.0 );
+
+    const int limit[ROUNDS] = int[ROUNDS]( 0x01, 0x03, 0x03 );
+
+    for( int i = 0; i < ROUNDS; ++i )
+    {
+        int pw = nextRand() & limit[i];
+        int ph = nextRand() & limit[i];
+
+        int npw = int( float( pw + i ) * cdepth ) + ( i + 1 );
+        int nph = int( float( ph + i ) * cdepth ) + ( i + 1 );
+
+        ivec2 offsets[8] = ivec2[8]( ivec2( npw, nph ), ivec2( npw, -nph ),
+                                     ivec2( -npw, nph ), ivec2( -npw, -nph ),
+                                     ivec2( pw, nph ), ivec2( pw, -nph ),
+                                     ivec2( npw, ph ), ivec2( -npw, ph ) );
+
+        for( int j = 0; j < 8; ++j )
+        {
+            vec3  ddiff = positionAt( aPos + offsets[j] ) - p;
+            float shadowAtJ = shadowAt( aPos + offsets[j] );
+
+            ao += aoFF( aPos, ddiff, n, shadowAtJ, shadowAt0, offsets[j] );
+            gi += giFF( aPos, ddiff, n, shadowAtJ, offsets[j] )
+                  * giColorCurve( colorAt( aPos + offsets[j] ) );
+        }
+    }
+
+    float reduceAOwhenNoShadow = u_useShadows ? ( 1.0 - shadowAt0 * 0.3 ) : 1.0;
+
+    ao = reduceAOwhenNoShadow * ( ao / ( float( ROUNDS ) * 8.0 ) );
+    ao = ( 1.0 - 1.0 / ( ao * ao * 5.0 + 1.0 ) ) * 1.2;
+
+    gi = gi / ( float( ROUNDS ) * 8.0 );
+
+    float giL = min( length( gi ) * 4.0, 1.0 );
+
+    giL = ( 1.0 - 1.0 / ( giL * 4.0 + 1.0 ) ) * 1.5;
+
+    return mix( vec3( ao ), -gi, giL );
+}
+
+void main()
+{
+    ivec2 pos = ivec2( gl_GlobalInvocationID.xy );
+
+    if( pos.x >= u_size.x || pos.y >= u_size.y )
+        return;
+
+    g_seed = uint( pos.x ) * 73856093u ^ uint( pos.y ) * 19349663u;
+
+    vec3 color = shade( pos );
+    int  i = ( pos.x + u_size.x * pos.y ) * 3;
+
+    shaded[i] = color.r;
+    shaded[i + 1] = color.g;
+    shaded[i + 2] = color.b;
+}
+)SHADER";
+
+
+POST_SHADER_SSAO_GPU::POST_SHADER_SSAO_GPU() :
+        m_program( 0 ),
+        m_initFailed( false )
+{
+    for( GLuint& buffer : m_buffers )
+        buffer = 0;
+}
+
+
+bool POST_SHADER_SSAO_GPU::IsSupported()
+{
+    return ( GLEW_VERSION_4_3 || ( GLEW_ARB_compute_shader
+                                   && GLEW_ARB_shader_storage_buffer_object ) );
+}
+
+
+bool POST_SHADER_SSAO_GPU::init()
+{
+    if( m_program )
+        return true;
+
+    if( m_initFailed || !IsSupported() )
+        return false;
+
+    GLuint      shader = glCreateShader( GL_COMPUTE_SHADER );
+    const char* source = ssaoComputeShader;
+    GLint       status = GL_FALSE;
+
+    glShaderSource( shader, 1, &source, nullptr );
+    glCompileShader( shader );
+    glGetShaderiv( shader, GL_COMPILE_STATUS, &status );
+
+    if( status == GL_TRUE )
+    {
+        m_program = glCreateProgram();
+        glAttachShader( m_program, shader );
+        glLinkProgram( m_program );
+        glGetProgramiv( m_program, GL_LINK_STATUS, &status );
+    }
+
+    if( status != GL_TRUE )
+    {
+        GLchar log[1024] = "";
+
+        if( m_program )
+            glGetProgramInfoLog( m_program, sizeof( log ), nullptr, log );
+        else
+            glGetShaderInfoLog( shader, sizeof( log ), nullptr, log );
+
+        wxLogTrace( traceSsaoGpu, wxT( "SSAO compute shader failed to build: %s" ),
+                    wxString::FromUTF8( log ) );
+
+        if( m_program )
+            glDeleteProgram( m_program );
+
+        m_program = 0;
+        m_initFailed = true;
+    }
+
+    glDeleteShader( shader );
+
+    if( !m_program )
+        return false;
+
+    glGenBuffers( BUFFER_COUNT, m_buffers );
+
+    return true;
+}
+
+
+bool POST_SHADER_SSAO_GPU::Shade( const POST_SHADER_SSAO& aShader, SFVEC3F* aOutput )
+{
+    const SFVEC2UI& size = aShader.m_size;
+    const size_t    pixels = (size_t) size.x * size.y;
+
+    if( pixels == 0 || !init() )
+        return false;
+
+    static_assert( sizeof( SFVEC3F ) == 3 * sizeof( float ), "colors must be float triplets" );
+
+    // Drop the errors left by the other renderers, to only check ours
+    while( glGetError() != GL_NO_ERROR )
+        ;
+
+    auto upload =
+            [&]( BUFFER aBuffer, const void* aData, size_t aSize )
+            {
+                glBindBuffer( GL_SHADER_STORAGE_BUFFER, m_buffers[aBuffer] );
+                glBufferData( GL_SHADER_STORAGE_BUFFER, aSize, aData,
+                              aData ? GL_STREAM_DRAW : GL_STREAM_READ );
+                glBindBufferBase( GL_SHADER_STORAGE_BUFFER, aBuffer, m_buffers[aBuffer] );
+            };
+
+    upload( NORMALS, aShader.m_normals, pixels * sizeof( SFVEC3F ) );
+    upload( COLORS, aShader.m_color, pixels * sizeof( SFVEC3F ) );
+    upload( POSITIONS, aShader.m_wc_hitposition, pixels * sizeof( SFVEC3F ) );
+    upload( DEPTHS, aShader.m_depth, pixels * sizeof( float ) );
+    upload( SHADOWS, aShader.m_shadow_att_factor, pixels * sizeof( float ) );
+    upload( SHADED, nullptr, pixels * sizeof( SFVEC3F ) );
+
+    glUseProgram( m_program );
+    glUniform2i( glGetUniformLocation( m_program, "u_size" ), size.x, size.y );
+    glUniform1i( glGetUniformLocation( m_program, "u_useShadows" ),
+                 aShader.m_isUsingShadows ? 1 : 0 );
+
+    glDispatchCompute( ( size.x + GROUP_SIZE - 1 ) / GROUP_SIZE,
+                       ( size.y + GROUP_SIZE - 1 ) / GROUP_SIZE, 1 );
+    glMemoryBarrier( GL_BUFFER_UPDATE_BARRIER_BIT );
+
+    glBindBuffer( GL_SHADER_STORAGE_BUFFER, m_buffers[SHADED] );
+    glGetBufferSubData( GL_SHADER_STORAGE_BUFFER, 0, pixels * sizeof( SFVEC3F ), aOutput );
+
+    glBindBuffer( GL_SHADER_STORAGE_BUFFER, 0 );
+    glUseProgram( 0 );
+
+    if( GLenum err = glGetError(); err != GL_NO_ERROR )
+    {
+        wxLogTrace( traceSsaoGpu, wxT( "SSAO compute shader failed with error 0x%X" ), err );
+        m_initFailed = true;
+        Release();
+        return false;
+    }
+
+    return true;
+}
+
+
+void POST_SHADER_SSAO_GPU::Release()
+{
+    if( m_program )
+    {
+        glDeleteProgram( m_program );
+        glDeleteBuffers( BUFFER_COUNT, m_buffers );
+    }
+
+    m_program = 0;
+
+    for( GLuint& buffer : m_buffers )
+        buffer = 0;
+}
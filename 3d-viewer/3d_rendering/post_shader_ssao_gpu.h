@@ -0,0 +1,86 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file post_shader_ssao_gpu.h
+ * @brief Run the screen space ambient occlusion post shader on the GPU.
+ */
+
+#ifndef POST_SHADER_SSAO_GPU_H
+#define POST_SHADER_SSAO_GPU_H
+
+#include "../common_ogl/openGL_includes.h"
+#include "post_shader_ssao.h"
+
+
+/**
+ * The shading pass of #POST_SHADER_SSAO as an OpenGL 4.3 compute shader.
+ *
+ * The pixel buffers of the post shader are uploaded to shader storage buffers and the shaded
+ * colors are read back, so the blur and final color passes don't change.  All the methods need
+ * the OpenGL context of the canvas to be current.
+ */
+class POST_SHADER_SSAO_GPU
+{
+public:
+    POST_SHADER_SSAO_GPU();
+
+    /**
+     * @return true if the current OpenGL context can run compute shaders.
+     */
+    static bool IsSupported();
+
+    /**
+     * Compute the shade color of every pixel of \a aShader into \a aOutput, which holds one
+     * color per pixel, row by row.
+     *
+     * @return false if the shader can't run, in which case the CPU shader must be used.
+     */
+    bool Shade( const POST_SHADER_SSAO& aShader, SFVEC3F* aOutput );
+
+    /**
+     * Delete the OpenGL objects.
+     */
+    void Release();
+
+private:
+    bool init();
+
+    enum BUFFER
+    {
+        NORMALS = 0,
+        COLORS,
+        POSITIONS,
+        DEPTHS,
+        SHADOWS,
+        SHADED,
+        BUFFER_COUNT
+    };
+
+    GLuint m_program;
+    GLuint m_buffers[BUFFER_COUNT];
+    bool   m_initFailed;           ///< Set if the shader failed to build, not to retry each frame
+};
+
+#endif   // POST_SHADER_SSAO_GPU_H
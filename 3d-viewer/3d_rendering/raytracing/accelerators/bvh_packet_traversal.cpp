@@ -28,6 +28,7 @@
  */
 
 #include "bvh_pbrt.h"
+#include "../raypacket_kernel.h"
 
 
 #define BVH_RANGED_TRAVERSAL
@@ -44,44 +45,17 @@ struct StackNode
 };
 
 
-static inline unsigned int getFirstHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                        unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
-{
-    float hitT;
-
-    if( aBBox.Intersect( aRayPacket.m_ray[ia], &hitT )
-      && ( hitT < aHitInfoPacket[ia].m_HitInfo.m_tHit ) )
-        return ia;
-
-    if( !aRayPacket.m_Frustum.Intersect( aBBox ) )
-        return RAYPACKET_RAYS_PER_PACKET;
-
-    for( unsigned int i = ia + 1; i < RAYPACKET_RAYS_PER_PACKET; ++i )
-    {
-        if( aBBox.Intersect( aRayPacket.m_ray[i], &hitT )
-          && ( hitT < aHitInfoPacket[i].m_HitInfo.m_tHit ) )
-            return i;
-    }
-
-    return RAYPACKET_RAYS_PER_PACKET;
-}
-
-
 #ifdef BVH_RANGED_TRAVERSAL
 
-static inline unsigned int getLastHit( const RAYPACKET& aRayPacket, const BBOX_3D& aBBox,
-                                       unsigned int ia, HITINFO_PACKET* aHitInfoPacket )
+/// @return the index of the lowest set bit of a non-zero ray mask
+static inline unsigned int firstRay( uint64_t aMask )
 {
-    for( unsigned int ie = (RAYPACKET_RAYS_PER_PACKET - 1); ie > ia; --ie )
-    {
-        float hitT;
+    unsigned int ray = 0;
 
-        if( aBBox.Intersect( aRayPacket.m_ray[ie], &hitT )
-          && ( hitT < aHitInfoPacket[ie].m_HitInfo.m_tHit ) )
-            return ie + 1;
-    }
+    while( !( aMask & ( (uint64_t) 1 << ray ) ) )
+        ray++;
 
-    return ia + 1;
+    return ray;
 }
 
 
@@ -103,14 +77,24 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
 
     unsigned int ia = 0;
 
+    // The node boxes are tested on all the rays of the packet at once, so keep the rays and
+    // their nearest hits in separate arrays for the vector kernel
+    const RAYPACKET_LANES lanes( aRayPacket );
+    alignas( 32 ) float   maxT[RAYPACKET_RAYS_PER_PACKET];
+
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+        maxT[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
+
     while( true )
     {
         const LinearBVHNode *curCell = &m_nodes[nodeNum];
 
-        ia = getFirstHit( aRayPacket, curCell->bounds, ia, aHitInfoPacket );
+        const uint64_t hits = RAYPACKET_IntersectBBox( lanes, curCell->bounds, maxT, ia );
 
-        if( ia < RAYPACKET_RAYS_PER_PACKET )
+        if( hits )
         {
+            ia = firstRay( hits );
+
             if( curCell->nPrimitives == 0 )
             {
                 StackNode& node = todo[todoOffset++];
@@ -121,17 +105,16 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
             }
             else
             {
-                const unsigned int ie = getLastHit( aRayPacket, curCell->bounds, ia,
-                                                    aHitInfoPacket );
-
                 for( int j = 0; j < curCell->nPrimitives; ++j )
                 {
                     const OBJECT_3D* obj = m_primitives[curCell->primitivesOffset + j];
 
                     if( aRayPacket.m_Frustum.Intersect( obj->GetBBox() ) )
                     {
-                        for( unsigned int i = ia; i < ie; ++i )
+                        // Only the rays entering the leaf box can hit its primitives
+                        for( uint64_t rays = hits; rays; rays &= rays - 1 )
                         {
+                            const unsigned int i = firstRay( rays );
                             const bool hit = obj->Intersect( aRayPacket.m_ray[i],
                                                              aHitInfoPacket[i].m_HitInfo );
 
@@ -140,6 +123,7 @@ bool BVH_PBRT::Intersect( const RAYPACKET& aRayPacket, HITINFO_PACKET* aHitInfoP
                                 anyHit |= hit;
                                 aHitInfoPacket[i].m_hitresult |= hit;
                                 aHitInfoPacket[i].m_HitInfo.m_acc_node_info = nodeNum;
+                                maxT[i] = aHitInfoPacket[i].m_HitInfo.m_tHit;
                             }
                         }
                     }
@@ -74,6 +74,7 @@
 #include <boost/range/algorithm/partition.hpp>
 #include <cstdlib>
 #include <vector>
+#include <core/thread_pool.h>
 
 #include <stack>
 #include <wx/debug.h>
@@ -103,6 +104,10 @@ struct BVHPrimitiveInfo
 };
 
 
+// Nodes with fewer primitives are not worth building both halves in parallel
+static constexpr int PARALLEL_BUILD_MIN_PRIMITIVES = 4096;
+
+
 struct BVHBuildNode
 {
     // BVHBuildNode Public Methods
@@ -275,9 +280,18 @@ BVH_PBRT::BVH_PBRT( const CONTAINER_3D_BASE& aObjectContainer, int aMaxPrimsInNo
     BVHBuildNode *root;
 
     if( m_splitMethod == SPLITMETHOD::HLBVH )
+    {
         root = HLBVHBuild( primitiveInfo, &totalNodes, orderedPrims );
+    }
     else
-        root = recursiveBuild( primitiveInfo, 0, m_primitives.size(), &totalNodes, orderedPrims );
+    {
+        std::atomic<int> nodeCount( 0 );
+
+        orderedPrims.resize( m_primitives.size() );
+        root = recursiveBuild( primitiveInfo, 0, m_primitives.size(), &nodeCount, orderedPrims,
+                               m_nodesToFree );
+        totalNodes = nodeCount;
+    }
 
     wxASSERT( m_primitives.size() == orderedPrims.size() );
 
@@ -423,9 +437,29 @@ struct BucketInfo
 };
 
 
+void BVH_PBRT::createLeaf( BVHBuildNode* node, const std::vector<BVHPrimitiveInfo>& primitiveInfo,
+                           int start, int end, const BBOX_3D& bounds,
+                           CONST_VECTOR_OBJECT& orderedPrims ) const
+{
+    // The primitives of a node stay in its range of _primitiveInfo_ while the tree is built, so
+    // they take the same range of _orderedPrims_ whatever the order the leaves are created in
+    for( int i = start; i < end; ++i )
+    {
+        const int primitiveNr = primitiveInfo[i].primitiveNumber;
+
+        wxASSERT( ( primitiveNr >= 0 ) && ( primitiveNr < (int) m_primitives.size() ) );
+
+        orderedPrims[i] = m_primitives[ primitiveNr ];
+    }
+
+    node->InitLeaf( start, end - start, bounds );
+}
+
+
 BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiveInfo,
-                                         int start, int end, int* totalNodes,
-                                         CONST_VECTOR_OBJECT& orderedPrims )
+                                         int start, int end, std::atomic<int>* totalNodes,
+                                         CONST_VECTOR_OBJECT& orderedPrims,
+                                         std::list<void*>& nodesToFree )
 {
     wxASSERT( totalNodes != nullptr );
     wxASSERT( start >= 0 );
@@ -439,7 +473,7 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
 
     // !TODO: implement an memory Arena
     BVHBuildNode *node = static_cast<BVHBuildNode *>( malloc( sizeof( BVHBuildNode ) ) );
-    m_nodesToFree.push_back( node );
+    nodesToFree.push_back( node );
 
     node->bounds.Reset();
     node->firstPrimOffset = 0;
@@ -460,16 +494,7 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
     if( nPrimitives == 1 )
     {
         // Create leaf _BVHBuildNode_
-        int firstPrimOffset = orderedPrims.size();
-
-        for( int i = start; i < end; ++i )
-        {
-            int primitiveNr = primitiveInfo[i].primitiveNumber;
-            wxASSERT( primitiveNr < (int)m_primitives.size() );
-            orderedPrims.push_back( m_primitives[ primitiveNr ] );
-        }
-
-        node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
+        createLeaf( node, primitiveInfo, start, end, bounds, orderedPrims );
     }
     else
     {
@@ -489,22 +514,7 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
                   centroidBounds.Min()[dim] ) < (FLT_EPSILON + FLT_EPSILON) )
         {
             // Create leaf _BVHBuildNode_
-            const int firstPrimOffset = orderedPrims.size();
-
-            for( int i = start; i < end; ++i )
-            {
-                int primitiveNr = primitiveInfo[i].primitiveNumber;
-
-                wxASSERT( ( primitiveNr >= 0 ) && ( primitiveNr < (int) m_primitives.size() ) );
-
-                const OBJECT_3D* obj = static_cast<const OBJECT_3D*>( m_primitives[ primitiveNr ] );
-
-                wxASSERT( obj != nullptr );
-
-                orderedPrims.push_back( obj );
-            }
-
-            node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
+            createLeaf( node, primitiveInfo, start, end, bounds, orderedPrims );
         }
         else
         {
@@ -582,39 +592,37 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
                         buckets[b].bounds.Union( primitiveInfo[i].bounds );
                     }
 
-                    // Compute costs for splitting after each bucket
-                    float cost[nBuckets - 1];
+                    // Compute costs for splitting after each bucket, sweeping the buckets once
+                    // from each end
+                    float   cost[nBuckets - 1];
+                    BBOX_3D b0, b1;
+                    int     count0 = 0;
+                    int     count1 = 0;
+
+                    b0.Reset();
+                    b1.Reset();
 
                     for( int i = 0; i < ( nBuckets - 1 ); ++i )
                     {
-                        BBOX_3D b0, b1;
-
-                        b0.Reset();
-                        b1.Reset();
-
-                        int count0 = 0;
-                        int count1 = 0;
-
-                        for( int j = 0; j <= i; ++j )
+                        if( buckets[i].count )
                         {
-                            if( buckets[j].count )
-                            {
-                                count0 += buckets[j].count;
-                                b0.Union( buckets[j].bounds );
-                            }
+                            count0 += buckets[i].count;
+                            b0.Union( buckets[i].bounds );
                         }
 
-                        for( int j = i + 1; j < nBuckets; ++j )
+                        cost[i] = count0 * b0.SurfaceArea();
+                    }
+
+                    for( int i = nBuckets - 2; i >= 0; --i )
+                    {
+                        if( buckets[i + 1].count )
                         {
-                            if( buckets[j].count )
-                            {
-                                count1 += buckets[j].count;
-                                b1.Union( buckets[j].bounds );
-                            }
+                            count1 += buckets[i + 1].count;
+                            b1.Union( buckets[i + 1].bounds );
                         }
 
-                        cost[i] = 1.0f + ( count0 * b0.SurfaceArea() +
-                                           count1 * b1.SurfaceArea() ) / bounds.SurfaceArea();
+                        cost[i] = 1.0f + ( cost[i] + count1 * b1.SurfaceArea() )
+                                                 / bounds.SurfaceArea();
                     }
 
                     // Find bucket to split at that minimizes SAH metric
@@ -644,18 +652,7 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
                     else
                     {
                         // Create leaf _BVHBuildNode_
-                        const int firstPrimOffset = orderedPrims.size();
-
-                        for( int i = start; i < end; ++i )
-                        {
-                            const int primitiveNr = primitiveInfo[i].primitiveNumber;
-
-                            wxASSERT( primitiveNr < (int)m_primitives.size() );
-
-                            orderedPrims.push_back( m_primitives[ primitiveNr ] );
-                        }
-
-                        node->InitLeaf( firstPrimOffset, nPrimitives, bounds );
+                        createLeaf( node, primitiveInfo, start, end, bounds, orderedPrims );
 
                         return node;
                     }
@@ -664,10 +661,36 @@ BVHBuildNode *BVH_PBRT::recursiveBuild ( std::vector<BVHPrimitiveInfo>& primitiv
             }
             }
 
-            node->InitInterior( dim, recursiveBuild( primitiveInfo, start, mid, totalNodes,
-                                                     orderedPrims ),
-                                recursiveBuild( primitiveInfo, mid, end, totalNodes,
-                                                orderedPrims) );
+            BVHBuildNode* children[2];
+
+            if( nPrimitives >= PARALLEL_BUILD_MIN_PRIMITIVES )
+            {
+                // The two halves own separate ranges of _primitiveInfo_ and _orderedPrims_, so
+                // they can be built in parallel
+                std::list<void*> childNodes[2];
+                const int        childStart[2] = { start, mid };
+                const int        childEnd[2] = { mid, end };
+
+                ParallelFor( 2,
+                        [&]( size_t aChild )
+                        {
+                            children[aChild] = recursiveBuild( primitiveInfo, childStart[aChild],
+                                                               childEnd[aChild], totalNodes,
+                                                               orderedPrims, childNodes[aChild] );
+                        } );
+
+                nodesToFree.splice( nodesToFree.end(), childNodes[0] );
+                nodesToFree.splice( nodesToFree.end(), childNodes[1] );
+            }
+            else
+            {
+                children[0] = recursiveBuild( primitiveInfo, start, mid, totalNodes, orderedPrims,
+                                              nodesToFree );
+                children[1] = recursiveBuild( primitiveInfo, mid, end, totalNodes, orderedPrims,
+                                              nodesToFree );
+            }
+
+            node->InitInterior( dim, children[0], children[1] );
         }
     }
 
@@ -756,27 +779,31 @@ BVHBuildNode *BVH_PBRT::HLBVHBuild( const std::vector<BVHPrimitiveInfo>& primiti
     }
 
     // Create LBVHs for treelets in parallel
-    int atomicTotal = 0;
-    int orderedPrimsOffset = 0;
+    std::atomic<int> atomicTotal( 0 );
 
     orderedPrims.resize( m_primitives.size() );
 
-    for( int index = 0; index < (int)treeletsToBuild.size(); ++index )
-    {
-        // Generate _index_th LBVH treelet
-        int nodesCreated = 0;
-        const int firstBit = 29 - 12;
+    ParallelFor( treeletsToBuild.size(),
+            [&]( size_t index )
+            {
+                // Generate _index_th LBVH treelet
+                int nodesCreated = 0;
+                const int firstBit = 29 - 12;
 
-        LBVHTreelet &tr = treeletsToBuild[index];
+                LBVHTreelet &tr = treeletsToBuild[index];
 
-        wxASSERT( tr.startIndex < (int)mortonPrims.size() );
+                wxASSERT( tr.startIndex < (int)mortonPrims.size() );
 
-        tr.buildNodes = emitLBVH( tr.buildNodes, primitiveInfo, &mortonPrims[tr.startIndex],
-                                  tr.numPrimitives, &nodesCreated, orderedPrims,
-                                  &orderedPrimsOffset, firstBit );
+                // The treelets take consecutive ranges of _orderedPrims_ in Morton order
+                int orderedPrimsOffset = tr.startIndex;
 
-        atomicTotal += nodesCreated;
-    }
+                tr.buildNodes = emitLBVH( tr.buildNodes, primitiveInfo,
+                                          &mortonPrims[tr.startIndex], tr.numPrimitives,
+                                          &nodesCreated, orderedPrims, &orderedPrimsOffset,
+                                          firstBit );
+
+                atomicTotal += nodesCreated;
+            } );
 
     *totalNodes = atomicTotal;
 
@@ -71,6 +71,7 @@
 #define _BVH_PBRT_H_
 
 #include "accelerator_3d.h"
+#include <atomic>
 #include <cstdint>
 #include <list>
 
@@ -121,8 +122,21 @@ public:
     bool IntersectP( const RAY& aRay, float aMaxDistance ) const override;
 
 private:
+    /**
+     * Build the subtree of the primitives from \a start to \a end of \a primitiveInfo, the two
+     * halves of large subtrees being built in parallel.
+     *
+     * @param orderedPrims must already have room for all the primitives.
+     * @param nodesToFree receives the nodes allocated for the subtree.
+     */
     BVHBuildNode* recursiveBuild( std::vector<BVHPrimitiveInfo>& primitiveInfo, int start,
-                                  int end, int* totalNodes, CONST_VECTOR_OBJECT& orderedPrims );
+                                  int end, std::atomic<int>* totalNodes,
+                                  CONST_VECTOR_OBJECT& orderedPrims,
+                                  std::list<void*>& nodesToFree );
+
+    void createLeaf( BVHBuildNode* node, const std::vector<BVHPrimitiveInfo>& primitiveInfo,
+                     int start, int end, const BBOX_3D& bounds,
+                     CONST_VECTOR_OBJECT& orderedPrims ) const;
 
     BVHBuildNode* HLBVHBuild( const std::vector<BVHPrimitiveInfo>& primitiveInfo,
                               int* totalNodes, CONST_VECTOR_OBJECT& orderedPrims );
@@ -0,0 +1,247 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+
+// On x86-64 the AVX kernel is built even when the compiler does not target AVX by default, and
+// selected at runtime if the CPU supports it.
+#if defined( __AVX__ )
+#define RAY_KERNEL_AVX
+#define RAY_KERNEL_AVX_TARGET
+#elif defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define RAY_KERNEL_AVX
+#define RAY_KERNEL_AVX_TARGET __attribute__( ( target( "avx" ) ) )
+#define RAY_KERNEL_AVX_DISPATCH
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+#define RAY_KERNEL_NEON
+#endif
+
+#if defined( RAY_KERNEL_AVX )
+#include <immintrin.h>
+#elif defined( RAY_KERNEL_NEON )
+#include <arm_neon.h>
+#endif
+
+#include "raypacket_kernel.h"
+
+
+RAYPACKET_LANES::RAYPACKET_LANES( const RAYPACKET& aRayPacket )
+{
+    for( unsigned int i = 0; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        const RAY& ray = aRayPacket.m_ray[i];
+
+        m_originX[i] = ray.m_Origin.x;
+        m_originY[i] = ray.m_Origin.y;
+        m_originZ[i] = ray.m_Origin.z;
+        m_invDirX[i] = ray.m_InvDir.x;
+        m_invDirY[i] = ray.m_InvDir.y;
+        m_invDirZ[i] = ray.m_InvDir.z;
+    }
+}
+
+
+/// Mask of the rays from \a aFirst on
+static inline uint64_t firstRaysMask( unsigned int aFirst )
+{
+    return ~(uint64_t) 0 << aFirst;
+}
+
+
+static uint64_t intersectScalar( const RAYPACKET_LANES& aLanes, const BBOX_3D& aBBox,
+                                 const float* aMaxT, unsigned int aFirst )
+{
+    const SFVEC3F& bmin = aBBox.Min();
+    const SFVEC3F& bmax = aBBox.Max();
+    uint64_t       mask = 0;
+
+    for( unsigned int i = aFirst; i < RAYPACKET_RAYS_PER_PACKET; ++i )
+    {
+        float t0 = ( bmin.x - aLanes.m_originX[i] ) * aLanes.m_invDirX[i];
+        float t1 = ( bmax.x - aLanes.m_originX[i] ) * aLanes.m_invDirX[i];
+        float tNear = std::min( t0, t1 );
+        float tFar = std::max( t0, t1 );
+
+        t0 = ( bmin.y - aLanes.m_originY[i] ) * aLanes.m_invDirY[i];
+        t1 = ( bmax.y - aLanes.m_originY[i] ) * aLanes.m_invDirY[i];
+        tNear = std::max( tNear, std::min( t0, t1 ) );
+        tFar = std::min( tFar, std::max( t0, t1 ) );
+
+        t0 = ( bmin.z - aLanes.m_originZ[i] ) * aLanes.m_invDirZ[i];
+        t1 = ( bmax.z - aLanes.m_originZ[i] ) * aLanes.m_invDirZ[i];
+        tNear = std::max( tNear, std::min( t0, t1 ) );
+        tFar = std::min( tFar, std::max( t0, t1 ) );
+
+        if( tFar >= std::max( tNear, 0.0f ) && tNear < aMaxT[i] )
+            mask |= (uint64_t) 1 << i;
+    }
+
+    return mask;
+}
+
+
+#if defined( RAY_KERNEL_AVX )
+
+RAY_KERNEL_AVX_TARGET
+static uint64_t intersectVector( const RAYPACKET_LANES& aLanes, const BBOX_3D& aBBox,
+                                 const float* aMaxT, unsigned int aFirst )
+{
+    const __m256 minX = _mm256_set1_ps( aBBox.Min().x );
+    const __m256 minY = _mm256_set1_ps( aBBox.Min().y );
+    const __m256 minZ = _mm256_set1_ps( aBBox.Min().z );
+    const __m256 maxX = _mm256_set1_ps( aBBox.Max().x );
+    const __m256 maxY = _mm256_set1_ps( aBBox.Max().y );
+    const __m256 maxZ = _mm256_set1_ps( aBBox.Max().z );
+    const __m256 zero = _mm256_setzero_ps();
+    uint64_t     mask = 0;
+
+    // Start at the block holding aFirst; the rays before it are masked out at the end
+    for( unsigned int i = aFirst & ~7u; i < RAYPACKET_RAYS_PER_PACKET; i += 8 )
+    {
+        __m256 ox = _mm256_load_ps( aLanes.m_originX + i );
+        __m256 ix = _mm256_load_ps( aLanes.m_invDirX + i );
+        __m256 t0 = _mm256_mul_ps( _mm256_sub_ps( minX, ox ), ix );
+        __m256 t1 = _mm256_mul_ps( _mm256_sub_ps( maxX, ox ), ix );
+        __m256 tNear = _mm256_min_ps( t0, t1 );
+        __m256 tFar = _mm256_max_ps( t0, t1 );
+
+        __m256 oy = _mm256_load_ps( aLanes.m_originY + i );
+        __m256 iy = _mm256_load_ps( aLanes.m_invDirY + i );
+        t0 = _mm256_mul_ps( _mm256_sub_ps( minY, oy ), iy );
+        t1 = _mm256_mul_ps( _mm256_sub_ps( maxY, oy ), iy );
+        tNear = _mm256_max_ps( tNear, _mm256_min_ps( t0, t1 ) );
+        tFar = _mm256_min_ps( tFar, _mm256_max_ps( t0, t1 ) );
+
+        __m256 oz = _mm256_load_ps( aLanes.m_originZ + i );
+        __m256 iz = _mm256_load_ps( aLanes.m_invDirZ + i );
+        t0 = _mm256_mul_ps( _mm256_sub_ps( minZ, oz ), iz );
+        t1 = _mm256_mul_ps( _mm256_sub_ps( maxZ, oz ), iz );
+        tNear = _mm256_max_ps( tNear, _mm256_min_ps( t0, t1 ) );
+        tFar = _mm256_min_ps( tFar, _mm256_max_ps( t0, t1 ) );
+
+        __m256 hit = _mm256_and_ps(
+                _mm256_cmp_ps( tFar, _mm256_max_ps( tNear, zero ), _CMP_GE_OQ ),
+                _mm256_cmp_ps( tNear, _mm256_loadu_ps( aMaxT + i ), _CMP_LT_OQ ) );
+
+        mask |= (uint64_t) (unsigned int) _mm256_movemask_ps( hit ) << i;
+    }
+
+    return mask & firstRaysMask( aFirst );
+}
+
+
+static bool vectorKernelAvailable()
+{
+#if defined( RAY_KERNEL_AVX_DISPATCH )
+    static const bool available = __builtin_cpu_supports( "avx" );
+    return available;
+#else
+    return true;
+#endif
+}
+
+#elif defined( RAY_KERNEL_NEON )
+
+/**
+ * @return a bit mask of which of the four rays starting at \a aIndex hit the box.
+ */
+static inline unsigned int hitMask4( const RAYPACKET_LANES& aLanes, const float32x4_t* aMin,
+                                     const float32x4_t* aMax, const float* aMaxT,
+                                     unsigned int aIndex )
+{
+    const float* origins[3] = { aLanes.m_originX, aLanes.m_originY, aLanes.m_originZ };
+    const float* invDirs[3] = { aLanes.m_invDirX, aLanes.m_invDirY, aLanes.m_invDirZ };
+    float32x4_t  tNear = vdupq_n_f32( 0.0f );
+    float32x4_t  tFar = vdupq_n_f32( 0.0f );
+
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        float32x4_t o = vld1q_f32( origins[axis] + aIndex );
+        float32x4_t inv = vld1q_f32( invDirs[axis] + aIndex );
+        float32x4_t t0 = vmulq_f32( vsubq_f32( aMin[axis], o ), inv );
+        float32x4_t t1 = vmulq_f32( vsubq_f32( aMax[axis], o ), inv );
+
+        if( axis == 0 )
+        {
+            tNear = vminq_f32( t0, t1 );
+            tFar = vmaxq_f32( t0, t1 );
+        }
+        else
+        {
+            tNear = vmaxq_f32( tNear, vminq_f32( t0, t1 ) );
+            tFar = vminq_f32( tFar, vmaxq_f32( t0, t1 ) );
+        }
+    }
+
+    uint32x4_t hit = vandq_u32( vcgeq_f32( tFar, vmaxq_f32( tNear, vdupq_n_f32( 0.0f ) ) ),
+                                vcltq_f32( tNear, vld1q_f32( aMaxT + aIndex ) ) );
+
+    return   ( vgetq_lane_u32( hit, 0 ) ? 1 : 0 ) | ( vgetq_lane_u32( hit, 1 ) ? 2 : 0 )
+           | ( vgetq_lane_u32( hit, 2 ) ? 4 : 0 ) | ( vgetq_lane_u32( hit, 3 ) ? 8 : 0 );
+}
+
+
+static uint64_t intersectVector( const RAYPACKET_LANES& aLanes, const BBOX_3D& aBBox,
+                                 const float* aMaxT, unsigned int aFirst )
+{
+    const float32x4_t bmin[3] = { vdupq_n_f32( aBBox.Min().x ), vdupq_n_f32( aBBox.Min().y ),
+                                  vdupq_n_f32( aBBox.Min().z ) };
+    const float32x4_t bmax[3] = { vdupq_n_f32( aBBox.Max().x ), vdupq_n_f32( aBBox.Max().y ),
+                                  vdupq_n_f32( aBBox.Max().z ) };
+    uint64_t          mask = 0;
+
+    // Start at the block holding aFirst; the rays before it are masked out at the end
+    for( unsigned int i = aFirst & ~7u; i < RAYPACKET_RAYS_PER_PACKET; i += 8 )
+    {
+        unsigned int hits = hitMask4( aLanes, bmin, bmax, aMaxT, i )
+                            | ( hitMask4( aLanes, bmin, bmax, aMaxT, i + 4 ) << 4 );
+
+        mask |= (uint64_t) hits << i;
+    }
+
+    return mask & firstRaysMask( aFirst );
+}
+
+
+static bool vectorKernelAvailable()
+{
+    return true;
+}
+
+#endif
+
+
+uint64_t RAYPACKET_IntersectBBox( const RAYPACKET_LANES& aLanes, const BBOX_3D& aBBox,
+                                  const float* aMaxT, unsigned int aFirst )
+{
+    if( aFirst >= RAYPACKET_RAYS_PER_PACKET )
+        return 0;
+
+#if defined( RAY_KERNEL_AVX ) || defined( RAY_KERNEL_NEON )
+    if( vectorKernelAvailable() )
+        return intersectVector( aLanes, aBBox, aMaxT, aFirst );
+#endif
+
+    return intersectScalar( aLanes, aBBox, aMaxT, aFirst );
+}
@@ -0,0 +1,68 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef RAYPACKET_KERNEL_H
+#define RAYPACKET_KERNEL_H
+
+#include <cstdint>
+
+#include "raypacket.h"
+#include "shapes3D/bbox_3d.h"
+
+static_assert( RAYPACKET_RAYS_PER_PACKET <= 64, "ray packet masks are 64 bits" );
+static_assert( RAYPACKET_RAYS_PER_PACKET % 8 == 0, "ray packet kernels work on 8 rays" );
+
+
+/**
+ * The origins and inverse directions of the rays of a packet, one array per coordinate, for the
+ * vector kernels.
+ */
+struct RAYPACKET_LANES
+{
+    explicit RAYPACKET_LANES( const RAYPACKET& aRayPacket );
+
+    alignas( 32 ) float m_originX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_originY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_originZ[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_invDirX[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_invDirY[RAYPACKET_RAYS_PER_PACKET];
+    alignas( 32 ) float m_invDirZ[RAYPACKET_RAYS_PER_PACKET];
+};
+
+
+/**
+ * Test the rays of a packet against a box with the slab method, eight rays per iteration (AVX
+ * or NEON when available, otherwise a plain loop).
+ *
+ * A ray hits the box if it enters it in front of its origin, or starts inside it, closer than
+ * its entry in \a aMaxT.
+ *
+ * @param aMaxT is the distance of the nearest hit found so far for each ray.
+ * @param aFirst is the first ray to test.
+ * @return a bit mask of the rays hitting the box, bit i being ray i.
+ */
+uint64_t RAYPACKET_IntersectBBox( const RAYPACKET_LANES& aLanes, const BBOX_3D& aBBox,
+                                  const float* aMaxT, unsigned int aFirst );
+
+#endif // RAYPACKET_KERNEL_H
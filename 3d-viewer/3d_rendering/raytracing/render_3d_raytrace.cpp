@@ -36,6 +36,7 @@
 #include "3d_math.h"
 #include "../common_ogl/ogl_utils.h"
 #include <core/profile.h>        // To use GetRunningMicroSecs or another profiling utility
+#include <core/thread_pool.h>
 #include <wx/log.h>
 
 
@@ -85,6 +86,8 @@ RENDER_3D_RAYTRACE::~RENDER_3D_RAYTRACE()
     delete[] m_shaderBuffer;
     m_shaderBuffer = nullptr;
 
+    m_postShaderSsaoGpu.Release();
+
     deletePbo();
 }
 
@@ -350,15 +353,17 @@ void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReport
 
     std::atomic<size_t> numBlocksRendered( 0 );
     std::atomic<size_t> currentBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
 
     size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+            GetThreadBudget( THREAD_SUBSYSTEM::RAYTRACE ),
             m_blockPositions.size() );
 
+    thread_pool&           tp = GetKiCadThreadPool();
+    BS::multi_future<void> futures;
+
     for( size_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        std::thread t = std::thread( [&]()
+        futures.push_back( tp.submit( [&]()
         {
             for( size_t iBlock = currentBlock.fetch_add( 1 );
                  iBlock < m_blockPositions.size() && !breakLoop;
@@ -377,15 +382,10 @@ void RENDER_3D_RAYTRACE::renderTracing( GLubyte* ptrPBO, REPORTER* aStatusReport
                         breakLoop = true;
                 }
             }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
+        } ) );
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    futures.wait();
 
     m_blockRenderProgressCount += numBlocksRendered;
 
@@ -842,36 +842,38 @@ void RENDER_3D_RAYTRACE::postProcessShading( GLubyte* /* ptrPBO */, REPORTER* aS
 
         m_postShaderSsao.SetShadowsEnabled( m_boardAdapter.m_Cfg->m_Render.raytrace_shadows );
 
-        std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
+        // Run the shader on the GPU when the OpenGL context can, else on the CPU
+        if( !m_boardAdapter.m_Cfg->m_Render.raytrace_gpu_post_processing
+          || !m_postShaderSsaoGpu.Shade( m_postShaderSsao, m_shaderBuffer ) )
+        {
+            std::atomic<size_t> nextBlock( 0 );
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+            size_t parallelThreadCount = GetThreadBudget( THREAD_SUBSYSTEM::RAYTRACE );
 
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
+            thread_pool&           tp = GetKiCadThreadPool();
+            BS::multi_future<void> futures;
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
             {
-                for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
-                     y = nextBlock.fetch_add( 1 ) )
+                futures.push_back( tp.submit( [&]()
                 {
-                    SFVEC3F* ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
-
-                    for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                    for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
+                         y = nextBlock.fetch_add( 1 ) )
                     {
-                        *ptr = m_postShaderSsao.Shade( SFVEC2I( x, y ) );
-                        ptr++;
-                    }
-                }
+                        SFVEC3F* ptr = &m_shaderBuffer[ y * m_realBufferSize.x ];
 
-                threadsFinished++;
-            } );
+                        for( signed int x = 0; x < (int)m_realBufferSize.x; ++x )
+                        {
+                            *ptr = m_postShaderSsao.Shade( SFVEC2I( x, y ) );
+                            ptr++;
+                        }
+                    }
+                } ) );
+            }
 
-            t.detach();
+            futures.wait();
         }
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-
         m_postShaderSsao.SetShadedBuffer( m_shaderBuffer );
 
         // Set next state
@@ -891,13 +893,15 @@ void RENDER_3D_RAYTRACE::postProcessBlurFinish( GLubyte* ptrPBO, REPORTER* /* aS
     {
         // Now blurs the shader result and compute the final color
         std::atomic<size_t> nextBlock( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
 
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+        size_t parallelThreadCount = GetThreadBudget( THREAD_SUBSYSTEM::RAYTRACE );
+
+        thread_pool&           tp = GetKiCadThreadPool();
+        BS::multi_future<void> futures;
 
         for( size_t ii = 0; ii < parallelThreadCount; ++ii )
         {
-            std::thread t = std::thread( [&]()
+            futures.push_back( tp.submit( [&]()
             {
                 for( size_t y = nextBlock.fetch_add( 1 ); y < m_realBufferSize.y;
                      y = nextBlock.fetch_add( 1 ) )
@@ -923,15 +927,10 @@ void RENDER_3D_RAYTRACE::postProcessBlurFinish( GLubyte* ptrPBO, REPORTER* /* aS
                         ptr += 4;
                     }
                 }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
+            } ) );
         }
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        futures.wait();
 
         // Debug code
         //m_postShaderSsao.DebugBuffersOutputAsImages();
@@ -947,15 +946,17 @@ void RENDER_3D_RAYTRACE::renderPreview( GLubyte* ptrPBO )
     m_isPreview = true;
 
     std::atomic<size_t> nextBlock( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
 
     size_t parallelThreadCount = std::min<size_t>(
-            std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
+            GetThreadBudget( THREAD_SUBSYSTEM::RAYTRACE ),
             m_blockPositions.size() );
 
+    thread_pool&           tp = GetKiCadThreadPool();
+    BS::multi_future<void> futures;
+
     for( size_t ii = 0; ii < parallelThreadCount; ++ii )
     {
-        std::thread t = std::thread( [&]()
+        futures.push_back( tp.submit( [&]()
         {
             for( size_t iBlock = nextBlock.fetch_add( 1 ); iBlock < m_blockPositionsFast.size();
                  iBlock = nextBlock.fetch_add( 1 ) )
@@ -1524,15 +1525,10 @@ void RENDER_3D_RAYTRACE::renderPreview( GLubyte* ptrPBO )
                     }
                 }
             }
-
-            threadsFinished++;
-        } );
-
-        t.detach();
+        } ) );
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+    futures.wait();
 }
 
 
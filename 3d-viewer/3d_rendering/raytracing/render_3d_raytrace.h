@@ -31,6 +31,7 @@
 #include "../render_3d_base.h"
 #include "light.h"
 #include "../post_shader_ssao.h"
+#include "../post_shader_ssao_gpu.h"
 #include "material.h"
 #include <plugins/3dapi/c3dmodel.h>
 
@@ -160,6 +161,7 @@ private:
     size_t m_blockRenderProgressCount;
 
     POST_SHADER_SSAO m_postShaderSsao;
+    POST_SHADER_SSAO_GPU m_postShaderSsaoGpu;
 
     std::list<LIGHT*> m_lights;
 
@@ -29,6 +29,7 @@
 #include "polygon_2d.h"
 #include "../ray.h"
 #include <wx/debug.h>
+#include <clipper.hpp>
 
 
 static bool polygon_IsPointInside( const SEGMENTS& aSegments, const SFVEC2F& aPoint )
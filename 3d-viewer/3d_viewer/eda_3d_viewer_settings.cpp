@@ -242,6 +242,8 @@ EDA_3D_VIEWER_SETTINGS::EDA_3D_VIEWER_SETTINGS() :
                                             &m_Render.raytrace_backfloor, false ) );
     m_params.emplace_back( new PARAM<bool>( "render.raytrace_post_processing",
                                             &m_Render.raytrace_post_processing, true ) );
+    m_params.emplace_back( new PARAM<bool>( "render.raytrace_gpu_post_processing",
+                                            &m_Render.raytrace_gpu_post_processing, true ) );
     m_params.emplace_back( new PARAM<bool>( "render.raytrace_procedural_textures",
                                              &m_Render.raytrace_procedural_textures, true ) );
     m_params.emplace_back( new PARAM<bool>( "render.raytrace_reflections",
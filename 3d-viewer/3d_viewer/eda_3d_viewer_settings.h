@@ -97,6 +97,7 @@ public:
         bool raytrace_anti_aliasing;
         bool raytrace_backfloor;
         bool raytrace_post_processing;
+        bool raytrace_gpu_post_processing;   ///< Run the post processing on the GPU if possible
         bool raytrace_procedural_textures;
         bool raytrace_reflections;
         bool raytrace_refractions;
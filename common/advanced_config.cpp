@@ -68,6 +68,7 @@ static const wxChar DRCEpsilon[] = wxT( "DRCEpsilon" );
 static const wxChar DRCSliverWidthTolerance[] = wxT( "DRCSliverWidthTolerance" );
 static const wxChar DRCSliverMinimumLength[] = wxT( "DRCSliverMinimumLength" );
 static const wxChar DRCSliverAngleTolerance[] = wxT( "DRCSliverAngleTolerance" );
+static const wxChar DRCTileSize[] = wxT( "DRCTileSize" );
 static const wxChar HoleWallThickness[] = wxT( "HoleWallPlatingThickness" );
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 static const wxChar ShowRouterDebugGraphics[] = wxT( "ShowRouterDebugGraphics" );
@@ -82,6 +83,12 @@ static const wxChar StrokeTriangulation[] = wxT( "StrokeTriangulation" );
 static const wxChar ExtraZoneDisplayModes[] = wxT( "ExtraZoneDisplayModes" );
 static const wxChar MinPlotPenWidth[] = wxT( "MinPlotPenWidth" );
 static const wxChar DebugZoneFiller[] = wxT( "DebugZoneFiller" );
+static const wxChar IncrementalZoneRefill[] = wxT( "IncrementalZoneRefill" );
+static const wxChar DraftZoneRefill[] = wxT( "DraftZoneRefill" );
+static const wxChar DraftZoneFillMaxError[] = wxT( "DraftZoneFillMaxError" );
+static const wxChar DraftZoneRefillDelay[] = wxT( "DraftZoneRefillDelay" );
+static const wxChar AsyncRatsnestMinChanges[] = wxT( "AsyncRatsnestMinChanges" );
+static const wxChar BoardCacheMinSize[] = wxT( "BoardCacheMinSize" );
 static const wxChar DebugPDFWriter[] = wxT( "DebugPDFWriter" );
 static const wxChar SmallDrillMarkSize[] = wxT( "SmallDrillMarkSize" );
 static const wxChar HotkeysDumper[] = wxT( "HotkeysDumper" );
@@ -93,17 +100,23 @@ static const wxChar HideVersionFromTitle[] = wxT( "HideVersionFromTitle" );
 static const wxChar TraceMasks[] = wxT( "TraceMasks" );
 static const wxChar ShowRepairSchematic[] = wxT( "ShowRepairSchematic" );
 static const wxChar ShowEventCounters[] = wxT( "ShowEventCounters" );
+static const wxChar ShowRenderStatistics[] = wxT( "ShowRenderStatistics" );
 static const wxChar AllowManualCanvasScale[] = wxT( "AllowManualCanvasScale" );
 static const wxChar UpdateUIEventInterval[] = wxT( "UpdateUIEventInterval" );
 static const wxChar V3DRT_BevelHeight_um[] = wxT( "V3DRT_BevelHeight_um" );
 static const wxChar V3DRT_BevelExtentFactor[] = wxT( "V3DRT_BevelExtentFactor" );
-static const wxChar UseClipper2[] = wxT( "UseClipper2" );
 static const wxChar EnableGenerators[] = wxT( "EnableGenerators" );
 static const wxChar EnableGit[] = wxT( "EnableGit" );
 static const wxChar EnableEeschemaPrintCairo[] = wxT( "EnableEeschemaPrintCairo" );
 static const wxChar DisambiguationTime[] = wxT( "DisambiguationTime" );
 static const wxChar PcbSelectionVisibilityRatio[] = wxT( "PcbSelectionVisibilityRatio" );
 static const wxChar MinimumSegmentLength[] = wxT( "MinimumSegmentLength" );
+static const wxChar MaximumThreads[] = wxT( "MaximumThreads" );
+static const wxChar ZoneFillThreads[] = wxT( "ZoneFillThreads" );
+static const wxChar DRCThreads[] = wxT( "DRCThreads" );
+static const wxChar ConnectivityThreads[] = wxT( "ConnectivityThreads" );
+static const wxChar V3DRT_Threads[] = wxT( "V3DRT_Threads" );
+static const wxChar TraceProfileFile[] = wxT( "TraceProfileFile" );
 } // namespace KEYS
 
 
@@ -207,6 +220,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_SliverWidthTolerance      = 0.08;
     m_SliverMinimumLength       = 0.0008;
     m_SliverAngleTolerance      = 20.0;
+    m_DRCTileSize               = 0.0;
 
     m_HoleWallThickness         = 0.020;    // IPC-6012 says 15-18um; Cadence says at least
                                             // 0.020 for a Class 2 board and at least 0.025
@@ -215,6 +229,12 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_MinPlotPenWidth           = 0.0212;   // 1 pixel at 1200dpi.
 
     m_DebugZoneFiller           = false;
+    m_IncrementalZoneRefill     = true;
+    m_DraftZoneRefill           = false;
+    m_DraftZoneFillMaxError     = 0.05;
+    m_DraftZoneRefillDelay      = 3000;
+    m_AsyncRatsnestMinChanges   = 200;
+    m_BoardCacheMinSize         = 0;
     m_DebugPDFWriter            = false;
     m_SmallDrillMarkSize        = 0.35;
     m_HotkeysDumper             = false;
@@ -224,6 +244,7 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_Skip3DModelMemoryCache    = false;
     m_HideVersionFromTitle      = false;
     m_ShowEventCounters         = false;
+    m_ShowRenderStatistics      = false;
     m_AllowManualCanvasScale    = false;
     m_CompactSave               = false;
     m_UpdateUIEventInterval     = 0;
@@ -236,8 +257,6 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_3DRT_BevelHeight_um       = 30;
     m_3DRT_BevelExtentFactor    = 1.0 / 16.0;
 
-    m_UseClipper2               = true;
-
     m_Use3DConnexionDriver      = true;
 
     m_IncrementalConnectivity   = true;
@@ -248,6 +267,12 @@ ADVANCED_CFG::ADVANCED_CFG()
 
     m_MinimumSegmentLength      = 50;
 
+    m_MaximumThreads            = 0;
+    m_ZoneFillThreads           = 0;
+    m_DRCThreads                = 0;
+    m_ConnectivityThreads       = 0;
+    m_3DRT_Threads              = 0;
+
     loadFromConfigFile();
 }
 
@@ -309,6 +334,9 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   &m_SliverAngleTolerance, m_SliverAngleTolerance,
                                                   1.0, 90.0 ) );
 
+    configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::DRCTileSize,
+                                                  &m_DRCTileSize, m_DRCTileSize, 0.0, 10000.0 ) );
+
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::HoleWallThickness,
                                                   &m_HoleWallThickness, m_HoleWallThickness,
                                                   0.0, 1.0 ) );
@@ -365,6 +393,29 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugZoneFiller,
                                                 &m_DebugZoneFiller, m_DebugZoneFiller ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::IncrementalZoneRefill,
+                                                &m_IncrementalZoneRefill,
+                                                m_IncrementalZoneRefill ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DraftZoneRefill,
+                                                &m_DraftZoneRefill, m_DraftZoneRefill ) );
+
+    configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::DraftZoneFillMaxError,
+                                                  &m_DraftZoneFillMaxError,
+                                                  m_DraftZoneFillMaxError, 0.005, 1.0 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::DraftZoneRefillDelay,
+                                               &m_DraftZoneRefillDelay, m_DraftZoneRefillDelay,
+                                               100, 600000 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::AsyncRatsnestMinChanges,
+                                               &m_AsyncRatsnestMinChanges,
+                                               m_AsyncRatsnestMinChanges, 0, 1000000 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::BoardCacheMinSize,
+                                               &m_BoardCacheMinSize, m_BoardCacheMinSize,
+                                               0, 100000 ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::DebugPDFWriter,
                                                 &m_DebugPDFWriter, m_DebugPDFWriter ) );
 
@@ -397,6 +448,10 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowEventCounters,
                                                 &m_ShowEventCounters, m_ShowEventCounters ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowRenderStatistics,
+                                                &m_ShowRenderStatistics,
+                                                m_ShowRenderStatistics ) );
+
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::AllowManualCanvasScale,
                                                 &m_AllowManualCanvasScale,
                                                 m_AllowManualCanvasScale ) );
@@ -411,9 +466,6 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   m_3DRT_BevelExtentFactor, 0.0, 100.0,
                                                   AC_GROUPS::V3D_RayTracing ) );
 
-    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::UseClipper2,
-                                                &m_UseClipper2, m_UseClipper2 ) );
-
     configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::Use3DConnexionDriver,
                                                 &m_Use3DConnexionDriver, m_Use3DConnexionDriver ) );
 
@@ -444,6 +496,26 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                   &m_MinimumSegmentLength,
                                                   m_MinimumSegmentLength, 10, 1000 ) );
 
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::MaximumThreads,
+                                               &m_MaximumThreads, m_MaximumThreads, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ZoneFillThreads,
+                                               &m_ZoneFillThreads, m_ZoneFillThreads, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::DRCThreads,
+                                               &m_DRCThreads, m_DRCThreads, 0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::ConnectivityThreads,
+                                               &m_ConnectivityThreads, m_ConnectivityThreads,
+                                               0, 1024 ) );
+
+    configParams.push_back( new PARAM_CFG_INT( true, AC_KEYS::V3DRT_Threads,
+                                               &m_3DRT_Threads, m_3DRT_Threads, 0, 1024,
+                                               AC_GROUPS::V3D_RayTracing ) );
+
+    configParams.push_back( new PARAM_CFG_WXSTRING( true, AC_KEYS::TraceProfileFile,
+                                                    &m_TraceProfileFile, wxS( "" ) ) );
+
     // Special case for trace mask setting...we just grab them and set them immediately
     // Because we even use wxLogTrace inside of advanced config
     wxString traceMasks;
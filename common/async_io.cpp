@@ -0,0 +1,202 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <list>
+
+#include <wx/ffile.h>
+
+#include <async_io.h>
+#include <core/trace_profiler.h>
+
+
+ASYNC_IO_SCHEDULER::ASYNC_IO_SCHEDULER( thread_pool& aPool ) :
+        m_pool( aPool ),
+        m_current( nullptr ),
+        m_maxActive( 0 ),
+        m_cancelled( false )
+{
+}
+
+
+ASYNC_IO_SCHEDULER::~ASYNC_IO_SCHEDULER()
+{
+}
+
+
+void ASYNC_IO_SCHEDULER::AddJob( JOB_FUNC aJob )
+{
+    m_jobs.emplace_back( std::make_unique<JOB>() );
+    m_jobs.back()->m_func = std::move( aJob );
+}
+
+
+int ASYNC_IO_SCHEDULER::runJob( JOB* aJob )
+{
+    // Exceptions must not unwind across the coroutine boundary
+    try
+    {
+        aJob->m_func( *this );
+    }
+    catch( ... )
+    {
+        if( !m_error )
+            m_error = std::current_exception();
+    }
+
+    return 0;
+}
+
+
+void ASYNC_IO_SCHEDULER::suspend()
+{
+    m_current->m_coroutine->KiYield();
+}
+
+
+void ASYNC_IO_SCHEDULER::RunOnMainStack( std::function<void()> aFunc )
+{
+    if( m_current )
+        m_current->m_coroutine->RunMainStack( std::move( aFunc ) );
+    else
+        aFunc();
+}
+
+
+bool ASYNC_IO_SCHEDULER::Run( const std::function<bool()>& aIdleCallback,
+                              std::chrono::milliseconds aPollInterval )
+{
+    TRACE_SCOPE( "ASYNC_IO_SCHEDULER::Run" );
+
+    size_t maxActive = m_maxActive ? m_maxActive
+                                   : std::max<size_t>( 2, 2 * m_pool.get_thread_count() );
+    size_t next = 0;
+
+    std::list<JOB*> active;
+
+    auto resume =
+            [&]( JOB* aJob, bool aStart )
+            {
+                m_current = aJob;
+                aJob->m_wait = nullptr;
+
+                bool running = aStart ? aJob->m_coroutine->Call( aJob )
+                                      : aJob->m_coroutine->Resume();
+
+                m_current = nullptr;
+                return running;
+            };
+
+    while( active.size() || ( next < m_jobs.size() && !m_cancelled ) )
+    {
+        while( !m_cancelled && active.size() < maxActive && next < m_jobs.size() )
+        {
+            JOB* job = m_jobs[next++].get();
+
+            job->m_coroutine = std::make_unique<COROUTINE<int, JOB*>>( this,
+                                                                      &ASYNC_IO_SCHEDULER::runJob );
+
+            if( resume( job, true ) )
+                active.push_back( job );
+        }
+
+        bool progressed = false;
+
+        for( auto it = active.begin(); it != active.end(); )
+        {
+            JOB* job = *it;
+
+            if( job->m_wait( std::chrono::milliseconds( 0 ) ) )
+            {
+                progressed = true;
+
+                if( !resume( job, false ) )
+                {
+                    it = active.erase( it );
+                    continue;
+                }
+            }
+
+            ++it;
+        }
+
+        if( !progressed && active.size() )
+        {
+            // Nothing to do on this thread until the oldest read completes
+            active.front()->m_wait( aPollInterval );
+
+            if( aIdleCallback && !aIdleCallback() )
+                m_cancelled = true;
+        }
+    }
+
+    m_jobs.clear();
+
+    if( m_error )
+    {
+        std::exception_ptr error = m_error;
+        m_error = nullptr;
+        std::rethrow_exception( error );
+    }
+
+    return !m_cancelled;
+}
+
+
+bool ASYNC_IO_SCHEDULER::ReadFile( const wxString& aFilename, std::string& aContents )
+{
+    return Await(
+            [&]()
+            {
+                wxFFile file( aFilename, wxS( "rb" ) );
+
+                if( !file.IsOpened() )
+                    return false;
+
+                wxFileOffset length = file.Length();
+
+                if( length < 0 )
+                    return false;
+
+                aContents.resize( static_cast<size_t>( length ) );
+
+                return file.Read( aContents.data(), aContents.size() ) == aContents.size();
+            } );
+}
+
+
+bool ASYNC_IO_SCHEDULER::Prefetch( const wxString& aFilename )
+{
+    return Await(
+            [&]()
+            {
+                wxFFile file( aFilename, wxS( "rb" ) );
+
+                if( !file.IsOpened() )
+                    return false;
+
+                char buffer[65536];
+
+                while( file.Read( buffer, sizeof( buffer ) ) == sizeof( buffer ) )
+                {
+                }
+
+                return !file.Error();
+            } );
+}
@@ -28,6 +28,7 @@
 #include <bitmaps.h>
 #include <bitmap_store.h>
 #include <bitmaps/bitmap_info.h>
+#include <core/trace_profiler.h>
 #include <hash.h>
 #include <kiplatform/ui.h>
 #include <paths.h>
@@ -103,6 +104,8 @@ size_t std::hash<std::pair<BITMAPS, int>>::operator()( const std::pair<BITMAPS,
 
 BITMAP_STORE::BITMAP_STORE()
 {
+    TRACE_SCOPE( "Load icon archive" );
+
     wxFileName path( PATHS::GetStockDataPath() + wxT( "/resources" ), IMAGE_ARCHIVE );
 
     wxLogTrace( traceBitmaps, "Loading bitmaps from " + path.GetFullPath() );
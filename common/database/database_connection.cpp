@@ -18,6 +18,8 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include <boost/locale.hpp>
 #include <fmt/core.h>
 #include <nanodbc/nanodbc.h>
@@ -114,6 +116,7 @@ DATABASE_CONNECTION::DATABASE_CONNECTION( const std::string& aConnectionString,
 DATABASE_CONNECTION::~DATABASE_CONNECTION()
 {
     Disconnect();
+    m_statements.clear();
     m_conn.reset();
 }
 
@@ -121,12 +124,13 @@ DATABASE_CONNECTION::~DATABASE_CONNECTION()
 void DATABASE_CONNECTION::init()
 {
     m_cache = std::make_unique<DB_CACHE_TYPE>( 10, 1 );
+    m_rowCache = std::make_unique<DB_ROW_CACHE_TYPE>( 10, 1 );
 }
 
 
 void DATABASE_CONNECTION::SetCacheParams( int aMaxSize, int aMaxAge )
 {
-    if( !m_cache )
+    if( !m_cache || !m_rowCache )
         return;
 
     if( aMaxSize < 0 )
@@ -135,7 +139,9 @@ void DATABASE_CONNECTION::SetCacheParams( int aMaxSize, int aMaxAge )
     if( aMaxAge < 0 )
         aMaxAge = 0;
 
-    m_cache->SetMaxSize( static_cast<size_t>( aMaxSize ) );
+    // The size limit is meant for single rows; whole tables are few
+    m_rowCache->SetMaxSize( static_cast<size_t>( aMaxSize ) );
+    m_rowCache->SetMaxAge( static_cast<time_t>( aMaxAge ) );
     m_cache->SetMaxAge( static_cast<time_t>( aMaxAge ) );
 }
 
@@ -147,6 +153,9 @@ bool DATABASE_CONNECTION::Connect()
     nanodbc::string pass = fromUTF8( m_pass );
     nanodbc::string cs   = fromUTF8( m_connectionString );
 
+    // Statements belong to the previous connection
+    m_statements.clear();
+
     try
     {
         if( cs.empty() )
@@ -183,6 +192,8 @@ bool DATABASE_CONNECTION::Disconnect()
         return false;
     }
 
+    m_statements.clear();
+
     try
     {
         m_conn->disconnect();
@@ -313,8 +324,83 @@ std::string DATABASE_CONNECTION::columnsFor( const std::string& aTable )
     return ret;
 }
 
-//next step, make SelectOne take from the SelectAll cache if the SelectOne cache is missing.
-//To do this, need to build a map of PK->ROW for the cache result.
+std::string DATABASE_CONNECTION::rowCacheKey( const std::string& aTable,
+                                              const std::string& aColumn,
+                                              const std::string& aValue ) const
+{
+    // Use a separator which can't be part of the names to keep the keys unambiguous
+    return fmt::format( "{}\x1f{}\x1f{}", aTable, aColumn, aValue );
+}
+
+
+nanodbc::statement& DATABASE_CONNECTION::preparedStatement( const std::string& aQuery )
+{
+    auto it = m_statements.find( aQuery );
+
+    if( it != m_statements.end() )
+        return *it->second;
+
+    auto statement = std::make_unique<nanodbc::statement>( *m_conn );
+    statement->prepare( fromUTF8( aQuery ) );
+
+    return *m_statements.emplace( aQuery, std::move( statement ) ).first->second;
+}
+
+
+void DATABASE_CONNECTION::dropConnection()
+{
+    m_statements.clear();
+    m_conn->disconnect();
+}
+
+
+bool DATABASE_CONNECTION::readRow( nanodbc::result& aResults, ROW& aRow )
+{
+    aRow.clear();
+
+    try
+    {
+        for( short i = 0; i < aResults.columns(); ++i )
+        {
+            std::string column = toUTF8( aResults.column_name( i ) );
+
+            switch( aResults.column_datatype( i ) )
+            {
+            case SQL_DOUBLE:
+            case SQL_FLOAT:
+            case SQL_REAL:
+            case SQL_DECIMAL:
+            case SQL_NUMERIC:
+            {
+                try
+                {
+                    aRow[column] = fmt::format( "{:G}", aResults.get<double>( i ) );
+                }
+                catch( nanodbc::null_access_error& e )
+                {
+                    // Column was empty (null)
+                    aRow[column] = std::string();
+                }
+
+                break;
+            }
+
+            default:
+                aRow[column] = toUTF8( aResults.get<nanodbc::string>( i, NANODBC_TEXT( "" ) ) );
+            }
+        }
+    }
+    catch( nanodbc::database_error& e )
+    {
+        m_lastError = e.what();
+        wxLogTrace( traceDatabase, wxT( "Exception while parsing results: %s" ), m_lastError );
+        return false;
+    }
+
+    return true;
+}
+
+
 bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
                                      const std::pair<std::string, std::string>& aWhere,
                                      DATABASE_CONNECTION::ROW& aResult )
@@ -366,22 +452,28 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
 
     const std::string& columnName = columnCacheIter->first;
 
-    std::string cacheKey = fmt::format( "{}{}{}", tableName, columnName, aWhere.second );
+    std::string cacheKey = rowCacheKey( tableName, columnName, aWhere.second );
+
+    if( m_rowCache->Get( cacheKey, aResult ) )
+    {
+        wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s` - row cache hit" ),
+                    tableName, aWhere.second );
+        return true;
+    }
 
     std::string queryStr = fmt::format( "SELECT {} FROM {}{}{} WHERE {}{}{} = ?",
                                         columnsFor( tableName ),
                                         m_quoteChar, tableName, m_quoteChar,
                                         m_quoteChar, columnName, m_quoteChar );
 
-    nanodbc::statement statement( *m_conn );
-    nanodbc::string query = fromUTF8( queryStr );
+    nanodbc::statement* statement = nullptr;
 
     PROF_TIMER timer;
 
     try
     {
-        statement.prepare( query );
-        statement.bind( 0, aWhere.second.c_str() );
+        statement = &preparedStatement( queryStr );
+        statement->bind( 0, aWhere.second.c_str() );
     }
     catch( nanodbc::database_error& e )
     {
@@ -390,19 +482,19 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
                     m_lastError );
 
         // Exception may be due to a connection error; nanodbc won't auto-reconnect
-        m_conn->disconnect();
+        dropConnection();
 
         return false;
     }
 
-    wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s`" ), toUTF8( query ),
+    wxLogTrace( traceDatabase, wxT( "SelectOne: `%s` with parameter `%s`" ), queryStr,
                 aWhere.second );
 
     nanodbc::result results;
 
     try
     {
-        results = nanodbc::execute( statement );
+        results = nanodbc::execute( *statement );
     }
     catch( nanodbc::database_error& e )
     {
@@ -411,7 +503,7 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
                     m_lastError );
 
         // Exception may be due to a connection error; nanodbc won't auto-reconnect
-        m_conn->disconnect();
+        dropConnection();
 
         return false;
     }
@@ -428,48 +520,132 @@ bool DATABASE_CONNECTION::SelectOne( const std::string& aTable,
     wxLogTrace( traceDatabase, wxT( "SelectOne: %ld results returned from query in %0.1f ms" ),
                 results.rows(), timer.msecs() );
 
-    aResult.clear();
+    if( !readRow( results, aResult ) )
+        return false;
 
-    try
+    m_rowCache->Put( cacheKey, aResult );
+
+    return true;
+}
+
+
+bool DATABASE_CONNECTION::SelectMany( const std::string& aTable, const std::string& aColumn,
+                                      const std::vector<std::string>& aValues )
+{
+    // Values per query.  The last batch is padded so that a single prepared statement serves
+    // all of them; this also stays well below the parameter limits of the common drivers.
+    static const size_t BATCH_SIZE = 100;
+
+    if( !m_conn )
     {
-        for( short i = 0; i < results.columns(); ++i )
-        {
-            std::string column = toUTF8( results.column_name( i ) );
+        wxLogTrace( traceDatabase, wxT( "Called SelectMany without valid connection!" ) );
+        return false;
+    }
 
-            switch( results.column_datatype( i ) )
-            {
-            case SQL_DOUBLE:
-            case SQL_FLOAT:
-            case SQL_REAL:
-            case SQL_DECIMAL:
-            case SQL_NUMERIC:
-            {
-                try
-                {
-                    aResult[column] = fmt::format( "{:G}", results.get<double>( i ) );
-                }
-                catch( nanodbc::null_access_error& e )
-                {
-                    // Column was empty (null)
-                    aResult[column] = std::string();
-                }
+    auto tableMapIter = m_tables.find( aTable );
 
-                break;
-            }
+    if( tableMapIter == m_tables.end() || !m_columnCache.count( tableMapIter->first ) )
+    {
+        wxLogTrace( traceDatabase, wxT( "SelectMany: requested table %s not found in cache" ),
+                    aTable );
+        return false;
+    }
 
-            default:
-                aResult[column] = toUTF8( results.get<nanodbc::string>( i, NANODBC_TEXT( "" ) ) );
-            }
+    const std::string& tableName = tableMapIter->first;
+    auto columnCacheIter = m_columnCache.at( tableName ).find( aColumn );
+
+    if( columnCacheIter == m_columnCache.at( tableName ).end() )
+    {
+        wxLogTrace( traceDatabase, wxT( "SelectMany: requested column %s not found in cache for %s" ),
+                    aColumn, tableName );
+        return false;
+    }
+
+    const std::string& columnName = columnCacheIter->first;
+
+    std::vector<std::string> missing;
+    std::set<std::string>    seen;
+    ROW                      row;
+
+    for( const std::string& value : aValues )
+    {
+        if( seen.insert( value ).second
+                && !m_rowCache->Get( rowCacheKey( tableName, columnName, value ), row ) )
+        {
+            missing.push_back( value );
         }
     }
-    catch( nanodbc::database_error& e )
+
+    if( missing.empty() )
+        return true;
+
+    // Make room for everything requested; the caller is about to look all of it up
+    if( m_rowCache->GetMaxSize() < seen.size() )
+        m_rowCache->SetMaxSize( seen.size() );
+
+    std::string placeholders;
+
+    for( size_t i = 0; i < BATCH_SIZE; ++i )
+        placeholders += i ? ", ?" : "?";
+
+    std::string queryStr = fmt::format( "SELECT {} FROM {}{}{} WHERE {}{}{} IN ({})",
+                                        columnsFor( tableName ),
+                                        m_quoteChar, tableName, m_quoteChar,
+                                        m_quoteChar, columnName, m_quoteChar,
+                                        placeholders );
+
+    PROF_TIMER timer;
+    size_t     found = 0;
+
+    for( size_t first = 0; first < missing.size(); first += BATCH_SIZE )
     {
-        m_lastError = e.what();
-        wxLogTrace( traceDatabase, wxT( "Exception while parsing results from SelectOne: %s" ),
-                    m_lastError );
-        return false;
+        nanodbc::result results;
+
+        try
+        {
+            nanodbc::statement& statement = preparedStatement( queryStr );
+
+            for( size_t i = 0; i < BATCH_SIZE; ++i )
+            {
+                size_t idx = std::min( first + i, missing.size() - 1 );
+                statement.bind( static_cast<short>( i ), missing[idx].c_str() );
+            }
+
+            results = nanodbc::execute( statement );
+        }
+        catch( nanodbc::database_error& e )
+        {
+            m_lastError = e.what();
+            wxLogTrace( traceDatabase, wxT( "Exception while executing query for SelectMany: %s" ),
+                        m_lastError );
+
+            // Exception may be due to a connection error; nanodbc won't auto-reconnect
+            dropConnection();
+
+            return false;
+        }
+
+        while( results.next() )
+        {
+            if( !readRow( results, row ) )
+                return false;
+
+            auto keyIt = row.find( columnName );
+
+            if( keyIt == row.end() )
+                continue;
+
+            std::string key = std::any_cast<std::string>( keyIt->second );
+            m_rowCache->Put( rowCacheKey( tableName, columnName, key ), row );
+            found++;
+        }
     }
 
+    timer.Stop();
+
+    wxLogTrace( traceDatabase, wxT( "SelectMany: %zu of %zu rows from %s fetched in %0.1f ms" ),
+                found, missing.size(), tableName, timer.msecs() );
+
     return true;
 }
 
@@ -524,7 +700,7 @@ bool DATABASE_CONNECTION::SelectAll( const std::string& aTable, const std::strin
                     m_lastError );
 
         // Exception may be due to a connection error; nanodbc won't auto-reconnect
-        m_conn->disconnect();
+        dropConnection();
 
         return false;
     }
@@ -542,7 +718,7 @@ bool DATABASE_CONNECTION::SelectAll( const std::string& aTable, const std::strin
                     m_lastError );
 
         // Exception may be due to a connection error; nanodbc won't auto-reconnect
-        m_conn->disconnect();
+        dropConnection();
 
         return false;
     }
@@ -24,9 +24,11 @@
  * or you may write to the Free Software Foundation, Inc.,
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
+#include <advanced_config.h>
 #include <confirm.h>
 #include <eda_draw_frame.h>
 #include <kiface_base.h>
+#include <layer_ids.h>
 #include <macros.h>
 #include <scoped_set_reset.h>
 #include <settings/app_settings.h>
@@ -38,6 +40,7 @@
 #include <gal/painter.h>
 #include <base_screen.h>
 #include <gal/cursors.h>
+#include <preview_items/preview_utils.h>
 #include <gal/graphics_abstraction_layer.h>
 #include <gal/opengl/opengl_gal.h>
 #include <gal/cairo/cairo_gal.h>
@@ -273,19 +276,22 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
             m_gal->SetCursorColor( settings->GetCursorColor() );
 
             // TODO: find why ClearScreen() must be called here in opengl mode
-            // and only if m_view->IsDirty() in Cairo mode to avoid display artifacts
-            // when moving the mouse cursor
+            // to avoid display artifacts when moving the mouse cursor
+            // In Cairo mode ClearTargets() clears the buffer holding the items, painting the
+            // whole screen first would lose the parts it keeps.
             if( m_backend == GAL_TYPE_OPENGL )
                 m_gal->ClearScreen();
 
+            bool showStatistics = ADVANCED_CFG::GetCfg().m_ShowRenderStatistics;
+            bool itemsDirty = m_view->IsTargetDirty( KIGFX::TARGET_CACHED )
+                              || m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED );
+
+            // The statistics are drawn on the overlay, so it has to be redrawn with the items
+            if( showStatistics && itemsDirty )
+                m_view->MarkTargetDirty( KIGFX::TARGET_OVERLAY );
+
             if( m_view->IsDirty() )
             {
-                if( m_backend != GAL_TYPE_OPENGL  // Already called in opengl
-                        && m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) )
-                {
-                    m_gal->ClearScreen();
-                }
-
                 m_view->ClearTargets();
 
                 // Grid has to be redrawn only when the NONCACHED target is redrawn
@@ -296,6 +302,15 @@ bool EDA_DRAW_PANEL_GAL::DoRePaint()
                 m_view->Redraw();
                 cntRedraw.Stop();
                 isDirty = true;
+
+                if( showStatistics )
+                {
+                    // Keep the counters of the last redraw of the items, not of the overlay
+                    if( itemsDirty || m_renderStatistics.empty() )
+                        updateRenderStatistics( cntUpd.msecs() );
+
+                    drawRenderStatistics();
+                }
             }
 
             m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
@@ -653,6 +668,67 @@ void EDA_DRAW_PANEL_GAL::SetCurrentCursor( KICURSOR aCursor )
 }
 
 
+void EDA_DRAW_PANEL_GAL::updateRenderStatistics( double aUpdateTime )
+{
+    const KIGFX::VIEW::REDRAW_STATISTICS&  viewStats = m_view->GetRedrawStatistics();
+    const KIGFX::GAL::RENDER_STATISTICS    galStats = m_gal->GetRenderStatistics();
+
+    m_renderStatistics.clear();
+    m_renderStatistics.push_back( wxString::Format( wxS( "Redraw: %.1f ms, update: %.1f ms" ),
+                                                    viewStats.m_redrawTime, aUpdateTime ) );
+    m_renderStatistics.push_back( wxString::Format( wxS( "Items drawn: %d (cached %d, new %d)" ),
+                                                    viewStats.m_drawnItems, viewStats.m_cacheHits,
+                                                    viewStats.m_cacheMisses ) );
+
+    // The layers holding the most items tell what makes a redraw slow
+    std::vector<std::pair<int, int>> layers( viewStats.m_layerItems.begin(),
+                                             viewStats.m_layerItems.end() );
+
+    std::sort( layers.begin(), layers.end(),
+               []( const std::pair<int, int>& a, const std::pair<int, int>& b )
+               {
+                   return a.second > b.second;
+               } );
+
+    for( size_t i = 0; i < layers.size() && i < 5; ++i )
+    {
+        m_renderStatistics.push_back( wxString::Format( wxS( "    %s (%d): %d" ),
+                                                        LayerName( layers[i].first ),
+                                                        layers[i].first, layers[i].second ) );
+    }
+
+    // Counters of the last frame the GAL finished, as the current one is still being drawn
+    if( m_backend == GAL_TYPE_OPENGL )
+    {
+        m_renderStatistics.push_back( wxString::Format( wxS( "Vertices: %u cached, %u noncached" ),
+                                                        galStats.m_cachedVertices,
+                                                        galStats.m_nonCachedVertices ) );
+        m_renderStatistics.push_back( wxString::Format( wxS( "Vertex memory: %.1f MB" ),
+                                                        m_gal->GetVertexMemoryUsage() / 1e6 ) );
+        m_renderStatistics.push_back( wxString::Format( wxS( "Draw calls: %u, defragmented: %d" ),
+                                                        galStats.m_drawCalls,
+                                                        galStats.m_defragmentations ) );
+    }
+
+    for( const wxString& line : m_renderStatistics )
+        KI_TRACE( traceGalProfile, "%s\n", line.ToStdString() );
+}
+
+
+void EDA_DRAW_PANEL_GAL::drawRenderStatistics()
+{
+    m_gal->SetTarget( KIGFX::TARGET_OVERLAY );
+    m_gal->SetLayerDepth( m_gal->GetMinDepth() );
+
+    VECTOR2D origin = m_view->ToWorld( VECTOR2D( 0, 0 ) );
+
+    KIGFX::PREVIEW::DrawTextNextToCursor( m_view, origin, VECTOR2D( -1, -1 ),
+                                          m_renderStatistics, true );
+    KIGFX::PREVIEW::DrawTextNextToCursor( m_view, origin, VECTOR2D( -1, -1 ),
+                                          m_renderStatistics, false );
+}
+
+
 std::shared_ptr<KIGFX::VIEW_OVERLAY> EDA_DRAW_PANEL_GAL::DebugOverlay()
 {
     if( !m_debugOverlay )
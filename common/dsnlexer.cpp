@@ -687,7 +687,15 @@ L_read:
                 }
 
                 else
-                    curText += *head++;
+                {
+                    // copy the run of plain characters up to the next escape or quote at once
+                    const char* run = head;
+
+                    while( head < limit && *head != '\\' && *head != '"' )
+                        ++head;
+
+                    curText.append( run, head );
+                }
 
             }   // while
 
@@ -772,7 +780,9 @@ L_read:
 
     head = cur;
     while( head<limit && !isSep( *head ) )
-        curText += *head++;
+        ++head;
+
+    curText.append( cur, head );
 
     if( isNumber( curText.c_str(), curText.c_str() + curText.size() ) )
     {
@@ -821,6 +831,140 @@ wxArrayString* DSNLEXER::ReadCommentLines()
 }
 
 
+void DSNLEXER::ReadListText( std::string& aText )
+{
+    const char* cur = next;
+    int         depth = 1;
+    bool        quoted = false;
+
+    for( ;; )
+    {
+        if( cur >= limit )
+        {
+            aText.append( next, limit );
+
+            if( !readLine() )
+            {
+                THROW_PARSE_ERROR( _( "Unexpected end of file" ), CurSource(), CurLine(),
+                                   CurLineNumber(), CurOffset() );
+            }
+
+            // Delimited strings don't span lines, NextTok() reports them later
+            cur = next;
+            quoted = false;
+            continue;
+        }
+
+        char cc = *cur++;
+
+        if( quoted )
+        {
+            if( cc == '\\' && !specctraMode && cur < limit )
+                ++cur;
+            else if( cc == stringDelimiter )
+                quoted = false;
+        }
+        else if( cc == stringDelimiter )
+        {
+            quoted = true;
+        }
+        else if( cc == '(' )
+        {
+            ++depth;
+        }
+        else if( cc == ')' && --depth == 0 )
+        {
+            break;
+        }
+    }
+
+    aText.append( next, cur );
+
+    prevTok = curTok;
+    curTok = DSN_RIGHT;
+    curText = ')';
+    curOffset = cur - 1 - start;
+    next = cur;
+}
+
+
+bool DSNLEXER::parseScaledDecimal( const char* aBegin, const char* aEnd, long long aScale,
+                                   long long& aResult, const char** aRest )
+{
+    static const long long pow10[] = { 1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL,
+                                       10000000LL, 100000000LL, 1000000000LL, 10000000000LL,
+                                       100000000000LL, 1000000000000LL, 10000000000000LL,
+                                       100000000000000LL, 1000000000000000LL,
+                                       10000000000000000LL, 100000000000000000LL,
+                                       1000000000000000000LL };
+
+    const char* cur = aBegin;
+    bool        negative = false;
+    bool        anyDigit = false;
+    long long   mantissa = 0;
+    int         digits = 0;
+    int         fractionDigits = 0;
+
+    if( cur < aEnd && ( *cur == '-' || *cur == '+' ) )
+        negative = *cur++ == '-';
+
+    auto readDigits =
+            [&]( bool aFraction )
+            {
+                while( cur < aEnd && *cur >= '0' && *cur <= '9' )
+                {
+                    anyDigit = true;
+
+                    if( mantissa || *cur != '0' || aFraction )
+                    {
+                        // 18 digits always fit in a long long
+                        if( ++digits > 18 )
+                            return false;
+
+                        mantissa = mantissa * 10 + ( *cur - '0' );
+                    }
+
+                    fractionDigits += aFraction;
+                    ++cur;
+                }
+
+                return true;
+            };
+
+    if( !readDigits( false ) )
+        return false;
+
+    if( cur < aEnd && *cur == '.' )
+    {
+        ++cur;
+
+        if( !readDigits( true ) )
+            return false;
+    }
+
+    if( !anyDigit || ( cur < aEnd && ( *cur == 'e' || *cur == 'E' ) ) )
+        return false;
+
+    if( aRest )
+        *aRest = cur;
+    else if( cur != aEnd )
+        return false;
+
+    if( aScale <= 0 || mantissa > std::numeric_limits<long long>::max() / aScale )
+        return false;
+
+    long long product = mantissa * aScale;
+    long long divisor = pow10[fractionDigits];
+    long long result = product / divisor;
+
+    if( 2 * ( product % divisor ) >= divisor )
+        ++result;
+
+    aResult = negative ? -result : result;
+    return true;
+}
+
+
 double DSNLEXER::parseDouble()
 {
 #if ( defined( __GNUC__ ) && __GNUC__ < 11 ) || ( defined( __clang__ ) && __clang_major__ < 13 )
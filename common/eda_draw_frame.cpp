@@ -1000,7 +1000,7 @@ void EDA_DRAW_FRAME::FocusOnLocation( const VECTOR2I& aPos )
         {
             GetCanvas()->GetView()->SetCenter( aPos, dialogScreenRects );
         }
-        catch( const ClipperLib::clipperException& exc )
+        catch( const Clipper2Lib::Clipper2Exception& exc )
         {
             wxLogError( wxT( "Clipper library error '%s' occurred centering object." ),
                         exc.what() );
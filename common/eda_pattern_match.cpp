@@ -289,6 +289,11 @@ bool EDA_PATTERN_MATCH_RELATIONAL::SetPattern( const wxString& aPattern )
     else
         return false;
 
+    // Each matcher owns its own description regex (wxRegEx keeps the results of the last
+    // match internally), so that separate matchers can be run from different threads.
+    if( !m_regex_description.Compile( R"((\w+)[=:]([-+]?[\d.]+)(\w*))", wxRE_ADVANCED ) )
+        return false;
+
     m_pattern = aPattern;
 
     return true;
@@ -365,8 +370,6 @@ int EDA_PATTERN_MATCH_RELATIONAL::FindOne( const wxString& aCandidate ) const
 }
 
 
-wxRegEx EDA_PATTERN_MATCH_RELATIONAL::m_regex_description(
-        R"((\w+)[=:]([-+]?[\d.]+)(\w*))", wxRE_ADVANCED );
 wxRegEx EDA_PATTERN_MATCH_RELATIONAL::m_regex_search(
         R"(^(\w+)(<|<=|=|>=|>)([-+]?[\d.]*)(\w*)$)", wxRE_ADVANCED );
 const std::map<wxString, double> EDA_PATTERN_MATCH_RELATIONAL::m_units = {
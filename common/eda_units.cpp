@@ -150,9 +150,70 @@ std::string EDA_UNIT_UTILS::FormatAngle( const EDA_ANGLE& aAngle )
 }
 
 
+/**
+ * Append \a aValue / 10^\a aDecimals to \a aBuf, exactly and without trailing zeros, the way
+ * "{:.10g}" prints it: integers have at most 10 digits, so printing them needs no rounding.
+ */
+static void formatScaledInt( std::string& aBuf, int aValue, int aDecimals )
+{
+    char               digits[16];
+    char*              end = digits + sizeof( digits );
+    char*              point = end - aDecimals;
+    char*              cur = end;
+    unsigned long long magnitude = aValue < 0 ? -(long long) aValue : aValue;
+
+    // Least significant first, with at least one digit before the point
+    do
+    {
+        *--cur = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while( magnitude || cur >= point );
+
+    // Drop the zeros ending the fraction, and the point if nothing is left after it
+    while( end > point && end[-1] == '0' )
+        --end;
+
+    if( aValue < 0 )
+        aBuf += '-';
+
+    aBuf.append( cur, point );
+
+    if( end > point )
+    {
+        aBuf += '.';
+        aBuf.append( point, end );
+    }
+}
+
+
+/**
+ * @return the number of decimals of the millimeters of \a aIuScale, or -1 if its internal
+ *         units per millimeter aren't a power of ten.
+ */
+static int mmDecimals( const EDA_IU_SCALE& aIuScale )
+{
+    double scale = 1.0;
+
+    for( int decimals = 0; decimals <= 9; ++decimals, scale *= 10.0 )
+    {
+        if( scale == aIuScale.IU_PER_MM )
+            return decimals;
+    }
+
+    return -1;
+}
+
+
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, int aValue )
 {
     std::string buf;
+
+    if( int decimals = mmDecimals( aIuScale ); decimals >= 0 )
+    {
+        formatScaledInt( buf, aValue, decimals );
+        return buf;
+    }
+
     double engUnits = aValue;
 
     engUnits /= aIuScale.IU_PER_MM;
@@ -186,6 +247,16 @@ std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale, i
 std::string EDA_UNIT_UTILS::FormatInternalUnits( const EDA_IU_SCALE& aIuScale,
                                                  const VECTOR2I&     aPoint )
 {
+    if( int decimals = mmDecimals( aIuScale ); decimals >= 0 )
+    {
+        std::string buf;
+
+        formatScaledInt( buf, aPoint.x, decimals );
+        buf += ' ';
+        formatScaledInt( buf, aPoint.y, decimals );
+        return buf;
+    }
+
     return FormatInternalUnits( aIuScale, aPoint.x ) + " "
            + FormatInternalUnits( aIuScale, aPoint.y );
 }
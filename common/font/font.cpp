@@ -127,6 +127,8 @@ private:
 
 static MARKUP_CACHE s_markupCache( 1024 );
 static std::mutex s_markupCacheMutex;
+static std::mutex s_defaultFontMutex;
+static std::mutex s_fontMapMutex;
 
 
 FONT::FONT()
@@ -136,6 +138,8 @@ FONT::FONT()
 
 FONT* FONT::getDefaultFont()
 {
+    std::lock_guard<std::mutex> lock( s_defaultFontMutex );
+
     if( !s_defaultFont )
         s_defaultFont = STROKE_FONT::LoadFont( wxEmptyString );
 
@@ -150,6 +154,9 @@ FONT* FONT::GetFont( const wxString& aFontName, bool aBold, bool aItalic )
 
     std::tuple<wxString, bool, bool> key = { aFontName, aBold, aItalic };
 
+    // Fonts are also looked up by footprints parsed on worker threads
+    std::lock_guard<std::mutex> lock( s_fontMapMutex );
+
     FONT* font = nullptr;
 
     if( s_fontMap.find( key ) != s_fontMap.end() )
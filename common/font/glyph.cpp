@@ -33,6 +33,10 @@ STROKE_GLYPH::STROKE_GLYPH( const STROKE_GLYPH& aGlyph )
         push_back( pointList );
 
     m_boundingBox = aGlyph.m_boundingBox;
+    m_source = aGlyph.m_source;
+    m_origin = aGlyph.m_origin;
+    m_xAxis = aGlyph.m_xAxis;
+    m_yAxis = aGlyph.m_yAxis;
 }
 
 
@@ -88,24 +92,39 @@ std::unique_ptr<GLYPH> STROKE_GLYPH::Transform( const VECTOR2D& aGlyphSize, cons
     glyph->m_boundingBox.SetEnd( end );
     glyph->m_boundingBox.Offset( aOffset );
 
+    auto transform =
+            [&]( VECTOR2D& point )
+            {
+                point *= aGlyphSize;
+
+                if( aTilt )
+                    point.x -= point.y * aTilt;
+
+                point += aOffset;
+
+                if( aMirror )
+                    point.x = aOrigin.x - ( point.x - aOrigin.x );
+
+                if( !aAngle.IsZero() )
+                    RotatePoint( point, aOrigin, aAngle );
+            };
+
     for( std::vector<VECTOR2D>& pointList : *glyph.get() )
     {
         for( VECTOR2D& point : pointList )
-        {
-            point *= aGlyphSize;
-
-            if( aTilt )
-                point.x -= point.y * aTilt;
+            transform( point );
+    }
 
-            point += aOffset;
+    // The transform is affine, so it maps the axes of the source glyph to the new ones
+    VECTOR2D xEnd = m_origin + m_xAxis;
+    VECTOR2D yEnd = m_origin + m_yAxis;
 
-            if( aMirror )
-                point.x = aOrigin.x - ( point.x - aOrigin.x );
+    transform( glyph->m_origin );
+    transform( xEnd );
+    transform( yEnd );
 
-            if( !aAngle.IsZero() )
-                RotatePoint( point, aOrigin, aAngle );
-        }
-    }
+    glyph->m_xAxis = xEnd - glyph->m_origin;
+    glyph->m_yAxis = yEnd - glyph->m_origin;
 
     return glyph;
 }
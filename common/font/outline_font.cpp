@@ -305,84 +305,36 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
 
         if( aGlyphs )
         {
-            if( m_fakeItal )
-            {
-                FT_Matrix matrix;
-                // Create a 12 degree slant
-                const float angle = (float)( -M_PI * 12.0f ) / 180.0f;
-                matrix.xx = (FT_Fixed) ( cos( angle ) * 0x10000L );
-                matrix.xy = (FT_Fixed) ( -sin( angle ) * 0x10000L );
-                matrix.yx = (FT_Fixed) ( 0 * 0x10000L );  // Don't rotate in the y direction
-                matrix.yy = (FT_Fixed) ( 1 * 0x10000L );
-
-                FT_Set_Transform( face, &matrix, 0 );
-            }
-
-            FT_Load_Glyph( face, glyphInfo[i].codepoint, FT_LOAD_NO_BITMAP );
-
-            if( m_fakeBold )
-                FT_Outline_Embolden( &face->glyph->outline, 1 << 6 );
-
-            // contours is a collection of all outlines in the glyph; for example the 'o' glyph
-            // generally contains 2 contours, one for the glyph outline and one for the hole
-            CONTOURS contours;
-
-            OUTLINE_DECOMPOSER decomposer( face->glyph->outline );
-            decomposer.OutlineToSegments( &contours );
-
-            std::unique_ptr<OUTLINE_GLYPH> glyph = std::make_unique<OUTLINE_GLYPH>();
-            std::vector<SHAPE_LINE_CHAIN>  holes;
-
-            for( CONTOUR& c : contours )
-            {
-                GLYPH_POINTS     points = c.m_Points;
-                SHAPE_LINE_CHAIN shape;
-
-                shape.ReservePoints( points.size() );
-
-                for( const VECTOR2D& v : points )
-                {
-                    VECTOR2D pt( v + cursor );
-
-                    if( IsSubscript( aTextStyle ) )
-                        pt.y += m_subscriptVerticalOffset * scaler;
-                    else if( IsSuperscript( aTextStyle ) )
-                        pt.y += m_superscriptVerticalOffset * scaler;
-
-                    pt *= scaleFactor;
-                    pt += aPosition;
-
-                    if( aMirror )
-                        pt.x = aOrigin.x - ( pt.x - aOrigin.x );
-
-                    if( !aAngle.IsZero() )
-                        RotatePoint( pt, aOrigin, aAngle );
+            bool     script = IsSubscript( aTextStyle ) || IsSuperscript( aTextStyle );
+            VECTOR2D offset( cursor );
+
+            if( IsSubscript( aTextStyle ) )
+                offset.y += m_subscriptVerticalOffset * scaler;
+            else if( IsSuperscript( aTextStyle ) )
+                offset.y += m_superscriptVerticalOffset * scaler;
+
+            // Glyphs are the same shape in every text, only placed differently, and affine
+            // transforms keep their triangulation valid
+            std::unique_ptr<OUTLINE_GLYPH> glyph =
+                    std::make_unique<OUTLINE_GLYPH>( getCachedGlyph( glyphInfo[i].codepoint,
+                                                                     script ) );
+
+            glyph->TransformPoints(
+                    [&]( const VECTOR2I& aPt )
+                    {
+                        VECTOR2D pt( VECTOR2D( aPt ) / m_glyphCacheScaler + offset );
 
-                    shape.Append( pt.x, pt.y );
-                }
+                        pt *= scaleFactor;
+                        pt += aPosition;
 
-                shape.SetClosed( true );
+                        if( aMirror )
+                            pt.x = aOrigin.x - ( pt.x - aOrigin.x );
 
-                if( contourIsHole( c ) )
-                    holes.push_back( std::move( shape ) );
-                else
-                    glyph->AddOutline( std::move( shape ) );
-            }
+                        if( !aAngle.IsZero() )
+                            RotatePoint( pt, aOrigin, aAngle );
 
-            for( SHAPE_LINE_CHAIN& hole : holes )
-            {
-                if( hole.PointCount() )
-                {
-                    for( int ii = 0; ii < glyph->OutlineCount(); ++ii )
-                    {
-                        if( glyph->Outline( ii ).PointInside( hole.GetPoint( 0 ) ) )
-                        {
-                            glyph->AddHole( std::move( hole ), ii );
-                            break;
-                        }
-                    }
-                }
-            }
+                        return VECTOR2I( pt );
+                    } );
 
             aGlyphs->push_back( std::move( glyph ) );
         }
@@ -408,6 +360,80 @@ VECTOR2I OUTLINE_FONT::getTextAsGlyphsUnlocked( BOX2I* aBBox,
 }
 
 
+const OUTLINE_GLYPH& OUTLINE_FONT::getCachedGlyph( unsigned int aGlyphIndex, bool aScript ) const
+{
+    std::unique_ptr<OUTLINE_GLYPH>& cached = m_glyphCache[ { aGlyphIndex, aScript } ];
+
+    if( cached )
+        return *cached;
+
+    if( m_fakeItal )
+    {
+        FT_Matrix matrix;
+        // Create a 12 degree slant
+        const float angle = (float)( -M_PI * 12.0f ) / 180.0f;
+        matrix.xx = (FT_Fixed) ( cos( angle ) * 0x10000L );
+        matrix.xy = (FT_Fixed) ( -sin( angle ) * 0x10000L );
+        matrix.yx = (FT_Fixed) ( 0 * 0x10000L );  // Don't rotate in the y direction
+        matrix.yy = (FT_Fixed) ( 1 * 0x10000L );
+
+        FT_Set_Transform( m_face, &matrix, 0 );
+    }
+
+    FT_Load_Glyph( m_face, aGlyphIndex, FT_LOAD_NO_BITMAP );
+
+    if( m_fakeBold )
+        FT_Outline_Embolden( &m_face->glyph->outline, 1 << 6 );
+
+    // contours is a collection of all outlines in the glyph; for example the 'o' glyph
+    // generally contains 2 contours, one for the glyph outline and one for the hole
+    CONTOURS contours;
+
+    OUTLINE_DECOMPOSER decomposer( m_face->glyph->outline );
+    decomposer.OutlineToSegments( &contours );
+
+    cached = std::make_unique<OUTLINE_GLYPH>();
+
+    std::vector<SHAPE_LINE_CHAIN> holes;
+
+    for( CONTOUR& c : contours )
+    {
+        SHAPE_LINE_CHAIN shape;
+
+        shape.ReservePoints( c.m_Points.size() );
+
+        for( const VECTOR2D& v : c.m_Points )
+            shape.Append( VECTOR2I( v * m_glyphCacheScaler ) );
+
+        shape.SetClosed( true );
+
+        if( contourIsHole( c ) )
+            holes.push_back( std::move( shape ) );
+        else
+            cached->AddOutline( std::move( shape ) );
+    }
+
+    for( SHAPE_LINE_CHAIN& hole : holes )
+    {
+        if( hole.PointCount() )
+        {
+            for( int ii = 0; ii < cached->OutlineCount(); ++ii )
+            {
+                if( cached->Outline( ii ).PointInside( hole.GetPoint( 0 ) ) )
+                {
+                    cached->AddHole( std::move( hole ), ii );
+                    break;
+                }
+            }
+        }
+    }
+
+    cached->CacheTriangulation( false );
+
+    return *cached;
+}
+
+
 #undef OUTLINEFONT_RENDER_AS_PIXELS
 #ifdef OUTLINEFONT_RENDER_AS_PIXELS
 /*
@@ -176,6 +176,7 @@ void STROKE_FONT::loadNewStrokeFont( const char* const aNewStrokeFont[], int aNe
 
             // Compute the bounding box of the glyph
             buildGlyphBoundingBox( glyph, glyphWidth );
+            glyph->MarkAsSource();
             g_defaultFontGlyphBoundingBoxes->emplace_back( glyph->BoundingBox() );
             g_defaultFontGlyphs.push_back( glyph );
             m_maxGlyphWidth = std::max( m_maxGlyphWidth, glyphWidth );
@@ -309,6 +309,16 @@ void FP_LIB_TABLE::FootprintEnumerate( wxArrayString& aFootprintNames, const wxS
 }
 
 
+void FP_LIB_TABLE::FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                                const wxString& aNickname, bool aBestEfforts )
+{
+    const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
+    wxASSERT( row->plugin );
+    row->plugin->FootprintEnumerateSummaries( aSummaries, row->GetFullURI( true ), aBestEfforts,
+                                              row->GetProperties() );
+}
+
+
 void FP_LIB_TABLE::PrefetchLib( const wxString& aNickname )
 {
     const FP_LIB_TABLE_ROW* row = FindRow( aNickname, true );
@@ -33,6 +33,8 @@
 #include <gal/cairo/cairo_compositor.h>
 #include <wx/log.h>
 
+#include <algorithm>
+
 using namespace KIGFX;
 
 CAIRO_COMPOSITOR::CAIRO_COMPOSITOR( cairo_t** aMainContext ) :
@@ -137,8 +139,89 @@ void CAIRO_COMPOSITOR::Begin()
 
 void CAIRO_COMPOSITOR::ClearBuffer( const COLOR4D& aColor )
 {
+    CAIRO_BUFFER& buffer = m_buffers[m_current];
+
     // Clear the pixel storage
-    memset( m_buffers[m_current].bitmap, 0x00, m_bufferSize * sizeof( int ) );
+    if( buffer.clip.empty() )
+    {
+        memset( buffer.bitmap, 0x00, m_bufferSize * sizeof( int ) );
+        return;
+    }
+
+    const BOX2I bufferArea( VECTOR2I( 0, 0 ), VECTOR2I( m_width, m_height ) );
+    const int   rowLength = m_stride / sizeof( uint32_t );
+
+    cairo_surface_flush( buffer.surface );
+
+    for( const BOX2I& area : buffer.clip )
+    {
+        BOX2I cleared = area.Intersect( bufferArea );
+
+        if( cleared.GetWidth() <= 0 || cleared.GetHeight() <= 0 )
+            continue;
+
+        for( int y = cleared.GetTop(); y < cleared.GetBottom(); ++y )
+        {
+            memset( &buffer.bitmap[y * rowLength + cleared.GetLeft()], 0x00,
+                    cleared.GetWidth() * sizeof( uint32_t ) );
+        }
+    }
+
+    cairo_surface_mark_dirty( buffer.surface );
+}
+
+
+void CAIRO_COMPOSITOR::ClipBuffer( unsigned int aBufferHandle, const std::vector<BOX2I>& aAreas )
+{
+    wxASSERT_MSG( aBufferHandle <= usedBuffers(), wxT( "Tried to use a not existing buffer" ) );
+
+    CAIRO_BUFFER& buffer = m_buffers[aBufferHandle - 1];
+
+    buffer.clip = aAreas;
+    cairo_reset_clip( buffer.context );
+
+    if( !aAreas.empty() )
+        clip( buffer.context, aAreas );
+}
+
+
+void CAIRO_COMPOSITOR::ScrollBuffer( unsigned int aBufferHandle, const VECTOR2I& aDelta )
+{
+    wxASSERT_MSG( aBufferHandle <= usedBuffers(), wxT( "Tried to use a not existing buffer" ) );
+
+    CAIRO_BUFFER& buffer = m_buffers[aBufferHandle - 1];
+    const int     width = m_width;
+    const int     height = m_height;
+    const int     rowLength = m_stride / sizeof( uint32_t );
+
+    if( std::abs( aDelta.x ) >= width || std::abs( aDelta.y ) >= height )
+        return;
+
+    const int    srcX = std::max( -aDelta.x, 0 );
+    const int    dstX = std::max( aDelta.x, 0 );
+    const size_t rowSize = ( width - std::abs( aDelta.x ) ) * sizeof( uint32_t );
+
+    cairo_surface_flush( buffer.surface );
+
+    // Rows are moved in the order that doesn't overwrite the ones still to be moved
+    if( aDelta.y > 0 )
+    {
+        for( int y = height - 1; y >= aDelta.y; --y )
+        {
+            memmove( &buffer.bitmap[y * rowLength + dstX],
+                     &buffer.bitmap[( y - aDelta.y ) * rowLength + srcX], rowSize );
+        }
+    }
+    else
+    {
+        for( int y = 0; y < height + aDelta.y; ++y )
+        {
+            memmove( &buffer.bitmap[y * rowLength + dstX],
+                     &buffer.bitmap[( y - aDelta.y ) * rowLength + srcX], rowSize );
+        }
+    }
+
+    cairo_surface_mark_dirty( buffer.surface );
 }
 
 
@@ -155,6 +238,11 @@ void CAIRO_COMPOSITOR::DrawBuffer( unsigned int aSourceHandle, unsigned int aDes
 
     // Draw the selected buffer contents
     cairo_t* ct = cairo_create( m_buffers[aDestHandle - 1].surface );
+
+    // Keep the parts of the destination outside of its clip areas
+    if( !m_buffers[aDestHandle - 1].clip.empty() )
+        clip( ct, m_buffers[aDestHandle - 1].clip );
+
     cairo_set_operator( ct, op );
     cairo_set_source_surface( ct, m_buffers[aSourceHandle - 1].surface, 0.0, 0.0 );
     cairo_paint( ct );
@@ -188,6 +276,23 @@ void CAIRO_COMPOSITOR::Present()
 }
 
 
+void CAIRO_COMPOSITOR::clip( cairo_t* aContext, const std::vector<BOX2I>& aAreas )
+{
+    cairo_matrix_t matrix;
+
+    // Areas are given in screen coordinates
+    cairo_get_matrix( aContext, &matrix );
+    cairo_identity_matrix( aContext );
+    cairo_new_path( aContext );
+
+    for( const BOX2I& area : aAreas )
+        cairo_rectangle( aContext, area.GetX(), area.GetY(), area.GetWidth(), area.GetHeight() );
+
+    cairo_clip( aContext );
+    cairo_set_matrix( aContext, &matrix );
+}
+
+
 void CAIRO_COMPOSITOR::clean()
 {
     CAIRO_BUFFERS::const_iterator it;
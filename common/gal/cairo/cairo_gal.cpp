@@ -1334,6 +1334,7 @@ CAIRO_GAL::CAIRO_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, wxWindow* aParent,
     m_tempBuffer = 0;
     m_savedBuffer = 0;
     m_validCompositor = false;
+    m_isCompositorFresh = true;
     m_currentTarget = TARGET_NONCACHED;
     SetTarget( TARGET_NONCACHED );
 
@@ -1407,6 +1408,10 @@ void CAIRO_GAL::EndDrawing()
 {
     CAIRO_GAL_BASE::EndDrawing();
 
+    // The main buffer is kept for the next frames
+    m_compositor->ClipBuffer( m_mainBuffer, {} );
+    m_isCompositorFresh = false;
+
     // Merge buffers on the screen
     m_compositor->DrawBuffer( m_mainBuffer );
     m_compositor->DrawBuffer( m_overlayBuffer );
@@ -1543,6 +1548,50 @@ void CAIRO_GAL::ClearTarget( RENDER_TARGET aTarget )
 }
 
 
+bool CAIRO_GAL::SetTargetClip( const BOX2I& aArea )
+{
+    // New buffers have nothing worth keeping
+    if( !m_validCompositor || m_isCompositorFresh )
+        return false;
+
+    // Cached and noncached items are rendered to the same buffer
+    m_compositor->ClipBuffer( m_mainBuffer, { aArea } );
+
+    return true;
+}
+
+
+bool CAIRO_GAL::ScrollTargets( const VECTOR2I& aDelta )
+{
+    if( !m_validCompositor || m_isCompositorFresh )
+        return false;
+
+    if( std::abs( aDelta.x ) >= m_screenSize.x || std::abs( aDelta.y ) >= m_screenSize.y )
+        return false;
+
+    m_compositor->ScrollBuffer( m_mainBuffer, aDelta );
+
+    // Only the bands uncovered along the edges are left to redraw
+    std::vector<BOX2I> uncovered;
+
+    if( aDelta.y > 0 )
+        uncovered.emplace_back( VECTOR2I( 0, 0 ), VECTOR2I( m_screenSize.x, aDelta.y ) );
+    else if( aDelta.y < 0 )
+        uncovered.emplace_back( VECTOR2I( 0, m_screenSize.y + aDelta.y ),
+                                VECTOR2I( m_screenSize.x, -aDelta.y ) );
+
+    if( aDelta.x > 0 )
+        uncovered.emplace_back( VECTOR2I( 0, 0 ), VECTOR2I( aDelta.x, m_screenSize.y ) );
+    else if( aDelta.x < 0 )
+        uncovered.emplace_back( VECTOR2I( m_screenSize.x + aDelta.x, 0 ),
+                                VECTOR2I( -aDelta.x, m_screenSize.y ) );
+
+    m_compositor->ClipBuffer( m_mainBuffer, uncovered );
+
+    return true;
+}
+
+
 void CAIRO_GAL::initSurface()
 {
     if( m_isInitialized )
@@ -1620,6 +1669,7 @@ void CAIRO_GAL::setCompositor()
     m_tempBuffer = m_compositor->CreateBuffer();
 
     m_validCompositor = true;
+    m_isCompositorFresh = true;
 }
 
 
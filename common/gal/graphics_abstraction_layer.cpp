@@ -64,6 +64,7 @@ GAL::GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions ) :
     SetLayerDepth( 0.0 );
     SetFlip( false, false );
     SetLineWidth( 1.0f );
+    SetMinPixelSize( 0.0 );
     computeWorldScale();
     SetAxesEnabled( false );
 
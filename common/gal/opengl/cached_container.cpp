@@ -56,7 +56,8 @@ CACHED_CONTAINER::CACHED_CONTAINER( unsigned int aSize ) :
         m_item( nullptr ),
         m_chunkSize( 0 ),
         m_chunkOffset( 0 ),
-        m_maxIndex( 0 )
+        m_maxIndex( 0 ),
+        m_defragmentations( 0 )
 {
     // In the beginning there is only free space
     m_freeChunks.insert( std::make_pair( aSize, 0 ) );
@@ -135,7 +136,7 @@ VERTEX* CACHED_CONTAINER::Allocate( unsigned int aSize )
     m_item->setSize( newSize );
 
     // The content has to be updated
-    m_dirty = true;
+    SetRangeDirty( m_chunkOffset, newSize );
 
 #if CACHED_CONTAINER_TEST > 0
     test();
@@ -239,6 +240,8 @@ bool CACHED_CONTAINER::reallocate( unsigned int aSize )
         if( !result )
             return false;
 
+        m_defragmentations++;
+
         newChunk = m_freeChunks.lower_bound( aSize );
         assert( newChunk != m_freeChunks.end() );
     }
@@ -32,6 +32,7 @@
 
 #include <wx/log.h>
 
+#include <algorithm>
 #include <list>
 
 #include <core/profile.h>
@@ -48,32 +49,25 @@ using namespace KIGFX;
  */
 static const wxChar* const traceGalCachedContainerGpu = wxT( "KICAD_GAL_CACHED_CONTAINER_GPU" );
 
+/// Above this number of separate changed ranges, the whole vertex buffer is uploaded
+static const size_t MAX_UPLOAD_RANGES = 4096;
+
 
 CACHED_CONTAINER_GPU::CACHED_CONTAINER_GPU( unsigned int aSize ) :
         CACHED_CONTAINER( aSize ),
         m_isMapped( false ),
-        m_glBufferHandle( -1 )
+        m_glBufferHandle( -1 ),
+        m_bufferSize( 0 )
 {
-    m_useCopyBuffer = GLEW_ARB_copy_buffer;
-
-    wxString vendor( glGetString( GL_VENDOR ) );
+    KI_TRACE( traceGalProfile, "VBO initial size: %d\n", m_currentSize );
 
-    // workaround for intel GPU drivers:
-    // disable glCopyBuffer, causes crashes/freezes on certain driver versions
-    // Note, Intel's GL_VENDOR string varies depending on GPU/driver generation
-    // But generally always starts with Intel at least
-    if( vendor.StartsWith( "Intel" ) || vendor.Contains( "etnaviv" ) )
-    {
-        m_useCopyBuffer = false;
-    }
+    m_vertices = static_cast<VERTEX*>( malloc( aSize * VERTEX_SIZE ) );
 
-    KI_TRACE( traceGalProfile, "VBO initial size: %d\n", m_currentSize );
+    if( !m_vertices )
+        throw std::bad_alloc();
 
     glGenBuffers( 1, &m_glBufferHandle );
-    glBindBuffer( GL_ARRAY_BUFFER, m_glBufferHandle );
-    glBufferData( GL_ARRAY_BUFFER, m_currentSize * VERTEX_SIZE, nullptr, GL_DYNAMIC_DRAW );
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
-    checkGlError( "allocating video memory for cached container", __FILE__, __LINE__ );
+    checkGlError( "generating vertices buffer", __FILE__, __LINE__ );
 }
 
 
@@ -84,6 +78,8 @@ CACHED_CONTAINER_GPU::~CACHED_CONTAINER_GPU()
 
     if( glDeleteBuffers )
         glDeleteBuffers( 1, &m_glBufferHandle );
+
+    free( m_vertices );
 }
 
 
@@ -95,11 +91,8 @@ void CACHED_CONTAINER_GPU::Map()
     if( !glBindBuffer )
         throw std::runtime_error( "OpenGL no longer available!" );
 
-    glBindBuffer( GL_ARRAY_BUFFER, m_glBufferHandle );
-    m_vertices = static_cast<VERTEX*>( glMapBuffer( GL_ARRAY_BUFFER, GL_READ_WRITE ) );
-
-    if( checkGlError( "mapping vertices buffer", __FILE__, __LINE__ ) == GL_NO_ERROR )
-        m_isMapped = true;
+    // Vertices are written to the copy in RAM, there is nothing to wait for
+    m_isMapped = true;
 }
 
 
@@ -107,135 +100,105 @@ void CACHED_CONTAINER_GPU::Unmap()
 {
     wxCHECK( IsMapped(), /*void*/ );
 
+    m_isMapped = false;
+
+    if( !m_dirty )
+        return;
+
     // This gets called from ~CACHED_CONTAINER_GPU.  To avoid throwing an exception from
     // the dtor, catch it here instead.
     try
     {
-        glUnmapBuffer( GL_ARRAY_BUFFER );
-        checkGlError( "unmapping vertices buffer", __FILE__, __LINE__ );
-        glBindBuffer( GL_ARRAY_BUFFER, 0 );
-        m_vertices = nullptr;
-        checkGlError( "unbinding vertices buffer", __FILE__, __LINE__ );
-    }
-    catch( const std::runtime_error& err )
-    {
-        wxLogError( wxT( "OpenGL did not shut down properly.\n\n%s" ), err.what() );
-    }
-
-    m_isMapped = false;
-}
-
-
-bool CACHED_CONTAINER_GPU::defragmentResize( unsigned int aNewSize )
-{
-    if( !m_useCopyBuffer )
-        return defragmentResizeMemcpy( aNewSize );
-
-    wxCHECK( IsMapped(), false );
-
-    wxLogTrace( traceGalCachedContainerGpu,
-                wxT( "Resizing & defragmenting container from %d to %d" ), m_currentSize,
-                aNewSize );
-
-    // No shrinking if we cannot fit all the data
-    if( usedSpace() > aNewSize )
-        return false;
-
 #ifdef KICAD_GAL_PROFILE
-    PROF_TIMER totalTime;
+        PROF_TIMER totalTime;
 #endif /* KICAD_GAL_PROFILE */
 
-    GLuint newBuffer;
-
-    // glCopyBufferSubData requires a buffer to be unmapped
-    glUnmapBuffer( GL_ARRAY_BUFFER );
-
-    // Create a new destination buffer
-    glGenBuffers( 1, &newBuffer );
+        std::sort( m_dirtyRanges.begin(), m_dirtyRanges.end() );
+
+        // Merge the overlapping and adjacent ranges
+        std::vector<std::pair<unsigned int, unsigned int>> ranges;
+        unsigned int                                       dirtySize = 0;
+
+        for( const auto& [offset, size] : m_dirtyRanges )
+        {
+            if( !ranges.empty() && offset <= ranges.back().first + ranges.back().second )
+            {
+                unsigned int end = std::max( ranges.back().first + ranges.back().second,
+                                             offset + size );
+                ranges.back().second = end - ranges.back().first;
+            }
+            else
+            {
+                ranges.emplace_back( offset, size );
+            }
+        }
+
+        for( const auto& [offset, size] : ranges )
+            dirtySize += size;
+
+        glBindBuffer( GL_ARRAY_BUFFER, m_glBufferHandle );
+        checkGlError( "binding vertices buffer", __FILE__, __LINE__ );
+
+        // Uploading most of the container at once is faster than many small updates
+        if( m_bufferSize != m_currentSize || dirtySize > m_currentSize / 2
+                || ranges.size() > MAX_UPLOAD_RANGES )
+        {
+            // Passing new contents orphans the previous storage, so the frames still drawing
+            // from it are not waited for
+            glBufferData( GL_ARRAY_BUFFER, m_currentSize * VERTEX_SIZE, m_vertices,
+                          GL_DYNAMIC_DRAW );
+            m_bufferSize = m_currentSize;
+            dirtySize = m_currentSize;
+        }
+        else
+        {
+            // The driver queues the changes along with the drawing commands
+            for( const auto& [offset, size] : ranges )
+            {
+                glBufferSubData( GL_ARRAY_BUFFER, offset * VERTEX_SIZE, size * VERTEX_SIZE,
+                                 &m_vertices[offset] );
+            }
+        }
+
+        checkGlError( "transferring vertices", __FILE__, __LINE__ );
+        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+        checkGlError( "unbinding vertices buffer", __FILE__, __LINE__ );
 
-    // It would be best to use GL_COPY_WRITE_BUFFER here,
-    // but it is not available everywhere
 #ifdef KICAD_GAL_PROFILE
-    GLint eaBuffer = -1;
-    glGetIntegerv( GL_ELEMENT_ARRAY_BUFFER_BINDING, &eaBuffer );
-    wxASSERT( eaBuffer == 0 );
-#endif /* KICAD_GAL_PROFILE */
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, newBuffer );
-    glBufferData( GL_ELEMENT_ARRAY_BUFFER, aNewSize * VERTEX_SIZE, nullptr, GL_DYNAMIC_DRAW );
-    checkGlError( "creating buffer during defragmentation", __FILE__, __LINE__ );
-
-    ITEMS::iterator it, it_end;
-    int             newOffset = 0;
-
-    // Defragmentation
-    for( it = m_items.begin(), it_end = m_items.end(); it != it_end; ++it )
-    {
-        VERTEX_ITEM* item = *it;
-        int          itemOffset = item->GetOffset();
-        int          itemSize = item->GetSize();
+        totalTime.Stop();
 
-        // Move an item to the new container
-        glCopyBufferSubData( GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, itemOffset * VERTEX_SIZE,
-                             newOffset * VERTEX_SIZE, itemSize * VERTEX_SIZE );
-
-        // Update new offset
-        item->setOffset( newOffset );
-
-        // Move to the next free space
-        newOffset += itemSize;
+        wxLogTrace( traceGalCachedContainerGpu, "Uploaded %d vertices in %d ranges / %.1f ms",
+                    dirtySize, (int) ranges.size(), totalTime.msecs() );
+#endif /* KICAD_GAL_PROFILE */
     }
-
-    // Move the current item and place it at the end
-    if( m_item->GetSize() > 0 )
+    catch( const std::runtime_error& err )
     {
-        glCopyBufferSubData( GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER,
-                             m_item->GetOffset() * VERTEX_SIZE, newOffset * VERTEX_SIZE,
-                             m_item->GetSize() * VERTEX_SIZE );
-
-        m_item->setOffset( newOffset );
-        m_chunkOffset = newOffset;
+        wxLogError( wxT( "OpenGL did not shut down properly.\n\n%s" ), err.what() );
     }
 
-    // Cleanup
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
-
-    // Previously we have unmapped the array buffer, now when it is also
-    // unbound, it may be officially marked as unmapped
-    m_isMapped = false;
-    glDeleteBuffers( 1, &m_glBufferHandle );
-
-    // Switch to the new vertex buffer
-    m_glBufferHandle = newBuffer;
-    Map();
-    checkGlError( "switching buffers during defragmentation", __FILE__, __LINE__ );
-
-#ifdef KICAD_GAL_PROFILE
-    totalTime.Stop();
-
-    wxLogTrace( traceGalCachedContainerGpu, "Defragmented container storing %d vertices / %.1f ms",
-                m_currentSize - m_freeSpace, totalTime.msecs() );
-#endif /* KICAD_GAL_PROFILE */
-
-    m_freeSpace += ( aNewSize - m_currentSize );
-    m_currentSize = aNewSize;
+    m_dirtyRanges.clear();
+    ClearDirty();
+}
 
-    KI_TRACE( traceGalProfile, "VBO size %d used %d\n", m_currentSize, AllItemsSize() );
 
-    // Now there is only one big chunk of free memory
-    m_freeChunks.clear();
-    m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
+void CACHED_CONTAINER_GPU::SetRangeDirty( unsigned int aOffset, unsigned int aSize )
+{
+    SetDirty();
 
-    return true;
+    // Items grow by successive allocations, so most ranges extend the previous one
+    if( !m_dirtyRanges.empty() && m_dirtyRanges.back().first == aOffset )
+        m_dirtyRanges.back().second = std::max( m_dirtyRanges.back().second, aSize );
+    else
+        m_dirtyRanges.emplace_back( aOffset, aSize );
 }
 
 
-bool CACHED_CONTAINER_GPU::defragmentResizeMemcpy( unsigned int aNewSize )
+bool CACHED_CONTAINER_GPU::defragmentResize( unsigned int aNewSize )
 {
     wxCHECK( IsMapped(), false );
 
     wxLogTrace( traceGalCachedContainerGpu,
-                wxT( "Resizing & defragmenting container (memcpy) from %d to %d" ), m_currentSize,
+                wxT( "Resizing & defragmenting container from %d to %d" ), m_currentSize,
                 aNewSize );
 
     // No shrinking if we cannot fit all the data
@@ -246,36 +209,17 @@ bool CACHED_CONTAINER_GPU::defragmentResizeMemcpy( unsigned int aNewSize )
     PROF_TIMER totalTime;
 #endif /* KICAD_GAL_PROFILE */
 
-    GLuint  newBuffer;
-    VERTEX* newBufferMem;
-
-    // Create the destination buffer
-    glGenBuffers( 1, &newBuffer );
+    VERTEX* newBufferMem = static_cast<VERTEX*>( malloc( aNewSize * VERTEX_SIZE ) );
 
-    // It would be best to use GL_COPY_WRITE_BUFFER here,
-    // but it is not available everywhere
-#ifdef KICAD_GAL_PROFILE
-    GLint eaBuffer = -1;
-    glGetIntegerv( GL_ELEMENT_ARRAY_BUFFER_BINDING, &eaBuffer );
-    wxASSERT( eaBuffer == 0 );
-#endif /* KICAD_GAL_PROFILE */
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, newBuffer );
-    glBufferData( GL_ELEMENT_ARRAY_BUFFER, aNewSize * VERTEX_SIZE, nullptr, GL_DYNAMIC_DRAW );
-    newBufferMem = static_cast<VERTEX*>( glMapBuffer( GL_ELEMENT_ARRAY_BUFFER, GL_WRITE_ONLY ) );
-    checkGlError( "creating buffer during defragmentation", __FILE__, __LINE__ );
+    if( !newBufferMem )
+        throw std::bad_alloc();
 
+    // Defragmenting the copy in RAM doesn't stall the GPU, the whole buffer is sent again on
+    // the next upload
     defragment( newBufferMem );
 
-    // Cleanup
-    glUnmapBuffer( GL_ELEMENT_ARRAY_BUFFER );
-    glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
-    Unmap();
-    glDeleteBuffers( 1, &m_glBufferHandle );
-
-    // Switch to the new vertex buffer
-    m_glBufferHandle = newBuffer;
-    Map();
-    checkGlError( "switching buffers during defragmentation", __FILE__, __LINE__ );
+    free( m_vertices );
+    m_vertices = newBufferMem;
 
 #ifdef KICAD_GAL_PROFILE
     totalTime.Stop();
@@ -287,12 +231,17 @@ bool CACHED_CONTAINER_GPU::defragmentResizeMemcpy( unsigned int aNewSize )
     m_freeSpace += ( aNewSize - m_currentSize );
     m_currentSize = aNewSize;
 
-    KI_TRACE( traceGalProfile, "VBO size %d used: %d \n", m_currentSize, AllItemsSize() );
+    KI_TRACE( traceGalProfile, "VBO size %d used %d\n", m_currentSize, AllItemsSize() );
 
     // Now there is only one big chunk of free memory
     m_freeChunks.clear();
     m_freeChunks.insert( std::make_pair( m_freeSpace, m_currentSize - m_freeSpace ) );
 
+    // Items have moved, so the whole buffer has to be sent again
+    m_bufferSize = 0;
+    m_dirtyRanges.clear();
+    SetDirty();
+
     return true;
 }
 
@@ -59,7 +59,8 @@ GPU_MANAGER::GPU_MANAGER( VERTEX_CONTAINER* aContainer ) :
         m_container( aContainer ),
         m_shader( nullptr ),
         m_shaderAttrib( 0 ),
-        m_enableDepthTest( true )
+        m_enableDepthTest( true ),
+        m_drawCalls( 0 )
 {
 }
 
@@ -120,14 +121,48 @@ void GPU_CACHED_MANAGER::DrawIndices( const VERTEX_ITEM *aItem )
     unsigned int offset = aItem->GetOffset();
     unsigned int size = aItem->GetSize();
 
-    if( size > 1000 )
+    if( size == 0 )
+        return;
+
+    // Items cached one after another are mostly drawn in the same order (e.g. the vias of a
+    // board), so extend the previous range instead of adding one.  Ranges growing big enough
+    // get their own draw call, which saves rebuilding and uploading their indices every frame.
+    if( !m_vranges.empty() && m_vranges.back().m_end + 1 == offset )
+    {
+        VRANGE&      last = m_vranges.back();
+        unsigned int lastSize = last.m_end - last.m_start + 1;
+
+        last.m_end += size;
+
+        if( last.m_isContinuous )
+        {
+            m_totalHuge += size;
+        }
+        else if( lastSize + size > HUGE_VRANGE_SIZE )
+        {
+            m_totalHuge += lastSize + size;
+            m_totalNormal -= lastSize;
+            last.m_isContinuous = true;
+            m_indexBufSize = std::max( m_curVrangeSize - lastSize, m_indexBufSize );
+            m_curVrangeSize = 0;
+        }
+        else
+        {
+            m_totalNormal += size;
+            m_curVrangeSize += size;
+        }
+
+        return;
+    }
+
+    if( size > HUGE_VRANGE_SIZE )
     {
         m_totalHuge += size;
         m_vranges.emplace_back( offset, offset + size - 1, true );
         m_indexBufSize = std::max( m_curVrangeSize, m_indexBufSize );
         m_curVrangeSize = 0;
     }
-    else if ( size > 0 )
+    else
     {
         m_totalNormal += size;
         m_vranges.emplace_back( offset, offset + size - 1, false );
@@ -218,6 +253,8 @@ void GPU_CACHED_MANAGER::EndDrawing()
 
     cntDraw.Stop();
 
+    m_drawCalls += drawCalls;
+
     KI_TRACE( traceGalProfile,
               "Cached manager size: VBO size %u iranges %zu max elt size %u drawcalls %u\n",
               cached->AllItemsSize(), m_vranges.size(), m_indexBufMaxSize, drawCalls );
@@ -305,6 +342,7 @@ void GPU_NONCACHED_MANAGER::EndDrawing()
     }
 
     glDrawArrays( GL_TRIANGLES, 0, m_container->GetSize() );
+    m_drawCalls++;
 
 #ifdef KICAD_GAL_PROFILE
     wxLogTrace( traceGalProfile, wxT( "Noncached manager size: %d" ), m_container->GetSize() );
@@ -78,6 +78,12 @@ wxGLContext* OPENGL_GAL::m_glMainContext = nullptr;
 int          OPENGL_GAL::m_instanceCounter = 0;
 GLuint       OPENGL_GAL::g_fontTexture = 0;
 bool         OPENGL_GAL::m_isBitmapFontLoaded = false;
+GLuint       OPENGL_GAL::g_strokeGlyphTexture = 0;
+
+std::unique_ptr<STROKE_GLYPH_ATLAS> OPENGL_GAL::g_strokeGlyphAtlas;
+
+// Keep the stroke glyph atlas texture always bound to the third texturing unit
+static const GLint STROKE_GLYPH_TEXTURE_UNIT = 3;
 
 namespace KIGFX
 {
@@ -347,6 +353,8 @@ OPENGL_GAL::OPENGL_GAL( const KIGFX::VC_SETTINGS& aVcSettings, GAL_DISPLAY_OPTIO
 
     // Initialize the flags
     m_isFramebufferInitialized = false;
+    m_isFramebufferFresh = false;
+    m_isTargetClipped = false;
     m_isBitmapFontInitialized = false;
     m_isInitialized = false;
     m_isGrouping = false;
@@ -445,6 +453,14 @@ OPENGL_GAL::~OPENGL_GAL()
             m_isBitmapFontLoaded = false;
         }
 
+        if( g_strokeGlyphTexture )
+        {
+            glDeleteTextures( 1, &g_strokeGlyphTexture );
+            g_strokeGlyphTexture = 0;
+        }
+
+        g_strokeGlyphAtlas.reset();
+
         GL_CONTEXT_MANAGER::Get().UnlockCtx( m_glMainContext );
         GL_CONTEXT_MANAGER::Get().DestroyCtx( m_glMainContext );
         m_glMainContext = nullptr;
@@ -493,6 +509,21 @@ void OPENGL_GAL::PostPaint( wxPaintEvent& aEvent )
 }
 
 
+size_t OPENGL_GAL::GetVertexMemoryUsage() const
+{
+    size_t bytes = 0;
+
+    for( const VERTEX_MANAGER* manager : { m_cachedManager, m_nonCachedManager, m_overlayManager,
+                                           m_tempManager } )
+    {
+        if( manager )
+            bytes += manager->GetMemoryUsage();
+    }
+
+    return bytes;
+}
+
+
 bool OPENGL_GAL::updatedGalDisplayOptions( const GAL_DISPLAY_OPTIONS& aOptions )
 {
     GAL_CONTEXT_LOCKER lock( this );
@@ -587,6 +618,7 @@ void OPENGL_GAL::BeginDrawing()
         }
 
         m_isFramebufferInitialized = true;
+        m_isFramebufferFresh = true;
     }
 
     m_compositor->Begin();
@@ -634,6 +666,12 @@ void OPENGL_GAL::BeginDrawing()
     m_overlayManager->BeginDrawing();
     m_tempManager->BeginDrawing();
 
+    for( VERTEX_MANAGER* manager : { m_cachedManager, m_nonCachedManager, m_overlayManager,
+                                     m_tempManager } )
+    {
+        manager->ResetDrawCalls();
+    }
+
     if( !m_isBitmapFontInitialized )
     {
         // Keep bitmap font texture always bound to the second texturing unit
@@ -665,6 +703,7 @@ void OPENGL_GAL::BeginDrawing()
         // Set shader parameter
         GLint ufm_fontTexture = m_shader->AddParameter( "u_fontTexture" );
         GLint ufm_fontTextureWidth = m_shader->AddParameter( "u_fontTextureWidth" );
+        GLint ufm_strokeGlyphTexture = m_shader->AddParameter( "u_strokeGlyphTexture" );
         ufm_worldPixelSize = m_shader->AddParameter( "u_worldPixelSize" );
         ufm_screenPixelSize = m_shader->AddParameter( "u_screenPixelSize" );
         ufm_pixelSizeMultiplier = m_shader->AddParameter( "u_pixelSizeMultiplier" );
@@ -673,6 +712,7 @@ void OPENGL_GAL::BeginDrawing()
         m_shader->Use();
         m_shader->SetParameter( ufm_fontTexture, (int) FONT_TEXTURE_UNIT );
         m_shader->SetParameter( ufm_fontTextureWidth, (int) font_image.width );
+        m_shader->SetParameter( ufm_strokeGlyphTexture, (int) STROKE_GLYPH_TEXTURE_UNIT );
         m_shader->Deactivate();
         checkGlError( "setting bitmap font sampler as shader parameter", __FILE__, __LINE__ );
 
@@ -719,6 +759,9 @@ void OPENGL_GAL::EndDrawing()
     PROF_TIMER cntSwap("gl-swap");
 
     cntTotal.Start();
+    // Glyphs may have been added to the atlas while drawing
+    updateStrokeGlyphTexture();
+
     // Cached & non-cached containers are rendered to the same buffer
     m_compositor->SetBuffer( m_mainBuffer );
 
@@ -730,6 +773,15 @@ void OPENGL_GAL::EndDrawing()
     m_cachedManager->EndDrawing();
     cntEndCached.Stop();
 
+    // The clip only applies to the targets drawn so far
+    if( m_isTargetClipped )
+    {
+        glDisable( GL_SCISSOR_TEST );
+        m_isTargetClipped = false;
+    }
+
+    m_isFramebufferFresh = false;
+
     cntEndOverlay.Start();
     // Overlay container is rendered to a different buffer
     if( m_overlayBuffer )
@@ -738,6 +790,19 @@ void OPENGL_GAL::EndDrawing()
     m_overlayManager->EndDrawing();
     cntEndOverlay.Stop();
 
+    m_renderStatistics = RENDER_STATISTICS();
+    m_renderStatistics.m_cachedVertices = m_cachedManager->GetVertexCount();
+    m_renderStatistics.m_defragmentations = m_cachedManager->GetDefragmentations();
+
+    for( VERTEX_MANAGER* manager : { m_cachedManager, m_nonCachedManager, m_overlayManager,
+                                     m_tempManager } )
+    {
+        m_renderStatistics.m_drawCalls += manager->GetDrawCalls();
+    }
+
+    for( VERTEX_MANAGER* manager : { m_nonCachedManager, m_overlayManager, m_tempManager } )
+        m_renderStatistics.m_nonCachedVertices += manager->GetVertexCount();
+
     cntComposite.Start();
     // Be sure that the framebuffer is not colorized (happens on specific GPU&drivers combinations)
     glColor4d( 1.0, 1.0, 1.0, 1.0 );
@@ -2068,6 +2133,29 @@ void OPENGL_GAL::ClearTarget( RENDER_TARGET aTarget )
 }
 
 
+bool OPENGL_GAL::SetTargetClip( const BOX2I& aArea )
+{
+    // New framebuffers have nothing worth keeping
+    if( m_isFramebufferFresh )
+        return false;
+
+    // The buffers have the size of the screen in physical pixels, times the supersampling
+    double scale = GetScaleFactor() * m_compositor->GetAntialiasSupersamplingFactor();
+    int    height = KiROUND( m_screenSize.y * scale );
+    int    left = std::floor( aArea.GetLeft() * scale );
+    int    right = std::ceil( aArea.GetRight() * scale );
+    int    top = std::floor( aArea.GetTop() * scale );
+    int    bottom = std::ceil( aArea.GetBottom() * scale );
+
+    // OpenGL counts rows from the bottom
+    glEnable( GL_SCISSOR_TEST );
+    glScissor( left, height - bottom, std::max( right - left, 0 ), std::max( bottom - top, 0 ) );
+    m_isTargetClipped = true;
+
+    return true;
+}
+
+
 bool OPENGL_GAL::HasTarget( RENDER_TARGET aTarget )
 {
     switch( aTarget )
@@ -2512,6 +2600,110 @@ void OPENGL_GAL::drawBitmapOverbar( double aLength, double aHeight, bool aReserv
 }
 
 
+const STROKE_GLYPH_ATLAS::CELL*
+OPENGL_GAL::getStrokeGlyphCell( const KIFONT::STROKE_GLYPH& aGlyph )
+{
+    // Only drawing at a known (coarse) detail level may use the atlas, as zooming in on cached
+    // geometry would show its texels
+    if( m_minPixelSize <= 0.0 || !aGlyph.GetSource() )
+        return nullptr;
+
+    const VECTOR2D& xAxis = aGlyph.GetXAxis();
+    const VECTOR2D& yAxis = aGlyph.GetYAxis();
+    double          scale = xAxis.EuclideanNorm();
+
+    // The distance field is only valid for transforms keeping distances proportional
+    if( scale <= 0.0 || std::abs( yAxis.EuclideanNorm() - scale ) > scale * 1e-3
+            || std::abs( xAxis.Dot( yAxis ) ) > scale * scale * 1e-3 )
+    {
+        return nullptr;
+    }
+
+    const double texelSize = scale * STROKE_GLYPH_ATLAS::CELL_EXTENT
+                             / STROKE_GLYPH_ATLAS::CELL_SIZE;
+
+    if( texelSize > m_minPixelSize )
+        return nullptr;
+
+    if( m_lineWidth / 2.0 + m_minPixelSize > scale * STROKE_GLYPH_ATLAS::MAX_DISTANCE )
+        return nullptr;
+
+    if( !g_strokeGlyphAtlas )
+        g_strokeGlyphAtlas = std::make_unique<STROKE_GLYPH_ATLAS>();
+
+    return g_strokeGlyphAtlas->GetCell( aGlyph.GetSource() );
+}
+
+
+void OPENGL_GAL::drawStrokeGlyphQuad( const KIFONT::STROKE_GLYPH&     aGlyph,
+                                      const STROKE_GLYPH_ATLAS::CELL& aCell, bool aReserve )
+{
+    const double scale = aGlyph.GetXAxis().EuclideanNorm();
+    const float  halfWidth = m_lineWidth / 2.0 / scale / STROKE_GLYPH_ATLAS::MAX_DISTANCE;
+
+    const VECTOR2D corners[4] = { aCell.m_quad.GetOrigin(),
+                                  VECTOR2D( aCell.m_quad.GetRight(), aCell.m_quad.GetTop() ),
+                                  VECTOR2D( aCell.m_quad.GetLeft(), aCell.m_quad.GetBottom() ),
+                                  aCell.m_quad.GetEnd() };
+
+    if( aReserve )
+        m_currentManager->Reserve( 6 );
+
+    m_currentManager->Color( m_strokeColor.r, m_strokeColor.g, m_strokeColor.b, m_strokeColor.a );
+
+    for( int idx : { 0, 1, 2, 1, 2, 3 } )
+    {
+        VECTOR2D tex = STROKE_GLYPH_ATLAS::ToTexture( aCell, corners[idx] );
+        VECTOR2D pos = aGlyph.FromSource( corners[idx] );
+
+        m_currentManager->Shader( SHADER_STROKE_FONT, tex.x, tex.y, halfWidth );
+        m_currentManager->Vertex( pos.x, pos.y, m_layerDepth );
+    }
+}
+
+
+void OPENGL_GAL::updateStrokeGlyphTexture()
+{
+    if( g_strokeGlyphAtlas && g_strokeGlyphAtlas->GetDirtyRows().second > 0 )
+    {
+        const int size = STROKE_GLYPH_ATLAS::TEXTURE_SIZE;
+
+        glActiveTexture( GL_TEXTURE0 + STROKE_GLYPH_TEXTURE_UNIT );
+
+        if( !g_strokeGlyphTexture )
+        {
+            glGenTextures( 1, &g_strokeGlyphTexture );
+            glBindTexture( GL_TEXTURE_2D, g_strokeGlyphTexture );
+            glTexImage2D( GL_TEXTURE_2D, 0, GL_LUMINANCE8, size, size, 0, GL_LUMINANCE,
+                          GL_UNSIGNED_BYTE, nullptr );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
+            glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE );
+            checkGlError( "creating stroke glyph texture", __FILE__, __LINE__ );
+        }
+
+        auto [top, count] = g_strokeGlyphAtlas->GetDirtyRows();
+
+        glBindTexture( GL_TEXTURE_2D, g_strokeGlyphTexture );
+        glPixelStorei( GL_UNPACK_ALIGNMENT, 1 );
+        glTexSubImage2D( GL_TEXTURE_2D, 0, 0, top, size, count, GL_LUMINANCE, GL_UNSIGNED_BYTE,
+                         g_strokeGlyphAtlas->GetTexels() + (size_t) top * size );
+        checkGlError( "updating stroke glyph texture", __FILE__, __LINE__ );
+
+        g_strokeGlyphAtlas->ClearDirtyRows();
+    }
+
+    // Texture bindings belong to each context, even with shared textures
+    if( g_strokeGlyphTexture )
+    {
+        glActiveTexture( GL_TEXTURE0 + STROKE_GLYPH_TEXTURE_UNIT );
+        glBindTexture( GL_TEXTURE_2D, g_strokeGlyphTexture );
+        glActiveTexture( GL_TEXTURE0 );
+    }
+}
+
+
 std::pair<VECTOR2D, float> OPENGL_GAL::computeBitmapTextSize( const UTF8& aText ) const
 {
     static const FONT_GLYPH_TYPE* defaultGlyph = LookupGlyph( '(' ); // for strange chars
@@ -2859,12 +3051,22 @@ void OPENGL_GAL::DrawGlyphs( const std::vector<std::unique_ptr<KIFONT::GLYPH>>&
 
     if( allGlyphsAreStroke )
     {
-        // Optimized path for stroke fonts that pre-reserves line quads.
+        // Optimized path for stroke fonts that pre-reserves line quads.  Glyphs small enough
+        // are drawn as one quad from the stroke glyph atlas, which uses as many vertices.
+        std::vector<const STROKE_GLYPH_ATLAS::CELL*> cells( aGlyphs.size(), nullptr );
         int lineQuadCount = 0;
 
-        for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aGlyphs )
+        for( size_t ii = 0; ii < aGlyphs.size(); ++ii )
         {
-            const auto& strokeGlyph = static_cast<const KIFONT::STROKE_GLYPH&>( *glyph );
+            const auto& strokeGlyph = static_cast<const KIFONT::STROKE_GLYPH&>( *aGlyphs[ii] );
+
+            cells[ii] = getStrokeGlyphCell( strokeGlyph );
+
+            if( cells[ii] )
+            {
+                lineQuadCount += 1;
+                continue;
+            }
 
             for( const std::vector<VECTOR2D>& points : strokeGlyph )
                 lineQuadCount += points.size() - 1;
@@ -2872,9 +3074,15 @@ void OPENGL_GAL::DrawGlyphs( const std::vector<std::unique_ptr<KIFONT::GLYPH>>&
 
         reserveLineQuads( lineQuadCount );
 
-        for( const std::unique_ptr<KIFONT::GLYPH>& glyph : aGlyphs )
+        for( size_t ii = 0; ii < aGlyphs.size(); ++ii )
         {
-            const auto& strokeGlyph = static_cast<const KIFONT::STROKE_GLYPH&>( *glyph );
+            const auto& strokeGlyph = static_cast<const KIFONT::STROKE_GLYPH&>( *aGlyphs[ii] );
+
+            if( cells[ii] )
+            {
+                drawStrokeGlyphQuad( strokeGlyph, *cells[ii], false );
+                continue;
+            }
 
             for( const std::vector<VECTOR2D>& points : strokeGlyph )
             {
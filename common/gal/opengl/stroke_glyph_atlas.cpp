@@ -0,0 +1,136 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <gal/opengl/stroke_glyph_atlas.h>
+#include <font/glyph.h>
+#include <math/util.h>
+
+#include <cmath>
+
+using namespace KIGFX;
+
+
+/// Distance from a point to a segment
+static double segmentDistance( const VECTOR2D& aPoint, const VECTOR2D& aStart,
+                               const VECTOR2D& aEnd )
+{
+    VECTOR2D d = aEnd - aStart;
+    double   lengthSq = d.SquaredEuclideanNorm();
+    double   t = 0.0;
+
+    if( lengthSq > 0.0 )
+        t = std::clamp( ( aPoint - aStart ).Dot( d ) / lengthSq, 0.0, 1.0 );
+
+    return ( aPoint - ( aStart + d * t ) ).EuclideanNorm();
+}
+
+
+STROKE_GLYPH_ATLAS::STROKE_GLYPH_ATLAS()
+{
+    ClearDirtyRows();
+}
+
+
+const STROKE_GLYPH_ATLAS::CELL* STROKE_GLYPH_ATLAS::GetCell( const KIFONT::STROKE_GLYPH* aGlyph )
+{
+    auto it = m_cellIndex.find( aGlyph );
+
+    if( it != m_cellIndex.end() )
+        return it->second >= 0 ? &m_cells[it->second] : nullptr;
+
+    int& index = m_cellIndex[aGlyph];
+    index = -1;
+
+    constexpr int cellsPerRow = TEXTURE_SIZE / CELL_SIZE;
+
+    if( m_cells.size() >= (size_t) ( cellsPerRow * cellsPerRow ) )
+        return nullptr;
+
+    BOX2D extents;
+    bool  empty = true;
+
+    for( const std::vector<VECTOR2D>& stroke : *aGlyph )
+    {
+        for( const VECTOR2D& point : stroke )
+        {
+            if( empty )
+                extents = BOX2D( point, VECTOR2D( 0, 0 ) );
+            else
+                extents.Merge( point );
+
+            empty = false;
+        }
+    }
+
+    // The strokes need room around them for the widest pens
+    if( empty || extents.GetWidth() + 2 * MAX_DISTANCE > CELL_EXTENT
+            || extents.GetHeight() + 2 * MAX_DISTANCE > CELL_EXTENT )
+    {
+        return nullptr;
+    }
+
+    int  col = m_cells.size() % cellsPerRow;
+    int  row = m_cells.size() / cellsPerRow;
+    CELL cell;
+
+    cell.m_origin = extents.Centre() - VECTOR2D( CELL_EXTENT, CELL_EXTENT ) / 2.0;
+    cell.m_texOrigin = VECTOR2D( col * CELL_SIZE, row * CELL_SIZE ) / (double) TEXTURE_SIZE;
+    cell.m_quad = extents;
+    cell.m_quad.Inflate( MAX_DISTANCE );
+
+    if( m_texels.empty() )
+        m_texels.resize( TEXTURE_SIZE * TEXTURE_SIZE, 255 );
+
+    const double texelSize = CELL_EXTENT / CELL_SIZE;
+
+    for( int y = 0; y < CELL_SIZE; ++y )
+    {
+        unsigned char* texel = &m_texels[( row * CELL_SIZE + y ) * TEXTURE_SIZE + col * CELL_SIZE];
+
+        for( int x = 0; x < CELL_SIZE; ++x )
+        {
+            // Distances are taken at the centres of the texels
+            VECTOR2D point = cell.m_origin + VECTOR2D( x + 0.5, y + 0.5 ) * texelSize;
+            double   dist = MAX_DISTANCE;
+
+            for( const std::vector<VECTOR2D>& stroke : *aGlyph )
+            {
+                if( stroke.size() == 1 )
+                    dist = std::min( dist, ( point - stroke[0] ).EuclideanNorm() );
+
+                for( size_t ii = 1; ii < stroke.size(); ++ii )
+                    dist = std::min( dist, segmentDistance( point, stroke[ii - 1], stroke[ii] ) );
+            }
+
+            texel[x] = (unsigned char) KiROUND( dist / MAX_DISTANCE * 255.0 );
+        }
+    }
+
+    m_dirtyTop = std::min( m_dirtyTop, row * CELL_SIZE );
+    m_dirtyBottom = std::max( m_dirtyBottom, ( row + 1 ) * CELL_SIZE );
+
+    index = m_cells.size();
+    m_cells.push_back( cell );
+
+    return &m_cells[index];
+}
@@ -191,17 +191,33 @@ void VERTEX_MANAGER::ChangeItemColor( const VERTEX_ITEM& aItem, const COLOR4D& a
     unsigned int offset = aItem.GetOffset();
 
     VERTEX* vertex = m_container->GetVertices( offset );
+    GLubyte r = aColor.r * 255.0;
+    GLubyte g = aColor.g * 255.0;
+    GLubyte b = aColor.b * 255.0;
+    GLubyte a = aColor.a * 255.0;
 
-    for( unsigned int i = 0; i < size; ++i )
+    // Recoloring all the items after a change of a few layers' colors leaves most of them as
+    // they were: skip the vertices which have the color already, so they are not uploaded again
+    unsigned int first = 0;
+
+    while( first < size && vertex[first].r == r && vertex[first].g == g && vertex[first].b == b
+           && vertex[first].a == a )
     {
-        vertex->r = aColor.r * 255.0;
-        vertex->g = aColor.g * 255.0;
-        vertex->b = aColor.b * 255.0;
-        vertex->a = aColor.a * 255.0;
-        vertex++;
+        ++first;
+    }
+
+    if( first == size )
+        return;
+
+    for( unsigned int i = first; i < size; ++i )
+    {
+        vertex[i].r = r;
+        vertex[i].g = g;
+        vertex[i].b = b;
+        vertex[i].a = a;
     }
 
-    m_container->SetDirty();
+    m_container->SetRangeDirty( offset + first, size - first );
 }
 
 
@@ -218,7 +234,7 @@ void VERTEX_MANAGER::ChangeItemDepth( const VERTEX_ITEM& aItem, GLfloat aDepth )
         vertex++;
     }
 
-    m_container->SetDirty();
+    m_container->SetRangeDirty( offset, size );
 }
 
 
@@ -299,3 +315,39 @@ void VERTEX_MANAGER::EnableDepthTest( bool aEnabled )
 {
     m_gpu->EnableDepthTest( aEnabled );
 }
+
+size_t VERTEX_MANAGER::GetMemoryUsage() const
+{
+    return m_container->GetSize() * VERTEX_SIZE;
+}
+
+
+unsigned int VERTEX_MANAGER::GetVertexCount() const
+{
+    // The size of a cached container is its capacity
+    if( m_container->IsCached() )
+        return static_cast<const CACHED_CONTAINER*>( m_container.get() )->AllItemsSize();
+
+    return m_container->GetSize();
+}
+
+
+int VERTEX_MANAGER::GetDefragmentations() const
+{
+    if( m_container->IsCached() )
+        return static_cast<const CACHED_CONTAINER*>( m_container.get() )->GetDefragmentations();
+
+    return 0;
+}
+
+
+unsigned int VERTEX_MANAGER::GetDrawCalls() const
+{
+    return m_gpu->GetDrawCalls();
+}
+
+
+void VERTEX_MANAGER::ResetDrawCalls() const
+{
+    m_gpu->ResetDrawCalls();
+}
@@ -30,7 +30,8 @@
 using namespace KIGFX;
 
 PAINTER::PAINTER( GAL* aGal ) :
-    m_gal( aGal )
+    m_gal( aGal ),
+    m_detailTolerance( 0.0 )
 {
 }
 
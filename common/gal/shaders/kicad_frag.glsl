@@ -35,6 +35,7 @@ const float SHADER_FILLED_CIRCLE        = 2.0;
 const float SHADER_STROKED_CIRCLE       = 3.0;
 const float SHADER_FONT                 = 4.0;
 const float SHADER_LINE_A               = 5.0;
+const float SHADER_STROKE_FONT          = 11.0;
 
 varying vec4 v_shaderParams;
 varying vec2 v_circleCoords;
@@ -45,6 +46,9 @@ uniform float u_worldPixelSize;
 // Needed to reconstruct the mipmap level / texel derivative
 uniform int u_fontTextureWidth;
 
+// Distance to the strokes of the stroke font glyphs
+uniform sampler2D u_strokeGlyphTexture;
+
 void filledCircle( vec2 aCoord )
 {
     if( dot( aCoord, aCoord ) < 1.0 )
@@ -143,6 +147,22 @@ void main()
 
         gl_FragColor = vec4( gl_Color.rgb, alpha );
     }
+    else if( mode == SHADER_STROKE_FONT )
+    {
+        // Distance to the stroke, 1.0 being the largest distance the texture holds
+        float dist         = texture2D( u_strokeGlyphTexture, v_shaderParams.yz ).r;
+        float pixel        = fwidth( dist );
+
+        // Keep strokes thinner than a pixel visible, like the minimum line width does
+        float halfWidth    = max( v_shaderParams.w, pixel * 0.5 );
+        float alpha        = ( 1.0 - smoothstep( halfWidth - pixel * 0.5, halfWidth + pixel * 0.5,
+                                                 dist ) ) * gl_Color.a;
+
+        if( alpha <= 0.0 )
+            discard;
+
+        gl_FragColor = vec4( gl_Color.rgb, alpha );
+    }
     else
     {
         // Simple pass-through
@@ -36,6 +36,7 @@ const float SHADER_LINE_C               = 7.0;
 const float SHADER_LINE_D               = 8.0;
 const float SHADER_LINE_E               = 9.0;
 const float SHADER_LINE_F               = 10.0;
+const float SHADER_STROKE_FONT          = 11.0;
 
 // Minimum line width
 const float MIN_WIDTH = 1.0;
@@ -29,11 +29,59 @@
 #include <kicad_curl/kicad_curl_easy.h>
 #include <curl/curl.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include <async_io.h>
+#include <hash.h>
+#include <ki_exception.h>
+#include <paths.h>
 #include <http_lib/http_lib_connection.h>
 
 const char* const traceHTTPLib = "KICAD_HTTP_LIB";
 
 
+static bool readCacheFile( const wxString& aFilename, std::string& aContents )
+{
+    wxFFile file( aFilename, wxS( "rb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    wxFileOffset length = file.Length();
+
+    if( length < 0 )
+        return false;
+
+    aContents.resize( static_cast<size_t>( length ) );
+
+    return file.Read( aContents.data(), aContents.size() ) == aContents.size();
+}
+
+
+static void writeCacheFile( const wxString& aFilename, const nlohmann::json& aEntry )
+{
+    wxFileName fn( aFilename );
+
+    if( !fn.DirExists() && !wxFileName::Mkdir( fn.GetPath(), wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return;
+
+    // Write next to the final file and rename, so that another instance never reads half of it
+    wxString    tmpName = aFilename + wxS( ".tmp" );
+    std::string contents = aEntry.dump();
+
+    {
+        wxFFile file( tmpName, wxS( "wb" ) );
+
+        if( !file.IsOpened() || file.Write( contents.data(), contents.size() ) != contents.size() )
+            return;
+    }
+
+    if( !wxRenameFile( tmpName, aFilename, true ) )
+        wxRemoveFile( tmpName );
+}
+
+
 HTTP_LIB_CONNECTION::HTTP_LIB_CONNECTION( const HTTP_LIB_SOURCE& aSource, bool aTestConnectionNow )
 {
     m_source = aSource;
@@ -56,18 +104,12 @@ bool HTTP_LIB_CONNECTION::ValidateHTTPLibraryEndpoints()
     m_endpointValid = false;
     std::string res = "";
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url );
+    // Always revalidate the root; a cached copy is only used when the server can't be reached
+    if( !fetch( "", 0, res ) )
+        return false;
 
     try
     {
-        curl->Perform();
-
-        res = curl->GetBuffer();
-
-        if( !checkServerResponse( curl ) )
-            return false;
-
         if( res.length() == 0 )
         {
             m_lastError += wxString::Format( _( "KiCad received an empty response!" ) + "\n" );
@@ -122,20 +164,11 @@ bool HTTP_LIB_CONNECTION::syncCategories()
 
     std::string res = "";
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url + http_endpoint_categories + ".json" );
+    if( !fetch( http_endpoint_categories + ".json", m_source.timeout_categories, res ) )
+        return false;
 
     try
     {
-        curl->Perform();
-
-        res = curl->GetBuffer();
-
-        if( !checkServerResponse( curl ) )
-        {
-            return false;
-        }
-
         nlohmann::json response = nlohmann::json::parse( res );
 
         // collect the categories in vector
@@ -189,116 +222,119 @@ bool HTTP_LIB_CONNECTION::SelectOne( const std::string& aPartID, HTTP_LIB_PART&
 
     std::string res = "";
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url + fmt::format( http_endpoint_parts + "/{}.json", aPartID ) );
+    if( !fetch( fmt::format( http_endpoint_parts + "/{}.json", aPartID ), m_source.timeout_parts,
+                res ) )
+    {
+        return false;
+    }
 
     try
     {
-        curl->Perform();
-
-        res = curl->GetBuffer();
-
-        if( !checkServerResponse( curl ) )
-        {
-            return false;
-        }
-
         nlohmann::json response = nlohmann::json::parse( res );
-        std::string    key = "";
-        std::string    value = "";
 
-        // the id used to identify the part, the name is needed to show a human-readable
-        // part description to the user inside the symbol chooser dialog
-        aFetchedPart.id = response.at( "id" );
+        parsePart( response, aFetchedPart );
+    }
+    catch( const std::exception& e )
+    {
+        m_lastError += wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response:  %s" ) + "\n",
+                                         e.what(), res );
 
-        // get a timestamp for caching
-        aFetchedPart.lastCached = std::time( nullptr );
+        wxLogTrace( traceHTTPLib,
+                    wxT( "SelectOne: Exception occurred while retrieving part from REST API: %s" ),
+                    m_lastError );
 
-        // API might not want to return an optional name.
-        if( response.contains( "name" ) )
-        {
-            aFetchedPart.name = response.at( "name" );
-        }
-        else
-        {
-            aFetchedPart.name = aFetchedPart.id;
-        }
+        return false;
+    }
 
-        aFetchedPart.symbolIdStr = response.at( "symbolIdStr" );
+    m_cachedParts[aFetchedPart.id] = aFetchedPart;
 
-        // initially assume no exclusion
-        std::string exclude;
+    return true;
+}
 
-        if( response.contains( "exclude_from_bom" ) )
-        {
-            // if key value doesn't exists default to false
-            exclude = response.at( "exclude_from_bom" );
-            aFetchedPart.exclude_from_bom = boolFromString( exclude, false );
-        }
 
-        // initially assume no exclusion
-        if( response.contains( "exclude_from_board" ) )
-        {
-            // if key value doesn't exists default to false
-            exclude = response.at( "exclude_from_board" );
-            aFetchedPart.exclude_from_board = boolFromString( exclude, false );
-        }
+bool HTTP_LIB_CONNECTION::parsePart( const nlohmann::json& aPart, HTTP_LIB_PART& aFetchedPart )
+{
+    std::string key = "";
+    std::string value = "";
 
-        // initially assume no exclusion
-        if( response.contains( "exclude_from_sim" ) )
-        {
-            // if key value doesn't exists default to false
-            exclude = response.at( "exclude_from_sim" );
-            aFetchedPart.exclude_from_sim = boolFromString( exclude, false );
-        }
+    // the id used to identify the part, the name is needed to show a human-readable
+    // part description to the user inside the symbol chooser dialog
+    aFetchedPart.id = aPart.at( "id" );
 
-        // Extract available fields
-        for( const auto& field : response.at( "fields" ).items() )
-        {
-            bool visible = true;
+    // get a timestamp for caching
+    aFetchedPart.lastCached = std::time( nullptr );
 
-            // name of the field
-            key = field.key();
+    // API might not want to return an optional name.
+    if( aPart.contains( "name" ) )
+    {
+        aFetchedPart.name = aPart.at( "name" );
+    }
+    else
+    {
+        aFetchedPart.name = aFetchedPart.id;
+    }
 
-            // this is a dict
-            auto& properties = field.value();
+    aFetchedPart.symbolIdStr = aPart.at( "symbolIdStr" );
 
-            value = properties.at( "value" );
+    // initially assume no exclusion
+    std::string exclude;
 
-            // check if user wants to display field in schematic
-            if( properties.contains( "visible" ) )
-            {
-                std::string vis = properties.at( "visible" );
-                visible = boolFromString( vis, true );
-            }
+    if( aPart.contains( "exclude_from_bom" ) )
+    {
+        // if key value doesn't exists default to false
+        exclude = aPart.at( "exclude_from_bom" );
+        aFetchedPart.exclude_from_bom = boolFromString( exclude, false );
+    }
 
-            // Add field to fields list
-            if( key.length() )
-            {
-                aFetchedPart.fields[key] = std::make_tuple( value, visible );
-            }
-        }
+    // initially assume no exclusion
+    if( aPart.contains( "exclude_from_board" ) )
+    {
+        // if key value doesn't exists default to false
+        exclude = aPart.at( "exclude_from_board" );
+        aFetchedPart.exclude_from_board = boolFromString( exclude, false );
     }
-    catch( const std::exception& e )
+
+    // initially assume no exclusion
+    if( aPart.contains( "exclude_from_sim" ) )
     {
-        m_lastError += wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response:  %s" ) + "\n",
-                                         e.what(), res );
+        // if key value doesn't exists default to false
+        exclude = aPart.at( "exclude_from_sim" );
+        aFetchedPart.exclude_from_sim = boolFromString( exclude, false );
+    }
 
-        wxLogTrace( traceHTTPLib,
-                    wxT( "SelectOne: Exception occurred while retrieving part from REST API: %s" ),
-                    m_lastError );
+    // Extract available fields
+    for( const auto& field : aPart.at( "fields" ).items() )
+    {
+        bool visible = true;
 
-        return false;
-    }
+        // name of the field
+        key = field.key();
 
-    m_cachedParts[aFetchedPart.id] = aFetchedPart;
+        // this is a dict
+        auto& properties = field.value();
+
+        value = properties.at( "value" );
+
+        // check if user wants to display field in schematic
+        if( properties.contains( "visible" ) )
+        {
+            std::string vis = properties.at( "visible" );
+            visible = boolFromString( vis, true );
+        }
+
+        // Add field to fields list
+        if( key.length() )
+        {
+            aFetchedPart.fields[key] = std::make_tuple( value, visible );
+        }
+    }
 
     return true;
 }
 
 
 bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory,
-                                     std::vector<HTTP_LIB_PART>& aParts )
+                                     std::vector<HTTP_LIB_PART>& aParts, ASYNC_IO_SCHEDULER* aIO )
 {
     if( !IsValidEndpoint() )
     {
@@ -308,71 +344,275 @@ bool HTTP_LIB_CONNECTION::SelectAll( const HTTP_LIB_CATEGORY& aCategory,
 
     std::string res = "";
 
-    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
-    curl->SetURL( m_source.root_url
-                    + fmt::format( http_endpoint_parts + "/category/{}.json", aCategory.id ) );
+    if( !fetch( fmt::format( http_endpoint_parts + "/category/{}.json", aCategory.id ),
+                m_source.timeout_categories, res, aIO ) )
+    {
+        return false;
+    }
 
-    try
+    bool ok = true;
+
+    auto parse =
+            [&]()
+            {
+                try
+                {
+                    nlohmann::json response = nlohmann::json::parse( res );
+
+                    for( nlohmann::json& item : response )
+                    {
+                        //PART result;
+                        HTTP_LIB_PART part;
+
+                        part.id = item.at( "id" );
+
+                        if( item.contains( "description" ) )
+                        {
+                            // At this point we don't display anything so just set it to false
+                            part.fields["description"] =
+                                    std::make_tuple( item.at( "description" ), false );
+                        }
+
+                        // API might not want to return an optional name.
+                        if( item.contains( "name" ) )
+                        {
+                            part.name = item.at( "name" );
+                        }
+                        else
+                        {
+                            part.name = part.id;
+                        }
+
+                        // Servers may return the full part details in the listing, which saves
+                        // a request per part when the symbols are loaded
+                        if( item.contains( "symbolIdStr" ) && item.contains( "fields" ) )
+                        {
+                            HTTP_LIB_PART fullPart;
+
+                            parsePart( item, fullPart );
+                            m_cachedParts[fullPart.id] = std::move( fullPart );
+                        }
+
+                        // add to cache
+                        m_cache[part.name] = std::make_tuple( part.id, aCategory.id );
+
+                        aParts.emplace_back( std::move( part ) );
+                    }
+                }
+                catch( const std::exception& e )
+                {
+                    m_lastError += wxString::Format( _( "Error: %s" ) + "\n"
+                                                             + _( "API Response:  %s" ) + "\n",
+                                                     e.what(), res );
+
+                    wxLogTrace( traceHTTPLib,
+                                wxT( "Exception occurred while syncing parts from REST API: %s" ),
+                                m_lastError );
+
+                    ok = false;
+                }
+            };
+
+    // Large listings are parsed off the small coroutine stacks
+    if( aIO )
+        aIO->RunOnMainStack( parse );
+    else
+        parse();
+
+    return ok;
+}
+
+
+bool HTTP_LIB_CONNECTION::SelectAll( const std::vector<HTTP_LIB_CATEGORY>& aCategories,
+                                     std::map<std::string, std::vector<HTTP_LIB_PART>>& aParts )
+{
+    ASYNC_IO_SCHEDULER io;
+    bool               ok = true;
+
+    // Requests go out concurrently; the responses are parsed one at a time on this thread
+    for( const HTTP_LIB_CATEGORY& category : aCategories )
     {
-        curl->Perform();
+        io.AddJob(
+                [this, &category, &aParts, &ok]( ASYNC_IO_SCHEDULER& aIO )
+                {
+                    std::vector<HTTP_LIB_PART> parts;
 
-        res = curl->GetBuffer();
+                    if( SelectAll( category, parts, &aIO ) )
+                        aParts[category.id] = std::move( parts );
+                    else
+                        ok = false;
+                } );
+    }
 
-        nlohmann::json response = nlohmann::json::parse( res );
-        std::string    key = "";
-        std::string    value = "";
+    io.Run();
 
-        for( nlohmann::json& item : response )
-        {
-            //PART result;
-            HTTP_LIB_PART part;
+    return ok;
+}
 
-            part.id = item.at( "id" );
 
-            if( item.contains( "description" ) )
-            {
-                // At this point we don't display anything so just set it to false
-                part.fields["description"] = std::make_tuple( item.at( "description" ), false );
-            }
+wxString HTTP_LIB_CONNECTION::cacheFileName( const std::string& aEndpoint ) const
+{
+    wxFileName fn( PATHS::GetUserCachePath(), wxEmptyString );
 
-            // API might not want to return an optional name.
-            if( item.contains( "name" ) )
+    fn.AppendDir( wxS( "http_lib" ) );
+    fn.AppendDir( wxString::Format( wxS( "%016llx" ),
+                                    static_cast<unsigned long long>(
+                                            hash_val( m_source.root_url, m_source.token ) ) ) );
+
+    fn.SetName( wxString::Format( wxS( "%016llx" ),
+                                  static_cast<unsigned long long>( hash_val( aEndpoint ) ) ) );
+    fn.SetExt( wxS( "json" ) );
+
+    return fn.GetFullPath();
+}
+
+
+bool HTTP_LIB_CONNECTION::fetch( const std::string& aEndpoint, int aTimeout,
+                                 std::string& aResponse, ASYNC_IO_SCHEDULER* aIO )
+{
+    struct RESULT
+    {
+        bool        performed = false;
+        int         status = 0;
+        std::string body;
+        std::string etag;
+        std::string error;
+    };
+
+    wxString       cacheFile = cacheFileName( aEndpoint );
+    nlohmann::json cached;
+    std::string    contents;
+
+    auto readCache =
+            [&]()
             {
-                part.name = item.at( "name" );
-            }
-            else
+                return readCacheFile( cacheFile, contents );
+            };
+
+    if( aIO ? aIO->Await( readCache ) : readCache() )
+    {
+        try
+        {
+            cached = nlohmann::json::parse( contents );
+        }
+        catch( const std::exception& e )
+        {
+            wxLogTrace( traceHTTPLib, wxT( "fetch: ignoring damaged cache file %s: %s" ),
+                        cacheFile, e.what() );
+        }
+    }
+
+    bool haveCached = cached.is_object() && cached.contains( "body" )
+                      && cached.contains( "fetched" );
+
+    if( haveCached
+        && std::difftime( std::time( nullptr ), cached.at( "fetched" ).get<std::time_t>() )
+                   < aTimeout )
+    {
+        aResponse = cached.at( "body" ).get<std::string>();
+        return true;
+    }
+
+    std::string url = m_source.root_url + aEndpoint;
+    std::string etag = haveCached ? cached.value( "etag", "" ) : "";
+
+    auto request =
+            [this, url, etag]()
             {
-                part.name = part.id;
-            }
+                RESULT result;
+
+                try
+                {
+                    std::unique_ptr<KICAD_CURL_EASY> curl = createCurlEasyObject();
+                    curl->SetURL( url );
+
+                    if( !etag.empty() )
+                        curl->SetHeader( "If-None-Match", etag );
+
+                    int code = curl->Perform();
+
+                    if( code != CURLE_OK )
+                    {
+                        result.error = curl->GetErrorText( code );
+                        return result;
+                    }
+
+                    result.performed = true;
+                    result.status = curl->GetResponseStatusCode();
+                    result.body = curl->GetBuffer();
+                    result.etag = curl->GetResponseHeader( "ETag" );
+                }
+                catch( const IO_ERROR& e )
+                {
+                    result.error = e.What().ToStdString();
+                }
+                catch( const std::exception& e )
+                {
+                    result.error = e.what();
+                }
 
-            // add to cache
-            m_cache[part.name] = std::make_tuple( part.id, aCategory.id );
+                return result;
+            };
+
+    RESULT result = aIO ? aIO->Await( request ) : request();
+
+    if( !result.performed )
+    {
+        if( haveCached )
+        {
+            wxLogTrace( traceHTTPLib, wxT( "fetch: %s unreachable (%s), using cached response" ),
+                        url, result.error );
 
-            aParts.emplace_back( std::move( part ) );
+            aResponse = cached.at( "body" ).get<std::string>();
+            return true;
         }
+
+        m_lastError += wxString::Format( _( "Error: %s" ) + "\n", result.error );
+        return false;
     }
-    catch( const std::exception& e )
+
+    if( result.status == 304 && haveCached )
     {
-        m_lastError += wxString::Format( _( "Error: %s" ) + "\n" + _( "API Response:  %s" ) + "\n",
-                                         e.what(), res );
+        aResponse = cached.at( "body" ).get<std::string>();
+        cached["fetched"] = std::time( nullptr );
+    }
+    else
+    {
+        if( !checkServerResponse( result.status ) )
+            return false;
 
-        wxLogTrace( traceHTTPLib, wxT( "Exception occurred while syncing parts from REST API: %s" ),
-                    m_lastError );
+        aResponse = std::move( result.body );
 
-        return false;
+        cached = nlohmann::json::object();
+        cached["fetched"] = std::time( nullptr );
+        cached["body"] = aResponse;
+
+        if( !result.etag.empty() )
+            cached["etag"] = result.etag;
     }
 
+    auto writeCache =
+            [&]()
+            {
+                writeCacheFile( cacheFile, cached );
+                return true;
+            };
+
+    if( aIO )
+        aIO->Await( writeCache );
+    else
+        writeCache();
+
     return true;
 }
 
 
-bool HTTP_LIB_CONNECTION::checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl )
+bool HTTP_LIB_CONNECTION::checkServerResponse( int aStatusCode )
 {
-    int statusCode = aCurl->GetResponseStatusCode();
-    if( statusCode != 200 )
+    if( aStatusCode != 200 )
     {
         m_lastError += wxString::Format( _( "API responded with error code: %s" ) + "\n",
-                                         httpErrorCodeDescription( statusCode ) );
+                                         httpErrorCodeDescription( aStatusCode ) );
         return false;
     }
 
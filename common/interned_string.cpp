@@ -0,0 +1,104 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <array>
+#include <mutex>
+#include <unordered_set>
+
+#include <interned_string.h>
+
+
+/**
+ * The table is split in shards, each with its own lock, so that threads interning different
+ * names rarely contend.  Elements of an unordered_set keep their address when the set grows,
+ * which is what lets INTERNED_STRING hold a plain pointer.
+ */
+struct INTERN_TABLE
+{
+    static constexpr size_t SHARDS = 16;
+
+    struct ENTRY_HASH
+    {
+        size_t operator()( const INTERNED_STRING::ENTRY& aEntry ) const { return aEntry.m_hash; }
+    };
+
+    struct ENTRY_EQUAL
+    {
+        bool operator()( const INTERNED_STRING::ENTRY& aLhs,
+                         const INTERNED_STRING::ENTRY& aRhs ) const
+        {
+            return aLhs.m_str == aRhs.m_str;
+        }
+    };
+
+    struct SHARD
+    {
+        std::mutex                                                          m_mutex;
+        std::unordered_set<INTERNED_STRING::ENTRY, ENTRY_HASH, ENTRY_EQUAL> m_strings;
+    };
+
+    std::array<SHARD, SHARDS> m_shards;
+};
+
+
+static INTERN_TABLE& internTable()
+{
+    // Deliberately leaked: interned strings may be referenced from other static objects
+    // during shutdown.
+    static INTERN_TABLE* table = new INTERN_TABLE();
+    return *table;
+}
+
+
+const INTERNED_STRING::ENTRY* INTERNED_STRING::intern( const wxString& aString )
+{
+    const size_t         hash = std::hash<wxString>()( aString );
+    INTERN_TABLE::SHARD& shard = internTable().m_shards[hash % INTERN_TABLE::SHARDS];
+
+    std::lock_guard<std::mutex> lock( shard.m_mutex );
+
+    return &*shard.m_strings.insert( ENTRY{ aString, hash } ).first;
+}
+
+
+INTERNED_STRING::INTERNED_STRING()
+{
+    static const ENTRY* empty = intern( wxEmptyString );
+    m_entry = empty;
+}
+
+
+INTERNED_STRING::INTERNED_STRING( const wxString& aString ) :
+        m_entry( intern( aString ) )
+{
+}
+
+
+size_t INTERNED_STRING::GetTableSize()
+{
+    size_t count = 0;
+
+    for( INTERN_TABLE::SHARD& shard : internTable().m_shards )
+    {
+        std::lock_guard<std::mutex> lock( shard.m_mutex );
+        count += shard.m_strings.size();
+    }
+
+    return count;
+}
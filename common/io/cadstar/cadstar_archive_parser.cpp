@@ -26,6 +26,8 @@
 #include <wx/log.h>
 #include <wx/xml/xml.h>
 
+#include <memory>
+
 #include <dsnlexer.h>
 #include <geometry/shape_poly_set.h>
 #include <io/cadstar/cadstar_archive_parser.h>
@@ -2448,13 +2450,73 @@ void CADSTAR_ARCHIVE_PARSER::InsertAttributeAtEnd( XNODE* aNode, wxString aValue
 }
 
 
+/**
+ * A node of the tree being read by CADSTAR_ARCHIVE_PARSER::LoadArchiveFile() which is still
+ * open.  wxXmlNode::AddChild() and wxXmlNode::AddAttribute() walk the whole list they append
+ * to, which is quadratic for the nodes of an archive holding thousands of children, so the
+ * ends of the lists are kept here instead.
+ */
+struct ARCHIVE_OPEN_NODE
+{
+    XNODE*          m_node;
+    XNODE*          m_lastChild = nullptr;
+    wxXmlAttribute* m_lastAttribute = nullptr;
+    long            m_numAttributes = 0;
+
+    void AppendAttribute( const wxString& aName, const wxString& aValue )
+    {
+        wxXmlAttribute* attribute = new wxXmlAttribute( aName, aValue );
+
+        if( m_lastAttribute )
+            m_lastAttribute->SetNext( attribute );
+        else
+            m_node->SetAttributes( attribute );
+
+        m_lastAttribute = attribute;
+    }
+
+    /// Same as CADSTAR_ARCHIVE_PARSER::InsertAttributeAtEnd(), but in constant time
+    void InsertAttributeAtEnd( const wxString& aValue )
+    {
+        wxString name = wxS( "attr" );
+        name << m_numAttributes++;
+
+        AppendAttribute( name, aValue );
+    }
+
+    void AppendChild( XNODE* aChild )
+    {
+        aChild->SetParent( m_node );
+
+        if( m_lastChild )
+            m_lastChild->SetNext( aChild );
+        else
+            m_node->SetChildren( aChild );
+
+        m_lastChild = aChild;
+    }
+
+    /// Close the node; like CADSTAR_ARCHIVE_PARSER::InsertAttributeAtEnd(), "numAttributes"
+    /// holds the index of the last attribute
+    void Close()
+    {
+        if( m_numAttributes > 0 )
+        {
+            wxString last;
+            last << m_numAttributes - 1;
+
+            AppendAttribute( wxS( "numAttributes" ), last );
+        }
+    }
+};
+
+
 XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
                                                 const wxString& aFileTypeIdentifier, PROGRESS_REPORTER* aProgressReporter )
 {
     KEYWORD   emptyKeywords[1] = {};
     XNODE*    rootNode = nullptr;
     XNODE*    cNode = nullptr;
-    XNODE*    iNode = nullptr;
     int       tok;
     bool      cadstarFileCheckDone = false;
     wxString  str;
@@ -2462,6 +2524,9 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
     wxMBConv* conv = &win1252; // Initial testing suggests file encoding to be Windows-1252
                                // More samples required.
 
+    std::vector<ARCHIVE_OPEN_NODE>      openNodes;
+    std::vector<std::unique_ptr<XNODE>> strayNodes;
+
     // Open the file and get the file size
     FILE* fp = wxFopen( aFileName, wxT( "rt" ) );
 
@@ -2479,6 +2544,21 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
                                 return static_cast<double>( ftell( fp ) ) / fileSize;
                             };
 
+    // Almost all the tokens are plain ASCII, which doesn't need the full code page conversion
+    auto currentText =
+            [&]() -> wxString
+            {
+                const char* text = lexer.CurText();
+
+                for( const char* c = text; *c; ++c )
+                {
+                    if( static_cast<unsigned char>( *c ) >= 0x80 )
+                        return wxString( text, *conv );
+                }
+
+                return wxString::FromAscii( text );
+            };
+
     double previousReportedProgress = -1.0;
 
     while( ( tok = lexer.NextTok() ) != DSN_EOF )
@@ -2497,10 +2577,10 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
 
         if( tok == DSN_RIGHT )
         {
-            cNode = iNode;
-            if( cNode )
+            if( !openNodes.empty() )
             {
-                iNode = cNode->GetParent();
+                openNodes.back().Close();
+                openNodes.pop_back();
             }
             else
             {
@@ -2512,17 +2592,17 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
         else if( tok == DSN_LEFT )
         {
             tok   = lexer.NextTok();
-            str   = wxString( lexer.CurText(), *conv );
+            str   = currentText();
             cNode = new XNODE( wxXML_ELEMENT_NODE, str );
 
             if( !rootNode )
                 rootNode = cNode;
 
-            if( iNode )
+            if( !openNodes.empty() )
             {
                 //we will add it as attribute as well as child node
-                InsertAttributeAtEnd( iNode, str );
-                iNode->AddChild( cNode );
+                openNodes.back().InsertAttributeAtEnd( str );
+                openNodes.back().AppendChild( cNode );
             }
             else if( !cadstarFileCheckDone )
             {
@@ -2534,14 +2614,18 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
 
                 cadstarFileCheckDone = true;
             }
+            else
+            {
+                // Nodes after the root one aren't part of the tree and are dropped
+                strayNodes.emplace_back( cNode );
+            }
 
-            iNode = cNode;
+            openNodes.push_back( { cNode } );
         }
-        else if( iNode )
+        else if( !openNodes.empty() )
         {
-            str = wxString( lexer.CurText(), *conv );
             //Insert even if string is empty
-            InsertAttributeAtEnd( iNode, str );
+            openNodes.back().InsertAttributeAtEnd( currentText() );
         }
         else
         {
@@ -2552,7 +2636,7 @@ XNODE* CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( const wxString& aFileName,
     }
 
     // Not enough closing brackets
-    if( iNode != nullptr )
+    if( !openNodes.empty() )
     {
         delete rootNode;
         THROW_IO_ERROR( _( "The selected file is not valid or might be corrupt!" ) );
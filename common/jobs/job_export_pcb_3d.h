@@ -62,6 +62,8 @@ public:
     double                    m_BoardOutlinesChainingEpsilon;
     bool                      m_exportTracks;
     bool                      m_exportZones;
+    bool                      m_fastMesh;            ///< GLB of meshes only, for previews
+    double                    m_meshDecimation;      ///< Decimation cell size in mm for m_fastMesh
     JOB_EXPORT_PCB_3D::FORMAT m_format;
 
     VRML_UNITS m_vrmlUnits;
@@ -36,6 +36,7 @@ JOB_EXPORT_PCB_GERBER::JOB_EXPORT_PCB_GERBER( const std::string& aType, bool aIs
     m_useAuxOrigin( false ),
     m_useProtelFileExtension( true ),
     m_precision( 5 ),
+    m_refillIfStale( false ),
     m_printMaskLayer()
 {
 }
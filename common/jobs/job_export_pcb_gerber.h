@@ -48,6 +48,8 @@ public:
 
     int m_precision;
 
+    /// Refill the zones whose fills are out of date before plotting
+    bool m_refillIfStale;
 
     LSEQ m_printMaskLayer;
 };
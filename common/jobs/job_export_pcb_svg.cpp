@@ -30,6 +30,7 @@ JOB_EXPORT_PCB_SVG::JOB_EXPORT_PCB_SVG( bool aIsCli ) :
     m_mirror( false ),
     m_blackAndWhite( false ),
     m_negative( false ),
+    m_compact( false ),
     m_plotDrawingSheet( true ),
     m_pageSizeMode( 0 ),
     m_printMaskLayer(),
@@ -39,6 +39,7 @@ public:
     bool m_mirror;
     bool m_blackAndWhite;
     bool m_negative;
+    bool m_compact;
 
     bool m_plotDrawingSheet;
     int m_pageSizeMode;
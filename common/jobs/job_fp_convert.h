@@ -0,0 +1,48 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_FP_CONVERT_H
+#define JOB_FP_CONVERT_H
+
+#include <kicommon.h>
+#include <vector>
+#include <wx/string.h>
+#include "job.h"
+
+/**
+ * Convert footprint libraries of any format with an importer to KiCad footprint libraries.
+ */
+class KICOMMON_API JOB_FP_CONVERT : public JOB
+{
+public:
+    JOB_FP_CONVERT( bool aIsCli );
+
+    std::vector<wxString> m_libraryPaths;
+
+    /// Where the ".pretty" libraries are written; next to each source library when empty
+    wxString m_outputDirectory;
+
+    /// Overwrite existing output libraries
+    bool m_force;
+
+    /// Number of libraries converted at the same time; 0 for as many as the thread pool runs
+    int m_threads;
+};
+
+#endif
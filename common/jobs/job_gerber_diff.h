@@ -0,0 +1,40 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOB_GERBER_DIFF_H
+#define JOB_GERBER_DIFF_H
+
+#include <kicommon.h>
+#include <wx/string.h>
+#include "job.h"
+
+class KICOMMON_API JOB_GERBER_DIFF : public JOB
+{
+public:
+    JOB_GERBER_DIFF( bool aIsCli );
+
+    wxString m_firstFile;
+    wxString m_secondFile;
+    wxString m_outputFile;    ///< Report file, the report is only printed if empty
+
+    double m_tolerance;       ///< Width of the thinnest difference reported, in mm
+    bool   m_exitCodeOnDiff;  ///< Return ERR_RC_VIOLATIONS if the files differ
+};
+
+#endif
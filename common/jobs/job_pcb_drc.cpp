@@ -29,6 +29,12 @@ JOB_PCB_DRC::JOB_PCB_DRC( bool aIsCli ) :
     m_severity( RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING ),
     m_format( OUTPUT_FORMAT::REPORT ),
     m_exitCodeViolations( false ),
-    m_parity( false )
+    m_parity( false ),
+    m_useCache( false ),
+    m_reportTimings( false ),
+    m_refillIfStale( false ),
+    m_restrictArea( false ),
+    m_shardCount( 0 ),
+    m_shardIndex( -1 )
 {
 }
\ No newline at end of file
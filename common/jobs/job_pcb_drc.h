@@ -23,6 +23,8 @@
 
 #include <kicommon.h>
 #include <layer_ids.h>
+#include <math/vector2d.h>
+#include <vector>
 #include <wx/string.h>
 #include <widgets/report_severity.h>
 #include "job.h"
@@ -58,6 +60,37 @@ public:
 
     bool m_exitCodeViolations;
     bool m_parity;
+
+    /// Only re-test the items changed since the results stored next to the board
+    bool m_useCache;
+
+    /// Add the time spent by each test and rule to the report
+    bool m_reportTimings;
+
+    /// Refill the zones whose fills are out of date before running DRC
+    bool m_refillIfStale;
+
+    /// Only report the violations located between these corners, in m_units
+    bool     m_restrictArea;
+    VECTOR2D m_areaStart;
+    VECTOR2D m_areaEnd;
+
+    /// Only report the violations on these layers; all layers when empty
+    LSET     m_layers;
+
+    /// Only report the violations involving these nets (wildcards allowed) or footprints
+    std::vector<wxString> m_nets;
+    std::vector<wxString> m_references;
+
+    /// Run DRC in this many worker processes, each one on a strip of the board
+    int      m_shardCount;
+
+    /// Be the worker of the m_shardIndex-th strip, and save its violations to m_outputFile
+    /// instead of writing a report.  -1 for a coordinator.
+    int      m_shardIndex;
+
+    /// Write the report of the violations saved by workers run elsewhere, instead of running DRC
+    std::vector<wxString> m_shardFiles;
 };
 
 #endif
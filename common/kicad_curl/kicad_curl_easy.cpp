@@ -29,6 +29,8 @@
 #include <kicad_curl/kicad_curl.h>
 #include <kicad_curl/kicad_curl_easy.h>
 
+#include <algorithm>
+#include <cctype>
 #include <cstdarg>
 #include <cstddef>
 #include <exception>
@@ -83,6 +85,41 @@ static size_t stream_write_callback( void* aContents, size_t aSize, size_t aNmem
     return realsize;
 }
 
+static size_t header_callback( char* aBuffer, size_t aSize, size_t aNitems, void* aUserp )
+{
+    size_t realsize = aSize * aNitems;
+
+    auto*       headers = static_cast<std::map<std::string, std::string>*>( aUserp );
+    std::string line( aBuffer, realsize );
+    size_t      colon = line.find( ':' );
+
+    // Skip the status line and the blank line ending the headers
+    if( colon == std::string::npos )
+        return realsize;
+
+    std::string name = line.substr( 0, colon );
+    std::string value = line.substr( colon + 1 );
+
+    std::transform( name.begin(), name.end(), name.begin(),
+                    []( unsigned char c )
+                    {
+                        return std::tolower( c );
+                    } );
+
+    size_t first = value.find_first_not_of( " \t" );
+    size_t last = value.find_last_not_of( " \t\r\n" );
+
+    if( first == std::string::npos )
+        value.clear();
+    else
+        value = value.substr( first, last - first + 1 );
+
+    ( *headers )[name] = value;
+
+    return realsize;
+}
+
+
 #if LIBCURL_VERSION_NUM >= 0x072000 // 7.32.0
 
 static int xferinfo( void* aProgress, curl_off_t aDLtotal, curl_off_t aDLnow, curl_off_t aULtotal,
@@ -123,6 +160,8 @@ KICAD_CURL_EASY::KICAD_CURL_EASY() :
 
     curl_easy_setopt( m_CURL, CURLOPT_WRITEFUNCTION, write_callback );
     curl_easy_setopt( m_CURL, CURLOPT_WRITEDATA, static_cast<void*>( &m_buffer ) );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERFUNCTION, header_callback );
+    curl_easy_setopt( m_CURL, CURLOPT_HEADERDATA, static_cast<void*>( &m_responseHeaders ) );
 
     // Only allow HTTP and HTTPS protocols
 #if LIBCURL_VERSION_NUM >= 0x075500     // version 7.85.0
@@ -195,6 +234,7 @@ int KICAD_CURL_EASY::Perform()
 
     // bonus: retain worst case memory allocation, should re-use occur
     m_buffer.clear();
+    m_responseHeaders.clear();
 
     return curl_easy_perform( m_CURL );
 }
@@ -357,4 +397,20 @@ int KICAD_CURL_EASY::GetResponseStatusCode()
     curl_easy_getinfo( m_CURL, CURLINFO_RESPONSE_CODE, &http_code );
 
     return static_cast<int>( http_code );
-}
\ No newline at end of file
+}
+
+
+std::string KICAD_CURL_EASY::GetResponseHeader( const std::string& aName ) const
+{
+    std::string name = aName;
+
+    std::transform( name.begin(), name.end(), name.begin(),
+                    []( unsigned char c )
+                    {
+                        return std::tolower( c );
+                    } );
+
+    auto it = m_responseHeaders.find( name );
+
+    return it != m_responseHeaders.end() ? it->second : std::string();
+}
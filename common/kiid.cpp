@@ -109,11 +109,69 @@ KIID::KIID( int null ) :
 }
 
 
+/**
+ * Parse the canonical 8-4-4-4-12 hex form of a UUID, which is what KiCad writes.  Much faster
+ * than boost's string_generator, which also accepts braces and undashed forms.
+ *
+ * @return false if \a aString is not in canonical form.
+ */
+static bool parseCanonicalUuid( const std::string& aString, boost::uuids::uuid& aUuid )
+{
+    if( aString.length() != 36 )
+        return false;
+
+    auto hexValue =
+            []( char c ) -> int
+            {
+                if( c >= '0' && c <= '9' )
+                    return c - '0';
+
+                if( c >= 'a' && c <= 'f' )
+                    return c - 'a' + 10;
+
+                if( c >= 'A' && c <= 'F' )
+                    return c - 'A' + 10;
+
+                return -1;
+            };
+
+    const char* str = aString.data();
+    size_t      pos = 0;
+
+    for( size_t ii = 0; ii < 16; ++ii )
+    {
+        if( pos == 8 || pos == 13 || pos == 18 || pos == 23 )
+        {
+            if( str[pos] != '-' )
+                return false;
+
+            ++pos;
+        }
+
+        int hi = hexValue( str[pos] );
+        int lo = hexValue( str[pos + 1] );
+
+        if( hi < 0 || lo < 0 )
+            return false;
+
+        aUuid.data[ii] = static_cast<uint8_t>( ( hi << 4 ) | lo );
+        pos += 2;
+    }
+
+    return true;
+}
+
+
 KIID::KIID( const std::string& aString ) :
         m_uuid(),
         m_cached_timestamp( 0 )
 {
-    if( aString.length() == 8
+    if( parseCanonicalUuid( aString, m_uuid ) )
+    {
+        if( IsLegacyTimestamp() )
+            m_cached_timestamp = strtol( aString.substr( 28 ).c_str(), nullptr, 16 );
+    }
+    else if( aString.length() == 8
         && std::all_of( aString.begin(), aString.end(),
                         []( unsigned char c )
                         {
@@ -149,6 +207,7 @@ KIID::KIID( const std::string& aString ) :
             {
 #endif
 
+                std::lock_guard<std::mutex> lock( rng_mutex );
                 m_uuid = randomGenerator();
 
 #if BOOST_VERSION >= 106700
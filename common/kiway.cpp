@@ -32,6 +32,7 @@
 #include <pgm_base.h>
 #include <config.h>
 #include <core/arraydim.h>
+#include <core/trace_profiler.h>
 #include <id.h>
 #include <kiplatform/app.h>
 #include <kiplatform/environment.h>
@@ -219,6 +220,8 @@ KIFACE* KIWAY::KiFACE( FACE_T aFaceId, bool doLoad )
     // DSO with KIFACE has not been loaded yet, does caller want to load it?
     if( doLoad )
     {
+        TRACE_SCOPE( "Load kiface" );
+
         wxString dname = dso_search_path( aFaceId );
 
         // Insert DLL search path for kicad_3dsg from build dir
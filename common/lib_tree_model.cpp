@@ -288,10 +288,17 @@ void LIB_TREE_NODE_LIBRARY::UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const w
                                          std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
 {
     for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
-    {
         child->UpdateScore( aMatcher, aLib, aFilter );
+
+    UpdateOwnScore( aMatcher, aLib, aFilter );
+}
+
+
+void LIB_TREE_NODE_LIBRARY::UpdateOwnScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
+                                            std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
+{
+    for( std::unique_ptr<LIB_TREE_NODE>& child: m_Children )
         m_Score = std::max( m_Score, child->m_Score );
-    }
 
     // aLib test is additive
     if( !aLib.IsEmpty() && m_Name.Lower().Matches( aLib ) )
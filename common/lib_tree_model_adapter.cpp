@@ -20,6 +20,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <core/thread_pool.h>
 #include <eda_base_frame.h>
 #include <eda_pattern_match.h>
 #include <kiface_base.h>
@@ -33,6 +34,7 @@
 #include <wx/settings.h>
 #include <wx/dc.h>
 #include <string_utils.h>
+#include <unordered_map>
 
 
 static const int kDataViewIndent = 20;
@@ -128,7 +130,8 @@ LIB_TREE_MODEL_ADAPTER::LIB_TREE_MODEL_ADAPTER( EDA_BASE_FRAME* aParent,
         m_show_units( true ),
         m_preselect_unit( 0 ),
         m_freeze( 0 ),
-        m_filter( nullptr )
+        m_filter( nullptr ),
+        m_lastMatchesValid( false )
 {
     // Default column widths.  Do not translate these names.
     m_colWidths[ _HKI( "Item" ) ] = 300;
@@ -224,6 +227,7 @@ LIB_TREE_NODE_LIBRARY& LIB_TREE_MODEL_ADAPTER::DoAddLibraryNode( const wxString&
     LIB_TREE_NODE_LIBRARY& lib_node = m_tree.AddLib( aNodeName, aDesc );
 
     lib_node.m_Pinned = pinned;
+    invalidateSearchResults();
 
     return lib_node;
 }
@@ -242,6 +246,169 @@ void LIB_TREE_MODEL_ADAPTER::DoAddLibrary( const wxString& aNodeName, const wxSt
 }
 
 
+/**
+ * @return true if every item matching \a aNew also matches \a aOld: both have the same number
+ *         of terms, each term of \a aNew contains the matching term of \a aOld, and \a aNew
+ *         uses no library, wildcard, regex or relational syntax.
+ */
+static bool isNarrowingSearch( const wxString& aOld, const wxString& aNew )
+{
+    if( aOld == aNew )
+        return false;
+
+    wxArrayString oldTerms = wxStringTokenize( aOld.Lower() );
+    wxArrayString newTerms = wxStringTokenize( aNew.Lower() );
+
+    if( oldTerms.empty() || oldTerms.size() != newTerms.size() )
+        return false;
+
+    for( size_t ii = 0; ii < newTerms.size(); ++ii )
+    {
+        if( newTerms[ii].find_first_of( wxS( ":*?<>=.^$|+\\()[]{}" ) ) != wxString::npos )
+            return false;
+
+        if( !newTerms[ii].Contains( oldTerms[ii] ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+void LIB_TREE_MODEL_ADAPTER::updateScores( const wxString& aSearch )
+{
+    std::vector<LIB_TREE_NODE*> items;
+
+    // Scores only ever get added for terms found in an item, so an item which didn't match
+    // any of the previous terms can't match their extensions either.
+    if( m_lastMatchesValid && isNarrowingSearch( m_lastSearch, aSearch ) )
+    {
+        items = std::move( m_lastMatches );
+    }
+    else
+    {
+        for( std::unique_ptr<LIB_TREE_NODE>& lib : m_tree.m_Children )
+        {
+            for( std::unique_ptr<LIB_TREE_NODE>& item : lib->m_Children )
+                items.push_back( item.get() );
+        }
+    }
+
+    m_tree.ResetScore();
+
+    // The filter may look at UI state (chooser checkboxes and such), so run it here on the
+    // main thread and hand the workers its cached results.
+    std::unordered_map<const LIB_TREE_NODE*, bool> filterResults;
+    std::function<bool( LIB_TREE_NODE& aNode )>    cachedFilter;
+    std::function<bool( LIB_TREE_NODE& aNode )>*   filter = nullptr;
+
+    if( m_filter )
+    {
+        for( LIB_TREE_NODE* item : items )
+        {
+            filterResults[item] = ( *m_filter )( *item );
+
+            for( std::unique_ptr<LIB_TREE_NODE>& unit : item->m_Children )
+                filterResults[unit.get()] = ( *m_filter )( *unit );
+        }
+
+        for( std::unique_ptr<LIB_TREE_NODE>& lib : m_tree.m_Children )
+        {
+            if( lib->m_Children.empty() )
+                filterResults[lib.get()] = ( *m_filter )( *lib );
+        }
+
+        cachedFilter =
+                [&]( LIB_TREE_NODE& aNode ) -> bool
+                {
+                    return filterResults.at( &aNode );
+                };
+
+        filter = &cachedFilter;
+    }
+
+    // Matchers keep per-match state, so each chunk of items gets its own
+    const size_t minChunkSize = 256;
+    const size_t chunkCount = std::max<size_t>( 1, std::min( items.size() / minChunkSize,
+                                                   GetKiCadThreadPool().get_thread_count() * 4 ) );
+    const size_t chunkSize = ( items.size() + chunkCount - 1 ) / chunkCount;
+
+    auto scoreStage =
+            [&]( const wxString* aTerm, const wxString& aLib,
+                 std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
+            {
+                std::vector<std::unique_ptr<EDA_COMBINED_MATCHER>> matchers;
+
+                if( aTerm )
+                {
+                    for( size_t ii = 0; ii < chunkCount; ++ii )
+                        matchers.push_back( std::make_unique<EDA_COMBINED_MATCHER>( *aTerm,
+                                                                                   CTX_LIBITEM ) );
+                }
+
+                ParallelFor( chunkCount,
+                        [&]( size_t aChunk )
+                        {
+                            EDA_COMBINED_MATCHER* matcher = aTerm ? matchers[aChunk].get()
+                                                                  : nullptr;
+                            size_t end = std::min( items.size(), ( aChunk + 1 ) * chunkSize );
+
+                            for( size_t ii = aChunk * chunkSize; ii < end; ++ii )
+                                items[ii]->UpdateScore( matcher, aLib, aFilter );
+                        } );
+
+                for( std::unique_ptr<LIB_TREE_NODE>& lib : m_tree.m_Children )
+                {
+                    static_cast<LIB_TREE_NODE_LIBRARY*>( lib.get() )->UpdateOwnScore(
+                            aTerm ? matchers[0].get() : nullptr, aLib, aFilter );
+                }
+            };
+
+    wxStringTokenizer tokenizer( aSearch );
+    bool              firstTerm = true;
+
+    while( tokenizer.HasMoreTokens() )
+    {
+        // First search for the full token, in case it appears in a search string
+        wxString term = tokenizer.GetNextToken().Lower();
+
+        scoreStage( &term, wxEmptyString, firstTerm ? filter : nullptr );
+        firstTerm = false;
+
+        if( term.Contains( ":" ) )
+        {
+            // Next search for the library:item_name
+            wxString lib = term.BeforeFirst( ':' );
+            wxString itemName = term.AfterFirst( ':' );
+
+            scoreStage( &itemName, lib, nullptr );
+        }
+        else
+        {
+            // In case the full token happens to match a library name
+            scoreStage( nullptr, '*' + term + '*', nullptr );
+        }
+    }
+
+    if( firstTerm )
+    {
+        // No terms processed; just run the filter
+        scoreStage( nullptr, wxEmptyString, filter );
+    }
+
+    m_lastSearch = aSearch;
+    m_lastMatches.clear();
+
+    for( LIB_TREE_NODE* item : items )
+    {
+        if( item->m_Score > 0 )
+            m_lastMatches.push_back( item );
+    }
+
+    m_lastMatchesValid = true;
+}
+
+
 void LIB_TREE_MODEL_ADAPTER::UpdateSearchString( const wxString& aSearch, bool aState )
 {
     {
@@ -274,41 +441,7 @@ void LIB_TREE_MODEL_ADAPTER::UpdateSearchString( const wxString& aSearch, bool a
         Freeze();
         BeforeReset();
 
-        m_tree.ResetScore();
-
-        wxStringTokenizer tokenizer( aSearch );
-        bool              firstTerm = true;
-
-        while( tokenizer.HasMoreTokens() )
-        {
-            // First search for the full token, in case it appears in a search string
-            wxString             term = tokenizer.GetNextToken().Lower();
-            EDA_COMBINED_MATCHER termMatcher( term, CTX_LIBITEM );
-
-            m_tree.UpdateScore( &termMatcher, wxEmptyString, firstTerm ? m_filter : nullptr );
-            firstTerm = false;
-
-            if( term.Contains( ":" ) )
-            {
-                // Next search for the library:item_name
-                wxString             lib = term.BeforeFirst( ':' );
-                wxString             itemName = term.AfterFirst( ':' );
-                EDA_COMBINED_MATCHER itemNameMatcher( itemName, CTX_LIBITEM );
-
-                m_tree.UpdateScore( &itemNameMatcher, lib, nullptr );
-            }
-            else
-            {
-                // In case the full token happens to match a library name
-                m_tree.UpdateScore( nullptr, '*' + term + '*', nullptr );
-            }
-        }
-
-        if( firstTerm )
-        {
-            // No terms processed; just run the filter
-            m_tree.UpdateScore( nullptr, wxEmptyString, m_filter );
-        }
+        updateScores( aSearch );
 
         m_tree.SortNodes( m_sort_mode == BEST_MATCH );
         AfterReset();
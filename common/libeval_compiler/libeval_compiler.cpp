@@ -187,6 +187,51 @@ UCODE::~UCODE()
 }
 
 
+void UCODE::AddOp( UOP* uop )
+{
+    m_ucode.push_back( uop );
+
+    int operands;
+
+    if( uop->GetOp() & TR_OP_BINARY_MASK )
+        operands = 2;
+    else if( uop->GetOp() & TR_OP_UNARY_MASK )
+        operands = 1;
+    else
+        return;
+
+    // The operands of the op are the ops just before it when they are constants
+    if( (int) m_ucode.size() < operands + 1 )
+        return;
+
+    size_t first = m_ucode.size() - operands - 1;
+
+    for( size_t ii = first; ii < m_ucode.size() - 1; ++ii )
+    {
+        const VALUE* value = m_ucode[ii]->GetValue();
+
+        if( m_ucode[ii]->GetOp() != TR_UOP_PUSH_VALUE || !value
+                || value->GetType() != VT_NUMERIC )
+        {
+            return;
+        }
+    }
+
+    CONTEXT ctx;
+
+    for( size_t ii = first; ii < m_ucode.size(); ++ii )
+        m_ucode[ii]->Exec( &ctx );
+
+    double result = ctx.Pop()->AsDouble();
+
+    for( size_t ii = first; ii < m_ucode.size(); ++ii )
+        delete m_ucode[ii];
+
+    m_ucode.resize( first );
+    m_ucode.push_back( new UOP( TR_UOP_PUSH_VALUE, std::make_unique<VALUE>( result ) ) );
+}
+
+
 wxString UCODE::Dump() const
 {
     wxString rv;
@@ -1121,7 +1166,7 @@ void UOP::Exec( CONTEXT* ctx )
         VALUE* value = nullptr;
 
         if( m_ref )
-            value = ctx->StoreValue( m_ref->GetValue( ctx ) );
+            value = m_ref->GetValue( ctx );
         else
             value = ctx->AllocValue();
 
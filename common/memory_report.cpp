@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+#include <wx/intl.h>
+
+#include <memory_report.h>
+
+
+void MEMORY_REPORT::Add( const wxString& aCategory, size_t aCount, size_t aBytes )
+{
+    for( ENTRY& entry : m_entries )
+    {
+        if( entry.m_category == aCategory )
+        {
+            entry.m_count += aCount;
+            entry.m_bytes += aBytes;
+            return;
+        }
+    }
+
+    m_entries.push_back( { aCategory, aCount, aBytes } );
+}
+
+
+size_t MEMORY_REPORT::GetTotalBytes() const
+{
+    size_t total = 0;
+
+    for( const ENTRY& entry : m_entries )
+        total += entry.m_bytes;
+
+    return total;
+}
+
+
+wxString MEMORY_REPORT::FormatJson() const
+{
+    nlohmann::ordered_json json;
+    nlohmann::ordered_json categories = nlohmann::ordered_json::array();
+
+    for( const ENTRY& entry : m_entries )
+    {
+        categories.push_back( { { "category", entry.m_category.ToStdString() },
+                                { "count", entry.m_count },
+                                { "bytes", entry.m_bytes } } );
+    }
+
+    json["total_bytes"] = GetTotalBytes();
+    json["categories"] = categories;
+
+    return wxString::FromUTF8( json.dump( 2 ) );
+}
+
+
+wxString MEMORY_REPORT::FormatHtml() const
+{
+    std::vector<ENTRY> sorted = m_entries;
+
+    std::sort( sorted.begin(), sorted.end(),
+               []( const ENTRY& a, const ENTRY& b )
+               {
+                   return a.m_bytes > b.m_bytes;
+               } );
+
+    wxString html = wxT( "<table>" );
+
+    html += wxString::Format( wxT( "<tr><th align='left'>%s</th><th align='right'>%s</th>"
+                                   "<th align='right'>%s</th></tr>" ),
+                              _( "Category" ), _( "Count" ), _( "Size" ) );
+
+    for( const ENTRY& entry : sorted )
+    {
+        html += wxString::Format( wxT( "<tr><td>%s</td><td align='right'>%zu</td>"
+                                       "<td align='right'>%s</td></tr>" ),
+                                  entry.m_category, entry.m_count,
+                                  FormatBytes( entry.m_bytes ) );
+    }
+
+    html += wxString::Format( wxT( "<tr><td><b>%s</b></td><td></td>"
+                                   "<td align='right'><b>%s</b></td></tr>" ),
+                              _( "Total" ), FormatBytes( GetTotalBytes() ) );
+
+    html += wxT( "</table>" );
+
+    return html;
+}
+
+
+wxString MEMORY_REPORT::FormatBytes( size_t aBytes )
+{
+    if( aBytes < 1024 )
+        return wxString::Format( wxT( "%zu B" ), aBytes );
+    else if( aBytes < 1024 * 1024 )
+        return wxString::Format( wxT( "%.1f kB" ), aBytes / 1024.0 );
+    else if( aBytes < 1024 * 1024 * 1024 )
+        return wxString::Format( wxT( "%.1f MB" ), aBytes / ( 1024.0 * 1024.0 ) );
+
+    return wxString::Format( wxT( "%.2f GB" ), aBytes / ( 1024.0 * 1024.0 * 1024.0 ) );
+}
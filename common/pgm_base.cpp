@@ -62,6 +62,7 @@
 #include <string_utils.h>
 #include <systemdirsappend.h>
 #include <core/thread_pool.h>
+#include <core/trace_profiler.h>
 #include <trace_helpers.h>
 
 #include <widgets/wx_splash.h>
@@ -158,6 +159,13 @@ void PGM_BASE::Destroy()
 {
     KICAD_CURL::Cleanup();
 
+    if( TRACE_PROFILER::IsEnabled() )
+    {
+        TRACE_PROFILER::Instance().Disable();
+        TRACE_PROFILER::Instance().WriteChromeTrace(
+                ADVANCED_CFG::GetCfg().m_TraceProfileFile.ToStdString() );
+    }
+
 #ifdef KICAD_USE_SENTRY
     sentry_close();
 #endif
@@ -509,6 +517,12 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     App().SetVendorName(  wxT( "KiCad" ) );
     App().SetAppName( pgm_name );
 
+    // Start recording as early as possible, so that the trace shows where the startup time goes
+    if( !ADVANCED_CFG::GetCfg().m_TraceProfileFile.IsEmpty() )
+        TRACE_PROFILER::Instance().Enable();
+
+    TRACE_SCOPE( "Program init" );
+
     // Install some image handlers, mainly for help
     if( wxImage::FindHandler( wxBITMAP_TYPE_PNG ) == nullptr )
         wxImage::AddHandler( new wxPNGHandler );
@@ -533,7 +547,11 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     wxSetEnv( "FONTCONFIG_PATH", PATHS::GetWindowsFontConfigDir() );
 #endif
 
-    m_settings_manager = std::make_unique<SETTINGS_MANAGER>( aHeadless );
+    {
+        TRACE_SCOPE( "Settings manager" );
+        m_settings_manager = std::make_unique<SETTINGS_MANAGER>( aHeadless );
+    }
+
     m_background_jobs_monitor = std::make_unique<BACKGROUND_JOBS_MONITOR>();
     m_notifications_manager = std::make_unique<NOTIFICATIONS_MANAGER>();
 
@@ -554,7 +572,10 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     m_settings_manager->ReloadColorSettings();
 
     // Load common settings from disk after setting up env vars
-    GetSettingsManager().Load( GetCommonSettings() );
+    {
+        TRACE_SCOPE( "Common settings" );
+        GetSettingsManager().Load( GetCommonSettings() );
+    }
 
     // Init user language *before* calling loadSettings, because
     // env vars could be incorrectly initialized on Linux
@@ -577,7 +598,10 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     // Create the python scripting stuff
     // Skip it fot applications that do not use it
     if( !aSkipPyInit )
+    {
+        TRACE_SCOPE( "Python init" );
         m_python_scripting = std::make_unique<SCRIPTING>();
+    }
 
     // TODO(JE): Remove this if apps are refactored to not assume Prj() always works
     // Need to create a project early for now (it can have an empty path for the moment)
@@ -594,6 +618,14 @@ bool PGM_BASE::InitPgm( bool aHeadless, bool aSkipPyInit, bool aIsUnitTest )
     if( ADVANCED_CFG::GetCfg().m_UpdateUIEventInterval != 0 )
         wxUpdateUIEvent::SetUpdateInterval( ADVANCED_CFG::GetCfg().m_UpdateUIEventInterval );
 
+    const ADVANCED_CFG& cfg = ADVANCED_CFG::GetCfg();
+
+    SetKiCadThreadPoolSize( cfg.m_MaximumThreads );
+    SetThreadBudget( THREAD_SUBSYSTEM::ZONE_FILL, cfg.m_ZoneFillThreads );
+    SetThreadBudget( THREAD_SUBSYSTEM::DRC, cfg.m_DRCThreads );
+    SetThreadBudget( THREAD_SUBSYSTEM::CONNECTIVITY, cfg.m_ConnectivityThreads );
+    SetThreadBudget( THREAD_SUBSYSTEM::RAYTRACE, cfg.m_3DRT_Threads );
+
     // Now the application can safely start, show the splash screen
     if( !aHeadless )
         ShowSplash();
@@ -390,15 +390,24 @@ bool DXF_PLOTTER::StartPlot( const wxString& aPageNumber )
                  dxf_layer[i].name, dxf_layer[i].color );
     }
 
-    // End of layer table, begin entities
+    // End of layer table.  The blocks and the entities are written by EndPlot(), once all the
+    // blocks are known.
     fputs( "  0\n"
            "ENDTAB\n"
            "  0\n"
-           "ENDSEC\n"
-           "  0\n"
-           "SECTION\n"
-           "  2\n"
-           "ENTITIES\n", m_outputFile );
+           "ENDSEC\n", m_outputFile );
+
+    m_entities.Clear();
+    m_blocks.Clear();
+    m_group.Clear();
+    m_groupDepth = 0;
+    m_blockNames.clear();
+
+    if( m_entitiesFile )
+        fclose( m_entitiesFile );
+
+    // Without a temporary file, the entities are kept in memory
+    m_entitiesFile = tmpfile();
 
     return true;
 }
@@ -408,6 +417,41 @@ bool DXF_PLOTTER::EndPlot()
 {
     wxASSERT( m_outputFile );
 
+    if( !m_blocks.GetString().empty() )
+    {
+        fputs( "  0\n"
+               "SECTION\n"
+               "  2\n"
+               "BLOCKS\n", m_outputFile );
+        fwrite( m_blocks.GetString().data(), 1, m_blocks.GetString().size(), m_outputFile );
+        fputs( "  0\n"
+               "ENDSEC\n", m_outputFile );
+    }
+
+    fputs( "  0\n"
+           "SECTION\n"
+           "  2\n"
+           "ENTITIES\n", m_outputFile );
+
+    if( m_entitiesFile )
+    {
+        char   buffer[65536];
+        size_t count;
+
+        rewind( m_entitiesFile );
+
+        while( ( count = fread( buffer, 1, sizeof( buffer ), m_entitiesFile ) ) > 0 )
+            fwrite( buffer, 1, count, m_outputFile );
+
+        fclose( m_entitiesFile );
+        m_entitiesFile = nullptr;
+    }
+
+    fwrite( m_entities.GetString().data(), 1, m_entities.GetString().size(), m_outputFile );
+    m_entities.Clear();
+    m_blocks.Clear();
+    m_blockNames.clear();
+
     // DXF FOOTER
     fputs( "  0\n"
            "ENDSEC\n"
@@ -420,6 +464,99 @@ bool DXF_PLOTTER::EndPlot()
 }
 
 
+DXF_PLOTTER::~DXF_PLOTTER()
+{
+    if( m_entitiesFile )
+        fclose( m_entitiesFile );
+}
+
+
+OUTPUTFORMATTER& DXF_PLOTTER::out()
+{
+    if( m_groupDepth > 0 )
+        return m_group;
+
+    // Keep the buffer small, the entities of large boards can take hundreds of megabytes
+    if( m_entitiesFile && m_entities.GetString().size() > 1024 * 1024 )
+        flushEntities();
+
+    return m_entities;
+}
+
+
+void DXF_PLOTTER::flushEntities()
+{
+    const std::string& entities = m_entities.GetString();
+
+    if( m_entitiesFile && !entities.empty() )
+    {
+        fwrite( entities.data(), 1, entities.size(), m_entitiesFile );
+        m_entities.Clear();
+    }
+}
+
+
+void DXF_PLOTTER::StartReusableGroup( const VECTOR2I& aAnchor, const wxString& aName )
+{
+    if( m_groupDepth++ > 0 )
+        return;
+
+    // Plot the items of the group relative to the anchor, so that identical groups give the
+    // same entities wherever they are
+    m_group.Clear();
+    m_groupAnchor = aAnchor;
+    m_groupName = aName;
+    m_savedPlotOffset = m_plotOffset;
+    m_plotOffset = aAnchor;
+}
+
+
+void DXF_PLOTTER::EndReusableGroup()
+{
+    wxCHECK( m_groupDepth > 0, /* void */ );
+
+    if( --m_groupDepth > 0 )
+        return;
+
+    m_plotOffset = m_savedPlotOffset;
+
+    const std::string& contents = m_group.GetString();
+
+    if( contents.empty() )
+        return;
+
+    auto it = m_blockNames.find( contents );
+
+    if( it == m_blockNames.end() )
+    {
+        // Block names are restricted to letters, digits and a few symbols
+        std::string name;
+
+        for( wxUniChar ch : m_groupName )
+        {
+            if( ch.IsAscii() && ( wxIsalnum( ch ) || ch == '-' || ch == '_' || ch == '$' ) )
+                name += static_cast<char>( ch );
+            else
+                name += '_';
+        }
+
+        name += fmt::format( "_{}", m_blockNames.size() + 1 );
+
+        m_blocks.PrintFmt( 0, "  0\nBLOCK\n  8\n0\n  2\n{}\n 70\n0\n 10\n0.0\n 20\n0.0\n"
+                              "  3\n{}\n", name, name );
+        m_blocks.PrintFmt( 0, "{}", contents );
+        m_blocks.PrintFmt( 0, "  0\nENDBLK\n  8\n0\n" );
+
+        it = m_blockNames.emplace( contents, name ).first;
+    }
+
+    VECTOR2D anchor_dev = userToDeviceCoordinates( m_groupAnchor );
+
+    out().PrintFmt( 0, "0\nINSERT\n8\n0\n2\n{}\n10\n{}\n20\n{}\n", it->second,
+                    formatCoord( anchor_dev.x ), formatCoord( anchor_dev.y ) );
+}
+
+
 void DXF_PLOTTER::SetColor( const COLOR4D& color )
 {
     if( ( m_colorMode )
@@ -453,10 +590,10 @@ void DXF_PLOTTER::Rect( const VECTOR2I& p1, const VECTOR2I& p2, FILL_T fill, int
         wxString cname = getDXFColorName( m_currentColor );
         VECTOR2D point_dev = userToDeviceCoordinates( p1 );
 
-        fprintf( m_outputFile, "0\nPOINT\n8\n%s\n10\n%s\n20\n%s\n",
-                 TO_UTF8( cname ),
-                 formatCoord( point_dev.x ).c_str(),
-                 formatCoord( point_dev.y ).c_str() );
+        out().PrintFmt( 0, "0\nPOINT\n8\n{}\n10\n{}\n20\n{}\n",
+                        TO_UTF8( cname ),
+                        formatCoord( point_dev.x ),
+                        formatCoord( point_dev.y ) );
     }
 }
 
@@ -473,38 +610,38 @@ void DXF_PLOTTER::Circle( const VECTOR2I& centre, int diameter, FILL_T fill, int
     {
         if( fill == FILL_T::NO_FILL )
         {
-            fprintf( m_outputFile, "0\nCIRCLE\n8\n%s\n10\n%s\n20\n%s\n40\n%s\n",
-                     TO_UTF8( cname ),
-                     formatCoord( centre_dev.x ).c_str(),
-                     formatCoord( centre_dev.y ).c_str(),
-                     formatCoord( radius ).c_str() );
+            out().PrintFmt( 0, "0\nCIRCLE\n8\n{}\n10\n{}\n20\n{}\n40\n{}\n",
+                            TO_UTF8( cname ),
+                            formatCoord( centre_dev.x ),
+                            formatCoord( centre_dev.y ),
+                            formatCoord( radius ) );
         }
         else if( fill == FILL_T::FILLED_SHAPE )
         {
             double r = radius * 0.5;
-            fprintf( m_outputFile, "0\nPOLYLINE\n" );
-            fprintf( m_outputFile, "8\n%s\n66\n1\n70\n1\n", TO_UTF8( cname ) );
-            fprintf( m_outputFile, "40\n%s\n41\n%s\n",
-                                    formatCoord( radius ).c_str(),
-                                    formatCoord( radius ).c_str() );
-            fprintf( m_outputFile, "0\nVERTEX\n8\n%s\n", TO_UTF8( cname ) );
-            fprintf( m_outputFile, "10\n%s\n 20\n%s\n42\n1.0\n",
-                                    formatCoord( centre_dev.x-r ).c_str(),
-                                    formatCoord( centre_dev.y ).c_str() );
-            fprintf( m_outputFile, "0\nVERTEX\n8\n%s\n", TO_UTF8( cname ) );
-            fprintf( m_outputFile, "10\n%s\n 20\n%s\n42\n1.0\n",
-                                    formatCoord( centre_dev.x+r ).c_str(),
-                                    formatCoord( centre_dev.y ).c_str() );
-            fprintf( m_outputFile, "0\nSEQEND\n");
+            out().PrintFmt( 0, "0\nPOLYLINE\n" );
+            out().PrintFmt( 0, "8\n{}\n66\n1\n70\n1\n", TO_UTF8( cname ) );
+            out().PrintFmt( 0, "40\n{}\n41\n{}\n",
+                            formatCoord( radius ),
+                            formatCoord( radius ) );
+            out().PrintFmt( 0, "0\nVERTEX\n8\n{}\n", TO_UTF8( cname ) );
+            out().PrintFmt( 0, "10\n{}\n 20\n{}\n42\n1.0\n",
+                            formatCoord( centre_dev.x-r ),
+                            formatCoord( centre_dev.y ) );
+            out().PrintFmt( 0, "0\nVERTEX\n8\n{}\n", TO_UTF8( cname ) );
+            out().PrintFmt( 0, "10\n{}\n 20\n{}\n42\n1.0\n",
+                            formatCoord( centre_dev.x+r ),
+                            formatCoord( centre_dev.y ) );
+            out().PrintFmt( 0, "0\nSEQEND\n");
         }
     }
     else
     {
         // Draw as a point
-        fprintf( m_outputFile, "0\nPOINT\n8\n%s\n10\n%s\n20\n%s\n",
-                 TO_UTF8( cname ),
-                 formatCoord( centre_dev.x ).c_str(),
-                 formatCoord( centre_dev.y ).c_str() );
+        out().PrintFmt( 0, "0\nPOINT\n8\n{}\n10\n{}\n20\n{}\n",
+                        TO_UTF8( cname ),
+                        formatCoord( centre_dev.x ),
+                        formatCoord( centre_dev.y ) );
     }
 }
 
@@ -628,12 +765,12 @@ void DXF_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
         // DXF LINE
         wxString    cname = getDXFColorName( m_currentColor );
         const char* lname = getDXFLineType( static_cast<LINE_STYLE>( m_currentLineType ) );
-        fprintf( m_outputFile, "0\nLINE\n8\n%s\n6\n%s\n10\n%s\n20\n%s\n11\n%s\n21\n%s\n",
-                 TO_UTF8( cname ), lname,
-                 formatCoord( pen_lastpos_dev.x ).c_str(),
-                 formatCoord( pen_lastpos_dev.y ).c_str(),
-                 formatCoord( pos_dev.x ).c_str(),
-                 formatCoord( pos_dev.y ).c_str() );
+        out().PrintFmt( 0, "0\nLINE\n8\n{}\n6\n{}\n10\n{}\n20\n{}\n11\n{}\n21\n{}\n",
+                        TO_UTF8( cname ), lname,
+                        formatCoord( pen_lastpos_dev.x ),
+                        formatCoord( pen_lastpos_dev.y ),
+                        formatCoord( pos_dev.x ),
+                        formatCoord( pos_dev.y ) );
     }
 
     m_penLastpos = pos;
@@ -700,13 +837,13 @@ void DXF_PLOTTER::Arc( const VECTOR2D& aCenter, const EDA_ANGLE& aStartAngle,
 
     // Emit a DXF ARC entity
     wxString cname = getDXFColorName( m_currentColor );
-    fprintf( m_outputFile,
-             "0\nARC\n8\n%s\n10\n%s\n20\n%s\n40\n%s\n50\n%.8f\n51\n%.8f\n",
-             TO_UTF8( cname ),
-             formatCoord( centre_device.x ).c_str(),
-             formatCoord( centre_device.y ).c_str(),
-             formatCoord( radius_device ).c_str(),
-             startAngle.AsDegrees(), endAngle.AsDegrees() );
+    out().PrintFmt( 0,
+                    "0\nARC\n8\n{}\n10\n{}\n20\n{}\n40\n{}\n50\n{:.8f}\n51\n{:.8f}\n",
+                    TO_UTF8( cname ),
+                    formatCoord( centre_device.x ),
+                    formatCoord( centre_device.y ),
+                    formatCoord( radius_device ),
+                    startAngle.AsDegrees(), endAngle.AsDegrees() );
 }
 
 
@@ -987,45 +1124,45 @@ void DXF_PLOTTER::plotOneLineOfText( const VECTOR2I& aPos, const COLOR4D& aColor
     // Position, size, rotation and alignment
     // The two alignment point usages is somewhat idiot (see the DXF ref)
     // Anyway since we don't use the fit/aligned options, they're the same
-    fprintf( m_outputFile,
-             "  0\n"
-             "TEXT\n"
-             "  7\n"
-             "%s\n"          // Text style
-             "  8\n"
-             "%s\n"          // Layer name
-             "  10\n"
-             "%s\n"          // First point X
-             "  11\n"
-             "%s\n"          // Second point X
-             "  20\n"
-             "%s\n"          // First point Y
-             "  21\n"
-             "%s\n"          // Second point Y
-             "  40\n"
-             "%s\n"          // Text height
-             "  41\n"
-             "%s\n"          // Width factor
-             "  50\n"
-             "%.8f\n"        // Rotation
-             "  51\n"
-             "%.8f\n"        // Oblique angle
-             "  71\n"
-             "%d\n"          // Mirror flags
-             "  72\n"
-             "%d\n"          // H alignment
-             "  73\n"
-             "%d\n",         // V alignment
-             aAttributes.m_Bold ? ( aAttributes.m_Italic ? "KICADBI" : "KICADB" )
-                                : ( aAttributes.m_Italic ? "KICADI" : "KICAD" ),
-             TO_UTF8( cname ),
-             formatCoord( origin_dev.x ).c_str(), formatCoord( origin_dev.x ).c_str(),
-             formatCoord( origin_dev.y ).c_str(), formatCoord( origin_dev.y ).c_str(),
-             formatCoord( size_dev.y ).c_str(), formatCoord( fabs( size_dev.x / size_dev.y ) ).c_str(),
-             aAttributes.m_Angle.AsDegrees(),
-             aAttributes.m_Italic ? DXF_OBLIQUE_ANGLE : 0,
-             aAttributes.m_Mirrored ? 2 : 0, // X mirror flag
-             h_code, v_code );
+    out().PrintFmt( 0,
+                    "  0\n"
+                    "TEXT\n"
+                    "  7\n"
+                    "{}\n"          // Text style
+                    "  8\n"
+                    "{}\n"          // Layer name
+                    "  10\n"
+                    "{}\n"          // First point X
+                    "  11\n"
+                    "{}\n"          // Second point X
+                    "  20\n"
+                    "{}\n"          // First point Y
+                    "  21\n"
+                    "{}\n"          // Second point Y
+                    "  40\n"
+                    "{}\n"          // Text height
+                    "  41\n"
+                    "{}\n"          // Width factor
+                    "  50\n"
+                    "{:.8f}\n"      // Rotation
+                    "  51\n"
+                    "{:.8f}\n"      // Oblique angle
+                    "  71\n"
+                    "{}\n"          // Mirror flags
+                    "  72\n"
+                    "{}\n"          // H alignment
+                    "  73\n"
+                    "{}\n",         // V alignment
+                    aAttributes.m_Bold ? ( aAttributes.m_Italic ? "KICADBI" : "KICADB" )
+                                       : ( aAttributes.m_Italic ? "KICADI" : "KICAD" ),
+                    TO_UTF8( cname ),
+                    formatCoord( origin_dev.x ), formatCoord( origin_dev.x ),
+                    formatCoord( origin_dev.y ), formatCoord( origin_dev.y ),
+                    formatCoord( size_dev.y ), formatCoord( fabs( size_dev.x / size_dev.y ) ),
+                    aAttributes.m_Angle.AsDegrees(),
+                    aAttributes.m_Italic ? DXF_OBLIQUE_ANGLE : 0,
+                    aAttributes.m_Mirrored ? 2 : 0, // X mirror flag
+                    h_code, v_code );
 
     /* There are two issue in emitting the text:
        - Our overline character (~) must be converted to the appropriate
@@ -1049,31 +1186,27 @@ void DXF_PLOTTER::plotOneLineOfText( const VECTOR2I& aPos, const COLOR4D& aColor
        in no more details...
      */
 
-    int braceNesting = 0;
-    int overbarDepth = -1;
-
-    fputs( "  1\n", m_outputFile );
+    int         braceNesting = 0;
+    int         overbarDepth = -1;
+    std::string text = "  1\n";
 
     for( unsigned int i = 0; i < aText.length(); i++ )
     {
-        /* Here I do a bad thing: writing the output one byte at a time!
-           but today I'm lazy and I have no idea on how to coerce a Unicode
-           wxString to spit out latin1 encoded text ...
-
-           At least stdio is *supposed* to do output buffering, so there is
-           hope is not too slow */
+        /* The text is converted to latin1 one character at a time, as there is
+           no simple way to coerce a Unicode wxString to spit out latin1 encoded
+           text ... */
         wchar_t ch = aText[i];
 
         if( ch > 255 )
         {
             // I can't encode this...
-            putc( '?', m_outputFile );
+            text += '?';
         }
         else
         {
             if( aText[i] == '~' && i+1 < aText.length() && aText[i+1] == '{' )
             {
-                fputs( "%%o", m_outputFile );
+                text += "%%o";
                 overbarDepth = braceNesting;
 
                 // Skip the '{'
@@ -1091,15 +1224,16 @@ void DXF_PLOTTER::plotOneLineOfText( const VECTOR2I& aPos, const COLOR4D& aColor
 
                 if( braceNesting == overbarDepth )
                 {
-                    fputs( "%%O", m_outputFile );
+                    text += "%%O";
                     overbarDepth = -1;
                     continue;
                 }
             }
 
-            putc( ch, m_outputFile );
+            text += static_cast<char>( ch );
         }
     }
 
-    putc( '\n', m_outputFile );
+    text += '\n';
+    out().PrintFmt( 0, "{}", text );
 }
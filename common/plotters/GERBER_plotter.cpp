@@ -25,6 +25,7 @@
 
 #include <string_utils.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <hash.h>
 #include <macros.h>
 #include <math/util.h>      // for KiROUND
 #include <trigo.h>
@@ -89,6 +90,34 @@ static bool polyCompare( const std::vector<VECTOR2I>& aPolygon,
 }
 
 
+// Write the decimal representation of aValue at aBuffer, and return the end of the written
+// chars.  Coordinates are the bulk of a Gerber file, and this is much faster than printf.
+static char* formatInt( char* aBuffer, int aValue )
+{
+    unsigned int value = aValue;
+
+    if( aValue < 0 )
+    {
+        *aBuffer++ = '-';
+        value = 0u - value;
+    }
+
+    char  digits[10];
+    char* digit = digits;
+
+    do
+    {
+        *digit++ = '0' + value % 10;
+        value /= 10;
+    } while( value );
+
+    while( digit != digits )
+        *aBuffer++ = *--digit;
+
+    return aBuffer;
+}
+
+
 GERBER_PLOTTER::GERBER_PLOTTER()
 {
     workFile  = nullptr;
@@ -119,6 +148,21 @@ GERBER_PLOTTER::GERBER_PLOTTER()
 }
 
 
+GERBER_PLOTTER::~GERBER_PLOTTER()
+{
+    // If EndPlot() was not called, the work file still uses m_workFileBuffer, so close it
+    // before the buffer is freed
+    if( workFile )
+    {
+        if( m_outputFile == workFile )
+            m_outputFile = finalFile;
+
+        fclose( workFile );
+        ::wxRemoveFile( m_workFilename );
+    }
+}
+
+
 void GERBER_PLOTTER::SetViewport( const VECTOR2I& aOffset, double aIusPerDecimil,
                                   double aScale, bool aMirror )
 {
@@ -155,7 +199,46 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 
 void GERBER_PLOTTER::emitDcode( const VECTOR2D& pt, int dcode )
 {
-    fprintf( m_outputFile, "X%dY%dD%02d*\n", KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    // Same as fprintf( "X%dY%dD%02d*\n" ), without the format parsing
+    char  line[48];
+    char* end = line;
+
+    *end++ = 'X';
+    end = formatInt( end, KiROUND( pt.x ) );
+    *end++ = 'Y';
+    end = formatInt( end, KiROUND( pt.y ) );
+    *end++ = 'D';
+
+    if( dcode >= 0 && dcode < 10 )
+        *end++ = '0';
+
+    end = formatInt( end, dcode );
+    *end++ = '*';
+    *end++ = '\n';
+
+    fwrite( line, 1, end - line, m_outputFile );
+}
+
+
+void GERBER_PLOTTER::emitArcEnd( const VECTOR2D& aEnd, const VECTOR2D& aRelCenter )
+{
+    // Same as fprintf( "X%dY%dI%dJ%dD01*\n" ), without the format parsing
+    char  line[64];
+    char* end = line;
+
+    *end++ = 'X';
+    end = formatInt( end, KiROUND( aEnd.x ) );
+    *end++ = 'Y';
+    end = formatInt( end, KiROUND( aEnd.y ) );
+    *end++ = 'I';
+    end = formatInt( end, KiROUND( aRelCenter.x ) );
+    *end++ = 'J';
+    end = formatInt( end, KiROUND( aRelCenter.y ) );
+
+    for( char c : { 'D', '0', '1', '*', '\n' } )
+        *end++ = c;
+
+    fwrite( line, 1, end - line, m_outputFile );
 }
 
 void GERBER_PLOTTER::ClearAllAttributes()
@@ -258,6 +341,9 @@ bool GERBER_PLOTTER::StartPlot( const wxString& aPageNumber )
     if( m_outputFile == nullptr )
         return false;
 
+    m_workFileBuffer.resize( 1 << 20 );
+    setvbuf( workFile, m_workFileBuffer.data(), _IOFBF, m_workFileBuffer.size() );
+
     for( unsigned ii = 0; ii < m_headerExtraLines.GetCount(); ii++ )
     {
         if( ! m_headerExtraLines[ii].IsEmpty() )
@@ -329,6 +415,9 @@ bool GERBER_PLOTTER::EndPlot()
     wxASSERT( workFile );
     m_outputFile = finalFile;
 
+    if( workFile )
+        setvbuf( workFile, m_workFileBuffer.data(), _IOFBF, m_workFileBuffer.size() );
+
     // Placement of apertures in RS274X
     while( fgets( line, 1024, workFile ) )
     {
@@ -388,6 +477,7 @@ bool GERBER_PLOTTER::EndPlot()
     fclose( workFile );
     fclose( finalFile );
     ::wxRemoveFile( m_workFilename );
+    workFile = nullptr;
     m_outputFile = nullptr;
 
     return true;
@@ -416,13 +506,18 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
                                          const EDA_ANGLE& aRotation, APERTURE::APERTURE_TYPE aType,
                                          int aApertureAttribute )
 {
-    int last_D_code = 9;
+    // D codes are allocated in sequence, starting at 10
+    int last_D_code = m_apertures.empty() ? 9 : m_apertures.back().m_DCode;
 
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
+    std::vector<int>& candidates = m_apertureIndex[hash_val( static_cast<int>( aType ),
+                                                             aSize.x, aSize.y, aRadius,
+                                                             aRotation.AsDegrees(),
+                                                             aApertureAttribute )];
+
+    for( int idx : candidates )
     {
         APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
 
         if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
             (tool->m_Radius == aRadius) && (tool->m_Rotation == aRotation) &&
@@ -440,6 +535,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const VECTOR2I& aSize, int aRadius,
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
+    candidates.push_back( m_apertures.size() - 1 );
 
     return m_apertures.size() - 1;
 }
@@ -449,7 +545,8 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
                                          const EDA_ANGLE& aRotation, APERTURE::APERTURE_TYPE aType,
                                          int aApertureAttribute )
 {
-    int last_D_code = 9;
+    // D codes are allocated in sequence, starting at 10
+    int last_D_code = m_apertures.empty() ? 9 : m_apertures.back().m_DCode;
 
     // For APERTURE::AM_FREE_POLYGON aperture macros, we need to create the macro
     // on the fly, because due to the fact the vertex count is not a constant we
@@ -462,13 +559,17 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
             m_am_freepoly_list.Append( aCorners );
     }
 
-    // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
+    // Search an existing aperture.  The corners are compared with a tolerance, so they can't
+    // be hashed
+    std::vector<int>& candidates = m_apertureIndex[hash_val( static_cast<int>( aType ),
+                                                             aCorners.size(),
+                                                             aRotation.AsDegrees(),
+                                                             aApertureAttribute )];
+
+    for( int idx : candidates )
     {
         APERTURE* tool = &m_apertures[idx];
 
-       last_D_code = tool->m_DCode;
-
         if( (tool->m_Type == aType) &&
             (tool->m_Corners.size() == aCorners.size() ) &&
             (tool->m_Rotation == aRotation) &&
@@ -494,6 +595,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const std::vector<VECTOR2I>& aCorners,
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
+    candidates.push_back( m_apertures.size() - 1 );
 
     return m_apertures.size() - 1;
 }
@@ -860,9 +962,7 @@ void GERBER_PLOTTER::plotArc( const SHAPE_ARC& aArc, bool aPlotInRegion )
     else
         fprintf( m_outputFile, "G03*\n" );    // Active circular interpolation, CCW
 
-    fprintf( m_outputFile, "X%dY%dI%dJ%dD01*\n",
-             KiROUND( devEnd.x ), KiROUND( devEnd.y ),
-             KiROUND( devRelCenter.x ), KiROUND( devRelCenter.y ) );
+    emitArcEnd( devEnd, devRelCenter );
 
     fprintf( m_outputFile, "G01*\n" ); // Back to linear interpolate (perhaps useless here).
 }
@@ -893,9 +993,7 @@ void GERBER_PLOTTER::plotArc( const VECTOR2I& aCenter, const EDA_ANGLE& aStartAn
     else
         fprintf( m_outputFile, "G02*\n" ); // Active circular interpolation, CW
 
-    fprintf( m_outputFile, "X%dY%dI%dJ%dD01*\n",
-             KiROUND( devEnd.x ), KiROUND( devEnd.y ),
-             KiROUND( devRelCenter.x ), KiROUND( devRelCenter.y ) );
+    emitArcEnd( devEnd, devRelCenter );
 
     fprintf( m_outputFile, "G01*\n" ); // Back to linear interpolate (perhaps useless here).
 }
@@ -29,9 +29,9 @@
 
 #include <algorithm>
 #include <cstdio> // snprintf
+#include <string_view>
 
 #include <wx/filename.h>
-#include <wx/mstream.h>
 #include <wx/zstream.h>
 #include <wx/wfstream.h>
 #include <wx/datstrm.h>
@@ -39,7 +39,7 @@
 #include <advanced_config.h>
 #include <eda_text.h> // for IsGotoPageHref
 #include <font/font.h>
-#include <core/ignore.h>
+#include <hash.h>
 #include <macros.h>
 #include <trigo.h>
 #include <string_utils.h>
@@ -448,6 +448,27 @@ void PDF_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
 }
 
 
+/**
+ * @return a hash of the size, the pixels and the transparency of an image.
+ */
+static size_t hashImage( const wxImage& aImage )
+{
+    size_t pixCount = (size_t) aImage.GetWidth() * aImage.GetHeight();
+    size_t hash = hash_val( aImage.GetWidth(), aImage.GetHeight(), aImage.HasAlpha(),
+                            aImage.HasMask() );
+
+    if( aImage.HasMask() )
+        hash_combine( hash, aImage.GetMaskRed(), aImage.GetMaskGreen(), aImage.GetMaskBlue() );
+
+    hash_combine( hash, std::string_view( (const char*) aImage.GetData(), pixCount * 3 ) );
+
+    if( aImage.HasAlpha() )
+        hash_combine( hash, std::string_view( (const char*) aImage.GetAlpha(), pixCount ) );
+
+    return hash;
+}
+
+
 void PDF_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double aScaleFactor )
 {
     wxASSERT( m_workFile );
@@ -460,51 +481,22 @@ void PDF_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double
     VECTOR2I start( aPos.x - drawsize.x / 2, aPos.y + drawsize.y / 2 );
     VECTOR2D dev_start = userToDeviceCoordinates( start );
 
-    // Deduplicate images
-    auto findHandleForImage = [&]( const wxImage& aCurrImage ) -> int
-    {
-        for( const auto& [imgHandle, image] : m_imageHandles )
-        {
-            if( image.IsSameAs( aCurrImage ) )
-                return imgHandle;
-
-            if( image.GetWidth() != aCurrImage.GetWidth() )
-                continue;
-
-            if( image.GetHeight() != aCurrImage.GetHeight() )
-                continue;
-
-            if( image.GetType() != aCurrImage.GetType() )
-                continue;
-
-            if( image.HasAlpha() != aCurrImage.HasAlpha() )
-                continue;
-
-            if( image.HasMask() != aCurrImage.HasMask() || image.GetMaskRed() != aCurrImage.GetMaskRed()
-                || image.GetMaskGreen() != aCurrImage.GetMaskGreen()
-                || image.GetMaskBlue() != aCurrImage.GetMaskBlue() )
-                continue;
-
-            int pixCount = image.GetWidth() * image.GetHeight();
+    // Deduplicate images.  Images are written with the first page using them, so only a hash
+    // of their contents is kept to find them on the next pages.
+    size_t imgHash = hashImage( aImage );
+    auto   it = m_imageHashes.find( imgHash );
+    int    imgHandle;
 
-            if( memcmp( image.GetData(), aCurrImage.GetData(), pixCount * 3 ) != 0 )
-                continue;
-
-            if( image.HasAlpha() && memcmp( image.GetAlpha(), aCurrImage.GetAlpha(), pixCount ) != 0 )
-                continue;
-
-            return imgHandle;
-        }
-
-        return -1;
-    };
-
-    int imgHandle = findHandleForImage( aImage );
-
-    if( imgHandle == -1 )
+    if( it != m_imageHashes.end() )
+    {
+        imgHandle = it->second;
+    }
+    else
     {
         imgHandle = allocPdfObject();
-        m_imageHandles.emplace( imgHandle, aImage );
+        m_imageHashes.emplace( imgHash, imgHandle );
+        m_imageHandles.push_back( imgHandle );
+        m_pageImages.emplace( imgHandle, aImage );
     }
 
     /* PDF has an uhm... simplified coordinate system handling. There is
@@ -599,51 +591,49 @@ void PDF_PLOTTER::closePdfStream()
         return;
     }
 
-    // Rewind the file, read in the page stream and DEFLATE it
+    // Rewind the file, and DEFLATE the page stream straight to the output file, a chunk at a
+    // time: pages of large schematics can hold many megabytes of drawing commands
     fseek( m_workFile, 0, SEEK_SET );
-    unsigned char *inbuf = new unsigned char[stream_len];
 
-    int rc = fread( inbuf, 1, stream_len, m_workFile );
-    wxASSERT( rc == stream_len );
-    ignore_unused( rc );
+    long streamStart = ftell( m_outputFile );
 
-    // We are done with the temporary file, junk it
-    fclose( m_workFile );
-    m_workFile = nullptr;
-    ::wxRemoveFile( m_workFilename );
+    // Init wxFFile so wxFFileOutputStream won't close file in dtor.
+    wxFFile outputFFile( m_outputFile );
 
-    unsigned out_count;
-
-    if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
-    {
-        out_count = stream_len;
-        fwrite( inbuf, out_count, 1, m_outputFile );
-    }
-    else
     {
-        // NULL means memos owns the memory, but provide a hint on optimum size needed.
-        wxMemoryOutputStream    memos( nullptr, std::max( 2000l, stream_len ) ) ;
+        wxFFileOutputStream ffos( outputFFile );
+        std::vector<char>   buffer( 1 << 16 );
+        size_t              count;
 
+        if( ADVANCED_CFG::GetCfg().m_DebugPDFWriter )
+        {
+            while( ( count = fread( buffer.data(), 1, buffer.size(), m_workFile ) ) > 0 )
+                ffos.Write( buffer.data(), count );
+        }
+        else
         {
             /* Somewhat standard parameters to compress in DEFLATE. The PDF spec is
              * misleading, it says it wants a DEFLATE stream but it really want a ZLIB
              * stream! (a DEFLATE stream would be generated with -15 instead of 15)
-             * rc = deflateInit2( &zstrm, Z_BEST_COMPRESSION, Z_DEFLATED, 15,
-             *                    8, Z_DEFAULT_STRATEGY );
+             * The default compression level is several times faster than the best one, for
+             * only slightly larger page streams.
              */
+            wxZlibOutputStream zos( ffos, wxZ_DEFAULT_COMPRESSION, wxZLIB_ZLIB );
 
-            wxZlibOutputStream      zos( memos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
-
-            zos.Write( inbuf, stream_len );
+            while( ( count = fread( buffer.data(), 1, buffer.size(), m_workFile ) ) > 0 )
+                zos.Write( buffer.data(), count );
         }   // flush the zip stream using zos destructor
+    }
 
-        wxStreamBuffer* sb = memos.GetOutputStreamBuffer();
+    outputFFile.Detach(); // Don't close it
 
-        out_count = sb->Tell();
-        fwrite( sb->GetBufferStart(), 1, out_count, m_outputFile );
-    }
+    unsigned out_count = ftell( m_outputFile ) - streamStart;
+
+    // We are done with the temporary file, junk it
+    fclose( m_workFile );
+    m_workFile = nullptr;
+    ::wxRemoveFile( m_workFilename );
 
-    delete[] inbuf;
     fputs( "\nendstream\n", m_outputFile );
     closePdfObject();
 
@@ -654,6 +644,100 @@ void PDF_PLOTTER::closePdfStream()
 }
 
 
+void PDF_PLOTTER::emitImage( int aHandle, const wxImage& aImage )
+{
+    // Init wxFFile so wxFFileOutputStream won't close file in dtor.
+    wxFFile outputFFile( m_outputFile );
+
+    // Image
+    startPdfObject( aHandle );
+    int imgLenHandle = allocPdfObject();
+    int smaskHandle = ( aImage.HasAlpha() || aImage.HasMask() ) ? allocPdfObject() : -1;
+
+    fprintf( m_outputFile,
+             "<<\n"
+             "/Type /XObject\n"
+             "/Subtype /Image\n"
+             "/BitsPerComponent 8\n"
+             "/ColorSpace %s\n"
+             "/Width %d\n"
+             "/Height %d\n"
+             "/Filter /FlateDecode\n"
+             "/Length %d 0 R\n", // Length is deferred
+             m_colorMode ? "/DeviceRGB" : "/DeviceGray", aImage.GetWidth(), aImage.GetHeight(),
+             imgLenHandle );
+
+    if( smaskHandle != -1 )
+        fprintf( m_outputFile, "/SMask %d 0 R\n", smaskHandle );
+
+    fputs( ">>\n", m_outputFile );
+    fputs( "stream\n", m_outputFile );
+
+    long imgStreamStart = ftell( m_outputFile );
+
+    {
+        wxFFileOutputStream ffos( outputFFile );
+        wxZlibOutputStream  zos( ffos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+        wxDataOutputStream  dos( zos );
+
+        WriteImageStream( aImage, dos, m_renderSettings->GetBackgroundColor().ToColour(),
+                          m_colorMode );
+    }
+
+    long imgStreamSize = ftell( m_outputFile ) - imgStreamStart;
+
+    fputs( "\nendstream\n", m_outputFile );
+    closePdfObject();
+
+    startPdfObject( imgLenHandle );
+    fprintf( m_outputFile, "%ld\n", imgStreamSize );
+    closePdfObject();
+
+    if( smaskHandle != -1 )
+    {
+        // SMask
+        startPdfObject( smaskHandle );
+        int smaskLenHandle = allocPdfObject();
+
+        fprintf( m_outputFile,
+                 "<<\n"
+                 "/Type /XObject\n"
+                 "/Subtype /Image\n"
+                 "/BitsPerComponent 8\n"
+                 "/ColorSpace /DeviceGray\n"
+                 "/Width %d\n"
+                 "/Height %d\n"
+                 "/Length %d 0 R\n"
+                 "/Filter /FlateDecode\n"
+                 ">>\n", // Length is deferred
+                 aImage.GetWidth(), aImage.GetHeight(), smaskLenHandle );
+
+        fputs( "stream\n", m_outputFile );
+
+        long smaskStreamStart = ftell( m_outputFile );
+
+        {
+            wxFFileOutputStream ffos( outputFFile );
+            wxZlibOutputStream  zos( ffos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
+            wxDataOutputStream  dos( zos );
+
+            WriteImageSMaskStream( aImage, dos );
+        }
+
+        long smaskStreamSize = ftell( m_outputFile ) - smaskStreamStart;
+
+        fputs( "\nendstream\n", m_outputFile );
+        closePdfObject();
+
+        startPdfObject( smaskLenHandle );
+        fprintf( m_outputFile, "%u\n", (unsigned) smaskStreamSize );
+        closePdfObject();
+    }
+
+    outputFFile.Detach(); // Don't close it
+}
+
+
 void PDF_PLOTTER::StartPage( const wxString& aPageNumber, const wxString& aPageName )
 {
     wxASSERT( m_outputFile );
@@ -764,6 +848,12 @@ void PDF_PLOTTER::ClosePage()
     // Close the page stream (and compress it)
     closePdfStream();
 
+    // Emit the images first used on this page
+    for( const auto& [imgHandle, image] : m_pageImages )
+        emitImage( imgHandle, image );
+
+    m_pageImages.clear();
+
     // Page size is in 1/72 of inch (default user space units).  Works like the bbox in postscript
     // but there is no need for swapping the sizes, since PDF doesn't require a portrait page.
     // We use the MediaBox but PDF has lots of other less-used boxes that could be used.
@@ -940,6 +1030,9 @@ bool PDF_PLOTTER::StartPlot( const wxString& aPageNumber, const wxString& aPageN
     m_hyperlinkHandles.clear();
     m_hyperlinkMenuHandles.clear();
     m_bookmarksInPage.clear();
+    m_imageHandles.clear();
+    m_imageHashes.clear();
+    m_pageImages.clear();
     m_totalOutlineNodes = 0;
 
     m_outlineRoot = std::make_unique<OUTLINE_NODE>();
@@ -1162,108 +1255,12 @@ bool PDF_PLOTTER::EndPlot()
     startPdfObject( m_imgResDictHandle );
     fputs( "<<\n", m_outputFile );
 
-    for( const auto& [imgHandle, image] : m_imageHandles )
-    {
+    for( int imgHandle : m_imageHandles )
         fprintf( m_outputFile, "    /Im%d %d 0 R\n", imgHandle, imgHandle );
-    }
 
     fputs( ">>\n", m_outputFile );
     closePdfObject();
 
-    // Emit images with optional SMask for transparency
-    for( const auto& [imgHandle, image] : m_imageHandles )
-    {
-        // Init wxFFile so wxFFileOutputStream won't close file in dtor.
-        wxFFile outputFFile( m_outputFile );
-
-        // Image
-        startPdfObject( imgHandle );
-        int imgLenHandle = allocPdfObject();
-        int smaskHandle = ( image.HasAlpha() || image.HasMask() ) ? allocPdfObject() : -1;
-
-        fprintf( m_outputFile,
-                 "<<\n"
-                 "/Type /XObject\n"
-                 "/Subtype /Image\n"
-                 "/BitsPerComponent 8\n"
-                 "/ColorSpace %s\n"
-                 "/Width %d\n"
-                 "/Height %d\n"
-                 "/Filter /FlateDecode\n"
-                 "/Length %d 0 R\n", // Length is deferred
-                 m_colorMode ? "/DeviceRGB" : "/DeviceGray", image.GetWidth(), image.GetHeight(),
-                 imgLenHandle );
-
-        if( smaskHandle != -1 )
-            fprintf( m_outputFile, "/SMask %d 0 R\n", smaskHandle );
-
-        fputs( ">>\n", m_outputFile );
-        fputs( "stream\n", m_outputFile );
-
-        long imgStreamStart = ftell( m_outputFile );
-
-        {
-            wxFFileOutputStream ffos( outputFFile );
-            wxZlibOutputStream  zos( ffos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
-            wxDataOutputStream  dos( zos );
-
-            WriteImageStream( image, dos, m_renderSettings->GetBackgroundColor().ToColour(),
-                              m_colorMode );
-        }
-
-        long imgStreamSize = ftell( m_outputFile ) - imgStreamStart;
-
-        fputs( "\nendstream\n", m_outputFile );
-        closePdfObject();
-
-        startPdfObject( imgLenHandle );
-        fprintf( m_outputFile, "%ld\n", imgStreamSize );
-        closePdfObject();
-
-        if( smaskHandle != -1 )
-        {
-            // SMask
-            startPdfObject( smaskHandle );
-            int smaskLenHandle = allocPdfObject();
-
-            fprintf( m_outputFile,
-                     "<<\n"
-                     "/Type /XObject\n"
-                     "/Subtype /Image\n"
-                     "/BitsPerComponent 8\n"
-                     "/ColorSpace /DeviceGray\n"
-                     "/Width %d\n"
-                     "/Height %d\n"
-                     "/Length %d 0 R\n"
-                     "/Filter /FlateDecode\n"
-                     ">>\n", // Length is deferred
-                     image.GetWidth(), image.GetHeight(), smaskLenHandle );
-
-            fputs( "stream\n", m_outputFile );
-
-            long smaskStreamStart = ftell( m_outputFile );
-
-            {
-                wxFFileOutputStream ffos( outputFFile );
-                wxZlibOutputStream  zos( ffos, wxZ_BEST_COMPRESSION, wxZLIB_ZLIB );
-                wxDataOutputStream  dos( zos );
-
-                WriteImageSMaskStream( image, dos );
-            }
-
-            long smaskStreamSize = ftell( m_outputFile ) - smaskStreamStart;
-
-            fputs( "\nendstream\n", m_outputFile );
-            closePdfObject();
-
-            startPdfObject( smaskLenHandle );
-            fprintf( m_outputFile, "%u\n", (unsigned) smaskStreamSize );
-            closePdfObject();
-        }
-
-        outputFFile.Detach(); // Don't close it
-    }
-
     for( const auto& [ linkHandle, linkPair ] : m_hyperlinkHandles )
     {
         const BOX2D&    box = linkPair.first;
@@ -93,6 +93,8 @@
 #include <macros.h>
 #include <trigo.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <wx/mstream.h>
 
@@ -172,6 +174,8 @@ SVG_PLOTTER::SVG_PLOTTER()
     m_brush_alpha     = 1.0;
     m_dashed          = LINE_STYLE::SOLID;
     m_precision       = 4;               // default: 4 digits in mantissa.
+    m_compact         = false;
+    m_pathPending     = false;
 }
 
 
@@ -202,6 +206,124 @@ void SVG_PLOTTER::SetSvgCoordinatesFormat( unsigned aPrecision )
     // Only number of digits in mantissa are adjustable.
     // SVG units are always mm
     m_precision = aPrecision;
+
+    // In compact mode, SVG units are 10^-aPrecision mm and written as integers
+    if( m_compact )
+    {
+        double iusPerMM = m_IUsPerDecimil / 2.54 * 1000;
+
+        m_iuPerDeviceUnit = std::pow( 10.0, aPrecision ) / iusPerMM;
+        m_precision = 0;
+    }
+}
+
+
+void SVG_PLOTTER::SetSvgCompactOutput( bool aCompact )
+{
+    m_compact = aCompact;
+}
+
+
+void SVG_PLOTTER::closePendingPath()
+{
+    if( m_pathPending )
+    {
+        fputs( "\" />\n", m_outputFile );
+        m_pathPending = false;
+    }
+}
+
+
+void SVG_PLOTTER::flashShape( int aKind, const VECTOR2I& aSize, int aRadius,
+                              const EDA_ANGLE& aOrient, const VECTOR2I& aPos,
+                              const std::function<void()>& aPlot )
+{
+    // The shapes reused take the style of the group they are used in, so set it first
+    setFillMode( FILL_T::FILLED_SHAPE );
+    SetCurrentLineWidth( 0 );
+
+    if( m_graphics_changed )
+        setSVGPlotStyle( GetCurrentLineWidth() );
+
+    closePendingPath();
+
+    VECTOR2D pos_dev = userToDeviceCoordinates( aPos );
+    auto     key = std::make_tuple( aKind, aSize.x, aSize.y, aRadius, aOrient.AsDegrees(),
+                                    m_brush_rgb_color, m_brush_alpha );
+    auto     it = m_flashedShapes.find( key );
+
+    if( it != m_flashedShapes.end() )
+    {
+        VECTOR2D offset = pos_dev - it->second.second;
+
+        fprintf( m_outputFile, "<use xlink:href=\"#pad%d\" x=\"%.*f\" y=\"%.*f\" />\n",
+                 it->second.first, m_precision, offset.x, m_precision, offset.y );
+        return;
+    }
+
+    int id = (int) m_flashedShapes.size();
+
+    m_flashedShapes.emplace( key, std::make_pair( id, pos_dev ) );
+
+    fprintf( m_outputFile, "<g id=\"pad%d\">\n", id );
+    aPlot();
+    closePendingPath();
+    fputs( "</g>\n", m_outputFile );
+}
+
+
+void SVG_PLOTTER::FlashPadCircle( const VECTOR2I& aPadPos, int aDiameter,
+                                  OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( !m_compact || aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadCircle( aPadPos, aDiameter, aTraceMode, aData );
+        return;
+    }
+
+    flashShape( 0, VECTOR2I( aDiameter, aDiameter ), 0, ANGLE_0, aPadPos,
+                [&]()
+                {
+                    PSLIKE_PLOTTER::FlashPadCircle( aPadPos, aDiameter, aTraceMode, aData );
+                } );
+}
+
+
+void SVG_PLOTTER::FlashPadRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                                void* aData )
+{
+    if( !m_compact || aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadRect( aPadPos, aSize, aPadOrient, aTraceMode, aData );
+        return;
+    }
+
+    flashShape( 1, aSize, 0, aPadOrient, aPadPos,
+                [&]()
+                {
+                    PSLIKE_PLOTTER::FlashPadRect( aPadPos, aSize, aPadOrient, aTraceMode, aData );
+                } );
+}
+
+
+void SVG_PLOTTER::FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                     int aCornerRadius, const EDA_ANGLE& aOrient,
+                                     OUTLINE_MODE aTraceMode, void* aData )
+{
+    if( !m_compact || aTraceMode != FILLED )
+    {
+        PSLIKE_PLOTTER::FlashPadRoundRect( aPadPos, aSize, aCornerRadius, aOrient, aTraceMode,
+                                           aData );
+        return;
+    }
+
+    flashShape( 2, aSize, aCornerRadius, aOrient, aPadPos,
+                [&]()
+                {
+                    PSLIKE_PLOTTER::FlashPadRoundRect( aPadPos, aSize, aCornerRadius, aOrient,
+                                                       aTraceMode, aData );
+                } );
 }
 
 
@@ -217,6 +339,8 @@ void SVG_PLOTTER::setFillMode( FILL_T fill )
 
 void SVG_PLOTTER::setSVGPlotStyle( int aLineWidth, bool aIsGroup, const std::string& aExtraStyle )
 {
+    closePendingPath();
+
     if( aIsGroup )
         fputs( "</g>\n<g ", m_outputFile );
 
@@ -236,7 +360,9 @@ void SVG_PLOTTER::setSVGPlotStyle( int aLineWidth, bool aIsGroup, const std::str
         case FILL_T::FILLED_SHAPE:
         case FILL_T::FILLED_WITH_BG_BODYCOLOR:
         case FILL_T::FILLED_WITH_COLOR:
-            fprintf( m_outputFile, "fill-opacity:%.*f; ", m_precision, m_brush_alpha );
+            // m_precision is 0 in compact mode, where coordinates are integers
+            fprintf( m_outputFile, "fill-opacity:%.*f; ", std::max( m_precision, 3U ),
+                     m_brush_alpha );
             break;
         default: break;
         }
@@ -371,6 +497,8 @@ void SVG_PLOTTER::SetDash( int aLineWidth, LINE_STYLE aLineStyle )
 
 void SVG_PLOTTER::Rect( const VECTOR2I& p1, const VECTOR2I& p2, FILL_T fill, int width )
 {
+    closePendingPath();
+
     BOX2I rect( p1, VECTOR2I( p2.x - p1.x, p2.y - p1.y ) );
     rect.Normalize();
 
@@ -412,6 +540,8 @@ void SVG_PLOTTER::Rect( const VECTOR2I& p1, const VECTOR2I& p2, FILL_T fill, int
 
 void SVG_PLOTTER::Circle( const VECTOR2I& pos, int diametre, FILL_T fill, int width )
 {
+    closePendingPath();
+
     VECTOR2D pos_dev = userToDeviceCoordinates( pos );
     double   radius  = userToDeviceSize( diametre / 2.0 );
 
@@ -445,6 +575,7 @@ void SVG_PLOTTER::Arc( const VECTOR2D& aCenter, const EDA_ANGLE& aStartAngle,
      *
      *  The arc is drawn in an anticlockwise direction from the start point to the end point.
      */
+    closePendingPath();
 
     if( aRadius <= 0 )
     {
@@ -548,6 +679,7 @@ void SVG_PLOTTER::BezierCurve( const VECTOR2I& aStart, const VECTOR2I& aControl1
                                int aTolerance, int aLineThickness )
 {
 #if 1
+    closePendingPath();
     setFillMode( FILL_T::NO_FILL );
     SetCurrentLineWidth( aLineThickness );
 
@@ -577,6 +709,7 @@ void SVG_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
     if( aCornerList.size() <= 1 )
         return;
 
+    closePendingPath();
     setFillMode( aFill );
     SetCurrentLineWidth( aWidth );
     fprintf( m_outputFile, "<path ");
@@ -618,6 +751,8 @@ void SVG_PLOTTER::PlotPoly( const std::vector<VECTOR2I>& aCornerList, FILL_T aFi
 
 void SVG_PLOTTER::PlotImage( const wxImage& aImage, const VECTOR2I& aPos, double aScaleFactor )
 {
+    closePendingPath();
+
     VECTOR2I pix_size( aImage.GetWidth(), aImage.GetHeight() );
 
     // Requested size (in IUs)
@@ -676,7 +811,12 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
     {
         if( m_penState != 'Z' )
         {
-            fputs( "\" />\n", m_outputFile );
+            // In compact mode, leave the path open for the next strokes of the same style
+            if( m_compact )
+                m_pathPending = true;
+            else
+                fputs( "\" />\n", m_outputFile );
+
             m_penState        = 'Z';
             m_penLastpos.x    = -1;
             m_penLastpos.y    = -1;
@@ -697,9 +837,18 @@ void SVG_PLOTTER::PenTo( const VECTOR2I& pos, char plume )
         if( m_graphics_changed )
             setSVGPlotStyle( GetCurrentLineWidth() );
 
-        fprintf( m_outputFile, "<path d=\"M%.*f %.*f\n",
-                 m_precision, pos_dev.x,
-                 m_precision, pos_dev.y );
+        if( m_pathPending )
+        {
+            fprintf( m_outputFile, "M%.*f %.*f\n", m_precision, pos_dev.x, m_precision,
+                     pos_dev.y );
+            m_pathPending = false;
+        }
+        else
+        {
+            fprintf( m_outputFile, "<path d=\"M%.*f %.*f\n",
+                     m_precision, pos_dev.x,
+                     m_precision, pos_dev.y );
+        }
     }
     else if( m_penState != plume || pos != m_penLastpos )
     {
@@ -722,6 +871,9 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
 {
     wxASSERT( m_outputFile );
 
+    m_pathPending = false;
+    m_flashedShapes.clear();
+
     static const char*  header[] =
     {
         "<?xml version=\"1.0\" standalone=\"no\"?>\n",
@@ -742,10 +894,13 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
     }
 
     // Write viewport pos and size
+    // (m_precision is 0 in compact mode, where only the viewBox is in integer units)
     VECTOR2D origin;    // TODO set to actual value
+    unsigned mmPrecision = std::max( m_precision, 3U );
+
     fprintf( m_outputFile, "  width=\"%.*fmm\" height=\"%.*fmm\" viewBox=\"%.*f %.*f %.*f %.*f\">\n",
-             m_precision, (double) m_paperSize.x / m_IUsPerDecimil * 2.54 / 1000,
-             m_precision, (double) m_paperSize.y / m_IUsPerDecimil * 2.54 / 1000,
+             mmPrecision, (double) m_paperSize.x / m_IUsPerDecimil * 2.54 / 1000,
+             mmPrecision, (double) m_paperSize.y / m_IUsPerDecimil * 2.54 / 1000,
              m_precision, origin.x, m_precision, origin.y,
              m_precision, m_paperSize.x * m_iuPerDeviceUnit,
              m_precision, m_paperSize.y * m_iuPerDeviceUnit);
@@ -767,7 +922,8 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
     double opacity = 1.0;      // 0.0 (transparent to 1.0 (solid)
     fprintf( m_outputFile,
              "<g style=\"fill:#%6.6lX; fill-opacity:%.*f;stroke:#%6.6lX; stroke-opacity:%.*f;\n",
-             m_brush_rgb_color, m_precision, m_brush_alpha, m_pen_rgb_color, m_precision, opacity );
+             m_brush_rgb_color, mmPrecision, m_brush_alpha, m_pen_rgb_color, mmPrecision,
+             opacity );
 
     // output the pen cap and line joint
     fputs( "stroke-linecap:round; stroke-linejoin:round;\"\n", m_outputFile );
@@ -778,6 +934,7 @@ bool SVG_PLOTTER::StartPlot( const wxString& aPageNumber )
 
 bool SVG_PLOTTER::EndPlot()
 {
+    closePendingPath();
     fputs( "</g> \n</svg>\n", m_outputFile );
     fclose( m_outputFile );
     m_outputFile = nullptr;
@@ -801,6 +958,7 @@ void SVG_PLOTTER::Text( const VECTOR2I&        aPos,
                         const KIFONT::METRICS& aFontMetrics,
                         void*                  aData )
 {
+    closePendingPath();
     setFillMode( FILL_T::NO_FILL );
     SetColor( aColor );
     SetCurrentLineWidth( aWidth );
@@ -863,6 +1021,7 @@ void SVG_PLOTTER::Text( const VECTOR2I&        aPos,
     PLOTTER::Text( aPos, aColor, aText, aOrient, aSize, aH_justify, aV_justify, aWidth, aItalic,
                    aBold, aMultilineAllowed, aFont, aFontMetrics );
 
+    closePendingPath();
     fputs( "</g>", m_outputFile );
 }
 
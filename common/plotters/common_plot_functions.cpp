@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <mutex>
+
 #include <eda_item.h>
 #include <font/font.h>
 #include <plotters/plotter_dxf.h>
@@ -55,6 +57,10 @@ void PlotDrawingSheet( PLOTTER* plotter, const PROJECT* aProject, const TITLE_BL
                        const wxString& aSheetPath, const wxString& aFilename, COLOR4D aColor,
                        bool aIsFirstPage )
 {
+    // The drawing sheet items are shared, so only one plotter can draw them at a time
+    static std::mutex           drawingSheetMutex;
+    std::lock_guard<std::mutex> lock( drawingSheetMutex );
+
     /* Note: Page sizes values are given in mils
      */
     double           iusPerMil = plotter->GetIUsPerDecimil() * 10.0;
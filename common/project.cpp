@@ -185,7 +185,8 @@ void PROJECT::PinLibrary( const wxString& aLibrary, bool isSymbolLibrary )
     if( !alg::contains( *pinnedLibs, aLibrary ) )
         pinnedLibs->push_back( aLibrary );
 
-    Pgm().GetSettingsManager().SaveProject();
+    if( !IsReadOnly() )
+        Pgm().GetSettingsManager().SaveDeferred( m_projectFile, GetProjectPath() );
 
     pinnedLibs = isSymbolLibrary ? &cfg->m_Session.pinned_symbol_libs
                                  : &cfg->m_Session.pinned_fp_libs;
@@ -193,7 +194,7 @@ void PROJECT::PinLibrary( const wxString& aLibrary, bool isSymbolLibrary )
     if( !alg::contains( *pinnedLibs, aLibrary ) )
         pinnedLibs->push_back( aLibrary );
 
-    cfg->SaveToFile( Pgm().GetSettingsManager().GetPathForSettingsFile( cfg ) );
+    Pgm().GetSettingsManager().SaveDeferred( cfg );
 }
 
 
@@ -204,13 +205,14 @@ void PROJECT::UnpinLibrary( const wxString& aLibrary, bool isSymbolLibrary )
                                                         : &m_projectFile->m_PinnedFootprintLibs;
 
     alg::delete_matching( *pinnedLibs, aLibrary );
-    Pgm().GetSettingsManager().SaveProject();
+    if( !IsReadOnly() )
+        Pgm().GetSettingsManager().SaveDeferred( m_projectFile, GetProjectPath() );
 
     pinnedLibs = isSymbolLibrary ? &cfg->m_Session.pinned_symbol_libs
                                  : &cfg->m_Session.pinned_fp_libs;
 
     alg::delete_matching( *pinnedLibs, aLibrary );
-    cfg->SaveToFile( Pgm().GetSettingsManager().GetPathForSettingsFile( cfg ) );
+    Pgm().GetSettingsManager().SaveDeferred( cfg );
 }
 
 
@@ -49,11 +49,24 @@
 
 static int vprint( std::string* result, const char* format, va_list ap )
 {
+    // Most results fit on the stack, which saves a pass to measure them
+    char    buf[256];
     va_list tmp;
     va_copy( tmp, ap );
-    size_t  len = vsnprintf( nullptr, 0, format, tmp );
+    int     ret = vsnprintf( buf, sizeof( buf ), format, tmp );
     va_end( tmp );
 
+    if( ret < 0 )
+        return ret;
+
+    if( ret < (int) sizeof( buf ) )
+    {
+        result->append( buf, ret );
+        return ret;
+    }
+
+    size_t  len = ret;
+
     // Resize the output to hold the required data
     size_t  size = result->size();
     result->resize( size + len );
@@ -275,6 +288,87 @@ char* FILE_LINE_READER::ReadLine()
 }
 
 
+MAPPED_FILE_LINE_READER::MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                                                  unsigned aMaxLineLength ) :
+        LINE_READER( aMaxLineLength ),
+        m_file( std::make_unique<KIPLATFORM::IO::MAPPED_FILE>() ),
+        m_pos( 0 )
+{
+    if( !KIPLATFORM::IO::MapFile( aFileName, *m_file ) )
+    {
+        wxString msg = wxString::Format( _( "Unable to open %s for reading." ),
+                                         aFileName.GetData() );
+        THROW_IO_ERROR( msg );
+    }
+
+    m_source = aFileName;
+}
+
+
+MAPPED_FILE_LINE_READER::~MAPPED_FILE_LINE_READER()
+{
+    KIPLATFORM::IO::UnmapFile( *m_file );
+}
+
+
+size_t MAPPED_FILE_LINE_READER::LineCount() const
+{
+    const char* data = m_file->m_data;
+    const char* end = data + m_file->m_size;
+    size_t      count = 0;
+
+    while( data < end )
+    {
+        const char* nl = static_cast<const char*>( memchr( data, '\n', end - data ) );
+
+        ++count;
+
+        if( !nl )
+            break;
+
+        data = nl + 1;
+    }
+
+    return count;
+}
+
+
+size_t MAPPED_FILE_LINE_READER::FileLength() const
+{
+    return m_file->m_size;
+}
+
+
+char* MAPPED_FILE_LINE_READER::ReadLine()
+{
+    size_t remaining = m_file->m_size - m_pos;
+    size_t new_length = 0;
+
+    if( remaining )
+    {
+        const char* begin = m_file->m_data + m_pos;
+        const char* nl = static_cast<const char*>( memchr( begin, '\n', remaining ) );
+
+        new_length = nl ? nl - begin + 1 : remaining;     // include the newline
+
+        if( new_length >= m_maxLineLength )
+            THROW_IO_ERROR( _( "Maximum line length exceeded" ) );
+
+        if( new_length + 1 > m_capacity )   // +1 for terminating nul
+            expandCapacity( new_length + 1 );
+
+        memcpy( m_line, begin, new_length );
+        m_pos += new_length;
+    }
+
+    m_length = new_length;
+    ++m_lineNum;      // this gets incremented even if no bytes were read
+    m_line[m_length] = 0;
+
+    return m_length ? m_line : nullptr;
+}
+
+
 STRING_LINE_READER::STRING_LINE_READER( const std::string& aString, const wxString& aSource ):
     LINE_READER( LINE_READER_LINE_DEFAULT_MAX ),
     m_lines( aString ), m_ndx( 0 )
@@ -443,22 +537,8 @@ int OUTPUTFORMATTER::vprint( const char* fmt, va_list ap )
 }
 
 
-int OUTPUTFORMATTER::sprint( const char* fmt, ... )
-{
-    va_list args;
-
-    va_start( args, fmt );
-    int ret = vprint( fmt, args);
-    va_end( args );
-
-    return ret;
-}
-
-
 int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
 {
-#define NESTWIDTH           2   ///< how many spaces per nestLevel
-
     va_list     args;
 
     va_start( args, fmt );
@@ -466,12 +546,18 @@ int OUTPUTFORMATTER::Print( int nestLevel, const char* fmt, ... )
     int result = 0;
     int total  = 0;
 
-    for( int i = 0; i < nestLevel; ++i )
+    if( nestLevel > 0 )
     {
-        // no error checking needed, an exception indicates an error.
-        result = sprint( "%*c", NESTWIDTH, ' ' );
+        static const std::string spaces( 64, ' ' );
 
-        total += result;
+        for( int width = nestLevel * NESTWIDTH; width > 0; width -= (int) spaces.size() )
+        {
+            // no error checking needed, an exception indicates an error.
+            result = std::min( width, (int) spaces.size() );
+            write( spaces.data(), result );
+
+            total += result;
+        }
     }
 
     // no error checking needed, an exception indicates an error.
@@ -566,6 +652,9 @@ FILE_OUTPUTFORMATTER::FILE_OUTPUTFORMATTER( const wxString& aFileName, const wxC
 
     if( !m_fp )
         THROW_IO_ERROR( strerror( errno ) );
+
+    // Output comes in many small pieces, have them written out in large blocks
+    setvbuf( m_fp, nullptr, _IOFBF, 256 * 1024 );
 }
 
 
@@ -78,7 +78,12 @@ JSON_SETTINGS::JSON_SETTINGS( const wxString& aFilename, SETTINGS_LOC aLocation,
         m_deleteLegacyAfterMigration( true ),
         m_resetParamsIfMissing( true ),
         m_schemaVersion( aSchemaVersion ),
-        m_manager( nullptr )
+        m_manager( nullptr ),
+        m_preparedWrite( nullptr ),
+        m_saveGeneration( 0 ),
+        m_writtenGeneration( 0 ),
+        m_lastWrittenHash( 0 ),
+        m_lastWrittenModTime( 0 )
 {
     m_internals = std::make_unique<JSON_SETTINGS_INTERNALS>();
 
@@ -454,7 +459,11 @@ bool JSON_SETTINGS::SaveToFile( const wxString& aDirectory, bool aForce )
     wxLogTrace( traceSettings, wxT( "Saving %s" ), GetFullFilename() );
 
     LOCALE_IO dummy;
-    bool success = true;
+
+    JSON_SETTINGS_WRITE write;
+
+    write.m_path = path.GetFullPath();
+    write.m_generation = ++m_saveGeneration;
 
     nlohmann::json toSave = m_internals->m_original;
 
@@ -465,28 +474,85 @@ bool JSON_SETTINGS::SaveToFile( const wxString& aDirectory, bool aForce )
         std::stringstream buffer;
         buffer << std::setw( 2 ) << toSave << std::endl;
 
-        wxFFileOutputStream fileStream( path.GetFullPath(), "wb" );
-
-        if( !fileStream.IsOk()
-                || !fileStream.WriteAll( buffer.str().c_str(), buffer.str().size() ) )
-        {
-            wxLogTrace( traceSettings, wxT( "Warning: could not save %s" ), GetFullFilename() );
-            success = false;
-        }
+        write.m_contents = buffer.str();
     }
     catch( nlohmann::json::exception& error )
     {
         wxLogTrace( traceSettings, wxT( "Catch error: could not save %s. Json error %s" ),
                     GetFullFilename(), error.what() );
-        success = false;
+        return false;
     }
     catch( ... )
     {
         wxLogTrace( traceSettings, wxT( "Error: could not save %s." ) );
-        success = false;
+        return false;
     }
 
-    return success;
+    if( m_preparedWrite )
+    {
+        *m_preparedWrite = std::move( write );
+        return true;
+    }
+
+    return WriteToFile( write );
+}
+
+
+bool JSON_SETTINGS::PrepareSave( JSON_SETTINGS_WRITE& aWrite, const wxString& aDirectory,
+                                 bool aForce )
+{
+    aWrite = JSON_SETTINGS_WRITE();
+
+    // Go through the (virtual) SaveToFile() so that derived classes get to update their
+    // contents as they would for a regular save
+    m_preparedWrite = &aWrite;
+    SaveToFile( aDirectory, aForce );
+    m_preparedWrite = nullptr;
+
+    return !aWrite.m_path.IsEmpty();
+}
+
+
+bool JSON_SETTINGS::WriteToFile( const JSON_SETTINGS_WRITE& aWrite )
+{
+    std::lock_guard<std::mutex> lock( m_writeMutex );
+
+    // A more recent save got here first
+    if( aWrite.m_generation < m_writtenGeneration )
+        return false;
+
+    m_writtenGeneration = aWrite.m_generation;
+
+    wxFileName fn( aWrite.m_path );
+    size_t     hash = std::hash<std::string>()( aWrite.m_contents );
+
+    // Rewriting a file with its own contents is pointless (and can be slow, for instance on
+    // network home directories).  Only trust the last write if nobody touched the file since.
+    if( aWrite.m_path == m_lastWrittenPath && hash == m_lastWrittenHash && fn.FileExists()
+            && fn.GetModificationTime().GetValue().GetValue() == m_lastWrittenModTime )
+    {
+        wxLogTrace( traceSettings, wxT( "%s unchanged on disk, skipping write" ),
+                    aWrite.m_path );
+        return false;
+    }
+
+    wxFFileOutputStream fileStream( aWrite.m_path, "wb" );
+
+    if( !fileStream.IsOk()
+            || !fileStream.WriteAll( aWrite.m_contents.c_str(), aWrite.m_contents.size() ) )
+    {
+        wxLogTrace( traceSettings, wxT( "Warning: could not save %s" ), aWrite.m_path );
+        m_lastWrittenPath.clear();
+        return false;
+    }
+
+    fileStream.Close();
+
+    m_lastWrittenPath = aWrite.m_path;
+    m_lastWrittenHash = hash;
+    m_lastWrittenModTime = fn.GetModificationTime().GetValue().GetValue();
+
+    return true;
 }
 
 
@@ -25,10 +25,13 @@
 #include <wx/filename.h>
 #include <wx/snglinst.h>
 #include <wx/stdpaths.h>
+#include <wx/timer.h>
 #include <wx/utils.h>
 
 #include <build_version.h>
 #include <confirm.h>
+#include <core/thread_pool.h>
+#include <core/trace_profiler.h>
 #include <dialogs/dialog_migrate_settings.h>
 #include <gestfich.h>
 #include <kiplatform/environment.h>
@@ -51,6 +54,7 @@
 SETTINGS_MANAGER::SETTINGS_MANAGER( bool aHeadless ) :
         m_headless( aHeadless ),
         m_kiway( nullptr ),
+        m_colorSettingsLoaded( false ),
         m_common_settings( nullptr ),
         m_migration_source(),
         m_migrateLibraryTables( true )
@@ -72,8 +76,14 @@ SETTINGS_MANAGER::SETTINGS_MANAGER( bool aHeadless ) :
     registerBuiltinColorSettings();
 }
 
+/// How long to wait for further changes before writing out deferred saves
+static constexpr int DEFERRED_SAVE_DELAY_MS = 1000;
+
+
 SETTINGS_MANAGER::~SETTINGS_MANAGER()
 {
+    FlushDeferredSaves();
+
     for( std::unique_ptr<PROJECT>& project : m_projects_list )
         project.reset();
 
@@ -166,8 +176,93 @@ void SETTINGS_MANAGER::Save( JSON_SETTINGS* aSettings )
 }
 
 
+void SETTINGS_MANAGER::SaveDeferred( JSON_SETTINGS* aSettings, const wxString& aDirectory )
+{
+    wxCHECK( aSettings, /* void */ );
+
+    wxString directory = aDirectory.IsEmpty() ? GetPathForSettingsFile( aSettings ) : aDirectory;
+
+    // Without an event loop to fire the timer there is nothing to defer to
+    if( m_headless )
+    {
+        aSettings->SaveToFile( directory );
+        return;
+    }
+
+    m_deferredSaves[ aSettings ] = directory;
+
+    if( !m_deferredSaveTimer )
+    {
+        m_deferredSaveTimer = std::make_unique<wxTimer>();
+        m_deferredSaveTimer->Bind( wxEVT_TIMER,
+                                   [this]( wxTimerEvent& )
+                                   {
+                                       writeDeferredSaves();
+                                   } );
+    }
+
+    // Restarting the timer on every request coalesces a burst of changes into one save
+    m_deferredSaveTimer->StartOnce( DEFERRED_SAVE_DELAY_MS );
+}
+
+
+void SETTINGS_MANAGER::writeDeferredSaves()
+{
+    // One batch at a time; if the previous one is still being written, check back later
+    if( m_deferredWrites.valid()
+            && m_deferredWrites.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
+    {
+        m_deferredSaveTimer->StartOnce( DEFERRED_SAVE_DELAY_MS );
+        return;
+    }
+
+    // Serializing has to happen here, on the UI thread, as the settings can't be read while
+    // they are being changed.  Only the (possibly slow) disk access is left to the background.
+    std::vector<std::pair<JSON_SETTINGS*, JSON_SETTINGS_WRITE>> writes;
+
+    for( const auto& [ settings, directory ] : m_deferredSaves )
+    {
+        JSON_SETTINGS_WRITE write;
+
+        if( settings->PrepareSave( write, directory ) )
+            writes.emplace_back( settings, std::move( write ) );
+    }
+
+    m_deferredSaves.clear();
+
+    if( writes.empty() )
+        return;
+
+    m_deferredWrites = GetKiCadThreadPool().submit(
+            [writes = std::move( writes )]()
+            {
+                for( const auto& [ settings, write ] : writes )
+                    settings->WriteToFile( write );
+            } );
+}
+
+
+void SETTINGS_MANAGER::FlushDeferredSaves()
+{
+    if( m_deferredSaveTimer )
+        m_deferredSaveTimer->Stop();
+
+    if( m_deferredWrites.valid() )
+        m_deferredWrites.wait();
+
+    if( !m_deferredSaves.empty() )
+        writeDeferredSaves();
+
+    if( m_deferredWrites.valid() )
+        m_deferredWrites.wait();
+}
+
+
 void SETTINGS_MANAGER::FlushAndRelease( JSON_SETTINGS* aSettings, bool aSave )
 {
+    // Deferred saves may still refer to the settings being released
+    FlushDeferredSaves();
+
     auto it = std::find_if( m_settings.begin(), m_settings.end(),
                             [&aSettings]( const std::unique_ptr<JSON_SETTINGS>& aPtr )
                             {
@@ -193,6 +288,8 @@ void SETTINGS_MANAGER::FlushAndRelease( JSON_SETTINGS* aSettings, bool aSave )
 
 COLOR_SETTINGS* SETTINGS_MANAGER::GetColorSettings( const wxString& aName )
 {
+    ensureColorSettingsLoaded();
+
     // Find settings the fast way
     if( m_color_settings.count( aName ) )
         return m_color_settings.at( aName );
@@ -300,6 +397,8 @@ COLOR_SETTINGS* SETTINGS_MANAGER::registerColorSettings( const wxString& aName,
 
 COLOR_SETTINGS* SETTINGS_MANAGER::AddNewColorSettings( const wxString& aName )
 {
+    ensureColorSettingsLoaded();
+
     if( aName.EndsWith( wxT( ".json" ) ) )
         return registerColorSettings( aName.BeforeLast( '.' ) );
     else
@@ -309,6 +408,8 @@ COLOR_SETTINGS* SETTINGS_MANAGER::AddNewColorSettings( const wxString& aName )
 
 COLOR_SETTINGS* SETTINGS_MANAGER::GetMigratedColorSettings()
 {
+    ensureColorSettingsLoaded();
+
     if( !m_color_settings.count( "user" ) )
     {
         COLOR_SETTINGS* settings = registerColorSettings( wxT( "user" ) );
@@ -378,13 +479,35 @@ void SETTINGS_MANAGER::loadAllColorSettings()
 
 void SETTINGS_MANAGER::ReloadColorSettings()
 {
+    std::lock_guard<std::mutex> lock( m_colorSettingsMutex );
+
     m_color_settings.clear();
-    loadAllColorSettings();
+    m_colorSettingsLoaded = false;
+}
+
+
+void SETTINGS_MANAGER::ensureColorSettingsLoaded()
+{
+    if( m_colorSettingsLoaded )
+        return;
+
+    // kicad-cli may run the jobs of several editors at once
+    std::lock_guard<std::mutex> lock( m_colorSettingsMutex );
+
+    if( !m_colorSettingsLoaded )
+    {
+        TRACE_SCOPE( "Load color themes" );
+
+        loadAllColorSettings();
+        m_colorSettingsLoaded = true;
+    }
 }
 
 
 void SETTINGS_MANAGER::SaveColorSettings( COLOR_SETTINGS* aSettings, const std::string& aNamespace )
 {
+    ensureColorSettingsLoaded();
+
     // The passed settings should already be managed
     wxASSERT( std::find_if( m_color_settings.begin(), m_color_settings.end(),
                             [aSettings] ( const std::pair<wxString, COLOR_SETTINGS*>& el )
@@ -26,6 +26,9 @@
  */
 
 
+#include <cmath>
+#include <unordered_set>
+
 #include <layer_ids.h>
 #include <trace_helpers.h>
 
@@ -39,7 +42,10 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <gal/painter.h>
 
+#include <core/kicad_algo.h>
 #include <core/profile.h>
+#include <core/thread_pool.h>
+#include <core/trace_profiler.h>
 
 #ifdef KICAD_GAL_PROFILE
 #include <wx/log.h>
@@ -138,6 +144,52 @@ private:
     }
 
 
+    /**
+     * Return the group id of the item at a detail level coarser than the full one.
+     *
+     * @return group id or -1 in case the item is not cached at this level.
+     */
+    int getDetailGroup( int aLevel, int aLayer ) const
+    {
+        for( const DETAIL_GROUP& detail : m_detailGroups )
+        {
+            if( detail.m_level == aLevel && detail.m_layer == aLayer )
+                return detail.m_group;
+        }
+
+        return -1;
+    }
+
+    void setDetailGroup( int aLevel, int aLayer, int aGroup )
+    {
+        m_detailGroups.push_back( { aLevel, aLayer, aGroup } );
+    }
+
+    /**
+     * Delete the groups of the coarser detail levels, which are rebuilt when drawn again.  They
+     * follow from the full detail groups, so they go whenever one of those changes.
+     */
+    void deleteDetailGroups( GAL* aGal )
+    {
+        for( const DETAIL_GROUP& detail : m_detailGroups )
+            aGal->DeleteGroup( detail.m_group );
+
+        m_detailGroups.clear();
+    }
+
+    /**
+     * Give the color of a layer to the groups of the coarser detail levels on this layer, which
+     * are drawn like the full detail group.
+     */
+    void changeDetailGroupsColor( GAL* aGal, int aLayer, const COLOR4D& aColor )
+    {
+        for( const DETAIL_GROUP& detail : m_detailGroups )
+        {
+            if( detail.m_layer == aLayer )
+                aGal->ChangeGroupColor( detail.m_group, aColor );
+        }
+    }
+
     /**
      * Remove all of the stored group ids. Forces recaching of the item.
      */
@@ -146,6 +198,7 @@ private:
         delete[] m_groups;
         m_groups = nullptr;
         m_groupsSize = 0;
+        m_detailGroups.clear();
     }
 
 
@@ -179,6 +232,12 @@ private:
 
             m_groups[i].first = new_layer;
         }
+
+        for( DETAIL_GROUP& detail : m_detailGroups )
+        {
+            if( aReorderMap.count( detail.m_layer ) )
+                detail.m_layer = aReorderMap.at( detail.m_layer );
+        }
     }
 
     /**
@@ -233,6 +292,18 @@ private:
                                              ///< item occupies.
     int                  m_groupsSize;
 
+    struct DETAIL_GROUP
+    {
+        int m_level;
+        int m_layer;
+        int m_group;
+    };
+
+    std::vector<DETAIL_GROUP> m_detailGroups; ///< Groups of the coarser detail levels.
+
+    BOX2I                m_bbox;             ///< Bounding box the item was inserted in the
+                                             ///< rtrees with.
+
     std::vector<int>     m_layers;           /// Stores layer numbers used by the item.
 };
 
@@ -260,7 +331,12 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_dynamic( aIsDynamic ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_detailPixelSize( 0.0 ),
+    m_detailLevel( 0 ),
+    m_partialRedraw( false ),
+    m_scrollRedraw( false ),
+    m_panned( false )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -329,6 +405,7 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 
     aItem->ViewGetLayers( layers, layers_count );
     aItem->viewPrivData()->saveLayers( layers, layers_count );
+    aItem->viewPrivData()->m_bbox = aItem->ViewBBox();
 
     m_allItems->push_back( aItem );
 
@@ -339,7 +416,7 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 
         VIEW_LAYER& l = m_layers[layers[i]];
         l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        markAreaDirty( l.target, aItem->viewPrivData()->m_bbox );
     }
 
     SetVisible( aItem, true );
@@ -360,25 +437,65 @@ void VIEW::Remove( VIEW_ITEM* aItem )
             aItem->m_viewPrivData->clearUpdateFlags();
         }
 
-        int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
-        aItem->m_viewPrivData->getLayers( layers, layers_count );
+        removeFromLayers( aItem );
+    }
+}
 
-        for( int i = 0; i < layers_count; ++i )
-        {
-            VIEW_LAYER& l = m_layers[layers[i]];
-            l.items->Remove( aItem );
-            MarkTargetDirty( l.target );
 
-            // Clear the GAL cache
-            int prevGroup = aItem->m_viewPrivData->getGroup( layers[i] );
+void VIEW::RemoveItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    std::unordered_set<VIEW_ITEM*> removed;
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        if( !item || !item->m_viewPrivData )
+            continue;
 
-            if( prevGroup >= 0 )
-                m_gal->DeleteGroup( prevGroup );
-        }
+        wxCHECK2( item->m_viewPrivData->m_view == this, continue );
+        removed.insert( item );
+    }
+
+    if( removed.empty() )
+        return;
+
+    // A single pass over all the items, rather than a search for each removed one
+    alg::delete_if( *m_allItems,
+                    [&]( VIEW_ITEM* item )
+                    {
+                        return removed.count( item ) > 0;
+                    } );
+
+    for( VIEW_ITEM* item : removed )
+    {
+        item->m_viewPrivData->clearUpdateFlags();
+        removeFromLayers( item );
+    }
+}
+
+
+void VIEW::removeFromLayers( VIEW_ITEM* aItem )
+{
+    VIEW_ITEM_DATA* viewData = aItem->m_viewPrivData;
+    int             layers[VIEW::VIEW_MAX_LAYERS], layers_count;
+
+    viewData->getLayers( layers, layers_count );
+
+    for( int i = 0; i < layers_count; ++i )
+    {
+        VIEW_LAYER& l = m_layers[layers[i]];
+        l.items->Remove( aItem, &viewData->m_bbox );
+        markAreaDirty( l.target, viewData->m_bbox );
 
-        aItem->m_viewPrivData->deleteGroups();
-        aItem->m_viewPrivData->m_view = nullptr;
+        // Clear the GAL cache
+        int prevGroup = viewData->getGroup( layers[i] );
+
+        if( prevGroup >= 0 )
+            m_gal->DeleteGroup( prevGroup );
     }
+
+    viewData->deleteDetailGroups( m_gal );
+    viewData->deleteGroups();
+    viewData->m_view = nullptr;
 }
 
 
@@ -590,8 +707,12 @@ void VIEW::SetCenter( const VECTOR2D& aCenter )
     m_gal->SetLookAtPoint( m_center );
     m_gal->ComputeWorldScreenMatrix();
 
-    // Redraw everything after the viewport has changed
+    // Redraw everything after the viewport has changed, unless the targets can be moved
+    bool panned = m_panned || ( !IsTargetDirty( TARGET_CACHED )
+                                && !IsTargetDirty( TARGET_NONCACHED ) );
+
     MarkDirty();
+    m_panned = panned;
 }
 
 
@@ -725,6 +846,8 @@ struct VIEW::UPDATE_COLOR_VISITOR
         if( group >= 0 )
             gal->ChangeGroupColor( group, color );
 
+        aItem->viewPrivData()->changeDetailGroupsColor( gal, layer, color );
+
         return true;
     }
 
@@ -778,6 +901,8 @@ void VIEW::UpdateAllLayersColor()
 
                 if( group >= 0 )
                     m_gal->ChangeGroupColor( group, color );
+
+                viewData->changeDetailGroupsColor( m_gal, layers[i], color );
             }
         }
     }
@@ -802,6 +927,8 @@ struct VIEW::UPDATE_DEPTH_VISITOR
         if( group >= 0 )
             gal->ChangeGroupDepth( group, depth );
 
+        aItem->viewPrivData()->deleteDetailGroups( gal );
+
         return true;
     }
 
@@ -903,6 +1030,7 @@ void VIEW::UpdateAllLayersOrder()
 
             int layers[VIEW::VIEW_MAX_LAYERS], layers_count;
             viewData->getLayers( layers, layers_count );
+            viewData->deleteDetailGroups( m_gal );
 
             for( int i = 0; i < layers_count; ++i )
             {
@@ -926,7 +1054,8 @@ struct VIEW::DRAW_ITEM_VISITOR
         useDrawPriority( aUseDrawPriority ),
         reverseDrawOrder( aReverseDrawOrder ),
         drawForcedTransparent( false ),
-        foundForcedTransparent( false )
+        foundForcedTransparent( false ),
+        drawnItems( nullptr )
     {
     }
 
@@ -934,6 +1063,10 @@ struct VIEW::DRAW_ITEM_VISITOR
     {
         wxCHECK( aItem->viewPrivData(), false );
 
+        // Items found in several of the redrawn areas are drawn once
+        if( drawnItems && !drawnItems->insert( aItem ).second )
+            return true;
+
         if( aItem->m_forcedTransparency > 0 && !drawForcedTransparent )
         {
             foundForcedTransparent = true;
@@ -983,6 +1116,7 @@ struct VIEW::DRAW_ITEM_VISITOR
     std::vector<VIEW_ITEM*> drawItems;
     bool drawForcedTransparent;
     bool foundForcedTransparent;
+    std::unordered_set<VIEW_ITEM*>* drawnItems;
 };
 
 
@@ -992,7 +1126,27 @@ void VIEW::redrawRect( const BOX2I& aRect )
     {
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
         {
-            DRAW_ITEM_VISITOR drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
+            DRAW_ITEM_VISITOR              drawFunc( this, l->id, m_useDrawPriority,
+                                                     m_reverseDrawOrder );
+            std::unordered_set<VIEW_ITEM*> drawnItems;
+            int                            drawnBefore = m_redrawStatistics.m_drawnItems;
+
+            // The overlay is always redrawn entirely
+            auto query =
+                    [&]()
+                    {
+                        if( m_redrawAreas.empty() || l->target == TARGET_OVERLAY )
+                        {
+                            l->items->Query( aRect, drawFunc );
+                            return;
+                        }
+
+                        drawnItems.clear();
+                        drawFunc.drawnItems = m_redrawAreas.size() > 1 ? &drawnItems : nullptr;
+
+                        for( const BOX2I& area : m_redrawAreas )
+                            l->items->Query( area, drawFunc );
+                    };
 
             m_gal->SetTarget( l->target );
             m_gal->SetLayerDepth( l->renderingOrder );
@@ -1004,7 +1158,7 @@ void VIEW::redrawRect( const BOX2I& aRect )
             else if( l->hasNegatives )
                 m_gal->StartNegativesLayer();
 
-            l->items->Query( aRect, drawFunc );
+            query();
 
             if( m_useDrawPriority )
                 drawFunc.deferredDraw();
@@ -1022,8 +1176,11 @@ void VIEW::redrawRect( const BOX2I& aRect )
                 m_gal->EnableDepthTest( true );
                 m_gal->SetLayerDepth( l->renderingOrder );
 
-                l->items->Query( aRect, drawFunc );
+                query();
             }
+
+            if( int drawn = m_redrawStatistics.m_drawnItems - drawnBefore; drawn > 0 )
+                m_redrawStatistics.m_layerItems[l->id] += drawn;
         }
     }
 }
@@ -1036,21 +1193,45 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
     if( !viewData )
         return;
 
+    m_redrawStatistics.m_drawnItems++;
+
     if( IsCached( aLayer ) && !aImmediate )
     {
         // Draw using cached information or create one
         int group = viewData->getGroup( aLayer );
 
+        // Zoomed out, use the coarser geometry if the item has it or cache it at the next update
+        if( group >= 0 && m_detailLevel > 0 && m_painter->HasDetailLevels( aItem, aLayer ) )
+        {
+            int detailGroup = viewData->getDetailGroup( m_detailLevel, aLayer );
+
+            if( detailGroup >= 0 )
+                group = detailGroup;
+            else
+                Update( aItem, DETAIL );
+        }
+
         if( group >= 0 )
+        {
             m_gal->DrawGroup( group );
+            m_redrawStatistics.m_cacheHits++;
+        }
         else
+        {
             Update( aItem );
+            m_redrawStatistics.m_cacheMisses++;
+        }
     }
     else
     {
-        // Immediate mode
+        // Immediate mode, drawn again at each redraw
+        if( m_gal->GetWorldScale() > 0.0 )
+            m_gal->SetMinPixelSize( 1.0 / m_gal->GetWorldScale() );
+
         if( !m_painter->Draw( aItem, aLayer ) )
             aItem->ViewDraw( aLayer, this );  // Alternative drawing method
+
+        m_gal->SetMinPixelSize( 0.0 );
     }
 }
 
@@ -1102,6 +1283,7 @@ struct VIEW::RECACHE_ITEM_VISITOR
             gal->DeleteGroup( group );
 
         viewData->setGroup( layer, -1 );
+        viewData->deleteDetailGroups( gal );
         view->Update( aItem );
 
         return true;
@@ -1128,31 +1310,31 @@ void VIEW::Clear()
 }
 
 
-void VIEW::ClearTargets()
+void VIEW::markAreaDirty( int aTarget, const BOX2I& aArea )
 {
-    if( IsTargetDirty( TARGET_CACHED ) || IsTargetDirty( TARGET_NONCACHED ) )
-    {
-        // TARGET_CACHED and TARGET_NONCACHED have to be redrawn together, as they contain
-        // layers that rely on each other (eg. netnames are noncached, but tracks - are cached)
-        m_gal->ClearTarget( TARGET_NONCACHED );
-        m_gal->ClearTarget( TARGET_CACHED );
-
-        MarkDirty();
-    }
+    wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
 
-    if( IsTargetDirty( TARGET_OVERLAY ) )
+    if( aTarget == TARGET_OVERLAY || !m_partialRedraw )
     {
-        m_gal->ClearTarget( TARGET_OVERLAY );
+        MarkTargetDirty( aTarget );
+        return;
     }
+
+    bool wasDirty = m_dirtyTargets[TARGET_CACHED] || m_dirtyTargets[TARGET_NONCACHED];
+
+    m_dirtyTargets[aTarget] = true;
+    m_panned = false;
+
+    // If the targets were already dirty without an area, they are dirty everywhere
+    if( !wasDirty )
+        m_dirtyArea = aArea;
+    else if( m_dirtyArea )
+        m_dirtyArea->Merge( aArea );
 }
 
 
-void VIEW::Redraw()
+BOX2I VIEW::visibleArea() const
 {
-#ifdef KICAD_GAL_PROFILE
-    PROF_TIMER totalRealTime;
-#endif /* KICAD_GAL_PROFILE */
-
     VECTOR2D screenSize = m_gal->GetScreenPixelSize();
     BOX2D    rect( ToWorld( VECTOR2D( 0, 0 ) ),
                    ToWorld( screenSize ) - ToWorld( VECTOR2D( 0, 0 ) ) );
@@ -1168,13 +1350,150 @@ void VIEW::Redraw()
         recti.SetMaximum();
     }
 
+    return recti;
+}
+
+
+bool VIEW::scrollTargets()
+{
+    if( !m_drawnWorldScreenMatrix )
+        return false;
+
+    const MATRIX3x3D& drawn = *m_drawnWorldScreenMatrix;
+    const MATRIX3x3D& current = m_gal->GetWorldScreenMatrix();
+
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        for( int jj = 0; jj < 2; ++jj )
+        {
+            if( drawn.m_data[ii][jj] != current.m_data[ii][jj] )
+                return false;
+        }
+    }
+
+    // Only moving by whole pixels keeps the items drawn before aligned with the new ones
+    VECTOR2D delta( current.m_data[0][2] - drawn.m_data[0][2],
+                    current.m_data[1][2] - drawn.m_data[1][2] );
+    VECTOR2I pixels( KiROUND( delta.x ), KiROUND( delta.y ) );
+    VECTOR2I screenSize = m_gal->GetScreenPixelSize();
+
+    if( std::abs( delta.x - pixels.x ) > 0.01 || std::abs( delta.y - pixels.y ) > 0.01 )
+        return false;
+
+    if( pixels == VECTOR2I( 0, 0 ) || std::abs( pixels.x ) >= screenSize.x
+            || std::abs( pixels.y ) >= screenSize.y )
+    {
+        return false;
+    }
+
+    if( !m_gal->ScrollTargets( pixels ) )
+        return false;
+
+    // The uncovered bands along the edges of the screen
+    std::vector<BOX2D> bands;
+
+    if( pixels.y > 0 )
+        bands.emplace_back( VECTOR2D( 0, 0 ), VECTOR2D( screenSize.x, pixels.y ) );
+    else if( pixels.y < 0 )
+        bands.emplace_back( VECTOR2D( 0, screenSize.y + pixels.y ),
+                            VECTOR2D( screenSize.x, -pixels.y ) );
+
+    if( pixels.x > 0 )
+        bands.emplace_back( VECTOR2D( 0, 0 ), VECTOR2D( pixels.x, screenSize.y ) );
+    else if( pixels.x < 0 )
+        bands.emplace_back( VECTOR2D( screenSize.x + pixels.x, 0 ),
+                            VECTOR2D( -pixels.x, screenSize.y ) );
+
+    for( const BOX2D& band : bands )
+    {
+        BOX2D area( ToWorld( band.GetOrigin() ),
+                    ToWorld( band.GetEnd() ) - ToWorld( band.GetOrigin() ) );
+
+        area.Normalize();
+
+        // Antialiasing of the items next to the bands may spill into them
+        area.Inflate( ToWorld( 2.0 ) );
+        m_redrawAreas.emplace_back( area.GetPosition(), area.GetSize() );
+    }
+
+    return true;
+}
+
+
+void VIEW::ClearTargets()
+{
+    m_redrawAreas.clear();
+
+    if( IsTargetDirty( TARGET_CACHED ) || IsTargetDirty( TARGET_NONCACHED ) )
+    {
+        std::optional<BOX2I> dirtyArea = m_dirtyArea;
+        bool                 panned = m_panned;
+
+        // TARGET_CACHED and TARGET_NONCACHED have to be redrawn together, as they contain
+        // layers that rely on each other (eg. netnames are noncached, but tracks - are cached)
+        MarkDirty();
+        m_gal->ClearTarget( TARGET_OVERLAY );
+
+        // After panning, move the targets and only redraw the area left uncovered
+        bool scrolled = m_scrollRedraw && panned && scrollTargets();
+
+        // When only a few items changed, clear and redraw the targets around them only
+        if( !scrolled && m_partialRedraw && dirtyArea )
+        {
+            BOX2I visible = visibleArea();
+            BOX2I area = dirtyArea->Intersect( visible );
+
+            // Antialiasing may spill a little out of the bounding boxes
+            area.Inflate( KiROUND( ToWorld( 2.0 ) ) );
+
+            if( area.GetWidth() < visible.GetWidth() || area.GetHeight() < visible.GetHeight() )
+            {
+                BOX2D screenArea( ToScreen( area.GetOrigin() ),
+                                  ToScreen( area.GetEnd() ) - ToScreen( area.GetOrigin() ) );
+
+                screenArea.Normalize();
+
+                if( m_gal->SetTargetClip( BOX2I( screenArea.GetPosition(),
+                                                 screenArea.GetSize() ) ) )
+                {
+                    m_redrawAreas.push_back( area );
+                }
+            }
+        }
+
+        m_gal->ClearTarget( TARGET_NONCACHED );
+        m_gal->ClearTarget( TARGET_CACHED );
+    }
+    else if( IsTargetDirty( TARGET_OVERLAY ) )
+    {
+        m_gal->ClearTarget( TARGET_OVERLAY );
+    }
+}
+
+
+void VIEW::Redraw()
+{
+    TRACE_SCOPE( "VIEW::Redraw" );
+
+    PROF_TIMER totalRealTime;
+
+    m_redrawStatistics = REDRAW_STATISTICS();
+
+    BOX2I recti = visibleArea();
+
+    m_detailLevel = detailLevel();
+
     redrawRect( recti );
+    m_redrawAreas.clear();
+    m_drawnWorldScreenMatrix = m_gal->GetWorldScreenMatrix();
 
     // All targets were redrawn, so nothing is dirty
     MarkClean();
 
-#ifdef KICAD_GAL_PROFILE
     totalRealTime.Stop();
+    m_redrawStatistics.m_redrawTime = totalRealTime.msecs();
+
+#ifdef KICAD_GAL_PROFILE
     wxLogTrace( traceGalProfile, wxS( "VIEW::Redraw(): %.1f ms" ), totalRealTime.msecs() );
 #endif /* KICAD_GAL_PROFILE */
 }
@@ -1237,6 +1556,10 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
     int layers[VIEW_MAX_LAYERS], layers_count;
     aItem->ViewGetLayers( layers, layers_count );
 
+    // An item repainted without a geometry update may still have been moved
+    BOX2I area = aItem->viewPrivData()->m_bbox;
+    area.Merge( aItem->ViewBBox() );
+
     // Iterate through layers used by the item and recache it immediately
     for( int i = 0; i < layers_count; ++i )
     {
@@ -1248,10 +1571,12 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
                 updateItemGeometry( aItem, layerId );
             else if( aUpdateFlags & COLOR )
                 updateItemColor( aItem, layerId );
+            else if( aUpdateFlags & DETAIL )
+                updateItemDetail( aItem, layerId );
         }
 
         // Mark those layers as dirty, so the VIEW will be refreshed
-        MarkTargetDirty( m_layers[layerId].target );
+        markAreaDirty( m_layers[layerId].target, area );
     }
 
     aItem->viewPrivData()->clearUpdateFlags();
@@ -1289,6 +1614,8 @@ void VIEW::updateItemColor( VIEW_ITEM* aItem, int aLayer )
     // Change the color, only if it has group assigned
     if( group >= 0 )
         m_gal->ChangeGroupColor( group, color );
+
+    viewData->changeDetailGroupsColor( m_gal, aLayer, color );
 }
 
 
@@ -1312,6 +1639,8 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     if( group >= 0 )
         m_gal->DeleteGroup( group );
 
+    viewData->deleteDetailGroups( m_gal );
+
     group = m_gal->BeginGroup();
     viewData->setGroup( aLayer, group );
 
@@ -1322,18 +1651,124 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
 }
 
 
+void VIEW::updateItemDetail( VIEW_ITEM* aItem, int aLayer )
+{
+    VIEW_ITEM_DATA* viewData = aItem->viewPrivData();
+    wxCHECK( (unsigned) aLayer < m_layers.size(), /*void*/ );
+    wxCHECK( IsCached( aLayer ), /*void*/ );
+
+    int level = detailLevel();
+
+    if( !viewData || level == 0 || viewData->getDetailGroup( level, aLayer ) >= 0 )
+        return;
+
+    if( !m_painter->HasDetailLevels( aItem, aLayer ) )
+        return;
+
+    VIEW_LAYER& l = m_layers.at( aLayer );
+
+    m_gal->SetTarget( l.target );
+    m_gal->SetLayerDepth( l.renderingOrder );
+
+    int group = m_gal->BeginGroup();
+    viewData->setDetailGroup( level, aLayer, group );
+
+    // The group is only displayed at this level, with pixels at least this large
+    m_painter->SetDetailTolerance( detailTolerance( level ) );
+    m_gal->SetMinPixelSize( detailTolerance( level ) );
+
+    if( !m_painter->Draw( aItem, aLayer ) )
+        aItem->ViewDraw( aLayer, this ); // Alternative drawing method
+
+    m_painter->SetDetailTolerance( 0.0 );
+    m_gal->SetMinPixelSize( 0.0 );
+    m_gal->EndGroup();
+}
+
+
+int VIEW::detailLevel() const
+{
+    if( m_detailPixelSize <= 0.0 || !m_gal || m_gal->GetWorldScale() <= 0.0 )
+        return 0;
+
+    double pixelSize = 1.0 / m_gal->GetWorldScale();
+    int    level = 0;
+
+    for( double size = m_detailPixelSize; pixelSize > size && level < DETAIL_LEVELS - 1;
+         size *= DETAIL_LEVEL_RATIO )
+    {
+        level++;
+    }
+
+    return level;
+}
+
+
+double VIEW::detailTolerance( int aLevel ) const
+{
+    if( aLevel == 0 )
+        return 0.0;
+
+    // The smallest size of a pixel at this level, so that the error stays below one pixel
+    return m_detailPixelSize * std::pow( DETAIL_LEVEL_RATIO, aLevel - 1 );
+}
+
+
+void VIEW::SetDetailPixelSize( double aSize )
+{
+    if( aSize == m_detailPixelSize )
+        return;
+
+    m_detailPixelSize = aSize;
+
+    for( VIEW_ITEM* item : *m_allItems )
+    {
+        if( VIEW_ITEM_DATA* viewData = item->viewPrivData() )
+            viewData->deleteDetailGroups( m_gal );
+    }
+
+    MarkDirty();
+}
+
+
+void VIEW::prepareItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    // Below that, starting the tasks costs more than it saves
+    if( !m_painter || aItems.size() < 1000 )
+        return;
+
+    thread_pool& tp = GetKiCadThreadPool();
+
+    tp.push_loop( aItems.size(),
+            [&]( const int a, const int b )
+            {
+                for( int ii = a; ii < b; ++ii )
+                    m_painter->PrepareDraw( aItems[ii] );
+            } );
+    tp.wait_for_tasks();
+}
+
+
 void VIEW::updateBbox( VIEW_ITEM* aItem )
 {
-    int layers[VIEW_MAX_LAYERS], layers_count;
+    VIEW_ITEM_DATA* viewData = aItem->viewPrivData();
+    int             layers[VIEW_MAX_LAYERS], layers_count;
+
+    // Both the previous and the new area of the item need redrawing
+    BOX2I prevBBox = viewData->m_bbox;
+    BOX2I area = prevBBox;
+
+    viewData->m_bbox = aItem->ViewBBox();
+    area.Merge( viewData->m_bbox );
 
     aItem->ViewGetLayers( layers, layers_count );
 
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Remove( aItem );
+        l.items->Remove( aItem, &prevBBox );
         l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        markAreaDirty( l.target, area );
     }
 }
 
@@ -1348,12 +1783,13 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
 
     // Remove the item from previous layer set
     viewData->getLayers( layers, layers_count );
+    viewData->deleteDetailGroups( m_gal );
 
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Remove( aItem );
-        MarkTargetDirty( l.target );
+        l.items->Remove( aItem, &viewData->m_bbox );
+        markAreaDirty( l.target, viewData->m_bbox );
 
         if( IsCached( l.id ) )
         {
@@ -1371,12 +1807,13 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
     // Add the item to new layer set
     aItem->ViewGetLayers( layers, layers_count );
     viewData->saveLayers( layers, layers_count );
+    viewData->m_bbox = aItem->ViewBBox();
 
     for( int i = 0; i < layers_count; i++ )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
         l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        markAreaDirty( l.target, viewData->m_bbox );
     }
 }
 
@@ -1404,6 +1841,10 @@ void VIEW::RecacheAllItems()
 
     r.SetMaximum();
 
+    // The GAL can only be fed from one thread, but the geometry behind the GAL calls can be
+    // built beforehand on all of them
+    prepareItems( *m_allItems );
+
     for( const VIEW_LAYER& l : m_layers )
     {
         if( IsCached( l.id ) )
@@ -1420,8 +1861,9 @@ void VIEW::UpdateItems()
     if( !m_gal->IsVisible() || !m_gal->IsInitialized() )
         return;
 
-    unsigned int cntGeomUpdate = 0;
-    bool         anyUpdated = false;
+    unsigned int            cntGeomUpdate = 0;
+    bool                    anyUpdated = false;
+    std::vector<VIEW_ITEM*> redrawnItems;
 
     for( VIEW_ITEM* item : *m_allItems )
     {
@@ -1438,6 +1880,9 @@ void VIEW::UpdateItems()
             {
                 cntGeomUpdate++;
             }
+
+            if( vpd->m_requiredUpdate & ( INITIAL_ADD | GEOMETRY | LAYERS | REPAINT ) )
+                redrawnItems.push_back( item );
         }
     }
 
@@ -1465,6 +1910,7 @@ void VIEW::UpdateItems()
         {
             item->ViewGetLayers( layers, layers_count );
             item->viewPrivData()->saveLayers( layers, layers_count );
+            item->viewPrivData()->m_bbox = item->ViewBBox();
 
             for( int i = 0; i < layers_count; ++i )
             {
@@ -1481,6 +1927,8 @@ void VIEW::UpdateItems()
 
     if( anyUpdated )
     {
+        prepareItems( redrawnItems );
+
         GAL_UPDATE_CONTEXT ctx( m_gal );
 
         for( VIEW_ITEM* item : *m_allItems.get() )
@@ -469,6 +469,15 @@ void mpFXY::Plot( wxDC& dc, mpWindow& w )
     maxDrawY = y;
     minDrawY = y;
     // drawnPoints = 0;
+
+    // Let the layer skip the points which don't change the drawing
+    std::vector<double> columnEdges;
+    columnEdges.reserve( endPx - startPx + 2 );
+
+    for( wxCoord px = startPx; px <= endPx + 1; ++px )
+        columnEdges.push_back( m_scaleX->TransformFromPlot( w.p2x( px ) ) );
+
+    SetSweepWindow( columnEdges );
     Rewind();
 
     dc.SetClippingRegion( startPx, minYpx, endPx - startPx + 1, maxYpx - minYpx + 1 );
@@ -653,6 +662,8 @@ void mpFXY::Plot( wxDC& dc, mpWindow& w )
         }
     }
 
+    SetSweepWindow( {} );
+
     if( !m_name.IsEmpty() && m_showName )
     {
         dc.SetFont( m_font );
@@ -2408,6 +2419,8 @@ mpFXYVector::mpFXYVector( const wxString& name, int flags ) :
     m_minY  = -1;
     m_maxY  = 1;
     m_type  = mpLAYER_PLOT;
+    m_lodValid = false;
+    m_sweepActive = false;
 }
 
 
@@ -2467,6 +2480,16 @@ size_t mpFXYVector::GetCount() const
 
 bool mpFXYVector::GetNextXY( double& x, double& y )
 {
+    if( m_sweepActive )
+    {
+        if( m_index >= m_sweep.size() )
+            return false;
+
+        x = m_xs[m_sweep[m_index]];
+        y = m_ys[m_sweep[m_index++]];
+        return true;
+    }
+
     if( m_index >= m_xs.size() )
     {
         return false;
@@ -2480,10 +2503,172 @@ bool mpFXYVector::GetNextXY( double& x, double& y )
 }
 
 
+void mpFXYVector::SetSweepWindow( const std::vector<double>& aColumnEdges )
+{
+    m_sweep.clear();
+    m_sweepActive = false;
+    m_index = 0;
+
+    if( aColumnEdges.size() < 2 || m_xs.size() < LOD_BLOCK * 2 )
+        return;
+
+    if( !m_lodValid )
+        buildLod();
+
+    // Unsorted X values can't be searched nor decimated
+    if( m_lod.empty() || !std::is_sorted( aColumnEdges.begin(), aColumnEdges.end() ) )
+        return;
+
+    auto indexOf =
+            [&]( double aX ) -> size_t
+            {
+                return std::lower_bound( m_xs.begin(), m_xs.end(), aX ) - m_xs.begin();
+            };
+
+    size_t columns = aColumnEdges.size() - 1;
+    size_t first = indexOf( aColumnEdges.front() );
+    size_t last = indexOf( aColumnEdges.back() );
+
+    // Keep a point on each side of the view, the lines to them cross its edges
+    size_t begin = first > 0 ? first - 1 : 0;
+    size_t end = std::min( last + 1, m_xs.size() );
+
+    m_sweepActive = true;
+
+    // Decimating only pays off with many points per column
+    if( end - begin <= columns * 4 )
+    {
+        for( size_t ii = begin; ii < end; ++ii )
+            m_sweep.push_back( ii );
+
+        return;
+    }
+
+    m_sweep.reserve( columns * 4 + 2 );
+
+    if( begin < first )
+        m_sweep.push_back( begin );
+
+    size_t columnStart = first;
+
+    for( size_t column = 0; column < columns; ++column )
+    {
+        size_t columnEnd = column + 1 < columns ? indexOf( aColumnEdges[column + 1] ) : last;
+
+        if( columnEnd > columnStart )
+        {
+            size_t lo, hi;
+
+            findMinMax( columnStart, columnEnd, lo, hi );
+
+            m_sweep.push_back( columnStart );
+
+            for( size_t ii : { std::min( lo, hi ), std::max( lo, hi ), columnEnd - 1 } )
+            {
+                if( ii != m_sweep.back() )
+                    m_sweep.push_back( ii );
+            }
+        }
+
+        columnStart = columnEnd;
+    }
+
+    if( end > last )
+        m_sweep.push_back( last );
+}
+
+
+void mpFXYVector::findMinMax( size_t aFirst, size_t aLast, size_t& aMin, size_t& aMax ) const
+{
+    aMin = aFirst;
+    aMax = aFirst;
+
+    auto merge =
+            [&]( size_t aLo, size_t aHi )
+            {
+                if( m_ys[aLo] < m_ys[aMin] )
+                    aMin = aLo;
+
+                if( m_ys[aHi] > m_ys[aMax] )
+                    aMax = aHi;
+            };
+
+    size_t ii = aFirst;
+
+    while( ii < aLast )
+    {
+        if( ii % LOD_BLOCK != 0 || ii + LOD_BLOCK > aLast )
+        {
+            merge( ii, ii );
+            ++ii;
+            continue;
+        }
+
+        // Use the largest block starting here which fits in the range
+        size_t level = 0;
+
+        while( level + 1 < m_lod.size() && ii % ( LOD_BLOCK << ( level + 1 ) ) == 0
+               && ii + ( LOD_BLOCK << ( level + 1 ) ) <= aLast )
+        {
+            level++;
+        }
+
+        const std::pair<size_t, size_t>& block = m_lod[level][ii / ( LOD_BLOCK << level )];
+
+        merge( block.first, block.second );
+        ii += LOD_BLOCK << level;
+    }
+}
+
+
+void mpFXYVector::buildLod()
+{
+    m_lod.clear();
+    m_lodValid = true;
+
+    if( !std::is_sorted( m_xs.begin(), m_xs.end() ) )
+        return;
+
+    for( size_t blockSize = LOD_BLOCK; blockSize * 2 <= m_ys.size(); blockSize *= 2 )
+    {
+        std::vector<std::pair<size_t, size_t>> level;
+        level.reserve( m_ys.size() / blockSize );
+
+        if( m_lod.empty() )
+        {
+            for( size_t start = 0; start + blockSize <= m_ys.size(); start += blockSize )
+            {
+                auto [ lo, hi ] = std::minmax_element( m_ys.begin() + start,
+                                                       m_ys.begin() + start + blockSize );
+                level.emplace_back( lo - m_ys.begin(), hi - m_ys.begin() );
+            }
+        }
+        else
+        {
+            // Each block of a level is made of two blocks of the previous one
+            const std::vector<std::pair<size_t, size_t>>& finer = m_lod.back();
+
+            for( size_t ii = 0; ii + 1 < finer.size(); ii += 2 )
+            {
+                const std::pair<size_t, size_t>& a = finer[ii];
+                const std::pair<size_t, size_t>& b = finer[ii + 1];
+
+                level.emplace_back( m_ys[b.first] < m_ys[a.first] ? b.first : a.first,
+                                    m_ys[b.second] > m_ys[a.second] ? b.second : a.second );
+            }
+        }
+
+        m_lod.push_back( std::move( level ) );
+    }
+}
+
+
 void mpFXYVector::Clear()
 {
     m_xs.clear();
     m_ys.clear();
+    m_lod.clear();
+    m_lodValid = false;
 }
 
 
@@ -2496,6 +2681,7 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
     // Copy the data:
     m_xs    = xs;
     m_ys    = ys;
+    m_lodValid = false;
 
     // Update internal variables for the bounding box.
     if( xs.size() > 0 )
@@ -2533,6 +2719,41 @@ void mpFXYVector::SetData( const std::vector<double>& xs, const std::vector<doub
 }
 
 
+void mpFXYVector::AppendData( const std::vector<double>& xs, const std::vector<double>& ys )
+{
+    if( xs.size() != ys.size() )
+        return;
+
+    if( m_xs.empty() )
+    {
+        SetData( xs, ys );
+        return;
+    }
+
+    m_xs.insert( m_xs.end(), xs.begin(), xs.end() );
+    m_ys.insert( m_ys.end(), ys.begin(), ys.end() );
+    m_lodValid = false;
+
+    for( const double x : xs )
+    {
+        if( x < m_minX )
+            m_minX = x;
+
+        if( x > m_maxX )
+            m_maxX = x;
+    }
+
+    for( const double y : ys )
+    {
+        if( y < m_minY )
+            m_minY = y;
+
+        if( y > m_maxY )
+            m_maxY = y;
+    }
+}
+
+
 void mpFXY::SetScale( mpScaleBase* scaleX, mpScaleBase* scaleY )
 {
     m_scaleX    = scaleX;
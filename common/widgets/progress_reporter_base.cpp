@@ -2,7 +2,7 @@
  * This program source code file is part of KiCad, a free EDA CAD application.
  *
  * Copyright (C) 2017 CERN
- * Copyright (C) 2021-2022 KiCad Developers, see AUTHORS.txt for contributors.
+ * Copyright (C) 2021-2024 KiCad Developers, see AUTHORS.txt for contributors.
  *
  * Author: Tomasz Wlostowski <tomasz.wlostowski@cern.ch>
  *
@@ -28,6 +28,19 @@
 #include <thread>
 #include <widgets/progress_reporter_base.h>
 
+
+/**
+ * @return the index of the pending progress counter used by the calling thread.
+ */
+static size_t progressSlot()
+{
+    static std::atomic<size_t> s_nextSlot( 0 );
+    thread_local size_t        slot = s_nextSlot.fetch_add( 1 );
+
+    return slot;
+}
+
+
 PROGRESS_REPORTER_BASE::PROGRESS_REPORTER_BASE( int aNumPhases ) :
     PROGRESS_REPORTER(),
     m_phase( 0 ),
@@ -43,6 +56,7 @@ PROGRESS_REPORTER_BASE::PROGRESS_REPORTER_BASE( int aNumPhases ) :
 void PROGRESS_REPORTER_BASE::BeginPhase( int aPhase )
 {
     m_phase.store( aPhase );
+    discardProgress();
     m_progress.store( 0 );
 }
 
@@ -50,6 +64,7 @@ void PROGRESS_REPORTER_BASE::BeginPhase( int aPhase )
 void PROGRESS_REPORTER_BASE::AdvancePhase()
 {
     m_phase.fetch_add( 1 );
+    discardProgress();
     m_progress.store( 0 );
 }
 
@@ -79,13 +94,37 @@ void PROGRESS_REPORTER_BASE::SetMaxProgress( int aMaxProgress )
 void PROGRESS_REPORTER_BASE::SetCurrentProgress( double aProgress )
 {
     m_maxProgress.store( 1000 );
+    discardProgress();
     m_progress.store( (int) ( aProgress * 1000.0 ) );
 }
 
 
 void PROGRESS_REPORTER_BASE::AdvanceProgress()
 {
-    m_progress.fetch_add( 1 );
+    m_pendingProgress[progressSlot() % PROGRESS_SLOTS].m_count.fetch_add( 1,
+                                                                         std::memory_order_relaxed );
+}
+
+
+void PROGRESS_REPORTER_BASE::mergeProgress()
+{
+    int pending = 0;
+
+    for( PENDING_PROGRESS& slot : m_pendingProgress )
+    {
+        if( slot.m_count.load( std::memory_order_relaxed ) )
+            pending += slot.m_count.exchange( 0, std::memory_order_relaxed );
+    }
+
+    if( pending )
+        m_progress.fetch_add( pending );
+}
+
+
+void PROGRESS_REPORTER_BASE::discardProgress()
+{
+    for( PENDING_PROGRESS& slot : m_pendingProgress )
+        slot.m_count.store( 0, std::memory_order_relaxed );
 }
 
 
@@ -103,8 +142,13 @@ void PROGRESS_REPORTER_BASE::AddPhases( int aNumPhases )
 
 int PROGRESS_REPORTER_BASE::CurrentProgress() const
 {
+    int progress = m_progress.load();
+
+    for( const PENDING_PROGRESS& slot : m_pendingProgress )
+        progress += slot.m_count.load( std::memory_order_relaxed );
+
     double current = ( 1.0 / (double) m_numPhases ) *
-                     ( (double) m_phase + ( (double) m_progress.load() / (double) m_maxProgress ) );
+                     ( (double) m_phase + ( (double) progress / (double) m_maxProgress ) );
 
     return (int)( current * 1000 );
 }
@@ -112,6 +156,8 @@ int PROGRESS_REPORTER_BASE::CurrentProgress() const
 
 bool PROGRESS_REPORTER_BASE::KeepRefreshing( bool aWait )
 {
+    mergeProgress();
+
     if( aWait )
     {
         while( m_progress.load() < m_maxProgress && m_maxProgress > 0 )
@@ -123,6 +169,7 @@ bool PROGRESS_REPORTER_BASE::KeepRefreshing( bool aWait )
             }
 
             wxMilliSleep( 33 /* 30 FPS refresh rate */ );
+            mergeProgress();
         }
 
         return true;
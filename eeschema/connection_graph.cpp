@@ -595,6 +595,8 @@ void CONNECTION_GRAPH::Reset()
     m_net_name_to_subgraphs_map.clear();
     m_item_to_subgraph_map.clear();
     m_local_label_cache.clear();
+    m_hier_port_cache.clear();
+    m_hier_pin_cache.clear();
     m_global_label_cache.clear();
     m_last_net_code = 1;
     m_last_bus_code = 1;
@@ -710,8 +712,127 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
         aSubgraph->getAllConnectedItems( retvals, subgraphs );
     };
 
+    auto traverse_cached =
+            [&]( const std::vector<const CONNECTION_SUBGRAPH*>& aCached )
+            {
+                for( const CONNECTION_SUBGRAPH* sg : aCached )
+                    traverse_subgraph( const_cast<CONNECTION_SUBGRAPH*>( sg ) );
+            };
+
+    auto traverse_global =
+            [&]( const wxString& aName )
+            {
+                auto it = m_global_label_cache.find( aName );
+
+                if( it != m_global_label_cache.end() )
+                    traverse_cached( it->second );
+            };
+
+    auto traverse_local =
+            [&]( const SCH_SHEET_PATH& aSheet, const wxString& aName )
+            {
+                auto it = m_local_label_cache.find( std::make_pair( aSheet, aName ) );
+
+                if( it != m_local_label_cache.end() )
+                    traverse_cached( it->second );
+            };
+
+    auto traverse_item =
+            [&]( SCH_ITEM* aItem )
+            {
+                auto it = m_item_to_subgraph_map.find( aItem );
+
+                if( it != m_item_to_subgraph_map.end() )
+                    traverse_subgraph( it->second );
+            };
+
+    // Labels, sheet pins and power pins also connect by name to subgraphs they share no item
+    // with.  The subgraphs they were connected to are found through their own subgraph, but the
+    // ones with the name they have now (which may be new items altogether) have to be looked up.
+    auto traverse_named =
+            [&]( SCH_ITEM* aItem )
+            {
+                SCH_ITEM*   parent = aItem->Type() == SCH_PIN_T || aItem->Type() == SCH_SHEET_PIN_T
+                                            ? static_cast<SCH_ITEM*>( aItem->GetParent() )
+                                            : aItem;
+                SCH_SCREEN* screen = parent ? dynamic_cast<SCH_SCREEN*>( parent->GetParent() )
+                                            : nullptr;
+
+                if( !screen )
+                    return;
+
+                for( const SCH_SHEET_PATH& sheet : screen->GetClientSheetPaths() )
+                {
+                    switch( aItem->Type() )
+                    {
+                    case SCH_PIN_T:
+                    {
+                        SCH_PIN* pin = static_cast<SCH_PIN*>( aItem );
+
+                        if( pin->IsGlobalPower() )
+                            traverse_global( pin->GetDefaultNetName( sheet ) );
+
+                        break;
+                    }
+
+                    case SCH_GLOBAL_LABEL_T:
+                    {
+                        SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( aItem );
+
+                        traverse_global( EscapeString( label->GetShownText( &sheet, false ),
+                                                       CTX_NETNAME ) );
+                        break;
+                    }
+
+                    case SCH_LABEL_T:
+                    case SCH_HIER_LABEL_T:
+                    {
+                        SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( aItem );
+
+                        traverse_local( sheet, EscapeString( label->GetShownText( &sheet, false ),
+                                                             CTX_NETNAME ) );
+
+                        // A hierarchical label may now match another pin of its sheet
+                        if( aItem->Type() == SCH_HIER_LABEL_T && sheet.size() > 1 )
+                        {
+                            for( SCH_SHEET_PIN* sheetPin : sheet.Last()->GetPins() )
+                                traverse_item( sheetPin );
+                        }
+
+                        break;
+                    }
+
+                    case SCH_SHEET_PIN_T:
+                    {
+                        SCH_SHEET_PIN* sheetPin = static_cast<SCH_SHEET_PIN*>( aItem );
+                        SCH_SHEET_PATH child = sheet;
+
+                        child.push_back( sheetPin->GetParent() );
+
+                        traverse_local( child, EscapeString( sheetPin->GetShownText( &child,
+                                                                                     false ),
+                                                             CTX_NETNAME ) );
+                        break;
+                    }
+
+                    default:
+                        break;
+                    }
+                }
+            };
+
     for( SCH_ITEM* item : aItems )
     {
+        if( item->Type() == SCH_SYMBOL_T )
+        {
+            for( SCH_PIN* pin : static_cast<SCH_SYMBOL*>( item )->GetPins() )
+                traverse_named( pin );
+        }
+        else
+        {
+            traverse_named( item );
+        }
+
         auto it = m_item_to_subgraph_map.find( item );
 
         if( it == m_item_to_subgraph_map.end() )
@@ -732,10 +853,51 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
             for( CONNECTION_SUBGRAPH* bus_sg : bus_it.second )
                 traverse_subgraph( bus_sg );
         }
-
-        alg::delete_matching( m_items, item );
     }
 
+    // The caches of a net are replaced as a whole when the new graph is merged, so every
+    // subgraph of the nets which are recalculated has to be recalculated with them.  Only the
+    // nets whose drivers may have changed are, the rest of the graph is kept as it is.
+    std::set<wxString> visited_names;
+    size_t             count;
+
+    do
+    {
+        count = subgraphs.size();
+
+        std::vector<CONNECTION_SUBGRAPH*> found( subgraphs.begin(), subgraphs.end() );
+
+        for( CONNECTION_SUBGRAPH* sg : found )
+        {
+            if( !sg->m_driver_connection )
+                continue;
+
+            wxString name = sg->m_driver_connection->Name();
+
+            if( name.IsEmpty() || !visited_names.insert( name ).second )
+                continue;
+
+            auto it = m_net_name_to_subgraphs_map.find( name );
+
+            if( it == m_net_name_to_subgraphs_map.end() )
+                continue;
+
+            for( CONNECTION_SUBGRAPH* other : it->second )
+                traverse_subgraph( other );
+        }
+    } while( subgraphs.size() != count );
+
+    std::set<SCH_ITEM*> extracted( aItems );
+
+    for( const auto& [ sheet, item ] : retvals )
+        extracted.insert( item );
+
+    alg::delete_if( m_items,
+                    [&]( SCH_ITEM* aItem )
+                    {
+                        return extracted.count( aItem ) > 0;
+                    } );
+
     removeSubgraphs( subgraphs );
 
     return retvals;
@@ -744,15 +906,8 @@ std::set<std::pair<SCH_SHEET_PATH, SCH_ITEM*>> CONNECTION_GRAPH::ExtractAffected
 
 void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgraphs )
 {
-    std::sort( m_driver_subgraphs.begin(), m_driver_subgraphs.end() );
-    std::sort( m_subgraphs.begin(), m_subgraphs.end() );
     std::set<int> codes_to_remove;
 
-    for( auto& el : m_sheet_to_subgraphs_map )
-    {
-        std::sort( el.second.begin(), el.second.end() );
-    }
-
     for( CONNECTION_SUBGRAPH* sg : aSubgraphs )
     {
         for( auto& it : sg->m_bus_neighbors )
@@ -792,86 +947,77 @@ void CONNECTION_GRAPH::removeSubgraphs( std::set<CONNECTION_SUBGRAPH*>& aSubgrap
                     parent->m_bus_neighbors.erase( it.first );
             }
         }
+    }
 
-        {
-            auto it = std::lower_bound( m_driver_subgraphs.begin(), m_driver_subgraphs.end(), sg );
-
-            while( it != m_driver_subgraphs.end() && *it == sg )
-                it = m_driver_subgraphs.erase( it );
-        }
-
-        {
-            auto it = std::lower_bound( m_subgraphs.begin(), m_subgraphs.end(), sg );
-
-            while( it != m_subgraphs.end() && *it == sg )
-                it = m_subgraphs.erase( it );
-        }
-
-        for( auto& el : m_sheet_to_subgraphs_map )
-        {
-            auto it = std::lower_bound( el.second.begin(), el.second.end(), sg );
-
-            while( it != el.second.end() && *it == sg )
-                it = el.second.erase( it );
-        }
+    // Each container is walked once for all the removed subgraphs, so that extracting a few
+    // nets doesn't cost a pass over the whole graph per subgraph
+    auto removed =
+            [&aSubgraphs]( const CONNECTION_SUBGRAPH* aSubgraph ) -> bool
+            {
+                return aSubgraphs.count( const_cast<CONNECTION_SUBGRAPH*>( aSubgraph ) ) > 0;
+            };
 
-        auto remove_sg = [sg]( auto it ) -> bool
-                        {
-                            for( const CONNECTION_SUBGRAPH* test_sg : it->second )
-                            {
-                                if( sg == test_sg )
-                                    return true;
-                            }
+    auto remove_sg =
+            [&removed]( auto it ) -> bool
+            {
+                for( const CONNECTION_SUBGRAPH* test_sg : it->second )
+                {
+                    if( removed( test_sg ) )
+                        return true;
+                }
 
-                            return false;
-                        };
+                return false;
+            };
 
-        for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_global_label_cache.erase( it );
-            else
-                ++it;
-        }
+    alg::delete_if( m_driver_subgraphs, removed );
+    alg::delete_if( m_subgraphs, removed );
 
-        for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_local_label_cache.erase( it );
-            else
-                ++it;
-        }
+    for( auto& el : m_sheet_to_subgraphs_map )
+        alg::delete_if( el.second, removed );
 
-        for( auto it = m_net_code_to_subgraphs_map.begin();
-             it != m_net_code_to_subgraphs_map.end(); )
-        {
-            if( remove_sg( it ) )
-            {
-                codes_to_remove.insert( it->first.Netcode );
-                it = m_net_code_to_subgraphs_map.erase( it );
-            }
-            else
-                ++it;
-        }
+    for( auto it = m_global_label_cache.begin(); it != m_global_label_cache.end(); )
+    {
+        if( remove_sg( it ) )
+            it = m_global_label_cache.erase( it );
+        else
+            ++it;
+    }
 
-        for( auto it = m_net_name_to_subgraphs_map.begin();
-             it != m_net_name_to_subgraphs_map.end(); )
-        {
-            if( remove_sg( it ) )
-                it = m_net_name_to_subgraphs_map.erase( it );
-            else
-                ++it;
-        }
+    for( auto it = m_local_label_cache.begin(); it != m_local_label_cache.end(); )
+    {
+        if( remove_sg( it ) )
+            it = m_local_label_cache.erase( it );
+        else
+            ++it;
+    }
 
-        for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+    for( auto it = m_net_code_to_subgraphs_map.begin();
+         it != m_net_code_to_subgraphs_map.end(); )
+    {
+        if( remove_sg( it ) )
         {
-            if( it->second == sg )
-                it = m_item_to_subgraph_map.erase( it );
-            else
-                ++it;
+            codes_to_remove.insert( it->first.Netcode );
+            it = m_net_code_to_subgraphs_map.erase( it );
         }
+        else
+            ++it;
+    }
 
+    for( auto it = m_net_name_to_subgraphs_map.begin();
+         it != m_net_name_to_subgraphs_map.end(); )
+    {
+        if( remove_sg( it ) )
+            it = m_net_name_to_subgraphs_map.erase( it );
+        else
+            ++it;
+    }
 
+    for( auto it = m_item_to_subgraph_map.begin(); it != m_item_to_subgraph_map.end(); )
+    {
+        if( removed( it->second ) )
+            it = m_item_to_subgraph_map.erase( it );
+        else
+            ++it;
     }
 
     for( auto it = m_net_name_to_code_map.begin(); it != m_net_name_to_code_map.end(); )
@@ -1391,7 +1537,7 @@ void CONNECTION_GRAPH::generateBusAliasMembers()
                 new_sg->m_strong_driver = true;
 
                 /// Need to figure out why these sgs are not getting connected to their bus parents
-                NET_NAME_CODE_CACHE_KEY key = { new_sg->GetNetName(), code };
+                NET_NAME_CODE_CACHE_KEY key = { INTERNED_STRING( new_sg->GetNetName() ), code };
                 m_net_code_to_subgraphs_map[ key ].push_back( new_sg );
                 m_net_name_to_subgraphs_map[ name ].push_back( new_sg );
                 m_subgraphs.push_back( new_sg );
@@ -1460,7 +1606,7 @@ void CONNECTION_GRAPH::generateGlobalPowerPinSubGraphs()
             subgraph->AddItem( pin );
             subgraph->ResolveDrivers();
 
-            NET_NAME_CODE_CACHE_KEY key = { subgraph->GetNetName(), code };
+            NET_NAME_CODE_CACHE_KEY key = { INTERNED_STRING( subgraph->GetNetName() ), code };
             m_net_code_to_subgraphs_map[ key ].push_back( subgraph );
             m_subgraphs.push_back( subgraph );
             m_driver_subgraphs.push_back( subgraph );
@@ -1902,6 +2048,56 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
             });
     tp.wait_for_tasks();
 
+    // Resolving the names of the hierarchical links is the expensive part of propagation and
+    // only depends on each subgraph, so it is done up front on all threads.  Propagation itself
+    // stays sequential so that net codes are assigned in the same order on every run.
+    tp.push_loop( m_driver_subgraphs.size(),
+            [&]( const int a, const int b)
+            {
+                for( int ii = a; ii < b; ++ii )
+                {
+                    CONNECTION_SUBGRAPH* subgraph = m_driver_subgraphs[ii];
+
+                    for( SCH_SHEET_PIN* pin : subgraph->m_hier_pins )
+                        subgraph->GetNameForDriver( pin );
+
+                    for( SCH_HIERLABEL* label : subgraph->m_hier_ports )
+                        subgraph->GetNameForDriver( label );
+                }
+            });
+    tp.wait_for_tasks();
+
+    // Index the hierarchical links by name, so that finding the other end of a link doesn't
+    // compare against every subgraph of the sheet.  The order of m_driver_subgraphs is kept, so
+    // propagation visits candidates in the same order as through m_sheet_to_subgraphs_map.
+    m_hier_port_cache.clear();
+    m_hier_pin_cache.clear();
+
+    for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
+    {
+        for( SCH_HIERLABEL* label : subgraph->m_hier_ports )
+        {
+            std::vector<CONNECTION_SUBGRAPH*>& candidates =
+                    m_hier_port_cache[std::make_pair( subgraph->m_sheet,
+                                                      subgraph->GetNameForDriver( label ) )];
+
+            if( candidates.empty() || candidates.back() != subgraph )
+                candidates.push_back( subgraph );
+        }
+
+        for( SCH_SHEET_PIN* pin : subgraph->m_hier_pins )
+        {
+            SCH_SHEET_PATH path = subgraph->m_sheet;
+            path.push_back( pin->GetParent() );
+
+            std::vector<CONNECTION_SUBGRAPH*>& candidates =
+                    m_hier_pin_cache[std::make_pair( path, subgraph->GetNameForDriver( pin ) )];
+
+            if( candidates.empty() || candidates.back() != subgraph )
+                candidates.push_back( subgraph );
+        }
+    }
+
     // Next time through the subgraphs, we do some post-processing to handle things like
     // connecting bus members to their neighboring subgraphs, and then propagate connections
     // through the hierarchy
@@ -1971,6 +2167,9 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
             propagateToNeighbors( subgraph, true );
     }
 
+    m_hier_port_cache.clear();
+    m_hier_pin_cache.clear();
+
     // Handle buses that have been linked together somewhere by member (net) connections.
     // This feels a bit hacky, perhaps this algorithm should be revisited in the future.
 
@@ -2111,7 +2310,7 @@ void CONNECTION_GRAPH::buildConnectionGraph( std::function<void( SCH_ITEM* )>* a
 
     for( CONNECTION_SUBGRAPH* subgraph : m_driver_subgraphs )
     {
-        NET_NAME_CODE_CACHE_KEY key = { subgraph->GetNetName(),
+        NET_NAME_CODE_CACHE_KEY key = { INTERNED_STRING( subgraph->GetNetName() ),
                                         subgraph->m_driver_connection->NetCode() };
         m_net_code_to_subgraphs_map[ key ].push_back( subgraph );
 
@@ -2258,83 +2457,51 @@ void CONNECTION_GRAPH::propagateToNeighbors( CONNECTION_SUBGRAPH* aSubgraph, boo
             SCH_SHEET_PATH path = aParent->m_sheet;
             path.push_back( pin->GetParent() );
 
-            auto it = m_sheet_to_subgraphs_map.find( path );
+            auto it = m_hier_port_cache.find( std::make_pair( path,
+                                                              aParent->GetNameForDriver( pin ) ) );
 
-            if( it == m_sheet_to_subgraphs_map.end() )
+            if( it == m_hier_port_cache.end() )
                 continue;
 
             for( CONNECTION_SUBGRAPH* candidate : it->second )
             {
-                if( !candidate->m_strong_driver
-                    || candidate->m_hier_ports.empty()
-                    || visited.count( candidate ) )
-                {
+                if( !candidate->m_strong_driver || visited.count( candidate ) )
                     continue;
-                }
 
-                for( SCH_HIERLABEL* label : candidate->m_hier_ports )
-                {
-                    if( candidate->GetNameForDriver( label ) == aParent->GetNameForDriver( pin ) )
-                    {
-                        wxLogTrace( ConnTrace, wxS( "%lu: found child %lu (%s)" ), aParent->m_code,
-                                    candidate->m_code, candidate->m_driver_connection->Name() );
+                wxLogTrace( ConnTrace, wxS( "%lu: found child %lu (%s)" ), aParent->m_code,
+                            candidate->m_code, candidate->m_driver_connection->Name() );
 
-                        candidate->m_hier_parent = aParent;
-                        aParent->m_hier_children.insert( candidate );
+                candidate->m_hier_parent = aParent;
+                aParent->m_hier_children.insert( candidate );
 
-                        wxASSERT( candidate->m_graph == aParent->m_graph );
+                wxASSERT( candidate->m_graph == aParent->m_graph );
 
-                        search_list.push_back( candidate );
-                        break;
-                    }
-                }
+                search_list.push_back( candidate );
             }
         }
 
         for( SCH_HIERLABEL* label : aParent->m_hier_ports )
         {
-            SCH_SHEET_PATH path = aParent->m_sheet;
-            path.pop_back();
-
-            auto it = m_sheet_to_subgraphs_map.find( path );
+            auto it = m_hier_pin_cache.find( std::make_pair( aParent->m_sheet,
+                                                             aParent->GetNameForDriver( label ) ) );
 
-            if( it == m_sheet_to_subgraphs_map.end() )
+            if( it == m_hier_pin_cache.end() )
                 continue;
 
             for( CONNECTION_SUBGRAPH* candidate : it->second )
             {
-                if( candidate->m_hier_pins.empty()
-                    || visited.count( candidate )
+                if( visited.count( candidate )
                     || candidate->m_driver_connection->Type() != aParent->m_driver_connection->Type() )
                 {
                     continue;
                 }
 
-                const KIID& last_parent_uuid = aParent->m_sheet.Last()->m_Uuid;
+                wxLogTrace( ConnTrace, wxS( "%lu: found additional parent %lu (%s)" ),
+                            aParent->m_code, candidate->m_code,
+                            candidate->m_driver_connection->Name() );
 
-                for( SCH_SHEET_PIN* pin : candidate->m_hier_pins )
-                {
-                    // If the last sheet UUIDs won't match, no need to check the full path
-                    if( pin->GetParent()->m_Uuid != last_parent_uuid )
-                        continue;
-
-                    SCH_SHEET_PATH pin_path = path;
-                    pin_path.push_back( pin->GetParent() );
-
-                    if( pin_path != aParent->m_sheet )
-                        continue;
-
-                    if( aParent->GetNameForDriver( label ) == candidate->GetNameForDriver( pin ) )
-                    {
-                        wxLogTrace( ConnTrace, wxS( "%lu: found additional parent %lu (%s)" ),
-                                    aParent->m_code, candidate->m_code,
-                                    candidate->m_driver_connection->Name() );
-
-                        aParent->m_hier_children.insert( candidate );
-                        search_list.push_back( candidate );
-                        break;
-                    }
-                }
+                aParent->m_hier_children.insert( candidate );
+                search_list.push_back( candidate );
             }
         }
     };
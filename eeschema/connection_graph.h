@@ -26,6 +26,7 @@
 #include <vector>
 
 #include <erc_settings.h>
+#include <interned_string.h>
 #include <sch_connection.h>
 #include <sch_item.h>
 #include <wx/treectrl.h>
@@ -305,8 +306,8 @@ private:
 
 struct NET_NAME_CODE_CACHE_KEY
 {
-    wxString  Name;
-    int       Netcode;
+    INTERNED_STRING Name;
+    int             Netcode;
 
     bool operator==(const NET_NAME_CODE_CACHE_KEY& other) const
     {
@@ -323,7 +324,7 @@ namespace std
         {
             const std::size_t prime = 19937;
 
-            return hash<wxString>()( k.Name ) ^ ( hash<int>()( k.Netcode ) * prime );
+            return k.Name.Hash() ^ ( hash<int>()( k.Netcode ) * prime );
         }
     };
 }
@@ -437,6 +438,11 @@ public:
      * For a set of items, this will remove the connected items and their
      * associated data including subgraphs and generated codes from the connection graph.
      *
+     * Along with the subgraphs of the items, this extracts every subgraph connected to them by
+     * name (through their current names as well as the ones they drove), and all the other
+     * subgraphs of the nets involved, so that recalculating the returned items gives the same
+     * nets as a full recalculation.
+     *
      * @param aItems A vector of items whose presence should be removed from the graph.
      * @return The full set of all items associated with the input items that were removed.
      */
@@ -723,6 +729,16 @@ private:
 
     std::unordered_map<wxString, std::vector<CONNECTION_SUBGRAPH*>> m_net_name_to_subgraphs_map;
 
+    /// Subgraphs with a hierarchical label, by sheet and label name.  Only valid while
+    /// propagating.
+    std::map< std::pair<SCH_SHEET_PATH, wxString>,
+              std::vector<CONNECTION_SUBGRAPH*> > m_hier_port_cache;
+
+    /// Subgraphs with a sheet pin, by sheet the pin leads to and pin name.  Only valid while
+    /// propagating.
+    std::map< std::pair<SCH_SHEET_PATH, wxString>,
+              std::vector<CONNECTION_SUBGRAPH*> > m_hier_pin_cache;
+
     std::unordered_map<SCH_ITEM*, CONNECTION_SUBGRAPH*> m_item_to_subgraph_map;
 
     NET_MAP m_net_code_to_subgraphs_map;
@@ -335,9 +335,9 @@ void SCH_EDIT_FRAME::SendSelectItemsToPcb( const std::vector<EDA_ITEM*>& aItems,
 
     std::string command = "$SELECT: 0,";
 
-    for( wxString part : parts )
+    for( const wxString& part : parts )
     {
-        command += part;
+        command += part.ToStdString();
         command += ",";
     }
 
@@ -450,27 +450,35 @@ void SCH_EDIT_FRAME::SendCrossProbeClearHighlight()
 }
 
 
-bool findSymbolsAndPins(
-        const SCHEMATIC& aSchematic, const SCH_SHEET_PATH& aSheetPath,
-        std::unordered_map<wxString, std::vector<SCH_REFERENCE>>&             aSyncSymMap,
-        std::unordered_map<wxString, std::unordered_map<wxString, SCH_PIN*>>& aSyncPinMap,
-        bool                                                                  aRecursive = false )
+/**
+ * The symbols of a sheet, as needed to match them against a sync selection.
+ */
+struct SHEET_SYMBOLS
 {
-    if( aRecursive )
-    {
-        // Iterate over children
-        for( const SCH_SHEET_PATH& candidate : aSchematic.GetSheets() )
-        {
-            if( candidate == aSheetPath || !candidate.IsContainedWithin( aSheetPath ) )
-                continue;
+    /// All symbols, including power and unannotated ones
+    size_t                                          m_count = 0;
 
-            findSymbolsAndPins( aSchematic, candidate, aSyncSymMap, aSyncPinMap, aRecursive );
-        }
-    }
+    /// Full reference and reference of each annotated, non-power symbol
+    std::vector<std::pair<wxString, SCH_REFERENCE>> m_annotated;
+};
+
+
+/**
+ * Gather the symbols of \a aSheetPath once; a sync selection visits most sheets several times.
+ */
+const SHEET_SYMBOLS& getSheetSymbols( const SCH_SHEET_PATH& aSheetPath,
+                                      std::unordered_map<SCH_SHEET_PATH, SHEET_SYMBOLS>& aCache )
+{
+    auto cacheIt = aCache.find( aSheetPath );
+
+    if( cacheIt != aCache.end() )
+        return cacheIt->second;
 
+    SHEET_SYMBOLS&     symbols = aCache[aSheetPath];
     SCH_REFERENCE_LIST references;
 
     aSheetPath.GetSymbols( references, false, true );
+    symbols.m_count = references.GetCount();
 
     for( unsigned ii = 0; ii < references.GetCount(); ii++ )
     {
@@ -479,9 +487,8 @@ bool findSymbolsAndPins(
         if( schRef.IsSplitNeeded() )
             schRef.Split();
 
-        SCH_SYMBOL* symbol = schRef.GetSymbol();
-        wxString    refNum = schRef.GetRefNumber();
-        wxString    fullRef = schRef.GetRef() + refNum;
+        wxString refNum = schRef.GetRefNumber();
+        wxString fullRef = schRef.GetRef() + refNum;
 
         // Skip power symbols
         if( fullRef.StartsWith( wxS( "#" ) ) )
@@ -491,6 +498,35 @@ bool findSymbolsAndPins(
         if( refNum.compare( wxS( "?" ) ) == 0 )
             continue;
 
+        symbols.m_annotated.emplace_back( fullRef, schRef );
+    }
+
+    return symbols;
+}
+
+
+bool findSymbolsAndPins(
+        const SCH_SHEET_LIST& aSheets, const SCH_SHEET_PATH& aSheetPath,
+        std::unordered_map<SCH_SHEET_PATH, SHEET_SYMBOLS>&                    aSheetSymbols,
+        std::unordered_map<wxString, std::vector<SCH_REFERENCE>>&             aSyncSymMap,
+        std::unordered_map<wxString, std::unordered_map<wxString, SCH_PIN*>>& aSyncPinMap,
+        bool                                                                  aRecursive = false )
+{
+    if( aRecursive )
+    {
+        // Iterate over children
+        for( const SCH_SHEET_PATH& candidate : aSheets )
+        {
+            if( candidate == aSheetPath || !candidate.IsContainedWithin( aSheetPath ) )
+                continue;
+
+            findSymbolsAndPins( aSheets, candidate, aSheetSymbols, aSyncSymMap, aSyncPinMap,
+                                aRecursive );
+        }
+    }
+
+    for( const auto& [fullRef, schRef] : getSheetSymbols( aSheetPath, aSheetSymbols ).m_annotated )
+    {
         // Look for whole footprint
         auto symMatchIt = aSyncSymMap.find( fullRef );
 
@@ -508,7 +544,7 @@ bool findSymbolsAndPins(
         if( symPinMatchIt != aSyncPinMap.end() )
         {
             std::unordered_map<wxString, SCH_PIN*>& pinMap = symPinMatchIt->second;
-            std::vector<SCH_PIN*>                   pinsOnSheet = symbol->GetPins( &aSheetPath );
+            std::vector<SCH_PIN*> pinsOnSheet = schRef.GetSymbol()->GetPins( &aSheetPath );
 
             for( SCH_PIN* pin : pinsOnSheet )
             {
@@ -530,7 +566,8 @@ bool findSymbolsAndPins(
 
 
 bool sheetContainsOnlyWantedItems(
-        const SCHEMATIC& aSchematic, const SCH_SHEET_PATH& aSheetPath,
+        const SCH_SHEET_LIST& aSheets, const SCH_SHEET_PATH& aSheetPath,
+        std::unordered_map<SCH_SHEET_PATH, SHEET_SYMBOLS>&                    aSheetSymbols,
         std::unordered_map<wxString, std::vector<SCH_REFERENCE>>&             aSyncSymMap,
         std::unordered_map<wxString, std::unordered_map<wxString, SCH_PIN*>>& aSyncPinMap,
         std::unordered_map<SCH_SHEET_PATH, bool>&                             aCache )
@@ -541,13 +578,13 @@ bool sheetContainsOnlyWantedItems(
         return cacheIt->second;
 
     // Iterate over children
-    for( const SCH_SHEET_PATH& candidate : aSchematic.GetSheets() )
+    for( const SCH_SHEET_PATH& candidate : aSheets )
     {
         if( candidate == aSheetPath || !candidate.IsContainedWithin( aSheetPath ) )
             continue;
 
-        bool childRet = sheetContainsOnlyWantedItems( aSchematic, candidate, aSyncSymMap,
-                                                      aSyncPinMap, aCache );
+        bool childRet = sheetContainsOnlyWantedItems( aSheets, candidate, aSheetSymbols,
+                                                      aSyncSymMap, aSyncPinMap, aCache );
 
         if( !childRet )
         {
@@ -556,33 +593,16 @@ bool sheetContainsOnlyWantedItems(
         }
     }
 
-    SCH_REFERENCE_LIST references;
-    aSheetPath.GetSymbols( references, false, true );
+    const SHEET_SYMBOLS& symbols = getSheetSymbols( aSheetPath, aSheetSymbols );
 
-    if( references.GetCount() == 0 )    // Empty sheet, obviously do not contain wanted items
+    if( symbols.m_count == 0 )    // Empty sheet, obviously do not contain wanted items
     {
         aCache.emplace( aSheetPath, false );
         return false;
     }
 
-    for( unsigned ii = 0; ii < references.GetCount(); ii++ )
+    for( const auto& [fullRef, schRef] : symbols.m_annotated )
     {
-        SCH_REFERENCE& schRef = references[ii];
-
-        if( schRef.IsSplitNeeded() )
-            schRef.Split();
-
-        wxString refNum = schRef.GetRefNumber();
-        wxString fullRef = schRef.GetRef() + refNum;
-
-        // Skip power symbols
-        if( fullRef.StartsWith( wxS( "#" ) ) )
-            continue;
-
-        // Unannotated symbols are not supported
-        if( refNum.compare( wxS( "?" ) ) == 0 )
-            continue;
-
         if( aSyncSymMap.find( fullRef ) == aSyncSymMap.end() )
         {
             aCache.emplace( aSheetPath, false );
@@ -611,6 +631,7 @@ findItemsFromSyncSelection( const SCHEMATIC& aSchematic, const std::string aSync
     std::unordered_map<wxString, std::unordered_map<wxString, SCH_PIN*>> syncPinMap;
     std::unordered_map<SCH_SHEET_PATH, double>                           symScores;
     std::unordered_map<SCH_SHEET_PATH, bool>                             fullyWantedCache;
+    std::unordered_map<SCH_SHEET_PATH, SHEET_SYMBOLS>                    sheetSymbols;
 
     std::optional<wxString>                                    focusSymbol;
     std::optional<std::pair<wxString, wxString>>               focusPin;
@@ -758,7 +779,7 @@ findItemsFromSyncSelection( const SCHEMATIC& aSchematic, const std::string aSync
         clearSyncMaps();
 
         // Fill sync maps
-        findSymbolsAndPins( aSchematic, aSheet, syncSymMap, syncPinMap );
+        findSymbolsAndPins( allSheetsList, aSheet, sheetSymbols, syncSymMap, syncPinMap );
         std::vector<SCH_ITEM*> itemsVector = flattenSyncMaps();
 
         // Add fully wanted sheets to vector
@@ -773,8 +794,8 @@ findItemsFromSyncSelection( const SCHEMATIC& aSchematic, const std::string aSync
             if( !subsheetPath )
                 continue;
 
-            if( sheetContainsOnlyWantedItems( aSchematic, *subsheetPath, syncSymMap, syncPinMap,
-                                              fullyWantedCache ) )
+            if( sheetContainsOnlyWantedItems( allSheetsList, *subsheetPath, sheetSymbols,
+                                              syncSymMap, syncPinMap, fullyWantedCache ) )
             {
                 itemsVector.push_back( item );
             }
@@ -789,7 +810,7 @@ findItemsFromSyncSelection( const SCHEMATIC& aSchematic, const std::string aSync
         {
             clearSyncMaps();
 
-            findSymbolsAndPins( aSchematic, sheetPath, syncSymMap, syncPinMap );
+            findSymbolsAndPins( allSheetsList, sheetPath, sheetSymbols, syncSymMap, syncPinMap );
 
             checkFocusItems( sheetPath );
         }
@@ -811,7 +832,7 @@ findItemsFromSyncSelection( const SCHEMATIC& aSchematic, const std::string aSync
         {
             clearSyncMaps();
 
-            findSymbolsAndPins( aSchematic, sheetPath, syncSymMap, syncPinMap );
+            findSymbolsAndPins( allSheetsList, sheetPath, sheetSymbols, syncSymMap, syncPinMap );
 
             if( !syncMapsValuesEmpty() )
             {
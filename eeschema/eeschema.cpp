@@ -27,6 +27,7 @@
 #include <kiface_base.h>
 #include <cli_progress_reporter.h>
 #include <confirm.h>
+#include <core/trace_profiler.h>
 #include <gestfich.h>
 #include <eda_dde.h>
 #include "eeschema_jobs_handler.h"
@@ -375,6 +376,8 @@ PGM_BASE* PgmOrNull()
 
 bool IFACE::OnKifaceStart( PGM_BASE* aProgram, int aCtlBits )
 {
+    TRACE_SCOPE( "Kiface start" );
+
     // This is process-level-initialization, not project-level-initialization of the DSO.
     // Do nothing in here pertinent to a project!
     InitSettings( new EESCHEMA_SETTINGS );
@@ -414,6 +417,8 @@ void IFACE::Reset()
 
 bool IFACE::loadGlobalLibTable()
 {
+    TRACE_SCOPE( "Load global library table" );
+
     wxFileName fn = SYMBOL_LIB_TABLE::GetGlobalTableFileName();
 
     if( !fn.FileExists() )
@@ -22,6 +22,7 @@
 #include <common.h>
 #include <pgm_base.h>
 #include <cli/exit_codes.h>
+#include <core/thread_pool.h>
 #include <sch_plotter.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
 #include <jobs/job_export_sch_bom.h>
@@ -29,12 +30,17 @@
 #include <jobs/job_export_sch_netlist.h>
 #include <jobs/job_export_sch_plot.h>
 #include <jobs/job_sch_erc.h>
+#include <jobs/job_sym_convert.h>
 #include <jobs/job_sym_export_svg.h>
 #include <jobs/job_sym_upgrade.h>
 #include <schematic.h>
+#include <sch_screen.h>
 #include <wx/dir.h>
 #include <wx/file.h>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <connection_graph.h>
 #include "eeschema_helpers.h"
 #include <sch_painter.h>
@@ -50,7 +56,9 @@
 #include <settings/settings_manager.h>
 
 #include <sch_file_versions.h>
+#include <sch_io/kicad_sexpr/sch_io_kicad_sexpr.h>
 #include <sch_io/kicad_sexpr/sch_io_kicad_sexpr_lib_cache.h>
+#include <sch_io/sch_io_mgr.h>
 
 #include <netlist.h>
 #include <netlist_exporter_base.h>
@@ -77,6 +85,8 @@ EESCHEMA_JOBS_HANDLER::EESCHEMA_JOBS_HANDLER()
               std::bind( &EESCHEMA_JOBS_HANDLER::JobExportPlot, this, std::placeholders::_1 ) );
     Register( "symupgrade",
               std::bind( &EESCHEMA_JOBS_HANDLER::JobSymUpgrade, this, std::placeholders::_1 ) );
+    Register( "symconvert",
+              std::bind( &EESCHEMA_JOBS_HANDLER::JobSymConvert, this, std::placeholders::_1 ) );
     Register( "symsvg",
               std::bind( &EESCHEMA_JOBS_HANDLER::JobSymExportSvg, this, std::placeholders::_1 ) );
     Register( "erc",
@@ -128,6 +138,63 @@ void EESCHEMA_JOBS_HANDLER::InitRenderSettings( KIGFX::SCH_RENDER_SETTINGS* aRen
 }
 
 
+SCHEMATIC* EESCHEMA_JOBS_HANDLER::getSchematic( JOB* aJob, const wxString& aFileName )
+{
+    wxFileName fn( aFileName );
+    fn.MakeAbsolute();
+
+    // A long running kicad-cli (e.g. a server) must not go on with sheets edited since
+    auto isModified =
+            [&]()
+            {
+                for( const auto& [ fileName, modified ] : m_schematicFileTimes )
+                {
+                    if( wxFileName( fileName ).GetModificationTime() != modified )
+                        return true;
+                }
+
+                return false;
+            };
+
+    if( !aJob->IsCli() || !m_schematic || fn.GetFullPath() != m_schematicFileName
+            || isModified() )
+    {
+        wxString   fileName = aFileName;
+        SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( fileName, SCH_IO_MGR::SCH_KICAD );
+
+        if( aJob->IsCli() && sch )
+        {
+            delete m_schematic;
+
+            m_schematic = sch;
+            m_schematicFileName = fn.GetFullPath();
+            m_schematicFileTimes.clear();
+
+            SCH_SCREENS screens( sch->Root() );
+
+            for( SCH_SCREEN* screen = screens.GetFirst(); screen; screen = screens.GetNext() )
+            {
+                wxFileName sheetFn( screen->GetFileName() );
+                sheetFn.MakeAbsolute( fn.GetPath() );
+                m_schematicFileTimes[ sheetFn.GetFullPath() ] = sheetFn.GetModificationTime();
+            }
+
+            m_schematicTextVars = sch->Prj().GetTextVars();
+        }
+
+        return sch;
+    }
+
+    if( m_schematic->Prj().GetTextVars() != m_schematicTextVars )
+    {
+        m_schematic->Prj().GetTextVars() = m_schematicTextVars;
+        m_schematic->Prj().IncrementTextVarsTicker();
+    }
+
+    return m_schematic;
+}
+
+
 int EESCHEMA_JOBS_HANDLER::JobExportPlot( JOB* aJob )
 {
     JOB_EXPORT_SCH_PLOT* aPlotJob = dynamic_cast<JOB_EXPORT_SCH_PLOT*>( aJob );
@@ -135,7 +202,7 @@ int EESCHEMA_JOBS_HANDLER::JobExportPlot( JOB* aJob )
     if( !aPlotJob )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( aPlotJob->m_filename, SCH_IO_MGR::SCH_KICAD );
+    SCHEMATIC* sch = getSchematic( aJob, aPlotJob->m_filename );
 
     if( sch == nullptr )
     {
@@ -234,7 +301,7 @@ int EESCHEMA_JOBS_HANDLER::JobExportNetlist( JOB* aJob )
     if( !aNetJob )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( aNetJob->m_filename, SCH_IO_MGR::SCH_KICAD );
+    SCHEMATIC* sch = getSchematic( aJob, aNetJob->m_filename );
 
     if( sch == nullptr )
     {
@@ -339,7 +406,7 @@ int EESCHEMA_JOBS_HANDLER::JobExportBom( JOB* aJob )
     if( !aBomJob )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( aBomJob->m_filename, SCH_IO_MGR::SCH_KICAD );
+    SCHEMATIC* sch = getSchematic( aJob, aBomJob->m_filename );
 
     if( sch == nullptr )
     {
@@ -597,7 +664,7 @@ int EESCHEMA_JOBS_HANDLER::JobExportPythonBom( JOB* aJob )
     if( !aNetJob )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( aNetJob->m_filename, SCH_IO_MGR::SCH_KICAD );
+    SCHEMATIC* sch = getSchematic( aJob, aNetJob->m_filename );
 
     if( sch == nullptr )
     {
@@ -792,6 +859,155 @@ int EESCHEMA_JOBS_HANDLER::doSymExportSvg( JOB_SYM_EXPORT_SVG*         aSvgJob,
 }
 
 
+int EESCHEMA_JOBS_HANDLER::JobSymConvert( JOB* aJob )
+{
+    JOB_SYM_CONVERT* convertJob = dynamic_cast<JOB_SYM_CONVERT*>( aJob );
+
+    if( !convertJob )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    std::vector<wxString> sources;
+    std::vector<wxString> outputs;
+    std::set<wxString>    outputSet;
+
+    for( const wxString& path : convertJob->m_libraryPaths )
+    {
+        wxFileName source( path );
+        source.MakeAbsolute();
+
+        wxFileName output( convertJob->m_outputDirectory.IsEmpty() ? source.GetPath()
+                                                                   : convertJob->m_outputDirectory,
+                           source.GetName(), FILEEXT::KiCadSymbolLibFileExtension );
+        output.MakeAbsolute();
+
+        if( output.GetFullPath() == source.GetFullPath()
+                || !outputSet.insert( output.GetFullPath() ).second
+                || ( !convertJob->m_force && output.FileExists() ) )
+        {
+            m_reporter->Report( wxString::Format( _( "Output library '%s' conflicts with an "
+                                                     "existing or another converted library\n" ),
+                                                  output.GetFullPath() ),
+                                RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+        }
+
+        sources.push_back( source.GetFullPath() );
+        outputs.push_back( output.GetFullPath() );
+    }
+
+    if( !convertJob->m_outputDirectory.IsEmpty() && !wxDir::Exists( convertJob->m_outputDirectory )
+            && !wxFileName::Mkdir( convertJob->m_outputDirectory, wxS_DIR_DEFAULT,
+                                   wxPATH_MKDIR_FULL ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to create output directory '%s'\n" ),
+                                              convertJob->m_outputDirectory ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    // Each library is read and written by its own plugins, so that libraries can be converted
+    // concurrently
+    auto convert =
+            []( const wxString& aSource, const wxString& aOutput ) -> int
+            {
+                SCH_IO_MGR::SCH_FILE_T type = SCH_IO_MGR::GuessPluginTypeFromLibPath( aSource );
+
+                if( type == SCH_IO_MGR::SCH_FILE_UNKNOWN )
+                    THROW_IO_ERROR( _( "Unknown symbol library format" ) );
+
+                IO_RELEASER<SCH_IO> sourceIO( SCH_IO_MGR::FindPlugin( type ) );
+                IO_RELEASER<SCH_IO> kicadIO( SCH_IO_MGR::FindPlugin( SCH_IO_MGR::SCH_KICAD ) );
+                std::vector<LIB_SYMBOL*>           symbols;
+                std::map<LIB_SYMBOL*, LIB_SYMBOL*> symbolMap;
+
+                // Symbols are only written once, when the whole library is converted
+                STRING_UTF8_MAP props;
+                props[SCH_IO_KICAD_SEXPR::PropBuffering] = "";
+
+                sourceIO->EnumerateSymbolLib( symbols, aSource );
+
+                // Copy non-aliases first so that aliases can be hooked up to the copies of
+                // their parents.  The library cache takes ownership of the copies.
+                for( bool aliases : { false, true } )
+                {
+                    for( LIB_SYMBOL* symbol : symbols )
+                    {
+                        if( symbol->IsAlias() != aliases )
+                            continue;
+
+                        LIB_SYMBOL* copy = new LIB_SYMBOL( *symbol );
+                        copy->SetName( EscapeString( symbol->GetName(), CTX_LIBID ) );
+
+                        if( aliases )
+                            copy->SetParent( symbolMap[symbol->GetParent().lock().get()] );
+                        else
+                            symbolMap[symbol] = copy;
+
+                        kicadIO->SaveSymbol( aOutput, copy, &props );
+                    }
+                }
+
+                kicadIO->SaveLibrary( aOutput, &props );
+
+                return (int) symbols.size();
+            };
+
+    size_t              count = sources.size();
+    size_t              workers = count;
+    std::atomic<size_t> next( 0 );
+    std::atomic<size_t> done( 0 );
+    std::atomic<size_t> failed( 0 );
+    std::mutex          reportMutex;
+
+    if( convertJob->m_threads > 0 )
+        workers = std::min( workers, (size_t) convertJob->m_threads );
+
+    ParallelFor( workers,
+                 [&]( size_t )
+                 {
+                     for( size_t ii = next++; ii < count; ii = next++ )
+                     {
+                         wxString msg;
+                         SEVERITY severity = RPT_SEVERITY_INFO;
+
+                         try
+                         {
+                             int symbols = convert( sources[ii], outputs[ii] );
+
+                             msg.Printf( _( "Converted %d symbols from '%s' to '%s'" ), symbols,
+                                         sources[ii], outputs[ii] );
+                         }
+                         catch( const IO_ERROR& ioe )
+                         {
+                             msg.Printf( _( "Unable to convert '%s': %s" ), sources[ii],
+                                         ioe.What() );
+                             severity = RPT_SEVERITY_ERROR;
+                             failed++;
+                         }
+                         catch( const std::exception& e )
+                         {
+                             msg.Printf( _( "Unable to convert '%s': %s" ), sources[ii],
+                                         e.what() );
+                             severity = RPT_SEVERITY_ERROR;
+                             failed++;
+                         }
+
+                         std::lock_guard<std::mutex> lock( reportMutex );
+
+                         m_reporter->Report( wxString::Format( wxS( "[%zu/%zu] %s\n" ), ++done,
+                                                               count, msg ),
+                                             severity );
+                     }
+                 } );
+
+    m_reporter->Report( wxString::Format( _( "Converted %zu of %zu symbol libraries\n" ),
+                                          count - failed, count ),
+                        failed ? RPT_SEVERITY_ERROR : RPT_SEVERITY_INFO );
+
+    return failed ? CLI::EXIT_CODES::ERR_UNKNOWN : CLI::EXIT_CODES::OK;
+}
+
+
 int EESCHEMA_JOBS_HANDLER::JobSymExportSvg( JOB* aJob )
 {
     JOB_SYM_EXPORT_SVG* svgJob = dynamic_cast<JOB_SYM_EXPORT_SVG*>( aJob );
@@ -935,7 +1151,7 @@ int EESCHEMA_JOBS_HANDLER::JobSchErc( JOB* aJob )
     if( !ercJob )
         return CLI::EXIT_CODES::ERR_UNKNOWN;
 
-    SCHEMATIC* sch = EESCHEMA_HELPERS::LoadSchematic( ercJob->m_filename, SCH_IO_MGR::SCH_KICAD );
+    SCHEMATIC* sch = getSchematic( aJob, ercJob->m_filename );
 
     if( sch == nullptr )
     {
@@ -22,8 +22,11 @@
 #define EESCHEMA_JOBS_HANDLER_H
 
 #include <jobs/job_dispatcher.h>
+#include <wx/datetime.h>
 #include <wx/string.h>
 
+#include <map>
+
 namespace KIGFX
 {
 class SCH_RENDER_SETTINGS;
@@ -47,6 +50,7 @@ public:
     int JobExportPlot( JOB* aJob );
     int JobSchErc( JOB* aJob );
     int JobSymUpgrade( JOB* aJob );
+    int JobSymConvert( JOB* aJob );
     int JobSymExportSvg( JOB* aJob );
 
     /**
@@ -69,7 +73,22 @@ private:
     int doSymExportSvg( JOB_SYM_EXPORT_SVG* aSvgJob, KIGFX::SCH_RENDER_SETTINGS* aRenderSettings,
                         LIB_SYMBOL* symbol );
 
+    /**
+     * Load the schematic of \a aJob.
+     *
+     * Jobs run from kicad-cli reuse the schematic loaded by the previous one when it is the
+     * same file and none of its sheets was modified since, so that the jobs of a jobset or a
+     * server load it and build its connectivity only once.  The text variables of its project
+     * are then reset to the ones it was loaded with, as jobs can override them.
+     */
+    SCHEMATIC* getSchematic( JOB* aJob, const wxString& aFileName );
+
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( SCHEMATIC* aSch );
+
+    SCHEMATIC*                     m_schematic = nullptr; ///< Shared by kicad-cli jobs
+    wxString                       m_schematicFileName;
+    std::map<wxString, wxDateTime> m_schematicFileTimes;  ///< Modification time of each sheet
+    std::map<wxString, wxString>   m_schematicTextVars;
 };
 
 #endif
@@ -24,6 +24,8 @@
  */
 
 #include <algorithm>
+#include <functional>
+#include <future>
 #include <numeric>
 
 #include "connection_graph.h"
@@ -50,6 +52,7 @@
 #include <wx/ffile.h>
 #include <sim/sim_lib_mgr.h>
 #include <progress_reporter.h>
+#include <core/thread_pool.h>
 
 
 /* ERC tests :
@@ -128,6 +131,22 @@ const std::set<ELECTRICAL_PINTYPE> DrivenPinTypes =
             ELECTRICAL_PINTYPE::PT_POWER_IN
         };
 
+
+typedef std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> PENDING_MARKERS;
+
+/// The markers of the test running on this thread, if it runs concurrently with others.
+/// Screens can't be changed while other tests iterate over them.
+static thread_local PENDING_MARKERS* s_pendingMarkers = nullptr;
+
+
+static void appendMarker( SCH_SCREEN* aScreen, SCH_MARKER* aMarker )
+{
+    if( s_pendingMarkers )
+        s_pendingMarkers->emplace_back( aScreen, aMarker );
+    else
+        aScreen->Append( aMarker );
+}
+
 int ERC_TESTER::TestDuplicateSheetNames( bool aCreateMarker )
 {
     SCH_SCREEN* screen;
@@ -215,7 +234,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
                 }
             }
@@ -232,7 +251,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, field.GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
                 }
 
@@ -248,7 +267,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                         ercItem->SetSheetSpecificPath( sheet );
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem, pin->GetPosition() );
-                        screen->Append( marker );
+                        appendMarker( screen, marker );
                     }
                 }
             }
@@ -261,7 +280,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, text->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                 }
             }
             else if( SCH_TEXTBOX* textBox = dynamic_cast<SCH_TEXTBOX*>( item ) )
@@ -273,7 +292,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     ercItem->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem, textBox->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                 }
             }
         }
@@ -289,7 +308,7 @@ void ERC_TESTER::TestTextVars( DS_PROXY_VIEW_ITEM* aDrawingSheet )
                     erc->SetSheetSpecificPath( sheet );
 
                     SCH_MARKER* marker = new SCH_MARKER( erc, text->GetPosition() );
-                    screen->Append( marker );
+                    appendMarker( screen, marker );
                 }
             }
         }
@@ -398,7 +417,7 @@ int ERC_TESTER::TestMultiunitFootprints()
                 ercItem->SetItems( unit, secondUnit );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, secondUnit->GetPosition() );
-                secondRef.GetSheetPath().LastScreen()->Append( marker );
+                appendMarker( secondRef.GetSheetPath().LastScreen(), marker );
 
                 ++errors;
             }
@@ -464,7 +483,7 @@ int ERC_TESTER::TestMissingUnits()
             ercItem->SetItems( unit );
 
             SCH_MARKER* marker = new SCH_MARKER( ercItem, unit->GetPosition() );
-            base_ref.GetSheetPath().LastScreen()->Append( marker );
+            appendMarker( base_ref.GetSheetPath().LastScreen(), marker );
 
             ++errors;
         };
@@ -571,7 +590,7 @@ int ERC_TESTER::TestMissingNetclasses()
                                                             netclass ) );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, item->GetPosition() );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
             };
 
     for( const SCH_SHEET_PATH& sheet : m_schematic->GetSheets() )
@@ -663,7 +682,7 @@ int ERC_TESTER::TestNoConnectPins()
                 ercItem->SetSheetSpecificPath( sheet );
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem, pair.first );
-                sheet.LastScreen()->Append( marker );
+                appendMarker( sheet.LastScreen(), marker );
             }
         }
     }
@@ -778,7 +797,7 @@ int ERC_TESTER::TestPinToPin()
 
                     SCH_MARKER* marker = new SCH_MARKER( ercItem,
                                                          refPin.Pin()->GetTransformedPosition() );
-                    pinToScreenMap[refPin.Pin()]->Append( marker );
+                    appendMarker( pinToScreenMap[refPin.Pin()], marker );
                     errors++;
                 }
             }
@@ -798,7 +817,7 @@ int ERC_TESTER::TestPinToPin()
 
                 SCH_MARKER* marker = new SCH_MARKER( ercItem,
                                                      needsDriver.Pin()->GetTransformedPosition() );
-                pinToScreenMap[needsDriver.Pin()]->Append( marker );
+                appendMarker( pinToScreenMap[needsDriver.Pin()], marker );
                 errors++;
             }
         }
@@ -856,7 +875,7 @@ int ERC_TESTER::TestMultUnitPinConflicts()
 
                         SCH_MARKER* marker = new SCH_MARKER( ercItem,
                                                              pin->GetTransformedPosition() );
-                        sheet.LastScreen()->Append( marker );
+                        appendMarker( sheet.LastScreen(), marker );
                         errors += 1;
                     }
                 }
@@ -874,11 +893,20 @@ int ERC_TESTER::TestSimilarLabels()
 
     int errors = 0;
 
-    std::unordered_map<wxString, std::pair<SCH_LABEL_BASE*, SCH_SHEET_PATH>> labelMap;
+    struct LABEL_ENTRY
+    {
+        SCH_LABEL_BASE* m_label;
+        SCH_SHEET_PATH  m_sheet;
+        wxString        m_text;
+    };
 
-    for( const std::pair<NET_NAME_CODE_CACHE_KEY, std::vector<CONNECTION_SUBGRAPH*>> net : nets )
+    // Labels are bucketed by their case-folded text, so each one is only compared with the
+    // first label of its bucket and its text is resolved once
+    std::unordered_map<wxString, LABEL_ENTRY> labelMap;
+
+    for( const auto& [ key, subgraphs ] : nets )
     {
-        for( CONNECTION_SUBGRAPH* subgraph : net.second )
+        for( CONNECTION_SUBGRAPH* subgraph : subgraphs )
         {
             const SCH_SHEET_PATH& sheet = subgraph->GetSheet();
 
@@ -891,29 +919,23 @@ int ERC_TESTER::TestSimilarLabels()
                 case SCH_GLOBAL_LABEL_T:
                 {
                     SCH_LABEL_BASE* label = static_cast<SCH_LABEL_BASE*>( item );
+                    wxString        text = label->GetShownText( &sheet, false );
 
-                    wxString normalized = label->GetShownText( &sheet, false ).Lower();
+                    LABEL_ENTRY     entry{ label, sheet, text };
 
-                    if( !labelMap.count( normalized ) )
-                    {
-                        labelMap[normalized] = std::make_pair( label, sheet );
-                        break;
-                    }
+                    auto [ it, inserted ] = labelMap.try_emplace( text.Lower(), entry );
 
-                    auto& [ otherLabel, otherSheet ] = labelMap.at( normalized );
+                    if( inserted || it->second.m_text == text )
+                        break;
 
-                    if( otherLabel->GetShownText( &otherSheet, false )
-                            != label->GetShownText( &sheet, false ) )
-                    {
-                        std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_SIMILAR_LABELS );
-                        ercItem->SetItems( label, labelMap.at( normalized ).first );
-                        ercItem->SetSheetSpecificPath( sheet );
-                        ercItem->SetItemsSheetPaths( sheet, labelMap.at( normalized ).second );
+                    std::shared_ptr<ERC_ITEM> ercItem = ERC_ITEM::Create( ERCE_SIMILAR_LABELS );
+                    ercItem->SetItems( label, it->second.m_label );
+                    ercItem->SetSheetSpecificPath( sheet );
+                    ercItem->SetItemsSheetPaths( sheet, it->second.m_sheet );
 
-                        SCH_MARKER* marker = new SCH_MARKER( ercItem, label->GetPosition() );
-                        sheet.LastScreen()->Append( marker );
-                        errors += 1;
-                    }
+                    SCH_MARKER* marker = new SCH_MARKER( ercItem, label->GetPosition() );
+                    appendMarker( sheet.LastScreen(), marker );
+                    errors += 1;
 
                     break;
                 }
@@ -939,6 +961,17 @@ int ERC_TESTER::TestLibSymbolIssues()
 
     SCH_SCREENS screens( m_schematic->Root() );
 
+    // Let libraries needing a round trip per symbol (e.g. databases) fetch them all at once
+    std::vector<LIB_ID> libIds;
+
+    for( SCH_SCREEN* screen = screens.GetFirst(); screen != nullptr; screen = screens.GetNext() )
+    {
+        for( SCH_ITEM* item : screen->Items().OfType( SCH_SYMBOL_T ) )
+            libIds.push_back( static_cast<SCH_SYMBOL*>( item )->GetLibId() );
+    }
+
+    libTable->PrefetchSymbols( libIds );
+
     for( SCH_SCREEN* screen = screens.GetFirst(); screen != nullptr; screen = screens.GetNext() )
     {
         std::vector<SCH_MARKER*> markers;
@@ -1010,7 +1043,7 @@ int ERC_TESTER::TestLibSymbolIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            appendMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1075,7 +1108,7 @@ int ERC_TESTER::TestOffGridEndpoints()
 
         for( SCH_MARKER* marker : markers )
         {
-            screen->Append( marker );
+            appendMarker( screen, marker );
             err_count += 1;
         }
     }
@@ -1126,7 +1159,7 @@ int ERC_TESTER::TestSimModelIssues()
 
         for( SCH_MARKER* marker : markers )
         {
-            sheet.LastScreen()->Append( marker );
+            appendMarker( sheet.LastScreen(), marker );
             err_count += 1;
         }
     }
@@ -1173,96 +1206,119 @@ void ERC_TESTER::RunTests( DS_PROXY_VIEW_ITEM* aDrawingSheet, SCH_EDIT_FRAME* aE
 
     m_schematic->ConnectionGraph()->RunERC();
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking units..." ) );
-
-    // Test is all units of each multiunit symbol have the same footprint assigned.
-    if( settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_FP ) )
+    // The remaining tests only read the schematic and the finished connection graph, so they
+    // run concurrently.  Their markers are collected per test and added to the screens in the
+    // order of the tests once all of them are done, so that the results don't depend on the
+    // scheduling.  The tests which load libraries or simulation models run on this thread.
+    struct ERC_TASK
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking footprints..." ) );
+        std::function<void()> m_test;
+        bool                  m_onCallerThread;
+        PENDING_MARKERS       m_markers;
+    };
 
-        TestMultiunitFootprints();
-    }
+    std::vector<ERC_TASK> tasks;
 
-    if( settings.IsTestEnabled( ERCE_MISSING_UNIT )
-        || settings.IsTestEnabled( ERCE_MISSING_INPUT_PIN )
-        || settings.IsTestEnabled( ERCE_MISSING_POWER_INPUT_PIN )
-        || settings.IsTestEnabled( ERCE_MISSING_BIDI_PIN ) )
-    {
-        TestMissingUnits();
-    }
+    auto addTest =
+            [&]( bool aEnabled, bool aOnCallerThread, std::function<void()> aTest )
+            {
+                if( aEnabled )
+                    tasks.push_back( { std::move( aTest ), aOnCallerThread, {} } );
+            };
 
-    if( aProgressReporter )
-        aProgressReporter->AdvancePhase( _( "Checking pins..." ) );
+    auto advance =
+            [&]( const wxString& aMessage )
+            {
+                if( aProgressReporter )
+                    aProgressReporter->AdvancePhase( aMessage );
+            };
+
+    // Test is all units of each multiunit symbol have the same footprint assigned.
+    addTest( settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_FP ), false,
+             [&]() { TestMultiunitFootprints(); } );
 
-    if( settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ) )
-        TestMultUnitPinConflicts();
+    addTest( settings.IsTestEnabled( ERCE_MISSING_UNIT )
+                     || settings.IsTestEnabled( ERCE_MISSING_INPUT_PIN )
+                     || settings.IsTestEnabled( ERCE_MISSING_POWER_INPUT_PIN )
+                     || settings.IsTestEnabled( ERCE_MISSING_BIDI_PIN ),
+             false, [&]() { TestMissingUnits(); } );
+
+    addTest( settings.IsTestEnabled( ERCE_DIFFERENT_UNIT_NET ), false,
+             [&]() { TestMultUnitPinConflicts(); } );
 
     // Test pins on each net against the pin connection table
-    if( settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
-        || settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
-        || settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN ) )
-    {
-        TestPinToPin();
-    }
+    addTest( settings.IsTestEnabled( ERCE_PIN_TO_PIN_ERROR )
+                     || settings.IsTestEnabled( ERCE_POWERPIN_NOT_DRIVEN )
+                     || settings.IsTestEnabled( ERCE_PIN_NOT_DRIVEN ),
+             false, [&]() { TestPinToPin(); } );
 
     // Test similar labels (i;e. labels which are identical when
     // using case insensitive comparisons)
-    if( settings.IsTestEnabled( ERCE_SIMILAR_LABELS ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking labels..." ) );
-
-        TestSimilarLabels();
-    }
-
-    if( settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for unresolved variables..." ) );
-
-        TestTextVars( aDrawingSheet );
-    }
+    addTest( settings.IsTestEnabled( ERCE_SIMILAR_LABELS ), false,
+             [&]() { TestSimilarLabels(); } );
+
+    addTest( settings.IsTestEnabled( ERCE_UNRESOLVED_VARIABLE ), true,
+             [&]()
+             {
+                 advance( _( "Checking for unresolved variables..." ) );
+                 TestTextVars( aDrawingSheet );
+             } );
+
+    addTest( settings.IsTestEnabled( ERCE_SIMULATION_MODEL ), true,
+             [&]()
+             {
+                 advance( _( "Checking SPICE models..." ) );
+                 TestSimModelIssues();
+             } );
+
+    addTest( settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ), false,
+             [&]() { TestNoConnectPins(); } );
+
+    addTest( settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES ), true,
+             [&]()
+             {
+                 advance( _( "Checking for library symbol issues..." ) );
+                 TestLibSymbolIssues();
+             } );
+
+    addTest( settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ), false,
+             [&]() { TestOffGridEndpoints(); } );
+
+    addTest( settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ), false,
+             [&]() { TestMissingNetclasses(); } );
+
+    auto runTest =
+            []( ERC_TASK& aTask )
+            {
+                s_pendingMarkers = &aTask.m_markers;
+                aTask.m_test();
+                s_pendingMarkers = nullptr;
+            };
 
-    if( settings.IsTestEnabled( ERCE_SIMULATION_MODEL ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking SPICE models..." ) );
+    advance( _( "Checking units, pins and labels..." ) );
 
-        TestSimModelIssues();
-    }
+    thread_pool&                   tp = GetKiCadThreadPool();
+    std::vector<std::future<void>> results;
 
-    if( settings.IsTestEnabled( ERCE_NOCONNECT_CONNECTED ) )
+    for( ERC_TASK& task : tasks )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking no connect pins for connections..." ) );
-
-        TestNoConnectPins();
+        if( !task.m_onCallerThread )
+            results.push_back( tp.submit( [&runTest, &task]() { runTest( task ); } ) );
     }
 
-    if( settings.IsTestEnabled( ERCE_LIB_SYMBOL_ISSUES ) )
+    for( ERC_TASK& task : tasks )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for library symbol issues..." ) );
-
-        TestLibSymbolIssues();
+        if( task.m_onCallerThread )
+            runTest( task );
     }
 
-    if( settings.IsTestEnabled( ERCE_ENDPOINT_OFF_GRID ) )
-    {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for off grid pins and wires..." ) );
+    for( std::future<void>& result : results )
+        result.wait();
 
-        TestOffGridEndpoints();
-    }
-
-    if( settings.IsTestEnabled( ERCE_UNDEFINED_NETCLASS ) )
+    for( ERC_TASK& task : tasks )
     {
-        if( aProgressReporter )
-            aProgressReporter->AdvancePhase( _( "Checking for undefined netclasses..." ) );
-
-        TestMissingNetclasses();
+        for( const auto& [ screen, marker ] : task.m_markers )
+            screen->Append( marker );
     }
 
     m_schematic->ResolveERCExclusionsPostUpdate();
@@ -20,6 +20,7 @@
 #include <wx/string.h>
 #include <wx/debug.h>
 #include <wx/grid.h>
+#include <unordered_map>
 #include <common.h>
 #include <widgets/wx_grid.h>
 #include <sch_reference_list.h>
@@ -294,10 +295,9 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::ColIsAttribute( int aCol )
 }
 
 
-bool FIELDS_EDITOR_GRID_DATA_MODEL::cmp( const DATA_MODEL_ROW&          lhGroup,
-                                         const DATA_MODEL_ROW&          rhGroup,
-                                         FIELDS_EDITOR_GRID_DATA_MODEL* dataModel, int sortCol,
-                                         bool ascending )
+bool FIELDS_EDITOR_GRID_DATA_MODEL::cmp( const DATA_MODEL_ROW& lhGroup,
+                                         const DATA_MODEL_ROW& rhGroup, const wxString& lhs,
+                                         const wxString& rhs, int sortCol, bool ascending )
 {
     // Empty rows always go to the bottom, whether ascending or descending
     if( lhGroup.m_Refs.size() == 0 )
@@ -317,10 +317,6 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::cmp( const DATA_MODEL_ROW&          lhGroup,
             };
 
     // Primary sort key is sortCol; secondary is always REFERENCE (column 0)
-
-    wxString lhs = dataModel->GetValue( (DATA_MODEL_ROW&) lhGroup, sortCol );
-    wxString rhs = dataModel->GetValue( (DATA_MODEL_ROW&) rhGroup, sortCol );
-
     if( lhs == rhs || sortCol == REFERENCE_FIELD )
     {
         wxString lhRef = lhGroup.m_Refs[0].GetRef() + lhGroup.m_Refs[0].GetRefNumber();
@@ -351,11 +347,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::Sort()
                    } );
     }
 
-    std::sort( m_rows.begin(), m_rows.end(),
-               [this]( const DATA_MODEL_ROW& lhs, const DATA_MODEL_ROW& rhs ) -> bool
-               {
-                   return cmp( lhs, rhs, this, m_sortColumn, m_sortAscending );
-               } );
+    sortRows( m_rows );
 
     // Time to renumber the item numbers
     int itemNumber = 1;
@@ -379,31 +371,63 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::unitMatch( const SCH_REFERENCE& lhRef,
 }
 
 
-bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef,
-                                                const SCH_REFERENCE& rhRef )
+void FIELDS_EDITOR_GRID_DATA_MODEL::sortRows( std::vector<DATA_MODEL_ROW>& aRows )
+{
+    std::vector<wxString> values;
+    std::vector<size_t>   order;
+
+    values.reserve( aRows.size() );
+    order.reserve( aRows.size() );
+
+    for( size_t i = 0; i < aRows.size(); ++i )
+    {
+        values.push_back( GetValue( aRows[i], m_sortColumn ) );
+        order.push_back( i );
+    }
+
+    std::sort( order.begin(), order.end(),
+               [&]( size_t lhs, size_t rhs ) -> bool
+               {
+                   return cmp( aRows[lhs], aRows[rhs], values[lhs], values[rhs], m_sortColumn,
+                               m_sortAscending );
+               } );
+
+    std::vector<DATA_MODEL_ROW> sorted;
+    sorted.reserve( aRows.size() );
+
+    for( size_t i : order )
+        sorted.push_back( std::move( aRows[i] ) );
+
+    aRows = std::move( sorted );
+}
+
 
+wxString FIELDS_EDITOR_GRID_DATA_MODEL::groupKey( const SCH_REFERENCE& aRef )
 {
-    int  refCol = GetFieldNameCol( GetCanonicalFieldName( REFERENCE_FIELD ) );
-    bool matchFound = false;
+    int      refCol = GetFieldNameCol( GetCanonicalFieldName( REFERENCE_FIELD ) );
+    wxString key;
 
     if( refCol == -1 )
-        return false;
+        return key;
+
+    // Each value is prefixed with its length so that no two sets of values give the same key
+    auto addValue =
+            [&]( const wxString& aValue )
+            {
+                key << (int) aValue.length() << ':' << aValue;
+            };
 
-    // First check the reference column.  This can be done directly out of the
-    // SCH_REFERENCEs as the references can't be edited in the grid.
+    // First the reference column.  This can be done directly out of the SCH_REFERENCEs
+    // as the references can't be edited in the grid.
     if( m_cols[refCol].m_group )
     {
         // if we're grouping by reference, then only the prefix must match
-        if( lhRef.GetRef() != rhRef.GetRef() )
-            return false;
-
-        matchFound = true;
+        addValue( aRef.GetRef() );
     }
 
-    const KIID& lhRefID = lhRef.GetSymbol()->m_Uuid;
-    const KIID& rhRefID = rhRef.GetSymbol()->m_Uuid;
+    const KIID& refID = aRef.GetSymbol()->m_Uuid;
 
-    // Now check all the other columns.
+    // Now all the other columns.
     for( size_t i = 0; i < m_cols.size(); ++i )
     {
         //Handled already
@@ -417,33 +441,18 @@ bool FIELDS_EDITOR_GRID_DATA_MODEL::groupMatch( const SCH_REFERENCE& lhRef,
         // to get the actual current value, otherwise we need to pull it out of the
         // store so the refresh can regroup based on values that haven't been applied
         // to the schematic yet.
-        wxString lh, rh;
-
         if( IsTextVar( m_cols[i].m_fieldName )
-            || IsTextVar( m_dataStore[lhRefID][m_cols[i].m_fieldName] ) )
+            || IsTextVar( m_dataStore[refID][m_cols[i].m_fieldName] ) )
         {
-            lh = getFieldShownText( lhRef, m_cols[i].m_fieldName );
+            addValue( getFieldShownText( aRef, m_cols[i].m_fieldName ) );
         }
         else
-            lh = m_dataStore[lhRefID][m_cols[i].m_fieldName];
-
-        if( IsTextVar( m_cols[i].m_fieldName )
-            || IsTextVar( m_dataStore[rhRefID][m_cols[i].m_fieldName] ) )
         {
-            rh = getFieldShownText( rhRef, m_cols[i].m_fieldName );
+            addValue( m_dataStore[refID][m_cols[i].m_fieldName] );
         }
-        else
-            rh = m_dataStore[rhRefID][m_cols[i].m_fieldName];
-
-        wxString fieldName = m_cols[i].m_fieldName;
-
-        if( lh != rh )
-            return false;
-
-        matchFound = true;
     }
 
-    return matchFound;
+    return key;
 }
 
 
@@ -546,6 +555,34 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
 
     m_rows.clear();
 
+    // Rows are matched on their first reference: the first row with the same annotated
+    // reference, or else the first row in the same group
+    std::unordered_map<wxString, size_t> unitRows;
+    std::unordered_map<wxString, size_t> groupRows;
+
+    auto unitKey =
+            []( const SCH_REFERENCE& aRef ) -> wxString
+            {
+                // If items are unannotated then we can't tell if they're units of the same
+                // symbol or not
+                if( aRef.GetRefNumber() == wxT( "?" ) )
+                    return wxEmptyString;
+
+                return aRef.GetRef() + wxT( "\n" ) + aRef.GetRefNumber();
+            };
+
+    auto addRow =
+            [&]( const SCH_REFERENCE& aRef, const wxString& aUnitKey, const wxString& aGroupKey )
+            {
+                if( !aUnitKey.IsEmpty() )
+                    unitRows.emplace( aUnitKey, m_rows.size() );
+
+                if( !aGroupKey.IsEmpty() )
+                    groupRows.emplace( aGroupKey, m_rows.size() );
+
+                m_rows.emplace_back( DATA_MODEL_ROW( aRef, GROUP_SINGLETON ) );
+            };
+
     for( unsigned i = 0; i < m_symbolsList.GetCount(); ++i )
     {
         SCH_REFERENCE ref = m_symbolsList[i];
@@ -568,38 +605,34 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::RebuildRows()
             continue;
         }
 
-        bool matchFound = false;
+        wxString refUnitKey = unitKey( ref );
+        wxString refGroupKey = m_groupingEnabled ? groupKey( ref ) : wxString();
 
-        // Performance optimization for ungrouped case to skip the N^2 for loop
+        // Performance optimization for ungrouped case to skip the lookups
         if( !m_groupingEnabled && !ref.IsMultiUnit() )
         {
-            m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
+            addRow( ref, refUnitKey, refGroupKey );
             continue;
         }
 
         // See if we already have a row which this symbol fits into
-        for( DATA_MODEL_ROW& row : m_rows )
-        {
-            // all group members must have identical refs so just use the first one
-            SCH_REFERENCE rowRef = row.m_Refs[0];
+        auto unitIt = refUnitKey.IsEmpty() ? unitRows.end() : unitRows.find( refUnitKey );
+        auto groupIt = refGroupKey.IsEmpty() ? groupRows.end() : groupRows.find( refGroupKey );
 
-            if( unitMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                break;
-            }
-            else if( m_groupingEnabled && groupMatch( ref, rowRef ) )
-            {
-                matchFound = true;
-                row.m_Refs.push_back( ref );
-                row.m_Flag = GROUP_COLLAPSED;
-                break;
-            }
+        if( unitIt != unitRows.end()
+                && ( groupIt == groupRows.end() || unitIt->second <= groupIt->second ) )
+        {
+            m_rows[unitIt->second].m_Refs.push_back( ref );
+        }
+        else if( groupIt != groupRows.end() )
+        {
+            m_rows[groupIt->second].m_Refs.push_back( ref );
+            m_rows[groupIt->second].m_Flag = GROUP_COLLAPSED;
+        }
+        else
+        {
+            addRow( ref, refUnitKey, refGroupKey );
         }
-
-        if( !matchFound )
-            m_rows.emplace_back( DATA_MODEL_ROW( ref, GROUP_SINGLETON ) );
     }
 
     if( GetView() )
@@ -640,11 +673,7 @@ void FIELDS_EDITOR_GRID_DATA_MODEL::ExpandRow( int aRow )
     if( children.size() < 2 )
         return;
 
-    std::sort( children.begin(), children.end(),
-               [this]( const DATA_MODEL_ROW& lhs, const DATA_MODEL_ROW& rhs ) -> bool
-               {
-                   return cmp( lhs, rhs, this, m_sortColumn, m_sortAscending );
-               } );
+    sortRows( children );
 
     m_rows[aRow].m_Flag = GROUP_EXPANDED;
     m_rows.insert( m_rows.begin() + aRow + 1, children.begin(), children.end() );
@@ -255,9 +255,20 @@ public:
 
 private:
     static bool cmp( const DATA_MODEL_ROW& lhGroup, const DATA_MODEL_ROW& rhGroup,
-                     FIELDS_EDITOR_GRID_DATA_MODEL* dataModel, int sortCol, bool ascending );
+                     const wxString& lhs, const wxString& rhs, int sortCol, bool ascending );
     bool        unitMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
-    bool        groupMatch( const SCH_REFERENCE& lhRef, const SCH_REFERENCE& rhRef );
+
+    /**
+     * Sort \a aRows on the sort column.  The sort column's value of each row is fetched once
+     * rather than on every comparison, as building reference ranges is expensive.
+     */
+    void        sortRows( std::vector<DATA_MODEL_ROW>& aRows );
+
+    /**
+     * @return a key which is equal for references that go in the same group: their reference
+     *         prefix and grouped field values.  Empty when no column is grouped.
+     */
+    wxString    groupKey( const SCH_REFERENCE& aRef );
 
     // Helper functions to deal with translating wxGrid values to and from
     // named field values like ${DNP}
@@ -121,7 +121,7 @@ bool NETLIST_EXPORTER_CADSTAR::writeListOfNets( FILE* f )
 
     for( const auto& [ key, subgraphs ] : m_schematic->ConnectionGraph()->GetNetMap() )
     {
-        netName.Printf( wxT( "\"%s\"" ), key.Name );
+        netName.Printf( wxT( "\"%s\"" ), key.Name.Str() );
 
         std::vector<std::pair<SCH_PIN*, SCH_SHEET_PATH>> sorted_items;
 
@@ -25,6 +25,7 @@
 
 
 #include <algorithm>
+#include <functional>
 #include <confirm.h>
 
 #include <xnode.h>
@@ -53,7 +54,90 @@ bool NETLIST_EXPORTER_KICAD::WriteNetlist( const wxString& aOutFileName, unsigne
 
 void NETLIST_EXPORTER_KICAD::Format( OUTPUTFORMATTER* aOut, int aCtl )
 {
-    std::unique_ptr<XNODE> xroot( makeRoot( aCtl ) );
+    // This writes the same document as makeRoot() builds, but the symbols and the nets are
+    // formatted as soon as each one is built, and the tree of the whole netlist never exists.
+    typedef std::function<void( const std::function<void( XNODE* )>& )> VISIT_FUNC;
 
-    xroot->Format( aOut, 0 );
+    auto formatNode =
+            [&]( XNODE* aNode )
+            {
+                std::unique_ptr<XNODE> xnode( aNode );
+
+                xnode->Format( aOut, 1 );
+            };
+
+    auto formatList =
+            [&]( const char* aName, const VISIT_FUNC& aVisit )
+            {
+                std::unique_ptr<XNODE> pending;
+
+                aOut->Print( 1, "(%s", aName );
+
+                aVisit( [&]( XNODE* aNode )
+                        {
+                            // XNODE::Format() ends all but the last child with a new line
+                            if( pending )
+                                pending->Format( aOut, 2 );
+
+                            aOut->Print( 0, "\n" );
+                            pending.reset( aNode );
+                        } );
+
+                if( pending )
+                    pending->Format( aOut, 2 );
+
+                aOut->Print( 0, ")" );
+            };
+
+    std::vector<std::function<void()>> sections;
+
+    if( aCtl & GNL_HEADER )
+        sections.emplace_back( [&]() { formatNode( makeDesignHeader() ); } );
+
+    if( aCtl & GNL_SYMBOLS )
+    {
+        sections.emplace_back(
+                [&]()
+                {
+                    formatList( "components",
+                                [&]( const std::function<void( XNODE* )>& aVisitor )
+                                {
+                                    visitSymbols( aCtl, aVisitor );
+                                } );
+                } );
+    }
+
+    if( aCtl & GNL_PARTS )
+        sections.emplace_back( [&]() { formatNode( makeLibParts() ); } );
+
+    if( aCtl & GNL_LIBRARIES )
+        sections.emplace_back( [&]() { formatNode( makeLibraries() ); } );
+
+    if( aCtl & GNL_NETS )
+    {
+        sections.emplace_back(
+                [&]()
+                {
+                    formatList( "nets",
+                                [&]( const std::function<void( XNODE* )>& aVisitor )
+                                {
+                                    visitNets( aCtl, aVisitor );
+                                } );
+                } );
+    }
+
+    std::unique_ptr<XNODE> xroot( node( wxT( "export" ) ) );
+
+    xroot->AddAttribute( wxT( "version" ), wxT( "E" ) );
+
+    aOut->Print( 0, "(export" );
+    xroot->FormatContents( aOut, 0 );
+
+    for( const std::function<void()>& section : sections )
+    {
+        aOut->Print( 0, "\n" );
+        section();
+    }
+
+    aOut->Print( 0, ")" );
 }
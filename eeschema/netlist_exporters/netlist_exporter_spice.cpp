@@ -43,6 +43,7 @@
 
 #include <dialogs/html_message_box.h>
 #include <fmt/core.h>
+#include <hash.h>
 #include <paths.h>
 #include <wx/dir.h>
 #include <wx/log.h>
@@ -153,6 +154,7 @@ bool NETLIST_EXPORTER_SPICE::ReadSchematicAndLibraries( unsigned aNetlistOptions
 {
     wxString              msg;
     std::set<std::string> refNames; // Set of reference names to check for duplication.
+    std::set<wxString>    usedKeys; // Symbols whose models are cached
     int                   ncCounter = 1;
 
     ReadDirectives( aNetlistOptions );
@@ -224,7 +226,42 @@ bool NETLIST_EXPORTER_SPICE::ReadSchematicAndLibraries( unsigned aNetlistOptions
             }
 
             readRefName( sheet, *symbol, spiceItem, refNames );
-            readModel( sheet, *symbol, spiceItem, aReporter );
+
+            // Re-simulating after an edit usually changes a few symbols at most, so only read
+            // the models of those again
+            wxString key = sheet.PathAsString() + symbol->m_Uuid.AsString();
+            size_t   signature = modelSignature( *symbol, spiceItem );
+            auto     it = m_modelCache.find( key );
+
+            if( it != m_modelCache.end() && it->second.m_signature == signature )
+            {
+                spiceItem.baseModelName = it->second.m_baseModelName;
+                spiceItem.modelName = it->second.m_modelName;
+                spiceItem.model = it->second.m_model;
+                readRawInclude( *spiceItem.model );
+            }
+            else
+            {
+                bool hadMessage = aReporter.HasMessage();
+
+                readModel( sheet, *symbol, spiceItem, aReporter );
+
+                // Models with errors are read again to report them again, and IBIS devices
+                // write their cache files while they're read
+                if( !hadMessage && !aReporter.HasMessage()
+                        && !dynamic_cast<const SIM_MODEL_KIBIS*>( spiceItem.model ) )
+                {
+                    m_modelCache[key] = { signature, spiceItem.baseModelName, spiceItem.modelName,
+                                          spiceItem.model };
+                }
+                else
+                {
+                    m_modelCache.erase( key );
+                }
+            }
+
+            usedKeys.insert( key );
+
             readPinNumbers( *symbol, spiceItem, pins );
             readPinNetNames( *symbol, spiceItem, pins, ncCounter );
 
@@ -234,10 +271,46 @@ bool NETLIST_EXPORTER_SPICE::ReadSchematicAndLibraries( unsigned aNetlistOptions
         }
     }
 
+    // Forget the symbols gone from the schematic, and the models nothing uses any more
+    std::set<const SIM_MODEL*> usedModels;
+
+    for( auto it = m_modelCache.begin(); it != m_modelCache.end(); )
+    {
+        if( usedKeys.count( it->first ) )
+            ++it;
+        else
+            it = m_modelCache.erase( it );
+    }
+
+    for( const SPICE_ITEM& item : m_items )
+        usedModels.insert( item.model );
+
+    m_libMgr.RetainModels( usedModels );
+
     return !aReporter.HasMessage();
 }
 
 
+size_t NETLIST_EXPORTER_SPICE::modelSignature( SCH_SYMBOL& aSymbol, const SPICE_ITEM& aItem )
+{
+    size_t signature = 0;
+
+    for( const SCH_FIELD& field : aItem.fields )
+    {
+        hash_combine( signature, field.GetName().utf8_string(),
+                      field.GetText().utf8_string() );
+    }
+
+    for( const LIB_PIN* pin : aSymbol.GetAllLibPins() )
+    {
+        hash_combine( signature, pin->GetNumber().utf8_string(), pin->GetName().utf8_string(),
+                      static_cast<int>( pin->GetType() ) );
+    }
+
+    return signature;
+}
+
+
 void NETLIST_EXPORTER_SPICE::ConvertToSpiceMarkup( std::string& aNetName )
 {
     MARKUP::MARKUP_PARSER         markupParser( aNetName );
@@ -453,13 +526,9 @@ void NETLIST_EXPORTER_SPICE::readModel( SCH_SHEET_PATH& aSheet, SCH_SYMBOL& aSym
     aItem.modelName = m_modelNameGenerator.Generate( modelName );
 
     // FIXME: Don't have special cases for raw Spice models and KIBIS.
-    if( auto rawSpiceModel = dynamic_cast<const SIM_MODEL_RAW_SPICE*>( aItem.model ) )
+    if( dynamic_cast<const SIM_MODEL_RAW_SPICE*>( aItem.model ) )
     {
-        int      libParamIndex = static_cast<int>( SIM_MODEL_RAW_SPICE::SPICE_PARAM::LIB );
-        wxString path = rawSpiceModel->GetParam( libParamIndex ).value;
-
-        if( !path.IsEmpty() )
-            m_rawIncludes.insert( path );
+        readRawInclude( *aItem.model );
     }
     else if( auto kibisModel = dynamic_cast<const SIM_MODEL_KIBIS*>( aItem.model ) )
     {
@@ -487,6 +556,19 @@ void NETLIST_EXPORTER_SPICE::readModel( SCH_SHEET_PATH& aSheet, SCH_SYMBOL& aSym
 }
 
 
+void NETLIST_EXPORTER_SPICE::readRawInclude( const SIM_MODEL& aModel )
+{
+    if( auto rawSpiceModel = dynamic_cast<const SIM_MODEL_RAW_SPICE*>( &aModel ) )
+    {
+        int      libParamIndex = static_cast<int>( SIM_MODEL_RAW_SPICE::SPICE_PARAM::LIB );
+        wxString path = rawSpiceModel->GetParam( libParamIndex ).value;
+
+        if( !path.IsEmpty() )
+            m_rawIncludes.insert( path );
+    }
+}
+
+
 void NETLIST_EXPORTER_SPICE::readPinNumbers( SCH_SYMBOL& aSymbol, SPICE_ITEM& aItem,
                                              const std::vector<PIN_INFO>& aPins  )
 {
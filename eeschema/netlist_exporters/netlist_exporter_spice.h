@@ -148,6 +148,15 @@ private:
                       std::set<std::string>& aRefNames );
     void readModel( SCH_SHEET_PATH& aSheet, SCH_SYMBOL& aSymbol, SPICE_ITEM& aItem,
                     REPORTER& aReporter );
+
+    /// Add the library of a raw Spice model to the includes
+    void readRawInclude( const SIM_MODEL& aModel );
+
+    /**
+     * @return a hash of what the model of a symbol is read from: its fields, as shown in
+     *         \a aItem, and its pins.
+     */
+    static size_t modelSignature( SCH_SYMBOL& aSymbol, const SPICE_ITEM& aItem );
     void readPinNumbers( SCH_SYMBOL& aSymbol, SPICE_ITEM& aItem,
                          const std::vector<PIN_INFO>& aPins );
     void readPinNetNames( SCH_SYMBOL& aSymbol, SPICE_ITEM& aItem,
@@ -172,6 +181,18 @@ private:
     ///< Items representing schematic symbols in Spice world.
     std::list<SPICE_ITEM>   m_items;
 
+    /// The model read for a symbol, reused by the next netlist if the symbol didn't change
+    struct CACHED_MODEL
+    {
+        size_t           m_signature;
+        std::string      m_baseModelName;
+        std::string      m_modelName;
+        const SIM_MODEL* m_model;
+    };
+
+    ///< Models read for the last netlist, by sheet path and symbol UUID
+    std::map<wxString, CACHED_MODEL> m_modelCache;
+
     wxWindow*               m_dialogParent;
 };
 
@@ -243,6 +243,19 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
 {
     XNODE* xcomps = node( wxT( "components" ) );
 
+    visitSymbols( aCtl,
+                  [&]( XNODE* aSymbol )
+                  {
+                      xcomps->AddChild( aSymbol );
+                  } );
+
+    return xcomps;
+}
+
+
+void NETLIST_EXPORTER_XML::visitSymbols( unsigned aCtl,
+                                         const std::function<void( XNODE* )>& aVisitor )
+{
     m_referencesAlreadyFound.Clear();
     m_libParts.clear();
 
@@ -304,8 +317,7 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // not always look best, but it will allow faster execution under XSL processing
             // systems which do sequential searching within an element.
 
-            XNODE* xcomp;  // current symbol being constructed
-            xcomps->AddChild( xcomp = node( wxT( "comp" ) ) );
+            XNODE* xcomp = node( wxT( "comp" ) );  // current symbol being constructed
 
             xcomp->AddAttribute( wxT( "ref" ), symbol->GetRef( &sheet ) );
             addSymbolFields( xcomp, symbol, &sheet );
@@ -383,7 +395,7 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
                 xproperty->AddAttribute( wxT( "name" ), wxT( "dnp" ) );
             }
 
-            if( const std::unique_ptr<LIB_SYMBOL>& part = symbol->GetLibSymbolRef() )
+            if( const std::shared_ptr<LIB_SYMBOL>& part = symbol->GetLibSymbolRef() )
             {
                 if( part->GetKeyWords().size() )
                 {
@@ -433,12 +445,12 @@ XNODE* NETLIST_EXPORTER_XML::makeSymbols( unsigned aCtl )
             // Output the primary UUID
             uuid = symbol->m_Uuid.AsString();
             xunits->AddChild( new XNODE( wxXML_TEXT_NODE, wxEmptyString, uuid ) );
+
+            aVisitor( xcomp );
         }
     }
 
     m_schematic->SetCurrentSheet( currentSheet );
-
-    return xcomps;
 }
 
 
@@ -667,7 +679,20 @@ XNODE* NETLIST_EXPORTER_XML::makeLibParts()
 
 XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
 {
-    XNODE*      xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
+    XNODE* xnets = node( wxT( "nets" ) );      // auto_ptr if exceptions ever get used.
+
+    visitNets( aCtl,
+               [&]( XNODE* aNet )
+               {
+                   xnets->AddChild( aNet );
+               } );
+
+    return xnets;
+}
+
+
+void NETLIST_EXPORTER_XML::visitNets( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor )
+{
     wxString    netCodeTxt;
     wxString    netName;
     wxString    ref;
@@ -808,7 +833,7 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
             {
                 netCodeTxt.Printf( wxT( "%d" ), i + 1 );
 
-                xnets->AddChild( xnet = node( wxT( "net" ) ) );
+                xnet = node( wxT( "net" ) );
                 xnet->AddAttribute( wxT( "code" ), netCodeTxt );
                 xnet->AddAttribute( wxT( "name" ), net_record->m_Name );
 
@@ -831,12 +856,13 @@ XNODE* NETLIST_EXPORTER_XML::makeListOfNets( unsigned aCtl )
 
             xnode->AddAttribute( wxT( "pintype" ), pinType );
         }
+
+        if( added )
+            aVisitor( xnet );
     }
 
     for( NET_RECORD* record : nets )
         delete record;
-
-    return xnets;
 }
 
 
@@ -26,6 +26,8 @@
 #ifndef NETLIST_EXPORT_XML_H
 #define NETLIST_EXPORT_XML_H
 
+#include <functional>
+
 #include <netlist_exporter_base.h>
 
 #include <project.h>
@@ -105,6 +107,13 @@ protected:
      */
     XNODE* makeSymbols( unsigned aCtl );
 
+    /**
+     * Build the nodes of the schematic symbols one at a time, as makeSymbols() does.
+     *
+     * @param aVisitor is called with each node, and takes ownership of it.
+     */
+    void visitSymbols( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor );
+
     /**
      * Fill out a project "design" header into an XML node.
      * @return the design header
@@ -123,6 +132,13 @@ protected:
      */
     XNODE* makeListOfNets( unsigned aCtl );
 
+    /**
+     * Build the nodes of the nets one at a time, as makeListOfNets() does.
+     *
+     * @param aVisitor is called with each node, and takes ownership of it.
+     */
+    void visitNets( unsigned aCtl, const std::function<void( XNODE* )>& aVisitor );
+
     /**
      * Fill out an XML node with a list of used libraries and returns it.
      * Must have called makeGenericLibParts() before this function.
@@ -78,6 +78,12 @@ SCH_DRAW_PANEL::SCH_DRAW_PANEL( wxWindow* aParentWindow, wxWindowID aWindowId,
     m_view->SetScaleLimits( ZOOM_MAX_LIMIT_EESCHEMA, ZOOM_MIN_LIMIT_EESCHEMA );
     m_view->SetMirror( false, false );
 
+    // Zoomed out beyond 25 um per pixel, texts are drawn with less detail
+    m_view->SetDetailPixelSize( schIUScale.mmToIU( 0.025 ) );
+
+    // Panning only draws the uncovered area when the GAL can move what it drew
+    m_view->UseScrollRedraw( true );
+
     // Early initialization of the canvas background color,
     // before any OnPaint event is fired for the canvas using a wrong bg color
     auto settings = m_painter->GetSettings();
@@ -118,6 +118,40 @@ LIB_SYMBOL* SCH_IO_DATABASE::LoadSymbol( const wxString&   aLibraryPath,
     if( !m_conn )
         THROW_IO_ERROR( m_lastError );
 
+    std::string                            symbolName;
+    std::vector<const DATABASE_LIB_TABLE*> tablesToTry = tablesForSymbol( aAliasName, symbolName );
+
+    if( tablesToTry.empty() )
+        return nullptr;
+
+    const DATABASE_LIB_TABLE* foundTable = nullptr;
+    DATABASE_CONNECTION::ROW result;
+
+    for( const DATABASE_LIB_TABLE* table : tablesToTry )
+    {
+        if( m_conn->SelectOne( table->table, std::make_pair( table->key_col, symbolName ),
+                               result ) )
+        {
+            foundTable = table;
+            wxLogTrace( traceDatabase, wxT( "LoadSymbol: SelectOne (%s, %s) found in %s" ),
+                        table->key_col, symbolName, table->table );
+        }
+        else
+        {
+            wxLogTrace( traceDatabase, wxT( "LoadSymbol: SelectOne (%s, %s) failed for table %s" ),
+                        table->key_col, symbolName, table->table );
+        }
+    }
+
+    wxCHECK( foundTable, nullptr );
+
+    return loadSymbolFromRow( aAliasName, *foundTable, result );
+}
+
+
+std::vector<const DATABASE_LIB_TABLE*>
+SCH_IO_DATABASE::tablesForSymbol( const wxString& aAliasName, std::string& aKey ) const
+{
     /*
      * Table names are tricky, in order to allow maximum flexibility to the user.
      * The slash character is used as a separator between a table name and symbol name, but symbol
@@ -128,12 +162,12 @@ LIB_SYMBOL* SCH_IO_DATABASE::LoadSymbol( const wxString&   aLibraryPath,
      */
 
     std::string tableName = "";
-    std::string symbolName( aAliasName.ToUTF8() );
+    aKey = std::string( aAliasName.ToUTF8() );
 
     if( aAliasName.Contains( '/' ) )
     {
         tableName = std::string( aAliasName.BeforeFirst( '/' ).ToUTF8() );
-        symbolName = std::string( aAliasName.AfterFirst( '/' ).ToUTF8() );
+        aKey = std::string( aAliasName.AfterFirst( '/' ).ToUTF8() );
     }
 
     std::vector<const DATABASE_LIB_TABLE*> tablesToTry;
@@ -146,32 +180,44 @@ LIB_SYMBOL* SCH_IO_DATABASE::LoadSymbol( const wxString&   aLibraryPath,
 
     if( tablesToTry.empty() )
     {
-        wxLogTrace( traceDatabase, wxT( "LoadSymbol: table '%s' not found in config" ), tableName );
-        return nullptr;
+        wxLogTrace( traceDatabase, wxT( "tablesForSymbol: table '%s' not found in config" ),
+                    tableName );
     }
 
-    const DATABASE_LIB_TABLE* foundTable = nullptr;
-    DATABASE_CONNECTION::ROW result;
+    return tablesToTry;
+}
 
-    for( const DATABASE_LIB_TABLE* table : tablesToTry )
+
+void SCH_IO_DATABASE::PrefetchSymbols( const wxString& aLibraryPath,
+                                       const std::vector<wxString>& aSymbolNames,
+                                       const STRING_UTF8_MAP* aProperties )
+{
+    wxCHECK_RET( m_libTable, "Database plugin missing library table handle!" );
+    ensureSettings( aLibraryPath );
+    ensureConnection();
+
+    if( !m_conn )
+        THROW_IO_ERROR( m_lastError );
+
+    // One query per table (and batch of keys) rather than one per symbol
+    std::map<const DATABASE_LIB_TABLE*, std::vector<std::string>> keysByTable;
+
+    for( const wxString& name : aSymbolNames )
     {
-        if( m_conn->SelectOne( table->table, std::make_pair( table->key_col, symbolName ),
-                               result ) )
-        {
-            foundTable = table;
-            wxLogTrace( traceDatabase, wxT( "LoadSymbol: SelectOne (%s, %s) found in %s" ),
-                        table->key_col, symbolName, table->table );
-        }
-        else
+        std::string key;
+
+        for( const DATABASE_LIB_TABLE* table : tablesForSymbol( name, key ) )
+            keysByTable[table].push_back( key );
+    }
+
+    for( const auto& [table, keys] : keysByTable )
+    {
+        if( !m_conn->SelectMany( table->table, table->key_col, keys ) )
         {
-            wxLogTrace( traceDatabase, wxT( "LoadSymbol: SelectOne (%s, %s) failed for table %s" ),
-                        table->key_col, symbolName, table->table );
+            wxLogTrace( traceDatabase, wxT( "PrefetchSymbols: prefetch from %s failed: %s" ),
+                        table->table, m_conn->GetLastError() );
         }
     }
-
-    wxCHECK( foundTable, nullptr );
-
-    return loadSymbolFromRow( aAliasName, *foundTable, result );
 }
 
 
@@ -64,6 +64,9 @@ public:
     LIB_SYMBOL* LoadSymbol( const wxString& aLibraryPath, const wxString& aAliasName,
                             const STRING_UTF8_MAP* aProperties = nullptr ) override;
 
+    void PrefetchSymbols( const wxString& aLibraryPath, const std::vector<wxString>& aSymbolNames,
+                          const STRING_UTF8_MAP* aProperties = nullptr ) override;
+
     bool SupportsSubLibraries() const override { return true; }
 
     void GetSubLibraryNames( std::vector<wxString>& aNames ) override;
@@ -91,6 +94,15 @@ private:
 
     void connect();
 
+    /**
+     * Split a symbol name into its table and key parts.
+     * @param aAliasName is the symbol name, optionally prefixed with a table name and a slash
+     * @param aKey will receive the value to look up in the key column
+     * @return the configured tables the symbol may come from
+     */
+    std::vector<const DATABASE_LIB_TABLE*> tablesForSymbol( const wxString& aAliasName,
+                                                            std::string& aKey ) const;
+
     LIB_SYMBOL* loadSymbolFromRow( const wxString& aSymbolName,
                                    const DATABASE_LIB_TABLE& aTable,
                                    const DATABASE_CONNECTION::ROW& aRow );
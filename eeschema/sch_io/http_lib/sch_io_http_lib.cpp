@@ -70,12 +70,10 @@ void SCH_IO_HTTP_LIB::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
             ( aProperties
               && aProperties->find( SYMBOL_LIB_TABLE::PropPowerSymsOnly ) != aProperties->end() );
 
-    for(const HTTP_LIB_CATEGORY& category : m_conn->getCategories() )
-    {
-        bool refresh_cache = true;
-
-        std::vector<HTTP_LIB_PART> found_parts;
+    std::vector<HTTP_LIB_CATEGORY> staleCategories;
 
+    for( const HTTP_LIB_CATEGORY& category : m_conn->getCategories() )
+    {
          // Check if there is already a part in our cache, if not fetch it
         if( m_cachedCategories.find( category.id ) != m_cachedCategories.end() )
         {
@@ -83,35 +81,48 @@ void SCH_IO_HTTP_LIB::EnumerateSymbolLib( std::vector<LIB_SYMBOL*>& aSymbolList,
             if( std::difftime( std::time( nullptr ), m_cachedCategories[category.id].lastCached )
                 < m_settings->m_Source.timeout_categories )
             {
-                refresh_cache = false;
+                continue;
             }
         }
 
-        if( refresh_cache )
+        staleCategories.push_back( category );
+    }
+
+    // Fetch all outdated categories at once so that the requests overlap
+    std::map<std::string, std::vector<HTTP_LIB_PART>> found_parts;
+
+    m_conn->SelectAll( staleCategories, found_parts );
+
+    for( const HTTP_LIB_CATEGORY& category : staleCategories )
+    {
+        auto it = found_parts.find( category.id );
+
+        if( it == found_parts.end() )
         {
-            if( !m_conn->SelectAll( category, found_parts ) )
+            if( !m_conn->GetLastError().empty() )
             {
-                if( !m_conn->GetLastError().empty() )
-                {
-                    wxString msg =
-                            wxString::Format( _( "Error retriving data from HTTP library %s: %s" ),
-                                              category.name, m_conn->GetLastError() );
-                    THROW_IO_ERROR( msg );
-                }
-
-                continue;
+                wxString msg =
+                        wxString::Format( _( "Error retriving data from HTTP library %s: %s" ),
+                                          category.name, m_conn->GetLastError() );
+                THROW_IO_ERROR( msg );
             }
 
-            // remove cached parts
-            m_cachedCategories[category.id].cachedParts.clear();
+            continue;
+        }
 
-            // Copy newly cached data across
-            m_cachedCategories[category.id].cachedParts = found_parts;
-            m_cachedCategories[category.id].lastCached = std::time( nullptr );
+        // Copy newly cached data across
+        m_cachedCategories[category.id].cachedParts = std::move( it->second );
+        m_cachedCategories[category.id].lastCached = std::time( nullptr );
+    }
 
-        }
+    for( const HTTP_LIB_CATEGORY& category : m_conn->getCategories() )
+    {
+        auto cachedIt = m_cachedCategories.find( category.id );
+
+        if( cachedIt == m_cachedCategories.end() )
+            continue;
 
-        for( const HTTP_LIB_PART& part : m_cachedCategories[category.id].cachedParts )
+        for( const HTTP_LIB_PART& part : cachedIt->second.cachedParts )
         {
             wxString libIDString( part.name );
 
@@ -143,14 +154,21 @@ LIB_SYMBOL* SCH_IO_HTTP_LIB::LoadSymbol( const wxString&        aLibraryPath,
     const HTTP_LIB_CATEGORY* foundCategory = nullptr;
     HTTP_LIB_PART            result;
 
-    std::vector<HTTP_LIB_CATEGORY> categories = m_conn->getCategories();
+    const std::vector<HTTP_LIB_CATEGORY>& categories = m_conn->getCategories();
+
+    // Look the part up rather than copying the whole cache, which holds every part of the library
+    const auto& cachedParts = m_conn->getCachedParts();
+    auto        relationIt = cachedParts.find( partName );
+
+    std::tuple<std::string, std::string> relations;
 
-    std::tuple relations = m_conn->getCachedParts()[partName];
+    if( relationIt != cachedParts.end() )
+        relations = relationIt->second;
 
     // get the matching category
     for( const HTTP_LIB_CATEGORY& categoryIter : categories )
     {
-        std::string associatedCatID = std::get<1>( relations );
+        const std::string& associatedCatID = std::get<1>( relations );
 
         if( categoryIter.id == associatedCatID )
         {
@@ -64,6 +64,7 @@
 #include <string_utils.h>
 #include <wx_filename.h>       // for ::ResolvePossibleSymlinks()
 #include <progress_reporter.h>
+#include <core/thread_pool.h>
 #include <boost/algorithm/string/join.hpp>
 
 using namespace TSCHEMATIC_T;
@@ -141,33 +142,45 @@ SCH_SHEET* SCH_IO_KICAD_SEXPR::LoadSchematicFile( const wxString& aFileName, SCH
     m_currentPath.push( m_path );
     init( aSchematic, aProperties );
 
-    if( aAppendToMe == nullptr )
+    try
     {
-        // Clean up any allocated memory if an exception occurs loading the schematic.
-        std::unique_ptr<SCH_SHEET> newSheet = std::make_unique<SCH_SHEET>( aSchematic );
+        if( aAppendToMe == nullptr )
+        {
+            // Clean up any allocated memory if an exception occurs loading the schematic.
+            std::unique_ptr<SCH_SHEET> newSheet = std::make_unique<SCH_SHEET>( aSchematic );
 
-        wxFileName relPath( aFileName );
+            wxFileName relPath( aFileName );
 
-        // Do not use wxPATH_UNIX as option in MakeRelativeTo(). It can create incorrect
-        // relative paths on Windows, because paths have a disk identifier (C:, D: ...)
-        relPath.MakeRelativeTo( aSchematic->Prj().GetProjectPath() );
+            // Do not use wxPATH_UNIX as option in MakeRelativeTo(). It can create incorrect
+            // relative paths on Windows, because paths have a disk identifier (C:, D: ...)
+            relPath.MakeRelativeTo( aSchematic->Prj().GetProjectPath() );
 
-        newSheet->SetFileName( relPath.GetFullPath() );
-        m_rootSheet = newSheet.get();
-        loadHierarchy( SCH_SHEET_PATH(), newSheet.get() );
+            newSheet->SetFileName( relPath.GetFullPath() );
+            m_rootSheet = newSheet.get();
+            loadHierarchy( SCH_SHEET_PATH(), newSheet.get() );
 
-        // If we got here, the schematic loaded successfully.
-        sheet = newSheet.release();
-        m_rootSheet = nullptr;         // Quiet Coverity warning.
+            // If we got here, the schematic loaded successfully.
+            sheet = newSheet.release();
+            m_rootSheet = nullptr;         // Quiet Coverity warning.
+        }
+        else
+        {
+            wxCHECK_MSG( aSchematic->IsValid(), nullptr,
+                         "Can't append to a schematic with no root!" );
+            m_rootSheet = &aSchematic->Root();
+            sheet = aAppendToMe;
+            loadHierarchy( SCH_SHEET_PATH(), sheet );
+        }
     }
-    else
+    catch( ... )
     {
-        wxCHECK_MSG( aSchematic->IsValid(), nullptr, "Can't append to a schematic with no root!" );
-        m_rootSheet = &aSchematic->Root();
-        sheet = aAppendToMe;
-        loadHierarchy( SCH_SHEET_PATH(), sheet );
+        // The prefetching tasks still refer to this plugin
+        clearPrefetchedSheets();
+        throw;
     }
 
+    clearPrefetchedSheets();
+
     wxASSERT( m_currentPath.size() == 1 );  // only the project path should remain
 
     m_currentPath.pop(); // Clear the path stack for next call to Load
@@ -274,6 +287,8 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
             SCH_SHEET_PATH currentSheetPath = aParentSheetPath;
             currentSheetPath.push_back( aSheet );
 
+            prefetchSheets( aSheet->GetScreen(), fileName.GetPath() );
+
             // This was moved out of the try{} block so that any sheet definitions that
             // the plugin fully parsed before the exception was raised will be loaded.
             for( SCH_ITEM* aItem : aSheet->GetScreen()->Items().OfType( SCH_SHEET_T ) )
@@ -294,9 +309,137 @@ void SCH_IO_KICAD_SEXPR::loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath,
 }
 
 
+void SCH_IO_KICAD_SEXPR::prefetchSheets( SCH_SCREEN* aScreen, const wxString& aPath )
+{
+    thread_pool& tp = GetKiCadThreadPool();
+
+    if( m_stopPrefetching )
+        return;
+
+    for( SCH_ITEM* item : aScreen->Items().OfType( SCH_SHEET_T ) )
+    {
+        wxFileName fileName = static_cast<SCH_SHEET*>( item )->GetFileName();
+
+        if( !fileName.IsAbsolute() )
+            fileName.MakeAbsolute( aPath );
+
+        wxString fullPath = fileName.GetFullPath();
+
+        if( !fileName.FileExists() )
+            continue;
+
+        std::lock_guard<std::mutex> lock( m_prefetchMutex );
+
+        // Sheets used more than once are only parsed once.  loadHierarchy() still looks for
+        // already loaded screens first, so a prefetched sheet may end up unused.
+        if( m_prefetchedSheets.count( fullPath ) )
+            continue;
+
+        m_prefetchedSheets[fullPath] = tp.submit(
+                [this, fileName, fullPath]() -> PREFETCHED_SHEET
+                {
+                    PREFETCHED_SHEET result;
+
+                    result.m_sheet = std::make_unique<SCH_SHEET>();
+                    result.m_sheet->SetScreen( new SCH_SCREEN( m_schematic ) );
+                    result.m_sheet->GetScreen()->SetFileName( fullPath );
+
+                    try
+                    {
+                        MAPPED_FILE_LINE_READER   reader( fullPath );
+                        SCH_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, 0, m_rootSheet,
+                                                          m_appending );
+
+                        parser.ParseSchematic( result.m_sheet.get() );
+                    }
+                    catch( ... )
+                    {
+                        result.m_exception = std::current_exception();
+                    }
+
+                    // Go on with the sub-sheets without waiting for loadHierarchy() to get here,
+                    // so that the whole hierarchy is parsed concurrently
+                    prefetchSheets( result.m_sheet->GetScreen(), fileName.GetPath() );
+
+                    return result;
+                } );
+    }
+}
+
+
+void SCH_IO_KICAD_SEXPR::clearPrefetchedSheets()
+{
+    // The pending tasks may still add their sub-sheets
+    m_stopPrefetching = true;
+
+    for( ;; )
+    {
+        std::future<PREFETCHED_SHEET> pending;
+
+        {
+            std::lock_guard<std::mutex> lock( m_prefetchMutex );
+
+            for( auto& [ fileName, prefetched ] : m_prefetchedSheets )
+            {
+                if( prefetched.valid() )
+                {
+                    pending = std::move( prefetched );
+                    break;
+                }
+            }
+        }
+
+        if( !pending.valid() )
+            break;
+
+        pending.get();
+    }
+
+    m_prefetchedSheets.clear();
+    m_stopPrefetching = false;
+}
+
+
 void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet )
 {
-    FILE_LINE_READER reader( aFileName );
+    std::future<PREFETCHED_SHEET> pending;
+
+    {
+        std::lock_guard<std::mutex> lock( m_prefetchMutex );
+        auto                        it = m_prefetchedSheets.find( aFileName );
+
+        // The entry is kept so that the sheet isn't prefetched again
+        if( it != m_prefetchedSheets.end() )
+            pending = std::move( it->second );
+    }
+
+    if( pending.valid() )
+    {
+        if( m_progressReporter )
+        {
+            m_progressReporter->Report( wxString::Format( _( "Loading %s..." ), aFileName ) );
+
+            if( !m_progressReporter->KeepRefreshing() )
+                THROW_IO_ERROR( _( "Open cancelled by user." ) );
+        }
+
+        PREFETCHED_SHEET prefetched = pending.get();
+        SCH_SCREEN*      screen = prefetched.m_sheet->GetScreen();
+
+        // The placeholder sheet only kept the screen alive until now
+        aSheet->SetScreen( screen );
+        prefetched.m_sheet.reset();
+
+        for( SCH_ITEM* item : screen->Items().OfType( SCH_SHEET_T ) )
+            item->SetParent( aSheet );
+
+        if( prefetched.m_exception )
+            std::rethrow_exception( prefetched.m_exception );
+
+        return;
+    }
+
+    MAPPED_FILE_LINE_READER reader( aFileName );
 
     size_t lineCount = 0;
 
@@ -307,10 +450,7 @@ void SCH_IO_KICAD_SEXPR::loadFile( const wxString& aFileName, SCH_SHEET* aSheet
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
-
-        reader.Rewind();
+        lineCount = reader.LineCount();
     }
 
     SCH_IO_KICAD_SEXPR_PARSER parser( &reader, m_progressReporter, lineCount, m_rootSheet,
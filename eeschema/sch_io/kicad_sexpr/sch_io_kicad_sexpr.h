@@ -23,7 +23,12 @@
 #ifndef SCH_IO_KICAD_SEXPR_H_
 #define SCH_IO_KICAD_SEXPR_H_
 
+#include <atomic>
+#include <exception>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sch_io/sch_io.h>
 #include <sch_io/sch_io_mgr.h>
 #include <sch_file_versions.h>
@@ -140,6 +145,18 @@ private:
     void loadHierarchy( const SCH_SHEET_PATH& aParentSheetPath, SCH_SHEET* aSheet );
     void loadFile( const wxString& aFileName, SCH_SHEET* aSheet );
 
+    /**
+     * Start parsing the files of the sub-sheets of \a aScreen on the thread pool, so that they
+     * are ready by the time loadHierarchy() descends into them.  Each parsed sheet prefetches
+     * its own sub-sheets in turn.  May be called from any thread.
+     *
+     * @param aPath is the path the sub-sheet file names are relative to.
+     */
+    void prefetchSheets( SCH_SCREEN* aScreen, const wxString& aPath );
+
+    /// Wait for and discard the sheets which were prefetched but never loaded.
+    void clearPrefetchedSheets();
+
     void saveSymbol( SCH_SYMBOL* aSymbol, const SCHEMATIC& aSchematic, int aNestLevel,
                      bool aForClipboard, const SCH_SHEET_PATH* aRelativePath = nullptr );
     void saveField( SCH_FIELD* aField, int aNestLevel );
@@ -173,6 +190,20 @@ protected:
     OUTPUTFORMATTER*        m_out;              ///< The formatter for saving SCH_SCREEN objects.
     SCH_IO_KICAD_SEXPR_LIB_CACHE* m_cache;
 
+    /// A sheet file parsed ahead of time into a placeholder sheet.
+    struct PREFETCHED_SHEET
+    {
+        std::unique_ptr<SCH_SHEET> m_sheet;
+        std::exception_ptr         m_exception;     ///< thrown while parsing, after which the
+                                                    ///<  screen holds what was parsed
+    };
+
+    /// Prefetched sheets by full file name.  The future of a sheet is no longer valid once the
+    /// sheet has been loaded.
+    std::map<wxString, std::future<PREFETCHED_SHEET>> m_prefetchedSheets;
+    std::mutex              m_prefetchMutex;
+    std::atomic<bool>       m_stopPrefetching = false;
+
     /// initialize PLUGIN like a constructor would.
     void init( SCHEMATIC* aSchematic, const STRING_UTF8_MAP* aProperties = nullptr );
 };
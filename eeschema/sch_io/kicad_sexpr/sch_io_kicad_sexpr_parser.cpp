@@ -592,24 +592,34 @@ LIB_ITEM* SCH_IO_KICAD_SEXPR_PARSER::ParseDrawItem()
 
 int SCH_IO_KICAD_SEXPR_PARSER::parseInternalUnits()
 {
-    auto retval = parseDouble() * schIUScale.IU_PER_MM;
-
     // Schematic internal units are represented as integers.  Any values that are
     // larger or smaller than the schematic units represent undefined behavior for
     // the system.  Limit values to the largest that can be displayed on the screen.
     constexpr double int_limit = std::numeric_limits<int>::max() * 0.7071; // 0.7071 = roughly 1/sqrt(2)
 
+    // Values written by KiCad have at most 4 decimals, which convert exactly to internal
+    // units in integer arithmetic
+    constexpr long long iuPerMM = static_cast<long long>( schIUScale.IU_PER_MM );
+    const std::string&  text = CurStr();
+    long long           value;
+
+    if( parseScaledDecimal( text.data(), text.data() + text.size(), iuPerMM, value ) )
+    {
+        constexpr long long limit = static_cast<long long>( int_limit );
+
+        return static_cast<int>( Clamp<long long>( -limit, value, limit ) );
+    }
+
+    auto retval = parseDouble() * schIUScale.IU_PER_MM;
+
     return KiROUND( Clamp<double>( -int_limit, retval, int_limit ) );
 }
 
 
 int SCH_IO_KICAD_SEXPR_PARSER::parseInternalUnits( const char* aExpected )
 {
-    auto retval = parseDouble( aExpected ) * schIUScale.IU_PER_MM;
-
-    constexpr double int_limit = std::numeric_limits<int>::max() * 0.7071;
-
-    return KiROUND( Clamp<double>( -int_limit, retval, int_limit ) );
+    NeedNUMBER( aExpected );
+    return parseInternalUnits();
 }
 
 
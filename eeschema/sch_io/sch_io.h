@@ -211,6 +211,29 @@ public:
     virtual LIB_SYMBOL* LoadSymbol( const wxString& aLibraryPath, const wxString& aPartName,
                                     const STRING_UTF8_MAP* aProperties = nullptr );
 
+    /**
+     * Tell the plugin that the symbols in \a aSymbolNames are about to be loaded one by one
+     * with LoadSymbol(), e.g. when a schematic is linked to its libraries.  Plugins for which
+     * each load is a round trip (e.g. database libraries) can fetch them all at once here.
+     *
+     * This is a no-op for plugins which don't benefit from it.
+     *
+     * @param aLibraryPath is a locator for the "library", usually a directory, file,
+     *                     or URL containing several symbols.
+     *
+     * @param aSymbolNames are the names of the #LIB_SYMBOLs which will be loaded.
+     *
+     * @param aProperties is an associative array that can be used to tell the loader
+     *                    implementation to do something special.  The caller continues to own
+     *                    this object, and plugins should expect it to be optionally NULL.
+     *
+     * @throw IO_ERROR if the library cannot be found or read.
+     */
+    virtual void PrefetchSymbols( const wxString& aLibraryPath,
+                                  const std::vector<wxString>& aSymbolNames,
+                                  const STRING_UTF8_MAP* aProperties = nullptr )
+    {}
+
     /**
      * Write \a aSymbol to an existing library located at \a aLibraryPath.  If a #LIB_SYMBOL
      * by the same name already exists or there are any conflicting alias names, the new
@@ -204,6 +204,34 @@ bool SCH_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
     return false;
 }
 
+
+bool SCH_PAINTER::HasDetailLevels( const VIEW_ITEM* aItem, int aLayer ) const
+{
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return false;
+
+    // Items drawing text, which the GAL may draw with less geometry when zoomed out
+    switch( item->Type() )
+    {
+    case SCH_TEXT_T:
+    case SCH_TEXTBOX_T:
+    case SCH_LABEL_T:
+    case SCH_GLOBAL_LABEL_T:
+    case SCH_HIER_LABEL_T:
+    case SCH_DIRECTIVE_LABEL_T:
+    case SCH_FIELD_T:
+    case SCH_SYMBOL_T:
+    case SCH_SHEET_T:
+    case SCH_SHEET_PIN_T:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
 void SCH_PAINTER::draw( const EDA_ITEM* aItem, int aLayer, bool aDimmed )
 {
 
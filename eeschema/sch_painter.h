@@ -138,6 +138,9 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM*, int ) override;
 
+    /// @copydoc PAINTER::HasDetailLevels()
+    bool HasDetailLevels( const VIEW_ITEM* aItem, int aLayer ) const override;
+
     /// @copydoc PAINTER::GetSettings()
     virtual SCH_RENDER_SETTINGS* GetSettings() override { return &m_schSettings; }
 
@@ -28,6 +28,7 @@
 #include <common.h>
 #include <sch_plotter.h>
 #include <locale_io.h>
+#include <core/thread_pool.h>
 #include <plotters/plotter_hpgl.h>
 #include <plotters/plotter_dxf.h>
 #include <plotters/plotters_pslike.h>
@@ -466,7 +467,6 @@ bool SCH_PLOTTER::plotOneSheetPS( const wxString& aFileName, SCH_SCREEN* aScreen
 void SCH_PLOTTER::createSVGFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
                                   RENDER_SETTINGS* aRenderSettings, REPORTER* aReporter )
 {
-    wxString       msg;
     SCH_SHEET_PATH oldsheetpath = m_schematic->CurrentSheet();
     SCH_SHEET_LIST sheetList;
 
@@ -487,64 +487,13 @@ void SCH_PLOTTER::createSVGFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
         sheetList.push_back( m_schematic->CurrentSheet() );
     }
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        SCH_SCREEN* screen;
-
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
-
-        screen = m_schematic->CurrentSheet().LastScreen();
-
-        try
-        {
-            wxString fname = m_schematic->GetUniqueFilenameForCurrentSheet();
-
-            // The sub sheet can be in a sub_hierarchy, but we plot the file in the
-            // main project folder (or the folder specified by the caller),
-            // so replace separators to create a unique filename:
-            fname.Replace( "/", "_" );
-            fname.Replace( "\\", "_" );
-            wxString   ext = SVG_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( aPlotSettings, fname, ext, aReporter );
-
-            m_lastOutputFilePath = plotFileName.GetFullPath();
-
-            if( !plotFileName.IsOk() )
-                return;
-
-            bool success = plotOneSheetSVG( plotFileName.GetFullPath(), screen, aRenderSettings,
-                                            aPlotSettings );
-
-            if( !success )
-            {
-                if( aReporter )
-                {
-                    msg.Printf( _( "Failed to create file '%s'." ), plotFileName.GetFullPath() );
-                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                }
-            }
-            else
-            {
-                if( aReporter )
-                {
-                    msg.Printf( _( "Plotted to '%s'." ), plotFileName.GetFullPath() );
-                    aReporter->Report( msg, RPT_SEVERITY_ACTION );
-                }
-            }
-        }
-        catch( const IO_ERROR& e )
-        {
-            if( aReporter )
-            {
-                // Cannot plot SVG file
-                msg.Printf( wxT( "SVG Plotter exception: %s" ), e.What() );
-                aReporter->Report( msg, RPT_SEVERITY_ERROR );
-            }
-            break;
-        }
-    }
+    plotSheetFiles( sheetList, aPlotSettings, aRenderSettings,
+                    SVG_PLOTTER::GetDefaultFileExtension(), wxT( "SVG" ), aReporter,
+                    [&]( const wxString& aFileName, SCH_SCREEN* aScreen,
+                         RENDER_SETTINGS* aSettings )
+                    {
+                        return plotOneSheetSVG( aFileName, aScreen, aSettings, aPlotSettings );
+                    } );
 
     if( aReporter )
     {
@@ -856,65 +805,14 @@ void SCH_PLOTTER::createDXFFiles( const SCH_PLOT_SETTINGS& aPlotSettings,
         sheetList.push_back( m_schematic->CurrentSheet() );
     }
 
-    for( unsigned i = 0; i < sheetList.size(); i++ )
-    {
-        m_schematic->SetCurrentSheet( sheetList[i] );
-        m_schematic->CurrentSheet().UpdateAllScreenReferences();
-        m_schematic->SetSheetNumberAndCount();
-
-        SCH_SCREEN* screen = m_schematic->CurrentSheet().LastScreen();
-        VECTOR2I    plot_offset;
-        wxString    msg;
-
-        try
-        {
-            wxString fname = m_schematic->GetUniqueFilenameForCurrentSheet();
-
-            // The sub sheet can be in a sub_hierarchy, but we plot the file in the
-            // main project folder (or the folder specified by the caller),
-            // so replace separators to create a unique filename:
-            fname.Replace( "/", "_" );
-            fname.Replace( "\\", "_" );
-            wxString   ext = DXF_PLOTTER::GetDefaultFileExtension();
-            wxFileName plotFileName = createPlotFileName( aPlotSettings, fname, ext, aReporter );
-
-            m_lastOutputFilePath = plotFileName.GetFullPath();
-
-            if( !plotFileName.IsOk() )
-                return;
-
-            if( plotOneSheetDXF( plotFileName.GetFullPath(), screen, aRenderSettings, plot_offset,
-                                 1.0, aPlotSettings ) )
-            {
-                if( aReporter )
-                {
-                    msg.Printf( _( "Plotted to '%s'." ), plotFileName.GetFullPath() );
-                    aReporter->Report( msg, RPT_SEVERITY_ACTION );
-                }
-            }
-            else // Error
-            {
-                if( aReporter )
-                {
-                    msg.Printf( _( "Failed to create file '%s'." ), plotFileName.GetFullPath() );
-                    aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                }
-            }
-        }
-        catch( IO_ERROR& e )
-        {
-            if( aReporter )
-            {
-                msg.Printf( wxT( "DXF Plotter exception: %s" ), e.What() );
-                aReporter->Report( msg, RPT_SEVERITY_ERROR );
-            }
-
-            m_schematic->SetCurrentSheet( oldsheetpath );
-            m_schematic->CurrentSheet().UpdateAllScreenReferences();
-            m_schematic->SetSheetNumberAndCount();
-            return;
-        }
-    }
+    plotSheetFiles( sheetList, aPlotSettings, aRenderSettings,
+                    DXF_PLOTTER::GetDefaultFileExtension(), wxT( "DXF" ), aReporter,
+                    [&]( const wxString& aFileName, SCH_SCREEN* aScreen,
+                         RENDER_SETTINGS* aSettings )
+                    {
+                        return plotOneSheetDXF( aFileName, aScreen, aSettings, VECTOR2I(), 1.0,
+                                                aPlotSettings );
+                    } );
 
     if( aReporter )
         aReporter->ReportTail( _( "Done." ), RPT_SEVERITY_INFO );
@@ -978,6 +876,144 @@ bool SCH_PLOTTER::plotOneSheetDXF( const wxString& aFileName, SCH_SCREEN* aScree
 }
 
 
+void SCH_PLOTTER::plotSheetFiles( const SCH_SHEET_LIST& aSheetList,
+                                  const SCH_PLOT_SETTINGS& aPlotSettings,
+                                  RENDER_SETTINGS* aRenderSettings, const wxString& aExtension,
+                                  const wxString& aFormatName, REPORTER* aReporter,
+                                  const std::function<bool( const wxString& aFileName,
+                                                            SCH_SCREEN* aScreen,
+                                                            RENDER_SETTINGS* aRenderSettings )>&
+                                          aPlotOneSheet )
+{
+    struct SHEET_FILE
+    {
+        SCH_SHEET_PATH m_sheet;
+        wxString       m_fileName;
+        bool           m_parallel = false;
+        bool           m_success = false;
+        wxString       m_error;
+    };
+
+    SCH_RENDER_SETTINGS*    schSettings = dynamic_cast<SCH_RENDER_SETTINGS*>( aRenderSettings );
+    std::vector<SHEET_FILE> files;
+    std::vector<size_t>     parallelFiles;
+    wxString                msg;
+
+    // Number the sheets, annotate their screens and build the file names first, as these
+    // change the schematic
+    for( const SCH_SHEET_PATH& sheet : aSheetList )
+    {
+        m_schematic->SetCurrentSheet( sheet );
+        m_schematic->CurrentSheet().UpdateAllScreenReferences();
+        m_schematic->SetSheetNumberAndCount();
+
+        SHEET_FILE file;
+
+        try
+        {
+            wxString fname = m_schematic->GetUniqueFilenameForCurrentSheet();
+
+            // The sub sheet can be in a sub_hierarchy, but we plot the file in the
+            // main project folder (or the folder specified by the caller),
+            // so replace separators to create a unique filename:
+            fname.Replace( "/", "_" );
+            fname.Replace( "\\", "_" );
+            wxFileName plotFileName = createPlotFileName( aPlotSettings, fname, aExtension,
+                                                          aReporter );
+
+            m_lastOutputFilePath = plotFileName.GetFullPath();
+
+            if( !plotFileName.IsOk() )
+                break;
+
+            file.m_fileName = plotFileName.GetFullPath();
+        }
+        catch( const IO_ERROR& e )
+        {
+            if( aReporter )
+            {
+                msg.Printf( wxT( "%s Plotter exception: %s" ), aFormatName, e.What() );
+                aReporter->Report( msg, RPT_SEVERITY_ERROR );
+            }
+
+            break;
+        }
+
+        file.m_sheet = m_schematic->CurrentSheet();
+        file.m_parallel = schSettings && file.m_sheet.LastScreen()->GetRefCount() == 1;
+
+        if( file.m_parallel )
+            parallelFiles.push_back( files.size() );
+
+        files.push_back( file );
+    }
+
+    auto plotFile =
+            [&]( SHEET_FILE& aFile, RENDER_SETTINGS* aSettings )
+            {
+                try
+                {
+                    aFile.m_success = aPlotOneSheet( aFile.m_fileName, aFile.m_sheet.LastScreen(),
+                                                     aSettings );
+                }
+                catch( const IO_ERROR& e )
+                {
+                    aFile.m_error = e.What();
+                }
+            };
+
+    if( !parallelFiles.empty() )
+    {
+        // The locale is process wide, so switch it once for all the threads
+        LOCALE_IO toggle;
+
+        ParallelFor( parallelFiles.size(),
+                     [&]( size_t aIndex )
+                     {
+                         SHEET_FILE&             file = files[parallelFiles[aIndex]];
+                         SCH_RENDER_SETTINGS     settings( *schSettings );
+                         SCHEMATIC::THREAD_SHEET threadSheet( m_schematic, &file.m_sheet );
+
+                         plotFile( file, &settings );
+                     } );
+    }
+
+    for( SHEET_FILE& file : files )
+    {
+        if( file.m_parallel )
+            continue;
+
+        m_schematic->SetCurrentSheet( file.m_sheet );
+        m_schematic->CurrentSheet().UpdateAllScreenReferences();
+        m_schematic->SetSheetNumberAndCount();
+
+        plotFile( file, aRenderSettings );
+    }
+
+    if( !aReporter )
+        return;
+
+    for( const SHEET_FILE& file : files )
+    {
+        if( !file.m_error.IsEmpty() )
+        {
+            msg.Printf( wxT( "%s Plotter exception: %s" ), aFormatName, file.m_error );
+            aReporter->Report( msg, RPT_SEVERITY_ERROR );
+        }
+        else if( file.m_success )
+        {
+            msg.Printf( _( "Plotted to '%s'." ), file.m_fileName );
+            aReporter->Report( msg, RPT_SEVERITY_ACTION );
+        }
+        else
+        {
+            msg.Printf( _( "Failed to create file '%s'." ), file.m_fileName );
+            aReporter->Report( msg, RPT_SEVERITY_ERROR );
+        }
+    }
+}
+
+
 void SCH_PLOTTER::restoreEnvironment( PDF_PLOTTER* aPlotter, SCH_SHEET_PATH& aOldsheetpath )
 {
     if( aPlotter )
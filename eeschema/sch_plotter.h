@@ -27,6 +27,8 @@
 #ifndef SCH_PLOTTER_H
 #define SCH_PLOTTER_H
 
+#include <functional>
+
 #include <wx/string.h>
 #include <wx/gdicmn.h>
 #include <page_info.h>
@@ -192,6 +194,24 @@ protected:
                           RENDER_SETTINGS*         aRenderSettings,
                           const SCH_PLOT_SETTINGS& aPlotSettings );
 
+    /**
+     * Plot each sheet of a list to its own file, for the formats with a file per sheet.
+     *
+     * The sheets whose screen is used by no other sheet are plotted in parallel, each thread
+     * seeing its own sheet as the current sheet and using its own copy of the render settings.
+     * The sheets of shared screens are plotted afterwards one at a time, as their symbol
+     * references depend on the sheet being plotted.
+     *
+     * @param aPlotOneSheet plots a sheet to a file, the sheet being the current sheet.
+     */
+    void plotSheetFiles( const SCH_SHEET_LIST& aSheetList, const SCH_PLOT_SETTINGS& aPlotSettings,
+                         RENDER_SETTINGS* aRenderSettings, const wxString& aExtension,
+                         const wxString& aFormatName, REPORTER* aReporter,
+                         const std::function<bool( const wxString& aFileName,
+                                                   SCH_SCREEN* aScreen,
+                                                   RENDER_SETTINGS* aRenderSettings )>&
+                                 aPlotOneSheet );
+
     /**
      * Everything done, close the plot and restore the environment.
      *
@@ -33,7 +33,9 @@
 
 #include <wx/regex.h>
 #include <algorithm>
+#include <map>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <string_utils.h>
@@ -304,41 +306,6 @@ std::vector<SCH_SYMBOL_INSTANCE> SCH_REFERENCE_LIST::GetSymbolInstances() const
 }
 
 
-int SCH_REFERENCE_LIST::createFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue )
-{
-    int expectedId = aFirstValue;
-
-    // We search for expected Id a value >= aFirstValue.
-    // Skip existing Id < aFirstValue
-    unsigned ii = 0;
-
-    for( ; ii < aIdList.size(); ii++ )
-    {
-        if( expectedId <= aIdList[ii] )
-            break;
-    }
-
-    // Ids are sorted by increasing value, from aFirstValue
-    // So we search from aFirstValue the first not used value, i.e. the first hole in list.
-    for( ; ii < aIdList.size(); ii++ )
-    {
-        if( expectedId != aIdList[ii] )    // This id is not yet used.
-        {
-            // Insert this free Id, in order to keep list sorted
-            aIdList.insert( aIdList.begin() + ii, expectedId );
-            return expectedId;
-        }
-
-        expectedId++;
-    }
-
-    // All existing Id are tested, and all values are found in use.
-    // So Create a new one.
-    aIdList.push_back( expectedId );
-    return expectedId;
-}
-
-
 // A helper function to build a full reference string of a SCH_REFERENCE item
 wxString buildFullReference( const SCH_REFERENCE& aItem, int aUnitNumber = -1 )
 {
@@ -479,6 +446,126 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         AddItem( additionalRef ); //add to this container
     }
 
+    // Index the references by symbol instance and the reference numbers in use by prefix, so
+    // that annotating a reference doesn't go through the whole list.  The index entries of a
+    // reference are left behind when its number changes, so they are checked when used.
+    typedef std::pair<SCH_SYMBOL*, KIID_PATH>                INSTANCE_KEY;
+    typedef std::map<int, std::vector<unsigned>>             REF_NUMBERS;
+
+    std::map<INSTANCE_KEY, std::vector<unsigned>>            instances;
+    std::map<INSTANCE_KEY, SCH_REFERENCE_LIST*>              lockedLists;
+    std::unordered_map<wxString, REF_NUMBERS>                refNumbers;
+
+    // Where to start looking for a free number.  The first free number can only increase as
+    // references get annotated, until a number or a unit gets changed back and forth.
+    std::unordered_map<wxString, int>                        searchHints;
+
+    auto instanceKey =
+            []( const SCH_REFERENCE& aRef )
+            {
+                return INSTANCE_KEY( aRef.GetSymbol(), aRef.GetSheetPath().Path() );
+            };
+
+    auto addRefNumber =
+            [&]( unsigned aIndex )
+            {
+                const SCH_REFERENCE& ref = m_flatList[aIndex];
+                refNumbers[ref.m_ref.Lower()][ref.m_numRef].push_back( aIndex );
+            };
+
+    auto isUsing =
+            [&]( unsigned aIndex, int aNumber )
+            {
+                return !m_flatList[aIndex].m_isNew && m_flatList[aIndex].m_numRef == aNumber;
+            };
+
+    // The first number from aMinValue which GetRefsInUse() doesn't list
+    auto firstFreeRefId =
+            [&]( const SCH_REFERENCE& aRef, int aMinValue ) -> int
+            {
+                wxString     prefix = aRef.m_ref.Lower();
+                REF_NUMBERS& numbers = refNumbers[prefix];
+                int&         hint = searchHints[wxString::Format( wxS( "%s|%d" ), prefix,
+                                                                  aMinValue )];
+
+                for( int id = std::max( hint, aMinValue ); ; ++id )
+                {
+                    auto it = numbers.find( id );
+
+                    if( it == numbers.end()
+                            || std::none_of( it->second.begin(), it->second.end(),
+                                             [&]( unsigned aIndex )
+                                             {
+                                                 return isUsing( aIndex, id );
+                                             } ) )
+                    {
+                        hint = id;
+                        return id;
+                    }
+                }
+            };
+
+    // Same as FindFirstUnusedReference()
+    auto firstUnusedReference =
+            [&]( const SCH_REFERENCE& aRef, int aMinValue,
+                 const std::vector<int>& aRequiredUnits ) -> int
+            {
+                wxString     prefix = aRef.m_ref.Lower();
+                REF_NUMBERS& numbers = refNumbers[prefix];
+                wxString     hintKey = wxString::Format( wxS( "%s|%d|%s|%s" ), prefix, aMinValue,
+                                                         aRef.m_rootSymbol->GetLibId().Format(),
+                                                         aRef.m_value );
+
+                for( int unit : aRequiredUnits )
+                    hintKey << wxS( "|" ) << unit;
+
+                int& hint = searchHints[hintKey];
+
+                for( int number = std::max( hint, aMinValue ); ; ++number )
+                {
+                    auto it = numbers.find( number );
+                    bool used = false;
+                    bool conflict = false;
+
+                    if( it != numbers.end() )
+                    {
+                        for( unsigned index : it->second )
+                        {
+                            if( !isUsing( index, number ) )
+                                continue;
+
+                            const SCH_REFERENCE& ref = m_flatList[index];
+
+                            used = true;
+                            conflict |= !aRequiredUnits.empty()
+                                        && ( ref.CompareLibName( aRef ) || ref.CompareValue( aRef )
+                                             || alg::contains( aRequiredUnits, ref.GetUnit() ) );
+                        }
+                    }
+
+                    if( !used || !conflict )
+                    {
+                        hint = number;
+                        return number;
+                    }
+                }
+            };
+
+    for( unsigned ii = 0; ii < m_flatList.size(); ii++ )
+    {
+        instances[instanceKey( m_flatList[ii] )].push_back( ii );
+
+        if( !m_flatList[ii].m_isNew )
+            addRefNumber( ii );
+    }
+
+    // The first list holding an instance wins, as when searching the map in order
+    for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned thisRefI = 0; thisRefI < pair.second.GetCount(); ++thisRefI )
+            lockedLists.emplace( instanceKey( pair.second[thisRefI] ), &pair.second );
+    }
+
     int LastReferenceNumber = 0;
 
     /* calculate index of the first symbol with the same reference prefix
@@ -507,25 +594,10 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         // Check whether this symbol is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = nullptr;
+        auto                lockedIt = lockedLists.find( instanceKey( ref_unit ) );
 
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
-        {
-            unsigned n_refs = pair.second.GetCount();
-
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
-            {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( ref_unit ) )
-                {
-                    lockedList = &pair.second;
-                    break;
-                }
-            }
-
-            if( lockedList != nullptr )
-                break;
-        }
+        if( lockedIt != lockedLists.end() )
+            lockedList = lockedIt->second;
 
         if(  ( m_flatList[first].CompareRef( ref_unit ) != 0 )
           || ( aUseSheetNum && ( m_flatList[first].m_sheetNum != ref_unit.m_sheetNum ) )  )
@@ -551,15 +623,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         {
             if( ref_unit.m_isNew )
             {
-                std::vector<int> idList;
-                GetRefsInUse( first, idList, minRefId );
-                LastReferenceNumber = createFirstFreeRefId( idList, minRefId );
+                LastReferenceNumber = firstFreeRefId( ref_unit, minRefId );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = wxString::Format( "%d", LastReferenceNumber );
+                ref_unit.m_isNew = false;
+                addRefNumber( ii );
             }
 
             ref_unit.m_flag  = 1;
-            ref_unit.m_isNew = false;
             continue;
         }
 
@@ -572,11 +643,12 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
             if( ref_unit.m_isNew )
             {
-                LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+                LastReferenceNumber = firstUnusedReference( ref_unit, minRefId, units );
                 ref_unit.m_numRef = LastReferenceNumber;
                 ref_unit.m_numRefStr = wxString::Format( "%d", LastReferenceNumber );
                 ref_unit.m_isNew = false;
                 ref_unit.m_flag = 1;
+                addRefNumber( ii );
             }
 
             for( unsigned lockedRefI = 0; lockedRefI < n_refs; ++lockedRefI )
@@ -586,6 +658,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                 if( lockedRef.IsSameInstance( ref_unit ) )
                 {
                     // This is the symbol we're currently annotating. Hold the unit!
+                    if( ref_unit.m_unit != lockedRef.m_unit )
+                        searchHints.clear();
+
                     ref_unit.m_unit = lockedRef.m_unit;
 
                     // lock this new full reference
@@ -599,9 +674,14 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching symbol
-                for( unsigned jj = ii + 1; jj < m_flatList.size(); jj++ )
+                auto instanceIt = instances.find( instanceKey( lockedRef ) );
+
+                if( instanceIt == instances.end() )
+                    continue;
+
+                for( unsigned jj : instanceIt->second )
                 {
-                    if( !lockedRef.IsSameInstance( m_flatList[jj] ) )
+                    if( jj <= ii )
                         continue;
 
                     wxString ref_candidate = buildFullReference( ref_unit, lockedRef.m_unit );
@@ -611,10 +691,17 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     // multiunits symbols have duplicate references)
                     if( inUseRefs.find( ref_candidate ) == inUseRefs.end() )
                     {
+                        // Its previous number may be free again
+                        SCH_REFERENCE& other = m_flatList[jj];
+
+                        if( !other.m_isNew && other.m_numRef != ref_unit.m_numRef )
+                            searchHints.clear();
+
                         m_flatList[jj].m_numRef = ref_unit.m_numRef;
                         m_flatList[jj].m_numRefStr = ref_unit.m_numRefStr;
                         m_flatList[jj].m_isNew = false;
                         m_flatList[jj].m_flag = 1;
+                        addRefNumber( jj );
 
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
@@ -629,10 +716,11 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             // know what group this might belong to, so just find the first unused reference for
             // this specific unit. The other units will be annotated in the following passes.
             std::vector<int> units = { ref_unit.GetUnit() };
-            LastReferenceNumber = FindFirstUnusedReference( ref_unit, minRefId, units );
+            LastReferenceNumber = firstUnusedReference( ref_unit, minRefId, units );
             ref_unit.m_numRef = LastReferenceNumber;
             ref_unit.m_isNew = false;
             ref_unit.m_flag = 1;
+            addRefNumber( ii );
         }
     }
 
@@ -605,20 +605,6 @@ private:
 
     static bool sortByReferenceOnly( const SCH_REFERENCE& item1, const SCH_REFERENCE& item2 );
 
-    /**
-     * Search for the first free reference number in \a aListId of reference numbers in use.
-     *
-     * This function just searches for a hole in a list of incremented numbers, this list must
-     * be sorted by increasing values and each value can be stored only once.  The new value
-     * is added to the list.
-     *
-     * @see BuildRefIdInUseList to prepare this list
-     * @param aIdList The buffer that contains the reference numbers in use.
-     * @param aFirstValue The first expected free value
-     * @return The first free (not yet used) value.
-     */
-    static int createFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue );
-
     // Used for sorting static sortByTimeStamp function
     friend class BACK_ANNOTATE;
 
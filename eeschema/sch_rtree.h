@@ -27,6 +27,7 @@
 
 #include <core/typeinfo.h>
 #include <sch_item.h>
+#include <initializer_list>
 #include <set>
 #include <vector>
 
@@ -71,6 +72,42 @@ public:
         m_count++;
     }
 
+    /**
+     * Replace the contents of the tree with \a aItems.  The tree is built in one pass, which
+     * is much faster than inserting the items one by one and gives faster queries.
+     */
+    void assign( const std::vector<SCH_ITEM*>& aItems )
+    {
+        std::vector<std::pair<ee_rtree::Rect, SCH_ITEM*>> entries;
+
+        entries.reserve( aItems.size() );
+
+        for( SCH_ITEM* item : aItems )
+        {
+            BOX2I bbox = item->GetBoundingBox();
+
+            // Inflate a bit for safety, selection shadows, etc.
+            bbox.Inflate( item->GetPenWidth() );
+
+            const int type = int( item->Type() );
+
+            entries.push_back( { { { type, bbox.GetX(), bbox.GetY() },
+                                   { type, bbox.GetRight(), bbox.GetBottom() } },
+                                 item } );
+        }
+
+        m_tree->BulkLoad( entries );
+        m_count = aItems.size();
+    }
+
+    /**
+     * Rebuild the tree from its own items, picking up any change to their bounding boxes.
+     */
+    void rebuild()
+    {
+        assign( std::vector<SCH_ITEM*>( m_tree->begin(), m_tree->end() ) );
+    }
+
     /**
      * Remove an item from the tree. Removal is done by comparing pointers, attempting
      * to remove a copy of the item will fail.
@@ -235,11 +272,115 @@ public:
         }
     };
 
+    /**
+     * The #EE_TYPES struct is the #EE_TYPE of several types.  The tree is searched for each
+     * type in turn, without collecting the items in a temporary container:
+     *
+     * for( SCH_ITEM* item : rtree.OfType( { SCH_JUNCTION_T, SCH_NO_CONNECT_T } ) )
+     *
+     * The types must be distinct, or the items of the repeated types are returned again.
+     */
+    struct EE_TYPES
+    {
+        class iterator
+        {
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef SCH_ITEM*                 value_type;
+            typedef ptrdiff_t                 difference_type;
+            typedef SCH_ITEM**                pointer;
+            typedef SCH_ITEM*&                reference;
+
+            iterator( const EE_TYPES* aTypes, size_t aIndex ) :
+                    m_types( aTypes ),
+                    m_index( aIndex )
+            {
+                if( m_index < m_types->m_rects.size() )
+                {
+                    m_it = m_types->m_tree->begin( m_types->m_rects[m_index] );
+                    nextType();
+                }
+            }
+
+            SCH_ITEM*& operator*() { return *m_it; }
+
+            iterator& operator++()
+            {
+                ++m_it;
+                nextType();
+                return *this;
+            }
+
+            bool operator==( const iterator& aOther ) const
+            {
+                return m_index == aOther.m_index && m_it == aOther.m_it;
+            }
+
+            bool operator!=( const iterator& aOther ) const { return !( *this == aOther ); }
+
+        private:
+            /// Move on to the next type with items when the current type has no more of them
+            void nextType()
+            {
+                while( m_index < m_types->m_rects.size() && m_it == m_types->m_tree->end() )
+                {
+                    if( ++m_index < m_types->m_rects.size() )
+                        m_it = m_types->m_tree->begin( m_types->m_rects[m_index] );
+                }
+            }
+
+            const EE_TYPES*    m_types;
+            size_t             m_index;
+            ee_rtree::Iterator m_it;
+        };
+
+        EE_TYPES( ee_rtree* aTree, std::initializer_list<KICAD_T> aTypes ) :
+                m_tree( aTree )
+        {
+            for( KICAD_T type : aTypes )
+                m_rects.push_back( EE_TYPE( aTree, type ).m_rect );
+        }
+
+        EE_TYPES( ee_rtree* aTree, std::initializer_list<KICAD_T> aTypes, const BOX2I& aRect ) :
+                m_tree( aTree )
+        {
+            for( KICAD_T type : aTypes )
+                m_rects.push_back( EE_TYPE( aTree, type, aRect ).m_rect );
+        }
+
+        iterator begin() const { return iterator( this, 0 ); }
+        iterator end() const { return iterator( this, m_rects.size() ); }
+
+        bool empty() const { return begin() == end(); }
+
+    private:
+        ee_rtree*                   m_tree;
+        std::vector<ee_rtree::Rect> m_rects;
+    };
+
     EE_TYPE OfType( KICAD_T aType ) const
     {
         return EE_TYPE( m_tree, aType );
     }
 
+    EE_TYPES OfType( std::initializer_list<KICAD_T> aTypes ) const
+    {
+        return EE_TYPES( m_tree, aTypes );
+    }
+
+    EE_TYPES Overlapping( std::initializer_list<KICAD_T> aTypes, const BOX2I& aRect ) const
+    {
+        return EE_TYPES( m_tree, aTypes, aRect );
+    }
+
+    EE_TYPES Overlapping( std::initializer_list<KICAD_T> aTypes, const VECTOR2I& aPoint,
+                          int aAccuracy = 0 ) const
+    {
+        BOX2I rect( aPoint, VECTOR2I( 0, 0 ) );
+        rect.Inflate( aAccuracy );
+        return EE_TYPES( m_tree, aTypes, rect );
+    }
+
     EE_TYPE Overlapping( const BOX2I& aRect ) const
     {
         return EE_TYPE( m_tree, SCH_LOCATE_ANY_T, aRect );
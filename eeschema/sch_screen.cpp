@@ -198,6 +198,9 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem, bool aUpdateLibSymbol )
 
                             wxCHECK2( foundSymbol, continue );
 
+                            // The name is only changed in this symbol's copy
+                            symbol->UnshareLibSymbol();
+
                             wxString tmp = symbol->GetLibSymbolRef()->GetName();
 
                             // Temporarily update the new symbol library symbol name so it
@@ -899,6 +902,20 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
     // Clear all existing symbol links.
     clearLibSymbols();
 
+    // Let libraries needing a round trip per symbol (e.g. databases) fetch them all at once
+    std::vector<LIB_ID> libIds;
+
+    for( SCH_SYMBOL* symbol : symbols )
+    {
+        if( m_libSymbols.find( symbol->GetSchSymbolLibraryName() ) == m_libSymbols.end() )
+            libIds.push_back( symbol->GetLibId() );
+    }
+
+    libs->PrefetchSymbols( libIds );
+
+    // Symbols of the same library symbol share a single flattened copy of it
+    std::map<wxString, std::shared_ptr<LIB_SYMBOL>> sharedLibSymbols;
+
     for( SCH_SYMBOL* symbol : symbols )
     {
         LIB_SYMBOL* tmp = nullptr;
@@ -919,7 +936,12 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
             }
 
             // Internal library symbols are already flattened so just make a copy.
-            symbol->SetLibSymbol( new LIB_SYMBOL( *it->second ) );
+            std::shared_ptr<LIB_SYMBOL>& shared = sharedLibSymbols[it->first];
+
+            if( !shared )
+                shared = std::make_shared<LIB_SYMBOL>( *it->second );
+
+            symbol->ShareLibSymbol( shared );
             continue;
         }
 
@@ -1022,7 +1044,12 @@ void SCH_SCREEN::UpdateSymbolLinks( REPORTER* aReporter )
         }
 
         if( libSymbol.get() )   // Only change the old link if the new link exists
-            symbol->SetLibSymbol( libSymbol.release() );
+        {
+            std::shared_ptr<LIB_SYMBOL> shared( libSymbol.release() );
+
+            sharedLibSymbols[symbol->GetSchSymbolLibraryName()] = shared;
+            symbol->ShareLibSymbol( shared );
+        }
     }
 
     // Changing the symbol may adjust the bbox of the symbol.  This re-inserts the
@@ -1039,22 +1066,32 @@ void SCH_SCREEN::UpdateLocalLibSymbolLinks()
     for( SCH_ITEM* item : Items().OfType( SCH_SYMBOL_T ) )
         symbols.push_back( static_cast<SCH_SYMBOL*>( item ) );
 
+    // Symbols of the same library symbol share a single copy of it
+    std::map<wxString, std::shared_ptr<LIB_SYMBOL>> sharedLibSymbols;
+
     for( SCH_SYMBOL* symbol : symbols )
     {
-        // Changing the symbol may adjust the bbox of the symbol; remove and reinsert it afterwards.
-        m_rtree.remove( symbol );
-
         auto it = m_libSymbols.find( symbol->GetSchSymbolLibraryName() );
 
-        LIB_SYMBOL* libSymbol = nullptr;
+        std::shared_ptr<LIB_SYMBOL> libSymbol;
 
         if( it != m_libSymbols.end() )
-            libSymbol = new LIB_SYMBOL( *it->second );
+        {
+            std::shared_ptr<LIB_SYMBOL>& shared = sharedLibSymbols[it->first];
 
-        symbol->SetLibSymbol( libSymbol );
+            if( !shared )
+                shared = std::make_shared<LIB_SYMBOL>( *it->second );
 
-        m_rtree.insert( symbol );
+            libSymbol = shared;
+        }
+
+        symbol->ShareLibSymbol( libSymbol );
     }
+
+    // Changing the symbols may adjust their bboxes.  Rebuilding the whole tree at once is
+    // much faster than removing and reinserting them one by one, which has to search the
+    // whole tree for each symbol whose bbox changed.
+    m_rtree.rebuild();
 }
 
 
@@ -1324,10 +1361,11 @@ void SCH_SCREEN::EnsureAlternateReferencesExist()
 
 void SCH_SCREEN::GetHierarchicalItems( std::vector<SCH_ITEM*>* aItems ) const
 {
-    for( SCH_ITEM* item : Items() )
+    for( SCH_ITEM* item : Items().OfType( { SCH_SYMBOL_T, SCH_SHEET_T, SCH_LABEL_T,
+                                           SCH_GLOBAL_LABEL_T, SCH_HIER_LABEL_T,
+                                           SCH_DIRECTIVE_LABEL_T } ) )
     {
-        if( item->IsType( { SCH_SYMBOL_T, SCH_SHEET_T, SCH_LABEL_LOCATE_ANY_T } ) )
-            aItems->push_back( item );
+        aItems->push_back( item );
     }
 }
 
@@ -1379,18 +1417,31 @@ void SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath,
                 }
             };
 
+    // An item can only connect to the items overlapping it, so each one is tested against the
+    // end points of its neighbours in the R-tree rather than against every end point of the
+    // screen.  The children of an item lie within its bounding box and share its neighbours.
     for( SCH_ITEM* item : Items() )
     {
+        if( !item->IsConnectable() )
+            continue;
 
-        getends( item );
-        item->RunOnChildren( getends );
-    }
+        BOX2I area = item->GetBoundingBox();
+
+        // Labels are hit-tested against wires with an accuracy of 1
+        area.Inflate( 1 );
+
+        endPoints.clear();
+
+        for( SCH_ITEM* neighbor : Items().Overlapping( area ) )
+        {
+            getends( neighbor );
+            neighbor->RunOnChildren( getends );
+        }
 
-    for( SCH_ITEM* item : Items() )
-    {
         update_state( item );
         item->RunOnChildren( update_state );
     }
+
     if( wxLog::IsAllowedTraceMask( DanglingProfileMask ) )
         timer.Show();
 }
@@ -194,8 +194,9 @@ SCH_SYMBOL::SCH_SYMBOL( const SCH_SYMBOL& aSymbol ) :
         m_pins.back()->SetParent( this );
     }
 
+    // The flattened library symbol is never changed in place, so the copy can share it
     if( aSymbol.m_part )
-        SetLibSymbol( new LIB_SYMBOL( *aSymbol.m_part ) );
+        ShareLibSymbol( aSymbol.m_part );
 
     m_fieldsAutoplaced = aSymbol.m_fieldsAutoplaced;
     m_schLibSymbolName = aSymbol.m_schLibSymbolName;
@@ -308,6 +309,25 @@ void SCH_SYMBOL::SetLibSymbol( LIB_SYMBOL* aLibSymbol )
 }
 
 
+void SCH_SYMBOL::ShareLibSymbol( const std::shared_ptr<LIB_SYMBOL>& aLibSymbol )
+{
+    wxCHECK( !aLibSymbol || aLibSymbol->IsRoot(), /* void */ );
+
+    m_part = aLibSymbol;
+    UpdatePins();
+}
+
+
+void SCH_SYMBOL::UnshareLibSymbol()
+{
+    if( m_part && m_part.use_count() > 1 )
+    {
+        m_part = std::make_shared<LIB_SYMBOL>( *m_part );
+        UpdatePins();
+    }
+}
+
+
 wxString SCH_SYMBOL::GetDescription() const
 {
     if( m_part )
@@ -1219,10 +1239,8 @@ void SCH_SYMBOL::SwapData( SCH_ITEM* aItem )
     for( std::unique_ptr<SCH_PIN>& pin : m_pins )
         pin->SetParent( this );
 
-    LIB_SYMBOL* libSymbol = symbol->m_part.release();
-    symbol->m_part = std::move( m_part );
+    std::swap( m_part, symbol->m_part );
     symbol->UpdatePins();
-    m_part.reset( libSymbol );
     UpdatePins();
 
     std::swap( m_pos, symbol->m_pos );
@@ -2291,9 +2309,7 @@ SCH_SYMBOL& SCH_SYMBOL::operator=( const SCH_ITEM& aItem )
 
         m_lib_id    = c->m_lib_id;
 
-        LIB_SYMBOL* libSymbol = c->m_part ? new LIB_SYMBOL( *c->m_part.get() ) : nullptr;
-
-        m_part.reset( libSymbol );
+        m_part      = c->m_part;
         m_pos       = c->m_pos;
         m_unit      = c->m_unit;
         m_bodyStyle = c->m_bodyStyle;
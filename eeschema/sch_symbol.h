@@ -219,8 +219,12 @@ public:
     wxString GetSchSymbolLibraryName() const;
     bool UseLibIdLookup() const { return m_schLibSymbolName.IsEmpty(); }
 
-    std::unique_ptr< LIB_SYMBOL >& GetLibSymbolRef() { return m_part; }
-    const std::unique_ptr< LIB_SYMBOL >& GetLibSymbolRef() const { return m_part; }
+    /**
+     * The library symbol may be shared with other schematic symbols, so it must not be changed
+     * without calling UnshareLibSymbol() first.
+     */
+    std::shared_ptr< LIB_SYMBOL >& GetLibSymbolRef() { return m_part; }
+    const std::shared_ptr< LIB_SYMBOL >& GetLibSymbolRef() const { return m_part; }
 
     /**
      * Set this schematic symbol library symbol reference to \a aLibSymbol
@@ -240,6 +244,20 @@ public:
      */
     void SetLibSymbol( LIB_SYMBOL* aLibSymbol );
 
+    /**
+     * Set this schematic symbol library symbol reference to \a aLibSymbol, which is shared
+     * with the other schematic symbols it is set to.
+     *
+     * @see SetLibSymbol()
+     */
+    void ShareLibSymbol( const std::shared_ptr<LIB_SYMBOL>& aLibSymbol );
+
+    /**
+     * Give this schematic symbol its own copy of its library symbol if it shares it with other
+     * schematic symbols, so that it can be changed without changing them.
+     */
+    void UnshareLibSymbol();
+
     /**
      * @return the associated LIB_SYMBOL's description field (or wxEmptyString).
      */
@@ -908,8 +926,9 @@ private:
     TRANSFORM                              m_transform; ///< The rotation/mirror transformation.
     std::vector<SCH_FIELD>                 m_fields;    ///< Variable length list of fields.
 
-    std::unique_ptr< LIB_SYMBOL >          m_part;      ///< a flattened copy of the LIB_SYMBOL
-                                                        ///<   from the PROJECT's libraries.
+    std::shared_ptr< LIB_SYMBOL >          m_part;      ///< a flattened copy of the LIB_SYMBOL
+                                                        ///<   from the PROJECT's libraries,
+                                                        ///<   shared between copies.
     std::vector<std::unique_ptr<SCH_PIN>>  m_pins;      ///< a SCH_PIN for every LIB_PIN (all units)
     std::unordered_map<LIB_PIN*, SCH_PIN*> m_pinMap;    ///< library pin pointer : SCH_PIN's index
 
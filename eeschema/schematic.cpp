@@ -37,6 +37,9 @@
 #include <sim/spice_value.h>
 #include <netlist_exporter_spice.h>
 
+
+thread_local SCHEMATIC::SHEET_OVERRIDE SCHEMATIC::s_threadSheet;
+
 SCHEMATIC::SCHEMATIC( PROJECT* aPrj ) :
           EDA_ITEM( nullptr, SCHEMATIC_T ),
           m_project( nullptr ),
@@ -400,7 +403,7 @@ std::set<wxString> SCHEMATIC::GetNetClassAssignmentCandidates()
         if( !firstSubgraph->GetDriverConnection()->IsBus()
                 && firstSubgraph->GetDriverPriority() >= CONNECTION_SUBGRAPH::PRIORITY::PIN )
         {
-            names.insert( key.Name );
+            names.insert( key.Name.Str() );
         }
     }
 
@@ -135,6 +135,9 @@ public:
 
     SCH_SHEET_PATH& CurrentSheet() const override
     {
+        if( s_threadSheet.m_schematic == this )
+            return *s_threadSheet.m_sheet;
+
         return *m_currentSheet;
     }
 
@@ -143,6 +146,35 @@ public:
         *m_currentSheet = aPath;
     }
 
+    /**
+     * Make CurrentSheet() return another sheet path on the calling thread only, for as long as
+     * the object lives, so that worker threads can each plot their own sheet.
+     *
+     * The sheet numbers and symbol references must have been set up beforehand on the main
+     * thread, and the screen of the sheet must not be shared with a sheet used by another thread.
+     */
+    class THREAD_SHEET
+    {
+    public:
+        THREAD_SHEET( const SCHEMATIC* aSchematic, SCH_SHEET_PATH* aSheet ) :
+                m_prevSchematic( s_threadSheet.m_schematic ),
+                m_prevSheet( s_threadSheet.m_sheet )
+        {
+            s_threadSheet.m_schematic = aSchematic;
+            s_threadSheet.m_sheet = aSheet;
+        }
+
+        ~THREAD_SHEET()
+        {
+            s_threadSheet.m_schematic = m_prevSchematic;
+            s_threadSheet.m_sheet = m_prevSheet;
+        }
+
+    private:
+        const SCHEMATIC* m_prevSchematic;
+        SCH_SHEET_PATH*  m_prevSheet;
+    };
+
     CONNECTION_GRAPH* ConnectionGraph() const override
     {
         return m_connectionGraph;
@@ -305,6 +337,15 @@ public:
 private:
     friend class SCH_EDIT_FRAME;
 
+    struct SHEET_OVERRIDE
+    {
+        const SCHEMATIC* m_schematic = nullptr;
+        SCH_SHEET_PATH*  m_sheet = nullptr;
+    };
+
+    /// The sheet path set by a THREAD_SHEET on the current thread
+    static thread_local SHEET_OVERRIDE s_threadSheet;
+
     template <typename Func, typename... Args>
     void InvokeListeners( Func&& aFunc, Args&&... args )
     {
@@ -32,7 +32,9 @@
 
 #include "kibis.h"
 #include "ibis_parser.h"
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 #include <sim/spice_simulator.h>
 
 
@@ -665,8 +667,38 @@ std::string KIBIS_PIN::addDie( KIBIS_MODEL& aModel, KIBIS_PARAMETER& aParam, int
 }
 
 
+/**
+ * Ku and Kd computed by the internal simulations, by simulation deck.  The deck holds all the
+ * data the result depends on, and it's the same for all the pins using a model with the same
+ * settings, so each one is only simulated once.
+ */
+struct KUKD_TABLES
+{
+    std::vector<double> m_Ku;
+    std::vector<double> m_Kd;
+    std::vector<double> m_t;
+};
+
+static std::mutex                                   s_kuKdCacheMutex;
+static std::unordered_map<std::string, KUKD_TABLES> s_kuKdCache;
+static const size_t                                 KUKD_CACHE_SIZE = 256;
+
+
 void KIBIS_PIN::getKuKdFromFile( std::string* aSimul )
 {
+    {
+        std::lock_guard<std::mutex> lock( s_kuKdCacheMutex );
+        auto                        it = s_kuKdCache.find( *aSimul );
+
+        if( it != s_kuKdCache.end() )
+        {
+            m_Ku = it->second.m_Ku;
+            m_Kd = it->second.m_Kd;
+            m_t = it->second.m_t;
+            return;
+        }
+    }
+
     std::string   outputFileName = m_topLevel->m_cacheDir + "temp_output.spice";
 
     if( std::remove( outputFileName.c_str() ) )
@@ -688,8 +720,12 @@ void KIBIS_PIN::getKuKdFromFile( std::string* aSimul )
     KuKdfile.open( outputFileName );
 
     std::vector<double> ku, kd, t;
+    bool                readOk = false;
+
     if( KuKdfile )
     {
+        readOk = true;
+
         std::string line;
 
         for( int i = 0; i < 11; i++ ) // number of line in the ngspice output header
@@ -722,7 +758,9 @@ void KIBIS_PIN::getKuKdFromFile( std::string* aSimul )
                 kd.push_back( kd_v );
                 t.push_back( t_v );
                 break;
-            default: Report( _( "Error while reading temporary file" ), RPT_SEVERITY_ERROR );
+            default:
+                Report( _( "Error while reading temporary file" ), RPT_SEVERITY_ERROR );
+                readOk = false;
             }
             i = ( i + 1 ) % 3;
         }
@@ -739,6 +777,16 @@ void KIBIS_PIN::getKuKdFromFile( std::string* aSimul )
         Report( _( "Cannot remove temporary output file" ), RPT_SEVERITY_WARNING );
     }
 
+    if( readOk && !t.empty() )
+    {
+        std::lock_guard<std::mutex> lock( s_kuKdCacheMutex );
+
+        if( s_kuKdCache.size() >= KUKD_CACHE_SIZE )
+            s_kuKdCache.clear();
+
+        s_kuKdCache[*aSimul] = { ku, kd, t };
+    }
+
     m_Ku = ku;
     m_Kd = kd;
     m_t = t;
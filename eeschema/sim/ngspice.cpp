@@ -208,7 +208,7 @@ std::vector<double> NGSPICE::GetImaginaryVector( const std::string& aName, int a
 }
 
 
-std::vector<double> NGSPICE::GetGainVector( const std::string& aName, int aMaxLen )
+std::vector<double> NGSPICE::GetGainVector( const std::string& aName, int aMaxLen, int aStart )
 {
     LOCALE_IO            c_locale;       // ngspice works correctly only with C locale
     std::vector<double>  data;
@@ -219,17 +219,18 @@ std::vector<double> NGSPICE::GetGainVector( const std::string& aName, int aMaxLe
 
     if( vector_info* vi = m_ngGet_Vec_Info( (char*) aName.c_str() ) )
     {
-        int length = aMaxLen < 0 ? vi->v_length : std::min( aMaxLen, vi->v_length );
+        int available = std::max( vi->v_length - aStart, 0 );
+        int length = aMaxLen < 0 ? available : std::min( aMaxLen, available );
         data.reserve( length );
 
         if( vi->v_realdata )
         {
-            for( int i = 0; i < length; i++ )
+            for( int i = aStart; i < aStart + length; i++ )
                 data.push_back( vi->v_realdata[i] );
         }
         else if( vi->v_compdata )
         {
-            for( int i = 0; i < length; i++ )
+            for( int i = aStart; i < aStart + length; i++ )
                 data.push_back( hypot( vi->v_compdata[i].cx_real, vi->v_compdata[i].cx_imag ) );
         }
     }
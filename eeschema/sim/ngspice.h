@@ -96,7 +96,8 @@ public:
     std::vector<double> GetImaginaryVector( const std::string& aName, int aMaxLen = -1 ) override final;
 
     ///< @copydoc SPICE_SIMULATOR::GetGainVector()
-    std::vector<double> GetGainVector( const std::string& aName, int aMaxLen = -1 ) override final;
+    std::vector<double> GetGainVector( const std::string& aName, int aMaxLen = -1,
+                                       int aStart = 0 ) override final;
 
     ///< @copydoc SPICE_SIMULATOR::GetPhaseVector()
     std::vector<double> GetPhaseVector( const std::string& aName, int aMaxLen = -1 ) override final;
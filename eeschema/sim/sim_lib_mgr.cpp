@@ -27,18 +27,109 @@
 #include <string_utils.h>
 #include <common.h>
 #include <functional>
+#include <mutex>
+#include <core/kicad_algo.h>
 #include <sch_symbol.h>
 
 // Include simulator headers after wxWidgets headers to avoid conflicts with Windows headers
 // (especially on msys2 + wxWidgets 3.0.x)
 #include <sim/sim_lib_mgr.h>
 #include <sim/sim_library.h>
+#include <sim/sim_library_spice.h>
 #include <sim/sim_model.h>
 #include <sim/sim_model_ideal.h>
 
 using namespace std::placeholders;
 
 
+namespace
+{
+
+/// The most libraries kept once no library manager uses them
+const size_t MAX_CACHED_LIBRARIES = 32;
+
+
+/**
+ * Forward messages to another reporter and keep them, to report them again when a cached
+ * library is used.
+ */
+class RECORDING_REPORTER : public REPORTER
+{
+public:
+    RECORDING_REPORTER( REPORTER& aTarget ) :
+            m_target( aTarget )
+    {}
+
+    REPORTER& Report( const wxString& aText, SEVERITY aSeverity = RPT_SEVERITY_UNDEFINED ) override
+    {
+        m_messages.emplace_back( aText, aSeverity );
+        m_target.Report( aText, aSeverity );
+        return *this;
+    }
+
+    bool HasMessage() const override { return !m_messages.empty(); }
+
+    const std::vector<std::pair<wxString, SEVERITY>>& GetMessages() const { return m_messages; }
+
+private:
+    REPORTER&                                  m_target;
+    std::vector<std::pair<wxString, SEVERITY>> m_messages;
+};
+
+
+struct FILE_STAMP
+{
+    wxString  m_path;
+    long long m_modified;
+    long long m_size;
+
+    static FILE_STAMP Get( const wxString& aPath )
+    {
+        wxFileName fn( aPath );
+
+        // Missing files are stamped too, so that creating an included file is noticed
+        if( !fn.FileExists() )
+            return { aPath, -1, -1 };
+
+        return { aPath, fn.GetModificationTime().GetValue().GetValue(),
+                 (long long) fn.GetSize().GetValue() };
+    }
+
+    bool IsCurrent() const
+    {
+        FILE_STAMP current = Get( m_path );
+        return current.m_modified == m_modified && current.m_size == m_size;
+    }
+};
+
+
+struct CACHED_LIBRARY
+{
+    std::shared_ptr<SIM_LIBRARY>               m_library;
+    std::vector<FILE_STAMP>                    m_stamps;
+    std::vector<std::pair<wxString, SEVERITY>> m_messages;
+    unsigned long long                         m_lastUse = 0;
+
+    bool IsCurrent() const
+    {
+        for( const FILE_STAMP& stamp : m_stamps )
+        {
+            if( !stamp.IsCurrent() )
+                return false;
+        }
+
+        return true;
+    }
+};
+
+
+std::mutex                         g_libraryCacheMutex;
+std::map<wxString, CACHED_LIBRARY> g_libraryCache;
+unsigned long long                 g_libraryCacheClock = 0;
+
+} // anonymous namespace
+
+
 SIM_LIB_MGR::SIM_LIB_MGR( const PROJECT* aPrj ) :
         m_project( aPrj ),
         m_forceFullParse( false )
@@ -131,17 +222,85 @@ wxString SIM_LIB_MGR::ResolveEmbeddedLibraryPath( const wxString& aLibPath,
 }
 
 
+std::shared_ptr<SIM_LIBRARY> SIM_LIB_MGR::loadLibrary( const wxString& aPath,
+                                                       REPORTER& aReporter )
+{
+    std::function<wxString( const wxString&, const wxString& )> f2 =
+            std::bind( &SIM_LIB_MGR::ResolveEmbeddedLibraryPath, this, _1, _2 );
+
+    // The model editor changes the models it reads, and IBIS libraries keep state for their
+    // models, so those always get their own copy
+    if( m_forceFullParse || aPath.EndsWith( ".ibs" ) )
+        return SIM_LIBRARY::Create( aPath, m_forceFullParse, aReporter, &f2 );
+
+    // Included files are resolved relative to the project
+    wxString key = aPath;
+
+    if( m_project )
+        key << wxS( "|" ) << m_project->GetProjectPath();
+
+    std::lock_guard<std::mutex> lock( g_libraryCacheMutex );
+
+    auto it = g_libraryCache.find( key );
+
+    if( it != g_libraryCache.end() && it->second.IsCurrent() )
+    {
+        for( const auto& [text, severity] : it->second.m_messages )
+            aReporter.Report( text, severity );
+    }
+    else
+    {
+        RECORDING_REPORTER reporter( aReporter );
+        CACHED_LIBRARY     entry;
+
+        entry.m_library = SIM_LIBRARY::Create( aPath, false, reporter, &f2 );
+        entry.m_messages = reporter.GetMessages();
+
+        if( SIM_LIBRARY_SPICE* spiceLib = dynamic_cast<SIM_LIBRARY_SPICE*>( &*entry.m_library ) )
+        {
+            for( const wxString& file : spiceLib->GetSourceFiles() )
+                entry.m_stamps.push_back( FILE_STAMP::Get( file ) );
+        }
+
+        it = g_libraryCache.insert_or_assign( key, std::move( entry ) ).first;
+    }
+
+    it->second.m_lastUse = ++g_libraryCacheClock;
+
+    std::shared_ptr<SIM_LIBRARY> library = it->second.m_library;
+
+    // Drop the least recently used libraries no manager holds any more
+    while( g_libraryCache.size() > MAX_CACHED_LIBRARIES )
+    {
+        auto oldest = g_libraryCache.end();
+
+        for( auto cand = g_libraryCache.begin(); cand != g_libraryCache.end(); ++cand )
+        {
+            if( cand->second.m_library.use_count() == 1
+                    && ( oldest == g_libraryCache.end()
+                         || cand->second.m_lastUse < oldest->second.m_lastUse ) )
+            {
+                oldest = cand;
+            }
+        }
+
+        if( oldest == g_libraryCache.end() )
+            break;
+
+        g_libraryCache.erase( oldest );
+    }
+
+    return library;
+}
+
+
 void SIM_LIB_MGR::SetLibrary( const wxString& aLibraryPath, REPORTER& aReporter )
 {
     try
     {
         wxString path = ResolveLibraryPath( aLibraryPath, m_project );
 
-        std::function<wxString(const wxString&, const wxString&)> f2 =
-                std::bind( &SIM_LIB_MGR::ResolveEmbeddedLibraryPath, this, _1, _2 );
-
-        std::unique_ptr<SIM_LIBRARY> library = SIM_LIBRARY::Create( path, m_forceFullParse,
-                                                                    aReporter, &f2 );
+        std::shared_ptr<SIM_LIBRARY> library = loadLibrary( path, aReporter );
 
         Clear();
         m_libraries[path] = std::move( library );
@@ -301,13 +460,7 @@ SIM_LIBRARY::MODEL SIM_LIB_MGR::CreateModel( const wxString& aLibraryPath,
         auto it = m_libraries.find( path );
 
         if( it == m_libraries.end() )
-        {
-            std::function<wxString( const wxString&, const wxString& )> f2 =
-                    std::bind( &SIM_LIB_MGR::ResolveEmbeddedLibraryPath, this, _1, _2 );
-
-            it = m_libraries.emplace( path, SIM_LIBRARY::Create( path, m_forceFullParse,
-                                                                 aReporter, &f2 ) ).first;
-        }
+            it = m_libraries.emplace( path, loadLibrary( path, aReporter ) ).first;
 
         library = &*it->second;
     }
@@ -331,7 +484,7 @@ SIM_LIBRARY::MODEL SIM_LIB_MGR::CreateModel( const wxString& aLibraryPath,
     }
     else if( library )
     {
-        baseModel = library->FindModel( aBaseModelName );
+        baseModel = library->FindModel( aBaseModelName, aReporter );
         modelName = aBaseModelName;
 
         if( !baseModel )
@@ -357,6 +510,16 @@ void SIM_LIB_MGR::SetModel( int aIndex, std::unique_ptr<SIM_MODEL> aModel )
 }
 
 
+void SIM_LIB_MGR::RetainModels( const std::set<const SIM_MODEL*>& aKeep )
+{
+    alg::delete_if( m_models,
+                    [&]( const std::unique_ptr<SIM_MODEL>& aModel )
+                    {
+                        return !aKeep.count( aModel.get() );
+                    } );
+}
+
+
 std::map<wxString, std::reference_wrapper<const SIM_LIBRARY>> SIM_LIB_MGR::GetLibraries() const
 {
     std::map<wxString, std::reference_wrapper<const SIM_LIBRARY>> libraries;
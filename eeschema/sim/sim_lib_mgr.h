@@ -27,6 +27,7 @@
 
 #include <memory>
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 
@@ -76,6 +77,11 @@ public:
 
     void SetModel( int aIndex, std::unique_ptr<SIM_MODEL> aModel );
 
+    /**
+     * Delete the models created by the manager, except those in \a aKeep.
+     */
+    void RetainModels( const std::set<const SIM_MODEL*>& aKeep );
+
     std::map<wxString, std::reference_wrapper<const SIM_LIBRARY>> GetLibraries() const;
     std::vector<std::reference_wrapper<SIM_MODEL>> GetModels() const;
 
@@ -83,9 +89,18 @@ public:
     wxString ResolveEmbeddedLibraryPath( const wxString& aLibPath, const wxString& aRelativeLib );
 
 private:
+    /**
+     * Read the library at \a aPath (already resolved).
+     *
+     * Unless a full parse is forced, Spice libraries are shared by all the library managers of
+     * the process and only read again when their files change: netlisting, ERC and the
+     * simulator each create their own manager, and large vendor libraries are slow to parse.
+     */
+    std::shared_ptr<SIM_LIBRARY> loadLibrary( const wxString& aPath, REPORTER& aReporter );
+
     const PROJECT*                                   m_project;
     bool                                             m_forceFullParse;
-    std::map<wxString, std::unique_ptr<SIM_LIBRARY>> m_libraries;
+    std::map<wxString, std::shared_ptr<SIM_LIBRARY>> m_libraries;
     std::vector<std::unique_ptr<SIM_MODEL>>          m_models;
 };
 
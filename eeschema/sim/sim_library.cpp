@@ -43,6 +43,9 @@ SIM_LIBRARY::Create( const wxString& aFilePath, bool aForceFullParse, REPORTER&
     library->m_pathResolver = aResolver;
     library->ReadFile( aFilePath, aReporter );
 
+    // The resolver belongs to the caller and may not outlive this call
+    library->m_pathResolver = nullptr;
+
     return library;
 }
 
@@ -50,29 +53,53 @@ SIM_LIBRARY::Create( const wxString& aFilePath, bool aForceFullParse, REPORTER&
 void SIM_LIBRARY::ReadFile( const wxString& aFilePath, REPORTER& aReporter )
 {
     m_filePath = aFilePath;
+    m_modelIndex.clear();
+    m_indexedModels = 0;
 }
 
 
 SIM_MODEL* SIM_LIBRARY::FindModel( const std::string& aModelName ) const
 {
-    std::string lowerName = boost::to_lower_copy( aModelName );
+    return FindModel( aModelName, NULL_REPORTER::GetInstance() );
+}
 
-    for( int i = 0; i < static_cast<int>( m_modelNames.size() ); ++i )
-    {
-        if( boost::to_lower_copy( m_modelNames.at( i ) ) == lowerName )
-            return m_models.at( i ).get();
-    }
 
-    return nullptr;
+SIM_MODEL* SIM_LIBRARY::FindModel( const std::string& aModelName, REPORTER& aReporter ) const
+{
+    std::lock_guard<std::recursive_mutex> lock( m_modelsMutex );
+
+    // Libraries can hold thousands of models, so don't search them linearly for each symbol.
+    // Index the models added since the last search, as models are also looked up while the
+    // library is read.  The first of several models with the same name wins.
+    for( ; m_indexedModels < m_modelNames.size(); ++m_indexedModels )
+        m_modelIndex.emplace( boost::to_lower_copy( m_modelNames[m_indexedModels] ),
+                              m_indexedModels );
+
+    auto it = m_modelIndex.find( boost::to_lower_copy( aModelName ) );
+
+    if( it == m_modelIndex.end() )
+        return nullptr;
+
+    if( !m_models[it->second] )
+        loadModel( it->second, aReporter );
+
+    return m_models[it->second].get();
 }
 
 
 std::vector<SIM_LIBRARY::MODEL> SIM_LIBRARY::GetModels() const
 {
-    std::vector<MODEL> result;
+    std::lock_guard<std::recursive_mutex> lock( m_modelsMutex );
+    std::vector<MODEL>                    result;
 
-    for( int i = 0; i < static_cast<int>( m_modelNames.size() ); ++i )
-        result.push_back( { m_modelNames.at( i ), *m_models.at( i ) } );
+    for( size_t i = 0; i < m_modelNames.size(); ++i )
+    {
+        if( !m_models[i] )
+            loadModel( i, NULL_REPORTER::GetInstance() );
+
+        if( m_models[i] )
+            result.push_back( { m_modelNames[i], *m_models[i] } );
+    }
 
     return result;
 }
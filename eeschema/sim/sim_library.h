@@ -25,6 +25,9 @@
 #ifndef SIM_LIBRARY_H
 #define SIM_LIBRARY_H
 
+#include <mutex>
+#include <unordered_map>
+
 #include <sim/sim_model.h>
 #include <reporter.h>
 
@@ -69,15 +72,31 @@ public:
 
     SIM_MODEL* FindModel( const std::string& aModelName ) const;
 
+    /**
+     * Find a model by name (case insensitive), reporting the errors met if it has to be parsed.
+     */
+    SIM_MODEL* FindModel( const std::string& aModelName, REPORTER& aReporter ) const;
+
     std::vector<MODEL> GetModels() const;
 
     std::string GetFilePath() const { return m_filePath; }
 
 protected:
-    std::vector<std::string>                m_modelNames;
-    std::vector<std::unique_ptr<SIM_MODEL>> m_models;
+    /**
+     * Create the model at \a aIndex if reading the file left it unparsed.  The model stays null
+     * if it can't be created.
+     */
+    virtual void loadModel( size_t aIndex, REPORTER& aReporter ) const {}
+
+    std::vector<std::string>                        m_modelNames;
+    mutable std::vector<std::unique_ptr<SIM_MODEL>> m_models;
+
+    /// Guards the lazy creation of models; recursive as models may be based on other models
+    mutable std::recursive_mutex                    m_modelsMutex;
+    mutable std::unordered_map<std::string, size_t> m_modelIndex;   ///< Lowercase name to index
+    mutable size_t                                  m_indexedModels = 0;
 
-    std::function<wxString( const wxString&, const wxString& )>* m_pathResolver;
+    std::function<wxString( const wxString&, const wxString& )>* m_pathResolver = nullptr;
 
     std::string m_filePath;
 };
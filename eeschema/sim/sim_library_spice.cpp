@@ -24,6 +24,9 @@
 
 #include <sim/sim_library_spice.h>
 #include <sim/sim_model_spice.h>
+#include <ki_exception.h>
+
+#include <wx/intl.h>
 
 
 SIM_LIBRARY_SPICE::SIM_LIBRARY_SPICE( bool aForceFullParse ) :
@@ -39,3 +42,28 @@ void SIM_LIBRARY_SPICE::ReadFile( const wxString& aFilePath, REPORTER& aReporter
     m_spiceLibraryParser->ReadFile( aFilePath, aReporter );
 }
 
+
+void SIM_LIBRARY_SPICE::loadModel( size_t aIndex, REPORTER& aReporter ) const
+{
+    if( aIndex >= m_modelSources.size() || m_modelSources[aIndex].empty() )
+        return;
+
+    // Taken out first so that a model based on itself, directly or not, isn't parsed forever
+    std::string source = std::move( m_modelSources[aIndex] );
+    m_modelSources[aIndex].clear();
+
+    try
+    {
+        m_models[aIndex] = SIM_MODEL_SPICE::Create( *this, source );
+    }
+    catch( const IO_ERROR& e )
+    {
+        aReporter.Report( e.What(), RPT_SEVERITY_ERROR );
+    }
+    catch( ... )
+    {
+        aReporter.Report( wxString::Format( _( "Cannot create sim model from %s" ), source ),
+                          RPT_SEVERITY_ERROR );
+    }
+}
+
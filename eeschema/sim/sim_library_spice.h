@@ -39,8 +39,24 @@ public:
     // @copydoc SIM_LIBRARY::ReadFile()
     void ReadFile( const wxString& aFilePath, REPORTER& aReporter ) override;
 
+    /**
+     * @return the files read for the library: its own file and the files it includes.
+     */
+    const std::vector<wxString>& GetSourceFiles() const { return m_sourceFiles; }
+
+protected:
+    /**
+     * Unless a full parse is forced, reading the file only splits it into models, and a model
+     * is parsed when it's first looked up.
+     */
+    void loadModel( size_t aIndex, REPORTER& aReporter ) const override;
+
 private:
     std::unique_ptr<SPICE_LIBRARY_PARSER> m_spiceLibraryParser;
+
+    /// Spice code of the models not parsed yet, in the order of m_modelNames
+    mutable std::vector<std::string>      m_modelSources;
+    std::vector<wxString>                 m_sourceFiles;
 };
 
 #endif // SIM_LIBRARY_SPICE_H
@@ -27,8 +27,19 @@
 #include <fmt/core.h>
 #include <wx/filename.h>
 #include <kiway.h>
+#include <mutex>
+#include <unordered_map>
 #include "sim_lib_mgr.h"
 
+
+/**
+ * Subcircuits written for IBIS devices.  Writing one reads the whole IBIS file and, for
+ * drivers, runs internal simulations, so the subcircuits are kept until their file changes.
+ */
+static std::mutex                                   s_ibisDeviceCacheMutex;
+static std::unordered_map<std::string, std::string> s_ibisDeviceCache;
+static const size_t                                 IBIS_DEVICE_CACHE_SIZE = 1024;
+
 std::string SPICE_GENERATOR_KIBIS::ModelName( const SPICE_ITEM& aItem ) const
 {
     return fmt::format( "{}.{}", aItem.refName, aItem.baseModelName );
@@ -68,6 +79,26 @@ std::string SPICE_GENERATOR_KIBIS::IbisDevice( const SPICE_ITEM& aItem, const PR
     bool        diffMode        = SIM_MODEL::GetFieldValue( &aItem.fields, SIM_LIBRARY_KIBIS::DIFF_FIELD ) == "1";
 
     wxString path = SIM_LIB_MGR::ResolveLibraryPath( ibisLibFilename, &aProject );
+    wxFileName  fn( path );
+    std::string cacheKey;
+
+    if( fn.FileExists() )
+    {
+        cacheKey = fmt::format( "{}|{}|{}|{}|{}|{}|{}|{}|{}|{}", path.ToStdString(),
+                                fn.GetModificationTime().GetValue().GetValue(),
+                                fn.GetSize().GetValue(), ibisCompName, ibisPinName, ibisModelName,
+                                diffMode, static_cast<int>( m_model.GetType() ), aItem.modelName,
+                                aCacheDir.ToStdString() );
+
+        for( int ii = 0; ii < m_model.GetParamCount(); ++ii )
+            cacheKey += "|" + m_model.GetParam( ii ).value;
+
+        std::lock_guard<std::mutex> lock( s_ibisDeviceCacheMutex );
+        auto                        it = s_ibisDeviceCache.find( cacheKey );
+
+        if( it != s_ibisDeviceCache.end() )
+            return it->second;
+    }
 
     KIBIS kibis( std::string( path.c_str() ) );
     kibis.m_cacheDir = std::string( aCacheDir.c_str() );
@@ -214,6 +245,16 @@ std::string SPICE_GENERATOR_KIBIS::IbisDevice( const SPICE_ITEM& aItem, const PR
         return "";
     }
 
+    if( !cacheKey.empty() && !result.empty() )
+    {
+        std::lock_guard<std::mutex> lock( s_ibisDeviceCacheMutex );
+
+        if( s_ibisDeviceCache.size() >= IBIS_DEVICE_CACHE_SIZE )
+            s_ibisDeviceCache.clear();
+
+        s_ibisDeviceCache[cacheKey] = result;
+    }
+
     return result;
 }
 
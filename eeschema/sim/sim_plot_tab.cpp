@@ -878,6 +878,29 @@ void SIM_PLOT_TAB::SetTraceData( TRACE* trace, std::vector<double>& aX, std::vec
         }
     }
 
+    convertTraceValues( trace, aY );
+    trace->SetData( aX, aY );
+    updateTraceScale( trace );
+}
+
+
+void SIM_PLOT_TAB::AppendTraceData( TRACE* trace, std::vector<double>& aX,
+                                    std::vector<double>& aY )
+{
+    if( trace->GetDataX().empty() )
+    {
+        SetTraceData( trace, aX, aY );
+        return;
+    }
+
+    convertTraceValues( trace, aY );
+    trace->AppendData( aX, aY );
+    updateTraceScale( trace );
+}
+
+
+void SIM_PLOT_TAB::convertTraceValues( TRACE* trace, std::vector<double>& aY ) const
+{
     if( GetSimType() == ST_AC || GetSimType() == ST_FFT )
     {
         if( trace->GetType() & SPT_AC_PHASE )
@@ -895,9 +918,11 @@ void SIM_PLOT_TAB::SetTraceData( TRACE* trace, std::vector<double>& aX, std::vec
             }
         }
     }
+}
 
-    trace->SetData( aX, aY );
 
+void SIM_PLOT_TAB::updateTraceScale( TRACE* trace )
+{
     if( ( trace->GetType() & SPT_AC_PHASE ) || ( trace->GetType() & SPT_CURRENT ) )
         trace->SetScale( m_axis_x, m_axis_y2 );
     else if( trace->GetType() & SPT_POWER )
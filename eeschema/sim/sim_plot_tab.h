@@ -167,6 +167,23 @@ public:
         mpFXYVector::SetData( aX, aY );
     }
 
+    /**
+     * Append points to the data set of the trace. aX and aY need to have the same length.
+     *
+     * @param aX are the X axis values.
+     * @param aY are the Y axis values.
+     */
+    void AppendData( const std::vector<double>& aX, const std::vector<double>& aY ) override
+    {
+        for( auto& [ idx, cursor ] : m_cursors )
+        {
+            if( cursor )
+                cursor->Update();
+        }
+
+        mpFXYVector::AppendData( aX, aY );
+    }
+
     const std::vector<double>& GetDataX() const { return m_xs; }
     const std::vector<double>& GetDataY() const { return m_ys; }
 
@@ -348,6 +365,12 @@ public:
 
     void SetTraceData( TRACE* aTrace, std::vector<double>& aX, std::vector<double>& aY );
 
+    /**
+     * Append points to the data of \a aTrace, such as the ones a running transient analysis
+     * added since the last update.
+     */
+    void AppendTraceData( TRACE* aTrace, std::vector<double>& aX, std::vector<double>& aY );
+
     bool DeleteTrace( const wxString& aVectorName, int aTraceType );
     void DeleteTrace( TRACE* aTrace );
 
@@ -368,6 +391,12 @@ private:
     ///< Create/Ensure axes are available for plotting
     void updateAxes( int aNewTraceType = SIM_TRACE_TYPE::SPT_UNKNOWN );
 
+    ///< Convert AC and FFT trace values to dB or degrees
+    void convertTraceValues( TRACE* aTrace, std::vector<double>& aY ) const;
+
+    ///< Assign the axes of a trace whose data changed and move its cursors along
+    void updateTraceScale( TRACE* aTrace );
+
 private:
     SIM_PLOT_COLORS              m_colors;
     std::map<wxString, wxColour> m_sessionTraceColors;
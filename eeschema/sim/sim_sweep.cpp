@@ -0,0 +1,689 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sim/sim_sweep.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <regex>
+#include <sstream>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/intl.h>
+#include <wx/process.h>
+#include <wx/regex.h>
+#include <wx/tokenzr.h>
+#include <wx/utils.h>
+
+#include <core/thread_pool.h>
+#include <locale_io.h>
+#include <sim/spice_value.h>
+
+
+/// Sweeps larger than this are most likely a typo in a .step directive
+static const size_t MAX_SWEEP_POINTS = 10000;
+
+
+/**
+ * A ngspice process running one point of a sweep.  Deletes itself once the process is over.
+ */
+class SIM_SWEEP_PROCESS : public wxProcess
+{
+public:
+    SIM_SWEEP_PROCESS( SIM_SWEEP_RUNNER* aRunner, size_t aIndex ) :
+            wxProcess( wxPROCESS_DEFAULT ),
+            m_runner( aRunner ),
+            m_index( aIndex )
+    {}
+
+    void OnTerminate( int aPid, int aStatus ) override
+    {
+        if( m_runner )
+            m_runner->onTerminated( m_index );
+
+        delete this;
+    }
+
+    SIM_SWEEP_RUNNER* m_runner;     ///< Null once the runner no longer waits for the process
+    size_t            m_index;
+};
+
+
+/**
+ * Remove the temporary file of a run and the netlist, raw and log files named after it.
+ */
+static void removeRunFiles( const wxString& aBase )
+{
+    for( const wxString& ext : { wxS( "" ), wxS( ".cir" ), wxS( ".raw" ), wxS( ".log" ) } )
+    {
+        if( wxFileExists( aBase + ext ) )
+            wxRemoveFile( aBase + ext );
+    }
+}
+
+
+static wxString normalizeVectorName( const wxString& aName )
+{
+    static const wxString BRANCH( wxS( "#branch" ) );
+
+    wxString name = aName.Lower();
+
+    if( name.EndsWith( BRANCH ) )
+        return wxS( "i(" ) + name.Left( name.length() - BRANCH.length() ) + wxS( ")" );
+
+    if( !name.Contains( '(' ) && !name.StartsWith( '@' ) )
+        return wxS( "v(" ) + name + wxS( ")" );
+
+    return name;
+}
+
+
+int SIM_RAW_PLOT::FindVector( const wxString& aName ) const
+{
+    wxString name = normalizeVectorName( aName );
+
+    for( size_t ii = 0; ii < m_names.size(); ++ii )
+    {
+        if( normalizeVectorName( wxString::FromUTF8( m_names[ii] ) ) == name )
+            return (int) ii;
+    }
+
+    return -1;
+}
+
+
+wxString SIM_SWEEP_POINT::GetLabel() const
+{
+    wxString label;
+
+    for( const auto& [ name, value ] : m_params )
+    {
+        if( !label.IsEmpty() )
+            label << wxS( " " );
+
+        label << name << wxS( "=" ) << value;
+    }
+
+    return label;
+}
+
+
+SIM_SWEEP_RUNNER::SIM_SWEEP_RUNNER( const std::string& aNetlist,
+                                    const std::vector<SIM_SWEEP_POINT>& aPoints ) :
+        m_netlist( aNetlist ),
+        m_points( aPoints ),
+        m_next( 0 ),
+        m_running( 0 ),
+        m_done( 0 )
+{
+}
+
+
+SIM_SWEEP_RUNNER::~SIM_SWEEP_RUNNER()
+{
+    Cancel();
+}
+
+
+bool SIM_SWEEP_RUNNER::ParseStepDirectives( wxString& aSimCommand,
+                                            std::vector<SIM_SWEEP_POINT>& aPoints,
+                                            wxString& aError )
+{
+    static wxRegEx number( wxS( "^[+-]?([0-9]+\\.?[0-9]*|\\.[0-9]+)([eE][+-]?[0-9]+)?[a-zA-Z]*$" ),
+                           wxRE_ADVANCED );
+    static wxRegEx identifier( wxS( "^[A-Za-z_][A-Za-z0-9_]*$" ), wxRE_ADVANCED );
+
+    std::vector<std::pair<wxString, std::vector<wxString>>> sweeps;
+    wxString                                                command;
+    bool                                                    first = true;
+
+    aPoints.clear();
+
+    for( const wxString& line : wxSplit( aSimCommand, '\n', '\0' ) )
+    {
+        wxStringTokenizer     tokenizer( line, wxS( " \t\r" ), wxTOKEN_STRTOK );
+        std::vector<wxString> tokens;
+
+        while( tokenizer.HasMoreTokens() )
+            tokens.push_back( tokenizer.GetNextToken() );
+
+        if( tokens.empty() || tokens[0].Lower() != wxS( ".step" ) )
+        {
+            if( !first )
+                command << wxS( "\n" );
+
+            command << line;
+            first = false;
+            continue;
+        }
+
+        if( tokens.size() < 4 || tokens[1].Lower() != wxS( "param" ) )
+        {
+            aError.Printf( _( "Only parameter sweeps are supported: '%s'." ), line );
+            return false;
+        }
+
+        if( !identifier.Matches( tokens[2] ) )
+        {
+            aError.Printf( _( "Invalid parameter name in '%s'." ), line );
+            return false;
+        }
+
+        std::vector<wxString> values;
+
+        if( tokens[3].Lower() == wxS( "list" ) )
+        {
+            values.assign( tokens.begin() + 4, tokens.end() );
+        }
+        else
+        {
+            if( tokens.size() != 6 || !number.Matches( tokens[3] ) || !number.Matches( tokens[4] )
+                    || !number.Matches( tokens[5] ) )
+            {
+                aError.Printf( _( "Expected '.step param <name> <start> <stop> <increment>' or "
+                                  "'.step param <name> list <values>': '%s'." ),
+                               line );
+                return false;
+            }
+
+            double start = SPICE_VALUE( tokens[3] ).ToDouble();
+            double stop = SPICE_VALUE( tokens[4] ).ToDouble();
+            double increment = SPICE_VALUE( tokens[5] ).ToDouble();
+            double steps = ( stop - start ) / increment;
+
+            if( increment == 0.0 || steps < 0.0 || steps >= MAX_SWEEP_POINTS )
+            {
+                aError.Printf( _( "Invalid sweep range in '%s'." ), line );
+                return false;
+            }
+
+            // Compute each value from the start, accumulating the increment would drift
+            for( size_t ii = 0; ii <= (size_t) std::floor( steps + 1e-9 ); ++ii )
+                values.push_back( SPICE_VALUE( start + ii * increment ).ToSpiceString() );
+        }
+
+        if( values.empty() )
+        {
+            aError.Printf( _( "No values to sweep in '%s'." ), line );
+            return false;
+        }
+
+        sweeps.emplace_back( tokens[2].Lower(), std::move( values ) );
+    }
+
+    if( sweeps.empty() )
+        return true;
+
+    size_t count = 1;
+
+    for( const auto& [ name, values ] : sweeps )
+    {
+        count *= values.size();
+
+        if( count > MAX_SWEEP_POINTS )
+        {
+            aError.Printf( _( "Sweeps are limited to %d points." ), (int) MAX_SWEEP_POINTS );
+            return false;
+        }
+    }
+
+    // The first directive is the outer loop
+    for( size_t ii = 0; ii < count; ++ii )
+    {
+        SIM_SWEEP_POINT point;
+        size_t          stride = count;
+
+        for( const auto& [ name, values ] : sweeps )
+        {
+            stride /= values.size();
+            point.m_params.emplace_back( name, values[( ii / stride ) % values.size()] );
+        }
+
+        aPoints.push_back( std::move( point ) );
+    }
+
+    aSimCommand = command;
+    return true;
+}
+
+
+std::string SIM_SWEEP_RUNNER::ApplyPoint( const std::string& aNetlist,
+                                          const SIM_SWEEP_POINT& aPoint, int aSeed )
+{
+    std::vector<std::regex> definitions;
+    std::vector<bool>       defined( aPoint.m_params.size(), false );
+
+    // Parameter names are checked by ParseStepDirectives(), they need no escaping
+    for( const auto& [ name, value ] : aPoint.m_params )
+    {
+        definitions.emplace_back( "(^|[\\s,])(" + name.ToStdString()
+                                          + ")\\s*=\\s*(\\{[^}]*\\}|'[^']*'|[^\\s,]+)",
+                                  std::regex::icase );
+    }
+
+    auto overrides =
+            [&]()
+            {
+                std::string cards;
+
+                for( size_t ii = 0; ii < aPoint.m_params.size(); ++ii )
+                {
+                    if( !defined[ii] )
+                    {
+                        cards += ".param " + aPoint.m_params[ii].first.ToStdString() + "="
+                                 + aPoint.m_params[ii].second.ToStdString() + "\n";
+                    }
+                }
+
+                return cards + ".options seed=" + std::to_string( aSeed ) + "\n";
+            };
+
+    std::istringstream in( aNetlist );
+    std::string        line;
+    std::string        netlist;
+    bool               ended = false;
+
+    while( std::getline( in, line ) )
+    {
+        size_t      start = line.find_first_not_of( " \t" );
+        std::string card = start == std::string::npos ? std::string() : line.substr( start );
+
+        std::transform( card.begin(), card.end(), card.begin(),
+                        []( unsigned char c ) { return (char) std::tolower( c ); } );
+
+        if( card.rfind( ".param", 0 ) == 0 )
+        {
+            for( size_t ii = 0; ii < aPoint.m_params.size(); ++ii )
+            {
+                if( std::regex_search( line, definitions[ii] ) )
+                {
+                    line = std::regex_replace( line, definitions[ii],
+                                               "$1$2=" + aPoint.m_params[ii].second.ToStdString() );
+                    defined[ii] = true;
+                }
+            }
+        }
+        else if( !ended && ( card == ".end" || card.rfind( ".end ", 0 ) == 0 ) )
+        {
+            netlist += overrides();
+            ended = true;
+        }
+
+        netlist += line + "\n";
+    }
+
+    if( !ended )
+        netlist += overrides() + ".end\n";
+
+    return netlist;
+}
+
+
+bool SIM_SWEEP_RUNNER::ParseRawFile( const std::string& aContents, SIM_RAW_PLOT& aPlot )
+{
+    LOCALE_IO toggle;      // ngspice writes numbers in the "C" locale
+
+    size_t pos = 0;
+    bool   found = false;
+
+    auto readLine =
+            [&]( std::string& aLine )
+            {
+                if( pos >= aContents.size() )
+                    return false;
+
+                size_t end = aContents.find( '\n', pos );
+
+                if( end == std::string::npos )
+                    end = aContents.size();
+
+                aLine = aContents.substr( pos, end - pos );
+                pos = end + 1;
+
+                if( !aLine.empty() && aLine.back() == '\r' )
+                    aLine.pop_back();
+
+                return true;
+            };
+
+    auto readValue =
+            [&]( double& aReal, double& aImag )
+            {
+                const char* begin = aContents.c_str() + pos;
+                char*       end = nullptr;
+
+                aReal = std::strtod( begin, &end );
+                aImag = 0.0;
+
+                if( end == begin )
+                    return false;
+
+                if( *end == ',' )
+                {
+                    const char* imag = end + 1;
+                    aImag = std::strtod( imag, &end );
+                }
+
+                pos += end - begin;
+                return true;
+            };
+
+    auto headerValue =
+            []( const std::string& aLine, const char* aKey, std::string& aValue )
+            {
+                size_t length = strlen( aKey );
+
+                if( aLine.compare( 0, length, aKey ) != 0 )
+                    return false;
+
+                size_t start = aLine.find_first_not_of( " \t", length );
+                aValue = start == std::string::npos ? std::string() : aLine.substr( start );
+                return true;
+            };
+
+    while( pos < aContents.size() )
+    {
+        SIM_RAW_PLOT plot;
+        size_t       varCount = 0;
+        size_t       pointCount = 0;
+        bool         binary = false;
+        bool         ascii = false;
+        std::string  line;
+        std::string  value;
+
+        while( !binary && !ascii && readLine( line ) )
+        {
+            if( headerValue( line, "Plotname:", value ) )
+            {
+                plot.m_plotName = wxString::FromUTF8( value );
+            }
+            else if( headerValue( line, "Flags:", value ) )
+            {
+                plot.m_complex = value.find( "complex" ) != std::string::npos;
+            }
+            else if( headerValue( line, "No. Variables:", value ) )
+            {
+                varCount = std::strtoul( value.c_str(), nullptr, 10 );
+            }
+            else if( headerValue( line, "No. Points:", value ) )
+            {
+                pointCount = std::strtoul( value.c_str(), nullptr, 10 );
+            }
+            else if( headerValue( line, "Variables:", value ) )
+            {
+                for( size_t ii = 0; ii < varCount && readLine( line ); ++ii )
+                {
+                    std::istringstream fields( line );
+                    std::string        index, name;
+
+                    fields >> index >> name;
+                    plot.m_names.push_back( name );
+                }
+            }
+            else if( headerValue( line, "Binary:", value ) )
+            {
+                binary = true;
+            }
+            else if( headerValue( line, "Values:", value ) )
+            {
+                ascii = true;
+            }
+        }
+
+        if( !binary && !ascii )
+            break;
+
+        if( varCount == 0 || plot.m_names.size() != varCount )
+            break;
+
+        plot.m_real.resize( varCount );
+
+        if( plot.m_complex )
+            plot.m_imag.resize( varCount );
+
+        if( binary )
+        {
+            size_t width = plot.m_complex ? 2 : 1;
+            size_t pointSize = varCount * width * sizeof( double );
+
+            // A run which was interrupted leaves fewer points than announced
+            pointCount = std::min( pointCount, ( aContents.size() - pos ) / pointSize );
+
+            for( size_t point = 0; point < pointCount; ++point )
+            {
+                for( size_t var = 0; var < varCount; ++var )
+                {
+                    double data[2] = { 0.0, 0.0 };
+
+                    memcpy( data, aContents.data() + pos, width * sizeof( double ) );
+                    pos += width * sizeof( double );
+
+                    plot.m_real[var].push_back( data[0] );
+
+                    if( plot.m_complex )
+                        plot.m_imag[var].push_back( data[1] );
+                }
+            }
+        }
+        else
+        {
+            bool complete = true;
+
+            for( size_t point = 0; point < pointCount && complete; ++point )
+            {
+                double index, unused;
+
+                // Each point starts with its index
+                complete = readValue( index, unused );
+
+                for( size_t var = 0; var < varCount && complete; ++var )
+                {
+                    double real, imag;
+
+                    complete = readValue( real, imag );
+
+                    if( !complete )
+                        break;
+
+                    plot.m_real[var].push_back( real );
+
+                    if( plot.m_complex )
+                        plot.m_imag[var].push_back( imag );
+                }
+            }
+
+            // Drop a partial point
+            size_t points = plot.m_real.back().size();
+
+            for( std::vector<double>& vector : plot.m_real )
+                vector.resize( points );
+
+            for( std::vector<double>& vector : plot.m_imag )
+                vector.resize( points );
+
+            // Skip to the line following the values
+            readLine( line );
+        }
+
+        aPlot = std::move( plot );
+        found = true;
+    }
+
+    return found;
+}
+
+
+wxString SIM_SWEEP_RUNNER::FindNgspice()
+{
+    wxPathList paths;
+
+    paths.AddEnvList( wxS( "PATH" ) );
+
+#ifdef __WINDOWS__
+    // ngspice.exe is the GUI flavor
+    return paths.FindAbsoluteValidPath( wxS( "ngspice_con.exe" ) );
+#else
+    return paths.FindAbsoluteValidPath( wxS( "ngspice" ) );
+#endif
+}
+
+
+bool SIM_SWEEP_RUNNER::Start( std::function<void( int aDone, int aCount )> aOnProgress,
+                              std::function<void()> aOnFinished )
+{
+    m_ngspice = FindNgspice();
+
+    if( m_ngspice.IsEmpty() )
+        return false;
+
+    m_onProgress = std::move( aOnProgress );
+    m_onFinished = std::move( aOnFinished );
+
+    m_results.assign( m_points.size(), SIM_RAW_PLOT() );
+    m_netlistFiles.assign( m_points.size(), wxEmptyString );
+    m_processes.assign( m_points.size(), nullptr );
+    m_next = 0;
+    m_running = 0;
+    m_done = 0;
+
+    startRuns();
+    return true;
+}
+
+
+void SIM_SWEEP_RUNNER::Cancel()
+{
+    m_next = m_points.size();
+    m_onFinished = nullptr;
+
+    for( size_t ii = 0; ii < m_processes.size(); ++ii )
+    {
+        if( SIM_SWEEP_PROCESS* process = m_processes[ii] )
+        {
+            process->m_runner = nullptr;
+            wxProcess::Kill( process->GetPid(), wxSIGKILL );
+            m_processes[ii] = nullptr;
+        }
+
+        if( !m_netlistFiles[ii].IsEmpty() )
+        {
+            removeRunFiles( m_netlistFiles[ii] );
+            m_netlistFiles[ii].Clear();
+        }
+    }
+
+    m_running = 0;
+}
+
+
+void SIM_SWEEP_RUNNER::startRuns()
+{
+    int maxRunning = std::max( 1, (int) GetKiCadThreadPool().get_thread_count() );
+
+    while( m_running < maxRunning && m_next < m_points.size() )
+        launch( m_next++ );
+
+    if( m_running == 0 && m_next >= m_points.size() && m_onFinished )
+    {
+        // The callback may delete the runner
+        std::function<void()> onFinished = std::move( m_onFinished );
+        m_onFinished = nullptr;
+        onFinished();
+    }
+}
+
+
+void SIM_SWEEP_RUNNER::launch( size_t aIndex )
+{
+    wxString    base = wxFileName::CreateTempFileName( wxS( "kicad_sweep" ) );
+    std::string netlist = ApplyPoint( m_netlist, m_points[aIndex], (int) aIndex + 1 );
+
+    m_netlistFiles[aIndex] = base;
+
+    if( !base.IsEmpty() )
+    {
+        wxFFile file( base + wxS( ".cir" ), wxS( "wb" ) );
+
+        if( file.IsOpened() && file.Write( netlist.data(), netlist.size() ) == netlist.size()
+                && file.Close() )
+        {
+            wxString command = wxString::Format( wxS( "\"%s\" -b -o \"%s.log\" -r \"%s.raw\" "
+                                                      "\"%s.cir\"" ),
+                                                 m_ngspice, base, base, base );
+
+            SIM_SWEEP_PROCESS* process = new SIM_SWEEP_PROCESS( this, aIndex );
+
+            if( wxExecute( command, wxEXEC_ASYNC | wxEXEC_HIDE_CONSOLE, process ) > 0 )
+            {
+                m_processes[aIndex] = process;
+                m_running++;
+                return;
+            }
+
+            delete process;
+        }
+    }
+
+    // The point failed, its plot stays empty
+    finish( aIndex );
+}
+
+
+void SIM_SWEEP_RUNNER::onTerminated( size_t aIndex )
+{
+    m_processes[aIndex] = nullptr;
+    m_running--;
+
+    finish( aIndex );
+    startRuns();
+}
+
+
+void SIM_SWEEP_RUNNER::finish( size_t aIndex )
+{
+    const wxString& base = m_netlistFiles[aIndex];
+
+    if( !base.IsEmpty() )
+    {
+        wxFFile file( base + wxS( ".raw" ), wxS( "rb" ) );
+
+        if( file.IsOpened() )
+        {
+            std::string contents( file.Length(), '\0' );
+
+            if( file.Read( contents.data(), contents.size() ) == contents.size() )
+                ParseRawFile( contents, m_results[aIndex] );
+
+            file.Close();
+        }
+
+        removeRunFiles( base );
+        m_netlistFiles[aIndex].Clear();
+    }
+
+    m_done++;
+
+    if( m_onProgress )
+        m_onProgress( m_done, (int) m_points.size() );
+}
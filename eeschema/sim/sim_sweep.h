@@ -0,0 +1,175 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SIM_SWEEP_H
+#define SIM_SWEEP_H
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <wx/string.h>
+
+class SIM_SWEEP_PROCESS;
+
+
+/**
+ * The vectors of an analysis, read from a SPICE raw file.
+ */
+struct SIM_RAW_PLOT
+{
+    wxString                         m_plotName;
+    bool                             m_complex = false;
+
+    /// Names of the vectors, the first one being the scale (time, frequency, ...)
+    std::vector<std::string>         m_names;
+
+    std::vector<std::vector<double>> m_real;
+    std::vector<std::vector<double>> m_imag;    ///< Empty unless m_complex
+
+    /**
+     * @return the index of the vector \a aName, or -1 if there is none.  Names are matched the
+     *         way ngspice does, so "V(out)" matches "out" and "I(V1)" matches "v1#branch".
+     */
+    int FindVector( const wxString& aName ) const;
+};
+
+
+/**
+ * One run of a parameter sweep: the values given to the swept parameters.
+ */
+struct SIM_SWEEP_POINT
+{
+    std::vector<std::pair<wxString, wxString>> m_params;
+
+    /**
+     * @return a description of the point, such as "rload=1k cload=10n".
+     */
+    wxString GetLabel() const;
+};
+
+
+/**
+ * Run the points of a parameter sweep or Monte Carlo analysis in parallel, each one in its own
+ * ngspice process, as the ngspice library holds a single circuit.
+ *
+ * Sweeps are described by .step directives in the simulation command, in the syntax of other
+ * SPICE simulators:
+ *
+ *     .step param <name> <start> <stop> <increment>
+ *     .step param <name> list <value> <value> ...
+ *
+ * Several directives make nested sweeps.  Each run gets its own random seed, so that stepping
+ * a dummy parameter over a circuit using agauss() and the other random functions makes a
+ * Monte Carlo analysis.
+ */
+class SIM_SWEEP_RUNNER
+{
+public:
+    SIM_SWEEP_RUNNER( const std::string& aNetlist, const std::vector<SIM_SWEEP_POINT>& aPoints );
+
+    ~SIM_SWEEP_RUNNER();
+
+    /**
+     * Remove the .step directives from a simulation command and expand them into the points of
+     * the sweep.
+     *
+     * @param aSimCommand [in,out] is the simulation command.
+     * @param aPoints [out] receives the points of the sweep, if there is a .step directive.
+     * @param aError [out] receives a description of the first invalid directive.
+     * @return false if a directive is invalid.
+     */
+    static bool ParseStepDirectives( wxString& aSimCommand, std::vector<SIM_SWEEP_POINT>& aPoints,
+                                     wxString& aError );
+
+    /**
+     * Give the values of \a aPoint to the parameters it sweeps, by replacing their definitions
+     * in the .param cards of \a aNetlist or adding new cards before the .end card, and set the
+     * seed of the random number generator.
+     */
+    static std::string ApplyPoint( const std::string& aNetlist, const SIM_SWEEP_POINT& aPoint,
+                                   int aSeed );
+
+    /**
+     * Read the last analysis of a raw file written by ngspice, in ASCII or binary format.
+     *
+     * @return false if the file holds no analysis.
+     */
+    static bool ParseRawFile( const std::string& aContents, SIM_RAW_PLOT& aPlot );
+
+    /**
+     * @return the ngspice program found in the search path, or an empty string.
+     */
+    static wxString FindNgspice();
+
+    /**
+     * Start the runs, at most as many at a time as the KiCad thread pool has threads.
+     *
+     * @param aOnProgress is called from the main thread after each run.
+     * @param aOnFinished is called from the main thread once all the runs are over.
+     * @return false if the ngspice program can't be found.
+     */
+    bool Start( std::function<void( int aDone, int aCount )> aOnProgress,
+                std::function<void()> aOnFinished );
+
+    /**
+     * Kill the running processes and drop the runs not started yet.  The finished callback is
+     * not called.
+     */
+    void Cancel();
+
+    bool IsRunning() const { return m_running > 0; }
+
+    const std::vector<SIM_SWEEP_POINT>& GetPoints() const { return m_points; }
+
+    /**
+     * @return the results of each point, in the order of GetPoints().  The plot of a failed
+     *         run has no vectors.
+     */
+    const std::vector<SIM_RAW_PLOT>& GetResults() const { return m_results; }
+
+private:
+    friend class SIM_SWEEP_PROCESS;
+
+    /// Launch runs up to the number of threads, or call the finished callback when all are over
+    void startRuns();
+
+    void launch( size_t aIndex );
+    void onTerminated( size_t aIndex );
+
+    /// Read the results of a run and remove its files
+    void finish( size_t aIndex );
+
+    std::string                             m_netlist;
+    std::vector<SIM_SWEEP_POINT>            m_points;
+    std::vector<SIM_RAW_PLOT>               m_results;
+
+    wxString                                m_ngspice;
+    std::vector<wxString>                   m_netlistFiles;
+    std::vector<SIM_SWEEP_PROCESS*>         m_processes;
+    size_t                                  m_next;
+    int                                     m_running;
+    int                                     m_done;
+
+    std::function<void( int, int )>         m_onProgress;
+    std::function<void()>                   m_onFinished;
+};
+
+#endif // SIM_SWEEP_H
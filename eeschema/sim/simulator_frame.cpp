@@ -48,11 +48,13 @@
 #include <tools/simulator_control.h>
 #include <tools/ee_actions.h>
 #include <string_utils.h>
+#include <richio.h>
 #include <pgm_base.h>
 #include "ngspice.h"
 #include <sim/simulator_frame.h>
 #include <sim/simulator_frame_ui.h>
 #include <sim/sim_plot_tab.h>
+#include <sim/sim_sweep.h>
 #include <sim/spice_simulator.h>
 #include <sim/simulator_reporter.h>
 #include <eeschema_settings.h>
@@ -194,6 +196,8 @@ SIMULATOR_FRAME::~SIMULATOR_FRAME()
 {
     NULL_REPORTER devnull;
 
+    StopSweep();
+
     m_simulator->Attach( nullptr, wxEmptyString, 0, devnull );
     m_simulator->SetReporter( nullptr );
     delete m_reporter;
@@ -417,6 +421,22 @@ void SIMULATOR_FRAME::StartSimulation()
         }
     }
 
+    wxString                     simCommand = simTab->GetSimCommand();
+    std::vector<SIM_SWEEP_POINT> sweepPoints;
+    wxString                     error;
+
+    if( !SIM_SWEEP_RUNNER::ParseStepDirectives( simCommand, sweepPoints, error ) )
+    {
+        DisplayErrorMessage( this, error );
+        return;
+    }
+
+    if( !sweepPoints.empty() )
+    {
+        startSweep( simCommand, simTab->GetSimOptions(), sweepPoints );
+        return;
+    }
+
     if( !LoadSimulator( simTab->GetSimCommand(), simTab->GetSimOptions() ) )
         return;
 
@@ -434,6 +454,84 @@ void SIMULATOR_FRAME::StartSimulation()
 }
 
 
+bool SIMULATOR_FRAME::IsSweepRunning() const
+{
+    return m_sweepRunner && m_sweepRunner->IsRunning();
+}
+
+
+void SIMULATOR_FRAME::StopSweep()
+{
+    if( m_sweepRunner )
+        m_sweepRunner->Cancel();
+
+    m_sweepRunner.reset();
+}
+
+
+void SIMULATOR_FRAME::startSweep( const wxString& aSimCommand, unsigned aSimOptions,
+                                  const std::vector<SIM_SWEEP_POINT>& aPoints )
+{
+    SIM_TYPE simType = SPICE_CIRCUIT_MODEL::CommandToSimType( aSimCommand );
+
+    if( simType != ST_TRAN && simType != ST_AC && simType != ST_DC )
+    {
+        DisplayErrorMessage( this, _( "Parameter sweeps are only supported for transient, AC "
+                                      "and DC analyses." ) );
+        return;
+    }
+
+    if( IsSweepRunning() || m_simulator->IsRunning() )
+    {
+        DisplayErrorMessage( this, _( "Another simulation is already running." ) );
+        return;
+    }
+
+    if( !m_schematicFrame->ReadyToNetlist( _( "Simulator requires a fully annotated schematic." ) ) )
+        return;
+
+    if( ADVANCED_CFG::GetCfg().m_IncrementalConnectivity )
+        m_schematicFrame->RecalculateConnections( nullptr, GLOBAL_CLEANUP );
+
+    wxString           errors;
+    WX_STRING_REPORTER reporter( &errors );
+    STRING_FORMATTER   formatter;
+
+    if( !m_circuitModel->GetNetlist( aSimCommand, aSimOptions, &formatter, reporter ) )
+    {
+        DisplayErrorMessage( this, _( "Errors during netlist generation.\n\n" ) + errors );
+        return;
+    }
+
+    m_ui->OnSimReport( wxString::Format( _( "Running %d sweep points..." ),
+                                         (int) aPoints.size() ) );
+
+    m_sweepRunner = std::make_unique<SIM_SWEEP_RUNNER>( formatter.GetString(), aPoints );
+
+    bool started = m_sweepRunner->Start(
+            [this]( int aDone, int aCount )
+            {
+                m_ui->OnSimReport( wxString::Format( _( "Sweep point %d of %d done." ), aDone,
+                                                     aCount ) );
+            },
+            [this]()
+            {
+                m_ui->OnSweepFinished( *m_sweepRunner );
+                m_ui->OnSimReport( _( "Sweep finished." ) );
+
+                // Not from within the runner's own callback
+                CallAfter( [this]() { StopSweep(); } );
+            } );
+
+    if( !started )
+    {
+        m_sweepRunner.reset();
+        DisplayErrorMessage( this, _( "Parameter sweeps need the ngspice program, which was not "
+                                      "found in the search path." ) );
+    }
+}
+
+
 SIM_TAB* SIMULATOR_FRAME::NewSimTab( const wxString& aSimCommand )
 {
     return m_ui->NewSimTab( aSimCommand );
@@ -643,7 +741,7 @@ void SIMULATOR_FRAME::setupUIConditions()
     auto simRunning =
             [this]( const SELECTION& aSel )
             {
-                return m_simulator && m_simulator->IsRunning();
+                return ( m_simulator && m_simulator->IsRunning() ) || IsSweepRunning();
             };
 
     auto simFinished =
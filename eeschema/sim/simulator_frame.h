@@ -45,6 +45,8 @@ class SCH_EDIT_FRAME;
 class SCH_SYMBOL;
 class SIMULATOR_FRAME_UI;
 class SIM_THREAD_REPORTER;
+class SIM_SWEEP_RUNNER;
+struct SIM_SWEEP_POINT;
 class ACTION_TOOLBAR;
 class SPICE_SIMULATOR;
 
@@ -82,6 +84,16 @@ public:
 
     void StartSimulation();
 
+    /**
+     * @return true while the runs of a parameter sweep are in progress.
+     */
+    bool IsSweepRunning() const;
+
+    /**
+     * Kill the runs of the parameter sweep in progress, if any.
+     */
+    void StopSweep();
+
     /**
      * Create a new plot tab for a given simulation type.
      *
@@ -199,6 +211,13 @@ private:
 
     void onExit( wxCommandEvent& event );
 
+    /**
+     * Run the points of a parameter sweep in ngspice processes and plot their results once
+     * they are all over.
+     */
+    void startSweep( const wxString& aSimCommand, unsigned aSimOptions,
+                     const std::vector<SIM_SWEEP_POINT>& aPoints );
+
 private:
     SCH_EDIT_FRAME*                      m_schematicFrame;
     ACTION_TOOLBAR*                      m_toolBar;
@@ -207,6 +226,7 @@ private:
     std::shared_ptr<SPICE_SIMULATOR>     m_simulator;
     SIM_THREAD_REPORTER*                 m_reporter;
     std::shared_ptr<SPICE_CIRCUIT_MODEL> m_circuitModel;
+    std::unique_ptr<SIM_SWEEP_RUNNER>    m_sweepRunner;
 
     bool                                 m_simFinished;
     bool                                 m_workbookModified;
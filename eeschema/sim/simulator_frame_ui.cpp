@@ -45,6 +45,7 @@
 #include <sim/simulator_frame_ui.h>
 #include <sim/simulator_frame.h>
 #include <sim/sim_plot_tab.h>
+#include <sim/sim_sweep.h>
 #include <sim/spice_simulator.h>
 #include <dialogs/dialog_text_entry.h>
 #include <dialogs/dialog_sim_format_value.h>
@@ -1658,6 +1659,17 @@ void SIMULATOR_FRAME_UI::updateTrace( const wxString& aVectorName, int aTraceTyp
     }
 
     unsigned int size = aDataX->size();
+    unsigned int start = 0;
+
+    // A running transient analysis only appends to its vectors, so traces already plotted from
+    // it only need the points added since
+    if( simType == ST_TRAN )
+    {
+        TRACE* trace = aPlotTab->GetTrace( aVectorName, aTraceType );
+
+        if( trace && m_streamedTraces.count( trace ) && trace->GetDataX().size() <= size )
+            start = trace->GetDataX().size();
+    }
 
     switch( simType )
     {
@@ -1684,8 +1696,12 @@ void SIMULATOR_FRAME_UI::updateTrace( const wxString& aVectorName, int aTraceTyp
         data_y = simulator()->GetGainVector( (const char*) simVectorName.c_str(), -1 );
         break;
 
-    case ST_NOISE:
     case ST_TRAN:
+        data_y = simulator()->GetGainVector( (const char*) simVectorName.c_str(), size - start,
+                                             start );
+        break;
+
+    case ST_NOISE:
     case ST_FFT:
         data_y = simulator()->GetGainVector( (const char*) simVectorName.c_str(), size );
         break;
@@ -1732,8 +1748,23 @@ void SIMULATOR_FRAME_UI::updateTrace( const wxString& aVectorName, int aTraceTyp
     }
     else if( TRACE* trace = aPlotTab->GetOrAddTrace( aVectorName, aTraceType ) )
     {
-        if( data_y.size() >= size )
-            aPlotTab->SetTraceData( trace, *aDataX, data_y );
+        if( start > 0 )
+        {
+            if( data_y.size() >= size - start )
+            {
+                std::vector<double> new_x( aDataX->begin() + start, aDataX->end() );
+                aPlotTab->AppendTraceData( trace, new_x, data_y );
+            }
+        }
+        else if( data_y.size() >= size )
+        {
+            // SetTraceData() may drop the first point, and the x axis is shared between traces
+            std::vector<double> x = *aDataX;
+            aPlotTab->SetTraceData( trace, x, data_y );
+        }
+
+        if( simType == ST_TRAN && simulator()->IsRunning() )
+            m_streamedTraces.insert( trace );
     }
 }
 
@@ -2579,6 +2610,7 @@ void SIMULATOR_FRAME_UI::OnSimUpdate()
         plotTab->ResetScales( true );
 
     m_simConsole->Clear();
+    m_streamedTraces.clear();
 
     // Do not export netlist, it is already stored in the simulator
     applyTuners();
@@ -2621,11 +2653,89 @@ std::vector<wxString> SIMULATOR_FRAME_UI::Signals() const
 }
 
 
+void SIMULATOR_FRAME_UI::OnSweepFinished( const SIM_SWEEP_RUNNER& aRunner )
+{
+    SIM_PLOT_TAB* plotTab = dynamic_cast<SIM_PLOT_TAB*>( GetCurrentSimTab() );
+
+    if( !plotTab )
+        return;
+
+    SIM_TYPE simType = plotTab->GetSimType();
+    int      failed = 0;
+
+    for( const SIM_RAW_PLOT& plot : aRunner.GetResults() )
+    {
+        if( plot.m_real.empty() )
+            failed++;
+    }
+
+    for( const wxString& signal : m_signals )
+    {
+        int      traceType = SPT_UNKNOWN;
+        wxString vectorName = vectorNameFromSignalName( plotTab, signal, &traceType );
+        wxString simVectorName = vectorName;
+
+        traceType &= SPT_Y_AXIS_MASK;
+        traceType |= getXAxisType( simType );
+
+        if( traceType & SPT_POWER )
+            simVectorName = simVectorName.AfterFirst( '(' ).BeforeLast( ')' ) + wxS( ":power" );
+
+        for( size_t ii = 0; ii < aRunner.GetPoints().size(); ++ii )
+        {
+            const SIM_RAW_PLOT& plot = aRunner.GetResults()[ii];
+            int                 index = plot.FindVector( simVectorName );
+
+            if( index < 1 )
+                continue;
+
+            std::vector<double> data_x = plot.m_real[0];
+            std::vector<double> data_y = plot.m_real[index];
+
+            if( simType == ST_AC && plot.m_complex )
+            {
+                for( size_t jj = 0; jj < data_y.size(); ++jj )
+                {
+                    double re = plot.m_real[index][jj];
+                    double im = plot.m_imag[index][jj];
+
+                    data_y[jj] = ( traceType & SPT_AC_PHASE ) ? atan2( im, re ) : hypot( re, im );
+                }
+            }
+
+            wxString name = wxString::Format( wxS( "%s [%s]" ), vectorName,
+                                              aRunner.GetPoints()[ii].GetLabel() );
+
+            if( TRACE* trace = plotTab->GetOrAddTrace( name, traceType ) )
+                plotTab->SetTraceData( trace, data_x, data_y );
+        }
+    }
+
+    if( failed )
+    {
+        m_simConsole->AppendText( wxString::Format( _( "\n%d of %d sweep points failed.\n" ),
+                                                    failed, (int) aRunner.GetPoints().size() ) );
+        m_simConsole->SetInsertionPointEnd();
+    }
+
+    plotTab->GetPlotWin()->UpdateAll();
+    plotTab->ResetScales( true );
+    plotTab->GetPlotWin()->Fit();
+
+    updatePlotCursors();
+}
+
+
 void SIMULATOR_FRAME_UI::OnSimRefresh( bool aFinal )
 {
     if( aFinal )
+    {
         m_refreshTimer.Stop();
 
+        // Whole vectors are fetched once more, in case ngspice rewrote them when finishing
+        m_streamedTraces.clear();
+    }
+
     SIM_TAB* simTab = GetCurrentSimTab();
 
     if( !simTab )
@@ -2732,13 +2842,17 @@ void SIMULATOR_FRAME_UI::OnSimRefresh( bool aFinal )
         for( const auto& [ trace, traceInfo ] : traceMap )
         {
             if( traceInfo.Vector.IsEmpty() )
+            {
+                m_streamedTraces.erase( trace );
                 plotTab->DeleteTrace( trace );
+            }
         }
 
+        // The x axis is fetched once for all the traces
+        std::vector<double> data_x;
+
         for( const auto& [ trace, info ] : traceMap )
         {
-            std::vector<double> data_x;
-
             if( !info.Vector.IsEmpty() )
                 updateTrace( info.Vector, info.TraceType, plotTab, &data_x, info.ClearData );
         }
@@ -33,12 +33,15 @@
 #include <sim/sim_types.h>
 #include <sim/sim_plot_tab.h>
 
+#include <set>
+
 #include <wx/event.h>
 
 class SCH_EDIT_FRAME;
 class SCH_SYMBOL;
 
 class SPICE_SIMULATOR;
+class SIM_SWEEP_RUNNER;
 class SPICE_SETTINGS;
 class EESCHEMA_SETTINGS;
 class SPICE_CIRCUIT_MODEL;
@@ -223,6 +226,12 @@ public:
     void OnSimReport( const wxString& aMsg );
     void OnSimRefresh( bool aFinal );
 
+    /**
+     * Plot the results of a parameter sweep: a trace of each plotted signal for each point of
+     * the sweep.
+     */
+    void OnSweepFinished( const SIM_SWEEP_RUNNER& aRunner );
+
     void OnModify();
 
 private:
@@ -239,6 +248,8 @@ private:
      * @param aVectorName is the SPICE vector name, such as "I(Net-C1-Pad1)".
      * @param aTraceType describes the type of plot.
      * @param aPlotTab is the tab that should receive the update.
+     * @param aDataX is the x axis vector, fetched on the first call and shared by the calls
+     *               that follow.
      */
     void updateTrace( const wxString& aVectorName, int aTraceType, SIM_PLOT_TAB* aPlotTab,
                       std::vector<double>* aDataX = nullptr, bool aClearData = false );
@@ -342,6 +353,10 @@ private:
     bool                         m_darkMode;
     unsigned int                 m_plotNumber;
     wxTimer                      m_refreshTimer;
+
+    ///< Traces plotted from the running transient analysis, to which the points it adds are
+    ///< appended rather than fetching whole vectors again on each refresh
+    std::set<TRACE*>             m_streamedTraces;
 };
 
 #endif // SIMULATOR_FRAME_UI_H
@@ -98,6 +98,8 @@ static SIM_MODEL::TYPE getFallbackType( const wxString& aToken, const wxString&
 
 void SPICE_LIBRARY_PARSER::readFallbacks( const wxString& aFilePath, REPORTER& aReporter )
 {
+    m_library.m_sourceFiles.push_back( aFilePath );
+
     try
     {
         wxArrayString lines = wxSplit( SafeReadFile( aFilePath, wxS( "r" ) ), '\n' );
@@ -115,6 +117,7 @@ void SPICE_LIBRARY_PARSER::readFallbacks( const wxString& aFilePath, REPORTER& a
 
                 m_library.m_models.push_back( std::make_unique<SIM_MODEL_SPICE_FALLBACK>( type ) );
                 m_library.m_modelNames.emplace_back( name );
+                m_library.m_modelSources.emplace_back();
             }
             else if( token == wxS( ".inc" ) )
             {
@@ -136,6 +139,8 @@ void SPICE_LIBRARY_PARSER::readFallbacks( const wxString& aFilePath, REPORTER& a
 
 void SPICE_LIBRARY_PARSER::parseFile( const wxString &aFilePath, REPORTER& aReporter )
 {
+    m_library.m_sourceFiles.push_back( aFilePath );
+
     try
     {
         tao::pegtl::string_input<> in( SafeReadFile( aFilePath, wxS( "r" ) ).ToStdString(),
@@ -152,10 +157,21 @@ void SPICE_LIBRARY_PARSER::parseFile( const wxString &aFilePath, REPORTER& aRepo
                 std::string model = node->string();
                 std::string modelName = node->children.at( 0 )->string();
 
+                // Most users of a library only need a few of its models, so leave the parsing
+                // of each one until it's looked up
+                if( !m_forceFullParse )
+                {
+                    m_library.m_models.emplace_back();
+                    m_library.m_modelNames.emplace_back( modelName );
+                    m_library.m_modelSources.emplace_back( std::move( model ) );
+                    continue;
+                }
+
                 try
                 {
                     m_library.m_models.push_back( SIM_MODEL_SPICE::Create( m_library, model ) );
                     m_library.m_modelNames.emplace_back( modelName );
+                    m_library.m_modelSources.emplace_back();
                 }
                 catch( const IO_ERROR& e )
                 {
@@ -209,6 +225,8 @@ void SPICE_LIBRARY_PARSER::ReadFile( const wxString& aFilePath, REPORTER& aRepor
 {
     m_library.m_models.clear();
     m_library.m_modelNames.clear();
+    m_library.m_modelSources.clear();
+    m_library.m_sourceFiles.clear();
 
     // Aside from the simulation model editor dialog, about the only data we use from the
     // complete models are the pin definitions for SUBCKTs.  The standard LTSpice "cmp" libraries
@@ -135,9 +135,12 @@ public:
      * @param aName is the vector named in Spice convention (e.g. V(3), I(R1)).
      * @param aMaxLen is max count of returned values.
      * if -1 (default) all available values are returned.
+     * @param aStart is the index of the first returned value, so that the values a running
+     * analysis added since the last call can be fetched alone.
      * @return Requested vector. It might be empty if there is no vector with requested name.
      */
-    virtual std::vector<double> GetGainVector( const std::string& aName, int aMaxLen = -1 ) = 0;
+    virtual std::vector<double> GetGainVector( const std::string& aName, int aMaxLen = -1,
+                                               int aStart = 0 ) = 0;
 
     /**
      * Return a requested vector with phase values.
@@ -0,0 +1,293 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <symbol_lib_index.h>
+
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <wx/datetime.h>
+
+#include <lib_symbol.h>
+#include <paths.h>
+#include <symbol_lib_table.h>
+
+
+/// Bumped whenever the contents of the index file change meaning
+static const int INDEX_VERSION = 1;
+
+
+static std::string toUTF8( const wxString& aString )
+{
+    return std::string( aString.ToUTF8() );
+}
+
+
+static wxString fromUTF8( const nlohmann::json& aJson )
+{
+    return wxString::FromUTF8( aJson.get<std::string>().c_str() );
+}
+
+
+SYMBOL_INFO::SYMBOL_INFO( LIB_SYMBOL* aSymbol ) :
+        m_libId( aSymbol->GetLibId() ),
+        m_description( aSymbol->GetDescription() ),
+        m_footprint( aSymbol->GetFootprint() ),
+        m_pinCount( aSymbol->GetPinCount() ),
+        m_isRoot( aSymbol->IsRoot() ),
+        m_isPower( aSymbol->IsPower() ),
+        m_searchTerms( aSymbol->GetSearchTerms() )
+{
+    aSymbol->GetChooserFields( m_fields );
+
+    for( int unit = 1; unit <= aSymbol->GetUnitCount(); ++unit )
+    {
+        UNIT& entry = m_units.emplace_back();
+
+        entry.m_reference = aSymbol->GetUnitReference( unit );
+
+        if( aSymbol->HasUnitDisplayName( unit ) )
+            entry.m_displayName = aSymbol->GetUnitDisplayName( unit );
+    }
+}
+
+
+void SYMBOL_INFO::GetChooserFields( std::map<wxString , wxString>& aColumnMap )
+{
+    for( const auto& [ name, value ] : m_fields )
+        aColumnMap[name] = value;
+}
+
+
+wxString SYMBOL_INFO::GetUnitReference( int aUnit )
+{
+    if( aUnit < 1 || aUnit > (int) m_units.size() )
+        return wxEmptyString;
+
+    return m_units[aUnit - 1].m_reference;
+}
+
+
+wxString SYMBOL_INFO::GetUnitDisplayName( int aUnit )
+{
+    if( aUnit < 1 || aUnit > (int) m_units.size() )
+        return wxEmptyString;
+
+    return m_units[aUnit - 1].m_displayName;
+}
+
+
+bool SYMBOL_INFO::HasUnitDisplayName( int aUnit )
+{
+    return !GetUnitDisplayName( aUnit ).IsEmpty();
+}
+
+
+wxFileName SYMBOL_LIB_INDEX::GetDefaultPath()
+{
+    return wxFileName( PATHS::GetUserCachePath(), wxS( "symbol-lib-index.json" ) );
+}
+
+
+bool SYMBOL_LIB_INDEX::CanIndex( const SYMBOL_LIB_TABLE_ROW* aRow )
+{
+    return aRow && aRow->SchLibType() == SCH_IO_MGR::SCH_KICAD && !fileSignature( aRow ).IsEmpty();
+}
+
+
+wxString SYMBOL_LIB_INDEX::fileSignature( const SYMBOL_LIB_TABLE_ROW* aRow )
+{
+    wxFileName fileName( aRow->GetFullURI( true ) );
+
+    if( !fileName.FileExists() )
+        return wxEmptyString;
+
+    return wxString::Format( wxS( "%lld:%llu" ),
+                             (long long) fileName.GetModificationTime().GetValue().GetValue(),
+                             (unsigned long long) fileName.GetSize().GetValue() );
+}
+
+
+bool SYMBOL_LIB_INDEX::Load( const wxFileName& aPath )
+{
+    m_libraries.clear();
+
+    if( !aPath.FileExists() )
+        return false;
+
+    try
+    {
+        std::ifstream  stream( aPath.GetFullPath().fn_str() );
+        nlohmann::json json = nlohmann::json::parse( stream );
+
+        if( json.at( "version" ).get<int>() != INDEX_VERSION )
+            return false;
+
+        for( const auto& [ fileName, entry ] : json.at( "libraries" ).items() )
+        {
+            LIBRARY& library = m_libraries[wxString::FromUTF8( fileName.c_str() )];
+
+            library.m_signature = fromUTF8( entry.at( "signature" ) );
+
+            for( const nlohmann::json& field : entry.at( "fields" ) )
+                library.m_fields.push_back( fromUTF8( field ) );
+
+            for( const nlohmann::json& item : entry.at( "symbols" ) )
+            {
+                SYMBOL_INFO& symbol = library.m_symbols.emplace_back();
+
+                symbol.m_libId.SetLibItemName( fromUTF8( item.at( "name" ) ) );
+                symbol.m_description = fromUTF8( item.at( "description" ) );
+                symbol.m_footprint = fromUTF8( item.at( "footprint" ) );
+                symbol.m_pinCount = item.at( "pin_count" ).get<int>();
+                symbol.m_isRoot = item.at( "root" ).get<bool>();
+                symbol.m_isPower = item.at( "power" ).get<bool>();
+
+                for( const auto& [ name, value ] : item.at( "fields" ).items() )
+                    symbol.m_fields[wxString::FromUTF8( name.c_str() )] = fromUTF8( value );
+
+                for( const nlohmann::json& term : item.at( "search_terms" ) )
+                {
+                    symbol.m_searchTerms.emplace_back( fromUTF8( term.at( "text" ) ),
+                                                       term.at( "score" ).get<int>() );
+                }
+
+                for( const nlohmann::json& unit : item.at( "units" ) )
+                {
+                    symbol.m_units.push_back( { fromUTF8( unit.at( "reference" ) ),
+                                                fromUTF8( unit.at( "name" ) ) } );
+                }
+            }
+        }
+    }
+    catch( ... )
+    {
+        // A damaged or foreign file only means the libraries get parsed again
+        m_libraries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool SYMBOL_LIB_INDEX::Save( const wxFileName& aPath ) const
+{
+    nlohmann::json libraries = nlohmann::json::object();
+
+    for( const auto& [ fileName, library ] : m_libraries )
+    {
+        nlohmann::json fields = nlohmann::json::array();
+        nlohmann::json symbols = nlohmann::json::array();
+
+        for( const wxString& field : library.m_fields )
+            fields.push_back( toUTF8( field ) );
+
+        for( const SYMBOL_INFO& symbol : library.m_symbols )
+        {
+            nlohmann::json item;
+            nlohmann::json itemFields = nlohmann::json::object();
+            nlohmann::json terms = nlohmann::json::array();
+            nlohmann::json units = nlohmann::json::array();
+
+            for( const auto& [ name, value ] : symbol.m_fields )
+                itemFields[toUTF8( name )] = toUTF8( value );
+
+            for( const SEARCH_TERM& term : symbol.m_searchTerms )
+                terms.push_back( { { "text", toUTF8( term.Text ) }, { "score", term.Score } } );
+
+            for( const SYMBOL_INFO::UNIT& unit : symbol.m_units )
+            {
+                units.push_back( { { "reference", toUTF8( unit.m_reference ) },
+                                   { "name", toUTF8( unit.m_displayName ) } } );
+            }
+
+            item["name"] = toUTF8( symbol.m_libId.GetLibItemName() );
+            item["description"] = toUTF8( symbol.m_description );
+            item["footprint"] = toUTF8( symbol.m_footprint );
+            item["pin_count"] = symbol.m_pinCount;
+            item["root"] = symbol.m_isRoot;
+            item["power"] = symbol.m_isPower;
+            item["fields"] = itemFields;
+            item["search_terms"] = terms;
+            item["units"] = units;
+
+            symbols.push_back( item );
+        }
+
+        libraries[toUTF8( fileName )] = { { "signature", toUTF8( library.m_signature ) },
+                                          { "fields", fields },
+                                          { "symbols", symbols } };
+    }
+
+    nlohmann::json json;
+
+    json["version"] = INDEX_VERSION;
+    json["libraries"] = libraries;
+
+    std::ofstream stream( aPath.GetFullPath().fn_str() );
+
+    if( !stream )
+        return false;
+
+    stream << json << std::endl;
+
+    return stream.good();
+}
+
+
+bool SYMBOL_LIB_INDEX::Find( const SYMBOL_LIB_TABLE_ROW* aRow, std::vector<SYMBOL_INFO>& aSymbols,
+                             std::vector<wxString>& aFields ) const
+{
+    if( !CanIndex( aRow ) )
+        return false;
+
+    auto it = m_libraries.find( aRow->GetFullURI( true ) );
+
+    if( it == m_libraries.end() || it->second.m_signature != fileSignature( aRow ) )
+        return false;
+
+    aSymbols = it->second.m_symbols;
+    aFields = it->second.m_fields;
+
+    // The same file may be in the table under another nickname
+    for( SYMBOL_INFO& symbol : aSymbols )
+        symbol.m_libId.SetLibNickname( aRow->GetNickName() );
+
+    return true;
+}
+
+
+void SYMBOL_LIB_INDEX::Update( const SYMBOL_LIB_TABLE_ROW* aRow,
+                               const std::vector<LIB_SYMBOL*>& aSymbols,
+                               const std::vector<wxString>& aFields )
+{
+    if( !CanIndex( aRow ) )
+        return;
+
+    LIBRARY& library = m_libraries[aRow->GetFullURI( true )];
+
+    library.m_signature = fileSignature( aRow );
+    library.m_fields = aFields;
+    library.m_symbols.clear();
+
+    for( LIB_SYMBOL* symbol : aSymbols )
+        library.m_symbols.emplace_back( symbol );
+}
@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef SYMBOL_LIB_INDEX_H
+#define SYMBOL_LIB_INDEX_H
+
+#include <map>
+#include <vector>
+
+#include <lib_tree_item.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+class LIB_SYMBOL;
+class SYMBOL_LIB_TABLE_ROW;
+
+
+/**
+ * What the symbol chooser shows of a library symbol, so that it can be listed without loading
+ * its library.
+ */
+class SYMBOL_INFO : public LIB_TREE_ITEM
+{
+public:
+    SYMBOL_INFO() :
+            m_pinCount( 0 ),
+            m_isRoot( true ),
+            m_isPower( false )
+    {}
+
+    SYMBOL_INFO( LIB_SYMBOL* aSymbol );
+
+    LIB_ID GetLibId() const override { return m_libId; }
+    wxString GetName() const override { return m_libId.GetLibItemName(); }
+    wxString GetLibNickname() const override { return m_libId.GetLibNickname(); }
+    wxString GetDescription() override { return m_description; }
+
+    void GetChooserFields( std::map<wxString , wxString>& aColumnMap ) override;
+    std::vector<SEARCH_TERM> GetSearchTerms() override { return m_searchTerms; }
+
+    bool IsRoot() const override { return m_isRoot; }
+    bool IsPower() const { return m_isPower; }
+
+    wxString GetFootprint() override { return m_footprint; }
+    int GetPinCount() override { return m_pinCount; }
+
+    int GetUnitCount() const override { return (int) m_units.size(); }
+    wxString GetUnitReference( int aUnit ) override;
+    wxString GetUnitDisplayName( int aUnit ) override;
+    bool HasUnitDisplayName( int aUnit ) override;
+
+private:
+    friend class SYMBOL_LIB_INDEX;
+
+    struct UNIT
+    {
+        wxString m_reference;
+        wxString m_displayName;     ///< empty when the unit has none
+    };
+
+    LIB_ID                       m_libId;
+    wxString                     m_description;
+    wxString                     m_footprint;
+    int                          m_pinCount;
+    bool                         m_isRoot;
+    bool                         m_isPower;
+    std::map<wxString, wxString> m_fields;
+    std::vector<SEARCH_TERM>     m_searchTerms;
+    std::vector<UNIT>            m_units;
+};
+
+
+/**
+ * The chooser information of the symbols of file based symbol libraries, stored in the user
+ * cache directory so that the symbol chooser doesn't have to parse the libraries on startup.
+ *
+ * A library is indexed by its file, and its entry is valid as long as the modification time
+ * and size of the file are the same as when it was indexed.
+ */
+class SYMBOL_LIB_INDEX
+{
+public:
+    /**
+     * @return the index file in the user cache directory.
+     */
+    static wxFileName GetDefaultPath();
+
+    /**
+     * @return true if the library of \a aRow is a single file which can be indexed.
+     */
+    static bool CanIndex( const SYMBOL_LIB_TABLE_ROW* aRow );
+
+    bool Load( const wxFileName& aPath );
+    bool Save( const wxFileName& aPath ) const;
+
+    /**
+     * Fetch the indexed symbols and chooser fields of the library of \a aRow.
+     *
+     * @return false if the library isn't indexed or changed since it was.
+     */
+    bool Find( const SYMBOL_LIB_TABLE_ROW* aRow, std::vector<SYMBOL_INFO>& aSymbols,
+               std::vector<wxString>& aFields ) const;
+
+    /**
+     * (Re-)index the library of \a aRow, which holds \a aSymbols.
+     *
+     * @param aFields are the fields available in the library, see
+     *                SYMBOL_LIB_TABLE_ROW::GetAvailableSymbolFields().
+     */
+    void Update( const SYMBOL_LIB_TABLE_ROW* aRow, const std::vector<LIB_SYMBOL*>& aSymbols,
+                 const std::vector<wxString>& aFields );
+
+private:
+    /**
+     * @return the modification time and size of the library file of \a aRow.
+     */
+    static wxString fileSignature( const SYMBOL_LIB_TABLE_ROW* aRow );
+
+    struct LIBRARY
+    {
+        wxString                 m_signature;
+        std::vector<wxString>    m_fields;
+        std::vector<SYMBOL_INFO> m_symbols;
+    };
+
+    /// Indexed libraries by file name
+    std::map<wxString, LIBRARY> m_libraries;
+};
+
+#endif // SYMBOL_LIB_INDEX_H
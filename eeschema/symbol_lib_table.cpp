@@ -439,6 +439,37 @@ LIB_SYMBOL* SYMBOL_LIB_TABLE::LoadSymbol( const wxString& aNickname, const wxStr
 }
 
 
+void SYMBOL_LIB_TABLE::PrefetchSymbols( const std::vector<LIB_ID>& aLibIds )
+{
+    std::map<wxString, std::vector<wxString>> namesByLib;
+
+    for( const LIB_ID& libId : aLibIds )
+    {
+        if( libId.IsValid() )
+            namesByLib[libId.GetLibNickname()].push_back( libId.GetLibItemName() );
+    }
+
+    for( const auto& [nickname, names] : namesByLib )
+    {
+        try
+        {
+            SYMBOL_LIB_TABLE_ROW* row = FindRow( nickname, true );
+
+            if( !row || !row->plugin )
+                continue;
+
+            std::lock_guard<std::mutex> lock( row->GetMutex() );
+
+            row->plugin->PrefetchSymbols( row->GetFullURI( true ), names, row->GetProperties() );
+        }
+        catch( const IO_ERROR& )
+        {
+            // The symbols will be loaded one by one, which reports the error
+        }
+    }
+}
+
+
 SYMBOL_LIB_TABLE::SAVE_T SYMBOL_LIB_TABLE::SaveSymbol( const wxString& aNickname,
                                                        const LIB_SYMBOL* aSymbol, bool aOverwrite )
 {
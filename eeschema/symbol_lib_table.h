@@ -211,6 +211,13 @@ public:
         return LoadSymbol( aLibId.GetLibNickname(), aLibId.GetLibItemName() );
     }
 
+    /**
+     * Let the libraries of @a aLibIds fetch the given symbols in bulk ahead of the LoadSymbol()
+     * calls which will follow.  Libraries which can't do so are left alone, and errors are
+     * left for the LoadSymbol() calls to report.
+     */
+    void PrefetchSymbols( const std::vector<LIB_ID>& aLibIds );
+
     /**
      * The set of return values from SaveSymbol() below.
      */
@@ -33,6 +33,7 @@
 #include <locale_io.h>
 #include <lib_symbol.h>
 #include <symbol_async_loader.h>
+#include <symbol_lib_index.h>
 #include <symbol_lib_table.h>
 #include <symbol_tree_model_adapter.h>
 #include <string_utils.h>
@@ -68,11 +69,35 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
 {
     std::unique_ptr<WX_PROGRESS_REPORTER> progressReporter = nullptr;
 
-    if( m_show_progress )
+    // Libraries which didn't change since they were indexed aren't loaded at all; their symbols
+    // get loaded on demand, when previewed or placed.
+    SYMBOL_LIB_INDEX index;
+    wxFileName       indexPath = SYMBOL_LIB_INDEX::GetDefaultPath();
+    bool             onlyPowerSymbols = GetFilter() != nullptr;
+
+    std::map<wxString, std::vector<SYMBOL_INFO>> indexedSymbolMap;
+    std::map<wxString, std::vector<wxString>>    indexedFieldMap;
+    std::vector<wxString>                        toLoad;
+
+    index.Load( indexPath );
+
+    for( const wxString& nickname : aNicknames )
+    {
+        SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( nickname );
+
+        if( !index.Find( row, indexedSymbolMap[nickname], indexedFieldMap[nickname] ) )
+        {
+            indexedSymbolMap.erase( nickname );
+            indexedFieldMap.erase( nickname );
+            toLoad.push_back( nickname );
+        }
+    }
+
+    if( m_show_progress && !toLoad.empty() )
     {
         progressReporter = std::make_unique<WX_PROGRESS_REPORTER>( aFrame,
                                                                    _( "Loading Symbol Libraries" ),
-                                                                   aNicknames.size(), true );
+                                                                   toLoad.size(), true );
     }
 
     // Disable KIID generation: not needed for library parts; sometimes very slow
@@ -80,28 +105,54 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
 
     std::unordered_map<wxString, std::vector<LIB_SYMBOL*>> loadedSymbolMap;
 
-    SYMBOL_ASYNC_LOADER loader( aNicknames, m_libs, GetFilter() != nullptr, &loadedSymbolMap,
+    SYMBOL_ASYNC_LOADER loader( toLoad, m_libs, onlyPowerSymbols, &loadedSymbolMap,
                                 progressReporter.get() );
 
     LOCALE_IO toggle;
 
-    loader.Start();
-
-    while( !loader.Done() )
+    if( !toLoad.empty() )
     {
-        if( progressReporter && !progressReporter->KeepRefreshing() )
-            break;
+        loader.Start();
 
-        wxMilliSleep( PROGRESS_INTERVAL_MILLIS );
-    }
+        while( !loader.Done() )
+        {
+            if( progressReporter && !progressReporter->KeepRefreshing() )
+                break;
 
-    loader.Join();
+            wxMilliSleep( PROGRESS_INTERVAL_MILLIS );
+        }
+
+        loader.Join();
+    }
 
     bool cancelled = false;
 
     if( progressReporter )
         cancelled = progressReporter->IsCancelled();
 
+    // Only power symbols get loaded when filtering, which isn't enough for the index
+    if( !cancelled && !onlyPowerSymbols && !loadedSymbolMap.empty() )
+    {
+        bool indexChanged = false;
+
+        for( const auto& [libNickname, libSymbols] : loadedSymbolMap )
+        {
+            SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( libNickname );
+
+            if( SYMBOL_LIB_INDEX::CanIndex( row ) )
+            {
+                std::vector<wxString> fields;
+                row->GetAvailableSymbolFields( fields );
+
+                index.Update( row, libSymbols, fields );
+                indexChanged = true;
+            }
+        }
+
+        if( indexChanged )
+            index.Save( indexPath );
+    }
+
     if( !loader.GetErrors().IsEmpty() )
     {
         HTML_MESSAGE_BOX dlg( aFrame, _( "Load Error" ) );
@@ -115,22 +166,45 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
         dlg.ShowModal();
     }
 
-    if( loadedSymbolMap.size() > 0 )
+    if( loadedSymbolMap.size() > 0 || indexedSymbolMap.size() > 0 )
     {
         COMMON_SETTINGS* cfg = Pgm().GetCommonSettings();
         PROJECT_FILE&    project = aFrame->Prj().GetProjectFile();
 
         auto addFunc =
-                [&]( const wxString& aLibName, const std::vector<LIB_SYMBOL*>& aSymbolList,
+                [&]( const wxString& aLibName, const std::vector<LIB_TREE_ITEM*>& aTreeItems,
                      const wxString& aDescription )
                 {
-                    std::vector<LIB_TREE_ITEM*> treeItems( aSymbolList.begin(), aSymbolList.end() );
                     bool pinned = alg::contains( cfg->m_Session.pinned_symbol_libs, aLibName )
                                   || alg::contains( project.m_PinnedSymbolLibs, aLibName );
 
-                    DoAddLibrary( aLibName, aDescription, treeItems, pinned, false );
+                    DoAddLibrary( aLibName, aDescription, aTreeItems, pinned, false );
                 };
 
+        for( auto& [libNickname, libSymbols] : indexedSymbolMap )
+        {
+            SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( libNickname );
+
+            wxCHECK2( row, continue );
+
+            if( !row->GetIsVisible() )
+                continue;
+
+            for( const wxString& column : indexedFieldMap[libNickname] )
+                addColumnIfNecessary( column );
+
+            std::vector<LIB_TREE_ITEM*> treeItems;
+
+            for( SYMBOL_INFO& symbol : libSymbols )
+            {
+                if( !onlyPowerSymbols || symbol.IsPower() )
+                    treeItems.push_back( &symbol );
+            }
+
+            if( !treeItems.empty() )
+                addFunc( libNickname, treeItems, m_libs->GetDescription( libNickname ) );
+        }
+
         for( const auto& [libNickname, libSymbols] : loadedSymbolMap )
         {
             SYMBOL_LIB_TABLE_ROW* row = m_libs->FindRow( libNickname );
@@ -163,7 +237,7 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
                     if( !parentDesc.IsEmpty() )
                         desc = wxString::Format( wxT( "%s (%s)" ), parentDesc, lib );
 
-                    std::vector<LIB_SYMBOL*> symbols;
+                    std::vector<LIB_TREE_ITEM*> symbols;
 
                     std::copy_if( libSymbols.begin(), libSymbols.end(),
                                   std::back_inserter( symbols ),
@@ -177,7 +251,9 @@ bool SYMBOL_TREE_MODEL_ADAPTER::AddLibraries( const std::vector<wxString>& aNick
             }
             else
             {
-                addFunc( libNickname, libSymbols, m_libs->GetDescription( libNickname ) );
+                std::vector<LIB_TREE_ITEM*> treeItems( libSymbols.begin(), libSymbols.end() );
+
+                addFunc( libNickname, treeItems, m_libs->GetDescription( libNickname ) );
             }
         }
     }
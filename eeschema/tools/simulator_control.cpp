@@ -343,6 +343,12 @@ int SIMULATOR_CONTROL::RunSimulation( const TOOL_EVENT& aEvent )
         return 0;
     }
 
+    if( m_simulatorFrame->IsSweepRunning() )
+    {
+        m_simulatorFrame->StopSweep();
+        return 0;
+    }
+
     if( !getCurrentSimTab() )
         NewAnalysisTab( aEvent );
 
@@ -43,6 +43,7 @@
 
 #include <wx/log.h>
 #include <X2_gerber_attributes.h>
+#include <gerber_file_reader.h>
 #include <string_utils.h>
 
 
@@ -82,8 +83,8 @@ void X2_ATTRIBUTE::DbgListPrms()
 }
 
 
-bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, char* &aText,
-                                   int& aLineNum )
+bool X2_ATTRIBUTE::ParseAttribCmd( GERBER_FILE_READER* aFile, char *aBuffer, int aBuffSize,
+                                   char* &aText, int& aLineNum )
 {
     // parse a TF, TA, TO ... command and fill m_Prms by the parameters found.
     // the "%TF" (start of command) is already read by the caller
@@ -128,7 +129,7 @@ bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, ch
         // end of current line, read another one.
         if( aBuffer && aFile )
         {
-            if( fgets( aBuffer, aBuffSize, aFile ) == nullptr )
+            if( aFile->ReadLine( aBuffer, aBuffSize ) == nullptr )
             {
                 // end of file
                 ok = false;
@@ -46,6 +46,8 @@
 
 #include <wx/arrstr.h>
 
+class GERBER_FILE_READER;
+
 /**
  * The attribute value consists of a number of substrings separated by a comma
 */
@@ -84,7 +86,7 @@ public:
     /**
      * Parse a TF command terminated with a % and fill m_Prms by the parameters found.
      *
-     * @param aFile = a FILE* ptr to the current Gerber file.
+     * @param aFile = the reader of the current Gerber file.
      * @param aBuffer = the buffer containing current Gerber data (can be null)
      * @param aBuffSize = the size of the buffer
      * @param aText = a pointer to the first char to read from Gerber data stored in aBuffer
@@ -93,7 +95,8 @@ public:
      * @param aLineNum = a point to the current line number of aFile
      * @return true if no error.
      */
-    bool ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, char* &aText, int& aLineNum );
+    bool ParseAttribCmd( GERBER_FILE_READER* aFile, char *aBuffer, int aBuffSize, char* &aText,
+                         int& aLineNum );
 
     /**
      * Debug function: print using wxLogMessage le list of parameters
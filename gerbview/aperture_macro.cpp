@@ -82,32 +82,11 @@ double APERTURE_MACRO::GetLocalParamValue( int aIndex )
 }
 
 
-void APERTURE_MACRO::AddPrimitiveToList( AM_PRIMITIVE& aPrimitive )
-{
-    m_primitivesList.push_back( aPrimitive );
-    m_primitivesList.back().m_LocalParamLevel = m_localParamStack.size();
-}
-
-void APERTURE_MACRO::AddLocalParamDefToStack()
-{
-    m_localParamStack.push_back( AM_PARAM() );
-}
-
-
-AM_PARAM& APERTURE_MACRO::GetLastLocalParamDefFromStack()
-{
-    return m_localParamStack.back();
-}
-
-
-SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
-                                                       const VECTOR2I& aShapePos )
+void APERTURE_MACRO::buildShape( const D_CODE* aDcode, SHAPE_POLY_SET& aShape )
 {
     SHAPE_POLY_SET holeBuffer;
 
-    m_shape.RemoveAllContours();
-    D_CODE* dcode = aParent->GetDcodeDescr();
-    InitLocalParams( dcode );
+    InitLocalParams( aDcode );
 
     for( AM_PRIMITIVE& prim_macro : m_primitivesList )
     {
@@ -116,7 +95,7 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
 
         if( prim_macro.IsAMPrimitiveExposureOn( this ) )
         {
-            prim_macro.ConvertBasicShapeToPolygon( this, m_shape );
+            prim_macro.ConvertBasicShapeToPolygon( this, aShape );
         }
         else
         {
@@ -124,19 +103,64 @@ SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* a
 
             if( holeBuffer.OutlineCount() )     // we have a new hole in shape: remove the hole
             {
-                m_shape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
+                aShape.BooleanSubtract( holeBuffer, SHAPE_POLY_SET::PM_FAST );
                 holeBuffer.RemoveAllContours();
             }
         }
     }
 
     // Merge and cleanup basic shape polygons
-    m_shape.Simplify( SHAPE_POLY_SET::PM_FAST );
+    aShape.Simplify( SHAPE_POLY_SET::PM_FAST );
 
     // A hole can be is defined inside a polygon, or the polygons themselve can create
     // a hole when merged, so we must fracture the polygon to be able to drawn it
     // (i.e link holes by overlapping edges)
-    m_shape.Fracture( SHAPE_POLY_SET::PM_FAST );
+    aShape.Fracture( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+void APERTURE_MACRO::AddPrimitiveToList( AM_PRIMITIVE& aPrimitive )
+{
+    m_shapeCache.clear();
+
+    m_primitivesList.push_back( aPrimitive );
+    m_primitivesList.back().m_LocalParamLevel = m_localParamStack.size();
+}
+
+void APERTURE_MACRO::AddLocalParamDefToStack()
+{
+    m_shapeCache.clear();
+    m_localParamStack.push_back( AM_PARAM() );
+}
+
+
+AM_PARAM& APERTURE_MACRO::GetLastLocalParamDefFromStack()
+{
+    return m_localParamStack.back();
+}
+
+
+SHAPE_POLY_SET* APERTURE_MACRO::GetApertureMacroShape( const GERBER_DRAW_ITEM* aParent,
+                                                       const VECTOR2I& aShapePos )
+{
+    D_CODE* dcode = aParent->GetDcodeDescr();
+
+    // The shape only depends on the parameters given by the D_CODE: it is evaluated once for
+    // each set of parameters, and only moved to the position of each flash.
+    std::vector<double> params;
+
+    for( unsigned id_param = 1; id_param <= dcode->GetParamCount(); id_param++ )
+        params.push_back( dcode->GetParam( id_param ) );
+
+    auto it = m_shapeCache.find( params );
+
+    if( it == m_shapeCache.end() )
+    {
+        it = m_shapeCache.emplace( std::move( params ), SHAPE_POLY_SET() ).first;
+        buildShape( dcode, it->second );
+    }
+
+    m_shape = it->second;
 
     // Move m_shape to the actual draw position:
     for( int icnt = 0; icnt < m_shape.OutlineCount(); icnt++ )
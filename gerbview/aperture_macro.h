@@ -31,6 +31,7 @@
 #define APERTURE_MACRO_H
 
 
+#include <map>
 #include <vector>
 #include <set>
 
@@ -165,7 +166,15 @@ private:
      */
     int m_paramLevelEval;
 
+    /**
+     * Evaluate the primitives of the macro with the parameters of \a aDcode, at the origin.
+     */
+    void buildShape( const D_CODE* aDcode, SHAPE_POLY_SET& aShape );
+
     SHAPE_POLY_SET m_shape;         ///< The shape of the item, calculated by GetApertureMacroShape
+
+    ///< The shapes built by buildShape(), for each set of D_CODE parameters
+    std::map<std::vector<double>, SHAPE_POLY_SET> m_shapeCache;
 };
 
 
@@ -38,6 +38,10 @@
 #include <widgets/wx_progress_reporters.h>
 #include "widgets/gerbview_layer_widget.h"
 #include <tool/tool_manager.h>
+#include <gerbview_settings.h>
+#include <core/thread_pool.h>
+
+#include <future>
 
 // HTML Messages used more than one time:
 #define MSG_NO_MORE_LAYER _( "<b>No more available layers</b> in GerbView to load files" )
@@ -248,7 +252,7 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
 
     // Read gerber files: each file is loaded on a new GerbView layer
     bool success = true;
-    int layer = GetActiveLayer();
+    bool showMessages = false;
     int  firstLoadedLayer = NO_AVAILABLE_LAYERS;
     LSET visibility = GetVisibleLayers();
 
@@ -256,8 +260,20 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
     wxString msg;
     WX_STRING_REPORTER reporter( &msg );
 
-    // Create progress dialog (only used if more than 1 file to load
-    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+    // Files are independent: they are checked and given a layer here, parsed concurrently
+    // each into its own image, and only then added to the images list and the view.
+    struct LOAD_JOB
+    {
+        wxString                           m_fullPath;
+        wxString                           m_fullName;
+        int                                m_fileType;
+        int                                m_layer;
+        std::unique_ptr<GERBER_FILE_IMAGE> m_image;
+        bool                               m_outOfMemory = false;
+    };
+
+    std::vector<LOAD_JOB> jobs;
+    std::vector<bool>     reservedLayers( ImagesMaxCount(), false );
 
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
@@ -290,31 +306,36 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             continue;
         }
 
-
         m_lastFileName = filename.GetFullPath();
 
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
+        // 2 = Autodetect
+        if( ( *aFileType )[ii] == 2 )
         {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Loading files..." ), 1,
-                                                               false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
+            if( EXCELLON_IMAGE::TestFileIsExcellon( filename.GetFullPath() ) )
+                ( *aFileType )[ii] = 1;
+            else if( GERBER_FILE_IMAGE::TestFileIsRS274( filename.GetFullPath() ) )
+                ( *aFileType )[ii] = 0;
         }
-        else if( progress )
+
+        if( ( *aFileType )[ii] != 0 && ( *aFileType )[ii] != 1 )
         {
-            progress->Report( wxString::Format( _("Loading %u/%zu %s..." ),
-                                                ii+1,
-                                                aFilenameList.GetCount(),
-                                                m_lastFileName ) );
-            progress->KeepRefreshing();
+            wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
+            reporter.Report( txt, RPT_SEVERITY_ERROR );
+            continue;
         }
 
+        // Make sure we have a layer available to load into, not already given to a file of
+        // this list
+        int layer = NO_AVAILABLE_LAYERS;
 
-        // Make sure we have a layer available to load into
-        layer = getNextAvailableLayer();
+        for( int candidate = 0; candidate < (int) ImagesMaxCount(); ++candidate )
+        {
+            if( !reservedLayers[candidate] && GetGbrImage( candidate ) == nullptr )
+            {
+                layer = candidate;
+                break;
+            }
+        }
 
         if( layer == NO_AVAILABLE_LAYERS )
         {
@@ -331,68 +352,167 @@ bool GERBVIEW_FRAME::LoadListOfGerberAndDrillFiles( const wxString&      aPath,
             break;
         }
 
-        SetActiveLayer( layer, false );
+        reservedLayers[layer] = true;
         visibility[ layer ] = true;
 
-        try
-        {
-            // 2 = Autodetect
-            if( ( *aFileType )[ii] == 2 )
-            {
-                if( EXCELLON_IMAGE::TestFileIsExcellon( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 1;
-                else if( GERBER_FILE_IMAGE::TestFileIsRS274( filename.GetFullPath() ) )
-                    ( *aFileType )[ii] = 0;
-            }
+        LOAD_JOB& job = jobs.emplace_back();
+        job.m_fullPath = filename.GetFullPath();
+        job.m_fullName = filename.GetFullName();
+        job.m_fileType = ( *aFileType )[ii];
+        job.m_layer = layer;
+    }
 
-            switch( ( *aFileType )[ii] )
-            {
-            case 0:
+    // Create progress dialog (only used if more than 1 file to load
+    std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
+
+    if( jobs.size() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this, _( "Loading files..." ), 1,
+                                                           false );
+        progress->SetMaxProgress( jobs.size() );
+        progress->Report( wxString::Format( _( "Loading %zu files..." ), jobs.size() ) );
+    }
+
+    EXCELLON_DEFAULTS nc_defaults;
+    GERBVIEW_SETTINGS* cfg = static_cast<GERBVIEW_SETTINGS*>( config() );
+    cfg->GetExcellonDefaults( nc_defaults );
 
-                if( Read_GERBER_File( filename.GetFullPath() ) )
+    auto load_lambda =
+            [&]( LOAD_JOB* aJob ) -> size_t
+            {
+                try
                 {
-                    UpdateFileHistory( filename.GetFullPath() );
+                    bool loaded;
 
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
+                    if( aJob->m_fileType == 1 )
+                    {
+                        auto drill = std::make_unique<EXCELLON_IMAGE>( aJob->m_layer );
+                        loaded = drill->LoadFile( aJob->m_fullPath, &nc_defaults );
+                        aJob->m_image = std::move( drill );
+                    }
+                    else
                     {
-                        firstLoadedLayer = layer;
+                        aJob->m_image = std::make_unique<GERBER_FILE_IMAGE>( aJob->m_layer );
+                        loaded = aJob->m_image->LoadGerberFile( aJob->m_fullPath );
                     }
+
+                    // The image will be added only if it can be read to avoid broken data
+                    if( !loaded )
+                        aJob->m_image.reset();
+                }
+                catch( const std::bad_alloc& )
+                {
+                    aJob->m_image.reset();
+                    aJob->m_outOfMemory = true;
                 }
 
-                break;
+                if( progress )
+                    progress->AdvanceProgress();
 
-            case 1:
+                return 1;
+            };
 
-                if( Read_EXCELLON_File( filename.GetFullPath() ) )
-                {
-                    UpdateFileHistory( filename.GetFullPath(), &m_drillFileHistory );
+    thread_pool&                     tp = GetKiCadThreadPool();
+    std::vector<std::future<size_t>> returns;
 
-                    // Select the first added layer by default when done loading
-                    if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
-                    {
-                        firstLoadedLayer = layer;
-                    }
-                }
+    returns.reserve( jobs.size() );
 
-                break;
-            default:
-                wxString txt = wxString::Format( MSG_NOT_LOADED, filename.GetFullName() );
-                reporter.Report( txt, RPT_SEVERITY_ERROR );
-            }
+    for( LOAD_JOB& job : jobs )
+        returns.emplace_back( tp.submit( load_lambda, &job ) );
+
+    for( const std::future<size_t>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 100 ) );
+
+        while( status != std::future_status::ready )
+        {
+            if( progress )
+                progress->KeepRefreshing();
+
+            status = ret.wait_for( std::chrono::milliseconds( 100 ) );
+        }
+    }
+
+    for( LOAD_JOB& job : jobs )
+    {
+        if( job.m_outOfMemory )
+        {
+            wxString txt = wxString::Format( MSG_OOM, job.m_fullName );
+            reporter.Report( txt, RPT_SEVERITY_ERROR );
+            success = false;
+            continue;
         }
-        catch( const std::bad_alloc& )
+
+        if( !job.m_image )
         {
-            wxString txt = wxString::Format( MSG_OOM, filename.GetFullName() );
+            wxString txt = wxString::Format( MSG_NOT_LOADED, job.m_fullName );
             reporter.Report( txt, RPT_SEVERITY_ERROR );
             success = false;
             continue;
         }
 
-        if( progress )
-            progress->AdvanceProgress();
+        GERBER_FILE_IMAGE* image = job.m_image.release();
+
+        if( GetImagesList()->AddGbrImage( image, job.m_layer ) < 0 )
+        {
+            delete image;
+            reporter.Report( wxString::Format( MSG_NOT_LOADED, job.m_fullName ),
+                             RPT_SEVERITY_ERROR );
+            success = false;
+            continue;
+        }
+
+        if( job.m_fileType == 1 )
+            UpdateFileHistory( job.m_fullPath, &m_drillFileHistory );
+        else
+            UpdateFileHistory( job.m_fullPath );
+
+        // Select the first added layer by default when done loading
+        if( firstLoadedLayer == NO_AVAILABLE_LAYERS )
+            firstLoadedLayer = job.m_layer;
+
+        // Gather the errors of all files in a single list
+        if( image->GetMessages().size() > 0 )
+        {
+            reporter.Report( wxString::Format( wxT( "<b>%s</b>" ), job.m_fullName ),
+                             RPT_SEVERITY_WARNING );
+
+            for( const wxString& line : image->GetMessages() )
+                reporter.Report( line, RPT_SEVERITY_WARNING );
+
+            showMessages = true;
+        }
+
+        /* if the gerber file has items using D codes but missing D codes definitions,
+         * it can be a deprecated RS274D file (i.e. without any aperture information),
+         * or has missing definitions, warn the user:
+         */
+        if( job.m_fileType == 0 && image->GetItemsCount() && image->m_Has_MissingDCode )
+        {
+            wxString txt;
+
+            if( !image->m_Has_DCode )
+                txt = _( "this file has no D-Code definition, therefore the size of some "
+                         "items is undefined" );
+            else
+                txt = _( "this file has some missing D-Code definitions, therefore the size "
+                         "of some items is undefined" );
+
+            reporter.Report( wxString::Format( wxT( "<b>%s:</b> %s" ), job.m_fullName, txt ),
+                             RPT_SEVERITY_WARNING );
+            showMessages = true;
+        }
+
+        if( GetCanvas() )
+        {
+            for( GERBER_DRAW_ITEM* item : image->GetItems() )
+                GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
+        }
     }
 
-    if( !success )
+    progress.reset();
+
+    if( !success || showMessages )
     {
         wxSafeYield();  // Allows slice of time to redraw the screen
                         // to refresh widgets, before displaying messages
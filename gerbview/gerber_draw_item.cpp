@@ -35,6 +35,8 @@
 #include <geometry/shape_arc.h>
 #include <math/util.h>      // for KiROUND
 #include <widgets/msgpanel.h>
+#include <view/view.h>
+#include <gal/graphics_abstraction_layer.h>
 
 #include <wx/msgdlg.h>
 
@@ -1008,8 +1010,19 @@ double GERBER_DRAW_ITEM::ViewGetLOD( int aLayer, KIGFX::VIEW* aView ) const
         return level / ( size + 1 );
     }
 
-    // Other layers are shown without any conditions
-    return 0.0;
+    // Items much smaller than a pixel are not drawn: zoomed out on a panel with millions of
+    // flashes, drawing them takes most of the redraw time for no visible detail.
+    // The world scale is the size of an IU in pixels and is proportional to the view scale.
+    constexpr double MIN_PIXEL_SIZE = 0.5;
+
+    if( aView->GetScale() <= 0.0 || aView->GetGAL()->GetWorldScale() <= 0.0 )
+        return 0.0;
+
+    BOX2I  bbox = GetBoundingBox();
+    double size = std::max( bbox.GetWidth(), bbox.GetHeight() );
+    double pixelsPerIUAtScale1 = aView->GetGAL()->GetWorldScale() / aView->GetScale();
+
+    return MIN_PIXEL_SIZE / ( pixelsPerIUAtScale1 * ( size + 1 ) );
 }
 
 
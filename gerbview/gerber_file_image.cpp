@@ -219,7 +219,8 @@ void GERBER_FILE_IMAGE::ResetDefaultValues()
     m_LastArcDataType = ARC_INFO_TYPE_NONE;         // Extra coordinate info type for arcs
                                                     // (radius or IJ center coord)
     m_LineNum = 0;                                  // line number in file being read
-    m_Current_File    = nullptr;                    // Gerber file to read
+    m_Current_File    = nullptr;                    // Drill file to read
+    m_GerberFile      = nullptr;                    // Gerber file to read
     m_PolygonFillMode = false;
     m_PolygonFillModeState = 0;
     m_Selected_Tool = 0;
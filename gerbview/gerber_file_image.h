@@ -37,6 +37,7 @@
 typedef std::vector<GERBER_DRAW_ITEM*> GERBER_DRAW_ITEMS;
 
 class GERBVIEW_FRAME;
+class GERBER_FILE_READER;
 class D_CODE;
 
 /* Gerber files have different parameters to define units and how items must be plotted.
@@ -329,9 +330,11 @@ private:
      * @param aFile = the opened GERBER file to read
      * @return a pointer to the beginning of the next line or NULL if end of file
     */
-    char* GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile );
+    char* GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText,
+                       GERBER_FILE_READER* aFile );
 
-    bool GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* aGerberFile );
+    bool GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText,
+                        GERBER_FILE_READER* aGerberFile );
 
     /**
      * Read a single RS274X command terminated with a %
@@ -365,7 +368,8 @@ private:
      * @param gerber_file Which file to read from for continuation.
      * @return true if a macro was read in successfully, else false.
      */
-    bool ReadApertureMacro( char *aBuff, unsigned int aBuffSize, char*& text, FILE* gerber_file );
+    bool ReadApertureMacro( char *aBuff, unsigned int aBuffSize, char*& text,
+                            GERBER_FILE_READER* gerber_file );
 
     // functions to execute G commands or D basic commands:
     bool Execute_G_Command( char*& text, int G_command );
@@ -426,7 +430,8 @@ public:
 
     ///< Identifier for arc data type (IJ (center) or A## (radius)).
     LAST_EXTRA_ARC_DATA_TYPE m_LastArcDataType;
-    FILE*              m_Current_File;                   // Current file to read
+    FILE*              m_Current_File;                   // Current drill file to read
+    GERBER_FILE_READER* m_GerberFile;                    // Current Gerber file to read
 
     int                m_Selected_Tool;                  // For highlight: current selected Dcode
 
@@ -473,8 +478,9 @@ public:
     VECTOR2I           m_DisplayOffset;
     EDA_ANGLE          m_DisplayRotation;
 
-    // A large buffer to store one line
-    static char m_LineBuffer[GERBER_BUFZ+1];
+    // A large buffer to store one line, only allocated while reading the file.  Each image has
+    // its own, as several files can be read at the same time.
+    std::vector<char>  m_LineBuffer;
 
 private:
     wxArrayString      m_messagesList;         // A list of messages created when reading a file
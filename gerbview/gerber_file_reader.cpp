@@ -0,0 +1,64 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include <wx/string.h>
+
+#include <gerber_file_reader.h>
+
+
+bool GERBER_FILE_READER::Open( const wxString& aFileName )
+{
+    Close();
+
+    return KIPLATFORM::IO::MapFile( aFileName, m_file );
+}
+
+
+void GERBER_FILE_READER::Close()
+{
+    KIPLATFORM::IO::UnmapFile( m_file );
+    m_pos = 0;
+}
+
+
+char* GERBER_FILE_READER::ReadLine( char* aBuff, int aBuffSize )
+{
+    if( aBuffSize < 2 || m_pos >= m_file.m_size )
+        return nullptr;
+
+    const char* begin = m_file.m_data + m_pos;
+    size_t      length = std::min( m_file.m_size - m_pos, (size_t) aBuffSize - 1 );
+    const char* eol = static_cast<const char*>( memchr( begin, '\n', length ) );
+
+    if( eol )
+        length = eol - begin + 1;
+
+    memcpy( aBuff, begin, length );
+    aBuff[length] = 0;
+    m_pos += length;
+
+    return aBuff;
+}
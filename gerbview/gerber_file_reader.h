@@ -0,0 +1,76 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GERBER_FILE_READER_H
+#define GERBER_FILE_READER_H
+
+#include <cstddef>
+
+#include <kiplatform/io.h>
+
+class wxString;
+
+
+/**
+ * Read the lines of a Gerber file mapped in memory.
+ *
+ * ReadLine() works like fgets(), so that the parser can keep its line buffer, but it finds the
+ * end of line with memchr() and copies the line in one go instead of going through stdio.
+ */
+class GERBER_FILE_READER
+{
+public:
+    GERBER_FILE_READER() :
+        m_pos( 0 )
+    { }
+
+    ~GERBER_FILE_READER() { Close(); }
+
+    GERBER_FILE_READER( const GERBER_FILE_READER& ) = delete;
+    GERBER_FILE_READER& operator=( const GERBER_FILE_READER& ) = delete;
+
+    /**
+     * Map \a aFileName in memory.
+     *
+     * @return false if the file can't be opened.
+     */
+    bool Open( const wxString& aFileName );
+
+    void Close();
+
+    /**
+     * Copy the next line to \a aBuff, with its end of line, and store a terminating nul.
+     *
+     * As with fgets(), at most \a aBuffSize - 1 characters are copied, the rest of a longer
+     * line being returned by the next calls.
+     *
+     * @return \a aBuff, or nullptr at the end of the file.
+     */
+    char* ReadLine( char* aBuff, int aBuffSize );
+
+private:
+    KIPLATFORM::IO::MAPPED_FILE m_file;
+    size_t                      m_pos;      ///< Offset of the next line
+};
+
+#endif  // GERBER_FILE_READER_H
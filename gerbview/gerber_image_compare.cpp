@@ -0,0 +1,449 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <future>
+
+#include <wx/translation.h>
+
+#include <base_units.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <core/thread_pool.h>
+#include <math/util.h>
+#include <progress_reporter.h>
+
+#include <aperture_macro.h>
+#include <dcode.h>
+#include <gerber_draw_item.h>
+#include <gerber_file_image.h>
+#include <gerber_image_compare.h>
+
+
+///< Side of the tiles the images are compared in
+static const double TILE_SIZE_MM = 10.0;
+
+///< Largest number of tiles along each side of the images
+static const int MAX_TILES_PER_SIDE = 64;
+
+
+/**
+ * Add the shape of \a aItem to \a aBuffer, in absolute (AB) coordinates.  This follows what
+ * GERBVIEW_PAINTER draws for each shape type.
+ */
+static void convertItemToPolygons( GERBER_DRAW_ITEM* aItem, SHAPE_POLY_SET& aBuffer,
+                                   int aMaxError )
+{
+    SHAPE_POLY_SET shape;
+    D_CODE*        code = aItem->GetDcodeDescr();
+
+    // Copy the outlines of aPolygon placed at aOffset, the painter applying the AB transform
+    // to each point
+    auto addPlacedPolygons =
+            [&]( const SHAPE_POLY_SET& aPolygon, const VECTOR2I& aOffset )
+            {
+                for( int ii = 0; ii < aPolygon.OutlineCount(); ++ii )
+                {
+                    SHAPE_POLY_SET::POLYGON poly = aPolygon.CPolygon( ii );
+
+                    for( SHAPE_LINE_CHAIN& chain : poly )
+                    {
+                        for( int jj = 0; jj < chain.PointCount(); ++jj )
+                        {
+                            chain.SetPoint( jj,
+                                            aItem->GetABPosition( chain.CPoint( jj ) + aOffset ) );
+                        }
+                    }
+
+                    shape.AddPolygon( poly );
+                }
+            };
+
+    switch( aItem->m_ShapeType )
+    {
+    case GBR_POLYGON:
+        // Degenerated polygons are drawn as lines, without area
+        if( aItem->m_ShapeAsPolygon.OutlineCount() > 0
+                && aItem->m_ShapeAsPolygon.COutline( 0 ).PointCount() >= 3 )
+        {
+            SHAPE_POLY_SET outline;
+            outline.AddOutline( aItem->m_ShapeAsPolygon.COutline( 0 ) );
+            outline.Outline( 0 ).SetClosed( true );
+            addPlacedPolygons( outline, VECTOR2I( 0, 0 ) );
+        }
+
+        break;
+
+    case GBR_SEGMENT:
+        if( code && code->m_ApertType == APT_RECT )
+        {
+            SHAPE_POLY_SET segment;
+            aItem->ConvertSegmentToPolygon( &segment );
+            addPlacedPolygons( segment, VECTOR2I( 0, 0 ) );
+        }
+        else
+        {
+            TransformOvalToPolygon( shape, aItem->GetABPosition( aItem->m_Start ),
+                                    aItem->GetABPosition( aItem->m_End ), aItem->m_Size.x,
+                                    aMaxError, ERROR_INSIDE );
+        }
+
+        break;
+
+    case GBR_CIRCLE:
+    {
+        VECTOR2I center = aItem->GetABPosition( aItem->m_Start );
+        int      radius = ( aItem->GetABPosition( aItem->m_End ) - center ).EuclideanNorm();
+
+        TransformRingToPolygon( shape, center, radius, aItem->m_Size.x, aMaxError,
+                                ERROR_INSIDE );
+        break;
+    }
+
+    case GBR_ARC:
+    {
+        // Same direction as the painter, which draws from the end to the start of the arc
+        VECTOR2I center = aItem->GetABPosition( aItem->m_ArcCentre );
+        VECTOR2I arcStart = aItem->GetABPosition( aItem->m_End );
+        VECTOR2I arcEnd = aItem->GetABPosition( aItem->m_Start );
+        double   radius = ( arcStart - center ).EuclideanNorm();
+
+        // In Gerber, 360-degree arcs are stored in the file with start equal to end
+        if( aItem->m_Start == aItem->m_End )
+        {
+            TransformRingToPolygon( shape, center, KiROUND( radius ), aItem->m_Size.x,
+                                    aMaxError, ERROR_INSIDE );
+            break;
+        }
+
+        EDA_ANGLE startAngle( VECTOR2D( arcStart - center ) );
+        EDA_ANGLE endAngle( VECTOR2D( arcEnd - center ) );
+
+        if( startAngle > endAngle )
+            endAngle += ANGLE_360;
+
+        double   midAngle = ( startAngle.AsRadians() + endAngle.AsRadians() ) / 2.0;
+        VECTOR2I arcMid = center + VECTOR2I( KiROUND( radius * cos( midAngle ) ),
+                                             KiROUND( radius * sin( midAngle ) ) );
+
+        TransformArcToPolygon( shape, arcStart, arcMid, arcEnd, aItem->m_Size.x, aMaxError,
+                               ERROR_INSIDE );
+        break;
+    }
+
+    case GBR_SPOT_CIRCLE:
+    case GBR_SPOT_RECT:
+    case GBR_SPOT_OVAL:
+    case GBR_SPOT_POLY:
+        if( !code )
+            break;
+
+        if( code->m_Polygon.OutlineCount() == 0 )
+            code->ConvertShapeToPolygon( aItem );
+
+        addPlacedPolygons( code->m_Polygon, aItem->m_Start );
+        break;
+
+    case GBR_SPOT_MACRO:
+        if( code && code->GetMacro() )
+        {
+            // The macro shape is already in absolute coordinates
+            shape.Append( *code->GetMacro()->GetApertureMacroShape( aItem, aItem->m_Start ) );
+        }
+
+        break;
+
+    default:
+        break;
+    }
+
+    // Mirrored images and files reverse the orientation of the outlines.  Give them all the
+    // same orientation, else the non-zero fill of the boolean operations leaves overlapping
+    // shapes unfilled.
+    for( int ii = 0; ii < shape.OutlineCount(); ++ii )
+    {
+        if( shape.COutline( ii ).Area( false ) < 0 )
+        {
+            for( SHAPE_LINE_CHAIN& chain : shape.Polygon( ii ) )
+                chain = chain.Reverse();
+        }
+
+        aBuffer.AddPolygon( shape.CPolygon( ii ) );
+    }
+}
+
+
+GERBER_IMAGE_COMPARE::GERBER_IMAGE_COMPARE( int aTolerance ) :
+        m_tolerance( aTolerance )
+{
+}
+
+
+void GERBER_IMAGE_COMPARE::ConvertImageToPolygons( GERBER_FILE_IMAGE* aImage,
+                                                   SHAPE_POLY_SET& aPolygons )
+{
+    // Same approximation of arcs as the painter
+    const int maxError = gerbIUScale.mmToIU( 0.005 );
+
+    SHAPE_POLY_SET run;     // The shapes of consecutive items of the same polarity
+    bool           runIsClear = false;
+
+    aPolygons.RemoveAllContours();
+
+    auto flushRun =
+            [&]()
+            {
+                if( run.OutlineCount() == 0 )
+                    return;
+
+                if( runIsClear )
+                    aPolygons.BooleanSubtract( run, SHAPE_POLY_SET::PM_FAST );
+                else
+                    aPolygons.BooleanAdd( run, SHAPE_POLY_SET::PM_FAST );
+
+                run.RemoveAllContours();
+            };
+
+    for( GERBER_DRAW_ITEM* item : aImage->GetItems() )
+    {
+        if( item->GetLayerPolarity() != runIsClear )
+        {
+            flushRun();
+            runIsClear = item->GetLayerPolarity();
+        }
+
+        convertItemToPolygons( item, run, maxError );
+    }
+
+    flushRun();
+    aPolygons.Simplify( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+bool GERBER_IMAGE_COMPARE::Compare( GERBER_FILE_IMAGE* aFirst, GERBER_FILE_IMAGE* aSecond,
+                                    PROGRESS_REPORTER* aProgressReporter )
+{
+    thread_pool&   tp = GetKiCadThreadPool();
+    SHAPE_POLY_SET images[2];
+
+    m_regions.clear();
+
+    // Waits for futures, keeping the progress reporter alive
+    auto waitFor =
+            [&]( std::vector<std::future<void>>& aFutures )
+            {
+                for( const std::future<void>& ret : aFutures )
+                {
+                    std::future_status status = ret.wait_for( std::chrono::milliseconds( 100 ) );
+
+                    while( status != std::future_status::ready )
+                    {
+                        if( aProgressReporter )
+                            aProgressReporter->KeepRefreshing();
+
+                        status = ret.wait_for( std::chrono::milliseconds( 100 ) );
+                    }
+                }
+
+                aFutures.clear();
+            };
+
+    // The canvas can be redrawn while the progress reporter is refreshed, so build the
+    // polygons of the D_CODEs here rather than in the worker threads
+    for( GERBER_FILE_IMAGE* image : { aFirst, aSecond } )
+    {
+        for( GERBER_DRAW_ITEM* item : image->GetItems() )
+        {
+            D_CODE* code = item->GetDcodeDescr();
+
+            if( item->m_Flashed && item->m_ShapeType != GBR_SPOT_MACRO && code
+                    && code->m_Polygon.OutlineCount() == 0 )
+            {
+                code->ConvertShapeToPolygon( item );
+            }
+        }
+    }
+
+    std::vector<std::future<void>> returns;
+
+    // The images don't share their D_CODEs, so they can be converted at the same time
+    returns.emplace_back( tp.submit( [&]() { ConvertImageToPolygons( aFirst, images[0] ); } ) );
+    returns.emplace_back( tp.submit( [&]() { ConvertImageToPolygons( aSecond, images[1] ); } ) );
+    waitFor( returns );
+
+    if( images[0].OutlineCount() == 0 && images[1].OutlineCount() == 0 )
+        return true;
+
+    BOX2I bbox = images[0].OutlineCount() ? images[0].BBox() : images[1].BBox();
+
+    if( images[0].OutlineCount() && images[1].OutlineCount() )
+        bbox.Merge( images[1].BBox() );
+
+    int tileSize = std::max( gerbIUScale.mmToIU( TILE_SIZE_MM ),
+                             (int) ( std::max( bbox.GetWidth(), bbox.GetHeight() )
+                                     / MAX_TILES_PER_SIDE ) + 1 );
+    int columns = bbox.GetWidth() / tileSize + 1;
+    int rows = bbox.GetHeight() / tileSize + 1;
+
+    // Bounding boxes of the polygons, to give each tile only the polygons it clips
+    std::vector<BOX2I> polyBoxes[2];
+
+    for( int ii = 0; ii < 2; ++ii )
+    {
+        for( int jj = 0; jj < images[ii].OutlineCount(); ++jj )
+            polyBoxes[ii].push_back( images[ii].COutline( jj ).BBox() );
+    }
+
+    std::vector<SHAPE_POLY_SET> onlyFirst( columns * rows );
+    std::vector<SHAPE_POLY_SET> onlySecond( columns * rows );
+    std::atomic<bool>           cancelled( false );
+
+    auto compareTile =
+            [&]( int aTile )
+            {
+                if( cancelled )
+                    return;
+
+                BOX2I tile( VECTOR2I( bbox.GetX() + ( aTile % columns ) * tileSize,
+                                      bbox.GetY() + ( aTile / columns ) * tileSize ),
+                            VECTOR2I( tileSize, tileSize ) );
+
+                SHAPE_POLY_SET clip;
+                clip.NewOutline();
+                clip.Append( tile.GetLeft(), tile.GetTop() );
+                clip.Append( tile.GetRight(), tile.GetTop() );
+                clip.Append( tile.GetRight(), tile.GetBottom() );
+                clip.Append( tile.GetLeft(), tile.GetBottom() );
+
+                SHAPE_POLY_SET parts[2];
+
+                for( int ii = 0; ii < 2; ++ii )
+                {
+                    for( size_t jj = 0; jj < polyBoxes[ii].size(); ++jj )
+                    {
+                        if( polyBoxes[ii][jj].Intersects( tile ) )
+                            parts[ii].AddPolygon( images[ii].CPolygon( jj ) );
+                    }
+
+                    parts[ii].BooleanIntersection( clip, SHAPE_POLY_SET::PM_FAST );
+                }
+
+                onlyFirst[aTile] = parts[0];
+                onlyFirst[aTile].BooleanSubtract( parts[1], SHAPE_POLY_SET::PM_FAST );
+                onlySecond[aTile] = parts[1];
+                onlySecond[aTile].BooleanSubtract( parts[0], SHAPE_POLY_SET::PM_FAST );
+
+                if( aProgressReporter )
+                {
+                    aProgressReporter->AdvanceProgress();
+
+                    if( aProgressReporter->IsCancelled() )
+                        cancelled = true;
+                }
+            };
+
+    if( aProgressReporter )
+        aProgressReporter->SetMaxProgress( columns * rows );
+
+    for( int ii = 0; ii < columns * rows; ++ii )
+        returns.emplace_back( tp.submit( compareTile, ii ) );
+
+    waitFor( returns );
+
+    if( cancelled )
+        return false;
+
+    // Merge the pieces of the regions cut by the tile borders
+    for( std::vector<SHAPE_POLY_SET>* pieces : { &onlyFirst, &onlySecond } )
+    {
+        SHAPE_POLY_SET diff;
+
+        for( SHAPE_POLY_SET& piece : *pieces )
+            diff.Append( piece );
+
+        diff.Simplify( SHAPE_POLY_SET::PM_FAST );
+        addRegions( diff, pieces == &onlyFirst );
+    }
+
+    std::sort( m_regions.begin(), m_regions.end(),
+               []( const GERBER_DIFF_REGION& aA, const GERBER_DIFF_REGION& aB )
+               {
+                   return aA.m_area > aB.m_area;
+               } );
+
+    return true;
+}
+
+
+void GERBER_IMAGE_COMPARE::addRegions( SHAPE_POLY_SET& aDiff, bool aInFirst )
+{
+    const int                       maxError = gerbIUScale.mmToIU( 0.005 );
+    std::vector<GERBER_DIFF_REGION> regions( aDiff.OutlineCount() );
+
+    ParallelFor( regions.size(),
+            [&]( size_t aIndex )
+            {
+                SHAPE_POLY_SET region;
+                region.AddPolygon( aDiff.CPolygon( aIndex ) );
+
+                regions[aIndex].m_area = -1.0;
+
+                // Regions thinner than the tolerance vanish when shrunk by half of it
+                if( m_tolerance > 0 )
+                {
+                    SHAPE_POLY_SET shrunk = region;
+                    shrunk.Deflate( m_tolerance / 2, CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS,
+                                    maxError );
+
+                    if( shrunk.OutlineCount() == 0 )
+                        return;
+                }
+
+                regions[aIndex].m_bbox = region.BBox();
+                regions[aIndex].m_area = region.Area();
+                regions[aIndex].m_inFirst = aInFirst;
+            } );
+
+    for( const GERBER_DIFF_REGION& region : regions )
+    {
+        if( region.m_area >= 0.0 )
+            m_regions.push_back( region );
+    }
+}
+
+
+wxString GERBER_IMAGE_COMPARE::FormatRegion( const GERBER_DIFF_REGION& aRegion )
+{
+    VECTOR2I center = aRegion.m_bbox.GetCenter();
+
+    return wxString::Format( aRegion.m_inFirst ? _( "Only in the first image: %.3f x %.3f mm "
+                                                    "at (%.3f, %.3f) mm, area %.4f mm²" )
+                                               : _( "Only in the second image: %.3f x %.3f mm "
+                                                    "at (%.3f, %.3f) mm, area %.4f mm²" ),
+                             gerbIUScale.IUTomm( aRegion.m_bbox.GetWidth() ),
+                             gerbIUScale.IUTomm( aRegion.m_bbox.GetHeight() ),
+                             gerbIUScale.IUTomm( center.x ),
+                             gerbIUScale.IUTomm( center.y ),
+                             aRegion.m_area / gerbIUScale.IU_PER_MM / gerbIUScale.IU_PER_MM );
+}
@@ -0,0 +1,102 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GERBER_IMAGE_COMPARE_H
+#define GERBER_IMAGE_COMPARE_H
+
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+#include <math/box2.h>
+
+class GERBER_FILE_IMAGE;
+class PROGRESS_REPORTER;
+class wxString;
+
+
+/**
+ * A region drawn by one of the compared images and not by the other.
+ */
+struct GERBER_DIFF_REGION
+{
+    BOX2I  m_bbox;
+    double m_area;      ///< In IU * IU
+    bool   m_inFirst;   ///< True if only the first image draws it, false if only the second
+};
+
+
+/**
+ * Compare the geometry of two Gerber or drill images, e.g. two revisions of a layer, or a fab
+ * output against a fresh plot of the board layer.
+ *
+ * Both images are converted to polygons, and their exclusive or is computed in tiles on the
+ * KiCad thread pool.  Regions of the difference thinner than the tolerance are ignored, as
+ * they come from arcs approximated or coordinates rounded differently.
+ */
+class GERBER_IMAGE_COMPARE
+{
+public:
+    /**
+     * @param aTolerance is the width of the thinnest difference reported, in IU.
+     */
+    GERBER_IMAGE_COMPARE( int aTolerance );
+
+    /**
+     * Merge the shapes of the items of \a aImage, clear polarity items removing what the
+     * previous items drew.
+     *
+     * This builds the polygons of the D_CODEs on first use, so an image must not be converted
+     * by two threads at the same time.
+     */
+    static void ConvertImageToPolygons( GERBER_FILE_IMAGE* aImage, SHAPE_POLY_SET& aPolygons );
+
+    /**
+     * Compare \a aFirst to \a aSecond, replacing the regions of a previous comparison.
+     *
+     * @param aProgressReporter is advanced once per tile, and can be nullptr.
+     * @return false if the comparison was cancelled.
+     */
+    bool Compare( GERBER_FILE_IMAGE* aFirst, GERBER_FILE_IMAGE* aSecond,
+                  PROGRESS_REPORTER* aProgressReporter = nullptr );
+
+    /**
+     * @return the regions found by Compare(), from the largest to the smallest.
+     */
+    const std::vector<GERBER_DIFF_REGION>& GetRegions() const { return m_regions; }
+
+    /**
+     * @return the description of a region, with its position and size in mm.
+     */
+    static wxString FormatRegion( const GERBER_DIFF_REGION& aRegion );
+
+private:
+    /**
+     * Add the regions of \a aDiff wider than the tolerance to m_regions.
+     */
+    void addRegions( SHAPE_POLY_SET& aDiff, bool aInFirst );
+
+    int                             m_tolerance;
+    std::vector<GERBER_DIFF_REGION> m_regions;
+};
+
+#endif  // GERBER_IMAGE_COMPARE_H
@@ -26,14 +26,17 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cli_progress_reporter.h>
 #include <gerbview.h>
 #include <gerbview_frame.h>
+#include <gerbview_jobs_handler.h>
 #include <gerbview_settings.h>
 #include <gestfich.h>
 #include <kiface_base.h>
 #include <macros.h>
 #include <nlohmann/json.hpp>
 #include <pgm_base.h>
+#include <reporter.h>
 #include <richio.h>
 #include <settings/settings_manager.h>
 #include <string_utils.h>
@@ -108,6 +111,11 @@ static struct IFACE : public KIFACE_BASE
                      const wxString& aNewProjectBasePath, const wxString& aNewProjectName,
                      const wxString& aSrcFilePath, wxString& aErrors ) override;
 
+    int HandleJob( JOB* aJob ) override;
+
+private:
+    std::unique_ptr<GERBVIEW_JOBS_HANDLER> m_jobHandler;
+
 } kiface( "gerbview", KIWAY::FACE_GERBVIEW );
 
 } // namespace
@@ -150,6 +158,15 @@ bool IFACE::OnKifaceStart( PGM_BASE* aProgram, int aCtlBits )
     InitSettings( new GERBVIEW_SETTINGS );
     aProgram->GetSettingsManager().RegisterSettings( KifaceSettings() );
     start_common( aCtlBits );
+
+    m_jobHandler = std::make_unique<GERBVIEW_JOBS_HANDLER>();
+
+    if( m_start_flags & KFCTL_CLI )
+    {
+        m_jobHandler->SetReporter( &CLI_REPORTER::GetInstance() );
+        m_jobHandler->SetProgressReporter( &CLI_PROGRESS_REPORTER::GetInstance() );
+    }
+
     return true;
 }
 
@@ -160,6 +177,12 @@ void IFACE::OnKifaceEnd()
 }
 
 
+int IFACE::HandleJob( JOB* aJob )
+{
+    return m_jobHandler->RunJob( aJob );
+}
+
+
 void IFACE::SaveFileAs( const wxString& aProjectBasePath, const wxString& aProjectName,
                         const wxString& aNewProjectBasePath, const wxString& aNewProjectName,
                         const wxString& aSrcFilePath, wxString& aErrors )
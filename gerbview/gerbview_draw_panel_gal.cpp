@@ -54,6 +54,9 @@ EDA_DRAW_PANEL_GAL( aParentWindow, aWindowId, aPosition, aSize, aOptions, aGalTy
     // This fixes the zoom in and zoom out limits:
     m_view->SetScaleLimits( ZOOM_MAX_LIMIT_GERBVIEW, ZOOM_MIN_LIMIT_GERBVIEW );
 
+    // Panning only draws the uncovered area when the GAL can move what it drew
+    m_view->UseScrollRedraw( true );
+
     m_viewControls = new KIGFX::WX_VIEW_CONTROLS( m_view, this );
 
     setDefaultLayerDeps();
@@ -0,0 +1,138 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
+#include "gerbview_jobs_handler.h"
+#include <base_units.h>
+#include <cli/exit_codes.h>
+#include <excellon_image.h>
+#include <gerber_file_image.h>
+#include <gerber_image_compare.h>
+#include <gerbview_settings.h>
+#include <jobs/job_gerber_diff.h>
+#include <kiface_base.h>
+#include <reporter.h>
+
+
+GERBVIEW_JOBS_HANDLER::GERBVIEW_JOBS_HANDLER()
+{
+    Register( "gerberdiff",
+              std::bind( &GERBVIEW_JOBS_HANDLER::JobGerberDiff, this, std::placeholders::_1 ) );
+}
+
+
+std::unique_ptr<GERBER_FILE_IMAGE> GERBVIEW_JOBS_HANDLER::loadImage( const wxString& aFileName,
+                                                                     int aLayer )
+{
+    if( !wxFileName::FileExists( aFileName ) )
+    {
+        m_reporter->Report( wxString::Format( _( "File '%s' not found.\n" ), aFileName ),
+                            RPT_SEVERITY_ERROR );
+        return nullptr;
+    }
+
+    std::unique_ptr<GERBER_FILE_IMAGE> image;
+    bool                               loaded = false;
+
+    if( EXCELLON_IMAGE::TestFileIsExcellon( aFileName ) )
+    {
+        EXCELLON_DEFAULTS  nc_defaults;
+        GERBVIEW_SETTINGS* cfg = static_cast<GERBVIEW_SETTINGS*>( Kiface().KifaceSettings() );
+        cfg->GetExcellonDefaults( nc_defaults );
+
+        auto drill = std::make_unique<EXCELLON_IMAGE>( aLayer );
+        loaded = drill->LoadFile( aFileName, &nc_defaults );
+        image = std::move( drill );
+    }
+    else if( GERBER_FILE_IMAGE::TestFileIsRS274( aFileName ) )
+    {
+        image = std::make_unique<GERBER_FILE_IMAGE>( aLayer );
+        loaded = image->LoadGerberFile( aFileName );
+    }
+
+    if( !loaded )
+    {
+        m_reporter->Report( wxString::Format( _( "'%s' is not a readable Gerber or drill "
+                                                 "file.\n" ),
+                                              aFileName ),
+                            RPT_SEVERITY_ERROR );
+        return nullptr;
+    }
+
+    return image;
+}
+
+
+int GERBVIEW_JOBS_HANDLER::JobGerberDiff( JOB* aJob )
+{
+    JOB_GERBER_DIFF* diffJob = dynamic_cast<JOB_GERBER_DIFF*>( aJob );
+
+    if( diffJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    std::unique_ptr<GERBER_FILE_IMAGE> first = loadImage( diffJob->m_firstFile, 0 );
+    std::unique_ptr<GERBER_FILE_IMAGE> second = loadImage( diffJob->m_secondFile, 1 );
+
+    if( !first || !second )
+        return CLI::EXIT_CODES::ERR_INVALID_INPUT_FILE;
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Comparing files...\n" ), RPT_SEVERITY_INFO );
+
+    GERBER_IMAGE_COMPARE compare( gerbIUScale.mmToIU( diffJob->m_tolerance ) );
+    compare.Compare( first.get(), second.get() );
+
+    wxString report;
+
+    report << wxString::Format( _( "First file: %s\n" ), diffJob->m_firstFile );
+    report << wxString::Format( _( "Second file: %s\n" ), diffJob->m_secondFile );
+    report << wxString::Format( _( "Found %zu differences\n" ), compare.GetRegions().size() );
+
+    for( const GERBER_DIFF_REGION& region : compare.GetRegions() )
+        report << GERBER_IMAGE_COMPARE::FormatRegion( region ) << wxS( "\n" );
+
+    if( diffJob->m_outputFile.IsEmpty() )
+    {
+        m_reporter->Report( report, RPT_SEVERITY_ACTION );
+    }
+    else
+    {
+        wxFFile file( diffJob->m_outputFile, wxS( "wb" ) );
+
+        if( !file.IsOpened() || !file.Write( report ) )
+        {
+            m_reporter->Report( wxString::Format( _( "Unable to save report to %s\n" ),
+                                                  diffJob->m_outputFile ),
+                                RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+        }
+
+        m_reporter->Report( wxString::Format( _( "Found %zu differences, saved report to %s\n" ),
+                                              compare.GetRegions().size(),
+                                              diffJob->m_outputFile ),
+                            RPT_SEVERITY_INFO );
+    }
+
+    if( diffJob->m_exitCodeOnDiff && !compare.GetRegions().empty() )
+        return CLI::EXIT_CODES::ERR_RC_VIOLATIONS;
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
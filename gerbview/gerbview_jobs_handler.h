@@ -0,0 +1,44 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GERBVIEW_JOBS_HANDLER_H
+#define GERBVIEW_JOBS_HANDLER_H
+
+#include <memory>
+
+#include <jobs/job_dispatcher.h>
+
+class GERBER_FILE_IMAGE;
+
+class GERBVIEW_JOBS_HANDLER : public JOB_DISPATCHER
+{
+public:
+    GERBVIEW_JOBS_HANDLER();
+    int JobGerberDiff( JOB* aJob );
+
+private:
+    /**
+     * Load a Gerber or Excellon drill file, its type being found from its contents.
+     *
+     * @return the image, or nullptr if the file can't be read.
+     */
+    std::unique_ptr<GERBER_FILE_IMAGE> loadImage( const wxString& aFileName, int aLayer );
+};
+
+#endif
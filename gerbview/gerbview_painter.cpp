@@ -263,7 +263,8 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
 
         if( aItem->m_AbsolutePolygon.OutlineCount() == 0 )
         {
-            std::vector<VECTOR2I> pts = aItem->m_ShapeAsPolygon.COutline( 0 ).CPoints();
+            const SHAPE_LINE_CHAIN& outline = aItem->m_ShapeAsPolygon.COutline( 0 );
+            std::vector<VECTOR2I>   pts( outline.CPoints().begin(), outline.CPoints().end() );
 
             for( auto& pt : pts )
                 pt = aItem->GetABPosition( pt );
@@ -433,7 +434,7 @@ void GERBVIEW_PAINTER::drawPolygon( GERBER_DRAW_ITEM* aParent, const SHAPE_POLY_
 
     SHAPE_POLY_SET poly;
     poly.NewOutline();
-    const std::vector<VECTOR2I> pts = aPolygon.COutline( 0 ).CPoints();
+    const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = aPolygon.COutline( 0 ).CPoints();
     VECTOR2I offset = aShift ? VECTOR2I( aParent->m_Start ) : VECTOR2I( 0, 0 );
 
     for( const VECTOR2I& pt : pts )
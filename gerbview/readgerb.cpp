@@ -28,6 +28,7 @@
 #include <gerbview.h>
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
+#include <gerber_file_reader.h>
 #include <gerber_file_image_list.h>
 #include <richio.h>
 #include <view/view.h>
@@ -225,9 +226,6 @@ bool GERBER_FILE_IMAGE::TestFileIsRS274( const wxString& aFullFileName )
 }
 
 
-// A large buffer to store one line
-char GERBER_FILE_IMAGE::m_LineBuffer[GERBER_BUFZ+1];
-
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
     int      G_command = 0;        // command number for G commands like G04
@@ -237,13 +235,16 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     ClearMessageList( );
     ResetDefaultValues();
 
-    // Read the gerber file */
-    m_Current_File = wxFopen( aFullFileName, wxT( "rt" ) );
+    // Read the gerber file, mapped in memory */
+    GERBER_FILE_READER reader;
 
-    if( m_Current_File == nullptr )
+    if( !reader.Open( aFullFileName ) )
         return false;
 
+    m_GerberFile = &reader;
+
     m_FileName = aFullFileName;
+    m_LineBuffer.resize( GERBER_BUFZ + 1 );
 
     LOCALE_IO toggleIo;
 
@@ -251,11 +252,11 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     while( true )
     {
-        if( fgets( m_LineBuffer, GERBER_BUFZ, m_Current_File ) == nullptr )
+        if( reader.ReadLine( m_LineBuffer.data(), GERBER_BUFZ ) == nullptr )
             break;
 
         m_LineNum++;
-        text = StrPurge( m_LineBuffer );
+        text = StrPurge( m_LineBuffer.data() );
 
         while( text && *text )
         {
@@ -312,7 +313,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
                 if( m_CommandState != ENTER_RS274X_CMD )
                 {
                     m_CommandState = ENTER_RS274X_CMD;
-                    ReadRS274XCommand( m_LineBuffer, GERBER_BUFZ, text );
+                    ReadRS274XCommand( m_LineBuffer.data(), GERBER_BUFZ, text );
                 }
                 else        //Error
                 {
@@ -331,7 +332,10 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
         }
     }
 
-    fclose( m_Current_File );
+    m_GerberFile = nullptr;
+
+    m_LineBuffer.clear();
+    m_LineBuffer.shrink_to_fit();
 
     m_InUse = true;
 
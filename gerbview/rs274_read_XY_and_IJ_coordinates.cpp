@@ -22,6 +22,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
 #include <math/util.h>      // for KiROUND
 
 #include <gerber_file_image.h>
@@ -76,16 +80,70 @@ static bool IsNumber( char x )
 }
 
 
+/**
+ * Read the number of a coordinate, made of the characters accepted by IsNumber().
+ *
+ * Integer numbers, by far the most common in Gerber and drill files, are converted while they
+ * are read instead of being copied for strtod().  Only numbers with a decimal point (or too
+ * many digits for an int64_t) go through strtod().
+ *
+ * @param aText is advanced past the number.
+ * @param aDigits receives the count of digits (sign and decimal point are not counted).
+ * @param aIsFloat is set to true if the number has a decimal point, and left unchanged if not.
+ * @return the value of the number, as strtod() would read it.
+ */
+static double readCoordNumber( char*& aText, int& aDigits, bool& aIsFloat )
+{
+    char*       start = aText;
+    bool        negative = false;
+    bool        hasPoint = false;
+    bool        inValue = true;     // false once a sign ends the number read by strtod()
+    int64_t     value = 0;
+
+    aDigits = 0;
+
+    if( *aText == '-' || *aText == '+' )
+        negative = *aText++ == '-';
+
+    for( ; IsNumber( *aText ); ++aText )
+    {
+        unsigned digit = (unsigned) ( *aText - '0' );
+
+        if( digit <= 9 )
+        {
+            // count digits only (sign and decimal point are not counted)
+            if( ++aDigits <= 18 && inValue )
+                value = value * 10 + digit;
+        }
+        else if( *aText == '.' )
+        {
+            hasPoint = true;
+        }
+        else
+        {
+            inValue = false;
+        }
+    }
+
+    if( hasPoint || aDigits > 18 )
+    {
+        // Force decimal format if reading a floating point number
+        if( hasPoint )
+            aIsFloat = true;
+
+        std::string number( start, aText );
+        return strtod( number.c_str(), nullptr );
+    }
+
+    return negative ? -(double) value : (double) value;
+}
+
+
 VECTOR2I GERBER_FILE_IMAGE::ReadXYCoord( char*& aText, bool aExcellonMode )
 {
     VECTOR2I pos( 0, 0 );
     bool    is_float   = false;
 
-    std::string line;
-
-    // Reserve the anticipated length plus an optional sign and decimal
-    line.reserve( std::max( m_FmtLen.x, m_FmtLen.y ) + 3 );
-
     // Set up return value for case where aText == nullptr
     if( !m_Relative )
         pos = m_CurrentPos;
@@ -100,21 +158,7 @@ VECTOR2I GERBER_FILE_IMAGE::ReadXYCoord( char*& aText, bool aExcellonMode )
         int    current_coord = 0;
         char   type_coord = *aText++;
 
-        line.clear();
-
-        while( IsNumber( *aText ) )
-        {
-            if( *aText == '.' )  // Force decimal format if reading a floating point number
-                is_float = true;
-
-            // count digits only (sign and decimal point are not counted)
-            if( (*aText >= '0') && (*aText <='9') )
-                nbdigits++;
-
-            line.push_back( *( aText++ ) );
-        }
-
-        double val = strtod( line.data(), nullptr );
+        double val = readCoordNumber( aText, nbdigits, is_float );
 
         if( is_float )
         {
@@ -173,11 +217,6 @@ VECTOR2I GERBER_FILE_IMAGE::ReadIJCoord( char*& aText )
     VECTOR2I pos( 0, 0 );
     bool    is_float   = false;
 
-    std::string line;
-
-    // Reserve the anticipated length plus an optional sign and decimal
-    line.reserve( std::max( m_FmtLen.x, m_FmtLen.y ) + 3 );
-
     if( aText == nullptr )
         return pos;
 
@@ -188,21 +227,7 @@ VECTOR2I GERBER_FILE_IMAGE::ReadIJCoord( char*& aText )
         int    current_coord = 0;
         char   type_coord = *aText++;
 
-        line.clear();
-
-        while( IsNumber( *aText ) )
-        {
-            if( *aText == '.' )  // Force decimal format if reading a floating point number
-                is_float = true;
-
-            // count digits only (sign and decimal point are not counted)
-            if( (*aText >= '0') && (*aText <='9') )
-                nbdigits++;
-
-            line.push_back( *( aText++ ) );
-        }
-
-        double val = strtod( line.data(), nullptr );
+        double val = readCoordNumber( aText, nbdigits, is_float );
 
         if( is_float )
         {
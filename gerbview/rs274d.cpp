@@ -131,10 +131,9 @@ void fillFlashedGBRITEM(  GERBER_DRAW_ITEM* aGbrItem,
         break;
 
     case APT_MACRO:
+        // The bounding box comes from the polygon of the D_CODE, built on first use like for
+        // the other polygonal apertures
         aGbrItem->m_ShapeType = GBR_SPOT_MACRO;
-
-        // Cache the bounding box for aperture macros
-        aGbrItem->GetDcodeDescr()->GetMacro()->GetApertureMacroShape( aGbrItem, aPos );
         break;
     }
 }
@@ -332,7 +331,7 @@ static void fillArcPOLY( GERBER_DRAW_ITEM* aGbrItem, const VECTOR2I& aStart, con
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( nullptr );
+    thread_local GERBER_DRAW_ITEM dummyGbrItem( nullptr );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -464,7 +463,7 @@ bool GERBER_FILE_IMAGE::Execute_G_Command( char*& text, int G_command )
             ExecuteRS274XCommand( code_command, nullptr, 0, cptr );
         }
 
-        GetEndOfBlock( m_LineBuffer, GERBER_BUFZ, text, m_Current_File );
+        GetEndOfBlock( m_LineBuffer.data(), GERBER_BUFZ, text, m_GerberFile );
 
         break;
 
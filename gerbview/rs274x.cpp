@@ -28,6 +28,7 @@
 
 #include <gerbview.h>
 #include <gerber_file_image.h>
+#include <gerber_file_reader.h>
 #include <core/ignore.h>
 #include <macros.h>
 #include <string_utils.h>
@@ -179,7 +180,7 @@ bool GERBER_FILE_IMAGE::ReadRS274XCommand( char *aBuff, unsigned int aBuffSize,
         }
 
         // end of current line, read another one.
-        if( fgets( aBuff, aBuffSize, m_Current_File ) == nullptr )
+        if( m_GerberFile->ReadLine( aBuff, aBuffSize ) == nullptr )
         {
             // end of file
             ok = false;
@@ -322,7 +323,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
                 msg.Printf( wxT( "Unknown id (%c) in FS command" ),
                            *aText );
                 AddMessageToList( msg );
-                GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+                GetEndOfBlock( aBuff, aBuffSize, aText, m_GerberFile );
                 ok = false;
                 break;
             }
@@ -385,7 +386,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case FILE_ATTRIBUTE:    // Command %TF ...
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_GerberFile, aBuff, aBuffSize, aText, m_LineNum );
 
         if( dummy.IsFileFunction() )
         {
@@ -410,7 +411,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case APERTURE_ATTRIBUTE:    // Command %TA
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_GerberFile, aBuff, aBuffSize, aText, m_LineNum );
 
         if( dummy.GetAttribute() == wxT( ".AperFunction" ) )
         {
@@ -427,7 +428,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     {
         X2_ATTRIBUTE dummy;
 
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_GerberFile, aBuff, aBuffSize, aText, m_LineNum );
 
         if( dummy.GetAttribute() == wxT( ".N" ) )
         {
@@ -461,7 +462,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case REMOVE_APERTURE_ATTRIBUTE:    // Command %TD ...
     {
         X2_ATTRIBUTE dummy;
-        dummy.ParseAttribCmd( m_Current_File, aBuff, aBuffSize, aText, m_LineNum );
+        dummy.ParseAttribCmd( m_GerberFile, aBuff, aBuffSize, aText, m_LineNum );
         RemoveAttribute( dummy );
     }
         break;
@@ -688,7 +689,7 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
     case AP_MACRO:  // lines like %AMMYMACRO*
                     // 5,1,8,0,0,1.08239X$1,22.5*
                     // %
-        /*ok = */ReadApertureMacro( aBuff, aBuffSize, aText, m_Current_File );
+        /*ok = */ReadApertureMacro( aBuff, aBuffSize, aText, m_GerberFile );
         break;
 
     case AP_DEFINITION:
@@ -909,13 +910,14 @@ bool GERBER_FILE_IMAGE::ExecuteRS274XCommand( int aCommand, char* aBuff,
 
     ignore_unused( seq_len );
 
-    ok = GetEndOfBlock( aBuff, aBuffSize, aText, m_Current_File );
+    ok = GetEndOfBlock( aBuff, aBuffSize, aText, m_GerberFile );
 
     return ok;
 }
 
 
-bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* gerber_file )
+bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText,
+                                       GERBER_FILE_READER* gerber_file )
 {
     for( ; ; )
     {
@@ -930,7 +932,7 @@ bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char
             aText++;
         }
 
-        if( fgets( aBuff, aBuffSize, gerber_file ) == nullptr )
+        if( gerber_file->ReadLine( aBuff, aBuffSize ) == nullptr )
             break;
 
         m_LineNum++;
@@ -941,7 +943,8 @@ bool GERBER_FILE_IMAGE::GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char
 }
 
 
-char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile )
+char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText,
+                                      GERBER_FILE_READER* aFile )
 {
     for( ; ; )
     {
@@ -954,7 +957,7 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
                 break;
 
             case 0:    // End of text found in aBuff: Read a new string
-                if( fgets( aBuff, aBuffSize, aFile ) == nullptr )
+                if( aFile->ReadLine( aBuff, aBuffSize ) == nullptr )
                     return nullptr;
 
                 m_LineNum++;
@@ -970,7 +973,7 @@ char* GERBER_FILE_IMAGE::GetNextLine( char *aBuff, unsigned int aBuffSize, char*
 
 bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
                                 char*&    aText,
-                                FILE*     gerber_file )
+                                GERBER_FILE_READER* gerber_file )
 {
     wxString       msg;
     APERTURE_MACRO am;
@@ -1046,7 +1049,7 @@ bool GERBER_FILE_IMAGE::ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
             is_comment = true;
 
             // Skip comment
-            GetEndOfBlock( m_LineBuffer, GERBER_BUFZ, aText, m_Current_File );
+            GetEndOfBlock( m_LineBuffer.data(), GERBER_BUFZ, aText, m_GerberFile );
 
             break;
 
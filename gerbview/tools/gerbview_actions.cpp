@@ -91,6 +91,13 @@ TOOL_ACTION GERBVIEW_ACTIONS::showSource( TOOL_ACTION_ARGS()
         .Tooltip( _( "Show source file for the current layer" ) )
         .Icon( BITMAPS::tools ) );
 
+TOOL_ACTION GERBVIEW_ACTIONS::compareLayers( TOOL_ACTION_ARGS()
+        .Name( "gerbview.Inspection.compareLayers" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Compare Layers..." ) )
+        .Tooltip( _( "List the areas drawn by only one of the active layer and another layer" ) )
+        .Icon( BITMAPS::tools ) );
+
 TOOL_ACTION GERBVIEW_ACTIONS::exportToPcbnew( TOOL_ACTION_ARGS()
         .Name( "gerbview.Control.exportToPcbnew" )
         .Scope( AS_GLOBAL )
@@ -25,6 +25,10 @@
 #include <dialogs/dialog_layers_select_to_pcb.h>
 #include <gestfich.h>
 #include <gerber_file_image.h>
+#include <gerber_file_image_list.h>
+#include <gerber_image_compare.h>
+#include <dialogs/html_message_box.h>
+#include <widgets/wx_progress_reporters.h>
 #include <gerbview_id.h>
 #include "gerbview_inspection_tool.h"
 #include "gerbview_actions.h"
@@ -196,6 +200,83 @@ int GERBVIEW_INSPECTION_TOOL::ShowSource( const TOOL_EVENT& aEvent )
 }
 
 
+int GERBVIEW_INSPECTION_TOOL::CompareLayers( const TOOL_EVENT& aEvent )
+{
+    int                     activeLayer = m_frame->GetActiveLayer();
+    GERBER_FILE_IMAGE*      activeImage = m_frame->GetGbrImage( activeLayer );
+    GERBER_FILE_IMAGE_LIST* images = m_frame->GetImagesList();
+
+    if( !activeImage )
+    {
+        wxString msg;
+        msg.Printf( _( "No file loaded on the active layer %d." ), activeLayer + 1 );
+        wxMessageBox( msg );
+        return 0;
+    }
+
+    wxArrayString    names;
+    std::vector<int> layers;
+
+    for( unsigned int layer = 0; layer < m_frame->ImagesMaxCount(); ++layer )
+    {
+        if( !m_frame->GetGbrImage( layer ) || static_cast<int>( layer ) == activeLayer )
+            continue;
+
+        names.Add( images->GetDisplayName( layer, false, true ) );
+        layers.push_back( layer );
+    }
+
+    if( layers.empty() )
+    {
+        wxMessageBox( _( "Load another file to compare the active layer to." ) );
+        return 0;
+    }
+
+    wxSingleChoiceDialog dlg( m_frame, images->GetDisplayName( activeLayer, false, true ),
+                              _( "Compare Active Layer To" ), names );
+
+    if( dlg.ShowModal() != wxID_OK )
+        return 0;
+
+    int                  otherLayer = layers[dlg.GetSelection()];
+    GERBER_IMAGE_COMPARE compare( gerbIUScale.mmToIU( 0.025 ) );
+    bool                 completed;
+
+    {
+        WX_PROGRESS_REPORTER progress( m_frame, _( "Compare Layers" ), 1 );
+        completed = compare.Compare( activeImage, m_frame->GetGbrImage( otherLayer ), &progress );
+    }
+
+    if( !completed )
+        return 0;
+
+    HTML_MESSAGE_BOX mbox( m_frame, _( "Layer Comparison" ) );
+
+    mbox.MessageSet( wxString::Format( _( "First image: %s" ),
+                                       images->GetDisplayName( activeLayer, false, true ) ) );
+    mbox.MessageSet( wxString::Format( _( "Second image: %s" ),
+                                       images->GetDisplayName( otherLayer, false, true ) ) );
+
+    if( compare.GetRegions().empty() )
+    {
+        mbox.MessageSet( _( "No differences found." ) );
+    }
+    else
+    {
+        wxArrayString list;
+
+        for( const GERBER_DIFF_REGION& region : compare.GetRegions() )
+            list.Add( GERBER_IMAGE_COMPARE::FormatRegion( region ) );
+
+        mbox.ListSet( list );
+    }
+
+    mbox.ShowModal();
+
+    return 0;
+}
+
+
 using KIGFX::PREVIEW::TWO_POINT_GEOMETRY_MANAGER;
 
 
@@ -326,5 +407,6 @@ void GERBVIEW_INSPECTION_TOOL::setTransitions()
 {
     Go( &GERBVIEW_INSPECTION_TOOL::ShowSource,     GERBVIEW_ACTIONS::showSource.MakeEvent() );
     Go( &GERBVIEW_INSPECTION_TOOL::ShowDCodes,     GERBVIEW_ACTIONS::showDCodes.MakeEvent() );
+    Go( &GERBVIEW_INSPECTION_TOOL::CompareLayers,  GERBVIEW_ACTIONS::compareLayers.MakeEvent() );
     Go( &GERBVIEW_INSPECTION_TOOL::MeasureTool,    ACTIONS::measureTool.MakeEvent() );
 }
@@ -46,6 +46,9 @@ public:
     ///< Show the source for the gerber file
     int ShowSource( const TOOL_EVENT& aEvent );
 
+    ///< Compare the geometry of the active layer to another layer
+    int CompareLayers( const TOOL_EVENT& aEvent );
+
     ///< Set up handlers for various events.
     void setTransitions() override;
 
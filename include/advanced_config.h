@@ -25,6 +25,7 @@
 #define ADVANCED_CFG__H
 
 #include <kicommon.h>
+#include <wx/string.h>
 
 class wxConfigBase;
 
@@ -169,6 +170,19 @@ public:
      */
     double m_SliverAngleTolerance;
 
+    /**
+     * Tile size for the DRC tests which analyse merged copper (slivers, connection widths).
+     *
+     * Copper larger than a tile is tested tile by tile, in parallel, instead of as one polygon
+     * per layer or net.  This bounds memory use on very large boards.  0 disables tiling.
+     * Units are mm.
+     *
+     * Setting name: "DRCTileSize"
+     * Valid values: 0 to 10000
+     * Default value: 0
+     */
+    double m_DRCTileSize;
+
 
     /**
      * Dimension used to calculate the actual hole size from the finish hole size.
@@ -290,6 +304,67 @@ public:
      */
     bool m_DebugZoneFiller;
 
+    /**
+     * Refill zones only around the items changed by an edit when they are refilled
+     * automatically, rather than from scratch.
+     *
+     * Setting name: "IncrementalZoneRefill"
+     * Valid values: 0 or 1
+     * Default value: 1
+     */
+    bool m_IncrementalZoneRefill;
+
+    /**
+     * Refill zones automatically after edits with quick, approximate draft fills.  Draft fills
+     * are replaced by full-precision fills when the board is saved, before DRC, and once the
+     * editor has been idle for DraftZoneRefillDelay.
+     *
+     * Setting name: "DraftZoneRefill"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_DraftZoneRefill;
+
+    /**
+     * The maximum error used to approximate arcs in draft zone fills, in mm.
+     *
+     * Setting name: "DraftZoneFillMaxError"
+     * Valid values: 0.005 to 1.0
+     * Default value: 0.05
+     */
+    double m_DraftZoneFillMaxError;
+
+    /**
+     * How long the editor has to stay idle before draft zone fills are refilled at full
+     * precision, in milliseconds.
+     *
+     * Setting name: "DraftZoneRefillDelay"
+     * Valid values: 100 to 600000
+     * Default value: 3000
+     */
+    int m_DraftZoneRefillDelay;
+
+    /**
+     * Commits changing at least this many items compute their ratsnest in the background,
+     * rather than blocking the editor until it is done.  0 disables background updates.
+     *
+     * Setting name: "AsyncRatsnestMinChanges"
+     * Valid values: 0 to 1000000
+     * Default value: 200
+     */
+    int m_AsyncRatsnestMinChanges;
+
+    /**
+     * Board files of at least this size in megabytes keep their zone fills in a binary cache
+     * file next to them (board.kicad_pcb.cache), which is read instead of the fills of the
+     * board file when it is still current.  0 disables the cache.
+     *
+     * Setting name: "BoardCacheMinSize"
+     * Valid values: 0 to 100000
+     * Default value: 0
+     */
+    int m_BoardCacheMinSize;
+
     /**
      * A mode that writes PDFs without compression.
      *
@@ -389,6 +464,16 @@ public:
      */
     bool m_ShowEventCounters;
 
+    /**
+     * Shows the rendering counters of the last redraw over the drawing canvas: redraw time,
+     * items drawn per layer, cache hits and misses, vertex count and memory and draw calls.
+     *
+     * Setting name: "ShowRenderStatistics"
+     * Valid values: 0 or 1
+     * Default value: 0
+     */
+    bool m_ShowRenderStatistics;
+
     /**
      * Allow manual scaling of canvas.
      *
@@ -421,15 +506,6 @@ public:
      */
     double m_3DRT_BevelExtentFactor;
 
-    /**
-     * Use Clipper2 instead of Clipper1.
-     *
-     * Setting name: "UseClipper2"
-     * Valid values: 0 or 1
-     * Default value: 1
-     */
-    bool m_UseClipper2;
-
     /**
      * Use the 3DConnexion Driver.
      *
@@ -509,6 +585,64 @@ public:
      */
     int m_MinimumSegmentLength;
 
+    /**
+     * Number of worker threads in the shared thread pool.  0 uses one thread per hardware
+     * thread.  Can be overridden with the kicad-cli "--threads" option.
+     *
+     * Setting name: "MaximumThreads"
+     * Valid values: 0 to 1024
+     * Default value: 0
+     */
+    int m_MaximumThreads;
+
+    /**
+     * Maximum number of threads used concurrently by the zone filler.  0 for no limit.
+     *
+     * Setting name: "ZoneFillThreads"
+     * Valid values: 0 to 1024
+     * Default value: 0
+     */
+    int m_ZoneFillThreads;
+
+    /**
+     * Maximum number of threads used concurrently by DRC test providers.  0 for no limit.
+     *
+     * Setting name: "DRCThreads"
+     * Valid values: 0 to 1024
+     * Default value: 0
+     */
+    int m_DRCThreads;
+
+    /**
+     * Maximum number of threads used concurrently by the connectivity algorithm.  0 for no
+     * limit.
+     *
+     * Setting name: "ConnectivityThreads"
+     * Valid values: 0 to 1024
+     * Default value: 0
+     */
+    int m_ConnectivityThreads;
+
+    /**
+     * Maximum number of threads used by the 3D raytracer.  0 for no limit.
+     *
+     * Setting name: "V3DRT_Threads"
+     * Valid values: 0 to 1024
+     * Default value: 0
+     */
+    int m_3DRT_Threads;
+
+    /**
+     * When set, record trace events (board load, zone fill, DRC providers, connectivity,
+     * redraws, thread pool queue depth) and write them to this file in Chrome trace format
+     * on exit.  The file can be opened in chrome://tracing or https://ui.perfetto.dev.
+     *
+     * Setting name: "TraceProfileFile"
+     * Valid values: a file path
+     * Default value: empty (disabled)
+     */
+    wxString m_TraceProfileFile;
+
 ///@}
 
 
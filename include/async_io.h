@@ -0,0 +1,157 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASYNC_IO_H
+#define ASYNC_IO_H
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <core/thread_pool.h>
+#include <tool/coroutine.h>
+
+
+/**
+ * Cooperative scheduler overlapping blocking I/O with work that must stay on the calling thread.
+ *
+ * Each job runs as a #COROUTINE on the thread calling Run().  When a job needs a file or network
+ * read it calls Await(): the operation is handed to the thread pool and the job is suspended so
+ * that the other jobs can parse whatever has already arrived.  Parsers, caches and other code
+ * which is not thread safe therefore keep running on a single thread, while the reads they
+ * depend on are in flight concurrently.
+ *
+ * Coroutine stacks are small.  Deeply recursive work (e.g. a model importer) should be wrapped
+ * in RunOnMainStack().
+ */
+class ASYNC_IO_SCHEDULER
+{
+public:
+    typedef std::function<void( ASYNC_IO_SCHEDULER& )> JOB_FUNC;
+
+    ASYNC_IO_SCHEDULER( thread_pool& aPool = GetKiCadThreadPool() );
+
+    ~ASYNC_IO_SCHEDULER();
+
+    ASYNC_IO_SCHEDULER( const ASYNC_IO_SCHEDULER& ) = delete;
+    ASYNC_IO_SCHEDULER& operator=( const ASYNC_IO_SCHEDULER& ) = delete;
+
+    /**
+     * Queue a job.  Jobs are started in the order they were added.
+     */
+    void AddJob( JOB_FUNC aJob );
+
+    /**
+     * Limit the number of jobs started but not finished, which bounds the number of reads in
+     * flight (and the memory they hold).  0 means twice the number of pool threads.
+     */
+    void SetMaxActiveJobs( size_t aMaxActive ) { m_maxActive = aMaxActive; }
+
+    /**
+     * Run all jobs and wait for them to finish.
+     *
+     * @param aIdleCallback optional function called whenever no job can make progress, at most
+     *                      every \a aPollInterval.  Typically keeps a progress reporter or the UI
+     *                      refreshed.  If it returns false, jobs which have not started yet are
+     *                      skipped.
+     * @param aPollInterval the maximum time between two calls to \a aIdleCallback.
+     * @return true if all jobs ran, false if the run was cancelled.
+     * @throw the first exception thrown by a job, once all the other jobs have finished.
+     */
+    bool Run( const std::function<bool()>& aIdleCallback = nullptr,
+              std::chrono::milliseconds aPollInterval = std::chrono::milliseconds( 50 ) );
+
+    /**
+     * Run \a aOperation on the thread pool and suspend the calling job until it has completed.
+     *
+     * Outside of a job the operation is simply executed synchronously.
+     *
+     * @return the result of \a aOperation.  Exceptions thrown by the operation are rethrown in
+     *         the job.
+     */
+    template <typename FUNC>
+    auto Await( FUNC aOperation ) -> decltype( aOperation() )
+    {
+        if( !m_current )
+            return aOperation();
+
+        std::future<decltype( aOperation() )> future = m_pool.submit( std::move( aOperation ) );
+
+        m_current->m_wait =
+                [&future]( std::chrono::milliseconds aTimeout )
+                {
+                    return future.wait_for( aTimeout ) == std::future_status::ready;
+                };
+
+        suspend();
+
+        return future.get();
+    }
+
+    /**
+     * Read the whole of \a aFilename on the thread pool.
+     *
+     * @param aContents receives the contents of the file.
+     * @return false if the file could not be read.
+     */
+    bool ReadFile( const wxString& aFilename, std::string& aContents );
+
+    /**
+     * Read \a aFilename on the thread pool and discard the data.
+     *
+     * Used ahead of code which insists on opening the file itself (e.g. a 3D model plugin) so
+     * that the read it then does is served from the operating system's cache.
+     *
+     * @return false if the file could not be read.
+     */
+    bool Prefetch( const wxString& aFilename );
+
+    /**
+     * Run \a aFunc on the main stack rather than on the job's coroutine stack.
+     */
+    void RunOnMainStack( std::function<void()> aFunc );
+
+    bool IsCancelled() const { return m_cancelled; }
+
+private:
+    struct JOB
+    {
+        JOB_FUNC                                         m_func;
+        std::unique_ptr<COROUTINE<int, JOB*>>            m_coroutine;
+
+        /// Set while the job is suspended in Await(); returns true once the operation is done
+        std::function<bool( std::chrono::milliseconds )> m_wait;
+    };
+
+    int  runJob( JOB* aJob );
+    void suspend();
+
+    thread_pool&                      m_pool;
+    std::vector<std::unique_ptr<JOB>> m_jobs;
+    JOB*                              m_current;
+    size_t                            m_maxActive;
+    bool                              m_cancelled;
+    std::exception_ptr                m_error;
+};
+
+
+#endif // ASYNC_IO_H
@@ -36,6 +36,7 @@
 #include <widgets/msgpanel.h>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <gal/cursors.h>
 
@@ -265,6 +266,12 @@ protected:
     void onRefreshTimer( wxTimerEvent& aEvent );
     void onShowTimer( wxTimerEvent& aEvent );
 
+    /// Format the rendering counters of the view and the GAL, for the statistics overlay.
+    void updateRenderStatistics( double aUpdateTime );
+
+    /// Draw the rendering counters in the top left corner of the overlay target.
+    void drawRenderStatistics();
+
     wxWindow*                m_parent;           ///< Pointer to the parent window
     EDA_DRAW_FRAME*          m_edaFrame;         ///< Parent EDA_DRAW_FRAME (if available)
 
@@ -317,6 +324,9 @@ protected:
 
     /// Optional overlay for drawing transient debug objects
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
+
+    /// Lines of the rendering statistics overlay, see ADVANCED_CFG::m_ShowRenderStatistics
+    std::vector<wxString>    m_renderStatistics;
 };
 
 #endif
@@ -95,6 +95,7 @@ public:
     }
 
     void SetMaxSize( size_t aMaxSize ) { m_maxSize = aMaxSize; }
+    size_t GetMaxSize() const { return m_maxSize; }
     void SetMaxAge( time_t aMaxAge ) { m_maxAge = aMaxAge; }
 
 private:
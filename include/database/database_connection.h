@@ -35,6 +35,8 @@ extern const char* const traceDatabase;
 namespace nanodbc
 {
     class connection;
+    class result;
+    class statement;
 }
 
 
@@ -77,6 +79,18 @@ public:
     bool SelectOne( const std::string& aTable, const std::pair<std::string, std::string>& aWhere,
                     ROW& aResult );
 
+    /**
+     * Retrieves the rows matching several values of a column in as few queries as possible, and
+     * caches them so that the following SelectOne() calls for these values don't need to query
+     * the database.  Values already in the cache are not queried again.
+     * @param aTable the name of a table in the database
+     * @param aColumn the column to search
+     * @param aValues the values to search for
+     * @return true if all queries succeeded (whether or not all values were found)
+     */
+    bool SelectMany( const std::string& aTable, const std::string& aColumn,
+                     const std::vector<std::string>& aValues );
+
     /**
      * Retrieves all rows from a database table.
      * @param aTable the name of a table in the database
@@ -96,8 +110,27 @@ private:
 
     std::string columnsFor( const std::string& aTable );
 
+    /**
+     * Returns a statement prepared for \a aQuery, reusing the one prepared by an earlier call.
+     * @throw nanodbc::database_error if the statement could not be prepared
+     */
+    nanodbc::statement& preparedStatement( const std::string& aQuery );
+
+    /**
+     * Drops the connection, e.g. after a failed query.  nanodbc won't auto-reconnect.
+     */
+    void dropConnection();
+
+    bool readRow( nanodbc::result& aResults, ROW& aRow );
+
+    std::string rowCacheKey( const std::string& aTable, const std::string& aColumn,
+                             const std::string& aValue ) const;
+
     std::unique_ptr<nanodbc::connection> m_conn;
 
+    /// Prepared statements by query, valid as long as m_conn is connected
+    std::map<std::string, std::unique_ptr<nanodbc::statement>> m_statements;
+
     std::string m_dsn;
     std::string m_user;
     std::string m_pass;
@@ -116,7 +149,13 @@ private:
 
     typedef DATABASE_CACHE<std::map<std::string, ROW>> DB_CACHE_TYPE;
 
+    /// Whole tables read by SelectAll()
     std::unique_ptr<DB_CACHE_TYPE> m_cache;
+
+    typedef DATABASE_CACHE<ROW> DB_ROW_CACHE_TYPE;
+
+    /// Single rows read by SelectOne() and SelectMany(), keyed by table, column and value
+    std::unique_ptr<DB_ROW_CACHE_TYPE> m_rowCache;
 };
 
 #endif //KICAD_DATABASE_CONNECTION_H
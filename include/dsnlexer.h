@@ -207,6 +207,16 @@ public:
      */
     int NextTok();
 
+    /**
+     * Append the raw text up to and including the #DSN_RIGHT which closes the current list to
+     * @a aText, without tokenizing it, and leave the lexer on that #DSN_RIGHT as if it had
+     * been read by #NextTok().  Used to read nested lists ahead so that they can be parsed
+     * later, e.g. by another lexer on another thread.
+     *
+     * @throw IO_ERROR if the list isn't closed before the end of the file.
+     */
+    void ReadListText( std::string& aText );
+
     /**
      * Call #NextTok() and then verifies that the token read in satisfies #IsSymbol().
      *
@@ -520,6 +530,20 @@ protected:
         return parseDouble( GetTokenText( aToken ) );
     }
 
+    /**
+     * Parse [@a aBegin, @a aEnd) as a plain decimal number (optional sign, digits and fraction,
+     * no exponent) multiplied by @a aScale, in integer arithmetic.  This is exact for the
+     * coordinates found in files and skips the double round trip of parseDouble().  The result
+     * is rounded half away from zero, like KiROUND().
+     *
+     * @param aRest if not null, is set to the first character after the number, else the whole
+     *              range has to be the number.
+     * @return false if the text isn't such a number or the result would overflow, in which
+     *         case callers fall back on parseDouble().
+     */
+    static bool parseScaledDecimal( const char* aBegin, const char* aEnd, long long aScale,
+                                    long long& aResult, const char** aRest = nullptr );
+
     bool                iOwnReaders;            ///< on readerStack, should I delete them?
     const char*         start;
     const char*         next;
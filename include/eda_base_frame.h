@@ -579,6 +579,9 @@ public:
     virtual int GetUndoCommandCount() const { return m_undoList.m_CommandsList.size(); }
     virtual int GetRedoCommandCount() const { return m_redoList.m_CommandsList.size(); }
 
+    const UNDO_REDO_CONTAINER& GetUndoList() const { return m_undoList; }
+    const UNDO_REDO_CONTAINER& GetRedoList() const { return m_redoList; }
+
     virtual wxString GetUndoActionDescription() const;
     virtual wxString GetRedoActionDescription() const;
 
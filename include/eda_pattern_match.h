@@ -192,7 +192,7 @@ protected:
     RELATION m_relation;
     double   m_value;
 
-    static wxRegEx m_regex_description;
+    wxRegEx        m_regex_description;
     static wxRegEx m_regex_search;
     static const std::map<wxString, double> m_units;
 };
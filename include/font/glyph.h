@@ -106,9 +106,40 @@ public:
                                       double aTilt, const EDA_ANGLE& aAngle, bool aMirror,
                                       const VECTOR2I& aOrigin  );
 
+    /**
+     * Make this glyph the source of the glyphs transformed from it.  Used for the glyphs of
+     * fonts, which live as long as the fonts.
+     */
+    void MarkAsSource() { m_source = this; }
+
+    /**
+     * @return the font glyph this glyph was transformed from, or nullptr if it doesn't come from
+     *         a font (as overbars and underlines).
+     */
+    const STROKE_GLYPH* GetSource() const { return m_source; }
+
+    /**
+     * Map a point from the coordinates of the source glyph to the coordinates of this glyph.
+     */
+    VECTOR2D FromSource( const VECTOR2D& aPoint ) const
+    {
+        return m_origin + m_xAxis * aPoint.x + m_yAxis * aPoint.y;
+    }
+
+    /// Return the images of the unit vectors of the source glyph
+    const VECTOR2D& GetXAxis() const { return m_xAxis; }
+    const VECTOR2D& GetYAxis() const { return m_yAxis; }
+
 private:
     bool  m_penIsDown = false;
     BOX2D m_boundingBox;
+
+    const STROKE_GLYPH* m_source = nullptr;
+
+    // The affine transform from the source glyph
+    VECTOR2D m_origin = { 0.0, 0.0 };
+    VECTOR2D m_xAxis = { 1.0, 0.0 };
+    VECTOR2D m_yAxis = { 0.0, 1.0 };
 };
 
 
@@ -122,6 +122,14 @@ private:
                                       bool aMirror, const VECTOR2I& aOrigin,
                                       TEXT_STYLE_FLAGS aTextStyle ) const;
 
+    /**
+     * Return the triangulated shape of a glyph in font units, times m_glyphCacheScaler, loading
+     * it on first use.  The face must already be set to the size matching \a aScript.
+     *
+     * Must be called with m_freeTypeMutex locked.
+     */
+    const OUTLINE_GLYPH& getCachedGlyph( unsigned int aGlyphIndex, bool aScript ) const;
+
 private:
     // FreeType variables
 
@@ -136,9 +144,15 @@ private:
     bool              m_fakeBold;
     bool              m_fakeItal;
 
-    // cache for glyphs converted to straight segments
-    // key is glyph index (FT_GlyphSlot field glyph_index)
-    std::map<unsigned int, GLYPH_POINTS_LIST> m_contourCache;
+    // cache for glyphs converted to straight segments and triangulated, shared by all the texts
+    // using the font which transform copies of them
+    // key is glyph index (FT_GlyphSlot field glyph_index) and whether the glyph is loaded at
+    // the sub/superscript size
+    mutable std::map<std::pair<unsigned int, bool>, std::unique_ptr<OUTLINE_GLYPH>> m_glyphCache;
+
+    // Cached glyphs are kept in integer coordinates, so font units are scaled up to keep their
+    // precision
+    static constexpr double m_glyphCacheScaler = 1024.0;
 
     // The height of the KiCad stroke font is the distance between stroke endpoints for a vertical
     // line of cap-height.  So the cap-height of the font is actually stroke-width taller than its
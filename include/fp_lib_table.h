@@ -147,6 +147,15 @@ public:
     void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aNickname,
                              bool aBestEfforts );
 
+    /**
+     * Return the summaries of the footprints of the library given by @a aNickname, see
+     * PCB_IO::FootprintEnumerateSummaries().
+     *
+     * @throw IO_ERROR if the library cannot be found, or footprint cannot be loaded.
+     */
+    void FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                      const wxString& aNickname, bool aBestEfforts );
+
     /**
      * Generate a hashed timestamp representing the last-mod-times of the library indicated
      * by \a aNickname, or all libraries if \a aNickname is NULL.
@@ -34,10 +34,12 @@
 
 #include <gal/compositor.h>
 #include <gal/gal_display_options.h>
+#include <math/box2.h>
 #include <cairo.h>
 
 #include <cstdint>
 #include <deque>
+#include <vector>
 
 namespace KIGFX
 {
@@ -86,6 +88,22 @@ public:
     /// @copydoc COMPOSITOR::Present()
     virtual void Present() override;
 
+    /**
+     * Restrict the clearing of a buffer and the drawing on it to some areas.
+     *
+     * @param aBufferHandle is the buffer to restrict.
+     * @param aAreas are the areas in screen pixels, none to lift the restriction.
+     */
+    void ClipBuffer( unsigned int aBufferHandle, const std::vector<BOX2I>& aAreas );
+
+    /**
+     * Move the contents of a buffer, the pixels left uncovered keeping their previous contents.
+     *
+     * @param aBufferHandle is the buffer to move.
+     * @param aDelta is the motion in pixels.
+     */
+    void ScrollBuffer( unsigned int aBufferHandle, const VECTOR2I& aDelta );
+
     void SetAntialiasingMode( CAIRO_ANTIALIASING_MODE aMode ); // clears all buffers
     CAIRO_ANTIALIASING_MODE GetAntialiasingMode() const
     {
@@ -120,6 +138,9 @@ protected:
      */
     void clean();
 
+    /// Restrict the drawing of a context to some areas, in screen pixels
+    void clip( cairo_t* aContext, const std::vector<BOX2I>& aAreas );
+
     /// Return number of currently used buffers.
     unsigned int usedBuffers()
     {
@@ -132,6 +153,7 @@ protected:
         cairo_t*            context;        ///< Main texture handle
         cairo_surface_t*    surface;        ///< Point to which an image from texture is attached
         BitmapPtr           bitmap;         ///< Pixel storage
+        std::vector<BOX2I>  clip;           ///< Areas the drawing is restricted to, if any
     };
 
     unsigned int            m_current;      ///< Currently used buffer handle
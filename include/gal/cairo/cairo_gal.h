@@ -413,6 +413,12 @@ public:
 
     void ClearTarget( RENDER_TARGET aTarget ) override;
 
+    /// @copydoc GAL::SetTargetClip()
+    bool SetTargetClip( const BOX2I& aArea ) override;
+
+    /// @copydoc GAL::ScrollTargets()
+    bool ScrollTargets( const VECTOR2I& aDelta ) override;
+
     /// @copydoc GAL::StartDiffLayer()
     void StartDiffLayer() override;
 
@@ -501,6 +507,7 @@ protected:
     unsigned int        m_savedBuffer;         ///< Handle to buffer to restore after rendering to temp buffer
     RENDER_TARGET       m_currentTarget;       ///< Current rendering target
     bool                m_validCompositor;     ///< Compositor initialization flag
+    bool                m_isCompositorFresh;   ///< Are the buffers new, with nothing to keep?
 
     // Variables related to wxWidgets
     wxWindow*           m_parentWindow;        ///< Parent window
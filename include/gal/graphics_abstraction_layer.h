@@ -82,6 +82,21 @@ public:
     /// Return true if the GAL engine is a OpenGL based type.
     virtual bool IsOpenGlEngine() { return false; }
 
+    /// Return the memory held by the vertex containers of the engine, in bytes.
+    virtual size_t GetVertexMemoryUsage() const { return 0; }
+
+    /// Rendering counters of an engine, to diagnose slow rendering.
+    struct RENDER_STATISTICS
+    {
+        unsigned int m_drawCalls = 0;           ///< Draw calls of the last frame
+        unsigned int m_cachedVertices = 0;      ///< Vertices held by the cache
+        unsigned int m_nonCachedVertices = 0;   ///< Vertices drawn without caching, last frame
+        int          m_defragmentations = 0;    ///< Defragmentations of the cache so far
+    };
+
+    /// Return the rendering counters of the engine, all 0 if it doesn't keep them.
+    virtual RENDER_STATISTICS GetRenderStatistics() const { return RENDER_STATISTICS(); }
+
     // ---------------
     // Drawing methods
     // ---------------
@@ -356,6 +371,17 @@ public:
         return m_lineWidth;
     }
 
+    /**
+     * Set the smallest size of a screen pixel, in world units, at which the items drawn from
+     * now on will be displayed.  0, the default, means they can be displayed at any zoom.
+     *
+     * Items that won't be magnified beyond some point can be drawn in cheaper ways that only
+     * hold up to it.
+     */
+    void SetMinPixelSize( double aWorldSize ) { m_minPixelSize = aWorldSize; }
+
+    double GetMinPixelSize() const { return m_minPixelSize; }
+
     /**
      * Set the depth of the layer (position on the z-axis)
      *
@@ -649,6 +675,27 @@ public:
      */
     virtual void ClearTarget( RENDER_TARGET aTarget ) {};
 
+    /**
+     * Restrict the clearing of the cached and noncached targets and the drawing on them to an
+     * area of the screen until the end of the current frame, keeping the rest of their contents.
+     *
+     * @param aArea is the area in screen pixels.
+     * @return false if the targets can't keep their contents, in which case they have to be
+     *         redrawn entirely.
+     */
+    virtual bool SetTargetClip( const BOX2I& aArea ) { return false; }
+
+    /**
+     * Move the contents of the cached and noncached targets after the view was panned, and
+     * restrict their clearing and the drawing on them to the uncovered area until the end of
+     * the current frame.
+     *
+     * @param aDelta is the motion of the contents in screen pixels.
+     * @return false if the targets can't keep their contents, in which case they have to be
+     *         redrawn entirely.
+     */
+    virtual bool ScrollTargets( const VECTOR2I& aDelta ) { return false; }
+
     /**
      * Return true if the target exists.
      *
@@ -1054,6 +1101,7 @@ protected:
     bool                 m_globalFlipY;        ///< Flag for Y axis flipping
 
     float                m_lineWidth;          ///< The line width
+    double               m_minPixelSize;       ///< Smallest pixel the items are displayed at
 
     bool                 m_isFillEnabled;      ///< Is filling of graphic objects enabled ?
     bool                 m_isStrokeEnabled;    ///< Are the outlines stroked ?
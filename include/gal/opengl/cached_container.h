@@ -94,7 +94,15 @@ public:
     ///< @copydoc VERTEX_CONTAINER::Unmap()
     virtual void Unmap() override = 0;
 
-    virtual unsigned int AllItemsSize() const { return 0; }
+    /**
+     * Return the number of vertices held, including the space reserved for the items.
+     */
+    virtual unsigned int AllItemsSize() const { return usedSpace(); }
+
+    /**
+     * Return the number of times the container was defragmented.
+     */
+    int GetDefragmentations() const { return m_defragmentations; }
 
 protected:
     ///< Maps size of free memory chunks to their offsets
@@ -180,6 +188,9 @@ protected:
     ///< Maximal vertex index number stored in the container
     unsigned int m_maxIndex;
 
+    ///< Number of defragmentations so far
+    int m_defragmentations;
+
 private:
     /// Debug & test functions
     void showFreeChunks();
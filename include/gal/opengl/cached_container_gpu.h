@@ -29,11 +29,18 @@
 
 #include <gal/opengl/cached_container.h>
 
+#include <utility>
+#include <vector>
+
 namespace KIGFX
 {
 
 /**
- * Specialization of CACHED_CONTAINER that stores data in video memory via memory mapping.
+ * Specialization of CACHED_CONTAINER that stores data in video memory.
+ *
+ * Vertices are written to a copy in RAM and only the changed ranges are sent to the vertex
+ * buffer when the container is unmapped.  The vertex buffer is never mapped, so updates don't
+ * wait for the GPU to finish drawing the previous frames.
  */
 class CACHED_CONTAINER_GPU : public CACHED_CONTAINER
 {
@@ -57,6 +64,9 @@ public:
     ///< @copydoc VERTEX_CONTAINER::Unmap()
     void Unmap() override;
 
+    ///< @copydoc VERTEX_CONTAINER::SetRangeDirty()
+    void SetRangeDirty( unsigned int aOffset, unsigned int aSize ) override;
+
     virtual unsigned int AllItemsSize() const override;
 
 
@@ -71,7 +81,6 @@ protected:
      * @return false in case of failure (e.g. memory shortage).
      */
     bool defragmentResize( unsigned int aNewSize ) override;
-    bool defragmentResizeMemcpy( unsigned int aNewSize );
 
     ///< Flag saying if vertex buffer is currently mapped
     bool m_isMapped;
@@ -79,8 +88,11 @@ protected:
     ///< Vertex buffer handle
     unsigned int m_glBufferHandle;
 
-    ///< Flag saying whether it is safe to use glCopyBufferSubData
-    bool m_useCopyBuffer;
+    ///< Size of the vertex buffer storage, expressed in vertices
+    unsigned int m_bufferSize;
+
+    ///< Offsets and sizes of the vertices changed since the last upload
+    std::vector<std::pair<unsigned int, unsigned int>> m_dirtyRanges;
 };
 } // namespace KIGFX
 
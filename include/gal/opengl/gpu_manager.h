@@ -79,6 +79,13 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Return the number of draw calls issued since the last call to ResetDrawCalls().
+     */
+    unsigned int GetDrawCalls() const { return m_drawCalls; }
+
+    void ResetDrawCalls() { m_drawCalls = 0; }
+
 protected:
     GPU_MANAGER( VERTEX_CONTAINER* aContainer );
 
@@ -96,6 +103,9 @@ protected:
 
     ///< true: enable Z test when drawing
     bool m_enableDepthTest;
+
+    ///< Number of draw calls issued since the last reset
+    unsigned int m_drawCalls;
 };
 
 
@@ -134,6 +144,9 @@ public:
     void Unmap();
 
 protected:
+    ///< Ranges with more vertices than this are drawn with a separate draw call
+    static constexpr unsigned int HUGE_VRANGE_SIZE = 1000;
+
     ///< Resizes the indices buffer to aNewSize if necessary
     void resizeIndices( unsigned int aNewSize );
 
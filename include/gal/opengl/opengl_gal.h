@@ -39,6 +39,7 @@
 #include <gal/opengl/cached_container.h>
 #include <gal/opengl/noncached_container.h>
 #include <gal/opengl/opengl_compositor.h>
+#include <gal/opengl/stroke_glyph_atlas.h>
 #include <gal/hidpi_gl_canvas.h>
 
 #include <unordered_map>
@@ -100,6 +101,12 @@ public:
 
     bool IsOpenGlEngine() override { return true; }
 
+    /// @copydoc GAL::GetVertexMemoryUsage()
+    size_t GetVertexMemoryUsage() const override;
+
+    /// @copydoc GAL::GetRenderStatistics()
+    RENDER_STATISTICS GetRenderStatistics() const override { return m_renderStatistics; }
+
     /// @copydoc GAL::IsInitialized()
     bool IsInitialized() const override
     {
@@ -257,6 +264,9 @@ public:
     /// @copydoc GAL::ClearTarget()
     void ClearTarget( RENDER_TARGET aTarget ) override;
 
+    /// @copydoc GAL::SetTargetClip()
+    bool SetTargetClip( const BOX2I& aArea ) override;
+
     /// @copydoc GAL::HasTarget()
     virtual bool HasTarget( RENDER_TARGET aTarget ) override;
 
@@ -339,6 +349,9 @@ private:
 
     static GLuint           g_fontTexture;      ///< Bitmap font texture handle (shared)
 
+    static GLuint           g_strokeGlyphTexture;   ///< Stroke glyph atlas texture (shared)
+    static std::unique_ptr<STROKE_GLYPH_ATLAS> g_strokeGlyphAtlas; ///< Its contents (shared)
+
     // Vertex buffer objects related fields
     typedef std::unordered_map< unsigned int, std::shared_ptr<VERTEX_ITEM> > GROUPS_MAP;
 
@@ -364,6 +377,9 @@ private:
 
     // Internal flags
     bool                    m_isFramebufferInitialized; ///< Are the framebuffers initialized?
+    bool                    m_isFramebufferFresh;       ///< Were they created for this frame?
+    bool                    m_isTargetClipped;          ///< Is SetTargetClip() in effect?
+    RENDER_STATISTICS       m_renderStatistics;         ///< Counters of the last frame
     static bool             m_isBitmapFontLoaded;       ///< Is the bitmap font texture loaded?
     bool                    m_isBitmapFontInitialized;  ///< Is the shader set to use bitmap fonts?
     bool                    m_isInitialized;            ///< Basic initialization flag, has to be
@@ -529,6 +545,23 @@ private:
      */
     std::pair<VECTOR2D, float> computeBitmapTextSize( const UTF8& aText ) const;
 
+    /**
+     * Return the stroke glyph atlas cell to draw a glyph with the current line width, if it
+     * can be drawn from the atlas without showing its texels.
+     */
+    const STROKE_GLYPH_ATLAS::CELL* getStrokeGlyphCell( const KIFONT::STROKE_GLYPH& aGlyph );
+
+    /**
+     * Draw a stroke glyph as a single quad textured from the stroke glyph atlas.
+     *
+     * @param aReserve if set to true, reserve the 6 vertices of the quad.
+     */
+    void drawStrokeGlyphQuad( const KIFONT::STROKE_GLYPH& aGlyph,
+                              const STROKE_GLYPH_ATLAS::CELL& aCell, bool aReserve = true );
+
+    /// Send the glyphs added to the stroke glyph atlas to its texture
+    void updateStrokeGlyphTexture();
+
     // Event handling
     /**
      * This is the OnPaint event handler.
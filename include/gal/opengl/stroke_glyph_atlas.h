@@ -0,0 +1,124 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef STROKE_GLYPH_ATLAS_H
+#define STROKE_GLYPH_ATLAS_H
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include <math/box2.h>
+#include <math/vector2d.h>
+
+namespace KIFONT
+{
+class STROKE_GLYPH;
+}
+
+namespace KIGFX
+{
+
+/**
+ * Distance fields of the stroke font glyphs, packed in a texture, to draw stroke font text with
+ * one quad per glyph.
+ *
+ * Each texel holds the distance to the nearest stroke of a glyph.  Keeping the texels closer
+ * than half the pen width gives the same round ended strokes as drawing the segments, for any
+ * pen width.  Glyphs are added on first use.
+ */
+class STROKE_GLYPH_ATLAS
+{
+public:
+    ///< Side of the texture, in texels
+    static constexpr int TEXTURE_SIZE = 2048;
+
+    ///< Side of the cell of a glyph, in texels
+    static constexpr int CELL_SIZE = 128;
+
+    ///< Side of the cell of a glyph, in glyph units (the size of the text)
+    static constexpr double CELL_EXTENT = 2.0;
+
+    ///< Largest distance to a stroke the texels can hold, in glyph units
+    static constexpr double MAX_DISTANCE = 0.25;
+
+    struct CELL
+    {
+        VECTOR2D m_origin;       ///< Glyph coordinates of the corner of the cell
+        VECTOR2D m_texOrigin;    ///< Texture coordinates of the corner of the cell
+        BOX2D    m_quad;         ///< Area to draw, in glyph coordinates
+    };
+
+    STROKE_GLYPH_ATLAS();
+
+    /**
+     * Return the cell of a font glyph, computing its distance field on first use.
+     *
+     * @return nullptr if the glyph doesn't fit in a cell or the texture is full.
+     */
+    const CELL* GetCell( const KIFONT::STROKE_GLYPH* aGlyph );
+
+    /**
+     * Convert glyph coordinates to texture coordinates for a cell.
+     */
+    static VECTOR2D ToTexture( const CELL& aCell, const VECTOR2D& aPoint )
+    {
+        return aCell.m_texOrigin + ( aPoint - aCell.m_origin ) * ( CELL_SIZE / CELL_EXTENT )
+                                           / (double) TEXTURE_SIZE;
+    }
+
+    /**
+     * @return the texels, one byte each, row by row.
+     */
+    const unsigned char* GetTexels() const { return m_texels.data(); }
+
+    /**
+     * @return the first row and the number of rows changed since the last call to
+     *         ClearDirtyRows(), the number being 0 if none was.
+     */
+    std::pair<int, int> GetDirtyRows() const
+    {
+        return { m_dirtyTop, std::max( m_dirtyBottom - m_dirtyTop, 0 ) };
+    }
+
+    void ClearDirtyRows()
+    {
+        m_dirtyTop = TEXTURE_SIZE;
+        m_dirtyBottom = 0;
+    }
+
+private:
+    ///< Index of the cell of each glyph in m_cells, -1 for glyphs without a cell
+    std::map<const KIFONT::STROKE_GLYPH*, int> m_cellIndex;
+    std::deque<CELL>                           m_cells;     ///< Deque to keep cells in place
+    std::vector<unsigned char>                 m_texels;
+
+    int m_dirtyTop;
+    int m_dirtyBottom;
+};
+
+} // namespace KIGFX
+
+#endif /* STROKE_GLYPH_ATLAS_H */
@@ -146,6 +146,18 @@ public:
         m_dirty = true;
     }
 
+    /**
+     * Set the dirty flag for a range of vertices.  Containers able to update part of the GPU
+     * memory only reupload the changed ranges.
+     *
+     * @param aOffset is the offset of the first changed vertex.
+     * @param aSize is the number of changed vertices.
+     */
+    virtual void SetRangeDirty( unsigned int aOffset, unsigned int aSize )
+    {
+        SetDirty();
+    }
+
     /**
      * Clear the dirty flag to prevent reuploading vertices to the GPU memory.
      */
@@ -347,6 +347,28 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Return the memory reserved by the vertex container, in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+    /**
+     * Return the number of vertices stored in the container.
+     */
+    unsigned int GetVertexCount() const;
+
+    /**
+     * Return the number of times the cache was defragmented, 0 if the manager is not cached.
+     */
+    int GetDefragmentations() const;
+
+    /**
+     * Return the number of draw calls issued since the last call to ResetDrawCalls().
+     */
+    unsigned int GetDrawCalls() const;
+
+    void ResetDrawCalls() const;
+
 protected:
     /**
      * Apply all transformation to the given coordinates and store them at the specified target.
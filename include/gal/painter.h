@@ -96,10 +96,35 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Build ahead of Draw() the data an item needs to be drawn which doesn't depend on the GAL
+     * state, such as polygon triangulations, so that it can be done in parallel when many items
+     * are recached.
+     *
+     * It is called from worker threads for different items at the same time, so it must only
+     * change \a aItem itself.
+     */
+    virtual void PrepareDraw( const VIEW_ITEM* aItem ) {}
+
+    /**
+     * @return true if \a aItem can be drawn with less detail on \a aLayer when zoomed out, in
+     *         which case the view caches its geometry for each detail level it is drawn at.
+     */
+    virtual bool HasDetailLevels( const VIEW_ITEM* aItem, int aLayer ) const { return false; }
+
+    /**
+     * Set the error allowed in the geometry drawn by Draw(), in world units.  0 asks for full
+     * detail, which is the default.
+     */
+    void SetDetailTolerance( double aTolerance ) { m_detailTolerance = aTolerance; }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
     GAL* m_gal;
+
+    /// Error allowed in the drawn geometry, 0 for full detail
+    double m_detailTolerance;
 };
 
 } // namespace KIGFX
@@ -28,6 +28,8 @@
 
 extern const char* const traceHTTPLib;
 
+class ASYNC_IO_SCHEDULER;
+
 
 class HTTP_LIB_CONNECTION
 {
@@ -54,13 +56,27 @@ public:
      * @param aResults will be filled with all parts in that category
      * @return true if the query succeeded and at least one part was found, false otherwise
      */
-    bool SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts );
+    bool SelectAll( const HTTP_LIB_CATEGORY& aCategory, std::vector<HTTP_LIB_PART>& aParts,
+                    ASYNC_IO_SCHEDULER* aIO = nullptr );
+
+    /**
+     * Retrieves the parts of several categories, with the requests in flight concurrently.
+     * @param aCategories are the categories to fetch
+     * @param aParts will be filled with the parts of each category, keyed by category id;
+     *               categories which failed to load are left out
+     * @return true if all categories were retrieved
+     */
+    bool SelectAll( const std::vector<HTTP_LIB_CATEGORY>& aCategories,
+                    std::map<std::string, std::vector<HTTP_LIB_PART>>& aParts );
 
     std::string GetLastError() const { return m_lastError; }
 
-    std::vector<HTTP_LIB_CATEGORY> getCategories() const { return m_categories; }
+    const std::vector<HTTP_LIB_CATEGORY>& getCategories() const { return m_categories; }
 
-    auto getCachedParts() { return m_cache; }
+    const std::map<std::string, std::tuple<std::string, std::string>>& getCachedParts() const
+    {
+        return m_cache;
+    }
 
 private:
 
@@ -82,7 +98,27 @@ private:
 
     bool syncCategories();
 
-    bool checkServerResponse( std::unique_ptr<KICAD_CURL_EASY>& aCurl );
+    /**
+     * Fetch an endpoint, going through the on-disk cache.
+     *
+     * A cached response younger than \a aTimeout seconds is used as is.  Older ones are
+     * revalidated with their ETag, and still used if the server can't be reached.
+     *
+     * @param aEndpoint is the path relative to the root URL
+     * @param aTimeout is the time in seconds a response is considered fresh
+     * @param aResponse will contain the response body
+     * @param aIO if given, the request is made on a worker thread while the other jobs of the
+     *            scheduler run
+     * @return true if aResponse was filled
+     */
+    bool fetch( const std::string& aEndpoint, int aTimeout, std::string& aResponse,
+                ASYNC_IO_SCHEDULER* aIO = nullptr );
+
+    wxString cacheFileName( const std::string& aEndpoint ) const;
+
+    bool parsePart( const nlohmann::json& aPart, HTTP_LIB_PART& aFetchedPart );
+
+    bool checkServerResponse( int aStatusCode );
 
     bool boolFromString( const std::any& aVal, bool aDefaultValue = false );
 
@@ -0,0 +1,106 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INTERNED_STRING_H
+#define INTERNED_STRING_H
+
+#include <cstddef>
+#include <functional>
+
+#include <kicommon.h>
+#include <core/wx_stl_compat.h>
+#include <wx/string.h>
+
+
+/**
+ * An immutable string stored once in a process-wide table.
+ *
+ * Constructing an INTERNED_STRING looks the text up in the table (adding it if needed), so
+ * equal strings always share the same storage.  Copies are a single pointer and equality works
+ * on that pointer, which makes these cheap keys for maps of names that are repeated across many
+ * objects (net names, net class names, ...).
+ *
+ * The hash is the hash of the text, computed once when it is interned.  It doesn't depend on
+ * where the string is stored, so unordered containers keyed on interned strings iterate in the
+ * same order from one run to the next.
+ *
+ * Entries are never removed from the table; only intern names which are bounded by the size
+ * of the designs being edited.  Interning is thread safe.
+ */
+class KICOMMON_API INTERNED_STRING
+{
+public:
+    /**
+     * The empty string.
+     */
+    INTERNED_STRING();
+
+    explicit INTERNED_STRING( const wxString& aString );
+
+    const wxString& Str() const { return m_entry->m_str; }
+
+    operator const wxString&() const { return m_entry->m_str; }
+
+    bool IsEmpty() const { return m_entry->m_str.IsEmpty(); }
+
+    bool operator==( const INTERNED_STRING& aOther ) const { return m_entry == aOther.m_entry; }
+    bool operator!=( const INTERNED_STRING& aOther ) const { return m_entry != aOther.m_entry; }
+
+    /**
+     * Lexical ordering, so that sorted containers iterate in the same order as with wxString
+     * keys.
+     */
+    bool operator<( const INTERNED_STRING& aOther ) const
+    {
+        return m_entry != aOther.m_entry && m_entry->m_str < aOther.m_entry->m_str;
+    }
+
+    size_t Hash() const { return m_entry->m_hash; }
+
+    /**
+     * @return the number of distinct strings in the table.
+     */
+    static size_t GetTableSize();
+
+    /**
+     * An entry of the table: the text and its hash.
+     */
+    struct ENTRY
+    {
+        wxString m_str;
+        size_t   m_hash;
+    };
+
+private:
+    static const ENTRY* intern( const wxString& aString );
+
+    const ENTRY* m_entry;
+};
+
+
+namespace std
+{
+    template <>
+    struct hash<INTERNED_STRING>
+    {
+        size_t operator()( const INTERNED_STRING& aString ) const { return aString.Hash(); }
+    };
+}
+
+#endif // INTERNED_STRING_H
@@ -35,6 +35,7 @@
 
 #include <kicommon.h>
 #include <functional>
+#include <map>
 #include <memory>
 #include <ostream>
 #include <string>
@@ -150,6 +151,14 @@ public:
 
     int GetResponseStatusCode();
 
+    /**
+     * Return the value of a header of the last response, i.e. ETag.
+     *
+     * @param aName is the case insensitive header name, without the colon.
+     * @return the header value, or an empty string if the response had no such header.
+     */
+    std::string GetResponseHeader( const std::string& aName ) const;
+
 private:
     /**
      * Set a curl option, only supports single parameter curl options.
@@ -165,6 +174,9 @@ private:
     curl_slist*                    m_headers;
     std::string                    m_buffer;
     std::unique_ptr<CURL_PROGRESS> progress;
+
+    /// Headers of the last response, keyed by lower case name
+    std::map<std::string, std::string> m_responseHeaders;
 };
 
 
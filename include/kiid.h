@@ -130,6 +130,16 @@ private:
 };
 
 
+namespace std
+{
+    template <>
+    struct hash<KIID>
+    {
+        size_t operator()( const KIID& aId ) const { return aId.Hash(); }
+    };
+}
+
+
 extern KICOMMON_API KIID niluuid;
 
 KICOMMON_API KIID& NilUuid();
@@ -257,6 +257,14 @@ public:
 
     void UpdateScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
                       std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) override;
+
+    /**
+     * Update the score of the library itself from the (already updated) scores of its
+     * children and its own name.  This is the second half of UpdateScore(), split out so
+     * the children can be scored elsewhere (for instance in parallel).
+     */
+    void UpdateOwnScore( EDA_COMBINED_MATCHER* aMatcher, const wxString& aLib,
+                         std::function<bool( LIB_TREE_NODE& aNode )>* aFilter );
 };
 
 
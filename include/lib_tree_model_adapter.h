@@ -143,7 +143,11 @@ public:
      *
      * @param aFilter   if SYM_FILTER_POWER, only power parts are loaded
      */
-    void SetFilter( std::function<bool( LIB_TREE_NODE& aNode )>* aFilter ) { m_filter = aFilter; }
+    void SetFilter( std::function<bool( LIB_TREE_NODE& aNode )>* aFilter )
+    {
+        m_filter = aFilter;
+        invalidateSearchResults();
+    }
 
     /**
      * Return the active filter.
@@ -394,12 +398,24 @@ protected:
 
     void resortTree();
 
+    /**
+     * Forget the results of the last search.  Must be called whenever nodes are added to,
+     * removed from or updated in the tree, so the next search doesn't start from stale matches.
+     */
+    void invalidateSearchResults() { m_lastMatchesValid = false; }
+
 private:
     /**
      * Find and expand successful search results.  Return the best match (if any).
      */
     const LIB_TREE_NODE* ShowResults();
 
+    /**
+     * Score the tree for \a aSearch.  The items are scored in parallel, and when \a aSearch
+     * only narrows the previous search, only the previous matches are scored again.
+     */
+    void updateScores( const wxString& aSearch );
+
     wxDataViewColumn* doAddColumn( const wxString& aHeader, bool aTranslate = true );
 
 protected:
@@ -424,6 +440,10 @@ private:
 
     std::function<bool( LIB_TREE_NODE& aNode )>* m_filter;
 
+    wxString                     m_lastSearch;        // The search m_lastMatches are from
+    std::vector<LIB_TREE_NODE*>  m_lastMatches;       // Items which scored for m_lastSearch
+    bool                         m_lastMatchesValid;
+
     std::vector<wxDataViewColumn*>               m_columns;
     std::map<wxString, wxDataViewColumn*>        m_colNameMap;
     std::map<wxString, int>                      m_colWidths;
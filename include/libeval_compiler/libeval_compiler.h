@@ -26,6 +26,8 @@
 #include <map>
 #include <string>
 #include <stack>
+#include <new>
+#include <type_traits>
 
 #include <base_units.h>
 #include <wx/intl.h>
@@ -296,6 +298,11 @@ public:
     virtual ~VAR_REF() {};
 
     virtual VAR_TYPE_T GetType() const = 0;
+
+    /**
+     * @return the value of the reference, owned by \a aCtx: either from CONTEXT::AllocValue()
+     *         or given to CONTEXT::StoreValue().
+     */
     virtual VALUE* GetValue( CONTEXT* aCtx ) = 0;
 };
 
@@ -305,21 +312,35 @@ class CONTEXT
 public:
     CONTEXT() :
         m_stack(),
-        m_stackPtr( 0 )
+        m_stackPtr( 0 ),
+        m_poolUsed( 0 )
     {
-        m_ownedValues.reserve( 20 );
     }
 
+    CONTEXT( const CONTEXT& ) = delete;
+    CONTEXT& operator=( const CONTEXT& ) = delete;
+
     virtual ~CONTEXT()
     {
+        for( int ii = 0; ii < m_poolUsed; ++ii )
+            reinterpret_cast<VALUE*>( &m_pool[ii] )->~VALUE();
+
         for( VALUE* v : m_ownedValues )
         {
             delete v;
         }
     }
 
+    /**
+     * @return a new value owned by the context.  Values are built in storage preallocated
+     *         with the context, as rules are evaluated millions of times in a DRC run; only
+     *         long expressions need more values than it holds.
+     */
     VALUE* AllocValue()
     {
+        if( m_poolUsed < VALUE_POOL_SIZE )
+            return new( &m_pool[m_poolUsed++] ) VALUE();
+
         m_ownedValues.emplace_back( new VALUE );
         return m_ownedValues.back();
     }
@@ -361,10 +382,15 @@ public:
     void ReportError( const wxString& aErrorMsg );
 
 private:
+    static constexpr int VALUE_POOL_SIZE = 16;
+
     std::vector<VALUE*> m_ownedValues;
     VALUE*              m_stack[100];       // std::stack not performant enough
     int                 m_stackPtr;
 
+    std::aligned_storage_t<sizeof( VALUE ), alignof( VALUE )> m_pool[VALUE_POOL_SIZE];
+    int                                                       m_poolUsed;
+
     std::function<void( const wxString& aMessage, int aOffset )> m_errorCallback;
 };
 
@@ -374,10 +400,11 @@ class UCODE
 public:
     virtual ~UCODE();
 
-    void AddOp( UOP* uop )
-    {
-        m_ucode.push_back(uop);
-    }
+    /**
+     * Append \a uop, taking ownership of it.  An operator applied to numeric constants is
+     * replaced by the constant it evaluates to.
+     */
+    void AddOp( UOP* uop );
 
     VALUE* Run( CONTEXT* ctx );
     wxString Dump() const;
@@ -426,6 +453,11 @@ public:
 
     void Exec( CONTEXT* ctx );
 
+    int GetOp() const { return m_op; }
+
+    ///< The value pushed by a TR_UOP_PUSH_VALUE op, or nullptr
+    const VALUE* GetValue() const { return m_value.get(); }
+
     wxString Format() const;
 
 private:
@@ -0,0 +1,77 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include <cstddef>
+#include <vector>
+
+#include <wx/string.h>
+
+
+/**
+ * A breakdown of the memory held by an editor, by category.
+ *
+ * Producers call Add() for everything they own; the numbers are estimates computed from the
+ * element counts and capacities of the underlying containers, not measurements from the heap,
+ * so allocator overhead and fragmentation are not included.
+ */
+class MEMORY_REPORT
+{
+public:
+    struct ENTRY
+    {
+        wxString m_category;
+        size_t   m_count;   ///< Number of objects in the category
+        size_t   m_bytes;   ///< Estimated bytes held by these objects
+    };
+
+    /**
+     * Add \a aCount objects using \a aBytes to \a aCategory.  Repeated calls for the same
+     * category accumulate.
+     */
+    void Add( const wxString& aCategory, size_t aCount, size_t aBytes );
+
+    const std::vector<ENTRY>& GetEntries() const { return m_entries; }
+
+    size_t GetTotalBytes() const;
+
+    /**
+     * @return the report as a JSON document:
+     *         { "total_bytes": N, "categories": [ { "category": ..., "count": ...,
+     *           "bytes": ... }, ... ] }
+     */
+    wxString FormatJson() const;
+
+    /**
+     * @return the report as an HTML table, largest categories first.
+     */
+    wxString FormatHtml() const;
+
+    /**
+     * @return a human readable size, e.g. "12.3 MB".
+     */
+    static wxString FormatBytes( size_t aBytes );
+
+private:
+    std::vector<ENTRY> m_entries;
+};
+
+#endif // MEMORY_REPORT_H
@@ -37,6 +37,8 @@
 #include <pcb_draw_panel_gal.h>
 #include <pcb_origin_transforms.h>
 #include <pcb_screen.h>
+#include <map>
+#include <memory>
 #include <vector>
 
 #include <wx/fswatcher.h>
@@ -101,6 +103,19 @@ public:
      */
     FOOTPRINT* LoadFootprint( const LIB_ID& aFootprintId );
 
+    /**
+     * Load several footprints from the footprint library table at once.
+     *
+     * Duplicate ids are loaded only once.  Libraries are read concurrently (each library
+     * table row owns its own plugin, so footprints of a single library are read in turn).
+     *
+     * @param aFootprintIds is the list of #LIB_ID to load.
+     * @return a map from each requested #LIB_ID to the loaded #FOOTPRINT, or to nullptr if
+     *         it could not be found or read.
+     */
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>>
+    LoadLibraryFootprints( const std::vector<LIB_ID>& aFootprintIds );
+
     /**
      * Calculate the bounding box containing all board items (or board edge segments).
      *
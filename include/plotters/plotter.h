@@ -525,6 +525,12 @@ public:
         // NOP for most plotters. Only for SVG plotter
     }
 
+    /// Enable the smaller output of the SVG plotter, with merged paths and reused shapes
+    virtual void SetSvgCompactOutput( bool aCompact )
+    {
+        // NOP for most plotters. Only for SVG plotter
+    }
+
     /**
      * calling this function allows one to define the beginning of a group
      * of drawing items, for instance in SVG  or Gerber format.
@@ -543,6 +549,20 @@ public:
      */
     virtual void EndBlock( void* aData ) {}
 
+    /**
+     * Start a group of items which can be repeated elsewhere in the plot, such as the graphics
+     * of a footprint.  Plotters able to reference a group write identical groups once.
+     *
+     * @param aAnchor is the position the items of the group are relative to.
+     * @param aName is a name to derive the name of the group from in the output.
+     */
+    virtual void StartReusableGroup( const VECTOR2I& aAnchor, const wxString& aName ) {}
+
+    /**
+     * End the group of items started by StartReusableGroup().
+     */
+    virtual void EndReusableGroup() {}
+
 
 protected:
     /**
@@ -20,6 +20,9 @@
 #pragma once
 
 #include "plotter.h"
+#include <richio.h>
+
+#include <unordered_map>
 
 
 class DXF_PLOTTER : public PLOTTER
@@ -33,6 +36,8 @@ public:
         SetUnits( DXF_UNITS::INCHES );
     }
 
+    ~DXF_PLOTTER();
+
     virtual PLOT_FORMAT GetPlotterType() const override
     {
         return PLOT_FORMAT::DXF;
@@ -58,6 +63,13 @@ public:
     virtual bool StartPlot( const wxString& aPageNumber ) override;
     virtual bool EndPlot() override;
 
+    /**
+     * Identical groups are written once as a block of the BLOCKS section, and each group is
+     * replaced by an INSERT of its block.
+     */
+    virtual void StartReusableGroup( const VECTOR2I& aAnchor, const wxString& aName ) override;
+    virtual void EndReusableGroup() override;
+
     // For now we don't use 'thick' primitives, so no line width
     virtual void SetCurrentLineWidth( int width, void* aData = nullptr ) override
     {
@@ -214,6 +226,15 @@ protected:
     void plotOneLineOfText( const VECTOR2I& aPos, const COLOR4D& aColor, const wxString& aText,
                             const TEXT_ATTRIBUTES& aAttrs );
 
+    /**
+     * @return the formatter of the entities: the group being recorded, if any, or the ENTITIES
+     *         section, as it is written after the BLOCKS section.
+     */
+    OUTPUTFORMATTER& out();
+
+    /// Move the buffered entities to the temporary file of the ENTITIES section
+    void flushEntities();
+
     bool         m_textAsLines;
     COLOR4D      m_currentColor;
     LINE_STYLE   m_currentLineType;
@@ -221,4 +242,17 @@ protected:
     DXF_UNITS    m_plotUnits;
     double       m_unitScalingFactor;
     unsigned int m_measurementDirective;
+
+    STRING_FORMATTER m_entities;                 ///< Entities not flushed yet
+    FILE*            m_entitiesFile = nullptr;   ///< Temporary file of the flushed entities
+    STRING_FORMATTER m_blocks;                   ///< Contents of the BLOCKS section
+
+    STRING_FORMATTER m_group;                    ///< Entities of the group being recorded
+    int              m_groupDepth = 0;           ///< Only the outer groups are recorded
+    VECTOR2I         m_groupAnchor;
+    wxString         m_groupName;
+    VECTOR2I         m_savedPlotOffset;
+
+    ///< Name of the block of each group contents
+    std::unordered_map<std::string, std::string> m_blockNames;
 };
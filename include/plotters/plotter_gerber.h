@@ -20,6 +20,9 @@
 
 #pragma once
 
+#include <unordered_map>
+#include <vector>
+
 #include "plotter.h"
 #include "gbr_plotter_apertures.h"
 
@@ -31,6 +34,8 @@ class GERBER_PLOTTER : public PLOTTER
 public:
     GERBER_PLOTTER();
 
+    ~GERBER_PLOTTER();
+
     virtual PLOT_FORMAT GetPlotterType() const override
     {
         return PLOT_FORMAT::GERBER;
@@ -331,6 +336,12 @@ protected:
      */
     void emitDcode( const VECTOR2D& pt, int dcode );
 
+    /**
+     * Emit the end point and the center, relative to the start point, of a circular
+     * interpolation: "X<x>Y<y>I<i>J<j>D01*".
+     */
+    void emitArcEnd( const VECTOR2D& aEnd, const VECTOR2D& aRelCenter );
+
     /**
      * Print a Gerber net attribute object record.
      *
@@ -365,6 +376,10 @@ protected:
     FILE* finalFile;
     wxString m_workFilename;
 
+    /// Large stdio buffer of the work file: Gerber files of large copper pours hold millions of
+    /// short coordinate lines
+    std::vector<char> m_workFileBuffer;
+
     /**
      * Generate the table of D codes
      */
@@ -372,6 +387,11 @@ protected:
 
     std::vector<APERTURE> m_apertures;  // The list of available apertures
     int     m_currentApertureIdx;       // The index of the current aperture in m_apertures
+
+    /// Indices in m_apertures of the apertures having the same hash of their type, size,
+    /// rotation and attribute.  Polygonal apertures are matched with a small tolerance, so
+    /// only their corner count is hashed, not their corners.
+    std::unordered_map<size_t, std::vector<int>> m_apertureIndex;
     bool    m_hasApertureRoundRect;     // true is at least one round rect aperture is in use
     bool    m_hasApertureRotOval;       // true is at least one oval rotated aperture is in use
     bool    m_hasApertureRotRect;       // true is at least one rect. rotated aperture is in use
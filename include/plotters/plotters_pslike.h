@@ -25,6 +25,11 @@
 
 #pragma once
 
+#include <functional>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
 #include "plotter.h"
 
 
@@ -465,6 +470,11 @@ protected:
      */
     void closePdfStream();
 
+    /**
+     * Write the XObject of an image (and of its soft mask, if it has transparency).
+     */
+    void emitImage( int aHandle, const wxImage& aImage );
+
     /**
      * Starts emitting the outline object
      */
@@ -508,7 +518,12 @@ protected:
 
     std::map<wxString, std::vector<std::pair<BOX2I, wxString>>>      m_bookmarksInPage;
 
-    std::map<int, wxImage> m_imageHandles;
+    std::vector<int>                m_imageHandles;     ///< Handles of all the image XObjects
+    std::unordered_map<size_t, int> m_imageHashes;      ///< Image handles by content hash
+
+    /// Images first used on the current page.  They are written with the page, so that a
+    /// many pages plot doesn't keep all its images until the end.
+    std::map<int, wxImage>          m_pageImages;
 
     std::unique_ptr<OUTLINE_NODE> m_outlineRoot;    ///< Root outline node
     int                           m_totalOutlineNodes;  ///< Total number of outline nodes
@@ -584,6 +599,24 @@ public:
      */
     virtual void SetSvgCoordinatesFormat( unsigned aPrecision ) override;
 
+    /**
+     * Write a compact file: contiguous strokes of the same style are merged into single paths,
+     * repeated filled pads and vias reuse the first one drawn, and coordinates are integers in
+     * 10^-precision mm, scaled back by the viewBox.
+     *
+     * Should be called before StartPlot().
+     */
+    virtual void SetSvgCompactOutput( bool aCompact ) override;
+
+    virtual void FlashPadCircle( const VECTOR2I& aPadPos, int aDiameter,
+                                 OUTLINE_MODE aTraceMode, void* aData ) override;
+    virtual void FlashPadRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                               const EDA_ANGLE& aPadOrient, OUTLINE_MODE aTraceMode,
+                               void* aData ) override;
+    virtual void FlashPadRoundRect( const VECTOR2I& aPadPos, const VECTOR2I& aSize,
+                                    int aCornerRadius, const EDA_ANGLE& aOrient,
+                                    OUTLINE_MODE aTraceMode, void* aData ) override;
+
     /**
      * Calling this function allows one to define the beginning of a group
      * of drawing items (used in SVG format to separate components)
@@ -643,6 +676,20 @@ protected:
      */
     void setFillMode( FILL_T fill );
 
+    /**
+     * Close the path left open by PenTo() in compact mode, so that other elements can be written.
+     */
+    void closePendingPath();
+
+    /**
+     * Draw a filled pad shape in compact mode, or reuse the same shape drawn earlier.
+     *
+     * @param aKind, aSize, aRadius and aOrient identify the shape.
+     * @param aPlot draws the shape at \a aPos the first time.
+     */
+    void flashShape( int aKind, const VECTOR2I& aSize, int aRadius, const EDA_ANGLE& aOrient,
+                     const VECTOR2I& aPos, const std::function<void()>& aPlot );
+
     FILL_T     m_fillMode;          // true if the current contour rect, arc, circle, polygon must
                                     // be filled
     long       m_pen_rgb_color;     // current rgb color value: each color has a value 0 ... 255,
@@ -657,4 +704,12 @@ protected:
                                     // Use 3-6 (3 means um precision, 6 nm precision) in PcbNew
                                     // 3-4 in other modules (avoid values >4 to avoid overflow)
                                     // see also comment for m_useInch.
+                                    // 0 in compact mode, the device unit being scaled instead
+    bool       m_compact;           // true to merge paths, reuse pad shapes and use integers
+    bool       m_pathPending;       // true if a path ended by PenTo() is still open (compact mode)
+
+    /// Filled pad shapes drawn in compact mode, with the number and the position (in device
+    /// units) of the first one drawn.  Keyed by kind, size, radius, orientation and color.
+    std::map<std::tuple<int, int, int, int, double, long, double>, std::pair<int, VECTOR2D>>
+               m_flashedShapes;
 };
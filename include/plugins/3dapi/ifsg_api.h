@@ -83,6 +83,19 @@ namespace S3D
     SGLIB_API SGNODE* ReadCache( const char* aFileName, void* aPluginMgr,
         bool (*aTagCheck)( const char*, void* ) );
 
+    /**
+     * Function ReadCache
+     * creates an SGNODE tree from the contents of a binary cache file already in memory,
+     * for example a file mapped in memory
+     *
+     * @param aData is the contents of the cache file
+     * @param aSize is the size of the contents, in bytes
+     * @param aName is the name of the cache file, for the error messages
+     * @return NULL on failure, on success a pointer to the top level SCENEGRAPH node.
+     */
+    SGLIB_API SGNODE* ReadCache( const char* aData, size_t aSize, const char* aName,
+        void* aPluginMgr, bool (*aTagCheck)( const char*, void* ) );
+
     /**
      * Function WriteVRML
      * writes out the given node and its subnodes to a VRML2 file
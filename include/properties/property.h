@@ -328,6 +328,24 @@ PROPERTY_BASE( const wxString& aName, PROPERTY_DISPLAY aDisplay = PT_DEFAULT,
         return std::nullopt;
     }
 
+    /**
+     * Read an int, bool or enum property without the wxAny conversions of get(), for code
+     * reading the property of many objects such as the rule evaluator.
+     *
+     * @param aObject is the object, already cast to the owner type of the property.
+     * @return false if the property isn't an int, bool or enum.
+     */
+    virtual bool GetInt( const void* aObject, int& aValue ) const { return false; }
+
+    /**
+     * Read a wxString property, or the name of an enum value, without the wxAny conversions
+     * of get().
+     *
+     * @param aObject is the object, already cast to the owner type of the property.
+     * @return false if the property isn't a wxString or an enum.
+     */
+    virtual bool GetString( const void* aObject, wxString& aValue ) const { return false; }
+
 protected:
     template<typename T>
     void set( void* aObject, T aValue )
@@ -462,6 +480,39 @@ public:
         return m_setter && PROPERTY_BASE::Writeable( aObject );
     }
 
+    bool GetInt( const void* obj, int& aValue ) const override
+    {
+        if constexpr( std::is_same_v<BASE_TYPE, int> || std::is_same_v<BASE_TYPE, bool>
+                      || std::is_enum_v<BASE_TYPE> )
+        {
+            aValue = static_cast<int>( (*m_getter)( reinterpret_cast<const Owner*>( obj ) ) );
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    bool GetString( const void* obj, wxString& aValue ) const override
+    {
+        if constexpr( std::is_same_v<BASE_TYPE, wxString> )
+        {
+            aValue = (*m_getter)( reinterpret_cast<const Owner*>( obj ) );
+            return true;
+        }
+        else if constexpr( std::is_enum_v<BASE_TYPE> )
+        {
+            BASE_TYPE value = (*m_getter)( reinterpret_cast<const Owner*>( obj ) );
+            aValue = ENUM_MAP<BASE_TYPE>::Instance().ToString( value );
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
 protected:
     PROPERTY( const wxString& aName, SETTER_BASE<Owner, T>* s, GETTER_BASE<Owner, T>* g,
               PROPERTY_DISPLAY aDisplay, ORIGIN_TRANSFORMS::COORD_TYPES_T aCoordType )
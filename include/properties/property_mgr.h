@@ -142,6 +142,15 @@ public:
      */
     const void* TypeCast( const void* aSource, TYPE_ID aBase, TYPE_ID aTarget ) const;
 
+    /**
+     * Return the converter TypeCast() uses between two types, for code casting many objects
+     * of the same type.
+     *
+     * @return the converter registered with AddTypeCast(), or nullptr if objects of type
+     *         \a aBase can be used as \a aTarget as they are (or can't be used at all).
+     */
+    const TYPE_CAST_BASE* GetTypeCast( TYPE_ID aBase, TYPE_ID aTarget ) const;
+
     void* TypeCast( void* aSource, TYPE_ID aBase, TYPE_ID aTarget ) const
     {
         return const_cast<void*>( TypeCast( (const void*) aSource, aBase, aTarget ) );
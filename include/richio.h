@@ -29,8 +29,13 @@
 // "richio" after its author, Richard Hollenbeck, aka Dick Hollenbeck.
 
 
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <string>
 #include <vector>
 #include <core/utf8.h>
+#include <fmt/core.h>
 
 // I really did not want to be dependent on wxWidgets in richio
 // but the errorText needs to be wide char so wxString rules.
@@ -41,6 +46,14 @@
 #include <ki_exception.h>
 #include <kicommon.h>
 
+namespace KIPLATFORM
+{
+namespace IO
+{
+    struct MAPPED_FILE;
+}
+}
+
 /**
  * This is like sprintf() but the output is appended to a std::string instead of to a
  * character array.
@@ -246,6 +259,54 @@ protected:
 };
 
 
+/**
+ * A #LINE_READER that reads from a file mapped in memory.
+ *
+ * Lines are found with memchr() and copied into the line buffer in one go, instead of through
+ * stdio one character at a time, which is what loading large boards and schematics spends its
+ * time on with a #FILE_LINE_READER.  Lines end with '\n' only, a '\r' before it is kept like
+ * any other character and is whitespace to DSNLEXER.
+ */
+class KICOMMON_API MAPPED_FILE_LINE_READER : public LINE_READER
+{
+public:
+    /**
+     * Map @a aFileName in memory.
+     *
+     * @param aFileName is the name of the file to map and to use for error reporting purposes.
+     * @param aMaxLineLength is the maximum length of a line.
+     *
+     * @throw IO_ERROR if @a aFileName cannot be opened or mapped.
+     */
+    MAPPED_FILE_LINE_READER( const wxString& aFileName,
+                             unsigned aMaxLineLength = LINE_READER_LINE_DEFAULT_MAX );
+
+    ~MAPPED_FILE_LINE_READER();
+
+    char* ReadLine() override;
+
+    /**
+     * Go back to the beginning of the file and reset the line number to zero.
+     */
+    void Rewind()
+    {
+        m_pos = 0;
+        m_lineNum = 0;
+    }
+
+    /**
+     * @return the number of lines in the file, without reading them.
+     */
+    size_t LineCount() const;
+
+    size_t FileLength() const;
+
+protected:
+    std::unique_ptr<KIPLATFORM::IO::MAPPED_FILE> m_file;
+    size_t                                       m_pos;    ///< offset of the next line
+};
+
+
 /**
  * Is a #LINE_READER that reads from a multiline 8 bit wide std::string
  */
@@ -375,6 +436,29 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Format and write text to the output stream, like Print() but with a fmt::format() style
+     * format string.  The arguments are checked against the format at compile time, and
+     * formatted in a single pass without a printf() parse, which makes it the better choice
+     * for the bulk of file output.
+     *
+     * @param aNestLevel The multiple of spaces to precede the output with.
+     * @param aFormat A fmt::format() style format string.
+     * @return the number of characters output.
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    template <typename... Args>
+    int PrintFmt( int aNestLevel, fmt::format_string<Args...> aFormat, Args&&... aArgs )
+    {
+        m_fmtBuffer.assign( (size_t) std::max( aNestLevel, 0 ) * NESTWIDTH, ' ' );
+        fmt::format_to( std::back_inserter( m_fmtBuffer ), aFormat,
+                        std::forward<Args>( aArgs )... );
+
+        write( m_fmtBuffer.data(), (int) m_fmtBuffer.size() );
+
+        return (int) m_fmtBuffer.size();
+    }
+
     /**
      * Perform quote character need determination.
      *
@@ -415,10 +499,12 @@ public:
     virtual bool Finish() { return true; }
 
 private:
+    static constexpr int NESTWIDTH = 2;     ///< how many spaces per nestLevel
+
     std::vector<char>   m_buffer;
+    std::string         m_fmtBuffer;        ///< for PrintFmt()
     char                quoteChar[2];
 
-    int sprint( const char* fmt, ... );
     int vprint( const char* fmt, va_list ap );
 
 };
@@ -27,6 +27,7 @@
 #include <wx/string.h>
 
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <nlohmann/json_fwd.hpp>
 
@@ -56,6 +57,19 @@ enum class SETTINGS_LOC {
 /// pimpl to allow hiding json.hpp
 class JSON_SETTINGS_INTERNALS;
 
+/**
+ * The serialized contents of a settings file, ready to be written out with
+ * JSON_SETTINGS::WriteToFile().
+ */
+struct JSON_SETTINGS_WRITE
+{
+    wxString    m_path;
+    std::string m_contents;
+
+    /// Order in which the contents were serialized; stale contents are never written
+    size_t      m_generation = 0;
+};
+
 class JSON_SETTINGS
 {
 public:
@@ -120,6 +134,25 @@ c     * @return true if the file was saved
      */
     virtual bool SaveToFile( const wxString& aDirectory = "", bool aForce = false );
 
+    /**
+     * Does everything SaveToFile() does except for the actual write: the contents which would
+     * have been written are returned in \a aWrite instead.
+     *
+     * @return true if there is something to write
+     */
+    bool PrepareSave( JSON_SETTINGS_WRITE& aWrite, const wxString& aDirectory = "",
+                      bool aForce = false );
+
+    /**
+     * Writes contents serialized by PrepareSave() to disk.  Safe to call from any thread.
+     *
+     * Nothing is written if more recent contents have already been written, or if the file
+     * still holds exactly these contents from the last write.
+     *
+     * @return true if the file was written
+     */
+    bool WriteToFile( const JSON_SETTINGS_WRITE& aWrite );
+
     /**
      * Resets all parameters to default values.  Does NOT write to file or update underlying JSON.
      */
@@ -336,6 +369,20 @@ protected:
     std::map<int, std::pair<int, std::function<bool()>>> m_migrators;
 
     std::unique_ptr<JSON_SETTINGS_INTERNALS> m_internals;
+
+private:
+    /// Where SaveToFile() hands its contents over to when called from PrepareSave()
+    JSON_SETTINGS_WRITE* m_preparedWrite;
+
+    /// Generation of the most recently serialized contents
+    size_t               m_saveGeneration;
+
+    /// Guards the members below, which are used by WriteToFile()
+    std::mutex           m_writeMutex;
+    size_t               m_writtenGeneration;
+    wxString             m_lastWrittenPath;
+    size_t               m_lastWrittenHash;
+    long long            m_lastWrittenModTime;
 };
 
 // Specializations to allow conversion between wxString and std::string via JSON_SETTINGS API
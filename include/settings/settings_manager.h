@@ -22,6 +22,9 @@
 #define _SETTINGS_MANAGER_H
 
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <map>
 #include <mutex>
 #include <typeinfo>
 #include <core/wx_stl_compat.h> // for wxString hash
@@ -34,6 +37,7 @@ class PROJECT;
 class PROJECT_FILE;
 class REPORTER;
 class wxSingleInstanceChecker;
+class wxTimer;
 class LOCKFILE;
 
 
@@ -79,6 +83,24 @@ public:
 
     void Save( JSON_SETTINGS* aSettings );
 
+    /**
+     * Save \a aSettings a little later rather than right away.
+     *
+     * Further requests for the same settings made before then are coalesced into a single
+     * save, and the file itself is written by a background thread.  Use this for settings
+     * which change often, so that each change doesn't stall the UI on the disk.
+     *
+     * @param aSettings is the settings object to save; it must outlive the save
+     * @param aDirectory is the directory to save to, or empty to use GetPathForSettingsFile()
+     */
+    void SaveDeferred( JSON_SETTINGS* aSettings, const wxString& aDirectory = wxEmptyString );
+
+    /**
+     * Save any settings still waiting on a deferred save, and wait until all deferred saves
+     * have been written to disk.
+     */
+    void FlushDeferredSaves();
+
     /**
      * If the given settings object is registered, save it to disk and unregister it
      * @param aSettings is the object to release
@@ -138,6 +160,8 @@ public:
 
     std::vector<COLOR_SETTINGS*> GetColorSettingsList()
     {
+        ensureColorSettingsLoaded();
+
         std::vector<COLOR_SETTINGS*> ret;
 
         for( const std::pair<const wxString, COLOR_SETTINGS*>& entry : m_color_settings )
@@ -224,6 +248,9 @@ public:
 
     /**
      * Re-scans the color themes directory, reloading any changes it finds.
+     *
+     * The themes are only read when one of them is first needed, so that applications which
+     * don't show any color don't pay for parsing them all at startup.
      */
     void ReloadColorSettings();
 
@@ -370,6 +397,11 @@ private:
 
     void loadAllColorSettings();
 
+    /**
+     * Load the color themes if they haven't been since the last ReloadColorSettings().
+     */
+    void ensureColorSettingsLoaded();
+
     /**
      * Registers a PROJECT_FILE and attempts to load it from disk
      * @param aProject is the project object to load the file for
@@ -388,6 +420,12 @@ private:
     // Helper to create built-in colors and register them
     void registerBuiltinColorSettings();
 
+    /**
+     * Serialize the settings waiting on a deferred save, and hand them over to a background
+     * thread for writing.
+     */
+    void writeDeferredSaves();
+
 private:
 
     /// True if running outside a UI context
@@ -400,6 +438,10 @@ private:
 
     std::unordered_map<wxString, COLOR_SETTINGS*> m_color_settings;
 
+    /// The color themes are loaded on first use
+    std::atomic<bool> m_colorSettingsLoaded;
+    std::mutex        m_colorSettingsMutex;
+
     /// Cache for app settings
     std::unordered_map<size_t, JSON_SETTINGS*> m_app_settings_cache;
 
@@ -426,6 +468,15 @@ private:
     /// Lock for loaded project (expand to multiple once we support MDI)
     std::unique_ptr<LOCKFILE> m_project_lock;
 
+    /// Settings waiting on a deferred save, and the directory to save them to
+    std::map<JSON_SETTINGS*, wxString> m_deferredSaves;
+
+    /// Fires when the deferred saves are due (created on first use)
+    std::unique_ptr<wxTimer>           m_deferredSaveTimer;
+
+    /// Background writing of the last batch of deferred saves
+    std::future<void>                  m_deferredWrites;
+
     static wxString backupDateTimeFormat;
 };
 
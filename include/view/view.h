@@ -29,11 +29,14 @@
 
 #include <gal/gal.h>
 #include <vector>
+#include <map>
 #include <set>
 #include <unordered_map>
 #include <memory>
+#include <optional>
 
 #include <math/box2.h>
+#include <math/matrix3x3.h>
 #include <gal/definitions.h>
 
 #include <view/view_overlay.h>
@@ -104,6 +107,15 @@ public:
      */
     virtual void Remove( VIEW_ITEM* aItem );
 
+    /**
+     * Remove a number of #VIEW_ITEMs from the view.
+     *
+     * Equivalent to calling Remove() for each item, but the list of all the items is only
+     * walked once rather than once per item.
+     *
+     * @param aItems: items to be removed. Caller must dispose the removed items if necessary
+     */
+    virtual void RemoveItems( const std::vector<VIEW_ITEM*>& aItems );
 
     /**
      * Find all visible items that touch or are within the rectangle \a aRect.
@@ -176,12 +188,6 @@ public:
      */
     void CopySettings( const VIEW* aOtherView );
 
-    /*
-     *  Convenience wrappers for adding multiple items
-     *  template <class T> void AddItems( const T& aItems );
-     *  template <class T> void RemoveItems( const T& aItems );
-     */
-
     /**
      * Assign a rendering device for the VIEW.
      *
@@ -522,7 +528,7 @@ public:
      *
      * @see RENDER_SETTINGS
      */
-    void UpdateAllLayersColor();
+    virtual void UpdateAllLayersColor();
 
     /**
      * Set given layer to be displayed on the top or sets back the default order of layers.
@@ -569,6 +575,21 @@ public:
      */
     virtual void Redraw();
 
+    /// Counters of a redraw, to diagnose slow rendering.
+    struct REDRAW_STATISTICS
+    {
+        double             m_redrawTime = 0.0;   ///< Duration of the redraw, in ms
+        int                m_drawnItems = 0;     ///< Items drawn, once per layer
+        int                m_cacheHits = 0;      ///< Items drawn from their cached group
+        int                m_cacheMisses = 0;    ///< Items cached during the redraw
+        std::map<int, int> m_layerItems;         ///< Items drawn on each layer
+    };
+
+    /**
+     * @return the counters of the last call to Redraw().
+     */
+    const REDRAW_STATISTICS& GetRedrawStatistics() const { return m_redrawStatistics; }
+
     /**
      * Rebuild GAL display lists.
      */
@@ -620,6 +641,12 @@ public:
     {
         wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
         m_dirtyTargets[aTarget] = true;
+
+        if( aTarget != TARGET_OVERLAY )
+        {
+            m_dirtyArea.reset();
+            m_panned = false;
+        }
     }
 
     /// Return true if the layer is cached.
@@ -644,6 +671,9 @@ public:
     {
         for( int i = 0; i < TARGETS_NUMBER; ++i )
             m_dirtyTargets[i] = true;
+
+        m_dirtyArea.reset();
+        m_panned = false;
     }
 
     /**
@@ -653,8 +683,25 @@ public:
     {
         for( int i = 0; i < TARGETS_NUMBER; ++i )
             m_dirtyTargets[i] = false;
+
+        m_dirtyArea.reset();
+        m_panned = false;
     }
 
+    /**
+     * Redraw only the area of the changed items when the GAL can keep the rest of the cached
+     * and noncached targets, rather than the whole screen.  Items must not be drawn outside of
+     * their bounding boxes for it to work.
+     */
+    void UsePartialRedraw( bool aEnable ) { m_partialRedraw = aEnable; }
+
+    /**
+     * After panning, move the cached and noncached targets and redraw only the uncovered area
+     * when the GAL can do so, rather than the whole screen.  Items must be drawn the same way
+     * wherever the viewport is for it to work.
+     */
+    void UseScrollRedraw( bool aEnable ) { m_scrollRedraw = aEnable; }
+
     /**
      * Iterate through the list of items that asked for updating and updates them.
      */
@@ -725,9 +772,22 @@ public:
      */
     std::unique_ptr<VIEW> DataReference() const;
 
+    /**
+     * Set the world size of a screen pixel up to which items are drawn at full detail.  When
+     * zoomed out further, the items which support it (see PAINTER::HasDetailLevels()) are drawn
+     * with coarser geometry, cached once for each detail level.  0 (the default) disables it.
+     */
+    void SetDetailPixelSize( double aSize );
+
     ///< Maximum number of layers that may be shown
     static constexpr int VIEW_MAX_LAYERS = 512;
 
+    ///< Number of detail levels, the first one being full detail
+    static constexpr int DETAIL_LEVELS = 3;
+
+    ///< Ratio between the pixel sizes at which successive detail levels begin
+    static constexpr double DETAIL_LEVEL_RATIO = 8.0;
+
     ///< Rendering order modifier for layers that are marked as top layers.
     static constexpr int TOP_LAYER_MODIFIER = -VIEW_MAX_LAYERS;
 
@@ -811,12 +871,44 @@ protected:
     ///< Update all information needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
+    ///< Cache the geometry of an item at the current detail level, if it has detail levels
+    void updateItemDetail( VIEW_ITEM* aItem, int aLayer );
+
+    ///< Return the detail level for the current zoom, 0 being full detail
+    int detailLevel() const;
+
+    ///< Return the error allowed in the geometry drawn at a detail level
+    double detailTolerance( int aLevel ) const;
+
+    ///< Let the painter prepare items to be drawn again, in parallel
+    void prepareItems( const std::vector<VIEW_ITEM*>& aItems );
+
+    /**
+     * Mark a target dirty in the area of an item only, so that if nothing else changes the rest
+     * of the target can be kept.
+     */
+    void markAreaDirty( int aTarget, const BOX2I& aArea );
+
+    ///< Return the world area shown on the screen
+    BOX2I visibleArea() const;
+
+    /**
+     * Move the contents of the cached and noncached targets after a pan and set the areas left
+     * to redraw.
+     *
+     * @return false if the targets have to be redrawn entirely.
+     */
+    bool scrollTargets();
+
     ///< Update bounding box of an item
     void updateBbox( VIEW_ITEM* aItem );
 
     ///< Update set of layers that an item occupies
     void updateLayers( VIEW_ITEM* aItem );
 
+    ///< Remove an item from its layers and drop its cached graphics
+    void removeFromLayers( VIEW_ITEM* aItem );
+
     ///< Determine rendering order of layers. Used in display order sorting function.
     static bool compareRenderingOrder( VIEW_LAYER* aI, VIEW_LAYER* aJ )
     {
@@ -883,6 +975,33 @@ protected:
 
     ///< Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
+
+    ///< World size of a pixel up to which items are drawn at full detail, 0 to always do so.
+    double m_detailPixelSize;
+
+    ///< Detail level of the current redraw.
+    int m_detailLevel;
+
+    ///< Flag to redraw only the area of the changed items when possible.
+    bool m_partialRedraw;
+
+    ///< Area where the cached and noncached targets are dirty, if they are not entirely.
+    std::optional<BOX2I> m_dirtyArea;
+
+    ///< Flag to move the targets and redraw only the uncovered area after panning.
+    bool m_scrollRedraw;
+
+    ///< Is panning the only change of the cached and noncached targets since the last redraw?
+    bool m_panned;
+
+    ///< World to screen transform of the last redraw.
+    std::optional<MATRIX3x3D> m_drawnWorldScreenMatrix;
+
+    ///< Areas of the cached and noncached targets cleared for the next redraw, if not entire.
+    std::vector<BOX2I> m_redrawAreas;
+
+    ///< Counters of the last redraw.
+    REDRAW_STATISTICS m_redrawStatistics;
 };
 } // namespace KIGFX
 
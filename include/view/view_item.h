@@ -55,6 +55,7 @@ enum VIEW_UPDATE_FLAGS {
     LAYERS      = 0x08,     ///< Layers have changed.
     INITIAL_ADD = 0x10,     ///< Item is being added to the view.
     REPAINT     = 0x20,     ///< Item needs to be redrawn.
+    DETAIL      = 0x40,     ///< Item needs to be cached at the current detail level.
     ALL         = 0xef      ///< All except INITIAL_ADD.
 };
 
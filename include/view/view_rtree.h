@@ -59,12 +59,23 @@ public:
      * Remove an item from the tree.
      *
      * Removal is done by comparing pointers, attempting to remove a copy of the item will fail.
+     *
+     * @param aBBox is the bounding box the item was inserted with, if known.  It limits the
+     *              search to the nodes which can hold the item; the whole tree is searched
+     *              otherwise.
      */
-    void Remove( VIEW_ITEM* aItem )
+    void Remove( VIEW_ITEM* aItem, const BOX2I* aBBox = nullptr )
     {
-        // const BOX2I&    bbox    = aItem->ViewBBox();
+        if( aBBox )
+        {
+            const int bmin[2] = { aBBox->GetX(), aBBox->GetY() };
+            const int bmax[2] = { aBBox->GetRight(), aBBox->GetBottom() };
+
+            // Returns true when the item was not found
+            if( !VIEW_RTREE_BASE::Remove( bmin, bmax, aItem ) )
+                return;
+        }
 
-        // FIXME: use cached bbox or ptr_map to speed up pointer <-> node lookups.
         const int       mmin[2] = { INT_MIN, INT_MIN };
         const int       mmax[2] = { INT_MAX, INT_MAX };
 
@@ -560,6 +560,14 @@ public:
 
     virtual size_t GetCount() const = 0;
 
+    /** Restrict the values enumerated by GetNextXY() to the ones needed to draw the view, which
+     *  lets layers holding many points enumerate a decimated set.
+     *  @param aColumnEdges X values of the edges of the pixel columns of the view, in increasing
+     *                      order.  Empty to lift the restriction.
+     *  Does nothing by default.
+     */
+    virtual void SetSweepWindow( const std::vector<double>& aColumnEdges ) {}
+
     /** Layer plot handler.
      *  This implementation will plot the locus in the visible area and put a label according to
      *  the alignment specified.
@@ -1374,6 +1382,12 @@ public:
      */
     virtual void SetData( const std::vector<double>& xs, const std::vector<double>& ys );
 
+    /** Appends points to the internal data, updating the bounding box from the new points only.
+     *  Both vectors MUST be of the same length. This method DOES NOT refresh the mpWindow; do it manually.
+     * @sa SetData
+     */
+    virtual void AppendData( const std::vector<double>& xs, const std::vector<double>& ys );
+
     /** Clears all the data, leaving the layer empty.
      * @sa SetData
      */
@@ -1406,6 +1420,38 @@ protected:
 
     size_t GetCount() const override;
 
+    /** Enumerate the first, smallest, largest and last point of each pixel column rather than
+     *  every visible point.  The drawn lines are the same, as mpFXY::Plot() merges the points
+     *  of a pixel column.
+     *  Overridden in this implementation.
+     */
+    void SetSweepWindow( const std::vector<double>& aColumnEdges ) override;
+
+    /** Build the min/max pyramid of the data, if the X values are sorted.
+     */
+    void buildLod();
+
+    /** Find the indices of the smallest and largest Y value of the points [aFirst, aLast)
+     *  with the min/max pyramid.
+     */
+    void findMinMax( size_t aFirst, size_t aLast, size_t& aMin, size_t& aMax ) const;
+
+    /** Size of the blocks of the finest level of the min/max pyramid.
+     */
+    static constexpr size_t LOD_BLOCK = 16;
+
+    /** Min/max pyramid: level l holds, for consecutive blocks of LOD_BLOCK << l points, the
+     *  indices of their smallest and largest Y value.  Built on the first sweep after the data
+     *  changes, so once after a simulation ends.
+     */
+    std::vector<std::vector<std::pair<size_t, size_t>>> m_lod;
+    bool m_lodValid;
+
+    /** Indices of the points enumerated while a sweep window is set.
+     */
+    std::vector<size_t> m_sweep;
+    bool m_sweepActive;
+
 public:
     /** Returns the actual minimum X data (loaded in SetData).
      */
@@ -84,6 +84,9 @@ public:
 
     /**
      * Increment the progress bar length (inside the current virtual zone).
+     *
+     * Worker threads each increment their own counter; the counters are merged into the
+     * progress value when the UI is refreshed.
      */
     void AdvanceProgress() override;
 
@@ -113,6 +116,16 @@ protected:
 
     virtual bool updateUI() = 0;
 
+    /**
+     * Fold the per-thread counters accumulated by AdvanceProgress() into m_progress.
+     */
+    void mergeProgress();
+
+    /**
+     * Drop the per-thread counters, e.g. when the progress value is reset.
+     */
+    void discardProgress();
+
     wxString           m_rptMessage;
 
     mutable std::mutex m_mutex;
@@ -122,6 +135,16 @@ protected:
     std::atomic_int    m_maxProgress;
     std::atomic_bool   m_cancelled;
 
+    static constexpr size_t PROGRESS_SLOTS = 16;
+
+    /// Keeps each counter on its own cache line so workers don't contend with each other
+    struct alignas( 64 ) PENDING_PROGRESS
+    {
+        std::atomic_int m_count{ 0 };
+    };
+
+    PENDING_PROGRESS   m_pendingProgress[PROGRESS_SLOTS];
+
     // True if the displayed message has changed,
     // so perhaps there is a need to resize the window
     // Note the resize is made only if the size of the new message
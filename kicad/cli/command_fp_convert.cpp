@@ -0,0 +1,92 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_fp_convert.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_fp_convert.h"
+#include <kiface_base.h>
+#include <string_utils.h>
+#include <wx/crt.h>
+#include <wx/dir.h>
+#include <wx/file.h>
+
+#include <macros.h>
+
+
+#define ARG_FORCE "--force"
+
+
+CLI::FP_CONVERT_COMMAND::FP_CONVERT_COMMAND() : COMMAND( "convert" )
+{
+    addCommonArgs( false, true, false, true );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Converts footprint libraries of other formats "
+                                                "(Eagle, Altium, CADSTAR, EasyEDA, gEDA, legacy KiCad, etc.) to KiCad footprint libraries, "
+                                                "several at a time" ) ) );
+
+    m_argParser.add_argument( ARG_INPUT )
+            .help( UTF8STDSTR( _( "Input footprint libraries" ) ) )
+            .metavar( "INPUT_LIBRARY" )
+            .nargs( argparse::nargs_pattern::at_least_one );
+
+    m_argParser.add_argument( ARG_FORCE )
+            .help( UTF8STDSTR( _( "Overwrites existing output libraries" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_THREADS )
+            .default_value( 0 )
+            .scan<'i', int>()
+            .help( UTF8STDSTR( _( "Number of libraries to convert at the same time; "
+                                  "0 for one per processor core" ) ) )
+            .metavar( "COUNT" );
+}
+
+
+int CLI::FP_CONVERT_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_FP_CONVERT> fpJob = std::make_unique<JOB_FP_CONVERT>( true );
+
+    for( const std::string& path : m_argParser.get<std::vector<std::string>>( ARG_INPUT ) )
+        fpJob->m_libraryPaths.push_back( From_UTF8( path.c_str() ) );
+
+    fpJob->m_outputDirectory = m_argOutput;
+    fpJob->m_force = m_argParser.get<bool>( ARG_FORCE );
+    fpJob->m_threads = m_argParser.get<int>( ARG_THREADS );
+
+    for( const wxString& path : fpJob->m_libraryPaths )
+    {
+        if( !wxFile::Exists( path ) && !wxDir::Exists( path ) )
+        {
+            wxFprintf( stderr,
+                       _( "Footprint library '%s' does not exist or is not accessible\n" ),
+                       path );
+            return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+        }
+    }
+
+    if( fpJob->m_threads < 0 )
+    {
+        wxFprintf( stderr, _( "Invalid thread count\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, fpJob.get() );
+
+    return exitCode;
+}
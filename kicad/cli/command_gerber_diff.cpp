@@ -0,0 +1,155 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_gerber_diff.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_export_pcb_gerber.h"
+#include "jobs/job_gerber_diff.h"
+#include <kiface_base.h>
+#include <layer_ids.h>
+#include <string_utils.h>
+#include <wildcards_and_files_ext.h>
+#include <wx/crt.h>
+#include <wx/filename.h>
+
+#include <locale_io.h>
+#include <macros.h>
+
+#define ARG_AGAINST "--against"
+#define ARG_LAYER "--layer"
+#define ARG_TOLERANCE "--tolerance"
+#define ARG_EXIT_CODE_VIOLATIONS "--exit-code-violations"
+#define ARG_USE_DRILL_FILE_ORIGIN "--use-drill-file-origin"
+
+CLI::GERBER_DIFF_COMMAND::GERBER_DIFF_COMMAND() : COMMAND( "diff" )
+{
+    addCommonArgs( true, true, false, false );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Compare the geometry of a Gerber or drill "
+                                                "file to another one, or to a layer of a "
+                                                "board, and list the areas drawn by only one "
+                                                "of them" ) ) );
+
+    m_argParser.add_argument( ARG_AGAINST )
+            .help( UTF8STDSTR( _( "Gerber or drill file, or board file, to compare the input "
+                                  "file to" ) ) )
+            .metavar( "FILE" )
+            .required();
+
+    m_argParser.add_argument( ARG_LAYER )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Layer of the board to compare the input file to, plotted "
+                                  "with the default Gerber options (e.g. F.Cu)" ) ) )
+            .metavar( "LAYER" );
+
+    m_argParser.add_argument( ARG_USE_DRILL_FILE_ORIGIN )
+            .help( UTF8STDSTR( _( "Plot the board layer relative to the drill/place file "
+                                  "origin" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_TOLERANCE )
+            .help( UTF8STDSTR( _( "Width of the thinnest difference reported, in mm" ) ) )
+            .scan<'g', double>()
+            .default_value( 0.025 )
+            .metavar( "MM" );
+
+    m_argParser.add_argument( ARG_EXIT_CODE_VIOLATIONS )
+            .help( UTF8STDSTR( _( "Return a nonzero exit code if the files differ" ) ) )
+            .flag();
+}
+
+
+int CLI::GERBER_DIFF_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_GERBER_DIFF> diffJob( new JOB_GERBER_DIFF( true ) );
+
+    diffJob->m_firstFile = m_argInput;
+    diffJob->m_secondFile = From_UTF8( m_argParser.get<std::string>( ARG_AGAINST ).c_str() );
+    diffJob->m_outputFile = m_argOutput;
+    diffJob->m_tolerance = m_argParser.get<double>( ARG_TOLERANCE );
+    diffJob->m_exitCodeOnDiff = m_argParser.get<bool>( ARG_EXIT_CODE_VIOLATIONS );
+
+    if( diffJob->m_tolerance < 0.0 )
+    {
+        wxFprintf( stderr, _( "The tolerance can't be negative\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    wxString   layerName = From_UTF8( m_argParser.get<std::string>( ARG_LAYER ).c_str() );
+    wxFileName boardFile( diffJob->m_secondFile );
+    wxString   plotFile;
+    int        exitCode;
+
+    LOCALE_IO dummy;
+
+    if( boardFile.GetExt() == FILEEXT::KiCadPcbFileExtension )
+    {
+        // Gerbview can't read boards, so compare to a fresh plot of the layer
+        if( !boardFile.FileExists() )
+        {
+            wxFprintf( stderr, _( "Board file does not exist or is not accessible\n" ) );
+            return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+        }
+
+        PCB_LAYER_ID layer = UNDEFINED_LAYER;
+
+        for( int ii = 0; ii < PCB_LAYER_ID_COUNT; ++ii )
+        {
+            if( LSET::Name( PCB_LAYER_ID( ii ) ) == layerName )
+                layer = PCB_LAYER_ID( ii );
+        }
+
+        if( layer == UNDEFINED_LAYER )
+        {
+            wxFprintf( stderr, _( "A valid board layer must be given with %s\n" ), ARG_LAYER );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        plotFile = wxFileName::CreateTempFileName( wxS( "kicad_gerber_diff" ) );
+
+        std::unique_ptr<JOB_EXPORT_PCB_GERBER> gerberJob( new JOB_EXPORT_PCB_GERBER( true ) );
+
+        gerberJob->m_filename = boardFile.GetFullPath();
+        gerberJob->m_outputFile = plotFile;
+        gerberJob->m_useAuxOrigin = m_argParser.get<bool>( ARG_USE_DRILL_FILE_ORIGIN );
+        gerberJob->m_printMaskLayer = { layer };
+
+        exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, gerberJob.get() );
+
+        if( exitCode != EXIT_CODES::OK )
+        {
+            wxRemoveFile( plotFile );
+            return exitCode;
+        }
+
+        diffJob->m_secondFile = plotFile;
+    }
+    else if( !layerName.IsEmpty() )
+    {
+        wxFprintf( stderr, _( "%s can only be used to compare to a board\n" ), ARG_LAYER );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    exitCode = aKiway.ProcessJob( KIWAY::FACE_GERBVIEW, diffJob.get() );
+
+    if( !plotFile.IsEmpty() )
+        wxRemoveFile( plotFile );
+
+    return exitCode;
+}
@@ -0,0 +1,156 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_jobset.h"
+#include "command_set.h"
+#include <cli/exit_codes.h>
+
+#include <wx/cmdline.h>
+#include <wx/crt.h>
+#include <wx/textfile.h>
+
+#include <memory>
+#include <thread>
+
+
+/**
+ * A line of a jobset file, with the commands that parsed it.
+ */
+struct JOBSET_LINE
+{
+    size_t                            m_lineNumber;
+    bool                              m_schematic;    ///< Run by the schematic editor
+    std::unique_ptr<CLI::COMMAND_SET> m_commands;
+    CLI::COMMAND*                     m_command = nullptr;
+    int                               m_exitCode = CLI::EXIT_CODES::OK;
+};
+
+
+CLI::JOBSET_COMMAND::JOBSET_COMMAND() : COMMAND( "jobset" )
+{
+    addCommonArgs( true, false, false, false );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Runs the commands of a jobset file, one per "
+                                                "line, loading each board and schematic once" ) ) );
+}
+
+
+int CLI::JOBSET_COMMAND::doPerform( KIWAY& aKiway )
+{
+    wxTextFile file( m_argInput );
+
+    if( !file.Exists() || !file.Open() )
+    {
+        wxFprintf( stderr, _( "Jobset file does not exist or is not accessible\n" ) );
+        return EXIT_CODES::ERR_INVALID_INPUT_FILE;
+    }
+
+    std::vector<JOBSET_LINE> lines;
+
+    // Parse the whole file first, so that an error in a line doesn't leave the outputs half done
+    for( size_t ii = 0; ii < file.GetLineCount(); ii++ )
+    {
+        wxString text = file.GetLine( ii );
+        text.Trim( true ).Trim( false );
+
+        if( text.IsEmpty() || text.StartsWith( wxS( "#" ) ) )
+            continue;
+
+        wxArrayString args = wxCmdLineParser::ConvertStringToArgs( text, wxCMD_LINE_SPLIT_UNIX );
+
+        if( !args.IsEmpty() && args[0] == wxS( "kicad-cli" ) )
+            args.RemoveAt( 0 );
+
+        if( args.IsEmpty() )
+            continue;
+
+        if( args[0] == GetName() || args[0] == wxS( "server" ) )
+        {
+            wxFprintf( stderr, _( "Line %d: '%s' can't be run from a jobset\n" ), (int) ii + 1,
+                       args[0] );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        JOBSET_LINE& line = lines.emplace_back();
+        line.m_lineNumber = ii + 1;
+        line.m_schematic = args[0] == wxS( "sch" ) || args[0] == wxS( "sym" );
+        line.m_commands = std::make_unique<COMMAND_SET>();
+
+        wxString error;
+        line.m_command = line.m_commands->Parse( args, error );
+
+        if( !line.m_command )
+        {
+            wxFprintf( stderr, _( "Line %d: %s\n" ), (int) line.m_lineNumber, error );
+            return EXIT_CODES::ERR_ARGS;
+        }
+    }
+
+    // Load the editors from this thread, as KIWAY doesn't guard the loading of a kiface
+    bool hasBoardJobs = false;
+    bool hasSchematicJobs = false;
+
+    for( const JOBSET_LINE& line : lines )
+    {
+        hasBoardJobs |= !line.m_schematic;
+        hasSchematicJobs |= line.m_schematic;
+    }
+
+    if( hasBoardJobs )
+        aKiway.KiFACE( KIWAY::FACE_PCB );
+
+    if( hasSchematicJobs )
+        aKiway.KiFACE( KIWAY::FACE_SCH );
+
+    // The jobs of an editor share its board or schematic, so they run one after the other,
+    // but the two editors don't share any document and run alongside each other.
+    auto runJobs =
+            [&]( bool aSchematic )
+            {
+                for( JOBSET_LINE& line : lines )
+                {
+                    if( line.m_schematic == aSchematic )
+                        line.m_exitCode = line.m_command->Perform( aKiway );
+                }
+            };
+
+    std::thread schematicJobs;
+
+    if( hasSchematicJobs && hasBoardJobs )
+        schematicJobs = std::thread( runJobs, true );
+    else if( hasSchematicJobs )
+        runJobs( true );
+
+    if( hasBoardJobs )
+        runJobs( false );
+
+    if( schematicJobs.joinable() )
+        schematicJobs.join();
+
+    for( const JOBSET_LINE& line : lines )
+    {
+        if( line.m_exitCode != EXIT_CODES::OK && line.m_exitCode != EXIT_CODES::AVOID_CLOSING )
+        {
+            wxFprintf( stderr, _( "Line %d failed\n" ), (int) line.m_lineNumber );
+            return line.m_exitCode;
+        }
+    }
+
+    return EXIT_CODES::OK;
+}
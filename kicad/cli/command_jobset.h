@@ -0,0 +1,43 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMAND_JOBSET_H
+#define COMMAND_JOBSET_H
+
+#include "command.h"
+
+namespace CLI
+{
+/**
+ * Run the kicad-cli commands listed in a file, one per line, without the leading "kicad-cli".
+ *
+ * The board and schematic jobs share the files loaded by the earlier jobs, and the board jobs
+ * run alongside the schematic ones.
+ */
+class JOBSET_COMMAND : public COMMAND
+{
+public:
+    JOBSET_COMMAND();
+
+protected:
+    int doPerform( KIWAY& aKiway ) override;
+};
+}
+
+#endif
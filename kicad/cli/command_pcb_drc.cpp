@@ -38,10 +38,18 @@
 #define ARG_SEVERITY_EXCLUSIONS "--severity-exclusions"
 #define ARG_EXIT_CODE_VIOLATIONS "--exit-code-violations"
 #define ARG_PARITY "--schematic-parity"
+#define ARG_USE_CACHE "--use-cache"
+#define ARG_TIMINGS "--timings"
+#define ARG_REGION "--region"
+#define ARG_NETS "--nets"
+#define ARG_REFS "--refs"
+#define ARG_SHARDS "--shards"
+#define ARG_SHARD "--shard"
+#define ARG_MERGE_SHARDS "--merge-shards"
 
-CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : COMMAND( "drc" )
+CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : PCB_EXPORT_BASE_COMMAND( "drc" )
 {
-    addCommonArgs( true, true, false, false );
+    addLayerArg( false );
     addDefineArg();
 
     m_argParser.add_description( UTF8STDSTR( _( "Runs the Design Rules Check (DRC) on the PCB "
@@ -84,11 +92,68 @@ CLI::PCB_DRC_COMMAND::PCB_DRC_COMMAND() : COMMAND( "drc" )
     m_argParser.add_argument( ARG_EXIT_CODE_VIOLATIONS )
             .help( UTF8STDSTR( _( "Return a nonzero exit code if DRC violations exist" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_USE_CACHE )
+            .help( UTF8STDSTR( _( "Store the results next to the board, and only re-test the "
+                                  "items changed since the previous run which stored them" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_REFILL_IF_STALE )
+            .help( UTF8STDSTR( _( ARG_REFILL_IF_STALE_DESC ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_TIMINGS )
+            .help( UTF8STDSTR( _( "Include the time spent by each test and evaluating the "
+                                  "conditions of each rule in the report" ) ) )
+            .flag();
+
+    m_argParser.add_argument( ARG_REGION )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Only report the violations located in the box between the "
+                                  "corners X1,Y1,X2,Y2, in the report units" ) ) )
+            .metavar( "X1,Y1,X2,Y2" );
+
+    m_argParser.add_argument( ARG_NETS )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Only report the violations involving these nets; comma "
+                                  "separated list of net names, wildcards allowed" ) ) )
+            .metavar( "NET_LIST" );
+
+    m_argParser.add_argument( ARG_REFS )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Only report the violations involving these footprints; comma "
+                                  "separated list of reference designators" ) ) )
+            .metavar( "REF_LIST" );
+
+    m_argParser.add_argument( ARG_SHARDS )
+            .default_value( 0 )
+            .scan<'i', int>()
+            .help( UTF8STDSTR( _( "Split the board in this many strips, and run DRC on each one "
+                                  "in a separate process" ) ) )
+            .metavar( "COUNT" );
+
+    m_argParser.add_argument( ARG_SHARD )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Only run DRC on strip INDEX (from 0) of a board split in COUNT "
+                                  "strips, and save the violations to the output file for "
+                                  "--merge-shards" ) ) )
+            .metavar( "INDEX/COUNT" );
+
+    m_argParser.add_argument( ARG_MERGE_SHARDS )
+            .default_value( std::string() )
+            .help( UTF8STDSTR( _( "Write the report of the violations saved by --shard runs "
+                                  "instead of running DRC; comma separated list of files" ) ) )
+            .metavar( "FILE_LIST" );
 }
 
 
 int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
 {
+    int baseExit = PCB_EXPORT_BASE_COMMAND::doPerform( aKiway );
+
+    if( baseExit != EXIT_CODES::OK )
+        return baseExit;
+
     std::unique_ptr<JOB_PCB_DRC> drcJob( new JOB_PCB_DRC( true ) );
 
     drcJob->m_outputFile = m_argOutput;
@@ -96,6 +161,9 @@ int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
     drcJob->SetVarOverrides( m_argDefineVars );
     drcJob->m_reportAllTrackErrors = m_argParser.get<bool>( ARG_ALL_TRACK_ERRORS );
     drcJob->m_exitCodeViolations = m_argParser.get<bool>( ARG_EXIT_CODE_VIOLATIONS );
+    drcJob->m_useCache = m_argParser.get<bool>( ARG_USE_CACHE );
+    drcJob->m_reportTimings = m_argParser.get<bool>( ARG_TIMINGS );
+    drcJob->m_refillIfStale = m_argParser.get<bool>( ARG_REFILL_IF_STALE );
 
     if( m_argParser.get<bool>( ARG_SEVERITY_ALL ) )
     {
@@ -139,6 +207,91 @@ int CLI::PCB_DRC_COMMAND::doPerform( KIWAY& aKiway )
         return EXIT_CODES::ERR_ARGS;
     }
 
+    for( PCB_LAYER_ID layer : m_selectedLayers )
+        drcJob->m_layers.set( layer );
+
+    wxString region = From_UTF8( m_argParser.get<std::string>( ARG_REGION ).c_str() );
+
+    if( !region.IsEmpty() )
+    {
+        wxStringTokenizer   tokens( region, "," );
+        std::vector<double> coords;
+        double              coord;
+
+        while( tokens.HasMoreTokens() )
+        {
+            if( !tokens.GetNextToken().Trim().Trim( false ).ToCDouble( &coord ) )
+                break;
+
+            coords.push_back( coord );
+        }
+
+        if( coords.size() != 4 || tokens.HasMoreTokens() )
+        {
+            wxFprintf( stderr, _( "Invalid region specified\n" ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        drcJob->m_restrictArea = true;
+        drcJob->m_areaStart = VECTOR2D( coords[0], coords[1] );
+        drcJob->m_areaEnd = VECTOR2D( coords[2], coords[3] );
+    }
+
+    auto parseList =
+            [&]( const char* aArg, std::vector<wxString>& aList )
+            {
+                wxStringTokenizer tokens( From_UTF8( m_argParser.get<std::string>( aArg ).c_str() ),
+                                          "," );
+
+                while( tokens.HasMoreTokens() )
+                {
+                    wxString token = tokens.GetNextToken().Trim().Trim( false );
+
+                    if( !token.IsEmpty() )
+                        aList.push_back( token );
+                }
+            };
+
+    parseList( ARG_NETS, drcJob->m_nets );
+    parseList( ARG_REFS, drcJob->m_references );
+    parseList( ARG_MERGE_SHARDS, drcJob->m_shardFiles );
+
+    drcJob->m_shardCount = m_argParser.get<int>( ARG_SHARDS );
+
+    wxString shard = From_UTF8( m_argParser.get<std::string>( ARG_SHARD ).c_str() );
+
+    if( !shard.IsEmpty() )
+    {
+        long index = -1;
+        long count = 0;
+
+        if( !shard.BeforeFirst( '/' ).ToLong( &index ) || !shard.AfterFirst( '/' ).ToLong( &count )
+                || count < 1 || index < 0 || index >= count )
+        {
+            wxFprintf( stderr, _( "Invalid shard specified\n" ) );
+            return EXIT_CODES::ERR_ARGS;
+        }
+
+        drcJob->m_shardIndex = static_cast<int>( index );
+        drcJob->m_shardCount = static_cast<int>( count );
+    }
+
+    if( drcJob->m_shardCount < 0
+            || ( drcJob->m_shardCount > 0 && !drcJob->m_shardFiles.empty() ) )
+    {
+        wxFprintf( stderr, _( "Invalid shard specified\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
+    if( ( drcJob->m_shardCount > 0 && drcJob->m_restrictArea )
+            || ( ( drcJob->m_shardCount > 0 || !drcJob->m_shardFiles.empty() )
+                 && ( drcJob->m_useCache || drcJob->m_reportTimings ) ) )
+    {
+        wxFprintf( stderr, _( "Shards can't be combined with a region, the result cache or "
+                              "timings\n" ) );
+        return EXIT_CODES::ERR_ARGS;
+    }
+
     wxString format = From_UTF8( m_argParser.get<std::string>( ARG_FORMAT ).c_str() );
     if( format == "report" )
     {
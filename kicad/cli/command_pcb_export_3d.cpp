@@ -21,6 +21,7 @@
 #include "command_pcb_export_3d.h"
 #include <cli/exit_codes.h>
 #include <kiface_base.h>
+#include <algorithm>
 #include <regex>
 #include <string_utils.h>
 #include <locale_io.h>
@@ -44,6 +45,8 @@
 #define ARG_VRML_UNITS "--units"
 #define ARG_VRML_MODELS_DIR "--models-dir"
 #define ARG_VRML_MODELS_RELATIVE "--models-relative"
+#define ARG_FAST_MESH "--fast-mesh"
+#define ARG_MESH_DECIMATION "--mesh-decimation"
 
 #define REGEX_QUANTITY "([\\s]*[+-]?[\\d]*[.]?[\\d]*)"
 #define REGEX_DELIMITER "(?:[\\s]*x)"
@@ -116,6 +119,23 @@ CLI::PCB_EXPORT_3D_COMMAND::PCB_EXPORT_3D_COMMAND( const std::string&        aNa
                 .metavar( "MIN_DIST" );
     }
 
+    if( m_format == JOB_EXPORT_PCB_3D::FORMAT::GLB
+        || m_format == JOB_EXPORT_PCB_3D::FORMAT::UNKNOWN )
+    {
+        m_argParser.add_argument( ARG_FAST_MESH )
+                .help( UTF8STDSTR( _( "Export a glb file of meshes only, from the board layers and "
+                                      "the 3D models, without building solids (fast, for "
+                                      "previews)" ) ) )
+                .flag();
+
+        m_argParser.add_argument( ARG_MESH_DECIMATION )
+                .default_value( 0.1 )
+                .scan<'g', double>()
+                .help( UTF8STDSTR( _( "Used with --fast-mesh: size in mm of the cells used to "
+                                      "decimate the 3D models, 0 to keep them as is" ) ) )
+                .metavar( "SIZE" );
+    }
+
     if( m_format == JOB_EXPORT_PCB_3D::FORMAT::STEP )
     {
         m_argParser.add_argument( ARG_NO_OPTIMIZE_STEP )
@@ -170,6 +190,13 @@ int CLI::PCB_EXPORT_3D_COMMAND::doPerform( KIWAY& aKiway )
         step->m_optimizeStep = !m_argParser.get<bool>( ARG_NO_OPTIMIZE_STEP );
     }
 
+    if( m_format == JOB_EXPORT_PCB_3D::FORMAT::GLB
+        || m_format == JOB_EXPORT_PCB_3D::FORMAT::UNKNOWN )
+    {
+        step->m_fastMesh = m_argParser.get<bool>( ARG_FAST_MESH );
+        step->m_meshDecimation = std::max( m_argParser.get<double>( ARG_MESH_DECIMATION ), 0.0 );
+    }
+
     step->m_overwrite = m_argParser.get<bool>( ARG_FORCE );
     step->m_filename = m_argInput;
     step->m_outputFile = m_argOutput;
@@ -39,6 +39,8 @@ namespace CLI
 #define ARG_THEME "--theme"
 #define ARG_INCLUDE_BORDER_TITLE "--include-border-title"
 #define ARG_MIRROR "--mirror"
+#define ARG_REFILL_IF_STALE "--refill-if-stale"
+#define ARG_REFILL_IF_STALE_DESC "Refill the zones whose fills were not built from the board as it is"
 
 struct PCB_EXPORT_BASE_COMMAND : public COMMAND
 {
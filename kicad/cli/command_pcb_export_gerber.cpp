@@ -82,6 +82,10 @@ CLI::PCB_EXPORT_GERBER_COMMAND::PCB_EXPORT_GERBER_COMMAND( const std::string& aN
     m_argParser.add_argument( ARG_NO_PROTEL_EXTENSION )
             .help( UTF8STDSTR( _( "Use KiCad Gerber file extension" ) ) )
             .flag();
+
+    m_argParser.add_argument( ARG_REFILL_IF_STALE )
+            .help( UTF8STDSTR( _( ARG_REFILL_IF_STALE_DESC ) ) )
+            .flag();
 }
 
 
@@ -107,6 +111,7 @@ int CLI::PCB_EXPORT_GERBER_COMMAND::populateJob( JOB_EXPORT_PCB_GERBER* aJob )
     aJob->m_useAuxOrigin = m_argParser.get<bool>( ARG_USE_DRILL_FILE_ORIGIN );
     aJob->m_useProtelFileExtension = !m_argParser.get<bool>( ARG_NO_PROTEL_EXTENSION );
     aJob->m_precision = m_argParser.get<int>( ARG_PRECISION );
+    aJob->m_refillIfStale = m_argParser.get<bool>( ARG_REFILL_IF_STALE );
     aJob->m_printMaskLayer = m_selectedLayers;
 
     if( !wxFile::Exists( aJob->m_filename ) )
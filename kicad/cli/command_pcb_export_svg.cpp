@@ -35,6 +35,7 @@
 #define ARG_EXCLUDE_DRAWING_SHEET "--exclude-drawing-sheet"
 #define ARG_PAGE_SIZE "--page-size-mode"
 #define ARG_DRILL_SHAPE_OPTION "--drill-shape-opt"
+#define ARG_COMPACT "--compact"
 
 
 CLI::PCB_EXPORT_SVG_COMMAND::PCB_EXPORT_SVG_COMMAND() : PCB_EXPORT_BASE_COMMAND( "svg" )
@@ -79,6 +80,11 @@ CLI::PCB_EXPORT_SVG_COMMAND::PCB_EXPORT_SVG_COMMAND() : PCB_EXPORT_BASE_COMMAND(
             .scan<'i', int>()
             .default_value( 2 )
             .metavar( "SHAPE_OPTION" );
+
+    m_argParser.add_argument( ARG_COMPACT )
+            .help( UTF8STDSTR( _( "Write a smaller file, merging strokes into paths, reusing "
+                                  "repeated pad shapes and using integer coordinates" ) ) )
+            .flag();
 }
 
 
@@ -95,6 +101,7 @@ int CLI::PCB_EXPORT_SVG_COMMAND::doPerform( KIWAY& aKiway )
     svgJob->m_pageSizeMode = m_argParser.get<int>( ARG_PAGE_SIZE );
     svgJob->m_negative = m_argParser.get<bool>( ARG_NEGATIVE );
     svgJob->m_drillShapeOption = m_argParser.get<int>( ARG_DRILL_SHAPE_OPTION );
+    svgJob->m_compact = m_argParser.get<bool>( ARG_COMPACT );
     svgJob->m_drawingSheet = m_argDrawingSheet;
 
     svgJob->m_filename = m_argInput;
@@ -0,0 +1,56 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_pcb_memory_report.h"
+#include <cli/exit_codes.h>
+#include "jobs/job_pcb_memory_report.h"
+#include <kiface_base.h>
+#include <string_utils.h>
+#include <wx/crt.h>
+
+#include <macros.h>
+
+#define ARG_FILL_ZONES "--fill-zones"
+
+CLI::PCB_MEMORY_REPORT_COMMAND::PCB_MEMORY_REPORT_COMMAND() : COMMAND( "memory-report" )
+{
+    addCommonArgs( true, true, false, false );
+
+    m_argParser.add_description( UTF8STDSTR( _( "Loads the PCB and writes a JSON report of the "
+                                                "estimated memory used by each category of board "
+                                                "data" ) ) );
+
+    m_argParser.add_argument( ARG_FILL_ZONES )
+            .help( UTF8STDSTR( _( "Refill all zones before writing the report" ) ) )
+            .flag();
+}
+
+
+int CLI::PCB_MEMORY_REPORT_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::unique_ptr<JOB_PCB_MEMORY_REPORT> memoryJob( new JOB_PCB_MEMORY_REPORT( true ) );
+
+    memoryJob->m_outputFile = m_argOutput;
+    memoryJob->m_filename = m_argInput;
+    memoryJob->m_fillZones = m_argParser.get<bool>( ARG_FILL_ZONES );
+
+    int exitCode = aKiway.ProcessJob( KIWAY::FACE_PCB, memoryJob.get() );
+
+    return exitCode;
+}
@@ -0,0 +1,103 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_server.h"
+#include "command_set.h"
+#include <cli/exit_codes.h>
+#include <string_utils.h>
+
+#include <wx/cmdline.h>
+#include <wx/crt.h>
+
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+
+
+CLI::SERVER_COMMAND::SERVER_COMMAND() : COMMAND( "server" )
+{
+    m_argParser.add_description( UTF8STDSTR( _( "Runs the commands read from the standard "
+                                                "input, one per line, keeping the boards and "
+                                                "schematics loaded between them" ) ) );
+}
+
+
+int CLI::SERVER_COMMAND::doPerform( KIWAY& aKiway )
+{
+    std::string input;
+    int         request = 0;
+
+    auto reply =
+            [&]( int aExitCode )
+            {
+                wxPrintf( wxS( "{\"request\": %d, \"exit_code\": %d}\n" ), request, aExitCode );
+
+                // The client waits for the reply before sending the next command
+                fflush( stdout );
+            };
+
+    while( std::getline( std::cin, input ) )
+    {
+        wxString text = From_UTF8( input.c_str() );
+        text.Trim( true ).Trim( false );
+
+        if( text.IsEmpty() || text.StartsWith( wxS( "#" ) ) )
+            continue;
+
+        if( text == wxS( "quit" ) )
+            break;
+
+        request++;
+
+        wxArrayString args = wxCmdLineParser::ConvertStringToArgs( text, wxCMD_LINE_SPLIT_UNIX );
+
+        if( !args.IsEmpty() && args[0] == wxS( "kicad-cli" ) )
+            args.RemoveAt( 0 );
+
+        if( args.IsEmpty() || args[0] == GetName() || args[0] == wxS( "jobset" ) )
+        {
+            wxFprintf( stderr, _( "Request %d: '%s' can't be run by the server\n" ), request,
+                       text );
+            reply( EXIT_CODES::ERR_ARGS );
+            continue;
+        }
+
+        // An argument parser can only parse one command line
+        std::unique_ptr<COMMAND_SET> commands = std::make_unique<COMMAND_SET>();
+        wxString                     error;
+        COMMAND*                     command = commands->Parse( args, error );
+
+        if( !command )
+        {
+            wxFprintf( stderr, _( "Request %d: %s\n" ), request, error );
+            reply( EXIT_CODES::ERR_ARGS );
+            continue;
+        }
+
+        int exitCode = command->Perform( aKiway );
+
+        if( exitCode == EXIT_CODES::AVOID_CLOSING )
+            exitCode = EXIT_CODES::OK;
+
+        reply( exitCode );
+    }
+
+    return EXIT_CODES::OK;
+}
@@ -0,0 +1,46 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMAND_SERVER_H
+#define COMMAND_SERVER_H
+
+#include "command.h"
+
+namespace CLI
+{
+/**
+ * Run the kicad-cli commands read from the standard input, one per line, until "quit" or the
+ * end of the input.
+ *
+ * The editors and the last board and schematic stay loaded between the commands, so that a
+ * client running many jobs only pays for the startup once.  A document is loaded again when
+ * one of its files has been modified since.  After each command, a line such as
+ * {"request": 3, "exit_code": 0} reports its result on the standard output.
+ */
+class SERVER_COMMAND : public COMMAND
+{
+public:
+    SERVER_COMMAND();
+
+protected:
+    int doPerform( KIWAY& aKiway ) override;
+};
+}
+
+#endif
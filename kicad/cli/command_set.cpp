@@ -0,0 +1,233 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "command_set.h"
+#include <locale_io.h>
+#include <string_utils.h>
+
+
+CLI::COMMAND_SET::COMMAND_SET() :
+        m_exportPcbGlbCmd( "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ),
+                           JOB_EXPORT_PCB_3D::FORMAT::GLB ),
+        m_exportPcbStepCmd( "step", UTF8STDSTR( _( "Export STEP" ) ),
+                            JOB_EXPORT_PCB_3D::FORMAT::STEP ),
+        m_exportPcbVrmlCmd( "vrml", UTF8STDSTR( _( "Export VRML" ) ),
+                            JOB_EXPORT_PCB_3D::FORMAT::VRML ),
+        m_exportSchDxfCmd( "dxf", UTF8STDSTR( _( "Export DXF" ) ), SCH_PLOT_FORMAT::DXF ),
+        m_exportSchHpglCmd( "hpgl", UTF8STDSTR( _( "Export HPGL" ) ), SCH_PLOT_FORMAT::HPGL ),
+        m_exportSchPdfCmd( "pdf", UTF8STDSTR( _( "Export PDF" ) ), SCH_PLOT_FORMAT::PDF, false ),
+        m_exportSchPostscriptCmd( "ps", UTF8STDSTR( _( "Export PS" ) ), SCH_PLOT_FORMAT::POST ),
+        m_exportSchSvgCmd( "svg", UTF8STDSTR( _( "Export SVG" ) ), SCH_PLOT_FORMAT::SVG )
+{
+    m_commandStack = {
+        {
+            &m_fpCmd,
+            {
+                {
+                    &m_fpConvertCmd
+                },
+                {
+                    &m_fpExportCmd,
+                    {
+                        &m_fpExportSvgCmd
+                    }
+                },
+                {
+                    &m_fpUpgradeCmd
+                }
+            }
+        },
+        {
+            &m_gerberCmd,
+            {
+                {
+                    &m_gerberDiffCmd
+                }
+            }
+        },
+        {
+            &m_jobsetCmd,
+        },
+        {
+            &m_serverCmd,
+        },
+        {
+            &m_pcbCmd,
+            {
+                {
+                    &m_pcbDrcCmd
+                },
+                {
+                    &m_pcbMemoryReportCmd
+                },
+                {
+                    &m_exportPcbCmd,
+                    {
+                        &m_exportPcbDrillCmd,
+                        &m_exportPcbDxfCmd,
+                        &m_exportPcbGerberCmd,
+                        &m_exportPcbGerbersCmd,
+                        &m_exportPcbGlbCmd,
+                        &m_exportPcbPdfCmd,
+                        &m_exportPcbPosCmd,
+                        &m_exportPcbStepCmd,
+                        &m_exportPcbSvgCmd,
+                        &m_exportPcbVrmlCmd
+                    }
+                }
+            }
+        },
+        {
+            &m_schCmd,
+            {
+                {
+                    &m_schErcCmd
+                },
+                {
+                    &m_exportSchCmd,
+                    {
+                        &m_exportSchDxfCmd,
+                        &m_exportSchHpglCmd,
+                        &m_exportSchNetlistCmd,
+                        &m_exportSchPdfCmd,
+                        &m_exportSchPostscriptCmd,
+                        &m_exportSchBomCmd,
+                        &m_exportSchPythonBomCmd,
+                        &m_exportSchSvgCmd
+                    }
+                }
+            }
+        },
+        {
+            &m_symCmd,
+            {
+                {
+                    &m_symConvertCmd
+                },
+                {
+                    &m_symExportCmd,
+                    {
+                        &m_symExportSvgCmd
+                    }
+                },
+                {
+                    &m_symUpgradeCmd
+                }
+            }
+        },
+        {
+                &m_versionCmd,
+        }
+    };
+}
+
+
+static void recurseArgParserBuild( argparse::ArgumentParser& aArgParser,
+                                   CLI::COMMAND_ENTRY&       aEntry )
+{
+    aArgParser.add_subparser( aEntry.handler->GetArgParser() );
+
+    for( CLI::COMMAND_ENTRY& subEntry : aEntry.subCommands )
+    {
+        recurseArgParserBuild( aEntry.handler->GetArgParser(), subEntry );
+    }
+}
+
+
+static CLI::COMMAND_ENTRY* recurseArgParserSubCommandUsed( argparse::ArgumentParser& aArgParser,
+                                                           CLI::COMMAND_ENTRY&       aEntry )
+{
+    CLI::COMMAND_ENTRY* cliCmd = nullptr;
+
+    if( aArgParser.is_subcommand_used( aEntry.handler->GetName() ) )
+    {
+        for( CLI::COMMAND_ENTRY& subentry : aEntry.subCommands )
+        {
+            cliCmd = recurseArgParserSubCommandUsed( aEntry.handler->GetArgParser(), subentry );
+            if( cliCmd )
+                break;
+        }
+
+        if(!cliCmd)
+            cliCmd = &aEntry;
+    }
+
+    return cliCmd;
+}
+
+
+void CLI::COMMAND_SET::AddTo( argparse::ArgumentParser& aArgParser )
+{
+    for( COMMAND_ENTRY& entry : m_commandStack )
+    {
+        recurseArgParserBuild( aArgParser, entry );
+    }
+}
+
+
+CLI::COMMAND_ENTRY* CLI::COMMAND_SET::GetUsedCommand( argparse::ArgumentParser& aArgParser )
+{
+    for( COMMAND_ENTRY& entry : m_commandStack )
+    {
+        if( COMMAND_ENTRY* cmdSubEntry = recurseArgParserSubCommandUsed( aArgParser, entry ) )
+            return cmdSubEntry;
+    }
+
+    return nullptr;
+}
+
+
+CLI::COMMAND* CLI::COMMAND_SET::Parse( const wxArrayString& aArgs, wxString& aError )
+{
+    argparse::ArgumentParser argParser( std::string( "kicad-cli" ), "",
+                                        argparse::default_arguments::none );
+    AddTo( argParser );
+
+    std::vector<std::string> argv = { "kicad-cli" };
+
+    for( size_t ii = 0; ii < aArgs.size(); ii++ )
+    {
+        if( ii == 0 && aArgs[ii] == wxS( "kicad-cli" ) )
+            continue;
+
+        argv.emplace_back( aArgs[ii].utf8_str() );
+    }
+
+    try
+    {
+        // Use the C locale to parse arguments, as for the kicad-cli command line
+        LOCALE_IO dummy;
+        argParser.parse_args( argv );
+    }
+    catch( const std::exception& err )
+    {
+        aError = From_UTF8( err.what() );
+        return nullptr;
+    }
+
+    COMMAND_ENTRY* entry = GetUsedCommand( argParser );
+
+    if( !entry || !entry->subCommands.empty() )
+    {
+        aError = _( "incomplete command" );
+        return nullptr;
+    }
+
+    return entry->handler;
+}
@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COMMAND_SET_H
+#define COMMAND_SET_H
+
+#include <vector>
+
+#include <wx/arrstr.h>
+
+#include "command_pcb.h"
+#include "command_pcb_export.h"
+#include "command_pcb_drc.h"
+#include "command_pcb_memory_report.h"
+#include "command_pcb_export_3d.h"
+#include "command_pcb_export_drill.h"
+#include "command_pcb_export_dxf.h"
+#include "command_pcb_export_gerber.h"
+#include "command_pcb_export_gerbers.h"
+#include "command_pcb_export_pdf.h"
+#include "command_pcb_export_pos.h"
+#include "command_pcb_export_svg.h"
+#include "command_sch_export_bom.h"
+#include "command_sch_export_pythonbom.h"
+#include "command_sch_export_netlist.h"
+#include "command_sch_export_plot.h"
+#include "command_fp.h"
+#include "command_fp_convert.h"
+#include "command_fp_export.h"
+#include "command_fp_export_svg.h"
+#include "command_fp_upgrade.h"
+#include "command_gerber.h"
+#include "command_gerber_diff.h"
+#include "command_jobset.h"
+#include "command_server.h"
+#include "command_sch.h"
+#include "command_sch_erc.h"
+#include "command_sch_export.h"
+#include "command_sym.h"
+#include "command_sym_convert.h"
+#include "command_sym_export.h"
+#include "command_sym_export_svg.h"
+#include "command_sym_upgrade.h"
+#include "command_version.h"
+
+namespace CLI
+{
+
+struct COMMAND_ENTRY
+{
+    COMMAND* handler;
+
+    std::vector<COMMAND_ENTRY> subCommands;
+
+    COMMAND_ENTRY( COMMAND* aHandler ) : handler( aHandler ){};
+    COMMAND_ENTRY( COMMAND* aHandler, std::vector<COMMAND_ENTRY> aSub ) :
+            handler( aHandler ), subCommands( aSub ){};
+};
+
+
+/**
+ * All the commands of kicad-cli, with the argument parsers of a command line.
+ *
+ * An argument parser can only parse one command line, so each line of a jobset gets its own
+ * set of commands.
+ */
+class COMMAND_SET
+{
+public:
+    COMMAND_SET();
+
+    COMMAND_SET( const COMMAND_SET& ) = delete;
+    COMMAND_SET& operator=( const COMMAND_SET& ) = delete;
+
+    /**
+     * Add the parsers of the commands as subcommands of \a aArgParser.
+     */
+    void AddTo( argparse::ArgumentParser& aArgParser );
+
+    /**
+     * @return the innermost command used in the command line parsed by \a aArgParser, or
+     *         nullptr if there is none.
+     */
+    COMMAND_ENTRY* GetUsedCommand( argparse::ArgumentParser& aArgParser );
+
+    /**
+     * Parse a kicad-cli command line, given with or without the leading "kicad-cli".
+     *
+     * @param aError is set to the reason of the failure when no command is returned.
+     * @return the command to perform, or nullptr if the line is not a complete command.
+     */
+    COMMAND* Parse( const wxArrayString& aArgs, wxString& aError );
+
+    VERSION_COMMAND& Version() { return m_versionCmd; }
+
+private:
+    PCB_COMMAND                  m_pcbCmd;
+    PCB_DRC_COMMAND              m_pcbDrcCmd;
+    PCB_MEMORY_REPORT_COMMAND    m_pcbMemoryReportCmd;
+    PCB_EXPORT_DRILL_COMMAND     m_exportPcbDrillCmd;
+    PCB_EXPORT_DXF_COMMAND       m_exportPcbDxfCmd;
+    PCB_EXPORT_3D_COMMAND        m_exportPcbGlbCmd;
+    PCB_EXPORT_3D_COMMAND        m_exportPcbStepCmd;
+    PCB_EXPORT_3D_COMMAND        m_exportPcbVrmlCmd;
+    PCB_EXPORT_SVG_COMMAND       m_exportPcbSvgCmd;
+    PCB_EXPORT_PDF_COMMAND       m_exportPcbPdfCmd;
+    PCB_EXPORT_POS_COMMAND       m_exportPcbPosCmd;
+    PCB_EXPORT_GERBER_COMMAND    m_exportPcbGerberCmd;
+    PCB_EXPORT_GERBERS_COMMAND   m_exportPcbGerbersCmd;
+    PCB_EXPORT_COMMAND           m_exportPcbCmd;
+    SCH_EXPORT_COMMAND           m_exportSchCmd;
+    SCH_COMMAND                  m_schCmd;
+    SCH_ERC_COMMAND              m_schErcCmd;
+    SCH_EXPORT_BOM_COMMAND       m_exportSchBomCmd;
+    SCH_EXPORT_PYTHONBOM_COMMAND m_exportSchPythonBomCmd;
+    SCH_EXPORT_NETLIST_COMMAND   m_exportSchNetlistCmd;
+    SCH_EXPORT_PLOT_COMMAND      m_exportSchDxfCmd;
+    SCH_EXPORT_PLOT_COMMAND      m_exportSchHpglCmd;
+    SCH_EXPORT_PLOT_COMMAND      m_exportSchPdfCmd;
+    SCH_EXPORT_PLOT_COMMAND      m_exportSchPostscriptCmd;
+    SCH_EXPORT_PLOT_COMMAND      m_exportSchSvgCmd;
+    FP_COMMAND                   m_fpCmd;
+    FP_CONVERT_COMMAND           m_fpConvertCmd;
+    FP_EXPORT_COMMAND            m_fpExportCmd;
+    FP_EXPORT_SVG_COMMAND        m_fpExportSvgCmd;
+    FP_UPGRADE_COMMAND           m_fpUpgradeCmd;
+    GERBER_COMMAND               m_gerberCmd;
+    GERBER_DIFF_COMMAND          m_gerberDiffCmd;
+    JOBSET_COMMAND               m_jobsetCmd;
+    SERVER_COMMAND               m_serverCmd;
+    SYM_COMMAND                  m_symCmd;
+    SYM_CONVERT_COMMAND          m_symConvertCmd;
+    SYM_EXPORT_COMMAND           m_symExportCmd;
+    SYM_EXPORT_SVG_COMMAND       m_symExportSvgCmd;
+    SYM_UPGRADE_COMMAND          m_symUpgradeCmd;
+    VERSION_COMMAND              m_versionCmd;
+
+    std::vector<COMMAND_ENTRY>   m_commandStack;
+};
+
+}
+
+#endif
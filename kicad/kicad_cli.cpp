@@ -35,6 +35,7 @@
 #include <settings/kicad_settings.h>
 #include <systemdirsappend.h>
 #include <trace_helpers.h>
+#include <core/thread_pool.h>
 
 #include <stdexcept>
 
@@ -46,33 +47,7 @@
 #include <kiplatform/environment.h>
 #include <locale_io.h>
 
-#include "cli/command_pcb.h"
-#include "cli/command_pcb_export.h"
-#include "cli/command_pcb_drc.h"
-#include "cli/command_pcb_export_3d.h"
-#include "cli/command_pcb_export_drill.h"
-#include "cli/command_pcb_export_dxf.h"
-#include "cli/command_pcb_export_gerber.h"
-#include "cli/command_pcb_export_gerbers.h"
-#include "cli/command_pcb_export_pdf.h"
-#include "cli/command_pcb_export_pos.h"
-#include "cli/command_pcb_export_svg.h"
-#include "cli/command_sch_export_bom.h"
-#include "cli/command_sch_export_pythonbom.h"
-#include "cli/command_sch_export_netlist.h"
-#include "cli/command_sch_export_plot.h"
-#include "cli/command_fp.h"
-#include "cli/command_fp_export.h"
-#include "cli/command_fp_export_svg.h"
-#include "cli/command_fp_upgrade.h"
-#include "cli/command_sch.h"
-#include "cli/command_sch_erc.h"
-#include "cli/command_sch_export.h"
-#include "cli/command_sym.h"
-#include "cli/command_sym_export.h"
-#include "cli/command_sym_export_svg.h"
-#include "cli/command_sym_upgrade.h"
-#include "cli/command_version.h"
+#include "cli/command_set.h"
 #include "cli/exit_codes.h"
 
 // Add this header after all others, to avoid a collision name in a Windows header
@@ -114,164 +89,6 @@ PGM_KICAD& PgmTop()
 }
 
 
-struct COMMAND_ENTRY
-{
-    CLI::COMMAND* handler;
-
-    std::vector<COMMAND_ENTRY> subCommands;
-
-    COMMAND_ENTRY( CLI::COMMAND* aHandler ) : handler( aHandler ){};
-    COMMAND_ENTRY( CLI::COMMAND* aHandler, std::vector<COMMAND_ENTRY> aSub ) :
-            handler( aHandler ), subCommands( aSub ){};
-};
-
-static CLI::PCB_COMMAND                  pcbCmd{};
-static CLI::PCB_DRC_COMMAND              pcbDrcCmd{};
-static CLI::PCB_EXPORT_DRILL_COMMAND     exportPcbDrillCmd{};
-static CLI::PCB_EXPORT_DXF_COMMAND       exportPcbDxfCmd{};
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbGlbCmd{ "glb", UTF8STDSTR( _( "Export GLB (binary GLTF)" ) ), JOB_EXPORT_PCB_3D::FORMAT::GLB };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbStepCmd{ "step", UTF8STDSTR( _( "Export STEP" ) ), JOB_EXPORT_PCB_3D::FORMAT::STEP };
-static CLI::PCB_EXPORT_3D_COMMAND        exportPcbVrmlCmd{ "vrml", UTF8STDSTR( _( "Export VRML" ) ), JOB_EXPORT_PCB_3D::FORMAT::VRML };
-static CLI::PCB_EXPORT_SVG_COMMAND       exportPcbSvgCmd{};
-static CLI::PCB_EXPORT_PDF_COMMAND       exportPcbPdfCmd{};
-static CLI::PCB_EXPORT_POS_COMMAND       exportPcbPosCmd{};
-static CLI::PCB_EXPORT_GERBER_COMMAND    exportPcbGerberCmd{};
-static CLI::PCB_EXPORT_GERBERS_COMMAND   exportPcbGerbersCmd{};
-static CLI::PCB_EXPORT_COMMAND           exportPcbCmd{};
-static CLI::SCH_EXPORT_COMMAND           exportSchCmd{};
-static CLI::SCH_COMMAND                  schCmd{};
-static CLI::SCH_ERC_COMMAND              schErcCmd{};
-static CLI::SCH_EXPORT_BOM_COMMAND       exportSchBomCmd{};
-static CLI::SCH_EXPORT_PYTHONBOM_COMMAND exportSchPythonBomCmd{};
-static CLI::SCH_EXPORT_NETLIST_COMMAND   exportSchNetlistCmd{};
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchDxfCmd{ "dxf", UTF8STDSTR( _( "Export DXF" ) ), SCH_PLOT_FORMAT::DXF };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchHpglCmd{ "hpgl", UTF8STDSTR( _( "Export HPGL" ) ), SCH_PLOT_FORMAT::HPGL };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPdfCmd{ "pdf", UTF8STDSTR( _( "Export PDF" ) ), SCH_PLOT_FORMAT::PDF, false };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchPostscriptCmd{ "ps", UTF8STDSTR( _( "Export PS" ) ), SCH_PLOT_FORMAT::POST };
-static CLI::SCH_EXPORT_PLOT_COMMAND      exportSchSvgCmd{ "svg", UTF8STDSTR( _( "Export SVG" ) ), SCH_PLOT_FORMAT::SVG };
-static CLI::FP_COMMAND                   fpCmd{};
-static CLI::FP_EXPORT_COMMAND            fpExportCmd{};
-static CLI::FP_EXPORT_SVG_COMMAND        fpExportSvgCmd{};
-static CLI::FP_UPGRADE_COMMAND           fpUpgradeCmd{};
-static CLI::SYM_COMMAND                  symCmd{};
-static CLI::SYM_EXPORT_COMMAND           symExportCmd{};
-static CLI::SYM_EXPORT_SVG_COMMAND       symExportSvgCmd{};
-static CLI::SYM_UPGRADE_COMMAND          symUpgradeCmd{};
-static CLI::VERSION_COMMAND              versionCmd{};
-
-
-static std::vector<COMMAND_ENTRY> commandStack = {
-    {
-        &fpCmd,
-        {
-            {
-                &fpExportCmd,
-                {
-                    &fpExportSvgCmd
-                }
-            },
-            {
-                &fpUpgradeCmd
-            }
-        }
-    },
-    {
-        &pcbCmd,
-        {
-            {
-                &pcbDrcCmd
-            },
-            {
-                &exportPcbCmd,
-                {
-                    &exportPcbDrillCmd,
-                    &exportPcbDxfCmd,
-                    &exportPcbGerberCmd,
-                    &exportPcbGerbersCmd,
-                    &exportPcbGlbCmd,
-                    &exportPcbPdfCmd,
-                    &exportPcbPosCmd,
-                    &exportPcbStepCmd,
-                    &exportPcbSvgCmd,
-                    &exportPcbVrmlCmd
-                }
-            }
-        }
-    },
-    {
-        &schCmd,
-        {
-            {
-                &schErcCmd
-            },
-            {
-                &exportSchCmd,
-                {
-                    &exportSchDxfCmd,
-                    &exportSchHpglCmd,
-                    &exportSchNetlistCmd,
-                    &exportSchPdfCmd,
-                    &exportSchPostscriptCmd,
-                    &exportSchBomCmd,
-                    &exportSchPythonBomCmd,
-                    &exportSchSvgCmd
-                }
-            }
-        }
-    },
-    {
-        &symCmd,
-        {
-            {
-                &symExportCmd,
-                {
-                    &symExportSvgCmd
-                }
-            },
-            {
-                &symUpgradeCmd
-            }
-        }
-    },
-    {
-            &versionCmd,
-    }
-};
-
-
-static void recurseArgParserBuild( argparse::ArgumentParser& aArgParser, COMMAND_ENTRY& aEntry )
-{
-    aArgParser.add_subparser( aEntry.handler->GetArgParser() );
-
-    for( COMMAND_ENTRY& subEntry : aEntry.subCommands )
-    {
-        recurseArgParserBuild( aEntry.handler->GetArgParser(), subEntry );
-    }
-}
-
-
-static COMMAND_ENTRY* recurseArgParserSubCommandUsed( argparse::ArgumentParser& aArgParser,
-                                                      COMMAND_ENTRY&            aEntry )
-{
-    COMMAND_ENTRY* cliCmd = nullptr;
-
-    if( aArgParser.is_subcommand_used( aEntry.handler->GetName() ) )
-    {
-        for( COMMAND_ENTRY& subentry : aEntry.subCommands )
-        {
-            cliCmd = recurseArgParserSubCommandUsed( aEntry.handler->GetArgParser(), subentry );
-            if( cliCmd )
-                break;
-        }
-
-        if(!cliCmd)
-            cliCmd = &aEntry;
-    }
-
-    return cliCmd;
-}
-
-
 static void printHelp( argparse::ArgumentParser& argParser )
 {
     std::stringstream ss;
@@ -324,10 +141,15 @@ int PGM_KICAD::OnPgmRun()
             .implicit_value( true )
             .nargs( 0 );
 
-    for( COMMAND_ENTRY& entry : commandStack )
-    {
-        recurseArgParserBuild( argParser, entry );
-    }
+    argParser.add_argument( ARG_THREADS )
+            .help( UTF8STDSTR( _( "Maximum number of worker threads (0 for one per CPU core); "
+                                  "overrides the MaximumThreads advanced setting" ) ) )
+            .scan<'i', int>()
+            .default_value( -1 )
+            .metavar( "COUNT" );
+
+    CLI::COMMAND_SET commands;
+    commands.AddTo( argParser );
 
     try
     {
@@ -342,14 +164,7 @@ int PGM_KICAD::OnPgmRun()
         wxPrintf( "%s\n", err.what() );
 
         // find the correct argparser object to output the command usage info
-        COMMAND_ENTRY* cliCmd = nullptr;
-        for( COMMAND_ENTRY& entry : commandStack )
-        {
-            if( argParser.is_subcommand_used( entry.handler->GetName() ) )
-            {
-                cliCmd = recurseArgParserSubCommandUsed( argParser, entry );
-            }
-        }
+        CLI::COMMAND_ENTRY* cliCmd = commands.GetUsedCommand( argParser );
 
         // arg parser uses a stream overload for printing the help
         // we want to intercept so we can wxString the utf8 contents
@@ -373,28 +188,21 @@ int PGM_KICAD::OnPgmRun()
         return 0;
     }
 
+    if( int threads = argParser.get<int>( ARG_THREADS ); threads >= 0 )
+        SetKiCadThreadPoolSize( threads );
+
     CLI::COMMAND* cliCmd = nullptr;
 
     // the version arg gets redirected to the version subcommand
     if( argParser[ARG_VERSION] == true )
     {
-        cliCmd = &versionCmd;
+        cliCmd = &commands.Version();
     }
 
     if( !cliCmd )
     {
-        for( COMMAND_ENTRY& entry : commandStack )
-        {
-            if( argParser.is_subcommand_used( entry.handler->GetName() ) )
-            {
-                COMMAND_ENTRY* cmdSubEntry = recurseArgParserSubCommandUsed( argParser, entry );
-                if( cmdSubEntry != nullptr )
-                {
-                    cliCmd = cmdSubEntry->handler;
-                    break;
-                }
-            }
-        }
+        if( CLI::COMMAND_ENTRY* cmdSubEntry = commands.GetUsedCommand( argParser ) )
+            cliCmd = cmdSubEntry->handler;
     }
 
     if( cliCmd )
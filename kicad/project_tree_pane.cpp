@@ -26,6 +26,8 @@
 #include <stack>
 #include <git2.h>
 
+#include <wx/filename.h>
+
 #include <wx/regex.h>
 #include <wx/stdpaths.h>
 #include <wx/string.h>
@@ -44,6 +46,7 @@
 #include <wildcards_and_files_ext.h>
 #include <kiplatform/environment.h>
 #include <core/kicad_algo.h>
+#include <core/thread_pool.h>
 #include <paths.h>
 #include <project/project_local_settings.h>
 #include <scoped_set_reset.h>
@@ -184,6 +187,10 @@ PROJECT_TREE_PANE::PROJECT_TREE_PANE( KICAD_MANAGER_FRAME* parent ) :
     m_watcherNeedReset = false;
     m_lastGitStatusUpdate = wxDateTime::Now();
     m_gitLastError = GIT_ERROR_NONE;
+    m_gitStatusCache = std::make_unique<GIT_STATUS_CACHE>();
+    m_gitPendingFull = false;
+    m_gitResultsFull = false;
+    m_gitBranchError = GIT_ERROR_NONE;
 
     m_watcher = nullptr;
     Connect( wxEVT_FSWATCHER,
@@ -209,6 +216,10 @@ PROJECT_TREE_PANE::PROJECT_TREE_PANE( KICAD_MANAGER_FRAME* parent ) :
 PROJECT_TREE_PANE::~PROJECT_TREE_PANE()
 {
     shutdownFileWatcher();
+
+    // The task posts its results to us and uses the status cache
+    if( m_gitStatusTask.valid() )
+        m_gitStatusTask.wait();
 }
 
 
@@ -1089,8 +1100,10 @@ void PROJECT_TREE_PANE::onIdle( wxIdleEvent& aEvent )
         item->Activate( this );
     }
 
-    // Inside this routine, we rate limit to once per 2 seconds
-    updateGitStatusIcons();
+    // Pick up changes made outside of the watched directories (e.g. a commit from the command
+    // line).  The task only looks at HEAD and the index unless something was queued.
+    if( ( wxDateTime::Now() - m_lastGitStatusUpdate ).Abs() >= wxTimeSpan::Seconds( 2 ) )
+        startGitStatusTask();
 }
 
 
@@ -1150,6 +1163,9 @@ void PROJECT_TREE_PANE::onExpand( wxTreeEvent& Event )
 
         // Sort filenames by alphabetic order
         m_TreeProject->SortChildren( kid );
+
+        // Show the status we already know for the new items
+        applyGitStatus();
     }
 
 #ifndef __WINDOWS__
@@ -1260,12 +1276,16 @@ void PROJECT_TREE_PANE::onFileSystemEvent( wxFileSystemWatcherEvent& event )
     {
     case wxFSW_EVENT_DELETE:
     case wxFSW_EVENT_CREATE:
+        queueGitStatusUpdate( pathModified );
+        break;
+
     case wxFSW_EVENT_RENAME:
-        CallAfter( &PROJECT_TREE_PANE::updateGitStatusIcons );
+        queueGitStatusUpdate( pathModified );
+        queueGitStatusUpdate( event.GetNewPath() );
         break;
 
     case wxFSW_EVENT_MODIFY:
-        CallAfter( &PROJECT_TREE_PANE::updateGitStatusIcons );
+        queueGitStatusUpdate( pathModified );
         KI_FALLTHROUGH;
     case wxFSW_EVENT_ACCESS:
     default:
@@ -1857,176 +1877,339 @@ void PROJECT_TREE_PANE::onGitRemoveVCS( wxCommandEvent& aEvent )
 }
 
 
-void PROJECT_TREE_PANE::updateGitStatusIcons()
+/**
+ * State kept by the git status task between runs.  The task has its own repository handle, as
+ * libgit2 objects can't be shared between threads; it also keeps the repository's index loaded,
+ * which libgit2 only re-reads when the file changed on disk.
+ */
+struct GIT_STATUS_CACHE
 {
-    if( ADVANCED_CFG::GetCfg().m_EnableGit == false )
-        return;
-
-    if( !m_TreeProject )
-        return;
+    ~GIT_STATUS_CACHE()
+    {
+        if( m_repo )
+            git_repository_free( m_repo );
+    }
 
-    wxTimeSpan timeSinceLastUpdate = wxDateTime::Now() - m_lastGitStatusUpdate;
+    void Reset( const wxString& aWorkDir )
+    {
+        if( m_repo )
+            git_repository_free( m_repo );
 
-    if( timeSinceLastUpdate.Abs() < wxTimeSpan::Seconds( 2 ) )
-        return;
+        m_workDir = aWorkDir;
+        m_repo = nullptr;
+        m_head = {};
+        m_indexTime = wxDateTime();
+        m_branch.clear();
+        m_branchError = GIT_ERROR_NONE;
+        m_localChanges.clear();
+        m_remoteChanges.clear();
+    }
 
-    m_lastGitStatusUpdate = wxDateTime::Now();
+    wxString           m_workDir;
+    git_repository*    m_repo = nullptr;
+    git_oid            m_head = {};
+    wxDateTime         m_indexTime;
 
-    wxTreeItemId      kid = m_TreeProject->GetRootItem();
+    wxString           m_branch;
+    int                m_branchError = GIT_ERROR_NONE;
+    wxString           m_branchErrorMsg;
 
-    if( !kid.IsOk() )
-        return;
+    std::set<wxString> m_localChanges;      // committed locally but not pushed
+    std::set<wxString> m_remoteChanges;     // committed remotely but not pulled
+};
 
-    git_repository* repo = m_TreeProject->GetGitRepo();
 
-    if( !repo )
-        return;
+static KIGIT_COMMON::GIT_STATUS gitStatusFromFlags( unsigned aFlags, const wxString& aPath,
+                                                    const GIT_STATUS_CACHE& aCache )
+{
+    // If the file is modified/added/deleted, that is the main status we want to show.
+    // Otherwise check to see if the current commit is ahead/behind the remote.
+    if( aFlags & ( GIT_STATUS_INDEX_MODIFIED | GIT_STATUS_WT_MODIFIED ) )
+        return KIGIT_COMMON::GIT_STATUS::GIT_STATUS_MODIFIED;
+    else if( aFlags & ( GIT_STATUS_INDEX_NEW | GIT_STATUS_WT_NEW ) )
+        return KIGIT_COMMON::GIT_STATUS::GIT_STATUS_ADDED;
+    else if( aFlags & ( GIT_STATUS_INDEX_DELETED | GIT_STATUS_WT_DELETED ) )
+        return KIGIT_COMMON::GIT_STATUS::GIT_STATUS_DELETED;
+    else if( aCache.m_localChanges.count( aPath ) )
+        return KIGIT_COMMON::GIT_STATUS::GIT_STATUS_AHEAD;
+    else if( aCache.m_remoteChanges.count( aPath ) )
+        return KIGIT_COMMON::GIT_STATUS::GIT_STATUS_BEHIND;
+    else
+        return KIGIT_COMMON::GIT_STATUS::GIT_STATUS_CURRENT;
+}
 
-    // Get Current Branch
 
-    git_reference* currentBranchReference = nullptr;
-    git_repository_head( &currentBranchReference, repo );
+void PROJECT_TREE_PANE::updateGitStatusIcons()
+{
+    m_gitPendingFull = true;
+    startGitStatusTask();
+}
 
-    // Get the current branch name
-    if( currentBranchReference )
-    {
-        PROJECT_TREE_ITEM* rootItem = GetItemIdData( kid );
-        wxString filename = wxFileNameFromPath( rootItem->GetFileName() );
-        wxString branchName = git_reference_shorthand( currentBranchReference );
 
-        m_TreeProject->SetItemText( kid, filename + " [" + branchName + "]" );
-        git_reference_free( currentBranchReference );
-    }
+void PROJECT_TREE_PANE::queueGitStatusUpdate( const wxFileName& aPath )
+{
+    if( aPath.GetDirs().Index( wxT( ".git" ) ) != wxNOT_FOUND )
+        m_gitPendingFull = true;
     else
-    {
-        if( giterr_last()->klass != m_gitLastError )
-            wxLogError( "Failed to lookup current branch: %s", giterr_last()->message );
+        m_gitPendingPaths.insert( aPath.GetFullPath() );
 
-        m_gitLastError = giterr_last()->klass;
-    }
+    startGitStatusTask();
+}
 
-    // Collect a map to easily set the state of each item
-    std::map<wxString, wxTreeItemId> branchMap;
+
+void PROJECT_TREE_PANE::startGitStatusTask()
+{
+    if( ADVANCED_CFG::GetCfg().m_EnableGit == false )
+        return;
+
+    if( !m_TreeProject || !m_TreeProject->GetGitRepo() )
+        return;
+
+    // Still running: it will start us again when it posts its results
+    if( m_gitStatusTask.valid()
+            && m_gitStatusTask.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready )
     {
-        std::stack<wxTreeItemId> items;
-        items.push( kid );
+        return;
+    }
 
-        while( !items.empty() )
-        {
-            kid = items.top();
-            items.pop();
+    const char* workdir = git_repository_workdir( m_TreeProject->GetGitRepo() );
 
-            PROJECT_TREE_ITEM* nextItem = GetItemIdData( kid );
+    if( !workdir )
+        return;
+
+    bool               full = m_gitPendingFull;
+    std::set<wxString> paths;
 
-            branchMap[nextItem->GetFileName()] = kid;
+    // Many files changing at once (a checkout, a library update) is cheaper to handle as one
+    // status of the whole repository
+    if( m_gitPendingPaths.size() > 200 )
+        full = true;
+    else if( !full )
+        paths.swap( m_gitPendingPaths );
 
-            wxTreeItemIdValue cookie;
-            wxTreeItemId      child = m_TreeProject->GetFirstChild( kid, cookie );
+    m_gitPendingPaths.clear();
+    m_gitPendingFull = false;
+    m_lastGitStatusUpdate = wxDateTime::Now();
 
-            while( child.IsOk() )
+    m_gitStatusTask = GetKiCadThreadPool().submit(
+            [this, dir = wxString::FromUTF8( workdir ), full, paths]()
             {
-                items.push( child );
-                child = m_TreeProject->GetNextChild( kid, cookie );
-            }
-        }
-    }
+                computeGitStatus( dir, full, paths );
+            } );
+}
 
-    git_status_options status_options = GIT_STATUS_OPTIONS_INIT;
-    status_options.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
-    status_options.flags = GIT_STATUS_OPT_INCLUDE_UNTRACKED | GIT_STATUS_OPT_INCLUDE_UNMODIFIED;
 
-    git_index* index = nullptr;
+void PROJECT_TREE_PANE::computeGitStatus( const wxString& aWorkDir, bool aFull,
+                                          std::set<wxString> aPaths )
+{
+    GIT_STATUS_CACHE& cache = *m_gitStatusCache;
 
-    if( git_repository_index( &index, repo ) != GIT_OK )
+    if( cache.m_workDir != aWorkDir || !cache.m_repo )
     {
-        m_gitLastError = giterr_last()->klass;
-        wxLogDebug( "Failed to get git index: %s", giterr_last()->message );
-        return;
-    }
+        cache.Reset( aWorkDir );
 
-    git_status_list* status_list = nullptr;
+        if( git_repository_open( &cache.m_repo, aWorkDir.utf8_str() ) != GIT_OK )
+        {
+            wxLogDebug( "Failed to open repository for status: %s", giterr_last()->message );
+            cache.m_repo = nullptr;
+            return;
+        }
 
-    if( git_status_list_new( &status_list, repo, &status_options ) != GIT_OK )
-    {
-        wxLogDebug( "Failed to get git status list: %s", giterr_last()->message );
-        git_index_free( index );
-        return;
+        aFull = true;
     }
 
-    auto [ localChanges, remoteChanges ] = m_TreeProject->GitCommon()->GetDifferentFiles();
+    git_repository* repo = cache.m_repo;
 
-    size_t count = git_status_list_entrycount( status_list );
+    // A commit, checkout or staging done elsewhere changes HEAD or the index without touching
+    // the files we watch
+    git_oid head = {};
+    git_reference_name_to_id( &head, repo, "HEAD" );
 
-    for( size_t ii = 0; ii < count; ++ii )
-    {
-        const git_status_entry* entry = git_status_byindex( status_list, ii );
-        std::string path( entry->head_to_index? entry->head_to_index->old_file.path
-                        : entry->index_to_workdir->old_file.path );
-        wxFileName fn( path );
-        fn.MakeAbsolute( git_repository_workdir( repo ) );
+    wxFileName indexFile( wxString::FromUTF8( git_repository_path( repo ) ), wxT( "index" ) );
+    wxDateTime indexTime = indexFile.FileExists() ? indexFile.GetModificationTime()
+                                                  : wxDateTime();
 
-        auto iter = branchMap.find( fn.GetFullPath() );
+    if( !git_oid_equal( &head, &cache.m_head ) || !( indexTime == cache.m_indexTime ) )
+        aFull = true;
 
-        if( iter == branchMap.end() )
-            continue;
+    if( !aFull && aPaths.empty() )
+        return;
+
+    std::map<wxString, int> results;
 
-        // If we are current, don't continue because we still need to check to see if the
-        // current commit is ahead/behind the remote.  If the file is modified/added/deleted,
-        // that is the main status we want to show.
-        if( entry->status == GIT_STATUS_CURRENT )
+    if( aFull )
+    {
+        cache.m_head = head;
+        cache.m_indexTime = indexTime;
+
+        git_reference* currentBranchReference = nullptr;
+        git_repository_head( &currentBranchReference, repo );
+
+        if( currentBranchReference )
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_CURRENT ) );
+            cache.m_branch = git_reference_shorthand( currentBranchReference );
+            cache.m_branchError = GIT_ERROR_NONE;
+            git_reference_free( currentBranchReference );
         }
-        else if( entry->status & ( GIT_STATUS_INDEX_MODIFIED | GIT_STATUS_WT_MODIFIED ) )
+        else
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_MODIFIED ) );
-            continue;
+            cache.m_branch.clear();
+            cache.m_branchError = giterr_last()->klass;
+            cache.m_branchErrorMsg = giterr_last()->message;
         }
-        else if( entry->status & ( GIT_STATUS_INDEX_NEW | GIT_STATUS_WT_NEW ) )
+
+        KIGIT_COMMON common( repo );
+        std::tie( cache.m_localChanges, cache.m_remoteChanges ) = common.GetDifferentFiles();
+
+        git_status_options status_options = GIT_STATUS_OPTIONS_INIT;
+        status_options.show = GIT_STATUS_SHOW_INDEX_AND_WORKDIR;
+        status_options.flags = GIT_STATUS_OPT_INCLUDE_UNTRACKED | GIT_STATUS_OPT_INCLUDE_UNMODIFIED;
+
+        git_status_list* status_list = nullptr;
+
+        if( git_status_list_new( &status_list, repo, &status_options ) != GIT_OK )
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_ADDED ) );
-            continue;
+            wxLogDebug( "Failed to get git status list: %s", giterr_last()->message );
+            return;
         }
-        else if( entry->status & ( GIT_STATUS_INDEX_DELETED | GIT_STATUS_WT_DELETED ) )
+
+        size_t count = git_status_list_entrycount( status_list );
+
+        for( size_t ii = 0; ii < count; ++ii )
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_DELETED ) );
-            continue;
+            const git_status_entry* entry = git_status_byindex( status_list, ii );
+            wxString path = wxString::FromUTF8( entry->head_to_index
+                                                        ? entry->head_to_index->old_file.path
+                                                        : entry->index_to_workdir->old_file.path );
+            wxFileName fn( path );
+            fn.MakeAbsolute( aWorkDir );
+
+            results[fn.GetFullPath()] =
+                    static_cast<int>( gitStatusFromFlags( entry->status, path, cache ) );
         }
 
-        // Check if file is up to date with the remote
-        if( localChanges.count( path ) )
+        git_status_list_free( status_list );
+    }
+    else
+    {
+        for( const wxString& file : aPaths )
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_AHEAD ) );
-            continue;
+            wxFileName fn( file );
+
+            if( !fn.MakeRelativeTo( aWorkDir ) || fn.GetFullPath().StartsWith( wxT( ".." ) ) )
+                continue;
+
+            wxString     path = fn.GetFullPath( wxPATH_UNIX );
+            unsigned int flags = 0;
+
+            // Fails for directories and for files which vanished without ever being tracked,
+            // neither of which has a status to show
+            if( git_status_file( &flags, repo, path.utf8_str() ) != GIT_OK
+                    || ( flags & GIT_STATUS_IGNORED ) )
+            {
+                continue;
+            }
+
+            results[file] = static_cast<int>( gitStatusFromFlags( flags, path, cache ) );
         }
-        else if( remoteChanges.count( path ) )
+    }
+
+    {
+        std::lock_guard<std::mutex> lock( m_gitResultsMutex );
+
+        if( aFull )
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_BEHIND ) );
-            continue;
+            m_gitResults = std::move( results );
+            m_gitResultsFull = true;
         }
         else
         {
-            m_TreeProject->SetItemState(
-                    iter->second,
-                    static_cast<int>( KIGIT_COMMON::GIT_STATUS::GIT_STATUS_CURRENT ) );
-            continue;
+            for( const auto& [file, status] : results )
+                m_gitResults[file] = status;
         }
+
+        m_gitBranchResult = cache.m_branch;
+        m_gitBranchError = cache.m_branchError;
+        m_gitBranchErrorMsg = cache.m_branchErrorMsg;
     }
 
-    git_status_list_free( status_list );
-    git_index_free( index );
+    CallAfter( &PROJECT_TREE_PANE::applyGitStatus );
+}
+
+
+void PROJECT_TREE_PANE::applyGitStatus()
+{
+    {
+        std::lock_guard<std::mutex> lock( m_gitResultsMutex );
+
+        if( m_gitResultsFull )
+            m_gitFileStatus.clear();
+
+        for( const auto& [file, status] : m_gitResults )
+            m_gitFileStatus[file] = status;
+
+        m_gitResults.clear();
+        m_gitResultsFull = false;
+
+        if( m_gitBranchError != GIT_ERROR_NONE )
+        {
+            if( m_gitBranchError != m_gitLastError )
+                wxLogError( "Failed to lookup current branch: %s", m_gitBranchErrorMsg );
+
+            m_gitLastError = m_gitBranchError;
+        }
+
+        m_gitBranchName = m_gitBranchResult;
+    }
+
+    // Changes seen while the task was running
+    if( m_gitPendingFull || !m_gitPendingPaths.empty() )
+        startGitStatusTask();
+
+    if( !m_TreeProject )
+        return;
+
+    wxTreeItemId kid = m_TreeProject->GetRootItem();
+
+    if( !kid.IsOk() )
+        return;
+
+    if( !m_gitBranchName.IsEmpty() )
+    {
+        PROJECT_TREE_ITEM* rootItem = GetItemIdData( kid );
+        wxString filename = wxFileNameFromPath( rootItem->GetFileName() );
+
+        m_TreeProject->SetItemText( kid, filename + " [" + m_gitBranchName + "]" );
+    }
+
+    std::stack<wxTreeItemId> items;
+    items.push( kid );
+
+    while( !items.empty() )
+    {
+        kid = items.top();
+        items.pop();
+
+        if( PROJECT_TREE_ITEM* nextItem = GetItemIdData( kid ) )
+        {
+            auto iter = m_gitFileStatus.find( nextItem->GetFileName() );
+
+            if( iter != m_gitFileStatus.end()
+                    && m_TreeProject->GetItemState( kid ) != iter->second )
+            {
+                m_TreeProject->SetItemState( kid, iter->second );
+            }
+        }
+
+        wxTreeItemIdValue cookie;
+        wxTreeItemId      child = m_TreeProject->GetFirstChild( kid, cookie );
+
+        while( child.IsOk() )
+        {
+            items.push( child );
+            child = m_TreeProject->GetNextChild( kid, cookie );
+        }
+    }
 }
 
 
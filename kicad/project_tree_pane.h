@@ -30,6 +30,11 @@
 #ifndef TREEPRJ_FRAME_H
 #define TREEPRJ_FRAME_H
 
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
 #include <vector>
 #include <wx/datetime.h>
 #include <wx/fswatcher.h>
@@ -42,6 +47,7 @@
 class KICAD_MANAGER_FRAME;
 class PROJECT_TREE_ITEM;
 class PROJECT_TREE;
+struct GIT_STATUS_CACHE;
 
 /** PROJECT_TREE_PANE
  * Window to display the tree files
@@ -221,10 +227,37 @@ private:
     void onGitRevertLocal( wxCommandEvent& event );
 
     /**
-     * Updates the icons shown in the tree project to reflect the current git status
+     * Updates the icons shown in the tree project to reflect the current git status.
+     *
+     * The status of the whole repository is computed on a worker thread, and the icons are
+     * updated once it is ready.
     */
     void updateGitStatusIcons();
 
+    /**
+     * Queue a git status update of a single file, e.g. after the file system watcher saw it
+     * change.  Changes inside the .git directory queue a full update.
+     */
+    void queueGitStatusUpdate( const wxFileName& aPath );
+
+    /**
+     * Start a git status task for the queued updates, unless one is already running (it will
+     * be started again once the running one completes).  With nothing queued, the task only
+     * checks whether HEAD or the index changed behind our back.
+     */
+    void startGitStatusTask();
+
+    /**
+     * Run on a worker thread: compute the status of the queued files, or of the whole
+     * repository, and post the changes to applyGitStatus().
+     */
+    void computeGitStatus( const wxString& aWorkDir, bool aFull, std::set<wxString> aPaths );
+
+    /**
+     * Merge the results of the last git status task and set the tree icons from them.
+     */
+    void applyGitStatus();
+
     /**
      * Returns true if the current project has any uncommitted changes
     */
@@ -294,6 +327,21 @@ private:
     wxDateTime              m_lastGitStatusUpdate;
     int                     m_gitLastError;
 
+    std::unique_ptr<GIT_STATUS_CACHE> m_gitStatusCache;  // only used by the git status task
+    std::future<void>       m_gitStatusTask;
+    bool                    m_gitPendingFull;   // a full status update is queued
+    std::set<wxString>      m_gitPendingPaths;  // files queued for a status update
+
+    std::mutex              m_gitResultsMutex;  // guards the results below, set by the task
+    std::map<wxString, int> m_gitResults;       // status changes by absolute file name
+    bool                    m_gitResultsFull;   // m_gitResults replaces all previous statuses
+    wxString                m_gitBranchResult;
+    int                     m_gitBranchError;
+    wxString                m_gitBranchErrorMsg;
+
+    std::map<wxString, int> m_gitFileStatus;    // status shown, by absolute file name
+    wxString                m_gitBranchName;
+
     DECLARE_EVENT_TABLE()
 };
 
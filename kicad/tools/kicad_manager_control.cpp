@@ -804,7 +804,7 @@ int KICAD_MANAGER_CONTROL::ShowPlayer( const TOOL_EVENT& aEvent )
     if( wxWindow::FindFocus() != player )
         player->SetFocus();
 
-    // Save window state to disk now.  Don't wait around for a crash.
+    // Save window state to disk soon.  Don't wait around for a crash.
     if( Pgm().GetCommonSettings()->m_Session.remember_open_files
             && !player->GetCurrentFileName().IsEmpty() )
     {
@@ -815,7 +815,8 @@ int KICAD_MANAGER_CONTROL::ShowPlayer( const TOOL_EVENT& aEvent )
         player->SaveWindowSettings( &windowSettings );
 
         Prj().GetLocalSettings().SaveFileState( rfn.GetFullPath(), &windowSettings, true );
-        Prj().GetLocalSettings().SaveToFile( Prj().GetProjectPath() );
+        Pgm().GetSettingsManager().SaveDeferred( &Prj().GetLocalSettings(),
+                                                 Prj().GetProjectPath() );
     }
 
     return 0;
@@ -0,0 +1,463 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+
+/**
+ * A std::vector work-alike which keeps up to \a N elements inside the object itself.
+ *
+ * Only containers growing past \a N elements allocate.  This suits the many short sequences
+ * created in the hot paths (pad, via and track hull outlines) which would otherwise each cost a
+ * heap allocation and a cache miss.
+ *
+ * The interface is the subset of std::vector's used in KiCad.  As with std::vector, iterators
+ * and references are invalidated by any operation that changes the capacity; unlike
+ * std::vector, moving a container holding inline elements moves the elements themselves and
+ * their addresses change.
+ */
+template <typename T, size_t N>
+class SMALL_VECTOR
+{
+public:
+    typedef T                                     value_type;
+    typedef size_t                                size_type;
+    typedef ptrdiff_t                             difference_type;
+    typedef T&                                    reference;
+    typedef const T&                              const_reference;
+    typedef T*                                    pointer;
+    typedef const T*                              const_pointer;
+    typedef T*                                    iterator;
+    typedef const T*                              const_iterator;
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    static_assert( N > 0, "SMALL_VECTOR needs an inline capacity" );
+
+    SMALL_VECTOR() :
+            m_data( inlineData() ),
+            m_size( 0 ),
+            m_capacity( N )
+    {}
+
+    explicit SMALL_VECTOR( size_type aCount, const T& aValue = T() ) :
+            SMALL_VECTOR()
+    {
+        assign( aCount, aValue );
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    SMALL_VECTOR( InputIt aFirst, InputIt aLast ) :
+            SMALL_VECTOR()
+    {
+        assign( aFirst, aLast );
+    }
+
+    SMALL_VECTOR( std::initializer_list<T> aList ) :
+            SMALL_VECTOR()
+    {
+        assign( aList.begin(), aList.end() );
+    }
+
+    SMALL_VECTOR( const SMALL_VECTOR& aOther ) :
+            SMALL_VECTOR()
+    {
+        assign( aOther.begin(), aOther.end() );
+    }
+
+    SMALL_VECTOR( SMALL_VECTOR&& aOther ) noexcept( std::is_nothrow_move_constructible<T>::value ) :
+            SMALL_VECTOR()
+    {
+        steal( std::move( aOther ) );
+    }
+
+    ~SMALL_VECTOR()
+    {
+        clear();
+        release();
+    }
+
+    SMALL_VECTOR& operator=( const SMALL_VECTOR& aOther )
+    {
+        if( this != &aOther )
+            assign( aOther.begin(), aOther.end() );
+
+        return *this;
+    }
+
+    SMALL_VECTOR& operator=( SMALL_VECTOR&& aOther )
+            noexcept( std::is_nothrow_move_constructible<T>::value )
+    {
+        if( this != &aOther )
+        {
+            clear();
+            steal( std::move( aOther ) );
+        }
+
+        return *this;
+    }
+
+    SMALL_VECTOR& operator=( std::initializer_list<T> aList )
+    {
+        assign( aList.begin(), aList.end() );
+        return *this;
+    }
+
+    void assign( size_type aCount, const T& aValue )
+    {
+        // aValue may be one of our own elements
+        T value( aValue );
+
+        clear();
+        reserve( aCount );
+        std::uninitialized_fill_n( m_data, aCount, value );
+        m_size = aCount;
+    }
+
+    template <typename InputIt,
+              typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    void assign( InputIt aFirst, InputIt aLast )
+    {
+        clear();
+
+        if constexpr( std::is_base_of<std::forward_iterator_tag,
+                              typename std::iterator_traits<InputIt>::iterator_category>::value )
+        {
+            reserve( std::distance( aFirst, aLast ) );
+            std::uninitialized_copy( aFirst, aLast, m_data );
+            m_size = std::distance( aFirst, aLast );
+        }
+        else
+        {
+            for( ; aFirst != aLast; ++aFirst )
+                emplace_back( *aFirst );
+        }
+    }
+
+    iterator               begin()         { return m_data; }
+    const_iterator         begin() const   { return m_data; }
+    const_iterator         cbegin() const  { return m_data; }
+    iterator               end()           { return m_data + m_size; }
+    const_iterator         end() const     { return m_data + m_size; }
+    const_iterator         cend() const    { return m_data + m_size; }
+    reverse_iterator       rbegin()        { return reverse_iterator( end() ); }
+    const_reverse_iterator rbegin() const  { return const_reverse_iterator( end() ); }
+    reverse_iterator       rend()          { return reverse_iterator( begin() ); }
+    const_reverse_iterator rend() const    { return const_reverse_iterator( begin() ); }
+
+    size_type size() const      { return m_size; }
+    size_type capacity() const  { return m_capacity; }
+    bool      empty() const     { return m_size == 0; }
+
+    /**
+     * @return true if the elements are stored inside the object, i.e. nothing was allocated.
+     */
+    bool IsInline() const { return m_data == inlineData(); }
+
+    T*       data()       { return m_data; }
+    const T* data() const { return m_data; }
+
+    T&       operator[]( size_type aIndex )       { return m_data[aIndex]; }
+    const T& operator[]( size_type aIndex ) const { return m_data[aIndex]; }
+
+    T& at( size_type aIndex )
+    {
+        if( aIndex >= m_size )
+            throw std::out_of_range( "SMALL_VECTOR::at" );
+
+        return m_data[aIndex];
+    }
+
+    const T& at( size_type aIndex ) const
+    {
+        if( aIndex >= m_size )
+            throw std::out_of_range( "SMALL_VECTOR::at" );
+
+        return m_data[aIndex];
+    }
+
+    T&       front()       { return m_data[0]; }
+    const T& front() const { return m_data[0]; }
+    T&       back()        { return m_data[m_size - 1]; }
+    const T& back() const  { return m_data[m_size - 1]; }
+
+    void reserve( size_type aCapacity )
+    {
+        if( aCapacity > m_capacity )
+            reallocate( aCapacity );
+    }
+
+    void shrink_to_fit()
+    {
+        if( !IsInline() && m_size < m_capacity )
+            reallocate( m_size );
+    }
+
+    void clear()
+    {
+        std::destroy( m_data, m_data + m_size );
+        m_size = 0;
+    }
+
+    void resize( size_type aCount )
+    {
+        if( aCount < m_size )
+        {
+            std::destroy( m_data + aCount, m_data + m_size );
+        }
+        else if( aCount > m_size )
+        {
+            reserve( aCount );
+            std::uninitialized_value_construct( m_data + m_size, m_data + aCount );
+        }
+
+        m_size = aCount;
+    }
+
+    void resize( size_type aCount, const T& aValue )
+    {
+        if( aCount <= m_size )
+        {
+            resize( aCount );
+            return;
+        }
+
+        T value( aValue );
+
+        reserve( aCount );
+        std::uninitialized_fill( m_data + m_size, m_data + aCount, value );
+        m_size = aCount;
+    }
+
+    void push_back( const T& aValue ) { emplace_back( aValue ); }
+    void push_back( T&& aValue )      { emplace_back( std::move( aValue ) ); }
+
+    template <typename... Args>
+    T& emplace_back( Args&&... aArgs )
+    {
+        if( m_size == m_capacity )
+        {
+            // The arguments may refer to our own elements, so build the new one first
+            T value( std::forward<Args>( aArgs )... );
+
+            reallocate( grownCapacity( m_size + 1 ) );
+            ::new( static_cast<void*>( m_data + m_size ) ) T( std::move( value ) );
+        }
+        else
+        {
+            ::new( static_cast<void*>( m_data + m_size ) ) T( std::forward<Args>( aArgs )... );
+        }
+
+        return m_data[m_size++];
+    }
+
+    void pop_back()
+    {
+        std::destroy_at( m_data + --m_size );
+    }
+
+    iterator insert( const_iterator aPos, const T& aValue )
+    {
+        size_type index = aPos - m_data;
+        emplace_back( aValue );
+        std::rotate( m_data + index, m_data + m_size - 1, m_data + m_size );
+        return m_data + index;
+    }
+
+    iterator insert( const_iterator aPos, T&& aValue )
+    {
+        size_type index = aPos - m_data;
+        emplace_back( std::move( aValue ) );
+        std::rotate( m_data + index, m_data + m_size - 1, m_data + m_size );
+        return m_data + index;
+    }
+
+    iterator insert( const_iterator aPos, size_type aCount, const T& aValue )
+    {
+        size_type index = aPos - m_data;
+        size_type oldSize = m_size;
+
+        resize( m_size + aCount, aValue );
+        std::rotate( m_data + index, m_data + oldSize, m_data + m_size );
+        return m_data + index;
+    }
+
+    /**
+     * Insert a copy of [\a aFirst, \a aLast) before \a aPos.  As with std::vector, the range
+     * must not be part of this container.
+     */
+    template <typename InputIt,
+              typename = std::enable_if_t<!std::is_integral<InputIt>::value>>
+    iterator insert( const_iterator aPos, InputIt aFirst, InputIt aLast )
+    {
+        size_type index = aPos - m_data;
+        size_type oldSize = m_size;
+
+        if constexpr( std::is_base_of<std::forward_iterator_tag,
+                              typename std::iterator_traits<InputIt>::iterator_category>::value )
+        {
+            size_type count = std::distance( aFirst, aLast );
+
+            if( m_size + count > m_capacity )
+                reallocate( grownCapacity( m_size + count ) );
+
+            std::uninitialized_copy( aFirst, aLast, m_data + m_size );
+            m_size += count;
+        }
+        else
+        {
+            for( ; aFirst != aLast; ++aFirst )
+                emplace_back( *aFirst );
+        }
+
+        std::rotate( m_data + index, m_data + oldSize, m_data + m_size );
+        return m_data + index;
+    }
+
+    iterator insert( const_iterator aPos, std::initializer_list<T> aList )
+    {
+        return insert( aPos, aList.begin(), aList.end() );
+    }
+
+    iterator erase( const_iterator aPos )
+    {
+        return erase( aPos, aPos + 1 );
+    }
+
+    iterator erase( const_iterator aFirst, const_iterator aLast )
+    {
+        iterator first = m_data + ( aFirst - m_data );
+        iterator last = m_data + ( aLast - m_data );
+
+        if( first != last )
+        {
+            iterator newEnd = std::move( last, end(), first );
+            std::destroy( newEnd, end() );
+            m_size = newEnd - m_data;
+        }
+
+        return first;
+    }
+
+    void swap( SMALL_VECTOR& aOther )
+    {
+        SMALL_VECTOR tmp( std::move( aOther ) );
+        aOther = std::move( *this );
+        *this = std::move( tmp );
+    }
+
+    bool operator==( const SMALL_VECTOR& aOther ) const
+    {
+        return m_size == aOther.m_size && std::equal( begin(), end(), aOther.begin() );
+    }
+
+    bool operator!=( const SMALL_VECTOR& aOther ) const
+    {
+        return !( *this == aOther );
+    }
+
+private:
+    T* inlineData() { return reinterpret_cast<T*>( m_inline ); }
+
+    const T* inlineData() const { return reinterpret_cast<const T*>( m_inline ); }
+
+    size_type grownCapacity( size_type aMinCapacity ) const
+    {
+        return std::max( aMinCapacity, 2 * m_capacity );
+    }
+
+    /**
+     * Move the elements to a buffer of \a aCapacity elements, which must be enough for them.
+     * The inline buffer is used again whenever it is enough.
+     */
+    void reallocate( size_type aCapacity )
+    {
+        T* buffer = aCapacity <= N ? inlineData()
+                                   : static_cast<T*>( ::operator new( aCapacity * sizeof( T ) ) );
+
+        if( buffer == m_data )
+            return;
+
+        std::uninitialized_move( m_data, m_data + m_size, buffer );
+        std::destroy( m_data, m_data + m_size );
+        release();
+
+        m_data = buffer;
+        m_capacity = std::max( aCapacity, N );
+    }
+
+    /// Free the heap buffer, if any.  The elements must have been destroyed or moved out.
+    void release()
+    {
+        if( !IsInline() )
+        {
+            ::operator delete( m_data );
+            m_data = inlineData();
+            m_capacity = N;
+        }
+    }
+
+    /// Take over the elements of \a aOther, which must be empty afterwards.  We must be empty.
+    void steal( SMALL_VECTOR&& aOther )
+    {
+        release();
+
+        if( aOther.IsInline() )
+        {
+            std::uninitialized_move( aOther.begin(), aOther.end(), m_data );
+            m_size = aOther.m_size;
+            aOther.clear();
+        }
+        else
+        {
+            m_data = aOther.m_data;
+            m_size = aOther.m_size;
+            m_capacity = aOther.m_capacity;
+
+            aOther.m_data = aOther.inlineData();
+            aOther.m_size = 0;
+            aOther.m_capacity = N;
+        }
+    }
+
+    T*        m_data;
+    size_type m_size;
+    size_type m_capacity;
+
+    alignas( T ) unsigned char m_inline[N * sizeof( T )];
+};
+
+
+#endif // SMALL_VECTOR_H
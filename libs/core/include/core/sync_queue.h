@@ -1,7 +1,7 @@
 /*
  * This program source code file is part of KiCad, a free EDA CAD application.
  *
- * Copyright (C) 2017-2020 KiCad Developers, see AUTHORS.txt for contributors.
+ * Copyright (C) 2017-2024 KiCad Developers, see AUTHORS.txt for contributors.
  *
  * This program is free software: you can redistribute it and/or modify it
  * under the terms of the GNU General Public License as published by the
@@ -20,19 +20,48 @@
 #ifndef SYNC_QUEUE_H
 #define SYNC_QUEUE_H
 
-#include <mutex>
-#include <queue>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
 
 /**
- * Synchronized, locking queue. Safe for multiple producer/multiple consumer environments with
- * nontrivial data (though bear in mind data needs to be copied in and out).
+ * Synchronized, lock-free queue. Safe for multiple producer/multiple consumer environments with
+ * nontrivial data (though bear in mind data needs to be copied or moved in and out).
+ *
+ * This is a Michael & Scott linked queue.  Nodes unlinked by pop() are not freed immediately
+ * since another thread may still be looking at them; they are parked on a retire list which is
+ * released the next time no operation is in progress on the queue.
  */
 template <typename T>
 class SYNC_QUEUE
 {
 public:
-    SYNC_QUEUE()
+    SYNC_QUEUE() :
+            m_size( 0 ),
+            m_active( 0 ),
+            m_retired( nullptr )
+    {
+        NODE* dummy = new NODE();
+        m_head.store( dummy );
+        m_tail.store( dummy );
+    }
+
+    SYNC_QUEUE( const SYNC_QUEUE& ) = delete;
+    SYNC_QUEUE& operator=( const SYNC_QUEUE& ) = delete;
+
+    ~SYNC_QUEUE()
     {
+        NODE* node = m_head.load();
+
+        while( node )
+        {
+            NODE* next = node->m_next.load();
+            delete node;
+            node = next;
+        }
+
+        freeRetired( m_retired.load() );
     }
 
     /**
@@ -40,8 +69,7 @@ public:
      */
     void push( T const& aValue )
     {
-        GUARD guard( m_mutex );
-        m_queue.push( aValue );
+        enqueue( new NODE( aValue ) );
     }
 
     /**
@@ -49,8 +77,7 @@ public:
      */
     void move_push( T&& aValue )
     {
-        GUARD guard( m_mutex );
-        m_queue.push( std::move( aValue ) );
+        enqueue( new NODE( std::move( aValue ) ) );
     }
 
     /**
@@ -62,17 +89,36 @@ public:
      */
     bool pop( T& aReceiver )
     {
-        GUARD guard( m_mutex );
+        OPERATION op( *this );
 
-        if( m_queue.empty() )
-        {
-            return false;
-        }
-        else
+        while( true )
         {
-            aReceiver = std::move( m_queue.front() );
-            m_queue.pop();
-            return true;
+            NODE* head = m_head.load();
+            NODE* next = head->m_next.load();
+
+            if( !next )
+                return false;
+
+            NODE* tail = m_tail.load();
+
+            // Never let the head overtake a lagging tail: help the producer finish instead
+            if( head == tail )
+            {
+                m_tail.compare_exchange_weak( tail, next );
+                continue;
+            }
+
+            if( m_head.compare_exchange_weak( head, next ) )
+            {
+                // next is the new dummy node; winning the exchange makes us the only owner of
+                // its value
+                aReceiver = std::move( *next->m_value );
+                next->m_value.reset();
+                m_size.fetch_sub( 1 );
+
+                retire( head );
+                return true;
+            }
         }
     }
 
@@ -81,17 +127,18 @@ public:
      */
     bool empty() const
     {
-        GUARD guard( m_mutex );
-        return m_queue.empty();
+        OPERATION op( *this );
+        return m_head.load()->m_next.load() == nullptr;
     }
 
     /**
      * Return the size of the queue.
+     *
+     * The value is exact when no other thread is pushing or popping and a snapshot otherwise.
      */
     size_t size() const
     {
-        GUARD guard( m_mutex );
-        return m_queue.size();
+        return m_size.load();
     }
 
     /**
@@ -99,19 +146,133 @@ public:
      */
     void clear()
     {
-        GUARD guard( m_mutex );
+        T dummy;
 
-        while( !m_queue.empty() )
+        while( pop( dummy ) )
         {
-            m_queue.pop();
         }
     }
 
 private:
-    typedef std::lock_guard<std::mutex> GUARD;
+    struct NODE
+    {
+        NODE() :
+                m_next( nullptr ),
+                m_nextRetired( nullptr )
+        {}
+
+        template <typename U>
+        explicit NODE( U&& aValue ) :
+                m_next( nullptr ),
+                m_value( std::forward<U>( aValue ) ),
+                m_nextRetired( nullptr )
+        {}
+
+        std::atomic<NODE*> m_next;
+        std::optional<T>   m_value;
+        NODE*              m_nextRetired;   ///< Retire list link; m_next may still be read
+    };
+
+    /**
+     * Marks the lifetime of a push, pop or empty query.  The thread leaving the queue last
+     * frees whatever was retired before it left.
+     */
+    class OPERATION
+    {
+    public:
+        OPERATION( const SYNC_QUEUE& aQueue ) :
+                m_queue( const_cast<SYNC_QUEUE&>( aQueue ) )
+        {
+            m_queue.m_active.fetch_add( 1 );
+        }
+
+        ~OPERATION()
+        {
+            m_queue.leave();
+        }
+
+    private:
+        SYNC_QUEUE& m_queue;
+    };
+
+    void enqueue( NODE* aNode )
+    {
+        OPERATION op( *this );
+
+        // Count before linking so that a concurrent pop() can never take the size below zero
+        m_size.fetch_add( 1 );
+
+        while( true )
+        {
+            NODE* tail = m_tail.load();
+            NODE* next = tail->m_next.load();
+
+            if( next )
+            {
+                m_tail.compare_exchange_weak( tail, next );
+                continue;
+            }
+
+            if( tail->m_next.compare_exchange_weak( next, aNode ) )
+            {
+                m_tail.compare_exchange_strong( tail, aNode );
+                return;
+            }
+        }
+    }
+
+    void retire( NODE* aNode )
+    {
+        pushRetired( aNode, aNode );
+    }
+
+    void pushRetired( NODE* aFirst, NODE* aLast )
+    {
+        NODE* top = m_retired.load();
+
+        do
+        {
+            aLast->m_nextRetired = top;
+        } while( !m_retired.compare_exchange_weak( top, aFirst ) );
+    }
+
+    void leave()
+    {
+        // Everything in this snapshot was unlinked before we took it, so only threads which were
+        // already inside the queue can still reference it.  If we are the last one out, nobody
+        // can.
+        NODE* retired = m_retired.exchange( nullptr );
+
+        if( m_active.fetch_sub( 1 ) == 1 )
+        {
+            freeRetired( retired );
+        }
+        else if( retired )
+        {
+            NODE* last = retired;
+
+            while( last->m_nextRetired )
+                last = last->m_nextRetired;
+
+            pushRetired( retired, last );
+        }
+    }
+
+    static void freeRetired( NODE* aNode )
+    {
+        while( aNode )
+        {
+            NODE* next = aNode->m_nextRetired;
+            delete aNode;
+            aNode = next;
+        }
+    }
 
-    std::queue<T>      m_queue;
-    mutable std::mutex m_mutex;
+    std::atomic<NODE*>  m_head;
+    std::atomic<NODE*>  m_tail;
+    std::atomic<size_t> m_size;
+    std::atomic<size_t> m_active;
+    std::atomic<NODE*>  m_retired;
 };
 
 #endif // SYNC_QUEUE_H
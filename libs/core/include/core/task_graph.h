@@ -0,0 +1,207 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#pragma once
+#ifndef INCLUDE_TASK_GRAPH_H_
+#define INCLUDE_TASK_GRAPH_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <core/thread_pool.h>
+
+
+/**
+ * Scheduling priority of a #TASK_GRAPH.
+ *
+ * Ready tasks of all running graphs share a single dispatch queue in front of the thread pool.
+ * Whenever a pool worker becomes free it runs the highest priority ready task, so an interactive
+ * job submitted after a long background job does not have to wait for the background queue to
+ * drain.
+ */
+enum class TASK_PRIORITY : int
+{
+    BACKGROUND = 0,     ///< Library scans, cache warming and other speculative work
+    NORMAL,             ///< Batch jobs (DRC, plotting, exports)
+    INTERACTIVE         ///< Work the user is actively waiting on (zone refill, ratsnest)
+};
+
+
+/**
+ * A shared cancellation flag.
+ *
+ * Copies refer to the same flag, so a token can be handed to a #TASK_GRAPH and to the code that
+ * decides to abort (e.g. a progress reporter callback).  Tasks which have not started when the
+ * token is cancelled are skipped; long running tasks should poll IsCancelled() themselves.
+ */
+class TASK_CANCEL_TOKEN
+{
+public:
+    TASK_CANCEL_TOKEN() :
+            m_flag( std::make_shared<std::atomic<bool>>( false ) )
+    {}
+
+    void Cancel() { m_flag->store( true, std::memory_order_relaxed ); }
+
+    bool IsCancelled() const { return m_flag->load( std::memory_order_relaxed ); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_flag;
+};
+
+
+/**
+ * A set of tasks with dependencies between them, executed on a #thread_pool.
+ *
+ * Tasks are added with AddTask() and ordered with AddDependency().  Run() submits every task as
+ * soon as all the tasks it depends on have finished and blocks the caller until the whole graph
+ * has completed or has been cancelled.  Unlike a flat list of futures, the caller does not have
+ * to poll individual results, and a task whose prerequisites are cancelled is never started.
+ *
+ * Run() is Start() followed by Wait(); calling them separately lets the caller do its own work
+ * while the graph executes.
+ *
+ * The graph is not reusable: it may only be started once, and a started graph must be waited for
+ * before it is destroyed.
+ *
+ * @warning Run() and Wait() block the calling thread.  Do not call them from a task executing in
+ *          the same thread pool or the pool may run out of workers.
+ */
+class TASK_GRAPH
+{
+public:
+    typedef size_t TASK_ID;
+
+    TASK_GRAPH( TASK_PRIORITY aPriority = TASK_PRIORITY::NORMAL,
+                const TASK_CANCEL_TOKEN& aToken = TASK_CANCEL_TOKEN() );
+
+    ~TASK_GRAPH();
+
+    TASK_GRAPH( const TASK_GRAPH& ) = delete;
+    TASK_GRAPH& operator=( const TASK_GRAPH& ) = delete;
+
+    /**
+     * Add a task to the graph.
+     *
+     * Tasks must not throw; errors have to be reported through state captured by the task.
+     *
+     * @return an identifier to be used with AddDependency().
+     */
+    TASK_ID AddTask( std::function<void()> aTask );
+
+    /**
+     * Declare that \a aTask may only start once \a aPrerequisite has finished.
+     */
+    void AddDependency( TASK_ID aTask, TASK_ID aPrerequisite );
+
+    /**
+     * Execute the graph on \a aPool and wait for it to finish.
+     *
+     * @param aPool the pool to execute on.
+     * @param aWaitCallback optional function called from the waiting thread every \a aPollInterval
+     *                      while tasks are still executing.  Typically used to keep a progress
+     *                      reporter refreshed.  If it returns false the graph is cancelled.
+     * @param aPollInterval the maximum time between two calls to \a aWaitCallback.
+     * @return true if all tasks ran, false if the graph was cancelled.
+     */
+    bool Run( thread_pool& aPool, const std::function<bool()>& aWaitCallback = nullptr,
+              std::chrono::milliseconds aPollInterval = std::chrono::milliseconds( 100 ) );
+
+    /**
+     * Submit the tasks without prerequisites to \a aPool and return immediately.
+     */
+    void Start( thread_pool& aPool );
+
+    /**
+     * Wait for a started graph to finish.  See Run() for the parameters.
+     *
+     * @return true if all tasks ran, false if the graph was cancelled.
+     */
+    bool Wait( const std::function<bool()>& aWaitCallback = nullptr,
+               std::chrono::milliseconds aPollInterval = std::chrono::milliseconds( 100 ) );
+
+    /**
+     * Limit the number of tasks of this graph which may execute at the same time.
+     *
+     * Use GetThreadBudget() to respect the budget configured for a subsystem.
+     *
+     * @param aMaxConcurrency the maximum number of concurrently running tasks, 0 for no limit.
+     */
+    void SetMaxConcurrency( size_t aMaxConcurrency ) { m_maxConcurrency = aMaxConcurrency; }
+
+    /**
+     * Cancel the graph.  Tasks already running finish normally; tasks not yet started are
+     * skipped.
+     */
+    void Cancel() { m_token.Cancel(); }
+
+    bool IsCancelled() const { return m_token.IsCancelled(); }
+
+    const TASK_CANCEL_TOKEN& GetCancelToken() const { return m_token; }
+
+    TASK_PRIORITY GetPriority() const { return m_priority; }
+
+    size_t GetTaskCount() const { return m_tasks.size(); }
+
+    /**
+     * @return the number of tasks which have run (or have been skipped after cancellation).
+     */
+    size_t GetFinishedCount() const { return m_finished.load(); }
+
+private:
+    friend class TASK_DISPATCHER;
+
+    struct TASK
+    {
+        std::function<void()> m_func;
+        std::vector<TASK_ID>  m_dependents;
+        std::atomic<size_t>   m_pendingPrereqs{ 0 };
+    };
+
+    void enqueue( thread_pool& aPool, TASK_ID aTask );
+    void execute( thread_pool& aPool, TASK_ID aTask );
+    void release( thread_pool& aPool );
+
+    TASK_PRIORITY                      m_priority;
+    TASK_CANCEL_TOKEN                  m_token;
+    std::vector<std::unique_ptr<TASK>> m_tasks;
+    std::atomic<size_t>                m_finished;
+    bool                               m_started;
+
+    size_t                             m_maxConcurrency;
+    size_t                             m_inFlight;
+    std::deque<TASK_ID>                m_deferred;     ///< Ready tasks held back by the limit
+    std::mutex                         m_deferredMutex;
+
+    std::mutex                         m_doneMutex;
+    std::condition_variable            m_doneCv;
+};
+
+
+#endif /* INCLUDE_TASK_GRAPH_H_ */
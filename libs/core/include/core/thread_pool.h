@@ -25,6 +25,8 @@
 #ifndef INCLUDE_THREAD_POOL_H_
 #define INCLUDE_THREAD_POOL_H_
 
+#include <functional>
+
 #include <bs_thread_pool.hpp>
 
 using thread_pool = BS::thread_pool;
@@ -39,4 +41,58 @@ using thread_pool = BS::thread_pool;
 thread_pool& GetKiCadThreadPool();
 
 
+/**
+ * Subsystems which can be restricted to a share of the thread pool.
+ *
+ * When several KiCad processes share a machine (e.g. kicad-cli jobs on a build host), letting
+ * each of them use every core leads to heavy oversubscription.  A budget caps the number of
+ * workers a subsystem keeps busy at any one time.
+ */
+enum class THREAD_SUBSYSTEM
+{
+    ZONE_FILL,
+    DRC,
+    CONNECTIVITY,
+    RAYTRACE,
+
+    COUNT
+};
+
+
+/**
+ * Set the number of worker threads of the KiCad thread pool.
+ *
+ * If the pool already exists it is reset, which waits for all queued tasks to complete.
+ *
+ * @param aThreadCount the number of threads, or 0 for one thread per hardware thread.
+ */
+void SetKiCadThreadPoolSize( size_t aThreadCount );
+
+
+/**
+ * Limit the number of threads used concurrently by \a aSubsystem.
+ *
+ * @param aThreadCount the maximum number of threads, or 0 for no limit beyond the pool size.
+ */
+void SetThreadBudget( THREAD_SUBSYSTEM aSubsystem, size_t aThreadCount );
+
+
+/**
+ * @return the number of threads \a aSubsystem may keep busy: its budget if one has been set,
+ *         clamped to the size of the KiCad thread pool.  Always at least 1.
+ */
+size_t GetThreadBudget( THREAD_SUBSYSTEM aSubsystem );
+
+
+/**
+ * Call \a aFunc( 0 ) to \a aFunc( aCount - 1 ) on the KiCad thread pool, the calling thread
+ * taking part.
+ *
+ * Pool workers only pick up jobs nobody has started yet, and the caller only waits for jobs
+ * which are already running.  Unlike waiting on futures, this can't deadlock when called from
+ * a task which itself runs on the pool (e.g. a zone refill).
+ */
+void ParallelFor( size_t aCount, const std::function<void( size_t )>& aFunc );
+
+
 #endif /* INCLUDE_THREAD_POOL_H_ */
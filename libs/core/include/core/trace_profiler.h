@@ -0,0 +1,197 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file trace_profiler.h
+ * @brief Thread-aware trace event recording with Chrome trace (and Perfetto) export.
+ */
+
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+/**
+ * Records scoped zones and counters into per-thread ring buffers.
+ *
+ * Recording is disabled by default and costs a single relaxed atomic load per zone while
+ * disabled.  Once enabled, every thread that records an event gets its own fixed size ring
+ * buffer; the oldest events are overwritten when a buffer is full so a long session keeps the
+ * most recent history.
+ *
+ * The result is written in the Chrome trace event JSON format, which can be loaded in
+ * chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Event and counter names are stored by pointer and must outlive the profiler: use string
+ * literals, or InternName() for names built at runtime.
+ */
+class TRACE_PROFILER
+{
+public:
+    static TRACE_PROFILER& Instance();
+
+    /**
+     * Start recording.
+     *
+     * @param aEventsPerThread the capacity of each per-thread ring buffer.
+     */
+    void Enable( size_t aEventsPerThread = 65536 );
+
+    /**
+     * Stop recording.  Recorded events are kept until Clear() is called.
+     */
+    void Disable();
+
+    static bool IsEnabled() { return s_enabled.load( std::memory_order_relaxed ); }
+
+    void BeginZone( const char* aName );
+    void EndZone( const char* aName );
+
+    /**
+     * Record the value of a counter (e.g. a queue depth) at the current time.
+     */
+    void Counter( const char* aName, int64_t aValue );
+
+    /**
+     * @return a pointer to a copy of \a aName which stays valid for the lifetime of the
+     *         profiler.  Repeated calls with the same name return the same pointer.
+     */
+    const char* InternName( const std::string& aName );
+
+    /**
+     * Discard all recorded events.
+     */
+    void Clear();
+
+    /**
+     * Write all recorded events in Chrome trace event JSON format.
+     */
+    void WriteChromeTrace( std::ostream& aStream ) const;
+
+    /**
+     * Write all recorded events to \a aFilename.
+     *
+     * @return false if the file could not be written.
+     */
+    bool WriteChromeTrace( const std::string& aFilename ) const;
+
+private:
+    TRACE_PROFILER();
+
+    struct EVENT
+    {
+        const char* m_name;
+        int64_t     m_timestamp;    ///< nanoseconds since the profiler epoch
+        int64_t     m_value;        ///< counter value, unused for zones
+        char        m_phase;        ///< 'B', 'E' or 'C', as in the Chrome trace format
+    };
+
+    struct THREAD_BUFFER;
+
+    void record( char aPhase, const char* aName, int64_t aValue );
+
+    THREAD_BUFFER* threadBuffer();
+
+    static std::atomic<bool>                    s_enabled;
+
+    std::chrono::steady_clock::time_point       m_epoch;
+    size_t                                      m_capacity;
+
+    mutable std::mutex                          m_buffersMutex;
+    std::vector<std::shared_ptr<THREAD_BUFFER>> m_buffers;
+
+    std::mutex                                  m_namesMutex;
+    std::unordered_set<std::string>             m_names;
+};
+
+
+/**
+ * RAII trace zone: records a begin event on construction and an end event on destruction.
+ *
+ * Prefer the #TRACE_SCOPE macro.
+ */
+class TRACE_ZONE
+{
+public:
+    TRACE_ZONE( const char* aName ) :
+            m_name( aName ),
+            m_active( TRACE_PROFILER::IsEnabled() )
+    {
+        if( m_active )
+            TRACE_PROFILER::Instance().BeginZone( m_name );
+    }
+
+    /**
+     * Zone with a name built at runtime.  The name is only interned when recording is enabled.
+     */
+    TRACE_ZONE( const std::string& aName ) :
+            m_name( nullptr ),
+            m_active( TRACE_PROFILER::IsEnabled() )
+    {
+        if( m_active )
+        {
+            m_name = TRACE_PROFILER::Instance().InternName( aName );
+            TRACE_PROFILER::Instance().BeginZone( m_name );
+        }
+    }
+
+    ~TRACE_ZONE()
+    {
+        if( m_active )
+            TRACE_PROFILER::Instance().EndZone( m_name );
+    }
+
+private:
+    const char* m_name;
+    bool        m_active;
+};
+
+
+#define TRACE_CONCAT_INNER( a, b ) a##b
+#define TRACE_CONCAT( a, b ) TRACE_CONCAT_INNER( a, b )
+
+/**
+ * Record the enclosing scope as a zone named \a name (a string literal).
+ */
+#define TRACE_SCOPE( name ) TRACE_ZONE TRACE_CONCAT( traceZone, __LINE__ )( name )
+
+/**
+ * Record a counter value if trace recording is enabled.
+ */
+#define TRACE_COUNTER( name, value )                                                              \
+    do                                                                                            \
+    {                                                                                             \
+        if( TRACE_PROFILER::IsEnabled() )                                                         \
+            TRACE_PROFILER::Instance().Counter( name, static_cast<int64_t>( value ) );            \
+    } while( false )
+
+#endif  // TRACE_PROFILER_H
@@ -0,0 +1,257 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstdint>
+#include <queue>
+
+#include <core/task_graph.h>
+#include <core/trace_profiler.h>
+
+
+/**
+ * Process-wide queue of ready tasks, ordered by priority and then by submission order.
+ *
+ * The thread pool itself is strictly FIFO.  Instead of pushing the tasks themselves, we push one
+ * anonymous "pump" job per ready task.  Each pump picks the best task available at the time it
+ * runs, which gives cross-graph prioritisation without modifying the pool.
+ */
+class TASK_DISPATCHER
+{
+public:
+    static void Enqueue( thread_pool& aPool, TASK_GRAPH* aGraph, TASK_GRAPH::TASK_ID aTask )
+    {
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+            m_ready.push( { static_cast<int>( aGraph->GetPriority() ), m_sequence++, &aPool,
+                            aGraph, aTask } );
+
+            TRACE_COUNTER( "Ready tasks", m_ready.size() );
+        }
+
+        aPool.push_task( &TASK_DISPATCHER::pump );
+    }
+
+private:
+    struct ENTRY
+    {
+        int                 m_priority;
+        uint64_t            m_sequence;
+        thread_pool*        m_pool;
+        TASK_GRAPH*         m_graph;
+        TASK_GRAPH::TASK_ID m_task;
+
+        bool operator<( const ENTRY& aOther ) const
+        {
+            if( m_priority != aOther.m_priority )
+                return m_priority < aOther.m_priority;
+
+            return m_sequence > aOther.m_sequence;
+        }
+    };
+
+    static void pump()
+    {
+        ENTRY entry;
+
+        {
+            std::lock_guard<std::mutex> lock( m_mutex );
+
+            if( m_ready.empty() )
+                return;
+
+            entry = m_ready.top();
+            m_ready.pop();
+
+            TRACE_COUNTER( "Ready tasks", m_ready.size() );
+        }
+
+        entry.m_graph->execute( *entry.m_pool, entry.m_task );
+    }
+
+    static std::mutex                 m_mutex;
+    static std::priority_queue<ENTRY> m_ready;
+    static uint64_t                   m_sequence;
+};
+
+
+std::mutex                                  TASK_DISPATCHER::m_mutex;
+std::priority_queue<TASK_DISPATCHER::ENTRY> TASK_DISPATCHER::m_ready;
+uint64_t                                    TASK_DISPATCHER::m_sequence = 0;
+
+
+TASK_GRAPH::TASK_GRAPH( TASK_PRIORITY aPriority, const TASK_CANCEL_TOKEN& aToken ) :
+        m_priority( aPriority ),
+        m_token( aToken ),
+        m_finished( 0 ),
+        m_started( false ),
+        m_maxConcurrency( 0 ),
+        m_inFlight( 0 )
+{
+}
+
+
+TASK_GRAPH::~TASK_GRAPH()
+{
+}
+
+
+TASK_GRAPH::TASK_ID TASK_GRAPH::AddTask( std::function<void()> aTask )
+{
+    m_tasks.emplace_back( std::make_unique<TASK>() );
+    m_tasks.back()->m_func = std::move( aTask );
+
+    return m_tasks.size() - 1;
+}
+
+
+void TASK_GRAPH::AddDependency( TASK_ID aTask, TASK_ID aPrerequisite )
+{
+    m_tasks[aPrerequisite]->m_dependents.push_back( aTask );
+    m_tasks[aTask]->m_pendingPrereqs++;
+}
+
+
+bool TASK_GRAPH::Run( thread_pool& aPool, const std::function<bool()>& aWaitCallback,
+                      std::chrono::milliseconds aPollInterval )
+{
+    Start( aPool );
+    return Wait( aWaitCallback, aPollInterval );
+}
+
+
+void TASK_GRAPH::Start( thread_pool& aPool )
+{
+    if( m_started )
+        return;
+
+    m_started = true;
+
+    // Collect the roots first: once the first task is enqueued, prerequisite counts start
+    // changing under our feet.
+    std::vector<TASK_ID> roots;
+
+    for( TASK_ID ii = 0; ii < m_tasks.size(); ++ii )
+    {
+        if( m_tasks[ii]->m_pendingPrereqs == 0 )
+            roots.push_back( ii );
+    }
+
+    for( TASK_ID root : roots )
+        enqueue( aPool, root );
+}
+
+
+bool TASK_GRAPH::Wait( const std::function<bool()>& aWaitCallback,
+                       std::chrono::milliseconds aPollInterval )
+{
+    if( !m_started )
+        return !IsCancelled();
+
+    std::unique_lock<std::mutex> lock( m_doneMutex );
+
+    while( m_finished.load() < m_tasks.size() )
+    {
+        m_doneCv.wait_for( lock, aPollInterval );
+
+        if( aWaitCallback && m_finished.load() < m_tasks.size() )
+        {
+            lock.unlock();
+
+            if( !aWaitCallback() )
+                Cancel();
+
+            lock.lock();
+        }
+    }
+
+    return !IsCancelled();
+}
+
+
+void TASK_GRAPH::enqueue( thread_pool& aPool, TASK_ID aTask )
+{
+    if( m_maxConcurrency )
+    {
+        std::lock_guard<std::mutex> lock( m_deferredMutex );
+
+        if( m_inFlight >= m_maxConcurrency )
+        {
+            m_deferred.push_back( aTask );
+            return;
+        }
+
+        m_inFlight++;
+    }
+
+    TASK_DISPATCHER::Enqueue( aPool, this, aTask );
+}
+
+
+void TASK_GRAPH::release( thread_pool& aPool )
+{
+    if( !m_maxConcurrency )
+        return;
+
+    TASK_ID next;
+
+    {
+        std::lock_guard<std::mutex> lock( m_deferredMutex );
+
+        if( m_deferred.empty() )
+        {
+            m_inFlight--;
+            return;
+        }
+
+        // Hand our slot straight to the oldest deferred task
+        next = m_deferred.front();
+        m_deferred.pop_front();
+    }
+
+    TASK_DISPATCHER::Enqueue( aPool, this, next );
+}
+
+
+void TASK_GRAPH::execute( thread_pool& aPool, TASK_ID aTask )
+{
+    TASK* task = m_tasks[aTask].get();
+
+    if( !IsCancelled() )
+        task->m_func();
+
+    // Release the closure (and anything it captured) as early as possible
+    task->m_func = nullptr;
+
+    release( aPool );
+
+    for( TASK_ID dependent : task->m_dependents )
+    {
+        if( --m_tasks[dependent]->m_pendingPrereqs == 0 )
+            enqueue( aPool, dependent );
+    }
+
+    std::lock_guard<std::mutex> lock( m_doneMutex );
+
+    if( ++m_finished == m_tasks.size() )
+        m_doneCv.notify_all();
+}
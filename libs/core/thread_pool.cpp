@@ -22,6 +22,12 @@
  */
 
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
 #include <core/thread_pool.h>
 
 // Under mingw, there is a problem with the destructor when creating a static instance
@@ -29,13 +35,100 @@
 // so we create it on the heap.
 static thread_pool* tp = nullptr;
 
+static size_t tp_size = 0;
+
+static std::atomic<size_t> budgets[static_cast<size_t>( THREAD_SUBSYSTEM::COUNT )];
+
+
 thread_pool& GetKiCadThreadPool()
 {
 #if 0   // Turn this on to disable multi-threading for debugging
     if( !tp ) tp = new thread_pool( 1 );
 #else
-    if( !tp ) tp = new thread_pool;
+    if( !tp ) tp = new thread_pool( static_cast<BS::concurrency_t>( tp_size ) );
 #endif
 
     return *tp;
 }
+
+
+void SetKiCadThreadPoolSize( size_t aThreadCount )
+{
+    if( aThreadCount == tp_size )
+        return;
+
+    tp_size = aThreadCount;
+
+    if( tp )
+        tp->reset( static_cast<BS::concurrency_t>( tp_size ) );
+}
+
+
+void SetThreadBudget( THREAD_SUBSYSTEM aSubsystem, size_t aThreadCount )
+{
+    budgets[static_cast<size_t>( aSubsystem )] = aThreadCount;
+}
+
+
+size_t GetThreadBudget( THREAD_SUBSYSTEM aSubsystem )
+{
+    size_t poolSize = GetKiCadThreadPool().get_thread_count();
+    size_t budget = budgets[static_cast<size_t>( aSubsystem )];
+
+    if( budget == 0 )
+        return std::max<size_t>( poolSize, 1 );
+
+    return std::clamp<size_t>( budget, 1, std::max<size_t>( poolSize, 1 ) );
+}
+
+
+void ParallelFor( size_t aCount, const std::function<void( size_t )>& aFunc )
+{
+    if( aCount < 2 )
+    {
+        for( size_t ii = 0; ii < aCount; ++ii )
+            aFunc( ii );
+
+        return;
+    }
+
+    struct STATE
+    {
+        std::atomic<size_t>                 m_next{ 0 };
+        size_t                              m_done = 0;
+        size_t                              m_count = 0;
+        const std::function<void( size_t )>* m_func = nullptr;
+        std::mutex                          m_mutex;
+        std::condition_variable             m_cv;
+    };
+
+    // Shared with the workers, as a late one may only get to run after we've returned
+    std::shared_ptr<STATE> state = std::make_shared<STATE>();
+    state->m_count = aCount;
+    state->m_func = &aFunc;
+
+    auto work =
+            [state]()
+            {
+                for( size_t ii = state->m_next++; ii < state->m_count; ii = state->m_next++ )
+                {
+                    ( *state->m_func )( ii );
+
+                    std::lock_guard<std::mutex> lock( state->m_mutex );
+
+                    if( ++state->m_done == state->m_count )
+                        state->m_cv.notify_all();
+                }
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       helpers = std::min<size_t>( tp.get_thread_count(), aCount - 1 );
+
+    for( size_t ii = 0; ii < helpers; ++ii )
+        tp.push_task( work );
+
+    work();
+
+    std::unique_lock<std::mutex> lock( state->m_mutex );
+    state->m_cv.wait( lock, [&]() { return state->m_done == state->m_count; } );
+}
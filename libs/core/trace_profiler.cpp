@@ -0,0 +1,246 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <core/trace_profiler.h>
+#include <core/spinlock.h>
+
+#include <algorithm>
+#include <fstream>
+
+
+/**
+ * Events recorded by a single thread.  The lock is only ever contended while the trace is
+ * being written or cleared.
+ */
+struct TRACE_PROFILER::THREAD_BUFFER
+{
+    THREAD_BUFFER( uint32_t aThreadId, size_t aCapacity ) :
+            m_threadId( aThreadId ),
+            m_next( 0 ),
+            m_wrapped( false )
+    {
+        m_events.resize( std::max<size_t>( aCapacity, 1 ) );
+    }
+
+    KISPINLOCK         m_lock;
+    uint32_t           m_threadId;
+    std::vector<EVENT> m_events;
+    size_t             m_next;
+    bool               m_wrapped;
+};
+
+
+std::atomic<bool> TRACE_PROFILER::s_enabled( false );
+
+
+TRACE_PROFILER& TRACE_PROFILER::Instance()
+{
+    // Never destroyed: worker threads may still record events during static destruction.
+    static TRACE_PROFILER* instance = new TRACE_PROFILER;
+    return *instance;
+}
+
+
+TRACE_PROFILER::TRACE_PROFILER() :
+        m_epoch( std::chrono::steady_clock::now() ),
+        m_capacity( 65536 )
+{
+}
+
+
+void TRACE_PROFILER::Enable( size_t aEventsPerThread )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_buffersMutex );
+        m_capacity = aEventsPerThread;
+    }
+
+    s_enabled.store( true );
+}
+
+
+void TRACE_PROFILER::Disable()
+{
+    s_enabled.store( false );
+}
+
+
+void TRACE_PROFILER::BeginZone( const char* aName )
+{
+    record( 'B', aName, 0 );
+}
+
+
+void TRACE_PROFILER::EndZone( const char* aName )
+{
+    record( 'E', aName, 0 );
+}
+
+
+void TRACE_PROFILER::Counter( const char* aName, int64_t aValue )
+{
+    record( 'C', aName, aValue );
+}
+
+
+TRACE_PROFILER::THREAD_BUFFER* TRACE_PROFILER::threadBuffer()
+{
+    thread_local THREAD_BUFFER* buffer = nullptr;
+
+    if( !buffer )
+    {
+        std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+        uint32_t id = static_cast<uint32_t>( m_buffers.size() + 1 );
+        m_buffers.emplace_back( std::make_shared<THREAD_BUFFER>( id, m_capacity ) );
+        buffer = m_buffers.back().get();
+    }
+
+    return buffer;
+}
+
+
+void TRACE_PROFILER::record( char aPhase, const char* aName, int64_t aValue )
+{
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now() - m_epoch ).count();
+
+    THREAD_BUFFER* buffer = threadBuffer();
+
+    buffer->m_lock.lock();
+
+    buffer->m_events[buffer->m_next] = { aName, now, aValue, aPhase };
+
+    if( ++buffer->m_next == buffer->m_events.size() )
+    {
+        buffer->m_next = 0;
+        buffer->m_wrapped = true;
+    }
+
+    buffer->m_lock.unlock();
+}
+
+
+const char* TRACE_PROFILER::InternName( const std::string& aName )
+{
+    std::lock_guard<std::mutex> lock( m_namesMutex );
+
+    return m_names.insert( aName ).first->c_str();
+}
+
+
+void TRACE_PROFILER::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+    for( const std::shared_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        buffer->m_lock.lock();
+        buffer->m_next = 0;
+        buffer->m_wrapped = false;
+        buffer->m_lock.unlock();
+    }
+}
+
+
+static void writeJsonString( std::ostream& aStream, const char* aString )
+{
+    aStream << '"';
+
+    for( const char* c = aString; *c; ++c )
+    {
+        if( *c == '"' || *c == '\\' )
+            aStream << '\\' << *c;
+        else if( static_cast<unsigned char>( *c ) < 0x20 )
+            aStream << ' ';
+        else
+            aStream << *c;
+    }
+
+    aStream << '"';
+}
+
+
+void TRACE_PROFILER::WriteChromeTrace( std::ostream& aStream ) const
+{
+    std::lock_guard<std::mutex> lock( m_buffersMutex );
+
+    bool first = true;
+    std::vector<EVENT> events;
+
+    aStream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    for( const std::shared_ptr<THREAD_BUFFER>& buffer : m_buffers )
+    {
+        // Copy out under the lock, format without it
+        buffer->m_lock.lock();
+
+        events.clear();
+
+        if( buffer->m_wrapped )
+        {
+            events.insert( events.end(), buffer->m_events.begin() + buffer->m_next,
+                           buffer->m_events.end() );
+        }
+
+        events.insert( events.end(), buffer->m_events.begin(),
+                       buffer->m_events.begin() + buffer->m_next );
+
+        buffer->m_lock.unlock();
+
+        for( const EVENT& event : events )
+        {
+            if( !first )
+                aStream << ',';
+
+            first = false;
+
+            aStream << "\n{\"name\":";
+            writeJsonString( aStream, event.m_name );
+            aStream << ",\"ph\":\"" << event.m_phase << "\"";
+            aStream << ",\"ts\":" << event.m_timestamp / 1000 << '.'
+                    << ( event.m_timestamp % 1000 ) / 100;
+            aStream << ",\"pid\":1,\"tid\":" << buffer->m_threadId;
+
+            if( event.m_phase == 'C' )
+                aStream << ",\"args\":{\"value\":" << event.m_value << "}";
+
+            aStream << '}';
+        }
+    }
+
+    aStream << "\n]}\n";
+}
+
+
+bool TRACE_PROFILER::WriteChromeTrace( const std::string& aFilename ) const
+{
+    std::ofstream out( aFilename, std::ios::out | std::ios::trunc );
+
+    if( !out.is_open() )
+        return false;
+
+    WriteChromeTrace( out );
+
+    return out.good();
+}
@@ -0,0 +1,109 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef GEOMETRY_ARENA_H
+#define GEOMETRY_ARENA_H
+
+#include <memory>
+#include <vector>
+
+#include <geometry/shape_line_chain.h>
+
+
+/**
+ * Transient buffers used while converting shapes to and from Clipper paths.
+ *
+ * Every boolean or offset operation needs a Z value buffer, an arc buffer and (with Clipper2)
+ * a list of input paths.  Inside a #GEOMETRY_ARENA these are reused from one operation to the
+ * next so they only grow to the size of the largest operation instead of being reallocated
+ * for every call.
+ */
+struct GEOMETRY_SCRATCH
+{
+    void Clear()
+    {
+        m_zValues.clear();
+        m_arcBuffer.clear();
+        m_paths.clear();
+        m_clips.clear();
+    }
+
+    std::vector<CLIPPER_Z_VALUE> m_zValues;
+    std::vector<SHAPE_ARC>       m_arcBuffer;
+    Clipper2Lib::Paths64         m_paths;
+    Clipper2Lib::Paths64         m_clips;
+};
+
+
+/**
+ * Scoped per-thread arena for the temporary buffers of SHAPE_POLY_SET operations.
+ *
+ * Create one on the stack around a unit of work that does many boolean operations (filling a
+ * zone layer, running a DRC test over a range of items).  While it is alive, operations on the
+ * same thread reuse their scratch buffers instead of allocating fresh ones, which takes a large
+ * share of the malloc traffic (and of the malloc lock contention between pool workers) out of
+ * these loops.  All buffers are freed when the outermost arena of the thread is destroyed.
+ *
+ * Arenas nest; only the outermost one owns the memory.  Without an arena operations behave as
+ * before and use local buffers.
+ */
+class GEOMETRY_ARENA
+{
+public:
+    GEOMETRY_ARENA();
+    ~GEOMETRY_ARENA();
+
+    GEOMETRY_ARENA( const GEOMETRY_ARENA& ) = delete;
+    GEOMETRY_ARENA& operator=( const GEOMETRY_ARENA& ) = delete;
+
+    /**
+     * @return true if an arena is active on the calling thread.
+     */
+    static bool IsActive();
+
+    /**
+     * A cleared set of scratch buffers, borrowed from the thread's arena if there is one.
+     *
+     * Leases are strictly scoped and may nest (e.g. an operation which itself performs another
+     * boolean operation gets a second set of buffers).
+     */
+    class LEASE
+    {
+    public:
+        LEASE();
+        ~LEASE();
+
+        LEASE( const LEASE& ) = delete;
+        LEASE& operator=( const LEASE& ) = delete;
+
+        GEOMETRY_SCRATCH& operator*() { return *m_scratch; }
+        GEOMETRY_SCRATCH* operator->() { return m_scratch; }
+
+    private:
+        GEOMETRY_SCRATCH* m_scratch;
+        bool              m_borrowed;
+        GEOMETRY_SCRATCH  m_local;      ///< Used when no arena is active
+    };
+};
+
+#endif // GEOMETRY_ARENA_H
@@ -32,6 +32,7 @@
 
 #include <math.h>           // for copysign
 #include <stdlib.h>         // for abs
+#include <vector>
 #include <math/box2.h>
 #include <geometry/eda_angle.h>
 
@@ -62,6 +63,55 @@ int GetArcToSegmentCount( int aRadius, int aErrorMax, const EDA_ANGLE& aArcAngle
  */
 int CircleToEndSegmentDeltaRadius( int aInnerCircleRadius, int aSegCount );
 
+/**
+ * @return the corners of the regular \a aSegCount sided polygon inscribed in the unit circle.
+ *
+ * The first corner is at angle 0, or at half a step (180/aSegCount degrees) if \a aHalfStep is
+ * true, and the next ones follow clockwise (in screen coordinates).  Scaled by a radius and
+ * rounded, they give exactly the corners RotatePoint() produces when rotating ( radius, 0 ) by
+ * successive steps of 360/aSegCount degrees.
+ *
+ * The tables are built once per segment count and shared by all threads; the returned
+ * reference stays valid until the program exits.
+ */
+const std::vector<VECTOR2D>& GetUnitCirclePolygon( int aSegCount, bool aHalfStep = false );
+
+/**
+ * Walk the angles aStart, aStart + aStep, aStart + 2 * aStep, ... and give their cosine and
+ * sine without trig calls: each step rotates the previous unit vector by aStep.
+ *
+ * The accumulated rounding error stays many orders of magnitude below one IU for any segment
+ * count used to approximate an arc.
+ */
+class ARC_STEPPER
+{
+public:
+    ARC_STEPPER( const EDA_ANGLE& aStart, const EDA_ANGLE& aStep ) :
+            m_cos( aStart.Cos() ),
+            m_sin( aStart.Sin() ),
+            m_stepCos( aStep.Cos() ),
+            m_stepSin( aStep.Sin() )
+    {
+    }
+
+    double Cos() const { return m_cos; }
+    double Sin() const { return m_sin; }
+
+    void Next()
+    {
+        double nextCos = m_cos * m_stepCos - m_sin * m_stepSin;
+
+        m_sin = m_sin * m_stepCos + m_cos * m_stepSin;
+        m_cos = nextCos;
+    }
+
+private:
+    double m_cos;
+    double m_sin;
+    double m_stepCos;
+    double m_stepSin;
+};
+
 /**
  * When creating polygons to create a clearance polygonal area, the polygon must
  * be same or bigger than the original shape.
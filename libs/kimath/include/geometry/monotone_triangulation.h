@@ -0,0 +1,64 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __MONOTONE_TRIANGULATION_H
+#define __MONOTONE_TRIANGULATION_H
+
+#include <geometry/shape_poly_set.h>
+
+
+/**
+ * Sweep-line triangulation of a polygon with holes.
+ *
+ * The polygon is first split into y-monotone pieces by a single top to bottom sweep (de Berg
+ * et al., "Computational Geometry", chapter 3), and each piece is then triangulated in linear
+ * time.  The overall cost is O(n log n) whatever the number of holes, so unlike the ear
+ * clipping POLYGON_TRIANGULATION the polygon doesn't need to be fractured nor partitioned
+ * first.
+ *
+ * Orientation tests are exact on integer coordinates.  The input must be simple: holes must
+ * lie strictly inside the outline and must not touch each other or the outline.  Degenerate
+ * input is detected (the triangle area must add up to the polygon area exactly) and reported
+ * as a failure, in which case the caller is expected to fall back to POLYGON_TRIANGULATION.
+ */
+class MONOTONE_TRIANGULATION
+{
+public:
+    MONOTONE_TRIANGULATION( SHAPE_POLY_SET::TRIANGULATED_POLYGON& aResult ) :
+            m_result( aResult )
+    {}
+
+    /**
+     * Triangulate \a aPolygon (the outline followed by its holes, without arcs).
+     *
+     * @return false if the polygon is degenerate.  The result is left empty in that case.
+     */
+    bool TesselatePolygon( const SHAPE_POLY_SET::POLYGON& aPolygon );
+
+private:
+    bool triangulate( const SHAPE_POLY_SET::POLYGON& aPolygon );
+
+    SHAPE_POLY_SET::TRIANGULATED_POLYGON& m_result;
+};
+
+#endif //__MONOTONE_TRIANGULATION_H
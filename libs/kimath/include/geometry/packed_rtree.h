@@ -0,0 +1,574 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef PACKED_RTREE_H
+#define PACKED_RTREE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include <math/box2.h>
+
+
+/**
+ * A static R-tree over bounding boxes, bulk loaded with Sort-Tile-Recursive packing.
+ *
+ * Items are queued with Insert() and only become visible to queries after Build(), which packs
+ * every item (earlier ones included) into full nodes stored level by level in one contiguous
+ * array.  Compared to the dynamic RTree, building takes a couple of sorts instead of one tree
+ * descent and node split per item, queries touch far fewer cache lines, and no node is
+ * allocated on its own.
+ *
+ * It suits content which is built once and then queried many times, such as the DRC caches.
+ * Content which is edited interactively is better served by the dynamic RTree.
+ *
+ * Building is not thread-safe; concurrent queries on a built tree are.
+ *
+ * @tparam T the payload, copied into the tree.  Typically a pointer.
+ * @tparam NODE_SIZE the number of children of a node.
+ */
+template <typename T, int NODE_SIZE = 16>
+class PACKED_RTREE
+{
+public:
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    /**
+     * Queue \a aItem with bounding box \a aBox (both edges included) for the next Build().
+     */
+    void Insert( const BOX2I& aBox, const T& aItem )
+    {
+        m_pendingBoxes.push_back( makeBox( aBox ) );
+        m_pendingItems.push_back( aItem );
+    }
+
+    /**
+     * Pack all the queued items, together with the ones already in the tree.
+     */
+    void Build()
+    {
+        if( m_pendingItems.empty() )
+            return;
+
+        std::vector<BOX> boxes;
+
+        boxes.reserve( m_items.size() + m_pendingItems.size() );
+
+        for( size_t ii = 0; ii < m_items.size(); ++ii )
+            boxes.push_back( m_itemBoxes.Get( ii ) );
+
+        boxes.insert( boxes.end(), m_pendingBoxes.begin(), m_pendingBoxes.end() );
+        m_items.insert( m_items.end(), m_pendingItems.begin(), m_pendingItems.end() );
+
+        m_pendingBoxes.clear();
+        m_pendingBoxes.shrink_to_fit();
+        m_pendingItems.clear();
+        m_pendingItems.shrink_to_fit();
+
+        pack( std::move( boxes ) );
+    }
+
+    /**
+     * @return true if items were inserted since the last Build().
+     */
+    bool NeedsBuild() const { return !m_pendingItems.empty(); }
+
+    void Clear()
+    {
+        m_itemBoxes.Clear();
+        m_items.clear();
+        m_nodeBoxes.Clear();
+        m_nodes.clear();
+        m_pendingBoxes.clear();
+        m_pendingItems.clear();
+    }
+
+    /**
+     * @return the number of items visible to queries.
+     */
+    size_t size() const { return m_items.size(); }
+
+    bool empty() const { return m_items.empty(); }
+
+    /**
+     * Iterate over all the items visible to queries, in no particular order.
+     */
+    const_iterator begin() const { return m_items.begin(); }
+    const_iterator end() const { return m_items.end(); }
+
+    /**
+     * Call \a aVisitor( const T& ) for each item whose box overlaps \a aBox (edges included),
+     * until it returns false.
+     *
+     * @return the number of visited items.
+     */
+    template <typename VISITOR>
+    int Search( const BOX2I& aBox, VISITOR&& aVisitor ) const
+    {
+        if( m_nodes.empty() )
+            return 0;
+
+        const BOX query = makeBox( aBox );
+        int       found = 0;
+        uint8_t   hits[NODE_SIZE];
+
+        // At most NODE_SIZE - 1 siblings per level wait on the stack
+        uint32_t stack[maxDepth() * NODE_SIZE];
+        int      top = 0;
+
+        stack[top++] = static_cast<uint32_t>( m_nodes.size() - 1 );
+
+        while( top > 0 )
+        {
+            const NODE& node = m_nodes[stack[--top]];
+
+            if( node.m_leaf )
+            {
+                m_itemBoxes.Overlaps( node.m_first, query, hits );
+
+                for( uint32_t ii = 0; ii < node.m_count; ++ii )
+                {
+                    if( hits[ii] )
+                    {
+                        found++;
+
+                        if( !aVisitor( m_items[node.m_first + ii] ) )
+                            return found;
+                    }
+                }
+            }
+            else
+            {
+                m_nodeBoxes.Overlaps( node.m_first, query, hits );
+
+                for( uint32_t ii = 0; ii < node.m_count; ++ii )
+                {
+                    if( hits[ii] )
+                        stack[top++] = node.m_first + ii;
+                }
+            }
+        }
+
+        return found;
+    }
+
+    /**
+     * Call \a aVisitor( const T& aMine, const T& aOther ) for each pair of items of this tree
+     * and of \a aOther whose boxes overlap once this tree's boxes are grown by \a aInflate on
+     * each side, until it returns false.
+     *
+     * Both trees are descended together, so that the pairs come out grouped by leaf and each
+     * box is only tested against the leaves near it.  This is much faster than one Search()
+     * per item when both trees are large.
+     *
+     * @return the number of visited pairs.
+     */
+    template <typename VISITOR>
+    int SearchPairs( const PACKED_RTREE& aOther, int aInflate, VISITOR&& aVisitor ) const
+    {
+        if( m_nodes.empty() || aOther.m_nodes.empty() )
+            return 0;
+
+        int     found = 0;
+        uint8_t hits[NODE_SIZE];
+
+        // Each step replaces a pair by at most NODE_SIZE pairs and goes one level down in one
+        // of the trees
+        std::pair<uint32_t, uint32_t> stack[2 * maxDepth() * NODE_SIZE];
+        int                           top = 0;
+
+        const uint32_t root = static_cast<uint32_t>( m_nodes.size() - 1 );
+        const uint32_t otherRoot = static_cast<uint32_t>( aOther.m_nodes.size() - 1 );
+
+        if( !m_nodeBoxes.Get( root ).Inflated( aInflate ).Overlaps(
+                    aOther.m_nodeBoxes.Get( otherRoot ) ) )
+        {
+            return 0;
+        }
+
+        stack[top++] = { root, otherRoot };
+
+        while( top > 0 )
+        {
+            const auto [mineIdx, otherIdx] = stack[--top];
+            const NODE& mine = m_nodes[mineIdx];
+            const NODE& other = aOther.m_nodes[otherIdx];
+
+            if( mine.m_leaf && other.m_leaf )
+            {
+                for( uint32_t ii = mine.m_first; ii < mine.m_first + mine.m_count; ++ii )
+                {
+                    const BOX query = m_itemBoxes.Get( ii ).Inflated( aInflate );
+
+                    aOther.m_itemBoxes.Overlaps( other.m_first, query, hits );
+
+                    for( uint32_t jj = 0; jj < other.m_count; ++jj )
+                    {
+                        if( hits[jj] )
+                        {
+                            found++;
+
+                            if( !aVisitor( m_items[ii], aOther.m_items[other.m_first + jj] ) )
+                                return found;
+                        }
+                    }
+                }
+            }
+            else if( other.m_leaf
+                     || ( !mine.m_leaf
+                          && m_nodeBoxes.Get( mineIdx ).Area()
+                                     >= aOther.m_nodeBoxes.Get( otherIdx ).Area() ) )
+            {
+                // Descend into this tree.  Growing the fixed box instead of each child is
+                // equivalent and keeps the batch test untouched.
+                const BOX query = aOther.m_nodeBoxes.Get( otherIdx ).Inflated( aInflate );
+
+                m_nodeBoxes.Overlaps( mine.m_first, query, hits );
+
+                for( uint32_t ii = 0; ii < mine.m_count; ++ii )
+                {
+                    if( hits[ii] )
+                        stack[top++] = { mine.m_first + ii, otherIdx };
+                }
+            }
+            else
+            {
+                const BOX query = m_nodeBoxes.Get( mineIdx ).Inflated( aInflate );
+
+                aOther.m_nodeBoxes.Overlaps( other.m_first, query, hits );
+
+                for( uint32_t ii = 0; ii < other.m_count; ++ii )
+                {
+                    if( hits[ii] )
+                        stack[top++] = { mineIdx, other.m_first + ii };
+                }
+            }
+        }
+
+        return found;
+    }
+
+    /**
+     * @return the memory held by the tree, in bytes, payloads excluded.
+     */
+    size_t GetMemoryUsage() const
+    {
+        return m_itemBoxes.GetMemoryUsage() + m_items.capacity() * sizeof( T )
+               + m_nodeBoxes.GetMemoryUsage() + m_nodes.capacity() * sizeof( NODE )
+               + m_pendingBoxes.capacity() * sizeof( BOX )
+               + m_pendingItems.capacity() * sizeof( T );
+    }
+
+private:
+    static_assert( NODE_SIZE >= 2, "PACKED_RTREE nodes need at least two children" );
+
+    /// Number of levels of a tree holding 2^32 items
+    static constexpr int maxDepth()
+    {
+        int      depth = 1;
+        uint64_t capacity = NODE_SIZE;
+
+        while( capacity < ( uint64_t( 1 ) << 32 ) )
+        {
+            capacity *= NODE_SIZE;
+            depth++;
+        }
+
+        return depth;
+    }
+
+    struct BOX
+    {
+        int m_minX;
+        int m_minY;
+        int m_maxX;
+        int m_maxY;
+
+        bool Overlaps( const BOX& aOther ) const
+        {
+            return m_minX <= aOther.m_maxX && aOther.m_minX <= m_maxX
+                   && m_minY <= aOther.m_maxY && aOther.m_minY <= m_maxY;
+        }
+
+        void Merge( const BOX& aOther )
+        {
+            m_minX = std::min( m_minX, aOther.m_minX );
+            m_minY = std::min( m_minY, aOther.m_minY );
+            m_maxX = std::max( m_maxX, aOther.m_maxX );
+            m_maxY = std::max( m_maxY, aOther.m_maxY );
+        }
+
+        BOX Inflated( int aDelta ) const
+        {
+            auto clamp =
+                    []( int64_t aValue )
+                    {
+                        return static_cast<int>( std::clamp<int64_t>(
+                                aValue, std::numeric_limits<int>::min(),
+                                std::numeric_limits<int>::max() ) );
+                    };
+
+            return { clamp( int64_t( m_minX ) - aDelta ), clamp( int64_t( m_minY ) - aDelta ),
+                     clamp( int64_t( m_maxX ) + aDelta ), clamp( int64_t( m_maxY ) + aDelta ) };
+        }
+
+        double Area() const { return ( double( m_maxX ) - m_minX ) * ( double( m_maxY ) - m_minY ); }
+
+        int64_t CenterX() const { return int64_t( m_minX ) + m_maxX; }
+        int64_t CenterY() const { return int64_t( m_minY ) + m_maxY; }
+    };
+
+    /**
+     * Boxes stored one coordinate per array, so that the boxes of a node can be tested against
+     * a query with a fixed-length loop the compiler turns into SIMD compares.
+     *
+     * The arrays are padded with NODE_SIZE unused boxes, so that a run of NODE_SIZE boxes can
+     * be read from the start of any node.
+     */
+    struct BOXES
+    {
+        void Assign( const std::vector<BOX>& aBoxes )
+        {
+            const size_t size = aBoxes.size() + NODE_SIZE;
+
+            for( std::vector<int>* coord : { &m_minX, &m_minY, &m_maxX, &m_maxY } )
+            {
+                coord->assign( size, 0 );
+                coord->shrink_to_fit();
+            }
+
+            for( size_t ii = 0; ii < aBoxes.size(); ++ii )
+                Set( ii, aBoxes[ii] );
+        }
+
+        void Clear()
+        {
+            for( std::vector<int>* coord : { &m_minX, &m_minY, &m_maxX, &m_maxY } )
+                coord->clear();
+        }
+
+        BOX Get( size_t aIdx ) const
+        {
+            return { m_minX[aIdx], m_minY[aIdx], m_maxX[aIdx], m_maxY[aIdx] };
+        }
+
+        void Set( size_t aIdx, const BOX& aBox )
+        {
+            m_minX[aIdx] = aBox.m_minX;
+            m_minY[aIdx] = aBox.m_minY;
+            m_maxX[aIdx] = aBox.m_maxX;
+            m_maxY[aIdx] = aBox.m_maxY;
+        }
+
+        /**
+         * Set \a aHits[ii] to 1 if box \a aFirst + ii overlaps \a aQuery, 0 otherwise, for ii
+         * below NODE_SIZE.  Entries past the end of the node are meaningless.
+         */
+        void Overlaps( uint32_t aFirst, const BOX& aQuery, uint8_t* aHits ) const
+        {
+            const int* minX = m_minX.data() + aFirst;
+            const int* minY = m_minY.data() + aFirst;
+            const int* maxX = m_maxX.data() + aFirst;
+            const int* maxY = m_maxY.data() + aFirst;
+
+            // Bitwise ands keep the loop free of branches
+            for( int ii = 0; ii < NODE_SIZE; ++ii )
+            {
+                aHits[ii] = ( minX[ii] <= aQuery.m_maxX ) & ( aQuery.m_minX <= maxX[ii] )
+                            & ( minY[ii] <= aQuery.m_maxY ) & ( aQuery.m_minY <= maxY[ii] );
+            }
+        }
+
+        size_t GetMemoryUsage() const
+        {
+            return ( m_minX.capacity() + m_minY.capacity() + m_maxX.capacity()
+                     + m_maxY.capacity() )
+                   * sizeof( int );
+        }
+
+        std::vector<int> m_minX;
+        std::vector<int> m_minY;
+        std::vector<int> m_maxX;
+        std::vector<int> m_maxY;
+    };
+
+    struct NODE
+    {
+        uint32_t m_first;       ///< first child node, or first item of a leaf
+        uint32_t m_count : 31;
+        uint32_t m_leaf : 1;
+    };
+
+    static BOX makeBox( const BOX2I& aBox )
+    {
+        BOX2I box = aBox;
+        box.Normalize();
+
+        return { box.GetX(), box.GetY(), box.GetRight(), box.GetBottom() };
+    }
+
+    /**
+     * Sort-Tile-Recursive ordering of \a aBoxes: return the permutation which groups them into
+     * runs of NODE_SIZE neighbouring boxes.
+     */
+    static std::vector<uint32_t> strOrder( const std::vector<BOX>& aBoxes, uint32_t aFirst,
+                                           uint32_t aCount )
+    {
+        std::vector<uint32_t> order( aCount );
+        std::iota( order.begin(), order.end(), aFirst );
+
+        const size_t groups = ( aCount + NODE_SIZE - 1 ) / NODE_SIZE;
+        const size_t slices = static_cast<size_t>( std::ceil( std::sqrt( double( groups ) ) ) );
+        const size_t sliceSize = slices * NODE_SIZE;
+
+        std::sort( order.begin(), order.end(),
+                   [&]( uint32_t aA, uint32_t aB )
+                   {
+                       return aBoxes[aA].CenterX() < aBoxes[aB].CenterX();
+                   } );
+
+        for( size_t start = 0; start < aCount; start += sliceSize )
+        {
+            auto first = order.begin() + start;
+            auto last = order.begin() + std::min<size_t>( aCount, start + sliceSize );
+
+            std::sort( first, last,
+                       [&]( uint32_t aA, uint32_t aB )
+                       {
+                           return aBoxes[aA].CenterY() < aBoxes[aB].CenterY();
+                       } );
+        }
+
+        return order;
+    }
+
+    void pack( std::vector<BOX>&& aItemBoxes )
+    {
+        m_nodes.clear();
+
+        const uint32_t count = static_cast<uint32_t>( m_items.size() );
+
+        // Leaves: reorder the items themselves so that each leaf owns a contiguous run
+        {
+            std::vector<uint32_t> order = strOrder( aItemBoxes, 0, count );
+            std::vector<BOX>      boxes;
+            std::vector<T>        items;
+
+            boxes.reserve( count );
+            items.reserve( count );
+
+            for( uint32_t idx : order )
+            {
+                boxes.push_back( aItemBoxes[idx] );
+                items.push_back( std::move( m_items[idx] ) );
+            }
+
+            m_itemBoxes.Assign( boxes );
+            m_items = std::move( items );
+            aItemBoxes = std::move( boxes );
+        }
+
+        std::vector<BOX> nodeBoxes;
+
+        m_nodes.reserve( count / ( NODE_SIZE - 1 ) + 2 );
+        nodeBoxes.reserve( count / ( NODE_SIZE - 1 ) + 2 );
+
+        for( uint32_t first = 0; first < count; first += NODE_SIZE )
+        {
+            NODE node;
+            node.m_first = first;
+            node.m_count = std::min<uint32_t>( NODE_SIZE, count - first );
+            node.m_leaf = 1;
+
+            BOX box = aItemBoxes[first];
+
+            for( uint32_t ii = first + 1; ii < first + node.m_count; ++ii )
+                box.Merge( aItemBoxes[ii] );
+
+            m_nodes.push_back( node );
+            nodeBoxes.push_back( box );
+        }
+
+        // Inner levels: reorder the nodes of the level below, which can be moved freely as
+        // their children don't refer back to them.  The root ends up last.
+        uint32_t levelFirst = 0;
+        uint32_t levelCount = static_cast<uint32_t>( m_nodes.size() );
+
+        while( levelCount > 1 )
+        {
+            std::vector<uint32_t> order = strOrder( nodeBoxes, levelFirst, levelCount );
+            std::vector<NODE>     level;
+            std::vector<BOX>      levelBoxes;
+
+            level.reserve( levelCount );
+            levelBoxes.reserve( levelCount );
+
+            for( uint32_t idx : order )
+            {
+                level.push_back( m_nodes[idx] );
+                levelBoxes.push_back( nodeBoxes[idx] );
+            }
+
+            std::copy( level.begin(), level.end(), m_nodes.begin() + levelFirst );
+            std::copy( levelBoxes.begin(), levelBoxes.end(), nodeBoxes.begin() + levelFirst );
+
+            const uint32_t nextFirst = static_cast<uint32_t>( m_nodes.size() );
+
+            for( uint32_t first = levelFirst; first < levelFirst + levelCount; first += NODE_SIZE )
+            {
+                NODE node;
+                node.m_first = first;
+                node.m_count = std::min<uint32_t>( NODE_SIZE, levelFirst + levelCount - first );
+                node.m_leaf = 0;
+
+                BOX box = nodeBoxes[first];
+
+                for( uint32_t ii = first + 1; ii < first + node.m_count; ++ii )
+                    box.Merge( nodeBoxes[ii] );
+
+                m_nodes.push_back( node );
+                nodeBoxes.push_back( box );
+            }
+
+            levelFirst = nextFirst;
+            levelCount = static_cast<uint32_t>( m_nodes.size() ) - nextFirst;
+        }
+
+        m_nodeBoxes.Assign( nodeBoxes );
+    }
+
+    BOXES             m_itemBoxes;      ///< in leaf order
+    std::vector<T>    m_items;          ///< in leaf order, parallel to m_itemBoxes
+    BOXES             m_nodeBoxes;      ///< parallel to m_nodes
+    std::vector<NODE> m_nodes;          ///< leaves first, then each level up; root is last
+
+    std::vector<BOX>  m_pendingBoxes;
+    std::vector<T>    m_pendingItems;
+};
+
+#endif // PACKED_RTREE_H
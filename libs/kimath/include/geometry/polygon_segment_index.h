@@ -0,0 +1,118 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef POLYGON_SEGMENT_INDEX_H
+#define POLYGON_SEGMENT_INDEX_H
+
+#include <cstdint>
+#include <vector>
+
+#include <geometry/seg.h>
+#include <math/vector2d.h>
+
+class SHAPE_LINE_CHAIN;
+
+
+/**
+ * Bounding volume hierarchy over the edges of a single polygon (outline and holes).
+ *
+ * The index is immutable once built; it does not follow later edits of the polygon it was
+ * built from.  All queries give the same answers as the corresponding linear scans in
+ * #SHAPE_POLY_SET and #SHAPE_LINE_CHAIN_BASE, but only visit the edges whose bounding boxes
+ * can affect the result.
+ */
+class POLYGON_SEGMENT_INDEX
+{
+public:
+    /**
+     * Build the index.
+     *
+     * @param aPolygon the outline followed by its holes, as in SHAPE_POLY_SET::POLYGON.
+     */
+    POLYGON_SEGMENT_INDEX( const std::vector<SHAPE_LINE_CHAIN>& aPolygon );
+
+    /**
+     * Equivalent of SHAPE_POLY_SET::containsSingle() without bounding box caches: true if
+     * \a aP is inside the outline (or within \a aAccuracy of its edge) and not inside any hole.
+     */
+    bool Contains( const VECTOR2I& aP, int aAccuracy ) const;
+
+    /**
+     * Equivalent of SHAPE_LINE_CHAIN_BASE::PointInside() on the outline, ignoring the holes.
+     */
+    bool OutlineContains( const VECTOR2I& aP, int aAccuracy ) const;
+
+    /**
+     * @return the squared distance between \a aP and the nearest edge.  Points inside the
+     *         polygon are not treated specially.
+     */
+    SEG::ecoord SquaredEdgeDistance( const VECTOR2I& aP, VECTOR2I* aNearest = nullptr ) const;
+
+    /**
+     * @return the squared distance between \a aSeg and the nearest edge.
+     */
+    SEG::ecoord SquaredEdgeDistance( const SEG& aSeg, VECTOR2I* aNearest = nullptr ) const;
+
+    size_t GetSegmentCount() const { return m_items.size(); }
+
+    /// Polygons with fewer edges than this are faster to scan linearly
+    static constexpr size_t MIN_SEGMENTS = 64;
+
+private:
+    struct ITEM
+    {
+        SEG m_seg;
+        int m_contour;
+    };
+
+    struct NODE
+    {
+        int      m_minX;
+        int      m_minY;
+        int      m_maxX;
+        int      m_maxY;
+        uint32_t m_first;      ///< first item of a leaf, or index of the second child
+        uint32_t m_count;      ///< number of items of a leaf, 0 for inner nodes
+    };
+
+    uint32_t build( uint32_t aFirst, uint32_t aCount );
+
+    /**
+     * Call \a aFunc with the contour index of every edge crossed by a ray from \a aP in the
+     * positive x direction, counted as in SHAPE_LINE_CHAIN_BASE::PointInside().
+     */
+    template <typename FUNC>
+    void forEachRayCrossing( const VECTOR2I& aP, FUNC aFunc ) const;
+
+    /**
+     * @return true if an edge of contour \a aContour is within \a aAccuracy of \a aP, as in
+     *         SHAPE_LINE_CHAIN_BASE::PointOnEdge().
+     */
+    bool onContourEdge( int aContour, const VECTOR2I& aP, int aAccuracy ) const;
+
+    std::vector<ITEM> m_items;
+    std::vector<NODE> m_nodes;
+    std::vector<bool> m_closedContours;     ///< contours PointInside() can be true for
+};
+
+#endif // POLYGON_SEGMENT_INDEX_H
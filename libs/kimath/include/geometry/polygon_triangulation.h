@@ -50,7 +50,6 @@
 #include <deque>
 #include <cmath>
 
-#include <clipper.hpp>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <math/box2.h>
@@ -326,47 +325,6 @@ private:
         return retval;
     }
 
-    /**
-     * Take a Clipper path and converts it into a circular, doubly-linked list for triangulation.
-     */
-    VERTEX* createList( const ClipperLib::Path& aPath )
-    {
-        VERTEX* tail = nullptr;
-        double sum = 0.0;
-        auto len = aPath.size();
-
-        // Check for winding order
-        for( size_t i = 0; i < len; i++ )
-        {
-            auto p1 = aPath.at( i );
-            auto p2 = aPath.at( ( i + 1 ) < len ? i + 1 : 0 );
-
-            sum += ( ( p2.X - p1.X ) * ( p2.Y + p1.Y ) );
-        }
-
-        if( sum <= 0.0 )
-        {
-            for( auto point : aPath )
-                tail = insertVertex( VECTOR2I( point.X, point.Y ), tail );
-        }
-        else
-        {
-            for( size_t i = 0; i < len; i++ )
-            {
-                auto p = aPath.at( len - i - 1 );
-                tail = insertVertex( VECTOR2I( p.X, p.Y ), tail );
-            }
-        }
-
-        if( tail && ( *tail == *tail->next ) )
-        {
-            tail->next->remove();
-        }
-
-        return tail;
-
-    }
-
     /**
      * Take a #SHAPE_LINE_CHAIN and links each point into a circular, doubly-linked list.
      */
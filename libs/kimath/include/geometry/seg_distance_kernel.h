@@ -0,0 +1,48 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef SEG_DISTANCE_KERNEL_H
+#define SEG_DISTANCE_KERNEL_H
+
+#include <cstddef>
+
+#include <math/vector2d.h>
+
+
+/**
+ * Find the next segment of a polyline which may pass within \a aRadius of \a aP.
+ *
+ * The polyline segments are ( aPoints[i], aPoints[i + 1] ) for i < \a aSegmentCount.  Distances
+ * are computed in double precision, several segments per iteration (AVX2 or NEON when the
+ * compiler targets them, otherwise a plain loop), with a safety margin larger than the rounding
+ * of both this kernel and the integer SEG routines.  A segment whose exact distance is below
+ * \a aRadius is therefore never skipped, but a returned candidate still has to be confirmed
+ * with SEG::SquaredDistance() or equivalent.
+ *
+ * @return the index of the first candidate at or after \a aStart, or \a aSegmentCount if there
+ *         is none.
+ */
+size_t FindSegmentNearPoint( const VECTOR2I* aPoints, size_t aSegmentCount, size_t aStart,
+                             const VECTOR2D& aP, double aRadius );
+
+#endif // SEG_DISTANCE_KERNEL_H
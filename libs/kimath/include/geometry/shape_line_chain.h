@@ -27,8 +27,8 @@
 #define __SHAPE_LINE_CHAIN
 
 
-#include <clipper.hpp>
 #include <clipper2/clipper.h>
+#include <core/small_vector.h>
 #include <geometry/seg.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
@@ -37,7 +37,7 @@
 
 /**
  * Holds information on each point of a SHAPE_LINE_CHAIN that is retrievable
- * after an operation with ClipperLib
+ * after an operation with Clipper2
  */
 struct CLIPPER_Z_VALUE
 {
@@ -81,9 +81,20 @@ struct CLIPPER_Z_VALUE
  */
 class SHAPE_LINE_CHAIN : public SHAPE_LINE_CHAIN_BASE
 {
+public:
+    /**
+     * Storage of the points, shape indices and arcs.
+     *
+     * Most chains are pad, via or track hulls with a handful of points and at most a couple of
+     * arcs, so these are kept inside the object and don't need a heap allocation.
+     */
+    typedef SMALL_VECTOR<VECTOR2I, 16>                    POINT_VECTOR;
+    typedef SMALL_VECTOR<std::pair<ssize_t, ssize_t>, 16> SHAPE_VECTOR;
+    typedef SMALL_VECTOR<SHAPE_ARC, 2>                    ARC_VECTOR;
+
 private:
-    typedef std::vector<VECTOR2I>::iterator point_iter;
-    typedef std::vector<VECTOR2I>::const_iterator point_citer;
+    typedef POINT_VECTOR::iterator point_iter;
+    typedef POINT_VECTOR::const_iterator point_citer;
 
 public:
     /**
@@ -178,8 +189,8 @@ public:
             m_closed( aClosed ),
             m_width( 0 )
     {
-        m_points = aV;
-        m_shapes = std::vector<std::pair<ssize_t, ssize_t>>( aV.size(), SHAPES_ARE_PT );
+        m_points.assign( aV.begin(), aV.end() );
+        m_shapes.assign( aV.size(), SHAPES_ARE_PT );
     }
 
     SHAPE_LINE_CHAIN( const SHAPE_ARC& aArc, bool aClosed = false ) :
@@ -190,13 +201,9 @@ public:
         m_points = aArc.ConvertToPolyline().CPoints();
         m_arcs.emplace_back( aArc );
         m_arcs.back().SetWidth( 0 );
-        m_shapes = std::vector<std::pair<ssize_t, ssize_t>>( m_points.size(), { 0, SHAPE_IS_PT } );
+        m_shapes.assign( m_points.size(), { 0, SHAPE_IS_PT } );
     }
 
-    SHAPE_LINE_CHAIN( const ClipperLib::Path& aPath,
-                      const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
-                      const std::vector<SHAPE_ARC>& aArcBuffer );
-
     SHAPE_LINE_CHAIN( const Clipper2Lib::Path64& aPath,
                       const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                       const std::vector<SHAPE_ARC>& aArcBuffer );
@@ -403,7 +410,7 @@ public:
         return m_points[aIndex];
     }
 
-    const std::vector<VECTOR2I>& CPoints() const
+    const POINT_VECTOR& CPoints() const
     {
         return m_points;
     }
@@ -419,7 +426,7 @@ public:
     /**
      * @return the vector of stored arcs.
      */
-    const std::vector<SHAPE_ARC>& CArcs() const
+    const ARC_VECTOR& CArcs() const
     {
         return m_arcs;
     }
@@ -427,11 +434,21 @@ public:
     /**
      * @return the vector of values indicating shape type and location.
      */
-    const std::vector<std::pair<ssize_t, ssize_t>>& CShapes() const
+    const SHAPE_VECTOR& CShapes() const
     {
         return m_shapes;
     }
 
+    /**
+     * @return the estimated heap memory held by the chain, in bytes.
+     */
+    size_t GetMemoryUsage() const
+    {
+        return m_points.capacity() * sizeof( VECTOR2I )
+               + m_shapes.capacity() * sizeof( std::pair<ssize_t, ssize_t> )
+               + m_arcs.capacity() * sizeof( SHAPE_ARC );
+    }
+
     /// @copydoc SHAPE::BBox()
     const BOX2I BBox( int aClearance = 0 ) const override
     {
@@ -953,14 +970,10 @@ protected:
     }
 
     /**
-     * Create a new Clipper path from the SHAPE_LINE_CHAIN in a given orientation
-     */
-    ClipperLib::Path convertToClipper( bool aRequiredOrientation,
-                                       std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
-                                       std::vector<SHAPE_ARC>&       aArcBuffer ) const;
-
-    /**
-     * Create a new Clipper2 path from the SHAPE_LINE_CHAIN in a given orientation
+     * Create a new Clipper2 path from the SHAPE_LINE_CHAIN in a given orientation.
+     *
+     * Points which don't belong to an arc all get Z value 0, which is added to
+     * \a aZValueBuffer if it is empty.  A chain without arcs doesn't add anything else.
      */
     Clipper2Lib::Path64 convertToClipper2( bool aRequiredOrientation,
             std::vector<CLIPPER_Z_VALUE> &aZValueBuffer,
@@ -983,7 +996,7 @@ private:
     static const std::pair<ssize_t, ssize_t> SHAPES_ARE_PT;
 
     /// array of vertices
-    std::vector<VECTOR2I> m_points;
+    POINT_VECTOR m_points;
 
     /**
      * Array of indices that refer to the index of the shape if the point is part of a larger
@@ -999,9 +1012,9 @@ private:
      *
      * The second element must always be SHAPE_IS_PT if the first element is SHAPE_IS_PT.
      */
-    std::vector<std::pair<ssize_t, ssize_t>> m_shapes;
+    SHAPE_VECTOR m_shapes;
 
-    std::vector<SHAPE_ARC> m_arcs;
+    ARC_VECTOR m_arcs;
 
     /// is the line chain closed?
     bool m_closed;
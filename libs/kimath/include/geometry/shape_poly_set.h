@@ -28,8 +28,11 @@
 #ifndef __SHAPE_POLY_SET_H
 #define __SHAPE_POLY_SET_H
 
+#include <atomic>
+#include <cstdint>
 #include <cstdio>
 #include <deque>                        // for deque
+#include <functional>
 #include <iosfwd>                       // for string, stringstream
 #include <memory>
 #include <set>                          // for set
@@ -37,7 +40,6 @@
 #include <stdlib.h>                     // for abs
 #include <vector>
 
-#include <clipper.hpp>                  // for ClipType, PolyTree (ptr only)
 #include <clipper2/clipper.h>
 #include <geometry/corner_strategy.h>
 #include <geometry/seg.h>               // for SEG
@@ -47,6 +49,8 @@
 #include <math/vector2d.h>              // for VECTOR2I
 #include <md5_hash.h>
 
+class POLYGON_SEGMENT_INDEX;
+
 
 /**
  * Represent a set of closed polygons. Polygons may be nonconvex, self-intersecting
@@ -172,12 +176,27 @@ public:
                 vertex += aVec;
         }
 
+        void TransformVertices( const std::function<VECTOR2I( const VECTOR2I& )>& aTransform )
+        {
+            for( VECTOR2I& vertex : m_vertices )
+                vertex = aTransform( vertex );
+        }
+
     private:
         int                  m_sourceOutline;
         std::deque<TRI>      m_triangles;
         std::deque<VECTOR2I> m_vertices;
     };
 
+    /**
+     * Triangulation algorithms available to CacheTriangulation().
+     */
+    enum class TRIANGULATOR
+    {
+        EAR_CLIPPING,   ///< POLYGON_TRIANGULATION, on fractured and partitioned polygons
+        SWEEP_LINE      ///< MONOTONE_TRIANGULATION, on whole polygons with their holes
+    };
+
     /**
      * Structure to hold the necessary information in order to index a vertex on a
      * SHAPE_POLY_SET object: the polygon index, the contour index relative to the polygon and
@@ -516,10 +535,31 @@ public:
      * This is a good value for Pcbnew: 1cm, in internal units.
      * But not good for Gerbview (1e7 = 10cm), however using a partition is not useful.
      * @param aSimplify = force the algorithm to simplify the POLY_SET before triangulating
+     *
+     * With \a aPartition, each polygon is triangulated on its own: polygons are processed in
+     * parallel on the KiCad thread pool, and polygons whose geometry hasn't changed since the
+     * previous call keep their triangles.
+     *
+     * This also enables the edge index used by Collide(), SquaredDistance(), Contains() and
+     * PointInside() on large polygons.  Like the triangulation, the index is dropped by
+     * editing the set and restored by the next call.
+     *
+     * @param aTriangulator the algorithm to use.  With #TRIANGULATOR::SWEEP_LINE, polygons are
+     * triangulated with their holes and without partitioning; any polygon the sweep cannot
+     * handle falls back to ear clipping.
      */
-    void CacheTriangulation( bool aPartition = true, bool aSimplify = false );
+    void CacheTriangulation( bool aPartition = true, bool aSimplify = false,
+                             TRIANGULATOR aTriangulator = TRIANGULATOR::EAR_CLIPPING );
     bool IsTriangulationUpToDate() const;
 
+    /**
+     * @return a number identifying the current triangulation, which changes whenever the
+     *         triangles are rebuilt or removed, or 0 if there is none.  Indices which point
+     *         to the triangles are valid as long as it doesn't change (and the set is
+     *         alive).
+     */
+    uint64_t GetTriangulationSerial() const { return m_triangulationSerial; }
+
     MD5_HASH GetHash() const;
 
     virtual bool HasIndexableSubshapes() const override;
@@ -678,6 +718,13 @@ public:
     /// mainly for reports
     int FullPointCount() const;
 
+    /// Return the estimated heap memory held by the outlines and holes, in bytes.
+    /// Mainly for memory usage reports.
+    size_t GetOutlineMemoryUsage() const;
+
+    /// Return the estimated heap memory held by the triangulation cache, in bytes.
+    size_t GetTriangulationMemoryUsage() const;
+
     /// Returns the number of holes in a given outline
     int HoleCount( int aOutline ) const
     {
@@ -690,9 +737,11 @@ public:
         return m_polys[aOutline].size() - 1;
     }
 
-    /// Return the reference to aIndex-th outline in the set
+    /// Return the reference to aIndex-th outline in the set.  This drops the edge index, so
+    /// use COutline() to only read the outline.
     SHAPE_LINE_CHAIN& Outline( int aIndex )
     {
+        invalidateSegmentIndex();
         return m_polys[aIndex][0];
     }
 
@@ -717,15 +766,18 @@ public:
         return Subset( aPolygonIndex, aPolygonIndex + 1 );
     }
 
-    /// Return the reference to aHole-th hole in the aIndex-th outline
+    /// Return the reference to aHole-th hole in the aIndex-th outline.  This drops the edge
+    /// index, so use CHole() to only read the hole.
     SHAPE_LINE_CHAIN& Hole( int aOutline, int aHole )
     {
+        invalidateSegmentIndex();
         return m_polys[aOutline][aHole + 1];
     }
 
     /// Return the aIndex-th subpolygon in the set
     POLYGON& Polygon( int aIndex )
     {
+        invalidateSegmentIndex();
         return m_polys[aIndex];
     }
 
@@ -770,6 +822,8 @@ public:
     {
         ITERATOR iter;
 
+        invalidateSegmentIndex();
+
         iter.m_poly = this;
         iter.m_currentPolygon = aFirst;
         iter.m_lastPolygon = aLast < 0 ? OutlineCount() - 1 : aLast;
@@ -878,6 +932,8 @@ public:
     {
         SEGMENT_ITERATOR iter;
 
+        invalidateSegmentIndex();
+
         iter.m_poly = this;
         iter.m_currentPolygon = aFirst;
         iter.m_lastPolygon = aLast < 0 ? OutlineCount() - 1 : aLast;
@@ -960,6 +1016,10 @@ public:
      * strictly simple polygon, but calculations can be really significantly time consuming
      * Most of time #PM_FAST is preferable.
      * #PM_STRICTLY_SIMPLE can be used in critical cases (Gerber output for instance)
+     *
+     * The boolean operations are done by Clipper2, which has no separate strictly simple mode,
+     * so both modes currently give the same result.  The parameter is kept for callers which
+     * state their requirement.
      */
     enum POLYGON_MODE
     {
@@ -1003,6 +1063,35 @@ public:
     void BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                               POLYGON_MODE aFastMode );
 
+    /**
+     * Perform a boolean union of this set with all the sets in \a aOthers, in a single sweep.
+     *
+     * Much cheaper than calling BooleanAdd() once per set: every edge enters the sweep only once
+     * and no intermediate result is built.
+     */
+    void BooleanAdd( const std::vector<const SHAPE_POLY_SET*>& aOthers, POLYGON_MODE aFastMode );
+
+    /**
+     * Subtract all the sets in \a aOthers from this set, in a single sweep.
+     *
+     * The sets to subtract may overlap each other and don't need to be merged beforehand.
+     */
+    void BooleanSubtract( const std::vector<const SHAPE_POLY_SET*>& aOthers,
+                          POLYGON_MODE aFastMode );
+
+    /**
+     * Merge all the polygons of \a aShapes into a new set of non-overlapping polygons.
+     *
+     * Large inputs are sorted along X and split into bands which are merged concurrently on the
+     * thread pool.  Only the merged polygons which may touch another band go through a final
+     * merge.  Small inputs are merged in a single sweep.
+     *
+     * @param aShapes the sets to merge.
+     * @param aMinParallel the number of outlines below which the merge is not split.
+     */
+    static SHAPE_POLY_SET ParallelUnion( const std::vector<const SHAPE_POLY_SET*>& aShapes,
+                                         int aMinParallel = 2000 );
+
     /**
     * Extract all contours from this polygon set, then recreate polygons with holes.
     * Essentially XOR'ing, but faster. Self-intersecting polygons are not supported.
@@ -1078,6 +1167,13 @@ public:
     /// For \a aFastMode meaning, see function booleanOp
     void Simplify( POLYGON_MODE aFastMode );
 
+    /**
+     * Remove the vertices closer than \a aMaxError to the line joining their neighbours, which
+     * gives a coarser version of the polygons, for instance to draw them from afar.  Arcs are
+     * lost, outlines and holes which degenerate are removed and the result may self-intersect.
+     */
+    void SimplifyOutlines( int aMaxError );
+
     /**
      * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s).
      *
@@ -1097,6 +1193,15 @@ public:
     /// @copydoc SHAPE::Move()
     void Move( const VECTOR2I& aVector ) override;
 
+    /**
+     * Map all vertices through an affine transform, such as any combination of scaling,
+     * mirroring, rotation and translation.
+     *
+     * Triangles stay valid through affine transforms, so an up to date triangulation is
+     * transformed along rather than computed again.  Arcs are converted to plain segments.
+     */
+    void TransformPoints( const std::function<VECTOR2I( const VECTOR2I& )>& aTransform );
+
     /**
      * Mirror the line points about y or x (or both)
      *
@@ -1435,9 +1540,6 @@ private:
 
     void fractureSingle( POLYGON& paths );
     void unfractureSingle ( POLYGON& path );
-    void importTree( ClipperLib::PolyTree*               tree,
-                     const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
-                     const std::vector<SHAPE_ARC>&       aArcBuffe );
     void importTree( Clipper2Lib::PolyTree64&            tree,
                      const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                      const std::vector<SHAPE_ARC>&       aArcBuffe );
@@ -1448,35 +1550,36 @@ private:
                      const std::vector<CLIPPER_Z_VALUE>&                 aZValueBuffer,
                      const std::vector<SHAPE_ARC>&                       aArcBuffer );
 
-    void inflate1( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy );
-    void inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy, bool aSimplify = false );
+    void inflate( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy,
+                  bool aSimplify = false );
 
-    void inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, int aCircleSegCount,
-                       CORNER_STRATEGY aCornerStrategy, bool aSimplify = false );
+    void inflateLine( const SHAPE_LINE_CHAIN& aLine, int aAmount, int aCircleSegCount,
+                      CORNER_STRATEGY aCornerStrategy, bool aSimplify = false );
 
     /**
      * This is the engine to execute all polygon boolean transforms (AND, OR, ... and polygon
      * simplification (merging overlapping  polygons).
      *
-     * @param aType is the transform type ( see ClipperLib::ClipType )
+     * Arcs are tagged through Clipper's Z values and restored on import.  Shapes without arcs
+     * skip the tagging altogether.
+     *
+     * @param aType is the transform type ( see Clipper2Lib::ClipType )
      * @param aOtherShape is the SHAPE_LINE_CHAIN to combine with me.
-     * @param aFastMode is an option to choose if the result can be a weak polygon
-     * or a strictly simple polygon.
-     * if aFastMode is PM_FAST the result can be a weak polygon
-     * if aFastMode is PM_STRICTLY_SIMPLE (default) the result is (theoretically) a strictly
-     * simple polygon, but calculations can be really significantly time consuming
      */
-    void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOtherShape,
-                    POLYGON_MODE aFastMode );
-
-    void booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
-                    const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode );
-
     void booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOtherShape );
 
     void booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
                     const SHAPE_POLY_SET& aOtherShape );
 
+    /**
+     * Combine all the subject sets with all the clip sets in a single sweep.
+     *
+     * The sets may alias this one: the result is only stored once they have all been read.
+     */
+    void booleanOp( Clipper2Lib::ClipType aType,
+                    const std::vector<const SHAPE_POLY_SET*>& aSubjects,
+                    const std::vector<const SHAPE_POLY_SET*>& aClips );
+
     /**
      * Check whether the point \a aP is inside the \a aSubpolyIndex-th polygon of the polyset. If
      * the points lies on an edge, the polygon is considered to contain it.
@@ -1526,12 +1629,51 @@ private:
 
     MD5_HASH checksum() const;
 
+    /// One edge index per polygon, nullptr for polygons too small to need one
+    typedef std::vector<std::unique_ptr<POLYGON_SEGMENT_INDEX>> SEGMENT_INDEX;
+
+    /**
+     * Return the edge index of the set, building it on first use.
+     *
+     * The index follows the lifecycle of the triangulation: it is enabled by
+     * CacheTriangulation(), which checks the geometry hash, and dropped by any editing
+     * function or non-const accessor.  Copies of an up-to-date set share the same index.
+     *
+     * @return the index, or nullptr if the set has been edited since CacheTriangulation().
+     */
+    std::shared_ptr<const SEGMENT_INDEX> segmentIndex() const;
+
+    /**
+     * Drop the edge index so that it is rebuilt on next use.
+     *
+     * Other threads may be reading the index of a shared set, so the pointer is only ever
+     * swapped atomically.
+     */
+    void resetSegmentIndex()
+    {
+        std::atomic_store( &m_segmentIndex, std::shared_ptr<const SEGMENT_INDEX>() );
+    }
+
+    void invalidateSegmentIndex()
+    {
+        m_segmentIndexEnabled = false;
+        resetSegmentIndex();
+    }
+
 private:
     std::vector<POLYGON>                               m_polys;
     std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> m_triangulatedPolys;
 
     bool     m_triangulationValid = false;
     MD5_HASH m_hash;
+    uint64_t m_triangulationSerial = 0;
+
+    /// Hash of each polygon as it was when its (partitioned) triangulation was built, invalid
+    /// for polygons which failed to triangulate
+    std::vector<MD5_HASH> m_outlineHashes;
+
+    std::atomic<bool>                            m_segmentIndexEnabled = false;
+    mutable std::shared_ptr<const SEGMENT_INDEX> m_segmentIndex;
 };
 
 #endif // __SHAPE_POLY_SET_H
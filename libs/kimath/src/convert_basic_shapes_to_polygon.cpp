@@ -49,8 +49,7 @@ void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCente
     if( numSegs & 1 )
         numSegs++;
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-    int       radius = aRadius;
+    int radius = aRadius;
 
     if( aErrorLoc == ERROR_OUTSIDE )
     {
@@ -61,11 +60,10 @@ void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aBuffer, const VECTOR2I& aCente
         radius += GetCircleToPolyCorrection( actual_delta_radius );
     }
 
-    for( EDA_ANGLE angle = ANGLE_0; angle < ANGLE_360; angle += delta )
+    for( const VECTOR2D& unitCorner : GetUnitCirclePolygon( numSegs ) )
     {
-        corner_position.x = radius;
-        corner_position.y = 0;
-        RotatePoint( corner_position, angle );
+        corner_position.x = KiROUND( radius * unitCorner.x );
+        corner_position.y = KiROUND( radius * unitCorner.y );
         corner_position += aCenter;
         aBuffer.Append( corner_position.x, corner_position.y );
     }
@@ -88,8 +86,7 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter,
     if( numSegs & 1 )
         numSegs++;
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-    int       radius = aRadius;
+    int radius = aRadius;
 
     if( aErrorLoc == ERROR_OUTSIDE )
     {
@@ -102,11 +99,10 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aCenter,
 
     aBuffer.NewOutline();
 
-    for( EDA_ANGLE angle = ANGLE_0; angle < ANGLE_360; angle += delta )
+    for( const VECTOR2D& unitCorner : GetUnitCirclePolygon( numSegs ) )
     {
-        corner_position.x = radius;
-        corner_position.y = 0;
-        RotatePoint( corner_position, angle );
+        corner_position.x = KiROUND( radius * unitCorner.x );
+        corner_position.y = KiROUND( radius * unitCorner.y );
         corner_position += aCenter;
         aBuffer.Append( corner_position.x, corner_position.y );
     }
@@ -134,8 +130,6 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
     // Round up to 8 to make segment approximations align properly at 45-degrees
     numSegs = ( numSegs + 7 ) / 8 * 8;
 
-    EDA_ANGLE delta = ANGLE_360 / numSegs;
-
     if( aErrorLoc == ERROR_OUTSIDE )
     {
         // The outer radius should be radius+aError
@@ -171,11 +165,15 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
 
     // add right rounded end:
 
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+    // numSegs is even and the half step offset keeps the corners well away from 180 degrees,
+    // so each end uses exactly the first half of the corners
+    const std::vector<VECTOR2D>& unitCorners = GetUnitCirclePolygon( numSegs, true );
+
+    for( int ii = 0; ii < numSegs / 2; ++ii )
     {
-        corner = VECTOR2I( 0, radius );
-        RotatePoint( corner, angle );
-        corner.x += seg_len;
+        // ( 0, radius ) rotated by the corner angle
+        corner.x = KiROUND( radius * -unitCorners[ii].y ) + seg_len;
+        corner.y = KiROUND( radius * unitCorners[ii].x );
         polyshape.Append( corner.x, corner.y );
     }
 
@@ -184,10 +182,10 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aStart, co
     polyshape.Append( corner.x, corner.y );
 
     // add left rounded end:
-    for( EDA_ANGLE angle = delta / 2; angle < ANGLE_180; angle += delta )
+    for( int ii = 0; ii < numSegs / 2; ++ii )
     {
-        corner = VECTOR2I( 0, -radius );
-        RotatePoint( corner, angle );
+        corner.x = KiROUND( -radius * -unitCorners[ii].y );
+        corner.y = KiROUND( -radius * unitCorners[ii].x );
         polyshape.Append( corner.x, corner.y );
     }
 
@@ -303,6 +301,18 @@ void CornerListToPolygon( SHAPE_POLY_SET& outline, std::vector<ROUNDED_CORNER>&
             VECTOR2I arcCenter = arcStart + incoming.Perpendicular().Resize( radius );
             VECTOR2I arcEnd, arcStartOrigin;
 
+            // arcStartOrigin rotated by -angPos, as RotatePoint() would do it
+            ARC_STEPPER rot( -angPos, -angDelta );
+
+            auto rotatedStart =
+                    [&]() -> VECTOR2I
+                    {
+                        return VECTOR2I( KiROUND( arcStartOrigin.y * rot.Sin()
+                                                  + arcStartOrigin.x * rot.Cos() ),
+                                         KiROUND( arcStartOrigin.y * rot.Cos()
+                                                  - arcStartOrigin.x * rot.Sin() ) );
+                    };
+
             if( aErrorLoc == ERROR_INSIDE )
             {
                 arcEnd = SEG( cornerPosition, arcCenter ).ReflectPoint( arcStart );
@@ -325,10 +335,9 @@ void CornerListToPolygon( SHAPE_POLY_SET& outline, std::vector<ROUNDED_CORNER>&
 
                 while( angPos < endAngle )
                 {
-                    VECTOR2I pt = arcStartOrigin;
-                    RotatePoint( pt, -angPos );
-                    pt += arcCenter;
+                    VECTOR2I pt = rotatedStart() + arcCenter;
                     angPos += angDelta;
+                    rot.Next();
 
                     if( outlineIn.Side( pt ) > 0 )
                     {
@@ -346,12 +355,8 @@ void CornerListToPolygon( SHAPE_POLY_SET& outline, std::vector<ROUNDED_CORNER>&
                 }
             }
 
-            for( ; angPos < endAngle; angPos += angDelta )
-            {
-                VECTOR2I pt = arcStartOrigin;
-                RotatePoint( pt, -angPos );
-                outline.Append( pt + arcCenter );
-            }
+            for( ; angPos < endAngle; angPos += angDelta, rot.Next() )
+                outline.Append( rotatedStart() + arcCenter );
 
             outline.Append( arcEnd );
         }
@@ -531,9 +536,9 @@ int ConvertArcToPolyline( SHAPE_LINE_CHAIN& aPolyline, VECTOR2I aCenter, int aRa
         // This is the easy case: with the error on the inside the endpoints of each segment
         // are error-free.
 
-        EDA_ANGLE rot = aStartAngle;
+        ARC_STEPPER rot( aStartAngle, delta );
 
-        for( int i = 0; i <= n; i++, rot += delta )
+        for( int i = 0; i <= n; i++, rot.Next() )
         {
             double x = aCenter.x + aRadius * rot.Cos();
             double y = aCenter.y + aRadius * rot.Sin();
@@ -556,9 +561,9 @@ int ConvertArcToPolyline( SHAPE_LINE_CHAIN& aPolyline, VECTOR2I aCenter, int aRa
 
         aPolyline.Append( KiROUND( x ), KiROUND( y ) );
 
-        EDA_ANGLE rot = aStartAngle + delta / 2;
+        ARC_STEPPER rot( aStartAngle + delta / 2, delta );
 
-        for( int i = 0; i < n; i++, rot += delta )
+        for( int i = 0; i < n; i++, rot.Next() )
         {
             x = aCenter.x + errorRadius * rot.Cos();
             y = aCenter.y + errorRadius * rot.Sin();
@@ -0,0 +1,96 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <wx/debug.h>
+
+#include <geometry/geometry_arena.h>
+
+
+namespace
+{
+
+struct ARENA_STATE
+{
+    int                                            m_depth = 0;    ///< Nested arenas
+    size_t                                         m_leased = 0;   ///< Scratch sets in use
+    std::vector<std::unique_ptr<GEOMETRY_SCRATCH>> m_scratch;
+};
+
+
+ARENA_STATE& arenaState()
+{
+    thread_local ARENA_STATE state;
+    return state;
+}
+
+} // namespace
+
+
+GEOMETRY_ARENA::GEOMETRY_ARENA()
+{
+    arenaState().m_depth++;
+}
+
+
+GEOMETRY_ARENA::~GEOMETRY_ARENA()
+{
+    ARENA_STATE& state = arenaState();
+
+    if( --state.m_depth == 0 )
+    {
+        wxASSERT( state.m_leased == 0 );
+        state.m_scratch.clear();
+        state.m_scratch.shrink_to_fit();
+    }
+}
+
+
+bool GEOMETRY_ARENA::IsActive()
+{
+    return arenaState().m_depth > 0;
+}
+
+
+GEOMETRY_ARENA::LEASE::LEASE() :
+        m_scratch( &m_local ),
+        m_borrowed( false )
+{
+    ARENA_STATE& state = arenaState();
+
+    if( state.m_depth == 0 )
+        return;
+
+    if( state.m_leased == state.m_scratch.size() )
+        state.m_scratch.emplace_back( std::make_unique<GEOMETRY_SCRATCH>() );
+
+    m_scratch = state.m_scratch[state.m_leased++].get();
+    m_scratch->Clear();
+    m_borrowed = true;
+}
+
+
+GEOMETRY_ARENA::LEASE::~LEASE()
+{
+    if( m_borrowed )
+        arenaState().m_leased--;
+}
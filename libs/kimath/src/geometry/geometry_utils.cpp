@@ -27,8 +27,13 @@
  * @brief a few functions useful in geometry calculations.
  */
 
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <algorithm>         // for max, min
+#include <map>
+#include <memory>
+#include <mutex>
 
 #include <geometry/geometry_utils.h>
 #include <math/util.h>      // for KiROUND
@@ -82,6 +87,62 @@ int CircleToEndSegmentDeltaRadius( int aRadius, int aSegCount )
     return delta;
 }
 
+
+static std::vector<VECTOR2D>* buildUnitCirclePolygon( int aSegCount, bool aHalfStep )
+{
+    std::vector<VECTOR2D>* corners = new std::vector<VECTOR2D>();
+    EDA_ANGLE              delta = ANGLE_360 / aSegCount;
+
+    corners->reserve( aSegCount + 1 );
+
+    // Accumulate the angle exactly as the callers used to, so that we visit the same angles
+    // (and, through rounding, possibly one more than aSegCount)
+    for( EDA_ANGLE angle = aHalfStep ? delta / 2 : ANGLE_0; angle < ANGLE_360; angle += delta )
+        corners->emplace_back( angle.Cos(), -angle.Sin() );
+
+    return corners;
+}
+
+
+const std::vector<VECTOR2D>& GetUnitCirclePolygon( int aSegCount, bool aHalfStep )
+{
+    // Segment counts used in practice are small: look them up without locking
+    static constexpr int MAX_DIRECT = 1024;
+
+    static std::array<std::atomic<std::vector<VECTOR2D>*>, 2 * MAX_DIRECT> s_direct{};
+    static std::mutex                                                       s_mutex;
+    static std::map<int, std::unique_ptr<std::vector<VECTOR2D>>>            s_others;
+
+    aSegCount = std::max( 1, aSegCount );
+
+    if( aSegCount < MAX_DIRECT )
+    {
+        std::atomic<std::vector<VECTOR2D>*>& slot = s_direct[2 * aSegCount + aHalfStep];
+        std::vector<VECTOR2D>*               corners = slot.load( std::memory_order_acquire );
+
+        if( !corners )
+        {
+            std::vector<VECTOR2D>* built = buildUnitCirclePolygon( aSegCount, aHalfStep );
+
+            // Another thread may have beaten us to it: keep its table
+            if( slot.compare_exchange_strong( corners, built, std::memory_order_acq_rel ) )
+                corners = built;
+            else
+                delete built;
+        }
+
+        return *corners;
+    }
+
+    std::lock_guard<std::mutex>             lock( s_mutex );
+    std::unique_ptr<std::vector<VECTOR2D>>& corners = s_others[2 * aSegCount + aHalfStep];
+
+    if( !corners )
+        corners.reset( buildUnitCirclePolygon( aSegCount, aHalfStep ) );
+
+    return *corners;
+}
+
 // When creating polygons to create a clearance polygonal area, the polygon must
 // be same or bigger than the original shape.
 // Polygons are bigger if the original shape has arcs (round rectangles, ovals,
@@ -0,0 +1,627 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/monotone_triangulation.h>
+
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <vector>
+
+
+namespace
+{
+
+typedef VECTOR2I::extended_type ecoord;
+
+
+/**
+ * The sweep order: top to bottom, and left to right along a horizontal line.
+ *
+ * Breaking ties on x is equivalent to rotating the plane by an infinitesimal angle, so no two
+ * distinct vertices are ever on the sweep line at the same time.
+ */
+inline bool isAbove( const VECTOR2I& aA, const VECTOR2I& aB )
+{
+    return aA.y > aB.y || ( aA.y == aB.y && aA.x < aB.x );
+}
+
+
+/// Twice the signed area of ( aA, aB, aC ), positive when counterclockwise
+inline ecoord cross( const VECTOR2I& aA, const VECTOR2I& aB, const VECTOR2I& aC )
+{
+    return ( (ecoord) aB.x - aA.x ) * ( (ecoord) aC.y - aA.y )
+           - ( (ecoord) aB.y - aA.y ) * ( (ecoord) aC.x - aA.x );
+}
+
+
+enum VERTEX_TYPE
+{
+    START,
+    END,
+    SPLIT,
+    MERGE,
+    REGULAR
+};
+
+
+/**
+ * Orders the edges crossed by the sweep line from left to right.
+ *
+ * Edges are identified by their first vertex and always go downwards in the sweep order.  They
+ * never cross nor share an end point while they are in the sweep status, so comparing them
+ * where the lowest starting one begins is enough.  Points can be looked up too, to find the
+ * edge directly left of a vertex.
+ */
+struct SWEEP_EDGE_LESS
+{
+    typedef void is_transparent;
+
+    struct POINT_KEY
+    {
+        VECTOR2I m_p;
+    };
+
+    const std::vector<VECTOR2I>* m_points;
+    const std::vector<int>*      m_next;
+    bool*                        m_degenerate;
+
+    /// Positive if \a aP lies right of \a aEdge, negative if it lies left of it
+    ecoord side( int aEdge, const VECTOR2I& aP ) const
+    {
+        return cross( ( *m_points )[aEdge], ( *m_points )[( *m_next )[aEdge]], aP );
+    }
+
+    bool operator()( int aA, int aB ) const
+    {
+        if( aA == aB )
+            return false;
+
+        const std::vector<VECTOR2I>& pts = *m_points;
+
+        bool   aIsLower = isAbove( pts[aB], pts[aA] );
+        int    ref = aIsLower ? aA : aB;
+        int    other = aIsLower ? aB : aA;
+        ecoord s = side( other, pts[ref] );
+
+        if( s == 0 )
+            s = side( other, pts[( *m_next )[ref]] );
+
+        if( s == 0 )
+        {
+            *m_degenerate = true;
+            return aA < aB;
+        }
+
+        return aIsLower ? s < 0 : s > 0;
+    }
+
+    bool operator()( int aEdge, const POINT_KEY& aKey ) const
+    {
+        ecoord s = side( aEdge, aKey.m_p );
+
+        if( s == 0 )
+            *m_degenerate = true;
+
+        return s > 0;
+    }
+
+    bool operator()( const POINT_KEY& aKey, int aEdge ) const
+    {
+        ecoord s = side( aEdge, aKey.m_p );
+
+        if( s == 0 )
+            *m_degenerate = true;
+
+        return s < 0;
+    }
+};
+
+} // namespace
+
+
+bool MONOTONE_TRIANGULATION::TesselatePolygon( const SHAPE_POLY_SET::POLYGON& aPolygon )
+{
+    m_result.Clear();
+
+    if( !triangulate( aPolygon ) )
+    {
+        m_result.Clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool MONOTONE_TRIANGULATION::triangulate( const SHAPE_POLY_SET::POLYGON& aPolygon )
+{
+    std::vector<VECTOR2I> pts;
+    std::vector<int>      prev;
+    std::vector<int>      next;
+    ecoord                polygonArea = 0;
+
+    if( aPolygon.empty() )
+        return false;
+
+    // Gather all the contours, counterclockwise for the outline and clockwise for the holes,
+    // so the interior is always on the left of the edges
+    for( size_t contour = 0; contour < aPolygon.size(); ++contour )
+    {
+        const SHAPE_LINE_CHAIN& chain = aPolygon[contour];
+        int                     first = (int) pts.size();
+
+        for( int ii = 0; ii < chain.PointCount(); ++ii )
+        {
+            const VECTOR2I& pt = chain.CPoint( ii );
+
+            if( (int) pts.size() == first || pts.back() != pt )
+                pts.push_back( pt );
+        }
+
+        while( (int) pts.size() > first + 1 && pts.back() == pts[first] )
+            pts.pop_back();
+
+        int count = (int) pts.size() - first;
+
+        if( count < 3 )
+            return false;
+
+        ecoord area = 0;
+
+        for( int ii = first + 1; ii + 1 < first + count; ++ii )
+            area += cross( pts[first], pts[ii], pts[ii + 1] );
+
+        if( area == 0 )
+            return false;
+
+        if( ( contour == 0 ) != ( area > 0 ) )
+        {
+            std::reverse( pts.begin() + first, pts.end() );
+            area = -area;
+        }
+
+        polygonArea += area;
+
+        for( int ii = 0; ii < count; ++ii )
+        {
+            prev.push_back( first + ( ii + count - 1 ) % count );
+            next.push_back( first + ( ii + 1 ) % count );
+        }
+    }
+
+    if( polygonArea <= 0 )
+        return false;
+
+    int              n = (int) pts.size();
+    std::vector<int> order( n );
+
+    std::iota( order.begin(), order.end(), 0 );
+    std::sort( order.begin(), order.end(),
+               [&]( int aA, int aB )
+               {
+                   return isAbove( pts[aA], pts[aB] );
+               } );
+
+    // Contours touching each other aren't supported
+    for( int ii = 1; ii < n; ++ii )
+    {
+        if( pts[order[ii - 1]] == pts[order[ii]] )
+            return false;
+    }
+
+    std::vector<VERTEX_TYPE> type( n );
+
+    for( int v = 0; v < n; ++v )
+    {
+        const VECTOR2I& pt = pts[v];
+        const VECTOR2I& p = pts[prev[v]];
+        const VECTOR2I& q = pts[next[v]];
+        bool            prevBelow = isAbove( pt, p );
+        bool            nextBelow = isAbove( pt, q );
+        ecoord          turn = cross( p, pt, q );
+
+        if( prevBelow == nextBelow )
+        {
+            // Both neighbours on the same side and aligned: a zero width spike
+            if( turn == 0 )
+                return false;
+
+            if( prevBelow )
+                type[v] = turn > 0 ? START : SPLIT;
+            else
+                type[v] = turn > 0 ? END : MERGE;
+        }
+        else
+        {
+            type[v] = REGULAR;
+        }
+    }
+
+    // Sweep from top to bottom, adding diagonals which split the polygon into y-monotone pieces
+    typedef std::set<int, SWEEP_EDGE_LESS> STATUS;
+
+    bool                            degenerate = false;
+    STATUS                          status( SWEEP_EDGE_LESS{ &pts, &next, &degenerate } );
+    std::vector<STATUS::iterator>   position( n, status.end() );
+    std::vector<int>                helper( n, -1 );
+    std::vector<std::pair<int, int>> diagonals;
+
+    auto insertEdge =
+            [&]( int aEdge, int aHelper )
+            {
+                position[aEdge] = status.insert( aEdge ).first;
+                helper[aEdge] = aHelper;
+            };
+
+    auto removeEdge =
+            [&]( int aEdge )
+            {
+                status.erase( position[aEdge] );
+                position[aEdge] = status.end();
+            };
+
+    auto leftEdge =
+            [&]( int aVertex ) -> int
+            {
+                SWEEP_EDGE_LESS::POINT_KEY key{ pts[aVertex] };
+                STATUS::iterator           it = status.upper_bound( key );
+
+                if( it == status.begin() )
+                    return -1;
+
+                return *std::prev( it );
+            };
+
+    auto connectMergeHelper =
+            [&]( int aVertex, int aEdge )
+            {
+                if( type[helper[aEdge]] == MERGE )
+                    diagonals.emplace_back( aVertex, helper[aEdge] );
+            };
+
+    for( int v : order )
+    {
+        int inEdge = prev[v];
+        int left;
+
+        switch( type[v] )
+        {
+        case START:
+            insertEdge( v, v );
+            break;
+
+        case END:
+            if( position[inEdge] == status.end() )
+                return false;
+
+            connectMergeHelper( v, inEdge );
+            removeEdge( inEdge );
+            break;
+
+        case SPLIT:
+            if( ( left = leftEdge( v ) ) < 0 )
+                return false;
+
+            diagonals.emplace_back( v, helper[left] );
+            helper[left] = v;
+            insertEdge( v, v );
+            break;
+
+        case MERGE:
+            if( position[inEdge] == status.end() )
+                return false;
+
+            connectMergeHelper( v, inEdge );
+            removeEdge( inEdge );
+
+            if( ( left = leftEdge( v ) ) < 0 )
+                return false;
+
+            connectMergeHelper( v, left );
+            helper[left] = v;
+            break;
+
+        case REGULAR:
+            if( isAbove( pts[prev[v]], pts[v] ) )
+            {
+                // The interior is on the right: we are on the left boundary of a piece
+                if( position[inEdge] == status.end() )
+                    return false;
+
+                connectMergeHelper( v, inEdge );
+                removeEdge( inEdge );
+                insertEdge( v, v );
+            }
+            else
+            {
+                if( ( left = leftEdge( v ) ) < 0 )
+                    return false;
+
+                connectMergeHelper( v, left );
+                helper[left] = v;
+            }
+
+            break;
+        }
+
+        if( degenerate )
+            return false;
+    }
+
+    // Adjacency of each vertex (boundary edges and diagonals), sorted counterclockwise
+    std::vector<int> offset( n + 1, 0 );
+
+    for( int v = 0; v < n; ++v )
+        offset[v + 1] = 2;
+
+    for( const std::pair<int, int>& diagonal : diagonals )
+    {
+        offset[diagonal.first + 1]++;
+        offset[diagonal.second + 1]++;
+    }
+
+    std::partial_sum( offset.begin(), offset.end(), offset.begin() );
+
+    std::vector<int> adjacent( offset[n] );
+    std::vector<int> fill( offset.begin(), offset.end() - 1 );
+
+    for( int v = 0; v < n; ++v )
+    {
+        adjacent[fill[v]++] = next[v];
+        adjacent[fill[v]++] = prev[v];
+    }
+
+    for( const std::pair<int, int>& diagonal : diagonals )
+    {
+        adjacent[fill[diagonal.first]++] = diagonal.second;
+        adjacent[fill[diagonal.second]++] = diagonal.first;
+    }
+
+    for( int v = 0; v < n; ++v )
+    {
+        if( offset[v + 1] - offset[v] == 2 )
+            continue;
+
+        const VECTOR2I& center = pts[v];
+
+        auto halfPlane =
+                [&]( int aTarget )
+                {
+                    const VECTOR2I& pt = pts[aTarget];
+                    return pt.y < center.y || ( pt.y == center.y && pt.x < center.x );
+                };
+
+        std::sort( adjacent.begin() + offset[v], adjacent.begin() + offset[v + 1],
+                   [&]( int aA, int aB )
+                   {
+                       bool halfA = halfPlane( aA );
+                       bool halfB = halfPlane( aB );
+
+                       if( halfA != halfB )
+                           return halfB;
+
+                       return cross( center, pts[aA], pts[aB] ) > 0;
+                   } );
+
+        for( int k = offset[v] + 1; k < offset[v + 1]; ++k )
+        {
+            if( halfPlane( adjacent[k - 1] ) == halfPlane( adjacent[k] )
+                && cross( center, pts[adjacent[k - 1]], pts[adjacent[k]] ) == 0 )
+            {
+                return false;
+            }
+        }
+    }
+
+    for( const VECTOR2I& pt : pts )
+        m_result.AddVertex( pt );
+
+    ecoord triangleArea = 0;
+
+    auto addTriangle =
+            [&]( int aA, int aB, int aC )
+            {
+                ecoord area = cross( pts[aA], pts[aB], pts[aC] );
+
+                if( area == 0 )
+                    return;
+
+                if( area < 0 )
+                {
+                    std::swap( aB, aC );
+                    area = -area;
+                }
+
+                m_result.AddTriangle( aA, aB, aC );
+                triangleArea += area;
+            };
+
+    // Walk the faces left of each half edge.  The reversed boundary edges are the outside.
+    std::vector<char> used( adjacent.size(), 0 );
+
+    for( int v = 0; v < n; ++v )
+    {
+        for( int k = offset[v]; k < offset[v + 1]; ++k )
+        {
+            if( adjacent[k] == prev[v] )
+                used[k] = 1;
+        }
+    }
+
+    std::vector<int>  face;
+    std::vector<int>  sorted;
+    std::vector<char> rightChain;
+    std::vector<int>  stack;
+
+    for( int v = 0; v < n; ++v )
+    {
+        for( int k = offset[v]; k < offset[v + 1]; ++k )
+        {
+            if( used[k] )
+                continue;
+
+            face.clear();
+
+            int from = v;
+            int slot = k;
+
+            while( !used[slot] )
+            {
+                used[slot] = 1;
+                face.push_back( from );
+
+                int to = adjacent[slot];
+                int back = -1;
+
+                for( int jj = offset[to]; jj < offset[to + 1] && back < 0; ++jj )
+                {
+                    if( adjacent[jj] == from )
+                        back = jj;
+                }
+
+                if( back < 0 || (int) face.size() > n )
+                    return false;
+
+                // The next edge of the face is the first one clockwise from the way back
+                int degree = offset[to + 1] - offset[to];
+
+                slot = offset[to] + ( back - offset[to] + degree - 1 ) % degree;
+                from = to;
+            }
+
+            if( from != v || slot != k || face.size() < 3 )
+                return false;
+
+            // Triangulate the y-monotone face.  Counterclockwise from the top vertex is the
+            // left chain, clockwise is the right chain.
+            size_t m = face.size();
+            size_t top = 0;
+            size_t bottom = 0;
+
+            for( size_t ii = 1; ii < m; ++ii )
+            {
+                if( isAbove( pts[face[ii]], pts[face[top]] ) )
+                    top = ii;
+
+                if( isAbove( pts[face[bottom]], pts[face[ii]] ) )
+                    bottom = ii;
+            }
+
+            sorted.clear();
+            rightChain.clear();
+            sorted.push_back( face[top] );
+            rightChain.push_back( 0 );
+
+            size_t l = ( top + 1 ) % m;
+            size_t r = ( top + m - 1 ) % m;
+
+            while( l != bottom || r != bottom )
+            {
+                bool takeLeft;
+
+                if( l == bottom )
+                    takeLeft = false;
+                else if( r == bottom )
+                    takeLeft = true;
+                else
+                    takeLeft = isAbove( pts[face[l]], pts[face[r]] );
+
+                if( takeLeft )
+                {
+                    sorted.push_back( face[l] );
+                    rightChain.push_back( 0 );
+                    l = ( l + 1 ) % m;
+                }
+                else
+                {
+                    sorted.push_back( face[r] );
+                    rightChain.push_back( 1 );
+                    r = ( r + m - 1 ) % m;
+                }
+            }
+
+            sorted.push_back( face[bottom] );
+            rightChain.push_back( 0 );
+
+            for( size_t ii = 1; ii < m; ++ii )
+            {
+                if( !isAbove( pts[sorted[ii - 1]], pts[sorted[ii]] ) )
+                    return false;
+            }
+
+            stack.assign( { 0, 1 } );
+
+            for( int jj = 2; jj + 1 < (int) m; ++jj )
+            {
+                if( rightChain[jj] != rightChain[stack.back()] )
+                {
+                    // Fan from the opposite chain
+                    while( stack.size() > 1 )
+                    {
+                        int last = stack.back();
+                        stack.pop_back();
+                        addTriangle( sorted[jj], sorted[last], sorted[stack.back()] );
+                    }
+
+                    stack.assign( { jj - 1, jj } );
+                }
+                else
+                {
+                    int last = stack.back();
+                    stack.pop_back();
+
+                    while( !stack.empty() )
+                    {
+                        ecoord turn = cross( pts[sorted[stack.back()]], pts[sorted[last]],
+                                             pts[sorted[jj]] );
+
+                        // Stop at the first diagonal which would go outside of this face
+                        if( rightChain[jj] ? turn >= 0 : turn <= 0 )
+                            break;
+
+                        addTriangle( sorted[stack.back()], sorted[last], sorted[jj] );
+                        last = stack.back();
+                        stack.pop_back();
+                    }
+
+                    stack.push_back( last );
+                    stack.push_back( jj );
+                }
+            }
+
+            int last = stack.back();
+            stack.pop_back();
+
+            while( !stack.empty() )
+            {
+                addTriangle( sorted[stack.back()], sorted[last], sorted[m - 1] );
+                last = stack.back();
+                stack.pop_back();
+            }
+        }
+    }
+
+    // Any remaining degeneracy shows up as missing or overlapping triangles
+    return triangleArea == polygonArea;
+}
@@ -0,0 +1,394 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <climits>
+
+#include <geometry/polygon_segment_index.h>
+#include <geometry/shape_line_chain.h>
+#include <math/util.h>
+
+
+/// Maximum number of edges in a leaf node
+static constexpr uint32_t LEAF_SIZE = 8;
+
+/// Enough for any tree built from a 32-bit item count
+static constexpr int MAX_DEPTH = 64;
+
+
+POLYGON_SEGMENT_INDEX::POLYGON_SEGMENT_INDEX( const std::vector<SHAPE_LINE_CHAIN>& aPolygon )
+{
+    for( size_t contour = 0; contour < aPolygon.size(); ++contour )
+    {
+        const SHAPE_LINE_CHAIN& chain = aPolygon[contour];
+
+        for( int ii = 0; ii < chain.SegmentCount(); ++ii )
+            m_items.push_back( { chain.CSegment( ii ), static_cast<int>( contour ) } );
+
+        m_closedContours.push_back( chain.IsClosed() && chain.PointCount() >= 3 );
+    }
+
+    if( !m_items.empty() )
+    {
+        m_nodes.reserve( 2 * m_items.size() / LEAF_SIZE + 1 );
+        build( 0, static_cast<uint32_t>( m_items.size() ) );
+    }
+}
+
+
+uint32_t POLYGON_SEGMENT_INDEX::build( uint32_t aFirst, uint32_t aCount )
+{
+    uint32_t nodeIdx = static_cast<uint32_t>( m_nodes.size() );
+    NODE     node = { INT_MAX, INT_MAX, INT_MIN, INT_MIN, aFirst, aCount };
+
+    // Edge midpoints (times two, to stay in integers) decide the split
+    int64_t cMinX = INT64_MAX, cMinY = INT64_MAX, cMaxX = INT64_MIN, cMaxY = INT64_MIN;
+
+    for( uint32_t ii = aFirst; ii < aFirst + aCount; ++ii )
+    {
+        const SEG& s = m_items[ii].m_seg;
+
+        node.m_minX = std::min( { node.m_minX, s.A.x, s.B.x } );
+        node.m_minY = std::min( { node.m_minY, s.A.y, s.B.y } );
+        node.m_maxX = std::max( { node.m_maxX, s.A.x, s.B.x } );
+        node.m_maxY = std::max( { node.m_maxY, s.A.y, s.B.y } );
+
+        int64_t cx = int64_t( s.A.x ) + s.B.x;
+        int64_t cy = int64_t( s.A.y ) + s.B.y;
+
+        cMinX = std::min( cMinX, cx );
+        cMinY = std::min( cMinY, cy );
+        cMaxX = std::max( cMaxX, cx );
+        cMaxY = std::max( cMaxY, cy );
+    }
+
+    m_nodes.push_back( node );
+
+    if( aCount <= LEAF_SIZE )
+        return nodeIdx;
+
+    bool     splitX = cMaxX - cMinX >= cMaxY - cMinY;
+    uint32_t half = aCount / 2;
+
+    std::nth_element( m_items.begin() + aFirst, m_items.begin() + aFirst + half,
+                      m_items.begin() + aFirst + aCount,
+                      [splitX]( const ITEM& aLhs, const ITEM& aRhs )
+                      {
+                          if( splitX )
+                              return int64_t( aLhs.m_seg.A.x ) + aLhs.m_seg.B.x
+                                     < int64_t( aRhs.m_seg.A.x ) + aRhs.m_seg.B.x;
+
+                          return int64_t( aLhs.m_seg.A.y ) + aLhs.m_seg.B.y
+                                 < int64_t( aRhs.m_seg.A.y ) + aRhs.m_seg.B.y;
+                      } );
+
+    // The first child immediately follows its parent
+    build( aFirst, half );
+    uint32_t second = build( aFirst + half, aCount - half );
+
+    m_nodes[nodeIdx].m_first = second;
+    m_nodes[nodeIdx].m_count = 0;
+
+    return nodeIdx;
+}
+
+
+static inline SEG::ecoord boxSquaredDistance( int aMinX, int aMinY, int aMaxX, int aMaxY,
+                                              int aOtherMinX, int aOtherMinY, int aOtherMaxX,
+                                              int aOtherMaxY )
+{
+    SEG::ecoord dx = std::max( { SEG::ecoord( aMinX ) - aOtherMaxX,
+                                 SEG::ecoord( aOtherMinX ) - aMaxX, SEG::ecoord( 0 ) } );
+    SEG::ecoord dy = std::max( { SEG::ecoord( aMinY ) - aOtherMaxY,
+                                 SEG::ecoord( aOtherMinY ) - aMaxY, SEG::ecoord( 0 ) } );
+
+    return dx * dx + dy * dy;
+}
+
+
+template <typename FUNC>
+void POLYGON_SEGMENT_INDEX::forEachRayCrossing( const VECTOR2I& aP, FUNC aFunc ) const
+{
+    if( m_nodes.empty() )
+        return;
+
+    uint32_t stack[MAX_DEPTH];
+    int      top = 0;
+
+    stack[top++] = 0;
+
+    while( top )
+    {
+        uint32_t    nodeIdx = stack[--top];
+        const NODE& node = m_nodes[nodeIdx];
+
+        // A crossed edge has one end above the ray and one on or below it, and crosses it on
+        // the right of aP (which rounding can't move outside the edge's x range)
+        if( node.m_minY > aP.y || node.m_maxY <= aP.y || node.m_maxX <= aP.x )
+            continue;
+
+        if( node.m_count )
+        {
+            for( uint32_t ii = node.m_first; ii < node.m_first + node.m_count; ++ii )
+            {
+                const VECTOR2I& p1 = m_items[ii].m_seg.A;
+                const VECTOR2I& p2 = m_items[ii].m_seg.B;
+                const VECTOR2I  diff = p2 - p1;
+
+                if( diff.y != 0 )
+                {
+                    const int d = rescale( diff.x, ( aP.y - p1.y ), diff.y );
+
+                    if( ( ( p1.y > aP.y ) != ( p2.y > aP.y ) ) && ( aP.x - p1.x < d ) )
+                        aFunc( m_items[ii].m_contour );
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.m_first;
+            stack[top++] = nodeIdx + 1;
+        }
+    }
+}
+
+
+bool POLYGON_SEGMENT_INDEX::onContourEdge( int aContour, const VECTOR2I& aP,
+                                           int aAccuracy ) const
+{
+    if( m_nodes.empty() )
+        return false;
+
+    // SEG::Distance() rounds down, so Distance() <= aAccuracy + 1 is d^2 < ( aAccuracy + 2 )^2
+    SEG::ecoord limit = SEG::Square( aAccuracy + 2 );
+    uint32_t    stack[MAX_DEPTH];
+    int         top = 0;
+
+    stack[top++] = 0;
+
+    while( top )
+    {
+        uint32_t    nodeIdx = stack[--top];
+        const NODE& node = m_nodes[nodeIdx];
+
+        if( boxSquaredDistance( node.m_minX, node.m_minY, node.m_maxX, node.m_maxY,
+                                aP.x, aP.y, aP.x, aP.y ) >= limit )
+        {
+            continue;
+        }
+
+        if( node.m_count )
+        {
+            for( uint32_t ii = node.m_first; ii < node.m_first + node.m_count; ++ii )
+            {
+                const SEG& s = m_items[ii].m_seg;
+
+                if( m_items[ii].m_contour != aContour )
+                    continue;
+
+                if( s.A == aP || s.B == aP || s.Distance( aP ) <= aAccuracy + 1 )
+                    return true;
+            }
+        }
+        else
+        {
+            stack[top++] = node.m_first;
+            stack[top++] = nodeIdx + 1;
+        }
+    }
+
+    return false;
+}
+
+
+bool POLYGON_SEGMENT_INDEX::Contains( const VECTOR2I& aP, int aAccuracy ) const
+{
+    if( m_closedContours.empty() || !m_closedContours[0] )
+        return false;
+
+    bool              inOutline = false;
+    std::vector<bool> inHole( m_closedContours.size(), false );
+
+    forEachRayCrossing( aP,
+                        [&]( int aContour )
+                        {
+                            if( aContour == 0 )
+                                inOutline = !inOutline;
+                            else
+                                inHole[aContour] = !inHole[aContour];
+                        } );
+
+    if( !inOutline && ( aAccuracy <= 1 || !onContourEdge( 0, aP, aAccuracy ) ) )
+        return false;
+
+    for( size_t ii = 1; ii < m_closedContours.size(); ++ii )
+    {
+        if( m_closedContours[ii] && inHole[ii] )
+            return false;
+    }
+
+    return true;
+}
+
+
+bool POLYGON_SEGMENT_INDEX::OutlineContains( const VECTOR2I& aP, int aAccuracy ) const
+{
+    if( m_closedContours.empty() || !m_closedContours[0] )
+        return false;
+
+    bool inside = false;
+
+    forEachRayCrossing( aP,
+                        [&]( int aContour )
+                        {
+                            if( aContour == 0 )
+                                inside = !inside;
+                        } );
+
+    return inside || ( aAccuracy > 1 && onContourEdge( 0, aP, aAccuracy ) );
+}
+
+
+SEG::ecoord POLYGON_SEGMENT_INDEX::SquaredEdgeDistance( const VECTOR2I& aP,
+                                                        VECTOR2I* aNearest ) const
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+    if( m_nodes.empty() )
+        return best;
+
+    uint32_t stack[MAX_DEPTH];
+    int      top = 0;
+
+    stack[top++] = 0;
+
+    while( top && best > 0 )
+    {
+        uint32_t    nodeIdx = stack[--top];
+        const NODE& node = m_nodes[nodeIdx];
+
+        if( boxSquaredDistance( node.m_minX, node.m_minY, node.m_maxX, node.m_maxY,
+                                aP.x, aP.y, aP.x, aP.y ) >= best )
+        {
+            continue;
+        }
+
+        if( node.m_count )
+        {
+            for( uint32_t ii = node.m_first; ii < node.m_first + node.m_count; ++ii )
+            {
+                const SEG&  s = m_items[ii].m_seg;
+                SEG::ecoord dist = s.SquaredDistance( aP );
+
+                if( dist < best )
+                {
+                    if( aNearest )
+                        *aNearest = s.NearestPoint( aP );
+
+                    best = dist;
+                }
+            }
+        }
+        else
+        {
+            // Visit the nearer child first so that it tightens the bound for the other one
+            const NODE& first = m_nodes[nodeIdx + 1];
+            const NODE& second = m_nodes[node.m_first];
+
+            SEG::ecoord d1 = boxSquaredDistance( first.m_minX, first.m_minY, first.m_maxX,
+                                                 first.m_maxY, aP.x, aP.y, aP.x, aP.y );
+            SEG::ecoord d2 = boxSquaredDistance( second.m_minX, second.m_minY, second.m_maxX,
+                                                 second.m_maxY, aP.x, aP.y, aP.x, aP.y );
+
+            if( d1 <= d2 )
+            {
+                stack[top++] = node.m_first;
+                stack[top++] = nodeIdx + 1;
+            }
+            else
+            {
+                stack[top++] = nodeIdx + 1;
+                stack[top++] = node.m_first;
+            }
+        }
+    }
+
+    return best;
+}
+
+
+SEG::ecoord POLYGON_SEGMENT_INDEX::SquaredEdgeDistance( const SEG& aSeg,
+                                                        VECTOR2I* aNearest ) const
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+    if( m_nodes.empty() )
+        return best;
+
+    const int minX = std::min( aSeg.A.x, aSeg.B.x );
+    const int minY = std::min( aSeg.A.y, aSeg.B.y );
+    const int maxX = std::max( aSeg.A.x, aSeg.B.x );
+    const int maxY = std::max( aSeg.A.y, aSeg.B.y );
+
+    uint32_t stack[MAX_DEPTH];
+    int      top = 0;
+
+    stack[top++] = 0;
+
+    while( top && best > 0 )
+    {
+        uint32_t    nodeIdx = stack[--top];
+        const NODE& node = m_nodes[nodeIdx];
+
+        // The distance between the bounding boxes is a lower bound of the edge distance
+        if( boxSquaredDistance( node.m_minX, node.m_minY, node.m_maxX, node.m_maxY,
+                                minX, minY, maxX, maxY ) >= best )
+        {
+            continue;
+        }
+
+        if( node.m_count )
+        {
+            for( uint32_t ii = node.m_first; ii < node.m_first + node.m_count; ++ii )
+            {
+                const SEG&  s = m_items[ii].m_seg;
+                SEG::ecoord dist = s.SquaredDistance( aSeg );
+
+                if( dist < best )
+                {
+                    if( aNearest )
+                        *aNearest = s.NearestPoint( aSeg );
+
+                    best = dist;
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.m_first;
+            stack[top++] = nodeIdx + 1;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,264 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+
+// On x86-64 the AVX2 kernel is built even when the compiler does not target AVX2 by default,
+// and selected at runtime if the CPU supports it.
+#if defined( __AVX2__ )
+#define SEG_KERNEL_AVX2
+#define SEG_KERNEL_AVX2_TARGET
+#elif defined( __x86_64__ ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#define SEG_KERNEL_AVX2
+#define SEG_KERNEL_AVX2_TARGET __attribute__( ( target( "avx2" ) ) )
+#define SEG_KERNEL_AVX2_DISPATCH
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+#define SEG_KERNEL_NEON
+#endif
+
+#if defined( SEG_KERNEL_AVX2 )
+#include <immintrin.h>
+#elif defined( SEG_KERNEL_NEON )
+#include <arm_neon.h>
+#endif
+
+#include <geometry/seg_distance_kernel.h>
+
+
+/// Margin (in internal units) covering the rounding of the kernel and of SEG::NearestPoint()
+static constexpr double DISTANCE_SLACK = 2.0;
+
+
+static inline bool isNear( const VECTOR2I& aA, const VECTOR2I& aB, const VECTOR2D& aP,
+                           double aThresholdSq )
+{
+    double dx = (double) aB.x - aA.x;
+    double dy = (double) aB.y - aA.y;
+    double qx = aP.x - aA.x;
+    double qy = aP.y - aA.y;
+
+    // Lengths are integers, so clamping the divisor to 1 only affects degenerate segments,
+    // for which the dot product is zero anyway
+    double t = ( qx * dx + qy * dy ) / std::max( dx * dx + dy * dy, 1.0 );
+
+    t = std::clamp( t, 0.0, 1.0 );
+
+    double ex = qx - t * dx;
+    double ey = qy - t * dy;
+
+    return ex * ex + ey * ey <= aThresholdSq;
+}
+
+
+static size_t findScalar( const VECTOR2I* aPoints, size_t aSegmentCount, size_t aStart,
+                          const VECTOR2D& aP, double aThresholdSq )
+{
+    for( size_t i = aStart; i < aSegmentCount; ++i )
+    {
+        if( isNear( aPoints[i], aPoints[i + 1], aP, aThresholdSq ) )
+            return i;
+    }
+
+    return aSegmentCount;
+}
+
+
+/**
+ * @return the first set bit of a non-zero lane mask, as a segment offset.
+ */
+static inline size_t firstLane( int aMask )
+{
+    size_t lane = 0;
+
+    while( !( aMask & ( 1 << lane ) ) )
+        lane++;
+
+    return lane;
+}
+
+
+#if defined( SEG_KERNEL_AVX2 )
+
+/**
+ * @return a bit mask of which of the four segments starting at \a aPoints are near \a aP.
+ */
+SEG_KERNEL_AVX2_TARGET
+static inline int nearMask4( const VECTOR2I* aPoints, __m256d aPx, __m256d aPy,
+                             __m256d aThresholdSq )
+{
+    // Each load brings in four VECTOR2Is; shuffle them into x0..x3 | y0..y3
+    const __m256i deinterleave = _mm256_setr_epi32( 0, 2, 4, 6, 1, 3, 5, 7 );
+
+    __m256i a = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256( reinterpret_cast<const __m256i*>( aPoints ) ), deinterleave );
+    __m256i b = _mm256_permutevar8x32_epi32(
+            _mm256_loadu_si256( reinterpret_cast<const __m256i*>( aPoints + 1 ) ), deinterleave );
+
+    __m256d ax = _mm256_cvtepi32_pd( _mm256_castsi256_si128( a ) );
+    __m256d ay = _mm256_cvtepi32_pd( _mm256_extracti128_si256( a, 1 ) );
+    __m256d bx = _mm256_cvtepi32_pd( _mm256_castsi256_si128( b ) );
+    __m256d by = _mm256_cvtepi32_pd( _mm256_extracti128_si256( b, 1 ) );
+
+    __m256d dx = _mm256_sub_pd( bx, ax );
+    __m256d dy = _mm256_sub_pd( by, ay );
+    __m256d qx = _mm256_sub_pd( aPx, ax );
+    __m256d qy = _mm256_sub_pd( aPy, ay );
+
+    __m256d len2 = _mm256_add_pd( _mm256_mul_pd( dx, dx ), _mm256_mul_pd( dy, dy ) );
+    __m256d dot = _mm256_add_pd( _mm256_mul_pd( qx, dx ), _mm256_mul_pd( qy, dy ) );
+    __m256d t = _mm256_div_pd( dot, _mm256_max_pd( len2, _mm256_set1_pd( 1.0 ) ) );
+
+    t = _mm256_min_pd( _mm256_max_pd( t, _mm256_setzero_pd() ), _mm256_set1_pd( 1.0 ) );
+
+    __m256d ex = _mm256_sub_pd( qx, _mm256_mul_pd( t, dx ) );
+    __m256d ey = _mm256_sub_pd( qy, _mm256_mul_pd( t, dy ) );
+    __m256d d2 = _mm256_add_pd( _mm256_mul_pd( ex, ex ), _mm256_mul_pd( ey, ey ) );
+
+    return _mm256_movemask_pd( _mm256_cmp_pd( d2, aThresholdSq, _CMP_LE_OQ ) );
+}
+
+
+SEG_KERNEL_AVX2_TARGET
+static size_t findVector( const VECTOR2I* aPoints, size_t aSegmentCount, size_t aStart,
+                          const VECTOR2D& aP, double aThresholdSq )
+{
+    __m256d px = _mm256_set1_pd( aP.x );
+    __m256d py = _mm256_set1_pd( aP.y );
+    __m256d thr = _mm256_set1_pd( aThresholdSq );
+    size_t  i = aStart;
+
+    // The second load of each block reads aPoints[i + 4], the end point of the last segment
+    for( ; i + 4 <= aSegmentCount; i += 4 )
+    {
+        if( int mask = nearMask4( aPoints + i, px, py, thr ) )
+            return i + firstLane( mask );
+    }
+
+    return findScalar( aPoints, aSegmentCount, i, aP, aThresholdSq );
+}
+
+
+static bool vectorKernelAvailable()
+{
+#if defined( SEG_KERNEL_AVX2_DISPATCH )
+    static const bool available = __builtin_cpu_supports( "avx2" );
+    return available;
+#else
+    return true;
+#endif
+}
+
+#elif defined( SEG_KERNEL_NEON )
+
+static inline uint64x2_t nearMask2( float64x2_t ax, float64x2_t ay, float64x2_t bx,
+                                    float64x2_t by, float64x2_t aPx, float64x2_t aPy,
+                                    float64x2_t aThresholdSq )
+{
+    float64x2_t dx = vsubq_f64( bx, ax );
+    float64x2_t dy = vsubq_f64( by, ay );
+    float64x2_t qx = vsubq_f64( aPx, ax );
+    float64x2_t qy = vsubq_f64( aPy, ay );
+
+    float64x2_t len2 = vaddq_f64( vmulq_f64( dx, dx ), vmulq_f64( dy, dy ) );
+    float64x2_t dot = vaddq_f64( vmulq_f64( qx, dx ), vmulq_f64( qy, dy ) );
+    float64x2_t t = vdivq_f64( dot, vmaxq_f64( len2, vdupq_n_f64( 1.0 ) ) );
+
+    t = vminq_f64( vmaxq_f64( t, vdupq_n_f64( 0.0 ) ), vdupq_n_f64( 1.0 ) );
+
+    float64x2_t ex = vsubq_f64( qx, vmulq_f64( t, dx ) );
+    float64x2_t ey = vsubq_f64( qy, vmulq_f64( t, dy ) );
+    float64x2_t d2 = vaddq_f64( vmulq_f64( ex, ex ), vmulq_f64( ey, ey ) );
+
+    return vcleq_f64( d2, aThresholdSq );
+}
+
+
+static inline float64x2_t toDouble( int32x2_t aValues )
+{
+    return vcvtq_f64_s64( vmovl_s32( aValues ) );
+}
+
+
+/**
+ * @return a bit mask of which of the four segments starting at \a aPoints are near \a aP.
+ */
+static inline int nearMask4( const VECTOR2I* aPoints, float64x2_t aPx, float64x2_t aPy,
+                             float64x2_t aThresholdSq )
+{
+    int32x4x2_t a = vld2q_s32( reinterpret_cast<const int32_t*>( aPoints ) );
+    int32x4x2_t b = vld2q_s32( reinterpret_cast<const int32_t*>( aPoints + 1 ) );
+
+    uint64x2_t lo = nearMask2( toDouble( vget_low_s32( a.val[0] ) ),
+                               toDouble( vget_low_s32( a.val[1] ) ),
+                               toDouble( vget_low_s32( b.val[0] ) ),
+                               toDouble( vget_low_s32( b.val[1] ) ), aPx, aPy, aThresholdSq );
+    uint64x2_t hi = nearMask2( toDouble( vget_high_s32( a.val[0] ) ),
+                               toDouble( vget_high_s32( a.val[1] ) ),
+                               toDouble( vget_high_s32( b.val[0] ) ),
+                               toDouble( vget_high_s32( b.val[1] ) ), aPx, aPy, aThresholdSq );
+
+    return   ( vgetq_lane_u64( lo, 0 ) ? 1 : 0 ) | ( vgetq_lane_u64( lo, 1 ) ? 2 : 0 )
+           | ( vgetq_lane_u64( hi, 0 ) ? 4 : 0 ) | ( vgetq_lane_u64( hi, 1 ) ? 8 : 0 );
+}
+
+
+static size_t findVector( const VECTOR2I* aPoints, size_t aSegmentCount, size_t aStart,
+                          const VECTOR2D& aP, double aThresholdSq )
+{
+    float64x2_t px = vdupq_n_f64( aP.x );
+    float64x2_t py = vdupq_n_f64( aP.y );
+    float64x2_t thr = vdupq_n_f64( aThresholdSq );
+    size_t      i = aStart;
+
+    // The second load of each block reads aPoints[i + 4], the end point of the last segment
+    for( ; i + 4 <= aSegmentCount; i += 4 )
+    {
+        if( int mask = nearMask4( aPoints + i, px, py, thr ) )
+            return i + firstLane( mask );
+    }
+
+    return findScalar( aPoints, aSegmentCount, i, aP, aThresholdSq );
+}
+
+
+static bool vectorKernelAvailable()
+{
+    return true;
+}
+
+#endif
+
+
+size_t FindSegmentNearPoint( const VECTOR2I* aPoints, size_t aSegmentCount, size_t aStart,
+                             const VECTOR2D& aP, double aRadius )
+{
+    double radius = std::max( aRadius, 0.0 ) + DISTANCE_SLACK;
+    double thresholdSq = radius * radius;
+
+#if defined( SEG_KERNEL_AVX2 ) || defined( SEG_KERNEL_NEON )
+    if( vectorKernelAvailable() )
+        return findVector( aPoints, aSegmentCount, aStart, aP, thresholdSq );
+#endif
+
+    return findScalar( aPoints, aSegmentCount, aStart, aP, thresholdSq );
+}
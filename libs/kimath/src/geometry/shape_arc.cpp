@@ -508,17 +508,17 @@ const SHAPE_LINE_CHAIN SHAPE_ARC::ConvertToPolyline( double aAccuracy,
 
     rv.Append( m_start );
 
-    for( int i = 1; i < n ; i += 2 )
+    if( n != 0 )
     {
-        EDA_ANGLE a = sa;
+        ARC_STEPPER a( sa + ca / n, ( ca * 2 ) / n );
 
-        if( n != 0 )
-            a += ( ca * i ) / n;
-
-        double x = c.x + r * a.Cos();
-        double y = c.y + r * a.Sin();
+        for( int i = 1; i < n; i += 2, a.Next() )
+        {
+            double x = c.x + r * a.Cos();
+            double y = c.y + r * a.Sin();
 
-        rv.Append( KiROUND( x ), KiROUND( y ) );
+            rv.Append( KiROUND( x ), KiROUND( y ) );
+        }
     }
 
     rv.Append( m_end );
@@ -27,6 +27,7 @@
 #include <limits>
 
 #include <geometry/seg.h>                         // for SEG
+#include <geometry/seg_distance_kernel.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
@@ -202,11 +203,35 @@ static inline bool Collide( const SHAPE_CIRCLE& aA, const SHAPE_LINE_CHAIN_BASE&
     }
     else
     {
+        // For plain line chains, let the batched kernel skip the segments which can't be within
+        // reach of the circle.
+        const SHAPE_LINE_CHAIN* chain = aB.Type() == SH_LINE_CHAIN
+                                                ? static_cast<const SHAPE_LINE_CHAIN*>( &aB )
+                                                : nullptr;
+        size_t   linearCount = chain && chain->PointCount() > 1 ? chain->PointCount() - 1 : 0;
+        VECTOR2D center( aA.GetCenter() );
+        double   reach = (double) aClearance + aA.GetRadius();
+        size_t   candidate = linearCount ? FindSegmentNearPoint( chain->CPoints().data(),
+                                                                 linearCount, 0, center, reach )
+                                         : 0;
+
         for( size_t s = 0; s < aB.GetSegmentCount(); s++ )
         {
             int collision_dist = 0;
             VECTOR2I pn;
 
+            if( s < linearCount )
+            {
+                if( s > candidate )
+                {
+                    candidate = FindSegmentNearPoint( chain->CPoints().data(), linearCount, s,
+                                                      center, reach );
+                }
+
+                if( s != candidate )
+                    continue;
+            }
+
             if( aA.Collide( aB.GetSegment( s ), aClearance,
                             aActual || aLocation ? &collision_dist : nullptr,
                             aLocation ? &pn : nullptr ) )
@@ -29,10 +29,10 @@
 #include <map>
 #include <string>            // for basic_string
 
-#include <clipper.hpp>
 #include <clipper2/clipper.h>
 #include <core/kicad_algo.h> // for alg::run_on_pair
 #include <geometry/seg.h>    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_distance_kernel.h>
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_poly_set.h>
 #include <math/box2.h>       // for BOX2I
@@ -55,59 +55,25 @@ SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const std::vector<int>& aV)
 }
 
 
-SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const ClipperLib::Path&             aPath,
+SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const Clipper2Lib::Path64&          aPath,
                                     const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                                     const std::vector<SHAPE_ARC>&       aArcBuffer ) :
         SHAPE_LINE_CHAIN_BASE( SH_LINE_CHAIN ),
         m_closed( true ), m_width( 0 )
 {
-    std::map<ssize_t, ssize_t> loadedArcs;
     m_points.reserve( aPath.size() );
     m_shapes.reserve( aPath.size() );
 
-    auto loadArc =
-        [&]( ssize_t aArcIndex ) -> ssize_t
-        {
-            if( aArcIndex == SHAPE_IS_PT )
-            {
-                return SHAPE_IS_PT;
-            }
-            else if( loadedArcs.count( aArcIndex ) == 0 )
-            {
-                loadedArcs.insert( { aArcIndex, m_arcs.size() } );
-                m_arcs.push_back( aArcBuffer.at( aArcIndex ) );
-            }
-
-            return loadedArcs.at( aArcIndex );
-        };
-
-    for( size_t ii = 0; ii < aPath.size(); ++ii )
+    // Without arcs in the operation, the Z values carry no information
+    if( aArcBuffer.empty() )
     {
-        Append( aPath[ii].X, aPath[ii].Y );
+        for( const Clipper2Lib::Point64& pt : aPath )
+            Append( pt.x, pt.y );
 
-        m_shapes[ii].first = loadArc( aZValueBuffer[aPath[ii].Z].m_FirstArcIdx );
-        m_shapes[ii].second = loadArc( aZValueBuffer[aPath[ii].Z].m_SecondArcIdx );
+        return;
     }
 
-    // Clipper shouldn't return duplicate contiguous points. if it did, these would be
-    // removed during Append() and we would have different number of shapes to points
-    wxASSERT( m_shapes.size() == m_points.size() );
-
-    // Clipper might mess up the rotation of the indices such that an arc can be split between
-    // the end point and wrap around to the start point. Lets fix the indices up now
-    fixIndicesRotation();
-}
-
-
-SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const Clipper2Lib::Path64&          aPath,
-                                    const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
-                                    const std::vector<SHAPE_ARC>&       aArcBuffer ) :
-        SHAPE_LINE_CHAIN_BASE( SH_LINE_CHAIN ),
-        m_closed( true ), m_width( 0 )
-{
     std::map<ssize_t, ssize_t> loadedArcs;
-    m_points.reserve( aPath.size() );
-    m_shapes.reserve( aPath.size() );
 
     auto loadArc =
         [&]( ssize_t aArcIndex ) -> ssize_t
@@ -143,69 +109,58 @@ SHAPE_LINE_CHAIN::SHAPE_LINE_CHAIN( const Clipper2Lib::Path64&          aPath,
 }
 
 
-ClipperLib::Path SHAPE_LINE_CHAIN::convertToClipper( bool aRequiredOrientation,
+Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientation,
                                                      std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                                                      std::vector<SHAPE_ARC>& aArcBuffer ) const
 {
-    ClipperLib::Path c_path;
-    SHAPE_LINE_CHAIN input;
-    bool             orientation = Area( false ) >= 0;
-    ssize_t          shape_offset = aArcBuffer.size();
+    Clipper2Lib::Path64 c_path;
+    bool                orientation = Area( false ) >= 0;
+    int                 pointCount = PointCount();
 
-    if( orientation != aRequiredOrientation )
-        input = Reverse();
-    else
-        input = *this;
+    // Z value 0 is shared by all the points which don't belong to an arc
+    if( aZValueBuffer.empty() )
+        aZValueBuffer.emplace_back();
 
-    int pointCount = input.PointCount();
     c_path.reserve( pointCount );
 
-    for( int i = 0; i < pointCount; i++ )
+    if( m_arcs.empty() )
     {
-        const VECTOR2I& vertex = input.CPoint( i );
-
-        CLIPPER_Z_VALUE z_value( input.m_shapes[i], shape_offset );
-        size_t          z_value_ptr = aZValueBuffer.size();
-        aZValueBuffer.push_back( z_value );
+        if( orientation == aRequiredOrientation )
+        {
+            for( const VECTOR2I& vertex : m_points )
+                c_path.emplace_back( vertex.x, vertex.y, 0 );
+        }
+        else
+        {
+            for( auto it = m_points.rbegin(); it != m_points.rend(); ++it )
+                c_path.emplace_back( it->x, it->y, 0 );
+        }
 
-        c_path.emplace_back( vertex.x, vertex.y, z_value_ptr );
+        return c_path;
     }
 
-    aArcBuffer.insert( aArcBuffer.end(), input.m_arcs.begin(), input.m_arcs.end() );
-
-    return c_path;
-}
-
-
-Clipper2Lib::Path64 SHAPE_LINE_CHAIN::convertToClipper2( bool aRequiredOrientation,
-                                                     std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
-                                                     std::vector<SHAPE_ARC>& aArcBuffer ) const
-{
-    Clipper2Lib::Path64 c_path;
-    SHAPE_LINE_CHAIN input;
-    bool             orientation = Area( false ) >= 0;
-    ssize_t          shape_offset = aArcBuffer.size();
+    SHAPE_LINE_CHAIN        reversed;
+    const SHAPE_LINE_CHAIN* input = this;
+    ssize_t                 shape_offset = aArcBuffer.size();
 
     if( orientation != aRequiredOrientation )
-        input = Reverse();
-    else
-        input = *this;
-
-    int pointCount = input.PointCount();
-    c_path.reserve( pointCount );
+    {
+        reversed = Reverse();
+        input = &reversed;
+    }
 
     for( int i = 0; i < pointCount; i++ )
     {
-        const VECTOR2I& vertex = input.CPoint( i );
+        const VECTOR2I& vertex = input->CPoint( i );
 
-        CLIPPER_Z_VALUE z_value( input.m_shapes[i], shape_offset );
+        CLIPPER_Z_VALUE z_value( input->m_shapes[i], shape_offset );
         size_t          z_value_ptr = aZValueBuffer.size();
         aZValueBuffer.push_back( z_value );
 
         c_path.emplace_back( vertex.x, vertex.y, z_value_ptr );
     }
 
-    aArcBuffer.insert( aArcBuffer.end(), input.m_arcs.begin(), input.m_arcs.end() );
+    aArcBuffer.insert( aArcBuffer.end(), input->m_arcs.begin(), input->m_arcs.end() );
 
     return c_path;
 }
@@ -454,30 +409,50 @@ bool SHAPE_LINE_CHAIN::Collide( const VECTOR2I& aP, int aClearance, int* aActual
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    // @return true when no further segment needs to be tested
+    auto testSegment =
+            [&]( size_t i ) -> bool
+            {
+                if( IsArcSegment( i ) )
+                    return false;
 
-        const SEG&  s = GetSegment( i );
-        VECTOR2I    pn = s.NearestPoint( aP );
-        SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
+                const SEG&  s = GetSegment( i );
+                VECTOR2I    pn = s.NearestPoint( aP );
+                SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
-        if( dist_sq < closest_dist_sq )
-        {
-            nearest = pn;
-            closest_dist_sq = dist_sq;
+                if( dist_sq < closest_dist_sq )
+                {
+                    nearest = pn;
+                    closest_dist_sq = dist_sq;
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return true;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return true;
+                }
+
+                return false;
+            };
+
+    // Collide line segments.  Only segments closer than aClearance can change the result, so
+    // let the batched kernel skip the others.
+    size_t   linearCount = m_points.size() > 1 ? m_points.size() - 1 : 0;
+    VECTOR2D p( aP );
+    bool     done = false;
+
+    for( size_t i = FindSegmentNearPoint( m_points.data(), linearCount, 0, p, aClearance );
+         i < linearCount && !done;
+         i = FindSegmentNearPoint( m_points.data(), linearCount, i + 1, p, aClearance ) )
+    {
+        done = testSegment( i );
     }
 
+    // The closing segment of a closed chain
+    if( !done && linearCount < GetSegmentCount() )
+        testSegment( linearCount );
+
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
         if( aLocation )
@@ -587,31 +562,52 @@ bool SHAPE_LINE_CHAIN::Collide( const SEG& aSeg, int aClearance, int* aActual,
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
     VECTOR2I    nearest;
 
-    // Collide line segments
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        if( IsArcSegment( i ) )
-            continue;
+    // @return true when no further segment needs to be tested
+    auto testSegment =
+            [&]( size_t i ) -> bool
+            {
+                if( IsArcSegment( i ) )
+                    return false;
 
-        const SEG&  s = GetSegment( i );
-        SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
+                const SEG&  s = GetSegment( i );
+                SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
-        if( dist_sq < closest_dist_sq )
-        {
-            if( aLocation )
-                nearest = s.NearestPoint( aSeg );
+                if( dist_sq < closest_dist_sq )
+                {
+                    if( aLocation )
+                        nearest = s.NearestPoint( aSeg );
 
-            closest_dist_sq = dist_sq;
+                    closest_dist_sq = dist_sq;
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return true;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return true;
+                }
+
+                return false;
+            };
+
+    // Collide line segments.  No point of aSeg is further than half its length from its
+    // midpoint, so segments further than that plus aClearance from the midpoint can't collide.
+    size_t   linearCount = m_points.size() > 1 ? m_points.size() - 1 : 0;
+    VECTOR2D mid = ( VECTOR2D( aSeg.A ) + VECTOR2D( aSeg.B ) ) / 2.0;
+    double   radius = aClearance + ( VECTOR2D( aSeg.B ) - VECTOR2D( aSeg.A ) ).EuclideanNorm() / 2.0;
+    bool     done = false;
+
+    for( size_t i = FindSegmentNearPoint( m_points.data(), linearCount, 0, mid, radius );
+         i < linearCount && !done;
+         i = FindSegmentNearPoint( m_points.data(), linearCount, i + 1, mid, radius ) )
+    {
+        done = testSegment( i );
     }
 
+    // The closing segment of a closed chain
+    if( !done && linearCount < GetSegmentCount() )
+        testSegment( linearCount );
+
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
         if( aLocation )
@@ -643,9 +639,9 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
 {
     SHAPE_LINE_CHAIN a( *this );
 
-    reverse( a.m_points.begin(), a.m_points.end() );
-    reverse( a.m_shapes.begin(), a.m_shapes.end() );
-    reverse( a.m_arcs.begin(), a.m_arcs.end() );
+    std::reverse( a.m_points.begin(), a.m_points.end() );
+    std::reverse( a.m_shapes.begin(), a.m_shapes.end() );
+    std::reverse( a.m_arcs.begin(), a.m_arcs.end() );
 
     for( auto& sh : a.m_shapes )
     {
@@ -786,7 +782,7 @@ void SHAPE_LINE_CHAIN::Replace( int aStartIndex, int aEndIndex, const SHAPE_LINE
 
     // The total new arcs index is added to the new arc indices
     size_t prev_arc_count = m_arcs.size();
-    std::vector<std::pair<ssize_t, ssize_t>> new_shapes = newLine.m_shapes;
+    SHAPE_VECTOR new_shapes = newLine.m_shapes;
 
     for( std::pair<ssize_t, ssize_t>& shape_pair : new_shapes )
     {
@@ -30,21 +30,28 @@
 
 #include <algorithm>
 #include <assert.h>                          // for assert
+#include <atomic>
 #include <cmath>                             // for sqrt, cos, hypot, isinf
+#include <condition_variable>
 #include <cstdio>
+#include <functional>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>                            // for char_traits, operator!=
 #include <type_traits>                       // for swap, move
 #include <unordered_set>
 #include <vector>
 
-#include <clipper.hpp>                       // for Clipper, PolyNode, Clipp...
 #include <clipper2/clipper.h>
+#include <core/thread_pool.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/monotone_triangulation.h>
+#include <geometry/polygon_segment_index.h>
 #include <geometry/polygon_triangulation.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
 #include <geometry/shape.h>
@@ -58,12 +65,40 @@
 #include <geometry/shape_segment.h>
 #include <geometry/shape_circle.h>
 
-// Do not keep this for release.  Only for testing clipper
-#include <advanced_config.h>
-
 #include <wx/log.h>
 
 
+static uint64_t newTriangulationSerial()
+{
+    static std::atomic<uint64_t> s_serial( 0 );
+
+    return ++s_serial;
+}
+
+
+static MD5_HASH polygonChecksum( const SHAPE_POLY_SET::POLYGON& aPolygon )
+{
+    MD5_HASH hash;
+
+    hash.Hash( aPolygon.size() );
+
+    for( const SHAPE_LINE_CHAIN& lc : aPolygon )
+    {
+        hash.Hash( lc.PointCount() );
+
+        for( int i = 0; i < lc.PointCount(); i++ )
+        {
+            hash.Hash( lc.CPoint( i ).x );
+            hash.Hash( lc.CPoint( i ).y );
+        }
+    }
+
+    hash.Finalize();
+
+    return hash;
+}
+
+
 SHAPE_POLY_SET::SHAPE_POLY_SET() :
     SHAPE( SH_POLY_SET )
 {
@@ -112,6 +147,11 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
 
         m_hash = aOther.GetHash();
         m_triangulationValid = true;
+        m_triangulationSerial = newTriangulationSerial();
+        m_outlineHashes = aOther.m_outlineHashes;
+
+        m_segmentIndexEnabled = aOther.m_segmentIndexEnabled.load();
+        m_segmentIndex = std::atomic_load( &aOther.m_segmentIndex );
     }
     else
     {
@@ -230,6 +270,8 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
 int SHAPE_POLY_SET::NewOutline()
 {
+    invalidateSegmentIndex();
+
     SHAPE_LINE_CHAIN empty_path;
     POLYGON poly;
 
@@ -242,6 +284,8 @@ int SHAPE_POLY_SET::NewOutline()
 
 int SHAPE_POLY_SET::NewHole( int aOutline )
 {
+    invalidateSegmentIndex();
+
     SHAPE_LINE_CHAIN empty_path;
 
     empty_path.SetClosed( true );
@@ -259,6 +303,8 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
 
 int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDuplication )
 {
+    invalidateSegmentIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -282,6 +328,8 @@ int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDu
 
 int SHAPE_POLY_SET::Append( const SHAPE_ARC& aArc, int aOutline, int aHole, double aAccuracy )
 {
+    invalidateSegmentIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -305,6 +353,8 @@ int SHAPE_POLY_SET::Append( const SHAPE_ARC& aArc, int aOutline, int aHole, doub
 
 void SHAPE_POLY_SET::InsertVertex( int aGlobalIndex, const VECTOR2I& aNewVertex )
 {
+    invalidateSegmentIndex();
+
     VERTEX_INDEX index;
 
     if( aGlobalIndex < 0 )
@@ -371,6 +421,37 @@ int SHAPE_POLY_SET::FullPointCount() const
 }
 
 
+size_t SHAPE_POLY_SET::GetOutlineMemoryUsage() const
+{
+    size_t bytes = m_polys.capacity() * sizeof( POLYGON );
+
+    for( const POLYGON& poly : m_polys )
+    {
+        bytes += poly.capacity() * sizeof( SHAPE_LINE_CHAIN );
+
+        for( const SHAPE_LINE_CHAIN& chain : poly )
+            bytes += chain.GetMemoryUsage();
+    }
+
+    return bytes;
+}
+
+
+size_t SHAPE_POLY_SET::GetTriangulationMemoryUsage() const
+{
+    size_t bytes = m_triangulatedPolys.capacity() * sizeof( std::unique_ptr<TRIANGULATED_POLYGON> );
+
+    for( const std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
+    {
+        bytes += sizeof( TRIANGULATED_POLYGON )
+                 + tri->GetTriangleCount() * sizeof( TRIANGULATED_POLYGON::TRI )
+                 + tri->GetVertexCount() * sizeof( VECTOR2I );
+    }
+
+    return bytes;
+}
+
+
 SHAPE_POLY_SET SHAPE_POLY_SET::Subset( int aFirstPolygon, int aLastPolygon )
 {
     assert( aFirstPolygon >= 0 && aLastPolygon <= OutlineCount() );
@@ -532,6 +613,8 @@ bool SHAPE_POLY_SET::IsSelfIntersecting() const
 
 int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 {
+    invalidateSegmentIndex();
+
     assert( aOutline.IsClosed() );
 
     POLYGON poly;
@@ -546,6 +629,8 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 
 int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 {
+    invalidateSegmentIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -565,6 +650,8 @@ int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 
 int SHAPE_POLY_SET::AddPolygon( const POLYGON& apolygon )
 {
+    invalidateSegmentIndex();
+
     m_polys.push_back( apolygon );
 
     return m_polys.size() - 1;
@@ -616,6 +703,8 @@ void SHAPE_POLY_SET::GetArcs( std::vector<SHAPE_ARC>& aArcBuffer ) const
 
 void SHAPE_POLY_SET::ClearArcs()
 {
+    invalidateSegmentIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( size_t i = 0; i < poly.size(); i++ )
@@ -626,6 +715,8 @@ void SHAPE_POLY_SET::ClearArcs()
 
 void SHAPE_POLY_SET::RebuildHolesFromContours()
 {
+    invalidateSegmentIndex();
+
     std::vector<SHAPE_LINE_CHAIN> contours;
 
     for( const POLYGON& poly : m_polys )
@@ -730,129 +821,49 @@ void SHAPE_POLY_SET::RebuildHolesFromContours()
 }
 
 
-void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aOtherShape,
-                                POLYGON_MODE aFastMode )
+void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOtherShape )
 {
-    booleanOp( aType, *this, aOtherShape, aFastMode );
+    invalidateSegmentIndex();
+
+    booleanOp( aType, *this, aOtherShape );
 }
 
 
-void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType, const SHAPE_POLY_SET& aShape,
-                                const SHAPE_POLY_SET& aOtherShape, POLYGON_MODE aFastMode )
+void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
+                                const SHAPE_POLY_SET& aOtherShape )
 {
-    if( ( aShape.OutlineCount() > 1 || aOtherShape.OutlineCount() > 0 )
-        && ( aShape.ArcCount() > 0 || aOtherShape.ArcCount() > 0 ) )
-    {
-        wxFAIL_MSG( wxT( "Boolean ops on curved polygons are not supported. You should call "
-                         "ClearArcs() before carrying out the boolean operation." ) );
-    }
-
-    ClipperLib::Clipper c;
-
-    c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
+    booleanOp( aType, { &aShape }, { &aOtherShape } );
+}
 
-    std::vector<CLIPPER_Z_VALUE> zValues;
-    std::vector<SHAPE_ARC> arcBuffer;
-    std::map<VECTOR2I, CLIPPER_Z_VALUE> newIntersectPoints;
 
-    for( const POLYGON& poly : aShape.m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-        {
-            c.AddPath( poly[i].convertToClipper( i == 0, zValues, arcBuffer ),
-                       ClipperLib::ptSubject, true );
-        }
-    }
-
-    for( const POLYGON& poly : aOtherShape.m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-        {
-            c.AddPath( poly[i].convertToClipper( i == 0, zValues, arcBuffer ),
-                       ClipperLib::ptClip, true );
-        }
-    }
+void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType                       aType,
+                                const std::vector<const SHAPE_POLY_SET*>& aSubjects,
+                                const std::vector<const SHAPE_POLY_SET*>& aClips )
+{
+    invalidateSegmentIndex();
 
-    ClipperLib::PolyTree solution;
+    int    outlineCount = 0;
+    int    arcCount = 0;
+    size_t subjectCount = 0;
+    size_t clipCount = 0;
 
-    ClipperLib::ZFillCallback callback =
-            [&]( ClipperLib::IntPoint & e1bot, ClipperLib::IntPoint & e1top,
-                ClipperLib::IntPoint & e2bot, ClipperLib::IntPoint & e2top,
-                ClipperLib::IntPoint & pt )
+    auto countPaths =
+            [&]( const std::vector<const SHAPE_POLY_SET*>& aShapes, size_t& aPathCount )
             {
-                auto arcIndex =
-                    [&]( const ssize_t& aZvalue, const ssize_t& aCompareVal = -1 ) -> ssize_t
-                    {
-                        ssize_t retval;
-
-                        retval = zValues.at( aZvalue ).m_SecondArcIdx;
-
-                        if( retval == -1 || ( aCompareVal > 0 && retval != aCompareVal ) )
-                            retval = zValues.at( aZvalue ).m_FirstArcIdx;
-
-                        return retval;
-                    };
-
-                auto arcSegment =
-                    [&]( const ssize_t& aBottomZ, const ssize_t aTopZ ) -> ssize_t
-                    {
-                        ssize_t retval = arcIndex( aBottomZ );
-
-                        if( retval != -1 )
-                        {
-                            if( retval != arcIndex( aTopZ, retval ) )
-                                retval = -1; // Not an arc segment as the two indices do not match
-                        }
-
-                        return retval;
-                    };
-
-                ssize_t e1ArcSegmentIndex = arcSegment( e1bot.Z, e1top.Z );
-                ssize_t e2ArcSegmentIndex = arcSegment( e2bot.Z, e2top.Z );
-
-                CLIPPER_Z_VALUE newZval;
-
-                if( e1ArcSegmentIndex != -1 )
+                for( const SHAPE_POLY_SET* shape : aShapes )
                 {
-                    newZval.m_FirstArcIdx = e1ArcSegmentIndex;
-                    newZval.m_SecondArcIdx = e2ArcSegmentIndex;
-                }
-                else
-                {
-                    newZval.m_FirstArcIdx = e2ArcSegmentIndex;
-                    newZval.m_SecondArcIdx = -1;
-                }
-
-                size_t z_value_ptr = zValues.size();
-                zValues.push_back( newZval );
+                    outlineCount += shape->OutlineCount();
+                    arcCount += shape->ArcCount();
 
-                // Only worry about arc segments for later processing
-                if( newZval.m_FirstArcIdx != -1 )
-                    newIntersectPoints.insert( { VECTOR2I( pt.X, pt.Y ), newZval } );
-
-                pt.Z = z_value_ptr;
-                //@todo amend X,Y values to true intersection between arcs or arc and segment
+                    for( const POLYGON& poly : shape->m_polys )
+                        aPathCount += poly.size();
+                }
             };
 
-    c.ZFillFunction( std::move( callback ) ); // register callback
+    countPaths( aSubjects, subjectCount );
+    countPaths( aClips, clipCount );
 
-    c.Execute( aType, solution, ClipperLib::pftNonZero, ClipperLib::pftNonZero );
-
-    importTree( &solution, zValues, arcBuffer );
-}
-
-
-void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aOtherShape )
-{
-    booleanOp( aType, *this, aOtherShape );
-}
-
-
-void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SET& aShape,
-                                const SHAPE_POLY_SET& aOtherShape )
-{
-    if( ( aShape.OutlineCount() > 1 || aOtherShape.OutlineCount() > 0 )
-        && ( aShape.ArcCount() > 0 || aOtherShape.ArcCount() > 0 ) )
+    if( outlineCount > 1 && arcCount > 0 )
     {
         wxFAIL_MSG( wxT( "Boolean ops on curved polygons are not supported. You should call "
                          "ClearArcs() before carrying out the boolean operation." ) );
@@ -860,26 +871,32 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
 
     Clipper2Lib::Clipper64 c;
 
-    std::vector<CLIPPER_Z_VALUE> zValues;
-    std::vector<SHAPE_ARC> arcBuffer;
+    GEOMETRY_ARENA::LEASE         scratch;
+    std::vector<CLIPPER_Z_VALUE>& zValues = scratch->m_zValues;
+    std::vector<SHAPE_ARC>&       arcBuffer = scratch->m_arcBuffer;
     std::map<VECTOR2I, CLIPPER_Z_VALUE> newIntersectPoints;
 
-    Clipper2Lib::Paths64 paths;
-    Clipper2Lib::Paths64 clips;
+    Clipper2Lib::Paths64& paths = scratch->m_paths;
+    Clipper2Lib::Paths64& clips = scratch->m_clips;
 
-    for( const POLYGON& poly : aShape.m_polys )
+    paths.reserve( subjectCount );
+    clips.reserve( clipCount );
+
+    for( const SHAPE_POLY_SET* shape : aSubjects )
     {
-        for( size_t i = 0; i < poly.size(); i++ )
+        for( const POLYGON& poly : shape->m_polys )
         {
-            paths.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
+            for( size_t i = 0; i < poly.size(); i++ )
+                paths.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
         }
     }
 
-    for( const POLYGON& poly : aOtherShape.m_polys )
+    for( const SHAPE_POLY_SET* shape : aClips )
     {
-        for( size_t i = 0; i < poly.size(); i++ )
+        for( const POLYGON& poly : shape->m_polys )
         {
-            clips.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
+            for( size_t i = 0; i < poly.size(); i++ )
+                clips.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
         }
     }
 
@@ -947,7 +964,9 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
                 //@todo amend X,Y values to true intersection between arcs or arc and segment
             };
 
-    c.SetZCallback( std::move( callback ) ); // register callback
+    // Without arcs there is nothing to tag and every Z value can stay the plain point one
+    if( !arcBuffer.empty() )
+        c.SetZCallback( std::move( callback ) );
 
     c.Execute( aType, Clipper2Lib::FillRule::NonZero, solution );
 
@@ -958,182 +977,182 @@ void SHAPE_POLY_SET::booleanOp( Clipper2Lib::ClipType aType, const SHAPE_POLY_SE
 
 void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Union, b );
-    else
-        booleanOp( ClipperLib::ctUnion, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Union, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanSubtract( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Difference, b );
-    else
-        booleanOp( ClipperLib::ctDifference, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Difference, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Intersection, b );
-    else
-        booleanOp( ClipperLib::ctIntersection, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Intersection, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanXor( const SHAPE_POLY_SET& b, POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Xor, b );
-    else
-        booleanOp( ClipperLib::ctXor, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Xor, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanAdd( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                  POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Union, a, b );
-    else
-        booleanOp( ClipperLib::ctUnion, a, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Union, a, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanSubtract( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                       POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Difference, a, b );
-    else
-        booleanOp( ClipperLib::ctDifference, a, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Difference, a, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                           POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Intersection, a, b );
-    else
-        booleanOp( ClipperLib::ctIntersection, a, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Intersection, a, b );
 }
 
 
 void SHAPE_POLY_SET::BooleanXor( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                                           POLYGON_MODE aFastMode )
 {
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Xor, a, b );
-    else
-        booleanOp( ClipperLib::ctXor, a, b, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Xor, a, b );
 }
 
 
-void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, CORNER_STRATEGY aCornerStrategy,
-                                             int aMaxError, POLYGON_MODE aFastMode )
+void SHAPE_POLY_SET::BooleanAdd( const std::vector<const SHAPE_POLY_SET*>& aOthers,
+                                 POLYGON_MODE aFastMode )
 {
-    Unfracture( aFastMode );
-    Inflate( aFactor, aCornerStrategy, aMaxError );
-    Fracture( aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Union, { this }, aOthers );
 }
 
 
-void SHAPE_POLY_SET::inflate1( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy )
+void SHAPE_POLY_SET::BooleanSubtract( const std::vector<const SHAPE_POLY_SET*>& aOthers,
+                                      POLYGON_MODE aFastMode )
 {
-    using namespace ClipperLib;
-    // A static table to avoid repetitive calculations of the coefficient
-    // 1.0 - cos( M_PI / aCircleSegCount )
-    // aCircleSegCount is most of time <= 64 and usually 8, 12, 16, 32
-    #define SEG_CNT_MAX 64
-    static double arc_tolerance_factor[SEG_CNT_MAX + 1];
-
-    ClipperOffset c;
+    booleanOp( Clipper2Lib::ClipType::Difference, { this }, aOthers );
+}
 
-    // N.B. see the Clipper documentation for jtSquare/jtMiter/jtRound.  They are poorly named
-    // and are not what you'd think they are.
-    // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Types/JoinType.htm
-    JoinType joinType = jtRound;    // The way corners are offsetted
-    double   miterLimit = 2.0;      // Smaller value when using jtMiter for joinType
-    JoinType miterFallback = jtSquare;
 
-    switch( aCornerStrategy )
+SHAPE_POLY_SET SHAPE_POLY_SET::ParallelUnion( const std::vector<const SHAPE_POLY_SET*>& aShapes,
+                                              int aMinParallel )
+{
+    struct ITEM
     {
-    case CORNER_STRATEGY::ALLOW_ACUTE_CORNERS:
-        joinType = jtMiter;
-        miterLimit = 10;        // Allows large spikes
-        miterFallback = jtSquare;
-        break;
+        const POLYGON* m_poly;
+        BOX2I          m_bbox;
+    };
 
-    case CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS: // Acute angles are chamfered
-        joinType = jtMiter;
-        miterFallback = jtRound;
-        break;
+    std::vector<ITEM> items;
+    SHAPE_POLY_SET    result;
+    int               outlineCount = 0;
 
-    case CORNER_STRATEGY::ROUND_ACUTE_CORNERS: // Acute angles are rounded
-        joinType = jtMiter;
-        miterFallback = jtSquare;
-        break;
+    for( const SHAPE_POLY_SET* shape : aShapes )
+        outlineCount += shape->OutlineCount();
 
-    case CORNER_STRATEGY::CHAMFER_ALL_CORNERS: // All angles are chamfered.
-        joinType = jtSquare;
-        miterFallback = jtSquare;
-        break;
+    size_t threads = GetKiCadThreadPool().get_thread_count();
 
-    case CORNER_STRATEGY::ROUND_ALL_CORNERS: // All angles are rounded.
-        joinType = jtRound;
-        miterFallback = jtSquare;
-        break;
+    if( outlineCount < std::max( aMinParallel, 2 ) || threads == 0 )
+    {
+        result.booleanOp( Clipper2Lib::ClipType::Union, aShapes, {} );
+        return result;
     }
 
-    std::vector<CLIPPER_Z_VALUE> zValues;
-    std::vector<SHAPE_ARC>       arcBuffer;
+    items.reserve( outlineCount );
 
-    for( const POLYGON& poly : m_polys )
+    for( const SHAPE_POLY_SET* shape : aShapes )
     {
-        for( size_t i = 0; i < poly.size(); i++ )
+        for( const POLYGON& poly : shape->m_polys )
         {
-            c.AddPath( poly[i].convertToClipper( i == 0, zValues, arcBuffer ),
-                       joinType, etClosedPolygon );
+            if( !poly.empty() )
+                items.push_back( { &poly, poly.front().BBox() } );
         }
     }
 
-    PolyTree solution;
+    // Split into vertical bands of equal polygon count, each of them large enough to be worth
+    // a sweep of its own
+    size_t bandCount = std::min( threads + 1, 2 * items.size() / std::max( aMinParallel, 2 ) );
+    bandCount = std::max<size_t>( bandCount, 2 );
 
-    // Calculate the arc tolerance (arc error) from the seg count by circle. The seg count is
-    // nn = M_PI / acos(1.0 - c.ArcTolerance / abs(aAmount))
-    // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Classes/ClipperOffset/Properties/ArcTolerance.htm
+    std::sort( items.begin(), items.end(),
+               []( const ITEM& aA, const ITEM& aB )
+               {
+                   return aA.m_bbox.Centre().x < aB.m_bbox.Centre().x;
+               } );
 
-    if( aCircleSegCount < 6 ) // avoid incorrect aCircleSegCount values
-        aCircleSegCount = 6;
+    auto bandStart =
+            [&]( size_t aBand )
+            {
+                return items.size() * aBand / bandCount;
+            };
 
-    double coeff;
+    std::vector<SHAPE_POLY_SET> bands( bandCount );
+    std::vector<BOX2I>          extents( bandCount );
 
-    if( aCircleSegCount > SEG_CNT_MAX || arc_tolerance_factor[aCircleSegCount] == 0 )
-    {
-        coeff = 1.0 - cos( M_PI / aCircleSegCount );
+    ParallelFor( bandCount,
+                 [&]( size_t aBand )
+                 {
+                     SHAPE_POLY_SET& band = bands[aBand];
 
-        if( aCircleSegCount <= SEG_CNT_MAX )
-            arc_tolerance_factor[aCircleSegCount] = coeff;
-    }
-    else
+                     for( size_t ii = bandStart( aBand ); ii < bandStart( aBand + 1 ); ++ii )
+                     {
+                         band.m_polys.push_back( *items[ii].m_poly );
+                         extents[aBand].Merge( items[ii].m_bbox );
+                     }
+
+                     band.Simplify( PM_FAST );
+                 } );
+
+    // A merged polygon whose bounding box misses the extents of all the other bands can't
+    // touch anything outside its own band and is final.  The others are merged once more.
+    SHAPE_POLY_SET seams;
+
+    for( size_t ii = 0; ii < bandCount; ++ii )
     {
-        coeff = arc_tolerance_factor[aCircleSegCount];
+        for( POLYGON& poly : bands[ii].m_polys )
+        {
+            BOX2I bbox = poly.front().BBox();
+            bool  isSeam = false;
+
+            for( size_t jj = 0; jj < bandCount && !isSeam; ++jj )
+                isSeam = jj != ii && bbox.Intersects( extents[jj] );
+
+            if( isSeam )
+                seams.m_polys.push_back( std::move( poly ) );
+            else
+                result.m_polys.push_back( std::move( poly ) );
+        }
     }
 
-    c.ArcTolerance = std::abs( aAmount ) * coeff;
-    c.MiterLimit = miterLimit;
-    c.MiterFallback = miterFallback;
-    c.Execute( solution, aAmount );
+    seams.Simplify( PM_FAST );
+
+    for( POLYGON& poly : seams.m_polys )
+        result.m_polys.push_back( std::move( poly ) );
+
+    return result;
+}
+
+
+void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, CORNER_STRATEGY aCornerStrategy,
+                                             int aMaxError, POLYGON_MODE aFastMode )
+{
+    invalidateSegmentIndex();
 
-    importTree( &solution, zValues, arcBuffer );
+    Unfracture( aFastMode );
+    Inflate( aFactor, aCornerStrategy, aMaxError );
+    Fracture( aFastMode );
 }
 
 
-void SHAPE_POLY_SET::inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy,
-        bool aSimplify )
+void SHAPE_POLY_SET::inflate( int aAmount, int aCircleSegCount, CORNER_STRATEGY aCornerStrategy,
+                              bool aSimplify )
 {
     using namespace Clipper2Lib;
     // A static table to avoid repetitive calculations of the coefficient
@@ -1174,12 +1193,15 @@ void SHAPE_POLY_SET::inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY
         break;
     }
 
-    std::vector<CLIPPER_Z_VALUE> zValues;
-    std::vector<SHAPE_ARC>       arcBuffer;
+    GEOMETRY_ARENA::LEASE         scratch;
+    std::vector<CLIPPER_Z_VALUE>& zValues = scratch->m_zValues;
+    std::vector<SHAPE_ARC>&       arcBuffer = scratch->m_arcBuffer;
+
+    Paths64& paths = scratch->m_paths;
 
     for( const POLYGON& poly : m_polys )
     {
-        Paths64 paths;
+        paths.clear();
 
         for( size_t i = 0; i < poly.size(); i++ )
             paths.push_back( poly[i].convertToClipper2( i == 0, zValues, arcBuffer ) );
@@ -1215,7 +1237,7 @@ void SHAPE_POLY_SET::inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY
 
     if( aSimplify )
     {
-        Paths64 paths;
+        paths.clear();
         c.Execute( aAmount, paths );
 
         Clipper2Lib::SimplifyPaths( paths, std::abs( aAmount ) * coeff, true );
@@ -1236,8 +1258,8 @@ void SHAPE_POLY_SET::inflate2( int aAmount, int aCircleSegCount, CORNER_STRATEGY
 }
 
 
-void SHAPE_POLY_SET::inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, int aCircleSegCount,
-                                   CORNER_STRATEGY aCornerStrategy, bool aSimplify )
+void SHAPE_POLY_SET::inflateLine( const SHAPE_LINE_CHAIN& aLine, int aAmount, int aCircleSegCount,
+                                  CORNER_STRATEGY aCornerStrategy, bool aSimplify )
 {
     using namespace Clipper2Lib;
     // A static table to avoid repetitive calculations of the coefficient
@@ -1278,8 +1300,9 @@ void SHAPE_POLY_SET::inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, i
         break;
     }
 
-    std::vector<CLIPPER_Z_VALUE> zValues;
-    std::vector<SHAPE_ARC>       arcBuffer;
+    GEOMETRY_ARENA::LEASE         scratch;
+    std::vector<CLIPPER_Z_VALUE>& zValues = scratch->m_zValues;
+    std::vector<SHAPE_ARC>&       arcBuffer = scratch->m_arcBuffer;
 
     Path64 path = aLine.convertToClipper2( true, zValues, arcBuffer );
     c.AddPath( path, joinType, EndType::Butt );
@@ -1336,45 +1359,22 @@ void SHAPE_POLY_SET::inflateLine2( const SHAPE_LINE_CHAIN& aLine, int aAmount, i
 void SHAPE_POLY_SET::Inflate( int aAmount, CORNER_STRATEGY aCornerStrategy, int aMaxError,
                               bool aSimplify )
 {
+    invalidateSegmentIndex();
+
     int segCount = GetArcToSegmentCount( std::abs( aAmount ), aMaxError, FULL_CIRCLE );
 
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        inflate2( aAmount, segCount, aCornerStrategy, aSimplify );
-    else
-        inflate1( aAmount, segCount, aCornerStrategy );
+    inflate( aAmount, segCount, aCornerStrategy, aSimplify );
 }
 
 
 void SHAPE_POLY_SET::OffsetLineChain( const SHAPE_LINE_CHAIN& aLine, int aAmount,
                                   CORNER_STRATEGY aCornerStrategy, int aMaxError, bool aSimplify )
 {
-    int segCount = GetArcToSegmentCount( std::abs( aAmount ), aMaxError, FULL_CIRCLE );
-
-    inflateLine2( aLine, aAmount, segCount, aCornerStrategy, aSimplify );
-}
-
-
-void SHAPE_POLY_SET::importTree( ClipperLib::PolyTree*               tree,
-                                 const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
-                                 const std::vector<SHAPE_ARC>&       aArcBuffer )
-{
-    m_polys.clear();
-
-    for( ClipperLib::PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
-    {
-        if( !n->IsHole() )
-        {
-            POLYGON paths;
-            paths.reserve( n->Childs.size() + 1 );
-
-            paths.emplace_back( n->Contour, aZValueBuffer, aArcBuffer );
+    invalidateSegmentIndex();
 
-            for( unsigned int i = 0; i < n->Childs.size(); i++ )
-                paths.emplace_back( n->Childs[i]->Contour, aZValueBuffer, aArcBuffer );
+    int segCount = GetArcToSegmentCount( std::abs( aAmount ), aMaxError, FULL_CIRCLE );
 
-            m_polys.push_back( paths );
-        }
-    }
+    inflateLine( aLine, aAmount, segCount, aCornerStrategy, aSimplify );
 }
 
 
@@ -1396,7 +1396,7 @@ void SHAPE_POLY_SET::importPolyPath( const std::unique_ptr<Clipper2Lib::PolyPath
                 importPolyPath( grandchild, aZValueBuffer, aArcBuffer );
         }
 
-        m_polys.push_back( paths );
+        m_polys.push_back( std::move( paths ) );
     }
 }
 
@@ -1405,6 +1405,8 @@ void SHAPE_POLY_SET::importTree( Clipper2Lib::PolyTree64&            tree,
                                  const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                                  const std::vector<SHAPE_ARC>&       aArcBuffer )
 {
+    invalidateSegmentIndex();
+
     m_polys.clear();
 
     for( const std::unique_ptr<Clipper2Lib::PolyPath64>& n : tree )
@@ -1416,6 +1418,8 @@ void SHAPE_POLY_SET::importPaths( Clipper2Lib::Paths64&              aPath,
                                  const std::vector<CLIPPER_Z_VALUE>& aZValueBuffer,
                                  const std::vector<SHAPE_ARC>&       aArcBuffer )
 {
+    invalidateSegmentIndex();
+
     m_polys.clear();
     POLYGON path;
 
@@ -1424,7 +1428,7 @@ void SHAPE_POLY_SET::importPaths( Clipper2Lib::Paths64&              aPath,
         if( Clipper2Lib::Area( n ) > 0 )
         {
             if( !path.empty() )
-                m_polys.emplace_back( path );
+                m_polys.emplace_back( std::move( path ) );
 
             path.clear();
         }
@@ -1437,7 +1441,7 @@ void SHAPE_POLY_SET::importPaths( Clipper2Lib::Paths64&              aPath,
     }
 
     if( !path.empty() )
-        m_polys.emplace_back( path );
+        m_polys.emplace_back( std::move( path ) );
 }
 
 
@@ -1562,7 +1566,7 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 
     for( const SHAPE_LINE_CHAIN& path : paths )
     {
-        const std::vector<VECTOR2I>& points = path.CPoints();
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& points = path.CPoints();
         int pointCount = points.size();
 
         FractureEdge* prev = nullptr, * first_edge = nullptr;
@@ -1665,6 +1669,8 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 
 void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 {
+    invalidateSegmentIndex();
+
     Simplify( aFastMode );    // remove overlapping holes/degeneracy
 
     for( POLYGON& paths : m_polys )
@@ -1856,6 +1862,8 @@ bool SHAPE_POLY_SET::HasHoles() const
 
 void SHAPE_POLY_SET::Unfracture( POLYGON_MODE aFastMode )
 {
+    invalidateSegmentIndex();
+
     for( POLYGON& path : m_polys )
         unfractureSingle( path );
 
@@ -1865,17 +1873,73 @@ void SHAPE_POLY_SET::Unfracture( POLYGON_MODE aFastMode )
 
 void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 {
+    invalidateSegmentIndex();
+
     SHAPE_POLY_SET empty;
 
-    if( ADVANCED_CFG::GetCfg().m_UseClipper2 )
-        booleanOp( Clipper2Lib::ClipType::Union, empty );
-    else
-        booleanOp( ClipperLib::ctUnion, empty, aFastMode );
+    booleanOp( Clipper2Lib::ClipType::Union, empty );
+}
+
+
+void SHAPE_POLY_SET::SimplifyOutlines( int aMaxError )
+{
+    invalidateSegmentIndex();
+
+    // Return false if the chain degenerates
+    auto simplifyChain =
+            [&]( SHAPE_LINE_CHAIN& aChain )
+            {
+                BOX2I bbox = aChain.BBox();
+
+                if( bbox.GetWidth() <= aMaxError && bbox.GetHeight() <= aMaxError )
+                    return false;
+
+                Clipper2Lib::Path64 path;
+
+                path.reserve( aChain.PointCount() );
+
+                for( const VECTOR2I& pt : aChain.CPoints() )
+                    path.emplace_back( pt.x, pt.y );
+
+                path = Clipper2Lib::SimplifyPath( path, aMaxError, true );
+
+                if( path.size() < 3 )
+                    return false;
+
+                std::vector<VECTOR2I> points;
+
+                points.reserve( path.size() );
+
+                for( const Clipper2Lib::Point64& pt : path )
+                    points.emplace_back( pt.x, pt.y );
+
+                aChain = SHAPE_LINE_CHAIN( points, true );
+                return true;
+            };
+
+    for( int ii = (int) m_polys.size() - 1; ii >= 0; --ii )
+    {
+        POLYGON& polygon = m_polys[ii];
+
+        if( !simplifyChain( polygon[0] ) )
+        {
+            m_polys.erase( m_polys.begin() + ii );
+            continue;
+        }
+
+        for( int jj = (int) polygon.size() - 1; jj > 0; --jj )
+        {
+            if( !simplifyChain( polygon[jj] ) )
+                polygon.erase( polygon.begin() + jj );
+        }
+    }
 }
 
 
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
+    invalidateSegmentIndex();
+
     // We are expecting only one main outline, but this main outline can have holes
     // if holes: combine holes and remove them from the main outline.
     // Note also we are using SHAPE_POLY_SET::PM_STRICTLY_SIMPLE in polygon
@@ -1942,6 +2006,8 @@ const std::string SHAPE_POLY_SET::Format( bool aCplusPlus ) const
 
 bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
 {
+    invalidateSegmentIndex();
+
     std::string tmp;
 
     aStream >> tmp;
@@ -2179,12 +2245,16 @@ bool SHAPE_POLY_SET::Collide( const SHAPE* aShape, int aClearance, int* aActual,
 
 void SHAPE_POLY_SET::RemoveAllContours()
 {
+    invalidateSegmentIndex();
+
     m_polys.clear();
 }
 
 
 void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 {
+    invalidateSegmentIndex();
+
     // Default polygon is the last one
     if( aPolygonIdx < 0 )
         aPolygonIdx += m_polys.size();
@@ -2195,6 +2265,8 @@ void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 
 int SHAPE_POLY_SET::RemoveNullSegments()
 {
+    invalidateSegmentIndex();
+
     int removed = 0;
 
     ITERATOR iterator = IterateWithHoles();
@@ -2254,12 +2326,16 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 
 void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 {
+    invalidateSegmentIndex();
+
     m_polys.erase( m_polys.begin() + aIdx );
 }
 
 
 void SHAPE_POLY_SET::DeletePolygonAndTriangulationData( int aIdx, bool aUpdateHash )
 {
+    invalidateSegmentIndex();
+
     m_polys.erase( m_polys.begin() + aIdx );
 
     if( m_triangulationValid )
@@ -2269,11 +2345,17 @@ void SHAPE_POLY_SET::DeletePolygonAndTriangulationData( int aIdx, bool aUpdateHa
             std::unique_ptr<TRIANGULATED_POLYGON>& triangleSet = m_triangulatedPolys[ii];
 
             if( triangleSet->GetSourceOutlineIndex() == aIdx )
+            {
                 m_triangulatedPolys.erase( m_triangulatedPolys.begin() + ii );
+                m_triangulationSerial = newTriangulationSerial();
+            }
             else if( triangleSet->GetSourceOutlineIndex() > aIdx )
                 triangleSet->SetSourceOutlineIndex( triangleSet->GetSourceOutlineIndex() - 1 );
         }
 
+        if( aIdx < (int) m_outlineHashes.size() )
+            m_outlineHashes.erase( m_outlineHashes.begin() + aIdx );
+
         if( aUpdateHash )
             m_hash = checksum();
     }
@@ -2283,17 +2365,24 @@ void SHAPE_POLY_SET::DeletePolygonAndTriangulationData( int aIdx, bool aUpdateHa
 void SHAPE_POLY_SET::UpdateTriangulationDataHash()
 {
     m_hash = checksum();
+
+    resetSegmentIndex();
+    m_segmentIndexEnabled = m_triangulationValid;
 }
 
 
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
+    invalidateSegmentIndex();
+
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
 }
 
 
 void SHAPE_POLY_SET::Append( const VECTOR2I& aP, int aOutline, int aHole )
 {
+    invalidateSegmentIndex();
+
     Append( aP.x, aP.y, aOutline, aHole );
 }
 
@@ -2418,6 +2507,8 @@ void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 
 void SHAPE_POLY_SET::RemoveVertex( VERTEX_INDEX aIndex )
 {
+    invalidateSegmentIndex();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].Remove( aIndex.m_vertex );
 }
 
@@ -2435,6 +2526,8 @@ void SHAPE_POLY_SET::SetVertex( int aGlobalIndex, const VECTOR2I& aPos )
 
 void SHAPE_POLY_SET::SetVertex( const VERTEX_INDEX& aIndex, const VECTOR2I& aPos )
 {
+    invalidateSegmentIndex();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].SetPoint( aIndex.m_vertex, aPos );
 }
 
@@ -2442,6 +2535,11 @@ void SHAPE_POLY_SET::SetVertex( const VERTEX_INDEX& aIndex, const VECTOR2I& aPos
 bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy,
                                      bool aUseBBoxCaches ) const
 {
+    std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex();
+
+    if( index && ( *index )[aSubpolyIndex] )
+        return ( *index )[aSubpolyIndex]->Contains( aP, aAccuracy );
+
     // Check that the point is inside the outline
     if( m_polys[aSubpolyIndex][0].PointInside( aP, aAccuracy ) )
     {
@@ -2475,11 +2573,56 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
         tri->Move( aVector );
 
     m_hash = checksum();
+
+    for( size_t ii = 0; ii < m_outlineHashes.size() && ii < m_polys.size(); ++ii )
+    {
+        if( m_outlineHashes[ii].IsValid() )
+            m_outlineHashes[ii] = polygonChecksum( m_polys[ii] );
+    }
+
+    // Still enabled if it was, but has to be rebuilt at the new position
+    resetSegmentIndex();
+}
+
+
+void SHAPE_POLY_SET::TransformPoints(
+        const std::function<VECTOR2I( const VECTOR2I& )>& aTransform )
+{
+    bool triangulationValid = IsTriangulationUpToDate();
+
+    for( POLYGON& poly : m_polys )
+    {
+        for( SHAPE_LINE_CHAIN& path : poly )
+        {
+            for( int ii = 0; ii < path.PointCount(); ++ii )
+                path.SetPoint( ii, aTransform( path.CPoint( ii ) ) );
+        }
+    }
+
+    if( triangulationValid )
+    {
+        for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
+            tri->TransformVertices( aTransform );
+
+        m_hash = checksum();
+        m_triangulationSerial = newTriangulationSerial();
+
+        for( size_t ii = 0; ii < m_outlineHashes.size() && ii < m_polys.size(); ++ii )
+        {
+            if( m_outlineHashes[ii].IsValid() )
+                m_outlineHashes[ii] = polygonChecksum( m_polys[ii] );
+        }
+    }
+
+    // Still enabled if it was, but has to be rebuilt with the new points
+    resetSegmentIndex();
 }
 
 
 void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
+    invalidateSegmentIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -2493,6 +2636,8 @@ void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 
 void SHAPE_POLY_SET::Rotate( const EDA_ANGLE& aAngle, const VECTOR2I& aCenter )
 {
+    invalidateSegmentIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -2547,6 +2692,11 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
         return 0;
     }
 
+    std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex();
+
+    if( index && ( *index )[aPolygonIndex] )
+        return ( *index )[aPolygonIndex]->SquaredEdgeDistance( aPoint, aNearest );
+
     CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
 
     SEG::ecoord minDistance = (*iterator).SquaredDistance( aPoint );
@@ -2581,6 +2731,15 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int a
         return 0;
     }
 
+    std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex();
+
+    if( index && ( *index )[aPolygonIndex] )
+    {
+        SEG::ecoord minDistance = ( *index )[aPolygonIndex]->SquaredEdgeDistance( aSegment,
+                                                                                  aNearest );
+        return minDistance < 0 ? 0 : minDistance;
+    }
+
     CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
     SEG::ecoord            minDistance = (*iterator).SquaredDistance( aSegment );
 
@@ -2884,6 +3043,11 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
 
     m_hash = aOther.m_hash;
     m_triangulationValid = aOther.m_triangulationValid;
+    m_triangulationSerial = m_triangulatedPolys.empty() ? 0 : newTriangulationSerial();
+    m_outlineHashes = aOther.m_outlineHashes;
+
+    m_segmentIndexEnabled = aOther.m_segmentIndexEnabled.load();
+    std::atomic_store( &m_segmentIndex, std::atomic_load( &aOther.m_segmentIndex ) );
 
     return *this;
 }
@@ -2981,7 +3145,8 @@ static SHAPE_POLY_SET partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aP
 }
 
 
-void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aSimplify )
+void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aSimplify,
+                                         TRIANGULATOR aTriangulator )
 {
     bool recalculate = !m_hash.IsValid();
     MD5_HASH hash;
@@ -3001,7 +3166,10 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aSimplify )
     }
 
     if( !recalculate )
+    {
+        m_segmentIndexEnabled = true;
         return;
+    }
 
     auto triangulate =
             []( SHAPE_POLY_SET& polySet, int forOutline,
@@ -3043,31 +3211,144 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aSimplify )
                 return triangulationValid;
             };
 
-    m_triangulatedPolys.clear();
-    m_triangulationValid = true;
+    typedef std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> TRIANGULATION;
+
+    // The sweep handles holes directly, so the polygons only need to be simple
+    auto triangulateSweep =
+            []( SHAPE_POLY_SET& polySet, int forOutline, TRIANGULATION& dest )
+            {
+                if( polySet.IsSelfIntersecting() )
+                    polySet.Simplify( PM_STRICTLY_SIMPLE );
+
+                for( int ii = 0; ii < polySet.OutlineCount(); ++ii )
+                {
+                    dest.push_back( std::make_unique<TRIANGULATED_POLYGON>( forOutline ) );
+                    MONOTONE_TRIANGULATION tess( *dest.back() );
+
+                    if( !tess.TesselatePolygon( polySet.CPolygon( ii ) ) )
+                    {
+                        dest.clear();
+                        return false;
+                    }
+                }
+
+                return true;
+            };
 
     if( aPartition )
     {
-        for( int ii = 0; ii < OutlineCount(); ++ii )
+        int                        count = OutlineCount();
+        std::vector<MD5_HASH>      hashes( count );
+        std::vector<TRIANGULATION> triangulations( count );
+        std::vector<char>          valid( count, true );
+        std::vector<int>           todo;
+
+        // Islands which haven't changed since the last triangulation keep their triangles
+        std::vector<TRIANGULATION> previous( m_outlineHashes.size() );
+        std::vector<bool>          reused( m_outlineHashes.size(), false );
+
+        for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : m_triangulatedPolys )
         {
-            // This partitions into regularly-sized grids (1cm in Pcbnew)
-            SHAPE_POLY_SET flattened( Outline( ii ) );
+            int source = tri->GetSourceOutlineIndex();
+
+            if( source >= 0 && source < (int) previous.size() )
+                previous[source].push_back( std::move( tri ) );
+        }
+
+        for( int ii = 0; ii < count; ++ii )
+        {
+            hashes[ii] = polygonChecksum( m_polys[ii] );
+
+            auto matches =
+                    [&]( int aPrevious )
+                    {
+                        return !reused[aPrevious] && !previous[aPrevious].empty()
+                               && m_outlineHashes[aPrevious].IsValid()
+                               && m_outlineHashes[aPrevious] == hashes[ii];
+                    };
+
+            // Try the same index first: it's where an unchanged island usually stays
+            int match = -1;
 
-            for( int jj = 0; jj < HoleCount( ii ); ++jj )
-                flattened.AddHole( Hole( ii, jj ) );
+            if( ii < (int) previous.size() && matches( ii ) )
+            {
+                match = ii;
+            }
+            else
+            {
+                for( int jj = 0; jj < (int) previous.size() && match < 0; ++jj )
+                {
+                    if( matches( jj ) )
+                        match = jj;
+                }
+            }
 
-            flattened.ClearArcs();
+            if( match >= 0 )
+            {
+                reused[match] = true;
+                triangulations[ii] = std::move( previous[match] );
+
+                for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : triangulations[ii] )
+                    tri->SetSourceOutlineIndex( ii );
+            }
+            else
+            {
+                todo.push_back( ii );
+            }
+        }
 
-            if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
-                flattened.Fracture( PM_FAST );
-            else if( aSimplify )
-                flattened.Simplify( PM_FAST );
+        // Islands are independent, so they can be triangulated concurrently
+        ParallelFor( todo.size(),
+                     [&]( size_t aJob )
+                     {
+                         int ii = todo[aJob];
+
+                         // This partitions into regularly-sized grids (1cm in Pcbnew)
+                         SHAPE_POLY_SET flattened( COutline( ii ) );
+
+                         for( int jj = 0; jj < HoleCount( ii ); ++jj )
+                             flattened.AddHole( CHole( ii, jj ) );
+
+                         flattened.ClearArcs();
+
+                         if( aTriangulator == TRIANGULATOR::SWEEP_LINE )
+                         {
+                             SHAPE_POLY_SET simple( flattened );
+
+                             if( triangulateSweep( simple, ii, triangulations[ii] ) )
+                                 return;
+                         }
+
+                         if( flattened.HasHoles() || flattened.IsSelfIntersecting() )
+                             flattened.Fracture( PM_FAST );
+                         else if( aSimplify )
+                             flattened.Simplify( PM_FAST );
+
+                         SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened,
+                                                                                         1e7 );
+
+                         // This pushes the triangulation for all polys in partitions
+                         // to be referenced to the ii-th polygon
+                         valid[ii] = triangulate( partitions, ii, triangulations[ii] );
+                     } );
+
+        m_triangulatedPolys.clear();
+        m_triangulationValid = true;
+        m_outlineHashes.assign( count, MD5_HASH() );
+
+        for( int ii = 0; ii < count; ++ii )
+        {
+            for( std::unique_ptr<TRIANGULATED_POLYGON>& tri : triangulations[ii] )
+            {
+                if( tri->GetTriangleCount() > 0 )
+                    m_triangulatedPolys.push_back( std::move( tri ) );
+            }
 
-            SHAPE_POLY_SET partitions = partitionPolyIntoRegularCellGrid( flattened, 1e7 );
+            m_triangulationValid &= (bool) valid[ii];
 
-            // This pushes the triangulation for all polys in partitions
-            // to be referenced to the ii-th polygon
-            m_triangulationValid &= triangulate( partitions, ii , m_triangulatedPolys );
+            // Don't remember failed islands so they are retried next time
+            if( valid[ii] )
+                m_outlineHashes[ii] = hashes[ii];
         }
     }
     else
@@ -3076,13 +3357,67 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, bool aSimplify )
 
         tmpSet.ClearArcs();
 
-        tmpSet.Fracture( PM_FAST );
+        m_triangulatedPolys.clear();
+        m_outlineHashes.clear();
+
+        bool done = false;
+
+        if( aTriangulator == TRIANGULATOR::SWEEP_LINE )
+        {
+            SHAPE_POLY_SET simple( tmpSet );
+            done = triangulateSweep( simple, -1, m_triangulatedPolys );
+            m_triangulationValid = done;
+        }
 
-        m_triangulationValid = triangulate( tmpSet, -1, m_triangulatedPolys );
+        if( !done )
+        {
+            tmpSet.Fracture( PM_FAST );
+            m_triangulationValid = triangulate( tmpSet, -1, m_triangulatedPolys );
+        }
     }
 
     if( m_triangulationValid )
         m_hash = checksum();
+
+    m_triangulationSerial = newTriangulationSerial();
+    resetSegmentIndex();
+    m_segmentIndexEnabled = m_triangulationValid;
+}
+
+
+std::shared_ptr<const SHAPE_POLY_SET::SEGMENT_INDEX> SHAPE_POLY_SET::segmentIndex() const
+{
+    if( !m_segmentIndexEnabled )
+        return nullptr;
+
+    std::shared_ptr<const SEGMENT_INDEX> index = std::atomic_load( &m_segmentIndex );
+
+    if( index )
+        return index;
+
+    std::shared_ptr<SEGMENT_INDEX> built = std::make_shared<SEGMENT_INDEX>();
+
+    for( const POLYGON& poly : m_polys )
+    {
+        size_t segmentCount = 0;
+
+        for( const SHAPE_LINE_CHAIN& path : poly )
+            segmentCount += path.SegmentCount();
+
+        if( segmentCount >= POLYGON_SEGMENT_INDEX::MIN_SEGMENTS )
+            built->push_back( std::make_unique<POLYGON_SEGMENT_INDEX>( poly ) );
+        else
+            built->push_back( nullptr );
+    }
+
+    // Concurrent queries may build the index at the same time; keep whichever came first
+    std::shared_ptr<const SEGMENT_INDEX> expected;
+    index = built;
+
+    if( !std::atomic_compare_exchange_strong( &m_segmentIndex, &expected, index ) )
+        index = expected;
+
+    return index;
 }
 
 
@@ -3234,49 +3569,36 @@ const SHAPE_POLY_SET
 SHAPE_POLY_SET::BuildPolysetFromOrientedPaths( const std::vector<SHAPE_LINE_CHAIN>& aPaths,
                                                bool aReverseOrientation, bool aEvenOdd )
 {
-    ClipperLib::Clipper  clipper;
-    ClipperLib::PolyTree tree;
+    Clipper2Lib::Clipper64  clipper;
+    Clipper2Lib::PolyTree64 tree;
+    Clipper2Lib::Paths64    paths;
 
     // fixme: do we need aReverseOrientation?
 
+    paths.reserve( aPaths.size() );
+
     for( const SHAPE_LINE_CHAIN& path : aPaths )
     {
-        ClipperLib::Path lc;
+        Clipper2Lib::Path64 lc;
+        lc.reserve( path.PointCount() );
 
         for( int i = 0; i < path.PointCount(); i++ )
-        {
             lc.emplace_back( path.CPoint( i ).x, path.CPoint( i ).y );
-        }
 
-        clipper.AddPath( lc, ClipperLib::ptSubject, true );
+        paths.push_back( std::move( lc ) );
     }
 
-    clipper.StrictlySimple( true );
-    clipper.Execute( ClipperLib::ctUnion, tree,
-                     aEvenOdd ? ClipperLib::pftEvenOdd : ClipperLib::pftNonZero,
-                     ClipperLib::pftNonZero );
-    SHAPE_POLY_SET result;
-
-    for( ClipperLib::PolyNode* n = tree.GetFirst(); n; n = n->GetNext() )
-    {
-        if( !n->IsHole() )
-        {
-            int outl = result.NewOutline();
+    clipper.AddSubject( paths );
+    clipper.Execute( Clipper2Lib::ClipType::Union,
+                     aEvenOdd ? Clipper2Lib::FillRule::EvenOdd : Clipper2Lib::FillRule::NonZero,
+                     tree );
 
-            for( unsigned int i = 0; i < n->Contour.size(); i++ )
-                result.Outline( outl ).Append( n->Contour[i].X, n->Contour[i].Y );
+    SHAPE_POLY_SET               result;
+    std::vector<CLIPPER_Z_VALUE> zValues( 1 );
+    std::vector<SHAPE_ARC>       arcBuffer;
 
-            for( unsigned int i = 0; i < n->Childs.size(); i++ )
-            {
-                int outh = result.NewHole( outl );
-                for( unsigned int j = 0; j < n->Childs[i]->Contour.size(); j++ )
-                {
-                    result.Hole( outl, outh )
-                            .Append( n->Childs[i]->Contour[j].X, n->Childs[i]->Contour[j].Y );
-                }
-            }
-        }
-    }
+    result.importTree( tree, zValues, arcBuffer );
+    tree.Clear();
 
     return result;
 }
@@ -3284,10 +3606,27 @@ SHAPE_POLY_SET::BuildPolysetFromOrientedPaths( const std::vector<SHAPE_LINE_CHAI
 
 bool SHAPE_POLY_SET::PointInside( const VECTOR2I& aPt, int aAccuracy, bool aUseBBoxCache ) const
 {
+    std::shared_ptr<const SEGMENT_INDEX> index = segmentIndex();
+
     for( int idx = 0; idx < OutlineCount(); idx++ )
     {
-        if( COutline( idx ).PointInside( aPt, aAccuracy, aUseBBoxCache ) )
+        const SHAPE_LINE_CHAIN& outline = COutline( idx );
+
+        if( index && ( *index )[idx] )
+        {
+            if( aUseBBoxCache && outline.GetCachedBBox()
+                    && !outline.GetCachedBBox()->Contains( aPt ) )
+            {
+                continue;
+            }
+
+            if( ( *index )[idx]->OutlineContains( aPt, aAccuracy ) )
+                return true;
+        }
+        else if( outline.PointInside( aPt, aAccuracy, aUseBBoxCache ) )
+        {
             return true;
+        }
     }
 
     return false;
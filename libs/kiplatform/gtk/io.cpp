@@ -23,6 +23,7 @@
 #include <wx/string.h>
 
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -58,3 +59,51 @@ bool KIPLATFORM::IO::DuplicatePermissions( const wxString &aSrc, const wxString
         return false;
     }
 }
+
+
+bool KIPLATFORM::IO::MapFile( const wxString& aPath, MAPPED_FILE& aFile )
+{
+    aFile = MAPPED_FILE();
+
+    int fd = open( aPath.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return false;
+
+    struct stat fileStat;
+
+    if( fstat( fd, &fileStat ) != 0 )
+    {
+        close( fd );
+        return false;
+    }
+
+    if( fileStat.st_size > 0 )
+    {
+        void* data = mmap( nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+
+        if( data == MAP_FAILED )
+        {
+            close( fd );
+            return false;
+        }
+
+        madvise( data, fileStat.st_size, MADV_SEQUENTIAL );
+
+        aFile.m_data = static_cast<const char*>( data );
+        aFile.m_size = fileStat.st_size;
+    }
+
+    // The mapping outlives the descriptor
+    close( fd );
+    return true;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( MAPPED_FILE& aFile )
+{
+    if( aFile.m_data )
+        munmap( const_cast<char*>( aFile.m_data ), aFile.m_size );
+
+    aFile = MAPPED_FILE();
+}
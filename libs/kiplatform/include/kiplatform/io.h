@@ -20,6 +20,7 @@
 #ifndef KIPLATFORM_IO_H_
 #define KIPLATFORM_IO_H_
 
+#include <stddef.h>
 #include <stdio.h>
 
 class wxString;
@@ -44,6 +45,29 @@ namespace IO
      * @return true if the process was successful
      */
     bool DuplicatePermissions( const wxString& aSrc, const wxString& aDest );
+
+    /**
+     * A whole file mapped read-only in memory, see MapFile().
+     */
+    struct MAPPED_FILE
+    {
+        const char* m_data = nullptr;
+        size_t      m_size = 0;
+        void*       m_handle = nullptr;     ///< platform specific, for UnmapFile()
+    };
+
+    /**
+     * Map the file \a aPath read-only in memory, hinting the system that it will be read
+     * sequentially.  An empty file maps to no data.
+     *
+     * @return true if the file was mapped, false if it couldn't be opened or mapped.
+     */
+    bool MapFile( const wxString& aPath, MAPPED_FILE& aFile );
+
+    /**
+     * Release a mapping made by MapFile().  \a aFile is emptied.
+     */
+    void UnmapFile( MAPPED_FILE& aFile );
 } // namespace IO
 } // namespace KIPLATFORM
 
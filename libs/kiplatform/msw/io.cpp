@@ -114,3 +114,63 @@ bool KIPLATFORM::IO::DuplicatePermissions( const wxString &aSrc, const wxString
 
     return retval;
 }
+
+
+bool KIPLATFORM::IO::MapFile( const wxString& aPath, MAPPED_FILE& aFile )
+{
+    aFile = MAPPED_FILE();
+
+    HANDLE hFile = CreateFileW( aPath.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL );
+
+    if( hFile == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+
+    if( !GetFileSizeEx( hFile, &size ) )
+    {
+        CloseHandle( hFile );
+        return false;
+    }
+
+    if( size.QuadPart > 0 )
+    {
+        HANDLE hMapping = CreateFileMappingW( hFile, NULL, PAGE_READONLY, 0, 0, NULL );
+
+        if( !hMapping )
+        {
+            CloseHandle( hFile );
+            return false;
+        }
+
+        void* data = MapViewOfFile( hMapping, FILE_MAP_READ, 0, 0, 0 );
+
+        if( !data )
+        {
+            CloseHandle( hMapping );
+            CloseHandle( hFile );
+            return false;
+        }
+
+        aFile.m_data = static_cast<const char*>( data );
+        aFile.m_size = static_cast<size_t>( size.QuadPart );
+        aFile.m_handle = hMapping;
+    }
+
+    // The mapping keeps the file open
+    CloseHandle( hFile );
+    return true;
+}
+
+
+void KIPLATFORM::IO::UnmapFile( MAPPED_FILE& aFile )
+{
+    if( aFile.m_data )
+        UnmapViewOfFile( aFile.m_data );
+
+    if( aFile.m_handle )
+        CloseHandle( static_cast<HANDLE>( aFile.m_handle ) );
+
+    aFile = MAPPED_FILE();
+}
@@ -62,6 +62,9 @@ PL_DRAW_PANEL_GAL::PL_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWindo
     // This fixes the zoom in and zoom out limits
     m_view->SetScaleLimits( ZOOM_MAX_LIMIT_PLEDITOR, ZOOM_MIN_LIMIT_PLEDITOR );
 
+    // Panning only draws the uncovered area when the GAL can move what it drew
+    m_view->UseScrollRedraw( true );
+
     setDefaultLayerDeps();
 
     m_view->SetLayerVisible( LAYER_DRAWINGSHEET, true );
@@ -0,0 +1,342 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <unordered_set>
+
+#include <board.h>
+#include <board_item.h>
+#include <footprint.h>
+#include <geometry/shape_poly_set.h>
+#include <hash.h>
+#include <hash_eda.h>
+#include <pcb_track.h>
+#include <zone.h>
+
+#include "area_test_cache.h"
+
+
+std::optional<bool> AREA_TEST_CACHE::Get( TEST aTest, const BOARD_ITEM* aArea,
+                                          const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer ) const
+{
+    const SHARD&                        itemShard = shard( aItem );
+    std::shared_lock<std::shared_mutex> lock( itemShard.m_mutex );
+    auto                                it = itemShard.m_results.find( aItem );
+
+    if( it == itemShard.m_results.end() )
+        return std::nullopt;
+
+    for( const RESULT& result : it->second )
+    {
+        if( result.m_area == aArea && result.m_layer == aLayer && result.m_test == aTest )
+            return result.m_result;
+    }
+
+    return std::nullopt;
+}
+
+
+void AREA_TEST_CACHE::Set( TEST aTest, const BOARD_ITEM* aArea, const BOARD_ITEM* aItem,
+                           PCB_LAYER_ID aLayer, bool aResult )
+{
+    SHARD&                              itemShard = shard( aItem );
+    std::unique_lock<std::shared_mutex> lock( itemShard.m_mutex );
+    std::vector<RESULT>&                results = itemShard.m_results[aItem];
+
+    // Two threads may have run the same test; they got the same result
+    for( const RESULT& result : results )
+    {
+        if( result.m_area == aArea && result.m_layer == aLayer && result.m_test == aTest )
+            return;
+    }
+
+    results.push_back( { aArea, aLayer, aTest, aResult } );
+}
+
+
+std::shared_ptr<const SHAPE_POLY_SET> AREA_TEST_CACHE::GetTestOutline( const ZONE* aArea,
+                                                                       int aEpsilon )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_outlinesMutex );
+        auto                        it = m_outlines.find( aArea );
+
+        if( it != m_outlines.end() && it->second.m_epsilon == aEpsilon )
+            return it->second.m_outline;
+    }
+
+    // Collisions include touching, so the outline is deflated by enough to exclude it.  This
+    // is particularly important for copper fills, which touch their rule areas along their
+    // whole border.
+    std::shared_ptr<SHAPE_POLY_SET> outline = std::make_shared<SHAPE_POLY_SET>(
+            aArea->Outline()->CloneDropTriangulation() );
+
+    outline->ClearArcs();
+    outline->Deflate( aEpsilon, CORNER_STRATEGY::ALLOW_ACUTE_CORNERS, ARC_LOW_DEF );
+
+    // Built outside of the lock; if two threads race on the same area the last one wins
+    std::lock_guard<std::mutex> lock( m_outlinesMutex );
+
+    m_outlines[aArea] = { aEpsilon, outline };
+    return outline;
+}
+
+
+void AREA_TEST_CACHE::Invalidate( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::unordered_set<const BOARD_ITEM*> items;
+    std::unordered_set<const BOARD_ITEM*> areas;
+
+    auto addItem =
+            [&]( BOARD_ITEM* aItem )
+            {
+                items.insert( aItem );
+
+                if( aItem->Type() == PCB_ZONE_T || aItem->Type() == PCB_FOOTPRINT_T )
+                    areas.insert( aItem );
+            };
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        addItem( item );
+        item->RunOnDescendants( addItem );
+    }
+
+    invalidate( items, areas );
+}
+
+
+/**
+ * Hash what the area tests read of \a aItem: its layers and its shape.  The descendants of
+ * an item are hashed separately.
+ */
+static size_t geometryHash( BOARD_ITEM* aItem )
+{
+    size_t hash = hash_val( aItem->Type() );
+
+    for( PCB_LAYER_ID layer : aItem->GetLayerSet().Seq() )
+        hash_combine( hash, layer );
+
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    {
+        PCB_TRACK* track = static_cast<PCB_TRACK*>( aItem );
+
+        hash_combine( hash, track->GetStart().x, track->GetStart().y, track->GetEnd().x,
+                      track->GetEnd().y, track->GetWidth() );
+
+        if( track->Type() == PCB_ARC_T )
+            hash_combine( hash, static_cast<PCB_ARC*>( track )->GetMid().x,
+                          static_cast<PCB_ARC*>( track )->GetMid().y );
+
+        break;
+    }
+
+    case PCB_VIA_T:
+        hash_combine( hash, aItem->GetPosition().x, aItem->GetPosition().y,
+                      hash_fp_item( aItem, HASH_ALL ) );
+        break;
+
+    case PCB_ZONE_T:
+    {
+        ZONE* zone = static_cast<ZONE*>( aItem );
+
+        for( auto it = zone->Outline()->CIterateWithHoles(); it; it++ )
+            hash_combine( hash, it->x, it->y );
+
+        // Zones are tested on their fill
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            hash_combine( hash, zone->GetHashValue( layer ).Format( true ) );
+
+        break;
+    }
+
+    case PCB_FOOTPRINT_T:
+    {
+        FOOTPRINT* footprint = static_cast<FOOTPRINT*>( aItem );
+
+        hash_combine( hash, footprint->GetPosition().x, footprint->GetPosition().y,
+                      footprint->GetOrientation().AsDegrees(), footprint->IsFlipped() );
+        break;
+    }
+
+    case PCB_PAD_T:
+    case PCB_SHAPE_T:
+    case PCB_FIELD_T:
+    case PCB_TEXT_T:
+    case PCB_TEXTBOX_T:
+        hash_combine( hash, hash_fp_item( aItem, HASH_POS | HASH_ROT | HASH_LAYER ) );
+        break;
+
+    default:
+    {
+        BOX2I bbox = aItem->GetBoundingBox();
+
+        hash_combine( hash, aItem->GetPosition().x, aItem->GetPosition().y, bbox.GetX(),
+                      bbox.GetY(), bbox.GetWidth(), bbox.GetHeight() );
+        break;
+    }
+    }
+
+    return hash;
+}
+
+
+void AREA_TEST_CACHE::Revalidate( BOARD* aBoard )
+{
+    std::unordered_map<const BOARD_ITEM*, size_t> geometry;
+
+    for( BOARD_ITEM* item : aBoard->GetItemSet() )
+    {
+        size_t hash = geometryHash( item );
+
+        // A footprint is tested through its courtyard and pads, so it changes with them
+        item->RunOnDescendants(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    size_t childHash = geometryHash( aChild );
+
+                    geometry[aChild] = childHash;
+                    hash_combine( hash, childHash );
+                } );
+
+        geometry[item] = hash;
+    }
+
+    std::unordered_set<const BOARD_ITEM*> items;
+    std::unordered_set<const BOARD_ITEM*> areas;
+
+    std::lock_guard<std::mutex> lock( m_geometryMutex );
+
+    for( const auto& [item, hash] : geometry )
+    {
+        auto it = m_geometry.find( item );
+
+        if( it == m_geometry.end() || it->second != hash )
+        {
+            items.insert( item );
+
+            if( item->Type() == PCB_ZONE_T || item->Type() == PCB_FOOTPRINT_T )
+                areas.insert( item );
+        }
+    }
+
+    // Items deleted without a commit; a new item may have been given the same address
+    for( const auto& [item, hash] : m_geometry )
+    {
+        if( !geometry.count( item ) )
+        {
+            items.insert( item );
+            areas.insert( item );
+        }
+    }
+
+    m_geometry = std::move( geometry );
+
+    invalidate( items, areas );
+}
+
+
+void AREA_TEST_CACHE::invalidate( const std::unordered_set<const BOARD_ITEM*>& aItems,
+                                  const std::unordered_set<const BOARD_ITEM*>& aAreas )
+{
+    for( const BOARD_ITEM* item : aItems )
+    {
+        SHARD&                              itemShard = shard( item );
+        std::unique_lock<std::shared_mutex> lock( itemShard.m_mutex );
+
+        itemShard.m_results.erase( item );
+    }
+
+    if( aAreas.empty() )
+        return;
+
+    // Results are stored by item tested: finding the ones against an area means looking at
+    // all of them
+    for( SHARD& areaShard : m_shards )
+    {
+        std::unique_lock<std::shared_mutex> lock( areaShard.m_mutex );
+
+        for( auto it = areaShard.m_results.begin(); it != areaShard.m_results.end(); )
+        {
+            std::vector<RESULT>& results = it->second;
+
+            results.erase( std::remove_if( results.begin(), results.end(),
+                                           [&]( const RESULT& aResult )
+                                           {
+                                               return aAreas.count( aResult.m_area ) > 0;
+                                           } ),
+                           results.end() );
+
+            if( results.empty() )
+                it = areaShard.m_results.erase( it );
+            else
+                ++it;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock( m_outlinesMutex );
+
+    for( const BOARD_ITEM* area : aAreas )
+        m_outlines.erase( area );
+}
+
+
+void AREA_TEST_CACHE::SetParameters( int aEpsilon, int aMaxError )
+{
+    if( aEpsilon != m_epsilon || aMaxError != m_maxError )
+    {
+        Clear();
+        m_epsilon = aEpsilon;
+        m_maxError = aMaxError;
+    }
+}
+
+
+void AREA_TEST_CACHE::Clear()
+{
+    for( SHARD& itemShard : m_shards )
+    {
+        std::unique_lock<std::shared_mutex> lock( itemShard.m_mutex );
+
+        itemShard.m_results.clear();
+    }
+
+    std::lock_guard<std::mutex> lock( m_outlinesMutex );
+
+    m_outlines.clear();
+}
+
+
+size_t AREA_TEST_CACHE::GetEntryCount() const
+{
+    size_t count = 0;
+
+    for( const SHARD& itemShard : m_shards )
+    {
+        std::shared_lock<std::shared_mutex> lock( itemShard.m_mutex );
+
+        for( const auto& [item, results] : itemShard.m_results )
+            count += results.size();
+    }
+
+    return count;
+}
@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef AREA_TEST_CACHE_H
+#define AREA_TEST_CACHE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <layer_ids.h>
+
+class BOARD;
+class BOARD_ITEM;
+class SHAPE_POLY_SET;
+class ZONE;
+
+
+/**
+ * The results of the intersectsArea(), enclosedByArea() and intersects*Courtyard() rule
+ * functions, shared by the DRC threads and kept from one DRC run to the next.
+ *
+ * Each result is stored with the item tested, the area or footprint it was tested against and
+ * the layer of the evaluation.  Results are sharded by item, each shard having its own lock,
+ * so that threads testing different items rarely wait for each other, and lookups only take
+ * a shared lock.
+ *
+ * Commits call Invalidate() for the items they add, change or remove: the results of the
+ * other items stay valid, so that a DRC run after an edit only tests what changed.  Undo and
+ * revert clear the whole cache.  Items can also be edited in place without a commit (by
+ * scripts for instance), so DRC calls Revalidate() before each run.
+ *
+ * Thread-safe.
+ */
+class AREA_TEST_CACHE
+{
+public:
+    enum class TEST
+    {
+        INTERSECTS_AREA,
+        HOLE_INTERSECTS_AREA,           ///< intersectsArea() of a hole proxy
+        ENCLOSED_BY_AREA,
+        INTERSECTS_COURTYARD,
+        INTERSECTS_FRONT_COURTYARD,
+        INTERSECTS_BACK_COURTYARD
+    };
+
+    /**
+     * @param aArea is the rule area, or the footprint for the courtyard tests.
+     * @param aLayer is the layer of the evaluation, UNDEFINED_LAYER if it has none.
+     * @return the result of the test, if there is one.
+     */
+    std::optional<bool> Get( TEST aTest, const BOARD_ITEM* aArea, const BOARD_ITEM* aItem,
+                             PCB_LAYER_ID aLayer ) const;
+
+    void Set( TEST aTest, const BOARD_ITEM* aArea, const BOARD_ITEM* aItem, PCB_LAYER_ID aLayer,
+              bool aResult );
+
+    /**
+     * @return the outline of \a aArea shrunk by \a aEpsilon, as intersectsArea() tests it,
+     *         built on first use.
+     */
+    std::shared_ptr<const SHAPE_POLY_SET> GetTestOutline( const ZONE* aArea, int aEpsilon );
+
+    /**
+     * Drop the results involving the items or their descendants, whether as item tested or as
+     * area or footprint tested against.
+     */
+    void Invalidate( const std::vector<BOARD_ITEM*>& aItems );
+
+    /**
+     * Drop the results involving the items of \a aBoard whose geometry changed since the last
+     * call, and the items which left the board since then.
+     *
+     * Compares a hash of the shape and layers of every item with the one taken by the previous
+     * call, so that edits made without a commit are caught.
+     */
+    void Revalidate( BOARD* aBoard );
+
+    /**
+     * Set the board settings the results depend on, clearing the cache if they changed.
+     */
+    void SetParameters( int aEpsilon, int aMaxError );
+
+    void Clear();
+
+    size_t GetEntryCount() const;
+
+private:
+    struct RESULT
+    {
+        const BOARD_ITEM* m_area;
+        PCB_LAYER_ID      m_layer;
+        TEST              m_test;
+        bool              m_result;
+    };
+
+    struct SHARD
+    {
+        mutable std::shared_mutex                                     m_mutex;
+        std::unordered_map<const BOARD_ITEM*, std::vector<RESULT>>    m_results;
+    };
+
+    static constexpr size_t SHARD_COUNT = 64;
+
+    /**
+     * Drop the results of \a aItems, and the results against \a aAreas.  The items are only
+     * compared, never dereferenced, so they may already be deleted.
+     */
+    void invalidate( const std::unordered_set<const BOARD_ITEM*>& aItems,
+                     const std::unordered_set<const BOARD_ITEM*>& aAreas );
+
+    SHARD& shard( const BOARD_ITEM* aItem ) const
+    {
+        // Items are hundreds of bytes apart: the low bits of their addresses are all alike
+        return m_shards[( reinterpret_cast<uintptr_t>( aItem ) >> 6 ) % SHARD_COUNT];
+    }
+
+    mutable std::array<SHARD, SHARD_COUNT>                                        m_shards;
+
+    struct OUTLINE
+    {
+        int                                   m_epsilon;
+        std::shared_ptr<const SHAPE_POLY_SET> m_outline;
+    };
+
+    mutable std::mutex                                         m_outlinesMutex;
+    std::unordered_map<const BOARD_ITEM*, OUTLINE>             m_outlines;
+
+    std::mutex                                                 m_geometryMutex;
+    std::unordered_map<const BOARD_ITEM*, size_t>              m_geometry;  ///< at last Revalidate()
+
+    int m_epsilon = -1;
+    int m_maxError = -1;
+};
+
+#endif // AREA_TEST_CACHE_H
@@ -26,6 +26,7 @@
  */
 
 #include <iterator>
+#include <unordered_set>
 
 #include <wx/log.h>
 
@@ -38,6 +39,7 @@
 #include <connectivity/connectivity_data.h>
 #include <convert_shape_list_to_polygon.h>
 #include <footprint.h>
+#include <hash_eda.h>
 #include <pcb_base_frame.h>
 #include <pcb_track.h>
 #include <pcb_marker.h>
@@ -253,22 +255,15 @@ void BOARD::IncrementTimeStamp()
 {
     m_timeStamp++;
 
-    if( !m_IntersectsAreaCache.empty()
-        || !m_EnclosedByAreaCache.empty()
-        || !m_IntersectsCourtyardCache.empty()
-        || !m_IntersectsFCourtyardCache.empty()
-        || !m_IntersectsBCourtyardCache.empty()
-        || !m_LayerExpressionCache.empty()
+    // m_AreaTestCache is kept: commits invalidate the items they change, and DRC revalidates
+    // it for the items changed without a commit
+
+    if( !m_LayerExpressionCache.empty()
         || !m_ZoneBBoxCache.empty()
         || m_CopperItemRTreeCache )
     {
         std::unique_lock<std::mutex> cacheLock( m_CachesMutex );
 
-        m_IntersectsAreaCache.clear();
-        m_EnclosedByAreaCache.clear();
-        m_IntersectsCourtyardCache.clear();
-        m_IntersectsFCourtyardCache.clear();
-        m_IntersectsBCourtyardCache.clear();
         m_LayerExpressionCache.clear();
 
         m_ZoneBBoxCache.clear();
@@ -284,6 +279,18 @@ void BOARD::IncrementTimeStamp()
         m_ZoneIsolatedIslandsMap.clear();
         m_CopperZoneRTreeCache.clear();
     }
+
+    m_PadShapeCache.Clear();
+    m_PlotGeometryCache.Clear();
+    invalidateOutlinesCache();
+}
+
+
+void BOARD::invalidateOutlinesCache()
+{
+    std::lock_guard<std::mutex> lock( m_outlinesCacheMutex );
+
+    m_outlinesCache.clear();
 }
 
 
@@ -947,6 +954,9 @@ void BOARD::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectivity
     aBoardItem->SetParent( this );
     aBoardItem->ClearEditFlags();
 
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        CacheItemById( aBoardItem );
+
     if( !aSkipConnectivity )
         m_connectivity->Add( aBoardItem );
 
@@ -1051,17 +1061,72 @@ void BOARD::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aRemoveMode )
         wxFAIL_MSG( wxT( "BOARD::Remove() needs more ::Type() support" ) );
     }
 
+    detachRemovedItem( aBoardItem );
+
+    if( aRemoveMode != REMOVE_MODE::BULK )
+        InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aBoardItem );
+}
+
+
+void BOARD::RemoveItems( const std::vector<BOARD_ITEM*>& aItems )
+{
+    std::unordered_set<BOARD_ITEM*> tracks;
+    std::vector<BOARD_ITEM*>        removed;
+
+    removed.reserve( aItems.size() );
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        switch( item->Type() )
+        {
+        case PCB_TRACE_T:
+        case PCB_ARC_T:
+        case PCB_VIA_T:
+            if( tracks.insert( item ).second )
+                removed.push_back( item );
+
+            break;
+
+        default:
+            Remove( item, REMOVE_MODE::BULK );
+            removed.push_back( item );
+        }
+    }
+
+    // Tracks are the bulk of any large removal: drop them from the deque in a single pass
+    // instead of one search per track.
+    if( !tracks.empty() )
+    {
+        alg::delete_if( m_tracks,
+                        [&]( PCB_TRACK* aTrack )
+                        {
+                            return tracks.count( aTrack ) > 0;
+                        } );
+
+        for( BOARD_ITEM* item : removed )
+        {
+            if( tracks.count( item ) )
+                detachRemovedItem( item );
+        }
+    }
+
+    FinalizeBulkRemove( removed );
+}
+
+
+void BOARD::detachRemovedItem( BOARD_ITEM* aBoardItem )
+{
     aBoardItem->SetFlags( STRUCT_DELETED );
 
+    if( aBoardItem->Type() != PCB_NETINFO_T )
+        UncacheItemById( aBoardItem );
+
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
 
     if( parentGroup && !( parentGroup->GetFlags() & STRUCT_DELETED ) )
         parentGroup->RemoveItem( aBoardItem );
 
     m_connectivity->Remove( aBoardItem );
-
-    if( aRemoveMode != REMOVE_MODE::BULK )
-        InvokeListeners( &BOARD_LISTENER::OnBoardItemRemoved, *this, aBoardItem );
 }
 
 
@@ -1101,7 +1166,10 @@ void BOARD::DeleteMARKERs()
 {
     // the vector does not know how to delete the PCB_MARKER, it holds pointers
     for( PCB_MARKER* marker : m_markers )
+    {
+        UncacheItemById( marker );
         delete marker;
+    }
 
     m_markers.clear();
 }
@@ -1117,6 +1185,7 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
         if( ( marker->GetSeverity() == RPT_SEVERITY_EXCLUSION && aExclusions )
                 || ( marker->GetSeverity() != RPT_SEVERITY_EXCLUSION && aWarningsAndErrors ) )
         {
+            UncacheItemById( marker );
             delete marker;
         }
         else
@@ -1132,7 +1201,10 @@ void BOARD::DeleteMARKERs( bool aWarningsAndErrors, bool aExclusions )
 void BOARD::DeleteAllFootprints()
 {
     for( FOOTPRINT* footprint : m_footprints )
+    {
+        UncacheItemById( footprint );
         delete footprint;
+    }
 
     m_footprints.clear();
 }
@@ -1143,6 +1215,15 @@ BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
     if( aID == niluuid )
         return nullptr;
 
+    // The ID of an item can be changed in place, so make sure it still matches
+    if( auto it = m_itemByIdCache.find( aID ); it != m_itemByIdCache.end() )
+    {
+        if( it->second->m_Uuid == aID )
+            return it->second;
+    }
+
+    // Nets aren't indexed; other misses are deleted items or IDs changed behind our back
+
     for( PCB_TRACK* track : Tracks() )
     {
         if( track->m_Uuid == aID )
@@ -1230,6 +1311,41 @@ BOARD_ITEM* BOARD::GetItem( const KIID& aID ) const
 }
 
 
+void BOARD::CacheItemById( BOARD_ITEM* aItem ) const
+{
+    m_itemByIdCache[aItem->m_Uuid] = aItem;
+
+    // Group members are board items of their own, only footprints own their children
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        aItem->RunOnDescendants(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    m_itemByIdCache[aChild->m_Uuid] = aChild;
+                } );
+    }
+}
+
+
+void BOARD::UncacheItemById( BOARD_ITEM* aItem ) const
+{
+    auto uncache =
+            [&]( BOARD_ITEM* aEntry )
+            {
+                auto it = m_itemByIdCache.find( aEntry->m_Uuid );
+
+                // Another item may have taken over the ID
+                if( it != m_itemByIdCache.end() && it->second == aEntry )
+                    m_itemByIdCache.erase( it );
+            };
+
+    uncache( aItem );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+        aItem->RunOnDescendants( uncache );
+}
+
+
 void BOARD::FillItemMap( std::map<KIID, EDA_ITEM*>& aMap )
 {
     // the board itself
@@ -1462,7 +1578,13 @@ void BOARD::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>
     int           viaCount = 0;
     int           trackSegmentCount = 0;
     std::set<int> netCodes;
-    int           unconnected = GetConnectivity()->GetUnconnectedCount( true );
+    wxString      unconnected;
+
+    // Don't wait for a ratsnest computed in the background; the panel is updated once it's done
+    if( GetConnectivity()->IsRatsnestPending() )
+        unconnected = wxS( "..." );
+    else
+        unconnected << GetConnectivity()->GetUnconnectedCount( true );
 
     for( PCB_TRACK* item : m_tracks )
     {
@@ -1490,7 +1612,7 @@ void BOARD::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>
     aList.emplace_back( _( "Vias" ), wxString::Format( wxT( "%d" ), viaCount ) );
     aList.emplace_back( _( "Track Segments" ), wxString::Format( wxT( "%d" ), trackSegmentCount ) );
     aList.emplace_back( _( "Nets" ), wxString::Format( wxT( "%d" ), (int) netCodes.size() ) );
-    aList.emplace_back( _( "Unrouted" ), wxString::Format( wxT( "%d" ), unconnected ) );
+    aList.emplace_back( _( "Unrouted" ), unconnected );
 }
 
 
@@ -2207,10 +2329,106 @@ bool BOARD::GetBoardPolygonOutlines( SHAPE_POLY_SET& aOutlines,
 {
     // max dist from one endPt to next startPt: use the current value
     int chainingEpsilon = GetOutlinesChainingEpsilon();
+    int maxError = GetDesignSettings().m_MaxError;
+
+    std::tuple<int, int, bool, bool> key( maxError, chainingEpsilon, aAllowUseArcsInPolygons,
+                                          aIncludeNPTHAsOutlines );
+    size_t               hash = outlinesHash( aIncludeNPTHAsOutlines );
+    OUTLINES_CACHE_ENTRY entry;
+
+    {
+        // Held while building, so that concurrent callers wait for one build instead of each
+        // running their own.
+        std::lock_guard<std::mutex> lock( m_outlinesCacheMutex );
+        auto                        it = m_outlinesCache.find( key );
+
+        // Items can be edited in place without telling the board, so the cached outlines are
+        // also checked against the shapes they were built from.
+        if( hash && it != m_outlinesCache.end() && it->second.m_hash == hash )
+        {
+            entry = it->second;
+        }
+        else
+        {
+            std::shared_ptr<SHAPE_POLY_SET> outlines = std::make_shared<SHAPE_POLY_SET>();
+
+            OUTLINE_ERROR_HANDLER recorder =
+                    [&]( const wxString& aMsg, BOARD_ITEM* aItemA, BOARD_ITEM* aItemB,
+                         const VECTOR2I& aPt )
+                    {
+                        entry.m_errors.emplace_back( aMsg, aItemA, aItemB, aPt );
+                    };
+
+            entry.m_success = buildPolygonOutlines( *outlines, &recorder, maxError,
+                                                    chainingEpsilon, aAllowUseArcsInPolygons,
+                                                    aIncludeNPTHAsOutlines );
+            entry.m_outlines = outlines;
+            entry.m_hash = hash;
+
+            if( hash )
+                m_outlinesCache[key] = entry;
+        }
+    }
+
+    if( aErrorHandler )
+    {
+        for( const auto& [msg, itemA, itemB, pt] : entry.m_errors )
+            ( *aErrorHandler )( msg, itemA, itemB, pt );
+    }
+
+    aOutlines = *entry.m_outlines;
+
+    return entry.m_success;
+}
+
+
+size_t BOARD::outlinesHash( bool aIncludeNPTHAsOutlines ) const
+{
+    // Much cheaper than chaining the shapes: hash what BuildBoardPolygonOutlines() reads.  Item
+    // pointers are included as the cached errors refer to the items.
+    size_t hash = 0;
+    bool   hasEdges = false;
+
+    auto hashEdges =
+            [&]( const BOARD_ITEM* aItem ) -> bool
+            {
+                if( aItem->Type() != PCB_SHAPE_T || aItem->GetLayer() != Edge_Cuts )
+                    return false;
+
+                hash_combine( hash, aItem, hash_fp_item( aItem, HASH_POS | HASH_LAYER ) );
+                hasEdges = true;
+                return true;
+            };
+
+    for( const BOARD_ITEM* item : m_drawings )
+        hashEdges( item );
+
+    for( const FOOTPRINT* fp : m_footprints )
+    {
+        bool fpHasEdges = false;
+
+        for( const BOARD_ITEM* item : fp->GraphicalItems() )
+            fpHasEdges |= hashEdges( item );
+
+        // Footprint edges make holes when the footprint has copper outside of them
+        for( const PAD* pad : fp->Pads() )
+        {
+            if( fpHasEdges || ( aIncludeNPTHAsOutlines && pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
+                hash_combine( hash, hash_fp_item( pad, HASH_POS | HASH_ROT | HASH_LAYER ) );
+        }
+    }
 
-    bool success = BuildBoardPolygonOutlines( this, aOutlines, GetDesignSettings().m_MaxError,
-                                              chainingEpsilon, aErrorHandler,
-                                              aAllowUseArcsInPolygons );
+    // Without any outline, the board falls back to the bounding box of all its items.
+    return hasEdges ? hash : 0;
+}
+
+
+bool BOARD::buildPolygonOutlines( SHAPE_POLY_SET& aOutlines, OUTLINE_ERROR_HANDLER* aErrorHandler,
+                                  int aMaxError, int aChainingEpsilon,
+                                  bool aAllowUseArcsInPolygons, bool aIncludeNPTHAsOutlines )
+{
+    bool success = BuildBoardPolygonOutlines( this, aOutlines, aMaxError, aChainingEpsilon,
+                                              aErrorHandler, aAllowUseArcsInPolygons );
 
     // Now add NPTH oval holes as holes in outlines if required
     if( aIncludeNPTHAsOutlines )
@@ -2223,7 +2441,7 @@ bool BOARD::GetBoardPolygonOutlines( SHAPE_POLY_SET& aOutlines,
                     continue;
 
                 SHAPE_POLY_SET hole;
-                pad->TransformHoleToPolygon( hole, 0, GetDesignSettings().m_MaxError, ERROR_INSIDE );
+                pad->TransformHoleToPolygon( hole, 0, aMaxError, ERROR_INSIDE );
 
                 // Add this pad hole to the main outline
                 // But we can have more than one main outline (i.e. more than one board), so
@@ -31,12 +31,17 @@
 #include <hash.h>
 #include <layer_ids.h>
 #include <netinfo.h>
+#include <area_test_cache.h>
+#include <pad_shape_cache.h>
+#include <plot_geometry_cache.h>
+#include <zone_knockout_cache.h>
 #include <pcb_item_containers.h>
 #include <pcb_plot_params.h>
 #include <title_block.h>
 #include <tools/pcb_selection.h>
 #include <mutex>
 #include <list>
+#include <tuple>
 
 class BOARD_DESIGN_SETTINGS;
 class BOARD_CONNECTED_ITEM;
@@ -401,6 +406,14 @@ public:
      */
     void FinalizeBulkRemove( std::vector<BOARD_ITEM*>& aRemovedItems );
 
+    /**
+     * Remove several items at once and notify the listeners with a single bulk event.
+     *
+     * Tracks are taken out of the track list in one pass, which avoids the quadratic cost of
+     * removing them one by one from large boards.
+     */
+    void RemoveItems( const std::vector<BOARD_ITEM*>& aItems );
+
     void CacheTriangulation( PROGRESS_REPORTER* aReporter = nullptr,
                              const std::vector<ZONE*>& aZones = {} );
 
@@ -426,6 +439,17 @@ public:
      */
     BOARD_ITEM* GetItem( const KIID& aID ) const;
 
+    /**
+     * Add \a aItem, and the children of a footprint, to the index behind GetItem().  Items are
+     * indexed when they are added to the board or to one of its footprints.
+     */
+    void CacheItemById( BOARD_ITEM* aItem ) const;
+
+    /**
+     * Remove \a aItem, and the children of a footprint, from the index behind GetItem().
+     */
+    void UncacheItemById( BOARD_ITEM* aItem ) const;
+
     void FillItemMap( std::map<KIID, EDA_ITEM*>& aMap );
 
     /**
@@ -688,6 +712,9 @@ public:
      * in board outlines. These holes can be seen like holes created by closed shapes
      * drawn on edge cut layer inside the board main outline.
      * @return true if success, false if a contour is not valid
+     *
+     * The outlines are cached, and only rebuilt when the shapes they are built from changed.
+     * Errors met building them are reported again to each caller.
      */
     bool GetBoardPolygonOutlines( SHAPE_POLY_SET& aOutlines,
                                   OUTLINE_ERROR_HANDLER* aErrorHandler = nullptr,
@@ -1232,15 +1259,14 @@ public:
 
     // ------------ Run-time caches -------------
     std::mutex                                            m_CachesMutex;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsFCourtyardCache;
-    std::unordered_map<PTR_PTR_CACHE_KEY, bool>           m_IntersectsBCourtyardCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_IntersectsAreaCache;
-    std::unordered_map<PTR_PTR_LAYER_CACHE_KEY, bool>     m_EnclosedByAreaCache;
+    AREA_TEST_CACHE                                       m_AreaTestCache;
     std::unordered_map< wxString, LSET >                  m_LayerExpressionCache;
-    std::unordered_map<ZONE*, std::unique_ptr<DRC_RTREE>> m_CopperZoneRTreeCache;
+    std::unordered_map<ZONE*, std::shared_ptr<DRC_RTREE>> m_CopperZoneRTreeCache;
     std::shared_ptr<DRC_RTREE>                            m_CopperItemRTreeCache;
     mutable std::unordered_map<const ZONE*, BOX2I>        m_ZoneBBoxCache;
+    mutable PAD_SHAPE_CACHE                               m_PadShapeCache;
+    mutable PLOT_GEOMETRY_CACHE                           m_PlotGeometryCache;
+    ZONE_KNOCKOUT_CACHE                                   m_ZoneKnockoutCache;
 
     // ------------ DRC caches -------------
     std::vector<ZONE*>    m_DRCZones;
@@ -1264,12 +1290,52 @@ private:
             ( l->*aFunc )( std::forward<Args>( args )... );
     }
 
+    /**
+     * Finish the removal of an item which has already been taken out of its container: flag it,
+     * drop it from the item cache, its group and the connectivity.
+     */
+    void detachRemovedItem( BOARD_ITEM* aBoardItem );
+
+    /**
+     * Drop the outlines cached by GetBoardPolygonOutlines().
+     */
+    void invalidateOutlinesCache();
+
+    /**
+     * @return a hash of the items the board outlines are built from, or 0 if the outlines
+     *         depend on the whole board and can't be cached.
+     */
+    size_t outlinesHash( bool aIncludeNPTHAsOutlines ) const;
+
+    /**
+     * Build the board outlines as described in GetBoardPolygonOutlines(), without caching.
+     */
+    bool buildPolygonOutlines( SHAPE_POLY_SET& aOutlines, OUTLINE_ERROR_HANDLER* aErrorHandler,
+                               int aMaxError, int aChainingEpsilon, bool aAllowUseArcsInPolygons,
+                               bool aIncludeNPTHAsOutlines );
+
     friend class PCB_EDIT_FRAME;
 
 
     /// the max distance between 2 end point to see them connected when building the board outlines
     int m_outlinesChainingEpsilon;
 
+    /**
+     * A board outline built by GetBoardPolygonOutlines(), with the errors reported while building
+     * it so they can be replayed to later callers.
+     */
+    struct OUTLINES_CACHE_ENTRY
+    {
+        bool                                  m_success;
+        size_t                                m_hash;       ///< outlinesHash() when built
+        std::shared_ptr<const SHAPE_POLY_SET> m_outlines;
+        std::vector<std::tuple<wxString, BOARD_ITEM*, BOARD_ITEM*, VECTOR2I>> m_errors;
+    };
+
+    /// Outlines keyed by max error, chaining epsilon, arcs allowed and NPTH holes included.
+    std::map<std::tuple<int, int, bool, bool>, OUTLINES_CACHE_ENTRY> m_outlinesCache;
+    std::mutex                                                         m_outlinesCacheMutex;
+
     /// What is this board being used for
     BOARD_USE           m_boardUse;
     int                 m_timeStamp;                // actually a modification counter
@@ -1283,6 +1349,9 @@ private:
     ZONES               m_zones;
     GENERATORS          m_generators;
 
+    // Items of the board by KIID, kept up to date as items are added and removed
+    mutable std::unordered_map<KIID, BOARD_ITEM*> m_itemByIdCache;
+
     LAYER               m_layers[PCB_LAYER_ID_COUNT];
 
     HIGH_LIGHT_INFO     m_highLight;                // current high light data
@@ -23,6 +23,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <advanced_config.h>
 #include <macros.h>
 #include <board.h>
 #include <footprint.h>
@@ -133,8 +134,9 @@ void BOARD_COMMIT::dirtyIntersectingZones( BOARD_ITEM* item, int aChangeType )
     BOARD* board = static_cast<BOARD*>( m_toolMgr->GetModel() );
     BOX2I  bbox = item->GetBoundingBox();
     LSET   layers = item->GetLayerSet();
+    bool   boardEdge = layers.test( Edge_Cuts ) || layers.test( Margin );
 
-    if( layers.test( Edge_Cuts ) || layers.test( Margin ) )
+    if( boardEdge )
         layers = LSET::PhysicalLayersMask();
     else
         layers &= LSET::AllCuMask();
@@ -149,7 +151,12 @@ void BOARD_COMMIT::dirtyIntersectingZones( BOARD_ITEM* item, int aChangeType )
             if( ( zone->GetLayerSet() & layers ).any()
                     && zone->GetBoundingBox().Intersects( bbox ) )
             {
-                zoneFillerTool->DirtyZone( zone );
+                // Board edges change the outline all fills are clipped to; other items only
+                // change fills around themselves (a changed zone itself is dirtied above)
+                if( boardEdge )
+                    zoneFillerTool->DirtyZone( zone );
+                else
+                    zoneFillerTool->DirtyZoneArea( zone, bbox );
             }
         }
     }
@@ -189,6 +196,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     std::vector<BOARD_ITEM*> bulkRemovedItems;
     std::vector<BOARD_ITEM*> itemsChanged;
 
+    // Removed from the view together once all the changes are applied
+    std::vector<KIGFX::VIEW_ITEM*> viewRemovedItems;
+
     if( m_isBoardEditor
             && !( aCommitFlags & ZONE_FILL_OP )
             && ( frame && frame->GetPcbNewSettings()->m_AutoRefillZones ) )
@@ -250,6 +260,20 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
     if( !staleTeardropPadsAndVias.empty() || !staleTeardropTracks.empty() )
         teardropMgr.RemoveTeardrops( *this, &staleTeardropPadsAndVias, &staleTeardropTracks );
 
+    // Drop the area test results of the changed items while they're all still alive; the
+    // other items keep theirs for the next DRC run
+    {
+        std::vector<BOARD_ITEM*> changedItems;
+
+        for( COMMIT_LINE& ent : m_changes )
+        {
+            if( BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( ent.m_item ) )
+                changedItems.push_back( boardItem );
+        }
+
+        board->m_AreaTestCache.Invalidate( changedItems );
+    }
+
     for( COMMIT_LINE& ent : m_changes )
     {
         int changeType = ent.m_type & CHT_TYPE;
@@ -351,8 +375,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             case PCB_MARKER_T:           // a marker used to show something
             case PCB_ZONE_T:
             case PCB_FOOTPRINT_T:
-                if( view )
-                    view->Remove( boardItem );
+                viewRemovedItems.push_back( boardItem );
 
                 if( !( changeFlags & CHT_DONE ) )
                 {
@@ -370,8 +393,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 break;
 
             case PCB_GROUP_T:
-                if( view )
-                    view->Remove( boardItem );
+                viewRemovedItems.push_back( boardItem );
 
                 if( !( changeFlags & CHT_DONE ) )
                 {
@@ -482,6 +504,11 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 } );
     }
 
+    if( view && !viewRemovedItems.empty() )
+        view->RemoveItems( viewRemovedItems );
+
+    viewRemovedItems.clear();
+
     if( bulkAddedItems.size() > 0 )
         board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -500,6 +527,34 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
             connectivity->ClearRatsnest();
             connectivity->ClearLocalRatsnest();
         }
+        else if( frame && ADVANCED_CFG::GetCfg().m_AsyncRatsnestMinChanges > 0
+                 && num_changes >= (size_t) ADVANCED_CFG::GetCfg().m_AsyncRatsnestMinChanges )
+        {
+            std::weak_ptr<CONNECTIVITY_DATA> weakConnectivity = connectivity;
+
+            // Large commits get their ratsnest lines computed in the background; the canvas
+            // catches up once they are ready.  The anchors are read by the computation, so
+            // the local ratsnest flags have to be cleared first.
+            connectivity->ClearLocalRatsnest();
+            connectivity->RecalculateRatsnestAsync( this,
+                    [frame, weakConnectivity]()
+                    {
+                        frame->CallAfter(
+                                [frame, weakConnectivity]()
+                                {
+                                    BOARD* brd = frame->GetBoard();
+
+                                    // The board may have been reloaded in the meantime
+                                    if( !brd || brd->GetConnectivity() != weakConnectivity.lock() )
+                                        return;
+
+                                    brd->UpdateRatsnestExclusions();
+                                    frame->GetCanvas()->RedrawRatsnest();
+                                    brd->OnRatsnestChanged();
+                                    frame->UpdateMsgPanel();
+                                } );
+                    } );
+        }
         else
         {
             connectivity->RecalculateRatsnest( this );
@@ -546,11 +601,14 @@ void BOARD_COMMIT::Push( const wxString& aMessage, int aCommitFlags )
                 if( ( ent.m_type & CHT_TYPE ) == CHT_ADD )
                     view->Add( boardItem );
                 else if( ( ent.m_type & CHT_TYPE ) == CHT_REMOVE )
-                    view->Remove( boardItem );
+                    viewRemovedItems.push_back( boardItem );
                 else
                     view->Update( boardItem );
             }
         }
+
+        if( view && !viewRemovedItems.empty() )
+            view->RemoveItems( viewRemovedItems );
     }
 
     if( frame )
@@ -620,10 +678,12 @@ void BOARD_COMMIT::Revert()
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = board->GetConnectivity();
 
     board->IncrementTimeStamp();   // clear caches
+    board->m_AreaTestCache.Clear();
 
-    std::vector<BOARD_ITEM*> bulkAddedItems;
-    std::vector<BOARD_ITEM*> bulkRemovedItems;
-    std::vector<BOARD_ITEM*> itemsChanged;
+    std::vector<BOARD_ITEM*>       bulkAddedItems;
+    std::vector<BOARD_ITEM*>       bulkRemovedItems;
+    std::vector<BOARD_ITEM*>       itemsChanged;
+    std::vector<KIGFX::VIEW_ITEM*> viewRemovedItems;
 
     for( auto it = m_changes.rbegin(); it != m_changes.rend(); ++it )
     {
@@ -648,7 +708,7 @@ void BOARD_COMMIT::Revert()
             if( !( changeFlags & CHT_DONE ) )
                 break;
 
-            view->Remove( boardItem );
+            viewRemovedItems.push_back( boardItem );
             connectivity->Remove( boardItem );
 
             if( FOOTPRINT* parentFP = boardItem->GetParentFootprint() )
@@ -676,7 +736,7 @@ void BOARD_COMMIT::Revert()
             }
             else
             {
-                board->Add( boardItem, ADD_MODE::INSERT );
+                board->Add( boardItem, ADD_MODE::BULK_INSERT );
                 bulkAddedItems.push_back( boardItem );
             }
 
@@ -716,6 +776,9 @@ void BOARD_COMMIT::Revert()
         boardItem->ClearEditFlags();
     }
 
+    if( !viewRemovedItems.empty() )
+        view->RemoveItems( viewRemovedItems );
+
     if( bulkAddedItems.size() > 0 )
         board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -182,11 +182,22 @@ void BOARD_ITEM::SwapItemData( BOARD_ITEM* aImage )
 
     SetParentGroup( nullptr );
     aImage->SetParentGroup( nullptr );
+
+    // The image's children (and ID, potentially) take the place of ours on the board
+    const BOARD* board = GetBoard();
+    bool         indexed = board && board->GetItem( m_Uuid ) == this;
+
+    if( indexed )
+        board->UncacheItemById( this );
+
     swapData( aImage );
 
     // Restore pointers to be sure they are not broken
     SetParent( parent );
     SetParentGroup( group );
+
+    if( indexed )
+        board->CacheItemById( this );
 }
 
 
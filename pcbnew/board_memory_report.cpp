@@ -0,0 +1,239 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <board.h>
+#include <footprint.h>
+#include <memory_report.h>
+#include <netinfo.h>
+#include <pad.h>
+#include <pcb_field.h>
+#include <pcb_shape.h>
+#include <pcb_text.h>
+#include <pcb_textbox.h>
+#include <pcb_track.h>
+#include <undo_redo_container.h>
+#include <zone.h>
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/connectivity_data.h>
+#include <drc/drc_rtree.h>
+
+#include "board_memory_report.h"
+
+
+static size_t textMemory( const EDA_TEXT* aText )
+{
+    return aText->GetText().length() * sizeof( wxChar );
+}
+
+
+/**
+ * Estimated size of a single item, not including its children.
+ */
+static size_t itemMemory( const BOARD_ITEM* aItem )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_TRACE_T:
+        return sizeof( PCB_TRACK );
+
+    case PCB_ARC_T:
+        return sizeof( PCB_ARC );
+
+    case PCB_VIA_T:
+        return sizeof( PCB_VIA );
+
+    case PCB_PAD_T:
+        return sizeof( PAD );
+
+    case PCB_SHAPE_T:
+    {
+        const PCB_SHAPE* shape = static_cast<const PCB_SHAPE*>( aItem );
+        return sizeof( PCB_SHAPE ) + shape->GetPolyShape().GetOutlineMemoryUsage();
+    }
+
+    case PCB_FIELD_T:
+        return sizeof( PCB_FIELD ) + textMemory( static_cast<const PCB_FIELD*>( aItem ) );
+
+    case PCB_TEXT_T:
+        return sizeof( PCB_TEXT ) + textMemory( static_cast<const PCB_TEXT*>( aItem ) );
+
+    case PCB_TEXTBOX_T:
+        return sizeof( PCB_TEXTBOX ) + textMemory( static_cast<const PCB_TEXTBOX*>( aItem ) );
+
+    case PCB_FOOTPRINT_T:
+        return sizeof( FOOTPRINT );
+
+    case PCB_ZONE_T:
+        return sizeof( ZONE ) + static_cast<const ZONE*>( aItem )->Outline()->GetOutlineMemoryUsage();
+
+    default:
+        return sizeof( BOARD_ITEM );
+    }
+}
+
+
+/**
+ * Estimated size of an item and all of its children.
+ */
+static size_t itemTreeMemory( const BOARD_ITEM* aItem )
+{
+    size_t bytes = itemMemory( aItem );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        const FOOTPRINT* fp = static_cast<const FOOTPRINT*>( aItem );
+
+        for( const PAD* pad : fp->Pads() )
+            bytes += itemMemory( pad );
+
+        for( const BOARD_ITEM* item : fp->GraphicalItems() )
+            bytes += itemMemory( item );
+
+        for( const PCB_FIELD* field : fp->Fields() )
+            bytes += itemMemory( field );
+
+        for( const ZONE* zone : fp->Zones() )
+            bytes += itemMemory( zone );
+    }
+
+    return bytes;
+}
+
+
+static void reportZone( const ZONE* aZone, MEMORY_REPORT& aReport )
+{
+    aReport.Add( wxT( "Zones" ), 1, itemMemory( aZone ) );
+
+    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+    {
+        const std::shared_ptr<SHAPE_POLY_SET>& fill = aZone->GetFilledPolysList( layer );
+
+        if( !fill )
+            continue;
+
+        aReport.Add( wxT( "Zone fills" ), 1, fill->GetOutlineMemoryUsage() );
+        aReport.Add( wxT( "Zone fill triangulations" ), fill->TriangulatedPolyCount(),
+                     fill->GetTriangulationMemoryUsage() );
+    }
+}
+
+
+void ReportBoardMemory( const BOARD* aBoard, MEMORY_REPORT& aReport )
+{
+    for( const PCB_TRACK* track : aBoard->Tracks() )
+    {
+        switch( track->Type() )
+        {
+        case PCB_ARC_T: aReport.Add( wxT( "Arcs" ), 1, itemMemory( track ) );   break;
+        case PCB_VIA_T: aReport.Add( wxT( "Vias" ), 1, itemMemory( track ) );   break;
+        default:        aReport.Add( wxT( "Tracks" ), 1, itemMemory( track ) ); break;
+        }
+    }
+
+    for( const FOOTPRINT* fp : aBoard->Footprints() )
+    {
+        aReport.Add( wxT( "Footprints" ), 1, itemMemory( fp ) );
+
+        for( const PAD* pad : fp->Pads() )
+            aReport.Add( wxT( "Pads" ), 1, itemMemory( pad ) );
+
+        for( const BOARD_ITEM* item : fp->GraphicalItems() )
+            aReport.Add( wxT( "Footprint graphics" ), 1, itemMemory( item ) );
+
+        for( const PCB_FIELD* field : fp->Fields() )
+            aReport.Add( wxT( "Footprint fields" ), 1, itemMemory( field ) );
+
+        for( const ZONE* zone : fp->Zones() )
+            reportZone( zone, aReport );
+    }
+
+    for( const BOARD_ITEM* item : aBoard->Drawings() )
+        aReport.Add( wxT( "Board graphics" ), 1, itemMemory( item ) );
+
+    for( const ZONE* zone : aBoard->Zones() )
+        reportZone( zone, aReport );
+
+    for( const NETINFO_ITEM* net : aBoard->GetNetInfo() )
+    {
+        aReport.Add( wxT( "Nets" ), 1, sizeof( NETINFO_ITEM )
+                                           + 3 * net->GetNetname().length() * sizeof( wxChar ) );
+    }
+
+    if( std::shared_ptr<CONNECTIVITY_DATA> connectivity = aBoard->GetConnectivity() )
+    {
+        if( std::shared_ptr<CN_CONNECTIVITY_ALGO> algo = connectivity->GetConnectivityAlgo() )
+        {
+            const CN_LIST& items = algo->ItemList();
+            aReport.Add( wxT( "Connectivity items and index" ), items.Size(),
+                         items.GetMemoryUsage() );
+        }
+    }
+
+    if( aBoard->m_CopperItemRTreeCache )
+    {
+        aReport.Add( wxT( "DRC R-trees" ), aBoard->m_CopperItemRTreeCache->size(),
+                     aBoard->m_CopperItemRTreeCache->GetMemoryUsage() );
+    }
+
+    for( const auto& [zone, rtree] : aBoard->m_CopperZoneRTreeCache )
+    {
+        if( rtree )
+            aReport.Add( wxT( "DRC R-trees" ), rtree->size(), rtree->GetMemoryUsage() );
+    }
+
+    // Kept by the zones for the next DRC; only count the ones DRC isn't using yet
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        std::shared_ptr<DRC_RTREE> rtree = zone->GetFillRTree();
+        auto                       it = aBoard->m_CopperZoneRTreeCache.find( zone );
+
+        if( rtree && ( it == aBoard->m_CopperZoneRTreeCache.end() || it->second != rtree ) )
+            aReport.Add( wxT( "Zone fill R-trees" ), rtree->size(), rtree->GetMemoryUsage() );
+    }
+
+    aReport.Add( wxT( "Pad shape cache" ), aBoard->m_PadShapeCache.GetEntryCount(),
+                 aBoard->m_PadShapeCache.GetMemoryUsage() );
+
+    aReport.Add( wxT( "Zone knockout cache" ), aBoard->m_ZoneKnockoutCache.GetEntryCount(),
+                 aBoard->m_ZoneKnockoutCache.GetMemoryUsage() );
+
+    aReport.Add( wxT( "Plot geometry cache" ), aBoard->m_PlotGeometryCache.GetEntryCount(),
+                 aBoard->m_PlotGeometryCache.GetMemoryUsage() );
+}
+
+
+void ReportUndoMemory( const UNDO_REDO_CONTAINER& aList, const wxString& aCategory,
+                       MEMORY_REPORT& aReport )
+{
+    for( const PICKED_ITEMS_LIST* command : aList.m_CommandsList )
+    {
+        for( unsigned ii = 0; ii < command->GetCount(); ++ii )
+        {
+            // The undo list owns the copies (links) for modified items and the items themselves
+            // for deleted ones
+            const EDA_ITEM* item = command->GetPickedItemLink( ii );
+
+            if( !item && command->GetPickedItemStatus( ii ) == UNDO_REDO::DELETED )
+                item = command->GetPickedItem( ii );
+
+            if( const BOARD_ITEM* boardItem = dynamic_cast<const BOARD_ITEM*>( item ) )
+                aReport.Add( aCategory, 1, itemTreeMemory( boardItem ) );
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BOARD_MEMORY_REPORT_H
+#define BOARD_MEMORY_REPORT_H
+
+class BOARD;
+class MEMORY_REPORT;
+class UNDO_REDO_CONTAINER;
+class wxString;
+
+
+/**
+ * Add the memory held by \a aBoard to \a aReport: board items by type, zone fills and their
+ * triangulations, the net list, the connectivity items and index, the DRC R-tree caches and
+ * the pad shape cache.
+ */
+void ReportBoardMemory( const BOARD* aBoard, MEMORY_REPORT& aReport );
+
+/**
+ * Add the memory held by the item copies in an undo or redo list to \a aReport.
+ */
+void ReportUndoMemory( const UNDO_REDO_CONTAINER& aList, const wxString& aCategory,
+                       MEMORY_REPORT& aReport );
+
+#endif // BOARD_MEMORY_REPORT_H
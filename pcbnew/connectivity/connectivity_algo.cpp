@@ -34,6 +34,7 @@
 #include <geometry/geometry_utils.h>
 #include <board_commit.h>
 #include <core/thread_pool.h>
+#include <core/trace_profiler.h>
 #include <pcb_shape.h>
 
 #include <wx/log.h>
@@ -47,11 +48,29 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
 {
     markItemNetAsDirty( aItem );
 
+    // Removing an item may split its clusters, and the items it was connected to may then
+    // have to take another net.  Dirty their nets so that the next propagation visits them.
+    auto markNeighbourNetsAsDirty =
+            [&]( const BOARD_ITEM* aParent )
+            {
+                auto it = m_itemMap.find( aParent );
+
+                if( it == m_itemMap.end() )
+                    return;
+
+                for( CN_ITEM* item : it->second.GetItems() )
+                {
+                    for( CN_ITEM* connected : item->ConnectedItems() )
+                        MarkNetAsDirty( connected->Net() );
+                }
+            };
+
     switch( aItem->Type() )
     {
     case PCB_FOOTPRINT_T:
         for( PAD* pad : static_cast<FOOTPRINT*>( aItem )->Pads() )
         {
+            markNeighbourNetsAsDirty( pad );
             m_itemMap[pad].MarkItemsAsInvalid();
             m_itemMap.erase( pad );
         }
@@ -65,6 +84,7 @@ bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
     case PCB_VIA_T:
     case PCB_ZONE_T:
     case PCB_SHAPE_T:
+        markNeighbourNetsAsDirty( aItem );
         m_itemMap[aItem].MarkItemsAsInvalid();
         m_itemMap.erase ( aItem );
         m_itemList.SetDirty( true );
@@ -309,21 +329,22 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
 }
 
 
-const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode )
+const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
+                                                                         bool aDirtyNetsOnly )
 {
     if( aMode == CSM_PROPAGATE )
     {
         return SearchClusters( aMode,
                                { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T, PCB_VIA_T, PCB_FOOTPRINT_T,
                                  PCB_SHAPE_T },
-                               -1 );
+                               -1, nullptr, aDirtyNetsOnly );
     }
     else
     {
         return SearchClusters( aMode,
                                { PCB_TRACE_T, PCB_ARC_T, PCB_PAD_T, PCB_VIA_T, PCB_ZONE_T,
                                  PCB_FOOTPRINT_T, PCB_SHAPE_T },
-                               -1 );
+                               -1, nullptr, aDirtyNetsOnly );
     }
 }
 
@@ -331,20 +352,23 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 const CN_CONNECTIVITY_ALGO::CLUSTERS
 CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                       const std::initializer_list<KICAD_T>& aTypes,
-                                      int aSingleNet, CN_ITEM* rootItem )
+                                      int aSingleNet, CN_ITEM* rootItem, bool aDirtyNetsOnly )
 {
     bool withinAnyNet = ( aMode != CSM_PROPAGATE );
 
-    std::deque<CN_ITEM*> Q;
-    std::set<CN_ITEM*> item_set;
+    std::deque<CN_ITEM*>  Q;
+    std::vector<CN_ITEM*> roots;
 
     CLUSTERS clusters;
 
     if( m_itemList.IsDirty() )
         searchConnections();
 
+    // Every item which may be part of a cluster is reset, but only the items of dirty nets
+    // start a cluster when aDirtyNetsOnly is set.  The other items of their clusters are
+    // reached through the connections.
     auto addToSearchList =
-            [&item_set, withinAnyNet, aSingleNet, &aTypes, rootItem ]( CN_ITEM *aItem )
+            [&]( CN_ITEM *aItem )
             {
                 if( withinAnyNet && aItem->Net() <= 0 )
                     return;
@@ -371,7 +395,8 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
 
                 aItem->SetVisited( false );
 
-                item_set.insert( aItem );
+                if( !aDirtyNetsOnly || IsNetDirty( aItem->Net() ) )
+                    roots.push_back( aItem );
             };
 
     std::for_each( m_itemList.begin(), m_itemList.end(), addToSearchList );
@@ -379,19 +404,13 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return CLUSTERS();
 
-    while( !item_set.empty() )
+    for( CN_ITEM* root : roots )
     {
-        std::shared_ptr<CN_CLUSTER> cluster = std::make_shared<CN_CLUSTER>();
-        CN_ITEM*                    root;
-        auto                        it = item_set.begin();
-
-        while( it != item_set.end() && (*it)->Visited() )
-            it = item_set.erase( item_set.begin() );
+        if( root->Visited() )
+            continue;
 
-        if( it == item_set.end() )
-            break;
+        std::shared_ptr<CN_CLUSTER> cluster = std::make_shared<CN_CLUSTER>();
 
-        root = *it;
         root->SetVisited( true );
 
         Q.clear();
@@ -435,6 +454,8 @@ CN_CONNECTIVITY_ALGO::SearchClusters( CLUSTER_SEARCH_MODE aMode,
 
 void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
+    TRACE_SCOPE( "Connectivity build" );
+
     // Generate CN_ZONE_LAYERs for each island on each layer of each zone
     //
     std::vector<CN_ZONE_LAYER*> zitems;
@@ -520,29 +541,27 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     }
 
-    // Add CN_ZONE_LAYERS, tracks, and pads to connectivity
+    // Create the items of tracks, pads and copper shapes (in parallel)
     //
-    int ii = zitems.size();
+    std::vector<BOARD_CONNECTED_ITEM*> sources;
 
-    for( CN_ZONE_LAYER* zitem : zitems )
-    {
-        m_itemList.Add( zitem );
-        m_itemMap[ zitem->Parent() ].Link( zitem );
-        report( ++ii );
-    }
+    sources.reserve( aBoard->Tracks().size() );
 
     for( PCB_TRACK* tv : aBoard->Tracks() )
     {
-        Add( tv );
-        report( ++ii );
+        if( tv->IsOnCopperLayer() )
+            sources.push_back( tv );
     }
 
     for( FOOTPRINT* footprint : aBoard->Footprints() )
     {
+        if( footprint->GetAttributes() & FP_JUST_ADDED )
+            continue;
+
         for( PAD* pad : footprint->Pads() )
         {
-            Add( pad );
-            report( ++ii );
+            if( pad->IsOnCopperLayer() )
+                sources.push_back( pad );
         }
     }
 
@@ -550,13 +569,110 @@ void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
     {
         if( PCB_SHAPE* shape = dynamic_cast<PCB_SHAPE*>( drawing ) )
         {
-            if( shape->IsOnCopperLayer() )
-                Add( shape );
+            if( shape->IsOnCopperLayer() && IsCopperLayer( shape->GetLayer() ) )
+                sources.push_back( shape );
         }
+    }
+
+    std::vector<CN_ITEM*> items( sources.size(), nullptr );
+
+    auto create_items =
+            [&]( const int a, const int b )
+            {
+                for( int jj = a; jj < b; ++jj )
+                {
+                    if( aReporter && aReporter->IsCancelled() )
+                        return;
+
+                    BOARD_CONNECTED_ITEM* source = sources[jj];
+                    CN_ITEM*              item = nullptr;
+
+                    switch( source->Type() )
+                    {
+                    case PCB_TRACE_T:
+                        item = CN_LIST::CreateItem( static_cast<PCB_TRACK*>( source ) );
+                        break;
+
+                    case PCB_ARC_T:
+                        item = CN_LIST::CreateItem( static_cast<PCB_ARC*>( source ) );
+                        break;
+
+                    case PCB_VIA_T:
+                        item = CN_LIST::CreateItem( static_cast<PCB_VIA*>( source ) );
+                        break;
+
+                    case PCB_PAD_T:
+                        item = CN_LIST::CreateItem( static_cast<PAD*>( source ) );
+                        break;
+
+                    case PCB_SHAPE_T:
+                        item = CN_LIST::CreateItem( static_cast<PCB_SHAPE*>( source ) );
+                        break;
+
+                    default:
+                        break;
+                    }
+
+                    // Bounding boxes (pad shapes in particular) are the costly part, so get
+                    // them here rather than when inserting in the index
+                    if( item )
+                        item->BBox();
+
+                    items[jj] = item;
+                }
+            };
+
+    auto create_returns = tp.parallelize_loop( 0, sources.size(), create_items,
+                                               GetThreadBudget( THREAD_SUBSYSTEM::CONNECTIVITY ) );
+
+    for( size_t jj = 0; jj < create_returns.size(); ++jj )
+    {
+        std::future<void>& ret = create_returns[jj];
 
+        if( ret.valid() )
+        {
+            std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+            while( status != std::future_status::ready )
+            {
+                if( aReporter )
+                    aReporter->KeepRefreshing();
+
+                status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+            }
+        }
+    }
+
+    // Add CN_ZONE_LAYERS, tracks, and pads to connectivity.  The index is filled in one go
+    // once the item map is set up.
+    //
+    int ii = zitems.size();
+
+    std::vector<CN_ITEM*> allItems( zitems.begin(), zitems.end() );
+
+    allItems.reserve( zitems.size() + items.size() );
+    m_itemMap.reserve( m_itemMap.size() + items.size() );
+
+    for( CN_ZONE_LAYER* zitem : zitems )
+    {
+        m_itemMap[ zitem->Parent() ].Link( zitem );
         report( ++ii );
     }
 
+    for( size_t jj = 0; jj < sources.size(); ++jj )
+    {
+        if( items[jj] )
+        {
+            m_itemMap[ sources[jj] ] = ITEM_MAP_ENTRY( items[jj] );
+            markItemNetAsDirty( sources[jj] );
+            allItems.push_back( items[jj] );
+        }
+
+        report( ++ii );
+    }
+
+    m_itemList.AddItems( allItems );
+
     if( aReporter )
     {
         aReporter->SetCurrentProgress( (double) ii / (double) size );
@@ -646,9 +762,9 @@ void CN_CONNECTIVITY_ALGO::propagateConnections( BOARD_COMMIT* aCommit )
 }
 
 
-void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit )
+void CN_CONNECTIVITY_ALGO::PropagateNets( BOARD_COMMIT* aCommit, bool aDirtyNetsOnly )
 {
-    m_connClusters = SearchClusters( CSM_PROPAGATE );
+    m_connClusters = SearchClusters( CSM_PROPAGATE, aDirtyNetsOnly );
     propagateConnections( aCommit );
 }
 
@@ -683,28 +799,33 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap(
 
     m_connClusters = SearchClusters( CSM_CONNECTIVITY_CHECK );
 
-    for( auto& [ zone, zoneIslands ] : aMap )
+    // Sort the zone items of all the clusters in a single pass, rather than looking through
+    // every cluster for each zone layer
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
     {
-        for( auto& [ layer, layerIslands ] : zoneIslands )
+        for( CN_ITEM* item : *cluster )
         {
-            if( zone->GetFilledPolysList( layer )->IsEmpty() )
+            if( item->Parent()->Type() != PCB_ZONE_T )
                 continue;
 
-            for( const std::shared_ptr<CN_CLUSTER>& cluster : m_connClusters )
-            {
-                for( CN_ITEM* item : *cluster )
-                {
-                    if( item->Parent() == zone && item->Layer() == layer )
-                    {
-                        CN_ZONE_LAYER* z = static_cast<CN_ZONE_LAYER*>( item );
+            ZONE* zone = static_cast<ZONE*>( item->Parent() );
+            auto  zoneIt = aMap.find( zone );
 
-                        if( cluster->IsOrphaned() )
-                            layerIslands.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
-                        else if( z->HasSingleConnection() )
-                            layerIslands.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
-                    }
-                }
-            }
+            if( zoneIt == aMap.end() )
+                continue;
+
+            auto layerIt = zoneIt->second.find( item->Layer() );
+
+            if( layerIt == zoneIt->second.end() )
+                continue;
+
+            CN_ZONE_LAYER*    z = static_cast<CN_ZONE_LAYER*>( item );
+            ISOLATED_ISLANDS& layerIslands = layerIt->second;
+
+            if( cluster->IsOrphaned() )
+                layerIslands.m_IsolatedOutlines.push_back( z->SubpolyIndex() );
+            else if( z->HasSingleConnection() )
+                layerIslands.m_SingleConnectionOutlines.push_back( z->SubpolyIndex() );
         }
     }
 }
@@ -712,7 +833,23 @@ void CN_CONNECTIVITY_ALGO::FillIsolatedIslandsMap(
 
 const CN_CONNECTIVITY_ALGO::CLUSTERS& CN_CONNECTIVITY_ALGO::GetClusters()
 {
-    m_ratsnestClusters = SearchClusters( CSM_RATSNEST );
+    // Ratsnest clusters never span nets, and every change to an item dirties its net, so the
+    // clusters of clean nets are still valid.
+    CLUSTERS clusters = SearchClusters( CSM_RATSNEST, true );
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : m_ratsnestClusters )
+    {
+        if( !IsNetDirty( cluster->OriginNet() ) )
+            clusters.push_back( cluster );
+    }
+
+    std::sort( clusters.begin(), clusters.end(),
+               []( const std::shared_ptr<CN_CLUSTER>& a, const std::shared_ptr<CN_CLUSTER>& b )
+               {
+                   return a->OriginNet() < b->OriginNet();
+               } );
+
+    m_ratsnestClusters = std::move( clusters );
     return m_ratsnestClusters;
 }
 
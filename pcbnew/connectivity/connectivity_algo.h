@@ -189,7 +189,7 @@ public:
 
     bool IsNetDirty( int aNet ) const
     {
-        if( aNet < 0 )
+        if( aNet < 0 || aNet >= (int) m_dirtyNets.size() )
             return false;
 
         return m_dirtyNets[ aNet ];
@@ -226,16 +226,24 @@ public:
     bool Remove( BOARD_ITEM* aItem );
     bool Add( BOARD_ITEM* aItem );
 
+    /**
+     * Search the clusters of connected items.
+     *
+     * @param aDirtyNetsOnly only search the clusters which hold an item of a dirty net.
+     */
     const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode,
                                    const std::initializer_list<KICAD_T>& aTypes,
-                                   int aSingleNet, CN_ITEM* rootItem = nullptr );
-    const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode );
+                                   int aSingleNet, CN_ITEM* rootItem = nullptr,
+                                   bool aDirtyNetsOnly = false );
+    const CLUSTERS SearchClusters( CLUSTER_SEARCH_MODE aMode, bool aDirtyNetsOnly = false );
 
     /**
      * Propagate nets from pads to other items in clusters.
      * @param aCommit is used to store undo information for items modified by the call.
+     * @param aDirtyNetsOnly only propagate within the clusters which hold an item of a dirty
+     *                       net.  The others can't have changed since the last propagation.
      */
-    void PropagateNets( BOARD_COMMIT* aCommit = nullptr );
+    void PropagateNets( BOARD_COMMIT* aCommit = nullptr, bool aDirtyNetsOnly = false );
 
     /**
      * Fill in the isolated islands map with copper islands that are not connected to a net.
@@ -243,6 +251,10 @@ public:
     void FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>>& aMap,
                                  bool aConnectivityAlreadyRebuilt );
 
+    /**
+     * @return the ratsnest clusters of all nets.  Only the clusters of dirty nets are searched
+     *         again, the ones of the other nets are kept from the previous call.
+     */
     const CLUSTERS& GetClusters();
 
     const CN_LIST& ItemList() const
@@ -45,7 +45,9 @@
 #include <drc/drc_rtree.h>
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA() :
-        m_skipRatsnestUpdate( false )
+        m_skipRatsnestUpdate( false ),
+        m_ratsnestCancelled( false ),
+        m_snapshot( std::make_shared<CONNECTIVITY_SNAPSHOT>() )
 {
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO( this ) );
     m_progressReporter = nullptr;
@@ -56,7 +58,9 @@ CONNECTIVITY_DATA::CONNECTIVITY_DATA() :
 CONNECTIVITY_DATA::CONNECTIVITY_DATA( std::shared_ptr<CONNECTIVITY_DATA> aGlobalConnectivity,
                                       const std::vector<BOARD_ITEM*>& aLocalItems,
                                       bool aSkipRatsnestUpdate ) :
-        m_skipRatsnestUpdate( aSkipRatsnestUpdate )
+        m_skipRatsnestUpdate( aSkipRatsnestUpdate ),
+        m_ratsnestCancelled( false ),
+        m_snapshot( std::make_shared<CONNECTIVITY_SNAPSHOT>() )
 {
     Build( aGlobalConnectivity, aLocalItems );
     m_progressReporter = nullptr;
@@ -66,6 +70,8 @@ CONNECTIVITY_DATA::CONNECTIVITY_DATA( std::shared_ptr<CONNECTIVITY_DATA> aGlobal
 
 CONNECTIVITY_DATA::~CONNECTIVITY_DATA()
 {
+    cancelRatsnest();
+
     for( RN_NET* net : m_nets )
         delete net;
 
@@ -75,28 +81,39 @@ CONNECTIVITY_DATA::~CONNECTIVITY_DATA()
 
 bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 {
+    WaitForRatsnest();
+
     m_connAlgo->Add( aItem );
+    m_fromToCache->InvalidateItem( aItem );
     return true;
 }
 
 
 bool CONNECTIVITY_DATA::Remove( BOARD_ITEM* aItem )
 {
+    WaitForRatsnest();
+
     m_connAlgo->Remove( aItem );
+    m_fromToCache->InvalidateItem( aItem );
     return true;
 }
 
 
 bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 {
+    WaitForRatsnest();
+
     m_connAlgo->Remove( aItem );
     m_connAlgo->Add( aItem );
+    m_fromToCache->InvalidateItem( aItem );
     return true;
 }
 
 
 bool CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
+    cancelRatsnest();
+
     aBoard->CacheTriangulation( aReporter );
 
     std::unique_lock<KISPINLOCK> lock( m_lock, std::try_to_lock );
@@ -114,6 +131,7 @@ bool CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO( this ) );
     m_connAlgo->Build( aBoard, aReporter );
+    m_fromToCache->Invalidate();
 
     m_netclassMap.clear();
 
@@ -146,6 +164,8 @@ bool CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 void CONNECTIVITY_DATA::Build( std::shared_ptr<CONNECTIVITY_DATA>& aGlobalConnectivity,
                                const std::vector<BOARD_ITEM*>& aLocalItems )
 {
+    cancelRatsnest();
+
     std::unique_lock<KISPINLOCK> lock( m_lock, std::try_to_lock );
 
     if( !lock )
@@ -160,6 +180,8 @@ void CONNECTIVITY_DATA::Build( std::shared_ptr<CONNECTIVITY_DATA>& aGlobalConnec
 
 void CONNECTIVITY_DATA::Move( const VECTOR2I& aDelta )
 {
+    WaitForRatsnest();
+
     m_connAlgo->ForEachAnchor( [&aDelta]( CN_ANCHOR& anchor )
                                {
                                    anchor.Move( aDelta );
@@ -184,13 +206,15 @@ void CONNECTIVITY_DATA::updateRatsnest()
             } );
 
     thread_pool& tp = GetKiCadThreadPool();
+    size_t       budget = GetThreadBudget( THREAD_SUBSYSTEM::CONNECTIVITY );
 
     tp.push_loop( dirty_nets.size(),
             [&]( const int a, const int b )
             {
                 for( int ii = a; ii < b; ++ii )
                     dirty_nets[ii]->UpdateNet();
-            } );
+            },
+            budget );
     tp.wait_for_tasks();
 
     tp.push_loop( dirty_nets.size(),
@@ -198,7 +222,8 @@ void CONNECTIVITY_DATA::updateRatsnest()
             {
                 for( int ii = a; ii < b; ++ii )
                     dirty_nets[ii]->OptimizeRNEdges();
-            } );
+            },
+            budget );
     tp.wait_for_tasks();
 
 #ifdef PROFILE
@@ -217,6 +242,7 @@ void CONNECTIVITY_DATA::addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& a
 
 void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
+    cancelRatsnest();
 
     // We can take over the lock here if called in the same thread
     // This is to prevent redraw during a RecalculateRatsnets process
@@ -226,9 +252,90 @@ void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 
 }
 
+
+void CONNECTIVITY_DATA::RecalculateRatsnestAsync( BOARD_COMMIT* aCommit,
+                                                  std::function<void()> aOnReady )
+{
+    cancelRatsnest();
+
+    std::vector<RN_NET*> dirty_nets;
+
+    {
+        std::unique_lock<KISPINLOCK> lock( m_lock );
+
+        prepareRatsnest( aCommit );
+
+        if( !m_skipRatsnestUpdate )
+        {
+            std::copy_if( m_nets.begin() + 1, m_nets.end(), std::back_inserter( dirty_nets ),
+                    [] ( RN_NET* aNet )
+                    {
+                        return aNet->IsDirty() && aNet->GetNodeCount() > 0;
+                    } );
+        }
+    }
+
+    if( dirty_nets.empty() )
+    {
+        if( aOnReady )
+            aOnReady();
+
+        return;
+    }
+
+    m_ratsnestCancelled = false;
+
+    // Run on a thread of its own rather than on the pool: pool tasks may wait for the ratsnest
+    // through the connectivity queries, and must not be queued ahead of it.  ParallelFor()
+    // still spreads the nets over the pool.
+    m_ratsnestTask = std::async( std::launch::async,
+            [this, dirty_nets, aOnReady]()
+            {
+                {
+                    std::unique_lock<KISPINLOCK> lock( m_lock );
+
+                    // Nets are updated and optimized one at a time, so that cancelling leaves
+                    // every net either done or still dirty
+                    ParallelFor( dirty_nets.size(),
+                            [&]( size_t ii )
+                            {
+                                if( m_ratsnestCancelled )
+                                    return;
+
+                                dirty_nets[ii]->UpdateNet();
+                                dirty_nets[ii]->OptimizeRNEdges();
+                            } );
+                }
+
+                if( !m_ratsnestCancelled && aOnReady )
+                    aOnReady();
+            } ).share();
+}
+
+
+void CONNECTIVITY_DATA::cancelRatsnest()
+{
+    if( !m_ratsnestTask.valid() )
+        return;
+
+    m_ratsnestCancelled = true;
+    m_ratsnestTask.wait();
+    m_ratsnestTask = std::shared_future<void>();
+}
+
+
 void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
-    m_connAlgo->PropagateNets( aCommit );
+    prepareRatsnest( aCommit );
+
+    if( !m_skipRatsnestUpdate )
+        updateRatsnest();
+}
+
+
+void CONNECTIVITY_DATA::prepareRatsnest( BOARD_COMMIT* aCommit )
+{
+    m_connAlgo->PropagateNets( aCommit, true );
 
     int lastNet = m_connAlgo->NetCount();
 
@@ -256,6 +363,10 @@ void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
         {
             m_nets[net]->Clear();
             dirtyNets++;
+
+            // Net propagation changes the nets of items without going through Update()
+            if( m_fromToCache )
+                m_fromToCache->InvalidateNet( net );
         }
     }
 
@@ -274,15 +385,61 @@ void CONNECTIVITY_DATA::internalRecalculateRatsnest( BOARD_COMMIT* aCommit  )
             addRatsnestCluster( c );
     }
 
+    if( !m_skipRatsnestUpdate )
+        updateSnapshot( clusters );
+
     m_connAlgo->ClearDirtyFlags();
+}
 
-    if( !m_skipRatsnestUpdate )
-        updateRatsnest();
+
+void CONNECTIVITY_DATA::updateSnapshot( const std::vector<std::shared_ptr<CN_CLUSTER>>& aClusters )
+{
+    int                                                    netCount = m_connAlgo->NetCount();
+    std::shared_ptr<CONNECTIVITY_SNAPSHOT>                 snapshot;
+    std::vector<std::vector<std::shared_ptr<CN_CLUSTER>>> dirtyClusters( netCount );
+
+    {
+        std::lock_guard<std::mutex> lock( m_snapshotMutex );
+
+        snapshot = std::make_shared<CONNECTIVITY_SNAPSHOT>( *m_snapshot );
+    }
+
+    snapshot->m_version++;
+    snapshot->m_nets.resize( netCount );
+
+    for( const std::shared_ptr<CN_CLUSTER>& c : aClusters )
+    {
+        int net = c->OriginNet();
+
+        if( net > 0 && net < netCount && m_connAlgo->IsNetDirty( net ) )
+            dirtyClusters[net].push_back( c );
+    }
+
+    // Clean nets keep sharing their data with the previous snapshot
+    for( int net = 1; net < netCount; net++ )
+    {
+        if( m_connAlgo->IsNetDirty( net ) || !snapshot->m_nets[net] )
+            snapshot->m_nets[net] = CONNECTIVITY_SNAPSHOT::BuildNet( dirtyClusters[net] );
+    }
+
+    std::lock_guard<std::mutex> lock( m_snapshotMutex );
+
+    m_snapshot = std::move( snapshot );
+}
+
+
+std::shared_ptr<const CONNECTIVITY_SNAPSHOT> CONNECTIVITY_DATA::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock( m_snapshotMutex );
+
+    return m_snapshot;
 }
 
 
 void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aItems )
 {
+    WaitForRatsnest();
+
     std::vector<BOARD_CONNECTED_ITEM*> citems;
 
     for( BOARD_ITEM* item : aItems )
@@ -317,6 +474,8 @@ void CONNECTIVITY_DATA::BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aIte
 
 int CONNECTIVITY_DATA::GetNetCount() const
 {
+    WaitForRatsnest();
+
     return m_connAlgo->NetCount();
 }
 
@@ -324,6 +483,8 @@ int CONNECTIVITY_DATA::GetNetCount() const
 void CONNECTIVITY_DATA::FillIsolatedIslandsMap( std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>>& aMap,
                                                 bool aConnectivityAlreadyRebuilt )
 {
+    WaitForRatsnest();
+
     m_connAlgo->FillIsolatedIslandsMap( aMap, aConnectivityAlreadyRebuilt );
 }
 
@@ -332,6 +493,8 @@ void CONNECTIVITY_DATA::ComputeLocalRatsnest( const std::vector<BOARD_ITEM*>& aI
                                               const CONNECTIVITY_DATA* aDynamicData,
                                               VECTOR2I aInternalOffset )
 {
+    WaitForRatsnest();
+
     if( !aDynamicData )
         return;
 
@@ -375,7 +538,8 @@ void CONNECTIVITY_DATA::ComputeLocalRatsnest( const std::vector<BOARD_ITEM*>& aI
             {
                 for( int ii = a; ii < b; ++ii )
                     update_lambda( ii );
-            });
+            },
+            GetThreadBudget( THREAD_SUBSYSTEM::CONNECTIVITY ) );
     tp.wait_for_tasks();
 
     // This gets the ratsnest for internal connections in the moving set
@@ -418,6 +582,8 @@ void CONNECTIVITY_DATA::HideLocalRatsnest()
 
 void CONNECTIVITY_DATA::PropagateNets( BOARD_COMMIT* aCommit )
 {
+    WaitForRatsnest();
+
     m_connAlgo->PropagateNets( aCommit );
 }
 
@@ -425,6 +591,8 @@ void CONNECTIVITY_DATA::PropagateNets( BOARD_COMMIT* aCommit )
 bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, int aLayer,
                                             const std::initializer_list<KICAD_T>& aTypes ) const
 {
+    WaitForRatsnest();
+
     CN_CONNECTIVITY_ALGO::ITEM_MAP_ENTRY &entry = m_connAlgo->ItemEntry( aItem );
 
     auto matchType =
@@ -455,8 +623,9 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
                     if( zone->IsFilled() )
                     {
-                        const SHAPE_POLY_SET*   zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
-                        const SHAPE_LINE_CHAIN& padHull = pad->GetEffectivePolygon( ERROR_INSIDE )->Outline( 0 );
+                        PCB_LAYER_ID            layer = ToLAYER_ID( aLayer );
+                        const SHAPE_POLY_SET*   zoneFill = zone->GetFilledPolysList( layer ).get();
+                        const SHAPE_LINE_CHAIN& padHull = pad->GetEffectivePolygon( ERROR_INSIDE )->COutline( 0 );
 
                         for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
                         {
@@ -479,7 +648,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
                     if( zone->IsFilled() )
                     {
-                        const SHAPE_POLY_SET* zoneFill = zone->GetFill( ToLAYER_ID( aLayer ) );
+                        PCB_LAYER_ID          layer = ToLAYER_ID( aLayer );
+                        const SHAPE_POLY_SET* zoneFill = zone->GetFilledPolysList( layer ).get();
                         SHAPE_CIRCLE          viaHull( via->GetCenter(), via->GetWidth() / 2 );
 
                         for( const VECTOR2I& pt : zoneFill->COutline( islandIdx ).CPoints() )
@@ -507,6 +677,8 @@ bool CONNECTIVITY_DATA::IsConnectedOnLayer( const BOARD_CONNECTED_ITEM *aItem, i
 
 unsigned int CONNECTIVITY_DATA::GetUnconnectedCount( bool aVisibleOnly ) const
 {
+    WaitForRatsnest();
+
     unsigned int unconnected = 0;
 
     for( RN_NET* net : m_nets )
@@ -527,6 +699,8 @@ unsigned int CONNECTIVITY_DATA::GetUnconnectedCount( bool aVisibleOnly ) const
 
 void CONNECTIVITY_DATA::ClearRatsnest()
 {
+    cancelRatsnest();
+
     for( RN_NET* net : m_nets )
         net->Clear();
 }
@@ -537,6 +711,8 @@ CONNECTIVITY_DATA::GetConnectedItems( const BOARD_CONNECTED_ITEM *aItem,
                                       const std::initializer_list<KICAD_T>& aTypes,
                                       bool aIgnoreNetcodes ) const
 {
+    WaitForRatsnest();
+
     std::vector<BOARD_CONNECTED_ITEM*> rv;
     CN_CONNECTIVITY_ALGO::CLUSTER_SEARCH_MODE searchMode;
 
@@ -567,6 +743,8 @@ CONNECTIVITY_DATA::GetConnectedItems( const BOARD_CONNECTED_ITEM *aItem,
 const std::vector<BOARD_CONNECTED_ITEM*>
 CONNECTIVITY_DATA::GetNetItems( int aNetCode, const std::initializer_list<KICAD_T>& aTypes ) const
 {
+    WaitForRatsnest();
+
     std::vector<BOARD_CONNECTED_ITEM*> items;
     items.reserve( 32 );
 
@@ -594,6 +772,8 @@ CONNECTIVITY_DATA::GetNetItems( int aNetCode, const std::initializer_list<KICAD_
 const std::vector<PCB_TRACK*>
 CONNECTIVITY_DATA::GetConnectedTracks( const BOARD_CONNECTED_ITEM* aItem ) const
 {
+    WaitForRatsnest();
+
     CN_CONNECTIVITY_ALGO::ITEM_MAP_ENTRY& entry = m_connAlgo->ItemEntry( aItem );
 
     std::set<PCB_TRACK*> tracks;
@@ -621,6 +801,8 @@ CONNECTIVITY_DATA::GetConnectedTracks( const BOARD_CONNECTED_ITEM* aItem ) const
 void CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem,
                                           std::set<PAD*>* pads ) const
 {
+    WaitForRatsnest();
+
     for( CN_ITEM* citem : m_connAlgo->ItemEntry( aItem ).GetItems() )
     {
         for( CN_ITEM* connected : citem->ConnectedItems() )
@@ -635,6 +817,8 @@ void CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem,
 const std::vector<PAD*> CONNECTIVITY_DATA::GetConnectedPads( const BOARD_CONNECTED_ITEM* aItem )
 const
 {
+    WaitForRatsnest();
+
     std::set<PAD*>    pads;
     std::vector<PAD*> rv;
 
@@ -649,6 +833,8 @@ void CONNECTIVITY_DATA::GetConnectedPadsAndVias( const BOARD_CONNECTED_ITEM* aIt
                                                  std::vector<PAD*>* pads,
                                                  std::vector<PCB_VIA*>* vias )
 {
+    WaitForRatsnest();
+
     for( CN_ITEM* citem : m_connAlgo->ItemEntry( aItem ).GetItems() )
     {
         for( CN_ITEM* connected : citem->ConnectedItems() )
@@ -669,6 +855,8 @@ void CONNECTIVITY_DATA::GetConnectedPadsAndVias( const BOARD_CONNECTED_ITEM* aIt
 
 unsigned int CONNECTIVITY_DATA::GetNodeCount( int aNet ) const
 {
+    WaitForRatsnest();
+
     int sum = 0;
 
     if( aNet < 0 )      // Node count for all nets
@@ -687,6 +875,8 @@ unsigned int CONNECTIVITY_DATA::GetNodeCount( int aNet ) const
 
 unsigned int CONNECTIVITY_DATA::GetPadCount( int aNet ) const
 {
+    WaitForRatsnest();
+
     int n = 0;
 
     for( CN_ITEM* pad : m_connAlgo->ItemList() )
@@ -706,6 +896,8 @@ unsigned int CONNECTIVITY_DATA::GetPadCount( int aNet ) const
 
 void CONNECTIVITY_DATA::RunOnUnconnectedEdges( std::function<bool( CN_EDGE& )> aFunc )
 {
+    WaitForRatsnest();
+
     for( RN_NET* rnNet : m_nets )
     {
         if( rnNet )
@@ -742,6 +934,8 @@ static int getMinDist( BOARD_CONNECTED_ITEM* aItem, const VECTOR2I& aPoint )
 bool CONNECTIVITY_DATA::TestTrackEndpointDangling( PCB_TRACK* aTrack, bool aIgnoreTracksInPads,
                                                    VECTOR2I* aPos ) const
 {
+    WaitForRatsnest();
+
     const std::list<CN_ITEM*>& items = GetConnectivityAlgo()->ItemEntry( aTrack ).GetItems();
 
     // Not in the connectivity system.  This is a bug!
@@ -883,6 +1077,8 @@ CONNECTIVITY_DATA::GetConnectedItemsAtAnchor( const BOARD_CONNECTED_ITEM* aItem,
                                               const std::initializer_list<KICAD_T>& aTypes,
                                               const int& aMaxError ) const
 {
+    WaitForRatsnest();
+
     CN_CONNECTIVITY_ALGO::ITEM_MAP_ENTRY& entry = m_connAlgo->ItemEntry( aItem );
     std::vector<BOARD_CONNECTED_ITEM*>    rv;
     SEG::ecoord                           maxError_sq = (SEG::ecoord) aMaxError * aMaxError;
@@ -916,6 +1112,8 @@ CONNECTIVITY_DATA::GetConnectedItemsAtAnchor( const BOARD_CONNECTED_ITEM* aItem,
 
 RN_NET* CONNECTIVITY_DATA::GetRatsnestForNet( int aNet )
 {
+    WaitForRatsnest();
+
     if ( aNet < 0 || aNet >= (int) m_nets.size() )
         return nullptr;
 
@@ -925,6 +1123,8 @@ RN_NET* CONNECTIVITY_DATA::GetRatsnestForNet( int aNet )
 
 void CONNECTIVITY_DATA::MarkItemNetAsDirty( BOARD_ITEM *aItem )
 {
+    WaitForRatsnest();
+
     if ( aItem->Type() == PCB_FOOTPRINT_T)
     {
         for( PAD* pad : static_cast<FOOTPRINT*>( aItem )->Pads() )
@@ -938,6 +1138,8 @@ void CONNECTIVITY_DATA::MarkItemNetAsDirty( BOARD_ITEM *aItem )
 
 void CONNECTIVITY_DATA::RemoveInvalidRefs()
 {
+    WaitForRatsnest();
+
     m_connAlgo->RemoveInvalidRefs();
 
     for( RN_NET* rnNet : m_nets )
@@ -955,6 +1157,8 @@ void CONNECTIVITY_DATA::SetProgressReporter( PROGRESS_REPORTER* aReporter )
 const std::vector<CN_EDGE>
 CONNECTIVITY_DATA::GetRatsnestForItems( const std::vector<BOARD_ITEM*>& aItems )
 {
+    WaitForRatsnest();
+
     std::set<int> nets;
     std::vector<CN_EDGE> edges;
     std::set<BOARD_CONNECTED_ITEM*> item_set;
@@ -1012,6 +1216,8 @@ CONNECTIVITY_DATA::GetRatsnestForItems( const std::vector<BOARD_ITEM*>& aItems )
 
 const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForPad( const PAD* aPad )
 {
+    WaitForRatsnest();
+
     std::vector<CN_EDGE> edges;
     RN_NET* net = GetRatsnestForNet( aPad->GetNetCode() );
 
@@ -1037,6 +1243,8 @@ const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForPad( const PAD* aPad
 const std::vector<CN_EDGE> CONNECTIVITY_DATA::GetRatsnestForComponent( FOOTPRINT* aComponent,
                                                                        bool aSkipInternalConnections )
 {
+    WaitForRatsnest();
+
     std::set<int> nets;
     std::set<const PAD*> pads;
     std::vector<CN_EDGE> edges;
@@ -30,6 +30,10 @@
 #include <core/typeinfo.h>
 #include <core/spinlock.h>
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -38,6 +42,7 @@
 #include <math/vector2d.h>
 #include <geometry/shape_poly_set.h>
 #include <zone.h>
+#include <connectivity/connectivity_snapshot.h>
 
 class FROM_TO_CACHE;
 class CN_CLUSTER;
@@ -177,6 +182,38 @@ public:
      */
     void RecalculateRatsnest( BOARD_COMMIT* aCommit = nullptr );
 
+    /**
+     * Update the ratsnest like RecalculateRatsnest(), but compute the ratsnest lines of the
+     * dirty nets on the thread pool.  Nets are still propagated and clusters assigned to nets
+     * before returning, so \a aCommit gets the same changes.
+     *
+     * Reading the ratsnest (or the connectivity) waits for the pending computation.  A new
+     * update or a rebuild cancels it; the nets it didn't get to stay dirty and are computed by
+     * the next update.
+     *
+     * @param aOnReady is called from the worker thread once all the ratsnest lines are ready.
+     *                 It isn't called when the computation is cancelled.
+     */
+    void RecalculateRatsnestAsync( BOARD_COMMIT* aCommit, std::function<void()> aOnReady );
+
+    /**
+     * Wait for the computation started by RecalculateRatsnestAsync(), if any.
+     */
+    void WaitForRatsnest() const
+    {
+        if( m_ratsnestTask.valid() )
+            m_ratsnestTask.wait();
+    }
+
+    /**
+     * @return true while the computation started by RecalculateRatsnestAsync() is running.
+     */
+    bool IsRatsnestPending() const
+    {
+        return m_ratsnestTask.valid()
+               && m_ratsnestTask.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready;
+    }
+
     /**
      * @param aVisibleOnly include only visbile edges in the count
      * @return the number of remaining edges in the ratsnest
@@ -263,7 +300,11 @@ public:
 
     void BlockRatsnestItems( const std::vector<BOARD_ITEM*>& aItems );
 
-    std::shared_ptr<CN_CONNECTIVITY_ALGO> GetConnectivityAlgo() const { return m_connAlgo; }
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> GetConnectivityAlgo() const
+    {
+        WaitForRatsnest();
+        return m_connAlgo;
+    }
 
     KISPINLOCK& GetLock() { return m_lock; }
 
@@ -285,6 +326,12 @@ public:
 
     std::shared_ptr<FROM_TO_CACHE> GetFromToCache() { return m_fromToCache; }
 
+    /**
+     * @return the connectivity as of the last ratsnest update.  The snapshot doesn't change
+     *         and can be read from any thread while the board is edited.
+     */
+    std::shared_ptr<const CONNECTIVITY_SNAPSHOT> GetSnapshot() const;
+
 private:
 
     /**
@@ -292,10 +339,19 @@ private:
      * @param aCommit is used to save the undo state of items modified by this call
      */
     void internalRecalculateRatsnest( BOARD_COMMIT* aCommit = nullptr );
+
+    ///< Propagate nets and hand the clusters of dirty nets over to their RN_NETs
+    void prepareRatsnest( BOARD_COMMIT* aCommit );
     void updateRatsnest();
 
+    ///< Stop the computation started by RecalculateRatsnestAsync() and wait for it to end
+    void cancelRatsnest();
+
     void addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& aCluster );
 
+    ///< Publish a snapshot with the clusters of the dirty nets out of \a aClusters
+    void updateSnapshot( const std::vector<std::shared_ptr<CN_CLUSTER>>& aClusters );
+
 private:
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
 
@@ -308,6 +364,14 @@ private:
 
     KISPINLOCK                      m_lock;
 
+    /// Ratsnest lines computed by RecalculateRatsnestAsync().  Shared so that threads may wait
+    /// for it concurrently.
+    mutable std::shared_future<void> m_ratsnestTask;
+    std::atomic<bool>               m_ratsnestCancelled;
+
+    std::shared_ptr<const CONNECTIVITY_SNAPSHOT> m_snapshot;
+    mutable std::mutex              m_snapshotMutex;
+
     /// Map of netcode -> netclass the net is a member of; used for ratsnest painting
     std::map<int, wxString>         m_netclassMap;
 
@@ -145,84 +145,108 @@ void CN_ITEM::RemoveInvalidRefs()
 }
 
 
-CN_ITEM* CN_LIST::Add( PAD* pad )
- {
+CN_ITEM* CN_LIST::CreateItem( PAD* pad )
+{
     if( !pad->IsOnCopperLayer() )
-         return nullptr;
-
-     auto item = new CN_ITEM( pad, false, 1 );
-     item->AddAnchor( pad->ShapePos() );
-     item->SetLayers( LAYER_RANGE( F_Cu, B_Cu ) );
-
-     switch( pad->GetAttribute() )
-     {
-     case PAD_ATTRIB::SMD:
-     case PAD_ATTRIB::NPTH:
-     case PAD_ATTRIB::CONN:
-     {
-         LSET lmsk = pad->GetLayerSet();
-
-         for( int i = 0; i <= MAX_CU_LAYERS; i++ )
-         {
-             if( lmsk[i] )
-             {
-                 item->SetLayer( i );
-                 break;
-             }
-         }
-         break;
-     }
-     default:
-         break;
-     }
-
-     addItemtoTree( item );
-     m_items.push_back( item );
-     SetDirty();
-     return item;
+        return nullptr;
+
+    auto item = new CN_ITEM( pad, false, 1 );
+    item->SetAnchors( { pad->ShapePos() } );
+    item->SetLayers( LAYER_RANGE( F_Cu, B_Cu ) );
+
+    switch( pad->GetAttribute() )
+    {
+    case PAD_ATTRIB::SMD:
+    case PAD_ATTRIB::NPTH:
+    case PAD_ATTRIB::CONN:
+    {
+        LSET lmsk = pad->GetLayerSet();
+
+        for( int i = 0; i <= MAX_CU_LAYERS; i++ )
+        {
+            if( lmsk[i] )
+            {
+                item->SetLayer( i );
+                break;
+            }
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    return item;
 }
 
 
-CN_ITEM* CN_LIST::Add( PCB_TRACK* track )
+CN_ITEM* CN_LIST::CreateItem( PCB_TRACK* track )
 {
     CN_ITEM* item = new CN_ITEM( track, true );
-    m_items.push_back( item );
-    item->AddAnchor( track->GetStart() );
-    item->AddAnchor( track->GetEnd() );
+    item->SetAnchors( { track->GetStart(), track->GetEnd() } );
     item->SetLayer( track->GetLayer() );
-    addItemtoTree( item );
-    SetDirty();
     return item;
 }
 
 
-CN_ITEM* CN_LIST::Add( PCB_ARC* aArc )
+CN_ITEM* CN_LIST::CreateItem( PCB_ARC* aArc )
 {
     CN_ITEM* item = new CN_ITEM( aArc, true );
-    m_items.push_back( item );
-    item->AddAnchor( aArc->GetStart() );
-    item->AddAnchor( aArc->GetEnd() );
+    item->SetAnchors( { aArc->GetStart(), aArc->GetEnd() } );
     item->SetLayer( aArc->GetLayer() );
-    addItemtoTree( item );
-    SetDirty();
     return item;
 }
 
 
-CN_ITEM* CN_LIST::Add( PCB_VIA* via )
+CN_ITEM* CN_LIST::CreateItem( PCB_VIA* via )
 {
     CN_ITEM* item = new CN_ITEM( via, !via->GetIsFree(), 1 );
+    item->SetAnchors( { via->GetStart() } );
+    item->SetLayers( LAYER_RANGE( via->TopLayer(), via->BottomLayer() ) );
+    return item;
+}
 
-    m_items.push_back( item );
-    item->AddAnchor( via->GetStart() );
 
-    item->SetLayers( LAYER_RANGE( via->TopLayer(), via->BottomLayer() ) );
-    addItemtoTree( item );
-    SetDirty();
+CN_ITEM* CN_LIST::CreateItem( PCB_SHAPE* shape )
+{
+    CN_ITEM* item = new CN_ITEM( shape, true );
+
+    item->SetAnchors( shape->GetConnectionPoints() );
+
+    item->SetLayer( shape->GetLayer() );
+    return item;
+}
+
+
+CN_ITEM* CN_LIST::Add( PAD* pad )
+{
+    CN_ITEM* item = CreateItem( pad );
+
+    if( item )
+        Add( item );
+
     return item;
 }
 
 
+CN_ITEM* CN_LIST::Add( PCB_TRACK* track )
+{
+    return Add( CreateItem( track ) );
+}
+
+
+CN_ITEM* CN_LIST::Add( PCB_ARC* aArc )
+{
+    return Add( CreateItem( aArc ) );
+}
+
+
+CN_ITEM* CN_LIST::Add( PCB_VIA* via )
+{
+    return Add( CreateItem( via ) );
+}
+
+
 const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 {
     const std::shared_ptr<SHAPE_POLY_SET>& polys = zone->GetFilledPolysList( aLayer );
@@ -235,8 +259,10 @@ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 
         zitem->BuildRTree();
 
-        for( const VECTOR2I& pt : zone->GetFilledPolysList( aLayer )->COutline( j ).CPoints() )
-            zitem->AddAnchor( pt );
+        const SHAPE_LINE_CHAIN& outline = zone->GetFilledPolysList( aLayer )->COutline( j );
+
+        zitem->SetAnchors( std::vector<VECTOR2I>( outline.CPoints().begin(),
+                                                  outline.CPoints().end() ) );
 
         rv.push_back( Add( zitem ) );
     }
@@ -245,27 +271,84 @@ const std::vector<CN_ITEM*> CN_LIST::Add( ZONE* zone, PCB_LAYER_ID aLayer )
 }
 
 
-CN_ITEM* CN_LIST::Add( CN_ZONE_LAYER* zitem )
+CN_ITEM* CN_LIST::Add( CN_ITEM* aItem )
 {
-    m_items.push_back( zitem );
-    addItemtoTree( zitem );
+    m_items.push_back( aItem );
+    addItemtoTree( aItem );
     SetDirty();
-    return zitem;
+    return aItem;
 }
 
 
 CN_ITEM* CN_LIST::Add( PCB_SHAPE* shape )
 {
-    CN_ITEM* item = new CN_ITEM( shape, true );
-    m_items.push_back( item );
+    return Add( CreateItem( shape ) );
+}
 
-    for( const VECTOR2I& point : shape->GetConnectionPoints() )
-        item->AddAnchor( point );
 
-    item->SetLayer( shape->GetLayer() );
-    addItemtoTree( item );
-    SetDirty();
-    return item;
+/**
+ * Interleave the bits of the coordinates of \a aPoint, so that points close to each other on
+ * the board are mostly close to each other in the order of their keys (a Z-order curve).
+ */
+static uint64_t zOrderKey( const VECTOR2I& aPoint )
+{
+    auto spread =
+            []( uint64_t aValue )
+            {
+                aValue &= 0xFFFFFFFF;
+                aValue = ( aValue | ( aValue << 16 ) ) & 0x0000FFFF0000FFFF;
+                aValue = ( aValue | ( aValue << 8 ) ) & 0x00FF00FF00FF00FF;
+                aValue = ( aValue | ( aValue << 4 ) ) & 0x0F0F0F0F0F0F0F0F;
+                aValue = ( aValue | ( aValue << 2 ) ) & 0x3333333333333333;
+                aValue = ( aValue | ( aValue << 1 ) ) & 0x5555555555555555;
+                return aValue;
+            };
+
+    // Shift the signed coordinates so that their order is kept as unsigned values
+    uint64_t x = (uint32_t) aPoint.x ^ 0x80000000;
+    uint64_t y = (uint32_t) aPoint.y ^ 0x80000000;
+
+    return spread( x ) | ( spread( y ) << 1 );
+}
+
+
+void CN_LIST::AddItems( const std::vector<CN_ITEM*>& aItems )
+{
+    std::vector<std::pair<uint64_t, CN_ITEM*>> sorted;
+
+    sorted.reserve( aItems.size() );
+
+    for( CN_ITEM* item : aItems )
+        sorted.emplace_back( zOrderKey( item->BBox().Centre() ), item );
+
+    // Group the items by layer range, and each group along the Z-order curve.  Inserting
+    // neighbours one after the other keeps the R-tree nodes tight and the insertion paths
+    // in cache, as a bulk load would.
+    std::sort( sorted.begin(), sorted.end(),
+               []( const std::pair<uint64_t, CN_ITEM*>& a, const std::pair<uint64_t, CN_ITEM*>& b )
+               {
+                   const LAYER_RANGE& layersA = a.second->Layers();
+                   const LAYER_RANGE& layersB = b.second->Layers();
+
+                   if( layersA.Start() != layersB.Start() )
+                       return layersA.Start() < layersB.Start();
+
+                   if( layersA.End() != layersB.End() )
+                       return layersA.End() < layersB.End();
+
+                   return a.first < b.first;
+               } );
+
+    m_items.reserve( m_items.size() + aItems.size() );
+
+    for( const auto& [key, item] : sorted )
+    {
+        m_items.push_back( item );
+        addItemtoTree( item );
+    }
+
+    if( !aItems.empty() )
+        SetDirty();
 }
 
 
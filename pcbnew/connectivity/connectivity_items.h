@@ -141,7 +141,7 @@ public:
         m_visited = false;
         m_valid = true;
         m_dirty = true;
-        m_anchors.reserve( std::max( 6, aAnchorCount ) );
+        m_anchors.reserve( aAnchorCount );
         m_layers = LAYER_RANGE( 0, PCB_LAYER_ID_COUNT );
         m_connected.reserve( 8 );
     }
@@ -152,10 +152,30 @@ public:
             anchor->SetItem( nullptr );
     };
 
-    std::shared_ptr<CN_ANCHOR> AddAnchor( const VECTOR2I& aPos )
+    /**
+     * Set the anchors of the item at \a aPositions, replacing any previous ones.
+     *
+     * The anchors are stored next to each other in a single allocation, which the pointers
+     * to them share, so that walking the anchors of an item doesn't jump around the heap.
+     * The block is freed once the item and all the ratsnest edges using its anchors are gone.
+     */
+    void SetAnchors( const std::vector<VECTOR2I>& aPositions )
     {
-        m_anchors.emplace_back( std::make_shared<CN_ANCHOR>( aPos, this ) );
-        return m_anchors.at( m_anchors.size() - 1 );
+        std::shared_ptr<std::vector<CN_ANCHOR>> block = std::make_shared<std::vector<CN_ANCHOR>>();
+
+        block->reserve( aPositions.size() );
+
+        for( const VECTOR2I& pos : aPositions )
+            block->emplace_back( pos, this );
+
+        for( const std::shared_ptr<CN_ANCHOR>& anchor : m_anchors )
+            anchor->SetItem( nullptr );
+
+        m_anchors.clear();
+        m_anchors.reserve( block->size() );
+
+        for( CN_ANCHOR& anchor : *block )
+            m_anchors.emplace_back( block, &anchor );
     }
 
     std::vector<std::shared_ptr<CN_ANCHOR>>& Anchors() { return m_anchors; }
@@ -229,6 +249,18 @@ public:
         return ( !m_parent || !m_valid ) ? -1 : m_parent->GetNetCode();
     }
 
+    /**
+     * @return the estimated memory held by the item and its anchors, in bytes.
+     */
+    size_t GetMemoryUsage() const
+    {
+        return sizeof( CN_ITEM )
+               + m_connected.capacity() * sizeof( CN_ITEM* )
+               + m_anchors.capacity() * sizeof( std::shared_ptr<CN_ANCHOR> )
+               + m_anchors.size() * sizeof( CN_ANCHOR )
+               + ( m_anchors.empty() ? 0 : sizeof( std::vector<CN_ANCHOR> ) );
+    }
+
 protected:
     bool            m_dirty;         ///< used to identify recently added item not yet
                                      ///< scanned into the connectivity search
@@ -297,7 +329,7 @@ public:
     bool ContainsPoint( const VECTOR2I& p ) const
     {
         if( m_zone->IsTeardropArea() )
-            return m_fillPoly->Outline( m_subpolyIndex ).Collide( p ) ;
+            return m_fillPoly->COutline( m_subpolyIndex ).Collide( p ) ;
 
         int  min[2] = { p.x, p.y };
         int  max[2] = { p.x, p.y };
@@ -327,7 +359,7 @@ public:
 
     const SHAPE_LINE_CHAIN& GetOutline() const
     {
-        return m_fillPoly->Outline( m_subpolyIndex );
+        return m_fillPoly->COutline( m_subpolyIndex );
     }
 
     bool Collide( SHAPE* aRefShape ) const
@@ -419,15 +451,46 @@ public:
 
     int Size() const { return m_items.size(); }
 
+    /**
+     * @return the estimated memory held by the items and the spatial index, in bytes.
+     */
+    size_t GetMemoryUsage() const
+    {
+        size_t bytes = m_items.capacity() * sizeof( CN_ITEM* ) + m_index.GetMemoryUsage( Size() );
+
+        for( const CN_ITEM* item : m_items )
+            bytes += item->GetMemoryUsage();
+
+        return bytes;
+    }
+
     CN_ITEM* Add( PAD* pad );
     CN_ITEM* Add( PCB_TRACK* track );
     CN_ITEM* Add( PCB_ARC* track );
     CN_ITEM* Add( PCB_VIA* via );
-    CN_ITEM* Add( CN_ZONE_LAYER* zitem );
+    CN_ITEM* Add( CN_ITEM* aItem );
     CN_ITEM* Add( PCB_SHAPE* shape );
 
     const std::vector<CN_ITEM*> Add( ZONE* zone, PCB_LAYER_ID aLayer );
 
+    /**
+     * Create the item of a board item without adding it to the list.  These don't touch the
+     * list, so they can run concurrently.
+     *
+     * @return the new item, or nullptr for a pad without copper layers.
+     */
+    static CN_ITEM* CreateItem( PAD* pad );
+    static CN_ITEM* CreateItem( PCB_TRACK* track );
+    static CN_ITEM* CreateItem( PCB_ARC* aArc );
+    static CN_ITEM* CreateItem( PCB_VIA* via );
+    static CN_ITEM* CreateItem( PCB_SHAPE* shape );
+
+    /**
+     * Add many items at once, inserting them in the spatial index by layer range and location
+     * rather than in the order they are given.
+     */
+    void AddItems( const std::vector<CN_ITEM*>& aItems );
+
 protected:
     void addItemtoTree( CN_ITEM* item )
     {
@@ -50,6 +50,17 @@ public:
         delete this->m_tree;
     }
 
+    /**
+     * Estimate the memory held by the tree for \a aCount items, in bytes.
+     *
+     * Nodes are at least half full, so two branches per item cover both the slack in the leaves
+     * and the inner levels of the tree.
+     */
+    static size_t GetMemoryUsage( size_t aCount )
+    {
+        return aCount * 2 * ( 2 * 3 * sizeof( int ) + sizeof( void* ) );
+    }
+
     /**
      * Function Insert()
      * Inserts an item into the tree. Item's bounding box is taken via its BBox() method.
@@ -0,0 +1,131 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <connectivity/connectivity_snapshot.h>
+
+#include <algorithm>
+
+#include <connectivity/connectivity_items.h>
+
+
+static const std::vector<KIID>                s_emptyItems;
+static const std::vector<std::vector<KIID>>   s_emptyClusters;
+
+
+const CONNECTIVITY_SNAPSHOT::NET* CONNECTIVITY_SNAPSHOT::getNet( int aNet ) const
+{
+    if( aNet < 0 || aNet >= (int) m_nets.size() )
+        return nullptr;
+
+    return m_nets[aNet].get();
+}
+
+
+const std::vector<KIID>& CONNECTIVITY_SNAPSHOT::GetNetItems( int aNet ) const
+{
+    const NET* net = getNet( aNet );
+
+    return net ? net->m_items : s_emptyItems;
+}
+
+
+const std::vector<std::vector<KIID>>& CONNECTIVITY_SNAPSHOT::GetClusters( int aNet ) const
+{
+    const NET* net = getNet( aNet );
+
+    return net ? net->m_clusters : s_emptyClusters;
+}
+
+
+bool CONNECTIVITY_SNAPSHOT::IsConnected( int aNet, const KIID& aItemA, const KIID& aItemB ) const
+{
+    const NET* net = getNet( aNet );
+
+    if( !net )
+        return false;
+
+    auto clustersOf =
+            [&]( const KIID& aItem )
+            {
+                return std::equal_range( net->m_itemClusters.begin(), net->m_itemClusters.end(),
+                                         std::make_pair( aItem, 0 ),
+                                         []( const std::pair<KIID, int>& aLhs,
+                                             const std::pair<KIID, int>& aRhs )
+                                         {
+                                             return aLhs.first < aRhs.first;
+                                         } );
+            };
+
+    auto [beginA, endA] = clustersOf( aItemA );
+    auto [beginB, endB] = clustersOf( aItemB );
+
+    // Most items are in a single cluster; zones may have a few islands
+    for( auto a = beginA; a != endA; ++a )
+    {
+        for( auto b = beginB; b != endB; ++b )
+        {
+            if( a->second == b->second )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+
+std::shared_ptr<const CONNECTIVITY_SNAPSHOT::NET>
+CONNECTIVITY_SNAPSHOT::BuildNet( const std::vector<std::shared_ptr<CN_CLUSTER>>& aClusters )
+{
+    std::shared_ptr<NET> net = std::make_shared<NET>();
+
+    net->m_clusters.reserve( aClusters.size() );
+
+    for( const std::shared_ptr<CN_CLUSTER>& cluster : aClusters )
+    {
+        std::vector<KIID>& items = net->m_clusters.emplace_back();
+        int                index = (int) net->m_clusters.size() - 1;
+
+        items.reserve( cluster->Size() );
+
+        for( CN_ITEM* item : *cluster )
+        {
+            if( item->Valid() )
+                items.push_back( item->Parent()->m_Uuid );
+        }
+
+        // The layers of a zone are separate connectivity items
+        std::sort( items.begin(), items.end() );
+        items.erase( std::unique( items.begin(), items.end() ), items.end() );
+
+        for( const KIID& id : items )
+        {
+            net->m_items.push_back( id );
+            net->m_itemClusters.emplace_back( id, index );
+        }
+    }
+
+    std::sort( net->m_items.begin(), net->m_items.end() );
+    net->m_items.erase( std::unique( net->m_items.begin(), net->m_items.end() ),
+                        net->m_items.end() );
+
+    std::sort( net->m_itemClusters.begin(), net->m_itemClusters.end() );
+
+    return net;
+}
@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef CONNECTIVITY_SNAPSHOT_H
+#define CONNECTIVITY_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <kiid.h>
+
+class CN_CLUSTER;
+
+
+/**
+ * An immutable copy of the connectivity of a board, as of a ratsnest update.
+ *
+ * Snapshots are obtained with CONNECTIVITY_DATA::GetSnapshot() and can be read from any thread
+ * without locking while the board keeps being edited.  Items are referred to by their KIID,
+ * since the items themselves may be changed or deleted in the meantime; resolve them with
+ * BOARD::GetItem() on the thread which owns the board.
+ *
+ * Nets are shared between successive snapshots, only the nets which changed are copied.
+ */
+class CONNECTIVITY_SNAPSHOT
+{
+public:
+    struct NET
+    {
+        /// The items of each cluster of the net.  A zone appears in each of the clusters
+        /// of its islands.
+        std::vector<std::vector<KIID>>   m_clusters;
+
+        /// The items of the net, sorted and unique
+        std::vector<KIID>                m_items;
+
+        /// The cluster index of each item, sorted by KIID
+        std::vector<std::pair<KIID, int>> m_itemClusters;
+    };
+
+    CONNECTIVITY_SNAPSHOT() :
+            m_version( 0 )
+    {}
+
+    /**
+     * @return a number which increases with each ratsnest update of the board.
+     */
+    uint64_t GetVersion() const { return m_version; }
+
+    int GetNetCount() const { return (int) m_nets.size(); }
+
+    /**
+     * @return the items of \a aNet, or an empty list if the net doesn't exist.
+     */
+    const std::vector<KIID>& GetNetItems( int aNet ) const;
+
+    /**
+     * @return the items of each cluster of \a aNet.
+     */
+    const std::vector<std::vector<KIID>>& GetClusters( int aNet ) const;
+
+    /**
+     * @return true if \a aItemA and \a aItemB are in the same cluster of \a aNet.
+     */
+    bool IsConnected( int aNet, const KIID& aItemA, const KIID& aItemB ) const;
+
+    /**
+     * Build the data of a net from its clusters.
+     */
+    static std::shared_ptr<const NET>
+    BuildNet( const std::vector<std::shared_ptr<CN_CLUSTER>>& aClusters );
+
+private:
+    friend class CONNECTIVITY_DATA;
+
+    const NET* getNet( int aNet ) const;
+
+    uint64_t                                m_version;
+    std::vector<std::shared_ptr<const NET>> m_nets;
+};
+
+#endif // CONNECTIVITY_SNAPSHOT_H
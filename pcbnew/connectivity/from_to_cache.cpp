@@ -17,6 +17,7 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <memory>
 #include <reporter.h>
@@ -50,81 +51,158 @@ void FROM_TO_CACHE::buildEndpointList( )
 }
 
 
-enum PATH_STATUS {
-    PS_OK = 0,
-    PS_MULTIPLE_PATHS = -1,
-    PS_NO_PATH = -2
-};
+int FROM_TO_CACHE::graphNode( NET_GRAPH& aGraph, int aNet, CN_ITEM* aItem )
+{
+    auto it = aGraph.m_index.find( aItem );
 
+    if( it != aGraph.m_index.end() )
+        return it->second;
 
-static bool isVertexVisited( CN_ITEM* v, const std::vector<CN_ITEM*>& path )
-{
-    for( CN_ITEM* u : path )
+    auto addNode =
+            [&]( CN_ITEM* aNode )
+            {
+                int index = (int) aGraph.m_nodes.size();
+
+                aGraph.m_nodes.push_back( aNode );
+                aGraph.m_adjacency.emplace_back();
+                aGraph.m_index[aNode] = index;
+                m_graphItemNets[aNode->Parent()] = aNet;
+                return index;
+            };
+
+    int root = addNode( aItem );
+
+    // Gather the items connected to aItem within its net
+    for( int node = root; node < (int) aGraph.m_nodes.size(); ++node )
     {
-        if ( u == v )
-            return true;
+        std::vector<int>& neighbours = aGraph.m_adjacency[node];
+
+        for( CN_ITEM* connected : aGraph.m_nodes[node]->ConnectedItems() )
+        {
+            if( !connected->Valid() || connected->Net() != aNet )
+                continue;
+
+            auto neighbour = aGraph.m_index.find( connected );
+
+            if( neighbour != aGraph.m_index.end() )
+                neighbours.push_back( neighbour->second );
+            else
+                neighbours.push_back( addNode( connected ) );
+        }
+
+        std::sort( neighbours.begin(), neighbours.end() );
+        neighbours.erase( std::unique( neighbours.begin(), neighbours.end() ), neighbours.end() );
     }
 
-    return false;
-}
+    // Find the bridges of the new nodes (Tarjan), without recursion as nets can be long chains
+    // of tracks
+    std::vector<int> order( aGraph.m_nodes.size(), -1 );
+    std::vector<int> low( aGraph.m_nodes.size(), 0 );
+    int              count = 0;
 
+    struct FRAME
+    {
+        int    node;
+        int    parent;
+        size_t next;
+    };
 
-static PATH_STATUS uniquePathBetweenNodes( CN_ITEM* u, CN_ITEM* v, std::vector<CN_ITEM*>& outPath )
-{
-    using Path = std::vector<CN_ITEM*>;
-    std::deque<Path> Q;
+    std::vector<FRAME> stack;
 
-    Path pInit;
-    bool pathFound = false;
-    pInit.push_back( u );
-    Q.push_back( pInit );
+    order[root] = low[root] = count++;
+    stack.push_back( { root, -1, 0 } );
 
-    while( Q.size() )
+    while( !stack.empty() )
     {
-        Path path = Q.front();
-        Q.pop_front();
-        CN_ITEM* last = path.back();
+        FRAME& frame = stack.back();
 
-        if( last == v )
+        if( frame.next < aGraph.m_adjacency[frame.node].size() )
         {
-            outPath = path;
+            int node = frame.node;
+            int next = aGraph.m_adjacency[node][frame.next++];
 
-            if( pathFound )
-                return PS_MULTIPLE_PATHS;
+            if( next == frame.parent )
+                continue;
 
-            pathFound = true;
+            if( order[next] < 0 )
+            {
+                order[next] = low[next] = count++;
+                stack.push_back( { next, node, 0 } );
+            }
+            else
+            {
+                low[node] = std::min( low[node], order[next] );
+            }
         }
-
-        for( CN_ITEM* ci : last->ConnectedItems() )
+        else
         {
-            bool vertexVisited = isVertexVisited( ci, path );
+            int node = frame.node;
+            int parent = frame.parent;
+
+            stack.pop_back();
+
+            if( parent >= 0 )
+            {
+                low[parent] = std::min( low[parent], low[node] );
+
+                if( low[node] > order[parent] )
+                    aGraph.m_bridges.emplace( std::min( node, parent ), std::max( node, parent ) );
+            }
+        }
+    }
+
+    return root;
+}
 
-            for( std::vector<CN_ITEM*>& p : Q )
-                if( isVertexVisited( ci, p ) )
-                {
-                    vertexVisited = true;
-                    break;
-                }
 
-            if( !vertexVisited )
+const std::vector<int>& FROM_TO_CACHE::searchTree( NET_GRAPH& aGraph, int aRoot )
+{
+    auto it = aGraph.m_trees.find( aRoot );
+
+    if( it != aGraph.m_trees.end() )
+        return it->second;
+
+    std::vector<int>& parents = aGraph.m_trees[aRoot];
+    std::deque<int>   queue;
+
+    parents.resize( aGraph.m_nodes.size(), -1 );
+    parents[aRoot] = aRoot;
+    queue.push_back( aRoot );
+
+    while( !queue.empty() )
+    {
+        int node = queue.front();
+        queue.pop_front();
+
+        for( int next : aGraph.m_adjacency[node] )
+        {
+            if( parents[next] < 0 )
             {
-                Path newpath( path );
-                newpath.push_back( ci );
-                Q.push_back( newpath );
+                parents[next] = node;
+                queue.push_back( next );
             }
         }
     }
 
-    return pathFound ? PS_OK : PS_NO_PATH;
-};
+    return parents;
+}
 
 
 int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo )
 {
     std::vector<FT_PATH>                  paths;
+    std::vector<FT_PATH*>&                cachedPaths = m_fromToQueries[ { aFrom, aTo } ];
     std::shared_ptr<CONNECTIVITY_DATA>    connectivity = m_board->GetConnectivity();
     std::shared_ptr<CN_CONNECTIVITY_ALGO> cnAlgo = connectivity->GetConnectivityAlgo();
 
+    auto cnItem =
+            [&]( PAD* aPad ) -> CN_ITEM*
+            {
+                const std::vector<CN_ITEM*>& items = cnAlgo->ItemEntry( aPad ).GetItems();
+
+                return items.empty() ? nullptr : items.front();
+            };
+
     for( FT_ENDPOINT& endpoint : m_ftEndpoints )
     {
         if( WildCompareString( aFrom, endpoint.name, false ) )
@@ -137,84 +215,81 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
         }
     }
 
+    int newPaths = 0;
+
     for( FT_PATH& path : paths )
     {
-        int count = 0;
+        CN_ITEM* cnFrom = cnItem( path.from );
+
+        if( !cnFrom )
+            continue;
+
+        NET_GRAPH&              graph = m_netGraphs[path.net];
+        int                     root = graphNode( graph, path.net, cnFrom );
+        const std::vector<int>& tree = searchTree( graph, root );
+        int                     count = 0;
+        int                     toNode = -1;
 
         wxString fromName = path.from->GetParentFootprint()->GetReference()
                                 + wxT( "-" ) + path.from->GetNumber();
 
-        auto padCandidates = connectivity->GetConnectedItems( path.from,
-                                                              { PCB_PAD_T, PCB_ARC_T, PCB_VIA_T,
-                                                                PCB_TRACE_T } );
-        PAD* toPad = nullptr;
-
-        for( BOARD_CONNECTED_ITEM* pitem : padCandidates )
+        for( int node = 0; node < (int) tree.size(); ++node )
         {
-            if( pitem == path.from )
+            if( tree[node] < 0 || node == root )
                 continue;
 
-            if( pitem->Type() != PCB_PAD_T )
-                continue;
+            BOARD_CONNECTED_ITEM* item = graph.m_nodes[node]->Parent();
 
-            const PAD *pad = static_cast<const PAD*>( pitem );
+            if( item->Type() != PCB_PAD_T || item == path.from )
+                continue;
 
-            wxString toName = pad->GetParentFootprint()->GetReference()
-                                    + wxT( "-" ) + pad->GetNumber();
+            PAD*      pad = static_cast<PAD*>( item );
+            wxString  ref = pad->GetParentFootprint()->GetReference();
+            wxString  toName = ref + wxT( "-" ) + pad->GetNumber();
 
-            for( const FT_ENDPOINT& endpoint : m_ftEndpoints )
+            // Each pad is an endpoint under both of these names
+            for( const wxString& endpointName : { toName, ref } )
             {
-                if( pad == endpoint.parent )
+                if( WildCompareString( aTo, endpointName, false ) )
                 {
-                    if( WildCompareString( aTo, endpoint.name, false ) )
+                    count++;
+
+                    path.to = pad;
+                    path.fromName = fromName;
+                    path.toName = toName;
+                    path.fromWildcard = aFrom;
+                    path.toWildcard = aTo;
+                    toNode = node;
+
+                    if( count >= 2 )
                     {
-                        count++;
-                        toPad = endpoint.parent;
-
-                        path.to = toPad;
-                        path.fromName = fromName;
-                        path.toName = toName;
-                        path.fromWildcard = aFrom;
-                        path.toWildcard = aTo;
-
-                        if( count >= 2 )
-                        {
-                            // fixme: report this somewhere?
-                            path.to = nullptr;
-                        }
+                        // fixme: report this somewhere?
+                        path.to = nullptr;
                     }
                 }
             }
         }
-    }
 
-    int newPaths = 0;
-
-    for( FT_PATH& path : paths )
-    {
-        if( !path.from || !path.to )
+        if( !path.to )
             continue;
 
-        CN_ITEM*              cnFrom = cnAlgo->ItemEntry( path.from ).GetItems().front();
-        CN_ITEM*              cnTo = cnAlgo->ItemEntry( path.to ).GetItems().front();
-        std::vector<CN_ITEM*> upath;
+        // The shortest path is the only one if none of its connections is part of a loop
+        path.isUnique = true;
 
-        auto result = uniquePathBetweenNodes( cnFrom, cnTo, upath );
+        for( int node = toNode; node != root; node = tree[node] )
+        {
+            int parent = tree[node];
 
-        if( result == PS_OK )
-            path.isUnique = true;
-        else
-            path.isUnique = false;
+            if( !graph.m_bridges.count( { std::min( node, parent ), std::max( node, parent ) } ) )
+                path.isUnique = false;
 
-        if( result == PS_NO_PATH )
-            continue;
-
-        for( const auto item : upath )
-        {
-            path.pathItems.insert( item->Parent() );
+            path.pathItems.insert( graph.m_nodes[node]->Parent() );
         }
 
-        m_ftPaths.push_back(path);
+        path.pathItems.insert( graph.m_nodes[root]->Parent() );
+
+        m_ftPaths.push_back( path );
+        cachedPaths.push_back( &m_ftPaths.back() );
         newPaths++;
     }
 
@@ -223,47 +298,169 @@ int FROM_TO_CACHE::cacheFromToPaths( const wxString& aFrom, const wxString& aTo
     return newPaths;
 }
 
-bool  FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo )
+static bool isOnPath( const std::vector<FROM_TO_CACHE::FT_PATH*>& aPaths,
+                      BOARD_CONNECTED_ITEM* aItem )
 {
-    int nFromTosFound = 0;
+    for( const FROM_TO_CACHE::FT_PATH* ftPath : aPaths )
+    {
+        if( ftPath->pathItems.count( aItem ) )
+            return true;
+    }
 
-    if( !m_board )
-        return false;
+    return false;
+}
+
+
+bool FROM_TO_CACHE::IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom,
+                                    const wxString& aTo )
+{
+    const std::pair<wxString, wxString> query( aFrom, aTo );
 
-    for( int attempt = 0; attempt < 2; attempt++ )
     {
-        // item already belongs to path
-        for( FT_PATH& ftPath : m_ftPaths )
+        std::shared_lock<std::shared_mutex> readLock( m_mutex );
+
+        if( m_valid && m_board )
         {
-            if( aFrom == ftPath.fromWildcard && aTo == ftPath.toWildcard )
-            {
-                nFromTosFound++;
+            auto it = m_fromToQueries.find( query );
 
-                if( ftPath.pathItems.count( aItem ) )
-                    return true;
-            }
+            if( it != m_fromToQueries.end() )
+                return isOnPath( it->second, aItem );
         }
+    }
 
-        if( !nFromTosFound )
-            cacheFromToPaths( aFrom, aTo );
-        else
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    if( !m_valid || !m_board )
+    {
+        // Rule resolution outside of DRC may be the first user of the cache
+        BOARD* board = m_board ? m_board : aItem->GetBoard();
+
+        if( !board )
             return false;
+
+        m_board = board;
+        clear();
     }
 
-    return false;
+    // Another thread may have cached the paths while we were waiting for the lock
+    auto it = m_fromToQueries.find( query );
+
+    if( it == m_fromToQueries.end() )
+    {
+        cacheFromToPaths( aFrom, aTo );
+        it = m_fromToQueries.find( query );
+    }
+
+    return isOnPath( it->second, aItem );
+}
+
+
+void FROM_TO_CACHE::clear()
+{
+    m_ftPaths.clear();
+    m_fromToQueries.clear();
+    buildEndpointList();
+    m_valid = true;
+}
+
+
+void FROM_TO_CACHE::Invalidate()
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    m_netGraphs.clear();
+    m_graphItemNets.clear();
+    m_valid = false;
+}
+
+
+void FROM_TO_CACHE::invalidateNet( int aNet )
+{
+    auto it = m_netGraphs.find( aNet );
+
+    if( it != m_netGraphs.end() )
+    {
+        for( CN_ITEM* node : it->second.m_nodes )
+            m_graphItemNets.erase( node->Parent() );
+
+        m_netGraphs.erase( it );
+    }
+
+    m_valid = false;
+}
+
+
+void FROM_TO_CACHE::InvalidateNet( int aNet )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    invalidateNet( aNet );
+}
+
+
+void FROM_TO_CACHE::InvalidateItem( BOARD_ITEM* aItem )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    auto invalidateConnectedItem =
+            [&]( BOARD_CONNECTED_ITEM* aConnectedItem )
+            {
+                auto it = m_graphItemNets.find( aConnectedItem );
+
+                // The item may have moved to another net since its graph was built
+                if( it != m_graphItemNets.end() )
+                    invalidateNet( it->second );
+
+                invalidateNet( aConnectedItem->GetNetCode() );
+            };
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        for( PAD* pad : static_cast<FOOTPRINT*>( aItem )->Pads() )
+            invalidateConnectedItem( pad );
+    }
+    else if( BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( aItem ) )
+    {
+        invalidateConnectedItem( item );
+    }
+
+    m_valid = false;
 }
 
 
 void FROM_TO_CACHE::Rebuild( BOARD* aBoard )
 {
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
     m_board = aBoard;
-    buildEndpointList();
-    m_ftPaths.clear();
+    m_netGraphs.clear();
+    m_graphItemNets.clear();
+    clear();
+}
+
+
+void FROM_TO_CACHE::Update( BOARD* aBoard )
+{
+    std::unique_lock<std::shared_mutex> writeLock( m_mutex );
+
+    if( m_valid && m_board == aBoard )
+        return;
+
+    if( m_board != aBoard )
+    {
+        m_netGraphs.clear();
+        m_graphItemNets.clear();
+    }
+
+    m_board = aBoard;
+    clear();
 }
 
 
 FROM_TO_CACHE::FT_PATH* FROM_TO_CACHE::QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems )
 {
+    std::shared_lock<std::shared_mutex> readLock( m_mutex );
+
     for( FT_PATH& ftPath : m_ftPaths )
     {
         if ( ftPath.pathItems == aItems )
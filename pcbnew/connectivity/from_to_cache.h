@@ -20,11 +20,34 @@
 #ifndef FROM_TO_CACHE_H
 #define FROM_TO_CACHE_H
 
+#include <atomic>
+#include <deque>
+#include <map>
 #include <set>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
 
+#include <wx/string.h>
+
+class BOARD;
+class BOARD_ITEM;
 class PAD;
 class BOARD_CONNECTED_ITEM;
+class CN_ITEM;
 
+/**
+ * Paths between the pads matched by the from and to wildcards of the fromTo() rule function.
+ *
+ * The cache belongs to a CONNECTIVITY_DATA, which invalidates it whenever items are added,
+ * removed or changed.  The paths found for a pair of wildcards therefore stay valid from one
+ * DRC run to the next, and are the same ones rule resolution outside of DRC (e.g. the length
+ * tuning generators) sees.  All public methods may be called from several threads at once.
+ *
+ * Paths are searched in a graph of the connectivity items of each net, which is kept along with
+ * the shortest paths found in it until an item of the net changes.  A path is unique when all
+ * of its connections are bridges of the graph, i.e. when none of them is part of a loop.
+ */
 class FROM_TO_CACHE
 {
 public:
@@ -47,7 +70,8 @@ public:
     };
 
     FROM_TO_CACHE( BOARD* aBoard = nullptr ) :
-        m_board( aBoard )
+        m_board( aBoard ),
+        m_valid( false )
     {
     }
 
@@ -55,20 +79,84 @@ public:
     {
     }
 
+    /**
+     * Discard all cached paths and rebuild the endpoint list of \a aBoard.
+     */
     void Rebuild( BOARD* aBoard );
+
+    /**
+     * Rebuild the cache only if the connectivity changed since it was built, or if it was
+     * built for another board.
+     */
+    void Update( BOARD* aBoard );
+
+    /**
+     * Mark the cached paths as out of date.  They are rebuilt on next use.
+     */
+    void Invalidate();
+
+    /**
+     * Mark the cached paths as out of date and discard the graphs of the nets \a aItem was or
+     * is part of.
+     */
+    void InvalidateItem( BOARD_ITEM* aItem );
+
+    /**
+     * Mark the cached paths as out of date and discard the graph of \a aNet.
+     */
+    void InvalidateNet( int aNet );
+
     bool IsOnFromToPath( BOARD_CONNECTED_ITEM* aItem, const wxString& aFrom, const wxString& aTo );
 
+    /**
+     * @return the cached path made of exactly \a aItems, or nullptr.  The path stays valid
+     *         until the cache is invalidated.
+     */
     FT_PATH* QueryFromToPath( const std::set<BOARD_CONNECTED_ITEM*>& aItems );
 
 private:
+    /**
+     * The connections between the connectivity items of a net.  Connected groups of items are
+     * added as they are queried.
+     */
+    struct NET_GRAPH
+    {
+        std::vector<CN_ITEM*>                   m_nodes;
+        std::vector<std::vector<int>>           m_adjacency;
+        std::unordered_map<const CN_ITEM*, int> m_index;
+
+        /// Connections which aren't part of any loop, as (lower, higher) node indices
+        std::set<std::pair<int, int>>           m_bridges;
+
+        /// Breadth-first search trees, by root node: the parent of each node, or -1
+        std::map<int, std::vector<int>>         m_trees;
+    };
+
+    /**
+     * @return the index in \a aGraph of \a aItem, adding the items connected to it if needed.
+     */
+    int graphNode( NET_GRAPH& aGraph, int aNet, CN_ITEM* aItem );
+
+    const std::vector<int>& searchTree( NET_GRAPH& aGraph, int aRoot );
+
     int cacheFromToPaths( const wxString& aFrom, const wxString& aTo );
     void buildEndpointList();
+    void clear();
+    void invalidateNet( int aNet );
 
 private:
     std::vector<FT_ENDPOINT> m_ftEndpoints;
-    std::vector<FT_PATH>     m_ftPaths;
+    std::deque<FT_PATH>      m_ftPaths;     ///< deque: cached paths never move
+
+    /// The paths found for each pair of wildcards, including pairs which have none
+    std::map<std::pair<wxString, wxString>, std::vector<FT_PATH*>> m_fromToQueries;
+
+    std::map<int, NET_GRAPH>                m_netGraphs;
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, int> m_graphItemNets;
 
     BOARD*                   m_board;
+    std::atomic<bool>        m_valid;
+    std::shared_mutex        m_mutex;
 };
 
 #endif
@@ -56,6 +56,8 @@
 #include <netlist_reader/netlist_reader.h>
 #include <wx/log.h>
 
+#include <unordered_map>
+
 /* Execute a remote command sent via a socket on port KICAD_PCB_PORT_SERVICE_NUMBER
  *
  * Commands are:
@@ -83,7 +85,7 @@ void PCB_EDIT_FRAME::ExecuteRemoteCommand( const char* cmdline )
 
     CROSS_PROBING_SETTINGS& crossProbingSettings = GetPcbNewSettings()->m_CrossProbing;
 
-    KIGFX::VIEW*            view = m_toolManager->GetView();
+    KIGFX::PCB_VIEW*        view = GetCanvas()->GetView();
     KIGFX::RENDER_SETTINGS* renderSettings = view->GetPainter()->GetSettings();
 
     strncpy( line, cmdline, sizeof(line) - 1 );
@@ -115,7 +117,7 @@ void PCB_EDIT_FRAME::ExecuteRemoteCommand( const char* cmdline )
         if( renderSettings->IsHighlightEnabled() )
         {
             renderSettings->SetHighlight( false );
-            view->UpdateAllLayersColor();
+            view->UpdateHighlightColors( pcb );
         }
 
         if( pcb->IsHighLightNetON() )
@@ -247,7 +249,7 @@ void PCB_EDIT_FRAME::ExecuteRemoteCommand( const char* cmdline )
         FocusOnLocation( bbox.Centre() );
     }
 
-    view->UpdateAllLayersColor();
+    view->UpdateHighlightColors( pcb );
 
     // Ensure the display is refreshed, because in some installs the refresh is done only
     // when the gal canvas has the focus, and that is not the case when crossprobing from
@@ -383,9 +385,9 @@ void PCB_EDIT_FRAME::SendSelectItemsToSch( const std::deque<EDA_ITEM*>& aItems,
     if( parts.empty() )
         return;
 
-    for( wxString part : parts )
+    for( const wxString& part : parts )
     {
-        command += part;
+        command += part.ToStdString();
         command += ",";
     }
 
@@ -452,6 +454,37 @@ std::vector<BOARD_ITEM*> PCB_EDIT_FRAME::FindItemsFromSyncSelection( std::string
 {
     wxArrayString syncArray = wxStringTokenize( syncStr, "," );
 
+    // Index the sync entries by (escaped) reference first, so that each footprint is looked up
+    // instead of being compared against every entry.  Selections can hold thousands of both.
+    std::vector<std::pair<unsigned, wxString>>                                 sheetEntries;
+    std::unordered_map<wxString, std::vector<unsigned>>                        footprintEntries;
+    std::unordered_map<wxString, std::vector<std::pair<unsigned, wxString>>>   padEntries;
+
+    for( unsigned index = 0; index < syncArray.size(); ++index )
+    {
+        const wxString& syncEntry = syncArray[index];
+
+        if( syncEntry.empty() )
+            continue;
+
+        wxString syncData = syncEntry.substr( 1 );
+
+        switch( syncEntry.GetChar( 0 ).GetValue() )
+        {
+        case 'S': // Select sheet with subsheets: S<Sheet path>
+            sheetEntries.emplace_back( index, syncData );
+            break;
+        case 'F': // Select footprint: F<Reference>
+            footprintEntries[syncData].push_back( index );
+            break;
+        case 'P': // Select pad: P<Footprint reference>/<Pad number>
+            padEntries[syncData.BeforeFirst( '/' )].emplace_back(
+                    index, UnescapeString( syncData.AfterFirst( '/' ) ) );
+            break;
+        default: break;
+        }
+    }
+
     std::vector<std::pair<int, BOARD_ITEM*>> orderPairs;
 
     for( FOOTPRINT* footprint : GetBoard()->Footprints() )
@@ -459,65 +492,49 @@ std::vector<BOARD_ITEM*> PCB_EDIT_FRAME::FindItemsFromSyncSelection( std::string
         if( footprint == nullptr )
             continue;
 
-        wxString fpSheetPath = footprint->GetPath().AsString().BeforeLast( '/' );
-        wxString fpUUID = footprint->m_Uuid.AsString();
+        if( !sheetEntries.empty() )
+        {
+            wxString fpSheetPath = footprint->GetPath().AsString().BeforeLast( '/' );
+
+            if( fpSheetPath.IsEmpty() )
+                fpSheetPath += '/';
 
-        if( fpSheetPath.IsEmpty() )
-            fpSheetPath += '/';
+            for( const auto& [index, sheetPath] : sheetEntries )
+            {
+                if( fpSheetPath.StartsWith( sheetPath ) )
+                    orderPairs.emplace_back( index, footprint );
+            }
+        }
 
-        if( fpUUID.empty() )
+        if( footprintEntries.empty() && padEntries.empty() )
             continue;
 
         wxString fpRefEscaped = EscapeString( footprint->GetReference(), CTX_IPC );
 
-        for( unsigned index = 0; index < syncArray.size(); ++index )
-        {
-            wxString syncEntry = syncArray[index];
+        auto fpIt = footprintEntries.find( fpRefEscaped );
 
-            if( syncEntry.empty() )
-                continue;
+        if( fpIt != footprintEntries.end() )
+        {
+            for( unsigned index : fpIt->second )
+                orderPairs.emplace_back( index, footprint );
+        }
 
-            wxString syncData = syncEntry.substr( 1 );
+        auto padIt = padEntries.find( fpRefEscaped );
 
-            switch( syncEntry.GetChar( 0 ).GetValue() )
-            {
-            case 'S': // Select sheet with subsheets: S<Sheet path>
-                if( fpSheetPath.StartsWith( syncData ) )
-                {
-                    orderPairs.emplace_back( index, footprint );
-                }
-                break;
-            case 'F': // Select footprint: F<Reference>
-                if( syncData == fpRefEscaped )
-                {
-                    orderPairs.emplace_back( index, footprint );
-                }
-                break;
-            case 'P': // Select pad: P<Footprint reference>/<Pad number>
+        if( padIt != padEntries.end() )
+        {
+            for( const auto& [index, padNumber] : padIt->second )
             {
-                if( syncData.StartsWith( fpRefEscaped ) )
+                for( PAD* pad : footprint->Pads() )
                 {
-                    wxString selectPadNumberEscaped =
-                            syncData.substr( fpRefEscaped.size() + 1 ); // Skips the slash
-
-                    wxString selectPadNumber = UnescapeString( selectPadNumberEscaped );
-
-                    for( PAD* pad : footprint->Pads() )
-                    {
-                        if( selectPadNumber == pad->GetNumber() )
-                        {
-                            orderPairs.emplace_back( index, pad );
-                        }
-                    }
+                    if( padNumber == pad->GetNumber() )
+                        orderPairs.emplace_back( index, pad );
                 }
-                break;
-            }
-            default: break;
             }
         }
     }
 
-    std::sort(
+    std::stable_sort(
             orderPairs.begin(), orderPairs.end(),
             []( const std::pair<int, BOARD_ITEM*>& a, const std::pair<int, BOARD_ITEM*>& b ) -> bool
             {
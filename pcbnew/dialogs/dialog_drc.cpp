@@ -133,6 +133,7 @@ DIALOG_DRC::DIALOG_DRC( PCB_EDIT_FRAME* aEditorFrame, wxWindow* aParent ) :
 
     m_cbRefillZones->SetValue( cfg->m_DrcDialog.refill_zones );
     m_cbReportAllTrackErrors->SetValue( cfg->m_DrcDialog.test_all_track_errors );
+    m_cbUseResultCache->SetValue( cfg->m_DrcDialog.use_result_cache );
 
     if( !Kiface().IsSingle() )
         m_cbTestFootprints->SetValue( cfg->m_DrcDialog.test_footprints );
@@ -175,6 +176,7 @@ DIALOG_DRC::~DIALOG_DRC()
     {
         cfg->m_DrcDialog.refill_zones          = m_cbRefillZones->GetValue();
         cfg->m_DrcDialog.test_all_track_errors = m_cbReportAllTrackErrors->GetValue();
+        cfg->m_DrcDialog.use_result_cache      = m_cbUseResultCache->GetValue();
 
         if( !Kiface().IsSingle() )
             cfg->m_DrcDialog.test_footprints   = m_cbTestFootprints->GetValue();
@@ -252,6 +254,7 @@ void DIALOG_DRC::OnRunDRCClick( wxCommandEvent& aEvent )
     bool              refillZones          = m_cbRefillZones->GetValue();
     bool              reportAllTrackErrors = m_cbReportAllTrackErrors->GetValue();
     bool              testFootprints       = m_cbTestFootprints->GetValue();
+    bool              useResultCache       = m_cbUseResultCache->GetValue();
 
     if( zoneFillerTool->IsBusy() )
     {
@@ -317,7 +320,7 @@ void DIALOG_DRC::OnRunDRCClick( wxCommandEvent& aEvent )
 
     {
     wxBusyCursor dummy;
-    drcTool->RunTests( this, refillZones, reportAllTrackErrors, testFootprints );
+    drcTool->RunTests( this, refillZones, reportAllTrackErrors, testFootprints, useResultCache );
     }
 
     if( m_cancelled )
@@ -41,6 +41,11 @@ DIALOG_DRC_BASE::DIALOG_DRC_BASE( wxWindow* parent, wxWindowID id, const wxStrin
 	m_cbTestFootprints = new wxCheckBox( this, wxID_ANY, _("Test for parity between PCB and schematic"), wxDefaultPosition, wxDefaultSize, 0 );
 	bSizerOptSettings->Add( m_cbTestFootprints, 0, wxALL, 5 );
 
+	m_cbUseResultCache = new wxCheckBox( this, wxID_ANY, _("Only re-test items changed since the last run"), wxDefaultPosition, wxDefaultSize, 0 );
+	m_cbUseResultCache->SetToolTip( _("If selected, the results of the last run are stored next to the board file, and the violations between unchanged items are taken from there instead of being tested again.") );
+
+	bSizerOptSettings->Add( m_cbUseResultCache, 0, wxBOTTOM|wxRIGHT|wxLEFT, 5 );
+
 
 	bSizerOptions->Add( bSizerOptSettings, 1, wxEXPAND|wxTOP|wxRIGHT|wxLEFT, 5 );
 
@@ -52,6 +52,7 @@ class DIALOG_DRC_BASE : public DIALOG_SHIM
 		wxCheckBox* m_cbRefillZones;
 		wxCheckBox* m_cbReportAllTrackErrors;
 		wxCheckBox* m_cbTestFootprints;
+		wxCheckBox* m_cbUseResultCache;
 		wxSimplebook* m_runningResultsBook;
 		wxPanel* running;
 		wxNotebook* m_runningNotebook;
@@ -25,6 +25,7 @@
  */
 
 #include <bitmaps.h>
+#include <core/thread_pool.h>
 #include <footprint.h>
 #include <pad.h>
 #include <dialog_exchange_footprints.h>
@@ -299,12 +300,13 @@ void DIALOG_EXCHANGE_FOOTPRINTS::OnOKClicked( wxCommandEvent& event )
 
     processMatchingFootprints();
 
-    m_parent->Compile_Ratsnest( true );
-    m_parent->GetCanvas()->Refresh();
-
     m_MessageWindow->Flush( false );
 
+    // All the exchanges go into a single commit, so connectivity and the ratsnest are rebuilt
+    // once, when it is pushed.
     m_commit.Push( wxT( "Changed footprint" ) );
+
+    m_parent->GetCanvas()->Refresh();
 }
 
 
@@ -323,9 +325,12 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processMatchingFootprints()
             return;
     }
 
+    std::vector<FOOTPRINT*> footprints;
+    std::vector<LIB_ID>     fpids;
+
     /*
-     * NB: the change is done from the last footprint because processFootprint() modifies the
-     * last item in the list.
+     * NB: the change is done from the last footprint, to keep the order in which they are
+     * reported unchanged.
      */
     for( auto it = m_parent->GetBoard()->Footprints().rbegin();
             it != m_parent->GetBoard()->Footprints().rend(); it++ )
@@ -335,20 +340,50 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processMatchingFootprints()
         if( !isMatch( footprint ) )
             continue;
 
-        if( m_updateMode )
-            processFootprint( footprint, footprint->GetFPID() );
-        else
-            processFootprint( footprint, newFPID );
+        footprints.push_back( footprint );
+        fpids.push_back( m_updateMode ? footprint->GetFPID() : newFPID );
     }
+
+    if( footprints.empty() )
+        return;
+
+    // Read each library footprint once, then build the replacement for every board footprint
+    // (and compare it against the board version) concurrently.  Only the exchange itself,
+    // which edits the board and the commit, is left serial.
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> libFootprints =
+            m_parent->LoadLibraryFootprints( fpids );
+
+    std::vector<FOOTPRINT*> newFootprints( footprints.size(), nullptr );
+    std::vector<char>       needsUpdate( footprints.size(), true );
+
+    ParallelFor( footprints.size(),
+            [&]( size_t ii )
+            {
+                auto libFootprint = libFootprints.find( fpids[ii] );
+
+                if( libFootprint == libFootprints.end() || !libFootprint->second )
+                    return;
+
+                FOOTPRINT* newFootprint =
+                        static_cast<FOOTPRINT*>( libFootprint->second->Duplicate() );
+
+                if( m_updateMode )
+                    needsUpdate[ii] = footprints[ii]->FootprintNeedsUpdate( newFootprint );
+
+                newFootprints[ii] = newFootprint;
+            } );
+
+    for( size_t ii = 0; ii < footprints.size(); ++ii )
+        processFootprint( footprints[ii], fpids[ii], newFootprints[ii], needsUpdate[ii] );
 }
 
 
-void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const LIB_ID& aNewFPID )
+void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const LIB_ID& aNewFPID,
+                                                   FOOTPRINT* aNewFootprint, bool aNeedsUpdate )
 {
     LIB_ID    oldFPID = aFootprint->GetFPID();
     wxString  msg;
 
-    // Load new footprint.
     if( m_updateMode )
     {
         msg.Printf( _( "Updated footprint %s (%s)" ) + wxS( ": " ),
@@ -363,18 +398,16 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const
                     aNewFPID.Format().c_str() );
     }
 
-    FOOTPRINT* newFootprint = m_parent->LoadFootprint( aNewFPID );
-
-    if( !newFootprint )
+    if( !aNewFootprint )
     {
         msg += _( "*** library footprint not found ***" );
         m_MessageWindow->Report( msg, RPT_SEVERITY_ERROR );
         return;
     }
 
-    bool updated = !m_updateMode || aFootprint->FootprintNeedsUpdate( newFootprint );
+    bool updated = !m_updateMode || aNeedsUpdate;
 
-    m_parent->ExchangeFootprint( aFootprint, newFootprint, m_commit,
+    m_parent->ExchangeFootprint( aFootprint, aNewFootprint, m_commit,
                                  m_removeExtraBox->GetValue(),
                                  m_resetTextItemLayers->GetValue(),
                                  m_resetTextItemEffects->GetValue(),
@@ -383,7 +416,7 @@ void DIALOG_EXCHANGE_FOOTPRINTS::processFootprint( FOOTPRINT* aFootprint, const
                                  &updated );
 
     if( aFootprint == m_currentFootprint )
-        m_currentFootprint = newFootprint;
+        m_currentFootprint = aNewFootprint;
 
     if( m_updateMode && !updated )
     {
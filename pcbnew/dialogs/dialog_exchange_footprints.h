@@ -54,7 +54,8 @@ private:
 
     bool isMatch( FOOTPRINT* );
     void processMatchingFootprints();
-    void processFootprint( FOOTPRINT* aFootprint, const LIB_ID& aNewFPID );
+    void processFootprint( FOOTPRINT* aFootprint, const LIB_ID& aNewFPID,
+                           FOOTPRINT* aNewFootprint, bool aNeedsUpdate );
 
     BOARD_COMMIT    m_commit;
     PCB_EDIT_FRAME* m_parent;
@@ -50,6 +50,7 @@
 #include <wx/wupdlock.h>
 
 #include <bitset>
+#include <set>
 #include <vector>
 
 
@@ -1434,9 +1435,12 @@ void DIALOG_NET_INSPECTOR::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardIt
 
 void DIALOG_NET_INSPECTOR::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItem )
 {
-    for( BOARD_ITEM* item : aBoardItem )
+    if( aBoardItem.size() == 1 )
+        OnBoardItemAdded( aBoard, aBoardItem.front() );
+    else if( !updateTrackLengths( aBoardItem, true ) )
     {
-        OnBoardItemAdded( aBoard, item );
+        buildNetsList();
+        m_netsList->Refresh();
     }
 }
 
@@ -1502,9 +1506,12 @@ void DIALOG_NET_INSPECTOR::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoard
 void DIALOG_NET_INSPECTOR::OnBoardItemsRemoved( BOARD& aBoard,
                                                 std::vector<BOARD_ITEM*>& aBoardItems )
 {
-    for( BOARD_ITEM* item : aBoardItems )
+    if( aBoardItems.size() == 1 )
+        OnBoardItemRemoved( aBoard, aBoardItems.front() );
+    else if( !updateTrackLengths( aBoardItems, false ) )
     {
-        OnBoardItemRemoved( aBoard, item );
+        buildNetsList();
+        m_netsList->Refresh();
     }
 }
 
@@ -1562,6 +1569,68 @@ void DIALOG_NET_INSPECTOR::OnBoardNetSettingsChanged( BOARD& aBoard )
 }
 
 
+bool DIALOG_NET_INSPECTOR::updateTrackLengths( const std::vector<BOARD_ITEM*>& aItems,
+                                               bool aAdded )
+{
+    // Only tracks of listed nets can be accounted for row by row.  Anything else needs the
+    // nodes of its nets recounted, and a single rebuild beats updating the nets one by one.
+    for( BOARD_ITEM* item : aItems )
+    {
+        PCB_TRACK* track = dynamic_cast<PCB_TRACK*>( item );
+
+        if( !track || !m_data_model->findItem( track->GetNet() ) )
+            return false;
+    }
+
+    std::set<int> changedNets;
+
+    for( BOARD_ITEM* item : aItems )
+    {
+        PCB_TRACK*                    track = static_cast<PCB_TRACK*>( item );
+        std::optional<LIST_ITEM_ITER> r = m_data_model->findItem( track->GetNet() );
+        const std::unique_ptr<LIST_ITEM>& list_item = *r.value();
+        int                           len = track->GetLength();
+        int                           layer = static_cast<int>( track->GetLayer() );
+
+        if( aAdded )
+            list_item->AddLayerWireLength( len, layer );
+        else
+            list_item->SubLayerWireLength( len, layer );
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            if( aAdded )
+            {
+                list_item->AddViaCount( 1 );
+                list_item->AddViaLength( calculateViaLength( track ) );
+            }
+            else
+            {
+                list_item->SubViaCount( 1 );
+                list_item->SubViaLength( calculateViaLength( track ) );
+            }
+        }
+
+        changedNets.insert( track->GetNetCode() );
+    }
+
+    // Restore the selection once for all the rows rather than once per row
+    wxDataViewItemArray sel;
+    m_netsList->GetSelections( sel );
+
+    for( int netCode : changedNets )
+        m_data_model->updateItem( m_data_model->findItem( netCode ) );
+
+    if( !sel.IsEmpty() )
+    {
+        m_netsList->SetSelections( sel );
+        m_netsList->EnsureVisible( sel.Item( 0 ) );
+    }
+
+    return true;
+}
+
+
 void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
 {
     // something for the specified net has changed, update that row.
@@ -78,6 +78,8 @@ private:
     std::vector<CN_ITEM*> relevantConnectivityItems() const;
     bool                  netFilterMatches( NETINFO_ITEM* aNet ) const;
     void                  updateNet( NETINFO_ITEM* aNet );
+    bool                  updateTrackLengths( const std::vector<BOARD_ITEM*>& aItems,
+                                              bool aAdded );
     unsigned int          calculateViaLength( const PCB_TRACK* ) const;
 
     void onSelChanged( wxDataViewEvent& event ) override;
@@ -46,6 +46,7 @@
 #include <tools/drc_tool.h>
 #include <math/util.h>      // for KiROUND
 #include <macros.h>
+#include <core/thread_pool.h>
 
 #include <wx/dirdlg.h>
 
@@ -1173,6 +1174,17 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
 
     wxBusyCursor dummy;
 
+    // The layers are independent files: list them first, then plot them in parallel
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID m_layer;
+        LSEQ         m_sequence;
+        wxString     m_fullPath;
+        bool         m_success = false;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+
     for( LSEQ seq = m_plotOpts.GetLayerSelection().UIOrder();  seq;  ++seq )
     {
         LSEQ plotSequence;
@@ -1223,34 +1235,54 @@ void DIALOG_PLOT::Plot( wxCommandEvent& event )
         wxString fullname = fn.GetFullName();
         jobfile_writer.AddGbrFile( layer, fullname );
 
+        layerPlots.push_back( { layer, plotSequence, fn.GetFullPath() } );
+    }
+
+    PrepareBoardForParallelPlot( board );
+
+    {
+        // Keep the C locale for all the plotting threads
         LOCALE_IO toggle;
 
-        //@todo allow controlling the sheet name and path that will be displayed in the title block
-        // Leave blank for now
-        PLOTTER* plotter = StartPlotBoard( board, &m_plotOpts, layer, fn.GetFullPath(),
-                                           wxEmptyString, wxEmptyString );
+        ParallelFor( layerPlots.size(),
+                     [&]( size_t aIndex )
+                     {
+                         LAYER_PLOT& layerPlot = layerPlots[aIndex];
+
+                         //@todo allow controlling the sheet name and path that will be displayed
+                         // in the title block.  Leave blank for now
+                         PLOTTER* plotter = StartPlotBoard( board, &m_plotOpts, layerPlot.m_layer,
+                                                            layerPlot.m_fullPath, wxEmptyString,
+                                                            wxEmptyString );
+
+                         if( plotter )
+                         {
+                             PlotBoardLayers( board, plotter, layerPlot.m_sequence, m_plotOpts );
+                             PlotInteractiveLayer( board, plotter, m_plotOpts );
+                             plotter->EndPlot();
+                             delete plotter->RenderSettings();
+                             delete plotter;
+
+                             layerPlot.m_success = true;
+                         }
+                     } );
+    }
 
-        // Print diags in messages box:
+    // Print diags in messages box:
+    for( const LAYER_PLOT& layerPlot : layerPlots )
+    {
         wxString msg;
 
-        if( plotter )
+        if( layerPlot.m_success )
         {
-            PlotBoardLayers( board, plotter, plotSequence, m_plotOpts );
-            PlotInteractiveLayer( board, plotter, m_plotOpts );
-            plotter->EndPlot();
-            delete plotter->RenderSettings();
-            delete plotter;
-
-            msg.Printf( _( "Plotted to '%s'." ), fn.GetFullPath() );
+            msg.Printf( _( "Plotted to '%s'." ), layerPlot.m_fullPath );
             reporter.Report( msg, RPT_SEVERITY_ACTION );
         }
         else
         {
-            msg.Printf( _( "Failed to create file '%s'." ), fn.GetFullPath() );
+            msg.Printf( _( "Failed to create file '%s'." ), layerPlot.m_fullPath );
             reporter.Report( msg, RPT_SEVERITY_ERROR );
         }
-
-        wxSafeYield();      // displays report message.
     }
 
     if( m_plotOpts.GetFormat() == PLOT_FORMAT::GERBER && m_plotOpts.GetCreateGerberJobFile() )
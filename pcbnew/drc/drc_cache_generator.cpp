@@ -30,6 +30,9 @@
 #include <drc/drc_engine.h>
 #include <drc/drc_rtree.h>
 #include <drc/drc_cache_generator.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_rule_condition.h>
+#include <pcbexpr_evaluator.h>
 
 bool DRC_CACHE_GENERATOR::Run()
 {
@@ -52,8 +55,12 @@ bool DRC_CACHE_GENERATOR::Run()
 
     std::set<ZONE*> allZones;
 
+    // In incremental runs everything below is restricted to the area under test
     for( ZONE* zone : m_board->Zones() )
     {
+        if( !m_drcEngine->IsInScope( zone ) )
+            continue;
+
         allZones.insert( zone );
 
         if( !zone->GetIsRuleArea() )
@@ -71,6 +78,9 @@ bool DRC_CACHE_GENERATOR::Run()
     {
         for( ZONE* zone : footprint->Zones() )
         {
+            if( !m_drcEngine->IsInScope( zone ) )
+                continue;
+
             allZones.insert( zone );
 
             if( !zone->GetIsRuleArea() )
@@ -83,22 +93,13 @@ bool DRC_CACHE_GENERATOR::Run()
         }
     }
 
-    size_t              count = 0;
-    std::atomic<size_t> done( 1 );
-
-    auto countItems =
-            [&]( BOARD_ITEM* item ) -> bool
-            {
-                ++count;
-                return true;
-            };
+    size_t                                    count = 0;
+    std::atomic<size_t>                       done( 1 );
+    std::vector<std::pair<BOARD_ITEM*, LSET>> copperItems;
 
-    auto addToCopperTree =
+    auto gatherItems =
             [&]( BOARD_ITEM* item ) -> bool
             {
-                if( m_drcEngine->IsCancelled() )
-                    return false;
-
                 LSET copperLayers = item->GetLayerSet() & boardCopperLayers;
 
                 // Special-case pad holes which pierce all the copper layers
@@ -110,16 +111,37 @@ bool DRC_CACHE_GENERATOR::Run()
                         copperLayers = boardCopperLayers;
                 }
 
-                for( PCB_LAYER_ID layer : copperLayers.Seq() )
+                if( copperLayers.any() )
                 {
-                    if( IsCopperLayer( layer ) )
-                        m_board->m_CopperItemRTreeCache->Insert( item, layer, largestClearance );
+                    copperItems.emplace_back( item, copperLayers );
+                    count += copperLayers.count();
                 }
 
-                done.fetch_add( 1 );
                 return true;
             };
 
+    // Each copper layer is filled and packed by its own task
+    auto buildCopperLayer =
+            [&]( PCB_LAYER_ID aLayer ) -> size_t
+            {
+                DRC_RTREE* copperTree = m_board->m_CopperItemRTreeCache.get();
+
+                for( const auto& [ item, copperLayers ] : copperItems )
+                {
+                    if( !copperLayers.test( aLayer ) )
+                        continue;
+
+                    if( m_drcEngine->IsCancelled() )
+                        return 0;
+
+                    copperTree->Insert( item, aLayer, largestClearance );
+                    done.fetch_add( 1 );
+                }
+
+                copperTree->Build( aLayer );
+                return 1;
+            };
+
     if( !reportPhase( _( "Gathering copper items..." ) ) )
         return false;   // DRC cancelled
 
@@ -131,35 +153,44 @@ bool DRC_CACHE_GENERATOR::Run()
         PCB_DIMENSION_T
     };
 
-    forEachGeometryItem( itemTypes, LSET::AllCuMask(), countItems );
+    forEachGeometryItem( itemTypes, LSET::AllCuMask(), gatherItems );
 
-    std::future<void> retn = tp.submit(
-            [&]()
-            {
-                std::unique_lock<std::mutex> cacheLock( m_board->m_CachesMutex );
+    {
+        std::unique_lock<std::mutex> cacheLock( m_board->m_CachesMutex );
 
-                if( !m_board->m_CopperItemRTreeCache )
-                    m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
+        if( !m_board->m_CopperItemRTreeCache )
+            m_board->m_CopperItemRTreeCache = std::make_shared<DRC_RTREE>();
+    }
 
-                forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
-            } );
+    std::vector<std::future<size_t>> layerReturns;
+    std::future_status               status;
 
-    std::future_status status = retn.wait_for( std::chrono::milliseconds( 250 ) );
+    for( PCB_LAYER_ID layer : boardCopperLayers.Seq() )
+        layerReturns.emplace_back( tp.submit( buildCopperLayer, layer ) );
 
-    while( status != std::future_status::ready )
+    for( const std::future<size_t>& ret : layerReturns )
     {
-        reportProgress( done, count );
-        status = retn.wait_for( std::chrono::milliseconds( 250 ) );
+        status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+        while( status != std::future_status::ready )
+        {
+            reportProgress( done, count );
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        }
     }
 
+    // Only marks the tree as built: the layers are packed already
+    m_board->m_CopperItemRTreeCache->Build();
+
     if( !reportPhase( _( "Tessellating copper zones..." ) ) )
         return false;   // DRC cancelled
 
     // Cache zone bounding boxes, triangulation, copper zone rtrees, and footprint courtyards
     // before we start.
 
+    // Only rebuilds the courtyards which changed since they were last built
     for( FOOTPRINT* footprint : m_board->Footprints() )
-        footprint->BuildCourtyardCaches();
+        footprint->GetCourtyard( F_CrtYd );
 
     std::vector<std::future<size_t>> returns;
 
@@ -176,13 +207,11 @@ bool DRC_CACHE_GENERATOR::Run()
 
                 if( !aZone->GetIsRuleArea() && aZone->IsOnCopperLayer() )
                 {
-                   std::unique_ptr<DRC_RTREE> rtree = std::make_unique<DRC_RTREE>();
+                   // The zone filler leaves the index of the fill it made with the zone
+                   std::shared_ptr<DRC_RTREE> rtree = aZone->GetFillRTree();
 
-                   for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
-                   {
-                       if( IsCopperLayer( layer ) )
-                           rtree->Insert( aZone, layer );
-                   }
+                   if( !rtree )
+                       rtree = aZone->BuildFillRTree();
 
                    std::unique_lock<std::mutex> cacheLock( m_board->m_CachesMutex );
                    m_board->m_CopperZoneRTreeCache[ aZone ] = std::move( rtree );
@@ -209,8 +238,16 @@ bool DRC_CACHE_GENERATOR::Run()
         }
     }
 
+    if( !cacheAreaTests() )
+        return false;   // DRC cancelled
+
     m_board->m_ZoneIsolatedIslandsMap.clear();
 
+    // Incremental runs rely on the connectivity kept up to date by the commits, and their
+    // providers don't look at islands
+    if( m_drcEngine->IsIncremental() )
+        return !m_drcEngine->IsCancelled();
+
     for( ZONE* zone : m_board->Zones() )
     {
         if( !zone->GetIsRuleArea() && !zone->IsTeardropArea() )
@@ -229,3 +266,111 @@ bool DRC_CACHE_GENERATOR::Run()
     return !m_drcEngine->IsCancelled();
 }
 
+
+bool DRC_CACHE_GENERATOR::cacheAreaTests()
+{
+    // Whether the rules naming each area are evaluated for each layer too: the implicit keepout
+    // rules only give disallow constraints, which are evaluated without a layer
+    std::map<wxString, bool> areaArgs;
+
+    // Function names are case-insensitive
+    for( const std::shared_ptr<DRC_RULE>& rule : m_drcEngine->GetRules() )
+    {
+        if( !rule->m_Condition )
+            continue;
+
+        wxString expr = rule->m_Condition->GetExpression();
+        wxString lowerExpr = expr.Lower();
+
+        for( const wxString& func : { wxString( wxT( "intersectsarea(" ) ),
+                                      wxString( wxT( "insidearea(" ) ) } )
+        {
+            for( size_t pos = lowerExpr.find( func ); pos != wxString::npos;
+                 pos = lowerExpr.find( func, pos + 1 ) )
+            {
+                size_t start = pos + func.length();
+
+                while( start < expr.length() && expr[start] == ' ' )
+                    start++;
+
+                if( start >= expr.length() || ( expr[start] != '\'' && expr[start] != '"' ) )
+                    continue;
+
+                size_t end = expr.find( expr[start], start + 1 );
+
+                if( end == wxString::npos )
+                    continue;
+
+                wxString arg = expr.Mid( start + 1, end - start - 1 );
+
+                // The items tested aren't known yet
+                if( arg != wxT( "A" ) && arg != wxT( "B" ) && !arg.IsEmpty() )
+                    areaArgs[arg] |= !rule->m_Implicit;
+            }
+        }
+    }
+
+    if( areaArgs.empty() )
+        return true;
+
+    if( !reportPhase( _( "Testing rule areas..." ) ) )
+        return false;   // DRC cancelled
+
+    std::map<ZONE*, bool> areaMap;
+    PCBEXPR_CONTEXT       searchCtx( 0, UNDEFINED_LAYER );
+
+    for( const auto& [arg, perLayer] : areaArgs )
+    {
+        searchAreas( m_board, arg, &searchCtx,
+                     [&]( ZONE* aArea )
+                     {
+                         areaMap[aArea] |= perLayer;
+                         return false;
+                     } );
+    }
+
+    std::vector<std::pair<ZONE*, bool>> areas( areaMap.begin(), areaMap.end() );
+    std::vector<BOARD_ITEM*>            items;
+
+    if( areas.empty() )
+        return true;
+
+    forEachGeometryItem( {}, LSET::AllLayersMask(),
+            [&]( BOARD_ITEM* item ) -> bool
+            {
+                items.push_back( item );
+                return true;
+            } );
+
+    ParallelFor( items.size(),
+            [&]( size_t ii )
+            {
+                if( m_drcEngine->IsCancelled() )
+                    return;
+
+                BOARD_ITEM* item = items[ii];
+                BOX2I       itemBBox = item->GetBoundingBox();
+
+                for( const auto& [area, perLayer] : areas )
+                {
+                    LSET commonLayers = area->GetLayerSet() & item->GetLayerSet();
+
+                    if( !commonLayers.any() || !area->GetBoundingBox().Intersects( itemBBox ) )
+                        continue;
+
+                    PCBEXPR_CONTEXT ctx( 0, UNDEFINED_LAYER );
+                    testIntersectsArea( item, itemBBox, area, &ctx );
+
+                    if( !perLayer )
+                        continue;
+
+                    for( PCB_LAYER_ID layer : commonLayers.Seq() )
+                    {
+                        PCBEXPR_CONTEXT layerCtx( 0, layer );
+                        testIntersectsArea( item, itemBBox, area, &layerCtx );
+                    }
+                }
+            } );
+
+    return !m_drcEngine->IsCancelled();
+}
@@ -43,6 +43,13 @@ public:
     }
 
     virtual bool Run() override;
+
+private:
+    /**
+     * Test the items against the rule areas named in the intersectsArea() calls of the rules,
+     * in parallel, filling the area test cache of the board before the rules are evaluated.
+     */
+    bool cacheAreaTests();
 };
 
 
@@ -24,6 +24,8 @@
  */
 
 #include <atomic>
+#include <chrono>
+#include <tuple>
 #include <reporter.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
@@ -36,12 +38,20 @@
 #include <drc/drc_test_provider.h>
 #include <drc/drc_item.h>
 #include <drc/drc_cache_generator.h>
+#include <drc/drc_incremental_scope.h>
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
+#include <core/task_graph.h>
 #include <core/thread_pool.h>
+#include <core/trace_profiler.h>
+#include <geometry/geometry_arena.h>
+#include <hash.h>
+#include <netclass.h>
 #include <zone.h>
 
+#include <wx/ffile.h>
+
 
 // wxListBox's performance degrades horrifically with very large datasets.  It's not clear
 // they're useful to the user anyway.
@@ -49,6 +59,67 @@
 #define EXTENDED_ERROR_LIMIT 499
 
 
+/**
+ * Output of a provider run concurrently with other providers.
+ *
+ * Violations and messages are queued here and handed to the violation handler and reporters
+ * from the DRC thread in provider order, so the output does not depend on which provider
+ * happened to finish first.
+ */
+struct DRC_PROVIDER_LOG
+{
+    enum ENTRY_TYPE
+    {
+        VIOLATION,
+        AUX,
+        PHASE
+    };
+
+    struct ENTRY
+    {
+        ENTRY_TYPE                m_type;
+        std::shared_ptr<DRC_ITEM> m_item;
+        VECTOR2I                  m_pos;
+        int                       m_layer;
+        wxString                  m_text;
+    };
+
+    DRC_PROVIDER_LOG( const DRC_ENGINE* aEngine, bool aOnCallerThread ) :
+            m_engine( aEngine ),
+            m_onCallerThread( aOnCallerThread ),
+            m_finished( false ),
+            m_aborted( false )
+    {}
+
+    void Add( ENTRY aEntry )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_entries.push_back( std::move( aEntry ) );
+    }
+
+    std::vector<ENTRY> Take()
+    {
+        std::vector<ENTRY>          entries;
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        entries.swap( m_entries );
+        return entries;
+    }
+
+    const DRC_ENGINE*  m_engine;
+    bool               m_onCallerThread;    ///< false when running on a pool thread
+    std::atomic<bool>  m_finished;
+    std::atomic<bool>  m_aborted;           ///< the provider's Run() returned false
+
+    std::mutex         m_mutex;
+    std::vector<ENTRY> m_entries;
+};
+
+
+/// The log of the provider running on this thread, if it runs concurrently with others
+static thread_local DRC_PROVIDER_LOG* s_threadLog = nullptr;
+
+
 void drcPrintDebugMessage( int level, const wxString& msg, const char *function, int line )
 {
     wxString valueStr;
@@ -70,13 +141,19 @@ DRC_ENGINE::DRC_ENGINE( BOARD* aBoard, BOARD_DESIGN_SETTINGS *aSettings ) :
     m_drawingSheet( nullptr ),
     m_schematicNetlist( nullptr ),
     m_rulesValid( false ),
+    m_rulesFileHash( 0 ),
+    m_errorLimits( DRCE_LAST + 1 ),
     m_reportAllTrackErrors( false ),
     m_testFootprints( false ),
+    m_incremental( false ),
+    m_skipIncrementalProviders( false ),
+    m_regionRun( false ),
     m_reporter( nullptr ),
-    m_progressReporter( nullptr )
+    m_progressReporter( nullptr ),
+    m_flushedLogs( 0 ),
+    m_conditionCacheStamp( -1 ),
+    m_collectTimings( false )
 {
-    m_errorLimits.resize( DRCE_LAST + 1 );
-
     for( int ii = DRCE_FIRST; ii <= DRCE_LAST; ++ii )
         m_errorLimits[ ii ] = ERROR_LIMIT;
 }
@@ -482,6 +559,12 @@ void DRC_ENGINE::loadRules( const wxFileName& aPath )
 
         for( std::shared_ptr<DRC_RULE>& rule : rules )
             m_rules.push_back( rule );
+
+        wxFFile  file( aPath.GetFullPath(), wxT( "rb" ) );
+        wxString text;
+
+        if( file.IsOpened() && file.ReadAll( &text ) )
+            m_rulesFileHash = hash_val( text.ToStdString() );
     }
 }
 
@@ -529,6 +612,15 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
 
     m_rules.clear();
     m_rulesValid = false;
+    m_rulesFileHash = 0;
+
+    // The cached condition results are keyed on the conditions being freed here, whose
+    // addresses the recompiled rules may reuse
+    {
+        std::unique_lock<std::shared_mutex> writeLock( m_conditionCacheMutex );
+        m_conditionCache.clear();
+        m_conditionCacheStamp = -1;
+    }
 
     for( std::pair<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> pair : m_constraintMap )
     {
@@ -542,6 +634,12 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
 
     m_board->IncrementTimeStamp();  // Clear board-level caches
 
+    // The area test results are kept across runs, unless the settings they depend on change
+    // or their items were edited without a commit
+    m_board->m_AreaTestCache.SetParameters( m_board->GetDesignSettings().GetDRCEpsilon(),
+                                            m_board->GetDesignSettings().m_MaxError );
+    m_board->m_AreaTestCache.Revalidate( m_board );
+
     try         // attempt to load full set of rules (implicit + user rules)
     {
         loadImplicitRules();
@@ -550,6 +648,8 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
     }
     catch( PARSE_ERROR& original_parse_error )
     {
+        m_rulesFileHash = 0;
+
         try     // try again with just our implicit rules
         {
             loadImplicitRules();
@@ -567,6 +667,89 @@ void DRC_ENGINE::InitEngine( const wxFileName& aRulePath )
         m_errorLimits[ ii ] = ERROR_LIMIT;
 
     m_rulesValid = true;
+
+    // The rules (and their conditions) are new
+    SetCollectTimings( m_collectTimings );
+}
+
+
+void DRC_ENGINE::SetCollectTimings( bool aCollect )
+{
+    m_collectTimings = aCollect;
+    m_providerTimings.clear();
+
+    if( aCollect )
+    {
+        for( DRC_TEST_PROVIDER* provider : m_testProviders )
+            m_providerTimings.push_back( { provider->GetName() } );
+    }
+
+    auto setup =
+            [aCollect]( DRC_RULE_CONDITION* aCondition )
+            {
+                if( aCondition )
+                {
+                    aCondition->SetCollectStatistics( aCollect );
+                    aCondition->ClearStatistics();
+                }
+            };
+
+    for( const std::shared_ptr<DRC_RULE>& rule : m_rules )
+    {
+        setup( rule->m_Condition );
+
+        for( const DRC_CONSTRAINT& constraint : rule->m_Constraints )
+            setup( constraint.m_Test );
+    }
+}
+
+
+DRC_TIMINGS DRC_ENGINE::GetTimings() const
+{
+    DRC_TIMINGS timings;
+
+    for( const DRC_TIMINGS::PROVIDER& provider : m_providerTimings )
+    {
+        if( provider.m_runs )
+            timings.m_providers.push_back( provider );
+    }
+
+    for( const std::shared_ptr<DRC_RULE>& rule : m_rules )
+    {
+        DRC_TIMINGS::RULE entry;
+        int64_t           nanoseconds = 0;
+
+        entry.m_name = rule->m_Name;
+
+        auto add =
+                [&]( const DRC_RULE_CONDITION* aCondition )
+                {
+                    if( aCondition )
+                    {
+                        entry.m_evaluations += aCondition->GetEvaluationCount();
+                        entry.m_cachedResults += aCondition->GetCachedResultCount();
+                        nanoseconds += aCondition->GetEvaluationTime();
+                    }
+                };
+
+        add( rule->m_Condition );
+
+        for( const DRC_CONSTRAINT& constraint : rule->m_Constraints )
+            add( constraint.m_Test );
+
+        entry.m_milliseconds = nanoseconds / 1e6;
+
+        if( entry.m_evaluations || entry.m_cachedResults )
+            timings.m_rules.push_back( entry );
+    }
+
+    std::stable_sort( timings.m_rules.begin(), timings.m_rules.end(),
+                      []( const DRC_TIMINGS::RULE& a, const DRC_TIMINGS::RULE& b )
+                      {
+                          return a.m_milliseconds > b.m_milliseconds;
+                      } );
+
+    return timings;
 }
 
 
@@ -589,27 +772,383 @@ void DRC_ENGINE::RunTests( EDA_UNITS aUnits, bool aReportAllTrackErrors, bool aT
 
     DRC_TEST_PROVIDER::Init();
 
+    m_regionRun = !m_region.IsEmpty();
+    m_regionItemMap.clear();
+
+    if( m_regionRun )
+    {
+        m_regionArea = m_region.m_area;
+
+        if( m_region.m_layers.any() || !m_region.m_netcodes.empty()
+                || !m_region.m_items.empty() )
+        {
+            m_board->FillItemMap( m_regionItemMap );
+        }
+
+        if( !m_region.m_netcodes.empty() || !m_region.m_items.empty() )
+        {
+            // Anything which can violate a rule with an item of the region is close to it
+            if( !m_regionArea.IsValid() )
+            {
+                for( const auto& [id, item] : m_regionItemMap )
+                {
+                    BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( item );
+
+                    if( boardItem && matchesRegionItems( boardItem ) )
+                        m_regionArea.Merge( boardItem->GetBoundingBox() );
+                }
+            }
+        }
+
+        if( m_regionArea.IsValid() )
+            m_regionArea.Inflate( worstClearance() + m_designSettings->GetDRCEpsilon() );
+    }
+
     m_board->IncrementTimeStamp();      // Invalidate all caches...
 
     DRC_CACHE_GENERATOR cacheGenerator;
     cacheGenerator.SetDRCEngine( this );
 
     if( !cacheGenerator.Run() )         // ... and regenerate them.
+    {
+        m_regionRun = false;
         return;
+    }
 
     int timestamp = m_board->GetTimeStamp();
 
+    // Providers which declare that they can share the board with others run concurrently.
+    // Exclusive providers act as barriers: everything before them has finished when they
+    // start, and nothing after them starts before they have finished.
+    std::vector<DRC_TEST_PROVIDER*> providers;
+
     for( DRC_TEST_PROVIDER* provider : m_testProviders )
     {
-        ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ), provider->GetName() ) );
+        bool incremental = !provider->GetIncrementalErrorCodes().empty();
 
-        if( !provider->RunTests( aUnits ) )
-            break;
+        if( m_incremental ? incremental : !( m_skipIncrementalProviders && incremental ) )
+            providers.push_back( provider );
+    }
+
+    m_providerLogs.clear();
+    m_providerLogMap.clear();
+    m_flushedLogs = 0;
+
+    for( DRC_TEST_PROVIDER* provider : providers )
+    {
+        DRC_TEST_PROVIDER::CONCURRENCY concurrency = provider->GetConcurrency();
+
+        if( concurrency == DRC_TEST_PROVIDER::CONCURRENCY::EXCLUSIVE )
+        {
+            m_providerLogs.emplace_back( nullptr );
+        }
+        else
+        {
+            bool onCallerThread = concurrency == DRC_TEST_PROVIDER::CONCURRENCY::CALLER_THREAD;
+
+            m_providerLogs.emplace_back( std::make_unique<DRC_PROVIDER_LOG>( this,
+                                                                             onCallerThread ) );
+            m_providerLogMap[ provider ] = m_providerLogs.back().get();
+        }
+    }
+
+    auto runProvider =
+            [&]( size_t aIndex ) -> bool
+            {
+                DRC_TEST_PROVIDER* provider = providers[ aIndex ];
+                DRC_PROVIDER_LOG*  log = m_providerLogs[ aIndex ].get();
+                bool               ok;
+
+                s_threadLog = log;
+
+                ReportAux( wxString::Format( wxT( "Run DRC provider: '%s'" ),
+                                             provider->GetName() ) );
+
+                {
+                    TRACE_ZONE     traceZone( provider->GetName().ToStdString() );
+                    GEOMETRY_ARENA arena;
+                    auto           start = std::chrono::steady_clock::now();
+
+                    ok = provider->RunTests( aUnits );
+
+                    if( m_collectTimings )
+                    {
+                        std::chrono::duration<double, std::milli> elapsed =
+                                std::chrono::steady_clock::now() - start;
+
+                        // Each provider only writes its own entry
+                        auto it = std::find( m_testProviders.begin(), m_testProviders.end(),
+                                             provider );
+                        size_t idx = it - m_testProviders.begin();
+
+                        if( idx < m_providerTimings.size() )
+                        {
+                            m_providerTimings[ idx ].m_milliseconds += elapsed.count();
+                            m_providerTimings[ idx ].m_runs++;
+                        }
+                    }
+                }
+
+                s_threadLog = nullptr;
+
+                if( log )
+                {
+                    log->m_aborted = !ok;
+                    log->m_finished = true;
+                }
+
+                return ok;
+            };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       count = providers.size();
+    bool         cancelled = false;
+
+    for( size_t ii = 0; ii < count && !cancelled; )
+    {
+        if( !m_providerLogs[ ii ] )
+        {
+            // Everything before has finished; this one reports directly
+            flushProviderLogs();
+            m_flushedLogs = ii + 1;
+
+            cancelled = !runProvider( ii++ );
+            continue;
+        }
+
+        size_t     last = ii;
+        TASK_GRAPH graph( TASK_PRIORITY::NORMAL );
+
+        while( last < count && m_providerLogs[ last ] )
+            last++;
+
+        for( size_t jj = ii; jj < last; ++jj )
+        {
+            if( !m_providerLogs[ jj ]->m_onCallerThread )
+                graph.AddTask( [&runProvider, jj]() { runProvider( jj ); } );
+        }
+
+        graph.SetMaxConcurrency( GetThreadBudget( THREAD_SUBSYSTEM::DRC ) );
+        graph.Start( tp );
+
+        for( size_t jj = ii; jj < last; ++jj )
+        {
+            if( m_providerLogs[ jj ]->m_onCallerThread && !cancelled )
+            {
+                if( !runProvider( jj ) )
+                {
+                    cancelled = true;
+                    graph.Cancel();
+                }
+
+                flushProviderLogs();
+            }
+        }
+
+        graph.Wait(
+                [&]()
+                {
+                    flushProviderLogs();
+                    return KeepRefreshing( false );
+                } );
+
+        flushProviderLogs();
+
+        for( size_t jj = ii; jj < last; ++jj )
+            cancelled |= m_providerLogs[ jj ]->m_aborted;
+
+        cancelled |= graph.IsCancelled();
+        ii = last;
     }
 
+    // Whatever was reported before a cancellation still goes out
+    flushProviderLogs( true );
+
+    m_providerLogMap.clear();
+    m_providerLogs.clear();
+
     // DRC tests are multi-threaded; anything that causes us to attempt to re-generate the
     // caches while DRC is running is problematic.
     wxASSERT( timestamp == m_board->GetTimeStamp() );
+
+    if( m_regionRun )
+    {
+        m_regionRun = false;
+        m_regionItemMap.clear();
+
+        // The caches only cover the neighbourhood of the region
+        m_board->IncrementTimeStamp();
+    }
+}
+
+
+void DRC_ENGINE::RunIncrementalTests( EDA_UNITS aUnits, const DRC_INCREMENTAL_SCOPE& aScope,
+                                      bool aRunOtherProviders )
+{
+    // Nothing can start failing where items were only removed
+    if( aScope.GetDirtyArea().IsValid() )
+    {
+        // Any item violating a rule with a changed item is closer to it than the worst
+        // clearance
+        m_testArea = aScope.GetDirtyArea();
+        m_testArea.Inflate( worstClearance() + m_board->GetDesignSettings().GetDRCEpsilon() );
+        m_incremental = true;
+
+        RunTests( aUnits, m_reportAllTrackErrors, m_testFootprints );
+
+        m_incremental = false;
+
+        // The caches only cover the area under test; don't leave them for anyone else
+        m_board->IncrementTimeStamp();
+    }
+
+    if( aRunOtherProviders && !IsCancelled() )
+    {
+        m_skipIncrementalProviders = true;
+
+        RunTests( aUnits, m_reportAllTrackErrors, m_testFootprints );
+
+        m_skipIncrementalProviders = false;
+    }
+}
+
+
+std::set<int> DRC_ENGINE::GetIncrementalErrorCodes() const
+{
+    std::set<int> codes;
+
+    for( DRC_TEST_PROVIDER* provider : m_testProviders )
+    {
+        for( int code : provider->GetIncrementalErrorCodes() )
+            codes.insert( code );
+    }
+
+    return codes;
+}
+
+
+int DRC_ENGINE::worstClearance()
+{
+    int            worst = m_board->GetMaxClearanceValue();
+    DRC_CONSTRAINT constraint;
+
+    for( DRC_CONSTRAINT_T type : { CLEARANCE_CONSTRAINT, HOLE_CLEARANCE_CONSTRAINT,
+                                   HOLE_TO_HOLE_CONSTRAINT, EDGE_CLEARANCE_CONSTRAINT,
+                                   PHYSICAL_CLEARANCE_CONSTRAINT,
+                                   PHYSICAL_HOLE_CLEARANCE_CONSTRAINT,
+                                   SILK_CLEARANCE_CONSTRAINT, COURTYARD_CLEARANCE_CONSTRAINT } )
+    {
+        if( QueryWorstConstraint( type, constraint ) )
+            worst = std::max( worst, constraint.GetValue().Min() );
+    }
+
+    return worst;
+}
+
+
+void DRC_ENGINE::SetRegion( const DRC_REGION& aRegion )
+{
+    m_region = aRegion;
+
+    if( m_region.m_area.IsValid() )
+        m_region.m_area.Normalize();
+}
+
+
+bool DRC_ENGINE::IsInScope( const BOARD_ITEM* aItem ) const
+{
+    if( m_incremental && !m_testArea.Intersects( aItem->GetBoundingBox() ) )
+        return false;
+
+    // A region of nets or items which aren't on the board has no neighbourhood
+    if( m_regionRun && !( m_region.m_netcodes.empty() && m_region.m_items.empty() )
+            && !m_regionArea.IsValid() )
+    {
+        return false;
+    }
+
+    if( m_regionRun && m_regionArea.IsValid()
+            && !m_regionArea.Intersects( aItem->GetBoundingBox() ) )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+bool DRC_ENGINE::matchesRegionItems( const BOARD_ITEM* aItem ) const
+{
+    if( !m_region.m_netcodes.empty() )
+    {
+        const BOARD_CONNECTED_ITEM* cItem = dynamic_cast<const BOARD_CONNECTED_ITEM*>( aItem );
+
+        if( !cItem || !m_region.m_netcodes.count( cItem->GetNetCode() ) )
+            return false;
+    }
+
+    if( !m_region.m_items.empty() )
+    {
+        if( !m_region.m_items.count( aItem->m_Uuid ) )
+        {
+            const FOOTPRINT* parentFP = aItem->GetParentFootprint();
+
+            if( !parentFP || !m_region.m_items.count( parentFP->m_Uuid ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+bool DRC_ENGINE::isInRegion( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                             int aMarkerLayer ) const
+{
+    if( m_region.m_area.IsValid() && !m_region.Contains( aPos ) )
+        return false;
+
+    std::vector<const BOARD_ITEM*> items;
+
+    for( const KIID& id : aItem->GetIDs() )
+    {
+        auto it = m_regionItemMap.find( id );
+
+        if( it != m_regionItemMap.end() )
+        {
+            if( const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( it->second ) )
+                items.push_back( item );
+        }
+    }
+
+    if( m_region.m_layers.any() )
+    {
+        bool onLayers = false;
+
+        if( aMarkerLayer >= 0 && aMarkerLayer < PCB_LAYER_ID_COUNT )
+        {
+            onLayers = m_region.m_layers.test( aMarkerLayer );
+        }
+        else
+        {
+            for( const BOARD_ITEM* item : items )
+                onLayers |= ( item->GetLayerSet() & m_region.m_layers ).any();
+        }
+
+        if( !onLayers )
+            return false;
+    }
+
+    if( !m_region.m_netcodes.empty() || !m_region.m_items.empty() )
+    {
+        return std::any_of( items.begin(), items.end(),
+                            [&]( const BOARD_ITEM* item )
+                            {
+                                return matchesRegionItems( item );
+                            } );
+    }
+
+    return true;
 }
 
 
@@ -672,6 +1211,132 @@ bool hasDrilledHole( const BOARD_ITEM* aItem )
 }
 
 
+bool DRC_ENGINE::CONDITION_SIGNATURE::operator==( const CONDITION_SIGNATURE& aOther ) const
+{
+    return m_type == aOther.m_type && m_viaType == aOther.m_viaType
+            && m_netCode == aOther.m_netCode && m_netclass == aOther.m_netclass
+            && m_layer == aOther.m_layer && m_footprint == aOther.m_footprint;
+}
+
+
+bool DRC_ENGINE::CONDITION_SIGNATURE::operator<( const CONDITION_SIGNATURE& aOther ) const
+{
+    return std::tie( m_type, m_viaType, m_netCode, m_netclass, m_layer, m_footprint )
+            < std::tie( aOther.m_type, aOther.m_viaType, aOther.m_netCode, aOther.m_netclass,
+                        aOther.m_layer, aOther.m_footprint );
+}
+
+
+bool DRC_ENGINE::CONDITION_CACHE_KEY::operator==( const CONDITION_CACHE_KEY& aOther ) const
+{
+    return m_condition == aOther.m_condition && m_constraint == aOther.m_constraint
+            && m_layer == aOther.m_layer && m_a == aOther.m_a && m_b == aOther.m_b;
+}
+
+
+std::size_t
+DRC_ENGINE::CONDITION_CACHE_KEY_HASH::operator()( const CONDITION_CACHE_KEY& aKey ) const
+{
+    return hash_val( aKey.m_condition, aKey.m_constraint, static_cast<int>( aKey.m_layer ),
+                     aKey.m_a.m_type, aKey.m_a.m_viaType, aKey.m_a.m_netCode, aKey.m_a.m_netclass,
+                     aKey.m_a.m_layer, aKey.m_a.m_footprint,
+                     aKey.m_b.m_type, aKey.m_b.m_viaType, aKey.m_b.m_netCode, aKey.m_b.m_netclass,
+                     aKey.m_b.m_layer, aKey.m_b.m_footprint );
+}
+
+
+bool DRC_ENGINE::evalCondition( DRC_RULE_CONDITION* aCondition, int aConstraint,
+                                const BOARD_ITEM* a, const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
+                                REPORTER* aReporter )
+{
+    int deps = aCondition->GetDependencies();
+
+    // Reports must show the actual evaluation
+    if( aReporter || ( deps & DRC_DEPENDS_ON_ANYTHING ) )
+        return aCondition->EvaluateFor( a, b, aConstraint, aLayer, aReporter );
+
+    auto signature =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                CONDITION_SIGNATURE sig;
+
+                if( !aItem )
+                    return sig;
+
+                sig.m_type = aItem->Type();
+
+                if( ( deps & DRC_DEPENDS_ON_VIA_TYPE ) && aItem->Type() == PCB_VIA_T )
+                {
+                    const PCB_VIA* via = static_cast<const PCB_VIA*>( aItem );
+                    sig.m_viaType = static_cast<int>( via->GetViaType() );
+                }
+
+                if( aItem->IsConnected() )
+                {
+                    auto citem = static_cast<const BOARD_CONNECTED_ITEM*>( aItem );
+
+                    if( deps & DRC_DEPENDS_ON_NET )
+                        sig.m_netCode = citem->GetNetCode();
+
+                    if( deps & DRC_DEPENDS_ON_NETCLASS )
+                        sig.m_netclass = citem->GetEffectiveNetClass();
+                }
+
+                if( deps & DRC_DEPENDS_ON_LAYER )
+                    sig.m_layer = aItem->GetLayer();
+
+                if( deps & DRC_DEPENDS_ON_FOOTPRINT )
+                {
+                    if( aItem->Type() == PCB_FOOTPRINT_T )
+                        sig.m_footprint = aItem;
+                    else
+                        sig.m_footprint = aItem->GetParentFootprint();
+                }
+
+                return sig;
+            };
+
+    CONDITION_CACHE_KEY key{ aCondition, aConstraint, aLayer, signature( a ), signature( b ) };
+
+    // Conditions are commutative
+    if( b && key.m_b < key.m_a )
+        std::swap( key.m_a, key.m_b );
+
+    const int stamp = m_board->GetTimeStamp();
+
+    {
+        std::shared_lock<std::shared_mutex> readLock( m_conditionCacheMutex );
+
+        if( m_conditionCacheStamp == stamp )
+        {
+            auto it = m_conditionCache.find( key );
+
+            if( it != m_conditionCache.end() )
+            {
+                aCondition->CountCachedResult();
+                return it->second;
+            }
+        }
+    }
+
+    bool result = aCondition->EvaluateFor( a, b, aConstraint, aLayer, nullptr );
+
+    std::unique_lock<std::shared_mutex> writeLock( m_conditionCacheMutex );
+
+    // Net and netclass pointers can be recycled once the board changed
+    if( stamp > m_conditionCacheStamp )
+    {
+        m_conditionCache.clear();
+        m_conditionCacheStamp = stamp;
+    }
+
+    if( stamp == m_conditionCacheStamp )
+        m_conditionCache[ key ] = result;
+
+    return result;
+}
+
+
 DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
                                       const BOARD_ITEM* b, PCB_LAYER_ID aLayer,
                                       REPORTER* aReporter )
@@ -1255,7 +1920,7 @@ DRC_CONSTRAINT DRC_ENGINE::EvalRules( DRC_CONSTRAINT_T aConstraintType, const BO
                                                   EscapeHTML( c->condition->GetExpression() ) ) )
                     }
 
-                    if( c->condition->EvaluateFor( a, b, c->constraint.m_Type, aLayer, aReporter ) )
+                    if( evalCondition( c->condition, c->constraint.m_Type, a, b, aLayer, aReporter ) )
                     {
                         if( aReporter )
                         {
@@ -1573,13 +2238,91 @@ bool DRC_ENGINE::IsErrorLimitExceeded( int error_code )
 }
 
 
+DRC_PROVIDER_LOG* DRC_ENGINE::getProviderLog( const DRC_TEST_PROVIDER* aProvider ) const
+{
+    if( s_threadLog && s_threadLog->m_engine == this )
+        return s_threadLog;
+
+    // Providers which use the thread pool themselves report from threads of their own
+    if( aProvider && !m_providerLogMap.empty() )
+    {
+        auto it = m_providerLogMap.find( aProvider );
+
+        if( it != m_providerLogMap.end() )
+            return it->second;
+    }
+
+    return nullptr;
+}
+
+
+void DRC_ENGINE::flushProviderLogs( bool aDrain )
+{
+    while( m_flushedLogs < m_providerLogs.size() )
+    {
+        DRC_PROVIDER_LOG* log = m_providerLogs[ m_flushedLogs ].get();
+
+        if( !log )
+        {
+            // An exclusive provider which has not run yet
+            if( !aDrain )
+                break;
+
+            m_flushedLogs++;
+            continue;
+        }
+
+        // Check before taking the entries so that none added in between can be left behind
+        bool finished = log->m_finished;
+
+        for( DRC_PROVIDER_LOG::ENTRY& entry : log->Take() )
+        {
+            switch( entry.m_type )
+            {
+            case DRC_PROVIDER_LOG::VIOLATION:
+                reportViolation( entry.m_item, entry.m_pos, entry.m_layer );
+                break;
+
+            case DRC_PROVIDER_LOG::AUX:
+                reportAux( entry.m_text );
+                break;
+
+            case DRC_PROVIDER_LOG::PHASE:
+                if( m_progressReporter )
+                    m_progressReporter->AdvancePhase( entry.m_text );
+
+                break;
+            }
+        }
+
+        if( !finished && !aDrain )
+            break;
+
+        m_flushedLogs++;
+    }
+}
+
+
 void DRC_ENGINE::ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
                                   int aMarkerLayer )
 {
-    static std::mutex globalLock;
+    if( m_regionRun && !isInRegion( aItem, aPos, aMarkerLayer ) )
+        return;
 
     m_errorLimits[ aItem->GetErrorCode() ] -= 1;
 
+    if( DRC_PROVIDER_LOG* log = getProviderLog( aItem->GetViolatingTest() ) )
+        log->Add( { DRC_PROVIDER_LOG::VIOLATION, aItem, aPos, aMarkerLayer, wxEmptyString } );
+    else
+        reportViolation( aItem, aPos, aMarkerLayer );
+}
+
+
+void DRC_ENGINE::reportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                                  int aMarkerLayer )
+{
+    static std::mutex globalLock;
+
     if( m_violationHandler )
     {
         std::lock_guard<std::mutex> guard( globalLock );
@@ -1614,6 +2357,15 @@ void DRC_ENGINE::ReportAux ( const wxString& aStr )
     if( !m_reporter )
         return;
 
+    if( DRC_PROVIDER_LOG* log = getProviderLog() )
+        log->Add( { DRC_PROVIDER_LOG::AUX, nullptr, VECTOR2I(), 0, aStr } );
+    else
+        reportAux( aStr );
+}
+
+
+void DRC_ENGINE::reportAux( const wxString& aStr )
+{
     m_reporter->Report( aStr, RPT_SEVERITY_INFO );
 }
 
@@ -1623,20 +2375,33 @@ bool DRC_ENGINE::KeepRefreshing( bool aWait )
     if( !m_progressReporter )
         return true;
 
+    // The progress reporter may only be refreshed from the DRC thread
+    DRC_PROVIDER_LOG* log = getProviderLog();
+
+    if( log && !log->m_onCallerThread )
+        return !IsCancelled();
+
+    if( log )
+        flushProviderLogs();
+
     return m_progressReporter->KeepRefreshing( aWait );
 }
 
 
 void DRC_ENGINE::AdvanceProgress()
 {
-    if( m_progressReporter )
+    DRC_PROVIDER_LOG* log = getProviderLog();
+
+    if( m_progressReporter && !( log && !log->m_onCallerThread ) )
         m_progressReporter->AdvanceProgress();
 }
 
 
 void DRC_ENGINE::SetMaxProgress( int aSize )
 {
-    if( m_progressReporter )
+    DRC_PROVIDER_LOG* log = getProviderLog();
+
+    if( m_progressReporter && !( log && !log->m_onCallerThread ) )
         m_progressReporter->SetMaxProgress( aSize );
 }
 
@@ -1646,8 +2411,13 @@ bool DRC_ENGINE::ReportProgress( double aProgress )
     if( !m_progressReporter )
         return true;
 
+    DRC_PROVIDER_LOG* log = getProviderLog();
+
+    if( log && !log->m_onCallerThread )
+        return !IsCancelled();
+
     m_progressReporter->SetCurrentProgress( aProgress );
-    return m_progressReporter->KeepRefreshing( false );
+    return KeepRefreshing( false );
 }
 
 
@@ -1656,8 +2426,18 @@ bool DRC_ENGINE::ReportPhase( const wxString& aMessage )
     if( !m_progressReporter )
         return true;
 
-    m_progressReporter->AdvancePhase( aMessage );
-    return m_progressReporter->KeepRefreshing( false );
+    DRC_PROVIDER_LOG* log = getProviderLog();
+
+    if( !log )
+    {
+        m_progressReporter->AdvancePhase( aMessage );
+        return m_progressReporter->KeepRefreshing( false );
+    }
+
+    // Replayed in provider order by flushProviderLogs()
+    log->Add( { DRC_PROVIDER_LOG::PHASE, nullptr, VECTOR2I(), 0, aMessage } );
+
+    return KeepRefreshing( false );
 }
 
 
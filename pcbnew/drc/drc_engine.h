@@ -24,14 +24,18 @@
 #ifndef DRC_ENGINE_H
 #define DRC_ENGINE_H
 
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 #include <vector>
 #include <unordered_map>
 
 #include <units_provider.h>
 #include <geometry/shape.h>
 
+#include <drc/drc_region.h>
 #include <drc/drc_rule.h>
+#include <drc/drc_timings.h>
 
 
 class BOARD_DESIGN_SETTINGS;
@@ -39,6 +43,7 @@ class DRC_TEST_PROVIDER;
 class PCB_EDIT_FRAME;
 class DS_PROXY_VIEW_ITEM;
 class BOARD_ITEM;
+class EDA_ITEM;
 class BOARD;
 class PCB_MARKER;
 class NETCLASS;
@@ -59,6 +64,8 @@ void drcPrintDebugMessage( int level, const wxString& msg, const char *function,
     drcPrintDebugMessage(level, wxString::Format( fmt, __VA_ARGS__ ), __FUNCTION__, __LINE__ );
 
 class DRC_RULE_CONDITION;
+class DRC_INCREMENTAL_SCOPE;
+struct DRC_PROVIDER_LOG;
 class DRC_ITEM;
 class DRC_RULE;
 class DRC_CONSTRAINT;
@@ -117,6 +124,8 @@ public:
         m_violationHandler = DRC_VIOLATION_HANDLER();
     }
 
+    const DRC_VIOLATION_HANDLER& GetViolationHandler() const { return m_violationHandler; }
+
     /**
      * Set an optional reporter for user-level progress info.
      */
@@ -144,6 +153,43 @@ public:
      */
     void RunTests( EDA_UNITS aUnits,  bool aReportAllTrackErrors, bool aTestFootprints );
 
+    /**
+     * Re-run the providers which support it on the neighbourhood of the items changed since the
+     * last run: the dirty area of \a aScope inflated by the worst clearance.  Only violations
+     * involving items in that area are reported; the caller is expected to replace the markers
+     * of GetIncrementalErrorCodes() touched by \a aScope with them.
+     *
+     * The board caches are only built for the area under test, and are discarded afterwards.
+     *
+     * @param aRunOtherProviders also run the providers which don't support incremental runs,
+     *                           on the whole board.
+     */
+    void RunIncrementalTests( EDA_UNITS aUnits, const DRC_INCREMENTAL_SCOPE& aScope,
+                              bool aRunOtherProviders = false );
+
+    /**
+     * @return the error codes re-checked by RunIncrementalTests().
+     */
+    std::set<int> GetIncrementalErrorCodes() const;
+
+    bool IsIncremental() const { return m_incremental; }
+
+    /**
+     * Restrict the following runs to \a aRegion.  Only the violations in the region are
+     * reported.  The board caches are only built for the neighbourhood of the region (its area,
+     * or the items of its nets and selection, inflated by the worst clearance), and are
+     * discarded after each run.  Providers which don't build on the caches still test the
+     * whole board.
+     */
+    void SetRegion( const DRC_REGION& aRegion );
+    void ClearRegion() { m_region = DRC_REGION(); }
+    const DRC_REGION& GetRegion() const { return m_region; }
+
+    /**
+     * @return true if \a aItem has to be tested by the current run.  Always true for full runs.
+     */
+    bool IsInScope( const BOARD_ITEM* aItem ) const;
+
     bool IsErrorLimitExceeded( int error_code );
 
     DRC_CONSTRAINT EvalRules( DRC_CONSTRAINT_T aConstraintType, const BOARD_ITEM* a,
@@ -159,11 +205,45 @@ public:
 
     bool HasRulesForConstraintType( DRC_CONSTRAINT_T constraintID );
 
+    /**
+     * Set the options RunIncrementalTests() runs with.  RunTests() sets them too.
+     */
+    void SetTestOptions( bool aReportAllTrackErrors, bool aTestFootprints )
+    {
+        m_reportAllTrackErrors = aReportAllTrackErrors;
+        m_testFootprints = aTestFootprints;
+    }
+
     bool GetReportAllTrackErrors() const { return m_reportAllTrackErrors; }
     bool GetTestFootprints() const { return m_testFootprints; }
 
     bool RulesValid() { return m_rulesValid; }
 
+    /**
+     * @return the rules in evaluation order.  The same rules file and board settings always
+     *         give the same rules in the same order.
+     */
+    const std::vector<std::shared_ptr<DRC_RULE>>& GetRules() const { return m_rules; }
+
+    /**
+     * @return a hash of the contents of the custom rules file in use, or 0 if there is none.
+     */
+    size_t GetRulesFileHash() const { return m_rulesFileHash; }
+
+    /**
+     * Record the time spent by each provider, and evaluating the conditions of each rule, in
+     * the following runs.  Clears the timings recorded so far.  Off by default, as timing
+     * every condition evaluation isn't free.
+     */
+    void SetCollectTimings( bool aCollect );
+    bool GetCollectTimings() const { return m_collectTimings; }
+
+    /**
+     * @return the timings recorded since SetCollectTimings(), or since the rules were last
+     *         loaded by InitEngine().
+     */
+    DRC_TIMINGS GetTimings() const;
+
     void ReportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
                           int aMarkerLayer );
 
@@ -227,6 +307,79 @@ private:
     void loadImplicitRules();
     std::shared_ptr<DRC_RULE> createImplicitRule( const wxString& name );
 
+    /**
+     * @return the log collecting the output of the provider running on the calling thread (or
+     *         of \a aProvider if given), or nullptr if the output is to be reported directly.
+     */
+    DRC_PROVIDER_LOG* getProviderLog( const DRC_TEST_PROVIDER* aProvider = nullptr ) const;
+
+    /**
+     * Report the output collected so far by the providers running concurrently, in provider
+     * order.  A log is only reported from once all the logs before it are complete.
+     *
+     * @param aDrain report all logs, complete or not.
+     */
+    void flushProviderLogs( bool aDrain = false );
+
+    void reportViolation( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                          int aMarkerLayer );
+    void reportAux( const wxString& aStr );
+
+    /**
+     * The properties of an item which can take part in a rule condition, limited to the ones
+     * a given condition depends on (see DRC_RULE_CONDITION::GetDependencies()).
+     */
+    struct CONDITION_SIGNATURE
+    {
+        int         m_type = -1;            ///< KICAD_T, or -1 for no item
+        int         m_viaType = 0;
+        int         m_netCode = -1;
+        const void* m_netclass = nullptr;
+        int         m_layer = UNDEFINED_LAYER;
+        const void* m_footprint = nullptr;
+
+        bool operator==( const CONDITION_SIGNATURE& aOther ) const;
+        bool operator<( const CONDITION_SIGNATURE& aOther ) const;
+    };
+
+    struct CONDITION_CACHE_KEY
+    {
+        const DRC_RULE_CONDITION* m_condition;
+        int                       m_constraint;
+        PCB_LAYER_ID              m_layer;
+        CONDITION_SIGNATURE       m_a;
+        CONDITION_SIGNATURE       m_b;
+
+        bool operator==( const CONDITION_CACHE_KEY& aOther ) const;
+    };
+
+    struct CONDITION_CACHE_KEY_HASH
+    {
+        std::size_t operator()( const CONDITION_CACHE_KEY& aKey ) const;
+    };
+
+    /**
+     * Evaluate \a aCondition, sharing the result between the item pairs on which it can't
+     * differ.  Most conditions (all the netclass ones for instance) only look at a few
+     * properties which are shared by many items.
+     */
+    bool evalCondition( DRC_RULE_CONDITION* aCondition, int aConstraint, const BOARD_ITEM* a,
+                        const BOARD_ITEM* b, PCB_LAYER_ID aLayer, REPORTER* aReporter );
+
+    /**
+     * @return the distance beyond which no item can violate a rule with another one.
+     */
+    int worstClearance();
+
+    bool matchesRegionItems( const BOARD_ITEM* aItem ) const;
+
+    /**
+     * @return true if a violation of \a aItem at \a aPos on \a aMarkerLayer is in the region
+     *         set by SetRegion().
+     */
+    bool isInRegion( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos,
+                     int aMarkerLayer ) const;
+
 protected:
     BOARD_DESIGN_SETTINGS*     m_designSettings;
     BOARD*                     m_board;
@@ -235,11 +388,20 @@ protected:
 
     std::vector<std::shared_ptr<DRC_RULE>>  m_rules;
     bool                                    m_rulesValid;
+    size_t                                  m_rulesFileHash;
     std::vector<DRC_TEST_PROVIDER*>         m_testProviders;
 
-    std::vector<int>           m_errorLimits;
+    std::vector<std::atomic<int>> m_errorLimits;
     bool                       m_reportAllTrackErrors;
     bool                       m_testFootprints;
+    bool                       m_incremental;
+    bool                       m_skipIncrementalProviders;
+    BOX2I                      m_testArea;          ///< Area under test in incremental runs
+
+    DRC_REGION                 m_region;
+    bool                       m_regionRun;         ///< the current run is restricted
+    BOX2I                      m_regionArea;        ///< neighbourhood of the region
+    std::map<KIID, EDA_ITEM*>  m_regionItemMap;     ///< to resolve violating items
 
     // constraint -> rule -> provider
     std::map<DRC_CONSTRAINT_T, std::vector<DRC_ENGINE_CONSTRAINT*>*> m_constraintMap;
@@ -248,6 +410,21 @@ protected:
     REPORTER*                  m_reporter;
     PROGRESS_REPORTER*         m_progressReporter;
 
+    // Output of the concurrently running providers, in m_testProviders order.  Null for
+    // providers which run alone and report directly.
+    std::vector<std::unique_ptr<DRC_PROVIDER_LOG>>                   m_providerLogs;
+    std::unordered_map<const DRC_TEST_PROVIDER*, DRC_PROVIDER_LOG*>  m_providerLogMap;
+    size_t                                                           m_flushedLogs;
+
+    // Condition results, valid for the board timestamp they were computed at and cleared
+    // whenever the rules are recompiled
+    std::unordered_map<CONDITION_CACHE_KEY, bool, CONDITION_CACHE_KEY_HASH> m_conditionCache;
+    int                                                                     m_conditionCacheStamp;
+    std::shared_mutex                                                       m_conditionCacheMutex;
+
+    bool                                   m_collectTimings;
+    std::vector<DRC_TIMINGS::PROVIDER>     m_providerTimings;     ///< in m_testProviders order
+
     std::shared_ptr<KIGFX::VIEW_OVERLAY> m_debugOverlay;
 };
 
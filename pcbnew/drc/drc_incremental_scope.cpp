@@ -0,0 +1,143 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <drc/drc_incremental_scope.h>
+#include <rc_item.h>
+#include <zone.h>
+
+
+void DRC_INCREMENTAL_SCOPE::addItem( const BOARD_ITEM* aItem, bool aRemoved )
+{
+    if( !aItem || aItem->Type() == PCB_MARKER_T )
+        return;
+
+    // Rule areas and the board outline take part in the evaluation of rules for items far
+    // away from them
+    if( aItem->Type() == PCB_ZONE_T && static_cast<const ZONE*>( aItem )->GetIsRuleArea() )
+        m_needsFullRun = true;
+
+    if( aItem->IsOnLayer( Edge_Cuts ) || aItem->IsOnLayer( Margin ) )
+        m_needsFullRun = true;
+
+    m_items.insert( aItem->m_Uuid );
+
+    if( !aRemoved )
+        m_dirtyArea.Merge( aItem->GetBoundingBox() );
+
+    aItem->RunOnDescendants(
+            [&]( BOARD_ITEM* aChild )
+            {
+                m_items.insert( aChild->m_Uuid );
+
+                if( aChild->Type() == PCB_ZONE_T
+                        && static_cast<ZONE*>( aChild )->GetIsRuleArea() )
+                {
+                    m_needsFullRun = true;
+                }
+
+                if( aChild->IsOnLayer( Edge_Cuts ) || aChild->IsOnLayer( Margin ) )
+                    m_needsFullRun = true;
+            } );
+
+    if( m_changeHandler )
+        m_changeHandler();
+}
+
+
+void DRC_INCREMENTAL_SCOPE::AddChangedItem( const BOARD_ITEM* aItem )
+{
+    addItem( aItem, false );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::AddRemovedItem( const BOARD_ITEM* aItem )
+{
+    addItem( aItem, true );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::Clear()
+{
+    m_items.clear();
+    m_dirtyArea = BOX2I();
+    m_needsFullRun = false;
+}
+
+
+bool DRC_INCREMENTAL_SCOPE::Touches( const RC_ITEM& aItem ) const
+{
+    for( const KIID& id : aItem.GetIDs() )
+    {
+        if( m_items.count( id ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    AddChangedItem( aItem );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        AddChangedItem( item );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    AddRemovedItem( aItem );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardItemsRemoved( BOARD& aBoard,
+                                                 std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        AddRemovedItem( item );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem )
+{
+    AddChangedItem( aItem );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardItemsChanged( BOARD& aBoard,
+                                                 std::vector<BOARD_ITEM*>& aItems )
+{
+    for( BOARD_ITEM* item : aItems )
+        AddChangedItem( item );
+}
+
+
+void DRC_INCREMENTAL_SCOPE::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    // Net class clearances may have changed anywhere
+    m_needsFullRun = true;
+
+    if( m_changeHandler )
+        m_changeHandler();
+}
@@ -0,0 +1,98 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_INCREMENTAL_SCOPE_H
+#define DRC_INCREMENTAL_SCOPE_H
+
+#include <functional>
+#include <set>
+
+#include <board.h>
+#include <kiid.h>
+#include <math/box2.h>
+
+class RC_ITEM;
+
+
+/**
+ * The part of a board an incremental DRC run has to re-check.
+ *
+ * Attached to a board as a listener, it accumulates the items added, changed and removed by
+ * the commits pushed since the last DRC run.  DRC_ENGINE::RunIncrementalTests() then re-tests
+ * only the neighbourhood of the added and changed items, and the markers referring to any
+ * changed or removed item can be replaced by the new results.
+ *
+ * Changes which can affect violations anywhere on the board (rule areas, the board outline,
+ * net settings) make NeedsFullRun() return true.
+ */
+class DRC_INCREMENTAL_SCOPE : public BOARD_LISTENER
+{
+public:
+    DRC_INCREMENTAL_SCOPE() :
+            m_needsFullRun( false )
+    {}
+
+    void AddChangedItem( const BOARD_ITEM* aItem );
+    void AddRemovedItem( const BOARD_ITEM* aItem );
+
+    /**
+     * Force the next run to be a full one.
+     */
+    void Invalidate() { m_needsFullRun = true; }
+
+    void Clear();
+
+    bool Empty() const { return m_items.empty() && !m_needsFullRun; }
+
+    bool NeedsFullRun() const { return m_needsFullRun; }
+
+    /**
+     * Set a function called each time a change is recorded, for instance to schedule a run.
+     */
+    void SetChangeHandler( std::function<void()> aHandler ) { m_changeHandler = aHandler; }
+
+    /**
+     * @return the union of the bounding boxes of the added and changed items.
+     */
+    const BOX2I& GetDirtyArea() const { return m_dirtyArea; }
+
+    /**
+     * @return true if \a aItem refers to an added, changed or removed item.
+     */
+    bool Touches( const RC_ITEM& aItem ) const;
+
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
+
+private:
+    void addItem( const BOARD_ITEM* aItem, bool aRemoved );
+
+    std::set<KIID> m_items;         ///< added, changed and removed items and their children
+    BOX2I          m_dirtyArea;
+    bool           m_needsFullRun;
+
+    std::function<void()> m_changeHandler;
+};
+
+#endif // DRC_INCREMENTAL_SCOPE_H
@@ -196,11 +196,12 @@ void DRC_INTERACTIVE_COURTYARD_CLEARANCE::Init( BOARD* aBoard )
 {
     m_board = aBoard;
 
-    // Update courtyard data and clear the COURTYARD_CONFLICT flag
+    // Clear the COURTYARD_CONFLICT flag, and update the courtyards of the footprints which
+    // changed since they were last built
     for( FOOTPRINT* fp: m_board->Footprints() )
     {
         fp->ClearFlags( COURTYARD_CONFLICT );
-        fp->BuildCourtyardCaches();
+        fp->GetCourtyard( F_CrtYd );
     }
 }
 
@@ -0,0 +1,62 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_REGION_H
+#define DRC_REGION_H
+
+#include <set>
+
+#include <kiid.h>
+#include <layer_ids.h>
+#include <math/box2.h>
+
+
+/**
+ * The part of a board a DRC run is restricted to, see DRC_ENGINE::SetRegion().  Each of the
+ * restrictions which is set has to be met by a violation for it to be reported.
+ */
+struct DRC_REGION
+{
+    /// Violations located in this box.  The box is half-open, so that the regions of a board
+    /// split in adjacent boxes share no violation.  Unrestricted when invalid.
+    BOX2I          m_area;
+
+    /// Violations on these layers.  Unrestricted when empty.
+    LSET           m_layers;
+
+    /// Violations involving an item of one of these nets.  Unrestricted when empty.
+    std::set<int>  m_netcodes;
+
+    /// Violations involving one of these items, or an item of one of these footprints.
+    /// Unrestricted when empty.
+    std::set<KIID> m_items;
+
+    bool IsEmpty() const
+    {
+        return !m_area.IsValid() && m_layers.none() && m_netcodes.empty() && m_items.empty();
+    }
+
+    bool Contains( const VECTOR2I& aPoint ) const
+    {
+        return aPoint.x >= m_area.GetLeft() && aPoint.x < m_area.GetRight()
+               && aPoint.y >= m_area.GetTop() && aPoint.y < m_area.GetBottom();
+    }
+};
+
+#endif // DRC_REGION_H
@@ -101,6 +101,25 @@ bool DRC_REPORT::WriteTextReport( const wxString& aFullFileName )
         fprintf( fp, "%s", TO_UTF8( item->ShowReport( &unitsProvider, severity, itemMap ) ) );
     }
 
+    if( !m_timings.empty() )
+    {
+        fprintf( fp, "\n** DRC timings **\n" );
+
+        for( const DRC_TIMINGS::PROVIDER& provider : m_timings.m_providers )
+        {
+            fprintf( fp, "    %-40s %10.1f ms\n", TO_UTF8( provider.m_name ),
+                     provider.m_milliseconds );
+        }
+
+        fprintf( fp, "\n** Rule condition timings **\n" );
+
+        for( const DRC_TIMINGS::RULE& rule : m_timings.m_rules )
+        {
+            fprintf( fp, "    %-40s %10.1f ms %10lld evaluations %10lld cached\n",
+                     TO_UTF8( rule.m_name ), rule.m_milliseconds,
+                     (long long) rule.m_evaluations, (long long) rule.m_cachedResults );
+        }
+    }
 
     fprintf( fp, "\n** End of Report **\n" );
 
@@ -164,6 +183,29 @@ bool DRC_REPORT::WriteJsonReport( const wxString& aFullFileName )
 
 
     nlohmann::json saveJson = nlohmann::json( reportHead );
+
+    if( !m_timings.empty() )
+    {
+        nlohmann::json providers = nlohmann::json::array();
+        nlohmann::json rules = nlohmann::json::array();
+
+        for( const DRC_TIMINGS::PROVIDER& provider : m_timings.m_providers )
+        {
+            providers.push_back( { { "name", provider.m_name.ToUTF8().data() },
+                                   { "milliseconds", provider.m_milliseconds } } );
+        }
+
+        for( const DRC_TIMINGS::RULE& rule : m_timings.m_rules )
+        {
+            rules.push_back( { { "name", rule.m_name.ToUTF8().data() },
+                               { "milliseconds", rule.m_milliseconds },
+                               { "evaluations", rule.m_evaluations },
+                               { "cached_results", rule.m_cachedResults } } );
+        }
+
+        saveJson["timings"] = { { "providers", providers }, { "rules", rules } };
+    }
+
     jsonFileStream << std::setw( 4 ) << saveJson << std::endl;
     jsonFileStream.flush();
     jsonFileStream.close();
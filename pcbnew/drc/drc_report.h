@@ -22,6 +22,7 @@
 
 #include <memory>
 #include <eda_units.h>
+#include <drc/drc_timings.h>
 #include <wx/string.h>
 
 class BOARD;
@@ -36,6 +37,11 @@ public:
                 std::shared_ptr<RC_ITEMS_PROVIDER> aRatsnestProvider,
                 std::shared_ptr<RC_ITEMS_PROVIDER> aFpWarningsProvider );
 
+    /**
+     * Add the timings collected by the DRC engine to the reports.
+     */
+    void SetTimings( const DRC_TIMINGS& aTimings ) { m_timings = aTimings; }
+
     bool WriteTextReport( const wxString& aFullFileName );
     bool WriteJsonReport( const wxString& aFullFileName );
 
@@ -45,6 +51,7 @@ private:
     std::shared_ptr<RC_ITEMS_PROVIDER> m_markersProvider;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_ratsnestProvider;
     std::shared_ptr<RC_ITEMS_PROVIDER> m_fpWarningsProvider;
+    DRC_TIMINGS                        m_timings;
 };
 
 
@@ -0,0 +1,344 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <drc/drc_result_cache.h>
+
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <build_version.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_incremental_scope.h>
+#include <drc/drc_item.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_test_provider.h>
+#include <footprint.h>
+#include <hash.h>
+#include <netinfo.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <project/net_settings.h>
+#include <richio.h>
+#include <string_utils.h>
+#include <zone.h>
+
+
+/// Bumped whenever the contents of the cache file change meaning
+static const int CACHE_VERSION = 1;
+
+
+DRC_RESULT_CACHE::DRC_RESULT_CACHE( DRC_ENGINE* aEngine ) :
+        m_engine( aEngine ),
+        m_board( aEngine->GetBoard() ),
+        m_signature( 0 )
+{
+}
+
+
+wxFileName DRC_RESULT_CACHE::GetDefaultPath( const BOARD* aBoard )
+{
+    wxFileName fn( aBoard->GetFileName() );
+
+    fn.SetName( fn.GetName() + wxS( "-drc-cache" ) );
+    fn.SetExt( wxS( "json" ) );
+
+    return fn;
+}
+
+
+size_t DRC_RESULT_CACHE::hashItem( PCB_IO_KICAD_SEXPR& aIO, STRING_FORMATTER& aFormatter,
+                                   const BOARD_ITEM* aItem )
+{
+    aFormatter.Clear();
+    aIO.SetOutputFormatter( &aFormatter );
+    aIO.Format( aItem );
+
+    return hash_val( aFormatter.GetString() );
+}
+
+
+size_t DRC_RESULT_CACHE::ComputeSignature( bool aReportAllTrackErrors,
+                                           bool aTestFootprints ) const
+{
+    BOARD_DESIGN_SETTINGS* bds = m_engine->GetDesignSettings();
+    PCB_IO_KICAD_SEXPR     io( CTL_FOR_BOARD );
+    STRING_FORMATTER       formatter;
+
+    bds->GetStackupDescriptor().FormatBoardStackup( &formatter, m_board, 0 );
+
+    size_t signature = hash_val( CACHE_VERSION, GetBuildVersion().ToStdString(),
+                                 m_engine->GetRulesFileHash(), bds->FormatAsString(),
+                                 formatter.GetString(), m_board->GetEnabledLayers().FmtHex(),
+                                 aReportAllTrackErrors, aTestFootprints );
+
+    if( bds->m_NetSettings )
+        hash_combine( signature, bds->m_NetSettings->FormatAsString() );
+
+    // Tracks and zones only store net codes
+    for( NETINFO_ITEM* net : m_board->GetNetInfo() )
+    {
+        hash_combine( signature, net->GetNetCode(), net->GetNetname().ToStdString() );
+
+        if( net->GetNetClass() )
+            hash_combine( signature, net->GetNetClass()->GetName().ToStdString() );
+    }
+
+    // Rule areas and the board outline take part in the evaluation of rules for items far
+    // away from them, so any change to them (removals included) invalidates everything
+    auto isGlobal =
+            []( const BOARD_ITEM* aItem )
+            {
+                if( aItem->Type() == PCB_ZONE_T
+                        && static_cast<const ZONE*>( aItem )->GetIsRuleArea() )
+                {
+                    return true;
+                }
+
+                return aItem->IsOnLayer( Edge_Cuts ) || aItem->IsOnLayer( Margin );
+            };
+
+    auto addItem =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                if( isGlobal( aItem ) )
+                    hash_combine( signature, hashItem( io, formatter, aItem ) );
+            };
+
+    for( const BOARD_ITEM* item : m_board->Drawings() )
+        addItem( item );
+
+    for( const ZONE* zone : m_board->Zones() )
+        addItem( zone );
+
+    for( const FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( const BOARD_ITEM* item : footprint->GraphicalItems() )
+            addItem( item );
+
+        for( const ZONE* zone : footprint->Zones() )
+            addItem( zone );
+    }
+
+    return signature;
+}
+
+
+bool DRC_RESULT_CACHE::load( const wxFileName& aPath )
+{
+    m_signature = 0;
+    m_itemHashes.clear();
+    m_violations.clear();
+
+    if( !aPath.FileExists() )
+        return false;
+
+    try
+    {
+        std::ifstream  stream( aPath.GetFullPath().fn_str() );
+        nlohmann::json json = nlohmann::json::parse( stream );
+
+        if( json.at( "version" ).get<int>() != CACHE_VERSION )
+            return false;
+
+        m_signature = std::stoull( json.at( "signature" ).get<std::string>(), nullptr, 16 );
+
+        for( const auto& [id, hash] : json.at( "items" ).items() )
+            m_itemHashes[KIID( id )] = std::stoull( hash.get<std::string>(), nullptr, 16 );
+
+        for( const nlohmann::json& entry : json.at( "violations" ) )
+            m_violations.push_back( DRC_STORED_VIOLATION::FromJson( entry ) );
+    }
+    catch( ... )
+    {
+        // A damaged or foreign file is just a cache miss
+        m_signature = 0;
+        m_itemHashes.clear();
+        m_violations.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool DRC_RESULT_CACHE::save( const wxFileName& aPath ) const
+{
+    nlohmann::json json;
+    nlohmann::json items = nlohmann::json::object();
+    nlohmann::json violations = nlohmann::json::array();
+
+    auto toHex =
+            []( size_t aValue )
+            {
+                wxString hex = wxString::Format( wxS( "%llx" ), (unsigned long long) aValue );
+                return hex.ToStdString();
+            };
+
+    for( const auto& [id, hash] : m_itemHashes )
+        items[id.AsString().ToStdString()] = toHex( hash );
+
+    for( const DRC_STORED_VIOLATION& violation : m_violations )
+        violations.push_back( violation.ToJson() );
+
+    json["version"] = CACHE_VERSION;
+    json["signature"] = toHex( m_signature );
+    json["items"] = items;
+    json["violations"] = violations;
+
+    std::ofstream stream( aPath.GetFullPath().fn_str() );
+
+    if( !stream )
+        return false;
+
+    stream << json << std::endl;
+
+    return stream.good();
+}
+
+
+bool DRC_RESULT_CACHE::RunTests( const wxFileName& aPath, EDA_UNITS aUnits,
+                                 bool aReportAllTrackErrors, bool aTestFootprints )
+{
+    DRC_VIOLATION_HANDLER               handler = m_engine->GetViolationHandler();
+
+    bool                                cached = load( aPath );
+    size_t                              signature = ComputeSignature( aReportAllTrackErrors,
+                                                                      aTestFootprints );
+    std::map<KIID, size_t>              itemHashes;
+    std::set<KIID>                      existing;
+    DRC_INCREMENTAL_SCOPE               scope;
+    PCB_IO_KICAD_SEXPR                  io( CTL_FOR_BOARD );
+    STRING_FORMATTER                    formatter;
+
+    auto addItem =
+            [&]( BOARD_ITEM* aItem )
+            {
+                size_t hash = hashItem( io, formatter, aItem );
+                auto   it = m_itemHashes.find( aItem->m_Uuid );
+
+                itemHashes[aItem->m_Uuid] = hash;
+                existing.insert( aItem->m_Uuid );
+
+                aItem->RunOnDescendants(
+                        [&]( BOARD_ITEM* aChild )
+                        {
+                            existing.insert( aChild->m_Uuid );
+                        } );
+
+                if( it == m_itemHashes.end() || it->second != hash )
+                    scope.AddChangedItem( aItem );
+            };
+
+    for( BOARD_ITEM* item : m_board->Tracks() )
+        addItem( item );
+
+    for( BOARD_ITEM* item : m_board->Footprints() )
+        addItem( item );
+
+    for( BOARD_ITEM* item : m_board->Zones() )
+        addItem( item );
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        addItem( item );
+
+    cached &= signature == m_signature && !scope.NeedsFullRun();
+
+    std::vector<DRC_STORED_VIOLATION> results;
+    std::set<wxString>                reported;
+
+    auto violationKey =
+            []( const DRC_STORED_VIOLATION& aViolation )
+            {
+                wxString key = wxString::Format( wxS( "%s|%d|%d|%d" ), aViolation.m_key,
+                                                 aViolation.m_pos.x, aViolation.m_pos.y,
+                                                 aViolation.m_layer );
+
+                for( const KIID& id : aViolation.m_items )
+                    key << wxS( "|" ) << id.AsString();
+
+                return key;
+            };
+
+    auto record =
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, const VECTOR2I& aPos, int aLayer )
+            {
+                DRC_STORED_VIOLATION violation = DRC_STORED_VIOLATION::FromItem( *m_engine, aItem,
+                                                                                 aPos, aLayer );
+
+                // Violations found again next to the changed items are already reported
+                if( cached && !reported.insert( violationKey( violation ) ).second )
+                    return;
+
+                results.push_back( violation );
+
+                if( handler )
+                    handler( aItem, aPos, aLayer );
+            };
+
+    m_engine->SetViolationHandler( record );
+
+    m_engine->SetTestOptions( aReportAllTrackErrors, aTestFootprints );
+
+    if( cached )
+    {
+        std::set<int> codes = m_engine->GetIncrementalErrorCodes();
+
+        for( const DRC_STORED_VIOLATION& violation : m_violations )
+        {
+            std::shared_ptr<DRC_ITEM> item = violation.ToItem( *m_engine );
+
+            if( !item || !codes.count( item->GetErrorCode() ) )
+                continue;
+
+            // Violations between unchanged items still hold; the others are re-tested
+            if( scope.Touches( *item ) )
+                continue;
+
+            bool stale = false;
+
+            for( const KIID& id : violation.m_items )
+                stale |= id != niluuid && !existing.count( id );
+
+            if( stale )
+                continue;
+
+            record( item, violation.m_pos, violation.m_layer );
+        }
+
+        m_engine->RunIncrementalTests( aUnits, scope, true );
+    }
+    else
+    {
+        m_engine->RunTests( aUnits, aReportAllTrackErrors, aTestFootprints );
+    }
+
+    m_engine->SetViolationHandler( handler );
+
+    if( !m_engine->IsCancelled() )
+    {
+        m_signature = signature;
+        m_itemHashes = std::move( itemHashes );
+        m_violations = std::move( results );
+        save( aPath );
+    }
+
+    return cached;
+}
@@ -0,0 +1,99 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_RESULT_CACHE_H
+#define DRC_RESULT_CACHE_H
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include <drc/drc_stored_violation.h>
+#include <eda_units.h>
+#include <kiid.h>
+#include <wx/filename.h>
+#include <wx/string.h>
+
+class BOARD;
+class BOARD_ITEM;
+class DRC_ENGINE;
+class PCB_IO_KICAD_SEXPR;
+class STRING_FORMATTER;
+
+
+/**
+ * DRC results stored next to a board, so that a later run only re-checks what changed.
+ *
+ * Along with the violations, the cache file holds a hash of each top-level board item and a
+ * signature of everything else the results depend on: the KiCad build, the custom rules, the
+ * board and net settings, the stackup, the board outline and the rule areas.
+ *
+ * When the signature matches, the top-level items whose hash changed are re-tested with
+ * DRC_ENGINE::RunIncrementalTests(), and the stored violations of the incremental error codes
+ * which don't involve them are reported again as they are.  Providers without incremental
+ * support run on the whole board.  Otherwise everything is re-tested.
+ */
+class DRC_RESULT_CACHE
+{
+public:
+    DRC_RESULT_CACHE( DRC_ENGINE* aEngine );
+
+    /**
+     * @return the cache file of \a aBoard, next to the board file.
+     */
+    static wxFileName GetDefaultPath( const BOARD* aBoard );
+
+    /**
+     * Run DRC like DRC_ENGINE::RunTests(), reusing the results stored in \a aPath where they
+     * are still valid.  Violations are reported through the engine's violation handler.  The
+     * cache file is rewritten unless the run is cancelled.
+     *
+     * @return true if results from the cache file were reused.
+     */
+    bool RunTests( const wxFileName& aPath, EDA_UNITS aUnits, bool aReportAllTrackErrors,
+                   bool aTestFootprints );
+
+    /**
+     * @return a hash of everything but the board items which the results of a run depend on:
+     *         the KiCad build, the custom rules, the board and net settings, the stackup, the
+     *         board outline and the rule areas.
+     */
+    size_t ComputeSignature( bool aReportAllTrackErrors, bool aTestFootprints ) const;
+
+private:
+    /**
+     * Hash \a aItem in the board file format, which covers every property of an item.
+     * hash_fp_item() only covers the ones which matter to footprint comparisons, and doesn't
+     * know tracks or zones.
+     */
+    static size_t hashItem( PCB_IO_KICAD_SEXPR& aIO, STRING_FORMATTER& aFormatter,
+                            const BOARD_ITEM* aItem );
+
+    bool load( const wxFileName& aPath );
+    bool save( const wxFileName& aPath ) const;
+
+    DRC_ENGINE*             m_engine;
+    BOARD*                  m_board;
+
+    size_t                  m_signature;
+    std::map<KIID, size_t>  m_itemHashes;
+    std::vector<DRC_STORED_VIOLATION> m_violations;
+};
+
+#endif // DRC_RESULT_CACHE_H
@@ -28,12 +28,15 @@
 #include <board_item.h>
 #include <pad.h>
 #include <pcb_text.h>
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <unordered_set>
 #include <set>
 #include <vector>
 
-#include <geometry/rtree.h>
+#include <geometry/packed_rtree.h>
 #include <geometry/shape.h>
 #include <geometry/shape_segment.h>
 #include <math/vector2d.h>
@@ -43,6 +46,13 @@
 /**
  * Implement an R-tree for fast spatial and layer indexing of connectable items.
  * Non-owning.
+ *
+ * The per-layer trees are packed: items are collected by Insert() and the trees are bulk built
+ * by Build(), or by the first query after the last Insert().  Inserting after querying is
+ * allowed but rebuilds the tree.
+ *
+ * Layers are independent until the tree is queried: different threads may Insert() into and
+ * Build() different target layers at the same time.
  */
 class DRC_RTREE
 {
@@ -75,7 +85,7 @@ public:
 
 private:
 
-    using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
+    using drc_rtree = PACKED_RTREE<ITEM_WITH_SHAPE*>;
 
 public:
 
@@ -85,17 +95,13 @@ public:
             m_tree[layer] = new drc_rtree();
 
         m_count = 0;
+        m_dirty = false;
     }
 
     ~DRC_RTREE()
     {
         for( drc_rtree* tree : m_tree )
-        {
-            for( DRC_RTREE::ITEM_WITH_SHAPE* el : *tree )
-                delete el;
-
             delete tree;
-        }
     }
 
     /**
@@ -121,13 +127,25 @@ public:
             return;
         }
 
-        std::vector<const SHAPE*> subshapes;
-        std::shared_ptr<SHAPE> shape = aItem->GetEffectiveShape( aRefLayer );
+        Insert( aItem, aTargetLayer, aItem->GetEffectiveShape( aRefLayer ), aWorstClearance );
+    }
+
+    /**
+     * Insert an item into the tree on a particular layer, with a shape computed beforehand
+     * (for instance in parallel, or taken from a cache).
+     */
+    void Insert( BOARD_ITEM* aItem, PCB_LAYER_ID aTargetLayer, const std::shared_ptr<SHAPE>& aShape,
+                 int aWorstClearance )
+    {
+        wxCHECK( aTargetLayer != UNDEFINED_LAYER && aShape, /* void */ );
 
-        if( shape->HasIndexableSubshapes() )
-            shape->GetIndexableSubshapes( subshapes );
+        std::vector<const SHAPE*>    subshapes;
+        std::deque<ITEM_WITH_SHAPE>& items = layerItems( aTargetLayer );
+
+        if( aShape->HasIndexableSubshapes() )
+            aShape->GetIndexableSubshapes( subshapes );
         else
-            subshapes.push_back( shape.get() );
+            subshapes.push_back( aShape.get() );
 
         for( const SHAPE* subshape : subshapes )
         {
@@ -138,11 +156,7 @@ public:
 
             bbox.Inflate( aWorstClearance );
 
-            const int        mmin[2] = { bbox.GetX(), bbox.GetY() };
-            const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
-            ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, subshape, shape );
-
-            m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
+            m_tree[aTargetLayer]->Insert( bbox, &items.emplace_back( aItem, subshape, aShape ) );
             m_count++;
         }
 
@@ -153,14 +167,41 @@ public:
 
             bbox.Inflate( aWorstClearance );
 
-            const int        mmin[2] = { bbox.GetX(), bbox.GetY() };
-            const int        mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
-            ITEM_WITH_SHAPE* itemShape = new ITEM_WITH_SHAPE( aItem, hole, shape );
-
-            m_tree[aTargetLayer]->Insert( mmin, mmax, itemShape );
+            m_tree[aTargetLayer]->Insert( bbox, &items.emplace_back( aItem, hole, aShape ) );
             m_count++;
-
         }
+
+        m_dirty = true;
+    }
+
+    /**
+     * Pack the items inserted so far.  Optional: the first query does it otherwise, but
+     * building up front keeps that cost out of the (possibly parallel) test phase.
+     */
+    void Build() const
+    {
+        if( !m_dirty.load( std::memory_order_acquire ) )
+            return;
+
+        std::lock_guard<std::mutex> lock( m_buildMutex );
+
+        if( !m_dirty.load( std::memory_order_relaxed ) )
+            return;
+
+        for( drc_rtree* tree : m_tree )
+            tree->Build();
+
+        m_dirty.store( false, std::memory_order_release );
+    }
+
+    /**
+     * Pack the items inserted so far on \a aLayer only, so that layers can be packed in
+     * parallel.  The tree counts as unbuilt until the next Build(), which then has nothing
+     * left to pack on this layer.
+     */
+    void Build( PCB_LAYER_ID aLayer )
+    {
+        m_tree[aLayer]->Build();
     }
 
     /**
@@ -168,10 +209,14 @@ public:
      */
     void clear()
     {
-        for( auto tree : m_tree )
-            tree->RemoveAll();
+        for( drc_rtree* tree : m_tree )
+            tree->Clear();
+
+        for( std::unique_ptr<std::deque<ITEM_WITH_SHAPE>>& items : m_items )
+            items.reset();
 
         m_count = 0;
+        m_dirty = false;
     }
 
     bool CheckColliding( SHAPE* aRefShape, PCB_LAYER_ID aTargetLayer, int aClearance = 0,
@@ -180,9 +225,6 @@ public:
         BOX2I box = aRefShape->BBox();
         box.Inflate( aClearance );
 
-        int min[2] = { box.GetX(),         box.GetY() };
-        int max[2] = { box.GetRight(),     box.GetBottom() };
-
         int count = 0;
 
         auto visit =
@@ -202,7 +244,8 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        Build();
+        this->m_tree[aTargetLayer]->Search( box, visit );
         return count > 0;
     }
 
@@ -228,9 +271,6 @@ public:
         BOX2I box = aRefItem->GetBoundingBox();
         box.Inflate( aClearance );
 
-        int min[2] = { box.GetX(),     box.GetY() };
-        int max[2] = { box.GetRight(), box.GetBottom() };
-
         std::shared_ptr<SHAPE> refShape = aRefItem->GetEffectiveShape( aRefLayer );
 
         int count = 0;
@@ -272,7 +312,8 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        Build();
+        this->m_tree[aTargetLayer]->Search( box, visit );
         return count;
     }
 
@@ -288,9 +329,6 @@ public:
         BOX2I bbox = aBox;
         bbox.Inflate( aClearance );
 
-        int min[2] = { bbox.GetX(), bbox.GetY() };
-        int max[2] = { bbox.GetRight(), bbox.GetBottom() };
-
         bool     collision = false;
         int      actual = INT_MAX;
         VECTOR2I pos;
@@ -319,7 +357,8 @@ public:
                     return true;
                 };
 
-        this->m_tree[aLayer]->Search( min, max, visit );
+        Build();
+        this->m_tree[aLayer]->Search( bbox, visit );
 
         if( collision )
         {
@@ -341,10 +380,7 @@ public:
     bool QueryColliding( const BOX2I& aBox, SHAPE* aRefShape, PCB_LAYER_ID aLayer ) const
     {
         SHAPE_POLY_SET* poly = dynamic_cast<SHAPE_POLY_SET*>( aRefShape );
-
-        int  min[2] = { aBox.GetX(), aBox.GetY() };
-        int  max[2] = { aBox.GetRight(), aBox.GetBottom() };
-        bool collision = false;
+        bool            collision = false;
 
         // Special case the polygon case.  Otherwise we'll call its Collide() method which will
         // triangulate it as well and then do triangle/triangle collisions.  This ends up being
@@ -356,7 +392,7 @@ public:
                     wxASSERT( dynamic_cast<const SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI*>( shape ) );
                     auto tri = static_cast<const SHAPE_POLY_SET::TRIANGULATED_POLYGON::TRI*>( shape );
 
-                    const SHAPE_LINE_CHAIN& outline = poly->Outline( 0 );
+                    const SHAPE_LINE_CHAIN& outline = poly->COutline( 0 );
 
                     for( int ii = 0; ii < (int) tri->GetSegmentCount(); ++ii )
                     {
@@ -389,10 +425,12 @@ public:
                     return true;
                 };
 
+        Build();
+
         if( poly && poly->OutlineCount() == 1 && poly->HoleCount( 0 ) == 0 )
-            this->m_tree[aLayer]->Search( min, max, polyVisitor );
+            this->m_tree[aLayer]->Search( aBox, polyVisitor );
         else
-            this->m_tree[aLayer]->Search( min, max, visitor );
+            this->m_tree[aLayer]->Search( aBox, visitor );
 
         return collision;
     }
@@ -407,8 +445,9 @@ public:
                                                   int aClearance = 0 )
     {
         std::unordered_set<BOARD_ITEM*> retval;
-        int min[2] = { aPt.x - aClearance, aPt.y - aClearance };
-        int max[2] = { aPt.x + aClearance, aPt.y + aClearance };
+        BOX2I                           box( aPt, VECTOR2I( 0, 0 ) );
+
+        box.Inflate( aClearance );
 
         auto visitor =
                 [&]( ITEM_WITH_SHAPE* aItem ) -> bool
@@ -417,7 +456,8 @@ public:
                     return true;
                 };
 
-        m_tree[aLayer]->Search( min, max, visitor );
+        Build();
+        m_tree[aLayer]->Search( box, visitor );
 
         return retval;
     }
@@ -437,41 +477,50 @@ public:
         ITEM_WITH_SHAPE* testItem;
     };
 
-    int QueryCollidingPairs( DRC_RTREE* aRefTree, std::vector<LAYER_PAIR> aLayerPairs,
-                             std::function<bool( const LAYER_PAIR&, ITEM_WITH_SHAPE*,
-                                                 ITEM_WITH_SHAPE*, bool* aCollision )> aVisitor,
-                             int aMaxClearance,
-                             std::function<bool(int, int )> aProgressReporter ) const
+    /**
+     * Collect the pairs of items of \a aRefTree and of this tree whose bounding boxes are within
+     * \a aMaxClearance of each other on each of \a aLayerPairs (reference layer first).  Items
+     * aren't paired with themselves.  The shapes of the pairs still have to be collided.
+     */
+    std::vector<PAIR_INFO> QueryCandidatePairs( DRC_RTREE* aRefTree,
+                                                const std::vector<LAYER_PAIR>& aLayerPairs,
+                                                int aMaxClearance ) const
     {
         std::vector<PAIR_INFO> pairsToVisit;
 
-        for( LAYER_PAIR& layerPair : aLayerPairs )
+        Build();
+        aRefTree->Build();
+
+        for( const LAYER_PAIR& layerPair : aLayerPairs )
         {
             const PCB_LAYER_ID refLayer = layerPair.first;
             const PCB_LAYER_ID targetLayer = layerPair.second;
 
-            for( ITEM_WITH_SHAPE* refItem : aRefTree->OnLayer( refLayer ) )
-            {
-                BOX2I box = refItem->shape->BBox();
-                box.Inflate( aMaxClearance );
-
-                int min[2] = { box.GetX(),     box.GetY() };
-                int max[2] = { box.GetRight(), box.GetBottom() };
+            // Both trees are walked together, which avoids one search per reference item.  The
+            // reference boxes are the ones stored in aRefTree, so any clearance it was built
+            // with only adds candidates.
+            aRefTree->m_tree[refLayer]->SearchPairs( *m_tree[targetLayer], aMaxClearance,
+                    [&]( ITEM_WITH_SHAPE* aRefItem, ITEM_WITH_SHAPE* aItemToTest ) -> bool
+                    {
+                        // don't collide items against themselves
+                        if( aItemToTest->parent != aRefItem->parent )
+                            pairsToVisit.emplace_back( layerPair, aRefItem, aItemToTest );
 
-                auto visit =
-                        [&]( ITEM_WITH_SHAPE* aItemToTest ) -> bool
-                        {
-                            // don't collide items against themselves
-                            if( aItemToTest->parent == refItem->parent )
-                                return true;
+                        return true;
+                    } );
+        }
 
-                            pairsToVisit.emplace_back( layerPair, refItem, aItemToTest );
-                            return true;
-                        };
+        return pairsToVisit;
+    }
 
-                this->m_tree[targetLayer]->Search( min, max, visit );
-            };
-        }
+    int QueryCollidingPairs( DRC_RTREE* aRefTree, std::vector<LAYER_PAIR> aLayerPairs,
+                             std::function<bool( const LAYER_PAIR&, ITEM_WITH_SHAPE*,
+                                                 ITEM_WITH_SHAPE*, bool* aCollision )> aVisitor,
+                             int aMaxClearance,
+                             std::function<bool(int, int )> aProgressReporter ) const
+    {
+        std::vector<PAIR_INFO> pairsToVisit = QueryCandidatePairs( aRefTree, aLayerPairs,
+                                                                   aMaxClearance );
 
         // keep track of BOARD_ITEMs pairs that have been already found to collide (some items
         // might be build of COMPOUND/triangulated shapes and a single subshape collision
@@ -524,7 +573,23 @@ public:
         return m_count == 0;
     }
 
-    using iterator = typename drc_rtree::Iterator;
+    /**
+     * Return the estimated memory held by the tree, in bytes.
+     *
+     * Shapes owned by the items are not included.  Nodes are at least half full, so two
+     * branches per item cover both the slack in the leaves and the inner levels of the tree.
+     */
+    size_t GetMemoryUsage() const
+    {
+        size_t usage = m_count * sizeof( ITEM_WITH_SHAPE );
+
+        for( drc_rtree* tree : m_tree )
+            usage += tree->GetMemoryUsage();
+
+        return usage;
+    }
+
+    using iterator = typename drc_rtree::const_iterator;
 
     /**
      * The DRC_LAYER struct provides a layer-specific auto-range iterator to the RTree.  Using
@@ -536,33 +601,42 @@ public:
      */
     struct DRC_LAYER
     {
-        DRC_LAYER( drc_rtree* aTree ) : layer_tree( aTree )
-        {
-            m_rect = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
-        };
-
-        DRC_LAYER( drc_rtree* aTree, const BOX2I& aRect ) : layer_tree( aTree )
+        DRC_LAYER( const drc_rtree* aTree ) :
+                m_tree( aTree ),
+                m_all( true )
+        {}
+
+        DRC_LAYER( const drc_rtree* aTree, const BOX2I& aRect ) :
+                m_tree( aTree ),
+                m_all( false )
         {
-            m_rect = { { aRect.GetX(), aRect.GetY() },
-                       { aRect.GetRight(), aRect.GetBottom() } };
-        };
-
-        drc_rtree::Rect m_rect;
-        drc_rtree*      layer_tree;
+            aTree->Search( aRect,
+                           [&]( ITEM_WITH_SHAPE* aItem )
+                           {
+                               m_found.push_back( aItem );
+                               return true;
+                           } );
+        }
 
-        iterator begin()
+        iterator begin() const
         {
-            return layer_tree->begin( m_rect );
+            return m_all ? m_tree->begin() : m_found.cbegin();
         }
 
-        iterator end()
+        iterator end() const
         {
-            return layer_tree->end( m_rect );
+            return m_all ? m_tree->end() : m_found.cend();
         }
+
+    private:
+        const drc_rtree*              m_tree;
+        bool                          m_all;
+        std::vector<ITEM_WITH_SHAPE*> m_found;
     };
 
     DRC_LAYER OnLayer( PCB_LAYER_ID aLayer ) const
     {
+        Build();
         return DRC_LAYER( m_tree[int( aLayer )] );
     }
 
@@ -570,18 +644,35 @@ public:
     {
         BOX2I rect( aPoint, VECTOR2I( 0, 0 ) );
         rect.Inflate( aAccuracy );
-        return DRC_LAYER( m_tree[int( aLayer )], rect );
+        return Overlapping( aLayer, rect );
     }
 
     DRC_LAYER Overlapping( PCB_LAYER_ID aLayer, const BOX2I& aRect ) const
     {
+        Build();
         return DRC_LAYER( m_tree[int( aLayer )], aRect );
     }
 
 
 private:
-    drc_rtree*  m_tree[PCB_LAYER_ID_COUNT];
-    size_t      m_count;
+    std::deque<ITEM_WITH_SHAPE>& layerItems( PCB_LAYER_ID aLayer )
+    {
+        // Allocated on demand: most trees (the zone ones for instance) use very few layers
+        if( !m_items[aLayer] )
+            m_items[aLayer] = std::make_unique<std::deque<ITEM_WITH_SHAPE>>();
+
+        return *m_items[aLayer];
+    }
+
+private:
+    drc_rtree*                  m_tree[PCB_LAYER_ID_COUNT];
+    std::atomic<size_t>         m_count;
+
+    /// Storage for the tree payloads, per target layer
+    std::unique_ptr<std::deque<ITEM_WITH_SHAPE>> m_items[PCB_LAYER_ID_COUNT];
+
+    mutable std::atomic<bool>   m_dirty;     ///< items were inserted since the last Build()
+    mutable std::mutex          m_buildMutex;
 };
 
 
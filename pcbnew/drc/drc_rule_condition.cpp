@@ -27,10 +27,127 @@
 #include <drc/drc_rule_condition.h>
 #include <pcbexpr_evaluator.h>
 
+#include <chrono>
+#include <map>
+
+
+/**
+ * Work out which item properties \a aExpression reads.
+ *
+ * Only properties and functions of the A, B and AB objects which are known to depend on
+ * nothing but the net, netclass, via type, layer or footprint of an item are recognised;
+ * anything else makes the condition depend on anything.
+ */
+static int findDependencies( const wxString& aExpression )
+{
+    // Keys are lower case, without underscores
+    static const std::map<wxString, int> properties =
+    {
+        { wxT( "net" ),         DRC_DEPENDS_ON_NET },
+        { wxT( "netname" ),     DRC_DEPENDS_ON_NET },
+        { wxT( "netclass" ),    DRC_DEPENDS_ON_NETCLASS },
+        { wxT( "type" ),        0 },
+        { wxT( "viatype" ),     DRC_DEPENDS_ON_VIA_TYPE },
+        { wxT( "layer" ),       DRC_DEPENDS_ON_LAYER },
+        { wxT( "reference" ),   DRC_DEPENDS_ON_FOOTPRINT }
+    };
+
+    static const std::map<wxString, int> functions =
+    {
+        { wxT( "indiffpair" ),          DRC_DEPENDS_ON_NET },
+        { wxT( "iscoupleddiffpair" ),   DRC_DEPENDS_ON_NET },
+        { wxT( "ismicrovia" ),          DRC_DEPENDS_ON_VIA_TYPE },
+        { wxT( "isblindburiedvia" ),    DRC_DEPENDS_ON_VIA_TYPE },
+        { wxT( "memberoffootprint" ),   DRC_DEPENDS_ON_FOOTPRINT }
+    };
+
+    auto isIdentChar =
+            []( wxUniChar c )
+            {
+                return wxIsalnum( c ) || c == '_';
+            };
+
+    int    deps = 0;
+    size_t len = aExpression.length();
+    size_t ii = 0;
+
+    while( ii < len )
+    {
+        wxUniChar c = aExpression[ii];
+
+        if( c == '\'' || c == '"' )
+        {
+            // Skip string literals
+            for( ++ii; ii < len && aExpression[ii] != c; ++ii )
+            {
+                if( aExpression[ii] == '\\' )
+                    ++ii;
+            }
+
+            ++ii;
+        }
+        else if( wxIsdigit( c ) )
+        {
+            // Skip numbers along with their units
+            while( ii < len && ( isIdentChar( aExpression[ii] ) || aExpression[ii] == '.' ) )
+                ++ii;
+        }
+        else if( isIdentChar( c ) )
+        {
+            size_t start = ii;
+
+            while( ii < len && isIdentChar( aExpression[ii] ) )
+                ++ii;
+
+            wxString ident = aExpression.Mid( start, ii - start );
+
+            if( ident == wxT( "L" ) )
+                continue;   // the layer under test is always part of the cache key
+
+            if( ( ident != wxT( "A" ) && ident != wxT( "B" ) && ident != wxT( "AB" ) )
+                    || ii >= len || aExpression[ii] != '.' )
+            {
+                return DRC_DEPENDS_ON_ANYTHING;
+            }
+
+            start = ++ii;
+
+            while( ii < len && isIdentChar( aExpression[ii] ) )
+                ++ii;
+
+            wxString member = aExpression.Mid( start, ii - start ).Lower();
+            member.Replace( wxT( "_" ), wxEmptyString );
+
+            while( ii < len && aExpression[ii] == ' ' )
+                ++ii;
+
+            const std::map<wxString, int>& known = ( ii < len && aExpression[ii] == '(' )
+                                                           ? functions : properties;
+            auto it = known.find( member );
+
+            if( it == known.end() )
+                return DRC_DEPENDS_ON_ANYTHING;
+
+            deps |= it->second;
+        }
+        else
+        {
+            ++ii;
+        }
+    }
+
+    return deps;
+}
+
 
 DRC_RULE_CONDITION::DRC_RULE_CONDITION( const wxString& aExpression ) :
     m_expression( aExpression ),
-    m_ucode ( nullptr )
+    m_ucode ( nullptr ),
+    m_dependencies( DRC_DEPENDS_ON_ANYTHING ),
+    m_collectStatistics( false ),
+    m_evaluations( 0 ),
+    m_cachedResults( 0 ),
+    m_evaluationTime( 0 )
 {
 }
 
@@ -40,8 +157,34 @@ DRC_RULE_CONDITION::~DRC_RULE_CONDITION()
 }
 
 
+void DRC_RULE_CONDITION::ClearStatistics()
+{
+    m_evaluations = 0;
+    m_cachedResults = 0;
+    m_evaluationTime = 0;
+}
+
+
 bool DRC_RULE_CONDITION::EvaluateFor( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
                                       int aConstraint, PCB_LAYER_ID aLayer, REPORTER* aReporter )
+{
+    if( !m_collectStatistics )
+        return evaluate( aItemA, aItemB, aConstraint, aLayer, aReporter );
+
+    auto start = std::chrono::steady_clock::now();
+    bool result = evaluate( aItemA, aItemB, aConstraint, aLayer, aReporter );
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count();
+
+    m_evaluations.fetch_add( 1, std::memory_order_relaxed );
+    m_evaluationTime.fetch_add( ns, std::memory_order_relaxed );
+
+    return result;
+}
+
+
+bool DRC_RULE_CONDITION::evaluate( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB,
+                                   int aConstraint, PCB_LAYER_ID aLayer, REPORTER* aReporter )
 {
     if( GetExpression().IsEmpty() )
         return true;
@@ -112,6 +255,9 @@ bool DRC_RULE_CONDITION::Compile( REPORTER* aReporter, int aSourceLine, int aSou
     PCBEXPR_CONTEXT preflightContext( 0, F_Cu );
 
     bool ok = compiler.Compile( GetExpression().ToUTF8().data(), m_ucode.get(), &preflightContext );
+
+    m_dependencies = ok ? findDependencies( GetExpression() ) : DRC_DEPENDS_ON_ANYTHING;
+
     return ok;
 }
 
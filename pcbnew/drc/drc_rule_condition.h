@@ -24,6 +24,9 @@
 #ifndef DRC_RULE_CONDITION_H
 #define DRC_RULE_CONDITION_H
 
+#include <atomic>
+#include <cstdint>
+
 #include <core/typeinfo.h>
 #include <layer_ids.h>
 
@@ -32,6 +35,21 @@ class PCBEXPR_UCODE;
 class REPORTER;
 
 
+/**
+ * The item properties a condition can depend on, beyond the item type and the layer under
+ * test (see DRC_RULE_CONDITION::GetDependencies()).
+ */
+enum DRC_CONDITION_DEPENDENCY
+{
+    DRC_DEPENDS_ON_NET       = 1 << 0,
+    DRC_DEPENDS_ON_NETCLASS  = 1 << 1,
+    DRC_DEPENDS_ON_VIA_TYPE  = 1 << 2,
+    DRC_DEPENDS_ON_LAYER     = 1 << 3,    ///< the item's own layer
+    DRC_DEPENDS_ON_FOOTPRINT = 1 << 4,    ///< the item's (parent) footprint
+    DRC_DEPENDS_ON_ANYTHING  = 1 << 5     ///< geometry, other properties, ...
+};
+
+
 class DRC_RULE_CONDITION
 {
 public:
@@ -46,9 +64,47 @@ public:
     void SetExpression( const wxString& aExpression ) { m_expression = aExpression; }
     wxString GetExpression() const { return m_expression; }
 
+    /**
+     * Items for which all these properties (plus the type) are equal give the same result,
+     * so results can be shared between them.  Worked out from the expression by Compile().
+     *
+     * @return a mask of DRC_CONDITION_DEPENDENCY flags, for either item.
+     */
+    int GetDependencies() const { return m_dependencies; }
+
+    /**
+     * Count the evaluations and the time spent in EvaluateFor(), for DRC timing reports.
+     * Timing every evaluation isn't free, so this is off by default.
+     */
+    void SetCollectStatistics( bool aCollect ) { m_collectStatistics = aCollect; }
+    void ClearStatistics();
+
+    /**
+     * Count a result of this condition which was reused instead of evaluated.
+     */
+    void CountCachedResult()
+    {
+        if( m_collectStatistics )
+            m_cachedResults.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    int64_t GetEvaluationCount() const { return m_evaluations; }
+    int64_t GetCachedResultCount() const { return m_cachedResults; }
+    int64_t GetEvaluationTime() const { return m_evaluationTime; }   ///< nanoseconds
+
+private:
+    bool evaluate( const BOARD_ITEM* aItemA, const BOARD_ITEM* aItemB, int aConstraint,
+                   PCB_LAYER_ID aLayer, REPORTER* aReporter );
+
 private:
     wxString                       m_expression;
     std::unique_ptr<PCBEXPR_UCODE> m_ucode;
+    int                            m_dependencies;
+
+    bool                           m_collectStatistics;
+    std::atomic<int64_t>           m_evaluations;
+    std::atomic<int64_t>           m_cachedResults;
+    std::atomic<int64_t>           m_evaluationTime;
 };
 
 
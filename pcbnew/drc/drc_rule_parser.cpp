@@ -22,7 +22,9 @@
  */
 
 
+#include <base_units.h>
 #include <board.h>
+#include <math/util.h>
 #include <zones.h>
 #include <drc/drc_rule_parser.h>
 #include <drc/drc_rule_condition.h>
@@ -563,6 +565,36 @@ void DRC_RULES_PARSER::parseConstraint( DRC_RULE* aRule )
 
 void DRC_RULES_PARSER::parseValueWithUnits( const wxString& aExpr, int& aResult, bool aUnitless )
 {
+    // Plain values such as "0.2mm" are by far the most common; convert them directly rather
+    // than compiling an expression for each one
+    wxScopedCharBuffer utf8 = aExpr.ToUTF8();
+    const char*        begin = utf8.data();
+    const char*        end = begin + utf8.length();
+    const char*        unit = end;
+
+    while( unit > begin && isalpha( (unsigned char) unit[-1] ) )
+        --unit;
+
+    std::string suffix( unit, end );
+    long long   scale = 0;
+    long long   value;
+
+    if( aUnitless )
+        scale = suffix.empty() ? 1 : 0;
+    else if( suffix == "mm" )
+        scale = KiROUND( pcbIUScale.IU_PER_MM );
+    else if( suffix == "mil" )
+        scale = KiROUND( pcbIUScale.IU_PER_MILS );
+    else if( suffix == "in" )
+        scale = KiROUND( pcbIUScale.IU_PER_MILS ) * 1000;
+
+    if( scale && parseScaledDecimal( begin, unit, scale, value ) )
+    {
+        aResult = static_cast<int>( Clamp<long long>( std::numeric_limits<int>::min(), value,
+                                                      std::numeric_limits<int>::max() ) );
+        return;
+    }
+
     auto errorHandler = [&]( const wxString& aMessage, int aOffset )
     {
         wxString rest;
@@ -0,0 +1,368 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <drc/drc_shards.h>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <map>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+#include <wx/app.h>
+#include <wx/apptrait.h>
+#include <wx/evtloop.h>
+#include <wx/filename.h>
+#include <wx/process.h>
+#include <wx/stdpaths.h>
+#include <wx/stream.h>
+
+#include <board.h>
+#include <base_units.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <footprint.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <reporter.h>
+#include <string_utils.h>
+#include <zone.h>
+
+
+/// Bumped whenever the contents of the shard files change meaning
+static const int SHARD_FILE_VERSION = 1;
+
+
+BOX2I DRC_SHARDS::GetShardArea( const BOARD* aBoard, int aIndex, int aCount )
+{
+    BOX2I bbox;
+
+    // Not BOARD::ComputeBoundingBox(), which depends on the visibility settings
+    for( const PCB_TRACK* track : aBoard->Tracks() )
+        bbox.Merge( track->GetBoundingBox() );
+
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
+        bbox.Merge( footprint->GetBoundingBox() );
+
+    for( const ZONE* zone : aBoard->Zones() )
+        bbox.Merge( zone->GetBoundingBox() );
+
+    for( const BOARD_ITEM* drawing : aBoard->Drawings() )
+        bbox.Merge( drawing->GetBoundingBox() );
+
+    if( !bbox.IsValid() )
+        bbox = BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 0, 0 ) );
+
+    // Violations are located on the items; leave some room around the outer ones anyway
+    bbox.Inflate( pcbIUScale.mmToIU( 10 ) );
+
+    if( aCount <= 1 )
+        return bbox;
+
+    bool             alongX = bbox.GetWidth() >= bbox.GetHeight();
+    std::vector<int> coords;
+
+    for( const PCB_TRACK* track : aBoard->Tracks() )
+    {
+        VECTOR2I center = track->GetBoundingBox().GetCenter();
+        coords.push_back( alongX ? center.x : center.y );
+    }
+
+    for( const FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( const PAD* pad : footprint->Pads() )
+            coords.push_back( alongX ? pad->GetPosition().x : pad->GetPosition().y );
+    }
+
+    std::sort( coords.begin(), coords.end() );
+
+    int lo = alongX ? bbox.GetLeft() : bbox.GetTop();
+    int hi = alongX ? bbox.GetRight() : bbox.GetBottom();
+
+    auto cut =
+            [&]( int aShard ) -> int
+            {
+                if( aShard <= 0 )
+                    return lo;
+                else if( aShard >= aCount )
+                    return hi;
+                else if( coords.empty() )
+                    return lo + static_cast<int>( int64_t( hi - lo ) * aShard / aCount );
+                else
+                    return coords[ coords.size() * aShard / aCount ];
+            };
+
+    int start = cut( aIndex );
+    int end = cut( aIndex + 1 );
+
+    if( alongX )
+        return BOX2I( VECTOR2I( start, bbox.GetTop() ), VECTOR2I( end - start, bbox.GetHeight() ) );
+    else
+        return BOX2I( VECTOR2I( bbox.GetLeft(), start ), VECTOR2I( bbox.GetWidth(), end - start ) );
+}
+
+
+bool DRC_SHARDS::WriteShard( const wxString& aPath, int aIndex, int aCount, size_t aSignature,
+                             const std::vector<DRC_STORED_VIOLATION>& aViolations )
+{
+    nlohmann::json json;
+    nlohmann::json violations = nlohmann::json::array();
+
+    for( const DRC_STORED_VIOLATION& violation : aViolations )
+        violations.push_back( violation.ToJson() );
+
+    json["version"] = SHARD_FILE_VERSION;
+    json["signature"] = wxString::Format( wxS( "%llx" ),
+                                          (unsigned long long) aSignature ).ToStdString();
+    json["shard"] = aIndex;
+    json["shards"] = aCount;
+    json["violations"] = violations;
+
+    std::ofstream stream( aPath.fn_str() );
+
+    if( !stream )
+        return false;
+
+    stream << json << std::endl;
+
+    return stream.good();
+}
+
+
+namespace
+{
+
+/**
+ * A worker process.  Its output is drained as it comes, so that it doesn't block on a full
+ * pipe; stderr is kept to explain failures.
+ */
+class DRC_SHARD_PROCESS : public wxProcess
+{
+public:
+    DRC_SHARD_PROCESS() :
+            wxProcess( wxPROCESS_REDIRECT ),
+            m_finished( false ),
+            m_exitCode( -1 )
+    {
+    }
+
+    void OnTerminate( int aPid, int aStatus ) override
+    {
+        Drain();
+        m_exitCode = aStatus;
+        m_finished = true;
+    }
+
+    void Drain()
+    {
+        char buffer[4096];
+
+        while( IsInputAvailable() )
+            GetInputStream()->Read( buffer, sizeof( buffer ) );
+
+        while( IsErrorAvailable() )
+        {
+            GetErrorStream()->Read( buffer, sizeof( buffer ) );
+            m_errors.append( buffer, GetErrorStream()->LastRead() );
+        }
+    }
+
+    bool        m_finished;
+    int         m_exitCode;
+    std::string m_errors;
+};
+
+} // namespace
+
+
+bool DRC_SHARDS::RunWorkers( const wxString& aBoardFile, int aCount,
+                             const std::vector<wxString>& aWorkerArgs,
+                             std::vector<wxString>& aShardFiles, REPORTER& aReporter )
+{
+    wxString   exe = wxStandardPaths::Get().GetExecutablePath();
+    wxFileName boardFn( aBoardFile );
+
+    // Share the cores between the workers rather than have each of them use all of them
+    int threads = std::max<int>( 1, std::thread::hardware_concurrency() / aCount );
+
+    // The ends of the workers are only noticed by an event loop, and kicad-cli has none.  Use
+    // one of the kind the application works with (kicad-cli is a console application).
+    std::unique_ptr<wxEventLoopBase> loop( wxTheApp->GetTraits()->CreateEventLoop() );
+    wxEventLoopActivator             activate( loop.get() );
+    std::vector<DRC_SHARD_PROCESS*>  processes;
+    bool                             ok = true;
+
+    aShardFiles.clear();
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        wxFileName shardFn( wxStandardPaths::Get().GetTempDir(),
+                            wxString::Format( wxS( "%s-drc-shard-%d-%d-%lu" ), boardFn.GetName(),
+                                              ii, aCount, wxGetProcessId() ),
+                            wxS( "json" ) );
+
+        std::vector<wxString> args = { exe, wxS( "--threads" ),
+                                       wxString::Format( wxS( "%d" ), threads ),
+                                       wxS( "pcb" ), wxS( "drc" ), wxS( "--shard" ),
+                                       wxString::Format( wxS( "%d/%d" ), ii, aCount ),
+                                       wxS( "--output" ), shardFn.GetFullPath() };
+
+        args.insert( args.end(), aWorkerArgs.begin(), aWorkerArgs.end() );
+        args.push_back( aBoardFile );
+
+        std::vector<const wchar_t*> argv;
+
+        for( const wxString& arg : args )
+            argv.push_back( arg.wc_str() );
+
+        argv.push_back( nullptr );
+
+        DRC_SHARD_PROCESS* process = new DRC_SHARD_PROCESS();
+
+        if( wxExecute( const_cast<wchar_t**>( argv.data() ), wxEXEC_ASYNC | wxEXEC_HIDE_CONSOLE,
+                       process ) <= 0 )
+        {
+            aReporter.Report( wxString::Format( _( "Unable to start DRC worker %d\n" ), ii ),
+                              RPT_SEVERITY_ERROR );
+            delete process;
+            ok = false;
+            break;
+        }
+
+        processes.push_back( process );
+        aShardFiles.push_back( shardFn.GetFullPath() );
+    }
+
+    auto running =
+            [&]()
+            {
+                return std::any_of( processes.begin(), processes.end(),
+                                    []( DRC_SHARD_PROCESS* aProcess )
+                                    {
+                                        return !aProcess->m_finished;
+                                    } );
+            };
+
+    while( running() )
+    {
+        loop->DispatchTimeout( 100 );
+
+        for( DRC_SHARD_PROCESS* process : processes )
+        {
+            if( !process->m_finished )
+                process->Drain();
+        }
+    }
+
+    for( size_t ii = 0; ii < processes.size(); ++ii )
+    {
+        if( processes[ii]->m_exitCode != 0 )
+        {
+            aReporter.Report( wxString::Format( _( "DRC worker %d failed (exit code %d)\n%s" ),
+                                                (int) ii, processes[ii]->m_exitCode,
+                                                From_UTF8( processes[ii]->m_errors.c_str() ) ),
+                              RPT_SEVERITY_ERROR );
+            ok = false;
+        }
+
+        delete processes[ii];
+    }
+
+    return ok;
+}
+
+
+bool DRC_SHARDS::MergeShards( DRC_ENGINE* aEngine, const std::vector<wxString>& aShardFiles,
+                              size_t aSignature, REPORTER& aReporter )
+{
+    std::map<int, std::vector<DRC_STORED_VIOLATION>> shards;
+    int                                              count = -1;
+    std::string signature = wxString::Format( wxS( "%llx" ),
+                                              (unsigned long long) aSignature ).ToStdString();
+
+    for( const wxString& path : aShardFiles )
+    {
+        try
+        {
+            std::ifstream  stream( path.fn_str() );
+            nlohmann::json json = nlohmann::json::parse( stream );
+            int            shard = json.at( "shard" ).get<int>();
+
+            if( json.at( "version" ).get<int>() != SHARD_FILE_VERSION
+                    || json.at( "signature" ).get<std::string>() != signature )
+            {
+                aReporter.Report( wxString::Format( _( "DRC shard %s was made with other rules "
+                                                       "or settings\n" ), path ),
+                                  RPT_SEVERITY_ERROR );
+                return false;
+            }
+
+            if( count >= 0 && json.at( "shards" ).get<int>() != count )
+            {
+                aReporter.Report( wxString::Format( _( "DRC shard %s is from another split of "
+                                                       "the board\n" ), path ),
+                                  RPT_SEVERITY_ERROR );
+                return false;
+            }
+
+            count = json.at( "shards" ).get<int>();
+
+            if( shards.count( shard ) )
+            {
+                aReporter.Report( wxString::Format( _( "DRC shard %d given twice\n" ), shard ),
+                                  RPT_SEVERITY_ERROR );
+                return false;
+            }
+
+            std::vector<DRC_STORED_VIOLATION>& violations = shards[shard];
+
+            for( const nlohmann::json& entry : json.at( "violations" ) )
+                violations.push_back( DRC_STORED_VIOLATION::FromJson( entry ) );
+        }
+        catch( ... )
+        {
+            aReporter.Report( wxString::Format( _( "Unable to read DRC shard %s\n" ), path ),
+                              RPT_SEVERITY_ERROR );
+            return false;
+        }
+    }
+
+    if( count < 0 || (int) shards.size() != count || shards.begin()->first != 0
+            || shards.rbegin()->first != count - 1 )
+    {
+        aReporter.Report( _( "DRC shards are missing\n" ), RPT_SEVERITY_ERROR );
+        return false;
+    }
+
+    DRC_VIOLATION_HANDLER handler = aEngine->GetViolationHandler();
+
+    for( const auto& [shard, violations] : shards )
+    {
+        for( const DRC_STORED_VIOLATION& violation : violations )
+        {
+            std::shared_ptr<DRC_ITEM> item = violation.ToItem( *aEngine );
+
+            if( item && handler )
+                handler( item, violation.m_pos, violation.m_layer );
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,85 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_SHARDS_H
+#define DRC_SHARDS_H
+
+#include <vector>
+
+#include <drc/drc_stored_violation.h>
+#include <math/box2.h>
+#include <wx/string.h>
+
+class BOARD;
+class DRC_ENGINE;
+class REPORTER;
+
+
+/**
+ * Sharded DRC: a coordinator splits a board in strips, and runs one worker per strip.  Each
+ * worker is a kicad-cli process which runs DRC restricted to its strip (see DRC_REGION), and
+ * saves the violations it found.  The coordinator then merges them and writes the report.
+ *
+ * Every worker computes the strips from the board it loaded, so that they partition it exactly.
+ * The strips are cut across the longer side of the board, balanced by the number of pads and
+ * tracks in each of them.
+ *
+ * Workers can also run on other machines: run "kicad-cli pcb drc --shard I/N" on each one, and
+ * merge their files with "kicad-cli pcb drc --merge-shards".
+ */
+class DRC_SHARDS
+{
+public:
+    /**
+     * @return the area of shard \a aIndex of \a aCount of \a aBoard.
+     */
+    static BOX2I GetShardArea( const BOARD* aBoard, int aIndex, int aCount );
+
+    /**
+     * Save the violations found by a worker.
+     *
+     * @param aSignature see DRC_RESULT_CACHE::ComputeSignature().  Shards are only merged by a
+     *                   coordinator with the same rules and settings.
+     */
+    static bool WriteShard( const wxString& aPath, int aIndex, int aCount, size_t aSignature,
+                            const std::vector<DRC_STORED_VIOLATION>& aViolations );
+
+    /**
+     * Run \a aCount workers on \a aBoardFile, in parallel, and wait for them to finish.
+     *
+     * @param aWorkerArgs arguments given to each worker after "pcb drc".
+     * @param aShardFiles receives the files of the shards, to be merged and then removed.
+     * @return false if a worker failed.
+     */
+    static bool RunWorkers( const wxString& aBoardFile, int aCount,
+                            const std::vector<wxString>& aWorkerArgs,
+                            std::vector<wxString>& aShardFiles, REPORTER& aReporter );
+
+    /**
+     * Report the violations of \a aShardFiles through the violation handler of \a aEngine,
+     * in shard order.
+     *
+     * @return false if a file can't be read, comes from another board setup, or if the files
+     *         don't hold every shard exactly once.
+     */
+    static bool MergeShards( DRC_ENGINE* aEngine, const std::vector<wxString>& aShardFiles,
+                             size_t aSignature, REPORTER& aReporter );
+};
+
+#endif // DRC_SHARDS_H
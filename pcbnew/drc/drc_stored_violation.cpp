@@ -0,0 +1,110 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <drc/drc_stored_violation.h>
+
+#include <nlohmann/json.hpp>
+
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <drc/drc_rule.h>
+#include <drc/drc_test_provider.h>
+#include <string_utils.h>
+
+
+DRC_STORED_VIOLATION DRC_STORED_VIOLATION::FromItem( const DRC_ENGINE& aEngine,
+                                                     const std::shared_ptr<DRC_ITEM>& aItem,
+                                                     const VECTOR2I& aPos, int aLayer )
+{
+    const std::vector<std::shared_ptr<DRC_RULE>>& rules = aEngine.GetRules();
+    DRC_STORED_VIOLATION                          violation;
+
+    violation.m_key = aItem->GetSettingsKey();
+    violation.m_message = aItem->GetErrorMessage();
+    violation.m_items = aItem->GetIDs();
+    violation.m_pos = aPos;
+    violation.m_layer = aLayer;
+
+    if( aItem->GetViolatingTest() )
+        violation.m_test = aItem->GetViolatingTest()->GetName();
+
+    for( size_t ii = 0; ii < rules.size(); ++ii )
+    {
+        if( rules[ii].get() == aItem->GetViolatingRule() )
+            violation.m_rule = static_cast<int>( ii );
+    }
+
+    return violation;
+}
+
+
+std::shared_ptr<DRC_ITEM> DRC_STORED_VIOLATION::ToItem( const DRC_ENGINE& aEngine ) const
+{
+    const std::vector<std::shared_ptr<DRC_RULE>>& rules = aEngine.GetRules();
+    std::shared_ptr<DRC_ITEM>                     item = DRC_ITEM::Create( m_key );
+
+    if( !item )
+        return nullptr;
+
+    item->SetItems( m_items );
+    item->SetErrorMessage( m_message );
+
+    if( m_rule >= 0 && m_rule < (int) rules.size() )
+        item->SetViolatingRule( rules[m_rule].get() );
+
+    item->SetViolatingTest( aEngine.GetTestProvider( m_test ) );
+
+    return item;
+}
+
+
+nlohmann::json DRC_STORED_VIOLATION::ToJson() const
+{
+    nlohmann::json ids = nlohmann::json::array();
+
+    for( const KIID& id : m_items )
+        ids.push_back( id.AsString().ToStdString() );
+
+    return { { "key", m_key.ToStdString() },
+             { "message", std::string( m_message.ToUTF8() ) },
+             { "rule", m_rule },
+             { "test", m_test.ToStdString() },
+             { "items", ids },
+             { "x", m_pos.x },
+             { "y", m_pos.y },
+             { "layer", m_layer } };
+}
+
+
+DRC_STORED_VIOLATION DRC_STORED_VIOLATION::FromJson( const nlohmann::json& aJson )
+{
+    DRC_STORED_VIOLATION violation;
+
+    violation.m_key = From_UTF8( aJson.at( "key" ).get<std::string>().c_str() );
+    violation.m_message = From_UTF8( aJson.at( "message" ).get<std::string>().c_str() );
+    violation.m_rule = aJson.at( "rule" ).get<int>();
+    violation.m_test = From_UTF8( aJson.at( "test" ).get<std::string>().c_str() );
+    violation.m_pos = VECTOR2I( aJson.at( "x" ).get<int>(), aJson.at( "y" ).get<int>() );
+    violation.m_layer = aJson.at( "layer" ).get<int>();
+
+    for( const nlohmann::json& id : aJson.at( "items" ) )
+        violation.m_items.emplace_back( id.get<std::string>() );
+
+    return violation;
+}
@@ -0,0 +1,66 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_STORED_VIOLATION_H
+#define DRC_STORED_VIOLATION_H
+
+#include <memory>
+#include <vector>
+
+#include <kiid.h>
+#include <math/vector2d.h>
+#include <nlohmann/json_fwd.hpp>
+#include <wx/string.h>
+
+class DRC_ENGINE;
+class DRC_ITEM;
+
+
+/**
+ * A violation in a form which can be saved to a file and reported again later, by another
+ * DRC_ENGINE with the same rules (the rule is stored by its index in DRC_ENGINE::GetRules()).
+ */
+struct DRC_STORED_VIOLATION
+{
+    wxString          m_key;        ///< error settings key
+    wxString          m_message;
+    int               m_rule = -1;  ///< index in DRC_ENGINE::GetRules(), or -1
+    wxString          m_test;       ///< name of the reporting provider
+    std::vector<KIID> m_items;
+    VECTOR2I          m_pos;
+    int               m_layer = 0;
+
+    static DRC_STORED_VIOLATION FromItem( const DRC_ENGINE& aEngine,
+                                          const std::shared_ptr<DRC_ITEM>& aItem,
+                                          const VECTOR2I& aPos, int aLayer );
+
+    /**
+     * @return a DRC_ITEM for this violation, or nullptr if its error key isn't known.
+     */
+    std::shared_ptr<DRC_ITEM> ToItem( const DRC_ENGINE& aEngine ) const;
+
+    nlohmann::json ToJson() const;
+
+    /**
+     * @throw nlohmann::json::exception if \a aJson is not a stored violation.
+     */
+    static DRC_STORED_VIOLATION FromJson( const nlohmann::json& aJson );
+};
+
+#endif // DRC_STORED_VIOLATION_H
@@ -168,9 +168,16 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             typeMask[ aType ] = true;
     }
 
+    // Incremental runs only visit the neighbourhood of the changed items
+    auto inScope =
+            [&]( const BOARD_ITEM* aItem )
+            {
+                return m_drcEngine->IsInScope( aItem );
+            };
+
     for( PCB_TRACK* item : brd->Tracks() )
     {
-        if( (item->GetLayerSet() & aLayers).any() )
+        if( (item->GetLayerSet() & aLayers).any() && inScope( item ) )
         {
             if( typeMask[ PCB_TRACE_T ] && item->Type() == PCB_TRACE_T )
             {
@@ -192,7 +199,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
 
     for( BOARD_ITEM* item : brd->Drawings() )
     {
-        if( (item->GetLayerSet() & aLayers).any() )
+        if( (item->GetLayerSet() & aLayers).any() && inScope( item ) )
         {
             if( typeMask[ PCB_DIMENSION_T ] && BaseType( item->Type() ) == PCB_DIMENSION_T )
             {
@@ -236,7 +243,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
     {
         for( ZONE* item : brd->Zones() )
         {
-            if( ( item->GetLayerSet() & aLayers ).any() )
+            if( ( item->GetLayerSet() & aLayers ).any() && inScope( item ) )
             {
                 if( !aFunc( item ) )
                     return n;
@@ -252,7 +259,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             for( PCB_FIELD* field : footprint->GetFields() )
             {
-                if( ( field->GetLayerSet() & aLayers ).any() )
+                if( ( field->GetLayerSet() & aLayers ).any() && inScope( field ) )
                 {
                     if( !aFunc( field ) )
                         return n;
@@ -267,7 +274,8 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             for( PAD* pad : footprint->Pads() )
             {
                 // Careful: if a pad has a hole then it pierces all layers
-                if( pad->HasHole() || ( pad->GetLayerSet() & aLayers ).any() )
+                if( ( pad->HasHole() || ( pad->GetLayerSet() & aLayers ).any() )
+                        && inScope( pad ) )
                 {
                     if( !aFunc( pad ) )
                         return n;
@@ -279,7 +287,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
 
         for( BOARD_ITEM* dwg : footprint->GraphicalItems() )
         {
-            if( (dwg->GetLayerSet() & aLayers).any() )
+            if( (dwg->GetLayerSet() & aLayers).any() && inScope( dwg ) )
             {
                 if( typeMask[ PCB_DIMENSION_T ] && BaseType( dwg->Type() ) == PCB_DIMENSION_T )
                 {
@@ -316,7 +324,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
         {
             for( ZONE* zone : footprint->Zones() )
             {
-                if( (zone->GetLayerSet() & aLayers).any() )
+                if( (zone->GetLayerSet() & aLayers).any() && inScope( zone ) )
                 {
                     if( !aFunc( zone ) )
                         return n;
@@ -326,7 +334,7 @@ int DRC_TEST_PROVIDER::forEachGeometryItem( const std::vector<KICAD_T>& aTypes,
             }
         }
 
-        if( typeMask[ PCB_FOOTPRINT_T ] )
+        if( typeMask[ PCB_FOOTPRINT_T ] && inScope( footprint ) )
         {
             if( !aFunc( footprint ) )
                 return n;
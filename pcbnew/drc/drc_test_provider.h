@@ -99,6 +99,37 @@ public:
     virtual const wxString GetName() const;
     virtual const wxString GetDescription() const;
 
+    /**
+     * How DRC_ENGINE::RunTests() may schedule a provider relative to the other providers.
+     *
+     * All providers run after the DRC caches have been built and may read them freely.
+     */
+    enum class CONCURRENCY
+    {
+        EXCLUSIVE,      ///< Modifies state other providers read: runs alone
+        CALLER_THREAD,  ///< Runs on the DRC thread, next to POOL providers.  For providers
+                        ///<   which use the thread pool themselves or may need the GUI.
+        POOL            ///< Only reads the board: may run on a pool thread next to any other
+                        ///<   non-exclusive provider.  Must not wait on pool tasks, so it may
+                        ///<   only go parallel through ParallelFor()
+    };
+
+    /**
+     * Declare how this provider may be run concurrently with the others.  Providers which do
+     * not know better run alone.
+     */
+    virtual CONCURRENCY GetConcurrency() const { return CONCURRENCY::EXCLUSIVE; }
+
+    /**
+     * Providers which only test items against their neighbours can take part in incremental
+     * runs (see DRC_ENGINE::RunIncrementalTests()).  They must restrict the items they test
+     * to the ones for which DRC_ENGINE::IsInScope() returns true.
+     *
+     * @return the error codes this provider re-checks in incremental runs, or an empty list
+     *         if it only supports full runs.
+     */
+    virtual std::vector<int> GetIncrementalErrorCodes() const { return {}; }
+
 protected:
     int forEachGeometryItem( const std::vector<KICAD_T>& aTypes, LSET aLayers,
                              const std::function<bool(BOARD_ITEM*)>& aFunc );
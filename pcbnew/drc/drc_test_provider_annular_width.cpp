@@ -66,6 +66,13 @@ public:
     {
         return wxT( "Tests pad/via annular rings" );
     }
+
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_ANNULAR_WIDTH };
+    }
 };
 
 
@@ -289,6 +296,9 @@ bool DRC_TEST_PROVIDER_ANNULAR_WIDTH::Run()
         if( !reportProgress( ii, total, progressDelta ) )
             return false;   // DRC cancelled
 
+        if( !m_drcEngine->IsInScope( item ) )
+            continue;
+
         if( !checkAnnularWidth( item ) )
             break;
     }
@@ -302,6 +312,9 @@ bool DRC_TEST_PROVIDER_ANNULAR_WIDTH::Run()
             if( !reportProgress( ii, total, progressDelta ) )
                 return false;   // DRC cancelled
 
+            if( !m_drcEngine->IsInScope( pad ) )
+                continue;
+
             if( !checkAnnularWidth( pad ) )
                 break;
         }
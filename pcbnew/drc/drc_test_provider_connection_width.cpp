@@ -37,6 +37,8 @@
 #include <drc/drc_test_provider.h>
 #include <drc/drc_rtree.h>
 #include <drc/drc_rule_condition.h>
+#include <drc/drc_tiles.h>
+#include <advanced_config.h>
 #include <footprint.h>
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
@@ -106,6 +108,9 @@ public:
         return wxT( "Checks copper nets for connections less than a specified minimum" );
     }
 
+    // Uses the thread pool
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::CALLER_THREAD; }
+
 private:
     wxString layerDesc( PCB_LAYER_ID aLayer );
 };
@@ -696,10 +701,12 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
             };
 
     /*
-     * Examine all necks in a given polygonSet which fail a given minWidth.
+     * Examine all necks in a given polygonSet which fail a given minWidth.  When the polygonSet
+     * only covers a tile, only the necks centred in the tile's core are examined.
      */
     auto min_checker =
-            [&]( const ITEMS_POLY& aItemsPoly, const PCB_LAYER_ID aLayer, int aMinWidth ) -> size_t
+            [&]( const ITEMS_POLY& aItemsPoly, const PCB_LAYER_ID aLayer, int aMinWidth,
+                 const DRC_TILE* aTile ) -> size_t
             {
                 if( m_drcEngine->IsCancelled() )
                     return 0;
@@ -729,6 +736,9 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
                         VECTOR2I location = ( span.A + span.B ) / 2;
                         int      dist = ( span.A - span.B ).EuclideanNorm();
 
+                        if( aTile && !aTile->Owns( location ) )
+                            continue;
+
                         std::vector<BOARD_ITEM*> contributingItems;
 
                         for( auto* item : board->m_CopperItemRTreeCache->GetObjectsAt( location,
@@ -784,7 +794,9 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
                     }
                 }
 
-                done.fetch_add( calc_effort( aItemsPoly.Items, aLayer ) );
+                // Tiles report progress per tile
+                if( !aTile )
+                    done.fetch_add( calc_effort( aItemsPoly.Items, aLayer ) );
 
                 return 1;
             };
@@ -826,6 +838,112 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
     std::vector<std::future<size_t>> returns;
     size_t                           total_effort = 0;
 
+    int tileSize = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_DRCTileSize );
+
+    if( tileSize > 0 )
+    {
+        if( distinctMinWidths.empty() )
+            return true;
+
+        // A neck is only reported if the copper widens again on both of its sides.  Clipping
+        // cuts the copper at the overlap, so look well beyond the largest minimum width.
+        int overlap = 10 * *distinctMinWidths.rbegin();
+
+        tileSize = std::max( tileSize, 4 * overlap );
+
+        /*
+         * Merge and examine the copper of a net on a layer one tile at a time.  Zone fills are
+         * clipped before they are merged, so that a tile never holds more than its share of a
+         * plane.
+         */
+        auto check_tile =
+                [&]( const std::set<BOARD_ITEM*>& aItems, const PCB_LAYER_ID aLayer,
+                     const DRC_TILE& aTile ) -> size_t
+                {
+                    if( m_drcEngine->IsCancelled() )
+                    {
+                        done.fetch_add( 1 );
+                        return 0;
+                    }
+
+                    ITEMS_POLY tileItemsPoly;
+
+                    for( BOARD_ITEM* item : aItems )
+                    {
+                        if( !item->GetBoundingBox().Intersects( aTile.m_clip ) )
+                            continue;
+
+                        tileItemsPoly.Items.insert( item );
+
+                        if( item->Type() == PCB_ZONE_T )
+                        {
+                            ZONE*          zone = static_cast<ZONE*>( item );
+                            SHAPE_POLY_SET fill =
+                                    zone->GetFilledPolysList( aLayer )->CloneDropTriangulation();
+
+                            aTile.Clip( fill );
+                            tileItemsPoly.Poly.Append( fill );
+                        }
+                        else
+                        {
+                            item->TransformShapeToPolygon( tileItemsPoly.Poly, aLayer, 0,
+                                                           ARC_HIGH_DEF, ERROR_OUTSIDE );
+                        }
+                    }
+
+                    if( !tileItemsPoly.Items.empty() )
+                    {
+                        aTile.Clip( tileItemsPoly.Poly );
+                        tileItemsPoly.Poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+                        for( int minWidth : distinctMinWidths )
+                            min_checker( tileItemsPoly, aLayer, minWidth, &aTile );
+                    }
+
+                    done.fetch_add( 1 );
+                    return 1;
+                };
+
+        std::vector<std::tuple<const ITEMS_POLY*, PCB_LAYER_ID, DRC_TILE>> tasks;
+
+        for( const auto& [ netLayer, itemsPoly ] : dataset )
+        {
+            BOX2I bbox;
+
+            for( BOARD_ITEM* item : itemsPoly.Items )
+                bbox.Merge( item->GetBoundingBox() );
+
+            for( const DRC_TILE& tile : BuildDRCTiles( bbox, tileSize, overlap ) )
+                tasks.emplace_back( &itemsPoly, netLayer.Layer, tile );
+        }
+
+        done.store( 0 );
+        returns.reserve( tasks.size() );
+
+        for( const auto& task : tasks )
+        {
+            returns.emplace_back( tp.submit(
+                    [&check_tile, &task]() -> size_t
+                    {
+                        return check_tile( std::get<0>( task )->Items, std::get<1>( task ),
+                                           std::get<2>( task ) );
+                    } ) );
+        }
+
+        for( std::future<size_t>& ret : returns )
+        {
+            std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+
+            while( status != std::future_status::ready )
+            {
+                reportProgress( done, tasks.size() );
+                status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+            }
+        }
+
+        return true;
+    }
+
     for( const auto& [ netLayer, itemsPoly ] : dataset )
         total_effort += calc_effort( itemsPoly.Items, netLayer.Layer );
 
@@ -855,7 +973,8 @@ bool DRC_TEST_PROVIDER_CONNECTION_WIDTH::Run()
     for( const auto& [ netLayer, itemsPoly ] : dataset )
     {
         for( int minWidth : distinctMinWidths )
-            returns.emplace_back( tp.submit( min_checker, itemsPoly, netLayer.Layer, minWidth ) );
+            returns.emplace_back( tp.submit( min_checker, itemsPoly, netLayer.Layer, minWidth,
+                                             nullptr ) );
     }
 
     for( std::future<size_t>& ret : returns )
@@ -31,6 +31,7 @@
 #include <core/thread_pool.h>
 #include <zone.h>
 
+#include <geometry/geometry_arena.h>
 #include <geometry/seg.h>
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
@@ -81,6 +82,15 @@ public:
         return wxT( "Tests copper item clearance" );
     }
 
+    // Uses the thread pool
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::CALLER_THREAD; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_CLEARANCE, DRCE_HOLE_CLEARANCE, DRCE_SHORTING_ITEMS,
+                 DRCE_TRACKS_CROSSING, DRCE_ZONES_INTERSECT };
+    }
+
 private:
     /**
      * Checks for track/via/hole <-> clearance
@@ -570,10 +580,18 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 
     auto testTrack = [&]( const int start_idx, const int end_idx )
     {
+        GEOMETRY_ARENA arena;
+
         for( int trackIdx = start_idx; trackIdx < end_idx; ++trackIdx )
         {
             PCB_TRACK* track = m_board->Tracks()[trackIdx];
 
+            if( !m_drcEngine->IsInScope( track ) )
+            {
+                done.fetch_add( 1 );
+                continue;
+            }
+
             for( PCB_LAYER_ID layer : LSET( track->GetLayerSet() & boardCopperLayers ).Seq() )
             {
                 std::shared_ptr<SHAPE> trackShape = track->GetEffectiveShape( layer );
@@ -674,7 +692,7 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testTrackClearances()
 
     thread_pool& tp = GetKiCadThreadPool();
 
-    tp.push_loop( m_board->Tracks().size(), testTrack );
+    tp.push_loop( m_board->Tracks().size(), testTrack, GetThreadBudget( THREAD_SUBSYSTEM::DRC ) );
 
     while( done < count )
     {
@@ -949,6 +967,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testPadClearances( )
                 {
                     for( PAD* pad : footprint->Pads() )
                     {
+                        if( !m_drcEngine->IsInScope( pad ) )
+                        {
+                            done.fetch_add( 1 );
+                            continue;
+                        }
+
                         for( PCB_LAYER_ID layer : LSET( pad->GetLayerSet() & boardCopperLayers ).Seq() )
                         {
                             if( m_drcEngine->IsCancelled() )
@@ -1128,10 +1152,13 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
             {
                 for( BOARD_ITEM* item : m_board->Drawings() )
                 {
-                    testGraphicAgainstZone( item );
+                    if( m_drcEngine->IsInScope( item ) )
+                    {
+                        testGraphicAgainstZone( item );
 
-                    if( item->Type() == PCB_SHAPE_T && item->IsOnCopperLayer() )
-                        testCopperGraphic( static_cast<PCB_SHAPE*>( item ) );
+                        if( item->Type() == PCB_SHAPE_T && item->IsOnCopperLayer() )
+                            testCopperGraphic( static_cast<PCB_SHAPE*>( item ) );
+                    }
 
                     done.fetch_add( 1 );
 
@@ -1143,7 +1170,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testGraphicClearances( )
                 {
                     for( BOARD_ITEM* item : footprint->GraphicalItems() )
                     {
-                        testGraphicAgainstZone( item );
+                        if( m_drcEngine->IsInScope( item ) )
+                            testGraphicAgainstZone( item );
 
                         done.fetch_add( 1 );
 
@@ -1302,8 +1330,8 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZonesToZones()
                     continue;
 
                 // Examine a candidate zone: compare zoneB to zoneA
-                SHAPE_POLY_SET* polyA = m_board->m_DRCCopperZones[ia]->GetFill( layer );
-                SHAPE_POLY_SET* polyB = m_board->m_DRCCopperZones[ia2]->GetFill( layer );
+                const SHAPE_POLY_SET* polyA = zoneA->GetFilledPolysList( layer ).get();
+                const SHAPE_POLY_SET* polyB = zoneB->GetFilledPolysList( layer ).get();
 
                 if( !polyA->BBoxFromCaches().Intersects( polyB->BBoxFromCaches() ) )
                     continue;
@@ -21,6 +21,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <thread>
+#include <core/thread_pool.h>
 #include <geometry/shape_poly_set.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
@@ -66,13 +69,28 @@ public:
         return wxT( "Tests footprints' courtyard clearance" );
     }
 
+    // Footprint courtyards are cached, and rebuilt under their footprint's lock
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
     bool testFootprintCourtyardDefinitions();
 
     bool testCourtyardClearances();
 
+    /**
+     * Test footprint \a aIdx against the footprints which follow it on the board.
+     */
+    void testFootprintClearances( size_t aIdx );
+
+    /**
+     * Run \a aFunc on blocks of the first \a aCount footprints in the thread pool, reporting
+     * progress until all are done.
+     */
+    bool forEachFootprint( size_t aCount, const std::function<void( size_t )>& aFunc );
+
 private:
-    int  m_largestCourtyardClearance;
+    int                m_largestCourtyardClearance;
+    std::vector<BOX2I> m_footprintBBoxes;
 };
 
 
@@ -96,50 +114,78 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintCourtyardDefinitions()
         return true;        // continue with other tests
     }
 
-    const int progressDelta = 500;
-    int       ii = 0;
+    const std::deque<FOOTPRINT*>& footprints = m_board->Footprints();
 
-    for( FOOTPRINT* footprint : m_board->Footprints() )
-    {
-        if( !reportProgress( ii++, m_board->Footprints().size(), progressDelta ) )
-            return false;   // DRC cancelled
+    return forEachFootprint( footprints.size(),
+            [&]( size_t aIdx )
+            {
+                FOOTPRINT* footprint = footprints[aIdx];
 
-        if( ( footprint->GetFlags() & MALFORMED_COURTYARDS ) != 0 )
-        {
-            if( m_drcEngine->IsErrorLimitExceeded( DRCE_MALFORMED_COURTYARD) )
-                continue;
+                // Builds the courtyards (and flags malformed ones) unless already cached
+                bool missing = footprint->GetCourtyard( F_CrtYd ).OutlineCount() == 0
+                               && footprint->GetCourtyard( B_CrtYd ).OutlineCount() == 0;
 
-            OUTLINE_ERROR_HANDLER errorHandler =
-                    [&]( const wxString& msg, BOARD_ITEM*, BOARD_ITEM*, const VECTOR2I& pt )
-                    {
-                        std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_MALFORMED_COURTYARD );
-                        drcItem->SetErrorMessage( drcItem->GetErrorText() + wxS( " " ) + msg );
-                        drcItem->SetItems( footprint );
-                        reportViolation( drcItem, pt, UNDEFINED_LAYER );
-                    };
-
-            // Re-run courtyard tests to generate DRC_ITEMs
-            footprint->BuildCourtyardCaches( &errorHandler );
-        }
-        else if( footprint->GetCourtyard( F_CrtYd ).OutlineCount() == 0
-                && footprint->GetCourtyard( B_CrtYd ).OutlineCount() == 0 )
-        {
-            if( m_drcEngine->IsErrorLimitExceeded( DRCE_MISSING_COURTYARD ) )
-                continue;
+                if( ( footprint->GetFlags() & MALFORMED_COURTYARDS ) != 0 )
+                {
+                    if( m_drcEngine->IsErrorLimitExceeded( DRCE_MALFORMED_COURTYARD) )
+                        return;
 
-            if( footprint->GetAttributes() & FP_ALLOW_MISSING_COURTYARD )
-                continue;
+                    OUTLINE_ERROR_HANDLER errorHandler =
+                            [&]( const wxString& msg, BOARD_ITEM*, BOARD_ITEM*,
+                                 const VECTOR2I& pt )
+                            {
+                                std::shared_ptr<DRC_ITEM> drcItem =
+                                        DRC_ITEM::Create( DRCE_MALFORMED_COURTYARD );
 
-            std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_MISSING_COURTYARD );
-            drcItem->SetItems( footprint );
-            reportViolation( drcItem, footprint->GetPosition(), UNDEFINED_LAYER );
-        }
-        else
-        {
-            footprint->GetCourtyard( F_CrtYd ).BuildBBoxCaches();
-            footprint->GetCourtyard( B_CrtYd ).BuildBBoxCaches();
-        }
-    }
+                                drcItem->SetErrorMessage( drcItem->GetErrorText() + wxS( " " )
+                                                          + msg );
+                                drcItem->SetItems( footprint );
+                                reportViolation( drcItem, pt, UNDEFINED_LAYER );
+                            };
+
+                    // Re-run courtyard tests to generate DRC_ITEMs
+                    footprint->ReportCourtyardErrors( &errorHandler );
+                }
+                else if( missing )
+                {
+                    if( m_drcEngine->IsErrorLimitExceeded( DRCE_MISSING_COURTYARD ) )
+                        return;
+
+                    if( footprint->GetAttributes() & FP_ALLOW_MISSING_COURTYARD )
+                        return;
+
+                    std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_MISSING_COURTYARD );
+                    drcItem->SetItems( footprint );
+                    reportViolation( drcItem, footprint->GetPosition(), UNDEFINED_LAYER );
+                }
+            } );
+}
+
+
+bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::forEachFootprint(
+        size_t aCount, const std::function<void( size_t )>& aFunc )
+{
+    const int             progressDelta = 100;
+    std::atomic<size_t>   done( 0 );
+    const std::thread::id caller = std::this_thread::get_id();
+    size_t                callerDone = 0;
+
+    // This provider itself runs on the thread pool, so use ParallelFor(), in which this thread
+    // takes part, rather than wait on tasks which could be queued behind it.  Only this thread
+    // may report the provider's progress.
+    ParallelFor( aCount,
+            [&]( size_t ii )
+            {
+                if( m_drcEngine->IsCancelled() )
+                    return;
+
+                aFunc( ii );
+
+                done.fetch_add( 1 );
+
+                if( std::this_thread::get_id() == caller && ( ++callerDone % progressDelta ) == 0 )
+                    reportProgress( done, aCount, 1 );
+            } );
 
     return !m_drcEngine->IsCancelled();
 }
@@ -150,26 +196,56 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
     if( !reportPhase( _( "Checking footprints for overlapping courtyards..." ) ) )
         return false;   // DRC cancelled
 
-    const int progressDelta = 100;
-    int       ii = 0;
+    m_footprintBBoxes.clear();
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+        m_footprintBBoxes.push_back( footprint->GetBoundingBox() );
+
+    return forEachFootprint( m_board->Footprints().size(),
+            [&]( size_t aIdx )
+            {
+                testFootprintClearances( aIdx );
+            } );
+}
+
 
-    for( auto itA = m_board->Footprints().begin(); itA != m_board->Footprints().end(); itA++ )
+void DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testFootprintClearances( size_t aIdx )
+{
+    if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
+        && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+        && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
     {
-        if( !reportProgress( ii++, m_board->Footprints().size(), progressDelta ) )
-            return false;   // DRC cancelled
+        return;
+    }
 
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_FOOTPRINTS)
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-            && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
-        {
-            return true;   // continue with other tests
-        }
+    const std::deque<FOOTPRINT*>& footprints = m_board->Footprints();
+    FOOTPRINT*                    fpA = footprints[aIdx];
+    const SHAPE_POLY_SET&         frontA = fpA->GetCourtyard( F_CrtYd );
+    const SHAPE_POLY_SET&         backA = fpA->GetCourtyard( B_CrtYd );
+
+    if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
+         && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
+         && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
+    {
+        // No courtyards defined and no hole testing against other footprint's courtyards
+        return;
+    }
+
+    BOX2I frontA_worstCaseBBox = frontA.BBoxFromCaches();
+    BOX2I backA_worstCaseBBox = backA.BBoxFromCaches();
+
+    frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+    backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+
+    const BOX2I& fpA_bbox = m_footprintBBoxes[aIdx];
 
-        FOOTPRINT*            fpA = *itA;
-        const SHAPE_POLY_SET& frontA = fpA->GetCourtyard( F_CrtYd );
-        const SHAPE_POLY_SET& backA = fpA->GetCourtyard( B_CrtYd );
+    for( size_t idxB = aIdx + 1; idxB < footprints.size(); ++idxB )
+    {
+        FOOTPRINT*            fpB = footprints[idxB];
+        const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
+        const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
 
-        if( frontA.OutlineCount() == 0 && backA.OutlineCount() == 0
+        if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
              && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
              && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
         {
@@ -177,169 +253,144 @@ bool DRC_TEST_PROVIDER_COURTYARD_CLEARANCE::testCourtyardClearances()
             continue;
         }
 
-        BOX2I frontA_worstCaseBBox = frontA.BBoxFromCaches();
-        BOX2I backA_worstCaseBBox = backA.BBoxFromCaches();
-
-        frontA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-        backA_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-
-        BOX2I fpA_bbox = fpA->GetBoundingBox();
-
-        for( auto itB = itA + 1; itB != m_board->Footprints().end(); itB++ )
-        {
-            FOOTPRINT*            fpB = *itB;
-            const SHAPE_POLY_SET& frontB = fpB->GetCourtyard( F_CrtYd );
-            const SHAPE_POLY_SET& backB = fpB->GetCourtyard( B_CrtYd );
-
-            if( frontB.OutlineCount() == 0 && backB.OutlineCount() == 0
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_PTH_IN_COURTYARD )
-                 && m_drcEngine->IsErrorLimitExceeded( DRCE_NPTH_IN_COURTYARD ) )
-            {
-                // No courtyards defined and no hole testing against other footprint's courtyards
-                continue;
-            }
+        BOX2I frontB_worstCaseBBox = frontB.BBoxFromCaches();
+        BOX2I backB_worstCaseBBox = backB.BBoxFromCaches();
 
-            BOX2I frontB_worstCaseBBox = frontB.BBoxFromCaches();
-            BOX2I backB_worstCaseBBox = backB.BBoxFromCaches();
+        frontB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+        backB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
 
-            frontB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
-            backB_worstCaseBBox.Inflate( m_largestCourtyardClearance );
+        const BOX2I&   fpB_bbox = m_footprintBBoxes[idxB];
+        DRC_CONSTRAINT constraint;
+        int            clearance;
+        int            actual;
+        VECTOR2I       pos;
 
-            BOX2I          fpB_bbox = fpB->GetBoundingBox();
-            DRC_CONSTRAINT constraint;
-            int            clearance;
-            int            actual;
-            VECTOR2I       pos;
+        //
+        // Check courtyard-to-courtyard collisions on front of board.
+        //
 
-            //
-            // Check courtyard-to-courtyard collisions on front of board.
-            //
+        if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
+                && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() ) )
+        {
+            constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
+            clearance = constraint.GetValue().Min();
 
-            if( frontA.OutlineCount() > 0 && frontB.OutlineCount() > 0
-                    && frontA_worstCaseBBox.Intersects( frontB.BBoxFromCaches() ) )
+            if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
             {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, F_Cu );
-                clearance = constraint.GetValue().Min();
-
-                if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+                if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
                 {
-                    if( frontA.Collide( &frontB, clearance, &actual, &pos ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
-
-                        if( clearance > 0 )
-                        {
-                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                      constraint.GetName(),
-                                                      clearance,
-                                                      actual );
+                    auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
 
-                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                        }
+                    if( clearance > 0 )
+                    {
+                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                                  constraint.GetName(),
+                                                  clearance,
+                                                  actual );
 
-                        drce->SetViolatingRule( constraint.GetParentRule() );
-                        drce->SetItems( fpA, fpB );
-                        reportViolation( drce, pos, F_CrtYd );
+                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
                     }
+
+                    drce->SetViolatingRule( constraint.GetParentRule() );
+                    drce->SetItems( fpA, fpB );
+                    reportViolation( drce, pos, F_CrtYd );
                 }
             }
+        }
 
-            //
-            // Check courtyard-to-courtyard collisions on back of board.
-            //
+        //
+        // Check courtyard-to-courtyard collisions on back of board.
+        //
 
-            if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
-                    && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() ) )
-            {
-                constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
-                clearance = constraint.GetValue().Min();
+        if( backA.OutlineCount() > 0 && backB.OutlineCount() > 0
+                && backA_worstCaseBBox.Intersects( backB.BBoxFromCaches() ) )
+        {
+            constraint = m_drcEngine->EvalRules( COURTYARD_CLEARANCE_CONSTRAINT, fpA, fpB, B_Cu );
+            clearance = constraint.GetValue().Min();
 
-                if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+            if( constraint.GetSeverity() != RPT_SEVERITY_IGNORE && clearance >= 0 )
+            {
+                if( backA.Collide( &backB, clearance, &actual, &pos ) )
                 {
-                    if( backA.Collide( &backB, clearance, &actual, &pos ) )
-                    {
-                        auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
+                    auto drce = DRC_ITEM::Create( DRCE_OVERLAPPING_FOOTPRINTS );
 
-                        if( clearance > 0 )
-                        {
-                            wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                      constraint.GetName(),
-                                                      clearance,
-                                                      actual );
-
-                            drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
-                        }
+                    if( clearance > 0 )
+                    {
+                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                                  constraint.GetName(),
+                                                  clearance,
+                                                  actual );
 
-                        drce->SetViolatingRule( constraint.GetParentRule() );
-                        drce->SetItems( fpA, fpB );
-                        reportViolation( drce, pos, B_CrtYd );
+                        drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + msg );
                     }
+
+                    drce->SetViolatingRule( constraint.GetParentRule() );
+                    drce->SetItems( fpA, fpB );
+                    reportViolation( drce, pos, B_CrtYd );
                 }
             }
+        }
 
-            //
-            // Check pad-hole-to-courtyard collisions on front and back of board.
-            //
-            // NB: via holes are not checked.  There is a presumption that a physical object goes
-            // through a pad hole, which is not the case for via holes.
-            //
+        //
+        // Check pad-hole-to-courtyard collisions on front and back of board.
+        //
+        // NB: via holes are not checked.  There is a presumption that a physical object goes
+        // through a pad hole, which is not the case for via holes.
+        //
 
-            auto testPadAgainstCourtyards =
-                    [&]( const PAD* pad, const FOOTPRINT* fp )
-                    {
-                        int errorCode = 0;
+        auto testPadAgainstCourtyards =
+                [&]( const PAD* pad, const FOOTPRINT* fp )
+                {
+                    int errorCode = 0;
 
-                        if( pad->GetAttribute() == PAD_ATTRIB::PTH )
-                            errorCode = DRCE_PTH_IN_COURTYARD;
-                        else if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
-                            errorCode = DRCE_NPTH_IN_COURTYARD;
-                        else
-                            return;
+                    if( pad->GetAttribute() == PAD_ATTRIB::PTH )
+                        errorCode = DRCE_PTH_IN_COURTYARD;
+                    else if( pad->GetAttribute() == PAD_ATTRIB::NPTH )
+                        errorCode = DRCE_NPTH_IN_COURTYARD;
+                    else
+                        return;
 
-                        if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
-                            return;
+                    if( m_drcEngine->IsErrorLimitExceeded( errorCode ) )
+                        return;
 
-                        if( pad->HasHole() )
-                        {
-                            std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
-                            const SHAPE_POLY_SET&          front = fp->GetCourtyard( F_CrtYd );
-                            const SHAPE_POLY_SET&          back = fp->GetCourtyard( B_CrtYd );
+                    if( pad->HasHole() )
+                    {
+                        std::shared_ptr<SHAPE_SEGMENT> hole = pad->GetEffectiveHoleShape();
+                        const SHAPE_POLY_SET&          front = fp->GetCourtyard( F_CrtYd );
+                        const SHAPE_POLY_SET&          back = fp->GetCourtyard( B_CrtYd );
 
-                            if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
-                            {
-                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
-                                drce->SetItems( pad, fp );
-                                reportViolation( drce, pad->GetPosition(), F_CrtYd );
-                            }
-                            else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
-                            {
-                                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
-                                drce->SetItems( pad, fp );
-                                reportViolation( drce, pad->GetPosition(), B_CrtYd );
-                            }
+                        if( front.OutlineCount() > 0 && front.Collide( hole.get(), 0 ) )
+                        {
+                            std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
+                            drce->SetItems( pad, fp );
+                            reportViolation( drce, pad->GetPosition(), F_CrtYd );
                         }
-                    };
-
-            if( ( frontA.OutlineCount() > 0 && frontA_worstCaseBBox.Intersects( fpB_bbox ) )
-                || ( backA.OutlineCount() > 0 && backA_worstCaseBBox.Intersects( fpB_bbox ) ) )
-            {
-                for( const PAD* padB : fpB->Pads() )
-                    testPadAgainstCourtyards( padB, fpA );
-            }
+                        else if( back.OutlineCount() > 0 && back.Collide( hole.get(), 0 ) )
+                        {
+                            std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( errorCode );
+                            drce->SetItems( pad, fp );
+                            reportViolation( drce, pad->GetPosition(), B_CrtYd );
+                        }
+                    }
+                };
 
-            if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpA_bbox ) )
-                || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpA_bbox ) ) )
-            {
-                for( const PAD* padA : fpA->Pads() )
-                    testPadAgainstCourtyards( padA, fpB );
-            }
+        if( ( frontA.OutlineCount() > 0 && frontA_worstCaseBBox.Intersects( fpB_bbox ) )
+            || ( backA.OutlineCount() > 0 && backA_worstCaseBBox.Intersects( fpB_bbox ) ) )
+        {
+            for( const PAD* padB : fpB->Pads() )
+                testPadAgainstCourtyards( padB, fpA );
+        }
 
-            if( m_drcEngine->IsCancelled() )
-                return false;
+        if( ( frontB.OutlineCount() > 0 && frontB.BBoxFromCaches().Intersects( fpA_bbox ) )
+            || ( backB.OutlineCount() > 0 && backB.BBoxFromCaches().Intersects( fpA_bbox ) ) )
+        {
+            for( const PAD* padA : fpA->Pads() )
+                testPadAgainstCourtyards( padA, fpB );
         }
-    }
 
-    return !m_drcEngine->IsCancelled();
+        if( m_drcEngine->IsCancelled() )
+            return;
+    }
 }
 
 
@@ -73,6 +73,9 @@ public:
         return wxT( "Tests differential pair coupling" );
     }
 
+    // The from-to cache is safe to share with other providers
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
     BOARD* m_board;
 };
@@ -342,7 +345,7 @@ bool test::DRC_TEST_PROVIDER_DIFF_PAIR_COUPLING::Run()
                 return true;
             };
 
-    m_board->GetConnectivity()->GetFromToCache()->Rebuild( m_board );
+    m_board->GetConnectivity()->GetFromToCache()->Update( m_board );
 
     forEachGeometryItem( { PCB_TRACE_T, PCB_VIA_T, PCB_ARC_T }, LSET::AllCuMask(),
                          evaluateDpConstraints );
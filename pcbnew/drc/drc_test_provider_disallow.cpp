@@ -30,6 +30,7 @@
 #include <drc/drc_rule.h>
 #include <drc/drc_test_provider.h>
 #include <pad.h>
+#include <pcbexpr_evaluator.h>
 #include <progress_reporter.h>
 #include <core/thread_pool.h>
 #include <zone.h>
@@ -64,6 +65,9 @@ public:
     {
         return wxT( "Tests for disallowed items (e.g. keepouts)" );
     }
+
+    // Temporarily flags items as HOLE_PROXY
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::EXCLUSIVE; }
 };
 
 
@@ -73,7 +77,6 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
         return false;   // DRC cancelled
 
     BOARD* board = m_drcEngine->GetBoard();
-    int    epsilon = board->GetDesignSettings().GetDRCEpsilon();
 
     // First build out the board's cache of copper-keepout to copper-zone caches.  This is where
     // the bulk of the time is spent, and we can do this in parallel.
@@ -114,48 +117,14 @@ bool DRC_TEST_PROVIDER_DISALLOW::Run()
                 if( m_drcEngine->IsCancelled() )
                     return 0;
 
-                ZONE* ruleArea = areaZonePair.first;
-                ZONE* copperZone = areaZonePair.second;
-                BOX2I areaBBox = ruleArea->GetBoundingBox();
-                BOX2I copperBBox = copperZone->GetBoundingBox();
-                bool  isInside = false;
-
-                if( copperZone->IsFilled() && areaBBox.Intersects( copperBBox ) )
-                {
-                    // Collisions include touching, so we need to deflate outline by enough to
-                    // exclude it.  This is particularly important for detecting copper fills as
-                    // they will be exactly touching along the entire exclusion border.
-                    SHAPE_POLY_SET areaPoly = ruleArea->Outline()->CloneDropTriangulation();
-                    areaPoly.Fracture( SHAPE_POLY_SET::PM_FAST );
-                    areaPoly.Deflate( epsilon, CORNER_STRATEGY::ALLOW_ACUTE_CORNERS, ARC_LOW_DEF );
-
-                    DRC_RTREE* zoneRTree = board->m_CopperZoneRTreeCache[ copperZone ].get();
-
-                    if( zoneRTree )
-                    {
-                        for( PCB_LAYER_ID layer : ruleArea->GetLayerSet().Seq() )
-                        {
-                            if( zoneRTree->QueryColliding( areaBBox, &areaPoly, layer ) )
-                            {
-                                isInside = true;
-                                break;
-                            }
-
-                            if( m_drcEngine->IsCancelled() )
-                                return 0;
-                        }
-                    }
-                }
-
-                if( m_drcEngine->IsCancelled() )
-                    return 0;
-
-                PTR_PTR_LAYER_CACHE_KEY key = { ruleArea, copperZone, UNDEFINED_LAYER };
+                ZONE*           ruleArea = areaZonePair.first;
+                ZONE*           copperZone = areaZonePair.second;
+                PCBEXPR_CONTEXT ctx( DISALLOW_CONSTRAINT, UNDEFINED_LAYER );
 
-                {
-                    std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                    board->m_IntersectsAreaCache[ key ] = isInside;
-                }
+                // Goes through the board's area test cache, where the implicit keepout rules
+                // will find the result.  Results of zones which didn't change since the last
+                // run are still there.
+                testIntersectsArea( copperZone, copperZone->GetBoundingBox(), ruleArea, &ctx );
 
                 done.fetch_add( 1 );
 
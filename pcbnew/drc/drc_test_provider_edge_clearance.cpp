@@ -71,6 +71,8 @@ public:
         return wxT( "Tests items vs board edge clearance" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
     bool testAgainstEdge( BOARD_ITEM* item, SHAPE* itemShape, BOARD_ITEM* other,
                           DRC_CONSTRAINT_T aConstraintType, PCB_DRC_CODE aErrorCode );
@@ -221,7 +223,7 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
                 {
                     // A single polygon for the board would make the RTree useless, so convert
                     // to n edges.
-                    SHAPE_LINE_CHAIN poly = shape->GetPolyShape().Outline( 0 );
+                    SHAPE_LINE_CHAIN poly = shape->GetPolyShape().COutline( 0 );
 
                     for( size_t ii = 0; ii < poly.GetSegmentCount(); ++ii )
                     {
@@ -61,6 +61,8 @@ public:
     {
         return wxT( "Check for common footprint pad and component type errors" );
     }
+
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
 };
 
 
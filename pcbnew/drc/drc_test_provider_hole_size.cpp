@@ -62,6 +62,13 @@ public:
         return wxT( "Tests sizes of drilled holes (via/pad drills)" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_DRILL_OUT_OF_RANGE, DRCE_MICROVIA_DRILL_OUT_OF_RANGE };
+    }
+
 private:
     void checkViaHole( PCB_VIA* via, bool aExceedMicro, bool aExceedStd );
     void checkPadHole( PAD* aPad );
@@ -79,6 +86,9 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
         {
             for( PAD* pad : footprint->Pads() )
             {
+                if( !m_drcEngine->IsInScope( pad ) )
+                    continue;
+
                 if( !m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE ) )
                     checkPadHole( pad );
             }
@@ -101,7 +111,7 @@ bool DRC_TEST_PROVIDER_HOLE_SIZE::Run()
 
         for( PCB_TRACK* track : m_drcEngine->GetBoard()->Tracks() )
         {
-            if( track->Type() == PCB_VIA_T )
+            if( track->Type() == PCB_VIA_T && m_drcEngine->IsInScope( track ) )
             {
                 bool exceedMicro = m_drcEngine->IsErrorLimitExceeded( DRCE_MICROVIA_DRILL_OUT_OF_RANGE );
                 bool exceedStd = m_drcEngine->IsErrorLimitExceeded( DRCE_DRILL_OUT_OF_RANGE );
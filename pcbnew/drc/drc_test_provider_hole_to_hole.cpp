@@ -67,6 +67,13 @@ public:
         return wxT( "Tests hole to hole spacing" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_DRILLED_HOLES_COLOCATED, DRCE_DRILLED_HOLES_TOO_CLOSE };
+    }
+
 private:
     bool testHoleAgainstHole( BOARD_ITEM* aItem, SHAPE_CIRCLE* aHole, BOARD_ITEM* aOther );
 
@@ -171,6 +178,9 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
         if( !reportProgress( ii++, count, progressDelta ) )
             return false;   // DRC cancelled
 
+        if( !m_drcEngine->IsInScope( via ) )
+            continue;
+
         // We only care about mechanically drilled (ie: non-laser) holes.  These include both
         // blind/buried via holes (drilled prior to lamination) and through-via and drilled pad
         // holes (which are generally drilled post laminataion).
@@ -218,6 +228,9 @@ bool DRC_TEST_PROVIDER_HOLE_TO_HOLE::Run()
             if( !reportProgress( ii++, count, progressDelta ) )
                 return false;   // DRC cancelled
 
+            if( !m_drcEngine->IsInScope( pad ) )
+                continue;
+
             // We only care about drilled (ie: round) holes
             if( pad->GetDrillSize().x && pad->GetDrillSize().x == pad->GetDrillSize().y )
             {
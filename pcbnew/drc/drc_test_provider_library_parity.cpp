@@ -34,6 +34,10 @@
 #include <drc/drc_item.h>
 #include <drc/drc_test_provider.h>
 #include <project_pcb.h>
+#include <core/thread_pool.h>
+#include <hash.h>
+
+#include <mutex>
 
 /*
     Library parity test.
@@ -66,6 +70,22 @@ public:
     {
         return wxT( "Performs board footprint vs library integity checks" );
     }
+
+    // Loading libraries may report errors through the GUI
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::CALLER_THREAD; }
+
+private:
+    /// The parity hash of a library footprint, valid while its library is unchanged
+    struct LIB_FOOTPRINT_HASH
+    {
+        wxString  m_libURI;
+        long long m_libTimestamp = 0;
+        bool      m_found = false;
+        size_t    m_hash = 0;
+    };
+
+    std::mutex                           m_libHashesMutex;
+    std::map<LIB_ID, LIB_FOOTPRINT_HASH> m_libHashes;
 };
 
 
@@ -714,6 +734,162 @@ bool FOOTPRINT::FootprintNeedsUpdate( const FOOTPRINT* aLibFP, REPORTER* aReport
 }
 
 
+/**
+ * Hash everything FOOTPRINT::FootprintNeedsUpdate() compares (without a reporter), with the
+ * footprint brought back to the library frame: unflipped, unrotated and at the origin.
+ *
+ * Values are hashed exactly where the comparison allows some tolerance, so footprints with
+ * equal hashes never need an update while differing hashes only call for the full comparison.
+ */
+static size_t parityHash( const FOOTPRINT* aFootprint, BOARD* aBoard )
+{
+    std::unique_ptr<FOOTPRINT> temp( static_cast<FOOTPRINT*>( aFootprint->Clone() ) );
+    temp->SetParentGroup( nullptr );
+
+    temp->SetParent( aBoard );  // Needed to know the copper layer count;
+
+    if( temp->IsFlipped() )
+        temp->Flip( temp->GetPosition(), false );
+
+    if( !temp->GetOrientation().IsZero() )
+        temp->SetOrientation( ANGLE_0 );
+
+    if( temp->GetPosition() != VECTOR2I( 0, 0 ) )
+        temp->SetPosition( VECTOR2I( 0, 0 ) );
+
+    for( BOARD_ITEM* item : temp->GraphicalItems() )
+        item->Normalize();
+
+    // Must not trigger the IncrementTimestamp call in ~FOOTPRINT
+    temp->SetParent( nullptr );
+
+    auto hashShape =
+            []( const PCB_SHAPE& aShape ) -> size_t
+            {
+                const STROKE_PARAMS& stroke = aShape.GetStroke();
+                const KIGFX::COLOR4D color = stroke.GetColor();
+
+                size_t ret = hash_val( aShape.GetShape(), aShape.IsFilled(), aShape.GetLayer(),
+                                       stroke.GetWidth(), stroke.GetLineStyle(), color.r,
+                                       color.g, color.b, color.a );
+
+                switch( aShape.GetShape() )
+                {
+                case SHAPE_T::RECTANGLE:
+                {
+                    BOX2I rect( aShape.GetStart(), aShape.GetEnd() - aShape.GetStart() );
+                    rect.Normalize();
+                    hash_combine( ret, rect.GetOrigin(), rect.GetEnd() );
+                    break;
+                }
+
+                case SHAPE_T::ARC:
+                    hash_combine( ret, aShape.GetArcMid() );
+                    KI_FALLTHROUGH;
+
+                case SHAPE_T::SEGMENT:
+                case SHAPE_T::CIRCLE:
+                    hash_combine( ret, aShape.GetStart(), aShape.GetEnd() );
+                    break;
+
+                case SHAPE_T::BEZIER:
+                    hash_combine( ret, aShape.GetStart(), aShape.GetEnd(), aShape.GetBezierC1(),
+                                  aShape.GetBezierC2() );
+                    break;
+
+                case SHAPE_T::POLY:
+                    for( auto it = aShape.GetPolyShape().CIterateWithHoles(); it; it++ )
+                        hash_combine( ret, *it );
+
+                    break;
+
+                default:
+                    break;
+                }
+
+                return ret;
+            };
+
+    size_t ret = hash_val( temp->GetLibDescription().utf8_string(),
+                           temp->GetKeywords().utf8_string(), temp->GetAttributes() );
+
+    for( const wxString& group : temp->GetNetTiePadGroups() )
+        hash_combine( ret, group.utf8_string() );
+
+    // Shapes, pads and zones aren't compared in file order, so neither are they hashed in it
+    auto combineSorted =
+            [&]( std::vector<size_t>& aHashes )
+            {
+                std::sort( aHashes.begin(), aHashes.end() );
+                hash_combine( ret, aHashes.size() );
+
+                for( size_t hash : aHashes )
+                    hash_combine( ret, hash );
+            };
+
+    std::vector<size_t> hashes;
+
+    for( BOARD_ITEM* item : temp->GraphicalItems() )
+    {
+        if( item->Type() == PCB_SHAPE_T )
+            hashes.push_back( hashShape( *static_cast<PCB_SHAPE*>( item ) ) );
+    }
+
+    combineSorted( hashes );
+    hashes.clear();
+
+    for( PAD* pad : temp->Pads() )
+    {
+        size_t padHash = hash_val( pad->GetPadToDieLength(), pad->GetFPRelativePosition(),
+                                   pad->GetNumber().utf8_string(), pad->GetRemoveUnconnected(),
+                                   pad->GetRemoveUnconnected() && pad->GetKeepTopBottom(), pad->GetLayerSet().to_ullong(),
+                                   pad->GetShape(), pad->GetAttribute(), pad->GetProperty() );
+
+        hash_combine( padHash, pad->GetOrientation().Normalize().AsDegrees(), pad->GetSize(),
+                      pad->GetDelta(), pad->GetRoundRectCornerRadius(),
+                      pad->GetRoundRectRadiusRatio(), pad->GetChamferRectRatio(),
+                      pad->GetChamferPositions(), pad->GetOffset(), pad->GetDrillShape(),
+                      pad->GetDrillSize() );
+
+        for( const std::shared_ptr<PCB_SHAPE>& primitive : pad->GetPrimitives() )
+            hash_combine( padHash, hashShape( *primitive ) );
+
+        hashes.push_back( padHash );
+    }
+
+    combineSorted( hashes );
+    hashes.clear();
+
+    for( ZONE* zone : temp->Zones() )
+    {
+        size_t zoneHash = hash_val( zone->GetCornerSmoothingType(), zone->GetCornerRadius(),
+                                    zone->GetZoneName().utf8_string(),
+                                    zone->GetAssignedPriority(), zone->GetIsRuleArea(),
+                                    zone->GetDoNotAllowCopperPour(),
+                                    zone->GetDoNotAllowFootprints(), zone->GetDoNotAllowPads(),
+                                    zone->GetDoNotAllowTracks(), zone->GetDoNotAllowVias(),
+                                    zone->GetLayerSet().to_ullong() );
+
+        hash_combine( zoneHash, zone->GetPadConnection(), zone->GetLocalClearance(),
+                      zone->GetThermalReliefGap(), zone->GetThermalReliefSpokeWidth(),
+                      zone->GetMinThickness(), zone->GetIslandRemovalMode(),
+                      zone->GetMinIslandArea(), zone->GetFillMode(), zone->GetHatchThickness(),
+                      zone->GetHatchGap(), zone->GetHatchOrientation().AsDegrees(),
+                      zone->GetHatchSmoothingLevel(), zone->GetHatchSmoothingValue(),
+                      zone->GetHatchHoleMinArea() );
+
+        for( auto it = zone->Outline()->CIterateWithHoles(); it; it++ )
+            hash_combine( zoneHash, *it );
+
+        hashes.push_back( zoneHash );
+    }
+
+    combineSorted( hashes );
+
+    return ret;
+}
+
+
 bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
 {
     BOARD*   board = m_drcEngine->GetBoard();
@@ -728,27 +904,36 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
     if( !reportPhase( _( "Loading footprint library table..." ) ) )
         return false;   // DRC cancelled
 
-    std::map<LIB_ID, std::shared_ptr<FOOTPRINT>> libFootprintCache;
+    std::lock_guard<std::mutex> lock( m_libHashesMutex );
 
-    FP_LIB_TABLE* libTable = PROJECT_PCB::PcbFootprintLibs( project );
-    wxString      msg;
-    int           ii = 0;
-    const int     progressDelta = 250;
+    struct LIB_FOOTPRINT
+    {
+        LIB_FOOTPRINT_HASH*        m_cached = nullptr;
+        std::vector<size_t>        m_users;       // Indices of the board footprints using it
+        std::shared_ptr<FOOTPRINT> m_footprint;   // Only loaded when needed
+        bool                       m_found = false;
+    };
+
+    struct LIBRARY
+    {
+        wxString                          m_uri;
+        bool                              m_hasTimestamp = false;
+        std::map<wxString, LIB_FOOTPRINT> m_footprints;
+    };
+
+    FP_LIB_TABLE*                   libTable = PROJECT_PCB::PcbFootprintLibs( project );
+    std::map<wxString, LIBRARY>     libraries;
+    std::vector<FOOTPRINT*>         footprints;
+    std::vector<LIB_FOOTPRINT*>     footprintLibFootprints;
+    wxString                        msg;
+    int                             ii = 0;
+    const int                       progressDelta = 250;
 
     if( !reportPhase( _( "Checking board footprints against library..." ) ) )
         return false;
 
     for( FOOTPRINT* footprint : board->Footprints() )
     {
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES )
-                && m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
-        {
-            return true;    // Continue with other tests
-        }
-
-        if( !reportProgress( ii++, (int) board->Footprints().size(), progressDelta ) )
-            return false;   // DRC cancelled
-
         LIB_ID               fpID = footprint->GetFPID();
         wxString             libName = fpID.GetLibNickname();
         wxString             fpName = fpID.GetLibItemName();
@@ -791,28 +976,133 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
             continue;
         }
 
-        auto                       cacheIt = libFootprintCache.find( fpID );
-        std::shared_ptr<FOOTPRINT> libFootprint;
+        LIBRARY&       library = libraries[libName];
+        LIB_FOOTPRINT& libFootprint = library.m_footprints[fpName];
 
-        if( cacheIt != libFootprintCache.end() )
-        {
-            libFootprint = cacheIt->second;
-        }
-        else
-        {
-            try
+        library.m_uri = libTableRow->GetFullURI( true );
+
+        // Only the native library formats report meaningful timestamps
+        library.m_hasTimestamp =
+                libTableRow->GetType() == PCB_IO_MGR::ShowType( PCB_IO_MGR::KICAD_SEXP )
+                || libTableRow->GetType() == PCB_IO_MGR::ShowType( PCB_IO_MGR::LEGACY )
+                || libTableRow->GetType() == PCB_IO_MGR::ShowType( PCB_IO_MGR::GEDA_PCB );
+        libFootprint.m_cached = &m_libHashes[fpID];
+        libFootprint.m_users.push_back( footprints.size() );
+
+        footprints.push_back( footprint );
+        footprintLibFootprints.push_back( &libFootprint );
+    }
+
+    // Hash the board footprints, then only load the library footprints whose library changed
+    // since their hash was taken, or which don't match the hash of one of their users.
+    std::vector<size_t> boardHashes( footprints.size() );
+
+    ParallelFor( footprints.size(),
+            [&]( size_t aIndex )
             {
-                libFootprint.reset( libTable->FootprintLoad( libName, fpName, true ) );
+                boardHashes[aIndex] = parityHash( footprints[aIndex], board );
+            } );
 
-                if( libFootprint )
-                    libFootprintCache[ fpID ] = libFootprint;
-            }
-            catch( const IO_ERROR& )
+    std::vector<std::pair<const wxString, LIBRARY>*> libraryList;
+
+    for( std::pair<const wxString, LIBRARY>& library : libraries )
+        libraryList.push_back( &library );
+
+    // Each library is handled by a single task, as its PCB_IO isn't thread-safe
+    ParallelFor( libraryList.size(),
+            [&]( size_t aIndex )
             {
-            }
+                const wxString& libName = libraryList[aIndex]->first;
+                LIBRARY&        library = libraryList[aIndex]->second;
+                long long       timestamp = 0;
+
+                try
+                {
+                    timestamp = libTable->GenerateTimestamp( &libName );
+                }
+                catch( const IO_ERROR& )
+                {
+                }
+
+                for( auto& [fpName, libFootprint] : library.m_footprints )
+                {
+                    LIB_FOOTPRINT_HASH& cached = *libFootprint.m_cached;
+                    bool                stale = !library.m_hasTimestamp
+                                                    || cached.m_libURI != library.m_uri
+                                                    || cached.m_libTimestamp != timestamp;
+                    bool                needed = stale;
+
+                    libFootprint.m_found = cached.m_found;
+
+                    if( !stale && cached.m_found )
+                    {
+                        for( size_t user : libFootprint.m_users )
+                            needed |= boardHashes[user] != cached.m_hash;
+                    }
+
+                    if( !needed )
+                        continue;
+
+                    try
+                    {
+                        libFootprint.m_footprint.reset( libTable->FootprintLoad( libName, fpName,
+                                                                                 true ) );
+                    }
+                    catch( const IO_ERROR& )
+                    {
+                        // Leave the cached hash stale so the library is read again next time
+                        libFootprint.m_found = false;
+                        continue;
+                    }
+
+                    libFootprint.m_found = libFootprint.m_footprint != nullptr;
+
+                    if( stale )
+                    {
+                        cached.m_libURI = library.m_uri;
+                        cached.m_libTimestamp = timestamp;
+                        cached.m_found = libFootprint.m_found;
+                        cached.m_hash = 0;
+
+                        if( libFootprint.m_found )
+                            cached.m_hash = parityHash( libFootprint.m_footprint.get(), board );
+                    }
+                }
+            } );
+
+    enum PARITY { MATCHES, NOT_FOUND, NEEDS_UPDATE };
+
+    std::vector<PARITY> parity( footprints.size(), MATCHES );
+
+    ParallelFor( footprints.size(),
+            [&]( size_t aIndex )
+            {
+                LIB_FOOTPRINT* libFootprint = footprintLibFootprints[aIndex];
+
+                if( !libFootprint->m_found )
+                    parity[aIndex] = NOT_FOUND;
+                else if( boardHashes[aIndex] == libFootprint->m_cached->m_hash )
+                    parity[aIndex] = MATCHES;
+                else if( footprints[aIndex]->FootprintNeedsUpdate( libFootprint->m_footprint.get() ) )
+                    parity[aIndex] = NEEDS_UPDATE;
+            } );
+
+    for( size_t idx = 0; idx < footprints.size(); ++idx )
+    {
+        if( m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES )
+                && m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
+        {
+            return true;    // Continue with other tests
         }
 
-        if( !libFootprint )
+        if( !reportProgress( ii++, (int) footprints.size(), progressDelta ) )
+            return false;   // DRC cancelled
+
+        FOOTPRINT* footprint = footprints[idx];
+        wxString   libName = footprint->GetFPID().GetLibNickname();
+        wxString   fpName = footprint->GetFPID().GetLibItemName();
+
+        if( parity[idx] == NOT_FOUND )
         {
             if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_ISSUES ) )
             {
@@ -825,7 +1115,7 @@ bool DRC_TEST_PROVIDER_LIBRARY_PARITY::Run()
                 reportViolation( drcItem, footprint->GetCenter(), UNDEFINED_LAYER );
             }
         }
-        else if( footprint->FootprintNeedsUpdate( libFootprint.get() ) )
+        else if( parity[idx] == NEEDS_UPDATE )
         {
             if( !m_drcEngine->IsErrorLimitExceeded( DRCE_LIB_FOOTPRINT_MISMATCH ) )
             {
@@ -18,6 +18,7 @@
  */
 
 #include <common.h>
+#include <core/thread_pool.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <pad.h>
@@ -65,12 +66,27 @@ public:
         return wxT( "Tests matched track lengths." );
     }
 
+    // Evaluates rules and nets on the thread pool
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::CALLER_THREAD; }
+
 private:
 
     bool runInternal( bool aDelayReportMode = false );
 
     using CONNECTION = DRC_LENGTH_REPORT::ENTRY;
 
+    CONNECTION buildConnection( DRC_RULE* aRule, int aNetCode,
+                                const std::set<BOARD_CONNECTED_ITEM*>& aItems );
+
+    /**
+     * Run \a aFunc( aStart, aEnd ) over [0, aCount) on the thread pool, reporting progress
+     * from the calling thread.
+     *
+     * @return the results of each block, in order.
+     */
+    template<typename T>
+    std::vector<T> parallelize( size_t aCount, const std::function<T( size_t, size_t )>& aFunc );
+
     void checkLengths( const DRC_CONSTRAINT& aConstraint,
                        const std::vector<CONNECTION>& aMatchedConnections );
     void checkSkews( const DRC_CONSTRAINT& aConstraint,
@@ -209,6 +225,119 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::Run()
 }
 
 
+DRC_LENGTH_REPORT::ENTRY
+DRC_TEST_PROVIDER_MATCHED_LENGTH::buildConnection( DRC_RULE* aRule, int aNetCode,
+                                                   const std::set<BOARD_CONNECTED_ITEM*>& aItems )
+{
+    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    const BOARD_STACKUP&         stackup = bds.GetStackupDescriptor();
+    CONNECTION                   ent;
+
+    ent.items = aItems;
+    ent.netcode = aNetCode;
+    ent.netname = m_board->GetNetInfo().GetNetItem( ent.netcode )->GetNetname();
+
+    ent.viaCount = 0;
+    ent.totalRoute = 0;
+    ent.totalVia = 0;
+    ent.totalPadToDie = 0;
+    ent.fromItem = nullptr;
+    ent.toItem = nullptr;
+
+    for( BOARD_CONNECTED_ITEM* citem : aItems )
+    {
+        if( citem->Type() == PCB_VIA_T )
+        {
+            ent.viaCount++;
+
+            if( bds.m_UseHeightForLengthCalcs )
+            {
+                const PCB_VIA* v = static_cast<PCB_VIA*>( citem );
+                PCB_LAYER_ID   topmost;
+                PCB_LAYER_ID   bottommost;
+
+                v->GetOutermostConnectedLayers( &topmost, &bottommost );
+
+                if( topmost != UNDEFINED_LAYER && topmost != bottommost )
+                    ent.totalVia += stackup.GetLayerDistance( topmost, bottommost );
+            }
+        }
+        else if( citem->Type() == PCB_TRACE_T )
+        {
+            ent.totalRoute += static_cast<PCB_TRACK*>( citem )->GetLength();
+        }
+        else if ( citem->Type() == PCB_ARC_T )
+        {
+            ent.totalRoute += static_cast<PCB_ARC*>( citem )->GetLength();
+        }
+        else if( citem->Type() == PCB_PAD_T )
+        {
+            ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
+        }
+    }
+
+    ent.total = ent.totalRoute + ent.totalVia + ent.totalPadToDie;
+    ent.matchingRule = aRule;
+
+    // fixme: doesn't seem to work ;-)
+    auto ftPath = m_board->GetConnectivity()->GetFromToCache()->QueryFromToPath( ent.items );
+
+    if( ftPath )
+    {
+        ent.from = ftPath->fromName;
+        ent.to = ftPath->toName;
+    }
+    else
+    {
+        ent.from = ent.to = _( "<unconstrained>" );
+    }
+
+    return ent;
+}
+
+
+template<typename T>
+std::vector<T>
+DRC_TEST_PROVIDER_MATCHED_LENGTH::parallelize( size_t aCount,
+                                               const std::function<T( size_t, size_t )>& aFunc )
+{
+    const size_t        progressDelta = 100;
+    std::atomic<size_t> done( 0 );
+    thread_pool&        tp = GetKiCadThreadPool();
+
+    auto returns = tp.parallelize_loop( 0, aCount,
+                                        [&]( size_t aStart, size_t aEnd ) -> T
+                                        {
+                                            T result;
+
+                                            if( !m_drcEngine->IsCancelled() )
+                                                result = aFunc( aStart, aEnd );
+
+                                            done.fetch_add( aEnd - aStart );
+                                            return result;
+                                        },
+                                        GetThreadBudget( THREAD_SUBSYSTEM::DRC ) );
+
+    std::vector<T> results;
+
+    for( size_t ii = 0; ii < returns.size(); ++ii )
+    {
+        std::future<T>&    ret = returns[ii];
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 0 ) );
+
+        while( status != std::future_status::ready )
+        {
+            reportProgress( done, aCount, progressDelta );
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        }
+
+        results.push_back( ret.get() );
+    }
+
+    return results;
+}
+
+
 bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
 {
     m_board = m_drcEngine->GetBoard();
@@ -220,127 +349,99 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
             return false;
     }
 
-    std::map<DRC_RULE*, std::set<BOARD_CONNECTED_ITEM*> > itemSets;
-
-    std::shared_ptr<FROM_TO_CACHE> ftCache = m_board->GetConnectivity()->GetFromToCache();
-
-    ftCache->Rebuild( m_board );
+    // The from-to paths found by earlier runs stay valid until the connectivity changes
+    m_board->GetConnectivity()->GetFromToCache()->Update( m_board );
 
     const size_t progressDelta = 100;
-    size_t       count = 0;
     size_t       ii = 0;
+    size_t       count = 0;
+
+    std::vector<BOARD_CONNECTED_ITEM*> items;
 
     forEachGeometryItem( { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, PCB_PAD_T }, LSET::AllCuMask(),
             [&]( BOARD_ITEM *item ) -> bool
             {
-                count++;
+                items.push_back( static_cast<BOARD_CONNECTED_ITEM*>( item ) );
                 return true;
             } );
 
-    forEachGeometryItem( { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, PCB_PAD_T }, LSET::AllCuMask(),
-            [&]( BOARD_ITEM *item ) -> bool
-            {
-                if( !reportProgress( ii++, count, progressDelta ) )
-                    return false;
+    using RULE_ITEMS = std::vector<std::pair<DRC_RULE*, BOARD_CONNECTED_ITEM*>>;
 
+    // Rule resolution (and the from-to paths it may have to find) is the expensive part
+    std::vector<RULE_ITEMS> ruleItems = parallelize<RULE_ITEMS>( items.size(),
+            [&]( size_t aStart, size_t aEnd )
+            {
                 const DRC_CONSTRAINT_T constraintsToCheck[] = {
                         LENGTH_CONSTRAINT,
                         SKEW_CONSTRAINT,
                         VIA_COUNT_CONSTRAINT,
                 };
 
-                for( int i = 0; i < 3; i++ )
-                {
-                    auto constraint = m_drcEngine->EvalRules( constraintsToCheck[i], item, nullptr,
-                                                              item->GetLayer() );
+                RULE_ITEMS result;
 
-                    if( constraint.IsNull() )
-                        continue;
+                for( size_t jj = aStart; jj < aEnd; ++jj )
+                {
+                    BOARD_CONNECTED_ITEM* citem = items[jj];
 
-                    auto citem = static_cast<BOARD_CONNECTED_ITEM*>( item );
+                    for( DRC_CONSTRAINT_T constraintType : constraintsToCheck )
+                    {
+                        auto constraint = m_drcEngine->EvalRules( constraintType, citem, nullptr,
+                                                                  citem->GetLayer() );
 
-                    itemSets[ constraint.GetParentRule() ].insert( citem );
+                        if( !constraint.IsNull() )
+                            result.emplace_back( constraint.GetParentRule(), citem );
+                    }
                 }
 
-                return true;
+                return result;
             } );
 
-    std::map< DRC_RULE*, std::vector<CONNECTION> > matches;
+    if( m_drcEngine->IsCancelled() )
+        return false;
 
-    for( const std::pair< DRC_RULE* const, std::set<BOARD_CONNECTED_ITEM*> >& it : itemSets )
-    {
-        std::map<int, std::set<BOARD_CONNECTED_ITEM*> > netMap;
-
-        for( BOARD_CONNECTED_ITEM* citem : it.second )
-            netMap[ citem->GetNetCode() ].insert( citem );
+    std::map<DRC_RULE*, std::map<int, std::set<BOARD_CONNECTED_ITEM*>>> ruleNetMap;
 
-        for( const std::pair< const int, std::set<BOARD_CONNECTED_ITEM*> >& nitem : netMap )
-        {
-            CONNECTION ent;
-            ent.items = nitem.second;
-            ent.netcode = nitem.first;
-            ent.netname = m_board->GetNetInfo().GetNetItem( ent.netcode )->GetNetname();
-
-            ent.viaCount = 0;
-            ent.totalRoute = 0;
-            ent.totalVia = 0;
-            ent.totalPadToDie = 0;
-            ent.fromItem = nullptr;
-            ent.toItem = nullptr;
-
-            for( BOARD_CONNECTED_ITEM* citem : nitem.second )
-            {
-                if( citem->Type() == PCB_VIA_T )
-                {
-                    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
-                    const BOARD_STACKUP&         stackup = bds.GetStackupDescriptor();
+    for( const RULE_ITEMS& block : ruleItems )
+    {
+        for( const auto& [ rule, citem ] : block )
+            ruleNetMap[ rule ][ citem->GetNetCode() ].insert( citem );
+    }
 
-                    ent.viaCount++;
+    std::vector<std::tuple<DRC_RULE*, int, const std::set<BOARD_CONNECTED_ITEM*>*>> nets;
 
-                    if( bds.m_UseHeightForLengthCalcs )
-                    {
-                        const PCB_VIA* v = static_cast<PCB_VIA*>( citem );
-                        PCB_LAYER_ID   topmost;
-                        PCB_LAYER_ID   bottommost;
+    for( const auto& [ rule, netMap ] : ruleNetMap )
+    {
+        for( const auto& [ netcode, netItems ] : netMap )
+            nets.emplace_back( rule, netcode, &netItems );
+    }
 
-                        v->GetOutermostConnectedLayers( &topmost, &bottommost );
+    std::vector<std::vector<CONNECTION>> connections = parallelize<std::vector<CONNECTION>>(
+            nets.size(),
+            [&]( size_t aStart, size_t aEnd )
+            {
+                std::vector<CONNECTION> result;
 
-                        if( topmost != UNDEFINED_LAYER && topmost != bottommost )
-                            ent.totalVia += stackup.GetLayerDistance( topmost, bottommost );
-                    }
-                }
-                else if( citem->Type() == PCB_TRACE_T )
+                for( size_t jj = aStart; jj < aEnd; ++jj )
                 {
-                    ent.totalRoute += static_cast<PCB_TRACK*>( citem )->GetLength();
+                    auto [ rule, netcode, netItems ] = nets[jj];
+                    result.push_back( buildConnection( rule, netcode, *netItems ) );
                 }
-                else if ( citem->Type() == PCB_ARC_T )
-                {
-                    ent.totalRoute += static_cast<PCB_ARC*>( citem )->GetLength();
-                }
-                else if( citem->Type() == PCB_PAD_T )
-                {
-                    ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
-                }
-            }
 
-            ent.total = ent.totalRoute + ent.totalVia + ent.totalPadToDie;
-            ent.matchingRule = it.first;
+                return result;
+            } );
 
-            // fixme: doesn't seem to work ;-)
-            auto ftPath = ftCache->QueryFromToPath( ent.items );
+    if( m_drcEngine->IsCancelled() )
+        return false;
 
-            if( ftPath )
-            {
-                ent.from = ftPath->fromName;
-                ent.to = ftPath->toName;
-            }
-            else
-            {
-                ent.from = ent.to = _( "<unconstrained>" );
-            }
+    std::map< DRC_RULE*, std::vector<CONNECTION> > matches;
 
+    // Blocks come back in order, so the report doesn't depend on the thread count
+    for( const std::vector<CONNECTION>& block : connections )
+    {
+        for( const CONNECTION& ent : block )
+        {
             m_report.Add( ent );
-            matches[ it.first ].push_back(ent);
+            matches[ ent.matchingRule ].push_back( ent );
         }
     }
 
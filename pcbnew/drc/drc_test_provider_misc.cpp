@@ -67,6 +67,8 @@ public:
         return wxT( "Misc checks (board outline, missing textvars)" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
     void testOutline();
     void testDisabledLayers();
@@ -70,6 +70,13 @@ public:
         return wxT( "Tests item clearances irrespective of nets" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_CLEARANCE, DRCE_HOLE_CLEARANCE };
+    }
+
 private:
     int testItemAgainstItem( BOARD_ITEM* aItem, SHAPE* aItemShape, PCB_LAYER_ID aLayer,
                               BOARD_ITEM* other );
@@ -302,7 +309,7 @@ bool DRC_TEST_PROVIDER_PHYSICAL_CLEARANCE::Run()
                             switch( shape->GetShape() )
                             {
                             case SHAPE_T::POLY:
-                                testShapeLineChain( shape->GetPolyShape().Outline( 0 ),
+                                testShapeLineChain( shape->GetPolyShape().COutline( 0 ),
                                                     shape->GetWidth(), layer, item, c );
                                 break;
 
@@ -21,6 +21,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include <board.h>
 #include <pad.h>
 #include <drc/drc_engine.h>
@@ -69,6 +72,8 @@ public:
         return wxT( "Performs layout-vs-schematics integity check" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
     void testNetlist( NETLIST& aNetlist );
 };
@@ -102,11 +107,27 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
         }
     }
 
+    // Footprints and components are matched through hash maps rather than by searching the
+    // board or the netlist for each of them, which is quadratic on large designs.
+    std::unordered_map<wxString, FOOTPRINT*> footprintsByRef;
+    std::unordered_set<wxString>             componentRefs;
+
+    for( FOOTPRINT* footprint : board->Footprints() )
+        footprintsByRef.emplace( footprint->GetReference(), footprint );
+
     // Search for component footprints in the netlist but not on the board.
     for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
     {
         COMPONENT* component = aNetlist.GetComponent( ii );
-        FOOTPRINT* footprint = board->FindFootprintByReference( component->GetReference() );
+        FOOTPRINT* footprint = nullptr;
+
+        componentRefs.insert( component->GetReference() );
+
+        if( auto it = footprintsByRef.find( component->GetReference() );
+                it != footprintsByRef.end() )
+        {
+            footprint = it->second;
+        }
 
         if( footprint == nullptr )
         {
@@ -227,6 +248,11 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
                 }
             }
 
+            std::unordered_set<wxString> padNumbers;
+
+            for( PAD* pad : footprint->Pads() )
+                padNumbers.insert( pad->GetNumber() );
+
             for( unsigned jj = 0; jj < component->GetNetCount(); ++jj )
             {
                 if( m_drcEngine->IsErrorLimitExceeded( DRCE_NET_CONFLICT ) )
@@ -234,7 +260,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
 
                 const COMPONENT_NET& sch_net = component->GetNet( jj );
 
-                if( !footprint->FindPadByNumber( sch_net.GetPinName() ) )
+                if( !padNumbers.count( sch_net.GetPinName() ) )
                 {
                     wxString msg;
 
@@ -269,7 +295,7 @@ void DRC_TEST_PROVIDER_SCHEMATIC_PARITY::testNetlist( NETLIST& aNetlist )
         if( footprint->GetAttributes() & FP_BOARD_ONLY )
             continue;
 
-        if( !aNetlist.GetComponentByReference( footprint->GetReference() ) )
+        if( !componentRefs.count( footprint->GetReference() ) )
         {
             std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_EXTRA_FOOTPRINT );
 
@@ -21,6 +21,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <thread>
 #include <common.h>
 #include <board.h>
 #include <footprint.h>
@@ -33,6 +35,7 @@
 #include <drc/drc_rule.h>
 #include <drc/drc_test_provider_clearance_base.h>
 #include <drc/drc_rtree.h>
+#include <core/thread_pool.h>
 
 /*
     Silk to silk clearance test. Check all silkscreen features against each other.
@@ -66,7 +69,16 @@ public:
         return wxT( "Tests for overlapping silkscreen features." );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
+    /**
+     * Test the candidate pairs of one pair of items, stopping at the first collision.
+     *
+     * @return false if the tests should stop.
+     */
+    bool testItemPair( const std::vector<DRC_RTREE::PAIR_INFO>& aCandidates, size_t aFirst,
+                       size_t aLast );
 
     BOARD* m_board;
     int m_largestClearance;
@@ -96,61 +108,6 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
     if( !reportPhase( _( "Checking silkscreen for overlapping items..." ) ) )
         return false;   // DRC cancelled
 
-    DRC_RTREE silkTree;
-    DRC_RTREE targetTree;
-    int       ii = 0;
-    int       items = 0;
-
-    auto countItems =
-            [&]( BOARD_ITEM* item ) -> bool
-            {
-                ++items;
-                return true;
-            };
-
-    auto addToSilkTree =
-            [&]( BOARD_ITEM* item ) -> bool
-            {
-                if( !reportProgress( ii++, items, progressDelta ) )
-                    return false;
-
-                for( PCB_LAYER_ID layer : { F_SilkS, B_SilkS } )
-                {
-                    if( item->IsOnLayer( layer ) )
-                        silkTree.Insert( item, layer );
-                }
-
-                return true;
-            };
-
-    auto addToTargetTree =
-            [&]( BOARD_ITEM* item ) -> bool
-            {
-                if( !reportProgress( ii++, items, progressDelta ) )
-                    return false;
-
-                for( PCB_LAYER_ID layer : item->GetLayerSet().Seq() )
-                    targetTree.Insert( item, layer );
-
-                return true;
-            };
-
-    forEachGeometryItem( s_allBasicItems, LSET( 2, F_SilkS, B_SilkS ), countItems );
-
-    forEachGeometryItem( s_allBasicItems,
-                         LSET::FrontMask() | LSET::BackMask() | LSET( 2, Edge_Cuts, Margin ),
-                         countItems );
-
-    forEachGeometryItem( s_allBasicItems, LSET( 2, F_SilkS, B_SilkS ), addToSilkTree );
-
-    forEachGeometryItem( s_allBasicItems,
-                         LSET::FrontMask() | LSET::BackMask() | LSET( 2, Edge_Cuts, Margin ),
-                         addToTargetTree );
-
-    reportAux( wxT( "Testing %d silkscreen features against %d board items." ),
-               silkTree.size(),
-               targetTree.size() );
-
     const std::vector<DRC_RTREE::LAYER_PAIR> layerPairs =
     {
         DRC_RTREE::LAYER_PAIR( F_SilkS, F_SilkS ),
@@ -173,87 +130,145 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
         DRC_RTREE::LAYER_PAIR( B_SilkS, Margin )
     };
 
-    targetTree.QueryCollidingPairs( &silkTree, layerPairs,
-            [&]( const DRC_RTREE::LAYER_PAIR& aLayers, DRC_RTREE::ITEM_WITH_SHAPE* aRefItemShape,
-                 DRC_RTREE::ITEM_WITH_SHAPE* aTestItemShape, bool* aCollisionDetected ) -> bool
+    const LSET silkLayers( 2, F_SilkS, B_SilkS );
+    LSET       targetLayers;
+
+    for( const DRC_RTREE::LAYER_PAIR& layerPair : layerPairs )
+        targetLayers.set( layerPair.second );
+
+    std::vector<BOARD_ITEM*> items;
+
+    forEachGeometryItem( s_allBasicItems, targetLayers,
+            [&]( BOARD_ITEM* item ) -> bool
             {
-                BOARD_ITEM*  refItem = aRefItemShape->parent;
-                const SHAPE* refShape = aRefItemShape->shape;
-                BOARD_ITEM*  testItem = aTestItemShape->parent;
-                const SHAPE* testShape = aTestItemShape->shape;
+                if( !isInvisibleText( item ) )
+                    items.push_back( item );
 
-                std::shared_ptr<SHAPE> hole;
+                return true;
+            } );
 
-                if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
-                    return false;
+    // Building the shapes of texts is expensive (outline font glyphs are triangulated), so
+    // build them in parallel.  Each item is handled by one task, as texts have render caches.
+    // Footprint texts and graphics keep their shapes from one run to the next.
+    //
+    // This provider itself runs on the thread pool, so use ParallelFor(), in which this thread
+    // takes part, rather than wait on tasks which could be queued behind it.  Only this thread
+    // may report the provider's progress.
+    using LAYER_SHAPES = std::vector<std::pair<PCB_LAYER_ID, std::shared_ptr<SHAPE>>>;
+
+    std::vector<LAYER_SHAPES> shapes( items.size() );
+    std::atomic<size_t>       done( 0 );
+    const std::thread::id     caller = std::this_thread::get_id();
+    size_t                    callerDone = 0;
+
+    ParallelFor( items.size(),
+            [&]( size_t ii )
+            {
+                if( m_drcEngine->IsCancelled() )
+                    return;
 
-                if( isInvisibleText( refItem ) || isInvisibleText( testItem ) )
-                    return true;
+                BOARD_ITEM* item = items[ii];
+                FOOTPRINT*  footprint = item->GetParentFootprint();
+                bool        cached = footprint && ( item->Type() == PCB_FIELD_T
+                                                    || item->Type() == PCB_TEXT_T
+                                                    || item->Type() == PCB_TEXTBOX_T
+                                                    || item->Type() == PCB_SHAPE_T );
 
-                if( testItem->IsTented() )
+                for( PCB_LAYER_ID layer : ( item->GetLayerSet() & targetLayers ).Seq() )
                 {
-                    if( testItem->HasHole() )
-                    {
-                        hole = testItem->GetEffectiveHoleShape();
-                        testShape = hole.get();
-                    }
+                    std::shared_ptr<SHAPE> shape;
+
+                    if( cached )
+                        shape = footprint->GetCachedEffectiveShape( item, layer );
                     else
-                    {
-                        return true;
-                    }
+                        shape = item->GetEffectiveShape( layer );
+
+                    shapes[ii].emplace_back( layer, std::move( shape ) );
                 }
 
-                DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( SILK_CLEARANCE_CONSTRAINT,
-                                                                    refItem, testItem,
-                                                                    aLayers.second );
+                done.fetch_add( 1 );
 
-                if( constraint.IsNull() || constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
-                    return true;
+                if( std::this_thread::get_id() == caller && ( ++callerDone % progressDelta ) == 0 )
+                    reportProgress( done, items.size(), 1 );
+            } );
 
-                int minClearance = constraint.GetValue().Min();
+    if( m_drcEngine->IsCancelled() )
+        return false;
 
-                if( minClearance < 0 )
-                    return true;
+    DRC_RTREE silkTree;
+    DRC_RTREE targetTree;
 
-                int      actual;
-                VECTOR2I pos;
+    for( size_t ii = 0; ii < items.size(); ++ii )
+    {
+        for( const auto& [ layer, shape ] : shapes[ii] )
+        {
+            if( silkLayers.test( layer ) )
+                silkTree.Insert( items[ii], layer, shape, 0 );
 
-                // Graphics are often compound shapes so ignore collisions between shapes in a
-                // single footprint or on the board (both parent footprints will be nullptr).
-                if( refItem->Type() == PCB_SHAPE_T && testItem->Type() == PCB_SHAPE_T
-                         && refItem->GetParentFootprint() == testItem->GetParentFootprint() )
-                {
-                    return true;
-                }
+            targetTree.Insert( items[ii], layer, shape, 0 );
+        }
+    }
 
-                if( refShape->Collide( testShape, minClearance, &actual, &pos ) )
-                {
-                    std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_OVERLAPPING_SILK );
+    shapes.clear();
+
+    reportAux( wxT( "Testing %d silkscreen features against %d board items." ),
+               silkTree.size(),
+               targetTree.size() );
 
-                    if( minClearance > 0 )
-                    {
-                        wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
-                                                  constraint.GetParentRule()->m_Name,
-                                                  minClearance,
-                                                  actual );
+    std::vector<DRC_RTREE::PAIR_INFO> candidates =
+            targetTree.QueryCandidatePairs( &silkTree, layerPairs, m_largestClearance );
 
-                        drcItem->SetErrorMessage( drcItem->GetErrorText() + wxS( " " ) + msg );
-                    }
+    auto itemPair =
+            []( const DRC_RTREE::PAIR_INFO& aPair )
+            {
+                BOARD_ITEM* a = aPair.refItem->parent;
+                BOARD_ITEM* b = aPair.testItem->parent;
 
-                    drcItem->SetItems( refItem, testItem );
-                    drcItem->SetViolatingRule( constraint.GetParentRule() );
+                // canonical order, so that a:b and b:a are the same pair
+                if( static_cast<void*>( a ) > static_cast<void*>( b ) )
+                    std::swap( a, b );
 
-                    reportViolation( drcItem, pos, aLayers.second );
+                return std::make_pair( a, b );
+            };
 
-                    *aCollisionDetected = true;
-                }
+    // Group the candidates of each pair of items (keeping their order), so that a pair of
+    // compound shapes reports one collision, and pairs can be tested in parallel
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      [&]( const DRC_RTREE::PAIR_INFO& aLhs, const DRC_RTREE::PAIR_INFO& aRhs )
+                      {
+                          return itemPair( aLhs ) < itemPair( aRhs );
+                      } );
 
-                return true;
-            },
-            m_largestClearance,
-            [&]( int aCount, int aSize ) -> bool
+    std::vector<size_t> groups;
+
+    for( size_t ii = 0; ii < candidates.size(); ++ii )
+    {
+        if( ii == 0 || itemPair( candidates[ii] ) != itemPair( candidates[ii - 1] ) )
+            groups.push_back( ii );
+    }
+
+    groups.push_back( candidates.size() );
+
+    size_t groupCount = groups.size() - 1;
+
+    std::atomic<bool> stop( false );
+
+    done = 0;
+    callerDone = 0;
+
+    ParallelFor( groupCount,
+            [&]( size_t ii )
             {
-                return reportProgress( aCount, aSize, progressDelta );
+                if( stop )
+                    return;
+
+                if( !testItemPair( candidates, groups[ii], groups[ii + 1] ) )
+                    stop = true;
+
+                done.fetch_add( 1 );
+
+                if( std::this_thread::get_id() == caller && ( ++callerDone % progressDelta ) == 0 )
+                    reportProgress( done, groupCount, 1 );
             } );
 
     reportRuleStatistics();
@@ -262,6 +277,88 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
 }
 
 
+bool DRC_TEST_PROVIDER_SILK_CLEARANCE::testItemPair(
+        const std::vector<DRC_RTREE::PAIR_INFO>& aCandidates, size_t aFirst, size_t aLast )
+{
+    for( size_t ii = aFirst; ii < aLast; ++ii )
+    {
+        const DRC_RTREE::LAYER_PAIR& aLayers = aCandidates[ii].layerPair;
+        BOARD_ITEM*                  refItem = aCandidates[ii].refItem->parent;
+        const SHAPE*                 refShape = aCandidates[ii].refItem->shape;
+        BOARD_ITEM*                  testItem = aCandidates[ii].testItem->parent;
+        const SHAPE*                 testShape = aCandidates[ii].testItem->shape;
+
+        std::shared_ptr<SHAPE> hole;
+
+        if( m_drcEngine->IsErrorLimitExceeded( DRCE_OVERLAPPING_SILK ) )
+            return false;
+
+        if( m_drcEngine->IsCancelled() )
+            return false;
+
+        if( testItem->IsTented() )
+        {
+            if( testItem->HasHole() )
+            {
+                hole = testItem->GetEffectiveHoleShape();
+                testShape = hole.get();
+            }
+            else
+            {
+                continue;
+            }
+        }
+
+        DRC_CONSTRAINT constraint = m_drcEngine->EvalRules( SILK_CLEARANCE_CONSTRAINT,
+                                                            refItem, testItem,
+                                                            aLayers.second );
+
+        if( constraint.IsNull() || constraint.GetSeverity() == RPT_SEVERITY_IGNORE )
+            continue;
+
+        int minClearance = constraint.GetValue().Min();
+
+        if( minClearance < 0 )
+            continue;
+
+        int      actual;
+        VECTOR2I pos;
+
+        // Graphics are often compound shapes so ignore collisions between shapes in a
+        // single footprint or on the board (both parent footprints will be nullptr).
+        if( refItem->Type() == PCB_SHAPE_T && testItem->Type() == PCB_SHAPE_T
+                 && refItem->GetParentFootprint() == testItem->GetParentFootprint() )
+        {
+            return true;
+        }
+
+        if( refShape->Collide( testShape, minClearance, &actual, &pos ) )
+        {
+            std::shared_ptr<DRC_ITEM> drcItem = DRC_ITEM::Create( DRCE_OVERLAPPING_SILK );
+
+            if( minClearance > 0 )
+            {
+                wxString msg = formatMsg( _( "(%s clearance %s; actual %s)" ),
+                                          constraint.GetParentRule()->m_Name,
+                                          minClearance,
+                                          actual );
+
+                drcItem->SetErrorMessage( drcItem->GetErrorText() + wxS( " " ) + msg );
+            }
+
+            drcItem->SetItems( refItem, testItem );
+            drcItem->SetViolatingRule( constraint.GetParentRule() );
+
+            reportViolation( drcItem, pos, aLayers.second );
+
+            return true;    // one collision per pair of items
+        }
+    }
+
+    return true;
+}
+
+
 namespace detail
 {
     static DRC_REGISTER_TEST_PROVIDER<DRC_TEST_PROVIDER_SILK_CLEARANCE> dummy;
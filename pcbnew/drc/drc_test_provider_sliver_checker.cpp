@@ -22,15 +22,19 @@
  */
 
 #include <atomic>
+#include <unordered_set>
 #include <board.h>
 #include <board_design_settings.h>
 #include <zone.h>
 #include <footprint.h>
 #include <pcb_shape.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/shape_poly_set.h>
 #include <drc/drc_rule.h>
 #include <drc/drc_item.h>
 #include <drc/drc_test_provider.h>
+#include <drc/drc_rtree.h>
+#include <drc/drc_tiles.h>
 #include <advanced_config.h>
 #include <progress_reporter.h>
 #include <core/thread_pool.h>
@@ -65,8 +69,17 @@ public:
         return wxT( "Checks copper layers for slivers" );
     }
 
+    // Uses the thread pool
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::CALLER_THREAD; }
+
 private:
     wxString layerDesc( PCB_LAYER_ID aLayer );
+
+    /**
+     * Report the slivers in the outlines of \a aPoly.  If \a aTile is given, only the ones in
+     * its core are reported.
+     */
+    void testSlivers( const SHAPE_POLY_SET& aPoly, PCB_LAYER_ID aLayer, const DRC_TILE* aTile );
 };
 
 
@@ -76,6 +89,112 @@ wxString DRC_TEST_PROVIDER_SLIVER_CHECKER::layerDesc( PCB_LAYER_ID aLayer )
 }
 
 
+void DRC_TEST_PROVIDER_SLIVER_CHECKER::testSlivers( const SHAPE_POLY_SET& aPoly,
+                                                    PCB_LAYER_ID aLayer, const DRC_TILE* aTile )
+{
+    int64_t widthTolerance = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_SliverWidthTolerance );
+    int64_t squared_width = widthTolerance * widthTolerance;
+
+    double angleTolerance = ADVANCED_CFG::GetCfg().m_SliverAngleTolerance;
+    double cosangleTol = 2.0 * cos( DEG2RAD( angleTolerance ) );
+
+    // Frequently, in filled areas, some points of the polygons are very near (dist is only
+    // a few internal units, like 2 or 3 units.
+    // We skip very small vertices: one cannot really compute a valid orientation of
+    // such a vertex
+    // So skip points near than min_len (in internal units).
+    const int min_len = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_SliverMinimumLength );
+
+    for( int jj = 0; jj < aPoly.OutlineCount(); ++jj )
+    {
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = aPoly.Outline( jj ).CPoints();
+        int                                   ptCount = pts.size();
+        int                                   offset = 0;
+
+        auto area = [&]( const VECTOR2I& p, const VECTOR2I& q, const VECTOR2I& r ) -> VECTOR2I::extended_type
+            {
+                return static_cast<VECTOR2I::extended_type>( q.y - p.y ) * ( r.x - q.x ) -
+                       static_cast<VECTOR2I::extended_type>( q.x - p.x ) * ( r.y - q.y );
+            };
+
+        auto isLocallyInside = [&]( int aA, int aB ) -> bool
+            {
+                int prev = ( ptCount + aA - 1 ) % ptCount;
+                int next = ( aA + 1 ) % ptCount;
+
+                if( area( pts[prev], pts[aA], pts[next] ) < 0 )
+                    return area( pts[aA], pts[aB], pts[next] ) >= 0 && area( pts[aA], pts[prev], pts[aB] ) >= 0;
+                else
+                    return area( pts[aA], pts[aB], pts[prev] ) < 0 || area( pts[aA], pts[next], pts[aB] ) < 0;
+            };
+
+        if( ptCount <= 5 )
+            continue;
+
+        for( int kk = 0; kk < ptCount; kk += offset )
+        {
+            int      prior_index = ( ptCount + kk - 1 ) % ptCount;
+            int      next_index  = ( kk + 1 ) % ptCount;
+            VECTOR2I pt = pts[ kk ];
+            VECTOR2I ptPrior = pts[ prior_index ];
+            VECTOR2I vPrior = ( ptPrior - pt );
+            int forward_offset = 1;
+
+            offset = 1;
+
+            while( std::abs( vPrior.x ) < min_len && std::abs( vPrior.y ) < min_len
+                    && offset < ptCount )
+            {
+                pt = pts[ ( kk + offset++ ) % ptCount ];
+                vPrior = ( ptPrior - pt );
+            }
+
+            if( offset >= ptCount )
+                break;
+
+            // Corners made by the tile clipping are outside its core
+            if( aTile && !aTile->Owns( pt ) )
+                continue;
+
+            VECTOR2I ptAfter  = pts[ next_index ];
+            VECTOR2I vAfter = ( ptAfter - pt );
+
+            while( std::abs( vAfter.x ) < min_len && std::abs( vAfter.y ) < min_len
+                    && forward_offset < ptCount )
+            {
+                next_index = ( kk + forward_offset++ ) % ptCount;
+                ptAfter  = pts[ next_index ];
+                vAfter = ( ptAfter - pt );
+            }
+
+            if( offset >= ptCount )
+                break;
+
+            // Negative dot product means that the angle is > 90°
+            if( vPrior.Dot( vAfter ) <= 0 )
+                continue;
+
+            if( !isLocallyInside( prior_index, next_index ) )
+                continue;
+
+            VECTOR2I vIncluded = ptAfter - ptPrior;
+            double arm1 = vPrior.SquaredEuclideanNorm();
+            double arm2 = vAfter.SquaredEuclideanNorm();
+            double opp  = vIncluded.SquaredEuclideanNorm();
+
+            double cos_ang = std::abs( ( opp - arm1 - arm2 ) / ( std::sqrt( arm1 ) * std::sqrt( arm2 ) ) );
+
+            if( cos_ang > cosangleTol && 2.0 - cos_ang > std::numeric_limits<float>::epsilon() && opp > squared_width )
+            {
+                std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_COPPER_SLIVER );
+                drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + layerDesc( aLayer ) );
+                reportViolation( drce, pt, aLayer );
+            }
+        }
+    }
+}
+
+
 bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
 {
     if( m_drcEngine->IsErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
@@ -84,22 +203,32 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
     if( !reportPhase( _( "Running sliver detection on copper layers..." ) ) )
         return false;   // DRC cancelled
 
-    int64_t widthTolerance = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_SliverWidthTolerance );
-    int64_t squared_width = widthTolerance * widthTolerance;
-
-    double angleTolerance = ADVANCED_CFG::GetCfg().m_SliverAngleTolerance;
-    double cosangleTol = 2.0 * cos( DEG2RAD( angleTolerance ) );
-    LSET   copperLayerSet = m_drcEngine->GetBoard()->GetEnabledLayers() & LSET::AllCuMask();
+    BOARD* board = m_drcEngine->GetBoard();
+    LSET   copperLayerSet = board->GetEnabledLayers() & LSET::AllCuMask();
     LSEQ   copperLayers = copperLayerSet.Seq();
     int    layerCount = copperLayers.size();
 
-    // Report progress on board zones only.  Everything else is in the noise.
+    // Slivers are reported once they open wider than the width tolerance.  Tile clipping cuts
+    // their sides at the overlap, which still lets wedges of 1 degree open that wide.
+    int widthTolerance = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_SliverWidthTolerance );
+    int overlap = KiROUND( widthTolerance / sin( DEG2RAD( 1.0 ) ) );
+    int tileSize = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_DRCTileSize );
+
+    std::vector<DRC_TILE> tiles;
+
+    if( tileSize > 0 )
+        tiles = BuildDRCTiles( board->GetBoundingBox(), std::max( tileSize, 4 * overlap ),
+                               overlap );
+
+    bool tiled = tiles.size() > 1 && board->m_CopperItemRTreeCache;
+
+    // Report progress on board zones only (or on tiles).  Everything else is in the noise.
     int    zoneLayerCount = 0;
     std::atomic<size_t> done( 1 );
 
     for( PCB_LAYER_ID layer : copperLayers )
     {
-        for( ZONE* zone : m_drcEngine->GetBoard()->Zones() )
+        for( ZONE* zone : board->Zones() )
         {
             if( !zone->GetIsRuleArea() && zone->IsOnLayer( layer ) )
                 zoneLayerCount++;
@@ -111,13 +240,12 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
     if( reporter && reporter->IsCancelled() )
         return false;   // DRC cancelled
 
-    std::vector<SHAPE_POLY_SET> layerPolys( layerCount );
-
-    auto build_layer_polys =
+    auto test_layer =
             [&]( int layerIdx ) -> size_t
             {
+                GEOMETRY_ARENA  arena;
                 PCB_LAYER_ID    layer = copperLayers[layerIdx];
-                SHAPE_POLY_SET& poly = layerPolys[layerIdx];
+                SHAPE_POLY_SET  poly;
 
                 if( m_drcEngine->IsCancelled() )
                     return 0;
@@ -131,7 +259,8 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
                             {
                                 if( !zone->GetIsRuleArea() )
                                 {
-                                    fill = zone->GetFill( layer )->CloneDropTriangulation();
+                                    fill = zone->GetFilledPolysList( layer )
+                                                   ->CloneDropTriangulation();
                                     poly.Append( fill );
 
                                     // Report progress on board zones only.  Everything else is
@@ -157,125 +286,94 @@ bool DRC_TEST_PROVIDER_SLIVER_CHECKER::Run()
 
                 poly.Simplify( SHAPE_POLY_SET::POLYGON_MODE::PM_FAST );
 
+                if( !m_drcEngine->IsErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
+                    testSlivers( poly, layer, nullptr );
+
                 return 1;
             };
 
-    thread_pool& tp = GetKiCadThreadPool();
-    std::vector<std::future<size_t>> returns;
-
-    returns.reserve( copperLayers.size() );
-
-    for( size_t ii = 0; ii < copperLayers.size(); ++ii )
-        returns.emplace_back( tp.submit( build_layer_polys, ii ) );
-
-    for( const std::future<size_t>& ret : returns )
-    {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-
-        while( status != std::future_status::ready )
-        {
-            reportProgress( zoneLayerCount, done );
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
-
-    for( int ii = 0; ii < layerCount; ++ii )
-    {
-        PCB_LAYER_ID    layer = copperLayers[ii];
-        SHAPE_POLY_SET& poly = layerPolys[ii];
-
-        if( m_drcEngine->IsErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
-            continue;
-
-        // Frequently, in filled areas, some points of the polygons are very near (dist is only
-        // a few internal units, like 2 or 3 units.
-        // We skip very small vertices: one cannot really compute a valid orientation of
-        // such a vertex
-        // So skip points near than min_len (in internal units).
-        const int min_len = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_SliverMinimumLength );
-
-        for( int jj = 0; jj < poly.OutlineCount(); ++jj )
-        {
-            const std::vector<VECTOR2I>& pts = poly.Outline( jj ).CPoints();
-            int                          ptCount = pts.size();
-            int                          offset = 0;
+    // Only the copper of the tile is merged.  Zone fills are clipped before they're merged, so
+    // that a tile never holds more than its share of a plane.
+    auto test_tile =
+            [&]( PCB_LAYER_ID aLayer, const DRC_TILE& aTile ) -> size_t
+            {
+                GEOMETRY_ARENA                  arena;
+                SHAPE_POLY_SET                  poly;
+                std::unordered_set<BOARD_ITEM*> items;
 
-            auto area = [&]( const VECTOR2I& p, const VECTOR2I& q, const VECTOR2I& r ) -> VECTOR2I::extended_type
+                if( m_drcEngine->IsCancelled()
+                        || m_drcEngine->IsErrorLimitExceeded( DRCE_COPPER_SLIVER ) )
                 {
-                    return static_cast<VECTOR2I::extended_type>( q.y - p.y ) * ( r.x - q.x ) -
-                           static_cast<VECTOR2I::extended_type>( q.x - p.x ) * ( r.y - q.y );
-                };
+                    done.fetch_add( 1 );
+                    return 0;
+                }
 
-            auto isLocallyInside = [&]( int aA, int aB ) -> bool
+                for( DRC_RTREE::ITEM_WITH_SHAPE* entry :
+                        board->m_CopperItemRTreeCache->Overlapping( aLayer, aTile.m_clip ) )
                 {
-                    int prev = ( ptCount + aA - 1 ) % ptCount;
-                    int next = ( aA + 1 ) % ptCount;
-
-                    if( area( pts[prev], pts[aA], pts[next] ) < 0 )
-                        return area( pts[aA], pts[aB], pts[next] ) >= 0 && area( pts[aA], pts[prev], pts[aB] ) >= 0;
-                    else
-                        return area( pts[aA], pts[aB], pts[prev] ) < 0 || area( pts[aA], pts[next], pts[aB] ) < 0;
-                };
-
-            if( ptCount <= 5 )
-                continue;
+                    if( entry->parent->IsOnLayer( aLayer ) && items.insert( entry->parent ).second )
+                    {
+                        entry->parent->TransformShapeToPolygon( poly, aLayer, 0, ARC_LOW_DEF,
+                                                                ERROR_INSIDE );
+                    }
+                }
 
-            for( int kk = 0; kk < ptCount; kk += offset )
-            {
-                int      prior_index = ( ptCount + kk - 1 ) % ptCount;
-                int      next_index  = ( kk + 1 ) % ptCount;
-                VECTOR2I pt = pts[ kk ];
-                VECTOR2I ptPrior = pts[ prior_index ];
-                VECTOR2I vPrior = ( ptPrior - pt );
-                int forward_offset = 1;
+                for( ZONE* zone : board->m_DRCCopperZones )
+                {
+                    if( !zone->IsOnLayer( aLayer )
+                            || !zone->GetBoundingBox().Intersects( aTile.m_clip ) )
+                    {
+                        continue;
+                    }
 
-                offset = 1;
+                    SHAPE_POLY_SET fill =
+                            zone->GetFilledPolysList( aLayer )->CloneDropTriangulation();
 
-                while( std::abs( vPrior.x ) < min_len && std::abs( vPrior.y ) < min_len
-                        && offset < ptCount )
-                {
-                    pt = pts[ ( kk + offset++ ) % ptCount ];
-                    vPrior = ( ptPrior - pt );
+                    aTile.Clip( fill );
+                    poly.Append( fill );
                 }
 
-                if( offset >= ptCount )
-                    break;
+                poly.Simplify( SHAPE_POLY_SET::POLYGON_MODE::PM_FAST );
+                aTile.Clip( poly );
 
-                VECTOR2I ptAfter  = pts[ next_index ];
-                VECTOR2I vAfter = ( ptAfter - pt );
+                if( !m_drcEngine->IsCancelled() )
+                    testSlivers( poly, aLayer, &aTile );
 
-                while( std::abs( vAfter.x ) < min_len && std::abs( vAfter.y ) < min_len
-                        && forward_offset < ptCount )
-                {
-                    next_index = ( kk + forward_offset++ ) % ptCount;
-                    ptAfter  = pts[ next_index ];
-                    vAfter = ( ptAfter - pt );
-                }
+                done.fetch_add( 1 );
+                return 1;
+            };
 
-                if( offset >= ptCount )
-                    break;
+    thread_pool& tp = GetKiCadThreadPool();
+    std::vector<std::future<size_t>> returns;
+    size_t                           total = zoneLayerCount;
 
-                // Negative dot product means that the angle is > 90°
-                if( vPrior.Dot( vAfter ) <= 0 )
-                    continue;
+    if( tiled )
+    {
+        total = tiles.size() * layerCount;
+        returns.reserve( total );
 
-                if( !isLocallyInside( prior_index, next_index ) )
-                    continue;
+        for( PCB_LAYER_ID layer : copperLayers )
+        {
+            for( const DRC_TILE& tile : tiles )
+                returns.emplace_back( tp.submit( test_tile, layer, std::cref( tile ) ) );
+        }
+    }
+    else
+    {
+        returns.reserve( copperLayers.size() );
 
-                VECTOR2I vIncluded = ptAfter - ptPrior;
-                double arm1 = vPrior.SquaredEuclideanNorm();
-                double arm2 = vAfter.SquaredEuclideanNorm();
-                double opp  = vIncluded.SquaredEuclideanNorm();
+        for( size_t ii = 0; ii < copperLayers.size(); ++ii )
+            returns.emplace_back( tp.submit( test_layer, ii ) );
+    }
 
-                double cos_ang = std::abs( ( opp - arm1 - arm2 ) / ( std::sqrt( arm1 ) * std::sqrt( arm2 ) ) );
+    for( const std::future<size_t>& ret : returns )
+    {
+        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
 
-                if( cos_ang > cosangleTol && 2.0 - cos_ang > std::numeric_limits<float>::epsilon() && opp > squared_width )
-                {
-                    std::shared_ptr<DRC_ITEM> drce = DRC_ITEM::Create( DRCE_COPPER_SLIVER );
-                    drce->SetErrorMessage( drce->GetErrorText() + wxS( " " ) + layerDesc( layer ) );
-                    reportViolation( drce, pt, layer );
-                }
-            }
+        while( status != std::future_status::ready )
+        {
+            reportProgress( done, total );
+            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
         }
     }
 
@@ -73,6 +73,8 @@ public:
                     "by mask apertures of other nets" );
     }
 
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
 private:
     void addItemToRTrees( BOARD_ITEM* aItem );
     void buildRTrees();
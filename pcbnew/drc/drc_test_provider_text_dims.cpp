@@ -61,6 +61,8 @@ public:
     {
         return wxT( "Tests text height and thickness" );
     }
+
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
 };
 
 
@@ -54,6 +54,13 @@ public:
     {
         return wxT( "Tests track widths" );
     }
+
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_TRACK_WIDTH };
+    }
 };
 
 
@@ -161,6 +168,9 @@ bool DRC_TEST_PROVIDER_TRACK_WIDTH::Run()
         if( !reportProgress( ii++, m_drcEngine->GetBoard()->Tracks().size(), progressDelta ) )
             break;
 
+        if( !m_drcEngine->IsInScope( item ) )
+            continue;
+
         if( !checkTrackWidth( item ) )
             break;
     }
@@ -54,6 +54,13 @@ public:
     {
         return wxT( "Tests via diameters" );
     }
+
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::POOL; }
+
+    virtual std::vector<int> GetIncrementalErrorCodes() const override
+    {
+        return { DRCE_VIA_DIAMETER };
+    }
 };
 
 
@@ -146,6 +153,9 @@ bool DRC_TEST_PROVIDER_VIA_DIAMETER::Run()
         if( !reportProgress( ii++, m_drcEngine->GetBoard()->Tracks().size(), progressDelta ) )
             break;
 
+        if( !m_drcEngine->IsInScope( item ) )
+            continue;
+
         if( !checkViaDiameter( item ) )
             break;
     }
@@ -68,6 +68,9 @@ public:
         return wxT( "Checks thermal reliefs for a sufficient number of connecting spokes" );
     }
 
+    // Uses the thread pool
+    virtual CONCURRENCY GetConcurrency() const override { return CONCURRENCY::CALLER_THREAD; }
+
 private:
     void testZoneLayer( ZONE* aZone, PCB_LAYER_ID aLayer );
 };
@@ -153,7 +156,7 @@ void DRC_TEST_PROVIDER_ZONE_CONNECTIONS::testZoneLayer( ZONE* aZone, PCB_LAYER_I
             {
                 std::vector<SHAPE_LINE_CHAIN::INTERSECTION> intersections;
 
-                zoneFill->Outline( jj ).Intersect( padOutline, intersections, true, &padBBox );
+                zoneFill->COutline( jj ).Intersect( padOutline, intersections, true, &padBBox );
 
                 // If we connect to an island that only connects to a single item then we *are*
                 // that item.  Thermal spokes to this (otherwise isolated) island don't provide
@@ -0,0 +1,123 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_TILES_H
+#define DRC_TILES_H
+
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+#include <math/box2.h>
+
+
+/**
+ * A square of a grid which splits the copper of a layer, for the tests which analyse merged
+ * copper polygons (slivers, connection widths).  Running on a tile bounds the size of the
+ * polygons, and lets tiles run in parallel.
+ *
+ * Copper is clipped to the tile's clip box, which extends past its core by the overlap.  The
+ * clipping creates edges and corners which aren't on the board; they are at least the overlap
+ * away from the core, and only violations located in the core are reported.  Every point
+ * belongs to the core of exactly one tile, so a violation found by two overlapping tiles is
+ * reported once.
+ */
+struct DRC_TILE
+{
+    BOX2I m_core;
+    BOX2I m_clip;
+
+    /**
+     * @return true if \a aPoint is in the core of this tile.  Cores are half-open, so that
+     *         points on the border between two tiles belong to one of them only.
+     */
+    bool Owns( const VECTOR2I& aPoint ) const
+    {
+        return aPoint.x >= m_core.GetLeft() && aPoint.x < m_core.GetRight()
+               && aPoint.y >= m_core.GetTop() && aPoint.y < m_core.GetBottom();
+    }
+
+    /**
+     * Intersect \a aPoly with the clip box of this tile.
+     */
+    void Clip( SHAPE_POLY_SET& aPoly ) const
+    {
+        SHAPE_POLY_SET clip;
+
+        clip.NewOutline();
+        clip.Append( m_clip.GetLeft(), m_clip.GetTop() );
+        clip.Append( m_clip.GetRight(), m_clip.GetTop() );
+        clip.Append( m_clip.GetRight(), m_clip.GetBottom() );
+        clip.Append( m_clip.GetLeft(), m_clip.GetBottom() );
+
+        aPoly.BooleanIntersection( clip, SHAPE_POLY_SET::PM_FAST );
+    }
+};
+
+
+/**
+ * Split \a aArea into square tiles of \a aTileSize, each one clipping \a aOverlap beyond its
+ * core.
+ *
+ * @return the tiles, or a single tile covering all of \a aArea when it fits in one.  Callers
+ *         can skip clipping and ownership tests in that case.
+ */
+inline std::vector<DRC_TILE> BuildDRCTiles( const BOX2I& aArea, int aTileSize, int aOverlap )
+{
+    BOX2I                 area = aArea;
+    std::vector<DRC_TILE> tiles;
+
+    area.Normalize();
+
+    if( aTileSize <= 0 || ( area.GetWidth() < aTileSize && area.GetHeight() < aTileSize ) )
+    {
+        BOX2I all = area;
+        all.Inflate( aOverlap );
+        tiles.push_back( { all, all } );
+        return tiles;
+    }
+
+    // Item outlines may stray a little out of their bounding boxes (e.g. arcs approximated
+    // outside), so cover the overlap around the area too
+    area.Inflate( aOverlap );
+
+    int cols = area.GetWidth() / aTileSize + 1;
+    int rows = area.GetHeight() / aTileSize + 1;
+
+    tiles.reserve( (size_t) cols * rows );
+
+    for( int row = 0; row < rows; ++row )
+    {
+        for( int col = 0; col < cols; ++col )
+        {
+            DRC_TILE tile;
+
+            tile.m_core = BOX2I( VECTOR2I( area.GetLeft() + col * aTileSize,
+                                           area.GetTop() + row * aTileSize ),
+                                 VECTOR2I( aTileSize, aTileSize ) );
+            tile.m_clip = tile.m_core;
+            tile.m_clip.Inflate( aOverlap );
+
+            tiles.push_back( tile );
+        }
+    }
+
+    return tiles;
+}
+
+#endif // DRC_TILES_H
@@ -0,0 +1,59 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DRC_TIMINGS_H
+#define DRC_TIMINGS_H
+
+#include <cstdint>
+#include <vector>
+
+#include <wx/string.h>
+
+
+/**
+ * Where DRC spent its time, as collected by DRC_ENGINE::SetCollectTimings().
+ *
+ * Providers run concurrently, so their times add up to more than the duration of the run.
+ * Rule times only cover the evaluation of their conditions (and assertions); the time spent
+ * testing the constraints they resolve to is counted in the providers.
+ */
+struct DRC_TIMINGS
+{
+    struct PROVIDER
+    {
+        wxString m_name;
+        double   m_milliseconds = 0.0;
+        int      m_runs = 0;
+    };
+
+    struct RULE
+    {
+        wxString m_name;
+        double   m_milliseconds = 0.0;
+        int64_t  m_evaluations = 0;     ///< condition evaluations
+        int64_t  m_cachedResults = 0;   ///< condition results reused for similar items
+    };
+
+    bool empty() const { return m_providers.empty() && m_rules.empty(); }
+
+    std::vector<PROVIDER> m_providers;  ///< in run order
+    std::vector<RULE>     m_rules;      ///< most expensive first
+};
+
+#endif // DRC_TIMINGS_H
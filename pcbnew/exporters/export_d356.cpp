@@ -42,6 +42,7 @@
 #include <pad.h>
 #include <pcb_track.h>
 #include <vector>
+#include <unordered_map>
 #include <cctype>
 #include <math/util.h>      // for KiROUND
 #include <export_d356.h>
@@ -106,6 +107,7 @@ static void build_pad_testpoints( BOARD *aPcb, std::vector <D356_RECORD>& aRecor
             // It could be a mask only pad, we only handle pads with copper here
             if( rk.access != -1 )
             {
+                rk.netcode = pad->GetNetCode();
                 rk.netname = pad->GetNetname();
                 rk.pin = pad->GetNumber();
                 rk.refdes = footprint->GetReference();
@@ -186,9 +188,15 @@ static void build_via_testpoints( BOARD *aPcb, std::vector <D356_RECORD>& aRecor
             rk.smd = false;
             rk.hole = true;
             if( net )
+            {
+                rk.netcode = net->GetNetCode();
                 rk.netname = net->GetNetname();
+            }
             else
+            {
+                rk.netcode = 0;
                 rk.netname = wxEmptyString;
+            }
             rk.refdes = wxT("VIA");
             rk.pin = wxT("");
             rk.midpoint = true; // Vias are always midpoints
@@ -214,7 +222,7 @@ static void build_via_testpoints( BOARD *aPcb, std::vector <D356_RECORD>& aRecor
 
 /* Add a new netname to the d356 canonicalized list */
 static const wxString intern_new_d356_netname( const wxString &aNetname,
-        std::map<wxString, wxString> &aMap, std::set<wxString> &aSet )
+                                               std::set<wxString> &aSet )
 {
     wxString canon;
 
@@ -259,7 +267,6 @@ static const wxString intern_new_d356_netname( const wxString &aNetname,
     }
 
     // Register it
-    aMap[aNetname] = canon;
     aSet.insert( canon );
     return canon;
 }
@@ -267,9 +274,9 @@ static const wxString intern_new_d356_netname( const wxString &aNetname,
 /* Write all the accumuled data to the file in D356 format */
 void IPC356D_WRITER::write_D356_records( std::vector <D356_RECORD> &aRecords, FILE* aFile )
 {
-    // Sanified and shorted network names and set of short names
-    std::map<wxString, wxString> d356_net_map;
-    std::set<wxString> d356_net_set;
+    // Sanified and shorted network names, by net code, and set of short names
+    std::unordered_map<int, wxString> d356_net_map;
+    std::set<wxString>                d356_net_set;
 
     for( unsigned i = 0; i < aRecords.size(); i++ )
     {
@@ -282,10 +289,16 @@ void IPC356D_WRITER::write_D356_records( std::vector <D356_RECORD> &aRecords, FI
 
         if( !rk.netname.empty() )
         {
-            d356_net = d356_net_map[rk.netname];
+            auto it = d356_net_map.find( rk.netcode );
+
+            if( it == d356_net_map.end() )
+            {
+                it = d356_net_map.emplace( rk.netcode,
+                                           intern_new_d356_netname( rk.netname, d356_net_set ) )
+                             .first;
+            }
 
-            if( d356_net.empty() )
-                d356_net = intern_new_d356_netname( rk.netname, d356_net_map, d356_net_set );
+            d356_net = it->second;
         }
 
         // Choose the best record type
@@ -30,6 +30,7 @@ struct D356_RECORD
 {
     bool       smd;
     bool       hole;
+    int        netcode;     // 0 for items without net
     wxString   netname;
     wxString   refdes;
     wxString   pin;
@@ -27,10 +27,14 @@
 #include <pcb_track.h>
 #include <locale_io.h>
 #include <macros.h>
+#include <hash.h>
 #include <hash_eda.h>
 
 #include <export_gencad_writer.h>
 
+#include <algorithm>
+#include <unordered_map>
+
 
 // layer names for Gencad export
 static std::string GenCADLayerName( int aCuCount, PCB_LAYER_ID aId )
@@ -275,12 +279,37 @@ static bool ViaSort( const PCB_VIA* aPadref, const PCB_VIA* aPadcmp )
         return aPadref->GetDrillValue() < aPadcmp->GetDrillValue();
 
     if( aPadref->GetLayerSet() != aPadcmp->GetLayerSet() )
-        return aPadref->GetLayerSet().FmtBin().compare( aPadcmp->GetLayerSet().FmtBin() ) < 0;
+    {
+        // Same order as comparing the LSET::FmtBin() strings, highest layers first
+        const LSET& refSet = aPadref->GetLayerSet();
+        const LSET& cmpSet = aPadcmp->GetLayerSet();
+
+        for( int layer = PCB_LAYER_ID_COUNT - 1; layer >= 0; --layer )
+        {
+            if( refSet[layer] != cmpSet[layer] )
+                return cmpSet[layer];
+        }
+    }
 
     return false;
 }
 
 
+/// Hash the fields compared by PAD::Compare(), so that pads it finds equal get the same hash
+static size_t hashPadstack( const PAD* aPad )
+{
+    // The rounded corner and chamfer scales are not hashed: PAD::Compare() rounds their
+    // difference to an int, so it doesn't tell them apart
+    return hash_val( aPad->GetShape(), aPad->GetAttribute(), aPad->GetDrillShape(),
+                     aPad->GetDrillSize().x, aPad->GetDrillSize().y,
+                     aPad->GetSize().x, aPad->GetSize().y,
+                     aPad->GetOffset().x, aPad->GetOffset().y,
+                     aPad->GetDelta().x, aPad->GetDelta().y,
+                     aPad->GetChamferPositions(), aPad->GetPrimitives().size(),
+                     static_cast<const BASE_SET&>( aPad->GetLayerSet() ) );
+}
+
+
 void GENCAD_EXPORTER::CreateArtworksSection( )
 {
     // The ARTWORKS section is empty but (officially) mandatory
@@ -306,9 +335,37 @@ void GENCAD_EXPORTER::CreatePadsShapesSection()
 
     fputs( "$PADS\n", m_file );
 
-    // Enumerate and sort the pads
+    // Enumerate the distinct pads, looking them up by their hash so that the pads of large
+    // boards are not all sorted with PAD::Compare(), and sort them
+    std::unordered_map<size_t, std::vector<PAD*>> padsByHash;
+    std::vector<std::pair<PAD*, PAD*>>            padstackOf;    // Pad and its distinct pad
+    std::vector<PAD*>                             pads;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            std::vector<PAD*>& candidates = padsByHash[hashPadstack( pad )];
+
+            auto it = std::find_if( candidates.begin(), candidates.end(),
+                                    [&]( const PAD* aCandidate )
+                                    {
+                                        return PAD::Compare( aCandidate, pad ) == 0;
+                                    } );
+
+            if( it == candidates.end() )
+            {
+                candidates.push_back( pad );
+                pads.push_back( pad );
+                padstackOf.emplace_back( pad, pad );
+            }
+            else
+            {
+                padstackOf.emplace_back( pad, *it );
+            }
+        }
+    }
 
-    std::vector<PAD*> pads = m_board->GetPads();
     std::sort( pads.begin(), pads.end(), []( const PAD* a, const PAD* b )
                                          {
                                              return PAD::Compare( a, b ) < 0;
@@ -341,23 +398,15 @@ void GENCAD_EXPORTER::CreatePadsShapesSection()
     }
 
     // Emit component pads
-    PAD* old_pad = nullptr;
-    int  pad_name_number = 0;
+    // @warning: This code is not 100% correct.  The #PAD::Compare function does not test
+    //           custom pad primitives so there may be duplicate custom pads in the export.
+    int pad_name_number = 0;
 
     for( unsigned i = 0; i<pads.size(); ++i )
     {
         PAD* pad = pads[i];
         const VECTOR2I& off = pad->GetOffset();
 
-        pad->SetSubRatsnest( pad_name_number );
-
-        // @warning: This code is not 100% correct.  The #PAD::Compare function does not test
-        //           custom pad primitives so there may be duplicate custom pads in the export.
-        if( old_pad && 0 == PAD::Compare( old_pad, pad ) )
-            continue;
-
-        old_pad = pad;
-
         pad_name_number++;
         pad->SetSubRatsnest( pad_name_number );
 
@@ -574,6 +623,9 @@ void GENCAD_EXPORTER::CreatePadsShapesSection()
 
     fputs( "\n$ENDPADS\n\n", m_file );
 
+    for( const auto& [pad, padstack] : padstackOf )
+        pad->SetSubRatsnest( padstack->GetSubRatsnest() );
+
     // Now emit the padstacks definitions, using the combined layer masks
     fputs( "$PADSTACKS\n", m_file );
 
@@ -866,6 +918,18 @@ void GENCAD_EXPORTER::CreateSignalsSection()
 
     fputs( "$SIGNALS\n", m_file );
 
+    // Gather the pads of each net in one pass, in the order of the footprints
+    std::unordered_map<int, std::vector<PAD*>> netPads;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->GetNetCode() > 0 )
+                netPads[pad->GetNetCode()].push_back( pad );
+        }
+    }
+
     for( unsigned ii = 0; ii < m_board->GetNetCount(); ii++ )
     {
         net = m_board->FindNet( ii );
@@ -885,20 +949,14 @@ void GENCAD_EXPORTER::CreateSignalsSection()
             fputs( TO_UTF8( msg ), m_file );
             fputs( "\n", m_file );
 
-            for( FOOTPRINT* footprint : m_board->Footprints() )
+            for( PAD* pad : netPads[net->GetNetCode()] )
             {
-                for( PAD* pad : footprint->Pads() )
-                {
-                    if( pad->GetNetCode() != net->GetNetCode() )
-                        continue;
+                msg.Printf( wxT( "NODE \"%s\" \"%s\"" ),
+                            escapeString( pad->GetParentFootprint()->GetReference() ),
+                            escapeString( pad->GetNumber() ) );
 
-                    msg.Printf( wxT( "NODE \"%s\" \"%s\"" ),
-                                escapeString( footprint->GetReference() ),
-                                escapeString( pad->GetNumber() ) );
-
-                    fputs( TO_UTF8( msg ), m_file );
-                    fputs( "\n", m_file );
-                }
+                fputs( TO_UTF8( msg ), m_file );
+                fputs( "\n", m_file );
             }
         }
     }
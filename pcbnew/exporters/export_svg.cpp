@@ -57,6 +57,7 @@ bool EXPORT_SVG::Plot( BOARD* aBoard, const PCB_PLOT_SVG_OPTIONS& aSvgPlotOption
     plot_opts.SetFormat( PLOT_FORMAT::SVG );
     // coord format: 4 digits in mantissa (units always in mm). This is a good choice.
     plot_opts.SetSvgPrecision( 4 );
+    plot_opts.SetSvgCompact( aSvgPlotOptions.m_compact );
 
     PAGE_INFO savedPageInfo = aBoard->GetPageSettings();
     VECTOR2I  savedAuxOrigin = aBoard->GetDesignSettings().GetAuxOrigin();
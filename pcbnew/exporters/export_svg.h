@@ -30,6 +30,7 @@ struct PCB_PLOT_SVG_OPTIONS
     bool m_blackAndWhite;
     bool m_plotFrame;
     bool m_negative;
+    bool m_compact = false;     ///< Merge paths, reuse pad shapes and use integer coordinates
 
     int m_pageSizeMode;
 
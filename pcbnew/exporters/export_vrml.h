@@ -55,6 +55,19 @@ public:
                                   const wxString& a3D_Subdir,
                                   double aXRef, double aYRef );
 
+    /**
+     * Exports the board and its footprint shapes 3D as a binary glTF file made of meshes only,
+     * without the B-rep pipeline of the STEP exporter, for fast previews
+     * @param aFullFileName is the full filename of the glb file to create
+     * @param aDecimation is the size in mm of the cells used to decimate the 3D shapes,
+     * 0 to keep them as is
+     * @param aBoardOnly = true to export the board without the 3D shapes
+     * @param aXRef = X position of board (in mm)
+     * @param aYRef = Y position of board (in mm)
+     */
+    bool ExportGLB_File( PROJECT* aProject, wxString* aMessages, const wxString& aFullFileName,
+                         double aDecimation, bool aBoardOnly, double aXRef, double aYRef );
+
 private:
     EXPORTER_PCB_VRML* pcb_exporter;
 };
@@ -44,6 +44,7 @@
 #include "plugins/3dapi/ifsg_all.h"
 #include "streamwrapper.h"
 #include "vrml_layer.h"
+#include "glb_mesh_writer.h"
 #include "pcb_edit_frame.h"
 
 #include <convert_basic_shapes_to_polygon.h>
@@ -71,6 +72,15 @@ bool EXPORTER_VRML::ExportVRML_File( PROJECT* aProject, wxString *aMessages,
 }
 
 
+bool EXPORTER_VRML::ExportGLB_File( PROJECT* aProject, wxString* aMessages,
+                                    const wxString& aFullFileName, double aDecimation,
+                                    bool aBoardOnly, double aXRef, double aYRef )
+{
+    return pcb_exporter->ExportGLB_File( aProject, aMessages, aFullFileName, aDecimation,
+                                         aBoardOnly, aXRef, aYRef );
+}
+
+
 EXPORTER_VRML::~EXPORTER_VRML()
 {
     delete pcb_exporter;
@@ -104,6 +114,8 @@ EXPORTER_PCB_VRML::EXPORTER_PCB_VRML( BOARD* aBoard ) :
     m_precision = 6;
     m_WorldScale = 1.0;
     m_Cache3Dmodels = nullptr;
+    m_glbWriter = nullptr;
+    m_glbDecimation = 0.0;
     m_UseInlineModelsInBrdfile = false;
     m_UseRelPathIn3DModelFilename = false;
     m_BoardToVrmlScale = pcbIUScale.MM_PER_IU;
@@ -710,7 +722,8 @@ void EXPORTER_PCB_VRML::writeLayers( const char* aFileName, OSTREAM* aOutputFile
                            GetLayerZ( B_SilkS ), false );
     }
 
-    if( !m_UseInlineModelsInBrdfile )
+    // No file name when the scene is only built to be converted to meshes
+    if( !m_UseInlineModelsInBrdfile && aFileName )
         S3D::WriteVRML( aFileName, true, m_OutputPCB.GetRawPtr(), true, true );
 }
 
@@ -986,15 +999,8 @@ static void compose_quat( double q1[4], double q2[4], double qr[4] )
 }
 
 
-void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream* aOutputFile )
+wxString EXPORTER_PCB_VRML::getFootprintBasePath( FOOTPRINT* aFootprint )
 {
-    // Note: if m_UseInlineModelsInBrdfile is false, the 3D footprint shape is copied to
-    // the vrml board file, and aOutputFile is not used (can be nullptr)
-    // if m_UseInlineModelsInBrdfile is true, the 3D footprint shape is copied to
-    // aOutputFile (with the suitable rotation/translation/scale transform, and the vrml board
-    // file contains only the filename of 3D shapes to add to the full vrml scene
-    wxCHECK( aFootprint, /* void */ );
-
     wxString libraryName = aFootprint->GetFPID().GetLibNickname();
     wxString footprintBasePath = wxEmptyString;
 
@@ -1015,6 +1021,20 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
             footprintBasePath = fpRow->GetFullURI( true );
     }
 
+    return footprintBasePath;
+}
+
+
+void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream* aOutputFile )
+{
+    // Note: if m_UseInlineModelsInBrdfile is false, the 3D footprint shape is copied to
+    // the vrml board file, and aOutputFile is not used (can be nullptr)
+    // if m_UseInlineModelsInBrdfile is true, the 3D footprint shape is copied to
+    // aOutputFile (with the suitable rotation/translation/scale transform, and the vrml board
+    // file contains only the filename of 3D shapes to add to the full vrml scene
+    wxCHECK( aFootprint, /* void */ );
+
+    wxString footprintBasePath = getFootprintBasePath( aFootprint );
 
     // Export pad holes
     for( PAD* pad : aFootprint->Pads() )
@@ -1200,6 +1220,49 @@ void EXPORTER_PCB_VRML::ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream
 
             aOutputFile->precision( old_precision );
         }
+        else if( m_glbWriter )
+        {
+            // Each model is written once, and placed by a node for each footprint using it
+            wxString key = footprintBasePath + wxT( "\n" ) + sM->m_Filename;
+            auto     it = m_glbModels.find( key );
+
+            if( it == m_glbModels.end() )
+            {
+                S3DMODEL* model = m_Cache3Dmodels->GetModel( sM->m_Filename, footprintBasePath );
+                int       index = model ? m_glbWriter->AddModel( *model, m_glbDecimation ) : -1;
+
+                it = m_glbModels.emplace( key, index ).first;
+            }
+
+            // Model transform: translation x rotation x scale, as a column-major matrix
+            double x = rot[0], y = rot[1], z = rot[2];
+            double len = std::sqrt( x * x + y * y + z * z );
+            double c = std::cos( rot[3] ), s = std::sin( rot[3] ), t = 1.0 - c;
+
+            if( len > 0.0 )
+            {
+                x /= len;
+                y /= len;
+                z /= len;
+            }
+            else
+            {
+                c = 1.0;
+                s = t = 0.0;
+            }
+
+            double matrix[16] = {
+                ( t * x * x + c ) * sM->m_Scale.x, ( t * x * y + s * z ) * sM->m_Scale.x,
+                ( t * x * z - s * y ) * sM->m_Scale.x, 0.0,
+                ( t * x * y - s * z ) * sM->m_Scale.y, ( t * y * y + c ) * sM->m_Scale.y,
+                ( t * y * z + s * x ) * sM->m_Scale.y, 0.0,
+                ( t * x * z + s * y ) * sM->m_Scale.z, ( t * y * z - s * x ) * sM->m_Scale.z,
+                ( t * z * z + c ) * sM->m_Scale.z, 0.0,
+                trans.x, trans.y, trans.z, 1.0
+            };
+
+            m_glbWriter->AddNode( it->second, matrix );
+        }
         else
         {
             IFSG_TRANSFORM* modelShape = new IFSG_TRANSFORM( m_OutputPCB.GetRawPtr() );
@@ -1310,6 +1373,106 @@ bool EXPORTER_PCB_VRML::ExportVRML_File( PROJECT* aProject, wxString *aMessages,
     return success;
 }
 
+bool EXPORTER_PCB_VRML::ExportGLB_File( PROJECT* aProject, wxString* aMessages,
+                                        const wxString& aFullFileName, double aDecimation,
+                                        bool aBoardOnly, double aXRef, double aYRef )
+{
+    if( aProject == nullptr )
+    {
+        if( aMessages )
+            *aMessages = _( "No project when exporting the glTF file" );
+
+        return false;
+    }
+
+    // The scene is built in mm, the glTF writer converts it to meters
+    m_UseInlineModelsInBrdfile = false;
+    m_Cache3Dmodels = PROJECT_PCB::Get3DCacheManager( aProject );
+    m_BoardToVrmlScale = pcbIUScale.MM_PER_IU;
+    SetOffset( -aXRef, aYRef );
+
+    GLB_MESH_WRITER writer;
+    bool            success = true;
+
+    m_glbWriter = &writer;
+    m_glbDecimation = aDecimation;
+    m_glbModels.clear();
+
+    try
+    {
+        ComputeLayer3D_Zpos();
+        ExportVrmlBoard();
+        ExportVrmlSolderMask();
+        ExportVrmlViaHoles();
+        ExportStandardLayers();
+
+        if( aBoardOnly )
+        {
+            for( FOOTPRINT* footprint : m_board->Footprints() )
+            {
+                for( PAD* pad : footprint->Pads() )
+                    ExportVrmlPadHole( pad );
+            }
+        }
+        else
+        {
+            // Load the models in parallel before placing them
+            std::vector<std::pair<wxString, wxString>> models;
+
+            for( FOOTPRINT* footprint : m_board->Footprints() )
+            {
+                wxString basePath = getFootprintBasePath( footprint );
+
+                for( const FP_3DMODEL& model : footprint->Models() )
+                {
+                    if( model.m_Show )
+                        models.emplace_back( model.m_Filename, basePath );
+                }
+            }
+
+            m_Cache3Dmodels->PreloadModels( models, []( size_t, S3DMODEL* ) {} );
+
+            for( FOOTPRINT* footprint : m_board->Footprints() )
+                ExportVrmlFootprint( footprint, nullptr );
+        }
+
+        // build the layers, that are the only nodes of the scene
+        writeLayers( nullptr, nullptr );
+
+        S3DMODEL* board = S3D::GetModel( (SCENEGRAPH*) m_OutputPCB.GetRawPtr() );
+
+        if( board )
+        {
+            const double identity[16] = { 1.0, 0.0, 0.0, 0.0,
+                                          0.0, 1.0, 0.0, 0.0,
+                                          0.0, 0.0, 1.0, 0.0,
+                                          0.0, 0.0, 0.0, 1.0 };
+
+            writer.AddNode( writer.AddModel( *board, 0.0 ), identity );
+            S3D::Destroy3DModel( &board );
+        }
+
+        if( !writer.Write( aFullFileName ) )
+        {
+            if( aMessages )
+                *aMessages << wxString::Format( _( "Cannot write '%s'." ), aFullFileName );
+
+            success = false;
+        }
+    }
+    catch( const std::exception& e )
+    {
+        if( aMessages )
+            *aMessages << _( "glTF Export Failed:\n" ) << From_UTF8( e.what() );
+
+        success = false;
+    }
+
+    m_glbWriter = nullptr;
+    return success;
+}
+
+
 bool PCB_EDIT_FRAME::ExportVRML_File( const wxString& aFullFileName, double aMMtoWRMLunit,
                                       bool aExport3DFiles, bool aUseRelativePaths,
                                       const wxString& a3D_Subdir,
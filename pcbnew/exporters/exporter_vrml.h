@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <map>
+
 #include <dialogs/dialog_color_picker.h>
 #include <export_vrml.h>
 
@@ -28,6 +30,7 @@
 #define  PLATE_OFFSET 0.005
 
 class PROJECT;
+class GLB_MESH_WRITER;
 
 enum VRML_COLOR_INDEX
 {
@@ -128,6 +131,25 @@ public:
                           const wxString& a3D_Subdir,
                           double aXRef, double aYRef );
 
+    /**
+     * Export a binary glTF file of the board meshes, for fast previews.
+     *
+     * The board layers are the ones built for the VRML export and the footprint models are the
+     * meshes of the 3D cache, each one written once and decimated, so no B-rep is built.
+     *
+     * @param aProject is the current project (cannot be null)
+     * @param aMessages will contain error message(s)
+     * @param aFullFileName the full filename of the file to create
+     * @param aDecimation the size of the cells used to decimate the footprint models, in mm;
+     *                    0 to keep the models as is.
+     * @param aBoardOnly true to export only the board, without its footprint models
+     * @param aXRef X value of PCB (0,0) reference point.
+     * @param aYRef Y value of PCB (0,0) reference point.
+     * @return true if Ok.
+     */
+    bool ExportGLB_File( PROJECT* aProject, wxString* aMessages, const wxString& aFullFileName,
+                         double aDecimation, bool aBoardOnly, double aXRef, double aYRef );
+
 private:
     VRML_COLOR& GetColor( VRML_COLOR_INDEX aIndex )
     {
@@ -163,6 +185,9 @@ private:
 
     void ExportVrmlFootprint( FOOTPRINT* aFootprint, std::ostream* aOutputFile );
 
+    // Return the path of the library of a footprint, to search its 3D models
+    wxString getFootprintBasePath( FOOTPRINT* aFootprint );
+
     // Build and exports the board outlines (board body)
     void ExportVrmlBoard();
 
@@ -228,6 +253,12 @@ private:
     std::list<SGNODE*> m_components;
     S3D_CACHE*         m_Cache3Dmodels;
 
+    // When exporting a glTF file, the footprint models are added to this writer instead of the
+    // VRML scene, each one once, its index in the writer being kept in m_glbModels
+    GLB_MESH_WRITER*        m_glbWriter;
+    std::map<wxString, int> m_glbModels;
+    double                  m_glbDecimation;
+
     /* true to use VRML inline{} syntax for footprint 3D models, like:
      * Inline { url "F:/tmp/pic_programmer/shapes3D/DIP-18_W7.62mm_Socket.wrl"  }
      * false to merge VRML 3D modules in the .wrl board file
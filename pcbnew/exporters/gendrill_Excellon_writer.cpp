@@ -50,6 +50,7 @@
 #include <wildcards_and_files_ext.h>
 #include <reporter.h>
 #include <gbr_metadata.h>
+#include <core/thread_pool.h>
 
 
 // Oblong holes can be drilled by a "canned slot" command (G85) or a routing command
@@ -77,7 +78,6 @@ bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
                                                  bool aGenMap, REPORTER * aReporter )
 {
     bool        success = true;
-    wxFileName  fn;
     wxString    msg;
 
     std::vector<DRILL_LAYER_PAIR> hole_sets = getUniqueLayerPairs();
@@ -86,65 +86,93 @@ bool EXCELLON_WRITER::CreateDrillandMapFilesSet( const wxString& aPlotDirectory,
     if( !m_merge_PTH_NPTH )
         hole_sets.emplace_back( F_Cu, B_Cu );
 
-    for( std::vector<DRILL_LAYER_PAIR>::const_iterator it = hole_sets.begin();
-         it != hole_sets.end();  ++it )
+    enum class FILE_STATUS
     {
-        DRILL_LAYER_PAIR  pair = *it;
-        // For separate drill files, the last layer pair is the NPTH drill file.
-        bool doing_npth = m_merge_PTH_NPTH ? false : ( it == hole_sets.end() - 1 );
-
-        buildHolesList( pair, doing_npth );
-
-        // The file is created if it has holes, or if it is the non plated drill file to be
-        // sure the NPTH file is up to date in separate files mode.
-        // Also a PTH drill/map file is always created, to be sure at least one plated hole
-        // drill file is created (do not create any PTH drill file can be seen as not working
-        // drill generator).
-        if( getHolesCount() > 0 || doing_npth || pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-        {
-            fn = getDrillFileName( pair, doing_npth, m_merge_PTH_NPTH );
-            fn.SetPath( aPlotDirectory );
+        SKIPPED,
+        CREATED,
+        FAILED
+    };
+
+    std::vector<wxString>    fullFilenames( hole_sets.size() );
+    std::vector<FILE_STATUS> statuses( hole_sets.size(), FILE_STATUS::SKIPPED );
+
+    // The drill files are independent: each one is written by its own copy of the writer, as
+    // the hole and tool lists are built for one layer pair at a time.
+    if( aGenDrill )
+    {
+        // Keep the C locale for all the writing threads
+        LOCALE_IO toggle;
+
+        ParallelFor( hole_sets.size(),
+                     [&]( size_t aIndex )
+                     {
+                         EXCELLON_WRITER  writer( *this );
+                         DRILL_LAYER_PAIR pair = hole_sets[aIndex];
+
+                         // For separate drill files, the last layer pair is the NPTH drill file.
+                         bool doing_npth = m_merge_PTH_NPTH ? false
+                                                            : ( aIndex == hole_sets.size() - 1 );
+
+                         writer.buildHolesList( pair, doing_npth );
+
+                         // The file is created if it has holes, or if it is the non plated drill
+                         // file to be sure the NPTH file is up to date in separate files mode.
+                         // Also a PTH drill/map file is always created, to be sure at least one
+                         // plated hole drill file is created (do not create any PTH drill file
+                         // can be seen as not working drill generator).
+                         if( writer.getHolesCount() == 0 && !doing_npth
+                                 && pair != DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                         {
+                             return;
+                         }
+
+                         wxFileName drillFn = writer.getDrillFileName( pair, doing_npth,
+                                                                       m_merge_PTH_NPTH );
+                         drillFn.SetPath( aPlotDirectory );
+                         fullFilenames[aIndex] = drillFn.GetFullPath();
+
+                         FILE* file = wxFopen( fullFilenames[aIndex], wxT( "w" ) );
+
+                         if( file == nullptr )
+                         {
+                             statuses[aIndex] = FILE_STATUS::FAILED;
+                             return;
+                         }
+
+                         TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
+
+                         // Only external layer pair can have non plated hole
+                         // internal layers have only plated via holes
+                         if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+                         {
+                             if( m_merge_PTH_NPTH )
+                                 file_type = TYPE_FILE::MIXED_FILE;
+                             else if( doing_npth )
+                                 file_type = TYPE_FILE::NPTH_FILE;
+                         }
+
+                         writer.createDrillFile( file, pair, file_type );
+                         statuses[aIndex] = FILE_STATUS::CREATED;
+                     } );
+    }
 
-            if( aGenDrill )
+    for( size_t ii = 0; ii < hole_sets.size(); ++ii )
+    {
+        if( statuses[ii] == FILE_STATUS::FAILED )
+        {
+            if( aReporter )
             {
-                wxString fullFilename = fn.GetFullPath();
-
-                FILE* file = wxFopen( fullFilename, wxT( "w" ) );
-
-                if( file == nullptr )
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Failed to create file '%s'." ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ERROR );
-                        success = false;
-                    }
-
-                    break;
-                }
-                else
-                {
-                    if( aReporter )
-                    {
-                        msg.Printf( _( "Created file '%s'" ), fullFilename );
-                        aReporter->Report( msg, RPT_SEVERITY_ACTION );
-                    }
-                }
-
-                TYPE_FILE file_type = TYPE_FILE::PTH_FILE;
-
-                // Only external layer pair can have non plated hole
-                // internal layers have only plated via holes
-                if( pair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-                {
-                    if( m_merge_PTH_NPTH )
-                        file_type = TYPE_FILE::MIXED_FILE;
-                    else if( doing_npth )
-                        file_type = TYPE_FILE::NPTH_FILE;
-                }
-
-                createDrillFile( file, pair, file_type );
+                msg.Printf( _( "Failed to create file '%s'." ), fullFilenames[ii] );
+                aReporter->Report( msg, RPT_SEVERITY_ERROR );
+                success = false;
             }
+
+            break;
+        }
+        else if( statuses[ii] == FILE_STATUS::CREATED && aReporter )
+        {
+            msg.Printf( _( "Created file '%s'" ), fullFilenames[ii] );
+            aReporter->Report( msg, RPT_SEVERITY_ACTION );
         }
     }
 
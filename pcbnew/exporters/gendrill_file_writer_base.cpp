@@ -31,88 +31,186 @@
 #include <reporter.h>
 
 #include <gendrill_file_writer_base.h>
+#include <core/thread_pool.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <unordered_map>
 
-/* Helper function for sorting hole list.
- * Compare function used for sorting holes type type:
- * plated then not plated
- * then by increasing diameter value
- * then by attribute type (vias, pad, mechanical)
- * then by X then Y position
+
+/* Helper function to order the holes of a tool along a short drill route.
+ * Holes are sorted by their index on a Hilbert curve covering their bounding box, which keeps
+ * consecutive holes close to each other, then by X and Y position to keep the file
+ * reproducible.
  */
-static bool cmpHoleSorting( const HOLE_INFO& a, const HOLE_INFO& b )
+static void sortHolesByRoute( std::vector<HOLE_INFO>& aHoles )
 {
-    if( a.m_Hole_NotPlated != b.m_Hole_NotPlated )
-        return b.m_Hole_NotPlated;
+    if( aHoles.size() < 2 )
+        return;
+
+    BOX2I bbox( aHoles[0].m_Hole_Pos, VECTOR2I( 0, 0 ) );
+
+    for( const HOLE_INFO& hole : aHoles )
+        bbox.Merge( hole.m_Hole_Pos );
+
+    const uint32_t gridSize = 1 << 16;
+    double         scale = ( gridSize - 1 ) / std::max( { (double) bbox.GetWidth(),
+                                                          (double) bbox.GetHeight(), 1.0 } );
+
+    auto hilbertIndex =
+            [&]( const VECTOR2I& aPos ) -> uint64_t
+            {
+                uint32_t x = KiROUND( ( aPos.x - bbox.GetX() ) * scale );
+                uint32_t y = KiROUND( ( aPos.y - bbox.GetY() ) * scale );
+                uint64_t d = 0;
+
+                for( uint32_t s = gridSize / 2; s > 0; s /= 2 )
+                {
+                    uint32_t rx = ( x & s ) ? 1 : 0;
+                    uint32_t ry = ( y & s ) ? 1 : 0;
+
+                    d += (uint64_t) s * s * ( ( 3 * rx ) ^ ry );
+
+                    if( ry == 0 )
+                    {
+                        if( rx == 1 )
+                        {
+                            x = gridSize - 1 - x;
+                            y = gridSize - 1 - y;
+                        }
 
-    if( a.m_Hole_Diameter != b.m_Hole_Diameter )
-        return a.m_Hole_Diameter < b.m_Hole_Diameter;
+                        std::swap( x, y );
+                    }
+                }
+
+                return d;
+            };
+
+    std::vector<std::pair<uint64_t, size_t>> keys( aHoles.size() );
+
+    for( size_t ii = 0; ii < aHoles.size(); ii++ )
+        keys[ii] = { hilbertIndex( aHoles[ii].m_Hole_Pos ), ii };
+
+    std::sort( keys.begin(), keys.end(),
+               [&]( const std::pair<uint64_t, size_t>& a, const std::pair<uint64_t, size_t>& b )
+               {
+                   if( a.first != b.first )
+                       return a.first < b.first;
 
-    // At this point (same diameter, same plated type), group by attribute
-    // type (via, pad, mechanical, although currently only not plated pads are mechanical)
-    if( a.m_HoleAttribute != b.m_HoleAttribute )
-        return a.m_HoleAttribute < b.m_HoleAttribute;
+                   const VECTOR2I& posA = aHoles[a.second].m_Hole_Pos;
+                   const VECTOR2I& posB = aHoles[b.second].m_Hole_Pos;
 
-    // At this point (same diameter, same type), sort by X then Y position.
-    // This is optimal for drilling and make the file reproducible as long as holes
-    // have not changed, even if the data order has changed.
-    if( a.m_Hole_Pos.x != b.m_Hole_Pos.x )
-        return a.m_Hole_Pos.x < b.m_Hole_Pos.x;
+                   if( posA.x != posB.x )
+                       return posA.x < posB.x;
 
-    return a.m_Hole_Pos.y < b.m_Hole_Pos.y;
+                   return posA.y < posB.y;
+               } );
+
+    std::vector<HOLE_INFO> sorted;
+    sorted.reserve( aHoles.size() );
+
+    for( const std::pair<uint64_t, size_t>& key : keys )
+        sorted.push_back( aHoles[key.second] );
+
+    aHoles.swap( sorted );
 }
 
 
-void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
-                                           bool aGenerateNPTH_list )
+bool GENDRILL_WRITER_BASE::buildHole( BOARD_ITEM* aItem, DRILL_LAYER_PAIR aLayerPair,
+                                      bool aGenerateNPTH_list, HOLE_INFO& aHole ) const
 {
-    HOLE_INFO new_hole;
+    if( aItem->Type() == PCB_VIA_T )
+    {
+        if( aGenerateNPTH_list )    // vias are always plated !
+            return false;
 
-    m_holeListBuffer.clear();
-    m_toolListBuffer.clear();
+        PCB_VIA* via = static_cast<PCB_VIA*>( aItem );
+        int      hole_sz = via->GetDrillValue();
 
-    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
+        if( hole_sz == 0 )   // Should not occur.
+            return false;
 
-    // build hole list for vias
-    if( ! aGenerateNPTH_list )  // vias are always plated !
-    {
-        for( auto track : m_pcb->Tracks() )
-        {
-            if( track->Type() != PCB_VIA_T )
-                continue;
+        aHole.m_ItemParent = via;
 
-            PCB_VIA* via = static_cast<PCB_VIA*>( track );
-            int      hole_sz = via->GetDrillValue();
+        if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
+            aHole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_THROUGH;
+        else
+            aHole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_BURIED;
 
-            if( hole_sz == 0 )   // Should not occur.
-                continue;
+        aHole.m_Tool_Reference = -1;         // Flag value for Not initialized
+        aHole.m_Hole_Orient    = ANGLE_0;
+        aHole.m_Hole_Diameter  = hole_sz;
+        aHole.m_Hole_NotPlated = false;
+        aHole.m_Hole_Size.x = aHole.m_Hole_Size.y = aHole.m_Hole_Diameter;
 
-            new_hole.m_ItemParent = via;
+        aHole.m_Hole_Shape = 0;              // hole shape: round
+        aHole.m_Hole_Pos = via->GetStart();
 
-            if( aLayerPair == DRILL_LAYER_PAIR( F_Cu, B_Cu ) )
-                new_hole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_THROUGH;
-            else
-                new_hole.m_HoleAttribute = HOLE_ATTRIBUTE::HOLE_VIA_BURIED;
+        via->LayerPair( &aHole.m_Hole_Top_Layer, &aHole.m_Hole_Bottom_Layer );
+
+        // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
+        // Remember: top layer = 0 and bottom layer = 31 for through hole vias
+        // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
+        return aHole.m_Hole_Top_Layer == aLayerPair.first
+                && aHole.m_Hole_Bottom_Layer == aLayerPair.second;
+    }
+
+    PAD* pad = static_cast<PAD*>( aItem );
+
+    if( !m_merge_PTH_NPTH )
+    {
+        if( !aGenerateNPTH_list && pad->GetAttribute() == PAD_ATTRIB::NPTH )
+            return false;
+
+        if( aGenerateNPTH_list && pad->GetAttribute() != PAD_ATTRIB::NPTH )
+            return false;
+    }
+
+    if( pad->GetDrillSize().x == 0 )
+        return false;
+
+    aHole.m_ItemParent     = pad;
+    aHole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB::NPTH);
+    aHole.m_HoleAttribute  = aHole.m_Hole_NotPlated ? HOLE_ATTRIBUTE::HOLE_MECHANICAL
+                                                    : HOLE_ATTRIBUTE::HOLE_PAD;
+    aHole.m_Tool_Reference = -1;         // Flag is: Not initialized
+    aHole.m_Hole_Orient    = pad->GetOrientation();
+    aHole.m_Hole_Shape     = 0;           // hole shape: round
+    aHole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
+    aHole.m_Hole_Size.x    = aHole.m_Hole_Size.y = aHole.m_Hole_Diameter;
+
+    // Convert oblong holes that are actually circular into drill hits
+    if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE &&
+            pad->GetDrillSizeX() != pad->GetDrillSizeY() )
+    {
+        aHole.m_Hole_Shape = 1; // oval flag set
+    }
 
-            new_hole.m_Tool_Reference = -1;         // Flag value for Not initialized
-            new_hole.m_Hole_Orient    = ANGLE_0;
-            new_hole.m_Hole_Diameter  = hole_sz;
-            new_hole.m_Hole_NotPlated = false;
-            new_hole.m_Hole_Size.x = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
+    aHole.m_Hole_Size         = pad->GetDrillSize();
+    aHole.m_Hole_Pos          = pad->GetPosition();  // hole position
+    aHole.m_Hole_Bottom_Layer = B_Cu;
+    aHole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
+    return true;
+}
 
-            new_hole.m_Hole_Shape = 0;              // hole shape: round
-            new_hole.m_Hole_Pos = via->GetStart();
 
-            via->LayerPair( &new_hole.m_Hole_Top_Layer, &new_hole.m_Hole_Bottom_Layer );
+void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
+                                           bool aGenerateNPTH_list )
+{
+    m_holeListBuffer.clear();
+    m_toolListBuffer.clear();
+
+    wxASSERT( aLayerPair.first < aLayerPair.second );  // fix the caller
 
-            // LayerPair() returns params with m_Hole_Bottom_Layer > m_Hole_Top_Layer
-            // Remember: top layer = 0 and bottom layer = 31 for through hole vias
-            // Any captured via should be from aLayerPair.first to aLayerPair.second exactly.
-            if( new_hole.m_Hole_Top_Layer    != aLayerPair.first ||
-                new_hole.m_Hole_Bottom_Layer != aLayerPair.second )
-                continue;
+    std::vector<BOARD_ITEM*> items;
 
-            m_holeListBuffer.push_back( new_hole );
+    if( ! aGenerateNPTH_list )  // vias are always plated !
+    {
+        for( PCB_TRACK* track : m_pcb->Tracks() )
+        {
+            if( track->Type() == PCB_VIA_T )
+                items.push_back( track );
         }
     }
 
@@ -122,87 +220,110 @@ void GENDRILL_WRITER_BASE::buildHolesList( DRILL_LAYER_PAIR aLayerPair,
         for( FOOTPRINT* footprint : m_pcb->Footprints() )
         {
             for( PAD* pad : footprint->Pads() )
+                items.push_back( pad );
+        }
+    }
+
+    // Build the holes in parallel, by chunks of items kept in order
+    const size_t                        chunkSize = 4096;
+    std::vector<std::vector<HOLE_INFO>> chunks( ( items.size() + chunkSize - 1 ) / chunkSize );
+
+    ParallelFor( chunks.size(),
+                 [&]( size_t aChunk )
+                 {
+                     size_t    end = std::min( items.size(), ( aChunk + 1 ) * chunkSize );
+                     HOLE_INFO hole;
+
+                     for( size_t ii = aChunk * chunkSize; ii < end; ii++ )
+                     {
+                         if( buildHole( items[ii], aLayerPair, aGenerateNPTH_list, hole ) )
+                             chunks[aChunk].push_back( hole );
+                     }
+                 } );
+
+    // Bucket the holes by tool: same diameter and plating (and attribute, if used)
+    std::unordered_map<uint64_t, size_t> toolIndex;
+    std::vector<DRILL_TOOL>              tools;
+    std::vector<std::vector<HOLE_INFO>>  toolHoles;
+
+    for( const std::vector<HOLE_INFO>& chunk : chunks )
+    {
+        for( const HOLE_INFO& hole : chunk )
+        {
+            uint64_t key = ( (uint64_t) (uint32_t) hole.m_Hole_Diameter << 32 )
+                           | ( hole.m_Hole_NotPlated ? 1 << 8 : 0 );
+#if USE_ATTRIB_FOR_HOLES
+            key |= static_cast<uint64_t>( hole.m_HoleAttribute );
+#endif
+            auto it = toolIndex.find( key );
+
+            if( it == toolIndex.end() )
             {
-                if( !m_merge_PTH_NPTH )
-                {
-                    if( !aGenerateNPTH_list && pad->GetAttribute() == PAD_ATTRIB::NPTH )
-                        continue;
+                it = toolIndex.emplace( key, tools.size() ).first;
+                tools.emplace_back( hole.m_Hole_Diameter, hole.m_Hole_NotPlated );
+                tools.back().m_HoleAttribute = hole.m_HoleAttribute;
+                toolHoles.emplace_back();
+            }
 
-                    if( aGenerateNPTH_list && pad->GetAttribute() != PAD_ATTRIB::NPTH )
-                        continue;
-                }
+            DRILL_TOOL& tool = tools[it->second];
 
-                if( pad->GetDrillSize().x == 0 )
-                    continue;
-
-                new_hole.m_ItemParent     = pad;
-                new_hole.m_Hole_NotPlated = (pad->GetAttribute() == PAD_ATTRIB::NPTH);
-                new_hole.m_HoleAttribute  = new_hole.m_Hole_NotPlated
-                                                ? HOLE_ATTRIBUTE::HOLE_MECHANICAL
-                                                : HOLE_ATTRIBUTE::HOLE_PAD;
-                new_hole.m_Tool_Reference = -1;         // Flag is: Not initialized
-                new_hole.m_Hole_Orient    = pad->GetOrientation();
-                new_hole.m_Hole_Shape     = 0;           // hole shape: round
-                new_hole.m_Hole_Diameter  = std::min( pad->GetDrillSize().x, pad->GetDrillSize().y );
-                new_hole.m_Hole_Size.x    = new_hole.m_Hole_Size.y = new_hole.m_Hole_Diameter;
-
-                // Convert oblong holes that are actually circular into drill hits
-                if( pad->GetDrillShape() != PAD_DRILL_SHAPE_CIRCLE &&
-                        pad->GetDrillSizeX() != pad->GetDrillSizeY() )
-                {
-                    new_hole.m_Hole_Shape = 1; // oval flag set
-                }
+            // Holes of different types sharing a tool are listed from the smallest attribute
+            tool.m_HoleAttribute = std::min( tool.m_HoleAttribute, hole.m_HoleAttribute );
+            tool.m_TotalCount++;
 
-                new_hole.m_Hole_Size         = pad->GetDrillSize();
-                new_hole.m_Hole_Pos          = pad->GetPosition();  // hole position
-                new_hole.m_Hole_Bottom_Layer = B_Cu;
-                new_hole.m_Hole_Top_Layer    = F_Cu;    // pad holes are through holes
-                m_holeListBuffer.push_back( new_hole );
-            }
+            if( hole.m_Hole_Shape )
+                tool.m_OvalCount++;
+
+            toolHoles[it->second].push_back( hole );
         }
     }
 
-    // Sort holes per increasing diameter value (and for each dimater, by position)
-    sort( m_holeListBuffer.begin(), m_holeListBuffer.end(), cmpHoleSorting );
+    // Sort tools per plating (plated then not plated), increasing diameter value and attribute
+    std::vector<size_t> toolOrder( tools.size() );
 
-    // build the tool list
-    int last_hole = -1;     // Set to not initialized (this is a value not used
-                            // for m_holeListBuffer[ii].m_Hole_Diameter)
-    bool last_notplated_opt = false;
-    HOLE_ATTRIBUTE last_attribute = HOLE_ATTRIBUTE::HOLE_UNKNOWN;
+    for( size_t ii = 0; ii < toolOrder.size(); ii++ )
+        toolOrder[ii] = ii;
 
-    DRILL_TOOL new_tool( 0, false );
-    unsigned   jj;
+    std::sort( toolOrder.begin(), toolOrder.end(),
+               [&]( size_t a, size_t b )
+               {
+                   const DRILL_TOOL& toolA = tools[a];
+                   const DRILL_TOOL& toolB = tools[b];
 
-    for( unsigned ii = 0; ii < m_holeListBuffer.size(); ii++ )
-    {
-        if( m_holeListBuffer[ii].m_Hole_Diameter != last_hole
-            || m_holeListBuffer[ii].m_Hole_NotPlated != last_notplated_opt
-#if USE_ATTRIB_FOR_HOLES
-            || m_holeListBuffer[ii].m_HoleAttribute != last_attribute
-#endif
-            )
-        {
-            new_tool.m_Diameter = m_holeListBuffer[ii].m_Hole_Diameter;
-            new_tool.m_Hole_NotPlated = m_holeListBuffer[ii].m_Hole_NotPlated;
-            new_tool.m_HoleAttribute = m_holeListBuffer[ii].m_HoleAttribute;
-            m_toolListBuffer.push_back( new_tool );
-            last_hole = new_tool.m_Diameter;
-            last_notplated_opt = new_tool.m_Hole_NotPlated;
-            last_attribute = new_tool.m_HoleAttribute;
-        }
+                   if( toolA.m_Hole_NotPlated != toolB.m_Hole_NotPlated )
+                       return toolB.m_Hole_NotPlated;
 
-        jj = m_toolListBuffer.size();
+                   if( toolA.m_Diameter != toolB.m_Diameter )
+                       return toolA.m_Diameter < toolB.m_Diameter;
 
-        if( jj == 0 )
-            continue;                                        // Should not occurs
+                   return toolA.m_HoleAttribute < toolB.m_HoleAttribute;
+               } );
 
-        m_holeListBuffer[ii].m_Tool_Reference = jj;          // Tool value Initialized (value >= 1)
+    // Order the holes of each tool along a short route, to reduce the drilling time
+    ParallelFor( toolHoles.size(),
+                 [&]( size_t aTool )
+                 {
+                     sortHolesByRoute( toolHoles[aTool] );
+                 } );
 
-        m_toolListBuffer.back().m_TotalCount++;
+    m_holeListBuffer.reserve( std::accumulate( tools.begin(), tools.end(), (size_t) 0,
+                                               []( size_t aSum, const DRILL_TOOL& aTool )
+                                               {
+                                                   return aSum + aTool.m_TotalCount;
+                                               } ) );
 
-        if( m_holeListBuffer[ii].m_Hole_Shape )
-            m_toolListBuffer.back().m_OvalCount++;
+    for( size_t ii : toolOrder )
+    {
+        m_toolListBuffer.push_back( tools[ii] );
+
+        // Tool value Initialized (value >= 1)
+        int toolRef = (int) m_toolListBuffer.size();
+
+        for( HOLE_INFO& hole : toolHoles[ii] )
+        {
+            hole.m_Tool_Reference = toolRef;
+            m_holeListBuffer.push_back( hole );
+        }
     }
 }
 
@@ -286,9 +286,9 @@ protected:
     /**
      * Create the list of holes and tools for a given board.
      *
-     * The list is sorted by increasing drill size.   Only holes included within aLayerPair
-     * are listed.  If aLayerPair identifies with [F_Cu, B_Cu], then pad holes are always
-     * included also.
+     * The list is sorted by increasing drill size, the holes of each tool following a short
+     * drill route.   Only holes included within aLayerPair are listed.  If aLayerPair
+     * identifies with [F_Cu, B_Cu], then pad holes are always included also.
      *
      * @param aLayerPair is an inclusive range of layers.
      * @param aGenerateNPTH_list :
@@ -297,6 +297,14 @@ protected:
      */
     void buildHolesList( DRILL_LAYER_PAIR aLayerPair, bool aGenerateNPTH_list );
 
+    /**
+     * Fill the hole of a via or a pad for buildHolesList().
+     *
+     * @return false if the item has no hole to drill in this list.
+     */
+    bool buildHole( BOARD_ITEM* aItem, DRILL_LAYER_PAIR aLayerPair, bool aGenerateNPTH_list,
+                    HOLE_INFO& aHole ) const;
+
     int  getHolesCount() const { return m_holeListBuffer.size(); }
 
     /**
@@ -0,0 +1,457 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "glb_mesh_writer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include <nlohmann/json.hpp>
+#include <wx/ffile.h>
+
+
+namespace
+{
+
+// glTF constants
+constexpr int GLTF_FLOAT = 5126;
+constexpr int GLTF_UNSIGNED_INT = 5125;
+constexpr int GLTF_ARRAY_BUFFER = 34962;
+constexpr int GLTF_ELEMENT_ARRAY_BUFFER = 34963;
+constexpr int GLTF_TRIANGLES = 4;
+
+constexpr uint32_t GLB_MAGIC = 0x46546C67;        // "glTF"
+constexpr uint32_t GLB_CHUNK_JSON = 0x4E4F534A;   // "JSON"
+constexpr uint32_t GLB_CHUNK_BIN = 0x004E4942;    // "BIN\0"
+
+
+struct MESH_DATA
+{
+    std::vector<SFVEC3F>  m_positions;
+    std::vector<SFVEC3F>  m_normals;
+    std::vector<SFVEC3F>  m_colors;
+    std::vector<uint32_t> m_indices;
+};
+
+
+void copyMesh( const SMESH& aMesh, MESH_DATA& aData )
+{
+    aData.m_positions.assign( aMesh.m_Positions, aMesh.m_Positions + aMesh.m_VertexSize );
+
+    if( aMesh.m_Normals )
+        aData.m_normals.assign( aMesh.m_Normals, aMesh.m_Normals + aMesh.m_VertexSize );
+
+    if( aMesh.m_Color )
+        aData.m_colors.assign( aMesh.m_Color, aMesh.m_Color + aMesh.m_VertexSize );
+
+    aData.m_indices.assign( aMesh.m_FaceIdx, aMesh.m_FaceIdx + aMesh.m_FaceIdxSize );
+}
+
+
+/**
+ * Decimate a mesh by vertex clustering: the vertices in a cell of the grid, with normals
+ * pointing about the same way so sharp edges are kept, are merged into their average.
+ */
+void decimateMesh( const SMESH& aMesh, double aCellSize, MESH_DATA& aData )
+{
+    struct CELL_KEY
+    {
+        int64_t m_x;
+        int64_t m_y;
+        int64_t m_z;
+        int     m_normal;
+
+        bool operator==( const CELL_KEY& aOther ) const
+        {
+            return m_x == aOther.m_x && m_y == aOther.m_y && m_z == aOther.m_z
+                   && m_normal == aOther.m_normal;
+        }
+    };
+
+    struct CELL_KEY_HASH
+    {
+        size_t operator()( const CELL_KEY& aKey ) const
+        {
+            size_t hash = std::hash<int64_t>()( aKey.m_x );
+
+            hash = hash * 31 + std::hash<int64_t>()( aKey.m_y );
+            hash = hash * 31 + std::hash<int64_t>()( aKey.m_z );
+            return hash * 31 + aKey.m_normal;
+        }
+    };
+
+    std::unordered_map<CELL_KEY, uint32_t, CELL_KEY_HASH> cells;
+    std::vector<uint32_t>                                 remap( aMesh.m_VertexSize );
+    std::vector<unsigned int>                             counts;
+
+    auto bin =
+            []( float aValue ) -> int
+            {
+                return (int) std::lround( aValue * 2.0f ) + 2;
+            };
+
+    for( unsigned int ii = 0; ii < aMesh.m_VertexSize; ++ii )
+    {
+        const SFVEC3F& pos = aMesh.m_Positions[ii];
+        CELL_KEY       key = { (int64_t) std::floor( pos.x / aCellSize ),
+                               (int64_t) std::floor( pos.y / aCellSize ),
+                               (int64_t) std::floor( pos.z / aCellSize ), 0 };
+
+        if( aMesh.m_Normals )
+        {
+            const SFVEC3F& n = aMesh.m_Normals[ii];
+            key.m_normal = ( bin( n.x ) * 5 + bin( n.y ) ) * 5 + bin( n.z );
+        }
+
+        auto [it, inserted] = cells.emplace( key, (uint32_t) aData.m_positions.size() );
+
+        if( inserted )
+        {
+            aData.m_positions.emplace_back( 0.0f );
+            counts.push_back( 0 );
+
+            if( aMesh.m_Normals )
+                aData.m_normals.emplace_back( 0.0f );
+
+            if( aMesh.m_Color )
+                aData.m_colors.emplace_back( 0.0f );
+        }
+
+        uint32_t idx = it->second;
+
+        aData.m_positions[idx] += pos;
+        counts[idx]++;
+
+        if( aMesh.m_Normals )
+            aData.m_normals[idx] += aMesh.m_Normals[ii];
+
+        if( aMesh.m_Color )
+            aData.m_colors[idx] += aMesh.m_Color[ii];
+
+        remap[ii] = idx;
+    }
+
+    for( size_t ii = 0; ii < counts.size(); ++ii )
+    {
+        aData.m_positions[ii] /= (float) counts[ii];
+
+        if( aMesh.m_Normals && glm::length( aData.m_normals[ii] ) > 0.0f )
+            aData.m_normals[ii] = glm::normalize( aData.m_normals[ii] );
+
+        if( aMesh.m_Color )
+            aData.m_colors[ii] /= (float) counts[ii];
+    }
+
+    for( unsigned int ii = 0; ii + 2 < aMesh.m_FaceIdxSize; ii += 3 )
+    {
+        uint32_t a = remap[aMesh.m_FaceIdx[ii]];
+        uint32_t b = remap[aMesh.m_FaceIdx[ii + 1]];
+        uint32_t c = remap[aMesh.m_FaceIdx[ii + 2]];
+
+        if( a == b || b == c || a == c )
+            continue;
+
+        aData.m_indices.push_back( a );
+        aData.m_indices.push_back( b );
+        aData.m_indices.push_back( c );
+    }
+}
+
+
+void writeUint32( wxFFile& aFile, uint32_t aValue )
+{
+    unsigned char bytes[4] = { (unsigned char) ( aValue & 0xFF ),
+                               (unsigned char) ( ( aValue >> 8 ) & 0xFF ),
+                               (unsigned char) ( ( aValue >> 16 ) & 0xFF ),
+                               (unsigned char) ( ( aValue >> 24 ) & 0xFF ) };
+
+    aFile.Write( bytes, sizeof( bytes ) );
+}
+
+} // namespace
+
+
+int GLB_MESH_WRITER::addAccessor( const void* aData, size_t aCount, bool aIsIndex,
+                                  bool aIsPosition )
+{
+    ACCESSOR accessor;
+    size_t   size = aCount * ( aIsIndex ? sizeof( uint32_t ) : sizeof( float ) * 3 );
+
+    accessor.m_offset = m_binary.size();
+    accessor.m_count = aCount;
+    accessor.m_isIndex = aIsIndex;
+
+    m_binary.resize( m_binary.size() + size );
+    std::memcpy( m_binary.data() + accessor.m_offset, aData, size );
+
+    if( aIsPosition )
+    {
+        const float* values = static_cast<const float*>( aData );
+
+        accessor.m_min.assign( values, values + 3 );
+        accessor.m_max.assign( values, values + 3 );
+
+        for( size_t ii = 0; ii < aCount * 3; ++ii )
+        {
+            accessor.m_min[ii % 3] = std::min( accessor.m_min[ii % 3], values[ii] );
+            accessor.m_max[ii % 3] = std::max( accessor.m_max[ii % 3], values[ii] );
+        }
+    }
+
+    m_accessors.push_back( std::move( accessor ) );
+    return (int) m_accessors.size() - 1;
+}
+
+
+int GLB_MESH_WRITER::AddModel( const S3DMODEL& aModel, double aCellSize )
+{
+    static_assert( sizeof( SFVEC3F ) == sizeof( float ) * 3, "SFVEC3F must be packed" );
+
+    std::vector<PRIMITIVE> primitives;
+    int                    firstMaterial = (int) m_materials.size();
+
+    m_materials.insert( m_materials.end(), aModel.m_Materials,
+                        aModel.m_Materials + aModel.m_MaterialsSize );
+
+    for( unsigned int ii = 0; ii < aModel.m_MeshesSize; ++ii )
+    {
+        const SMESH& mesh = aModel.m_Meshes[ii];
+        MESH_DATA    data;
+
+        if( !mesh.m_Positions || !mesh.m_FaceIdx || mesh.m_FaceIdxSize < 3 )
+            continue;
+
+        if( aCellSize > 0.0 )
+            decimateMesh( mesh, aCellSize, data );
+        else
+            copyMesh( mesh, data );
+
+        if( data.m_indices.empty() )
+            continue;
+
+        PRIMITIVE primitive;
+
+        primitive.m_position = addAccessor( data.m_positions.data(), data.m_positions.size(),
+                                            false, true );
+        primitive.m_normal = -1;
+        primitive.m_color = -1;
+
+        if( !data.m_normals.empty() )
+        {
+            primitive.m_normal = addAccessor( data.m_normals.data(), data.m_normals.size(),
+                                              false, false );
+        }
+
+        if( !data.m_colors.empty() )
+        {
+            primitive.m_color = addAccessor( data.m_colors.data(), data.m_colors.size(),
+                                             false, false );
+        }
+
+        primitive.m_indices = addAccessor( data.m_indices.data(), data.m_indices.size(),
+                                           true, false );
+
+        if( mesh.m_MaterialIdx < aModel.m_MaterialsSize )
+            primitive.m_material = firstMaterial + (int) mesh.m_MaterialIdx;
+        else
+            primitive.m_material = -1;
+
+        primitives.push_back( primitive );
+    }
+
+    if( primitives.empty() )
+        return -1;
+
+    m_meshes.push_back( std::move( primitives ) );
+    return (int) m_meshes.size() - 1;
+}
+
+
+void GLB_MESH_WRITER::AddNode( int aModel, const double aMatrix[16] )
+{
+    if( aModel < 0 || aModel >= (int) m_meshes.size() )
+        return;
+
+    NODE node;
+
+    node.m_mesh = aModel;
+    std::copy( aMatrix, aMatrix + 16, node.m_matrix );
+    m_nodes.push_back( node );
+}
+
+
+bool GLB_MESH_WRITER::Write( const wxString& aFileName ) const
+{
+    nlohmann::json json;
+
+    json["asset"] = { { "version", "2.0" }, { "generator", "KiCad" } };
+    json["scene"] = 0;
+
+    // The root node converts from mm with Z up to meters with Y up
+    nlohmann::json root = { { "matrix", { 0.001, 0.0, 0.0, 0.0,
+                                          0.0, 0.0, -0.001, 0.0,
+                                          0.0, 0.001, 0.0, 0.0,
+                                          0.0, 0.0, 0.0, 1.0 } } };
+    nlohmann::json nodes = nlohmann::json::array();
+    nlohmann::json children = nlohmann::json::array();
+
+    for( size_t ii = 0; ii < m_nodes.size(); ++ii )
+    {
+        nlohmann::json matrix = nlohmann::json::array();
+
+        for( double value : m_nodes[ii].m_matrix )
+            matrix.push_back( value );
+
+        nodes.push_back( { { "mesh", m_nodes[ii].m_mesh }, { "matrix", matrix } } );
+        children.push_back( ii + 1 );
+    }
+
+    if( !children.empty() )
+        root["children"] = children;
+
+    nodes.insert( nodes.begin(), root );
+    json["nodes"] = nodes;
+    json["scenes"] = { { { "nodes", { 0 } } } };
+
+    nlohmann::json meshes = nlohmann::json::array();
+
+    for( const std::vector<PRIMITIVE>& mesh : m_meshes )
+    {
+        nlohmann::json primitives = nlohmann::json::array();
+
+        for( const PRIMITIVE& primitive : mesh )
+        {
+            nlohmann::json attributes = { { "POSITION", primitive.m_position } };
+
+            if( primitive.m_normal >= 0 )
+                attributes["NORMAL"] = primitive.m_normal;
+
+            if( primitive.m_color >= 0 )
+                attributes["COLOR_0"] = primitive.m_color;
+
+            nlohmann::json entry = { { "attributes", attributes },
+                                     { "indices", primitive.m_indices },
+                                     { "mode", GLTF_TRIANGLES } };
+
+            if( primitive.m_material >= 0 )
+                entry["material"] = primitive.m_material;
+
+            primitives.push_back( entry );
+        }
+
+        meshes.push_back( { { "primitives", primitives } } );
+    }
+
+    if( !meshes.empty() )
+        json["meshes"] = meshes;
+
+    nlohmann::json materials = nlohmann::json::array();
+
+    for( const SMATERIAL& material : m_materials )
+    {
+        float          alpha = 1.0f - std::clamp( material.m_Transparency, 0.0f, 1.0f );
+        nlohmann::json entry;
+
+        entry["pbrMetallicRoughness"] = {
+            { "baseColorFactor",
+              { material.m_Diffuse.r, material.m_Diffuse.g, material.m_Diffuse.b, alpha } },
+            { "metallicFactor", 0.0 },
+            { "roughnessFactor", 1.0 - std::clamp( material.m_Shininess, 0.0f, 1.0f ) }
+        };
+        entry["doubleSided"] = true;
+
+        if( alpha < 1.0f )
+            entry["alphaMode"] = "BLEND";
+
+        materials.push_back( entry );
+    }
+
+    if( !materials.empty() )
+        json["materials"] = materials;
+
+    nlohmann::json bufferViews = nlohmann::json::array();
+    nlohmann::json accessors = nlohmann::json::array();
+
+    for( size_t ii = 0; ii < m_accessors.size(); ++ii )
+    {
+        const ACCESSOR& accessor = m_accessors[ii];
+        size_t          elementSize = accessor.m_isIndex ? sizeof( uint32_t ) : sizeof( float ) * 3;
+
+        bufferViews.push_back( { { "buffer", 0 },
+                                 { "byteOffset", accessor.m_offset },
+                                 { "byteLength", accessor.m_count * elementSize },
+                                 { "target", accessor.m_isIndex ? GLTF_ELEMENT_ARRAY_BUFFER
+                                                                : GLTF_ARRAY_BUFFER } } );
+
+        nlohmann::json entry = { { "bufferView", ii },
+                                 { "componentType", accessor.m_isIndex ? GLTF_UNSIGNED_INT
+                                                                       : GLTF_FLOAT },
+                                 { "count", accessor.m_count },
+                                 { "type", accessor.m_isIndex ? "SCALAR" : "VEC3" } };
+
+        if( !accessor.m_min.empty() )
+        {
+            entry["min"] = accessor.m_min;
+            entry["max"] = accessor.m_max;
+        }
+
+        accessors.push_back( entry );
+    }
+
+    if( !m_binary.empty() )
+    {
+        json["buffers"] = { { { "byteLength", m_binary.size() } } };
+        json["bufferViews"] = bufferViews;
+        json["accessors"] = accessors;
+    }
+
+    // Chunks are padded to 4 bytes, the JSON one with spaces and the binary one with zeros
+    std::string jsonChunk = json.dump();
+    jsonChunk.resize( ( jsonChunk.size() + 3 ) & ~size_t( 3 ), ' ' );
+
+    size_t binSize = ( m_binary.size() + 3 ) & ~size_t( 3 );
+    size_t length = 12 + 8 + jsonChunk.size() + ( m_binary.empty() ? 0 : 8 + binSize );
+
+    wxFFile file( aFileName, wxS( "wb" ) );
+
+    if( !file.IsOpened() )
+        return false;
+
+    writeUint32( file, GLB_MAGIC );
+    writeUint32( file, 2 );
+    writeUint32( file, (uint32_t) length );
+
+    writeUint32( file, (uint32_t) jsonChunk.size() );
+    writeUint32( file, GLB_CHUNK_JSON );
+    file.Write( jsonChunk.data(), jsonChunk.size() );
+
+    if( !m_binary.empty() )
+    {
+        const char padding[3] = { 0, 0, 0 };
+
+        writeUint32( file, (uint32_t) binSize );
+        writeUint32( file, GLB_CHUNK_BIN );
+        file.Write( m_binary.data(), m_binary.size() );
+        file.Write( padding, binSize - m_binary.size() );
+    }
+
+    return !file.Error() && file.Close();
+}
@@ -0,0 +1,91 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <plugins/3dapi/c3dmodel.h>
+#include <wx/string.h>
+
+/**
+ * Write triangle meshes to a binary glTF (.glb) file, without any B-rep processing.
+ *
+ * Each model is stored once and placed by as many nodes as needed.  Coordinates are given in
+ * mm with Z up, as in the VRML exporter, and the file is written in meters with Y up, as glTF
+ * expects.
+ */
+class GLB_MESH_WRITER
+{
+public:
+    /**
+     * Add the meshes of a model.
+     *
+     * @param aModel is the model, its materials giving the colors of the meshes.
+     * @param aCellSize is the size of the cells used to decimate the meshes, in the units of
+     *                  the model.  The vertices in a cell with about the same normal are merged
+     *                  and the triangles left without area dropped.  0 keeps the meshes as is.
+     * @return the index of the model, to give to AddNode(), or -1 if it has no triangles.
+     */
+    int AddModel( const S3DMODEL& aModel, double aCellSize );
+
+    /**
+     * Place a model in the scene.
+     *
+     * @param aModel is the index returned by AddModel().
+     * @param aMatrix is the transform of the model to mm, as a column-major 4x4 matrix.
+     */
+    void AddNode( int aModel, const double aMatrix[16] );
+
+    bool Write( const wxString& aFileName ) const;
+
+private:
+    struct PRIMITIVE
+    {
+        int m_position;
+        int m_normal;     ///< -1 if the mesh has no normals
+        int m_color;      ///< -1 if the mesh has no vertex colors
+        int m_indices;
+        int m_material;
+    };
+
+    struct ACCESSOR
+    {
+        size_t             m_offset;     ///< In the binary chunk
+        size_t             m_count;
+        bool               m_isIndex;
+        std::vector<float> m_min;        ///< Bounds of the positions, empty for other accessors
+        std::vector<float> m_max;
+    };
+
+    struct NODE
+    {
+        int    m_mesh;
+        double m_matrix[16];
+    };
+
+    int addAccessor( const void* aData, size_t aCount, bool aIsIndex, bool aIsPosition );
+
+    std::vector<uint8_t>                m_binary;
+    std::vector<ACCESSOR>               m_accessors;
+    std::vector<SMATERIAL>              m_materials;
+    std::vector<std::vector<PRIMITIVE>> m_meshes;
+    std::vector<NODE>                   m_nodes;
+};
@@ -24,29 +24,43 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <wx/filename.h>
 #include <wx/filefn.h>
+#include <wx/utils.h>
 #include <wx/stdpaths.h>
 #include <wx/wfstream.h>
 #include <wx/zipstrm.h>
 
 #include <decompress.hpp>
 
+#include <boost/version.hpp>
+
+#if BOOST_VERSION >= 106800
+#include <boost/uuid/detail/sha1.hpp>
+#else
+#include <boost/uuid/sha1.hpp>
+#endif
+
 #include <footprint.h>
 #include <pad.h>
 #include <pcb_track.h>
 #include <kiplatform/io.h>
 #include <string_utils.h>
 #include <build_version.h>
+#include <paths.h>
+#include <core/thread_pool.h>
 #include <geometry/shape_segment.h>
 
 #include "step_pcb_model.h"
 #include "streamwrapper.h"
 
+#include <BinXCAFDrivers.hxx>
 #include <IGESCAFControl_Reader.hxx>
 #include <IGESCAFControl_Writer.hxx>
 #include <IGESControl_Controller.hxx>
@@ -188,9 +202,52 @@ MODEL3D_FORMAT_TYPE fileType( const char* aFileName )
 }
 
 
+/// Changed when the model readers or their settings change, to drop the old cache files
+static const char MODEL_CACHE_VERSION[] = "KiCad STEP export model cache 1";
+
+
+/**
+ * @return the file caching the model document read from \a aFileName, named after a hash of the
+ *         contents of the model file, or an empty string if the file can't be read.
+ */
+static wxString modelCacheFileName( const wxString& aFileName )
+{
+    KIPLATFORM::IO::MAPPED_FILE mapped;
+
+    if( !KIPLATFORM::IO::MapFile( aFileName, mapped ) )
+        return wxEmptyString;
+
+    boost::uuids::detail::sha1 hash;
+
+    hash.process_bytes( MODEL_CACHE_VERSION, sizeof( MODEL_CACHE_VERSION ) );
+    hash.process_bytes( mapped.m_data, mapped.m_size );
+
+    KIPLATFORM::IO::UnmapFile( mapped );
+
+    unsigned int digest[5];
+    hash.get_digest( digest );
+
+    wxFileName cacheFile;
+
+    // The 3D viewer model cache directory, cleaned up with it
+    cacheFile.AssignDir( PATHS::GetUserCachePath() );
+    cacheFile.AppendDir( wxT( "3d" ) );
+    cacheFile.SetName( wxString::Format( wxT( "%08x%08x%08x%08x%08x" ), digest[0], digest[1],
+                                         digest[2], digest[3], digest[4] ) );
+    cacheFile.SetExt( wxT( "xbf" ) );
+
+    return cacheFile.GetFullPath();
+}
+
+
 STEP_PCB_MODEL::STEP_PCB_MODEL( const wxString& aPcbName )
 {
     m_app = XCAFApp_Application::GetApplication();
+
+    // The format of the model cache files
+    static std::once_flag defineCacheFormat;
+    std::call_once( defineCacheFormat, [&]() { BinXCAFDrivers::DefineFormat( m_app ); } );
+
     m_app->NewDocument( "MDTV-XCAF", m_doc );
     m_assy = XCAFDoc_DocumentTool::ShapeTool( m_doc->Main() );
     m_assy_label = m_assy->NewShape();
@@ -489,7 +546,7 @@ static bool IsChainCircle( const SHAPE_LINE_CHAIN& aChain )
     // If aChain is a circle it
     // - contains only one arc
     // - this arc has the same start and end point
-    const std::vector<SHAPE_ARC>& arcs = aChain.CArcs();
+    const SHAPE_LINE_CHAIN::ARC_VECTOR& arcs = aChain.CArcs();
 
     if( arcs.size() == 1 )
     {
@@ -514,7 +571,7 @@ bool STEP_PCB_MODEL::MakeShapeAsCylinder( TopoDS_Shape& aShape,
     if( !aChain.IsClosed() )
         return false; // the loop is not closed
 
-    const std::vector<SHAPE_ARC>& arcs = aChain.CArcs();
+    const SHAPE_LINE_CHAIN::ARC_VECTOR& arcs = aChain.CArcs();
     const SHAPE_ARC& arc = arcs[0];
 
     TopoDS_Shape base_shape;
@@ -680,7 +737,7 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
                        -pcbIUScale.IUTomm( aKiCoords.y - aOrigin.y ), aZposition );
     };
 
-    for( const SHAPE_POLY_SET::POLYGON& polygon : simplified.CPolygons() )
+    auto makePrism = [&]( const SHAPE_POLY_SET::POLYGON& polygon, TopoDS_Shape& aPrism ) -> bool
     {
         auto makeWireFromChain = [&]( BRepLib_MakeWire&       aMkWire,
                                       const SHAPE_LINE_CHAIN& aChain ) -> bool
@@ -859,10 +916,17 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
 
         if( mkFace.IsDone() )
         {
-            TopoDS_Shape prism = BRepPrimAPI_MakePrism( mkFace, gp_Vec( 0, 0, aThickness ) );
-            aShapes.push_back( prism );
+            try
+            {
+                aPrism = BRepPrimAPI_MakePrism( mkFace, gp_Vec( 0, 0, aThickness ) );
+            }
+            catch( const Standard_Failure& e )
+            {
+                ReportMessage( wxString::Format( wxT( "MakeShapes: OCC exception: %s\n" ),
+                                                 e.GetMessageString() ) );
+            }
 
-            if( prism.IsNull() )
+            if( aPrism.IsNull() )
             {
                 ReportMessage( wxT( "Failed to create a prismatic shape\n" ) );
                 return false;
@@ -872,9 +936,32 @@ bool STEP_PCB_MODEL::MakeShapes( std::vector<TopoDS_Shape>& aShapes, const SHAPE
         {
             wxASSERT( false );
         }
+
+        return true;
+    };
+
+    // The polygons are independent, so build their prisms in parallel
+    const std::vector<SHAPE_POLY_SET::POLYGON>& polygons = simplified.CPolygons();
+    std::vector<TopoDS_Shape>                   prisms( polygons.size() );
+    std::vector<char>                           built( polygons.size(), false );
+
+    ParallelFor( polygons.size(),
+                 [&]( size_t aIndex )
+                 {
+                     built[aIndex] = makePrism( polygons[aIndex], prisms[aIndex] );
+                 } );
+
+    bool success = true;
+
+    for( size_t ii = 0; ii < polygons.size(); ++ii )
+    {
+        if( !prisms[ii].IsNull() )
+            aShapes.push_back( prisms[ii] );
+
+        success &= built[ii] != 0;
     }
 
-    return true;
+    return success;
 }
 
 
@@ -939,46 +1026,71 @@ bool STEP_PCB_MODEL::CreatePCB( SHAPE_POLY_SET& aOutline, VECTOR2D aOrigin )
 
         auto subtractShapes = [&]( const wxString& aWhat, std::vector<TopoDS_Shape>& aShapesList )
         {
-            // Remove holes for each item (board body or bodies, one can have more than one board)
-            int cnt = 0;
-            for( TopoDS_Shape& shape : aShapesList )
-            {
-                Bnd_Box shapeBbox;
-                BRepBndLib::Add( shape, shapeBbox );
-
-                const TColStd_ListOfInteger& indices = bsbHoles.Compare( shapeBbox );
+            if( aShapesList.empty() )
+                return;
 
-                TopTools_ListOfShape holelist;
+            ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
 
-                for( const Standard_Integer& index : indices )
-                    holelist.Append( m_cutouts[index] );
+            // Find the holes of each item first: Bnd_BoundSortBox::Compare() returns a list it
+            // owns, so it can't be called from several threads
+            std::vector<TopTools_ListOfShape> holelists( aShapesList.size() );
 
-                if( cnt == 0 )
-                    ReportMessage( wxString::Format( _( "Build holes for %s\n" ), aWhat ) );
-
-                cnt++;
-
-                if( cnt % 10 == 0 )
-                    ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), cnt,
-                                                     (int) aShapesList.size(), aWhat ) );
+            for( size_t ii = 0; ii < aShapesList.size(); ++ii )
+            {
+                Bnd_Box shapeBbox;
+                BRepBndLib::Add( aShapesList[ii], shapeBbox );
 
-                if( holelist.IsEmpty() )
-                    continue;
+                for( const Standard_Integer& index : bsbHoles.Compare( shapeBbox ) )
+                    holelists[ii].Append( m_cutouts[index] );
+            }
 
-                TopTools_ListOfShape cutArgs;
-                cutArgs.Append( shape );
+            // Remove holes for each item (board body or bodies, one can have more than one
+            // board).  The cuts are independent, so run them in parallel.
+            std::atomic<int> cnt( 0 );
 
-                BRepAlgoAPI_Cut cut;
+            ParallelFor( aShapesList.size(),
+                    [&]( size_t aIndex )
+                    {
+                        TopoDS_Shape& shape = aShapesList[aIndex];
 
-                // This helps cutting circular holes in zones where a hole is already cut in Clipper
-                cut.SetFuzzyValue( 0.0005 );
-                cut.SetArguments( cutArgs );
+                        if( !holelists[aIndex].IsEmpty() )
+                        {
+                            TopTools_ListOfShape cutArgs;
+                            cutArgs.Append( shape );
+
+                            BRepAlgoAPI_Cut cut;
+
+                            // This helps cutting circular holes in zones where a hole is already
+                            // cut in Clipper
+                            cut.SetFuzzyValue( 0.0005 );
+
+                            // The holes are shared by the concurrent cuts, which must not change
+                            // their tolerances
+                            cut.SetNonDestructive( true );
+                            cut.SetArguments( cutArgs );
+                            cut.SetTools( holelists[aIndex] );
+
+                            try
+                            {
+                                cut.Build();
+
+                                if( cut.IsDone() )
+                                    shape = cut.Shape();
+                            }
+                            catch( const Standard_Failure& e )
+                            {
+                                ReportMessage( wxString::Format(
+                                        wxT( "Cutting %s: OCC exception: %s\n" ), aWhat,
+                                        e.GetMessageString() ) );
+                            }
+                        }
 
-                cut.SetTools( holelist );
-                cut.Build();
+                        int done = ++cnt;
 
-                shape = cut.Shape();
-            }
+                        if( done % 10 == 0 )
+                            ReportMessage( wxString::Format( _( "Cutting %d/%d %s\n" ), done,
+                                                             (int) aShapesList.size(), aWhat ) );
+                    } );
         };
 
         subtractShapes( _( "pads" ), m_board_copper_pads );
@@ -1191,24 +1303,39 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
     wxString fileName( wxString::FromUTF8( aFileNameUTF8.c_str() ) );
     MODEL3D_FORMAT_TYPE modelFmt = fileType( aFileNameUTF8.c_str() );
 
+    wxString cacheFile;
+
+    if( modelFmt == FMT_IGES || modelFmt == FMT_STEP )
+        cacheFile = modelCacheFileName( fileName );
+
     switch( modelFmt )
     {
     case FMT_IGES:
+        if( readModelCache( cacheFile, doc ) )
+            break;
+
         if( !readIGES( doc, aFileNameUTF8.c_str() ) )
         {
             ReportMessage( wxString::Format( wxT( "readIGES() failed on filename '%s'.\n" ),
                                              fileName ) );
             return false;
         }
+
+        writeModelCache( cacheFile, doc );
         break;
 
     case FMT_STEP:
+        if( readModelCache( cacheFile, doc ) )
+            break;
+
         if( !readSTEP( doc, aFileNameUTF8.c_str() ) )
         {
             ReportMessage( wxString::Format( wxT( "readSTEP() failed on filename '%s'.\n" ),
                                              fileName ) );
             return false;
         }
+
+        writeModelCache( cacheFile, doc );
         break;
 
     case FMT_STEPZ:
@@ -1371,6 +1498,10 @@ bool STEP_PCB_MODEL::getModelLabel( const std::string& aFileNameUTF8, VECTOR3D a
 
     aLabel = transferModel( doc, m_doc, aScale );
 
+    // The shapes are shared with the export document, the model document is no longer needed
+    if( doc->CanClose() == CDM_CCS_OK )
+        doc->Close();
+
     if( aLabel.IsNull() )
     {
         ReportMessage( wxString::Format( wxT( "Could not transfer model data from file '%s'.\n" ),
@@ -1532,6 +1663,67 @@ bool STEP_PCB_MODEL::readSTEP( Handle( TDocStd_Document )& doc, const char* fnam
 }
 
 
+bool STEP_PCB_MODEL::readModelCache( const wxString& aCacheFile, Handle( TDocStd_Document )& aDoc )
+{
+    if( aCacheFile.IsEmpty() || !wxFileName::FileExists( aCacheFile ) )
+        return false;
+
+    Handle( TDocStd_Document ) cached;
+
+    try
+    {
+        if( m_app->Open( TCollection_ExtendedString( aCacheFile.ToUTF8().data(), true ), cached )
+            != PCDM_RS_OK )
+        {
+            return false;
+        }
+    }
+    catch( const Standard_Failure& e )
+    {
+        ReportMessage( wxString::Format( wxT( "Could not read model cache file '%s': %s\n" ),
+                                         aCacheFile, e.GetMessageString() ) );
+        return false;
+    }
+
+    if( aDoc->CanClose() == CDM_CCS_OK )
+        aDoc->Close();
+
+    aDoc = cached;
+    return true;
+}
+
+
+void STEP_PCB_MODEL::writeModelCache( const wxString& aCacheFile, Handle( TDocStd_Document )& aDoc )
+{
+    if( aCacheFile.IsEmpty() )
+        return;
+
+    wxFileName cacheFile( aCacheFile );
+
+    if( !cacheFile.DirExists() && !cacheFile.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL ) )
+        return;
+
+    // Write to a file of our own first: other exports may be reading or writing the same model
+    wxString tmpFile = wxString::Format( wxT( "%s.%lu.tmp" ), aCacheFile, wxGetProcessId() );
+    bool     saved = false;
+
+    try
+    {
+        aDoc->ChangeStorageFormat( "BinXCAF" );
+        saved = m_app->SaveAs( aDoc, TCollection_ExtendedString( tmpFile.ToUTF8().data(), true ) )
+                == PCDM_SS_OK;
+    }
+    catch( const Standard_Failure& e )
+    {
+        ReportMessage( wxString::Format( wxT( "Could not write model cache file '%s': %s\n" ),
+                                         aCacheFile, e.GetMessageString() ) );
+    }
+
+    if( !saved || !wxRenameFile( tmpFile, aCacheFile, true ) )
+        wxRemoveFile( tmpFile );
+}
+
+
 TDF_Label STEP_PCB_MODEL::transferModel( Handle( TDocStd_Document )& source,
                                    Handle( TDocStd_Document )& dest, VECTOR3D aScale )
 {
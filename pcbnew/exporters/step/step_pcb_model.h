@@ -218,6 +218,16 @@ private:
     bool readIGES( Handle( TDocStd_Document )& m_doc, const char* fname );
     bool readSTEP( Handle( TDocStd_Document )& m_doc, const char* fname );
 
+    /**
+     * Replace \a aDoc by the model document saved in \a aCacheFile, if there is one.
+     *
+     * STEP and IGES models are slow to read, so the documents read from them are saved in the
+     * 3D model cache directory, under a hash of the contents of the model file.  The cache is
+     * shared by all the exports, from KiCad as from kicad-cli.
+     */
+    bool readModelCache( const wxString& aCacheFile, Handle( TDocStd_Document )& aDoc );
+    void writeModelCache( const wxString& aCacheFile, Handle( TDocStd_Document )& aDoc );
+
     TDF_Label transferModel( Handle( TDocStd_Document )& source, Handle( TDocStd_Document ) & dest,
                              VECTOR3D aScale );
 
@@ -64,6 +64,7 @@
 #include <dialogs/dialog_imported_layers.h>
 #include <dialogs/dialog_import_choose_project.h>
 #include <tools/pcb_actions.h>
+#include <tools/zone_filler_tool.h>
 #include "footprint_info_impl.h"
 #include <board_commit.h>
 #include <zone_filler.h>
@@ -929,6 +930,9 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool addToHistory,
     // please, keep it simple.  prompting goes elsewhere.
     wxFileName pcbFileName = aFileName;
 
+    // Draft zone fills are never written out
+    m_toolManager->GetTool<ZONE_FILLER_TOOL>()->RefillDraftZones( this );
+
     if( pcbFileName.GetExt() == FILEEXT::LegacyPcbFileExtension )
         pcbFileName.SetExt( FILEEXT::KiCadPcbFileExtension );
 
@@ -51,6 +51,8 @@
 #include <geometry/shape_simple.h>
 #include <convert_shape_list_to_polygon.h>
 #include <geometry/convex_hull.h>
+#include <hash.h>
+#include <hash_eda.h>
 #include "convert_basic_shapes_to_polygon.h"
 
 
@@ -61,7 +63,8 @@ FOOTPRINT::FOOTPRINT( BOARD* parent ) :
         m_textExcludedBBoxCacheTimeStamp( 0 ),
         m_hullCacheTimeStamp( 0 ),
         m_initial_comments( nullptr ),
-        m_courtyard_cache_timestamp( 0 )
+        m_courtyard_cache_timestamp( 0 ),
+        m_courtyard_cache_hash( 0 )
 {
     m_attributes   = 0;
     m_layer        = F_Cu;
@@ -105,7 +108,9 @@ FOOTPRINT::FOOTPRINT( BOARD* parent ) :
 
 
 FOOTPRINT::FOOTPRINT( const FOOTPRINT& aFootprint ) :
-    BOARD_ITEM_CONTAINER( aFootprint )
+    BOARD_ITEM_CONTAINER( aFootprint ),
+    m_courtyard_cache_timestamp( 0 ),
+    m_courtyard_cache_hash( 0 )
 {
     m_pos          = aFootprint.m_pos;
     m_fpid         = aFootprint.m_fpid;
@@ -209,7 +214,9 @@ FOOTPRINT::FOOTPRINT( const FOOTPRINT& aFootprint ) :
 
 
 FOOTPRINT::FOOTPRINT( FOOTPRINT&& aFootprint ) :
-    BOARD_ITEM_CONTAINER( aFootprint )
+    BOARD_ITEM_CONTAINER( aFootprint ),
+    m_courtyard_cache_timestamp( 0 ),
+    m_courtyard_cache_hash( 0 )
 {
     *this = std::move( aFootprint );
 }
@@ -338,6 +345,10 @@ PCB_FIELD* FOOTPRINT::AddField( const PCB_FIELD& aField )
     int newNdx = m_fields.size();
 
     m_fields.push_back( new PCB_FIELD( aField ) );
+
+    if( BOARD* board = GetBoard() )
+        board->CacheItemById( m_fields[newNdx] );
+
     return m_fields[newNdx];
 }
 
@@ -348,6 +359,9 @@ void FOOTPRINT::RemoveField( const wxString& aFieldName )
     {
         if( aFieldName == m_fields[i]->GetName( false ) )
         {
+            if( BOARD* board = GetBoard() )
+                board->UncacheItemById( m_fields[i] );
+
             m_fields.erase( m_fields.begin() + i );
             return;
         }
@@ -780,11 +794,19 @@ void FOOTPRINT::Add( BOARD_ITEM* aBoardItem, ADD_MODE aMode, bool aSkipConnectiv
 
     aBoardItem->ClearEditFlags();
     aBoardItem->SetParent( this );
+
+    if( BOARD* board = GetBoard() )
+        board->CacheItemById( aBoardItem );
 }
 
 
 void FOOTPRINT::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aMode )
 {
+    {
+        std::lock_guard<std::mutex> lock( m_effectiveShapeCacheMutex );
+        m_effectiveShapeCache.clear();
+    }
+
     switch( aBoardItem->Type() )
     {
     case PCB_FIELD_T:
@@ -872,6 +894,9 @@ void FOOTPRINT::Remove( BOARD_ITEM* aBoardItem, REMOVE_MODE aMode )
 
     aBoardItem->SetFlags( STRUCT_DELETED );
 
+    if( BOARD* board = GetBoard() )
+        board->UncacheItemById( aBoardItem );
+
     PCB_GROUP* parentGroup = aBoardItem->GetParentGroup();
 
     if( parentGroup && !( parentGroup->GetFlags() & STRUCT_DELETED ) )
@@ -2509,8 +2534,16 @@ std::shared_ptr<SHAPE> FOOTPRINT::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHI
 
 const SHAPE_POLY_SET& FOOTPRINT::GetCourtyard( PCB_LAYER_ID aLayer ) const
 {
+    std::lock_guard<std::mutex> lock( m_courtyard_cache_mutex );
+
     if( GetBoard() && GetBoard()->GetTimeStamp() > m_courtyard_cache_timestamp )
-        const_cast<FOOTPRINT*>( this )->BuildCourtyardCaches();
+    {
+        // The board changed, but usually not the courtyards of most footprints
+        if( m_courtyard_cache_timestamp == 0 || courtyardHash() != m_courtyard_cache_hash )
+            const_cast<FOOTPRINT*>( this )->buildCourtyardCaches( nullptr );
+        else
+            m_courtyard_cache_timestamp = GetBoard()->GetTimeStamp();
+    }
 
     if( IsBackLayer( aLayer ) )
         return m_courtyard_cache_back;
@@ -2519,38 +2552,75 @@ const SHAPE_POLY_SET& FOOTPRINT::GetCourtyard( PCB_LAYER_ID aLayer ) const
 }
 
 
+void FOOTPRINT::getCourtyardShapes( PCB_LAYER_ID aLayer, std::vector<PCB_SHAPE*>& aShapes,
+                                    std::map<int, int>* aWidthHistogram ) const
+{
+    // Only PCB_SHAPE_T have meaning, graphic texts are ignored.
+    for( BOARD_ITEM* item : GraphicalItems() )
+    {
+        if( item->GetLayer() == aLayer && item->Type() == PCB_SHAPE_T )
+        {
+            PCB_SHAPE* shape = static_cast<PCB_SHAPE*>( item );
+            aShapes.push_back( shape );
+
+            if( aWidthHistogram )
+                ( *aWidthHistogram )[ shape->GetStroke().GetWidth() ]++;
+        }
+    }
+}
+
+
+size_t FOOTPRINT::courtyardHash() const
+{
+    size_t hash = 0;
+
+    for( BOARD_ITEM* item : GraphicalItems() )
+    {
+        if( ( item->GetLayer() == F_CrtYd || item->GetLayer() == B_CrtYd )
+                && item->Type() == PCB_SHAPE_T )
+        {
+            hash_combine( hash, hash_fp_item( item, HASH_POS | HASH_LAYER ) );
+        }
+    }
+
+    return hash;
+}
+
+
 void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
+{
+    std::lock_guard<std::mutex> lock( m_courtyard_cache_mutex );
+
+    // With no errors to report, caches built from the same courtyard shapes are still good
+    if( !aErrorHandler && m_courtyard_cache_timestamp != 0
+            && courtyardHash() == m_courtyard_cache_hash )
+    {
+        m_courtyard_cache_timestamp = GetBoard()->GetTimeStamp();
+        return;
+    }
+
+    buildCourtyardCaches( aErrorHandler );
+}
+
+
+void FOOTPRINT::buildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
 {
     m_courtyard_cache_front.RemoveAllContours();
     m_courtyard_cache_back.RemoveAllContours();
     ClearFlags( MALFORMED_COURTYARDS );
 
     m_courtyard_cache_timestamp = GetBoard()->GetTimeStamp();
+    m_courtyard_cache_hash = courtyardHash();
 
     // Build the courtyard area from graphic items on the courtyard.
-    // Only PCB_SHAPE_T have meaning, graphic texts are ignored.
     // Collect items:
     std::vector<PCB_SHAPE*> list_front;
     std::vector<PCB_SHAPE*> list_back;
     std::map<int, int>      front_width_histogram;
     std::map<int, int>      back_width_histogram;
 
-    for( BOARD_ITEM* item : GraphicalItems() )
-    {
-        if( item->GetLayer() == B_CrtYd && item->Type() == PCB_SHAPE_T )
-        {
-            PCB_SHAPE* shape = static_cast<PCB_SHAPE*>( item );
-            list_back.push_back( shape );
-            back_width_histogram[ shape->GetStroke().GetWidth() ]++;
-        }
-
-        if( item->GetLayer() == F_CrtYd && item->Type() == PCB_SHAPE_T )
-        {
-            PCB_SHAPE* shape = static_cast<PCB_SHAPE*>( item );
-            list_front.push_back( shape );
-            front_width_histogram[ shape->GetStroke().GetWidth() ]++;
-        }
-    }
+    getCourtyardShapes( B_CrtYd, list_back, &back_width_histogram );
+    getCourtyardShapes( F_CrtYd, list_front, &front_width_histogram );
 
     if( !list_front.size() && !list_back.size() )
         return;
@@ -2567,6 +2637,7 @@ void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
         m_courtyard_cache_front.Inflate( -1, CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS, maxError );
 
         m_courtyard_cache_front.CacheTriangulation( false );
+        m_courtyard_cache_front.BuildBBoxCaches();
         auto max = std::max_element( front_width_histogram.begin(), front_width_histogram.end(),
                                      []( const std::pair<int, int>& a, const std::pair<int, int>& b )
                                      {
@@ -2596,6 +2667,7 @@ void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
         m_courtyard_cache_back.Inflate( -1, CORNER_STRATEGY::CHAMFER_ACUTE_CORNERS, maxError );
 
         m_courtyard_cache_back.CacheTriangulation( false );
+        m_courtyard_cache_back.BuildBBoxCaches();
         auto max = std::max_element( back_width_histogram.begin(), back_width_histogram.end(),
                                      []( const std::pair<int, int>& a, const std::pair<int, int>& b )
                                      {
@@ -2618,6 +2690,65 @@ void FOOTPRINT::BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler )
 }
 
 
+void FOOTPRINT::ReportCourtyardErrors( OUTLINE_ERROR_HANDLER* aErrorHandler ) const
+{
+    int maxError = pcbIUScale.mmToIU( 0.005 );        // max error for polygonization
+    int chainingEpsilon = pcbIUScale.mmToIU( 0.02 );  // max dist from one endPt to next startPt
+
+    for( PCB_LAYER_ID layer : { F_CrtYd, B_CrtYd } )
+    {
+        std::vector<PCB_SHAPE*> shapes;
+        SHAPE_POLY_SET          outline;
+
+        getCourtyardShapes( layer, shapes );
+
+        if( !shapes.empty() )
+        {
+            ConvertOutlineToPolygon( shapes, outline, maxError, chainingEpsilon, true,
+                                     aErrorHandler );
+        }
+    }
+}
+
+
+/**
+ * Hash what the effective shape of a footprint text or graphic item depends on.
+ */
+static size_t effectiveShapeHash( const BOARD_ITEM* aItem )
+{
+    size_t hash = hash_fp_item( aItem, HASH_POS | HASH_ROT | HASH_LAYER | HASH_REF | HASH_VALUE );
+
+    if( const EDA_TEXT* text = dynamic_cast<const EDA_TEXT*>( aItem ) )
+    {
+        hash_combine( hash, text->GetShownText( true ).ToStdString(), text->GetFont(),
+                      text->GetEffectiveTextPenWidth(), text->IsVisible() );
+    }
+
+    hash_combine( hash, aItem->IsKnockout() );
+
+    return hash;
+}
+
+
+std::shared_ptr<SHAPE> FOOTPRINT::GetCachedEffectiveShape( const BOARD_ITEM* aItem,
+                                                           PCB_LAYER_ID aLayer ) const
+{
+    wxASSERT( aItem->GetParentFootprint() == this );
+
+    size_t hash = effectiveShapeHash( aItem );
+
+    // Held while building, as the texts of a footprint share some render caches
+    std::lock_guard<std::mutex> lock( m_effectiveShapeCacheMutex );
+
+    std::pair<size_t, std::shared_ptr<SHAPE>>& entry = m_effectiveShapeCache[ { aItem, aLayer } ];
+
+    if( !entry.second || entry.first != hash )
+        entry = { hash, aItem->GetEffectiveShape( aLayer ) };
+
+    return entry.second;
+}
+
+
 std::map<wxString, int> FOOTPRINT::MapPadNumbersToNetTieGroups() const
 {
     std::map<wxString, int> padNumberToGroupIdxMap;
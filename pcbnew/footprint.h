@@ -26,6 +26,8 @@
 #define FOOTPRINT_H
 
 #include <deque>
+#include <map>
+#include <mutex>
 
 #include <template_fieldnames.h>
 
@@ -901,6 +903,9 @@ public:
     /**
      * Used in DRC to test the courtyard area (a complex polygon).
      *
+     * The courtyards are cached, and only rebuilt when the graphic items on the courtyard layers
+     * changed.  Thread-safe, as long as the footprint isn't modified at the same time.
+     *
      * @return the courtyard polygon.
      */
     const SHAPE_POLY_SET& GetCourtyard( PCB_LAYER_ID aLayer ) const;
@@ -908,11 +913,29 @@ public:
     /**
      * Build complex polygons of the courtyard areas from graphic items on the courtyard layers.
      *
+     * Without \a aErrorHandler, this does nothing if the courtyard shapes didn't change since the
+     * caches were last built.
+     *
      * @note Set the #MALFORMED_F_COURTYARD and #MALFORMED_B_COURTYARD status flags if the given
      *       courtyard layer does not contain a (single) closed shape.
      */
     void BuildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler = nullptr );
 
+    /**
+     * Report why the courtyards are malformed to \a aErrorHandler, without touching the
+     * courtyard caches (which other threads may be reading).
+     */
+    void ReportCourtyardErrors( OUTLINE_ERROR_HANDLER* aErrorHandler ) const;
+
+    /**
+     * Return the effective shape of \a aItem, a text or graphic item of this footprint, on
+     * \a aLayer.  The shapes are cached until the item changes, so that repeated DRC runs don't
+     * rebuild outline font glyphs for every field.  Thread-safe, as long as the footprint isn't
+     * modified at the same time.
+     */
+    std::shared_ptr<SHAPE> GetCachedEffectiveShape( const BOARD_ITEM* aItem,
+                                                    PCB_LAYER_ID aLayer ) const;
+
     // @copydoc BOARD_ITEM::GetEffectiveShape
     std::shared_ptr<SHAPE> GetEffectiveShape( PCB_LAYER_ID aLayer = UNDEFINED_LAYER,
                                               FLASHING aFlash = FLASHING::DEFAULT ) const override;
@@ -948,6 +971,15 @@ public:
 protected:
     virtual void swapData( BOARD_ITEM* aImage ) override;
 
+private:
+    /// The courtyard shapes of \a aLayer (F_CrtYd or B_CrtYd), with their stroke widths.
+    void getCourtyardShapes( PCB_LAYER_ID aLayer, std::vector<PCB_SHAPE*>& aShapes,
+                             std::map<int, int>* aWidthHistogram = nullptr ) const;
+
+    size_t courtyardHash() const;
+
+    void buildCourtyardCaches( OUTLINE_ERROR_HANDLER* aErrorHandler );
+
 private:
     PCB_FIELDS      m_fields;
     DRAWINGS        m_drawings;          // BOARD_ITEMs for drawings on the board, owned by pointer.
@@ -1009,6 +1041,13 @@ private:
     SHAPE_POLY_SET  m_courtyard_cache_front;  // Note that a footprint can have both front and back
     SHAPE_POLY_SET  m_courtyard_cache_back;   // courtyards populated.
     mutable int     m_courtyard_cache_timestamp;
+    size_t          m_courtyard_cache_hash;   // Hash of the items the caches were built from
+    mutable std::mutex m_courtyard_cache_mutex;
+
+    // Effective shapes of texts and graphics, with the hash of the item they were built from
+    mutable std::map<std::pair<const BOARD_ITEM*, PCB_LAYER_ID>,
+                     std::pair<size_t, std::shared_ptr<SHAPE>>> m_effectiveShapeCache;
+    mutable std::mutex                                          m_effectiveShapeCacheMutex;
 };
 
 #endif     // FOOTPRINT_H
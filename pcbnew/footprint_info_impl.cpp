@@ -31,7 +31,7 @@
 #include <lib_id.h>
 #include <progress_reporter.h>
 #include <string_utils.h>
-#include <core/thread_pool.h>
+#include <core/task_graph.h>
 #include <wildcards_and_files_ext.h>
 
 #include <kiplatform/io.h>
@@ -174,13 +174,14 @@ void FOOTPRINT_LIST_IMPL::loadLibs()
 {
     thread_pool& tp = GetKiCadThreadPool();
     size_t num_returns = m_queue_in.size();
-    std::vector<std::future<size_t>> returns( num_returns );
+
+    // Library scans are speculative work; let interactive jobs overtake them in the pool.
+    TASK_GRAPH graph( TASK_PRIORITY::BACKGROUND );
 
     auto loader_job =
-            [this]() -> size_t
+            [this]()
             {
                 wxString nickname;
-                size_t retval = 0;
 
                 if( !m_cancelled && m_queue_in.pop( nickname ) )
                 {
@@ -192,28 +193,21 @@ void FOOTPRINT_LIST_IMPL::loadLibs()
                     {
                         m_progress_reporter->AdvanceProgress();
                     }
-
-                    ++retval;
                 }
-
-                return retval;
             };
 
     for( size_t ii = 0; ii < num_returns; ++ii )
-        returns[ii] = tp.submit( loader_job );
-
-    for( const std::future<size_t>& ret : returns )
-    {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        graph.AddTask( loader_job );
 
-        while( status != std::future_status::ready )
-        {
-            if( m_progress_reporter && !m_progress_reporter->KeepRefreshing() )
-                m_cancelled = true;
+    graph.Run( tp,
+               [this]() -> bool
+               {
+                   if( m_progress_reporter && !m_progress_reporter->KeepRefreshing() )
+                       m_cancelled = true;
 
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
+                   return !m_cancelled;
+               },
+               std::chrono::milliseconds( 250 ) );
 }
 
 
@@ -231,58 +225,57 @@ void FOOTPRINT_LIST_IMPL::loadFootprints()
     SYNC_QUEUE<std::unique_ptr<FOOTPRINT_INFO>> queue_parsed;
     thread_pool&                                tp = GetKiCadThreadPool();
     size_t                                      num_elements = m_queue_out.size();
-    std::vector<std::future<size_t>>            returns( num_elements );
+    TASK_GRAPH                                  graph( TASK_PRIORITY::BACKGROUND );
 
     auto fp_thread =
-            [ this, &queue_parsed ]() -> size_t
+            [ this, &queue_parsed ]()
             {
                 wxString nickname;
 
                 if( m_cancelled || !m_queue_out.pop( nickname ) )
-                    return 0;
+                    return;
 
-                wxArrayString fpnames;
+                std::vector<FOOTPRINT_SUMMARY> summaries;
 
+                // Summaries don't need the footprints, which some plugins can get from an
+                // index without parsing the library
                 CatchErrors(
                         [&]()
                         {
-                            m_lib_table->FootprintEnumerate( fpnames, nickname, false );
+                            m_lib_table->FootprintEnumerateSummaries( summaries, nickname,
+                                                                      false );
                         } );
 
-                for( wxString fpname : fpnames )
+                for( const FOOTPRINT_SUMMARY& summary : summaries )
                 {
-                    CatchErrors(
-                            [&]()
-                            {
-                                auto* fpinfo = new FOOTPRINT_INFO_IMPL( this, nickname, fpname );
-                                queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
-                            } );
+                    auto* fpinfo = new FOOTPRINT_INFO_IMPL( nickname, summary.m_name,
+                                                            summary.m_description,
+                                                            summary.m_keywords, 0,
+                                                            summary.m_padCount,
+                                                            summary.m_uniquePadCount );
+
+                    queue_parsed.move_push( std::unique_ptr<FOOTPRINT_INFO>( fpinfo ) );
 
                     if( m_cancelled )
-                        return 0;
+                        return;
                 }
 
                 if( m_progress_reporter )
                     m_progress_reporter->AdvanceProgress();
-
-                return 1;
             };
 
     for( size_t ii = 0; ii < num_elements; ++ii )
-        returns[ii] = tp.submit( fp_thread );
-
-    for( const std::future<size_t>& ret : returns )
-    {
-        std::future_status status = ret.wait_for( std::chrono::milliseconds( 250 ) );
+        graph.AddTask( fp_thread );
 
-        while( status != std::future_status::ready )
-        {
-            if( m_progress_reporter )
-                m_progress_reporter->KeepRefreshing();
+    graph.Run( tp,
+               [this]() -> bool
+               {
+                   if( m_progress_reporter )
+                       m_progress_reporter->KeepRefreshing();
 
-            status = ret.wait_for( std::chrono::milliseconds( 250 ) );
-        }
-    }
+                   return true;
+               },
+               std::chrono::milliseconds( 250 ) );
 
     std::unique_ptr<FOOTPRINT_INFO> fpi;
 
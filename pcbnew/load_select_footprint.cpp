@@ -29,6 +29,7 @@ using namespace std::placeholders;
 #include <board.h>
 #include <footprint.h>
 #include <confirm.h>
+#include <core/thread_pool.h>
 #include <connectivity/connectivity_data.h>
 #include <dialog_footprint_chooser.h>
 #include <dialog_get_footprint_by_name.h>
@@ -232,6 +233,109 @@ FOOTPRINT* PCB_BASE_FRAME::LoadFootprint( const LIB_ID& aFootprintId )
 }
 
 
+std::map<LIB_ID, std::unique_ptr<FOOTPRINT>>
+PCB_BASE_FRAME::LoadLibraryFootprints( const std::vector<LIB_ID>& aFootprintIds )
+{
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> footprints;
+    FP_LIB_TABLE*                                fptbl = PROJECT_PCB::PcbFootprintLibs( &Prj() );
+
+    wxCHECK_MSG( fptbl, {}, wxT( "Cannot look up LIB_ID in NULL FP_LIB_TABLE." ) );
+
+    // Group the requested footprints by library.  Each library table row owns its own
+    // plugin instance (and cache), so distinct libraries can be read concurrently.
+    std::map<wxString, std::vector<LIB_ID>> byLibrary;
+
+    for( const LIB_ID& fpid : aFootprintIds )
+    {
+        if( footprints.count( fpid ) )
+            continue;
+
+        footprints[ fpid ] = nullptr;
+
+        if( fpid.GetLibNickname().empty() )
+        {
+            // No nickname means searching every library; leave that to the serial loader
+            footprints[ fpid ].reset( LoadFootprint( fpid ) );
+            continue;
+        }
+
+        byLibrary[ fpid.GetLibNickname() ].push_back( fpid );
+    }
+
+    std::vector<std::vector<LIB_ID>*> libraries;
+
+    for( auto& [ nickname, fpids ] : byLibrary )
+    {
+        // FindRow() instantiates the row plugin on first use; do that here, before any
+        // worker thread touches the row.
+        try
+        {
+            fptbl->FindRow( nickname, true );
+            libraries.push_back( &fpids );
+        }
+        catch( const IO_ERROR& )
+        {
+        }
+    }
+
+    // When loading a footprint from a library in the footprint editor
+    // the items UUIDs must be keep and not reinitialized
+    bool keepUUID = IsType( FRAME_FOOTPRINT_EDITOR );
+
+    std::vector<std::vector<FOOTPRINT*>> loaded( libraries.size() );
+
+    for( size_t ii = 0; ii < libraries.size(); ++ii )
+        loaded[ii].resize( libraries[ii]->size(), nullptr );
+
+    ParallelFor( libraries.size(),
+            [&]( size_t ii )
+            {
+                for( size_t jj = 0; jj < libraries[ii]->size(); ++jj )
+                {
+                    const LIB_ID& fpid = ( *libraries[ii] )[jj];
+
+                    try
+                    {
+                        loaded[ii][jj] = fptbl->FootprintLoad( fpid.GetLibNickname(),
+                                                               fpid.GetLibItemName(), keepUUID );
+                    }
+                    catch( const IO_ERROR& )
+                    {
+                    }
+                }
+            } );
+
+    BOARD_DESIGN_SETTINGS* bds = nullptr;
+
+    if( m_pcb && !m_pcb->IsFootprintHolder() )
+        bds = &m_pcb->GetDesignSettings();
+
+    for( size_t ii = 0; ii < libraries.size(); ++ii )
+    {
+        for( size_t jj = 0; jj < libraries[ii]->size(); ++jj )
+        {
+            FOOTPRINT* footprint = loaded[ii][jj];
+
+            if( !footprint )
+                continue;
+
+            // See loadFootprint()
+            footprint->ClearAllNets();
+
+            if( bds )
+            {
+                footprint->ApplyDefaultSettings( *m_pcb, bds->m_StyleFPFields,
+                                                 bds->m_StyleFPText, bds->m_StyleFPShapes );
+            }
+
+            footprints[ ( *libraries[ii] )[jj] ].reset( footprint );
+        }
+    }
+
+    return footprints;
+}
+
+
 FOOTPRINT* PCB_BASE_FRAME::loadFootprint( const LIB_ID& aFootprintId )
 {
     FP_LIB_TABLE*   fptbl = PROJECT_PCB::PcbFootprintLibs( &Prj() );
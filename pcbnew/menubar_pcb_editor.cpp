@@ -369,10 +369,12 @@ void PCB_EDIT_FRAME::doReCreateMenuBar()
 
     inspectMenu->Add( PCB_ACTIONS::listNets );
     inspectMenu->Add( PCB_ACTIONS::boardStatistics );
+    inspectMenu->Add( PCB_ACTIONS::memoryReport );
     inspectMenu->Add( ACTIONS::measureTool );
 
     inspectMenu->AppendSeparator();
     inspectMenu->Add( PCB_ACTIONS::runDRC );
+    inspectMenu->Add( PCB_ACTIONS::toggleBackgroundDRC, ACTION_MENU::CHECK );
     inspectMenu->Add( ACTIONS::prevMarker );
     inspectMenu->Add( ACTIONS::nextMarker );
     inspectMenu->Add( ACTIONS::excludeMarker );
@@ -33,6 +33,7 @@
 #include <gr_basic.h>
 #include <netclass.h>
 #include <board_item.h>
+#include <interned_string.h>
 #include <string_utils.h>
 
 
@@ -111,12 +112,19 @@ public:
     /**
      * @return the full netname.
      */
-    const wxString& GetNetname() const { return m_netname; }
+    const wxString& GetNetname() const { return m_netname.Str(); }
+
+#ifndef SWIG
+    /**
+     * @return the full netname as an interned string, for cheap comparison and hashing.
+     */
+    const INTERNED_STRING& GetInternedNetname() const { return m_netname; }
+#endif
 
     /**
      * @return the short netname.
      */
-    const wxString& GetShortNetname() const { return m_shortNetname; }
+    const wxString& GetShortNetname() const { return m_shortNetname.Str(); }
 
     /**
      * @return the unescaped short netname.
@@ -128,8 +136,8 @@ public:
      */
     bool HasAutoGeneratedNetname()
     {
-        return m_shortNetname.StartsWith( wxT( "Net-(" ) )
-                    || m_shortNetname.StartsWith( wxT( "unconnected-(" ) );
+        return m_shortNetname.Str().StartsWith( wxT( "Net-(" ) )
+                    || m_shortNetname.Str().StartsWith( wxT( "unconnected-(" ) );
     }
 
     /**
@@ -138,12 +146,12 @@ public:
      */
     void SetNetname( const wxString& aNewName )
     {
-        m_netname = aNewName;
+        m_netname = INTERNED_STRING( aNewName );
 
         if( aNewName.Contains( wxT( "/" ) ) )
-            m_shortNetname = aNewName.AfterLast( '/' );
+            m_shortNetname = INTERNED_STRING( aNewName.AfterLast( '/' ) );
         else
-            m_shortNetname = aNewName;
+            m_shortNetname = m_netname;
 
         m_unescapedShortNetname = UnescapeString( m_shortNetname );
     }
@@ -189,10 +197,12 @@ protected:
 private:
     friend class NETINFO_LIST;
 
-    int         m_netCode;               ///< A number equivalent to the net name.
-    wxString    m_netname;               ///< Full net name like /sheet/subsheet/vout used by Eeschema.
-    wxString    m_shortNetname;          ///< Short net name, like vout from /sheet/subsheet/vout.
-    wxString    m_unescapedShortNetname; ///< Unescaped short net name.
+    int             m_netCode;               ///< A number equivalent to the net name.
+    INTERNED_STRING m_netname;               ///< Full net name like /sheet/subsheet/vout used
+                                             ///< by Eeschema.
+    INTERNED_STRING m_shortNetname;          ///< Short net name, like vout from
+                                             ///< /sheet/subsheet/vout.
+    wxString        m_unescapedShortNetname; ///< Unescaped short net name.
 
     std::shared_ptr<NETCLASS> m_netClass;
 
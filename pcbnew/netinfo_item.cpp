@@ -43,7 +43,7 @@ NETINFO_ITEM::NETINFO_ITEM( BOARD* aParent, const wxString& aNetName, int aNetCo
         BOARD_ITEM( aParent, PCB_NETINFO_T ),
         m_netCode( aNetCode ),
         m_netname( aNetName ),
-        m_shortNetname( m_netname.AfterLast( '/' ) ),
+        m_shortNetname( aNetName.AfterLast( '/' ) ),
         m_unescapedShortNetname( UnescapeString( m_shortNetname ) ),
         m_isCurrent( true )
 {
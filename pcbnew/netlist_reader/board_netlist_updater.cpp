@@ -27,6 +27,9 @@
  */
 
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include <common.h>                         // for PAGE_INFO
 
 #include <base_units.h>
@@ -1043,6 +1046,8 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
     wxString msg;
     wxString padNumber;
 
+    std::unordered_set<wxString> padNumbers;
+
     for( int i = 0; i < (int) aNetlist.GetCount(); i++ )
     {
         COMPONENT* component = aNetlist.GetComponent( i );
@@ -1051,6 +1056,11 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
         if( !footprint )    // It can be missing in partial designs
             continue;
 
+        padNumbers.clear();
+
+        for( PAD* pad : footprint->Pads() )
+            padNumbers.insert( pad->GetNumber() );
+
         // Explore all pins/pads in component
         for( unsigned jj = 0; jj < component->GetNetCount(); jj++ )
         {
@@ -1066,7 +1076,7 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
                 m_reporter->Report( msg, RPT_SEVERITY_ERROR );
                 ++m_errorCount;
             }
-            else if( !footprint->FindPadByNumber( padNumber ) )
+            else if( !padNumbers.count( padNumber ) )
             {
                 // not found: bad footprint, report error
                 msg.Printf( _( "%s pad %s not found in %s." ),
@@ -1085,7 +1095,6 @@ bool BOARD_NETLIST_UPDATER::testConnectivity( NETLIST& aNetlist,
 
 bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 {
-    FOOTPRINT* lastPreexistingFootprint = nullptr;
     COMPONENT* component = nullptr;
     wxString   msg;
 
@@ -1095,8 +1104,46 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
 
     std::map<COMPONENT*, FOOTPRINT*> footprintMap;
 
-    if( !m_board->Footprints().empty() )
-        lastPreexistingFootprint = m_board->Footprints().back();
+    // Footprints and components are matched through hash maps rather than by searching the
+    // board or the netlist for each of them, which is quadratic on large designs.  The board
+    // footprints are listed with their index, so that they are processed in board order.
+    using FOOTPRINT_ENTRIES = std::vector<std::pair<size_t, FOOTPRINT*>>;
+
+    std::map<KIID_PATH, FOOTPRINT_ENTRIES>           footprintsByPath;
+    std::unordered_map<wxString, FOOTPRINT_ENTRIES>  footprintsByRef;
+    std::map<KIID_PATH, COMPONENT*>                  componentsByPath;
+    std::unordered_map<wxString, COMPONENT*>         componentsByRef;
+
+    size_t boardIndex = 0;
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        std::pair<size_t, FOOTPRINT*> entry( boardIndex++, footprint );
+
+        if( m_lookupByTimestamp )
+            footprintsByPath[footprint->GetPath()].push_back( entry );
+        else
+            footprintsByRef[footprint->GetReference().Lower()].push_back( entry );
+    }
+
+    for( unsigned i = 0; i < aNetlist.GetCount(); i++ )
+    {
+        component = aNetlist.GetComponent( i );
+
+        if( m_lookupByTimestamp )
+        {
+            for( const KIID& uuid : component->GetKIIDs() )
+            {
+                KIID_PATH path = component->GetPath();
+                path.push_back( uuid );
+                componentsByPath.emplace( path, component );
+            }
+        }
+        else
+        {
+            componentsByRef.emplace( component->GetReference(), component );
+        }
+    }
 
     cacheCopperZoneConnections();
 
@@ -1124,54 +1171,50 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
                     component->GetFPID().Format().wx_str() );
         m_reporter->Report( msg, RPT_SEVERITY_INFO );
 
-        int matchCount = 0;
+        FOOTPRINT_ENTRIES matches;
 
-        for( FOOTPRINT* footprint : m_board->Footprints() )
+        if( m_lookupByTimestamp )
         {
-            bool match = false;
-
-            if( m_lookupByTimestamp )
+            for( const KIID& uuid : component->GetKIIDs() )
             {
-                for( const KIID& uuid : component->GetKIIDs() )
-                {
-                    KIID_PATH base = component->GetPath();
-                    base.push_back( uuid );
+                KIID_PATH base = component->GetPath();
+                base.push_back( uuid );
 
-                    if( footprint->GetPath() == base )
-                    {
-                        match = true;
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                match = footprint->GetReference().CmpNoCase( component->GetReference() ) == 0;
+                auto it = footprintsByPath.find( base );
+
+                if( it != footprintsByPath.end() )
+                    matches.insert( matches.end(), it->second.begin(), it->second.end() );
             }
 
-            if( match )
-            {
-                FOOTPRINT* tmp = footprint;
+            std::sort( matches.begin(), matches.end() );
+            matches.erase( std::unique( matches.begin(), matches.end() ), matches.end() );
+        }
+        else
+        {
+            auto it = footprintsByRef.find( component->GetReference().Lower() );
 
-                if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
-                    tmp = replaceFootprint( aNetlist, footprint, component );
+            if( it != footprintsByRef.end() )
+                matches = it->second;
+        }
 
-                if( tmp )
-                {
-                    footprintMap[ component ] = tmp;
+        int matchCount = 0;
 
-                    updateFootprintParameters( tmp, component );
-                    updateComponentPadConnections( tmp, component );
-                }
+        for( const auto& [index, footprint] : matches )
+        {
+            FOOTPRINT* tmp = footprint;
 
-                matchCount++;
-            }
+            if( m_replaceFootprints && component->GetFPID() != footprint->GetFPID() )
+                tmp = replaceFootprint( aNetlist, footprint, component );
 
-            if( footprint == lastPreexistingFootprint )
+            if( tmp )
             {
-                // No sense going through the newly-created footprints: end of loop
-                break;
+                footprintMap[ component ] = tmp;
+
+                updateFootprintParameters( tmp, component );
+                updateComponentPadConnections( tmp, component );
             }
+
+            matchCount++;
         }
 
         if( matchCount == 0 )
@@ -1207,10 +1250,22 @@ bool BOARD_NETLIST_UPDATER::UpdateNetlist( NETLIST& aNetlist )
         if( ( footprint->GetAttributes() & FP_BOARD_ONLY ) > 0 )
             doDelete = false;
 
+        component = nullptr;
+
         if( m_lookupByTimestamp )
-            component = aNetlist.GetComponentByPath( footprint->GetPath() );
+        {
+            auto it = componentsByPath.find( footprint->GetPath() );
+
+            if( it != componentsByPath.end() )
+                component = it->second;
+        }
         else
-            component = aNetlist.GetComponentByReference( footprint->GetReference() );
+        {
+            auto it = componentsByRef.find( footprint->GetReference() );
+
+            if( it != componentsByRef.end() )
+                component = it->second;
+        }
 
         if( component && component->GetProperties().count( wxT( "exclude_from_board" ) ) == 0 )
             matched = true;
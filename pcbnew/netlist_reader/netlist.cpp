@@ -144,9 +144,7 @@ void PCB_EDIT_FRAME::OnNetlistChanged( BOARD_NETLIST_UPDATER& aUpdater, bool* aR
 void PCB_EDIT_FRAME::LoadFootprints( NETLIST& aNetlist, REPORTER& aReporter )
 {
     wxString   msg;
-    LIB_ID     lastFPID;
     COMPONENT* component;
-    FOOTPRINT* footprint = nullptr;
     FOOTPRINT* fpOnBoard = nullptr;
 
     if( aNetlist.IsEmpty() || PROJECT_PCB::PcbFootprintLibs( &Prj() )->IsEmpty() )
@@ -154,6 +152,9 @@ void PCB_EDIT_FRAME::LoadFootprints( NETLIST& aNetlist, REPORTER& aReporter )
 
     aNetlist.SortByFPID();
 
+    std::vector<COMPONENT*> toLoad;
+    std::vector<LIB_ID>     fpids;
+
     for( unsigned ii = 0; ii < aNetlist.GetCount(); ii++ )
     {
         component = aNetlist.GetComponent( ii );
@@ -203,51 +204,34 @@ void PCB_EDIT_FRAME::LoadFootprints( NETLIST& aNetlist, REPORTER& aReporter )
         if( fpOnBoard && !footprintMisMatch )   // nothing else to do here
             continue;
 
-        if( component->GetFPID() != lastFPID )
-        {
-            footprint = nullptr;
-
-            // The LIB_ID is ok as long as there is a footprint portion coming the library if
-            // it's needed.  Nickname can be blank.
-            if( !component->GetFPID().GetLibItemName().size() )
-            {
-                msg.Printf( _( "%s footprint ID '%s' is not valid." ),
-                            component->GetReference(),
-                            component->GetFPID().Format().wx_str() );
-                aReporter.Report( msg, RPT_SEVERITY_ERROR );
-
-                continue;
-            }
+        toLoad.push_back( component );
+        fpids.push_back( component->GetFPID() );
+    }
 
-            // loadFootprint() can find a footprint with an empty nickname in fpid.
-            footprint = PCB_BASE_FRAME::loadFootprint( component->GetFPID() );
+    // Each distinct footprint is read from its library only once, and distinct libraries are
+    // read concurrently.  Nicknames can be blank; those are searched for in every library.
+    std::map<LIB_ID, std::unique_ptr<FOOTPRINT>> libFootprints =
+            LoadLibraryFootprints( fpids );
 
-            if( footprint )
-            {
-                lastFPID = component->GetFPID();
-            }
-            else
-            {
-                msg.Printf( _( "%s footprint '%s' not found in any libraries in the footprint "
-                               "library table." ),
-                            component->GetReference(),
-                            component->GetFPID().GetLibItemName().wx_str() );
-                aReporter.Report( msg, RPT_SEVERITY_ERROR );
+    for( COMPONENT* comp : toLoad )
+    {
+        std::unique_ptr<FOOTPRINT>& libFootprint = libFootprints[ comp->GetFPID() ];
 
-                continue;
-            }
-        }
-        else
+        if( !libFootprint )
         {
-            // Footprint already loaded from a library, duplicate it (faster)
-            if( !footprint )
-                continue;            // Footprint does not exist in any library.
+            msg.Printf( _( "%s footprint '%s' not found in any libraries in the footprint "
+                           "library table." ),
+                        comp->GetReference(),
+                        comp->GetFPID().GetLibItemName().wx_str() );
+            aReporter.Report( msg, RPT_SEVERITY_ERROR );
 
-            footprint = new FOOTPRINT( *footprint );
-            const_cast<KIID&>( footprint->m_Uuid ) = KIID();
+            continue;
         }
 
-        if( footprint )
-            component->SetFootprint( footprint );
+        // Several components can share a library footprint; give each its own copy
+        FOOTPRINT* footprint = new FOOTPRINT( *libFootprint );
+        const_cast<KIID&>( footprint->m_Uuid ) = KIID();
+
+        comp->SetFootprint( footprint );
     }
 }
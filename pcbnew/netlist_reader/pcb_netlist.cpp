@@ -60,12 +60,17 @@ COMPONENT_NET COMPONENT::m_emptyNet;
 
 const COMPONENT_NET& COMPONENT::GetNet( const wxString& aPinName ) const
 {
-    for( const COMPONENT_NET& net : m_nets )
+    if( m_netIndex.empty() )
     {
-        if( net.GetPinName() == aPinName )
-            return net;
+        for( size_t ii = 0; ii < m_nets.size(); ++ii )
+            m_netIndex.emplace( m_nets[ii].GetPinName(), ii );
     }
 
+    auto it = m_netIndex.find( aPinName );
+
+    if( it != m_netIndex.end() )
+        return m_nets[it->second];
+
     return m_emptyNet;
 }
 
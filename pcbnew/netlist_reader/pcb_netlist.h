@@ -26,6 +26,8 @@
 #ifndef PCB_NETLIST_H
 #define PCB_NETLIST_H
 
+#include <unordered_map>
+
 #include <boost/ptr_container/ptr_vector.hpp>
 #include <wx/arrstr.h>
 #include <nlohmann/json.hpp>
@@ -105,6 +107,7 @@ public:
                  const wxString& aPinType )
     {
         m_nets.emplace_back( aPinName, aNetName, aPinFunction, aPinType );
+        m_netIndex.clear();
     }
 
     unsigned GetNetCount() const { return m_nets.size(); }
@@ -113,9 +116,17 @@ public:
 
     const COMPONENT_NET& GetNet( const wxString& aPinName ) const;
 
-    void ClearNets() { m_nets.clear(); }
+    void ClearNets()
+    {
+        m_nets.clear();
+        m_netIndex.clear();
+    }
 
-    void SortPins() { sort( m_nets.begin(), m_nets.end() ); }
+    void SortPins()
+    {
+        sort( m_nets.begin(), m_nets.end() );
+        m_netIndex.clear();
+    }
 
     void SetName( const wxString& aName ) { m_name = aName;}
     const wxString& GetName() const { return m_name; }
@@ -174,6 +185,10 @@ public:
 private:
     std::vector<COMPONENT_NET>   m_nets;  ///< list of nets shared by the component pins
 
+    /// Index in #m_nets of the first net of each pin name, built on demand by GetNet() so
+    /// that matching the pads of large footprints isn't quadratic.
+    mutable std::unordered_map<wxString, size_t> m_netIndex;
+
     wxArrayString                m_footprintFilters;
     int                          m_pinCount;
     wxString                     m_reference;
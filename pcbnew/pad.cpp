@@ -547,9 +547,7 @@ void PAD::BuildEffectiveShapes( PCB_LAYER_ID aLayer ) const
     {
         SHAPE_POLY_SET outline;
 
-        TransformRoundChamferedRectToPolygon( outline, shapePos, GetSize(), m_orient,
-                                              GetRoundRectCornerRadius(), GetChamferRectRatio(),
-                                              GetChamferPositions(), 0, maxError, ERROR_INSIDE );
+        TransformShapeToPolygon( outline, UNDEFINED_LAYER, 0, maxError, ERROR_INSIDE );
 
         add( new SHAPE_SIMPLE( outline.COutline( 0 ) ) );
     }
@@ -1591,6 +1589,49 @@ void PAD::TransformShapeToPolygon( SHAPE_POLY_SET& aBuffer, PCB_LAYER_ID aLayer,
 {
     wxASSERT_MSG( !ignoreLineWidth, wxT( "IgnoreLineWidth has no meaning for pads." ) );
 
+    VECTOR2I     padShapePos = ShapePos();  // Note: for pad having a shape offset, the pad
+                                            //   position is NOT the shape position
+    const BOARD* board = GetBoard();
+
+    // Custom pads depend on their primitives, which aren't part of the cache key
+    if( !board || GetShape() == PAD_SHAPE::CUSTOM )
+    {
+        transformShapeToPolygon( aBuffer, padShapePos, aClearance, aMaxError, aErrorLoc );
+        return;
+    }
+
+    bool          isRect = GetShape() == PAD_SHAPE::ROUNDRECT
+                           || GetShape() == PAD_SHAPE::CHAMFERED_RECT;
+    bool          doChamfer = GetShape() == PAD_SHAPE::CHAMFERED_RECT;
+    PAD_SHAPE_KEY key;
+
+    key.m_shape = GetShape();
+    key.m_size = m_size;
+    key.m_deltaSize = GetShape() == PAD_SHAPE::TRAPEZOID ? m_deltaSize : VECTOR2I( 0, 0 );
+    key.m_orientation = GetShape() == PAD_SHAPE::CIRCLE ? 0.0 : m_orient.AsDegrees();
+    key.m_cornerRadius = isRect ? GetRoundRectCornerRadius() : 0;
+    key.m_chamferRatio = doChamfer ? GetChamferRectRatio() : 0.0;
+    key.m_chamferPositions = doChamfer ? GetChamferPositions() : 0;
+    key.m_clearance = aClearance;
+    key.m_maxError = aMaxError;
+    key.m_errorLoc = aErrorLoc;
+
+    std::shared_ptr<const SHAPE_POLY_SET> localOutline = board->m_PadShapeCache.Get( key,
+            [&]( SHAPE_POLY_SET& aOutline )
+            {
+                transformShapeToPolygon( aOutline, VECTOR2I( 0, 0 ), aClearance, aMaxError,
+                                         aErrorLoc );
+            } );
+
+    SHAPE_POLY_SET outline( *localOutline );
+    outline.Move( padShapePos );
+    aBuffer.Append( outline );
+}
+
+
+void PAD::transformShapeToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aShapePos,
+                                   int aClearance, int aMaxError, ERROR_LOC aErrorLoc ) const
+{
     // minimal segment count to approximate a circle to create the polygonal pad shape
     // This minimal value is mainly for very small pads, like SM0402.
     // Most of time pads are using the segment count given by aError value.
@@ -1598,8 +1639,7 @@ void PAD::TransformShapeToPolygon( SHAPE_POLY_SET& aBuffer, PCB_LAYER_ID aLayer,
     int       dx = m_size.x / 2;
     int       dy = m_size.y / 2;
 
-    VECTOR2I padShapePos = ShapePos();    // Note: for pad having a shape offset, the pad
-                                          //   position is NOT the shape position
+    const VECTOR2I& padShapePos = aShapePos;
 
     switch( GetShape() )
     {
@@ -737,6 +737,12 @@ private:
     void addPadPrimitivesToPolygon( SHAPE_POLY_SET* aMergedPolygon, int aError,
                                     ERROR_LOC aErrorLoc ) const;
 
+    /**
+     * The uncached part of TransformShapeToPolygon(), with the pad shape at \a aShapePos.
+     */
+    void transformShapeToPolygon( SHAPE_POLY_SET& aBuffer, const VECTOR2I& aShapePos,
+                                  int aClearance, int aMaxError, ERROR_LOC aErrorLoc ) const;
+
 private:
     wxString      m_number;             // Pad name (pin number in schematic)
     wxString      m_pinFunction;        // Pin name in schematic
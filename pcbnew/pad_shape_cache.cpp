@@ -0,0 +1,73 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include "pad_shape_cache.h"
+
+
+std::shared_ptr<const SHAPE_POLY_SET>
+PAD_SHAPE_CACHE::Get( const PAD_SHAPE_KEY& aKey,
+                      const std::function<void( SHAPE_POLY_SET& )>& aBuilder )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto                        it = m_outlines.find( aKey );
+
+        if( it != m_outlines.end() )
+            return it->second;
+    }
+
+    // Build outside of the lock: conversions are slow and other threads may want other pads.
+    // If two threads race on the same key, the first one to finish wins.
+    std::shared_ptr<SHAPE_POLY_SET> outline = std::make_shared<SHAPE_POLY_SET>();
+    aBuilder( *outline );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_outlines.emplace( aKey, std::move( outline ) ).first->second;
+}
+
+
+void PAD_SHAPE_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_outlines.clear();
+}
+
+
+size_t PAD_SHAPE_CACHE::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_outlines.size();
+}
+
+
+size_t PAD_SHAPE_CACHE::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    size_t                      bytes = 0;
+
+    for( const auto& [key, outline] : m_outlines )
+        bytes += sizeof( key ) + sizeof( SHAPE_POLY_SET ) + outline->GetOutlineMemoryUsage();
+
+    return bytes;
+}
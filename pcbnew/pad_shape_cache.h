@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PAD_SHAPE_CACHE_H
+#define PAD_SHAPE_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <geometry/geometry_utils.h>
+#include <hash.h>
+#include <math/vector2d.h>
+#include <pad_shapes.h>
+
+class SHAPE_POLY_SET;
+
+
+/**
+ * Everything the polygonal outline of a (non custom) pad depends on, apart from its position.
+ */
+struct PAD_SHAPE_KEY
+{
+    PAD_SHAPE m_shape;
+    VECTOR2I  m_size;
+    VECTOR2I  m_deltaSize;
+    double    m_orientation;        ///< in degrees
+    int       m_cornerRadius;
+    double    m_chamferRatio;
+    int       m_chamferPositions;
+    int       m_clearance;
+    int       m_maxError;
+    ERROR_LOC m_errorLoc;
+
+    bool operator==( const PAD_SHAPE_KEY& aOther ) const
+    {
+        return m_shape == aOther.m_shape && m_size == aOther.m_size
+               && m_deltaSize == aOther.m_deltaSize && m_orientation == aOther.m_orientation
+               && m_cornerRadius == aOther.m_cornerRadius
+               && m_chamferRatio == aOther.m_chamferRatio
+               && m_chamferPositions == aOther.m_chamferPositions
+               && m_clearance == aOther.m_clearance && m_maxError == aOther.m_maxError
+               && m_errorLoc == aOther.m_errorLoc;
+    }
+};
+
+
+namespace std
+{
+    template <>
+    struct hash<PAD_SHAPE_KEY>
+    {
+        std::size_t operator()( const PAD_SHAPE_KEY& aKey ) const
+        {
+            return hash_val( static_cast<int>( aKey.m_shape ), aKey.m_size.x, aKey.m_size.y,
+                             aKey.m_deltaSize.x, aKey.m_deltaSize.y, aKey.m_orientation,
+                             aKey.m_cornerRadius, aKey.m_chamferRatio, aKey.m_chamferPositions,
+                             aKey.m_clearance, aKey.m_maxError,
+                             static_cast<int>( aKey.m_errorLoc ) );
+        }
+    };
+}
+
+
+/**
+ * Polygonal pad outlines shared by all the pads of a board with the same geometry.
+ *
+ * A board with thousands of identical pads otherwise converts the same outline thousands of
+ * times for each consumer (effective polygons, zone knockouts, 3D layers...).  The cache holds
+ * one immutable outline per PAD_SHAPE_KEY, built with the pad shape position at the origin;
+ * pads only translate a copy to their own position, which gives exactly the result of
+ * converting them in place.
+ *
+ * Thread-safe.  The board clears it whenever its contents change, so stale geometries don't
+ * pile up during editing.
+ */
+class PAD_SHAPE_CACHE
+{
+public:
+    /**
+     * @return the outline for \a aKey, calling \a aBuilder to build it if it isn't cached yet.
+     */
+    std::shared_ptr<const SHAPE_POLY_SET>
+    Get( const PAD_SHAPE_KEY& aKey, const std::function<void( SHAPE_POLY_SET& )>& aBuilder );
+
+    void Clear();
+
+    size_t GetEntryCount() const;
+
+    /**
+     * @return the estimated memory held by the cached outlines, in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    mutable std::mutex                                                          m_mutex;
+    std::unordered_map<PAD_SHAPE_KEY, std::shared_ptr<const SHAPE_POLY_SET>>    m_outlines;
+};
+
+#endif // PAD_SHAPE_CACHE_H
@@ -236,6 +236,12 @@ PCB_DRAW_PANEL_GAL::PCB_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
     // This fixes the zoom in and zoom out limits:
     m_view->SetScaleLimits( ZOOM_MAX_LIMIT_PCBNEW, ZOOM_MIN_LIMIT_PCBNEW );
 
+    // Zoomed out beyond 50 um per pixel, zone fills, texts and arcs are drawn with less detail
+    m_view->SetDetailPixelSize( pcbIUScale.mmToIU( 0.05 ) );
+
+    // Editing a few items only redraws the area around them
+    m_view->UsePartialRedraw( true );
+
     setDefaultLayerOrder();
     setDefaultLayerDeps();
 
@@ -528,7 +534,13 @@ void PCB_DRAW_PANEL_GAL::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame,
     int           viaCount = 0;
     int           trackSegmentCount = 0;
     std::set<int> netCodes;
-    int           unconnected = (int) board->GetConnectivity()->GetUnconnectedCount( true );
+    wxString      unconnected;
+
+    // Don't wait for a ratsnest computed in the background; the panel is updated once it's done
+    if( board->GetConnectivity()->IsRatsnestPending() )
+        unconnected = wxS( "..." );
+    else
+        unconnected << board->GetConnectivity()->GetUnconnectedCount( true );
 
     for( PCB_TRACK* item : board->Tracks() )
     {
@@ -556,7 +568,7 @@ void PCB_DRAW_PANEL_GAL::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame,
     aList.emplace_back( _( "Vias" ), wxString::Format( wxT( "%d" ), viaCount ) );
     aList.emplace_back( _( "Track Segments" ), wxString::Format( wxT( "%d" ), trackSegmentCount ) );
     aList.emplace_back( _( "Nets" ), wxString::Format( wxT( "%d" ), (int) netCodes.size() ) );
-    aList.emplace_back( _( "Unrouted" ), wxString::Format( wxT( "%d" ), unconnected ) );
+    aList.emplace_back( _( "Unrouted" ), unconnected );
 }
 
 
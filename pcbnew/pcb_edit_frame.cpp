@@ -819,6 +819,12 @@ void PCB_EDIT_FRAME::setupUIConditions()
                 return GetPcbNewSettings()->m_Display.m_DisplayRatsnestLinesCurved;
             };
 
+    auto backgroundDRCCond =
+            [this] (const SELECTION& )
+            {
+                return GetPcbNewSettings()->m_BackgroundDRC;
+            };
+
     auto netHighlightCond =
             [this]( const SELECTION& )
             {
@@ -839,6 +845,7 @@ void PCB_EDIT_FRAME::setupUIConditions()
     mgr->SetConditions( PCB_ACTIONS::showLayersManager,    CHECK( layerManagerCond ) );
     mgr->SetConditions( PCB_ACTIONS::showRatsnest,         CHECK( globalRatsnestCond ) );
     mgr->SetConditions( PCB_ACTIONS::ratsnestLineMode,     CHECK( curvedRatsnestCond ) );
+    mgr->SetConditions( PCB_ACTIONS::toggleBackgroundDRC,  CHECK( backgroundDRCCond ) );
     mgr->SetConditions( PCB_ACTIONS::toggleNetHighlight,   CHECK( netHighlightCond )
                                                            .Enable( enableNetHighlightCond ) );
     mgr->SetConditions( PCB_ACTIONS::showProperties,       CHECK( propertiesCond ) );
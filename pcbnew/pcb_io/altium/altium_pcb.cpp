@@ -35,6 +35,7 @@
 #include <pcb_text.h>
 #include <pcb_track.h>
 #include <core/profile.h>
+#include <core/thread_pool.h>
 #include <string_utils.h>
 #include <zone.h>
 
@@ -468,6 +469,8 @@ void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFi
         }
     }
 
+    decodePrimitiveStreams( altiumPcbFile, aFileMapping );
+
     // Parse data in specified order
     for( const std::tuple<bool, ALTIUM_PCB_DIR, PARSE_FUNCTION_POINTER_fp>& cur : parserOrder )
     {
@@ -505,6 +508,8 @@ void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFi
         }
     }
 
+    m_decodedStreams.clear();
+
     // fixup zone priorities since Altium stores them in the opposite order
     for( ZONE* zone : m_polygons )
     {
@@ -541,7 +546,7 @@ void ALTIUM_PCB::Parse( const ALTIUM_COMPOUND_FILE&                  altiumPcbFi
             if( !zone->HasFilledPolysForLayer( layer ) )
                 continue;
 
-            zone->GetFilledPolysList( layer )->Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+            zone->GetFill( layer )->Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
         }
     }
 
@@ -789,6 +794,132 @@ FOOTPRINT* ALTIUM_PCB::ParseFootprint( ALTIUM_COMPOUND_FILE& altiumLibFile,
     return footprint.release();
 }
 
+template <typename RECORD, typename... ARGS>
+static std::vector<RECORD> decodeRecords( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
+                                          const CFB::COMPOUND_FILE_ENTRY* aEntry,
+                                          const char* aStreamName, ARGS... aArgs )
+{
+    ALTIUM_PARSER       reader( aAltiumPcbFile, aEntry );
+    std::vector<RECORD> records;
+
+    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+        records.emplace_back( reader, aArgs... );
+
+    if( reader.GetRemainingBytes() != 0 )
+    {
+        THROW_IO_ERROR( wxString::Format( wxT( "%s stream is not fully parsed" ),
+                                          aStreamName ) );
+    }
+
+    return records;
+}
+
+
+void ALTIUM_PCB::decodePrimitiveStreams( const ALTIUM_COMPOUND_FILE&                  aAltiumPcbFile,
+                                         const std::map<ALTIUM_PCB_DIR, std::string>& aFileMapping )
+{
+    typedef std::function<std::any( const CFB::COMPOUND_FILE_ENTRY* )> DECODE_FUNCTION;
+
+    const ALTIUM_COMPOUND_FILE& file = aAltiumPcbFile;
+
+    const std::vector<std::pair<ALTIUM_PCB_DIR, DECODE_FUNCTION>> decoders = {
+        { ALTIUM_PCB_DIR::ARCS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<AARC6>( file, aEntry, "Arcs6" ) );
+          } },
+        { ALTIUM_PCB_DIR::PADS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<APAD6>( file, aEntry, "Pads6" ) );
+          } },
+        { ALTIUM_PCB_DIR::VIAS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<AVIA6>( file, aEntry, "Vias6" ) );
+          } },
+        { ALTIUM_PCB_DIR::TRACKS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<ATRACK6>( file, aEntry, "Tracks6" ) );
+          } },
+        { ALTIUM_PCB_DIR::FILLS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<AFILL6>( file, aEntry, "Fills6" ) );
+          } },
+        { ALTIUM_PCB_DIR::SHAPEBASEDREGIONS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<AREGION6>( file, aEntry, "ShapeBasedRegions6",
+                                                        true ) );
+          } },
+        { ALTIUM_PCB_DIR::REGIONS6,
+          [&file]( auto aEntry )
+          {
+              return std::any( decodeRecords<AREGION6>( file, aEntry, "Regions6", false ) );
+          } }
+    };
+
+    std::vector<std::tuple<const DECODE_FUNCTION*, const CFB::COMPOUND_FILE_ENTRY*,
+                           DECODED_STREAM*>> jobs;
+
+    for( const auto& [directory, decode] : decoders )
+    {
+        const auto& mappedDirectory = aFileMapping.find( directory );
+
+        if( mappedDirectory == aFileMapping.end() )
+            continue;
+
+        const CFB::COMPOUND_FILE_ENTRY* entry =
+                aAltiumPcbFile.FindStream( { mappedDirectory->second, "Data" } );
+
+        if( entry )
+            jobs.emplace_back( &decode, entry, &m_decodedStreams[directory] );
+    }
+
+    if( m_progressReporter )
+        m_progressReporter->Report( _( "Decoding primitives..." ) );
+
+    // Each job reads its stream on its own and frees it once its records are decoded
+    ParallelFor( jobs.size(),
+                 [&]( size_t aIndex )
+                 {
+                     const auto& [decode, entry, decoded] = jobs[aIndex];
+
+                     try
+                     {
+                         decoded->m_records = ( *decode )( entry );
+                     }
+                     catch( ... )
+                     {
+                         decoded->m_error = std::current_exception();
+                     }
+                 } );
+}
+
+
+template <typename RECORD, typename... ARGS>
+std::vector<RECORD> ALTIUM_PCB::takeRecords( ALTIUM_PCB_DIR aDirectory,
+                                             const ALTIUM_COMPOUND_FILE& aAltiumPcbFile,
+                                             const CFB::COMPOUND_FILE_ENTRY* aEntry,
+                                             const char* aStreamName, ARGS... aArgs )
+{
+    auto it = m_decodedStreams.find( aDirectory );
+
+    if( it == m_decodedStreams.end() )
+        return decodeRecords<RECORD>( aAltiumPcbFile, aEntry, aStreamName, aArgs... );
+
+    DECODED_STREAM decoded = std::move( it->second );
+    m_decodedStreams.erase( it );
+
+    if( decoded.m_error )
+        std::rethrow_exception( decoded.m_error );
+
+    return std::move( *std::any_cast<std::vector<RECORD>>( &decoded.m_records ) );
+}
+
+
 int ALTIUM_PCB::GetNetCode( uint16_t aId ) const
 {
     if( aId == ALTIUM_NET_UNCONNECTED )
@@ -1945,13 +2076,14 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data( const ALTIUM_COMPOUND_FILE&     aA
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading polygons..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AREGION6> records = takeRecords<AREGION6>( ALTIUM_PCB_DIR::SHAPEBASEDREGIONS6,
+                                                           aAltiumPcbFile, aEntry,
+                                                           "ShapeBasedRegions6", true );
 
-    /* TODO: use Header section of file */
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) records.size(); primitiveIndex++ )
     {
         checkpoint();
-        AREGION6 elem( reader, true );
+        const AREGION6& elem = records[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE
             || elem.kind == ALTIUM_REGION_KIND::BOARD_CUTOUT )
@@ -1965,9 +2097,6 @@ void ALTIUM_PCB::ParseShapeBasedRegions6Data( const ALTIUM_COMPOUND_FILE&     aA
             ConvertShapeBasedRegions6ToFootprintItem( footprint, elem, primitiveIndex );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "ShapeBasedRegions6 stream is not fully parsed" );
 }
 
 
@@ -2322,12 +2451,10 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFi
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading zone fills..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AREGION6& elem : takeRecords<AREGION6>( ALTIUM_PCB_DIR::REGIONS6, aAltiumPcbFile,
+                                                       aEntry, "Regions6", false ) )
     {
         checkpoint();
-        AREGION6 elem( reader, false );
 
         if( elem.polygon != ALTIUM_POLYGON_NONE )
         {
@@ -2385,9 +2512,6 @@ void ALTIUM_PCB::ParseRegions6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFi
             zone->SetNeedRefill( false );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Regions6 stream is not fully parsed" ) );
 }
 
 
@@ -2397,12 +2521,13 @@ void ALTIUM_PCB::ParseArcs6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading arcs..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<AARC6> records = takeRecords<AARC6>( ALTIUM_PCB_DIR::ARCS6, aAltiumPcbFile,
+                                                     aEntry, "Arcs6" );
 
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) records.size(); primitiveIndex++ )
     {
         checkpoint();
-        AARC6 elem( reader );
+        const AARC6& elem = records[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2414,9 +2539,6 @@ void ALTIUM_PCB::ParseArcs6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
             ConvertArcs6ToFootprintItem( footprint, elem, primitiveIndex, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Arcs6 stream is not fully parsed" );
 }
 
 
@@ -2640,12 +2762,10 @@ void ALTIUM_PCB::ParsePads6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading pads..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const APAD6& elem : takeRecords<APAD6>( ALTIUM_PCB_DIR::PADS6, aAltiumPcbFile, aEntry,
+                                                 "Pads6" ) )
     {
         checkpoint();
-        APAD6 elem( reader );
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -2657,9 +2777,6 @@ void ALTIUM_PCB::ParsePads6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
             ConvertPads6ToFootprintItem( footprint, elem );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Pads6 stream is not fully parsed" ) );
 }
 
 
@@ -3098,12 +3215,10 @@ void ALTIUM_PCB::ParseVias6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading vias..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AVIA6& elem : takeRecords<AVIA6>( ALTIUM_PCB_DIR::VIAS6, aAltiumPcbFile, aEntry,
+                                                 "Vias6" ) )
     {
         checkpoint();
-        AVIA6 elem( reader );
 
         PCB_VIA* via = new PCB_VIA( m_board );
         m_board->Add( via, ADD_MODE::APPEND );
@@ -3147,9 +3262,6 @@ void ALTIUM_PCB::ParseVias6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
         // we need VIATYPE set!
         via->SetLayerPair( start_klayer, end_klayer );
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( wxT( "Vias6 stream is not fully parsed" ) );
 }
 
 void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile,
@@ -3158,12 +3270,13 @@ void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFil
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading tracks..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
+    std::vector<ATRACK6> records = takeRecords<ATRACK6>( ALTIUM_PCB_DIR::TRACKS6, aAltiumPcbFile,
+                                                         aEntry, "Tracks6" );
 
-    for( int primitiveIndex = 0; reader.GetRemainingBytes() >= 4; primitiveIndex++ )
+    for( int primitiveIndex = 0; primitiveIndex < (int) records.size(); primitiveIndex++ )
     {
         checkpoint();
-        ATRACK6 elem( reader );
+        const ATRACK6& elem = records[primitiveIndex];
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -3175,9 +3288,6 @@ void ALTIUM_PCB::ParseTracks6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFil
             ConvertTracks6ToFootprintItem( footprint, elem, primitiveIndex, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Tracks6 stream is not fully parsed" );
 }
 
 
@@ -3528,12 +3638,10 @@ void ALTIUM_PCB::ParseFills6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile
     if( m_progressReporter )
         m_progressReporter->Report( _( "Loading rectangles..." ) );
 
-    ALTIUM_PARSER reader( aAltiumPcbFile, aEntry );
-
-    while( reader.GetRemainingBytes() >= 4 /* TODO: use Header section of file */ )
+    for( const AFILL6& elem : takeRecords<AFILL6>( ALTIUM_PCB_DIR::FILLS6, aAltiumPcbFile, aEntry,
+                                                   "Fills6" ) )
     {
         checkpoint();
-        AFILL6 elem( reader );
 
         if( elem.component == ALTIUM_COMPONENT_NONE )
         {
@@ -3545,9 +3653,6 @@ void ALTIUM_PCB::ParseFills6Data( const ALTIUM_COMPOUND_FILE&     aAltiumPcbFile
             ConvertFills6ToFootprintItem( footprint, elem, true );
         }
     }
-
-    if( reader.GetRemainingBytes() != 0 )
-        THROW_IO_ERROR( "Fills6 stream is not fully parsed" );
 }
 
 
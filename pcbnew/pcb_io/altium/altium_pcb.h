@@ -25,8 +25,11 @@
 #ifndef ALTIUM_PCB_H
 #define ALTIUM_PCB_H
 
+#include <any>
+#include <exception>
 #include <functional>
 #include <layer_ids.h>
+#include <map>
 #include <vector>
 
 #include <altium_parser_pcb.h>
@@ -118,6 +121,25 @@ public:
 private:
     void checkpoint();
 
+    /**
+     * Decode the records of the large primitive streams (arcs, pads, vias, tracks, fills and
+     * regions) on the thread pool.  Their records depend neither on the board nor on each
+     * other, so only their conversion to board items has to happen in the parser order.
+     */
+    void decodePrimitiveStreams( const ALTIUM_COMPOUND_FILE&                  aAltiumPcbFile,
+                                 const std::map<ALTIUM_PCB_DIR, std::string>& aFileMapping );
+
+    /**
+     * @return the records of \a aDirectory decoded by decodePrimitiveStreams(), or else the
+     *         records of \a aEntry decoded now.  Decoding errors are thrown here, so that they
+     *         are reported in the parser order.
+     */
+    template <typename RECORD, typename... ARGS>
+    std::vector<RECORD> takeRecords( ALTIUM_PCB_DIR aDirectory,
+                                     const ALTIUM_COMPOUND_FILE& aAltiumPcbFile,
+                                     const CFB::COMPOUND_FILE_ENTRY* aEntry,
+                                     const char* aStreamName, ARGS... aArgs );
+
     PCB_LAYER_ID  GetKicadLayer( ALTIUM_LAYER aAltiumLayer ) const;
     std::vector<PCB_LAYER_ID> GetKicadLayersToIterate( ALTIUM_LAYER aAltiumLayer ) const;
     int           GetNetCode( uint16_t aId ) const;
@@ -250,6 +272,15 @@ private:
 
     std::map<ALTIUM_LAYER, ZONE*>        m_outer_plane;
 
+    struct DECODED_STREAM
+    {
+        std::any           m_records;   ///< std::vector of the records of the stream
+        std::exception_ptr m_error;     ///< set instead when the stream could not be decoded
+    };
+
+    /// Primitive streams decoded ahead of their conversion, until they are taken
+    std::map<ALTIUM_PCB_DIR, DECODED_STREAM> m_decodedStreams;
+
     PROGRESS_REPORTER* m_progressReporter; ///< optional; may be nullptr
     unsigned           m_doneCount;
     unsigned           m_lastProgressCount;
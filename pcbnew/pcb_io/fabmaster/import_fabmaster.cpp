@@ -33,6 +33,7 @@
 #include <memory>
 #include <string>
 #include <sstream>
+#include <tuple>
 #include <vector>
 #include <utility>
 
@@ -41,6 +42,7 @@
 #include <board.h>
 #include <board_design_settings.h>
 #include <board_item.h>
+#include <core/thread_pool.h>
 #include <footprint.h>
 #include <pad.h>
 #include <pad_shapes.h>
@@ -1966,473 +1968,519 @@ bool FABMASTER::loadZones( BOARD* aBoard )
 }
 
 
-bool FABMASTER::loadFootprints( BOARD* aBoard )
+FOOTPRINT* FABMASTER::loadFootprint( BOARD* aBoard, const COMPONENT& aSrc, int aIndex,
+                                     bool aHasMultiple )
 {
-    const NETNAMES_MAP& netinfo = aBoard->GetNetInfo().NetsByName();
     const auto& ds = aBoard->GetDesignSettings();
+    FOOTPRINT*  fp = new FOOTPRINT( aBoard );
 
-    for( auto& mod : components )
-    {
-        checkpoint();
+    wxString mod_ref = aSrc.name;
+    wxString lib_ref = m_filename.GetName();
 
-        bool has_multiple = mod.second.size() > 1;
+    if( aHasMultiple )
+        mod_ref.Append( wxString::Format( wxT( "_%d" ), aIndex ) );
 
-        for( int i = 0; i < mod.second.size(); ++i )
-        {
-            auto& src = mod.second[i];
+    ReplaceIllegalFileNameChars( lib_ref, '_' );
+    ReplaceIllegalFileNameChars( mod_ref, '_' );
 
-            FOOTPRINT* fp = new FOOTPRINT( aBoard );
+    wxString key = !lib_ref.empty() ? lib_ref + wxT( ":" ) + mod_ref : mod_ref;
 
-            wxString mod_ref = src->name;
-            wxString lib_ref = m_filename.GetName();
+    LIB_ID fpID;
+    fpID.Parse( key, true );
+    fp->SetFPID( fpID );
 
-            if( has_multiple )
-                mod_ref.Append( wxString::Format( wxT( "_%d" ), i ) );
+    fp->SetPosition( VECTOR2I( aSrc.x, aSrc.y ) );
+    fp->SetOrientationDegrees( -aSrc.rotate );
 
-            ReplaceIllegalFileNameChars( lib_ref, '_' );
-            ReplaceIllegalFileNameChars( mod_ref, '_' );
+    // KiCad netlisting requires parts to have non-digit + digit annotation.
+    // If the reference begins with a number, we prepend 'UNK' (unknown) for the source designator
+    wxString reference = aSrc.refdes;
 
-            wxString key = !lib_ref.empty() ? lib_ref + wxT( ":" ) + mod_ref : mod_ref;
+    if( !std::isalpha( aSrc.refdes[0] ) )
+        reference.Prepend( "UNK" );
 
-            LIB_ID fpID;
-            fpID.Parse( key, true );
-            fp->SetFPID( fpID );
+    fp->SetReference( reference );
 
-            fp->SetPosition( VECTOR2I( src->x, src->y ) );
-            fp->SetOrientationDegrees( -src->rotate );
+    fp->SetValue( aSrc.value );
+    fp->Value().SetLayer( F_Fab );
+    fp->Value().SetVisible( false );
 
-            // KiCad netlisting requires parts to have non-digit + digit annotation.
-            // If the reference begins with a number, we prepend 'UNK' (unknown) for the source designator
-            wxString reference = src->refdes;
+    if( auto ref_it = refdes_index.find( aSrc.refdes ); ref_it != refdes_index.end() )
+    {
+        for( const TRACE* ref : ref_it->second )
+        {
+            const GRAPHIC_TEXT *lsrc =
+                    static_cast<const GRAPHIC_TEXT*>( ( *( ref->segment.begin() ) ).get() );
 
-            if( !std::isalpha( src->refdes[0] ) )
-                reference.Prepend( "UNK" );
+            PCB_TEXT*    txt = nullptr;
+            PCB_LAYER_ID layer = getLayer( ref->layer );
 
-            fp->SetReference( reference );
+            if( !IsPcbLayer( layer ) )
+            {
+                wxLogDebug("The layer %s is not mapped?\n", ref->layer.c_str() );
+                continue;
+            }
 
-            fp->SetValue( src->value );
-            fp->Value().SetLayer( F_Fab );
-            fp->Value().SetVisible( false );
+            if( layer == F_SilkS || layer == B_SilkS )
+                txt = &( fp->Reference() );
+            else
+                txt = new PCB_TEXT( fp );
 
-            for( auto& ref : refdes )
+            if( aSrc.mirror )
             {
-                const GRAPHIC_TEXT *lsrc =
-                        static_cast<const GRAPHIC_TEXT*>( ( *( ref->segment.begin() ) ).get() );
+                txt->SetLayer( FlipLayer( layer ) );
+                txt->SetTextPos( VECTOR2I( lsrc->start_x, 2 * aSrc.y - ( lsrc->start_y - lsrc->height / 2 ) ) );
+            }
+            else
+            {
+                txt->SetLayer( layer );
+                txt->SetTextPos( VECTOR2I( lsrc->start_x, lsrc->start_y - lsrc->height / 2 ) );
+            }
 
-                if( lsrc->text == src->refdes )
-                {
-                    PCB_TEXT*    txt = nullptr;
-                    PCB_LAYER_ID layer = getLayer( ref->layer );
+            txt->SetText( lsrc->text );
+            txt->SetItalic( lsrc->ital );
+            txt->SetTextThickness( lsrc->thickness );
+            txt->SetTextHeight( lsrc->height );
+            txt->SetTextWidth( lsrc->width );
+            txt->SetHorizJustify( lsrc->orient );
 
-                    if( !IsPcbLayer( layer ) )
-                    {
-                        wxLogDebug("The layer %s is not mapped?\n", ref->layer.c_str() );
-                        continue;
-                    }
+            if( txt != &fp->Reference() )
+                fp->Add( txt, ADD_MODE::APPEND );
+        }
+    }
 
-                    if( layer == F_SilkS || layer == B_SilkS )
-                        txt = &( fp->Reference() );
-                    else
-                        txt = new PCB_TEXT( fp );
+    /// Always set the module to the top and flip later if needed
+    /// When flipping later, we get the full coordinate transform for free
+    fp->SetLayer( F_Cu );
 
-                    if( src->mirror )
-                    {
-                        txt->SetLayer( FlipLayer( layer ) );
-                        txt->SetTextPos( VECTOR2I( lsrc->start_x, 2 * src->y - ( lsrc->start_y - lsrc->height / 2 ) ) );
-                    }
-                    else
-                    {
-                        txt->SetLayer( layer );
-                        txt->SetTextPos( VECTOR2I( lsrc->start_x, lsrc->start_y - lsrc->height / 2 ) );
-                    }
+    auto gr_it = comp_graphics.find( aSrc.refdes );
 
-                    txt->SetText( lsrc->text );
-                    txt->SetItalic( lsrc->ital );
-                    txt->SetTextThickness( lsrc->thickness );
-                    txt->SetTextHeight( lsrc->height );
-                    txt->SetTextWidth( lsrc->width );
-                    txt->SetHorizJustify( lsrc->orient );
+    if( gr_it == comp_graphics.end() )
+    {
+        //TODO: Error
+        delete fp;
+        return nullptr;
+    }
 
-                    if( txt != &fp->Reference() )
-                        fp->Add( txt, ADD_MODE::APPEND );
-                }
-            }
+    for( auto& gr_ref : gr_it->second )
+    {
+        auto& graphic = gr_ref.second;
+
+        for( auto& seg : *graphic.elements )
+        {
+            PCB_LAYER_ID layer = Dwgs_User;
 
-            /// Always set the module to the top and flip later if needed
-            /// When flipping later, we get the full coordinate transform for free
-            fp->SetLayer( F_Cu );
+            if( IsPcbLayer( getLayer( seg->layer ) ) )
+                layer = getLayer( seg->layer );
 
-            auto gr_it = comp_graphics.find( src->refdes );
+            STROKE_PARAMS defaultStroke( ds.GetLineThickness( layer ) );
 
-            if( gr_it == comp_graphics.end() )
+            switch( seg->shape )
             {
-                continue;
-                //TODO: Error
-            }
 
-            for( auto& gr_ref : gr_it->second )
+            case GR_SHAPE_LINE:
             {
-                auto& graphic = gr_ref.second;
+                const GRAPHIC_LINE* lsrc = static_cast<const GRAPHIC_LINE*>( seg.get() );
 
-                for( auto& seg : *graphic.elements )
+                PCB_SHAPE* line = new PCB_SHAPE( fp, SHAPE_T::SEGMENT );
+
+                if( aSrc.mirror )
+                {
+                    line->SetLayer( FlipLayer( layer ) );
+                    line->SetStart( VECTOR2I( lsrc->start_x, 2 * aSrc.y - lsrc->start_y ) );
+                    line->SetEnd( VECTOR2I( lsrc->end_x, 2 * aSrc.y - lsrc->end_y ) );
+                }
+                else
                 {
-                    PCB_LAYER_ID layer = Dwgs_User;
+                    line->SetLayer( layer );
+                    line->SetStart( VECTOR2I( lsrc->start_x, lsrc->start_y ) );
+                    line->SetEnd( VECTOR2I( lsrc->end_x, lsrc->end_y ) );
+                }
 
-                    if( IsPcbLayer( getLayer( seg->layer ) ) )
-                        layer = getLayer( seg->layer );
+                line->SetStroke( STROKE_PARAMS( lsrc->width, LINE_STYLE::SOLID ) );
 
-                    STROKE_PARAMS defaultStroke( ds.GetLineThickness( layer ) );
+                line->Rotate( { 0, 0 }, fp->GetOrientation() );
+                line->Move( fp->GetPosition() );
 
-                    switch( seg->shape )
-                    {
+                if( lsrc->width == 0 )
+                    line->SetStroke( defaultStroke );
 
-                    case GR_SHAPE_LINE:
-                    {
-                        const GRAPHIC_LINE* lsrc = static_cast<const GRAPHIC_LINE*>( seg.get() );
+                fp->Add( line, ADD_MODE::APPEND );
+                break;
+            }
+            case GR_SHAPE_CIRCLE:
+            {
+                const GRAPHIC_ARC* lsrc = static_cast<const GRAPHIC_ARC*>( seg.get() );
 
-                        PCB_SHAPE* line = new PCB_SHAPE( fp, SHAPE_T::SEGMENT );
+                PCB_SHAPE* circle = new PCB_SHAPE( fp, SHAPE_T::CIRCLE );
 
-                        if( src->mirror )
-                        {
-                            line->SetLayer( FlipLayer( layer ) );
-                            line->SetStart( VECTOR2I( lsrc->start_x, 2 * src->y - lsrc->start_y ) );
-                            line->SetEnd( VECTOR2I( lsrc->end_x, 2 * src->y - lsrc->end_y ) );
-                        }
-                        else
-                        {
-                            line->SetLayer( layer );
-                            line->SetStart( VECTOR2I( lsrc->start_x, lsrc->start_y ) );
-                            line->SetEnd( VECTOR2I( lsrc->end_x, lsrc->end_y ) );
-                        }
+                circle->SetLayer( layer );
+                circle->SetCenter( VECTOR2I( lsrc->center_x, lsrc->center_y ) );
+                circle->SetEnd( VECTOR2I( lsrc->end_x, lsrc->end_y ) );
+                circle->SetWidth( lsrc->width );
 
-                        line->SetStroke( STROKE_PARAMS( lsrc->width, LINE_STYLE::SOLID ) );
+                circle->Rotate( { 0, 0 }, fp->GetOrientation() );
+                circle->Move( fp->GetPosition() );
 
-                        line->Rotate( { 0, 0 }, fp->GetOrientation() );
-                        line->Move( fp->GetPosition() );
+                if( lsrc->width == 0 )
+                    circle->SetWidth( ds.GetLineThickness( circle->GetLayer() ) );
 
-                        if( lsrc->width == 0 )
-                            line->SetStroke( defaultStroke );
+                if( aSrc.mirror )
+                    circle->Flip( circle->GetCenter(), false );
 
-                        fp->Add( line, ADD_MODE::APPEND );
-                        break;
-                    }
-                    case GR_SHAPE_CIRCLE:
-                    {
-                        const GRAPHIC_ARC* lsrc = static_cast<const GRAPHIC_ARC*>( seg.get() );
-
-                        PCB_SHAPE* circle = new PCB_SHAPE( fp, SHAPE_T::CIRCLE );
+                fp->Add( circle, ADD_MODE::APPEND );
+                break;
+            }
+            case GR_SHAPE_ARC:
+            {
+                const GRAPHIC_ARC* lsrc = static_cast<const GRAPHIC_ARC*>( seg.get() );
 
-                        circle->SetLayer( layer );
-                        circle->SetCenter( VECTOR2I( lsrc->center_x, lsrc->center_y ) );
-                        circle->SetEnd( VECTOR2I( lsrc->end_x, lsrc->end_y ) );
-                        circle->SetWidth( lsrc->width );
+                PCB_SHAPE* arc = new PCB_SHAPE( fp, SHAPE_T::ARC );
 
-                        circle->Rotate( { 0, 0 }, fp->GetOrientation() );
-                        circle->Move( fp->GetPosition() );
+                arc->SetLayer( layer );
+                arc->SetArcGeometry( lsrc->result.GetP0(),
+                                     lsrc->result.GetArcMid(),
+                                     lsrc->result.GetP1() );
+                arc->SetStroke( STROKE_PARAMS( lsrc->width, LINE_STYLE::SOLID ) );
 
-                        if( lsrc->width == 0 )
-                            circle->SetWidth( ds.GetLineThickness( circle->GetLayer() ) );
+                arc->Rotate( { 0, 0 }, fp->GetOrientation() );
+                arc->Move( fp->GetPosition() );
 
-                        if( src->mirror )
-                            circle->Flip( circle->GetCenter(), false );
+                if( lsrc->width == 0 )
+                    arc->SetStroke( defaultStroke );
 
-                        fp->Add( circle, ADD_MODE::APPEND );
-                        break;
-                    }
-                    case GR_SHAPE_ARC:
-                    {
-                        const GRAPHIC_ARC* lsrc = static_cast<const GRAPHIC_ARC*>( seg.get() );
+                if( aSrc.mirror )
+                    arc->Flip( arc->GetCenter(), false );
 
-                        PCB_SHAPE* arc = new PCB_SHAPE( fp, SHAPE_T::ARC );
+                fp->Add( arc, ADD_MODE::APPEND );
+                break;
+            }
+            case GR_SHAPE_RECTANGLE:
+            {
+                const GRAPHIC_RECTANGLE *lsrc =
+                        static_cast<const GRAPHIC_RECTANGLE*>( seg.get() );
 
-                        arc->SetLayer( layer );
-                        arc->SetArcGeometry( lsrc->result.GetP0(),
-                                             lsrc->result.GetArcMid(),
-                                             lsrc->result.GetP1() );
-                        arc->SetStroke( STROKE_PARAMS( lsrc->width, LINE_STYLE::SOLID ) );
+                PCB_SHAPE* rect = new PCB_SHAPE( fp, SHAPE_T::RECTANGLE );
 
-                        arc->Rotate( { 0, 0 }, fp->GetOrientation() );
-                        arc->Move( fp->GetPosition() );
+                if( aSrc.mirror )
+                {
+                    rect->SetLayer( FlipLayer( layer ) );
+                    rect->SetStart( VECTOR2I( lsrc->start_x, 2 * aSrc.y - lsrc->start_y ) );
+                    rect->SetEnd( VECTOR2I( lsrc->end_x, 2 * aSrc.y - lsrc->end_y ) );
+                }
+                else
+                {
+                    rect->SetLayer( layer );
+                    rect->SetStart( VECTOR2I( lsrc->start_x, lsrc->start_y ) );
+                    rect->SetEnd( VECTOR2I( lsrc->end_x, lsrc->end_y ) );
+                }
 
-                        if( lsrc->width == 0 )
-                            arc->SetStroke( defaultStroke );
+                rect->SetStroke( defaultStroke );
 
-                        if( src->mirror )
-                            arc->Flip( arc->GetCenter(), false );
+                rect->Rotate( { 0, 0 }, fp->GetOrientation() );
+                rect->Move( fp->GetPosition() );
 
-                        fp->Add( arc, ADD_MODE::APPEND );
-                        break;
-                    }
-                    case GR_SHAPE_RECTANGLE:
-                    {
-                        const GRAPHIC_RECTANGLE *lsrc =
-                                static_cast<const GRAPHIC_RECTANGLE*>( seg.get() );
+                fp->Add( rect, ADD_MODE::APPEND );
+                break;
+            }
+            case GR_SHAPE_TEXT:
+            {
+                const GRAPHIC_TEXT *lsrc =
+                        static_cast<const GRAPHIC_TEXT*>( seg.get() );
 
-                        PCB_SHAPE* rect = new PCB_SHAPE( fp, SHAPE_T::RECTANGLE );
+                PCB_TEXT* txt = new PCB_TEXT( fp );
 
-                        if( src->mirror )
-                        {
-                            rect->SetLayer( FlipLayer( layer ) );
-                            rect->SetStart( VECTOR2I( lsrc->start_x, 2 * src->y - lsrc->start_y ) );
-                            rect->SetEnd( VECTOR2I( lsrc->end_x, 2 * src->y - lsrc->end_y ) );
-                        }
-                        else
-                        {
-                            rect->SetLayer( layer );
-                            rect->SetStart( VECTOR2I( lsrc->start_x, lsrc->start_y ) );
-                            rect->SetEnd( VECTOR2I( lsrc->end_x, lsrc->end_y ) );
-                        }
+                if( aSrc.mirror )
+                {
+                    txt->SetLayer( FlipLayer( layer ) );
+                    txt->SetTextPos( VECTOR2I( lsrc->start_x, 2 * aSrc.y - ( lsrc->start_y - lsrc->height / 2 ) ) );
+                }
+                else
+                {
+                    txt->SetLayer( layer );
+                    txt->SetTextPos( VECTOR2I( lsrc->start_x, lsrc->start_y - lsrc->height / 2 ) );
+                }
 
-                        rect->SetStroke( defaultStroke );
+                txt->SetText( lsrc->text );
+                txt->SetItalic( lsrc->ital );
+                txt->SetTextThickness( lsrc->thickness );
+                txt->SetTextHeight( lsrc->height );
+                txt->SetTextWidth( lsrc->width );
+                txt->SetHorizJustify( lsrc->orient );
 
-                        rect->Rotate( { 0, 0 }, fp->GetOrientation() );
-                        rect->Move( fp->GetPosition() );
+                // FABMASTER doesn't have visibility flags but layers that are not silk should be hidden
+                // by default to prevent clutter.
+                if( txt->GetLayer() != F_SilkS && txt->GetLayer() != B_SilkS )
+                    txt->SetVisible( false );
 
-                        fp->Add( rect, ADD_MODE::APPEND );
-                        break;
-                    }
-                    case GR_SHAPE_TEXT:
-                    {
-                        const GRAPHIC_TEXT *lsrc =
-                                static_cast<const GRAPHIC_TEXT*>( seg.get() );
+                fp->Add( txt, ADD_MODE::APPEND );
+                break;
+            }
+            default:
+                continue;
+            }
+        }
+    }
 
-                        PCB_TEXT* txt = new PCB_TEXT( fp );
+    auto pin_it = pins.find( aSrc.refdes );
 
-                        if( src->mirror )
-                        {
-                            txt->SetLayer( FlipLayer( layer ) );
-                            txt->SetTextPos( VECTOR2I( lsrc->start_x, 2 * src->y - ( lsrc->start_y - lsrc->height / 2 ) ) );
-                        }
-                        else
-                        {
-                            txt->SetLayer( layer );
-                            txt->SetTextPos( VECTOR2I( lsrc->start_x, lsrc->start_y - lsrc->height / 2 ) );
-                        }
+    if( pin_it != pins.end() )
+    {
+        for( auto& pin : pin_it->second )
+        {
+            auto pin_net_it = pin_nets.find( std::make_pair( pin->refdes, pin->pin_number ) );
+            auto padstack = pads.find( pin->padstack );
+            std::string netname = "";
 
-                        txt->SetText( lsrc->text );
-                        txt->SetItalic( lsrc->ital );
-                        txt->SetTextThickness( lsrc->thickness );
-                        txt->SetTextHeight( lsrc->height );
-                        txt->SetTextWidth( lsrc->width );
-                        txt->SetHorizJustify( lsrc->orient );
+            if( pin_net_it != pin_nets.end() )
+                netname = pin_net_it->second.name;
 
-                        // FABMASTER doesn't have visibility flags but layers that are not silk should be hidden
-                        // by default to prevent clutter.
-                        if( txt->GetLayer() != F_SilkS && txt->GetLayer() != B_SilkS )
-                            txt->SetVisible( false );
+            NETINFO_ITEM* net = findNet( netname );
 
-                        fp->Add( txt, ADD_MODE::APPEND );
-                        break;
-                    }
-                    default:
-                        continue;
-                    }
-                }
-            }
+            std::unique_ptr<PAD> newpad = std::make_unique<PAD>( fp );
 
-            auto pin_it = pins.find( src->refdes );
+            if( net )
+                newpad->SetNet( net );
+            else
+                newpad->SetNetCode( 0 );
 
-            if( pin_it != pins.end() )
-            {
-                for( auto& pin : pin_it->second )
-                {
-                    auto pin_net_it = pin_nets.find( std::make_pair( pin->refdes, pin->pin_number ) );
-                    auto padstack = pads.find( pin->padstack );
-                    std::string netname = "";
+            newpad->SetX( pin->pin_x );
 
-                    if( pin_net_it != pin_nets.end() )
-                        netname = pin_net_it->second.name;
+            if( aSrc.mirror )
+                newpad->SetY( 2 * aSrc.y - pin->pin_y );
+            else
+                newpad->SetY( pin->pin_y );
 
-                    auto net_it = netinfo.find( netname );
+            newpad->SetNumber( pin->pin_number );
 
-                    std::unique_ptr<PAD> newpad = std::make_unique<PAD>( fp );
+            if( padstack == pads.end() )
+            {
+                wxLogError( _( "Unable to locate padstack %s in file %s\n" ),
+                              pin->padstack.c_str(), aBoard->GetFileName().wc_str() );
+                continue;
+            }
+            else
+            {
+                auto& pad = padstack->second;
 
-                    if( net_it != netinfo.end() )
-                        newpad->SetNet( net_it->second );
-                    else
-                        newpad->SetNetCode( 0 );
+                newpad->SetShape( pad.shape );
 
-                    newpad->SetX( pin->pin_x );
+                if( pad.shape == PAD_SHAPE::CUSTOM )
+                {
+                    // Choose the smaller dimension to ensure the base pad
+                    // is fully hidden by the custom pad
+                    int pad_size = std::min( pad.width, pad.height );
 
-                    if( src->mirror )
-                        newpad->SetY( 2 * src->y - pin->pin_y );
-                    else
-                        newpad->SetY( pin->pin_y );
+                    newpad->SetSize( VECTOR2I( pad_size / 2, pad_size / 2 ) );
 
-                    newpad->SetNumber( pin->pin_number );
+                    std::string custom_name = pad.custom_name + "_" + pin->refdes + "_" + pin->pin_number;
+                    auto custom_it = pad_shapes.find( custom_name );
 
-                    if( padstack == pads.end() )
+                    if( custom_it != pad_shapes.end() )
                     {
-                        wxLogError( _( "Unable to locate padstack %s in file %s\n" ),
-                                      pin->padstack.c_str(), aBoard->GetFileName().wc_str() );
-                        continue;
-                    }
-                    else
-                    {
-                        auto& pad = padstack->second;
 
-                        newpad->SetShape( pad.shape );
+                        SHAPE_POLY_SET poly_outline;
+                        int last_subseq = 0;
+                        int hole_idx = -1;
 
-                        if( pad.shape == PAD_SHAPE::CUSTOM )
-                        {
-                            // Choose the smaller dimension to ensure the base pad
-                            // is fully hidden by the custom pad
-                            int pad_size = std::min( pad.width, pad.height );
+                        poly_outline.NewOutline();
 
-                            newpad->SetSize( VECTOR2I( pad_size / 2, pad_size / 2 ) );
+                        // Custom pad shapes have a group of elements
+                        // that are a list of graphical polygons
+                        for( const auto& el : (*custom_it).second.elements )
+                        {
+                            // For now, we are only processing the custom pad for the top layer
+                            // TODO: Use full padstacks when implementing in KiCad
+                            PCB_LAYER_ID primary_layer = aSrc.mirror ? B_Cu : F_Cu;
 
-                            std::string custom_name = pad.custom_name + "_" + pin->refdes + "_" + pin->pin_number;
-                            auto custom_it = pad_shapes.find( custom_name );
+                            if( getLayer( ( *( el.second.begin() ) )->layer ) != primary_layer )
+                                continue;
 
-                            if( custom_it != pad_shapes.end() )
+                            for( const auto& seg : el.second )
                             {
-
-                                SHAPE_POLY_SET poly_outline;
-                                int last_subseq = 0;
-                                int hole_idx = -1;
-
-                                poly_outline.NewOutline();
-
-                                // Custom pad shapes have a group of elements
-                                // that are a list of graphical polygons
-                                for( const auto& el : (*custom_it).second.elements )
+                                if( seg->subseq > 0 || seg->subseq != last_subseq )
                                 {
-                                    // For now, we are only processing the custom pad for the top layer
-                                    // TODO: Use full padstacks when implementing in KiCad
-                                    PCB_LAYER_ID primary_layer = src->mirror ? B_Cu : F_Cu;
-
-                                    if( getLayer( ( *( el.second.begin() ) )->layer ) != primary_layer )
-                                        continue;
-
-                                    for( const auto& seg : el.second )
-                                    {
-                                        if( seg->subseq > 0 || seg->subseq != last_subseq )
-                                        {
-                                            poly_outline.Polygon(0).back().SetClosed( true );
-                                            hole_idx = poly_outline.AddHole( SHAPE_LINE_CHAIN{} );
-                                        }
-
-                                        if( seg->shape == GR_SHAPE_LINE )
-                                        {
-                                            const GRAPHIC_LINE* src = static_cast<const GRAPHIC_LINE*>( seg.get() );
-
-                                            if( poly_outline.VertexCount( 0, hole_idx ) == 0 )
-                                                poly_outline.Append( src->start_x, src->start_y, 0, hole_idx );
-
-                                            poly_outline.Append( src->end_x, src->end_y, 0, hole_idx );
-                                        }
-                                        else if( seg->shape == GR_SHAPE_ARC )
-                                        {
-                                            const GRAPHIC_ARC* src = static_cast<const GRAPHIC_ARC*>( seg.get() );
-                                            SHAPE_LINE_CHAIN&  chain = poly_outline.Hole( 0, hole_idx );
-
-                                            chain.Append( src->result );
-                                        }
-                                    }
+                                    poly_outline.Polygon(0).back().SetClosed( true );
+                                    hole_idx = poly_outline.AddHole( SHAPE_LINE_CHAIN{} );
                                 }
 
-                                if( poly_outline.OutlineCount() < 1
-                                        || poly_outline.Outline( 0 ).PointCount() < 3 )
+                                if( seg->shape == GR_SHAPE_LINE )
                                 {
-                                    wxLogError( _( "Invalid custom pad '%s'. Replacing with "
-                                                   "circular pad." ),
-                                                custom_name.c_str() );
-                                    newpad->SetShape( PAD_SHAPE::CIRCLE );
-                                }
-                                else
-                                {
-                                    poly_outline.Fracture( SHAPE_POLY_SET::POLYGON_MODE::PM_FAST );
-
-                                    poly_outline.Move( -newpad->GetPosition() );
+                                    const GRAPHIC_LINE* src = static_cast<const GRAPHIC_LINE*>( seg.get() );
 
-                                    if( src->mirror )
-                                    {
-                                        poly_outline.Mirror( false, true, VECTOR2I( 0, ( pin->pin_y - src->y ) ) );
-                                        poly_outline.Rotate( EDA_ANGLE( src->rotate - pin->rotation, DEGREES_T ) );
-                                    }
-                                    else
-                                    {
-                                        poly_outline.Rotate( EDA_ANGLE( -src->rotate + pin->rotation, DEGREES_T ) );
-                                    }
+                                    if( poly_outline.VertexCount( 0, hole_idx ) == 0 )
+                                        poly_outline.Append( src->start_x, src->start_y, 0, hole_idx );
 
-                                    newpad->AddPrimitivePoly( poly_outline, 0, true );
+                                    poly_outline.Append( src->end_x, src->end_y, 0, hole_idx );
                                 }
-
-                                SHAPE_POLY_SET mergedPolygon;
-                                newpad->MergePrimitivesAsPolygon( &mergedPolygon );
-
-                                if( mergedPolygon.OutlineCount() > 1 )
+                                else if( seg->shape == GR_SHAPE_ARC )
                                 {
-                                    wxLogError( _( "Invalid custom pad '%s'. Replacing with "
-                                                   "circular pad." ),
-                                                custom_name.c_str() );
-                                    newpad->SetShape( PAD_SHAPE::CIRCLE );
+                                    const GRAPHIC_ARC* src = static_cast<const GRAPHIC_ARC*>( seg.get() );
+                                    SHAPE_LINE_CHAIN&  chain = poly_outline.Hole( 0, hole_idx );
+
+                                    chain.Append( src->result );
                                 }
                             }
-                            else
-                            {
-                                wxLogError( _( "Could not find custom pad '%s'." ),
-                                            custom_name.c_str() );
-                            }
                         }
-                        else
-                            newpad->SetSize( VECTOR2I( pad.width, pad.height ) );
 
-                        if( pad.drill )
+                        if( poly_outline.OutlineCount() < 1
+                                || poly_outline.Outline( 0 ).PointCount() < 3 )
                         {
-                            if( pad.plated )
+                            wxLogError( _( "Invalid custom pad '%s'. Replacing with "
+                                           "circular pad." ),
+                                        custom_name.c_str() );
+                            newpad->SetShape( PAD_SHAPE::CIRCLE );
+                        }
+                        else
+                        {
+                            poly_outline.Fracture( SHAPE_POLY_SET::POLYGON_MODE::PM_FAST );
+
+                            poly_outline.Move( -newpad->GetPosition() );
+
+                            if( aSrc.mirror )
                             {
-                                newpad->SetAttribute( PAD_ATTRIB::PTH );
-                                newpad->SetLayerSet( PAD::PTHMask() );
+                                poly_outline.Mirror( false, true, VECTOR2I( 0, ( pin->pin_y - aSrc.y ) ) );
+                                poly_outline.Rotate( EDA_ANGLE( aSrc.rotate - pin->rotation, DEGREES_T ) );
                             }
                             else
                             {
-                                newpad->SetAttribute( PAD_ATTRIB::NPTH );
-                                newpad->SetLayerSet( PAD::UnplatedHoleMask() );
+                                poly_outline.Rotate( EDA_ANGLE( -aSrc.rotate + pin->rotation, DEGREES_T ) );
                             }
 
-                            if( pad.drill_size_x == pad.drill_size_y )
-                                newpad->SetDrillShape( PAD_DRILL_SHAPE_CIRCLE );
-                            else
-                                newpad->SetDrillShape( PAD_DRILL_SHAPE_OBLONG );
-
-                            newpad->SetDrillSize( VECTOR2I( pad.drill_size_x, pad.drill_size_y ) );
+                            newpad->AddPrimitivePoly( poly_outline, 0, true );
                         }
-                        else
-                        {
-                            newpad->SetAttribute( PAD_ATTRIB::SMD );
 
-                            if( pad.top )
-                                newpad->SetLayerSet( PAD::SMDMask() );
-                            else if( pad.bottom )
-                                newpad->SetLayerSet( FlipLayerMask( PAD::SMDMask() ) );
+                        SHAPE_POLY_SET mergedPolygon;
+                        newpad->MergePrimitivesAsPolygon( &mergedPolygon );
+
+                        if( mergedPolygon.OutlineCount() > 1 )
+                        {
+                            wxLogError( _( "Invalid custom pad '%s'. Replacing with "
+                                           "circular pad." ),
+                                        custom_name.c_str() );
+                            newpad->SetShape( PAD_SHAPE::CIRCLE );
                         }
                     }
-
-                    if( src->mirror )
-                        newpad->SetOrientation( EDA_ANGLE( -src->rotate + pin->rotation, DEGREES_T ) );
                     else
-                        newpad->SetOrientation( EDA_ANGLE( src->rotate - pin->rotation, DEGREES_T ) );
+                    {
+                        wxLogError( _( "Could not find custom pad '%s'." ),
+                                    custom_name.c_str() );
+                    }
+                }
+                else
+                    newpad->SetSize( VECTOR2I( pad.width, pad.height ) );
 
-                    if( newpad->GetSizeX() > 0 || newpad->GetSizeY() > 0 )
+                if( pad.drill )
+                {
+                    if( pad.plated )
                     {
-                        fp->Add( newpad.release(), ADD_MODE::APPEND );
+                        newpad->SetAttribute( PAD_ATTRIB::PTH );
+                        newpad->SetLayerSet( PAD::PTHMask() );
                     }
                     else
                     {
-                        wxLogError( _( "Invalid zero-sized pad ignored in\nfile: %s" ),
-                                    aBoard->GetFileName().wc_str() );
+                        newpad->SetAttribute( PAD_ATTRIB::NPTH );
+                        newpad->SetLayerSet( PAD::UnplatedHoleMask() );
                     }
+
+                    if( pad.drill_size_x == pad.drill_size_y )
+                        newpad->SetDrillShape( PAD_DRILL_SHAPE_CIRCLE );
+                    else
+                        newpad->SetDrillShape( PAD_DRILL_SHAPE_OBLONG );
+
+                    newpad->SetDrillSize( VECTOR2I( pad.drill_size_x, pad.drill_size_y ) );
+                }
+                else
+                {
+                    newpad->SetAttribute( PAD_ATTRIB::SMD );
+
+                    if( pad.top )
+                        newpad->SetLayerSet( PAD::SMDMask() );
+                    else if( pad.bottom )
+                        newpad->SetLayerSet( FlipLayerMask( PAD::SMDMask() ) );
                 }
             }
 
-            if( src->mirror )
+            if( aSrc.mirror )
+                newpad->SetOrientation( EDA_ANGLE( -aSrc.rotate + pin->rotation, DEGREES_T ) );
+            else
+                newpad->SetOrientation( EDA_ANGLE( aSrc.rotate - pin->rotation, DEGREES_T ) );
+
+            if( newpad->GetSizeX() > 0 || newpad->GetSizeY() > 0 )
+            {
+                fp->Add( newpad.release(), ADD_MODE::APPEND );
+            }
+            else
             {
-                fp->SetOrientationDegrees( 180.0 - src->rotate );
-                fp->Flip( fp->GetPosition(), true );
+                wxLogError( _( "Invalid zero-sized pad ignored in\nfile: %s" ),
+                            aBoard->GetFileName().wc_str() );
             }
+        }
+    }
+
+    if( aSrc.mirror )
+    {
+        fp->SetOrientationDegrees( 180.0 - aSrc.rotate );
+        fp->Flip( fp->GetPosition(), true );
+    }
+
+    return fp;
+}
+
+
+bool FABMASTER::loadFootprints( BOARD* aBoard )
+{
+    // The reference designator texts, by the reference they show, so that each footprint
+    // doesn't have to go through all of them
+    refdes_index.clear();
+
+    for( auto& ref : refdes )
+    {
+        const GRAPHIC_TEXT* lsrc =
+                static_cast<const GRAPHIC_TEXT*>( ( *( ref->segment.begin() ) ).get() );
+
+        refdes_index[lsrc->text].push_back( ref.get() );
+    }
+
+    std::vector<std::tuple<const COMPONENT*, int, bool>> jobs;
+
+    for( auto& mod : components )
+    {
+        bool has_multiple = mod.second.size() > 1;
 
-            aBoard->Add( fp, ADD_MODE::APPEND );
+        for( int i = 0; i < mod.second.size(); ++i )
+            jobs.emplace_back( mod.second[i].get(), i, has_multiple );
+    }
+
+    // Footprints only depend on the parsed tables, so they are built concurrently and added to
+    // the board in the file order afterwards
+    std::vector<FOOTPRINT*> footprints( jobs.size(), nullptr );
+
+    ParallelFor( jobs.size(),
+                 [&]( size_t aIndex )
+                 {
+                     const auto& [src, index, has_multiple] = jobs[aIndex];
+
+                     try
+                     {
+                         footprints[aIndex] = loadFootprint( aBoard, *src, index, has_multiple );
+                     }
+                     catch( ... )
+                     {
+                         wxLogError( _( "Unable to load footprint %s." ), src->refdes.c_str() );
+                     }
+                 } );
+
+    size_t next = 0;
+
+    for( auto& mod : components )
+    {
+        checkpoint();
+
+        for( size_t i = 0; i < mod.second.size(); ++i, ++next )
+        {
+            if( footprints[next] )
+                aBoard->Add( footprints[next], ADD_MODE::APPEND );
         }
     }
 
@@ -2472,22 +2520,21 @@ bool FABMASTER::loadLayers( BOARD* aBoard )
 
 bool FABMASTER::loadVias( BOARD* aBoard )
 {
-    const NETNAMES_MAP& netinfo = aBoard->GetNetInfo().NetsByName();
     const auto& ds = aBoard->GetDesignSettings();
 
     for( auto& via : vias )
     {
         checkpoint();
 
-        auto net_it = netinfo.find( via->net );
+        NETINFO_ITEM* net = findNet( via->net );
         auto padstack = pads.find( via->padstack );
 
         PCB_VIA* new_via = new PCB_VIA( aBoard );
 
         new_via->SetPosition( VECTOR2I( via->x, via->y ) );
 
-        if( net_it != netinfo.end() )
-            new_via->SetNet( net_it->second );
+        if( net )
+            new_via->SetNet( net );
 
         if( padstack == pads.end() )
         {
@@ -2527,14 +2574,35 @@ bool FABMASTER::loadNets( BOARD* aBoard )
         aBoard->Add( newnet, ADD_MODE::APPEND );
     }
 
+    // Look the nets up by the names used in the file, without converting them each time
+    const NETNAMES_MAP& netinfo = aBoard->GetNetInfo().NetsByName();
+
+    net_index.clear();
+
+    if( auto it = netinfo.find( wxEmptyString ); it != netinfo.end() )
+        net_index.emplace( "", it->second );
+
+    for( const std::string& net : netnames )
+    {
+        if( auto it = netinfo.find( net ); it != netinfo.end() )
+            net_index[net] = it->second;
+    }
+
     return true;
 }
 
 
+NETINFO_ITEM* FABMASTER::findNet( const std::string& aName ) const
+{
+    auto it = net_index.find( aName );
+
+    return it != net_index.end() ? it->second : nullptr;
+}
+
+
 bool FABMASTER::loadEtch( BOARD* aBoard, const std::unique_ptr<FABMASTER::TRACE>& aLine)
 {
-    const NETNAMES_MAP& netinfo = aBoard->GetNetInfo().NetsByName();
-    auto net_it = netinfo.find( aLine->netname );
+    NETINFO_ITEM* net = findNet( aLine->netname );
 
     int  last_subseq = 0;
     ZONE* new_zone = nullptr;
@@ -2556,8 +2624,8 @@ bool FABMASTER::loadEtch( BOARD* aBoard, const std::unique_ptr<FABMASTER::TRACE>
                 trk->SetEnd( VECTOR2I( src->end_x, src->end_y ) );
                 trk->SetWidth( src->width );
 
-                if( net_it != netinfo.end() )
-                    trk->SetNet( net_it->second );
+                if( net )
+                    trk->SetNet( net );
 
                 aBoard->Add( trk, ADD_MODE::APPEND );
             }
@@ -2569,8 +2637,8 @@ bool FABMASTER::loadEtch( BOARD* aBoard, const std::unique_ptr<FABMASTER::TRACE>
                 trk->SetLayer( layer );
                 trk->SetWidth( src->width );
 
-                if( net_it != netinfo.end() )
-                    trk->SetNet( net_it->second );
+                if( net )
+                    trk->SetNet( net );
 
                 aBoard->Add( trk, ADD_MODE::APPEND );
             }
@@ -2678,8 +2746,7 @@ bool FABMASTER::loadZone( BOARD* aBoard, const std::unique_ptr<FABMASTER::TRACE>
     SHAPE_POLY_SET* zone_outline = nullptr;
     ZONE* zone = nullptr;
 
-    const NETNAMES_MAP& netinfo = aBoard->GetNetInfo().NetsByName();
-    auto net_it = netinfo.find( aLine->netname );
+    NETINFO_ITEM* net = findNet( aLine->netname );
     PCB_LAYER_ID layer = Cmts_User;
     auto new_layer = getLayer( aLine->layer );
 
@@ -2689,8 +2756,8 @@ bool FABMASTER::loadZone( BOARD* aBoard, const std::unique_ptr<FABMASTER::TRACE>
     zone = new ZONE( aBoard );
     zone_outline = new SHAPE_POLY_SET;
 
-    if( net_it != netinfo.end() )
-        zone->SetNet( net_it->second );
+    if( net )
+        zone->SetNet( net );
 
     if( aLine->layer == "ALL" )
         zone->SetLayerSet( aBoard->GetLayerSet() & LSET::AllCuMask() );
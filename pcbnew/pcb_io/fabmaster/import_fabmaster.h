@@ -44,6 +44,8 @@
 
 enum PCB_LAYER_ID : int;
 class BOARD;
+class FOOTPRINT;
+class NETINFO_ITEM;
 class PROGRESS_REPORTER;
 
 class FABMASTER
@@ -502,6 +504,12 @@ private:
 
     std::map<std::string, std::set<std::unique_ptr<PIN>, PIN::BY_NUM>> pins;
 
+    /// Board nets by their name in the file, filled by loadNets()
+    std::unordered_map<std::string, NETINFO_ITEM*> net_index;
+
+    /// Reference designator texts by the reference they show, filled by loadFootprints()
+    std::unordered_map<std::string, std::vector<const TRACE*>> refdes_index;
+
     std::map<std::string, PCB_LAYER_ID> layer_map;
 
     section_type detectType( size_t aOffset );
@@ -581,6 +589,16 @@ private:
     bool loadPolygon( BOARD* aBoard, const std::unique_ptr<FABMASTER::TRACE>& aLine);
     bool loadFootprints( BOARD* aBoard );
 
+    /**
+     * Build the footprint of a component without adding it to the board, so that footprints
+     * can be built concurrently.
+     * @return the new footprint, or nullptr if the component has no graphics
+     */
+    FOOTPRINT* loadFootprint( BOARD* aBoard, const COMPONENT& aSrc, int aIndex,
+                              bool aHasMultiple );
+
+    NETINFO_ITEM* findNet( const std::string& aName ) const;
+
     SHAPE_POLY_SET loadShapePolySet( const graphic_element& aLine);
 
     PROGRESS_REPORTER*  m_progressReporter;  ///< optional; may be nullptr
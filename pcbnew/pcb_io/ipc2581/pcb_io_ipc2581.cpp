@@ -50,6 +50,7 @@
 #include <geometry/shape_poly_set.h>
 #include <geometry/shape_segment.h>
 
+#include <wx/filename.h>
 #include <wx/log.h>
 #include <wx/numformatter.h>
 #include <wx/mstream.h>
@@ -125,20 +126,20 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
     // that if possible.  When we share a parent and our next sibling is null,
     // then we are the last child and can just append to the end of the list.
 
-    static wxXmlNode* lastNode = nullptr;
     wxXmlNode* node = new wxXmlNode( wxXML_ELEMENT_NODE, aName );
 
-    if( lastNode && lastNode->GetParent() == aParent && lastNode->GetNext() == nullptr )
+    if( m_last_appended && m_last_appended->GetParent() == aParent
+            && m_last_appended->GetNext() == nullptr )
     {
         node->SetParent( aParent );
-        lastNode->SetNext( node );
+        m_last_appended->SetNext( node );
     }
     else
     {
         aParent->AddChild( node );
     }
 
-    lastNode = node;
+    m_last_appended = node;
 
     // Opening tag, closing tag, brackets and the closing slash
     m_total_bytes += 2 * aName.size() + 5;
@@ -147,6 +148,185 @@ wxXmlNode* PCB_IO_IPC2581::appendNode( wxXmlNode* aParent, const wxString& aName
 }
 
 
+void PCB_IO_IPC2581::spoolChildren( wxXmlNode* aNode )
+{
+    if( !aNode->GetChildren() )
+        return;
+
+    // Without a spool file, the nodes stay in memory
+    if( !m_spool )
+        return;
+
+    int depth = 1;
+
+    for( wxXmlNode* parent = aNode->GetParent();
+         parent && parent->GetType() == wxXML_ELEMENT_NODE; parent = parent->GetParent() )
+    {
+        ++depth;
+    }
+
+    std::string buffer;
+
+    for( wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        buffer += '\n';
+        buffer.append( 2 * depth, ' ' );
+        formatNode( buffer, child, depth, nullptr );
+    }
+
+    // A failed write is reported by writeDocument()
+    wxFileOffset start = m_spool->Tell();
+    m_spool->Write( buffer.data(), buffer.size() );
+
+    // Nodes are spooled one at a time, so the children of a node are contiguous in the file
+    auto [it, inserted] = m_spooled.emplace( aNode, std::make_pair( start, start ) );
+    wxASSERT( inserted || it->second.second == start );
+    it->second.second = m_spool->Tell();
+
+    wxXmlNode* child = aNode->GetChildren();
+
+    while( child )
+    {
+        wxXmlNode* next = child->GetNext();
+        delete child;
+        child = next;
+    }
+
+    aNode->SetChildren( nullptr );
+    m_last_appended = nullptr;
+}
+
+
+static void escapeXml( std::string& aBuffer, const wxString& aStr, bool aAttribute )
+{
+    const wxScopedCharBuffer utf8 = aStr.utf8_str();
+
+    for( size_t ii = 0; ii < utf8.length(); ++ii )
+    {
+        char c = utf8.data()[ii];
+
+        switch( c )
+        {
+        case '<':  aBuffer += "&lt;";   break;
+        case '>':  aBuffer += "&gt;";   break;
+        case '&':  aBuffer += "&amp;";  break;
+        case '\r': aBuffer += "&#xD;";  break;
+        case '"':  aBuffer += aAttribute ? "&quot;" : "\"";  break;
+        case '\t': aBuffer += aAttribute ? "&#x9;" : "\t";   break;
+        case '\n': aBuffer += aAttribute ? "&#xA;" : "\n";   break;
+        default:   aBuffer += c;        break;
+        }
+    }
+}
+
+
+void PCB_IO_IPC2581::formatNode( std::string& aBuffer, const wxXmlNode* aNode, int aDepth,
+                                 wxOutputStream* aStream )
+{
+    if( aNode->GetType() == wxXML_TEXT_NODE )
+    {
+        escapeXml( aBuffer, aNode->GetContent(), false );
+        return;
+    }
+
+    if( aNode->GetType() != wxXML_ELEMENT_NODE )
+        return;
+
+    aBuffer += '<';
+    aBuffer += aNode->GetName().utf8_str().data();
+
+    for( wxXmlAttribute* attr = aNode->GetAttributes(); attr; attr = attr->GetNext() )
+    {
+        aBuffer += ' ';
+        aBuffer += attr->GetName().utf8_str().data();
+        aBuffer += "=\"";
+        escapeXml( aBuffer, attr->GetValue(), true );
+        aBuffer += '"';
+    }
+
+    auto spooled = aStream ? m_spooled.find( aNode ) : m_spooled.end();
+
+    if( !aNode->GetChildren() && spooled == m_spooled.end() )
+    {
+        aBuffer += "/>";
+        return;
+    }
+
+    aBuffer += '>';
+
+    bool lastWasText = false;
+
+    for( const wxXmlNode* child = aNode->GetChildren(); child; child = child->GetNext() )
+    {
+        lastWasText = child->GetType() == wxXML_TEXT_NODE;
+
+        if( !lastWasText )
+        {
+            aBuffer += '\n';
+            aBuffer.append( 2 * ( aDepth + 1 ), ' ' );
+        }
+
+        formatNode( aBuffer, child, aDepth + 1, aStream );
+    }
+
+    if( spooled != m_spooled.end() )
+    {
+        aStream->Write( aBuffer.data(), aBuffer.size() );
+        aBuffer.clear();
+
+        std::vector<char> chunk( 1 << 20 );
+        wxFileOffset      remaining = spooled->second.second - spooled->second.first;
+
+        m_spool->Seek( spooled->second.first );
+
+        while( remaining > 0 && aStream->IsOk() )
+        {
+            size_t count = m_spool->Read( chunk.data(), std::min<wxFileOffset>( remaining,
+                                                                                chunk.size() ) );
+
+            if( count == 0 )
+                break;
+
+            aStream->Write( chunk.data(), count );
+            remaining -= count;
+        }
+
+        lastWasText = false;
+    }
+
+    if( !lastWasText )
+    {
+        aBuffer += '\n';
+        aBuffer.append( 2 * aDepth, ' ' );
+    }
+
+    aBuffer += "</";
+    aBuffer += aNode->GetName().utf8_str().data();
+    aBuffer += '>';
+
+    if( aStream && aBuffer.size() > ( 1 << 20 ) )
+    {
+        aStream->Write( aBuffer.data(), aBuffer.size() );
+        aBuffer.clear();
+    }
+}
+
+
+bool PCB_IO_IPC2581::writeDocument( wxOutputStream& aStream )
+{
+    std::string buffer = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+
+    if( m_spool )
+        m_spool->Flush();
+
+    formatNode( buffer, m_xml_root, 0, &aStream );
+    buffer += '\n';
+    aStream.Write( buffer.data(), buffer.size() );
+
+    return aStream.IsOk() && ( !m_spool || !m_spool->Error() );
+}
+
+
 wxString PCB_IO_IPC2581::genString( const wxString& aStr, const char* aPrefix ) const
 {
     wxString str;
@@ -660,7 +840,7 @@ void PCB_IO_IPC2581::addText( wxXmlNode* aContentNode, EDA_TEXT* aText, const KI
                 wxXmlNode* outline_node = appendNode( text_node, "Outline" );
                 wxXmlNode* poly_node = appendNode( outline_node, "Polygon" );
 
-                const std::vector<VECTOR2I>& pts = aPoly.CPoints();
+                const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = aPoly.CPoints();
                 wxXmlNode* point_node = appendNode( poly_node, "PolyBegin" );
                 addXY( point_node, pts.front() );
 
@@ -1744,7 +1924,7 @@ bool PCB_IO_IPC2581::addPolygonNode( wxXmlNode* aParentNode,
         polygonNode = appendNode( aParentNode, "Polygon" );
         wxXmlNode* polybeginNode = appendNode( polygonNode, "PolyBegin" );
 
-        const std::vector<VECTOR2I>& pts = aPolygon[0].CPoints();
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = aPolygon[0].CPoints();
         addXY( polybeginNode, pts[0] );
 
         for( size_t ii = 1; ii < pts.size(); ++ii )
@@ -1788,7 +1968,7 @@ bool PCB_IO_IPC2581::addPolygonCutouts( wxXmlNode* aParentNode, const SHAPE_POLY
         wxXmlNode* cutoutNode = appendNode( aParentNode, "Cutout" );
         wxXmlNode* polybeginNode = appendNode( cutoutNode, "PolyBegin" );
 
-        const std::vector<VECTOR2I>& hole = aPolygon[ii].CPoints();
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& hole = aPolygon[ii].CPoints();
         addXY( polybeginNode, hole[0] );
 
         for( size_t jj = 1; jj < hole.size(); ++jj )
@@ -2365,9 +2545,15 @@ void PCB_IO_IPC2581::generateLayerFeatures( wxXmlNode* aStepNode )
                 continue;
 
             generateLayerSetNet( layerNode, layer, vec );
+
+            // Fills make the feature sets the bulk of the file, so they are written out as
+            // soon as each net is done
+            spoolChildren( layerNode );
+            vec.clear();
+            vec.shrink_to_fit();
         }
 
-        if( layerNode->GetChildren() == nullptr )
+        if( layerNode->GetChildren() == nullptr && !m_spooled.count( layerNode ) )
         {
             aStepNode->RemoveChild( layerNode );
             delete layerNode;
@@ -2880,6 +3066,16 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     m_xml_doc = new wxXmlDocument();
     m_xml_root = generateXmlHeader();
 
+    m_spool_path = wxFileName::CreateTempFileName( wxS( "ipc2581" ) );
+
+    if( !m_spool_path.empty() )
+    {
+        m_spool = std::make_unique<wxFFile>( m_spool_path, wxS( "w+b" ) );
+
+        if( !m_spool->IsOpened() )
+            m_spool.reset();
+    }
+
     generateContentSection();
 
     if( m_progressReporter )
@@ -2928,7 +3124,22 @@ void PCB_IO_IPC2581::SaveBoard( const wxString& aFileName, BOARD* aBoard,
 
     out_stream.SetProgressCallback( update_progress );
 
-    if( !m_xml_doc->Save( out_stream ) )
+    bool saved = writeDocument( out_stream );
+
+    delete m_xml_doc;
+    m_xml_doc = nullptr;
+    m_xml_root = nullptr;
+    m_last_appended = nullptr;
+    m_spooled.clear();
+
+    m_spool.reset();
+
+    if( !m_spool_path.empty() )
+        wxRemoveFile( m_spool_path );
+
+    m_spool_path.clear();
+
+    if( !saved )
     {
         wxLogError( _( "Failed to save file to buffer" ) );
         return;
@@ -30,8 +30,10 @@
 #include <geometry/shape_segment.h>
 #include <stroke_params.h>
 
+#include <wx/ffile.h>
 #include <wx/xml/xml.h>
 #include <memory>
+#include <unordered_map>
 
 class BOARD;
 class BOARD_ITEM;
@@ -70,6 +72,7 @@ public:
         m_progress_reporter = nullptr;
         m_xml_doc = nullptr;
         m_xml_root = nullptr;
+        m_last_appended = nullptr;
     }
 
     ~PCB_IO_IPC2581() override;
@@ -281,6 +284,26 @@ private:
 
     void addLayerAttributes( wxXmlNode* aNode, PCB_LAYER_ID aLayer );
 
+    /**
+     * Serialize the children of \a aNode to the spool file and free them.  The children are
+     * written back in place of the (now empty) node when the document is saved, so that the
+     * per-net feature sets of a layer don't all have to be held in memory at once.
+     */
+    void spoolChildren( wxXmlNode* aNode );
+
+    /**
+     * Format \a aNode and its children, indented for \a aDepth, into \a aBuffer.  Follows the
+     * layout of wxXmlDocument::Save() with an indentation step of 2.  When \a aStream is given,
+     * the buffer is flushed to it as it grows and the spooled children are copied in.
+     */
+    void formatNode( std::string& aBuffer, const wxXmlNode* aNode, int aDepth,
+                     wxOutputStream* aStream );
+
+    /**
+     * Write the document to \a aStream, splicing in the spooled children.
+     */
+    bool writeDocument( wxOutputStream& aStream );
+
     bool isValidLayerFor2581( PCB_LAYER_ID aLayer );
 private:
     LAYER_MAPPING_HANDLER   m_layerMappingHandler;
@@ -306,20 +329,20 @@ private:
     std::vector<FOOTPRINT*> m_loaded_footprints;
     const STRING_UTF8_MAP*  m_props;
 
-    std::map<size_t, wxString> m_user_shape_dict;   //<! Map between shape hash values and reference id string
-    wxXmlNode*                 m_shape_user_node;   //<! Output XML node for reference shapes in UserDict
+    std::unordered_map<size_t, wxString> m_user_shape_dict;   //<! Map between shape hash values and reference id string
+    wxXmlNode*                           m_shape_user_node;   //<! Output XML node for reference shapes in UserDict
 
-    std::map<size_t, wxString> m_std_shape_dict;    //<! Map between shape hash values and reference id string
-    wxXmlNode*                 m_shape_std_node;    //<! Output XML node for reference shapes in StandardDict
+    std::unordered_map<size_t, wxString> m_std_shape_dict;    //<! Map between shape hash values and reference id string
+    wxXmlNode*                           m_shape_std_node;    //<! Output XML node for reference shapes in StandardDict
 
-    std::map<size_t, wxString> m_line_dict;         //<! Map between line hash values and reference id string
-    wxXmlNode*                 m_line_node;         //<! Output XML node for reference lines in LineDict
+    std::unordered_map<size_t, wxString> m_line_dict;         //<! Map between line hash values and reference id string
+    wxXmlNode*                           m_line_node;         //<! Output XML node for reference lines in LineDict
 
-    std::map<size_t, wxString> m_padstack_dict;     //<! Map between padstack hash values and reference id string (PADSTACK_##)
-    std::vector<wxXmlNode*>    m_padstacks;         //<! Holding vector for padstacks.  These need to be inserted prior to the components
-    wxXmlNode*                 m_last_padstack;     //<! Pointer to padstack list where we can insert the VIA padstacks once we process tracks
+    std::unordered_map<size_t, wxString> m_padstack_dict;     //<! Map between padstack hash values and reference id string (PADSTACK_##)
+    std::vector<wxXmlNode*>              m_padstacks;         //<! Holding vector for padstacks.  These need to be inserted prior to the components
+    wxXmlNode*                           m_last_padstack;     //<! Pointer to padstack list where we can insert the VIA padstacks once we process tracks
 
-    std::map<size_t, wxString>
+    std::unordered_map<size_t, wxString>
             m_footprint_dict; //<! Map between the footprint hash values and reference id string (<fpid>_##)
 
     std::map<wxString, FOOTPRINT*>
@@ -349,6 +372,13 @@ private:
 
     wxXmlDocument*          m_xml_doc;
     wxXmlNode*              m_xml_root;
+    wxXmlNode*              m_last_appended;    //<! Last node added by appendNode()
+
+    wxString                m_spool_path;       //<! Temporary file holding the spooled nodes
+    std::unique_ptr<wxFFile> m_spool;
+
+    std::unordered_map<const wxXmlNode*, std::pair<wxFileOffset, wxFileOffset>>
+            m_spooled; //<! Range of the spool file holding the children of a spooled node
 };
 
 #endif // PCB_IO_IPC2581_H_
\ No newline at end of file
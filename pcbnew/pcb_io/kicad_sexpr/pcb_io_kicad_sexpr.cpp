@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <set>
+
 #include <advanced_config.h>
 #include <board.h>
 #include <board_design_settings.h>
@@ -31,6 +33,8 @@
 #include <kiface_base.h>
 #include <locale_io.h>
 #include <macros.h>
+#include <core/thread_pool.h>
+#include <core/trace_profiler.h>
 #include <fmt/core.h>
 #include <callback_gal.h>
 #include <pad.h>
@@ -49,6 +53,8 @@
 #include <pgm_base.h>
 #include <io/kicad/kicad_io_utils.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_board_cache.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_lib_index.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
 #include <trace_helpers.h>
 #include <progress_reporter.h>
@@ -69,9 +75,11 @@
 using namespace PCB_KEYS_T;
 
 
-FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName ) :
+FP_CACHE_ITEM::FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName,
+                              long long aTimestamp ) :
         m_filename( aFileName ),
-        m_footprint( aFootprint )
+        m_footprint( aFootprint ),
+        m_timestamp( aTimestamp )
 { }
 
 
@@ -81,6 +89,7 @@ FP_CACHE::FP_CACHE( PCB_IO_KICAD_SEXPR* aOwner, const wxString& aLibraryPath )
     m_lib_raw_path = aLibraryPath;
     m_lib_path.SetPath( aLibraryPath );
     m_cache_timestamp = 0;
+    m_complete = false;
     m_cache_dirty = true;
 }
 
@@ -145,6 +154,7 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
         }
 #endif
         m_cache_timestamp += fn.GetTimestamp();
+        it->second->SetTimestamp( GetFileTimestamp( fn.GetFullPath() ) );
     }
 
     m_cache_timestamp += m_lib_path.GetModificationTime().GetValue().GetValue();
@@ -157,6 +167,7 @@ void FP_CACHE::Save( FOOTPRINT* aFootprint )
 
 void FP_CACHE::Load()
 {
+    m_complete = true;
     m_cache_dirty = false;
     m_cache_timestamp = 0;
 
@@ -169,53 +180,132 @@ void FP_CACHE::Load()
         THROW_IO_ERROR( msg );
     }
 
-    wxString fullName;
-    wxString fileSpec = wxT( "*." ) + FILEEXT::KiCadFootprintFileExtension;
+    struct PENDING_FILE
+    {
+        WX_FILENAME                m_fn;
+        long long                  m_timestamp;
+        std::unique_ptr<FOOTPRINT> m_footprint;
+        wxString                   m_error;
+    };
+
+    wxString                  fullName;
+    wxString                  fileSpec = wxT( "*." ) + FILEEXT::KiCadFootprintFileExtension;
+    std::set<wxString>        found;
+    std::vector<PENDING_FILE> pending;
 
     // wxFileName construction is egregiously slow.  Construct it once and just swap out
     // the filename thereafter.
     WX_FILENAME fn( m_lib_raw_path, wxT( "dummyName" ) );
 
-    if( dir.GetFirst( &fullName, fileSpec ) )
+    for( bool ok = dir.GetFirst( &fullName, fileSpec ); ok; ok = dir.GetNext( &fullName ) )
     {
-        wxString cacheError;
+        fn.SetFullName( fullName );
 
-        do
-        {
-            fn.SetFullName( fullName );
+        wxString  fpName = fn.GetName();
+        long long timestamp = GetFileTimestamp( fn.GetFullPath() );
+        auto      it = m_footprints.find( fpName );
+
+        found.insert( fpName );
+
+        // Keep what was read from files which didn't change since
+        if( it != m_footprints.end() && timestamp && it->second->GetTimestamp() == timestamp )
+            continue;
+
+        pending.push_back( { fn, timestamp, nullptr, wxEmptyString } );
+    }
+
+    std::vector<wxString> removed;
+
+    for( const auto& [fpName, item] : m_footprints )
+    {
+        if( !found.count( fpName ) )
+            removed.push_back( fpName );
+    }
 
-            // Queue I/O errors so only files that fail to parse don't get loaded.
-            try
+    for( const wxString& fpName : removed )
+        m_footprints.erase( fpName );
+
+    ParallelFor( pending.size(),
+            [&]( size_t aIndex )
             {
-                FILE_LINE_READER reader( fn.GetFullPath() );
-                PCB_IO_KICAD_SEXPR_PARSER       parser( &reader, nullptr, nullptr );
+                PENDING_FILE& file = pending[aIndex];
+
+                // Queue I/O errors so only files that fail to parse don't get loaded.
+                try
+                {
+                    MAPPED_FILE_LINE_READER   reader( file.m_fn.GetFullPath() );
+                    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
 
-                FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
-                wxString fpName = fn.GetName();
+                    file.m_footprint.reset( dynamic_cast<FOOTPRINT*>( parser.Parse() ) );
 
-                if( !footprint )
+                    if( !file.m_footprint )
+                    {
+                        THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
+                                                          file.m_fn.GetFullPath() ) );
+                    }
+                }
+                catch( const IO_ERROR& ioe )
                 {
-                    THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
-                                                      fn.GetFullPath() ) );
+                    file.m_error = ioe.What();
                 }
+            } );
 
-                footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
-                m_footprints.insert( fpName, new FP_CACHE_ITEM( footprint, fn ) );
-            }
-            catch( const IO_ERROR& ioe )
-            {
-                if( !cacheError.IsEmpty() )
-                    cacheError += wxT( "\n\n" );
+    wxString cacheError;
 
-                cacheError += ioe.What();
-            }
-        } while( dir.GetNext( &fullName ) );
+    for( PENDING_FILE& file : pending )
+    {
+        wxString fpName = file.m_fn.GetName();
+
+        m_footprints.erase( fpName );
+
+        if( !file.m_footprint )
+        {
+            if( !cacheError.IsEmpty() )
+                cacheError += wxT( "\n\n" );
+
+            cacheError += file.m_error;
+            continue;
+        }
 
-        m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+        file.m_footprint->SetFPID( LIB_ID( wxEmptyString, fpName ) );
+        m_footprints.insert( fpName, new FP_CACHE_ITEM( file.m_footprint.release(), file.m_fn,
+                                                        file.m_timestamp ) );
+    }
+
+    m_cache_timestamp = GetTimestamp( m_lib_raw_path );
+
+    if( !cacheError.IsEmpty() )
+        THROW_IO_ERROR( cacheError );
+}
 
-        if( !cacheError.IsEmpty() )
-            THROW_IO_ERROR( cacheError );
+
+const FOOTPRINT* FP_CACHE::LoadFootprint( const wxString& aFootprintName )
+{
+    // Warning: footprint names frequently contain a point, so give the extension separately
+    WX_FILENAME fn( m_lib_raw_path, aFootprintName + wxT( "." )
+                                            + FILEEXT::KiCadFootprintFileExtension );
+
+    m_footprints.erase( aFootprintName );
+
+    if( !wxFileName::FileExists( fn.GetFullPath() ) )
+        return nullptr;
+
+    long long                 timestamp = GetFileTimestamp( fn.GetFullPath() );
+    MAPPED_FILE_LINE_READER   reader( fn.GetFullPath() );
+    PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+    FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( parser.Parse() );
+
+    if( !footprint )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
+                                          fn.GetFullPath() ) );
     }
+
+    footprint->SetFPID( LIB_ID( wxEmptyString, aFootprintName ) );
+    m_footprints.insert( aFootprintName, new FP_CACHE_ITEM( footprint, fn, timestamp ) );
+
+    return footprint;
 }
 
 
@@ -273,6 +363,17 @@ long long FP_CACHE::GetTimestamp( const wxString& aLibPath )
 }
 
 
+long long FP_CACHE::GetFileTimestamp( const wxString& aFilePath )
+{
+    wxFileName fn( aFilePath );
+
+    if( !fn.FileExists() )
+        return 0;
+
+    return fn.GetModificationTime().GetValue().GetValue() + (long long) fn.GetSize().GetValue();
+}
+
+
 bool PCB_IO_KICAD_SEXPR::CanReadBoard( const wxString& aFileName ) const
 {
     if( !PCB_IO::CanReadBoard( aFileName ) )
@@ -332,6 +433,19 @@ void PCB_IO_KICAD_SEXPR::SaveBoard( const wxString& aFileName, BOARD* aBoard,
     m_out->Finish();
 
     m_out = nullptr;
+
+    // Refresh the board cache from the file just written
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE         cache;
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE::SOURCE source;
+
+    if( !( m_ctl & CTL_OMIT_FILLS )
+            && PCB_IO_KICAD_SEXPR_BOARD_CACHE::IsEnabled( wxFileName::GetSize( aFileName )
+                                                                  .GetValue() )
+            && PCB_IO_KICAD_SEXPR_BOARD_CACHE::Identify( aFileName, source )
+            && cache.Collect( aBoard ) )
+    {
+        cache.Save( PCB_IO_KICAD_SEXPR_BOARD_CACHE::GetCachePath( aFileName ), source );
+    }
 }
 
 
@@ -478,17 +592,17 @@ void PCB_IO_KICAD_SEXPR::formatPolyPts( const SHAPE_LINE_CHAIN& outline, int aNe
 
         if( ind < 0 )
         {
-            m_out->Print( nestLevel, "(xy %s)",
-                          formatInternalUnits( outline.CPoint( ii ), aParentFP ).c_str() );
+            m_out->PrintFmt( nestLevel, "(xy {})",
+                             formatInternalUnits( outline.CPoint( ii ), aParentFP ) );
             needNewline = true;
         }
         else
         {
             const SHAPE_ARC& arc = outline.Arc( ind );
-            m_out->Print( nestLevel, "(arc (start %s) (mid %s) (end %s))",
-                          formatInternalUnits( arc.GetP0(), aParentFP ).c_str(),
-                          formatInternalUnits( arc.GetArcMid(), aParentFP ).c_str(),
-                          formatInternalUnits( arc.GetP1(), aParentFP ).c_str() );
+            m_out->PrintFmt( nestLevel, "(arc (start {}) (mid {}) (end {}))",
+                             formatInternalUnits( arc.GetP0(), aParentFP ),
+                             formatInternalUnits( arc.GetArcMid(), aParentFP ),
+                             formatInternalUnits( arc.GetP1(), aParentFP ) );
             needNewline = true;
 
             do
@@ -2100,9 +2214,9 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_TRACK* aTrack, int aNestLevel ) const
             THROW_IO_ERROR( wxString::Format( _( "unknown via type %d"  ), via->GetViaType() ) );
         }
 
-        m_out->Print( 0, " (at %s) (size %s)",
-                      formatInternalUnits( aTrack->GetStart() ).c_str(),
-                      formatInternalUnits( aTrack->GetWidth() ).c_str() );
+        m_out->PrintFmt( 0, " (at {}) (size {})",
+                         formatInternalUnits( aTrack->GetStart() ),
+                         formatInternalUnits( aTrack->GetWidth() ) );
 
         // Old boards were using UNDEFINED_DRILL_DIAMETER value in file for via drill when
         // via drill was the netclass value.
@@ -2155,11 +2269,11 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_TRACK* aTrack, int aNestLevel ) const
     {
         const PCB_ARC* arc = static_cast<const PCB_ARC*>( aTrack );
 
-        m_out->Print( aNestLevel, "(arc (start %s) (mid %s) (end %s) (width %s)",
-                      formatInternalUnits( arc->GetStart() ).c_str(),
-                      formatInternalUnits( arc->GetMid() ).c_str(),
-                      formatInternalUnits( arc->GetEnd() ).c_str(),
-                      formatInternalUnits( arc->GetWidth() ).c_str() );
+        m_out->PrintFmt( aNestLevel, "(arc (start {}) (mid {}) (end {}) (width {})",
+                         formatInternalUnits( arc->GetStart() ),
+                         formatInternalUnits( arc->GetMid() ),
+                         formatInternalUnits( arc->GetEnd() ),
+                         formatInternalUnits( arc->GetWidth() ) );
 
         if( arc->IsLocked() )
             KICAD_FORMAT::FormatBool( m_out, 0, "locked", arc->IsLocked() );
@@ -2168,10 +2282,10 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_TRACK* aTrack, int aNestLevel ) const
     }
     else
     {
-        m_out->Print( aNestLevel, "(segment (start %s) (end %s) (width %s)",
-                      formatInternalUnits( aTrack->GetStart() ).c_str(),
-                      formatInternalUnits( aTrack->GetEnd() ).c_str(),
-                      formatInternalUnits( aTrack->GetWidth() ).c_str() );
+        m_out->PrintFmt( aNestLevel, "(segment (start {}) (end {}) (width {})",
+                         formatInternalUnits( aTrack->GetStart() ),
+                         formatInternalUnits( aTrack->GetEnd() ),
+                         formatInternalUnits( aTrack->GetWidth() ) );
 
         if( aTrack->IsLocked() )
             KICAD_FORMAT::FormatBool( m_out, 0, "locked", aTrack->IsLocked() );
@@ -2179,7 +2293,7 @@ void PCB_IO_KICAD_SEXPR::format( const PCB_TRACK* aTrack, int aNestLevel ) const
         m_out->Print( 0, " (layer %s)", m_out->Quotew( LSET::Name( aTrack->GetLayer() ) ).c_str() );
     }
 
-    m_out->Print( 0, " (net %d)", m_mapping->Translate( aTrack->GetNetCode() ) );
+    m_out->PrintFmt( 0, " (net {})", m_mapping->Translate( aTrack->GetNetCode() ) );
 
     KICAD_FORMAT::FormatUuid( m_out, aTrack->m_Uuid );
 
@@ -2299,7 +2413,7 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone, int aNestLevel ) const
     m_out->Print( aNestLevel + 1, "(fill" );
 
     // Default is not filled.
-    if( aZone->IsFilled() )
+    if( aZone->IsFilled() && !( m_ctl & CTL_OMIT_FILLS ) )
         m_out->Print( 0, " yes" );
 
     // Default is polygon filled.
@@ -2377,6 +2491,12 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone, int aNestLevel ) const
         }
     }
 
+    if( m_ctl & CTL_OMIT_FILLS )
+    {
+        m_out->Print( aNestLevel, ")\n" );
+        return;
+    }
+
     // Save the PolysList (filled areas)
     for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
     {
@@ -2398,6 +2518,22 @@ void PCB_IO_KICAD_SEXPR::format( const ZONE* aZone, int aNestLevel ) const
         }
     }
 
+    // Save what the fills were built from, so that a later load can tell if they are current
+    if( aZone->IsFilled() )
+    {
+        for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+        {
+            const std::string& hash = aZone->GetFillInputHash( layer );
+
+            if( !hash.empty() )
+            {
+                m_out->Print( aNestLevel + 1, "(fill_input_hash (layer %s) %s)\n",
+                              m_out->Quotew( LSET::Name( layer ) ).c_str(),
+                              m_out->Quotes( hash ).c_str() );
+            }
+        }
+    }
+
     m_out->Print( aNestLevel, ")\n" );
 }
 
@@ -2422,7 +2558,19 @@ PCB_IO_KICAD_SEXPR::~PCB_IO_KICAD_SEXPR()
 BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                               const STRING_UTF8_MAP* aProperties, PROJECT* aProject )
 {
-    FILE_LINE_READER reader( aFileName );
+    TRACE_SCOPE( "Load board" );
+
+    MAPPED_FILE_LINE_READER reader( aFileName );
+
+    // Large boards may have their zone fills in a binary cache, which is much faster to read
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE         cache;
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE::SOURCE source;
+    wxString cachePath = PCB_IO_KICAD_SEXPR_BOARD_CACHE::GetCachePath( aFileName );
+    bool     lazyFills = aProperties && aProperties->Exists( PROP_LAZY_ZONE_FILLS );
+    bool     useCache = !aAppendToMe && !lazyFills
+                        && PCB_IO_KICAD_SEXPR_BOARD_CACHE::IsEnabled( reader.FileLength() )
+                        && PCB_IO_KICAD_SEXPR_BOARD_CACHE::Identify( aFileName, source );
+    bool     cached = useCache && cache.Load( cachePath, source );
 
     unsigned lineCount = 0;
 
@@ -2433,13 +2581,23 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
         if( !m_progressReporter->KeepRefreshing() )
             THROW_IO_ERROR( _( "Open cancelled by user." ) );
 
-        while( reader.ReadLine() )
-            lineCount++;
+        lineCount = reader.LineCount();
+    }
+
+    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount,
+                           cached );
 
+    if( cached && !cache.Apply( board ) )
+    {
+        // The cache was written from the same file contents, but doesn't hold the same zones
+        delete board;
         reader.Rewind();
+        cached = false;
+        board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
     }
 
-    BOARD* board = DoLoad( reader, aAppendToMe, aProperties, m_progressReporter, lineCount );
+    if( useCache && !cached && cache.Collect( board ) )
+        cache.Save( cachePath, source );
 
     // Give the filename to the board if it's new
     if( !aAppendToMe )
@@ -2450,13 +2608,19 @@ BOARD* PCB_IO_KICAD_SEXPR::LoadBoard( const wxString& aFileName, BOARD* aAppendT
 
 
 BOARD* PCB_IO_KICAD_SEXPR::DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const STRING_UTF8_MAP* aProperties,
-                           PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount)
+                           PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount,
+                           bool aSkipZoneFills )
 {
     init( aProperties );
 
     PCB_IO_KICAD_SEXPR_PARSER parser( &aReader, aAppendToMe, m_queryUserCallback, aProgressReporter, aLineCount );
     BOARD*     board;
 
+    if( aProperties && aProperties->Exists( PROP_LAZY_ZONE_FILLS ) )
+        parser.SetLazyZoneFills( true );
+
+    parser.SetSkipZoneFills( aSkipZoneFills );
+
     try
     {
         board = dynamic_cast<BOARD*>( parser.Parse() );
@@ -2495,13 +2659,18 @@ void PCB_IO_KICAD_SEXPR::init( const STRING_UTF8_MAP* aProperties )
 
 void PCB_IO_KICAD_SEXPR::validateCache( const wxString& aLibraryPath, bool checkModified )
 {
-    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || ( checkModified && m_cache->IsModified() ) )
+    if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
     {
         // a spectacular episode in memory management:
         delete m_cache;
         m_cache = new FP_CACHE( this, aLibraryPath );
         m_cache->Load();
     }
+    else if( !m_cache->IsComplete() || ( checkModified && m_cache->IsModified() ) )
+    {
+        // Only the changed footprint files are read again
+        m_cache->Load();
+    }
 }
 
 
@@ -2534,6 +2703,47 @@ void PCB_IO_KICAD_SEXPR::FootprintEnumerate( wxArrayString& aFootprintNames, con
 }
 
 
+void PCB_IO_KICAD_SEXPR::FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                                      const wxString& aLibraryPath,
+                                                      bool aBestEfforts,
+                                                      const STRING_UTF8_MAP* aProperties )
+{
+    LOCALE_IO toggle;     // toggles on, then off, the C locale.
+
+    init( aProperties );
+
+    // A library which is already loaded doesn't need its index
+    if( m_cache && m_cache->IsPath( aLibraryPath ) && m_cache->IsComplete()
+            && !m_cache->IsModified() )
+    {
+        PCB_IO::FootprintEnumerateSummaries( aSummaries, aLibraryPath, aBestEfforts,
+                                             aProperties );
+        return;
+    }
+
+    FP_LIB_INDEX index( aLibraryPath );
+    wxString     errorMsg;
+
+    try
+    {
+        index.Update();
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        errorMsg = ioe.What();
+    }
+
+    // Some of the files may have been parsed correctly so we want to add the valid files to
+    // the list.
+    std::vector<FOOTPRINT_SUMMARY> summaries = index.GetSummaries();
+
+    aSummaries.insert( aSummaries.end(), summaries.begin(), summaries.end() );
+
+    if( !errorMsg.IsEmpty() && !aBestEfforts )
+        THROW_IO_ERROR( errorMsg );
+}
+
+
 const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
                                            const wxString& aFootprintName,
                                            const STRING_UTF8_MAP* aProperties,
@@ -2543,6 +2753,32 @@ const FOOTPRINT* PCB_IO_KICAD_SEXPR::getFootprint( const wxString& aLibraryPath,
 
     init( aProperties );
 
+    // Footprints of a library which wasn't enumerated are read one at a time, on demand
+    if( !m_cache || !m_cache->IsPath( aLibraryPath ) || !m_cache->IsComplete() )
+    {
+        if( !m_cache || !m_cache->IsPath( aLibraryPath ) )
+        {
+            delete m_cache;
+            m_cache = new FP_CACHE( this, aLibraryPath );
+        }
+
+        FP_CACHE_FOOTPRINT_MAP&                footprints = m_cache->GetFootprints();
+        FP_CACHE_FOOTPRINT_MAP::const_iterator it = footprints.find( aFootprintName );
+
+        if( it != footprints.end() && !checkModified )
+            return it->second->GetFootprint();
+
+        try
+        {
+            return m_cache->LoadFootprint( aFootprintName );
+        }
+        catch( const IO_ERROR& )
+        {
+            // do nothing with the error
+            return nullptr;
+        }
+    }
+
     try
     {
         validateCache( aLibraryPath, checkModified );
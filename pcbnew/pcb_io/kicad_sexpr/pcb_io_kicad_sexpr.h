@@ -148,7 +148,8 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
 //#define SEXPR_BOARD_FILE_VERSION    20231014  // V8 file format normalization
 //#define SEXPR_BOARD_FILE_VERSION    20231212  // Reference image locking/UUIDs, footprint boolean format
 //#define SEXPR_BOARD_FILE_VERSION    20231231  // Use 'uuid' rather than 'id' for generators and groups
-#define SEXPR_BOARD_FILE_VERSION      20240108  // Convert teardrop parameters to explicit bools
+//#define SEXPR_BOARD_FILE_VERSION    20240108  // Convert teardrop parameters to explicit bools
+#define SEXPR_BOARD_FILE_VERSION      20240225  // Zone fill input hashes
 
 #define BOARD_FILE_HOST_VERSION       20200825  ///< Earlier files than this include the host tag
 #define LEGACY_ARC_FORMATTING         20210925  ///< These were the last to use old arc formatting
@@ -167,6 +168,7 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
                                                 ///< board/not library).
 #define CTL_OMIT_FOOTPRINT_VERSION  (1 << 8)    ///< Omit the version string from the (footprint)
                                                 ///<sexpr group
+#define CTL_OMIT_FILLS              (1 << 9)    ///< Omit zone fills (and whether zones are filled)
 
 // common combinations of the above:
 
@@ -181,6 +183,10 @@ class PCB_IO_KICAD_SEXPR;   // forward decl
 /// a BOARD file underneath IO_MGR.
 #define CTL_FOR_BOARD               (CTL_OMIT_INITIAL_COMMENTS|CTL_OMIT_FOOTPRINT_VERSION)
 
+/// LoadBoard() property: leave zone fills unparsed until they are first accessed (see
+/// ZONE::SetLazyFill()), for callers which mostly don't need them.
+#define PROP_LAZY_ZONE_FILLS        "lazy_zone_fills"
+
 /**
  * Helper class for creating a footprint library cache.
  *
@@ -193,13 +199,19 @@ class FP_CACHE_ITEM
 {
     WX_FILENAME                m_filename;
     std::unique_ptr<FOOTPRINT> m_footprint;
+    long long                  m_timestamp;    // of the file the footprint was read from or
+                                               // saved to, 0 if unknown
 
 public:
-    FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName );
+    FP_CACHE_ITEM( FOOTPRINT* aFootprint, const WX_FILENAME& aFileName,
+                   long long aTimestamp = 0 );
 
     const WX_FILENAME& GetFileName() const { return m_filename; }
     void               SetFilePath( const wxString& aFilePath ) { m_filename.SetPath( aFilePath ); }
     const FOOTPRINT*   GetFootprint() const { return m_footprint.get(); }
+
+    long long          GetTimestamp() const { return m_timestamp; }
+    void               SetTimestamp( long long aTimestamp ) { m_timestamp = aTimestamp; }
 };
 
 typedef boost::ptr_map<wxString, FP_CACHE_ITEM> FP_CACHE_FOOTPRINT_MAP;
@@ -211,6 +223,8 @@ class FP_CACHE
     wxString      m_lib_raw_path; // For quick comparisons.
     FP_CACHE_FOOTPRINT_MAP m_footprints;   // Map of footprint filename to FOOTPRINT*.
 
+    bool m_complete;             // All the footprint files were read by Load(), rather
+                                 // than some of them by LoadFootprint().
     bool m_cache_dirty;          // Stored separately because it's expensive to check
                                  // m_cache_timestamp against all the files.
     long long m_cache_timestamp; // A hash of the timestamps for all the footprint
@@ -238,8 +252,30 @@ public:
      */
     void Save( FOOTPRINT* aFootprint = nullptr );
 
+    /**
+     * Bring the cache up to date with the library.  Only the footprint files which are new or
+     * changed since they were last read are parsed, in parallel; the footprints of unchanged
+     * files are kept as they are.
+     *
+     * @throw IO_ERROR if the library cannot be read, or with the errors of the footprint files
+     *                 which cannot be parsed once the others are loaded.
+     */
     void Load();
 
+    /**
+     * Read the footprint \a aFootprintName alone, replacing what the cache holds of it.
+     *
+     * @return the footprint, or nullptr if the library has no such footprint file.
+     * @throw IO_ERROR if the footprint file cannot be parsed.
+     */
+    const FOOTPRINT* LoadFootprint( const wxString& aFootprintName );
+
+    /**
+     * @return true if the cache holds the whole library, false if only the footprints read
+     *         with LoadFootprint().
+     */
+    bool IsComplete() const { return m_complete; }
+
     void Remove( const wxString& aFootprintName );
 
     /**
@@ -249,6 +285,11 @@ public:
      */
     static long long GetTimestamp( const wxString& aLibPath );
 
+    /**
+     * Generate a timestamp for a single footprint file, from its modification time and size.
+     */
+    static long long GetFileTimestamp( const wxString& aFilePath );
+
     /**
      * Return true if the cache is not up-to-date.
      */
@@ -312,12 +353,25 @@ public:
     BOARD* LoadBoard( const wxString& aFileName, BOARD* aAppendToMe,
                       const STRING_UTF8_MAP* aProperties = nullptr, PROJECT* aProject = nullptr ) override;
 
+    /**
+     * @param aSkipZoneFills leaves the zone fills out of the board, for callers which set them
+     *                       afterwards from a PCB_IO_KICAD_SEXPR_BOARD_CACHE.
+     */
     BOARD* DoLoad( LINE_READER& aReader, BOARD* aAppendToMe, const STRING_UTF8_MAP* aProperties,
-                     PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount );
+                     PROGRESS_REPORTER* aProgressReporter, unsigned aLineCount,
+                     bool aSkipZoneFills = false );
 
     void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibraryPath,
                              bool aBestEfforts, const STRING_UTF8_MAP* aProperties = nullptr ) override;
 
+    /**
+     * Summarize footprints from a FP_LIB_INDEX of the library, which only parses the footprint
+     * files changed since it was last updated.
+     */
+    void FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                      const wxString& aLibraryPath, bool aBestEfforts,
+                                      const STRING_UTF8_MAP* aProperties = nullptr ) override;
+
     const FOOTPRINT* GetEnumeratedFootprint( const wxString& aLibraryPath,
                                              const wxString& aFootprintName,
                                              const STRING_UTF8_MAP* aProperties = nullptr ) override;
@@ -0,0 +1,438 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_board_cache.h>
+
+#include <cstring>
+#include <set>
+#include <string_view>
+#include <type_traits>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <footprint.h>
+#include <kiplatform/io.h>
+#include <zone.h>
+
+
+/// Bumped whenever the layout of the cache file changes
+static const uint32_t CACHE_VERSION = 1;
+
+/// Tells caches written on machines of the other endianness apart
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+static const char CACHE_MAGIC[] = "kicad_pcb cache";
+
+
+namespace
+{
+
+/**
+ * Appends fixed size values in the native byte order.
+ */
+class WRITER
+{
+public:
+    template <typename T>
+    void Put( T aValue )
+    {
+        static_assert( std::is_trivially_copyable_v<T> );
+        m_data.append( reinterpret_cast<const char*>( &aValue ), sizeof( T ) );
+    }
+
+    void PutString( const std::string& aString )
+    {
+        Put<uint32_t>( aString.size() );
+        m_data.append( aString );
+    }
+
+    const std::string& GetData() const { return m_data; }
+
+private:
+    std::string m_data;
+};
+
+
+/**
+ * Reads values written by WRITER.  Reading past the end sets the failed state and returns
+ * zeroes, so that a truncated file is detected once, after reading.
+ */
+class READER
+{
+public:
+    READER( const std::string& aData ) :
+            m_data( aData ),
+            m_pos( 0 ),
+            m_failed( false )
+    {
+    }
+
+    template <typename T>
+    T Get()
+    {
+        T value{};
+
+        if( m_failed || m_data.size() - m_pos < sizeof( T ) )
+        {
+            m_failed = true;
+            return value;
+        }
+
+        memcpy( &value, m_data.data() + m_pos, sizeof( T ) );
+        m_pos += sizeof( T );
+        return value;
+    }
+
+    std::string GetString()
+    {
+        uint32_t size = Get<uint32_t>();
+
+        if( m_failed || m_data.size() - m_pos < size )
+        {
+            m_failed = true;
+            return std::string();
+        }
+
+        std::string value = m_data.substr( m_pos, size );
+        m_pos += size;
+        return value;
+    }
+
+    /**
+     * @return false if there aren't \a aCount items of \a aItemSize bytes left.  Guards the
+     *         allocations made for counts read from a damaged file.
+     */
+    bool Has( uint64_t aCount, size_t aItemSize )
+    {
+        m_failed |= aCount > ( m_data.size() - m_pos ) / aItemSize;
+        return !m_failed;
+    }
+
+    bool Failed() const { return m_failed; }
+    bool AtEnd() const { return m_pos == m_data.size(); }
+
+private:
+    const std::string& m_data;
+    size_t             m_pos;
+    bool               m_failed;
+};
+
+
+template <typename FUNC>
+void forEachZone( const BOARD* aBoard, FUNC aFunction )
+{
+    for( ZONE* zone : aBoard->Zones() )
+        aFunction( zone );
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( ZONE* zone : footprint->Zones() )
+            aFunction( zone );
+    }
+}
+
+} // namespace
+
+
+bool PCB_IO_KICAD_SEXPR_BOARD_CACHE::IsEnabled( size_t aFileSize )
+{
+    int minSize = ADVANCED_CFG::GetCfg().m_BoardCacheMinSize;
+
+    return minSize > 0 && aFileSize >= (size_t) minSize * 1024 * 1024;
+}
+
+
+wxString PCB_IO_KICAD_SEXPR_BOARD_CACHE::GetCachePath( const wxString& aBoardFileName )
+{
+    return aBoardFileName + wxS( ".cache" );
+}
+
+
+bool PCB_IO_KICAD_SEXPR_BOARD_CACHE::Identify( const wxString& aBoardFileName, SOURCE& aSource )
+{
+    KIPLATFORM::IO::MAPPED_FILE file;
+    wxFileName                  fn( aBoardFileName );
+
+    if( !fn.FileExists() || !KIPLATFORM::IO::MapFile( aBoardFileName, file ) )
+        return false;
+
+    aSource.m_size = file.m_size;
+    aSource.m_modified = fn.GetModificationTime().GetValue().GetValue();
+    aSource.m_hash = std::hash<std::string_view>()( std::string_view( file.m_data,
+                                                                      file.m_size ) );
+
+    KIPLATFORM::IO::UnmapFile( file );
+    return true;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_BOARD_CACHE::Load( const wxString& aPath, const SOURCE& aSource )
+{
+    m_fills.clear();
+
+    wxFFile     file;
+    std::string data;
+
+    if( !wxFileExists( aPath ) || !file.Open( aPath, wxS( "rb" ) ) )
+        return false;
+
+    data.resize( file.Length() );
+
+    if( file.Read( data.data(), data.size() ) != data.size() )
+        return false;
+
+    READER reader( data );
+    SOURCE source;
+
+    if( reader.GetString() != CACHE_MAGIC
+            || reader.Get<uint32_t>() != CACHE_VERSION
+            || reader.Get<uint32_t>() != BYTE_ORDER_MARK )
+    {
+        return false;
+    }
+
+    source.m_size = reader.Get<uint64_t>();
+    source.m_modified = reader.Get<int64_t>();
+    source.m_hash = reader.Get<uint64_t>();
+
+    if( reader.Failed() || !( source == aSource ) )
+        return false;
+
+    uint32_t zoneCount = reader.Get<uint32_t>();
+
+    for( uint32_t ii = 0; ii < zoneCount && !reader.Failed(); ++ii )
+    {
+        std::vector<LAYER_FILL>& layers = m_fills[KIID( reader.GetString() )];
+        uint32_t                 layerCount = reader.Get<uint32_t>();
+
+        for( uint32_t jj = 0; jj < layerCount && !reader.Failed(); ++jj )
+        {
+            LAYER_FILL& layer = layers.emplace_back();
+            uint32_t    outlineCount;
+
+            layer.m_layer = ToLAYER_ID( reader.Get<int32_t>() );
+            outlineCount = reader.Get<uint32_t>();
+
+            for( uint32_t kk = 0; kk < outlineCount && !reader.Failed(); ++kk )
+            {
+                if( reader.Get<uint8_t>() )
+                    layer.m_islands.push_back( (int) kk );
+
+                uint32_t chainCount = reader.Get<uint32_t>();
+
+                // Every polygon has an outline, which the holes are added to
+                if( chainCount == 0 )
+                {
+                    m_fills.clear();
+                    return false;
+                }
+
+                for( uint32_t ll = 0; ll < chainCount && !reader.Failed(); ++ll )
+                {
+                    uint32_t pointCount = reader.Get<uint32_t>();
+
+                    if( !reader.Has( pointCount, 2 * sizeof( int32_t ) ) )
+                        break;
+
+                    SHAPE_LINE_CHAIN chain;
+
+                    chain.ReservePoints( pointCount );
+
+                    for( uint32_t mm = 0; mm < pointCount; ++mm )
+                    {
+                        int x = reader.Get<int32_t>();
+                        int y = reader.Get<int32_t>();
+                        chain.Append( x, y, true );
+                    }
+
+                    chain.SetClosed( true );
+
+                    if( ll == 0 )
+                        layer.m_fill.AddOutline( chain );
+                    else
+                        layer.m_fill.AddHole( chain, (int) kk );
+                }
+            }
+        }
+    }
+
+    if( reader.Failed() || !reader.AtEnd() )
+    {
+        m_fills.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_BOARD_CACHE::Save( const wxString& aPath, const SOURCE& aSource ) const
+{
+    WRITER writer;
+
+    writer.PutString( CACHE_MAGIC );
+    writer.Put<uint32_t>( CACHE_VERSION );
+    writer.Put<uint32_t>( BYTE_ORDER_MARK );
+    writer.Put<uint64_t>( aSource.m_size );
+    writer.Put<int64_t>( aSource.m_modified );
+    writer.Put<uint64_t>( aSource.m_hash );
+    writer.Put<uint32_t>( m_fills.size() );
+
+    for( const auto& [id, layers] : m_fills )
+    {
+        writer.PutString( id.AsString().ToStdString() );
+        writer.Put<uint32_t>( layers.size() );
+
+        for( const LAYER_FILL& layer : layers )
+        {
+            const SHAPE_POLY_SET& fill = layer.m_fill;
+            std::set<int>         islands( layer.m_islands.begin(), layer.m_islands.end() );
+
+            writer.Put<int32_t>( layer.m_layer );
+            writer.Put<uint32_t>( fill.OutlineCount() );
+
+            for( int ii = 0; ii < fill.OutlineCount(); ++ii )
+            {
+                const SHAPE_POLY_SET::POLYGON& polygon = fill.CPolygon( ii );
+
+                writer.Put<uint8_t>( islands.count( ii ) ? 1 : 0 );
+                writer.Put<uint32_t>( polygon.size() );
+
+                for( const SHAPE_LINE_CHAIN& chain : polygon )
+                {
+                    writer.Put<uint32_t>( chain.PointCount() );
+
+                    for( const VECTOR2I& pt : chain.CPoints() )
+                    {
+                        writer.Put<int32_t>( pt.x );
+                        writer.Put<int32_t>( pt.y );
+                    }
+                }
+            }
+        }
+    }
+
+    // Write next to the cache and swap it in, so that a reader never sees half a file
+    wxString tempPath = aPath + wxS( ".tmp" );
+    wxFFile  file;
+
+    if( !file.Open( tempPath, wxS( "wb" ) ) )
+        return false;
+
+    const std::string& data = writer.GetData();
+    bool               ok = file.Write( data.data(), data.size() ) == data.size();
+
+    ok &= file.Close();
+
+    if( !ok || !wxRenameFile( tempPath, aPath, true ) )
+    {
+        wxRemoveFile( tempPath );
+        return false;
+    }
+
+    return true;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_BOARD_CACHE::Collect( const BOARD* aBoard )
+{
+    bool ok = true;
+
+    m_fills.clear();
+
+    forEachZone( aBoard,
+            [&]( const ZONE* aZone )
+            {
+                // Lazy fills would all be loaded here, which is what they are meant to avoid
+                if( aZone->HasLazyFill() || m_fills.count( aZone->m_Uuid ) )
+                {
+                    ok = false;
+                    return;
+                }
+
+                std::vector<LAYER_FILL>& layers = m_fills[aZone->m_Uuid];
+
+                for( PCB_LAYER_ID layerId : aZone->GetLayerSet().Seq() )
+                {
+                    if( !aZone->HasFilledPolysForLayer( layerId ) )
+                        continue;
+
+                    const SHAPE_POLY_SET* fill = aZone->GetFilledPolysList( layerId ).get();
+
+                    if( fill->IsEmpty() )
+                        continue;
+
+                    LAYER_FILL& layer = layers.emplace_back();
+
+                    layer.m_layer = layerId;
+                    layer.m_fill = *fill;
+
+                    for( int ii = 0; ii < fill->OutlineCount(); ++ii )
+                    {
+                        // Fills don't hold arcs, but only points are cached
+                        for( const SHAPE_LINE_CHAIN& chain : fill->CPolygon( ii ) )
+                            ok &= chain.ArcCount() == 0;
+
+                        if( aZone->IsIsland( layerId, ii ) )
+                            layer.m_islands.push_back( ii );
+                    }
+                }
+
+                if( layers.empty() )
+                    m_fills.erase( aZone->m_Uuid );
+            } );
+
+    if( !ok )
+        m_fills.clear();
+
+    return ok;
+}
+
+
+bool PCB_IO_KICAD_SEXPR_BOARD_CACHE::Apply( BOARD* aBoard ) const
+{
+    size_t applied = 0;
+
+    forEachZone( aBoard,
+            [&]( ZONE* aZone )
+            {
+                auto it = m_fills.find( aZone->m_Uuid );
+
+                if( it == m_fills.end() )
+                    return;
+
+                for( const LAYER_FILL& layer : it->second )
+                {
+                    aZone->SetFilledPolysList( layer.m_layer, layer.m_fill );
+
+                    for( int island : layer.m_islands )
+                        aZone->SetIsIsland( layer.m_layer, island );
+                }
+
+                aZone->CalculateFilledArea();
+                ++applied;
+            } );
+
+    return applied == m_fills.size();
+}
@@ -0,0 +1,122 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PCB_IO_KICAD_SEXPR_BOARD_CACHE_H
+#define PCB_IO_KICAD_SEXPR_BOARD_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include <geometry/shape_poly_set.h>
+#include <kiid.h>
+#include <layer_ids.h>
+#include <wx/string.h>
+
+class BOARD;
+class ZONE;
+
+
+/**
+ * A binary sidecar of a .kicad_pcb file holding the filled polygons of its zones, which are
+ * the bulk of large board files and the slowest part of them to parse.
+ *
+ * The cache is tied to the exact contents of the board file by its size, modification time and
+ * hash, and is ignored when any of them differ.  The board file stays the only source of truth:
+ * a cache is only ever written from fills which are also in the board file.
+ */
+class PCB_IO_KICAD_SEXPR_BOARD_CACHE
+{
+public:
+    /**
+     * What identifies the contents of a board file.
+     */
+    struct SOURCE
+    {
+        uint64_t m_size = 0;
+        int64_t  m_modified = 0;    ///< milliseconds since the epoch
+        uint64_t m_hash = 0;
+
+        bool operator==( const SOURCE& aOther ) const
+        {
+            return m_size == aOther.m_size && m_modified == aOther.m_modified
+                   && m_hash == aOther.m_hash;
+        }
+    };
+
+    /**
+     * @return true if boards of \a aFileSize bytes are cached, see
+     *         ADVANCED_CFG::m_BoardCacheMinSize.
+     */
+    static bool IsEnabled( size_t aFileSize );
+
+    /**
+     * @return the name of the cache file of \a aBoardFileName.
+     */
+    static wxString GetCachePath( const wxString& aBoardFileName );
+
+    /**
+     * Identify the current contents of \a aBoardFileName.
+     *
+     * @return false if the file cannot be read.
+     */
+    static bool Identify( const wxString& aBoardFileName, SOURCE& aSource );
+
+    /**
+     * Read the cache file \a aPath.
+     *
+     * @return true if it was read and was built from \a aSource.  A missing, outdated or
+     *         damaged cache file leaves the cache empty.
+     */
+    bool Load( const wxString& aPath, const SOURCE& aSource );
+
+    /**
+     * Write the fills gathered by Collect() to \a aPath, as built from \a aSource.
+     *
+     * @return false if the file cannot be written.
+     */
+    bool Save( const wxString& aPath, const SOURCE& aSource ) const;
+
+    /**
+     * Gather the fills of the zones of \a aBoard and of its footprints.
+     *
+     * @return false if they cannot be cached, e.g. because of zones sharing a UUID.
+     */
+    bool Collect( const BOARD* aBoard );
+
+    /**
+     * Set the fills of the zones of \a aBoard and of its footprints from the cache.
+     *
+     * @return false if the cache doesn't match the zones of the board.
+     */
+    bool Apply( BOARD* aBoard ) const;
+
+private:
+    struct LAYER_FILL
+    {
+        PCB_LAYER_ID      m_layer;
+        SHAPE_POLY_SET    m_fill;
+        std::vector<int>  m_islands;
+    };
+
+    std::map<KIID, std::vector<LAYER_FILL>> m_fills;
+};
+
+#endif // PCB_IO_KICAD_SEXPR_BOARD_CACHE_H
@@ -0,0 +1,251 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_lib_index.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+#include <wx/dir.h>
+#include <wx/filename.h>
+#include <wx/translation.h>
+
+#include <footprint.h>
+#include <hash.h>
+#include <macros.h>
+#include <paths.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_parser.h>
+#include <richio.h>
+#include <wildcards_and_files_ext.h>
+
+
+/// Bumped whenever the contents of the index file change meaning
+static const int INDEX_VERSION = 1;
+
+
+FP_LIB_INDEX::FP_LIB_INDEX( const wxString& aLibraryPath ) :
+        m_libraryPath( aLibraryPath )
+{
+}
+
+
+wxString FP_LIB_INDEX::GetIndexPath( const wxString& aLibraryPath )
+{
+    wxFileName fn( PATHS::GetUserCachePath(), wxEmptyString );
+    size_t     hash = hash_val( std::string( TO_UTF8( aLibraryPath ) ) );
+
+    fn.AppendDir( wxS( "footprint-index" ) );
+    fn.SetName( wxString::Format( wxS( "%016llx" ), (unsigned long long) hash ) );
+    fn.SetExt( wxS( "json" ) );
+
+    return fn.GetFullPath();
+}
+
+
+void FP_LIB_INDEX::Update()
+{
+    wxDir dir( m_libraryPath );
+
+    if( !dir.IsOpened() )
+    {
+        THROW_IO_ERROR( wxString::Format( _( "Footprint library '%s' not found." ),
+                                          m_libraryPath ) );
+    }
+
+    bool                      changed = !load();
+    std::map<wxString, ENTRY> entries;
+    wxString                  fullName;
+    wxString                  fileSpec = wxT( "*." ) + FILEEXT::KiCadFootprintFileExtension;
+    wxString                  errors;
+    wxFileName                fn( m_libraryPath, wxT( "dummyName" ) );
+
+    for( bool found = dir.GetFirst( &fullName, fileSpec ); found; found = dir.GetNext( &fullName ) )
+    {
+        fn.SetFullName( fullName );
+
+        ENTRY entry;
+
+        entry.m_timestamp = fn.GetModificationTime().GetValue().GetValue();
+        entry.m_size = (long long) fn.GetSize().GetValue();
+
+        auto it = m_entries.find( fullName );
+
+        if( it != m_entries.end() && it->second.m_timestamp == entry.m_timestamp
+                && it->second.m_size == entry.m_size )
+        {
+            entries[fullName] = std::move( it->second );
+            continue;
+        }
+
+        changed = true;
+
+        try
+        {
+            MAPPED_FILE_LINE_READER    reader( fn.GetFullPath() );
+            PCB_IO_KICAD_SEXPR_PARSER  parser( &reader, nullptr, nullptr );
+            std::unique_ptr<FOOTPRINT> footprint( dynamic_cast<FOOTPRINT*>( parser.Parse() ) );
+
+            if( !footprint )
+            {
+                THROW_IO_ERROR( wxString::Format( _( "Unable to read file '%s'" ),
+                                                  fn.GetFullPath() ) );
+            }
+
+            entry.m_summary.m_name = fn.GetName();
+            entry.m_summary.m_description = footprint->GetLibDescription();
+            entry.m_summary.m_keywords = footprint->GetKeywords();
+            entry.m_summary.m_padCount = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+            entry.m_summary.m_uniquePadCount = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+
+            entries[fullName] = std::move( entry );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            if( !errors.IsEmpty() )
+                errors += wxT( "\n\n" );
+
+            errors += ioe.What();
+        }
+    }
+
+    changed |= entries.size() != m_entries.size();
+    m_entries = std::move( entries );
+
+    // Footprints which failed to parse are retried next time, so keep the index as is
+    if( changed && errors.IsEmpty() )
+        save();
+
+    if( !errors.IsEmpty() )
+        THROW_IO_ERROR( errors );
+}
+
+
+std::vector<FOOTPRINT_SUMMARY> FP_LIB_INDEX::GetSummaries() const
+{
+    std::vector<FOOTPRINT_SUMMARY> summaries;
+
+    summaries.reserve( m_entries.size() );
+
+    for( const auto& [fileName, entry] : m_entries )
+        summaries.push_back( entry.m_summary );
+
+    std::sort( summaries.begin(), summaries.end(),
+               []( const FOOTPRINT_SUMMARY& aLhs, const FOOTPRINT_SUMMARY& aRhs )
+               {
+                   return aLhs.m_name < aRhs.m_name;
+               } );
+
+    return summaries;
+}
+
+
+bool FP_LIB_INDEX::load()
+{
+    wxString path = GetIndexPath( m_libraryPath );
+
+    m_entries.clear();
+
+    if( !wxFileName::FileExists( path ) )
+        return false;
+
+    try
+    {
+        std::ifstream  stream( path.fn_str() );
+        nlohmann::json json = nlohmann::json::parse( stream );
+
+        if( json.at( "version" ).get<int>() != INDEX_VERSION
+                || wxString::FromUTF8( json.at( "library" ).get<std::string>() ) != m_libraryPath )
+        {
+            return false;
+        }
+
+        for( const nlohmann::json& item : json.at( "footprints" ) )
+        {
+            ENTRY entry;
+
+            entry.m_timestamp = item.at( "timestamp" ).get<long long>();
+            entry.m_size = item.at( "size" ).get<long long>();
+            entry.m_summary.m_name = wxString::FromUTF8( item.at( "name" ).get<std::string>() );
+            entry.m_summary.m_description =
+                    wxString::FromUTF8( item.at( "description" ).get<std::string>() );
+            entry.m_summary.m_keywords =
+                    wxString::FromUTF8( item.at( "keywords" ).get<std::string>() );
+            entry.m_summary.m_padCount = item.at( "pads" ).get<unsigned int>();
+            entry.m_summary.m_uniquePadCount = item.at( "unique_pads" ).get<unsigned int>();
+
+            m_entries[wxString::FromUTF8( item.at( "file" ).get<std::string>() )] = entry;
+        }
+    }
+    catch( ... )
+    {
+        // A damaged or foreign file is just an empty index
+        m_entries.clear();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool FP_LIB_INDEX::save() const
+{
+    wxString       path = GetIndexPath( m_libraryPath );
+    nlohmann::json json;
+    nlohmann::json footprints = nlohmann::json::array();
+
+    if( !PATHS::EnsurePathExists( wxFileName( path ).GetPath() ) )
+        return false;
+
+    for( const auto& [fileName, entry] : m_entries )
+    {
+        footprints.push_back( {
+                { "file", TO_UTF8( fileName ) },
+                { "timestamp", entry.m_timestamp },
+                { "size", entry.m_size },
+                { "name", TO_UTF8( entry.m_summary.m_name ) },
+                { "description", TO_UTF8( entry.m_summary.m_description ) },
+                { "keywords", TO_UTF8( entry.m_summary.m_keywords ) },
+                { "pads", entry.m_summary.m_padCount },
+                { "unique_pads", entry.m_summary.m_uniquePadCount } } );
+    }
+
+    json["version"] = INDEX_VERSION;
+    json["library"] = TO_UTF8( m_libraryPath );
+    json["footprints"] = footprints;
+
+    // Write next to the index and swap it in, as several instances may share the cache path
+    wxString      tempPath = path + wxS( ".tmp" );
+    std::ofstream stream( tempPath.fn_str() );
+
+    if( !stream )
+        return false;
+
+    stream << json << std::endl;
+    stream.close();
+
+    if( !stream.good() || !wxRenameFile( tempPath, path, true ) )
+    {
+        wxRemoveFile( tempPath );
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PCB_IO_KICAD_SEXPR_LIB_INDEX_H
+#define PCB_IO_KICAD_SEXPR_LIB_INDEX_H
+
+#include <map>
+#include <vector>
+
+#include <pcb_io/pcb_io.h>
+#include <wx/string.h>
+
+
+/**
+ * The summaries of the footprints of a .pretty library, kept in the user cache directory so
+ * that footprint lists can be built without parsing every footprint file.
+ *
+ * Each summary is stored along with the modification time and size of its footprint file, and
+ * only the footprint files which changed since the index was written are parsed again.
+ */
+class FP_LIB_INDEX
+{
+public:
+    FP_LIB_INDEX( const wxString& aLibraryPath );
+
+    /**
+     * @return the index file of the library \a aLibraryPath.
+     */
+    static wxString GetIndexPath( const wxString& aLibraryPath );
+
+    /**
+     * Bring the index up to date with the library, and save it if it changed.
+     *
+     * @throw IO_ERROR if the library cannot be read.  Footprint files which cannot be parsed
+     *                 are left out of the index, and their errors are thrown after it is
+     *                 updated.
+     */
+    void Update();
+
+    /**
+     * @return the summaries of the footprints of the library, ordered by name.
+     */
+    std::vector<FOOTPRINT_SUMMARY> GetSummaries() const;
+
+private:
+    struct ENTRY
+    {
+        long long         m_timestamp = 0;
+        long long         m_size = 0;
+        FOOTPRINT_SUMMARY m_summary;
+    };
+
+    bool load();
+    bool save() const;
+
+    wxString                  m_libraryPath;
+    std::map<wxString, ENTRY> m_entries;    ///< by footprint file name
+};
+
+#endif // PCB_IO_KICAD_SEXPR_LIB_INDEX_H
@@ -66,6 +66,7 @@
 #include <progress_reporter.h>
 #include <board_stackup_manager/stackup_predefined_prms.h>
 #include <pgm_base.h>
+#include <core/thread_pool.h>
 
 // For some reason wxWidgets is built with wxUSE_BASE64 unset so expose the wxWidgets
 // base64 code. Needed for PCB_REFERENCE_IMAGE
@@ -194,23 +195,33 @@ int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits()
     // to confirm or experiment.  Use a similar strategy in both places, here
     // and in the test program. Make that program with:
     // $ make test-nm-biu-to-ascii-mm-round-tripping
-    auto retval = parseDouble() * pcbIUScale.IU_PER_MM;
+
+    // Values written by KiCad have at most 6 decimals, so they convert to nanometers exactly
+    // in integer arithmetic, without the double round trip.
+    constexpr long long iuPerMM = static_cast<long long>( pcbIUScale.IU_PER_MM );
+    const std::string&  text = CurStr();
+    long long           value;
 
     // N.B. we currently represent board units as integers.  Any values that are
     // larger or smaller than those board units represent undefined behavior for
     // the system.  We limit values to the largest that is visible on the screen
+    if( parseScaledDecimal( text.data(), text.data() + text.size(), iuPerMM, value ) )
+    {
+        constexpr long long limit = static_cast<long long>( INT_LIMIT );
+
+        return static_cast<int>( Clamp<long long>( -limit, value, limit ) );
+    }
+
+    auto retval = parseDouble() * pcbIUScale.IU_PER_MM;
+
     return KiROUND( Clamp<double>( -INT_LIMIT, retval, INT_LIMIT ) );
 }
 
 
 int PCB_IO_KICAD_SEXPR_PARSER::parseBoardUnits( const char* aExpected )
 {
-    auto retval = parseDouble( aExpected ) * pcbIUScale.IU_PER_MM;
-
-    // N.B. we currently represent board units as integers.  Any values that are
-    // larger or smaller than those board units represent undefined behavior for
-    // the system.  We limit values to the largest that is visible on the screen
-    return KiROUND( Clamp<double>( -INT_LIMIT, retval, INT_LIMIT ) );
+    NeedNUMBER( aExpected );
+    return parseBoardUnits();
 }
 
 
@@ -897,6 +908,24 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
     std::vector<BOARD_ITEM*> bulkAddedItems;
     BOARD_ITEM* item = nullptr;
 
+    // Footprints and zones make up most of a board file, and their parsing only reads the
+    // board, so they are captured as text and parsed in parallel once the nets are all known.
+    // Not when appending, the new UUIDs have to be assigned in file order.  Nor for legacy
+    // files, whose conversions report warnings and expect a single pass.
+    std::vector<DEFERRED_SECTION> deferredSections;
+    bool deferSections = !m_appendToExisting && m_requiredVersion >= 20211014;
+
+    auto deferSection =
+            [&]()
+            {
+                DEFERRED_SECTION& section = deferredSections.emplace_back();
+
+                section.m_lineNumber = CurLineNumber();
+                section.m_text = "(" + CurStr() + " ";
+                ReadListText( section.m_text );
+                section.m_lastLineNumber = CurLineNumber();
+            };
+
     for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
     {
         checkpoint();
@@ -1014,6 +1043,12 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 
         case T_module:      // legacy token
         case T_footprint:
+            if( deferSections )
+            {
+                deferSection();
+                break;
+            }
+
             item = parseFOOTPRINT();
             m_board->Add( item, ADD_MODE::BULK_APPEND, true );
             bulkAddedItems.push_back( item );
@@ -1046,6 +1081,12 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
             break;
 
         case T_zone:
+            if( deferSections )
+            {
+                deferSection();
+                break;
+            }
+
             item = parseZONE( m_board );
             m_board->Add( item, ADD_MODE::BULK_APPEND, true );
             bulkAddedItems.push_back( item );
@@ -1064,6 +1105,9 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
         }
     }
 
+    if( !deferredSections.empty() )
+        parseDeferredSections( deferredSections, bulkAddedItems );
+
     if( bulkAddedItems.size() > 0 )
         m_board->FinalizeBulkAdd( bulkAddedItems );
 
@@ -1160,6 +1204,149 @@ BOARD* PCB_IO_KICAD_SEXPR_PARSER::parseBOARD_unchecked()
 }
 
 
+void PCB_IO_KICAD_SEXPR_PARSER::parseDeferredSections( std::vector<DEFERRED_SECTION>& aSections,
+                                                       std::vector<BOARD_ITEM*>& aBulkAddedItems )
+{
+    /// Reads the text of consecutive sections, reporting the line numbers of the file
+    class SECTION_LINE_READER : public STRING_LINE_READER
+    {
+    public:
+        SECTION_LINE_READER( const std::string& aText, const wxString& aSource,
+                             unsigned aLineNumber ) :
+                STRING_LINE_READER( aText, aSource )
+        {
+            m_lineNum = aLineNumber - 1;
+        }
+    };
+
+    struct BATCH
+    {
+        size_t                                     m_first;
+        size_t                                     m_count;
+        std::unique_ptr<PCB_IO_KICAD_SEXPR_PARSER> m_parser;
+        std::exception_ptr                         m_error;
+    };
+
+    thread_pool& tp = GetKiCadThreadPool();
+    size_t       totalSize = 0;
+
+    for( const DEFERRED_SECTION& section : aSections )
+        totalSize += section.m_text.size();
+
+    // A few batches per thread, so that large footprints don't leave threads idle
+    size_t             threads = std::max<size_t>( tp.get_thread_count(), 1 );
+    size_t             batchSize = totalSize / ( 4 * threads ) + 1;
+    std::vector<BATCH> batches;
+    size_t             size = 0;
+
+    for( size_t ii = 0; ii < aSections.size(); ++ii )
+    {
+        if( batches.empty() || size >= batchSize )
+        {
+            batches.push_back( { ii, 0, nullptr, nullptr } );
+            size = 0;
+        }
+
+        batches.back().m_count++;
+        size += aSections[ii].m_text.size();
+    }
+
+    ParallelFor( batches.size(),
+            [&]( size_t aBatch )
+            {
+                BATCH&      batch = batches[aBatch];
+                std::string text;
+                unsigned    line = aSections[batch.m_first].m_lineNumber;
+
+                // Pad the gaps between sections so that errors report the lines of the file
+                for( size_t ii = batch.m_first; ii < batch.m_first + batch.m_count; ++ii )
+                {
+                    const DEFERRED_SECTION& section = aSections[ii];
+
+                    if( section.m_lineNumber > line )
+                        text.append( section.m_lineNumber - line, '\n' );
+                    else if( !text.empty() )
+                        text.append( 1, ' ' );
+
+                    text.append( section.m_text );
+                    line = section.m_lastLineNumber;
+                }
+
+                try
+                {
+                    SECTION_LINE_READER reader( text, CurSource(),
+                                                aSections[batch.m_first].m_lineNumber );
+
+                    batch.m_parser = std::make_unique<PCB_IO_KICAD_SEXPR_PARSER>( &reader, m_board,
+                                                                                  nullptr );
+
+                    PCB_IO_KICAD_SEXPR_PARSER* parser = batch.m_parser.get();
+
+                    parser->m_layerIndices = m_layerIndices;
+                    parser->m_layerMasks = m_layerMasks;
+                    parser->m_netCodes = m_netCodes;
+                    parser->m_requiredVersion = m_requiredVersion;
+                    parser->m_tooRecent = m_tooRecent;
+                    parser->m_generatorVersion = m_generatorVersion;
+                    parser->m_showLegacySegmentZoneWarning = m_showLegacySegmentZoneWarning;
+                    parser->m_showLegacy5ZoneWarning = m_showLegacy5ZoneWarning;
+                    parser->m_appendToExisting = false;
+                    parser->m_deferBoardChanges = true;
+                    parser->m_lazyZoneFills = m_lazyZoneFills;
+                    parser->m_skipZoneFills = m_skipZoneFills;
+
+                    for( size_t ii = batch.m_first; ii < batch.m_first + batch.m_count; ++ii )
+                    {
+                        parser->NeedLEFT();
+
+                        if( parser->NextTok() == T_zone )
+                            aSections[ii].m_item = parser->parseZONE( m_board );
+                        else
+                            aSections[ii].m_item = parser->parseFOOTPRINT();
+                    }
+                }
+                catch( ... )
+                {
+                    batch.m_error = std::current_exception();
+                }
+            } );
+
+    for( const BATCH& batch : batches )
+    {
+        if( batch.m_error )
+        {
+            for( DEFERRED_SECTION& section : aSections )
+                delete section.m_item;
+
+            std::rethrow_exception( batch.m_error );
+        }
+    }
+
+    for( const BATCH& batch : batches )
+    {
+        PCB_IO_KICAD_SEXPR_PARSER* parser = batch.m_parser.get();
+
+        m_undefinedLayers.insert( parser->m_undefinedLayers.begin(),
+                                  parser->m_undefinedLayers.end() );
+
+        for( GROUP_INFO& groupInfo : parser->m_groupInfos )
+            m_groupInfos.push_back( std::move( groupInfo ) );
+
+        for( GENERATOR_INFO& genInfo : parser->m_generatorInfos )
+            m_generatorInfos.push_back( std::move( genInfo ) );
+
+        for( const auto& [zone, netName] : parser->m_deferredZones )
+            finishZone( zone, netName );
+
+        for( size_t ii = batch.m_first; ii < batch.m_first + batch.m_count; ++ii )
+        {
+            m_board->Add( aSections[ii].m_item, ADD_MODE::BULK_APPEND, true );
+            aBulkAddedItems.push_back( aSections[ii].m_item );
+        }
+    }
+}
+
+
 void PCB_IO_KICAD_SEXPR_PARSER::resolveGroups( BOARD_ITEM* aParent )
 {
     auto getItem = [&]( const KIID& aId )
@@ -5550,6 +5737,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 
     // bigger scope since each filled_polygon is concatenated in here
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> pts;
+    std::map<PCB_LAYER_ID, std::string>    lazyFills;
+    std::string                            skippedText;
     std::map<PCB_LAYER_ID, std::vector<SEG>> legacySegs;
     PCB_LAYER_ID filledLayer;
     bool         addedFilledPolygons = false;
@@ -5945,6 +6134,25 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
                 {
                     filledLayer = parseBoardItemLayer();
                     NeedRIGHT();
+
+                    // Legacy fills need converting, which is done once they are all read
+                    if( m_skipZoneFills && !isStrokedFill )
+                    {
+                        skippedText.clear();
+                        ReadListText( skippedText );
+                        break;
+                    }
+
+                    if( m_lazyZoneFills && !isStrokedFill )
+                    {
+                        std::string& text = lazyFills[filledLayer];
+
+                        text += "(filled_polygon ";
+                        ReadListText( text );
+                        text += '\n';
+                        break;
+                    }
+
                     token = NextTok();
 
                     if( token != T_LEFT )
@@ -5958,38 +6166,28 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
                     filledLayer = zone->GetFirstLayer();
                 }
 
-                bool island = false;
-
-                if( token == T_island )
-                {
-                    island = true;
-                    NeedRIGHT();
-                    NeedLEFT();
-                    token = NextTok();
-                }
-
-                if( token != T_pts )
-                    Expecting( T_pts );
+                SHAPE_POLY_SET& poly = pts[filledLayer];
 
-                if( !pts.count( filledLayer ) )
-                    pts[filledLayer] = SHAPE_POLY_SET();
+                parseFilledPolygon( zone.get(), filledLayer, token, poly );
 
-                SHAPE_POLY_SET& poly = pts.at( filledLayer );
-
-                int idx = poly.NewOutline();
-                SHAPE_LINE_CHAIN& chain = poly.Outline( idx );
-
-                if( island )
-                    zone->SetIsIsland( filledLayer, idx );
+                addedFilledPolygons |= !poly.IsEmpty();
+            }
 
-                for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
-                    parseOutlinePoints( chain );
+            break;
 
-                NeedRIGHT();
+        case T_fill_input_hash:
+            // "(fill_input_hash (layer "F.Cu") "digest")"
+            NeedLEFT();
+            token = NextTok();
 
-                addedFilledPolygons |= !poly.IsEmpty();
-            }
+            if( token != T_layer )
+                Expecting( T_layer );
 
+            filledLayer = parseBoardItemLayer();
+            NeedRIGHT();
+            NeedSYMBOLorNUMBER();
+            zone->SetFillInputHash( filledLayer, CurStr() );
+            NeedRIGHT();
             break;
 
         case T_fill_segments:
@@ -6077,7 +6275,8 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
 
         default:
             Expecting( "net, layer/layers, tstamp, hatch, priority, connect_pads, min_thickness, "
-                       "fill, polygon, filled_polygon, fill_segments, attr, locked, uuid, or name" );
+                       "fill, polygon, filled_polygon, fill_segments, fill_input_hash, attr, "
+                       "locked, uuid, or name" );
         }
     }
 
@@ -6170,39 +6369,117 @@ ZONE* PCB_IO_KICAD_SEXPR_PARSER::parseZONE( BOARD_ITEM_CONTAINER* aParent )
     if( !zone_has_net )
         zone->SetNetCode( NETINFO_LIST::UNCONNECTED );
 
+    if( !lazyFills.empty() )
+    {
+        zone->SetLazyFill(
+                [fills = std::move( lazyFills ), source = CurSource()]( ZONE& aZone )
+                {
+                    for( const auto& [layer, text] : fills )
+                    {
+                        SHAPE_POLY_SET fill;
+
+                        try
+                        {
+                            STRING_LINE_READER        reader( text, source );
+                            PCB_IO_KICAD_SEXPR_PARSER parser( &reader, nullptr, nullptr );
+
+                            while( parser.NextTok() == T_LEFT )
+                            {
+                                if( parser.NextTok() != T_filled_polygon )
+                                    parser.Expecting( T_filled_polygon );
+
+                                parser.NeedLEFT();
+                                parser.parseFilledPolygon( &aZone, layer, parser.NextTok(),
+                                                           fill );
+                            }
+                        }
+                        catch( const IO_ERROR& ioe )
+                        {
+                            // Only the nesting of the text was checked when the file was read.
+                            // Keep what could be parsed of a damaged fill.
+                            wxLogWarning( ioe.What() );
+                        }
+
+                        aZone.SetFilledPolysList( layer, fill );
+                    }
+
+                    aZone.CalculateFilledArea();
+                } );
+    }
+
+    // Clear flags used in zone edition:
+    zone->SetNeedRefill( false );
+
+    if( m_deferBoardChanges )
+        m_deferredZones.emplace_back( zone.get(), netnameFromfile );
+    else
+        finishZone( zone.get(), netnameFromfile );
+
+    return zone.release();
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::parseFilledPolygon( ZONE* aZone, PCB_LAYER_ID aLayer, int aToken,
+                                                    SHAPE_POLY_SET& aFill )
+{
+    bool island = false;
+
+    if( aToken == T_island )
+    {
+        island = true;
+        NeedRIGHT();
+        NeedLEFT();
+        aToken = NextTok();
+    }
+
+    if( aToken != T_pts )
+        Expecting( T_pts );
+
+    int idx = aFill.NewOutline();
+    SHAPE_LINE_CHAIN& chain = aFill.Outline( idx );
+
+    if( island )
+        aZone->SetIsIsland( aLayer, idx );
+
+    for( int token = NextTok();  token != T_RIGHT;  token = NextTok() )
+        parseOutlinePoints( chain );
+
+    NeedRIGHT();
+}
+
+
+void PCB_IO_KICAD_SEXPR_PARSER::finishZone( ZONE* aZone, const wxString& aNetNameFromFile )
+{
+    bool zone_has_net = aZone->IsOnCopperLayer() && !aZone->GetIsRuleArea();
+
     // Ensure the zone net name is valid, and matches the net code, for copper zones
-    if( zone_has_net && ( zone->GetNet()->GetNetname() != netnameFromfile ) )
+    if( zone_has_net && ( aZone->GetNet()->GetNetname() != aNetNameFromFile ) )
     {
         // Can happens which old boards, with nonexistent nets ...
         // or after being edited by hand
         // We try to fix the mismatch.
-        NETINFO_ITEM* net = m_board->FindNet( netnameFromfile );
+        NETINFO_ITEM* net = m_board->FindNet( aNetNameFromFile );
 
         if( net )   // An existing net has the same net name. use it for the zone
         {
-            zone->SetNetCode( net->GetNetCode() );
+            aZone->SetNetCode( net->GetNetCode() );
         }
         else    // Not existing net: add a new net to keep trace of the zone netname
         {
             int newnetcode = m_board->GetNetCount();
-            net = new NETINFO_ITEM( m_board, netnameFromfile, newnetcode );
+            net = new NETINFO_ITEM( m_board, aNetNameFromFile, newnetcode );
             m_board->Add( net, ADD_MODE::INSERT, true );
 
             // Store the new code mapping
             pushValueIntoMap( newnetcode, net->GetNetCode() );
 
             // and update the zone netcode
-            zone->SetNetCode( net->GetNetCode() );
+            aZone->SetNetCode( net->GetNetCode() );
         }
     }
 
-    if( zone->IsTeardropArea() && m_requiredVersion < 20230517 )
+    if( aZone->IsTeardropArea() && m_requiredVersion < 20230517 )
         m_board->SetLegacyTeardrops( true );
-
-    // Clear flags used in zone edition:
-    zone->SetNeedRefill( false );
-
-    return zone.release();
 }
 
 
@@ -62,6 +62,7 @@ class PCB_VIA;
 class ZONE;
 class FP_3DMODEL;
 class SHAPE_LINE_CHAIN;
+class SHAPE_POLY_SET;
 struct LAYER;
 class PROGRESS_REPORTER;
 class TEARDROP_PARAMETERS;
@@ -80,6 +81,9 @@ public:
         PCB_LEXER( aReader ),
         m_board( aAppendToMe ),
         m_appendToExisting( aAppendToMe != nullptr ),
+        m_deferBoardChanges( false ),
+        m_lazyZoneFills( false ),
+        m_skipZoneFills( false ),
         m_progressReporter( aProgressReporter ),
         m_lastProgressTime( std::chrono::steady_clock::now() ),
         m_lineCount( aLineCount ),
@@ -120,6 +124,18 @@ public:
      */
     bool IsValidBoardHeader();
 
+    /**
+     * Leave the filled polygons of zones unparsed until they are first accessed, see
+     * ZONE::SetLazyFill().  For readers which mostly don't need them.
+     */
+    void SetLazyZoneFills( bool aLazy ) { m_lazyZoneFills = aLazy; }
+
+    /**
+     * Leave the filled polygons of zones out, for callers which set them from elsewhere (see
+     * PCB_IO_KICAD_SEXPR_BOARD_CACHE).  Legacy fills, which need converting, are still read.
+     */
+    void SetSkipZoneFills( bool aSkip ) { m_skipZoneFills = aSkip; }
+
 private:
 
     // Group membership info refers to other Uuids in the file.
@@ -226,6 +242,19 @@ private:
     PCB_TRACK*  parsePCB_TRACK();
     PCB_VIA*    parsePCB_VIA();
     ZONE*       parseZONE( BOARD_ITEM_CONTAINER* aParent );
+
+    /**
+     * Parse the rest of a (filled_polygon ...) from \a aToken, (island) or (pts, on, and
+     * append it to \a aFill.
+     */
+    void        parseFilledPolygon( ZONE* aZone, PCB_LAYER_ID aLayer, int aToken,
+                                    SHAPE_POLY_SET& aFill );
+
+    /**
+     * Apply the changes to the board that reading \a aZone calls for: the creation of a net
+     * for an unknown net name, and the legacy teardrops flag.
+     */
+    void        finishZone( ZONE* aZone, const wxString& aNetNameFromFile );
     PCB_TARGET* parsePCB_TARGET();
     BOARD*      parseBOARD();
     void        parseGROUP_members( GROUP_INFO& aGroupInfo );
@@ -366,6 +395,24 @@ private:
      */
     void resolveGroups( BOARD_ITEM* aParent );
 
+    /**
+     * The text of a top-level board section, captured to be parsed later.
+     */
+    struct DEFERRED_SECTION
+    {
+        std::string m_text;
+        unsigned    m_lineNumber;       ///< line of the opening parenthesis
+        unsigned    m_lastLineNumber;   ///< line of the closing parenthesis
+        BOARD_ITEM* m_item = nullptr;
+    };
+
+    /**
+     * Parse footprint and zone sections in parallel, each batch of consecutive sections with
+     * its own parser, and add the resulting items to the board in file order.
+     */
+    void parseDeferredSections( std::vector<DEFERRED_SECTION>& aSections,
+                                std::vector<BOARD_ITEM*>& aBulkAddedItems );
+
     typedef std::unordered_map< std::string, PCB_LAYER_ID > LAYER_ID_MAP;
     typedef std::unordered_map< std::string, LSET >         LSET_MAP;
     typedef std::unordered_map< wxString, KIID >            KIID_MAP;
@@ -388,6 +435,12 @@ private:
     int                 m_requiredVersion;  ///< set to the KiCad format version this board requires
     wxString            m_generatorVersion; ///< Set to the generator version this board requires
     bool                m_appendToExisting; ///< reading into an existing board; reset UUIDs
+    bool                m_deferBoardChanges; ///< parsing on a worker; leave m_board untouched
+    bool                m_lazyZoneFills;    ///< capture zone fills for ZONE::SetLazyFill()
+    bool                m_skipZoneFills;    ///< read past zone fills
+
+    ///< zones waiting for finishZone() when m_deferBoardChanges is set
+    std::vector<std::pair<ZONE*, wxString>> m_deferredZones;
 
     ///< if resetting UUIDs, record new ones to update groups with.
     KIID_MAP            m_resetKIIDMap;
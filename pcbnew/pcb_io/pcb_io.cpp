@@ -25,6 +25,7 @@
 #include <unordered_set>
 #include <pcb_io/pcb_io.h>
 #include <pcb_io/pcb_io_mgr.h>
+#include <footprint.h>
 #include <ki_exception.h>
 #include <string_utf8_map.h>
 #include <wx/log.h>
@@ -101,6 +102,44 @@ void PCB_IO::FootprintEnumerate( wxArrayString& aFootprintNames, const wxString&
 }
 
 
+void PCB_IO::FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                          const wxString& aLibraryPath, bool aBestEfforts,
+                                          const STRING_UTF8_MAP* aProperties )
+{
+    wxArrayString footprintNames;
+    wxString      errorMsg;
+
+    // Summarize the footprints which could be read before reporting the others
+    try
+    {
+        FootprintEnumerate( footprintNames, aLibraryPath, aBestEfforts, aProperties );
+    }
+    catch( const IO_ERROR& ioe )
+    {
+        errorMsg = ioe.What();
+    }
+
+    for( const wxString& name : footprintNames )
+    {
+        FOOTPRINT_SUMMARY& summary = aSummaries.emplace_back();
+
+        summary.m_name = name;
+
+        // Should only fail with malformed/broken libraries
+        if( const FOOTPRINT* footprint = GetEnumeratedFootprint( aLibraryPath, name, aProperties ) )
+        {
+            summary.m_description = footprint->GetLibDescription();
+            summary.m_keywords = footprint->GetKeywords();
+            summary.m_padCount = footprint->GetPadCount( DO_NOT_INCLUDE_NPTH );
+            summary.m_uniquePadCount = footprint->GetUniquePadCount( DO_NOT_INCLUDE_NPTH );
+        }
+    }
+
+    if( !errorMsg.IsEmpty() )
+        THROW_IO_ERROR( errorMsg );
+}
+
+
 void PCB_IO::PrefetchLib( const wxString&, const STRING_UTF8_MAP* )
 {
 }
@@ -40,6 +40,20 @@ class STRING_UTF8_MAP;
 class PROJECT;
 class PROGRESS_REPORTER;
 
+
+/**
+ * What footprint lists and choosers show of a library footprint, see
+ * PCB_IO::FootprintEnumerateSummaries().
+ */
+struct FOOTPRINT_SUMMARY
+{
+    wxString     m_name;
+    wxString     m_description;
+    wxString     m_keywords;
+    unsigned int m_padCount = 0;
+    unsigned int m_uniquePadCount = 0;
+};
+
 /**
  * A base class that #BOARD loading and saving plugins should derive from.
  *
@@ -177,6 +191,24 @@ public:
     virtual void FootprintEnumerate( wxArrayString& aFootprintNames, const wxString& aLibraryPath,
                                      bool aBestEfforts, const STRING_UTF8_MAP* aProperties = nullptr );
 
+    /**
+     * Return the summaries of the footprints of the library at @a aLibraryPath, for footprint
+     * lists which don't need the footprints themselves.
+     *
+     * The default implementation loads every footprint with FootprintEnumerate() and
+     * GetEnumeratedFootprint().  Plugins which can summarize footprints faster should override it.
+     *
+     * @param aSummaries is filled with the summary of each footprint of the library.
+     * @param aLibraryPath is a locator for the "library", see FootprintEnumerate().
+     * @param aBestEfforts if true, don't throw on errors, just leave out what cannot be read.
+     * @param aProperties see FootprintEnumerate().
+     *
+     * @throw IO_ERROR if the library cannot be found, or footprint cannot be loaded.
+     */
+    virtual void FootprintEnumerateSummaries( std::vector<FOOTPRINT_SUMMARY>& aSummaries,
+                                              const wxString& aLibraryPath, bool aBestEfforts,
+                                              const STRING_UTF8_MAP* aProperties = nullptr );
+
     /**
      * Generate a timestamp representing all the files in the library (including the library
      * directory).
@@ -531,6 +531,101 @@ int PCB_PAINTER::getViaDrillSize( const PCB_VIA* aVia ) const
 }
 
 
+void PCB_PAINTER::PrepareDraw( const VIEW_ITEM* aItem )
+{
+    const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItem );
+
+    if( !item )
+        return;
+
+    auto triangulate =
+            [&]( SHAPE_POLY_SET& aPolySet )
+            {
+                // Same triangulation as the one draw() would make
+                if( aPolySet.OutlineCount() > 0 && !aPolySet.IsTriangulationUpToDate() )
+                    aPolySet.CacheTriangulation( true, true );
+            };
+
+    switch( item->Type() )
+    {
+    case PCB_PAD_T:
+    {
+        // Both are built under the pad's own locks
+        const PAD* pad = static_cast<const PAD*>( item );
+
+        pad->GetEffectiveShape();
+
+        if( pad->HasHole() )
+            pad->GetEffectiveHoleShape();
+
+        break;
+    }
+
+    case PCB_SHAPE_T:
+    {
+        PCB_SHAPE* shape = const_cast<PCB_SHAPE*>( static_cast<const PCB_SHAPE*>( item ) );
+
+        if( m_gal->IsOpenGlEngine() && shape->GetShape() == SHAPE_T::POLY && shape->IsFilled() )
+            triangulate( shape->GetPolyShape() );
+
+        break;
+    }
+
+    case PCB_ZONE_T:
+    {
+        const ZONE*       zone = static_cast<const ZONE*>( item );
+        ZONE_DISPLAY_MODE displayMode = m_pcbSettings.m_ZoneDisplayMode;
+
+        if( m_gal->IsOpenGlEngine() && !zone->GetIsRuleArea()
+                && ( displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED
+                     || displayMode == ZONE_DISPLAY_MODE::SHOW_FRACTURE_BORDERS
+                     || displayMode == ZONE_DISPLAY_MODE::SHOW_TRIANGULATION ) )
+        {
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            {
+                if( zone->HasFilledPolysForLayer( layer ) )
+                    triangulate( *zone->GetFilledPolysList( layer ) );
+            }
+        }
+
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+
+bool PCB_PAINTER::HasDetailLevels( const VIEW_ITEM* aItem, int aLayer ) const
+{
+    const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItem );
+
+    if( !item || aLayer == LAYER_LOCKED_ITEM_SHADOW )
+        return false;
+
+    switch( item->Type() )
+    {
+    case PCB_ZONE_T:
+        return IsZoneFillLayer( aLayer )
+                && m_pcbSettings.m_ZoneDisplayMode == ZONE_DISPLAY_MODE::SHOW_FILLED;
+
+    case PCB_FIELD_T:
+    case PCB_TEXT_T:
+        return !static_cast<const PCB_TEXT*>( item )->IsKnockout();
+
+    case PCB_ARC_T:
+        return true;
+
+    case PCB_SHAPE_T:
+        return static_cast<const PCB_SHAPE*>( item )->GetShape() == SHAPE_T::ARC;
+
+    default:
+        return false;
+    }
+}
+
+
 bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 {
     const BOARD_ITEM* item = dynamic_cast<const BOARD_ITEM*>( aItem );
@@ -849,7 +944,7 @@ void PCB_PAINTER::draw( const PCB_ARC* aArc, int aLayer )
         if( aLayer == LAYER_LOCKED_ITEM_SHADOW )
             width = width + m_lockedShadowMargin;
 
-        m_gal->DrawArcSegment( center, radius, start_angle, angle, width, m_maxError );
+        m_gal->DrawArcSegment( center, radius, start_angle, angle, width, arcMaxError() );
     }
 
     // Clearance lines
@@ -864,7 +959,7 @@ void PCB_PAINTER::draw( const PCB_ARC* aArc, int aLayer )
         m_gal->SetStrokeColor( color );
 
         m_gal->DrawArcSegment( center, radius, start_angle, angle, width + clearance * 2,
-                               m_maxError );
+                               arcMaxError() );
     }
 
 // Debug only: enable this code only to test the TransformArcToPolygon function
@@ -1835,7 +1930,7 @@ void PCB_PAINTER::draw( const PCB_SHAPE* aShape, int aLayer )
             if( outline_mode )
             {
                 m_gal->DrawArcSegment( aShape->GetCenter(), aShape->GetRadius(), startAngle,
-                                       endAngle - startAngle, thickness, m_maxError );
+                                       endAngle - startAngle, thickness, arcMaxError() );
             }
             else
             {
@@ -1843,7 +1938,7 @@ void PCB_PAINTER::draw( const PCB_SHAPE* aShape, int aLayer )
                 m_gal->SetIsStroke( false );
 
                 m_gal->DrawArcSegment( aShape->GetCenter(), aShape->GetRadius(), startAngle,
-                                       endAngle - startAngle, thickness, m_maxError );
+                                       endAngle - startAngle, thickness, arcMaxError() );
             }
             break;
         }
@@ -2106,7 +2201,22 @@ void PCB_PAINTER::draw( const PCB_TEXT* aText, int aLayer )
         if( font->IsOutline() )
             cache = aText->GetRenderCache( font, resolvedText );
 
-        if( cache )
+        // Zoomed out until the text is a couple of pixels high, a bar over it looks the same as
+        // its strokes or glyph triangles
+        if( m_detailTolerance > 0.0 && aText->GetTextHeight() < 2 * m_detailTolerance )
+        {
+            BOX2I    box = aText->GetTextBox();
+            VECTOR2I start( box.GetLeft(), box.GetCenter().y );
+            VECTOR2I end( box.GetRight(), box.GetCenter().y );
+
+            RotatePoint( start, aText->GetTextPos(), aText->GetTextAngle() );
+            RotatePoint( end, aText->GetTextPos(), aText->GetTextAngle() );
+
+            m_gal->SetIsFill( true );
+            m_gal->SetIsStroke( false );
+            m_gal->DrawSegment( start, end, box.GetHeight() / 2.0 );
+        }
+        else if( cache )
         {
             m_gal->SetLineWidth( attrs.m_StrokeWidth );
             m_gal->DrawGlyphs( *cache );
@@ -2474,6 +2584,26 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
         m_gal->SetFillColor( color );
         m_gal->SetLineWidth( 0 );
 
+        // Zoomed out, the details of the fill smaller than a pixel are dropped.  The view caches
+        // this coarser version apart from the full one.
+        if( m_detailTolerance > 0.0 && displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED )
+        {
+            SHAPE_POLY_SET coarse = *polySet;
+
+            coarse.SimplifyOutlines( KiROUND( m_detailTolerance ) );
+
+            if( coarse.OutlineCount() == 0 )
+                return;
+
+            if( m_gal->IsOpenGlEngine() )
+                coarse.CacheTriangulation( true, true );
+
+            m_gal->SetIsFill( true );
+            m_gal->SetIsStroke( false );
+            m_gal->DrawPolygon( coarse );
+            return;
+        }
+
         if( displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED )
         {
             m_gal->SetIsFill( true );
@@ -173,6 +173,12 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::PrepareDraw()
+    void PrepareDraw( const VIEW_ITEM* aItem ) override;
+
+    /// @copydoc PAINTER::HasDetailLevels()
+    bool HasDetailLevels( const VIEW_ITEM* aItem, int aLayer ) const override;
+
 protected:
     PCB_VIEWERS_SETTINGS_BASE* viewer_settings();
 
@@ -200,6 +206,12 @@ protected:
      */
     int getLineThickness( int aActualThickness ) const;
 
+    /**
+     * @return the error allowed when approximating arcs with segments, which grows when drawing
+     *         at a coarser detail level.
+     */
+    double arcMaxError() const { return std::max<double>( m_maxError, m_detailTolerance ); }
+
     /**
      * Return drill shape of a pad.
      */
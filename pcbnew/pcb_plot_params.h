@@ -146,6 +146,9 @@ public:
     void        SetSvgPrecision( unsigned aPrecision );
     unsigned    GetSvgPrecision() const { return m_svgPrecision; }
 
+    void        SetSvgCompact( bool aCompact ) { m_svgCompact = aCompact; }
+    bool        GetSvgCompact() const { return m_svgCompact; }
+
     void        SetBlackAndWhite( bool blackAndWhite ) { m_blackAndWhite = blackAndWhite; }
     unsigned    GetBlackAndWhite() const { return m_blackAndWhite; }
 
@@ -252,6 +255,9 @@ private:
     /// Precision of coordinates in SVG: accepted 3 - 6; 6 is the internal resolution of Pcbnew
     unsigned   m_svgPrecision;
 
+    /// Write merged paths, reused pad shapes and integer coordinates in SVG (not saved)
+    bool       m_svgCompact;
+
     bool       m_useAuxOrigin;          ///< Plot gerbers using auxiliary (drill) origin instead
                                         ///<   of absolute coordinates
 
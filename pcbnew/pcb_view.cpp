@@ -24,17 +24,22 @@
  */
 
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 using namespace std::placeholders;
 
 #include <pcb_view.h>
 #include <pcb_display_options.h>
 #include <pcb_painter.h>
+#include <board.h>
 #include <footprint.h>
+#include <connectivity/connectivity_data.h>
 
 namespace KIGFX {
 PCB_VIEW::PCB_VIEW( bool aIsDynamic ) :
-    VIEW( aIsDynamic )
+    VIEW( aIsDynamic ),
+    m_colorsHighlightEnabled( false )
 {
     // Set m_boundary to define the max area size. The default value is acceptable for Pcbnew
     // and Gerbview.
@@ -72,6 +77,29 @@ void PCB_VIEW::Remove( KIGFX::VIEW_ITEM* aItem )
 }
 
 
+void PCB_VIEW::RemoveItems( const std::vector<KIGFX::VIEW_ITEM*>& aItems )
+{
+    std::vector<KIGFX::VIEW_ITEM*> items;
+    items.reserve( aItems.size() );
+
+    for( KIGFX::VIEW_ITEM* item : aItems )
+    {
+        if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( item ) )
+        {
+            footprint->RunOnChildren(
+                    [&]( BOARD_ITEM* child )
+                    {
+                        items.push_back( child );
+                    } );
+        }
+
+        items.push_back( item );
+    }
+
+    VIEW::RemoveItems( items );
+}
+
+
 void PCB_VIEW::Update( const KIGFX::VIEW_ITEM* aItem, int aUpdateFlags ) const
 {
     if( const BOARD_ITEM* boardItem = dynamic_cast<const BOARD_ITEM*>( aItem ) )
@@ -93,6 +121,67 @@ void PCB_VIEW::Update( const KIGFX::VIEW_ITEM* aItem ) const
 }
 
 
+void PCB_VIEW::UpdateAllLayersColor()
+{
+    const RENDER_SETTINGS* settings = GetPainter()->GetSettings();
+
+    m_colorsHighlightEnabled = settings->IsHighlightEnabled();
+    m_colorsHighlightNets = settings->GetHighlightNetCodes();
+
+    VIEW::UpdateAllLayersColor();
+}
+
+
+void PCB_VIEW::UpdateHighlightColors( BOARD* aBoard )
+{
+    const RENDER_SETTINGS* settings = GetPainter()->GetSettings();
+    const std::set<int>&   nets = settings->GetHighlightNetCodes();
+
+    if( settings->IsHighlightEnabled() == m_colorsHighlightEnabled
+            && nets == m_colorsHighlightNets )
+    {
+        return;
+    }
+
+    // Turning highlighting on or off dims or restores everything.  Items without a net (-1) and
+    // unconnected ones (0) are not all in the connectivity, so their nets are recolored in full.
+    if( !aBoard || !settings->IsHighlightEnabled() || !m_colorsHighlightEnabled )
+    {
+        UpdateAllLayersColor();
+        return;
+    }
+
+    std::set<int> changedNets;
+
+    std::set_symmetric_difference( nets.begin(), nets.end(), m_colorsHighlightNets.begin(),
+                                   m_colorsHighlightNets.end(),
+                                   std::inserter( changedNets, changedNets.begin() ) );
+
+    if( changedNets.empty() || *changedNets.begin() <= 0 )
+    {
+        UpdateAllLayersColor();
+        return;
+    }
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = aBoard->GetConnectivity();
+
+    for( int net : changedNets )
+    {
+        for( BOARD_CONNECTED_ITEM* item : connectivity->GetNetItems( net, { PCB_TRACE_T,
+                                                                            PCB_ARC_T,
+                                                                            PCB_VIA_T,
+                                                                            PCB_PAD_T,
+                                                                            PCB_ZONE_T,
+                                                                            PCB_SHAPE_T } ) )
+        {
+            VIEW::Update( item, COLOR );
+        }
+    }
+
+    m_colorsHighlightNets = nets;
+}
+
+
 void PCB_VIEW::UpdateDisplayOptions( const PCB_DISPLAY_OPTIONS& aOptions )
 {
     KIGFX::PCB_PAINTER*         painter  = static_cast<KIGFX::PCB_PAINTER*>( GetPainter() );
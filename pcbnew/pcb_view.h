@@ -25,10 +25,13 @@
 #ifndef __PCB_VIEW_H
 #define __PCB_VIEW_H
 
+#include <set>
+
 #include <layer_ids.h>
 #include <view/view.h>
 #include <board_item.h>
 
+class BOARD;
 class PCB_DISPLAY_OPTIONS;
 
 namespace KIGFX {
@@ -45,13 +48,33 @@ public:
     /// @copydoc VIEW::Remove()
     virtual void Remove( VIEW_ITEM* aItem ) override;
 
+    /// @copydoc VIEW::RemoveItems()
+    virtual void RemoveItems( const std::vector<VIEW_ITEM*>& aItems ) override;
+
     /// @copydoc VIEW::Update()
     virtual void Update( const VIEW_ITEM* aItem, int aUpdateFlags ) const override;
 
     /// @copydoc VIEW::Update()
     virtual void Update( const VIEW_ITEM* aItem ) const override;
 
+    /// @copydoc VIEW::UpdateAllLayersColor()
+    virtual void UpdateAllLayersColor() override;
+
+    /**
+     * Apply a change of the highlighted nets of the #RENDER_SETTINGS to the item colors.
+     *
+     * While highlighting stays on, only the items of the nets which were highlighted or just
+     * became so change color, and they are found in the connectivity of \a aBoard rather than by
+     * recoloring all the items.  Other changes recolor everything.
+     */
+    void UpdateHighlightColors( BOARD* aBoard );
+
     void UpdateDisplayOptions( const PCB_DISPLAY_OPTIONS& aOptions );
+
+private:
+    ///< Highlighting of the item colors, as of the last recolor
+    bool          m_colorsHighlightEnabled;
+    std::set<int> m_colorsHighlightNets;
 };
 
 }
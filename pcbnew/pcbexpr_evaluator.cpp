@@ -192,17 +192,60 @@ protected:
 };
 
 
+void PCBEXPR_VAR_REF::AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop )
+{
+    PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
+    BOUND_PROPERTY    bound = { prop, propMgr.GetTypeCast( type_hash, prop->OwnerHash() ),
+                                ACCESSOR::NUMBER };
+
+    // Objects which can't be cast to the owner of the property don't have it
+    if( !bound.m_cast && !propMgr.IsOfType( type_hash, prop->OwnerHash() ) )
+        return;
+
+    if( prop->TypeHash() == TYPE_HASH( int ) || prop->TypeHash() == TYPE_HASH( bool ) )
+    {
+        bound.m_accessor = ACCESSOR::NUMBER;
+    }
+    else if( prop->TypeHash() == TYPE_HASH( wxString ) )
+    {
+        if( prop->Name() == wxT( "Pin Type" ) )
+            bound.m_accessor = ACCESSOR::PIN_TYPE;
+        else
+            bound.m_accessor = ACCESSOR::STRING;
+    }
+    else if( prop->HasChoices() )
+    {
+        if( prop->Name() == wxT( "Layer" )
+                || prop->Name() == wxT( "Layer Top" )
+                || prop->Name() == wxT( "Layer Bottom" ) )
+        {
+            bound.m_accessor = ACCESSOR::LAYER;
+        }
+        else
+        {
+            bound.m_accessor = ACCESSOR::ENUM;
+        }
+    }
+    else
+    {
+        return;
+    }
+
+    m_matchingTypes[type_hash] = bound;
+}
+
+
 LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
 {
     PCBEXPR_CONTEXT* context = static_cast<PCBEXPR_CONTEXT*>( aCtx );
 
     if( m_itemIndex == 2 )
-        return new PCBEXPR_LAYER_VALUE( context->GetLayer() );
+        return aCtx->StoreValue( new PCBEXPR_LAYER_VALUE( context->GetLayer() ) );
 
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
     auto it = m_matchingTypes.find( TYPE_HASH( *item ) );
 
@@ -212,51 +255,60 @@ LIBEVAL::VALUE* PCBEXPR_VAR_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
         // simpler "A.Via_Type == 'buried'" is perfectly clear.  Instead, return an undefined
         // value when the property doesn't appear on a particular object.
 
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
     }
-    else
+
+    const BOUND_PROPERTY& bound = it->second;
+    const INSPECTABLE*    object = item;
+    const void*           owner = bound.m_cast ? ( *bound.m_cast )( object ) : object;
+    LIBEVAL::VALUE*       value = nullptr;
+    wxString              str;
+    int                   num;
+
+    switch( bound.m_accessor )
     {
-        if( m_type == LIBEVAL::VT_NUMERIC )
+    case ACCESSOR::NUMBER:
+        if( bound.m_property->GetInt( owner, num ) )
         {
-            return new LIBEVAL::VALUE( (double) item->Get<int>( it->second ) );
+            value = aCtx->AllocValue();
+            value->Set( (double) num );
+            return value;
         }
-        else
+
+        break;
+
+    case ACCESSOR::STRING:
+    case ACCESSOR::ENUM:
+        if( bound.m_property->GetString( owner, str ) )
         {
-            wxString str;
+            value = aCtx->AllocValue();
+            value->Set( str );
+            return value;
+        }
 
-            if( !m_isEnum )
-            {
-                str = item->Get<wxString>( it->second );
+        break;
 
-                if( it->second->Name() == wxT( "Pin Type" ) )
-                    return new PCBEXPR_PINTYPE_VALUE( str );
-                else
-                    return new LIBEVAL::VALUE( str );
-            }
-            else
-            {
-                const wxAny& any = item->Get( it->second );
-                PCB_LAYER_ID layer;
+    case ACCESSOR::PIN_TYPE:
+        if( bound.m_property->GetString( owner, str ) )
+            return aCtx->StoreValue( new PCBEXPR_PINTYPE_VALUE( str ) );
 
-                if( it->second->Name() == wxT( "Layer" )
-                        || it->second->Name() == wxT( "Layer Top" )
-                        || it->second->Name() == wxT( "Layer Bottom" ) )
-                {
-                    if( any.GetAs<PCB_LAYER_ID>( &layer ) )
-                        return new PCBEXPR_LAYER_VALUE( layer );
-                    else if( any.GetAs<wxString>( &str ) )
-                        return new PCBEXPR_LAYER_VALUE( context->GetBoard()->GetLayerID( str ) );
-                }
-                else
-                {
-                    if( any.GetAs<wxString>( &str ) )
-                        return new LIBEVAL::VALUE( str );
-                }
-            }
+        break;
 
-            return new LIBEVAL::VALUE();
+    case ACCESSOR::LAYER:
+        if( bound.m_property->GetInt( owner, num ) )
+        {
+            return aCtx->StoreValue( new PCBEXPR_LAYER_VALUE( static_cast<PCB_LAYER_ID>( num ) ) );
+        }
+        else if( bound.m_property->GetString( owner, str ) )
+        {
+            PCB_LAYER_ID layer = context->GetBoard()->GetLayerID( str );
+            return aCtx->StoreValue( new PCBEXPR_LAYER_VALUE( layer ) );
         }
+
+        break;
     }
+
+    return aCtx->AllocValue();
 }
 
 
@@ -265,9 +317,9 @@ LIBEVAL::VALUE* PCBEXPR_NETCLASS_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NETCLASS_VALUE( item );
+    return aCtx->StoreValue( new PCBEXPR_NETCLASS_VALUE( item ) );
 }
 
 
@@ -276,9 +328,9 @@ LIBEVAL::VALUE* PCBEXPR_NETNAME_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_CONNECTED_ITEM* item = dynamic_cast<BOARD_CONNECTED_ITEM*>( GetObject( aCtx ) );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new PCBEXPR_NET_VALUE( item );
+    return aCtx->StoreValue( new PCBEXPR_NET_VALUE( item ) );
 }
 
 
@@ -287,9 +339,11 @@ LIBEVAL::VALUE* PCBEXPR_TYPE_REF::GetValue( LIBEVAL::CONTEXT* aCtx )
     BOARD_ITEM* item = GetObject( aCtx );
 
     if( !item )
-        return new LIBEVAL::VALUE();
+        return aCtx->AllocValue();
 
-    return new LIBEVAL::VALUE( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    LIBEVAL::VALUE* value = aCtx->AllocValue();
+    value->Set( ENUM_MAP<KICAD_T>::Instance().ToString( item->Type() ) );
+    return value;
 }
 
 
@@ -25,8 +25,10 @@
 #ifndef PCBEXPR_EVALUATOR_H
 #define PCBEXPR_EVALUATOR_H
 
+#include <functional>
 #include <unordered_map>
 
+#include <math/box2.h>
 #include <properties/property.h>
 #include <properties/property_mgr.h>
 
@@ -34,6 +36,7 @@
 
 class BOARD;
 class BOARD_ITEM;
+class ZONE;
 
 class PCBEXPR_VAR_REF;
 
@@ -96,17 +99,35 @@ public:
     void SetType( LIBEVAL::VAR_TYPE_T type ) { m_type = type; }
     LIBEVAL::VAR_TYPE_T GetType() const override { return m_type; }
 
-    void AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop )
-    {
-        m_matchingTypes[type_hash] = prop;
-    }
+    /**
+     * Bind the property to read for the objects of a class.  The cast to the owner of the
+     * property and the way to read it are chosen here, so that GetValue() only calls the
+     * typed getter of the property.
+     */
+    void AddAllowedClass( TYPE_ID type_hash, PROPERTY_BASE* prop );
 
     LIBEVAL::VALUE* GetValue( LIBEVAL::CONTEXT* aCtx ) override;
 
     BOARD_ITEM* GetObject( const LIBEVAL::CONTEXT* aCtx ) const;
 
 private:
-    std::unordered_map<TYPE_ID, PROPERTY_BASE*> m_matchingTypes;
+    enum class ACCESSOR
+    {
+        NUMBER,       ///< int or bool property
+        STRING,       ///< wxString property
+        PIN_TYPE,     ///< wxString property compared as a pin type
+        LAYER,        ///< layer property
+        ENUM          ///< other enum property, compared by the name of its value
+    };
+
+    struct BOUND_PROPERTY
+    {
+        PROPERTY_BASE*        m_property;
+        const TYPE_CAST_BASE* m_cast;        ///< nullptr if the object is used as is
+        ACCESSOR              m_accessor;
+    };
+
+    std::unordered_map<TYPE_ID, BOUND_PROPERTY> m_matchingTypes;
     int                                         m_itemIndex;
     LIBEVAL::VAR_TYPE_T                         m_type;
     bool                                        m_isEnum;
@@ -191,6 +212,25 @@ private:
 };
 
 
+/**
+ * Call \a aFunc for each rule area an intersectsArea() argument designates, until it returns
+ * true.  A and B designate the items of \a aCtx, which may not be areas.
+ *
+ * @return true if \a aFunc did.
+ */
+bool searchAreas( BOARD* aBoard, const wxString& aArg, PCBEXPR_CONTEXT* aCtx,
+                  const std::function<bool( ZONE* )>& aFunc );
+
+/**
+ * Test \a aItem against a rule area as intersectsArea() does, for the layer of \a aCtx, going
+ * through the area test cache of the board.
+ *
+ * @param aItemBBox is the bounding box of \a aItem.
+ */
+bool testIntersectsArea( BOARD_ITEM* aItem, const BOX2I& aItemBBox, ZONE* aArea,
+                         PCBEXPR_CONTEXT* aCtx );
+
+
 class PCBEXPR_UNIT_RESOLVER : public LIBEVAL::UNIT_RESOLVER
 {
 public:
@@ -185,12 +185,34 @@ static void isPlatedFunc( LIBEVAL::CONTEXT* aCtx, void* self )
 }
 
 
+/**
+ * Run a test of \a aItem against a rule area or a footprint through the area test cache of the
+ * board, for the layer of \a aCtx.
+ */
+static bool cachedTest( AREA_TEST_CACHE::TEST aTest, BOARD_ITEM* aArea, BOARD_ITEM* aItem,
+                        PCBEXPR_CONTEXT* aCtx, const std::function<bool()>& aTestFunc )
+{
+    // Router items are temporary
+    if( aItem->GetFlags() & ROUTER_TRANSIENT )
+        return aTestFunc();
+
+    AREA_TEST_CACHE&    cache = aItem->GetBoard()->m_AreaTestCache;
+    std::optional<bool> cached = cache.Get( aTest, aArea, aItem, aCtx->GetLayer() );
+
+    if( cached )
+        return *cached;
+
+    bool result = aTestFunc();
+
+    cache.Set( aTest, aArea, aItem, aCtx->GetLayer(), result );
+    return result;
+}
+
+
 bool collidesWithCourtyard( BOARD_ITEM* aItem, std::shared_ptr<SHAPE>& aItemShape,
                             PCBEXPR_CONTEXT* aCtx, FOOTPRINT* aFootprint, PCB_LAYER_ID aSide )
 {
-    SHAPE_POLY_SET footprintCourtyard;
-
-    footprintCourtyard = aFootprint->GetCourtyard( aSide );
+    const SHAPE_POLY_SET& footprintCourtyard = aFootprint->GetCourtyard( aSide );
 
     if( !aItemShape )
     {
@@ -271,24 +293,15 @@ static void intersectsCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                auto i = board->m_IntersectsCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsCourtyardCache.end() )
-                                    return i->second;
-                            }
-
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu )
-                                    || collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsCourtyardCache[ key ] = res;
-
-                            return res;
+                            return cachedTest( AREA_TEST_CACHE::TEST::INTERSECTS_COURTYARD, fp,
+                                               item, context,
+                                    [&]()
+                                    {
+                                        return collidesWithCourtyard( item, itemShape, context,
+                                                                      fp, F_Cu )
+                                               || collidesWithCourtyard( item, itemShape, context,
+                                                                         fp, B_Cu );
+                                    } );
                         } ) )
                 {
                     return 1.0;
@@ -331,23 +344,13 @@ static void intersectsFrontCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                auto i = board->m_IntersectsFCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsFCourtyardCache.end() )
-                                    return i->second;
-                            }
-
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, F_Cu );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsFCourtyardCache[ key ] = res;
-
-                            return res;
+                            return cachedTest( AREA_TEST_CACHE::TEST::INTERSECTS_FRONT_COURTYARD,
+                                               fp, item, context,
+                                    [&]()
+                                    {
+                                        return collidesWithCourtyard( item, itemShape, context,
+                                                                      fp, F_Cu );
+                                    } );
                         } ) )
                 {
                     return 1.0;
@@ -390,23 +393,13 @@ static void intersectsBackCourtyardFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                 if( searchFootprints( board, arg->AsString(), context,
                         [&]( FOOTPRINT* fp )
                         {
-                            PTR_PTR_CACHE_KEY            key = { fp, item };
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                auto i = board->m_IntersectsBCourtyardCache.find( key );
-
-                                if( i != board->m_IntersectsBCourtyardCache.end() )
-                                    return i->second;
-                            }
-
-                            bool res = collidesWithCourtyard( item, itemShape, context, fp, B_Cu );
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_IntersectsBCourtyardCache[ key ] = res;
-
-                            return res;
+                            return cachedTest( AREA_TEST_CACHE::TEST::INTERSECTS_BACK_COURTYARD,
+                                               fp, item, context,
+                                    [&]()
+                                    {
+                                        return collidesWithCourtyard( item, itemShape, context,
+                                                                      fp, B_Cu );
+                                    } );
                         } ) )
                 {
                     return 1.0;
@@ -423,13 +416,10 @@ bool collidesWithArea( BOARD_ITEM* aItem, PCBEXPR_CONTEXT* aCtx, ZONE* aArea )
     BOX2I                  areaBBox = aArea->GetBoundingBox();
     std::shared_ptr<SHAPE> shape;
 
-    // Collisions include touching, so we need to deflate outline by enough to exclude it.
-    // This is particularly important for detecting copper fills as they will be exactly
-    // touching along the entire exclusion border.
-    SHAPE_POLY_SET areaOutline = aArea->Outline()->CloneDropTriangulation();
-    areaOutline.ClearArcs();
-    areaOutline.Deflate( board->GetDesignSettings().GetDRCEpsilon(),
-                         CORNER_STRATEGY::ALLOW_ACUTE_CORNERS, ARC_LOW_DEF );
+    // The outline is deflated by the DRC epsilon, as collisions include touching
+    std::shared_ptr<const SHAPE_POLY_SET> testOutline = board->m_AreaTestCache.GetTestOutline(
+            aArea, board->GetDesignSettings().GetDRCEpsilon() );
+    const SHAPE_POLY_SET& areaOutline = *testOutline;
 
     if( aItem->GetFlags() & HOLE_PROXY )
     {
@@ -504,15 +494,15 @@ bool collidesWithArea( BOARD_ITEM* aItem, PCBEXPR_CONTEXT* aCtx, ZONE* aArea )
         if( !zone->IsFilled() )
             return false;
 
-        DRC_RTREE* zoneRTree = board->m_CopperZoneRTreeCache[ zone ].get();
+        auto zoneRTree = board->m_CopperZoneRTreeCache.find( zone );
 
-        if( zoneRTree )
+        if( zoneRTree != board->m_CopperZoneRTreeCache.end() && zoneRTree->second )
         {
             for( PCB_LAYER_ID layer : aArea->GetLayerSet().Seq() )
             {
                 if( aCtx->GetLayer() == layer || aCtx->GetLayer() == UNDEFINED_LAYER )
                 {
-                    if( zoneRTree->QueryColliding( areaBBox, &areaOutline, layer ) )
+                    if( zoneRTree->second->QueryColliding( areaBBox, &areaOutline, layer ) )
                         return true;
                 }
             }
@@ -601,6 +591,41 @@ bool searchAreas( BOARD* aBoard, const wxString& aArg, PCBEXPR_CONTEXT* aCtx,
 }
 
 
+bool testIntersectsArea( BOARD_ITEM* aItem, const BOX2I& aItemBBox, ZONE* aArea,
+                         PCBEXPR_CONTEXT* aCtx )
+{
+    if( !aArea || aArea == aItem || aArea->GetParent() == aItem )
+        return false;
+
+    if( !( aArea->GetLayerSet() & aItem->GetLayerSet() ).any() )
+        return false;
+
+    if( !aArea->GetBoundingBox().Intersects( aItemBBox ) )
+        return false;
+
+    auto test =
+            [&]()
+            {
+                return collidesWithArea( aItem, aCtx, aArea );
+            };
+
+    // Zones are tested on their fill, which DRC indexes before its tests; without the index
+    // the result would be wrong until the next fill
+    if( aItem->Type() == PCB_ZONE_T )
+    {
+        BOARD* board = aItem->GetBoard();
+
+        if( !board->m_CopperZoneRTreeCache.count( static_cast<ZONE*>( aItem ) ) )
+            return test();
+    }
+
+    if( aItem->GetFlags() & HOLE_PROXY )
+        return cachedTest( AREA_TEST_CACHE::TEST::HOLE_INTERSECTS_AREA, aArea, aItem, aCtx, test );
+    else
+        return cachedTest( AREA_TEST_CACHE::TEST::INTERSECTS_AREA, aArea, aItem, aCtx, test );
+}
+
+
 #define MISSING_AREA_ARG( f ) \
     wxString::Format( _( "Missing rule-area argument (A, B, or rule-area name) to %s." ), f )
 
@@ -630,55 +655,13 @@ static void intersectsAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
     result->SetDeferredEval(
             [item, arg, context]() -> double
             {
-                BOARD*       board = item->GetBoard();
-                PCB_LAYER_ID aLayer = context->GetLayer();
-                BOX2I        itemBBox = item->GetBoundingBox();
+                BOARD* board = item->GetBoard();
+                BOX2I  itemBBox = item->GetBoundingBox();
 
                 if( searchAreas( board, arg->AsString(), context,
                         [&]( ZONE* aArea )
                         {
-                            if( !aArea || aArea == item || aArea->GetParent() == item )
-                                return false;
-
-                            LSET commonLayers = aArea->GetLayerSet() & item->GetLayerSet();
-
-                            if( !commonLayers.any() )
-                                return false;
-
-                            if( !aArea->GetBoundingBox().Intersects( itemBBox ) )
-                                return false;
-
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                            LSET                         testLayers;
-                            PTR_PTR_LAYER_CACHE_KEY      key;
-
-                            if( aLayer != UNDEFINED_LAYER )
-                                testLayers.set( aLayer );
-                            else
-                                testLayers = commonLayers;
-
-                            for( PCB_LAYER_ID layer : testLayers.UIOrder() )
-                            {
-                                if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                {
-                                    key = { aArea, item, layer };
-
-                                    auto i = board->m_IntersectsAreaCache.find( key );
-
-                                    if( i != board->m_IntersectsAreaCache.end() && i->second )
-                                        return true;
-                                }
-
-                                bool collides = collidesWithArea( item, context, aArea );
-
-                                if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                    board->m_IntersectsAreaCache[ key ] = collides;
-
-                                if( collides )
-                                    return true;
-                            }
-
-                            return false;
+                            return testIntersectsArea( item, itemBBox, aArea, context );
                         } ) )
                 {
                     return 1.0;
@@ -732,40 +715,24 @@ static void enclosedByAreaFunc( LIBEVAL::CONTEXT* aCtx, void* self )
                             if( !aArea->GetBoundingBox().Intersects( itemBBox ) )
                                 return false;
 
-                            std::unique_lock<std::mutex> cacheLock( board->m_CachesMutex );
-                            PTR_PTR_LAYER_CACHE_KEY      key = { aArea, item, layer };
-
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                            {
-                                auto i = board->m_EnclosedByAreaCache.find( key );
-
-                                if( i != board->m_EnclosedByAreaCache.end() )
-                                    return i->second;
-                            }
-
-                            SHAPE_POLY_SET itemShape;
-                            bool           enclosedByArea;
-
-                            item->TransformShapeToPolygon( itemShape, layer, 0, maxError,
-                                                           ERROR_OUTSIDE );
+                            return cachedTest( AREA_TEST_CACHE::TEST::ENCLOSED_BY_AREA, aArea,
+                                               item, context,
+                                    [&]()
+                                    {
+                                        SHAPE_POLY_SET itemShape;
 
-                            if( itemShape.IsEmpty() )
-                            {
-                                // If it's already empty then our test will have no meaning.
-                                enclosedByArea = false;
-                            }
-                            else
-                            {
-                                itemShape.BooleanSubtract( *aArea->Outline(),
-                                                           SHAPE_POLY_SET::PM_FAST );
+                                        item->TransformShapeToPolygon( itemShape, layer, 0,
+                                                                       maxError, ERROR_OUTSIDE );
 
-                                enclosedByArea = itemShape.IsEmpty();
-                            }
+                                        // If it's already empty then our test has no meaning
+                                        if( itemShape.IsEmpty() )
+                                            return false;
 
-                            if( ( item->GetFlags() & ROUTER_TRANSIENT ) == 0 )
-                                board->m_EnclosedByAreaCache[ key ] = enclosedByArea;
+                                        itemShape.BooleanSubtract( *aArea->Outline(),
+                                                                   SHAPE_POLY_SET::PM_FAST );
 
-                            return enclosedByArea;
+                                        return itemShape.IsEmpty();
+                                    } );
                         } ) )
                 {
                     return 1.0;
@@ -27,6 +27,7 @@
 #include <pgm_base.h>
 #include <cli_progress_reporter.h>
 #include <confirm.h>
+#include <core/trace_profiler.h>
 #include <kiface_base.h>
 #include <kiface_ids.h>
 #include <pcb_edit_frame.h>
@@ -395,6 +396,8 @@ FOOTPRINT_LIST_IMPL   GFootprintList;
 
 bool IFACE::OnKifaceStart( PGM_BASE* aProgram, int aCtlBits )
 {
+    TRACE_SCOPE( "Kiface start" );
+
     // This is process-level-initialization, not project-level-initialization of the DSO.
     // Do nothing in here pertinent to a project!
     InitSettings( new PCBNEW_SETTINGS );
@@ -436,6 +439,8 @@ void IFACE::Reset()
 
 bool IFACE::loadGlobalLibTable()
 {
+    TRACE_SCOPE( "Load global library table" );
+
     wxFileName fn = FP_LIB_TABLE::GetGlobalTableFileName();
 
     if( !fn.FileExists() )
@@ -18,14 +18,24 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <atomic>
+#include <mutex>
+#include <set>
+
 #include <wx/dir.h>
+#include <wx/ffile.h>
 #include "pcbnew_jobs_handler.h"
 #include <board_commit.h>
+#include <board_memory_report.h>
 #include <board_design_settings.h>
+#include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <drc/drc_report.h>
+#include <drc/drc_result_cache.h>
+#include <drc/drc_shards.h>
 #include <drawing_sheet/ds_data_model.h>
 #include <drawing_sheet/ds_proxy_view_item.h>
+#include <jobs/job_fp_convert.h>
 #include <jobs/job_fp_export_svg.h>
 #include <jobs/job_fp_upgrade.h>
 #include <jobs/job_export_pcb_gerber.h>
@@ -37,7 +47,9 @@
 #include <jobs/job_export_pcb_svg.h>
 #include <jobs/job_export_pcb_3d.h>
 #include <jobs/job_pcb_drc.h>
+#include <jobs/job_pcb_memory_report.h>
 #include <cli/exit_codes.h>
+#include <core/thread_pool.h>
 #include <exporters/place_file_exporter.h>
 #include <exporters/step/exporter_step.h>
 #include <plotters/plotter_dxf.h>
@@ -50,7 +62,10 @@
 #include <gendrill_Excellon_writer.h>
 #include <gendrill_gerber_writer.h>
 #include <kiface_base.h>
+#include <locale_io.h>
 #include <macros.h>
+#include <memory_report.h>
+#include <footprint.h>
 #include <pad.h>
 #include <pcb_marker.h>
 #include <project/project_file.h>
@@ -59,9 +74,13 @@
 #include <pcbplot.h>
 #include <pgm_base.h>
 #include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/pcb_io_mgr.h>
 #include <reporter.h>
+#include <string_utils.h>
 #include <wildcards_and_files_ext.h>
 #include <export_vrml.h>
+#include <zone_fill_hasher.h>
+#include <zone_filler.h>
 
 #include "pcbnew_scripting_helpers.h"
 
@@ -81,9 +100,13 @@ PCBNEW_JOBS_HANDLER::PCBNEW_JOBS_HANDLER()
     Register( "pos", std::bind( &PCBNEW_JOBS_HANDLER::JobExportPos, this, std::placeholders::_1 ) );
     Register( "fpupgrade",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportFpUpgrade, this, std::placeholders::_1 ) );
+    Register( "fpconvert",
+              std::bind( &PCBNEW_JOBS_HANDLER::JobFootprintConvert, this, std::placeholders::_1 ) );
     Register( "fpsvg",
               std::bind( &PCBNEW_JOBS_HANDLER::JobExportFpSvg, this, std::placeholders::_1 ) );
     Register( "drc", std::bind( &PCBNEW_JOBS_HANDLER::JobExportDrc, this, std::placeholders::_1 ) );
+    Register( "memoryreport",
+              std::bind( &PCBNEW_JOBS_HANDLER::JobMemoryReport, this, std::placeholders::_1 ) );
 }
 
 
@@ -97,7 +120,7 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aStepJob->m_filename );
+    BOARD* brd = getBoard( aJob, aStepJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
     if( aStepJob->m_outputFile.IsEmpty() )
@@ -160,6 +183,38 @@ int PCBNEW_JOBS_HANDLER::JobExportStep( JOB* aJob )
             return CLI::EXIT_CODES::ERR_UNKNOWN;
         }
     }
+    else if( aStepJob->m_format == JOB_EXPORT_PCB_3D::FORMAT::GLB && aStepJob->m_fastMesh )
+    {
+        // Meshes only, from the VRML exporter scene and the 3D cache models: no B-rep is built
+        EXPORTER_VRML vrmlExporter( brd );
+        wxString      messages;
+        VECTOR2I      origin( aStepJob->m_xOrigin, aStepJob->m_yOrigin );
+
+        if( aStepJob->m_useDrillOrigin )
+            origin = brd->GetDesignSettings().GetAuxOrigin();
+        else if( aStepJob->m_useGridOrigin )
+            origin = brd->GetDesignSettings().GetGridOrigin();
+        else if( !aStepJob->m_hasUserOrigin )
+            origin = brd->ComputeBoundingBox( true ).GetCenter();
+
+        bool success = vrmlExporter.ExportGLB_File(
+                brd->GetProject(), &messages, aStepJob->m_outputFile, aStepJob->m_meshDecimation,
+                aStepJob->m_boardOnly, pcbIUScale.IUTomm( origin.x ),
+                pcbIUScale.IUTomm( origin.y ) );
+
+        if( success )
+        {
+            m_reporter->Report( wxString::Format( _( "Successfully exported glTF to %s" ),
+                                                  aStepJob->m_outputFile ),
+                                RPT_SEVERITY_INFO );
+        }
+        else
+        {
+            m_reporter->Report( messages.IsEmpty() ? _( "Error exporting glTF" ) : messages,
+                                RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_UNKNOWN;
+        }
+    }
     else
     {
         EXPORTER_STEP_PARAMS params;
@@ -213,6 +268,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     svgPlotOptions.m_outputFile = aSvgJob->m_outputFile;
     svgPlotOptions.m_mirror = aSvgJob->m_mirror;
     svgPlotOptions.m_negative = aSvgJob->m_negative;
+    svgPlotOptions.m_compact = aSvgJob->m_compact;
     svgPlotOptions.m_pageSizeMode = aSvgJob->m_pageSizeMode;
     svgPlotOptions.m_printMaskLayer = aSvgJob->m_printMaskLayer;
     svgPlotOptions.m_plotFrame = aSvgJob->m_plotDrawingSheet;
@@ -221,7 +277,7 @@ int PCBNEW_JOBS_HANDLER::JobExportSvg( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aSvgJob->m_filename );
+    BOARD* brd = getBoard( aJob, aSvgJob->m_filename );
     loadOverrideDrawingSheet( brd, aSvgJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
@@ -247,7 +303,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDxf( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aDxfJob->m_filename );
+    BOARD* brd = getBoard( aJob, aDxfJob->m_filename );
     loadOverrideDrawingSheet( brd, aDxfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
@@ -304,7 +360,7 @@ int PCBNEW_JOBS_HANDLER::JobExportPdf( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aPdfJob->m_filename );
+    BOARD* brd = getBoard( aJob, aPdfJob->m_filename );
     loadOverrideDrawingSheet( brd, aPdfJob->m_drawingSheet );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
@@ -375,9 +431,12 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aGerberJob->m_filename );
+    BOARD* brd = getBoard( aJob, aGerberJob->m_filename );
     loadOverrideDrawingSheet( brd, aGerberJob->m_drawingSheet );
 
+    if( aGerberJob->m_refillIfStale )
+        refillStaleZones( brd );
+
     PCB_PLOT_PARAMS       boardPlotOptions = brd->GetPlotOptions();
     LSET                  plotOnAllLayersSelection = boardPlotOptions.GetPlotOnAllLayersSelection();
     GERBER_JOBFILE_WRITER jobfile_writer( brd );
@@ -405,6 +464,18 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
             aGerberJob->m_layersIncludeOnAll = plotOnAllLayersSelection;
     }
 
+    // The layers are independent files: list them first, then plot them in parallel
+    struct LAYER_PLOT
+    {
+        PCB_LAYER_ID    m_layer;
+        LSEQ            m_sequence;
+        PCB_PLOT_PARAMS m_plotOpts;
+        wxString        m_fullPath;
+        bool            m_success = false;
+    };
+
+    std::vector<LAYER_PLOT> layerPlots;
+
     for( LSEQ seq = LSET( aGerberJob->m_printMaskLayer ).UIOrder(); seq; ++seq )
     {
         LSEQ plotSequence;
@@ -442,26 +513,52 @@ int PCBNEW_JOBS_HANDLER::JobExportGerbers( JOB* aJob )
 
         jobfile_writer.AddGbrFile( layer, fullname );
 
-        // We are feeding it one layer at the start here to silence a logic check
-        GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard(
-                brd, &plotOpts, layer, fn.GetFullPath(), wxEmptyString, wxEmptyString );
+        layerPlots.push_back( { layer, plotSequence, plotOpts, fn.GetFullPath() } );
+    }
+
+    PrepareBoardForParallelPlot( brd );
 
-        if( plotter )
+    {
+        // Keep the C locale for all the plotting threads
+        LOCALE_IO toggle;
+
+        ParallelFor( layerPlots.size(),
+                     [&]( size_t aIndex )
+                     {
+                         LAYER_PLOT& layerPlot = layerPlots[aIndex];
+
+                         // We are feeding it one layer at the start here to silence a logic check
+                         GERBER_PLOTTER* plotter = (GERBER_PLOTTER*) StartPlotBoard(
+                                 brd, &layerPlot.m_plotOpts, layerPlot.m_layer,
+                                 layerPlot.m_fullPath, wxEmptyString, wxEmptyString );
+
+                         if( plotter )
+                         {
+                             PlotBoardLayers( brd, plotter, layerPlot.m_sequence,
+                                              layerPlot.m_plotOpts );
+                             plotter->EndPlot();
+                             layerPlot.m_success = true;
+                         }
+
+                         delete plotter;
+                     } );
+    }
+
+    for( const LAYER_PLOT& layerPlot : layerPlots )
+    {
+        if( layerPlot.m_success )
         {
-            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ), fn.GetFullPath() ),
+            m_reporter->Report( wxString::Format( _( "Plotted to '%s'.\n" ),
+                                                  layerPlot.m_fullPath ),
                                 RPT_SEVERITY_ACTION );
-            PlotBoardLayers( brd, plotter, plotSequence, plotOpts );
-            plotter->EndPlot();
         }
         else
         {
             m_reporter->Report( wxString::Format( _( "Failed to plot to '%s'.\n" ),
-                                                  fn.GetFullPath() ),
+                                                  layerPlot.m_fullPath ),
                                 RPT_SEVERITY_ERROR );
             exitCode = CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
         }
-
-        delete plotter;
     }
 
     wxFileName fn( aGerberJob->m_filename );
@@ -509,9 +606,12 @@ int PCBNEW_JOBS_HANDLER::JobExportGerber( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aGerberJob->m_filename );
+    BOARD* brd = getBoard( aJob, aGerberJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
+    if( aGerberJob->m_refillIfStale )
+        refillStaleZones( brd );
+
     if( aGerberJob->m_outputFile.IsEmpty() )
     {
         wxFileName fn = brd->GetFileName();
@@ -562,7 +662,8 @@ int PCBNEW_JOBS_HANDLER::JobExportDrill( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aDrillJob->m_filename );
+    // Drill files only need holes
+    BOARD* brd = getBoard( aJob, aDrillJob->m_filename, false );
 
     // ensure output dir exists
     wxFileName fn( aDrillJob->m_outputDir + wxT( "/" ) );
@@ -684,7 +785,8 @@ int PCBNEW_JOBS_HANDLER::JobExportPos( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( aPosJob->m_filename );
+    // Placement files only need footprints
+    BOARD* brd = getBoard( aJob, aPosJob->m_filename, false );
 
     if( aPosJob->m_outputFile.IsEmpty() )
     {
@@ -822,6 +924,164 @@ int PCBNEW_JOBS_HANDLER::JobExportFpUpgrade( JOB* aJob )
 }
 
 
+int PCBNEW_JOBS_HANDLER::JobFootprintConvert( JOB* aJob )
+{
+    JOB_FP_CONVERT* convertJob = dynamic_cast<JOB_FP_CONVERT*>( aJob );
+
+    if( convertJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    std::vector<wxString> sources;
+    std::vector<wxString> outputs;
+    std::set<wxString>    outputSet;
+
+    for( wxString path : convertJob->m_libraryPaths )
+    {
+        // A trailing separator would leave the directory of a library without a name
+        while( path.Length() > 1 && wxFileName::IsPathSeparator( path.Last() ) )
+            path.RemoveLast();
+
+        wxFileName source( path );
+        source.MakeAbsolute();
+
+        wxFileName output( convertJob->m_outputDirectory.IsEmpty() ? source.GetPath()
+                                                                   : convertJob->m_outputDirectory,
+                           source.GetName(), FILEEXT::KiCadFootprintLibPathExtension );
+        output.MakeAbsolute();
+
+        if( output.GetFullPath() == source.GetFullPath()
+                || !outputSet.insert( output.GetFullPath() ).second
+                || ( !convertJob->m_force && ( wxDir::Exists( output.GetFullPath() )
+                                               || wxFile::Exists( output.GetFullPath() ) ) ) )
+        {
+            m_reporter->Report( wxString::Format( _( "Output library '%s' conflicts with an "
+                                                     "existing or another converted library\n" ),
+                                                  output.GetFullPath() ),
+                                RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+        }
+
+        sources.push_back( source.GetFullPath() );
+        outputs.push_back( output.GetFullPath() );
+    }
+
+    if( !convertJob->m_outputDirectory.IsEmpty() && !wxDir::Exists( convertJob->m_outputDirectory )
+            && !wxFileName::Mkdir( convertJob->m_outputDirectory, wxS_DIR_DEFAULT,
+                                   wxPATH_MKDIR_FULL ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to create output directory '%s'\n" ),
+                                              convertJob->m_outputDirectory ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    PCBNEW_SETTINGS* cfg = dynamic_cast<PCBNEW_SETTINGS*>( Kiface().KifaceSettings() );
+    bool             flipLeftRight = cfg && cfg->m_FlipLeftRight;
+
+    // Each library is read by its own importer and written through its own cache, so that
+    // libraries can be converted concurrently
+    auto convert =
+            [&]( const wxString& aSource, const wxString& aOutput ) -> int
+            {
+                PCB_IO_MGR::PCB_FILE_T type = PCB_IO_MGR::GuessPluginTypeFromLibPath( aSource );
+
+                if( type == PCB_IO_MGR::FILE_TYPE_NONE )
+                    THROW_IO_ERROR( _( "Unknown footprint library format" ) );
+
+                IO_RELEASER<PCB_IO> sourceIO( PCB_IO_MGR::PluginFind( type ) );
+                PCB_IO_KICAD_SEXPR  kicadIO( CTL_FOR_LIBRARY );
+                FP_CACHE            library( &kicadIO, aOutput );
+                wxArrayString       names;
+
+                sourceIO->FootprintEnumerate( names, aSource, false );
+
+                for( const wxString& name : names )
+                {
+                    FOOTPRINT* footprint = sourceIO->FootprintLoad( aSource, name );
+
+                    if( !footprint )
+                        continue;
+
+                    // Library footprints are stored unrotated on the front, like with
+                    // PCB_IO_KICAD_SEXPR::FootprintSave()
+                    footprint->SetOrientation( ANGLE_0 );
+
+                    if( footprint->GetLayer() != F_Cu )
+                        footprint->Flip( footprint->GetPosition(), flipLeftRight );
+
+                    footprint->SetParent( nullptr );
+                    footprint->SetParentGroup( nullptr );
+
+                    wxString fileName = name + wxS( "." ) + FILEEXT::KiCadFootprintFileExtension;
+
+                    library.GetFootprints().insert( name, new FP_CACHE_ITEM( footprint,
+                                                            WX_FILENAME( aOutput, fileName ) ) );
+                }
+
+                if( wxDir::Exists( aOutput ) )
+                    kicadIO.DeleteLibrary( aOutput );
+
+                library.Save();
+
+                return (int) names.size();
+            };
+
+    size_t              count = sources.size();
+    size_t              workers = count;
+    std::atomic<size_t> next( 0 );
+    std::atomic<size_t> done( 0 );
+    std::atomic<size_t> failed( 0 );
+    std::mutex          reportMutex;
+
+    if( convertJob->m_threads > 0 )
+        workers = std::min( workers, (size_t) convertJob->m_threads );
+
+    ParallelFor( workers,
+                 [&]( size_t )
+                 {
+                     for( size_t ii = next++; ii < count; ii = next++ )
+                     {
+                         wxString  msg;
+                         SEVERITY  severity = RPT_SEVERITY_INFO;
+
+                         try
+                         {
+                             int footprints = convert( sources[ii], outputs[ii] );
+
+                             msg.Printf( _( "Converted %d footprints from '%s' to '%s'" ),
+                                         footprints, sources[ii], outputs[ii] );
+                         }
+                         catch( const IO_ERROR& ioe )
+                         {
+                             msg.Printf( _( "Unable to convert '%s': %s" ), sources[ii],
+                                         ioe.What() );
+                             severity = RPT_SEVERITY_ERROR;
+                             failed++;
+                         }
+                         catch( const std::exception& e )
+                         {
+                             msg.Printf( _( "Unable to convert '%s': %s" ), sources[ii],
+                                         e.what() );
+                             severity = RPT_SEVERITY_ERROR;
+                             failed++;
+                         }
+
+                         std::lock_guard<std::mutex> lock( reportMutex );
+
+                         m_reporter->Report( wxString::Format( wxS( "[%zu/%zu] %s\n" ), ++done,
+                                                               count, msg ),
+                                             severity );
+                     }
+                 } );
+
+    m_reporter->Report( wxString::Format( _( "Converted %zu of %zu footprint libraries\n" ),
+                                          count - failed, count ),
+                        failed ? RPT_SEVERITY_ERROR : RPT_SEVERITY_INFO );
+
+    return failed ? CLI::EXIT_CODES::ERR_UNKNOWN : CLI::EXIT_CODES::OK;
+}
+
+
 int PCBNEW_JOBS_HANDLER::JobExportFpSvg( JOB* aJob )
 {
     JOB_FP_EXPORT_SVG* svgJob = dynamic_cast<JOB_FP_EXPORT_SVG*>( aJob );
@@ -944,6 +1204,62 @@ int PCBNEW_JOBS_HANDLER::doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPR
 }
 
 
+std::vector<wxString> PCBNEW_JOBS_HANDLER::getDrcWorkerArgs( const JOB_PCB_DRC* aJob ) const
+{
+    std::vector<wxString> args;
+
+    auto addList =
+            [&]( const wxString& aArg, const std::vector<wxString>& aList )
+            {
+                wxString list;
+
+                for( const wxString& item : aList )
+                    list << ( list.IsEmpty() ? wxS( "" ) : wxS( "," ) ) << item;
+
+                if( !list.IsEmpty() )
+                {
+                    args.push_back( aArg );
+                    args.push_back( list );
+                }
+            };
+
+    args.push_back( wxS( "--units" ) );
+
+    switch( aJob->m_units )
+    {
+    case JOB_PCB_DRC::UNITS::INCHES: args.push_back( wxS( "in" ) );   break;
+    case JOB_PCB_DRC::UNITS::MILS:   args.push_back( wxS( "mils" ) ); break;
+    default:                         args.push_back( wxS( "mm" ) );   break;
+    }
+
+    if( aJob->m_reportAllTrackErrors )
+        args.push_back( wxS( "--all-track-errors" ) );
+
+    if( aJob->m_parity )
+        args.push_back( wxS( "--schematic-parity" ) );
+
+    if( aJob->m_refillIfStale )
+        args.push_back( wxS( "--refill-if-stale" ) );
+
+    std::vector<wxString> layers;
+
+    for( PCB_LAYER_ID layer : aJob->m_layers.Seq() )
+        layers.push_back( LSET::Name( layer ) );
+
+    addList( wxS( "--layers" ), layers );
+    addList( wxS( "--nets" ), aJob->m_nets );
+    addList( wxS( "--refs" ), aJob->m_references );
+
+    for( const auto& [name, value] : aJob->GetVarOverrides() )
+    {
+        args.push_back( wxS( "--define-var" ) );
+        args.push_back( name + wxS( "=" ) + value );
+    }
+
+    return args;
+}
+
+
 int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 {
     JOB_PCB_DRC* drcJob = dynamic_cast<JOB_PCB_DRC*>( aJob );
@@ -954,7 +1270,7 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
     if( aJob->IsCli() )
         m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
 
-    BOARD* brd = LoadBoard( drcJob->m_filename );
+    BOARD* brd = getBoard( aJob, drcJob->m_filename );
     brd->GetProject()->ApplyTextVars( aJob->GetVarOverrides() );
 
     if( drcJob->m_outputFile.IsEmpty() )
@@ -962,10 +1278,20 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
         wxFileName fn = brd->GetFileName();
         fn.SetName( fn.GetName() );
 
-        if( drcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
+        if( drcJob->m_shardIndex >= 0 )
+        {
+            fn.SetName( fn.GetName()
+                        + wxString::Format( wxS( "-drc-shard-%d" ), drcJob->m_shardIndex ) );
+            fn.SetExt( FILEEXT::JsonFileExtension );
+        }
+        else if( drcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
+        {
             fn.SetExt( FILEEXT::JsonFileExtension );
+        }
         else
+        {
             fn.SetExt( FILEEXT::ReportFileExtension );
+        }
 
         drcJob->m_outputFile = fn.GetFullName();
     }
@@ -1006,8 +1332,173 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 
     brd->RecordDRCExclusions();
     brd->DeleteMARKERs( true, true );
-    drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, drcJob->m_parity );
+
+    drcEngine->SetCollectTimings( drcJob->m_reportTimings );
+
+    DRC_REGION region;
+
+    if( drcJob->m_restrictArea )
+    {
+        auto toIU =
+                [&]( double aValue )
+                {
+                    return KiROUND( EDA_UNIT_UTILS::UI::FromUserUnit( pcbIUScale, units,
+                                                                      aValue ) );
+                };
+
+        VECTOR2I start( toIU( drcJob->m_areaStart.x ), toIU( drcJob->m_areaStart.y ) );
+        VECTOR2I end( toIU( drcJob->m_areaEnd.x ), toIU( drcJob->m_areaEnd.y ) );
+
+        region.m_area = BOX2I( start, end - start );
+    }
+
+    region.m_layers = drcJob->m_layers;
+
+    for( const wxString& pattern : drcJob->m_nets )
+    {
+        bool found = false;
+
+        for( NETINFO_ITEM* net : brd->GetNetInfo() )
+        {
+            if( net->GetNetCode() > 0 && WildCompareString( pattern, net->GetNetname(), true ) )
+            {
+                region.m_netcodes.insert( net->GetNetCode() );
+                found = true;
+            }
+        }
+
+        if( !found )
+        {
+            m_reporter->Report( wxString::Format( _( "Net '%s' not found\n" ), pattern ),
+                                RPT_SEVERITY_WARNING );
+        }
+    }
+
+    for( const wxString& reference : drcJob->m_references )
+    {
+        if( FOOTPRINT* footprint = brd->FindFootprintByReference( reference ) )
+        {
+            region.m_items.insert( footprint->m_Uuid );
+        }
+        else
+        {
+            m_reporter->Report( wxString::Format( _( "Footprint '%s' not found\n" ), reference ),
+                                RPT_SEVERITY_WARNING );
+        }
+    }
+
+    // Nets or footprints were asked for, but none of them exist: report nothing rather than
+    // the whole board
+    if( ( !drcJob->m_nets.empty() && region.m_netcodes.empty() )
+            || ( !drcJob->m_references.empty() && region.m_items.empty() ) )
+    {
+        region.m_items.insert( niluuid );
+    }
+
+    // A coordinator doesn't test the board itself, its workers do
+    bool coordinator = drcJob->m_shardIndex < 0
+                       && ( drcJob->m_shardCount > 0 || !drcJob->m_shardFiles.empty() );
+
+    if( drcJob->m_refillIfStale && !coordinator )
+        refillStaleZones( brd );
+
+    if( drcJob->m_shardIndex >= 0 )
+    {
+        region.m_area = DRC_SHARDS::GetShardArea( brd, drcJob->m_shardIndex,
+                                                  drcJob->m_shardCount );
+    }
+
+    drcEngine->SetRegion( region );
+
+    if( drcJob->m_shardIndex >= 0 )
+    {
+        // A worker only saves the violations of its strip, for the coordinator to report
+        std::vector<DRC_STORED_VIOLATION> violations;
+
+        drcEngine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+                {
+                    violations.push_back( DRC_STORED_VIOLATION::FromItem( *drcEngine, aItem,
+                                                                          aPos, aLayer ) );
+                } );
+
+        drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, drcJob->m_parity );
+
+        drcEngine->ClearViolationHandler();
+        drcEngine->ClearRegion();
+
+        DRC_RESULT_CACHE cache( drcEngine.get() );
+        size_t signature = cache.ComputeSignature( drcJob->m_reportAllTrackErrors,
+                                                   drcJob->m_parity );
+
+        if( !DRC_SHARDS::WriteShard( drcJob->m_outputFile, drcJob->m_shardIndex,
+                                     drcJob->m_shardCount, signature, violations ) )
+        {
+            m_reporter->Report( wxString::Format( _( "Unable to save DRC shard to %s\n" ),
+                                                  drcJob->m_outputFile ),
+                                RPT_SEVERITY_ERROR );
+            return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+        }
+
+        return CLI::EXIT_CODES::SUCCESS;
+    }
+
+    if( drcJob->m_shardCount > 0 || !drcJob->m_shardFiles.empty() )
+    {
+        DRC_RESULT_CACHE      cache( drcEngine.get() );
+        size_t                signature = cache.ComputeSignature( drcJob->m_reportAllTrackErrors,
+                                                                  drcJob->m_parity );
+        std::vector<wxString> shardFiles = drcJob->m_shardFiles;
+        bool                  ok = true;
+
+        if( shardFiles.empty() )
+        {
+            ok = DRC_SHARDS::RunWorkers( drcJob->m_filename, drcJob->m_shardCount,
+                                         getDrcWorkerArgs( drcJob ), shardFiles, *m_reporter );
+        }
+
+        ok = ok && DRC_SHARDS::MergeShards( drcEngine.get(), shardFiles, signature,
+                                            *m_reporter );
+
+        // Files of workers run elsewhere belong to the caller
+        if( drcJob->m_shardFiles.empty() )
+        {
+            for( const wxString& file : shardFiles )
+                wxRemoveFile( file );
+        }
+
+        if( !ok )
+        {
+            drcEngine->ClearViolationHandler();
+            drcEngine->ClearRegion();
+            return CLI::EXIT_CODES::ERR_UNKNOWN;
+        }
+    }
+    else if( drcJob->m_useCache && !region.IsEmpty() )
+    {
+        // The cache stores the results of the whole board
+        m_reporter->Report( _( "Not using the result cache for a region\n" ),
+                            RPT_SEVERITY_WARNING );
+        drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, drcJob->m_parity );
+    }
+    else if( drcJob->m_useCache )
+    {
+        DRC_RESULT_CACHE cache( drcEngine.get() );
+
+        if( cache.RunTests( DRC_RESULT_CACHE::GetDefaultPath( brd ), units,
+                            drcJob->m_reportAllTrackErrors, drcJob->m_parity ) )
+        {
+            m_reporter->Report( _( "Reused cached results for unchanged items\n" ),
+                                RPT_SEVERITY_INFO );
+        }
+    }
+    else
+    {
+        drcEngine->RunTests( units, drcJob->m_reportAllTrackErrors, drcJob->m_parity );
+    }
+
     drcEngine->ClearViolationHandler();
+    drcEngine->ClearRegion();
 
     commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
 
@@ -1040,6 +1531,12 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 
     DRC_REPORT reportWriter( brd, units, markersProvider, ratsnestProvider, fpWarningsProvider );
 
+    if( drcJob->m_reportTimings )
+    {
+        reportWriter.SetTimings( drcEngine->GetTimings() );
+        drcEngine->SetCollectTimings( false );
+    }
+
     bool wroteReport = false;
     if( drcJob->m_format == JOB_PCB_DRC::OUTPUT_FORMAT::JSON )
         wroteReport = reportWriter.WriteJsonReport( drcJob->m_outputFile );
@@ -1069,6 +1566,69 @@ int PCBNEW_JOBS_HANDLER::JobExportDrc( JOB* aJob )
 }
 
 
+int PCBNEW_JOBS_HANDLER::JobMemoryReport( JOB* aJob )
+{
+    JOB_PCB_MEMORY_REPORT* memoryJob = dynamic_cast<JOB_PCB_MEMORY_REPORT*>( aJob );
+
+    if( memoryJob == nullptr )
+        return CLI::EXIT_CODES::ERR_UNKNOWN;
+
+    if( aJob->IsCli() )
+        m_reporter->Report( _( "Loading board\n" ), RPT_SEVERITY_INFO );
+
+    BOARD* brd = getBoard( aJob, memoryJob->m_filename );
+
+    if( memoryJob->m_outputFile.IsEmpty() )
+    {
+        wxFileName fn = brd->GetFileName();
+        fn.SetName( fn.GetName() + wxT( "-memory" ) );
+        fn.SetExt( FILEEXT::JsonFileExtension );
+
+        memoryJob->m_outputFile = fn.GetFullName();
+    }
+
+    if( memoryJob->m_fillZones )
+    {
+        m_reporter->Report( _( "Filling zones...\n" ), RPT_SEVERITY_INFO );
+
+        // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
+        TOOL_MANAGER* toolManager = new TOOL_MANAGER;
+        toolManager->SetEnvironment( brd, nullptr, nullptr, Kiface().KifaceSettings(), nullptr );
+
+        BOARD_COMMIT       commit( toolManager );
+        ZONE_FILLER        filler( brd, &commit );
+        std::vector<ZONE*> toFill = brd->Zones();
+
+        if( filler.Fill( toFill ) )
+        {
+            commit.Push( _( "Fill Zone(s)" ), SKIP_UNDO | SKIP_SET_DIRTY | ZONE_FILL_OP
+                                                      | SKIP_CONNECTIVITY );
+        }
+
+        brd->BuildConnectivity();
+    }
+
+    MEMORY_REPORT report;
+    ReportBoardMemory( brd, report );
+
+    wxFFile file( memoryJob->m_outputFile, wxS( "wb" ) );
+
+    if( !file.IsOpened() || !file.Write( report.FormatJson() ) )
+    {
+        m_reporter->Report( wxString::Format( _( "Unable to save memory report to %s\n" ),
+                                              memoryJob->m_outputFile ),
+                            RPT_SEVERITY_ERROR );
+        return CLI::EXIT_CODES::ERR_INVALID_OUTPUT_CONFLICT;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Saved memory report to %s\n" ),
+                                          memoryJob->m_outputFile ),
+                        RPT_SEVERITY_INFO );
+
+    return CLI::EXIT_CODES::SUCCESS;
+}
+
+
 DS_PROXY_VIEW_ITEM* PCBNEW_JOBS_HANDLER::getDrawingSheetProxyView( BOARD* aBrd )
 {
     DS_PROXY_VIEW_ITEM* drawingSheet = new DS_PROXY_VIEW_ITEM( pcbIUScale,
@@ -1114,3 +1674,91 @@ void PCBNEW_JOBS_HANDLER::loadOverrideDrawingSheet( BOARD* aBrd, const wxString&
     // failed loading custom path, revert back to default
     loadSheet( aBrd->GetProject()->GetProjectFile().m_BoardDrawingSheetFile );
 }
+
+
+BOARD* PCBNEW_JOBS_HANDLER::getBoard( JOB* aJob, const wxString& aFileName, bool aWithFills )
+{
+    wxFileName fn( aFileName );
+    fn.MakeAbsolute();
+
+    // A long running kicad-cli (e.g. a server) must not go on with a board edited since
+    if( !aJob->IsCli() || !m_board || fn.GetFullPath() != m_boardFileName
+            || ( aWithFills && !m_boardHasFills )
+            || fn.GetModificationTime() != m_boardModified )
+    {
+        wxString fileName = aFileName;
+        BOARD*   brd = aWithFills ? LoadBoard( fileName ) : LoadBoardWithoutFills( fileName );
+
+        if( aJob->IsCli() && brd )
+        {
+            delete m_board;
+
+            m_board = brd;
+            m_boardModified = fn.GetModificationTime();
+            m_boardFileName = fn.GetFullPath();
+            m_boardHasFills = aWithFills;
+            m_boardTextVars = brd->GetProject()->GetTextVars();
+        }
+
+        return brd;
+    }
+
+    PROJECT* project = m_board->GetProject();
+
+    if( project->GetTextVars() != m_boardTextVars )
+    {
+        project->GetTextVars() = m_boardTextVars;
+        project->IncrementTextVarsTicker();
+    }
+
+    // An earlier job may have loaded another drawing sheet
+    BASE_SCREEN::m_DrawingSheetFileName = project->GetProjectFile().m_BoardDrawingSheetFile;
+
+    wxString sheet = DS_DATA_MODEL::ResolvePath( BASE_SCREEN::m_DrawingSheetFileName,
+                                                 project->GetProjectPath() );
+
+    if( !DS_DATA_MODEL::GetTheInstance().LoadDrawingSheet( sheet ) )
+        m_reporter->Report( _( "Error loading drawing sheet." ), RPT_SEVERITY_ERROR );
+
+    return m_board;
+}
+
+
+void PCBNEW_JOBS_HANDLER::refillStaleZones( BOARD* aBoard )
+{
+    ZONE_FILL_HASHER hasher( aBoard );
+    int              stale = 0;
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        if( !hasher.IsUpToDate( zone ) )
+            stale++;
+    }
+
+    if( stale == 0 )
+    {
+        m_reporter->Report( _( "Zone fills are up to date\n" ), RPT_SEVERITY_INFO );
+        return;
+    }
+
+    m_reporter->Report( wxString::Format( _( "Refilling %d out of date zone(s)...\n" ), stale ),
+                        RPT_SEVERITY_INFO );
+
+    // BOARD_COMMIT uses TOOL_MANAGER to grab the board internally so we must give it one
+    TOOL_MANAGER* toolManager = new TOOL_MANAGER;
+    toolManager->SetEnvironment( aBoard, nullptr, nullptr, Kiface().KifaceSettings(), nullptr );
+
+    BOARD_COMMIT       commit( toolManager );
+    ZONE_FILLER        filler( aBoard, &commit );
+    std::vector<ZONE*> toFill = aBoard->Zones();
+
+    filler.SetSkipUpToDate( true );
+
+    if( filler.Fill( toFill ) )
+    {
+        commit.Push( _( "Fill Zone(s)" ), SKIP_UNDO | SKIP_SET_DIRTY | ZONE_FILL_OP
+                                                  | SKIP_CONNECTIVITY );
+    }
+
+    aBoard->BuildConnectivity();
+}
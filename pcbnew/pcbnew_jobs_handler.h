@@ -23,12 +23,16 @@
 
 #include <jobs/job_dispatcher.h>
 #include <pcb_plot_params.h>
+#include <wx/datetime.h>
+
+#include <map>
 
 class BOARD;
 class DS_PROXY_VIEW_ITEM;
 class FOOTPRINT;
 class JOB_EXPORT_PCB_GERBER;
 class JOB_FP_EXPORT_SVG;
+class JOB_PCB_DRC;
 
 class PCBNEW_JOBS_HANDLER : public JOB_DISPATCHER
 {
@@ -43,8 +47,10 @@ public:
     int JobExportDrill( JOB* aJob );
     int JobExportPos( JOB* aJob );
     int JobExportFpUpgrade( JOB* aJob );
+    int JobFootprintConvert( JOB* aJob );
     int JobExportFpSvg( JOB* aJob );
     int JobExportDrc( JOB* aJob );
+    int JobMemoryReport( JOB* aJob );
 
 private:
     void populateGerberPlotOptionsFromJob( PCB_PLOT_PARAMS&       aPlotOpts,
@@ -52,7 +58,37 @@ private:
     int  doFpExportSvg( JOB_FP_EXPORT_SVG* aSvgJob, const FOOTPRINT* aFootprint );
     void loadOverrideDrawingSheet( BOARD* brd, const wxString& aSheetPath );
 
+    /**
+     * Load the board of \a aJob.
+     *
+     * Jobs run from kicad-cli reuse the board loaded by the previous one when it is the same
+     * file and it wasn't modified since, so that the jobs of a jobset or a server load it only
+     * once.  The drawing sheet and the text variables of its project are then reset to the
+     * ones it was loaded with, as jobs can override them.
+     *
+     * @param aWithFills false if the job doesn't need the zone fills.
+     */
+    BOARD* getBoard( JOB* aJob, const wxString& aFileName, bool aWithFills = true );
+
+    /**
+     * Refill the zones of \a aBoard whose fills were built from other inputs than the ones
+     * they have now, or have no record of them.
+     */
+    void refillStaleZones( BOARD* aBoard );
+
     DS_PROXY_VIEW_ITEM* getDrawingSheetProxyView( BOARD* aBrd );
+
+    /**
+     * @return the arguments the workers of a sharded DRC \a aJob need to find the same
+     *         violations as a single run would.
+     */
+    std::vector<wxString> getDrcWorkerArgs( const JOB_PCB_DRC* aJob ) const;
+
+    BOARD*                       m_board = nullptr;      ///< The board shared by kicad-cli jobs
+    wxString                     m_boardFileName;
+    wxDateTime                   m_boardModified;
+    bool                         m_boardHasFills = false;
+    std::map<wxString, wxString> m_boardTextVars;
 };
 
 #endif
\ No newline at end of file
@@ -76,6 +76,7 @@ PCBNEW_SETTINGS::PCBNEW_SETTINGS()
           m_RotationAngle( ANGLE_90 ),
           m_ShowPageLimits( true ),
           m_ShowCourtyardCollisions( true ),
+          m_BackgroundDRC( false ),
           m_AutoRefillZones( false ),
           m_AllowFreePads( false ),
           m_PnsSettings( nullptr ),
@@ -155,6 +156,9 @@ PCBNEW_SETTINGS::PCBNEW_SETTINGS()
     m_params.emplace_back( new PARAM<bool>( "editing.show_courtyard_collisions",
             &m_ShowCourtyardCollisions, true ) );
 
+    m_params.emplace_back( new PARAM<bool>( "editing.background_drc",
+            &m_BackgroundDRC, false ) );
+
     m_params.emplace_back( new PARAM<bool>( "editing.magnetic_graphics",
             &m_MagneticItems.graphics, true ) );
 
@@ -305,6 +309,9 @@ PCBNEW_SETTINGS::PCBNEW_SETTINGS()
     m_params.emplace_back( new PARAM<bool>( "drc_dialog.test_footprints",
             &m_DrcDialog.test_footprints, false ) );
 
+    m_params.emplace_back( new PARAM<bool>( "drc_dialog.use_result_cache",
+            &m_DrcDialog.use_result_cache, false ) );
+
     m_params.emplace_back( new PARAM<int>( "drc_dialog.severities",
             &m_DrcDialog.severities, RPT_SEVERITY_ERROR | RPT_SEVERITY_WARNING ) );
 
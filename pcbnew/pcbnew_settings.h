@@ -164,6 +164,7 @@ public:
         bool refill_zones;
         bool test_all_track_errors;
         bool test_footprints;
+        bool use_result_cache;
         int  severities;
     };
 
@@ -441,6 +442,8 @@ public:
 
     bool m_ShowCourtyardCollisions;
 
+    bool m_BackgroundDRC;               // Re-check edited items after each commit
+
     ///<@todo Implement real auto zone filling (not just after zone properties are edited)
     bool m_AutoRefillZones; // Fill zones after editing the zone using the Zone Properties dialog
 
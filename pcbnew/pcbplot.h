@@ -143,6 +143,15 @@ PLOTTER* StartPlotBoard( BOARD* aBoard, const PCB_PLOT_PARAMS* aPlotOpts, int aL
                          const wxString& aFullFileName, const wxString& aSheetName,
                          const wxString& aSheetPath );
 
+/**
+ * Fill the caches the board items build on demand while they are plotted (bounding boxes and
+ * text boxes), so several layers can then be plotted at once, each one by its own thread and
+ * its own plotter, the threads only reading the board.
+ *
+ * The board must not be modified until the plots are over.
+ */
+void PrepareBoardForParallelPlot( BOARD* aBoard );
+
 /**
  * Plot a sequence of board layer IDs.
  *
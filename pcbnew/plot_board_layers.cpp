@@ -28,6 +28,7 @@
  */
 
 
+
 #include <wx/log.h>
 #include <eda_item.h>
 #include <layer_ids.h>
@@ -43,6 +44,7 @@
 #include <pcb_shape.h>
 #include <pcb_target.h>
 #include <pcb_dimension.h>
+#include <pcb_field.h>
 #include <pcbplot.h>
 #include <plotters/plotter_dxf.h>
 #include <plotters/plotter_hpgl.h>
@@ -309,6 +311,8 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     for( FOOTPRINT* footprint : aBoard->Footprints() )
     {
         aPlotter->StartBlock( nullptr );
+        aPlotter->StartReusableGroup( footprint->GetPosition(),
+                                      footprint->GetFPID().GetUniStringLibItemName() );
 
         for( PAD* pad : footprint->Pads() )
         {
@@ -377,11 +381,23 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             // Now offset the pad size by margin + width_adj
             VECTOR2I padPlotsSize = pad->GetSize() + margin * 2 + VECTOR2I( width_adj, width_adj );
 
-            // Store these parameters that can be modified to plot inflated/deflated pads shape
-            PAD_SHAPE padShape = pad->GetShape();
-            VECTOR2I  padSize = pad->GetSize();
-            VECTOR2I  padDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
-            double    padCornerRadius = pad->GetRoundRectCornerRadius();
+            VECTOR2I padSize = pad->GetSize();
+            VECTOR2I padDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
+
+            // Inflated/deflated pad shapes are plotted from a copy of the pad, as the board
+            // pads are shared by the layers plotted in parallel
+            PAD plotPad( *pad );
+
+            // Inflated/deflated polygonal shapes are the same for all the layers and formats
+            // plotted with the same margin, so they are built only once
+            auto inflatedOutline =
+                    [&]( const std::function<void( SHAPE_POLY_SET& )>& aBuilder )
+                    {
+                        PLOT_GEOMETRY_KEY key{ PLOT_GEOMETRY_KEY::KIND::PAD_OUTLINE, pad,
+                                               UNDEFINED_LAYER, mask_clearance, 0, maxError };
+
+                        return aBoard->m_PlotGeometryCache.Get( key, aBuilder );
+                    };
 
             // Don't draw a 0 sized pad.
             // Note: a custom pad can have its pad anchor with size = 0
@@ -395,29 +411,29 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             {
             case PAD_SHAPE::CIRCLE:
             case PAD_SHAPE::OVAL:
-                pad->SetSize( padPlotsSize );
+                plotPad.SetSize( padPlotsSize );
 
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == DRILL_MARKS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
-                    ( pad->GetAttribute() == PAD_ATTRIB::NPTH ) )
+                    ( plotPad.GetSize() == plotPad.GetDrillSize() ) &&
+                    ( plotPad.GetAttribute() == PAD_ATTRIB::NPTH ) )
                 {
                     break;
                 }
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 break;
 
             case PAD_SHAPE::RECTANGLE:
-                pad->SetSize( padPlotsSize );
+                plotPad.SetSize( padPlotsSize );
 
                 if( mask_clearance > 0 )
                 {
-                    pad->SetShape( PAD_SHAPE::ROUNDRECT );
-                    pad->SetRoundRectCornerRadius( mask_clearance );
+                    plotPad.SetShape( PAD_SHAPE::ROUNDRECT );
+                    plotPad.SetRoundRectCornerRadius( mask_clearance );
                 }
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 break;
 
             case PAD_SHAPE::TRAPEZOID:
@@ -432,35 +448,40 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 }
                 else
                 {
-                    PAD dummy( *pad );
-                    dummy.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
-                    dummy.SetShape( PAD_SHAPE::CUSTOM );
-                    SHAPE_POLY_SET outline;
-                    outline.NewOutline();
-                    int dx = padSize.x / 2;
-                    int dy = padSize.y / 2;
-                    int ddx = padDelta.x / 2;
-                    int ddy = padDelta.y / 2;
-
-                    outline.Append( -dx - ddy,  dy + ddx );
-                    outline.Append(  dx + ddy,  dy - ddx );
-                    outline.Append(  dx - ddy, -dy + ddx );
-                    outline.Append( -dx + ddy, -dy - ddx );
-
-                    // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
-                    // which can create bad shapes if margin.x is < 0
-                    outline.InflateWithLinkedHoles( mask_clearance,
-                                                    CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError,
-                                                    SHAPE_POLY_SET::PM_FAST );
-                    dummy.DeletePrimitivesList();
-                    dummy.AddPrimitivePoly( outline, 0, true );
+                    plotPad.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
+                    plotPad.SetShape( PAD_SHAPE::CUSTOM );
+
+                    std::shared_ptr<const SHAPE_POLY_SET> outline = inflatedOutline(
+                            [&]( SHAPE_POLY_SET& aOutline )
+                            {
+                                aOutline.NewOutline();
+                                int dx = padSize.x / 2;
+                                int dy = padSize.y / 2;
+                                int ddx = padDelta.x / 2;
+                                int ddy = padDelta.y / 2;
+
+                                aOutline.Append( -dx - ddy,  dy + ddx );
+                                aOutline.Append(  dx + ddy,  dy - ddx );
+                                aOutline.Append(  dx - ddy, -dy + ddx );
+                                aOutline.Append( -dx + ddy, -dy - ddx );
+
+                                // Shape polygon can have holes so use InflateWithLinkedHoles(),
+                                // not Inflate() which can create bad shapes if margin.x is < 0
+                                aOutline.InflateWithLinkedHoles( mask_clearance,
+                                                                 CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                                                 maxError,
+                                                                 SHAPE_POLY_SET::PM_FAST );
+                            } );
+
+                    plotPad.DeletePrimitivesList();
+                    plotPad.AddPrimitivePoly( *outline, 0, true );
 
                     // Be sure the anchor pad is not bigger than the deflated shape because this
                     // anchor will be added to the pad shape when plotting the pad. So now the
                     // polygonal shape is built, we can clamp the anchor size
-                    dummy.SetSize( VECTOR2I( 0, 0 ) );
+                    plotPad.SetSize( VECTOR2I( 0, 0 ) );
 
-                    itemplotter.PlotPad( &dummy, color, padPlotMode );
+                    itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 }
 
                 break;
@@ -471,10 +492,10 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 // to force recalculation of other values after size changing (we do not
                 // really change the rounding percent value)
                 double radius_ratio = pad->GetRoundRectRadiusRatio();
-                pad->SetSize( padPlotsSize );
-                pad->SetRoundRectRadiusRatio( radius_ratio );
+                plotPad.SetSize( padPlotsSize );
+                plotPad.SetRoundRectRadiusRatio( radius_ratio );
 
-                itemplotter.PlotPad( pad, color, padPlotMode );
+                itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 break;
             }
 
@@ -482,41 +503,43 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                 if( mask_clearance == 0 )
                 {
                     // the size can be slightly inflated by width_adj (PS/PDF only)
-                    pad->SetSize( padPlotsSize );
-                    itemplotter.PlotPad( pad, color, padPlotMode );
+                    plotPad.SetSize( padPlotsSize );
+                    itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 }
                 else
                 {
                     // Due to the polygonal shape of a CHAMFERED_RECT pad, the best way is to
                     // convert the pad shape to a full polygon, inflate/deflate the polygon
                     // and use a dummy  CUSTOM pad to plot the final shape.
-                    PAD dummy( *pad );
                     // Build the dummy pad outline with coordinates relative to the pad position
                     // and orientation 0. The actual pos and rotation will be taken in account
                     // later by the plot function
-                    dummy.SetPosition( VECTOR2I( 0, 0 ) );
-                    dummy.SetOrientation( ANGLE_0 );
-                    SHAPE_POLY_SET outline;
-                    dummy.TransformShapeToPolygon( outline, UNDEFINED_LAYER, 0, maxError,
-                                                   ERROR_INSIDE );
-                    outline.InflateWithLinkedHoles( mask_clearance,
-                                                    CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError,
-                                                    SHAPE_POLY_SET::PM_FAST );
+                    std::shared_ptr<const SHAPE_POLY_SET> outline = inflatedOutline(
+                            [&]( SHAPE_POLY_SET& aOutline )
+                            {
+                                PAD localPad( *pad );
+                                localPad.SetPosition( VECTOR2I( 0, 0 ) );
+                                localPad.SetOrientation( ANGLE_0 );
+                                localPad.TransformShapeToPolygon( aOutline, UNDEFINED_LAYER, 0,
+                                                                  maxError, ERROR_INSIDE );
+                                aOutline.InflateWithLinkedHoles( mask_clearance,
+                                                                 CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                                                 maxError,
+                                                                 SHAPE_POLY_SET::PM_FAST );
+                            } );
 
                     // Initialize the dummy pad shape:
-                    dummy.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
-                    dummy.SetShape( PAD_SHAPE::CUSTOM );
-                    dummy.DeletePrimitivesList();
-                    dummy.AddPrimitivePoly( outline, 0, true );
+                    plotPad.SetAnchorPadShape( PAD_SHAPE::CIRCLE );
+                    plotPad.SetShape( PAD_SHAPE::CUSTOM );
+                    plotPad.DeletePrimitivesList();
+                    plotPad.AddPrimitivePoly( *outline, 0, true );
 
                     // Be sure the anchor pad is not bigger than the deflated shape because this
                     // anchor will be added to the pad shape when plotting the pad.
                     // So we set the anchor size to 0
-                    dummy.SetSize( VECTOR2I( 0, 0 ) );
-                    dummy.SetPosition( pad->GetPosition() );
-                    dummy.SetOrientation( pad->GetOrientation() );
+                    plotPad.SetSize( VECTOR2I( 0, 0 ) );
 
-                    itemplotter.PlotPad( &dummy, color, padPlotMode );
+                    itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 }
 
                 break;
@@ -525,36 +548,34 @@ void PlotStandardLayer( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             {
                 // inflate/deflate a custom shape is a bit complex.
                 // so build a similar pad shape, and inflate/deflate the polygonal shape
-                PAD dummy( *pad );
-                SHAPE_POLY_SET shape;
-                pad->MergePrimitivesAsPolygon( &shape );
-
-                // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
-                // which can create bad shapes if margin.x is < 0
-                shape.InflateWithLinkedHoles( mask_clearance,
-                                              CORNER_STRATEGY::ROUND_ALL_CORNERS, maxError,
-                                              SHAPE_POLY_SET::PM_FAST );
-                dummy.DeletePrimitivesList();
-                dummy.AddPrimitivePoly( shape, 0, true );
+                std::shared_ptr<const SHAPE_POLY_SET> shape = inflatedOutline(
+                        [&]( SHAPE_POLY_SET& aShape )
+                        {
+                            pad->MergePrimitivesAsPolygon( &aShape );
+
+                            // Shape polygon can have holes so use InflateWithLinkedHoles(), not
+                            // Inflate() which can create bad shapes if margin.x is < 0
+                            aShape.InflateWithLinkedHoles( mask_clearance,
+                                                           CORNER_STRATEGY::ROUND_ALL_CORNERS,
+                                                           maxError, SHAPE_POLY_SET::PM_FAST );
+                        } );
+
+                plotPad.DeletePrimitivesList();
+                plotPad.AddPrimitivePoly( *shape, 0, true );
 
                 // Be sure the anchor pad is not bigger than the deflated shape because this
                 // anchor will be added to the pad shape when plotting the pad. So now the
                 // polygonal shape is built, we can clamp the anchor size
                 if( mask_clearance < 0 )  // we expect margin.x = margin.y for custom pads
-                    dummy.SetSize( padPlotsSize );
+                    plotPad.SetSize( padPlotsSize );
 
-                itemplotter.PlotPad( &dummy, color, padPlotMode );
+                itemplotter.PlotPad( &plotPad, color, padPlotMode );
                 break;
             }
             }
-
-            // Restore the pad parameters modified by the plot code
-            pad->SetSize( padSize );
-            pad->SetDelta( padDelta );
-            pad->SetShape( padShape );
-            pad->SetRoundRectCornerRadius( padCornerRadius );
         }
 
+        aPlotter->EndReusableGroup();
         aPlotter->EndBlock( nullptr );
     }
 
@@ -794,27 +815,12 @@ void PlotLayerOutlines( BOARD* aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
 
 /**
- * Plot a solder mask layer.
- *
- * Solder mask layers have a minimum thickness value and cannot be drawn like standard layers,
- * unless the minimum thickness is 0.
- *
- * The algorithm is somewhat complicated to allow for min web thickness while also preserving
- * pad attributes in Gerber.
- *
- * 1 - create initial polygons for every shape
- * 2 - inflate and deflate polygons with Min Thickness/2, and merges the result
- * 3 - substract all initial polygons from (2), leaving the areas where the thickness was less
- *      than min thickness
- * 4 - plot all initial shapes by flashing (or using regions), including Gerber attribute data
- * 5 - plot remaining polygons from (2) (witout any Gerber attributes)
+ * Build the merged solder mask areas of \a aLayer, the slowest part of plotting a mask layer.
  */
-
-void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
-                          const PCB_PLOT_PARAMS& aPlotOpt, int aMinThickness )
+static void buildSolderMaskAreas( BOARD* aBoard, const BRDITEMS_PLOTTER& aItemPlotter,
+                                  PCB_LAYER_ID aLayer, int aMinThickness, SHAPE_POLY_SET& aAreas )
 {
     int             maxError = aBoard->GetDesignSettings().m_MaxError;
-    PCB_LAYER_ID    layer = aLayerMask[B_Mask] ? B_Mask : F_Mask;
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
 
@@ -825,17 +831,13 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     // than or equal comparison in the shape separation (boolean add)
     int inflate = aMinThickness / 2 - 1;
 
-    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
-    itemplotter.SetLayerSet( aLayerMask );
-
     // Build polygons for each pad shape.  The size of the shape on solder mask should be size
     // of pad + clearance around the pad, where clearance = solder mask clearance + extra margin.
     // Extra margin is half the min width for solder mask, which is used to merge too-close shapes
     // (distance < aMinThickness), and will be removed when creating the actual shapes.
 
-    // Will contain shapes inflated by inflate value that will be merged and deflated by inflate
-    // value to build final polygons
-    SHAPE_POLY_SET areas;
+    // aAreas will contain shapes inflated by inflate value that will be merged and deflated by
+    // inflate value to build the final polygons
 
     // Will contain exact shapes of all items on solder mask
     SHAPE_POLY_SET initialPolys;
@@ -843,23 +845,23 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     auto plotFPTextItem =
             [&]( const PCB_TEXT& aText )
             {
-                if( !itemplotter.GetPlotFPText() )
+                if( !aItemPlotter.GetPlotFPText() )
                     return;
 
-                if( !aText.IsVisible() && !itemplotter.GetPlotInvisibleText()  )
+                if( !aText.IsVisible() && !aItemPlotter.GetPlotInvisibleText()  )
                     return;
 
-                if( aText.GetText() == wxT( "${REFERENCE}" ) && !itemplotter.GetPlotReference() )
+                if( aText.GetText() == wxT( "${REFERENCE}" ) && !aItemPlotter.GetPlotReference() )
                     return;
 
-                if( aText.GetText() == wxT( "${VALUE}" ) && !itemplotter.GetPlotValue() )
+                if( aText.GetText() == wxT( "${VALUE}" ) && !aItemPlotter.GetPlotValue() )
                     return;
 
                 // add shapes with their exact mask layer size in initialPolys
                 aText.TransformTextToPolySet( initialPolys, 0, maxError, ERROR_OUTSIDE );
 
                 // add shapes inflated by aMinThickness/2 in areas
-                aText.TransformTextToPolySet( areas, inflate, maxError, ERROR_OUTSIDE );
+                aText.TransformTextToPolySet( aAreas, inflate, maxError, ERROR_OUTSIDE );
             };
 
     // Generate polygons with arcs inside the shape or exact shape to minimize shape changes
@@ -870,25 +872,25 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         for( const FOOTPRINT* footprint : aBoard->Footprints() )
         {
             // add shapes with their exact mask layer size in initialPolys
-            footprint->TransformPadsToPolySet( initialPolys, layer, 0, maxError, ERROR_OUTSIDE );
+            footprint->TransformPadsToPolySet( initialPolys, aLayer, 0, maxError, ERROR_OUTSIDE );
             // add shapes inflated by aMinThickness/2 in areas
-            footprint->TransformPadsToPolySet( areas, layer, inflate, maxError, ERROR_OUTSIDE );
+            footprint->TransformPadsToPolySet( aAreas, aLayer, inflate, maxError, ERROR_OUTSIDE );
 
             for( const PCB_FIELD* field : footprint->Fields() )
             {
-                if( field->IsReference() && !itemplotter.GetPlotReference() )
+                if( field->IsReference() && !aItemPlotter.GetPlotReference() )
                     continue;
 
-                if( field->IsValue() && !itemplotter.GetPlotValue() )
+                if( field->IsValue() && !aItemPlotter.GetPlotValue() )
                     continue;
 
-                if( field->IsOnLayer( layer ) )
+                if( field->IsOnLayer( aLayer ) )
                     plotFPTextItem( static_cast<const PCB_TEXT&>( *field ) );
             }
 
             for( const BOARD_ITEM* item : footprint->GraphicalItems() )
             {
-                if( item->IsOnLayer( layer ) )
+                if( item->IsOnLayer( aLayer ) )
                 {
                     if( item->Type() == PCB_TEXT_T )
                     {
@@ -897,11 +899,11 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                     else
                     {
                         // add shapes with their exact mask layer size in initialPolys
-                        item->TransformShapeToPolygon( initialPolys, layer, 0, maxError,
+                        item->TransformShapeToPolygon( initialPolys, aLayer, 0, maxError,
                                                        ERROR_OUTSIDE );
 
                         // add shapes inflated by aMinThickness/2 in areas
-                        item->TransformShapeToPolygon( areas, layer, inflate, maxError,
+                        item->TransformShapeToPolygon( aAreas, aLayer, inflate, maxError,
                                                        ERROR_OUTSIDE );
                     }
                 }
@@ -917,20 +919,21 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
             const PCB_VIA* via = static_cast<const PCB_VIA*>( track );
 
             // Note: IsOnLayer() checks relevant mask layers of untented vias
-            if( !via->IsOnLayer( layer ) )
+            if( !via->IsOnLayer( aLayer ) )
                 continue;
 
             int clearance = via->GetSolderMaskExpansion();
 
             // add shapes with their exact mask layer size in initialPolys
-            via->TransformShapeToPolygon( initialPolys, layer, clearance, maxError, ERROR_OUTSIDE );
+            via->TransformShapeToPolygon( initialPolys, aLayer, clearance, maxError,
+                                          ERROR_OUTSIDE );
 
             // add shapes inflated by aMinThickness/2 in areas
             clearance += inflate;
-            via->TransformShapeToPolygon( areas, layer, clearance, maxError, ERROR_OUTSIDE );
+            via->TransformShapeToPolygon( aAreas, aLayer, clearance, maxError, ERROR_OUTSIDE );
         }
 
-        // Add filled zone areas.
+        // Add filled zone aAreas.
 #if 0   // Set to 1 if a solder mask expansion must be applied to zones on solder mask
         int zone_margin = aBoard->GetDesignSettings().m_SolderMaskExpansion;
 #else
@@ -939,7 +942,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
         for( const BOARD_ITEM* item : aBoard->Drawings() )
         {
-            if( item->IsOnLayer( layer ) )
+            if( item->IsOnLayer( aLayer ) )
             {
                 if( item->Type() == PCB_TEXT_T )
                 {
@@ -949,16 +952,16 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
                     text->TransformTextToPolySet( initialPolys, 0, maxError, ERROR_OUTSIDE );
 
                     // add shapes inflated by aMinThickness/2 in areas
-                    text->TransformTextToPolySet( areas, inflate, maxError, ERROR_OUTSIDE );
+                    text->TransformTextToPolySet( aAreas, inflate, maxError, ERROR_OUTSIDE );
                 }
                 else
                 {
                     // add shapes with their exact mask layer size in initialPolys
-                    item->TransformShapeToPolygon( initialPolys, layer, 0, maxError,
+                    item->TransformShapeToPolygon( initialPolys, aLayer, 0, maxError,
                                                    ERROR_OUTSIDE );
 
                     // add shapes inflated by aMinThickness/2 in areas
-                    item->TransformShapeToPolygon( areas, layer, inflate, maxError,
+                    item->TransformShapeToPolygon( aAreas, aLayer, inflate, maxError,
                                                    ERROR_OUTSIDE );
                 }
             }
@@ -966,11 +969,11 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
         for( ZONE* zone : aBoard->Zones() )
         {
-            if( !zone->IsOnLayer( layer ) )
+            if( !zone->IsOnLayer( aLayer ) )
                 continue;
 
             // add shapes inflated by aMinThickness/2 in areas
-            zone->TransformSmoothedOutlineToPolygon( areas, inflate + zone_margin, maxError,
+            zone->TransformSmoothedOutlineToPolygon( aAreas, inflate + zone_margin, maxError,
                                                      ERROR_OUTSIDE, boardOutline );
 
             // add shapes with their exact mask layer size in initialPolys
@@ -981,8 +984,55 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
     // Merge all polygons: After deflating, not merged (not overlapping) polygons will have the
     // initial shape (with perhaps small changes due to deflating transform)
-    areas.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-    areas.Deflate( inflate, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
+    aAreas.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    aAreas.Deflate( inflate, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
+
+    // Combine the current areas to initial areas. This is mandatory because inflate/deflate
+    // transform is not perfect, and we want the initial areas perfectly kept
+    aAreas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
+    aAreas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+}
+
+
+/**
+ * Plot a solder mask layer.
+ *
+ * Solder mask layers have a minimum thickness value and cannot be drawn like standard layers,
+ * unless the minimum thickness is 0.
+ *
+ * The algorithm is somewhat complicated to allow for min web thickness while also preserving
+ * pad attributes in Gerber.
+ *
+ * 1 - create initial polygons for every shape
+ * 2 - inflate and deflate polygons with Min Thickness/2, and merges the result
+ * 3 - substract all initial polygons from (2), leaving the areas where the thickness was less
+ *      than min thickness
+ * 4 - plot all initial shapes by flashing (or using regions), including Gerber attribute data
+ * 5 - plot remaining polygons from (2) (witout any Gerber attributes)
+ */
+
+void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
+                          const PCB_PLOT_PARAMS& aPlotOpt, int aMinThickness )
+{
+    PCB_LAYER_ID    layer = aLayerMask[B_Mask] ? B_Mask : F_Mask;
+
+    BRDITEMS_PLOTTER itemplotter( aPlotter, aBoard, aPlotOpt );
+    itemplotter.SetLayerSet( aLayerMask );
+
+    // The areas don't depend on the plotter, only on the texts plotted on the mask layer
+    int textOptions = ( itemplotter.GetPlotFPText() ? 1 : 0 )
+                      | ( itemplotter.GetPlotInvisibleText() ? 2 : 0 )
+                      | ( itemplotter.GetPlotReference() ? 4 : 0 )
+                      | ( itemplotter.GetPlotValue() ? 8 : 0 );
+
+    PLOT_GEOMETRY_KEY key{ PLOT_GEOMETRY_KEY::KIND::SOLDER_MASK, nullptr, layer, aMinThickness,
+                           textOptions, aBoard->GetDesignSettings().m_MaxError };
+
+    std::shared_ptr<const SHAPE_POLY_SET> areas = aBoard->m_PlotGeometryCache.Get( key,
+            [&]( SHAPE_POLY_SET& aAreas )
+            {
+                buildSolderMaskAreas( aBoard, itemplotter, layer, aMinThickness, aAreas );
+            } );
 
     // To avoid a lot of code, use a ZONE to handle and plot polygons, because our polygons look
     // exactly like filled areas in zones.
@@ -993,12 +1043,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
     zone.SetMinThickness( 0 );      // trace polygons only
     zone.SetLayer( layer );
 
-    // Combine the current areas to initial areas. This is mandatory because inflate/deflate
-    // transform is not perfect, and we want the initial areas perfectly kept
-    areas.BooleanAdd( initialPolys, SHAPE_POLY_SET::PM_FAST );
-    areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-
-    itemplotter.PlotZone( &zone, layer, areas );
+    itemplotter.PlotZone( &zone, layer, *areas );
 }
 
 
@@ -1078,6 +1123,9 @@ static void initializePlotter( PLOTTER* aPlotter, const BOARD* aBoard,
 
     aPlotter->SetPageSettings( *sheet_info );
 
+    // Has meaning only for SVG plotter. Must be called before SetViewport
+    aPlotter->SetSvgCompactOutput( aPlotOpts->GetSvgCompact() );
+
     aPlotter->SetViewport( offset, pcbIUScale.IU_PER_MILS/10, compound_scale, aPlotOpts->GetMirror() );
 
     // Has meaning only for gerber plotter. Must be called only after SetViewport
@@ -1258,3 +1306,31 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, const PCB_PLOT_PARAMS *aPlotOpts, int aL
     delete plotter;
     return nullptr;
 }
+
+
+void PrepareBoardForParallelPlot( BOARD* aBoard )
+{
+    auto cacheTextBox =
+            []( BOARD_ITEM* aItem )
+            {
+                if( EDA_TEXT* text = dynamic_cast<EDA_TEXT*>( aItem ) )
+                    text->GetTextBox();
+            };
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        footprint->GetBoundingBox();
+        footprint->GetBoundingBox( true, false );
+        footprint->GetBoundingBox( false, false );
+        footprint->GetBoundingHull();
+
+        for( PCB_FIELD* field : footprint->Fields() )
+            field->GetTextBox();
+
+        for( BOARD_ITEM* item : footprint->GraphicalItems() )
+            cacheTextBox( item );
+    }
+
+    for( BOARD_ITEM* item : aBoard->Drawings() )
+        cacheTextBox( item );
+}
@@ -502,6 +502,9 @@ void BRDITEMS_PLOTTER::PlotPcbTarget( const PCB_TARGET* aMire )
 
 void BRDITEMS_PLOTTER::PlotFootprintGraphicItems( const FOOTPRINT* aFootprint )
 {
+    m_plotter->StartReusableGroup( aFootprint->GetPosition(),
+                                   aFootprint->GetFPID().GetUniStringLibItemName() );
+
     for( const BOARD_ITEM* item : aFootprint->GraphicalItems() )
     {
         if( aFootprint->GetPrivateLayers().test( item->GetLayer() ) )
@@ -548,6 +551,8 @@ void BRDITEMS_PLOTTER::PlotFootprintGraphicItems( const FOOTPRINT* aFootprint )
             UNIMPLEMENTED_FOR( item->GetClass() );
         }
     }
+
+    m_plotter->EndReusableGroup();
 }
 
 
@@ -0,0 +1,73 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include "plot_geometry_cache.h"
+
+
+std::shared_ptr<const SHAPE_POLY_SET>
+PLOT_GEOMETRY_CACHE::Get( const PLOT_GEOMETRY_KEY& aKey,
+                          const std::function<void( SHAPE_POLY_SET& )>& aBuilder )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto                        it = m_geometries.find( aKey );
+
+        if( it != m_geometries.end() )
+            return it->second;
+    }
+
+    // Build outside of the lock, as other layers are plotted meanwhile.  If two threads race on
+    // the same key, the first one to finish wins.
+    std::shared_ptr<SHAPE_POLY_SET> geometry = std::make_shared<SHAPE_POLY_SET>();
+    aBuilder( *geometry );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_geometries.emplace( aKey, std::move( geometry ) ).first->second;
+}
+
+
+void PLOT_GEOMETRY_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_geometries.clear();
+}
+
+
+size_t PLOT_GEOMETRY_CACHE::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_geometries.size();
+}
+
+
+size_t PLOT_GEOMETRY_CACHE::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    size_t                      bytes = 0;
+
+    for( const auto& [key, geometry] : m_geometries )
+        bytes += sizeof( key ) + sizeof( SHAPE_POLY_SET ) + geometry->GetOutlineMemoryUsage();
+
+    return bytes;
+}
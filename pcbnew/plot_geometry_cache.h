@@ -0,0 +1,111 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PLOT_GEOMETRY_CACHE_H
+#define PLOT_GEOMETRY_CACHE_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <hash.h>
+#include <layer_ids.h>
+
+class BOARD_ITEM;
+class SHAPE_POLY_SET;
+
+
+/**
+ * Identify a polygonal geometry computed to plot a board, and everything it depends on apart
+ * from the item itself.
+ */
+struct PLOT_GEOMETRY_KEY
+{
+    enum class KIND
+    {
+        PAD_OUTLINE,        ///< inflated/deflated pad shape, relative to the pad position
+        SOLDER_MASK         ///< merged solder mask areas of a whole layer, in board coordinates
+    };
+
+    KIND              m_kind;
+    const BOARD_ITEM* m_item;       ///< nullptr for whole layer geometries
+    PCB_LAYER_ID      m_layer;      ///< UNDEFINED_LAYER if the geometry is the same on all layers
+    int               m_margin;     ///< pad clearance, or solder mask min width
+    int               m_options;    ///< flags of the plot options used by the geometry
+    int               m_maxError;
+
+    bool operator==( const PLOT_GEOMETRY_KEY& aOther ) const
+    {
+        return m_kind == aOther.m_kind && m_item == aOther.m_item && m_layer == aOther.m_layer
+               && m_margin == aOther.m_margin && m_options == aOther.m_options
+               && m_maxError == aOther.m_maxError;
+    }
+};
+
+
+namespace std
+{
+    template <>
+    struct hash<PLOT_GEOMETRY_KEY>
+    {
+        std::size_t operator()( const PLOT_GEOMETRY_KEY& aKey ) const
+        {
+            return hash_val( static_cast<int>( aKey.m_kind ), aKey.m_item,
+                             static_cast<int>( aKey.m_layer ), aKey.m_margin, aKey.m_options,
+                             aKey.m_maxError );
+        }
+    };
+}
+
+
+/**
+ * Geometries computed to plot a board, shared by the layers and the output formats of a plot.
+ *
+ * Plotting the same layers to Gerber, PDF and SVG otherwise re-inflates the same pad shapes and
+ * redoes the solder mask merge (the slowest part of a mask layer) for each format.  None of
+ * these depend on the plotter, so they are computed once and reused.
+ *
+ * Keys hold item pointers: the board clears the cache whenever its contents change, so these
+ * never outlive the items.  Thread-safe, as layers are plotted in parallel.
+ */
+class PLOT_GEOMETRY_CACHE
+{
+public:
+    /**
+     * @return the geometry for \a aKey, calling \a aBuilder to build it if it isn't cached yet.
+     */
+    std::shared_ptr<const SHAPE_POLY_SET>
+    Get( const PLOT_GEOMETRY_KEY& aKey, const std::function<void( SHAPE_POLY_SET& )>& aBuilder );
+
+    void Clear();
+
+    size_t GetEntryCount() const;
+
+    /**
+     * @return the estimated memory held by the cached geometries, in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    mutable std::mutex                                                            m_mutex;
+    std::unordered_map<PLOT_GEOMETRY_KEY, std::shared_ptr<const SHAPE_POLY_SET>>  m_geometries;
+};
+
+#endif // PLOT_GEOMETRY_CACHE_H
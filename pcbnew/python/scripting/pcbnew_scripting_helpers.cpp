@@ -34,17 +34,25 @@
 
 #include <action_plugin.h>
 #include <board.h>
+#include <board_commit.h>
 #include <board_design_settings.h>
 #include <pcb_marker.h>
 #include <cstdlib>
+#include <set>
 #include <drawing_sheet/ds_data_model.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
 #include <fp_lib_table.h>
+#include <footprint.h>
 #include <core/ignore.h>
 #include <pcb_io/pcb_io_mgr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <string_utf8_map.h>
 #include <string_utils.h>
 #include <macros.h>
+#include <pad.h>
+#include <pcb_edit_frame.h>
+#include <pcb_track.h>
 #include <pcbnew_scripting_helpers.h>
 #include <project.h>
 #include <project_pcb.h>
@@ -84,15 +92,30 @@ void ScriptingOnDestructPcbEditFrame( PCB_EDIT_FRAME* aPcbEditFrame )
         s_PcbEditFrame = nullptr;
 }
 
-BOARD* LoadBoard( wxString& aFileName )
+static PCB_IO_MGR::PCB_FILE_T boardFileType( const wxString& aFileName )
 {
     if( aFileName.EndsWith( FILEEXT::KiCadPcbFileExtension ) )
-        return LoadBoard( aFileName, PCB_IO_MGR::KICAD_SEXP );
+        return PCB_IO_MGR::KICAD_SEXP;
     else if( aFileName.EndsWith( FILEEXT::LegacyPcbFileExtension ) )
-        return LoadBoard( aFileName, PCB_IO_MGR::LEGACY );
+        return PCB_IO_MGR::LEGACY;
 
     // as fall back for any other kind use the legacy format
-    return LoadBoard( aFileName, PCB_IO_MGR::LEGACY );
+    return PCB_IO_MGR::LEGACY;
+}
+
+
+static BOARD* loadBoard( wxString& aFileName, PCB_IO_MGR::PCB_FILE_T aFormat, bool aWithFills );
+
+
+BOARD* LoadBoard( wxString& aFileName )
+{
+    return LoadBoard( aFileName, boardFileType( aFileName ) );
+}
+
+
+BOARD* LoadBoardWithoutFills( wxString& aFileName )
+{
+    return loadBoard( aFileName, boardFileType( aFileName ), false );
 }
 
 
@@ -135,6 +158,12 @@ PROJECT* GetDefaultProject()
 
 
 BOARD* LoadBoard( wxString& aFileName, PCB_IO_MGR::PCB_FILE_T aFormat )
+{
+    return loadBoard( aFileName, aFormat, true );
+}
+
+
+static BOARD* loadBoard( wxString& aFileName, PCB_IO_MGR::PCB_FILE_T aFormat, bool aWithFills )
 {
     wxFileName pro = aFileName;
     pro.SetExt( FILEEXT::ProjectFileExtension );
@@ -175,7 +204,12 @@ BOARD* LoadBoard( wxString& aFileName, PCB_IO_MGR::PCB_FILE_T aFormat )
     if( !DS_DATA_MODEL::GetTheInstance().LoadDrawingSheet( filename ) )
         wxFprintf( stderr, _( "Error loading drawing sheet." ) );
 
-    BOARD* brd = PCB_IO_MGR::Load( aFormat, aFileName );
+    STRING_UTF8_MAP props;
+
+    if( !aWithFills )
+        props[PROP_LAZY_ZONE_FILLS] = "";
+
+    BOARD* brd = PCB_IO_MGR::Load( aFormat, aFileName, nullptr, &props );
 
     if( brd )
     {
@@ -220,7 +254,10 @@ BOARD* LoadBoard( wxString& aFileName, PCB_IO_MGR::PCB_FILE_T aFormat )
         for( PCB_MARKER* marker : brd->ResolveDRCExclusions( true ) )
             brd->Add( marker );
 
-        brd->BuildConnectivity();
+        // The connectivity would parse all the fills
+        if( aWithFills )
+            brd->BuildConnectivity();
+
         brd->BuildListOfNets();
         brd->SynchronizeNetsAndNetClasses( false );
         brd->UpdateUserUnits( brd, nullptr );
@@ -649,3 +686,243 @@ wxString GetLanguage()
     else
         return "";
 }
+
+
+void ReadTrackColumns( BOARD* aBoard, BULK_COLUMNS& aColumns )
+{
+    wxCHECK( aBoard, /* void */ );
+
+    const size_t count = aBoard->Tracks().size();
+
+    for( const char* name : { "type", "start_x", "start_y", "end_x", "end_y", "mid_x", "mid_y",
+                              "width", "layer", "net" } )
+    {
+        aColumns[name].clear();
+        aColumns[name].reserve( count );
+    }
+
+    std::vector<int>& type = aColumns["type"];
+    std::vector<int>& startX = aColumns["start_x"];
+    std::vector<int>& startY = aColumns["start_y"];
+    std::vector<int>& endX = aColumns["end_x"];
+    std::vector<int>& endY = aColumns["end_y"];
+    std::vector<int>& midX = aColumns["mid_x"];
+    std::vector<int>& midY = aColumns["mid_y"];
+    std::vector<int>& width = aColumns["width"];
+    std::vector<int>& layer = aColumns["layer"];
+    std::vector<int>& net = aColumns["net"];
+
+    for( PCB_TRACK* track : aBoard->Tracks() )
+    {
+        VECTOR2I mid = ( track->GetStart() + track->GetEnd() ) / 2;
+
+        if( track->Type() == PCB_ARC_T )
+            mid = static_cast<PCB_ARC*>( track )->GetMid();
+
+        type.push_back( track->Type() );
+        startX.push_back( track->GetStart().x );
+        startY.push_back( track->GetStart().y );
+        endX.push_back( track->GetEnd().x );
+        endY.push_back( track->GetEnd().y );
+        midX.push_back( mid.x );
+        midY.push_back( mid.y );
+        width.push_back( track->GetWidth() );
+        layer.push_back( track->GetLayer() );
+        net.push_back( track->GetNetCode() );
+    }
+}
+
+
+void ReadPadColumns( BOARD* aBoard, BULK_COLUMNS& aColumns )
+{
+    wxCHECK( aBoard, /* void */ );
+
+    for( const char* name : { "footprint", "x", "y", "size_x", "size_y", "drill_x", "drill_y",
+                              "shape", "attribute", "net" } )
+    {
+        aColumns[name].clear();
+    }
+
+    std::vector<int>& footprint = aColumns["footprint"];
+    std::vector<int>& x = aColumns["x"];
+    std::vector<int>& y = aColumns["y"];
+    std::vector<int>& sizeX = aColumns["size_x"];
+    std::vector<int>& sizeY = aColumns["size_y"];
+    std::vector<int>& drillX = aColumns["drill_x"];
+    std::vector<int>& drillY = aColumns["drill_y"];
+    std::vector<int>& shape = aColumns["shape"];
+    std::vector<int>& attribute = aColumns["attribute"];
+    std::vector<int>& net = aColumns["net"];
+    int               fpIndex = 0;
+
+    for( FOOTPRINT* fp : aBoard->Footprints() )
+    {
+        for( PAD* pad : fp->Pads() )
+        {
+            footprint.push_back( fpIndex );
+            x.push_back( pad->GetPosition().x );
+            y.push_back( pad->GetPosition().y );
+            sizeX.push_back( pad->GetSize().x );
+            sizeY.push_back( pad->GetSize().y );
+            drillX.push_back( pad->GetDrillSize().x );
+            drillY.push_back( pad->GetDrillSize().y );
+            shape.push_back( static_cast<int>( pad->GetShape() ) );
+            attribute.push_back( static_cast<int>( pad->GetAttribute() ) );
+            net.push_back( pad->GetNetCode() );
+        }
+
+        fpIndex++;
+    }
+}
+
+
+int WriteTrackColumns( BOARD* aBoard, const BULK_COLUMNS& aColumns, wxString& aError )
+{
+    wxCHECK( aBoard, -1 );
+
+    static const std::set<std::string> writable = { "start_x", "start_y", "end_x", "end_y",
+                                                    "mid_x", "mid_y", "width", "layer", "net" };
+
+    std::vector<PCB_TRACK*> tracks( aBoard->Tracks().begin(), aBoard->Tracks().end() );
+
+    // Check everything first, so a bad column doesn't leave the board half modified
+    for( const auto& [name, values] : aColumns )
+    {
+        if( name != "type" && !writable.count( name ) )
+        {
+            aError.Printf( wxS( "'%s' is not a writable track column" ), name );
+            return -1;
+        }
+
+        if( values.size() != tracks.size() )
+        {
+            aError.Printf( wxS( "column '%s' has %zu values for %zu tracks" ), name,
+                           values.size(), tracks.size() );
+            return -1;
+        }
+    }
+
+    auto column =
+            [&]( const char* aName ) -> const std::vector<int>*
+            {
+                auto it = aColumns.find( aName );
+                return it == aColumns.end() ? nullptr : &it->second;
+            };
+
+    const std::vector<int>* startX = column( "start_x" );
+    const std::vector<int>* startY = column( "start_y" );
+    const std::vector<int>* endX = column( "end_x" );
+    const std::vector<int>* endY = column( "end_y" );
+    const std::vector<int>* midX = column( "mid_x" );
+    const std::vector<int>* midY = column( "mid_y" );
+    const std::vector<int>* width = column( "width" );
+    const std::vector<int>* layer = column( "layer" );
+    const std::vector<int>* net = column( "net" );
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        if( width && ( *width )[ii] <= 0 )
+        {
+            aError.Printf( wxS( "invalid width %d for track %zu" ), ( *width )[ii], ii );
+            return -1;
+        }
+
+        if( layer && tracks[ii]->Type() != PCB_VIA_T
+                && ( !IsCopperLayer( ( *layer )[ii] )
+                     || !aBoard->IsLayerEnabled( ToLAYER_ID( ( *layer )[ii] ) ) ) )
+        {
+            aError.Printf( wxS( "invalid layer %d for track %zu" ), ( *layer )[ii], ii );
+            return -1;
+        }
+
+        if( net && !aBoard->FindNet( ( *net )[ii] ) )
+        {
+            aError.Printf( wxS( "unknown net %d for track %zu" ), ( *net )[ii], ii );
+            return -1;
+        }
+    }
+
+    std::unique_ptr<BOARD_COMMIT> commit;
+
+    if( s_PcbEditFrame && s_PcbEditFrame->GetBoard() == aBoard && !IsActionRunning() )
+        commit = std::make_unique<BOARD_COMMIT>( s_PcbEditFrame );
+
+    auto value =
+            []( const std::vector<int>* aColumn, size_t aIndex, int aDefault )
+            {
+                return aColumn ? ( *aColumn )[aIndex] : aDefault;
+            };
+
+    std::vector<BOARD_ITEM*> modified;
+
+    for( size_t ii = 0; ii < tracks.size(); ++ii )
+    {
+        PCB_TRACK* track = tracks[ii];
+        VECTOR2I   start( value( startX, ii, track->GetStart().x ),
+                          value( startY, ii, track->GetStart().y ) );
+        VECTOR2I   end( value( endX, ii, track->GetEnd().x ),
+                        value( endY, ii, track->GetEnd().y ) );
+        int        newWidth = value( width, ii, track->GetWidth() );
+        int        newLayer = value( layer, ii, track->GetLayer() );
+        int        newNet = value( net, ii, track->GetNetCode() );
+        VECTOR2I   mid;
+        bool       midChanged = false;
+
+        if( track->Type() == PCB_ARC_T )
+        {
+            PCB_ARC* arc = static_cast<PCB_ARC*>( track );
+
+            mid = VECTOR2I( value( midX, ii, arc->GetMid().x ), value( midY, ii, arc->GetMid().y ) );
+            midChanged = mid != arc->GetMid();
+        }
+
+        if( track->Type() == PCB_VIA_T )
+            newLayer = track->GetLayer();
+
+        if( start == track->GetStart() && end == track->GetEnd() && !midChanged
+                && newWidth == track->GetWidth() && newLayer == track->GetLayer()
+                && newNet == track->GetNetCode() )
+        {
+            continue;
+        }
+
+        if( commit )
+            commit->Modify( track );
+
+        if( track->Type() == PCB_VIA_T )
+        {
+            // A via has a single position; the start column wins
+            if( start != track->GetStart() )
+                static_cast<PCB_VIA*>( track )->SetPosition( start );
+            else
+                static_cast<PCB_VIA*>( track )->SetPosition( end );
+        }
+        else
+        {
+            track->SetStart( start );
+            track->SetEnd( end );
+
+            if( midChanged )
+                static_cast<PCB_ARC*>( track )->SetMid( mid );
+
+            track->SetLayer( ToLAYER_ID( newLayer ) );
+        }
+
+        track->SetWidth( newWidth );
+        track->SetNetCode( newNet );
+        modified.push_back( track );
+    }
+
+    if( commit )
+    {
+        commit->Push( _( "Update Tracks" ) );
+    }
+    else if( !modified.empty() )
+    {
+        // No commit to invalidate the area test results of the tracks
+        aBoard->m_AreaTestCache.Invalidate( modified );
+        aBoard->BuildConnectivity();
+    }
+
+    return (int) modified.size();
+}
@@ -26,6 +26,9 @@
 #define __PCBNEW_SCRIPTING_HELPERS_H
 
 #include <deque>
+#include <map>
+#include <string>
+#include <vector>
 #include <pcb_io/pcb_io_mgr.h>
 #include <layer_ids.h>
 
@@ -54,6 +57,15 @@ BOARD*  LoadBoard( wxString& aFileName, PCB_IO_MGR::PCB_FILE_T aFormat );
 // Default LoadBoard() to load .kicad_pcb files:.
 BOARD*  LoadBoard( wxString& aFileName );
 
+#ifndef SWIG
+/**
+ * Load a board for a job which needs neither its zone fills nor its connectivity.  The fills
+ * are only parsed if something accesses them (see PROP_LAZY_ZONE_FILLS), and the connectivity
+ * isn't built.
+ */
+BOARD*  LoadBoardWithoutFills( wxString& aFileName );
+#endif
+
 /**
  * Creates a new board and project with the given filename (will overwrite existing files!)
  *
@@ -227,4 +239,41 @@ bool WriteDRCReport( BOARD* aBoard, const wxString& aFileName, EDA_UNITS aUnits,
  */
 wxString GetLanguage();
 
+#ifndef SWIG
+/**
+ * Named columns of integers, one value per item.  Used by the BOARD.GetTrackColumns(),
+ * BOARD.GetPadColumns() and BOARD.SetTrackColumns() Python methods, which hand whole columns
+ * to scripts instead of wrapping each item and property.
+ */
+typedef std::map<std::string, std::vector<int>> BULK_COLUMNS;
+
+/**
+ * Read the tracks, arcs and vias of \a aBoard into columns, in BOARD::Tracks() order:
+ * "type" (the KICAD_T), "start_x", "start_y", "end_x", "end_y", "mid_x", "mid_y" (the arc
+ * midpoint, or the middle of the segment), "width", "layer" and "net".
+ */
+void ReadTrackColumns( BOARD* aBoard, BULK_COLUMNS& aColumns );
+
+/**
+ * Read the pads of \a aBoard into columns, footprint by footprint: "footprint" (the index of
+ * the footprint in BOARD::Footprints()), "x", "y", "size_x", "size_y", "drill_x", "drill_y",
+ * "shape" (the PAD_SHAPE), "attribute" (the PAD_ATTRIB) and "net".
+ */
+void ReadPadColumns( BOARD* aBoard, BULK_COLUMNS& aColumns );
+
+/**
+ * Write columns as returned by ReadTrackColumns() back to the tracks of \a aBoard.  Any
+ * subset of the columns may be given; "type" is ignored and "layer" is ignored for vias.
+ *
+ * When \a aBoard is the board of the PCB editor, the changes are pushed as a single commit
+ * (unless an action plugin is running, which records its own changes).  Otherwise they are
+ * applied directly and the connectivity is rebuilt.
+ *
+ * @param aError is set to the reason when the columns are rejected.
+ * @return the number of modified tracks, or -1 if the columns were rejected, in which case
+ *         nothing is modified.
+ */
+int WriteTrackColumns( BOARD* aBoard, const BULK_COLUMNS& aColumns, wxString& aError );
+#endif
+
 #endif      // __PCBNEW_SCRIPTING_HELPERS_H
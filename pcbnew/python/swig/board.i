@@ -73,11 +73,7 @@ HANDLE_EXCEPTIONS(BOARD::TracksInNetBetweenPoints)
 
 // Do not wrap internal-only structures
 %ignore BOARD::m_CachesMutex;
-%ignore BOARD::m_IntersectsCourtyardCache;
-%ignore BOARD::m_IntersectsFCourtyardCache;
-%ignore BOARD::m_IntersectsBCourtyardCache;
-%ignore BOARD::m_IntersectsAreaCache;
-%ignore BOARD::m_EnclosedByAreaCache;
+%ignore BOARD::m_AreaTestCache;
 %ignore BOARD::m_LayerExpressionCache;
 %ignore BOARD::m_CopperZoneRTreeCache;
 %ignore BOARD::m_CopperItemRTreeCache;
@@ -122,8 +118,169 @@ HANDLE_EXCEPTIONS(BOARD::TracksInNetBetweenPoints)
     %}
 }
 
+%{
+// Return the columns as a dict of memoryviews of C ints, which can be read as they are or
+// handed to array.array or numpy.frombuffer without converting each value.
+static PyObject* bulkColumnsToPython( const BULK_COLUMNS& aColumns )
+{
+    PyObject* dict = PyDict_New();
+
+    for( const auto& [name, values] : aColumns )
+    {
+        PyObject* bytes = PyByteArray_FromStringAndSize(
+                reinterpret_cast<const char*>( values.data() ), values.size() * sizeof( int ) );
+        PyObject* view = bytes ? PyMemoryView_FromObject( bytes ) : nullptr;
+        PyObject* column = view ? PyObject_CallMethod( view, "cast", "s", "i" ) : nullptr;
+
+        Py_XDECREF( view );
+        Py_XDECREF( bytes );
+
+        if( !column )
+        {
+            Py_DECREF( dict );
+            return nullptr;
+        }
+
+        PyDict_SetItemString( dict, name.c_str(), column );
+        Py_DECREF( column );
+    }
+
+    return dict;
+}
+
+
+// Read a column from anything exposing C ints or longs through the buffer protocol (array,
+// memoryview, numpy arrays), or else from any sequence of Python ints.
+static bool bulkColumnFromPython( PyObject* aObject, std::vector<int>& aValues )
+{
+    Py_buffer buffer;
+
+    if( PyObject_GetBuffer( aObject, &buffer, PyBUF_FORMAT | PyBUF_C_CONTIGUOUS ) == 0 )
+    {
+        std::string format = buffer.format ? buffer.format : "B";
+        bool        done = true;
+
+        if( !format.empty() && strchr( "@=<", format[0] ) )
+            format = format.substr( 1 );
+
+        if( format == "i" && buffer.itemsize == sizeof( int ) )
+        {
+            aValues.resize( buffer.len / sizeof( int ) );
+            memcpy( aValues.data(), buffer.buf, aValues.size() * sizeof( int ) );
+        }
+        else if( ( format == "q" || format == "l" ) && buffer.itemsize == sizeof( int64_t ) )
+        {
+            const int64_t* data = static_cast<const int64_t*>( buffer.buf );
+
+            aValues.assign( data, data + buffer.len / sizeof( int64_t ) );
+        }
+        else
+        {
+            done = false;
+        }
+
+        PyBuffer_Release( &buffer );
+
+        if( done )
+            return true;
+    }
+    else
+    {
+        PyErr_Clear();
+    }
+
+    PyObject* seq = PySequence_Fast( aObject, "track columns must be sequences of ints" );
+
+    if( !seq )
+        return false;
+
+    Py_ssize_t count = PySequence_Fast_GET_SIZE( seq );
+    aValues.resize( count );
+
+    for( Py_ssize_t ii = 0; ii < count; ++ii )
+    {
+        aValues[ii] = (int) PyLong_AsLong( PySequence_Fast_GET_ITEM( seq, ii ) );
+
+        if( PyErr_Occurred() )
+        {
+            Py_DECREF( seq );
+            return false;
+        }
+    }
+
+    Py_DECREF( seq );
+    return true;
+}
+%}
+
 %extend BOARD
 {
+    /**
+     * Return a dict of columns describing all tracks, arcs and vias, one entry per item in
+     * Tracks() order.  See ReadTrackColumns() for the column names.
+     */
+    PyObject* GetTrackColumns()
+    {
+        BULK_COLUMNS columns;
+        ReadTrackColumns( $self, columns );
+        return bulkColumnsToPython( columns );
+    }
+
+    /**
+     * Return a dict of columns describing all pads of all footprints.  See ReadPadColumns()
+     * for the column names.
+     */
+    PyObject* GetPadColumns()
+    {
+        BULK_COLUMNS columns;
+        ReadPadColumns( $self, columns );
+        return bulkColumnsToPython( columns );
+    }
+
+    /**
+     * Apply a dict of track columns, such as a modified result of GetTrackColumns(), in a
+     * single commit.  Return the number of modified tracks; raise ValueError if the columns
+     * don't fit the board.
+     */
+    PyObject* SetTrackColumns( PyObject* aColumns )
+    {
+        if( !PyDict_Check( aColumns ) )
+        {
+            PyErr_SetString( PyExc_TypeError, "SetTrackColumns() expects a dict of columns" );
+            return nullptr;
+        }
+
+        BULK_COLUMNS columns;
+        PyObject*    key;
+        PyObject*    values;
+        Py_ssize_t   pos = 0;
+
+        while( PyDict_Next( aColumns, &pos, &key, &values ) )
+        {
+            const char* name = PyUnicode_Check( key ) ? PyUnicode_AsUTF8( key ) : nullptr;
+
+            if( !name )
+            {
+                PyErr_SetString( PyExc_TypeError, "track column names must be strings" );
+                return nullptr;
+            }
+
+            if( !bulkColumnFromPython( values, columns[name] ) )
+                return nullptr;
+        }
+
+        wxString error;
+        int      modified = WriteTrackColumns( $self, columns, error );
+
+        if( modified < 0 )
+        {
+            PyErr_SetString( PyExc_ValueError, error.utf8_str() );
+            return nullptr;
+        }
+
+        return PyLong_FromLong( modified );
+    }
+
     // NOTE: this does not generate a ctor, despite swig docs saying it should.  Not sure why.
     // Because of this, we use the __init__ override hack below.
     // BOARD()
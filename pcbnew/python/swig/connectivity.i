@@ -27,13 +27,16 @@
 
 // this shared_ptr line has to be before include connectivity_data.h.
 %shared_ptr(CONNECTIVITY_DATA)
+%shared_ptr(CONNECTIVITY_SNAPSHOT)
 
+%include connectivity/connectivity_snapshot.h
 %include connectivity/connectivity_data.h
 
  
 
 
 %{
+#include <connectivity/connectivity_snapshot.h>
 #include <connectivity/connectivity_data.h>
 %}
 
@@ -135,5 +135,6 @@ HANDLE_EXCEPTIONS(WriteDRCReport)
 %include plugins.i
 %include units.i
 %include version.i
+%include router.i
 
 
@@ -40,6 +40,7 @@ using namespace std::placeholders;
 
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <limits>
 
 #include <delaunator.hpp>
@@ -220,19 +221,16 @@ public:
             delaunator::Delaunator delaunator( node_pts );
             auto& triangles = delaunator.triangles;
 
-            for( size_t i = 0; i < triangles.size(); i += 3 )
+            // Half-edge i runs from triangles[i] to the next corner of its triangle.  Inner
+            // edges have two half-edges, one in each triangle: only keep the first, so that
+            // the MST doesn't have to sort every edge several times over.
+            for( size_t i = 0; i < triangles.size(); i++ )
             {
-                addEdge( anchors[triangles[i]],     anchors[triangles[i + 1]] );
-                addEdge( anchors[triangles[i + 1]], anchors[triangles[i + 2]] );
-                addEdge( anchors[triangles[i + 2]], anchors[triangles[i]]     );
-            }
-
-            for( size_t i = 0; i < delaunator.halfedges.size(); i++ )
-            {
-                if( delaunator.halfedges[i] == delaunator::INVALID_INDEX )
-                    continue;
+                size_t next = ( i % 3 == 2 ) ? i - 2 : i + 1;
+                size_t opposite = delaunator.halfedges[i];
 
-                addEdge( anchors[triangles[i]], anchors[triangles[delaunator.halfedges[i]]] );
+                if( opposite == delaunator::INVALID_INDEX || i < opposite )
+                    addEdge( anchors[triangles[i]], anchors[triangles[next]] );
             }
         }
 
@@ -351,7 +349,7 @@ void RN_NET::OptimizeRNEdges()
 
                     if( zoneLayer && aLayerSet.test( zoneLayer->Layer() ) )
                     {
-                        const std::vector<VECTOR2I>& pts = zoneLayer->GetOutline().CPoints();
+                        const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = zoneLayer->GetOutline().CPoints();
 
                         for( const VECTOR2I& pt : pts )
                         {
@@ -475,6 +473,7 @@ void RN_NET::Clear()
     m_rnEdges.clear();
     m_boardEdges.clear();
     m_nodes.clear();
+    m_nodeGrid.reset();
 
     m_dirty = true;
 }
@@ -484,6 +483,8 @@ void RN_NET::AddCluster( std::shared_ptr<CN_CLUSTER> aCluster )
 {
     std::shared_ptr<CN_ANCHOR> firstAnchor;
 
+    m_nodeGrid.reset();
+
     for( CN_ITEM* item : *aCluster )
     {
         std::vector<std::shared_ptr<CN_ANCHOR>>& anchors = item->Anchors();
@@ -511,15 +512,76 @@ void RN_NET::AddCluster( std::shared_ptr<CN_CLUSTER> aCluster )
 }
 
 
+const RN_NET::NODE_GRID& RN_NET::nodeGrid() const
+{
+    if( m_nodeGrid )
+        return *m_nodeGrid;
+
+    m_nodeGrid = std::make_shared<NODE_GRID>();
+
+    NODE_GRID& grid = *m_nodeGrid;
+
+    if( m_nodes.empty() )
+        return grid;
+
+    grid.m_bbox = BOX2I( ( *m_nodes.begin() )->Pos(), VECTOR2I( 0, 0 ) );
+
+    for( const std::shared_ptr<CN_ANCHOR>& node : m_nodes )
+        grid.m_bbox.Merge( node->Pos() );
+
+    // Aim for a couple of nodes per cell
+    double width = std::max<double>( grid.m_bbox.GetWidth(), 1.0 );
+    double height = std::max<double>( grid.m_bbox.GetHeight(), 1.0 );
+    double cellSize = std::sqrt( 2.0 * width * height / m_nodes.size() );
+
+    cellSize = std::max( cellSize, std::max( width, height ) / m_nodes.size() );
+    grid.m_cellSize = std::max( 1, KiROUND( cellSize ) );
+    grid.m_cols = grid.m_bbox.GetWidth() / grid.m_cellSize + 1;
+    grid.m_rows = grid.m_bbox.GetHeight() / grid.m_cellSize + 1;
+
+    // Counting sort of the nodes by cell
+    std::vector<int> cellOf;
+
+    cellOf.reserve( m_nodes.size() );
+    grid.m_cellStart.assign( (size_t) grid.m_cols * grid.m_rows + 1, 0 );
+
+    for( const std::shared_ptr<CN_ANCHOR>& node : m_nodes )
+    {
+        VECTOR2I cell = grid.CellOf( node->Pos() );
+        int      idx = cell.y * grid.m_cols + cell.x;
+
+        cellOf.push_back( idx );
+        grid.m_cellStart[idx + 1]++;
+    }
+
+    for( size_t ii = 1; ii < grid.m_cellStart.size(); ++ii )
+        grid.m_cellStart[ii] += grid.m_cellStart[ii - 1];
+
+    std::vector<int> fill( grid.m_cellStart.begin(), grid.m_cellStart.end() - 1 );
+    size_t           ii = 0;
+
+    grid.m_nodes.resize( m_nodes.size() );
+
+    for( const std::shared_ptr<CN_ANCHOR>& node : m_nodes )
+        grid.m_nodes[fill[cellOf[ii++]]++] = node.get();
+
+    return grid;
+}
+
+
 bool RN_NET::NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2 ) const
 {
     bool rv = false;
 
     SEG::ecoord distMax_sq = VECTOR2I::ECOORD_MAX;
 
+    const NODE_GRID& grid = nodeGrid();
+
+    if( grid.m_nodes.empty() )
+        return false;
+
     auto verify =
-            [&]( const std::shared_ptr<CN_ANCHOR>& aTestNode1,
-                 const std::shared_ptr<CN_ANCHOR>& aTestNode2 )
+            [&]( const CN_ANCHOR* aTestNode1, const CN_ANCHOR* aTestNode2 )
             {
                 VECTOR2I    diff = aTestNode1->Pos() - aTestNode2->Pos();
                 SEG::ecoord dist_sq = diff.SquaredEuclideanNorm();
@@ -533,55 +595,60 @@ bool RN_NET::NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I&
                 }
             };
 
-    std::multiset<std::shared_ptr<CN_ANCHOR>, CN_PTR_CMP> nodes_b;
+    auto visitCell =
+            [&]( const CN_ANCHOR* aNodeA, int aCol, int aRow )
+            {
+                if( aCol < 0 || aCol >= grid.m_cols || aRow < 0 || aRow >= grid.m_rows )
+                    return;
+
+                int idx = aRow * grid.m_cols + aCol;
 
-    std::copy_if( m_nodes.begin(), m_nodes.end(), std::inserter( nodes_b, nodes_b.end() ),
-            []( const std::shared_ptr<CN_ANCHOR> &aVal )
-            { return !aVal->GetNoLine(); } );
+                for( int ii = grid.m_cellStart[idx]; ii < grid.m_cellStart[idx + 1]; ++ii )
+                {
+                    if( !grid.m_nodes[ii]->GetNoLine() )
+                        verify( aNodeA, grid.m_nodes[ii] );
+                }
+            };
 
-    /// Sweep-line algorithm to cut the number of comparisons to find the closest point
-    ///
-    /// Step 1: The outer loop needs to be the subset (selected nodes) as it is a linear search
+    /// The outer loop is the subset (selected nodes), searched for in rings of grid cells
+    /// around each of them.  Rings stop once they are further than the closest pair found.
     for( const std::shared_ptr<CN_ANCHOR>& nodeA : aOtherNet->m_nodes )
     {
-
         if( nodeA->GetNoLine() )
             continue;
 
-        /// Step 2: O( log n ) search to identify a close element ordered by x
-        /// The fwd_it iterator will move forward through the elements while
-        /// the rev_it iterator will move backward through the same set
-        auto fwd_it = nodes_b.lower_bound( nodeA );
-        auto rev_it = std::make_reverse_iterator( fwd_it );
+        // Nodes outside of the grid start from the closest cell: no node is closer to them
+        // than it is to their projection on the grid
+        VECTOR2I home = grid.CellOf( nodeA->Pos() );
+        int      maxRing = std::max( grid.m_cols, grid.m_rows );
 
-        for( ; fwd_it != nodes_b.end(); ++fwd_it )
+        for( int ring = 0; ring <= maxRing; ++ring )
         {
-            const std::shared_ptr<CN_ANCHOR>& nodeB = *fwd_it;
-
-            SEG::ecoord distX_sq = SEG::Square( nodeA->Pos().x - nodeB->Pos().x );
-
-            /// As soon as the x distance (primary sort) is larger than the smallest distance,
-            /// stop checking further elements
-            if( distX_sq > distMax_sq )
+            if( ring > 0 && SEG::Square( (SEG::ecoord) ( ring - 1 ) * grid.m_cellSize )
+                                    > distMax_sq )
+            {
                 break;
+            }
 
-            verify( nodeA, nodeB );
-        }
-
-        /// Step 3: using the same starting point, check points backwards for closer points
-        for( ; rev_it != nodes_b.rend(); ++rev_it )
-        {
-            const std::shared_ptr<CN_ANCHOR>& nodeB = *rev_it;
-
-            SEG::ecoord distX_sq = SEG::Square( nodeA->Pos().x - nodeB->Pos().x );
+            if( ring == 0 )
+            {
+                visitCell( nodeA.get(), home.x, home.y );
+                continue;
+            }
 
-            if( distX_sq > distMax_sq )
-                break;
+            for( int dx = -ring; dx <= ring; ++dx )
+            {
+                visitCell( nodeA.get(), home.x + dx, home.y - ring );
+                visitCell( nodeA.get(), home.x + dx, home.y + ring );
+            }
 
-            verify( nodeA, nodeB );
+            for( int dy = -ring + 1; dy <= ring - 1; ++dy )
+            {
+                visitCell( nodeA.get(), home.x - ring, home.y + dy );
+                visitCell( nodeA.get(), home.x + ring, home.y + dy );
+            }
         }
     }
 
     return rv;
 }
-
@@ -35,6 +35,8 @@
 #include <core/typeinfo.h>
 #include <math/box2.h>
 
+#include <algorithm>
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -99,6 +101,32 @@ public:
     bool NearestBicoloredPair( RN_NET* aOtherNet, VECTOR2I& aPos1, VECTOR2I& aPos2 ) const;
 
 protected:
+    /**
+     * A uniform grid of the nodes, for the nearest node searches of the dynamic ratsnest.
+     * The nodes of a cell are stored next to each other, from m_cellStart[cell] up to
+     * m_cellStart[cell + 1].
+     */
+    struct NODE_GRID
+    {
+        VECTOR2I CellOf( const VECTOR2I& aPos ) const
+        {
+            int col = ( aPos.x - m_bbox.GetLeft() ) / m_cellSize;
+            int row = ( aPos.y - m_bbox.GetTop() ) / m_cellSize;
+
+            return VECTOR2I( std::clamp( col, 0, m_cols - 1 ), std::clamp( row, 0, m_rows - 1 ) );
+        }
+
+        BOX2I                   m_bbox;
+        int                     m_cellSize = 1;
+        int                     m_cols = 0;
+        int                     m_rows = 0;
+        std::vector<int>        m_cellStart;
+        std::vector<CN_ANCHOR*> m_nodes;
+    };
+
+    ///< Return the grid of the nodes, building it if the nodes changed since the last call.
+    const NODE_GRID& nodeGrid() const;
+
     ///< Recompute ratsnest from scratch.
     void compute();
 
@@ -121,6 +149,9 @@ protected:
     class TRIANGULATOR_STATE;
 
     std::shared_ptr<TRIANGULATOR_STATE> m_triangulator;
+
+    ///< Grid of the nodes, built on first use by the dynamic ratsnest
+    mutable std::shared_ptr<NODE_GRID>  m_nodeGrid;
 };
 
 #endif /* RATSNEST_DATA_H */
@@ -83,6 +83,7 @@ public:
     void SetWidth( int aWidth ) override
     {
         m_arc.SetWidth(aWidth);
+        invalidateHull();
     }
 
     int Width() const override
@@ -112,7 +113,11 @@ public:
 
     OPT_BOX2I ChangedArea( const ARC* aOther ) const;
 
-    SHAPE_ARC& Arc() { return m_arc; }
+    SHAPE_ARC& Arc()
+    {
+        invalidateHull();
+        return m_arc;
+    }
     const SHAPE_ARC& CArc() const { return m_arc; }
 
 private:
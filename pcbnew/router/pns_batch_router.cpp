@@ -0,0 +1,265 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <router/pns_batch_router.h>
+
+#include <board.h>
+#include <board_commit.h>
+#include <board_connected_item.h>
+#include <netinfo.h>
+
+#include "pns_kicad_iface.h"
+#include "pns_placement_algo.h"
+#include "pns_router.h"
+#include "pns_routing_settings.h"
+#include "pns_sizes_settings.h"
+
+
+/**
+ * Write the results of the router to a BOARD_COMMIT, or to the board itself when there is none.
+ */
+class PNS_BATCH_IFACE : public PNS_KICAD_IFACE_BASE
+{
+public:
+    PNS_BATCH_IFACE( BOARD* aBoard, BOARD_COMMIT* aCommit ) :
+            m_commit( aCommit ),
+            m_boardChanged( false )
+    {
+        SetBoard( aBoard );
+    }
+
+    ~PNS_BATCH_IFACE()
+    {
+        // Removed items are kept until the router is gone, as its world refers to them
+        for( BOARD_ITEM* item : m_removedItems )
+            delete item;
+
+        delete m_ruleResolver;
+    }
+
+    void AddItem( PNS::ITEM* aItem ) override
+    {
+        BOARD_CONNECTED_ITEM* boardItem = createBoardItem( aItem );
+
+        if( !boardItem )
+            return;
+
+        aItem->SetParent( boardItem );
+        boardItem->ClearFlags();
+
+        if( m_commit )
+        {
+            m_commit->Add( boardItem );
+        }
+        else
+        {
+            m_board->Add( boardItem );
+            m_boardChanged = true;
+        }
+    }
+
+    void UpdateItem( PNS::ITEM* aItem ) override
+    {
+        if( m_commit )
+            m_commit->Modify( aItem->Parent() );
+        else
+            m_boardChanged = true;
+
+        modifyBoardItem( aItem );
+    }
+
+    void RemoveItem( PNS::ITEM* aItem ) override
+    {
+        BOARD_ITEM* parent = aItem->Parent();
+
+        // Pads aren't moved by single track routing
+        if( !parent || aItem->OfKind( PNS::ITEM::SOLID_T ) )
+            return;
+
+        if( m_commit )
+        {
+            m_commit->Remove( parent );
+        }
+        else
+        {
+            m_board->Remove( parent );
+            m_removedItems.push_back( parent );
+            m_boardChanged = true;
+        }
+    }
+
+    void Commit() override
+    {
+        m_fpOffsets.clear();
+    }
+
+    int GetNetCode( PNS::NET_HANDLE aNet ) const override
+    {
+        return aNet ? static_cast<NETINFO_ITEM*>( aNet )->GetNetCode() : -1;
+    }
+
+    wxString GetNetName( PNS::NET_HANDLE aNet ) const override
+    {
+        return aNet ? static_cast<NETINFO_ITEM*>( aNet )->GetNetname() : wxString();
+    }
+
+    bool BoardChanged() const { return m_boardChanged; }
+
+private:
+    BOARD_COMMIT*            m_commit;
+    std::vector<BOARD_ITEM*> m_removedItems;
+    bool                     m_boardChanged;
+};
+
+
+PNS_BATCH_ROUTER::PNS_BATCH_ROUTER( BOARD* aBoard ) :
+        m_board( aBoard ),
+        m_shove( false )
+{
+}
+
+
+int PNS_BATCH_ROUTER::AddRoute( const VECTOR2I& aStart, const VECTOR2I& aEnd,
+                                PCB_LAYER_ID aLayer, int aNetCode )
+{
+    m_routes.push_back( { aStart, aEnd, aLayer, aNetCode, false } );
+    return (int) m_routes.size() - 1;
+}
+
+
+bool PNS_BATCH_ROUTER::IsRouted( int aIndex ) const
+{
+    if( aIndex < 0 || aIndex >= (int) m_routes.size() )
+        return false;
+
+    return m_routes[aIndex].m_routed;
+}
+
+
+int PNS_BATCH_ROUTER::Run( BOARD_COMMIT* aCommit )
+{
+    // The interactive router of the editor, if any, is the one its tools expect to find
+    PNS::ROUTER* previousRouter = PNS::ROUTER::GetInstance();
+    int          routed = 0;
+
+    PNS_BATCH_IFACE       iface( m_board, aCommit );
+    PNS::ROUTING_SETTINGS settings( nullptr, "" );
+
+    settings.SetMode( m_shove ? PNS::RM_Shove : PNS::RM_Walkaround );
+
+    {
+        // Destroyed before the interface, as the world needs its rule resolver
+        PNS::ROUTER router;
+
+        router.SetInterface( &iface );
+        router.ClearWorld();
+        router.SyncWorld();
+        router.LoadSettings( &settings );
+        router.SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+
+        for( ROUTE& r : m_routes )
+        {
+            r.m_routed = route( router, r );
+
+            if( r.m_routed )
+                routed++;
+        }
+    }
+
+    PNS::ROUTER::SetInstance( previousRouter );
+
+    if( iface.BoardChanged() )
+        m_board->BuildConnectivity();
+
+    return routed;
+}
+
+
+bool PNS_BATCH_ROUTER::route( PNS::ROUTER& aRouter, ROUTE& aRoute )
+{
+    PNS_KICAD_IFACE_BASE* iface = static_cast<PNS_KICAD_IFACE_BASE*>( aRouter.GetInterface() );
+    PNS::ITEM*            startItem = pickItem( aRouter, aRoute.m_start, aRoute.m_layer,
+                                                aRoute.m_netCode );
+
+    // Without a start item, the track would have no net
+    if( !startItem )
+        return false;
+
+    PNS::SIZES_SETTINGS sizes( aRouter.Sizes() );
+
+    iface->SetStartLayer( aRoute.m_layer );
+    iface->ImportSizes( sizes, startItem, nullptr );
+    aRouter.UpdateSizes( sizes );
+
+    if( !aRouter.StartRouting( aRoute.m_start, startItem, aRoute.m_layer ) )
+        return false;
+
+    PNS::ITEM* endItem = pickItem( aRouter, aRoute.m_end, aRoute.m_layer, aRoute.m_netCode );
+
+    aRouter.Move( aRoute.m_end, endItem );
+
+    // A route blocked on its way is dropped rather than committed half-way
+    if( aRouter.Placer()->CurrentEnd() == aRoute.m_end
+            && aRouter.FixRoute( aRoute.m_end, endItem, true ) )
+    {
+        aRouter.CommitRouting();
+        return true;
+    }
+
+    aRouter.StopRouting();
+    return false;
+}
+
+
+PNS::ITEM* PNS_BATCH_ROUTER::pickItem( PNS::ROUTER& aRouter, const VECTOR2I& aWhere,
+                                       PCB_LAYER_ID aLayer, int aNetCode ) const
+{
+    NETINFO_ITEM* net = m_board->FindNet( aNetCode );
+    PNS::ITEM*    best = nullptr;
+    int           bestPriority = 0;
+
+    if( !net )
+        return nullptr;
+
+    for( PNS::ITEM* item : aRouter.QueryHoverItems( aWhere ).CItems() )
+    {
+        int priority = 0;
+
+        if( item->Net() != net || !item->Layers().Overlaps( aLayer ) )
+            continue;
+
+        switch( item->Kind() )
+        {
+        case PNS::ITEM::SOLID_T:   priority = 3; break;
+        case PNS::ITEM::VIA_T:     priority = 2; break;
+        case PNS::ITEM::SEGMENT_T:
+        case PNS::ITEM::ARC_T:     priority = 1; break;
+        default:                   break;
+        }
+
+        if( priority > bestPriority )
+        {
+            best = item;
+            bestPriority = priority;
+        }
+    }
+
+    return best;
+}
@@ -0,0 +1,107 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef PNS_BATCH_ROUTER_H
+#define PNS_BATCH_ROUTER_H
+
+#include <vector>
+
+#include <layer_ids.h>
+#include <math/vector2d.h>
+
+class BOARD;
+class BOARD_COMMIT;
+
+namespace PNS
+{
+class ITEM;
+class ROUTER;
+}
+
+
+/**
+ * Route a list of connections with the interactive router, without a user interface (for
+ * fanouts and escape routing made by scripts).
+ *
+ * Each route starts from an item of its net (pad, via or track) at its start point and is routed
+ * to its end point in one go, walking around or shoving the obstacles.  The world is synced with
+ * the board once per run, so the later routes avoid (or push) the earlier ones.  The routes are
+ * routed one after the other: the router algorithms share their world and aren't thread safe.
+ */
+class PNS_BATCH_ROUTER
+{
+public:
+    PNS_BATCH_ROUTER( BOARD* aBoard );
+
+    /**
+     * Shove the tracks in the way of the routes instead of walking around them.
+     */
+    void SetShove( bool aShove ) { m_shove = aShove; }
+    bool GetShove() const { return m_shove; }
+
+    /**
+     * Add a route from \a aStart to \a aEnd on \a aLayer.  There must be an item of the net
+     * \a aNetCode on the layer at \a aStart.
+     *
+     * @return the index of the route.
+     */
+    int AddRoute( const VECTOR2I& aStart, const VECTOR2I& aEnd, PCB_LAYER_ID aLayer,
+                  int aNetCode );
+
+    void ClearRoutes() { m_routes.clear(); }
+
+    int GetRouteCount() const { return (int) m_routes.size(); }
+
+    /**
+     * @return true if the route \a aIndex reached its end point in the last run.
+     */
+    bool IsRouted( int aIndex ) const;
+
+    /**
+     * Route all the routes, in the order they were added.
+     *
+     * @param aCommit receives the tracks made and changed by the router, to be pushed by the
+     *                caller.  When null, the board is changed directly (which can't be undone).
+     * @return the number of routes which reached their end point.
+     */
+    int Run( BOARD_COMMIT* aCommit = nullptr );
+
+private:
+    struct ROUTE
+    {
+        VECTOR2I     m_start;
+        VECTOR2I     m_end;
+        PCB_LAYER_ID m_layer;
+        int          m_netCode;
+        bool         m_routed;
+    };
+
+    bool route( PNS::ROUTER& aRouter, ROUTE& aRoute );
+
+    ///< @return the item of \a aNetCode at \a aWhere on \a aLayer, pads first, then vias
+    PNS::ITEM* pickItem( PNS::ROUTER& aRouter, const VECTOR2I& aWhere, PCB_LAYER_ID aLayer,
+                         int aNetCode ) const;
+
+    BOARD*             m_board;
+    bool               m_shove;
+    std::vector<ROUTE> m_routes;
+};
+
+#endif // PNS_BATCH_ROUTER_H
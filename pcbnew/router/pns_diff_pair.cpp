@@ -19,11 +19,13 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
 #include <limits>
 
+#include <core/thread_pool.h>
 #include <geometry/shape_rect.h>
 
 #include "pns_diff_pair.h"
@@ -338,13 +340,76 @@ void DP_GATEWAYS::BuildOrthoProjections( DP_GATEWAYS& aEntries, const VECTOR2I&
 }
 
 
+void DP_GATEWAYS::removeDuplicates()
+{
+    auto same =
+            []( const DP_GATEWAY& a, const DP_GATEWAY& b )
+            {
+                if( a.AnchorP() != b.AnchorP() || a.AnchorN() != b.AnchorN()
+                        || a.IsDiagonal() != b.IsDiagonal() || a.Priority() != b.Priority()
+                        || a.AllowedAngles() != b.AllowedAngles()
+                        || a.HasEntryLines() != b.HasEntryLines() )
+                {
+                    return false;
+                }
+
+                return !a.HasEntryLines()
+                       || ( a.EntryP().CPoints() == b.EntryP().CPoints()
+                            && a.EntryN().CPoints() == b.EntryN().CPoints() );
+            };
+
+    std::vector<DP_GATEWAY> unique;
+
+    unique.reserve( m_gateways.size() );
+
+    for( const DP_GATEWAY& g : m_gateways )
+    {
+        bool dup = false;
+
+        for( const DP_GATEWAY& u : unique )
+        {
+            if( same( g, u ) )
+            {
+                dup = true;
+                break;
+            }
+        }
+
+        if( !dup )
+            unique.push_back( g );
+    }
+
+    m_gateways = std::move( unique );
+}
+
+
 bool DP_GATEWAYS::FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool aPrefDiagonal,
-                               DIFF_PAIR& aDp )
+                               DIFF_PAIR& aDp, DP_FIT_HINT* aHint )
 {
-    DP_CANDIDATE best;
+    struct CANDIDATE
+    {
+        const DP_GATEWAY* m_entry;
+        const DP_GATEWAY* m_target;
+        bool              m_diagonal;
+        int               m_score;
+        bool              m_hinted;
+    };
+
+    aEntry.removeDuplicates();
+    aTarget.removeDuplicates();
+
+    auto isHinted =
+            [&]( const DP_GATEWAY& aGwEntry, const DP_GATEWAY& aGwTarget, bool aDiagonal )
+            {
+                return aHint && aHint->m_valid && aHint->m_diagonal == aDiagonal
+                       && aHint->m_entryP == aGwEntry.AnchorP()
+                       && aHint->m_entryN == aGwEntry.AnchorN()
+                       && aHint->m_targetSpan == aGwTarget.AnchorP() - aGwTarget.AnchorN();
+            };
+
+    std::vector<CANDIDATE> candidates;
 
-    int bestScore = -1000;
-    bool found = false;
+    candidates.reserve( 2 * aEntry.Gateways().size() * aTarget.Gateways().size() );
 
     for( const DP_GATEWAY& g_entry : aEntry.Gateways() )
     {
@@ -352,33 +417,78 @@ bool DP_GATEWAYS::FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool a
         {
             for( bool preferred : { false, true } )
             {
-                int score = preferred ? 0 : -3;
-                score += g_entry.Priority();
-                score += g_target.Priority();
+                bool diagonal = preferred ? aPrefDiagonal : !aPrefDiagonal;
+                int  score = ( preferred ? 0 : -3 ) + g_entry.Priority() + g_target.Priority();
 
-                if( score >= bestScore )
-                {
-                    DIFF_PAIR l( m_gap );
-
-                    if( l.BuildInitial( g_entry, g_target, preferred ? aPrefDiagonal
-                                                                     : !aPrefDiagonal ) )
-                    {
-                        best.p = l.CP();
-                        best.n = l.CN();
-                        bestScore = score;
-                        found = true;
-                    }
-                }
+                candidates.push_back( { &g_entry, &g_target, diagonal, score,
+                                        isHinted( g_entry, g_target, diagonal ) } );
             }
         }
     }
 
+    // The fit is the highest scoring candidate which can be built, the last one generated when
+    // several score the same (unless one of them is the hinted one).  Trying them in that order
+    // allows to stop at the first one which can be built.
+    std::reverse( candidates.begin(), candidates.end() );
+    std::stable_sort( candidates.begin(), candidates.end(),
+                      []( const CANDIDATE& a, const CANDIDATE& b )
+                      {
+                          if( a.m_score != b.m_score )
+                              return a.m_score > b.m_score;
+
+                          return a.m_hinted && !b.m_hinted;
+                      } );
 
-    if( found )
+    // Building a candidate is cheap, so only large sets (e.g. when fitting vias) are worth
+    // building in parallel, a batch at a time so that the search can still stop early
+    const size_t parallelThreshold = 256;
+    const size_t batchSize = candidates.size() >= parallelThreshold ? 64 : 1;
+
+    std::vector<DIFF_PAIR> pairs( batchSize, DIFF_PAIR( m_gap ) );
+    std::vector<char>      built( batchSize, 0 );
+
+    for( size_t first = 0; first < candidates.size(); first += batchSize )
     {
-        aDp.SetGap( m_gap );
-        aDp.SetShape( best.p, best.n );
-        return true;
+        size_t count = std::min( batchSize, candidates.size() - first );
+
+        auto build =
+                [&]( size_t aIdx )
+                {
+                    const CANDIDATE& c = candidates[first + aIdx];
+
+                    built[aIdx] = pairs[aIdx].BuildInitial( *c.m_entry, *c.m_target,
+                                                            c.m_diagonal );
+                };
+
+        if( count > 1 )
+        {
+            ParallelFor( count, build );
+        }
+        else
+        {
+            build( 0 );
+        }
+
+        for( size_t i = 0; i < count; i++ )
+        {
+            if( !built[i] )
+                continue;
+
+            const CANDIDATE& c = candidates[first + i];
+
+            if( aHint )
+            {
+                aHint->m_valid = true;
+                aHint->m_entryP = c.m_entry->AnchorP();
+                aHint->m_entryN = c.m_entry->AnchorN();
+                aHint->m_targetSpan = c.m_target->AnchorP() - c.m_target->AnchorN();
+                aHint->m_diagonal = c.m_diagonal;
+            }
+
+            aDp.SetGap( m_gap );
+            aDp.SetShape( pairs[i].CP(), pairs[i].CN() );
+            return true;
+        }
     }
 
     return false;
@@ -161,6 +161,20 @@ private:
     VECTOR2I m_anchorP, m_anchorN;
 };
 
+/**
+ * The gateways a diff pair was last fitted to.  They win over equally scored gateways the next
+ * time, so that the head doesn't jump between equivalent fits as the cursor moves.
+ */
+struct DP_FIT_HINT
+{
+    bool     m_valid = false;
+    VECTOR2I m_entryP;          ///< anchors of the entry gateway
+    VECTOR2I m_entryN;
+    VECTOR2I m_targetSpan;      ///< vector between the anchors of the target gateway
+    bool     m_diagonal = false;
+};
+
+
 /**
  * A set of gateways calculated for the cursor or starting/ending primitive pair.
  */
@@ -197,8 +211,15 @@ public:
                        bool aViaMode = false );
     void BuildFromPrimitivePair( const DP_PRIMITIVE_PAIR& aPair, bool aPreferDiagonal );
 
+    /**
+     * Connect the best scoring pair of \a aEntry and \a aTarget gateways which can be.
+     *
+     * @param aHint if not null, the fit to prefer among equally scored ones, updated with the
+     *              new fit.
+     * @return true if a pair of gateways could be connected; \a aDp then holds the connection.
+     */
     bool FitGateways( DP_GATEWAYS& aEntry, DP_GATEWAYS& aTarget, bool aPrefDiagonal,
-                      DIFF_PAIR& aDp );
+                      DIFF_PAIR& aDp, DP_FIT_HINT* aHint = nullptr );
 
     std::vector<DP_GATEWAY>& Gateways() { return m_gateways; }
 
@@ -207,14 +228,10 @@ public:
     void FilterByOrientation( int aAngleMask, DIRECTION_45 aRefOrientation );
 
 private:
-    struct DP_CANDIDATE
-    {
-        SHAPE_LINE_CHAIN p, n;
-        VECTOR2I         gw_p, gw_n;
-        int              score;
-    };
-
     bool checkDiagonalAlignment( const VECTOR2I& a, const VECTOR2I& b ) const;
+
+    ///< Drop the gateways identical to an earlier one, which can only fit the same way
+    void removeDuplicates();
     void buildDpContinuation( const DP_PRIMITIVE_PAIR& aPair, bool aIsDiagonal );
     void buildEntries( const VECTOR2I& p0_p, const VECTOR2I& p0_n );
 
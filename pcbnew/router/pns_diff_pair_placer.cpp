@@ -389,6 +389,7 @@ const ITEM_SET DIFF_PAIR_PLACER::Traces()
 void DIFF_PAIR_PLACER::FlipPosture()
 {
     m_startDiagonal = !m_startDiagonal;
+    m_fitHint = DP_FIT_HINT();
 
     if( !m_idle )
         Move( m_currentEnd, nullptr );
@@ -628,6 +629,7 @@ void DIFF_PAIR_PLACER::initPlacement()
     m_orthoMode = false;
     m_currentEndItem = nullptr;
     m_startDiagonal = m_initialDiagonal;
+    m_fitHint = DP_FIT_HINT();
 
     NODE* world = Router()->GetWorld();
 
@@ -700,7 +702,8 @@ bool DIFF_PAIR_PLACER::routeHead( const VECTOR2I& aP )
     m_currentTrace.SetGap( gap() );
     m_currentTrace.SetLayer( m_currentLayer );
 
-    bool result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace );
+    bool result = gwsEntry.FitGateways( gwsEntry, gwsTarget, m_startDiagonal, m_currentTrace,
+                                        &m_fitHint );
 
     if( result )
     {
@@ -815,6 +818,7 @@ bool DIFF_PAIR_PLACER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForce
     topo.SimplifyLine( &lineN );
 
     m_prevPair = m_currentTrace.EndingPrimitives();
+    m_fitHint = DP_FIT_HINT();
 
     CommitPlacement();
     m_placingVia = false;
@@ -232,6 +232,9 @@ private:
     DP_PRIMITIVE_PAIR m_start;
     std::optional<DP_PRIMITIVE_PAIR> m_prevPair;
 
+    ///< gateways the head was fitted to on the previous move
+    DP_FIT_HINT m_fitHint;
+
     ///< current algorithm iteration
     int m_iteration;
 
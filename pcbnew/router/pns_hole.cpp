@@ -112,6 +112,7 @@ void HOLE::SetCenter( const VECTOR2I& aCenter )
 {
     assert( m_holeShape->Type() == SH_CIRCLE );
     static_cast<SHAPE_CIRCLE*>( m_holeShape )->SetCenter( aCenter );
+    invalidateHull();
 }
 
 
@@ -119,12 +120,14 @@ void HOLE::SetRadius( int aRadius )
 {
     assert( m_holeShape->Type() == SH_CIRCLE );
     static_cast<SHAPE_CIRCLE*>( m_holeShape )->SetRadius( aRadius );
+    invalidateHull();
 }
 
 
 void HOLE::Move( const VECTOR2I& delta )
 {
     m_holeShape->Move( delta );
+    invalidateHull();
 }
 
 
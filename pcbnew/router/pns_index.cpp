@@ -33,8 +33,21 @@ void INDEX::Add( ITEM* aItem )
     if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
         m_subIndices.resize( 2 * range.End() + 1 ); // +1 handles the 0 case
 
-    for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i].Add( aItem );
+    // An item still marked as removed from the packed trees can't go back to them
+    if( m_bulkLoading && !m_removedPackedItems.count( aItem ) )
+    {
+        BOX2I bbox = aItem->Shape()->BBox();
+
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_subIndices[i].m_packed.Insert( bbox, aItem );
+
+        m_packedItems.insert( aItem );
+    }
+    else
+    {
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_subIndices[i].m_dynamic.Add( aItem );
+    }
 
     m_allItems.insert( aItem );
     NET_HANDLE net = aItem->Net();
@@ -52,14 +65,64 @@ void INDEX::Remove( ITEM* aItem )
     if( m_subIndices.size() <= static_cast<size_t>( range.End() ) )
         return;
 
-    for( int i = range.Start(); i <= range.End(); ++i )
-        m_subIndices[i].Remove( aItem );
+    if( isPacked( aItem ) )
+    {
+        m_removedPackedItems.insert( aItem );
+    }
+    else
+    {
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_subIndices[i].m_dynamic.Remove( aItem );
+    }
 
     m_allItems.erase( aItem );
     NET_HANDLE net = aItem->Net();
 
     if( net && m_netMap.find( net ) != m_netMap.end() )
         m_netMap[net].remove( aItem );
+
+    // Removed items still cost their share of each packed tree search
+    if( !m_bulkLoading && m_removedPackedItems.size() > 1024
+            && m_removedPackedItems.size() * 2 > m_packedItems.size() )
+    {
+        repack();
+    }
+}
+
+
+void INDEX::EndBulkLoad()
+{
+    m_bulkLoading = false;
+
+    for( SUBINDEX& sub : m_subIndices )
+        sub.m_packed.Build();
+}
+
+
+void INDEX::repack()
+{
+    for( SUBINDEX& sub : m_subIndices )
+    {
+        sub.m_packed.Clear();
+        sub.m_dynamic.RemoveAll();
+    }
+
+    m_packedItems.clear();
+    m_removedPackedItems.clear();
+
+    for( ITEM* item : m_allItems )
+    {
+        const LAYER_RANGE& range = item->Layers();
+        BOX2I              bbox = item->Shape()->BBox();
+
+        for( int i = range.Start(); i <= range.End(); ++i )
+            m_subIndices[i].m_packed.Insert( bbox, item );
+
+        m_packedItems.insert( item );
+    }
+
+    for( SUBINDEX& sub : m_subIndices )
+        sub.m_packed.Build();
 }
 
 
@@ -28,6 +28,7 @@
 #include <unordered_set>
 
 #include <layer_ids.h>
+#include <geometry/packed_rtree.h>
 #include <geometry/shape_index.h>
 
 #include "pns_item.h"
@@ -41,15 +42,34 @@ namespace PNS {
  * Custom spatial index, holding our board items and allowing for very fast searches. Items
  * are assigned to separate R-Tree subindices depending on their type and spanned layers, reducing
  * overlap and improving search time.
+ *
+ * Each subindex is made of a packed R-Tree, holding the items added between BeginBulkLoad()
+ * and EndBulkLoad() (typically the whole board when the router world is synced), and of a
+ * dynamic R-Tree for the items added afterwards.  Items removed from the packed trees are only
+ * marked as such, until enough of them are to make repacking worth it.
  **/
 class INDEX
 {
 public:
     typedef std::list<ITEM*>            NET_ITEMS_LIST;
     typedef SHAPE_INDEX<ITEM*>          ITEM_SHAPE_INDEX;
+    typedef PACKED_RTREE<ITEM*>         ITEM_PACKED_INDEX;
     typedef std::unordered_set<ITEM*>   ITEM_SET;
 
-    INDEX(){};
+    INDEX() :
+            m_bulkLoading( false )
+    {};
+
+    /**
+     * Queue the items added from now on for the packed trees.  They are not visible to queries
+     * until EndBulkLoad().
+     */
+    void BeginBulkLoad() { m_bulkLoading = true; }
+
+    /**
+     * Pack the items queued since BeginBulkLoad().
+     */
+    void EndBulkLoad();
 
     /**
      * Adds item to the spatial index.
@@ -118,13 +138,30 @@ public:
     ITEM_SET::iterator end() { return m_allItems.end(); }
 
 private:
+    struct SUBINDEX
+    {
+        ITEM_PACKED_INDEX m_packed;
+        ITEM_SHAPE_INDEX  m_dynamic;
+    };
+
     template <class Visitor>
     int querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistance, Visitor& aVisitor ) const;
 
+    bool isPacked( ITEM* aItem ) const
+    {
+        return m_packedItems.count( aItem ) && !m_removedPackedItems.count( aItem );
+    }
+
+    ///< Move all the items to the packed trees
+    void repack();
+
 private:
-    std::deque<ITEM_SHAPE_INDEX>         m_subIndices;
+    std::deque<SUBINDEX>                 m_subIndices;
     std::map<NET_HANDLE, NET_ITEMS_LIST> m_netMap;
     ITEM_SET                             m_allItems;
+    ITEM_SET                             m_packedItems;        ///< removed ones included
+    ITEM_SET                             m_removedPackedItems;
+    bool                                 m_bulkLoading;
 };
 
 
@@ -134,7 +171,31 @@ int INDEX::querySingle( std::size_t aIndex, const SHAPE* aShape, int aMinDistanc
     if( aIndex >= m_subIndices.size() )
         return 0;
 
-    return m_subIndices[aIndex].Query( aShape, aMinDistance, aVisitor);
+    const SUBINDEX& sub = m_subIndices[aIndex];
+    int             total = 0;
+
+    if( !sub.m_packed.empty() )
+    {
+        BOX2I box = aShape->BBox();
+        box.Inflate( aMinDistance );
+
+        bool stopped = false;
+
+        total += sub.m_packed.Search( box,
+                [&]( ITEM* aItem )
+                {
+                    if( !m_removedPackedItems.empty() && m_removedPackedItems.count( aItem ) )
+                        return true;
+
+                    stopped = !aVisitor( aItem );
+                    return !stopped;
+                } );
+
+        if( stopped )
+            return total;
+    }
+
+    return total + sub.m_dynamic.Query( aShape, aMinDistance, aVisitor );
 }
 
 template<class Visitor>
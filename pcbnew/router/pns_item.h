@@ -23,6 +23,7 @@
 #ifndef __PNS_ITEM_H
 #define __PNS_ITEM_H
 
+#include <atomic>
 #include <memory>
 #include <unordered_set>
 #include <math/vector2d.h>
@@ -87,6 +88,90 @@ protected:
     const ITEM_OWNER *m_owner;
 };
 
+/**
+ * The hulls of an item already built, by clearance, walkaround thickness and layer.
+ *
+ * Entries are never modified once added, so the references handed out stay valid until the
+ * cache is cleared, and the concurrent walkarounds can look up and add hulls without a lock
+ * (a hull built by both at once is just added twice).  The cache is cleared when the geometry
+ * of the item changes, which never happens while it is being walked around.
+ */
+class HULL_CACHE
+{
+public:
+    HULL_CACHE() :
+        m_head( nullptr )
+    {}
+
+    HULL_CACHE( const HULL_CACHE& ) :
+        m_head( nullptr )
+    {}
+
+    HULL_CACHE& operator=( const HULL_CACHE& )
+    {
+        Clear();
+        return *this;
+    }
+
+    ~HULL_CACHE()
+    {
+        Clear();
+    }
+
+    /**
+     * @return the hull for the given parameters, built with \a aBuild if it isn't cached yet.
+     */
+    template <typename BUILDER>
+    const SHAPE_LINE_CHAIN& Get( int aClearance, int aWalkaroundThickness, int aLayer,
+                                 BUILDER aBuild )
+    {
+        ENTRY* head = m_head.load( std::memory_order_acquire );
+
+        for( ENTRY* entry = head; entry; entry = entry->m_next )
+        {
+            if( entry->m_clearance == aClearance
+                    && entry->m_walkaroundThickness == aWalkaroundThickness
+                    && entry->m_layer == aLayer )
+            {
+                return entry->m_hull;
+            }
+        }
+
+        ENTRY* entry = new ENTRY{ aClearance, aWalkaroundThickness, aLayer, aBuild(), head };
+
+        while( !m_head.compare_exchange_weak( entry->m_next, entry, std::memory_order_release,
+                                              std::memory_order_acquire ) )
+        {
+        }
+
+        return entry->m_hull;
+    }
+
+    void Clear()
+    {
+        ENTRY* entry = m_head.exchange( nullptr );
+
+        while( entry )
+        {
+            ENTRY* next = entry->m_next;
+            delete entry;
+            entry = next;
+        }
+    }
+
+private:
+    struct ENTRY
+    {
+        int              m_clearance;
+        int              m_walkaroundThickness;
+        int              m_layer;
+        SHAPE_LINE_CHAIN m_hull;
+        ENTRY*           m_next;
+    };
+
+    std::atomic<ENTRY*> m_head;
+};
+
 /**
  * Base class for PNS router board items.
  *
@@ -160,6 +245,21 @@ public:
         return SHAPE_LINE_CHAIN();
     }
 
+    /**
+     * Return the same hull as Hull(), built once and then kept with the item until its geometry
+     * changes.  Walkaround and obstacle searches ask for the hulls of the same items many times
+     * over, this saves both rebuilding and copying them.
+     */
+    const SHAPE_LINE_CHAIN& CachedHull( int aClearance = 0, int aWalkaroundThickness = 0,
+                                        int aLayer = -1 ) const
+    {
+        return m_hullCache.Get( aClearance, aWalkaroundThickness, aLayer,
+                                [&]()
+                                {
+                                    return Hull( aClearance, aWalkaroundThickness, aLayer );
+                                } );
+    }
+
     /**
      * Return the type (kind) of the item.
      */
@@ -281,6 +381,11 @@ private:
                         COLLISION_SEARCH_CONTEXT* aCtx ) const;
 
 protected:
+    /**
+     * Drop the cached hulls, to be called by every method changing the geometry of the item.
+     */
+    void invalidateHull() { m_hullCache.Clear(); }
+
     PnsKind       m_kind;
 
     BOARD_ITEM*   m_parent;
@@ -294,6 +399,8 @@ protected:
     bool          m_isVirtual;
     bool          m_isFreePad;
     bool          m_isCompoundShapePrimitive;
+
+    mutable HULL_CACHE m_hullCache;
 };
 
 template<typename T, typename S>
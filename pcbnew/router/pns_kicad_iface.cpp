@@ -54,6 +54,7 @@
 #include <wx/log.h>
 
 #include <memory>
+#include <mutex>
 
 #include <advanced_config.h>
 #include <pcbnew_settings.h>
@@ -152,6 +153,10 @@ private:
 
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_clearanceCache;
     std::unordered_map<CLEARANCE_CACHE_KEY, int> m_tempClearanceCache;
+
+    /// Guards the caches and the dummy items, as walkaround directions are searched
+    /// concurrently
+    std::recursive_mutex m_mutex;
 };
 
 
@@ -224,6 +229,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::IsNetTieExclusion( const PNS::ITEM* aItem,
 bool PNS_PCBNEW_RULE_RESOLVER::IsKeepout( const PNS::ITEM* aObstacle, const PNS::ITEM* aItem,
                                           bool* aEnforce )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     auto checkKeepout =
             []( const ZONE* aKeepout, const BOARD_ITEM* aOther )
             {
@@ -372,6 +379,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
                                                 const PNS::ITEM* aItemA, const PNS::ITEM* aItemB,
                                                 int aLayer, PNS::CONSTRAINT* aConstraint )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
 
     if( !drcEngine )
@@ -448,6 +457,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>& aItems )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     int n_pruned = 0;
     std::set<const PNS::ITEM*> remainingItems( aItems.begin(), aItems.end() );
 
@@ -475,6 +486,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCacheForItems( std::vector<const PNS::ITEM*>
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     m_clearanceCache.clear();
     m_tempClearanceCache.clear();
 }
@@ -482,6 +495,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearCaches()
 
 void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     m_tempClearanceCache.clear();
 }
 
@@ -489,6 +504,8 @@ void PNS_PCBNEW_RULE_RESOLVER::ClearTemporaryCaches()
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB,
                                          bool aUseClearanceEpsilon )
 {
+    std::lock_guard<std::recursive_mutex> lock( m_mutex );
+
     CLEARANCE_CACHE_KEY key = { aA, aB, aUseClearanceEpsilon };
 
     // Search cache (used for actual board items)
@@ -1041,6 +1058,8 @@ PNS_KICAD_IFACE_BASE::PNS_KICAD_IFACE_BASE()
     m_world = nullptr;
     m_debugDecorator = nullptr;
     m_startLayer = -1;
+    m_worstClearance = 0;
+    m_worldStale = false;
 }
 
 
@@ -1513,29 +1532,136 @@ bool PNS_KICAD_IFACE::IsItemVisible( const PNS::ITEM* aItem ) const
 }
 
 
-void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
+void PNS_KICAD_IFACE_BASE::syncFootprint( PNS::NODE* aWorld, FOOTPRINT* aFootprint,
+                                          SHAPE_POLY_SET* aBoardOutline )
 {
-    if( !m_board )
+    std::vector<const BOARD_ITEM*>& children = m_footprintChildren[aFootprint];
+
+    children.clear();
+
+    for( PAD* pad : aFootprint->Pads() )
     {
-        wxLogTrace( wxT( "PNS" ), wxT( "No board attached, aborting sync." ) );
-        return;
+        if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
+            aWorld->Add( std::move( solid ) );
+
+        m_worstClearance = std::max( m_worstClearance, pad->GetLocalClearance() );
+
+        if( pad->GetProperty() == PAD_PROP::CASTELLATED )
+        {
+            std::unique_ptr<SHAPE> hole;
+            hole.reset( pad->GetEffectiveHoleShape()->Clone() );
+            aWorld->AddEdgeExclusion( std::move( hole ) );
+        }
+
+        children.push_back( pad );
     }
 
-    int worstClearance = m_board->GetMaxClearanceValue();
+    syncTextItem( aWorld, &aFootprint->Reference(), aFootprint->Reference().GetLayer() );
+    syncTextItem( aWorld, &aFootprint->Value(), aFootprint->Value().GetLayer() );
 
-    m_world = aWorld;
+    for( ZONE* zone : aFootprint->Zones() )
+    {
+        syncZone( aWorld, zone, aBoardOutline );
+        children.push_back( zone );
+    }
 
-    for( BOARD_ITEM* gitem : m_board->Drawings() )
+    for( PCB_FIELD* field : aFootprint->Fields() )
+    {
+        syncTextItem( aWorld, static_cast<PCB_TEXT*>( field ), field->GetLayer() );
+        children.push_back( field );
+    }
+
+    for( BOARD_ITEM* item : aFootprint->GraphicalItems() )
     {
-        if ( gitem->Type() == PCB_SHAPE_T || gitem->Type() == PCB_TEXTBOX_T )
+        if( item->Type() == PCB_SHAPE_T || item->Type() == PCB_TEXTBOX_T )
         {
-            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( gitem ) );
+            syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
         }
-        else if( gitem->Type() == PCB_TEXT_T )
+        else if( item->Type() == PCB_TEXT_T )
         {
-            syncTextItem( aWorld, static_cast<PCB_TEXT*>( gitem ), gitem->GetLayer() );
+            syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
         }
+
+        children.push_back( item );
     }
+}
+
+
+void PNS_KICAD_IFACE_BASE::syncItem( PNS::NODE* aWorld, BOARD_ITEM* aItem,
+                                     SHAPE_POLY_SET* aBoardOutline )
+{
+    switch( aItem->Type() )
+    {
+    case PCB_SHAPE_T:
+    case PCB_TEXTBOX_T:
+        syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( aItem ) );
+        break;
+
+    case PCB_TEXT_T:
+    case PCB_FIELD_T:
+        syncTextItem( aWorld, static_cast<PCB_TEXT*>( aItem ), aItem->GetLayer() );
+        break;
+
+    case PCB_ZONE_T:
+        syncZone( aWorld, static_cast<ZONE*>( aItem ), aBoardOutline );
+        break;
+
+    case PCB_PAD_T:
+        if( std::unique_ptr<PNS::SOLID> solid = syncPad( static_cast<PAD*>( aItem ) ) )
+            aWorld->Add( std::move( solid ) );
+
+        m_worstClearance = std::max( m_worstClearance,
+                                     static_cast<PAD*>( aItem )->GetLocalClearance() );
+        break;
+
+    case PCB_FOOTPRINT_T:
+        syncFootprint( aWorld, static_cast<FOOTPRINT*>( aItem ), aBoardOutline );
+        break;
+
+    case PCB_TRACE_T:
+        if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( static_cast<PCB_TRACK*>( aItem ) ) )
+            aWorld->Add( std::move( segment ) );
+
+        break;
+
+    case PCB_ARC_T:
+        if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( aItem ) ) )
+            aWorld->Add( std::move( arc ) );
+
+        break;
+
+    case PCB_VIA_T:
+        if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( aItem ) ) )
+            aWorld->Add( std::move( via ) );
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
+{
+    if( !m_board )
+    {
+        wxLogTrace( wxT( "PNS" ), wxT( "No board attached, aborting sync." ) );
+        return;
+    }
+
+    m_worstClearance = m_board->GetMaxClearanceValue();
+
+    m_world = aWorld;
+    m_footprintChildren.clear();
+    m_staleParents.clear();
+    m_itemsToSync.clear();
+    m_worldStale = false;
+
+    aWorld->BeginBulkLoad();
+
+    for( BOARD_ITEM* gitem : m_board->Drawings() )
+        syncItem( aWorld, gitem, nullptr );
 
     SHAPE_POLY_SET  buffer;
     SHAPE_POLY_SET* boardOutline = nullptr;
@@ -1544,77 +1670,176 @@ void PNS_KICAD_IFACE_BASE::SyncWorld( PNS::NODE *aWorld )
         boardOutline = &buffer;
 
     for( ZONE* zone : m_board->Zones() )
-    {
         syncZone( aWorld, zone, boardOutline );
-    }
 
     for( FOOTPRINT* footprint : m_board->Footprints() )
+        syncFootprint( aWorld, footprint, boardOutline );
+
+    for( PCB_TRACK* t : m_board->Tracks() )
+        syncItem( aWorld, t, nullptr );
+
+    aWorld->EndBulkLoad();
+
+    // NB: if this were ever to become a long-lived object we would need to dirty its
+    // clearance cache here....
+    delete m_ruleResolver;
+    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
+
+    aWorld->SetRuleResolver( m_ruleResolver );
+    aWorld->SetMaxClearance( m_worstClearance + m_ruleResolver->ClearanceEpsilon() );
+}
+
+
+bool PNS_KICAD_IFACE_BASE::UpdateWorld( PNS::NODE* aWorld )
+{
+    if( !m_board || !m_ruleResolver || aWorld != m_world || m_worldStale )
+        return false;
+
+    if( m_staleParents.empty() && m_itemsToSync.empty() )
+        return true;
+
+    // Past this point, re-creating the items one by one costs more than bulk loading them
+    if( m_staleParents.size() > 10000 )
+        return false;
+
+    for( PNS::ITEM* item : aWorld->FindItemsByParents( m_staleParents ) )
+        aWorld->Remove( item );
+
+    for( const BOARD_ITEM* item : m_staleParents )
+        m_footprintChildren.erase( item );
+
+    SHAPE_POLY_SET  buffer;
+    SHAPE_POLY_SET* boardOutline = nullptr;
+    bool            outlineValid = false;
+
+    for( BOARD_ITEM* item : m_itemsToSync )
     {
-        for( PAD* pad : footprint->Pads() )
+        // Only zones need the (costly) board outline
+        if( !outlineValid && ( item->Type() == PCB_ZONE_T || item->Type() == PCB_FOOTPRINT_T ) )
         {
-            if( std::unique_ptr<PNS::SOLID> solid = syncPad( pad ) )
-                aWorld->Add( std::move( solid ) );
-
-            worstClearance = std::max( worstClearance, pad->GetLocalClearance() );
+            if( m_board->GetBoardPolygonOutlines( buffer ) )
+                boardOutline = &buffer;
 
-            if( pad->GetProperty() == PAD_PROP::CASTELLATED )
-            {
-                std::unique_ptr<SHAPE> hole;
-                hole.reset( pad->GetEffectiveHoleShape()->Clone() );
-                aWorld->AddEdgeExclusion( std::move( hole ) );
-            }
+            outlineValid = true;
         }
 
-        syncTextItem( aWorld, &footprint->Reference(), footprint->Reference().GetLayer() );
-        syncTextItem( aWorld, &footprint->Value(), footprint->Value().GetLayer() );
+        syncItem( aWorld, item, boardOutline );
+    }
 
-        for( ZONE* zone : footprint->Zones() )
-            syncZone( aWorld, zone, boardOutline );
+    m_staleParents.clear();
+    m_itemsToSync.clear();
 
-        for( PCB_FIELD* field : footprint->Fields() )
-            syncTextItem( aWorld, static_cast<PCB_TEXT*>( field ), field->GetLayer() );
+    m_worstClearance = std::max( m_worstClearance, m_board->GetMaxClearanceValue() );
 
-        for( BOARD_ITEM* item : footprint->GraphicalItems() )
-        {
-            if( item->Type() == PCB_SHAPE_T || item->Type() == PCB_TEXTBOX_T )
-            {
-                syncGraphicalItem( aWorld, static_cast<PCB_SHAPE*>( item ) );
-            }
-            else if( item->Type() == PCB_TEXT_T )
+    m_ruleResolver->ClearCaches();
+    aWorld->SetMaxClearance( m_worstClearance + m_ruleResolver->ClearanceEpsilon() );
+
+    return true;
+}
+
+
+void PNS_KICAD_IFACE_BASE::markBoardItemChanged( BOARD_ITEM* aItem, bool aRemoved )
+{
+    if( !m_world || m_worldStale )
+        return;
+
+    // Changes to the board outline affect the zones, and edge exclusions can't be removed
+    auto isGlobal =
+            [&]( BOARD_ITEM* aCandidate )
             {
-                syncTextItem( aWorld, static_cast<PCB_TEXT*>( item ), item->GetLayer() );
-            }
-        }
+                if( aCandidate->IsOnLayer( Edge_Cuts ) )
+                    return true;
+
+                if( aCandidate->Type() == PCB_PAD_T )
+                    return static_cast<PAD*>( aCandidate )->GetProperty() == PAD_PROP::CASTELLATED;
+
+                return false;
+            };
+
+    if( isGlobal( aItem ) )
+    {
+        m_worldStale = true;
+        return;
     }
 
-    for( PCB_TRACK* t : m_board->Tracks() )
+    if( aItem->Type() == PCB_FOOTPRINT_T )
     {
-        KICAD_T type = t->Type();
+        FOOTPRINT* footprint = static_cast<FOOTPRINT*>( aItem );
+        bool       global = false;
 
-        if( type == PCB_TRACE_T )
-        {
-            if( std::unique_ptr<PNS::SEGMENT> segment = syncTrack( t ) )
-                aWorld->Add( std::move( segment ) );
-        }
-        else if( type == PCB_ARC_T )
-        {
-            if( std::unique_ptr<PNS::ARC> arc = syncArc( static_cast<PCB_ARC*>( t ) ) )
-                aWorld->Add( std::move( arc ) );
-        }
-        else if( type == PCB_VIA_T )
+        footprint->RunOnChildren(
+                [&]( BOARD_ITEM* aChild )
+                {
+                    global |= isGlobal( aChild );
+                } );
+
+        if( global )
         {
-            if( std::unique_ptr<PNS::VIA> via = syncVia( static_cast<PCB_VIA*>( t ) ) )
-                aWorld->Add( std::move( via ) );
+            m_worldStale = true;
+            return;
         }
+
+        // The children the footprint had when it was synced may be gone by now
+        auto it = m_footprintChildren.find( aItem );
+
+        if( it != m_footprintChildren.end() )
+            m_staleParents.insert( it->second.begin(), it->second.end() );
     }
 
-    // NB: if this were ever to become a long-lived object we would need to dirty its
-    // clearance cache here....
-    delete m_ruleResolver;
-    m_ruleResolver = new PNS_PCBNEW_RULE_RESOLVER( m_board, this );
+    m_staleParents.insert( aItem );
 
-    aWorld->SetRuleResolver( m_ruleResolver );
-    aWorld->SetMaxClearance( worstClearance + m_ruleResolver->ClearanceEpsilon() );
+    if( aRemoved )
+        m_itemsToSync.erase( aItem );
+    else
+        m_itemsToSync.insert( aItem );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    markBoardItemChanged( aBoardItem, false );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsAdded( BOARD& aBoard,
+                                              std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        markBoardItemChanged( item, false );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    markBoardItemChanged( aBoardItem, true );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsRemoved( BOARD& aBoard,
+                                                std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        markBoardItemChanged( item, true );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem )
+{
+    markBoardItemChanged( aBoardItem, false );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardItemsChanged( BOARD& aBoard,
+                                                std::vector<BOARD_ITEM*>& aBoardItems )
+{
+    for( BOARD_ITEM* item : aBoardItems )
+        markBoardItemChanged( item, false );
+}
+
+
+void PNS_KICAD_IFACE_BASE::OnBoardNetSettingsChanged( BOARD& aBoard )
+{
+    m_worldStale = true;
 }
 
 
@@ -1803,7 +2028,7 @@ void PNS_KICAD_IFACE_BASE::UpdateItem( PNS::ITEM* aItem )
 }
 
 
-void PNS_KICAD_IFACE::modifyBoardItem( PNS::ITEM* aItem )
+void PNS_KICAD_IFACE_BASE::modifyBoardItem( PNS::ITEM* aItem )
 {
     BOARD_ITEM* board_item = aItem->Parent();
 
@@ -1875,7 +2100,7 @@ void PNS_KICAD_IFACE_BASE::AddItem( PNS::ITEM* aItem )
 }
 
 
-BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE::createBoardItem( PNS::ITEM* aItem )
+BOARD_CONNECTED_ITEM* PNS_KICAD_IFACE_BASE::createBoardItem( PNS::ITEM* aItem )
 {
     BOARD_CONNECTED_ITEM* newBI = nullptr;
     auto net = static_cast<NETINFO_ITEM*>( aItem->Net() );
@@ -22,8 +22,11 @@
 #ifndef __PNS_KICAD_IFACE_H
 #define __PNS_KICAD_IFACE_H
 
+#include <unordered_map>
 #include <unordered_set>
 
+#include <board.h>
+
 #include "pns_router.h"
 
 class PNS_PCBNEW_RULE_RESOLVER;
@@ -48,7 +51,11 @@ namespace KIGFX
     class VIEW;
 }
 
-class PNS_KICAD_IFACE_BASE : public PNS::ROUTER_IFACE
+/**
+ * Once registered as a listener of its board, the interface records the changes made to the
+ * board after SyncWorld(), so that UpdateWorld() can apply them to the world.
+ */
+class PNS_KICAD_IFACE_BASE : public PNS::ROUTER_IFACE, public BOARD_LISTENER
 {
 public:
     PNS_KICAD_IFACE_BASE();
@@ -57,6 +64,7 @@ public:
     void EraseView() override {};
     void SetBoard( BOARD* aBoard );
     void SyncWorld( PNS::NODE* aWorld ) override;
+    bool UpdateWorld( PNS::NODE* aWorld ) override;
     bool IsAnyLayerVisible( const LAYER_RANGE& aLayer ) const override { return true; };
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, int aLayer ) const override;
     bool IsFlashedOnLayer( const PNS::ITEM* aItem, const LAYER_RANGE& aLayer ) const override;
@@ -92,6 +100,14 @@ public:
     PNS::RULE_RESOLVER* GetRuleResolver() override;
     PNS::DEBUG_DECORATOR* GetDebugDecorator() override;
 
+    void OnBoardItemAdded( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsAdded( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemRemoved( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsRemoved( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardItemChanged( BOARD& aBoard, BOARD_ITEM* aBoardItem ) override;
+    void OnBoardItemsChanged( BOARD& aBoard, std::vector<BOARD_ITEM*>& aBoardItems ) override;
+    void OnBoardNetSettingsChanged( BOARD& aBoard ) override;
+
 protected:
     PNS_PCBNEW_RULE_RESOLVER* m_ruleResolver;
     PNS::DEBUG_DECORATOR* m_debugDecorator;
@@ -103,12 +119,36 @@ protected:
     bool syncTextItem( PNS::NODE* aWorld, PCB_TEXT* aText, PCB_LAYER_ID aLayer );
     bool syncGraphicalItem( PNS::NODE* aWorld, PCB_SHAPE* aItem );
     bool syncZone( PNS::NODE* aWorld, ZONE* aZone, SHAPE_POLY_SET* aBoardOutline );
+    void syncFootprint( PNS::NODE* aWorld, FOOTPRINT* aFootprint, SHAPE_POLY_SET* aBoardOutline );
+    void syncItem( PNS::NODE* aWorld, BOARD_ITEM* aItem, SHAPE_POLY_SET* aBoardOutline );
     bool inheritTrackWidth( PNS::ITEM* aItem, int* aInheritedWidth );
 
+    ///< Record a change to \a aItem for the next UpdateWorld()
+    void markBoardItemChanged( BOARD_ITEM* aItem, bool aRemoved );
+
+    BOARD_CONNECTED_ITEM* createBoardItem( PNS::ITEM* aItem );
+    void                  modifyBoardItem( PNS::ITEM* aItem );
+
+    struct OFFSET
+    {
+        VECTOR2I p_old, p_new;
+    };
+
 protected:
     PNS::NODE* m_world;
     BOARD*     m_board;
     int        m_startLayer;
+    int        m_worstClearance;
+
+    ///< The children each footprint had when it was last synced, as they may be gone by the
+    ///< time the footprint is synced again
+    std::unordered_map<const BOARD_ITEM*, std::vector<const BOARD_ITEM*>> m_footprintChildren;
+
+    std::unordered_set<const BOARD_ITEM*> m_staleParents;  ///< items to remove from the world
+    std::unordered_set<BOARD_ITEM*>       m_itemsToSync;   ///< items to add (back) to the world
+    bool                                  m_worldStale;    ///< changes need a full sync
+
+    std::map<PAD*, OFFSET>                m_fpOffsets;
 };
 
 class PNS_KICAD_IFACE : public PNS_KICAD_IFACE_BASE
@@ -142,15 +182,6 @@ public:
     void SetCommitFlags( int aCommitFlags ) { m_commitFlags = aCommitFlags; }
 
 protected:
-    BOARD_CONNECTED_ITEM* createBoardItem( PNS::ITEM* aItem );
-    void                  modifyBoardItem( PNS::ITEM* aItem );
-
-    struct OFFSET
-    {
-        VECTOR2I p_old, p_new;
-    };
-
-    std::map<PAD*, OFFSET>          m_fpOffsets;
     KIGFX::VIEW*                    m_view;
     KIGFX::VIEW_GROUP*              m_previewItems;
     std::unordered_set<BOARD_ITEM*> m_hiddenItems;
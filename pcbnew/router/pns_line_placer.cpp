@@ -807,9 +807,10 @@ bool LINE_PLACER::rhMarkObstacles( const VECTOR2I& aP, LINE& aNewHead, LINE& aNe
     // the shove/walk mode that certain users find too intrusive.
     if( obs )
     {
-        int              clearance = m_currentNode->GetClearance( obs->m_item, &m_head, false );
-        SHAPE_LINE_CHAIN hull = obs->m_item->Hull( clearance, m_head.Width() );
-        VECTOR2I         nearest;
+        int                     clearance = m_currentNode->GetClearance( obs->m_item, &m_head,
+                                                                         false );
+        const SHAPE_LINE_CHAIN& hull = obs->m_item->CachedHull( clearance, m_head.Width() );
+        VECTOR2I                nearest;
 
         DIRECTION_45::CORNER_MODE cornerMode = Settings().GetCornerMode();
 
@@ -559,33 +559,64 @@ bool MEANDER_SHAPE::Fit( MEANDER_TYPE aType, const SEG& aSeg, const VECTOR2I& aP
 
     int minAmpl = MinAmplitude();
     int maxAmpl = std::max( st.m_maxAmplitude, minAmpl );
+    int step = std::max( st.m_step, 1 );
 
-    for( int ampl = maxAmpl; ampl >= minAmpl; ampl -= st.m_step )
-    {
-        m_amplitude = ampl;
+    auto fits =
+            [&]( int aAmpl )
+            {
+                m_amplitude = aAmpl;
 
-        if( m_dual )
-        {
-            m_shapes[0] = genMeanderShape( aP, aSeg.B - aSeg.A, aSide, aType, m_baselineOffset );
-            m_shapes[1] = genMeanderShape( aP, aSeg.B - aSeg.A, aSide, aType, -m_baselineOffset );
-        }
-        else
-        {
-            m_shapes[0] = genMeanderShape( aP, aSeg.B - aSeg.A, aSide, aType, 0 );
-        }
+                if( m_dual )
+                {
+                    m_shapes[0] = genMeanderShape( aP, aSeg.B - aSeg.A, aSide, aType,
+                                                   m_baselineOffset );
+                    m_shapes[1] = genMeanderShape( aP, aSeg.B - aSeg.A, aSide, aType,
+                                                   -m_baselineOffset );
+                }
+                else
+                {
+                    m_shapes[0] = genMeanderShape( aP, aSeg.B - aSeg.A, aSide, aType, 0 );
+                }
 
-        m_type = aType;
-        m_baseSeg = aSeg;
-        m_p0 = aP;
-        m_side = aSide;
+                m_type = aType;
+                m_baseSeg = aSeg;
+                m_p0 = aP;
+                m_side = aSide;
 
-        updateBaseSegment();
+                updateBaseSegment();
 
-        if( m_placer->CheckFit( this ) )
-            return true;
+                return m_placer->CheckFit( this );
+            };
+
+    // The amplitudes tried are the steps down from the maximum one.  A meander covers the lower
+    // ones, so when the highest doesn't fit, bisect for the highest which does rather than
+    // checking the collisions of each step.
+    if( fits( maxAmpl ) )
+        return true;
+
+    int lastStep = ( maxAmpl - minAmpl ) / step;
+
+    if( lastStep == 0 || !fits( maxAmpl - lastStep * step ) )
+        return false;
+
+    int failing = 0;
+    int fitting = lastStep;
+
+    while( fitting - failing > 1 )
+    {
+        int mid = ( failing + fitting ) / 2;
+
+        if( fits( maxAmpl - mid * step ) )
+            fitting = mid;
+        else
+            failing = mid;
     }
 
-    return false;
+    // Leave the shape with the amplitude which fits
+    if( m_amplitude != maxAmpl - fitting * step )
+        fits( maxAmpl - fitting * step );
+
+    return true;
 }
 
 
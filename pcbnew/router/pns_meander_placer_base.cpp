@@ -19,6 +19,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
+#include <math/util.h>
+
 #include "pns_meander_placer_base.h"
 #include "pns_meander.h"
 #include "pns_router.h"
@@ -87,69 +91,74 @@ void MEANDER_PLACER_BASE::UpdateSettings( const MEANDER_SETTINGS& aSettings )
 }
 
 
-int findAmplitudeBinarySearch( MEANDER_SHAPE& aCopy, int targetLength, int minAmp, int maxAmp )
+/**
+ * Find the amplitude in [\a minAmp, \a maxAmp] at which \a m is \a targetLength long.
+ *
+ * The length of a meander grows linearly with its amplitude (each side adds its height), so the
+ * amplitude is interpolated between the ones bracketing the target length.  The rounding of the
+ * corners bends the line a little, so an interpolation which doesn't halve the bracket is
+ * followed by a bisection.
+ */
+int findAmplitudeForLength( MEANDER_SHAPE* m, long long int targetLength, int minAmp, int maxAmp )
 {
-    if( minAmp == maxAmp )
-        return maxAmp;
-
-    aCopy.Resize( minAmp );
-    int minLen = aCopy.CurrentLength();
+    MEANDER_SHAPE copy = *m;
 
-    aCopy.Resize( maxAmp );
-    int maxLen = aCopy.CurrentLength();
+    // Try to keep the same baseline length
+    copy.SetTargetBaselineLength( m->BaselineLength() );
 
-    if( minLen > targetLength )
-        return 0;
+    auto lengthAt =
+            [&]( int aAmpl )
+            {
+                copy.Resize( aAmpl );
+                return copy.CurrentLength();
+            };
 
-    if( maxLen < targetLength )
-        return 0;
+    int           lo = minAmp;
+    int           hi = maxAmp;
+    long long int loLen = lengthAt( lo );
 
-    int minError = minLen - targetLength;
-    int maxError = maxLen - targetLength;
+    if( loLen >= targetLength || lo >= hi )
+        return lo;
 
-    if( std::abs( minError ) < LENGTH_TARGET_TOLERANCE
-        || std::abs( maxError ) < LENGTH_TARGET_TOLERANCE )
-    {
-        return std::abs( minError ) < std::abs( maxError ) ? minAmp : maxAmp;
-    }
-    else
-    {
-        int left =
-                findAmplitudeBinarySearch( aCopy, targetLength, minAmp, ( minAmp + maxAmp ) / 2 );
+    long long int hiLen = lengthAt( hi );
 
-        if( left )
-            return left;
+    if( hiLen <= targetLength )
+        return hi;
 
-        int right =
-                findAmplitudeBinarySearch( aCopy, targetLength, ( minAmp + maxAmp ) / 2, maxAmp );
+    bool bisect = false;
 
-        if( right )
-            return right;
-    }
-
-    return 0;
-}
+    while( hi - lo > 1 )
+    {
+        int ampl;
 
+        if( bisect )
+            ampl = lo + ( hi - lo ) / 2;
+        else
+            ampl = lo + KiROUND( (double) ( targetLength - loLen ) * ( hi - lo ) / ( hiLen - loLen ) );
 
-int findAmplitudeForLength( MEANDER_SHAPE* m, int targetLength, int minAmp, int maxAmp )
-{
-    MEANDER_SHAPE copy = *m;
+        ampl = std::clamp( ampl, lo + 1, hi - 1 );
 
-    // Try to keep the same baseline length
-    copy.SetTargetBaselineLength( m->BaselineLength() );
+        long long int len = lengthAt( ampl );
+        int           prevSpan = hi - lo;
 
-    long long initialGuess = m->Amplitude() - ( m->CurrentLength() - targetLength ) / 2;
+        if( std::abs( len - targetLength ) < LENGTH_TARGET_TOLERANCE )
+            return ampl;
 
-    if( initialGuess >= minAmp && initialGuess <= maxAmp )
-    {
-        copy.Resize( minAmp );
+        if( len < targetLength )
+        {
+            lo = ampl;
+            loLen = len;
+        }
+        else
+        {
+            hi = ampl;
+            hiLen = len;
+        }
 
-        if( std::abs( copy.CurrentLength() - targetLength ) < LENGTH_TARGET_TOLERANCE )
-            return initialGuess;
+        bisect = !bisect && ( hi - lo ) * 2 > prevSpan;
     }
 
-    // The length is non-trivial, use binary search
-    return findAmplitudeBinarySearch( copy, targetLength, minAmp, maxAmp );
+    return std::abs( loLen - targetLength ) <= std::abs( hiLen - targetLength ) ? lo : hi;
 }
 
 
@@ -235,9 +244,6 @@ void MEANDER_PLACER_BASE::tuneLineLength( MEANDERED_LINE& aTuned, long long int
             int amp = findAmplitudeForLength( m, initialLen - lenReductionHere, minAmpl,
                                               m->Amplitude() );
 
-            if( amp < minAmpl )
-                amp = minAmpl;
-
             m->SetTargetBaselineLength( m->BaselineLength() );
             m->Resize( amp );
 
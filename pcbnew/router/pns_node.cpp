@@ -45,6 +45,8 @@
 #include "pns_router.h"
 #include "pns_utils.h"
 
+#include <hash.h>
+
 
 namespace PNS {
 
@@ -140,10 +142,16 @@ int NODE::GetClearance( const ITEM* aA, const ITEM* aB, bool aUseClearanceEpsilo
 }
 
 
+PROF_COUNTER NODE::s_branchCount( "branches" );
+PROF_COUNTER NODE::s_collisionQueryCount( "collision queries" );
+
+
 NODE* NODE::Branch()
 {
     NODE* child = new NODE;
 
+    s_branchCount++;
+
     m_children.insert( child );
 
     child->m_depth = m_depth + 1;
@@ -258,25 +266,146 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles,
     if( aItem->IsVirtual() )
         return 0;
 
+    s_collisionQueryCount++;
+
     DEFAULT_OBSTACLE_VISITOR visitor( &ctx, aItem );
 
 #ifdef DEBUG
     assert( allocNodes.find( this ) != allocNodes.end() );
 #endif
 
-    visitor.SetWorld( this, nullptr );
-
     // first, look for colliding items in the local index
-    m_index->Query( aItem, m_maxClearance, visitor );
+    if( !isRoot() )
+    {
+        visitor.SetWorld( this, nullptr );
+        m_index->Query( aItem, m_maxClearance, visitor );
+    }
 
     // if we haven't found enough items, look in the root branch as well.
-    if( !isRoot() && ( ctx.obstacles.size() < aOpts.m_limitCount || aOpts.m_limitCount < 0 ) )
+    if( isRoot() || ctx.obstacles.size() < aOpts.m_limitCount || aOpts.m_limitCount < 0 )
+        queryRoot( aItem, visitor, ctx );
+
+    return aObstacles.size();
+}
+
+
+bool NODE::QUERY_CACHE_KEY::operator==( const QUERY_CACHE_KEY& aOther ) const
+{
+    return m_a == aOther.m_a && m_b == aOther.m_b && m_width == aOther.m_width
+           && m_net == aOther.m_net && m_layerStart == aOther.m_layerStart
+           && m_layerEnd == aOther.m_layerEnd && m_parent == aOther.m_parent
+           && m_maxClearance == aOther.m_maxClearance
+           && m_kindMask == aOther.m_kindMask
+           && m_overrideClearance == aOther.m_overrideClearance
+           && m_differentNetsOnly == aOther.m_differentNetsOnly
+           && m_useClearanceEpsilon == aOther.m_useClearanceEpsilon;
+}
+
+
+std::size_t NODE::QUERY_CACHE_KEY_HASH::operator()( const QUERY_CACHE_KEY& aKey ) const
+{
+    return hash_val( aKey.m_a.x, aKey.m_a.y, aKey.m_b.x, aKey.m_b.y, aKey.m_width, aKey.m_net,
+                     aKey.m_layerStart, aKey.m_layerEnd, aKey.m_parent, aKey.m_kindMask );
+}
+
+
+void NODE::queryRoot( const ITEM* aItem, DEFAULT_OBSTACLE_VISITOR& aVisitor,
+                      COLLISION_SEARCH_CONTEXT& aCtx ) const
+{
+    const NODE* overrides = isRoot() ? nullptr : this;
+
+    // Shoving and walking around query the same segments against the root over and over, from
+    // one branch to the next.  Only complete searches for items which aren't part of the root
+    // can be reused.
+    if( aItem->Kind() != ITEM::SEGMENT_T || aItem->BelongsTo( m_root )
+            || aCtx.options.m_limitCount >= 0 || aCtx.options.m_restrictedSet )
     {
-        visitor.SetWorld( m_root, this );
-        m_root->m_index->Query( aItem, m_maxClearance, visitor );
+        aVisitor.SetWorld( m_root, overrides );
+        m_root->m_index->Query( aItem, m_maxClearance, aVisitor );
+        return;
     }
 
-    return aObstacles.size();
+    const SEGMENT*  seg = static_cast<const SEGMENT*>( aItem );
+    QUERY_CACHE_KEY key = { seg->Seg().A,
+                            seg->Seg().B,
+                            seg->Width(),
+                            seg->Net(),
+                            seg->Layers().Start(),
+                            seg->Layers().End(),
+                            seg->Parent(),
+                            m_maxClearance,
+                            aCtx.options.m_kindMask,
+                            aCtx.options.m_overrideClearance,
+                            aCtx.options.m_differentNetsOnly,
+                            aCtx.options.m_useClearanceEpsilon };
+
+    std::vector<OBSTACLE> found;
+    bool                  cached = false;
+
+    {
+        std::lock_guard<std::mutex> lock( m_root->m_queryCacheMutex );
+        auto                        it = m_root->m_queryCache.find( key );
+
+        if( it != m_root->m_queryCache.end() )
+        {
+            found = it->second;
+            cached = true;
+        }
+    }
+
+    if( !cached )
+    {
+        // Search without the overrides of this branch, so that the result holds for all of them
+        OBSTACLES                rootObstacles;
+        COLLISION_SEARCH_CONTEXT rootCtx( rootObstacles, aCtx.options );
+        DEFAULT_OBSTACLE_VISITOR rootVisitor( &rootCtx, aItem );
+
+        rootVisitor.SetWorld( m_root, nullptr );
+        m_root->m_index->Query( aItem, m_maxClearance, rootVisitor );
+
+        found.assign( rootObstacles.begin(), rootObstacles.end() );
+
+        // Temporary segments from a drag make for a lot of one-off queries
+        const size_t maxCacheSize = 65536;
+
+        std::lock_guard<std::mutex> lock( m_root->m_queryCacheMutex );
+
+        if( m_root->m_queryCache.size() >= maxCacheSize )
+            m_root->m_queryCache.clear();
+
+        m_root->m_queryCache.emplace( key, found );
+    }
+
+    for( OBSTACLE& obstacle : found )
+    {
+        if( overrides && overrides->Overrides( obstacle.m_item ) )
+            continue;
+
+        obstacle.m_head = const_cast<ITEM*>( aItem );
+        aCtx.obstacles.insert( obstacle );
+    }
+}
+
+
+void NODE::BeginBulkLoad()
+{
+    m_index->BeginBulkLoad();
+}
+
+
+void NODE::EndBulkLoad()
+{
+    m_index->EndBulkLoad();
+}
+
+
+void NODE::invalidateQueryCache()
+{
+    if( !isRoot() )
+        return;
+
+    std::lock_guard<std::mutex> lock( m_queryCacheMutex );
+    m_queryCache.clear();
 }
 
 
@@ -322,7 +451,22 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
                 }
             };
 
-    SHAPE_LINE_CHAIN obstacleHull;
+    // Hulls come from the items' caches; only the 90 degree modes need a hull of their own
+    const bool       useBBox = cornerMode == DIRECTION_45::MITERED_90
+                               || cornerMode == DIRECTION_45::ROUNDED_90;
+    SHAPE_LINE_CHAIN bboxedHull;
+
+    auto bboxHull =
+            [&]( const SHAPE_LINE_CHAIN& aHull )
+            {
+                BOX2I bbox = aHull.BBox();
+                bboxedHull.Clear();
+                bboxedHull.Append( bbox.GetLeft(),  bbox.GetTop()    );
+                bboxedHull.Append( bbox.GetRight(), bbox.GetTop()    );
+                bboxedHull.Append( bbox.GetRight(), bbox.GetBottom() );
+                bboxedHull.Append( bbox.GetLeft(),  bbox.GetBottom() );
+            };
+
     DEBUG_DECORATOR* debugDecorator = ROUTER::GetInstance()->GetInterface()->GetDebugDecorator();
     std::vector<SHAPE_LINE_CHAIN::INTERSECTION> intersectingPts;
     int layer = aLine->Layer();
@@ -335,22 +479,18 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
         int clearance = GetClearance( obstacle.m_item, aLine, aOpts.m_useClearanceEpsilon )
                             + aLine->Width() / 2;
 
-        obstacleHull = obstacle.m_item->Hull( clearance, 0, layer );
+        const SHAPE_LINE_CHAIN* obstacleHull = &obstacle.m_item->CachedHull( clearance, 0, layer );
 
-        if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
+        if( useBBox )
         {
-            BOX2I bbox = obstacleHull.BBox();
-            obstacleHull.Clear();
-            obstacleHull.Append( bbox.GetLeft(),  bbox.GetTop()    );
-            obstacleHull.Append( bbox.GetRight(), bbox.GetTop()    );
-            obstacleHull.Append( bbox.GetRight(), bbox.GetBottom() );
-            obstacleHull.Append( bbox.GetLeft(),  bbox.GetBottom() );
+            bboxHull( *obstacleHull );
+            obstacleHull = &bboxedHull;
         }
         //debugDecorator->AddLine( obstacleHull, 2, 40000, "obstacle-hull-test" );
         //debugDecorator->AddLine( aLine->CLine(), 5, 40000, "obstacle-test-line" );
 
         intersectingPts.clear();
-        HullIntersection( obstacleHull, aLine->CLine(), intersectingPts );
+        HullIntersection( *obstacleHull, aLine->CLine(), intersectingPts );
 
         for( const auto& ip : intersectingPts )
         {
@@ -365,21 +505,17 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine,
             int viaClearance = GetClearance( obstacle.m_item, &via, aOpts.m_useClearanceEpsilon )
                                + via.Diameter() / 2;
 
-            obstacleHull = obstacle.m_item->Hull( viaClearance, 0, layer );
+            obstacleHull = &obstacle.m_item->CachedHull( viaClearance, 0, layer );
 
-            if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
+            if( useBBox )
             {
-                BOX2I bbox = obstacleHull.BBox();
-                obstacleHull.Clear();
-                obstacleHull.Append( bbox.GetLeft(),  bbox.GetTop()    );
-                obstacleHull.Append( bbox.GetRight(), bbox.GetTop()    );
-                obstacleHull.Append( bbox.GetRight(), bbox.GetBottom() );
-                obstacleHull.Append( bbox.GetLeft(),  bbox.GetBottom() );
+                bboxHull( *obstacleHull );
+                obstacleHull = &bboxedHull;
             }
             //debugDecorator->AddLine( obstacleHull, 3 );
 
             intersectingPts.clear();
-            HullIntersection( obstacleHull, aLine->CLine(), intersectingPts );
+            HullIntersection( *obstacleHull, aLine->CLine(), intersectingPts );
 
             for( const SHAPE_LINE_CHAIN::INTERSECTION& ip : intersectingPts )
                 updateNearest( ip, obstacle );
@@ -522,6 +658,7 @@ void NODE::addSolid( SOLID* aSolid )
 
     aSolid->SetOwner( this );
     m_index->Add( aSolid );
+    invalidateQueryCache();
 }
 
 
@@ -547,6 +684,7 @@ void NODE::addVia( VIA* aVia )
     aVia->SetOwner( this );
 
     m_index->Add( aVia );
+    invalidateQueryCache();
 }
 
 
@@ -557,6 +695,7 @@ void NODE::addHole( HOLE* aHole )
 
     aHole->SetOwner( this );
     m_index->Add( aHole );
+    invalidateQueryCache();
 }
 
 
@@ -651,6 +790,7 @@ void NODE::addSegment( SEGMENT* aSeg )
     linkJoint( aSeg->Seg().B, aSeg->Layers(), aSeg->Net(), aSeg );
 
     m_index->Add( aSeg );
+    invalidateQueryCache();
 }
 
 
@@ -680,6 +820,7 @@ void NODE::addArc( ARC* aArc )
     linkJoint( aArc->Anchor( 1 ), aArc->Layers(), aArc->Net(), aArc );
 
     m_index->Add( aArc );
+    invalidateQueryCache();
 }
 
 
@@ -701,6 +842,7 @@ bool NODE::Add( std::unique_ptr< ARC >&& aArc, bool aAllowRedundant )
 void NODE::AddEdgeExclusion( std::unique_ptr<SHAPE> aShape )
 {
     m_edgeExclusions.push_back( std::move( aShape ) );
+    invalidateQueryCache();
 }
 
 
@@ -736,6 +878,8 @@ void NODE::doRemove( ITEM* aItem )
 
         if( aItem->HasHole() )
             m_index->Remove( aItem->Hole() );
+
+        invalidateQueryCache();
     }
 
     // the item belongs to this particular branch: un-reference it
@@ -1136,6 +1280,17 @@ void NODE::FixupVirtualVias()
 {
     const SEGMENT* locked_seg = nullptr;
     std::vector<VVIA*> vvias;
+    std::vector<ITEM*> stale;
+
+    // Start over when the world is brought up to date with the board
+    for( ITEM* item : *m_index )
+    {
+        if( item->Kind() == ITEM::VIA_T && item->IsVirtual() )
+            stale.push_back( item );
+    }
+
+    for( ITEM* item : stale )
+        Remove( item );
 
     for( auto& jointPair : m_joints )
     {
@@ -1675,6 +1830,24 @@ ITEM *NODE::FindItemByParent( const BOARD_ITEM* aParent )
     return nullptr;
 }
 
+std::vector<ITEM*> NODE::FindItemsByParents( const std::unordered_set<const BOARD_ITEM*>& aParents )
+{
+    std::vector<ITEM*> ret;
+
+    if( aParents.empty() )
+        return ret;
+
+    for( ITEM* item : *m_index )
+    {
+        // Holes go along with the pads and vias they belong to
+        if( item->Kind() != ITEM::HOLE_T && aParents.count( item->Parent() ) )
+            ret.push_back( item );
+    }
+
+    return ret;
+}
+
+
 std::vector<ITEM*> NODE::FindItemsByZone( const ZONE* aParent )
 {
     std::vector<ITEM*> ret;
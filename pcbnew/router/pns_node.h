@@ -25,8 +25,12 @@
 
 #include <vector>
 #include <list>
+#include <mutex>
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <core/minoptmax.h>
+#include <core/profile.h>
 
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_index.h>
@@ -133,6 +137,11 @@ struct COLLISION_SEARCH_CONTEXT
 };
 
 
+/**
+ * Resolves clearances and other constraints between router items.  Collision queries may run
+ * on several threads at once (e.g. both directions of a walkaround), so implementations have
+ * to be thread-safe.
+ */
 class RULE_RESOLVER
 {
 public:
@@ -234,8 +243,23 @@ public:
     void SetMaxClearance( int aClearance )
     {
         m_maxClearance = aClearance;
+        invalidateQueryCache();
     }
 
+    /**
+     * Forget the collisions with the items of the root node cached by QueryColliding().  The
+     * cache follows changes to the root by itself; this is for changes to the design rules.
+     */
+    void ClearQueryCache() { m_root->invalidateQueryCache(); }
+
+    /**
+     * Hold the items added from now on until EndBulkLoad(), which packs them into the spatial
+     * index all at once.  Much faster than adding a whole board item by item, but the items
+     * can't be found by queries in the meantime.
+     */
+    void BeginBulkLoad();
+    void EndBulkLoad();
+
     ///< Assign a clearance resolution function object.
     void SetRuleResolver( RULE_RESOLVER* aFunc )
     {
@@ -368,6 +392,10 @@ public:
      */
     NODE* Branch();
 
+    ///< Branches made and collision queries run by all the nodes, for benchmarks
+    static PROF_COUNTER s_branchCount;
+    static PROF_COUNTER s_collisionQueryCount;
+
     /**
      * Follow the joint map to assemble a line connecting two non-trivial joints starting from
      * segment \a aSeg.
@@ -440,6 +468,10 @@ public:
 
     ITEM* FindItemByParent( const BOARD_ITEM* aParent );
 
+    ///< Find the items of this node (but not of its parents) with one of \a aParents as parent,
+    ///< holes excepted.  The parents are only compared, so they don't have to exist anymore.
+    std::vector<ITEM*> FindItemsByParents( const std::unordered_set<const BOARD_ITEM*>& aParents );
+
     std::vector<ITEM*> FindItemsByZone( const ZONE* aParent );
 
     bool HasChildren() const
@@ -519,8 +551,44 @@ private:
                      VECTOR2I* aCorners, LINKED_ITEM** aSegments, bool* aArcReversed,
                      bool& aGuardHit, bool aStopAtLockedJoints, bool aFollowLockedSegments );
 
-private:
     struct DEFAULT_OBSTACLE_VISITOR;
+
+    /**
+     * Identifies the collision queries of segments against the root node which are bound to give
+     * the same obstacles: the obstacles only depend on the segment's geometry, net, layers and
+     * parent, and on the search options.
+     */
+    struct QUERY_CACHE_KEY
+    {
+        VECTOR2I          m_a;
+        VECTOR2I          m_b;
+        int               m_width;
+        NET_HANDLE        m_net;
+        int               m_layerStart;
+        int               m_layerEnd;
+        const BOARD_ITEM* m_parent;
+        int               m_maxClearance;
+        int               m_kindMask;
+        int               m_overrideClearance;
+        bool              m_differentNetsOnly;
+        bool              m_useClearanceEpsilon;
+
+        bool operator==( const QUERY_CACHE_KEY& aOther ) const;
+    };
+
+    struct QUERY_CACHE_KEY_HASH
+    {
+        std::size_t operator()( const QUERY_CACHE_KEY& aKey ) const;
+    };
+
+    ///< Collect the obstacles to \a aItem among the items of the root node, skipping the items
+    ///< this node overrides
+    void queryRoot( const ITEM* aItem, DEFAULT_OBSTACLE_VISITOR& aVisitor,
+                    COLLISION_SEARCH_CONTEXT& aCtx ) const;
+
+    void invalidateQueryCache();
+
+private:
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
 
@@ -543,6 +611,12 @@ private:
     std::vector< std::unique_ptr<SHAPE> > m_edgeExclusions;
 
     std::unordered_set<ITEM*> m_garbageItems;
+
+    ///< Obstacles found among the items of this node by the queries run on it and its branches.
+    ///< Only used in the root node.
+    mutable std::unordered_map<QUERY_CACHE_KEY, std::vector<OBSTACLE>,
+                               QUERY_CACHE_KEY_HASH> m_queryCache;
+    mutable std::mutex        m_queryCacheMutex;
 };
 
 }
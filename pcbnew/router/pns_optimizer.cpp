@@ -36,6 +36,8 @@
 #include "pns_router.h"
 #include "pns_debug_decorator.h"
 
+#include <hash.h>
+
 
 namespace PNS {
 
@@ -446,11 +448,37 @@ bool OPTIMIZER::checkConstraints( int aVertex1, int aVertex2, LINE* aOriginLine,
 }
 
 
+std::size_t OPTIMIZER::PATH_HASH::operator()( const std::vector<VECTOR2I>& aPath ) const
+{
+    std::size_t seed = 0xa82de1c0;
+
+    for( const VECTOR2I& pt : aPath )
+        hash_combine( seed, pt.x, pt.y );
+
+    return seed;
+}
+
+
 bool OPTIMIZER::checkColliding( LINE* aLine, const SHAPE_LINE_CHAIN& aOptPath )
 {
+    // Only the shape changes between the lines tested during an optimization
+    if( aOptPath.ArcCount() )
+    {
+        LINE tmp( *aLine, aOptPath );
+        return checkColliding( &tmp );
+    }
+
+    auto it = m_collisionMemo.find( aOptPath.CPoints() );
+
+    if( it != m_collisionMemo.end() )
+        return it->second;
+
     LINE tmp( *aLine, aOptPath );
+    bool colliding = checkColliding( &tmp );
 
-    return checkColliding( &tmp );
+    m_collisionMemo.emplace( aOptPath.CPoints(), colliding );
+
+    return colliding;
 }
 
 
@@ -504,9 +532,7 @@ bool OPTIMIZER::mergeObtuse( LINE* aLine )
                     opt_path.Append( s1opt.B );
                     opt_path.Append( s2opt.B );
 
-                    LINE opt_track( *aLine, opt_path );
-
-                    if( !checkColliding( &opt_track ) )
+                    if( !checkColliding( aLine, opt_path ) )
                     {
                         current_path.Replace( s1.Index() + 1, s2.Index(), ip );
 
@@ -623,6 +649,8 @@ bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
     bool hasArcs = aLine->ArcCount();
     bool rv = false;
 
+    m_collisionMemo.clear();
+
     if( (m_effortLevel & LIMIT_CORNER_COUNT) && aRoot )
     {
         const int angleMask = DIRECTION_45::ANG_OBTUSE;
@@ -682,6 +710,8 @@ bool OPTIMIZER::Optimize( LINE* aLine, LINE* aResult, LINE* aRoot )
     if( !hasArcs && m_effortLevel & FANOUT_CLEANUP )
         rv |= fanoutCleanup( aResult );
 
+    m_collisionMemo.clear();
+
     return rv;
 }
 
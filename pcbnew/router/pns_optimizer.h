@@ -169,6 +169,11 @@ private:
         bool m_isStatic;
     };
 
+    struct PATH_HASH
+    {
+        std::size_t operator()( const std::vector<VECTOR2I>& aPath ) const;
+    };
+
     bool mergeObtuse( LINE* aLine );
     bool mergeFull( LINE* aLine );
     bool mergeColinear( LINE* aLine );
@@ -202,6 +207,10 @@ private:
     std::vector<OPT_CONSTRAINT*>           m_constraints;
     std::unordered_map<ITEM*, CACHED_ITEM> m_cacheTags;
 
+    ///< Collisions of the paths tested since the start of the current optimization.  Merge
+    ///< steps start over after each improvement, testing the same paths over and over.
+    std::unordered_map<std::vector<VECTOR2I>, bool, PATH_HASH> m_collisionMemo;
+
     NODE*               m_world;
     int                 m_collisionKindMask;
     int                 m_effortLevel;
@@ -83,10 +83,19 @@ ROUTER* ROUTER::GetInstance()
 }
 
 
+void ROUTER::SetInstance( ROUTER* aRouter )
+{
+    theRouter = aRouter;
+}
+
+
 ROUTER::~ROUTER()
 {
     ClearWorld();
-    theRouter = nullptr;
+
+    if( theRouter == this )
+        theRouter = nullptr;
+
     delete m_logger;
 }
 
@@ -101,6 +110,27 @@ void ROUTER::SyncWorld()
 }
 
 
+void ROUTER::UpdateWorld()
+{
+    if( !m_world || RoutingInProgress() )
+    {
+        SyncWorld();
+        return;
+    }
+
+    m_placer.reset();
+    m_world->KillChildren();
+
+    if( !m_iface->UpdateWorld( m_world.get() ) )
+    {
+        SyncWorld();
+        return;
+    }
+
+    m_world->FixupVirtualVias();
+}
+
+
 void ROUTER::ClearWorld()
 {
     if( m_world )
@@ -166,6 +196,9 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM_SET aStartItems, int aDragM
 
     GetRuleResolver()->ClearCaches();
 
+    if( m_world )
+        m_world->ClearQueryCache();
+
     if( aStartItems.Count( ITEM::SOLID_T ) == aStartItems.Size() )
     {
         m_dragger = std::make_unique<COMPONENT_DRAGGER>( this );
@@ -391,6 +424,9 @@ bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
     GetRuleResolver()->ClearCaches();
 
+    if( m_world )
+        m_world->ClearQueryCache();
+
     if( !isStartingPointRoutable( aP, aStartItem, aLayer ) )
         return false;
 
@@ -90,6 +90,15 @@ enum DRAG_MODE
     virtual ~ROUTER_IFACE() {};
 
     virtual void SyncWorld( NODE* aNode ) = 0;
+
+    /**
+     * Apply to \a aNode, synced with SyncWorld() earlier, the changes made to the board since.
+     *
+     * @return false if the changes can't be applied incrementally, in which case the world has
+     *         to be synced again from scratch.
+     */
+    virtual bool UpdateWorld( NODE* aNode ) { return false; }
+
     virtual void AddItem( ITEM* aItem ) = 0;
     virtual void UpdateItem( ITEM* aItem ) = 0;
     virtual void RemoveItem( ITEM* aItem ) = 0;
@@ -141,9 +150,21 @@ public:
 
     static ROUTER* GetInstance();
 
+    /**
+     * Make \a aRouter the one returned by GetInstance().  Each router becomes the instance when
+     * it is created, so one which is kept around has to be made current again before it is used.
+     */
+    static void SetInstance( ROUTER* aRouter );
+
     void ClearWorld();
     void SyncWorld();
 
+    /**
+     * Bring the world up to date with the board, applying only the changes made since it was
+     * synced when the interface supports it.
+     */
+    void UpdateWorld();
+
     bool RoutingInProgress() const;
     bool StartRouting( const VECTOR2I& aP, ITEM* aItem, int aLayer );
     bool Move( const VECTOR2I& aP, ITEM* aItem );
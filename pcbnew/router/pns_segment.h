@@ -74,6 +74,7 @@ public:
     void SetWidth( int aWidth ) override
     {
         m_seg.SetWidth(aWidth);
+        invalidateHull();
     }
 
     int Width() const override
@@ -94,12 +95,14 @@ public:
     void SetEnds( const VECTOR2I& a, const VECTOR2I& b )
     {
         m_seg.SetSeg( SEG ( a, b ) );
+        invalidateHull();
     }
 
     void SwapEnds()
     {
         SEG tmp = m_seg.GetSeg();
         m_seg.SetSeg( SEG (tmp.B , tmp.A ) );
+        invalidateHull();
     }
 
     const SHAPE_LINE_CHAIN Hull( int aClearance, int aWalkaroundThickness, int aLayer = -1 ) const override;
@@ -122,6 +125,7 @@ public:
     void SetShape( const SHAPE_SEGMENT& aShape )
     {
         m_seg = aShape;
+        invalidateHull();
     }
 
 private:
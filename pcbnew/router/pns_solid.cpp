@@ -89,6 +89,7 @@ void SOLID::SetPos( const VECTOR2I& aCenter )
         m_hole->Move( delta );
 
     m_pos = aCenter;
+    invalidateHull();
 }
 
 
@@ -99,6 +99,7 @@ public:
     {
         delete m_shape;
         m_shape = shape;
+        invalidateHull();
     }
 
     const VECTOR2I& Pos() const { return m_pos; }
@@ -49,6 +49,7 @@ TOOL_BASE::TOOL_BASE( const std::string& aToolName ) :
     m_iface = nullptr;
     m_router = nullptr;
     m_cancelled = false;
+    m_worldOutdated = true;
 
     m_startItem = nullptr;
 
@@ -70,18 +71,37 @@ TOOL_BASE::~TOOL_BASE()
 void TOOL_BASE::Reset( RESET_REASON aReason )
 {
     delete m_gridHelper;
-    delete m_router;
-    delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
 
-    m_iface = new PNS_KICAD_IFACE;
-    m_iface->SetBoard( board() );
-    m_iface->SetView( getView() );
-    m_iface->SetHostTool( this );
+    // The world follows the changes made to the board since it was synced, so running the tool
+    // again only has to catch up with them
+    if( aReason == RUN && m_router && !m_worldOutdated )
+    {
+        // Other tools may have created routers of their own since this one was
+        ROUTER::SetInstance( m_router );
+        m_router->UpdateWorld();
+    }
+    else
+    {
+        // A board which was replaced is gone, along with its listeners
+        if( m_iface && m_iface->GetBoard() == board() )
+            board()->RemoveListener( m_iface );
+
+        delete m_router;
+        delete m_iface; // Delete after m_router because PNS::NODE dtor needs m_ruleResolver
+
+        m_iface = new PNS_KICAD_IFACE;
+        m_iface->SetBoard( board() );
+        m_iface->SetView( getView() );
+        m_iface->SetHostTool( this );
 
-    m_router = new ROUTER;
-    m_router->SetInterface( m_iface );
-    m_router->ClearWorld();
-    m_router->SyncWorld();
+        m_router = new ROUTER;
+        m_router->SetInterface( m_iface );
+        m_router->ClearWorld();
+        m_router->SyncWorld();
+
+        board()->AddListener( m_iface );
+        m_worldOutdated = false;
+    }
 
     m_router->UpdateSizes( m_savedSizes );
 
@@ -96,6 +116,20 @@ void TOOL_BASE::Reset( RESET_REASON aReason )
 }
 
 
+void TOOL_BASE::updateWorld()
+{
+    if( m_worldOutdated )
+    {
+        m_router->SyncWorld();
+        m_worldOutdated = false;
+    }
+    else
+    {
+        m_router->UpdateWorld();
+    }
+}
+
+
 ITEM* TOOL_BASE::pickSingleItem( const VECTOR2I& aWhere, NET_HANDLE aNet, int aLayer,
                                  bool aIgnorePads, const std::vector<ITEM*> aAvoidItems )
 {
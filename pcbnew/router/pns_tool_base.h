@@ -67,6 +67,12 @@ protected:
     virtual void updateStartItem( const TOOL_EVENT& aEvent, bool aIgnorePads = false );
     virtual void updateEndItem( const TOOL_EVENT& aEvent );
 
+    /**
+     * Bring the router world up to date with the board: incrementally, unless the board or its
+     * rules were reloaded since the world was synced.
+     */
+    void updateWorld();
+
     SIZES_SETTINGS   m_savedSizes;       // Stores sizes settings between router invocations
     ITEM*            m_startItem;
     VECTOR2I         m_startSnapPoint;
@@ -80,6 +86,7 @@ protected:
     ROUTER*          m_router;
 
     bool             m_cancelled;
+    bool             m_worldOutdated;    // The board was reloaded since the world was synced
 };
 
 }
@@ -429,7 +429,7 @@ const ITEM_SET TOPOLOGY::AssembleTuningPath( ITEM* aStart, SOLID** aStartPad, SO
                     if( !aPad->FlashLayer( line->Layer() ) )
                         continue;
 
-                    const std::vector<VECTOR2I>& points = line->CLine().CPoints();
+                    const SHAPE_LINE_CHAIN::POINT_VECTOR& points = line->CLine().CPoints();
 
                     if( points.front() != aJoint->Pos() && points.back() != aJoint->Pos() )
                         continue;
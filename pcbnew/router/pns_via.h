@@ -89,6 +89,7 @@ public:
         m_diameter = aB.m_diameter;
         m_shape = SHAPE_CIRCLE( m_pos, m_diameter / 2 );
         m_drill = aB.m_drill;
+        invalidateHull();
         SetHole( HOLE::MakeCircularHole( m_pos, m_drill / 2 ) );
         m_marker = aB.m_marker;
         m_rank = aB.m_rank;
@@ -131,6 +132,7 @@ public:
     {
         m_pos = aPos;
         m_shape.SetCenter( aPos );
+        invalidateHull();
 
         if( m_hole )
             m_hole->SetCenter( aPos );
@@ -145,6 +147,7 @@ public:
     {
         m_diameter = aDiameter;
         m_shape.SetRadius( m_diameter / 2 );
+        invalidateHull();
     }
 
     int Drill() const { return m_drill; }
@@ -21,6 +21,7 @@
 
 #include <optional>
 
+#include <core/thread_pool.h>
 #include <geometry/shape_line_chain.h>
 
 #include "pns_walkaround.h"
@@ -100,20 +101,24 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath, bool aWinding
 
     SHAPE_LINE_CHAIN path_walk;
 
-    SHAPE_LINE_CHAIN hull = current_obs->m_item->Hull( current_obs->m_clearance, aPath.Width() );
+    const SHAPE_LINE_CHAIN& obstacleHull =
+            current_obs->m_item->CachedHull( current_obs->m_clearance, aPath.Width() );
+    SHAPE_LINE_CHAIN        bboxHull;
 
     DIRECTION_45::CORNER_MODE cornerMode = Settings().GetCornerMode();
+    bool useBBox = cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90;
 
-    if( cornerMode == DIRECTION_45::MITERED_90 || cornerMode == DIRECTION_45::ROUNDED_90 )
+    if( useBBox )
     {
-        BOX2I bbox = hull.BBox();
-        hull.Clear();
-        hull.Append( bbox.GetLeft(),  bbox.GetTop()    );
-        hull.Append( bbox.GetRight(), bbox.GetTop()    );
-        hull.Append( bbox.GetRight(), bbox.GetBottom() );
-        hull.Append( bbox.GetLeft(),  bbox.GetBottom() );
+        BOX2I bbox = obstacleHull.BBox();
+        bboxHull.Append( bbox.GetLeft(),  bbox.GetTop()    );
+        bboxHull.Append( bbox.GetRight(), bbox.GetTop()    );
+        bboxHull.Append( bbox.GetRight(), bbox.GetBottom() );
+        bboxHull.Append( bbox.GetLeft(),  bbox.GetBottom() );
     }
 
+    const SHAPE_LINE_CHAIN& hull = useBBox ? bboxHull : obstacleHull;
+
     bool s_cw = aPath.Walkaround( hull, path_walk, aWindingDirection );
 
     PNS_DBG( Dbg(), BeginGroup, "hull/walk", 1 );
@@ -182,59 +187,43 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
     const int maxWalkDistFactor = 10;
     long long lengthLimit       = aInitialPath.CLine().Length() * maxWalkDistFactor;
 
-    while( m_iteration < m_iterationLimit )
+    auto walk =
+            [&]( LINE& aPath, WALKAROUND_STATUS& aStatus, bool aWindingDirection )
+            {
+                for( int ii = 0; ii < m_iterationLimit && aStatus == IN_PROGRESS; ii++ )
+                {
+                    aStatus = singleStep( aPath, aWindingDirection );
+
+                    // Safety valve
+                    if( m_lengthLimitOn && aPath.CLine().Length() > lengthLimit )
+                        break;
+                }
+            };
+
+    // Both directions only read the world, so they can be walked concurrently.  Debug output
+    // is kept in order by walking them one after the other.
+    if( s_cw == IN_PROGRESS && s_ccw == IN_PROGRESS && !( Dbg() && Dbg()->IsDebugEnabled() ) )
     {
-        if( s_cw != STUCK && s_cw != ALMOST_DONE )
-            s_cw = singleStep( path_cw, true );
-
-        if( s_ccw != STUCK && s_ccw != ALMOST_DONE )
-            s_ccw = singleStep( path_ccw, false );
-
-        if( s_cw != IN_PROGRESS )
-        {
-            result.lineCw = path_cw;
-            result.statusCw = s_cw;
-        }
-
-        if( s_ccw != IN_PROGRESS )
-        {
-            result.lineCcw = path_ccw;
-            result.statusCcw = s_ccw;
-        }
-
-        if( s_cw != IN_PROGRESS && s_ccw != IN_PROGRESS )
-            break;
-
-        double length = (double)aInitialPath.CLine().Length();
-        wxCHECK2( length != 0, length = 1.0 );
-        double lcw = path_cw.Line().Length() / length;
-
-        length = (double)aInitialPath.CLine().Length();
-        wxCHECK2( length != 0, length = 1.0 );
-        double lccw = path_ccw.Line().Length() / length;
-
-        PNS_DBG( Dbg(), Message, wxString::Format( wxT( "lcw %.1f lccw %.1f" ), lcw, lccw ) );
-
-
-        // Safety valve
-        if( m_lengthLimitOn && path_cw.Line().Length() > lengthLimit && path_ccw.Line().Length() >
-            lengthLimit )
-            break;
-
-        m_iteration++;
+        ParallelFor( 2,
+                [&]( size_t aIdx )
+                {
+                    if( aIdx == 0 )
+                        walk( path_cw, s_cw, true );
+                    else
+                        walk( path_ccw, s_ccw, false );
+                } );
     }
-
-    if( s_cw == IN_PROGRESS )
+    else
     {
-        result.lineCw = path_cw;
-        result.statusCw = ALMOST_DONE;
+        walk( path_cw, s_cw, true );
+        walk( path_ccw, s_ccw, false );
     }
 
-    if( s_ccw == IN_PROGRESS )
-    {
-        result.lineCcw = path_ccw;
-        result.statusCcw = ALMOST_DONE;
-    }
+    result.lineCw = path_cw;
+    result.statusCw = s_cw == IN_PROGRESS ? ALMOST_DONE : s_cw;
+
+    result.lineCcw = path_ccw;
+    result.statusCcw = s_ccw == IN_PROGRESS ? ALMOST_DONE : s_ccw;
 
     if( result.lineCw.SegmentCount() < 1 || result.lineCw.CPoint( 0 ) != aInitialPath.CPoint( 0 ) )
     {
@@ -563,6 +563,8 @@ void ROUTER_TOOL::Reset( RESET_REASON aReason )
 
     if( aReason == RUN )
         TOOL_BASE::Reset( aReason );
+    else
+        m_worldOutdated = true;
 }
 
 // Saves the complete event log and the dump of the PCB, allowing us to
@@ -1775,7 +1777,7 @@ int ROUTER_TOOL::MainLoop( const TOOL_EVENT& aEvent )
         }
         else if( evt->Action() == TA_UNDO_REDO_POST || evt->Action() == TA_MODEL_CHANGE )
         {
-            m_router->SyncWorld();
+            updateWorld();
         }
         else if( evt->IsMotion() )
         {
@@ -2150,8 +2152,8 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
         }
     }
 
-    // If we overrode locks, we want to clear the flag from the source item before SyncWorld is
-    // called so that virtual vias are not generated for the (now unlocked) track segment.  Note in
+    // If we overrode locks, we want to clear the flag from the source item before the world is
+    // updated so that virtual vias are not generated for the (now unlocked) track segment.  Note in
     // this case the lock can't be reliably re-applied, because there is no guarantee that the end
     // state of the drag results in the same number of segments so it's not clear which segment to
     // apply the lock state to.
@@ -2161,6 +2163,7 @@ int ROUTER_TOOL::InlineDrag( const TOOL_EVENT& aEvent )
     {
         wasLocked = true;
         item->SetLocked( false );
+        board()->OnItemChanged( item );
     }
 
     m_toolMgr->RunAction( PCB_ACTIONS::selectionClear );
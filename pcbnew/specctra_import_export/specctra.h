@@ -34,7 +34,9 @@
 
 #include <specctra_import_export/specctra_lexer.h>
 
+#include <map>
 #include <memory>
+#include <unordered_map>
 #include <geometry/shape_poly_set.h>
 
 // all outside the DSN namespace:
@@ -2213,6 +2215,7 @@ public:
 
 private:
     friend class SPECCTRA_DB;
+    friend class LIBRARY;
 
     std::string  m_hash;       ///< a hash string used by Compare(), not Format()ed/exported.
 
@@ -2254,6 +2257,9 @@ public:
         ELEM( aType, aParent )
     {
         m_unit = nullptr;
+        m_indexedImages = 0;
+        m_indexedPadstacks = 0;
+        m_indexedVias = 0;
 //        via_start_index = -1;       // 0 or greater means there is at least one via
     }
 
@@ -2286,23 +2292,22 @@ public:
      */
     int FindIMAGE( IMAGE* aImage )
     {
-        unsigned i;
+        indexImages();
 
-        for( i=0;  i<m_images.size();  ++i )
-        {
-            if( 0 == IMAGE::Compare( aImage, &m_images[i] ) )
-                return (int) i;
-        }
+        if( aImage->m_hash.empty() )
+            aImage->m_hash = aImage->makeHash();
+
+        auto it = m_imageIndex.find( aImage->m_hash );
+
+        if( it != m_imageIndex.end() )
+            return it->second;
 
         // There is no match to the IMAGE contents, but now generate a unique
         // name for it.
-        int dups = 1;
+        auto dups = m_imageIdCounts.find( aImage->m_image_id );
 
-        for( i=0;  i<m_images.size();  ++i )
-        {
-            if( 0 == aImage->m_image_id.compare( m_images[i].m_image_id ) )
-                aImage->m_duplicated = dups++;
-        }
+        if( dups != m_imageIdCounts.end() )
+            aImage->m_duplicated = dups->second;
 
         return -1;
     }
@@ -2343,11 +2348,15 @@ public:
      */
     int FindVia( PADSTACK* aVia )
     {
-        for( unsigned i = 0; i < m_vias.size(); ++i )
-        {
-            if( 0 == PADSTACK::Compare( aVia, &m_vias[i] ) )
-                return int( i );
-        }
+        indexVias();
+
+        if( aVia->m_hash.empty() )
+            aVia->m_hash = aVia->makeHash();
+
+        auto it = m_viaIndex.find( { aVia->m_hash, aVia->m_padstack_id } );
+
+        if( it != m_viaIndex.end() )
+            return it->second;
 
         return -1;
     }
@@ -2397,13 +2406,12 @@ public:
      */
     PADSTACK* FindPADSTACK( const std::string& aPadstackId )
     {
-        for( unsigned i = 0; i < m_padstacks.size(); ++i )
-        {
-            PADSTACK* ps = &m_padstacks[i];
+        indexPadstacks();
 
-            if( ps->GetPadstackId().compare( aPadstackId ) == 0 )
-                return ps;
-        }
+        auto it = m_padstackIndex.find( aPadstackId );
+
+        if( it != m_padstackIndex.end() )
+            return &m_padstacks[it->second];
 
         return nullptr;
     }
@@ -2434,11 +2442,63 @@ public:
 private:
     friend class SPECCTRA_DB;
 
+    /*
+     * The containers may also be filled directly by the parser, so the lookup indexes are
+     * brought up to date lazily, covering whatever was appended since the previous lookup.
+     * The first entry wins on duplicate keys, matching the linear searches they replace.
+     */
+
+    void indexImages()
+    {
+        for( ; m_indexedImages < m_images.size(); ++m_indexedImages )
+        {
+            IMAGE& image = m_images[m_indexedImages];
+
+            if( image.m_hash.empty() )
+                image.m_hash = image.makeHash();
+
+            m_imageIndex.emplace( image.m_hash, (int) m_indexedImages );
+            ++m_imageIdCounts[image.m_image_id];
+        }
+    }
+
+    void indexPadstacks()
+    {
+        for( ; m_indexedPadstacks < m_padstacks.size(); ++m_indexedPadstacks )
+        {
+            m_padstackIndex.emplace( m_padstacks[m_indexedPadstacks].m_padstack_id,
+                                     (int) m_indexedPadstacks );
+        }
+    }
+
+    void indexVias()
+    {
+        for( ; m_indexedVias < m_vias.size(); ++m_indexedVias )
+        {
+            PADSTACK& via = m_vias[m_indexedVias];
+
+            if( via.m_hash.empty() )
+                via.m_hash = via.makeHash();
+
+            m_viaIndex.emplace( std::make_pair( via.m_hash, via.m_padstack_id ),
+                                (int) m_indexedVias );
+        }
+    }
+
     UNIT_RES*       m_unit;
     IMAGES          m_images;
 
     PADSTACKS       m_padstacks;      ///< all except vias, which are in 'vias'
     PADSTACKS       m_vias;
+
+    std::unordered_map<std::string, int>          m_imageIndex;     ///< image hash to index
+    std::unordered_map<std::string, int>          m_imageIdCounts;  ///< images per image_id
+    std::unordered_map<std::string, int>          m_padstackIndex;  ///< padstack_id to index
+    std::map<std::pair<std::string, std::string>, int> m_viaIndex;  ///< (hash, id) to index
+
+    size_t          m_indexedImages;
+    size_t          m_indexedPadstacks;
+    size_t          m_indexedVias;
 };
 
 
@@ -40,6 +40,7 @@
 
 #include <set>                  // std::set
 #include <map>                  // std::map
+#include <tuple>                // std::tuple
 
 #include <board.h>
 #include <board_design_settings.h>
@@ -1660,7 +1661,11 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
 
     //-----<export the existing real BOARD instantiated vias>-----------------
     {
-        // Export all vias, once per unique size and drill diameter combo.
+        // Export all vias, once per unique size and drill diameter combo.  Boards have
+        // thousands of vias but only a handful of distinct kinds, so remember which padstack
+        // each kind registered as rather than building and hashing one per via.
+        std::map<std::tuple<int, int, PCB_LAYER_ID, PCB_LAYER_ID>, PADSTACK*> viaKinds;
+
         for( PCB_TRACK* track : aBoard->Tracks() )
         {
             if( track->Type() != PCB_VIA_T )
@@ -1672,13 +1677,24 @@ void SPECCTRA_DB::FromBOARD( BOARD* aBoard )
             if( netcode == 0 )
                 continue;
 
-            PADSTACK*   padstack    = makeVia( via );
-            PADSTACK*   registered  = m_pcb->m_library->LookupVia( padstack );
+            PCB_LAYER_ID topLayer;
+            PCB_LAYER_ID botLayer;
 
-            // if the one looked up is not our padstack, then delete our padstack
-            // since it was a duplicate of one already registered.
-            if( padstack != registered )
-                delete padstack;
+            via->LayerPair( &topLayer, &botLayer );
+
+            PADSTACK*& registered = viaKinds[ { via->GetWidth(), via->GetDrillValue(),
+                                                topLayer, botLayer } ];
+
+            if( !registered )
+            {
+                PADSTACK* padstack = makeVia( via );
+                registered = m_pcb->m_library->LookupVia( padstack );
+
+                // if the one looked up is not our padstack, then delete our padstack
+                // since it was a duplicate of one already registered.
+                if( padstack != registered )
+                    delete padstack;
+            }
 
             WIRE_VIA* dsnVia = new WIRE_VIA( m_pcb->m_wiring );
 
@@ -43,11 +43,15 @@
 #include <pcb_group.h>
 #include <pcb_track.h>
 #include <connectivity/connectivity_data.h>
+#include <core/thread_pool.h>
 #include <view/view.h>
 #include "specctra.h"
 #include <math/util.h>      // for KiROUND
 #include <pcbnew_settings.h>
 
+#include <mutex>
+#include <unordered_map>
+
 using namespace DSN;
 
 bool PCB_EDIT_FRAME::ImportSpecctraSession( const wxString& fullFileName )
@@ -376,6 +380,13 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
         // correct side of the board.
         COMPONENTS& components = m_session->placement->m_components;
 
+        // Index the footprints once; the first footprint wins for duplicated references,
+        // as BOARD::FindFootprintByReference() would do.
+        std::unordered_map<std::string, FOOTPRINT*> footprintsByRef;
+
+        for( FOOTPRINT* footprint : aBoard->Footprints() )
+            footprintsByRef.emplace( TO_UTF8( footprint->GetReference() ), footprint );
+
         for( COMPONENTS::iterator comp=components.begin();  comp!=components.end();  ++comp )
         {
             PLACES& places = comp->m_places;
@@ -383,15 +394,16 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
             {
                 PLACE* place = &places[i];  // '&' even though places[] holds a pointer!
 
-                wxString   reference = From_UTF8( place->m_component_id.c_str() );
-                FOOTPRINT* footprint = aBoard->FindFootprintByReference( reference );
+                auto fpIt = footprintsByRef.find( place->m_component_id );
 
-                if( !footprint )
+                if( fpIt == footprintsByRef.end() )
                 {
                     THROW_IO_ERROR( wxString::Format( _( "Reference '%s' not found." ),
-                                                      reference ) );
+                                            From_UTF8( place->m_component_id.c_str() ) ) );
                 }
 
+                FOOTPRINT* footprint = fpIt->second;
+
                 if( !place->m_hasVertex )
                     continue;
 
@@ -437,76 +449,39 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
 
     m_routeResolution = m_session->route->GetUnits();
 
-    // Walk the NET_OUTs and create tracks and vias anew.
+    // Walk the NET_OUTs and create tracks and vias anew.  Net and padstack names are resolved
+    // here, then the items of each NET_OUT are built on the thread pool and finally added to
+    // the board in one bulk operation, in NET_OUT order.
     NET_OUTS& net_outs = m_session->route->net_outs;
-    for( NET_OUTS::iterator net = net_outs.begin(); net!=net_outs.end(); ++net )
+    LIBRARY&  library = *m_session->route->library;
+
+    std::shared_ptr<NET_SETTINGS>& netSettings = aBoard->GetDesignSettings().m_NetSettings;
+    int via_drill_default = netSettings->m_DefaultNetClass->GetViaDrill();
+
+    std::vector<int>                     netCodes( net_outs.size(), 0 );
+    std::vector<std::vector<PADSTACK*>>  viaPadstacks( net_outs.size() );
+
+    for( unsigned n = 0; n < net_outs.size(); ++n )
     {
-        int netoutCode = 0;
+        NET_OUT* net = &net_outs[n];
 
         // page 143 of spec says wire's net_id is optional
         if( net->net_id.size() )
         {
             wxString netName = From_UTF8( net->net_id.c_str() );
-            NETINFO_ITEM* netinfo = aBoard->FindNet( netName );
-
-            if( netinfo )
-                netoutCode = netinfo->GetNetCode();
-        }
-
-        WIRES& wires = net->wires;
-        for( unsigned i = 0; i<wires.size(); ++i )
-        {
-            WIRE*   wire  = &wires[i];
-            DSN_T   shape = wire->m_shape->Type();
-
-            if( shape != T_path )
-            {
-                /*
-                 * shape == T_polygon is expected from freerouter if you have a zone on a non-
-                 * "power" type layer, i.e. a T_signal layer and the design does a round-trip
-                 * back in as session here.  We kept our own zones in the BOARD, so ignore this
-                 * so called 'wire'.
-
-                wxString netId = From_UTF8( wire->net_id.c_str() );
-                THROW_IO_ERROR( wxString::Format( _( "Unsupported wire shape: '%s' for net: '%s'" ),
-                                                    DLEX::GetTokenString(shape).GetData(),
-                                                    netId.GetData() ) );
-                */
-            }
-            else
-            {
-                PATH*   path = (PATH*) wire->m_shape;
 
-                for( unsigned pt=0; pt < path->points.size()-1; ++pt )
-                {
-                    PCB_TRACK* track = makeTRACK( wire, path, pt, netoutCode );
-                    aBoard->Add( track );
-                }
-            }
+            if( NETINFO_ITEM* netinfo = aBoard->FindNet( netName ) )
+                netCodes[n] = netinfo->GetNetCode();
         }
 
-        WIRE_VIAS& wire_vias = net->wire_vias;
-        LIBRARY& library = *m_session->route->library;
-
-        for( unsigned i=0;  i<wire_vias.size();  ++i )
+        for( unsigned i = 0; i < net->wire_vias.size(); ++i )
         {
-            int         netCode = 0;
-
-            // page 144 of spec says wire_via's net_id is optional
-            if( net->net_id.size() )
-            {
-                wxString netName = From_UTF8( net->net_id.c_str() );
-                NETINFO_ITEM* netvia = aBoard->FindNet( netName );
-
-                if( netvia )
-                    netCode = netvia->GetNetCode();
-            }
-
-            WIRE_VIA* wire_via = &wire_vias[i];
+            WIRE_VIA* wire_via = &net->wire_vias[i];
 
             // example: (via Via_15:8_mil 149000 -71000 )
 
             PADSTACK* padstack = library.FindPADSTACK( wire_via->GetPadstackId() );
+
             if( !padstack )
             {
                 // Dick  Feb 29, 2008:
@@ -521,18 +496,104 @@ void SPECCTRA_DB::FromSESSION( BOARD* aBoard )
                                                   psid ) );
             }
 
-            std::shared_ptr<NET_SETTINGS>& netSettings = aBoard->GetDesignSettings().m_NetSettings;
+            viaPadstacks[n].push_back( padstack );
+        }
+    }
 
-            int via_drill_default = netSettings->m_DefaultNetClass->GetViaDrill();
+    std::vector<std::vector<BOARD_ITEM*>> newItems( net_outs.size() );
+    std::mutex                            errorMutex;
+    std::unique_ptr<IO_ERROR>             firstError;
+    size_t                                firstErrorNet = net_outs.size();
 
-            for( unsigned v = 0; v < wire_via->m_vertexes.size(); ++v )
+    ParallelFor( net_outs.size(),
+            [&]( size_t n )
             {
-                PCB_VIA* via = makeVIA( wire_via, padstack, wire_via->m_vertexes[v], netCode,
-                                        via_drill_default );
-                aBoard->Add( via );
-            }
+                NET_OUT*                 net = &net_outs[n];
+                std::vector<BOARD_ITEM*>& items = newItems[n];
+
+                try
+                {
+                    WIRES& wires = net->wires;
+
+                    for( unsigned i = 0; i < wires.size(); ++i )
+                    {
+                        WIRE*   wire  = &wires[i];
+                        DSN_T   shape = wire->m_shape->Type();
+
+                        if( shape != T_path )
+                        {
+                            /*
+                             * shape == T_polygon is expected from freerouter if you have a zone
+                             * on a non-"power" type layer, i.e. a T_signal layer and the design
+                             * does a round-trip back in as session here.  We kept our own zones
+                             * in the BOARD, so ignore this so called 'wire'.
+                             */
+                        }
+                        else
+                        {
+                            PATH*   path = (PATH*) wire->m_shape;
+
+                            for( unsigned pt=0; pt < path->points.size()-1; ++pt )
+                                items.push_back( makeTRACK( wire, path, pt, netCodes[n] ) );
+                        }
+                    }
+
+                    WIRE_VIAS& wire_vias = net->wire_vias;
+
+                    for( unsigned i=0;  i<wire_vias.size();  ++i )
+                    {
+                        WIRE_VIA* wire_via = &wire_vias[i];
+                        PADSTACK* padstack = viaPadstacks[n][i];
+
+                        for( unsigned v = 0; v < wire_via->m_vertexes.size(); ++v )
+                        {
+                            items.push_back( makeVIA( wire_via, padstack, wire_via->m_vertexes[v],
+                                                      netCodes[n], via_drill_default ) );
+                        }
+                    }
+                }
+                catch( const IO_ERROR& ioe )
+                {
+                    for( BOARD_ITEM* item : items )
+                        delete item;
+
+                    items.clear();
+
+                    // Report the error the serial walk would have hit first.
+                    std::lock_guard<std::mutex> lock( errorMutex );
+
+                    if( n < firstErrorNet )
+                    {
+                        firstErrorNet = n;
+                        firstError = std::make_unique<IO_ERROR>( ioe );
+                    }
+                }
+            } );
+
+    if( firstError )
+    {
+        for( std::vector<BOARD_ITEM*>& items : newItems )
+        {
+            for( BOARD_ITEM* item : items )
+                delete item;
+        }
+
+        throw *firstError;
+    }
+
+    std::vector<BOARD_ITEM*> added;
+
+    for( std::vector<BOARD_ITEM*>& items : newItems )
+    {
+        for( BOARD_ITEM* item : items )
+        {
+            // Connectivity is rebuilt by the caller once the whole session is in.
+            aBoard->Add( item, ADD_MODE::BULK_APPEND, true );
+            added.push_back( item );
         }
     }
+
+    aBoard->FinalizeBulkAdd( added );
 }
 
 
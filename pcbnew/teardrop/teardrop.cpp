@@ -38,6 +38,9 @@
 #include <geometry/rtree.h>
 #include <convert_basic_shapes_to_polygon.h>
 #include <bezier_curves.h>
+#include <core/thread_pool.h>
+
+#include <unordered_set>
 
 #include <wx/log.h>
 
@@ -102,6 +105,7 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
 {
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     std::vector<ZONE*>                 stale_teardrops;
+    std::unordered_set<BOARD_ITEM*>    dirty( dirtyPadsAndVias->begin(), dirtyPadsAndVias->end() );
 
     for( ZONE* zone : m_board->Zones() )
     {
@@ -116,7 +120,7 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
 
             for( PAD* pad : connectedPads )
             {
-                if( alg::contains( *dirtyPadsAndVias, pad ) )
+                if( dirty.count( pad ) )
                 {
                     stale = true;
                     break;
@@ -127,7 +131,7 @@ void TEARDROP_MANAGER::RemoveTeardrops( BOARD_COMMIT& aCommit,
             {
                 for( PCB_VIA* via : connectedVias )
                 {
-                    if( alg::contains( *dirtyPadsAndVias, via ) )
+                    if( dirty.count( via ) )
                     {
                         stale = true;
                         break;
@@ -180,22 +184,51 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
     }
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    std::unordered_set<BOARD_ITEM*>    dirty;
+    std::unordered_set<PCB_TRACK*>     candidates;
+    std::vector<TEARDROP_JOB>          jobs;
+
+    if( !aForceFullUpdate )
+    {
+        dirty.insert( dirtyPadsAndVias->begin(), dirtyPadsAndVias->end() );
+        candidates.insert( dirtyTracks->begin(), dirtyTracks->end() );
+
+        // Only the tracks which changed or which touch a pad or via which changed can get new
+        // teardrops.  Removed pads and vias are no longer in the connectivity, so look up the
+        // tracks touching them in the track tree.
+        for( BOARD_ITEM* item : *dirtyPadsAndVias )
+        {
+            for( PCB_LAYER_ID layer : ( item->GetLayerSet() & LSET::AllCuMask() ).Seq() )
+            {
+                m_tracksRTree.QueryColliding( item, layer, layer, nullptr,
+                        [&]( BOARD_ITEM* aTrack ) -> bool
+                        {
+                            candidates.insert( static_cast<PCB_TRACK*>( aTrack ) );
+                            return true;
+                        },
+                        m_tolerance );
+            }
+        }
+    }
 
     for( PCB_TRACK* track : m_board->Tracks() )
     {
         if( ! ( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T ) )
             continue;
 
+        if( !aForceFullUpdate && !candidates.count( track ) )
+            continue;
+
         std::vector<PAD*>     connectedPads;
         std::vector<PCB_VIA*> connectedVias;
 
         connectivity->GetConnectedPadsAndVias( track, &connectedPads, &connectedVias );
 
-        bool forceUpdate = aForceFullUpdate || alg::contains( *dirtyTracks, track );
+        bool forceUpdate = aForceFullUpdate || dirtyTracks->count( track );
 
         for( PAD* pad : connectedPads )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, pad ) )
+            if( !forceUpdate && !dirty.count( pad ) )
                 continue;
 
             if( pad->GetShape() == PAD_SHAPE::CUSTOM )
@@ -223,28 +256,17 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
 
             // Skip case where pad and the track are within a copper zone with the same net
             // (and the pad can be connected to the zone)
-            if( !tdParams.m_TdOnPadsInZones && areItemsInSameZone( pad, track ) )
-                continue;
-
-            std::vector<VECTOR2I> points;
-
-            if( computeTeardropPolygon( tdParams, points, track, pad, pad->GetPosition() ) )
-            {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                aCommit.Added( new_teardrop );
-            }
+            jobs.push_back( { &tdParams, track, pad, pad->GetPosition(), TD_TYPE_PADVIA,
+                              !tdParams.m_TdOnPadsInZones } );
         }
 
         for( PCB_VIA* via : connectedVias )
         {
-            if( !forceUpdate && !alg::contains( *dirtyPadsAndVias, via ) )
+            if( !forceUpdate && !dirty.count( via ) )
                 continue;
 
-            TEARDROP_PARAMETERS tdParams = via->GetTeardropParams();
-            int                 annularWidth = via->GetWidth();
+            TEARDROP_PARAMETERS& tdParams = via->GetTeardropParams();
+            int                  annularWidth = via->GetWidth();
 
             if( !tdParams.m_Enabled )
                 continue;
@@ -262,19 +284,12 @@ void TEARDROP_MANAGER::UpdateTeardrops( BOARD_COMMIT& aCommit,
                 // The track is entirely inside the via; cannot create a teardrop
                 continue;
 
-            std::vector<VECTOR2I> points;
-
-            if( computeTeardropPolygon( tdParams, points, track, via, via->GetPosition() ) )
-            {
-                ZONE* new_teardrop = createTeardrop( TD_TYPE_PADVIA, points, track );
-                m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                m_createdTdList.push_back( new_teardrop );
-
-                aCommit.Added( new_teardrop );
-            }
+            jobs.push_back( { &tdParams, track, via, via->GetPosition(), TD_TYPE_PADVIA, false } );
         }
     }
 
+    addTeardrops( aCommit, jobs );
+
     if( ( aForceFullUpdate || !dirtyTracks->empty() )
         && m_prmsList->GetParameters( TARGET_TRACK )->m_Enabled )
     {
@@ -350,6 +365,11 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
 {
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
     TEARDROP_PARAMETERS                params = *m_prmsList->GetParameters( TARGET_TRACK );
+    std::vector<TEARDROP_JOB>          jobs;
+
+    // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
+    params.m_WidthtoSizeFilterRatio = std::max( params.m_WidthtoSizeFilterRatio, 0.1 );
+    const double th = 1.0 / params.m_WidthtoSizeFilterRatio;
 
     // Explore groups (a group is a set of tracks on the same layer and the same net):
     for( auto& grp : m_trackLookupList.GetBuffer() )
@@ -381,13 +401,8 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
         {
             PCB_TRACK* track = (*sublist)[ii];
             int        track_len = (int) track->GetLength();
-            bool       track_needs_update = aForceFullUpdate || alg::contains( *aTracks, track );
-            min_width = track->GetWidth();
-
-            // to avoid creating a teardrop between 2 tracks having similar widths give a threshold
-            params.m_WidthtoSizeFilterRatio = std::max( params.m_WidthtoSizeFilterRatio, 0.1 );
-            const double th = 1.0 / params.m_WidthtoSizeFilterRatio;
-            min_width = KiROUND( min_width * th );
+            bool       track_needs_update = aForceFullUpdate || aTracks->count( track );
+            min_width = KiROUND( track->GetWidth() * th );
 
             for( unsigned jj = ii+1; jj < sublist->size(); jj++ )
             {
@@ -418,7 +433,7 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
                 if( !match_points )
                     continue;
 
-                if( !track_needs_update && alg::contains( *aTracks, candidate ) )
+                if( !track_needs_update && aTracks->count( candidate ) )
                     continue;
 
                 // Pads/vias have priority for teardrops; ensure there isn't one at our position
@@ -443,19 +458,42 @@ void TEARDROP_MANAGER::AddTeardropsOnTracks( BOARD_COMMIT& aCommit,
                 if( existingPadOrVia )
                     continue;
 
-                std::vector<VECTOR2I> points;
-
-                if( computeTeardropPolygon( params, points, track, candidate, pos ) )
-                {
-                    ZONE* new_teardrop = createTeardrop( TD_TYPE_TRACKEND, points, track );
-                    m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
-                    m_createdTdList.push_back( new_teardrop );
-
-                    aCommit.Added( new_teardrop );
-                }
+                jobs.push_back( { &params, track, candidate, pos, TD_TYPE_TRACKEND, false } );
             }
         }
     }
+
+    addTeardrops( aCommit, jobs );
+}
+
+
+void TEARDROP_MANAGER::addTeardrops( BOARD_COMMIT& aCommit, std::vector<TEARDROP_JOB>& aJobs )
+{
+    // The shapes only depend on the board as it was before any of them is added, so they can
+    // be computed in parallel
+    ParallelFor( aJobs.size(),
+            [&]( size_t ii )
+            {
+                TEARDROP_JOB& job = aJobs[ii];
+
+                if( job.m_checkZones && areItemsInSameZone( job.m_other, job.m_track ) )
+                    return;
+
+                job.m_valid = computeTeardropPolygon( *job.m_params, job.m_points, job.m_track,
+                                                      job.m_other, job.m_otherPos );
+            } );
+
+    for( TEARDROP_JOB& job : aJobs )
+    {
+        if( !job.m_valid )
+            continue;
+
+        ZONE* new_teardrop = createTeardrop( job.m_variant, job.m_points, job.m_track );
+        m_board->Add( new_teardrop, ADD_MODE::BULK_INSERT );
+        m_createdTdList.push_back( new_teardrop );
+
+        aCommit.Added( new_teardrop );
+    }
 }
 
 
@@ -132,6 +132,27 @@ public:
     static bool IsRound( BOARD_ITEM* aItem );
 
 private:
+    /**
+     * A teardrop to build between a track and a pad, via or track end.
+     */
+    struct TEARDROP_JOB
+    {
+        const TEARDROP_PARAMETERS* m_params;
+        PCB_TRACK*                 m_track;
+        BOARD_ITEM*                m_other;
+        VECTOR2I                   m_otherPos;
+        TEARDROP_VARIANT           m_variant;
+        bool                       m_checkZones;    ///< skip if in a zone of the same net
+        std::vector<VECTOR2I>      m_points = {};
+        bool                       m_valid = false;
+    };
+
+    /**
+     * Compute the shapes of \a aJobs in parallel, then add the teardrops to the board and to
+     * \a aCommit in the order of \a aJobs.
+     */
+    void addTeardrops( BOARD_COMMIT& aCommit, std::vector<TEARDROP_JOB>& aJobs );
+
     /**
      * @return true if the given aViaPad + aTrack is located inside a zone of the same netname
      */
@@ -436,7 +436,7 @@ bool TEARDROP_MANAGER::computeAnchorPoints( const TEARDROP_PARAMETERS& aParams,
      */
 
     SHAPE_LINE_CHAIN& padpoly = c_buffer.Outline(0);
-    std::vector<VECTOR2I> points = padpoly.CPoints();
+    const SHAPE_LINE_CHAIN::POINT_VECTOR& points = padpoly.CPoints();
 
     std::vector<VECTOR2I> initialPoints;
     initialPoints.push_back( aPts[0] );
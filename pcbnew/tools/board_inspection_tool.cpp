@@ -35,6 +35,10 @@
 #include <dialogs/dialog_net_inspector.h>
 #include <dialogs/panel_setup_rules_base.h>
 #include <dialogs/dialog_footprint_associations.h>
+#include <dialogs/html_message_box.h>
+#include <gal/graphics_abstraction_layer.h>
+#include <board_memory_report.h>
+#include <memory_report.h>
 #include <string_utils.h>
 #include <tools/board_inspection_tool.h>
 #include <fp_lib_table.h>
@@ -144,6 +148,27 @@ int BOARD_INSPECTION_TOOL::ShowBoardStatistics( const TOOL_EVENT& aEvent )
 }
 
 
+int BOARD_INSPECTION_TOOL::ShowMemoryReport( const TOOL_EVENT& aEvent )
+{
+    MEMORY_REPORT report;
+
+    ReportBoardMemory( m_frame->GetBoard(), report );
+    ReportUndoMemory( m_frame->GetUndoList(), wxT( "Undo history" ), report );
+    ReportUndoMemory( m_frame->GetRedoList(), wxT( "Redo history" ), report );
+
+    if( KIGFX::GAL* gal = getView()->GetGAL() )
+        report.Add( wxT( "View vertex buffers" ), 1, gal->GetVertexMemoryUsage() );
+
+    HTML_MESSAGE_BOX dlg( m_frame, _( "Memory Usage" ) );
+
+    dlg.MessageSet( _( "Estimated memory usage (allocator overhead not included):" ) );
+    dlg.AddHTML_Text( report.FormatHtml() );
+    dlg.ShowModal();
+
+    return 0;
+}
+
+
 std::unique_ptr<DRC_ENGINE> BOARD_INSPECTION_TOOL::makeDRCEngine( bool* aCompileError, 
                                                                   bool* aCourtyardError )
 {
@@ -1632,7 +1657,7 @@ int BOARD_INSPECTION_TOOL::HighlightItem( const TOOL_EVENT& aEvent )
                 board->SetHighLightNet( multiNet, true );
 
             board->HighLightON();
-            m_toolMgr->GetView()->UpdateAllLayersColor();
+            view()->UpdateHighlightColors( board );
             m_currentlyHighlighted = netcodes;
             return true;
         }
@@ -1713,7 +1738,7 @@ int BOARD_INSPECTION_TOOL::HighlightItem( const TOOL_EVENT& aEvent )
             m_lastHighlighted = netcodes;
 
         settings->SetHighlight( enableHighlight, net );
-        m_toolMgr->GetView()->UpdateAllLayersColor();
+        view()->UpdateHighlightColors( board );
     }
 
     // Store the highlighted netcode in the current board (for dialogs for instance)
@@ -1755,7 +1780,7 @@ int BOARD_INSPECTION_TOOL::HighlightNet( const TOOL_EVENT& aEvent )
     {
         m_lastHighlighted = highlighted;
         settings->SetHighlight( true, netcode );
-        m_toolMgr->GetView()->UpdateAllLayersColor();
+        view()->UpdateHighlightColors( board() );
         m_currentlyHighlighted.clear();
         m_currentlyHighlighted.insert( netcode );
     }
@@ -1768,7 +1793,7 @@ int BOARD_INSPECTION_TOOL::HighlightNet( const TOOL_EVENT& aEvent )
     {
         std::set<int> temp = highlighted;
         settings->SetHighlight( m_lastHighlighted );
-        m_toolMgr->GetView()->UpdateAllLayersColor();
+        view()->UpdateHighlightColors( board() );
         m_currentlyHighlighted = m_lastHighlighted;
         m_lastHighlighted      = std::move( temp );
     }
@@ -1776,7 +1801,7 @@ int BOARD_INSPECTION_TOOL::HighlightNet( const TOOL_EVENT& aEvent )
     {
         bool turnOn = highlighted.empty() && !m_currentlyHighlighted.empty();
         settings->SetHighlight( m_currentlyHighlighted, turnOn );
-        m_toolMgr->GetView()->UpdateAllLayersColor();
+        view()->UpdateHighlightColors( board() );
     }
     else    // Highlight the net belonging to the item under the cursor
     {
@@ -1797,7 +1822,7 @@ int BOARD_INSPECTION_TOOL::ClearHighlight( const TOOL_EVENT& aEvent )
 
     board->ResetNetHighLight();
     settings->SetHighlight( false );
-    m_toolMgr->GetView()->UpdateAllLayersColor();
+    view()->UpdateHighlightColors( board );
     m_frame->SetMsgPanel( board );
     m_frame->SendCrossProbeNetName( "" );
     return 0;
@@ -2061,6 +2086,7 @@ void BOARD_INSPECTION_TOOL::setTransitions()
 
     Go( &BOARD_INSPECTION_TOOL::ListNets,            PCB_ACTIONS::listNets.MakeEvent() );
     Go( &BOARD_INSPECTION_TOOL::ShowBoardStatistics, PCB_ACTIONS::boardStatistics.MakeEvent() );
+    Go( &BOARD_INSPECTION_TOOL::ShowMemoryReport,    PCB_ACTIONS::memoryReport.MakeEvent() );
     Go( &BOARD_INSPECTION_TOOL::InspectClearance,    PCB_ACTIONS::inspectClearance.MakeEvent() );
     Go( &BOARD_INSPECTION_TOOL::InspectConstraints,  PCB_ACTIONS::inspectConstraints.MakeEvent() );
     Go( &BOARD_INSPECTION_TOOL::DiffFootprint,       PCB_ACTIONS::diffFootprint.MakeEvent() );
@@ -56,6 +56,9 @@ public:
      */
     int ShowBoardStatistics( const TOOL_EVENT& aEvent );
 
+    ///< Show the estimated memory usage of the board, caches and undo history.
+    int ShowMemoryReport( const TOOL_EVENT& aEvent );
+
     ///< Highlight net belonging to the item under the cursor.
     int HighlightNet( const TOOL_EVENT& aEvent );
 
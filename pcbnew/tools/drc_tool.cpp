@@ -35,8 +35,15 @@
 #include <progress_reporter.h>
 #include <drc/drc_engine.h>
 #include <drc/drc_item.h>
+#include <drc/drc_result_cache.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <macros.h>
+#include <pcbnew_settings.h>
+
+
+/// Time without any commit after which the background DRC re-checks the changed items (ms)
+static const int BACKGROUND_DRC_DELAY = 750;
+
 
 DRC_TOOL::DRC_TOOL() :
         PCB_TOOL_BASE( "pcbnew.DRCTool" ),
@@ -45,11 +52,23 @@ DRC_TOOL::DRC_TOOL() :
         m_drcDialog( nullptr ),
         m_drcRunning( false )
 {
+    m_incrementalScope.SetChangeHandler(
+            [this]()
+            {
+                scheduleBackgroundTests();
+            } );
+
+    m_backgroundTimer.Bind( wxEVT_TIMER,
+            [this]( wxTimerEvent& aEvent )
+            {
+                runBackgroundTests();
+            } );
 }
 
 
 DRC_TOOL::~DRC_TOOL()
 {
+    m_backgroundTimer.Stop();
 }
 
 
@@ -64,6 +83,11 @@ void DRC_TOOL::Reset( RESET_REASON aReason )
 
         m_pcb = m_editFrame->GetBoard();
         m_drcEngine = m_pcb->GetDesignSettings().m_DRCEngine;
+
+        // Nothing is known about the markers of a new board
+        m_incrementalScope.Clear();
+        m_incrementalScope.Invalidate();
+        m_pcb->AddListener( &m_incrementalScope );
     }
 }
 
@@ -130,7 +154,7 @@ void DRC_TOOL::DestroyDRCDialog()
 
 
 void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones,
-                         bool aReportAllTrackErrors, bool aTestFootprints )
+                         bool aReportAllTrackErrors, bool aTestFootprints, bool aUseResultCache )
 {
     // One at a time, please.
     // Note that the main GUI entry points to get here are blocked, so this is really an
@@ -152,6 +176,11 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 
         zoneFiller->FillAllZones( m_drcDialog, aProgressReporter );
     }
+    else
+    {
+        // Draft fills are too rough to be checked
+        zoneFiller->RefillDraftZones( m_drcDialog );
+    }
 
     m_drcEngine->SetDrawingSheet( m_editFrame->GetCanvas()->GetDrawingSheet() );
 
@@ -178,7 +207,18 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
                 commit.Add( marker );
             } );
 
-    m_drcEngine->RunTests( m_editFrame->GetUserUnits(), aReportAllTrackErrors, aTestFootprints );
+    if( aUseResultCache && !m_pcb->GetFileName().IsEmpty() )
+    {
+        DRC_RESULT_CACHE cache( m_drcEngine.get() );
+
+        cache.RunTests( DRC_RESULT_CACHE::GetDefaultPath( m_pcb ), m_editFrame->GetUserUnits(),
+                        aReportAllTrackErrors, aTestFootprints );
+    }
+    else
+    {
+        m_drcEngine->RunTests( m_editFrame->GetUserUnits(), aReportAllTrackErrors,
+                               aTestFootprints );
+    }
 
     m_drcEngine->SetProgressReporter( nullptr );
     m_drcEngine->ClearViolationHandler();
@@ -195,6 +235,9 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 
     m_drcRunning = false;
 
+    if( !aProgressReporter->IsCancelled() )
+        m_incrementalScope.Clear();
+
     m_editFrame->ShowSolderMask();
 
     // update the m_drcDialog listboxes
@@ -202,6 +245,104 @@ void DRC_TOOL::RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones
 }
 
 
+bool DRC_TOOL::RunIncrementalTests()
+{
+    if( m_drcRunning || m_incrementalScope.NeedsFullRun() )
+        return false;
+
+    if( m_incrementalScope.Empty() )
+        return true;
+
+    BOARD_COMMIT       commit( m_editFrame );
+    std::set<int>      errorCodes = m_drcEngine->GetIncrementalErrorCodes();
+    std::set<wxString> existing;
+
+    m_drcRunning = true;
+
+    // Drop the markers the run is going to re-check; remember the others so that the
+    // violations found again next to the changed items aren't reported twice.
+    for( PCB_MARKER* marker : m_pcb->Markers() )
+    {
+        if( marker->GetMarkerType() != MARKER_BASE::MARKER_DRC )
+            continue;
+
+        std::shared_ptr<RC_ITEM> rcItem = marker->GetRCItem();
+
+        if( errorCodes.count( rcItem->GetErrorCode() ) && m_incrementalScope.Touches( *rcItem ) )
+            commit.Remove( marker );
+        else
+            existing.insert( marker->Serialize() );
+    }
+
+    m_drcEngine->SetDrawingSheet( m_editFrame->GetCanvas()->GetDrawingSheet() );
+
+    m_drcEngine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+            {
+                PCB_MARKER* marker = new PCB_MARKER( aItem, aPos, aLayer );
+
+                if( existing.insert( marker->Serialize() ).second )
+                    commit.Add( marker );
+                else
+                    delete marker;
+            } );
+
+    m_drcEngine->RunIncrementalTests( userUnits(), m_incrementalScope );
+
+    m_drcEngine->ClearViolationHandler();
+
+    commit.Push( _( "DRC" ), SKIP_UNDO | SKIP_SET_DIRTY );
+
+    m_drcRunning = false;
+    m_incrementalScope.Clear();
+
+    updatePointers( false );
+
+    return true;
+}
+
+
+int DRC_TOOL::ToggleBackgroundDRC( const TOOL_EVENT& aEvent )
+{
+    PCBNEW_SETTINGS* settings = m_editFrame->GetPcbNewSettings();
+
+    settings->m_BackgroundDRC = !settings->m_BackgroundDRC;
+
+    if( settings->m_BackgroundDRC )
+        scheduleBackgroundTests();
+    else
+        m_backgroundTimer.Stop();
+
+    return 0;
+}
+
+
+void DRC_TOOL::scheduleBackgroundTests()
+{
+    // Each new commit pushes the run back: only the last of a burst of edits gets tested
+    if( m_editFrame && m_editFrame->GetPcbNewSettings()->m_BackgroundDRC )
+        m_backgroundTimer.StartOnce( BACKGROUND_DRC_DELAY );
+}
+
+
+void DRC_TOOL::runBackgroundTests()
+{
+    if( !m_editFrame || !m_editFrame->GetPcbNewSettings()->m_BackgroundDRC )
+        return;
+
+    // Interactive tools edit items in place before pushing their commit; wait until they
+    // are done rather than testing half-edited items.
+    if( m_drcRunning || !m_editFrame->ToolStackIsEmpty() )
+    {
+        scheduleBackgroundTests();
+        return;
+    }
+
+    // Full runs are too slow to start behind the user's back; they stay with the dialog
+    RunIncrementalTests();
+}
+
+
 void DRC_TOOL::updatePointers( bool aDRCWasCancelled )
 {
     // update my pointers, m_editFrame is the only unchangeable one
@@ -289,6 +430,7 @@ int DRC_TOOL::ExcludeMarker( const TOOL_EVENT& aEvent )
 void DRC_TOOL::setTransitions()
 {
     Go( &DRC_TOOL::ShowDRCDialog,              PCB_ACTIONS::runDRC.MakeEvent() );
+    Go( &DRC_TOOL::ToggleBackgroundDRC,        PCB_ACTIONS::toggleBackgroundDRC.MakeEvent() );
     Go( &DRC_TOOL::PrevMarker,                 ACTIONS::prevMarker.MakeEvent() );
     Go( &DRC_TOOL::NextMarker,                 ACTIONS::nextMarker.MakeEvent() );
     Go( &DRC_TOOL::ExcludeMarker,              ACTIONS::excludeMarker.MakeEvent() );
@@ -31,7 +31,9 @@
 #include <geometry/shape_poly_set.h>
 #include <memory>
 #include <vector>
+#include <wx/timer.h>
 #include <tools/pcb_tool_base.h>
+#include <drc/drc_incremental_scope.h>
 
 
 class PCB_EDIT_FRAME;
@@ -79,9 +81,23 @@ public:
 
     /**
      * Run the DRC tests.
+     *
+     * @param aUseResultCache only re-test the items changed since the results stored next to
+     *                        the board file (see DRC_RESULT_CACHE).
      */
     void RunTests( PROGRESS_REPORTER* aProgressReporter, bool aRefillZones,
-                   bool aReportAllTrackErrors, bool aTestFootprints );
+                   bool aReportAllTrackErrors, bool aTestFootprints, bool aUseResultCache );
+
+    /**
+     * Re-test only the items changed by the commits pushed since the last DRC run, and merge
+     * the results into the existing markers.
+     *
+     * @return false if nothing was tested because a full run is needed (for instance after a
+     *         change to the board outline or to a rule area).
+     */
+    bool RunIncrementalTests();
+
+    int ToggleBackgroundDRC( const TOOL_EVENT& aEvent );
 
     int PrevMarker( const TOOL_EVENT& aEvent );
     int NextMarker( const TOOL_EVENT& aEvent );
@@ -106,12 +122,20 @@ private:
 
     EDA_UNITS userUnits() const { return m_editFrame->GetUserUnits(); }
 
+    /**
+     * Run the incremental tests once the edits have settled, if background DRC is enabled.
+     */
+    void scheduleBackgroundTests();
+    void runBackgroundTests();
+
 private:
     PCB_EDIT_FRAME*             m_editFrame;
     BOARD*                      m_pcb;
     DIALOG_DRC*                 m_drcDialog;
     bool                        m_drcRunning;
     std::shared_ptr<DRC_ENGINE> m_drcEngine;
+    DRC_INCREMENTAL_SCOPE       m_incrementalScope;
+    wxTimer                     m_backgroundTimer;
 };
 
 
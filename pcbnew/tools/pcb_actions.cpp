@@ -409,6 +409,12 @@ TOOL_ACTION PCB_ACTIONS::runDRC( TOOL_ACTION_ARGS()
         .Tooltip( _( "Show the design rules checker window" ) )
         .Icon( BITMAPS::erc ) );
 
+TOOL_ACTION PCB_ACTIONS::toggleBackgroundDRC( TOOL_ACTION_ARGS()
+        .Name( "pcbnew.DRCTool.toggleBackgroundDRC" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Background DRC" ) )
+        .Tooltip( _( "Re-check the edited items and update the DRC markers after each change" ) ) );
+
 
 // EDIT_TOOL
 //
@@ -1865,6 +1871,13 @@ TOOL_ACTION PCB_ACTIONS::boardStatistics( TOOL_ACTION_ARGS()
         .FriendlyName( _( "Show Board Statistics" ) )
         .Tooltip( _( "Shows board statistics" ) ) );
 
+TOOL_ACTION PCB_ACTIONS::memoryReport( TOOL_ACTION_ARGS()
+        .Name( "pcbnew.InspectionTool.ShowMemoryReport" )
+        .Scope( AS_GLOBAL )
+        .FriendlyName( _( "Show Memory Usage" ) )
+        .Tooltip( _( "Shows the estimated memory used by the board, its caches and the undo "
+                     "history" ) ) );
+
 TOOL_ACTION PCB_ACTIONS::inspectClearance( TOOL_ACTION_ARGS()
         .Name( "pcbnew.InspectionTool.InspectClearance" )
         .Scope( AS_GLOBAL )
@@ -430,6 +430,7 @@ public:
 
     static TOOL_ACTION listNets;
     static TOOL_ACTION runDRC;
+    static TOOL_ACTION toggleBackgroundDRC;
 
     static TOOL_ACTION editFpInFpEditor;
     static TOOL_ACTION editLibFpInFpEditor;
@@ -529,6 +530,7 @@ public:
     static TOOL_ACTION appendBoard;
     static TOOL_ACTION showEeschema;
     static TOOL_ACTION boardStatistics;
+    static TOOL_ACTION memoryReport;
     static TOOL_ACTION boardReannotate;
     static TOOL_ACTION repairBoard;
     static TOOL_ACTION repairFootprint;
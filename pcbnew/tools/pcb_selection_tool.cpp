@@ -33,10 +33,10 @@ using namespace std::placeholders;
 #include <advanced_config.h>
 #include <macros.h>
 #include <core/kicad_algo.h>
+#include <core/thread_pool.h>
 #include <board.h>
 #include <board_design_settings.h>
 #include <board_item.h>
-#include <clipper.hpp>
 #include <pcb_reference_image.h>
 #include <pcb_track.h>
 #include <footprint.h>
@@ -981,19 +981,58 @@ bool PCB_SELECTION_TOOL::selectMultiple()
                     group_items.emplace( group_item );
             }
 
+            // The view returns an item once for each of its layers.  Reject the duplicates
+            // and the items which can't be selected (hidden or beyond their LOD) before any
+            // geometry is looked at.
+            std::vector<BOARD_ITEM*>        hitCandidates;
+            std::unordered_set<BOARD_ITEM*> seen;
+
             for( const KIGFX::VIEW::LAYER_ITEM_PAIR& candidate : candidates )
             {
                 BOARD_ITEM* item = static_cast<BOARD_ITEM*>( candidate.first );
 
+                if( !item || !seen.insert( item ).second )
+                    continue;
 
-                if( item && Selectable( item ) && item->HitTest( selectionRect, !greedySelection )
-                        && ( greedySelection || !group_items.count( item ) ) )
-                {
-                    if( item->Type() == PCB_PAD_T && !m_isFootprintEditor )
-                        padsCollector.Append( item );
-                    else
-                        collector.Append( item );
-                }
+                if( !greedySelection && group_items.count( item ) )
+                    continue;
+
+                if( !Selectable( item ) )
+                    continue;
+
+                // Zone bounding boxes are cached in the board, fill the cache before the
+                // hit tests run in parallel
+                if( item->Type() == PCB_ZONE_T )
+                    static_cast<ZONE*>( item )->CacheBoundingBox();
+
+                hitCandidates.push_back( item );
+            }
+
+            // Each item is hit tested by a single task, as some of them cache their geometry
+            const size_t      blockSize = 256;
+            const bool        greedy = greedySelection;
+            std::vector<char> hits( hitCandidates.size(), 0 );
+
+            ParallelFor( ( hitCandidates.size() + blockSize - 1 ) / blockSize,
+                    [&]( size_t aBlock )
+                    {
+                        size_t end = std::min( hitCandidates.size(), ( aBlock + 1 ) * blockSize );
+
+                        for( size_t ii = aBlock * blockSize; ii < end; ++ii )
+                            hits[ii] = hitCandidates[ii]->HitTest( selectionRect, !greedy );
+                    } );
+
+            for( size_t ii = 0; ii < hitCandidates.size(); ++ii )
+            {
+                BOARD_ITEM* item = hitCandidates[ii];
+
+                if( !hits[ii] )
+                    continue;
+
+                if( item->Type() == PCB_PAD_T && !m_isFootprintEditor )
+                    padsCollector.Append( item );
+                else
+                    collector.Append( item );
             }
 
             // Apply the stateful filter
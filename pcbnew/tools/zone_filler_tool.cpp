@@ -23,8 +23,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 #include <cstdint>
+#include <map>
 #include <thread>
 #include <zone.h>
+#include <advanced_config.h>
 #include <connectivity/connectivity_data.h>
 #include <board_commit.h>
 #include <footprint.h>
@@ -50,16 +52,20 @@ ZONE_FILLER_TOOL::ZONE_FILLER_TOOL() :
     PCB_TOOL_BASE( "pcbnew.ZoneFiller" ),
     m_fillInProgress( false )
 {
+    m_draftRefillTimer.Bind( wxEVT_TIMER, &ZONE_FILLER_TOOL::onDraftRefillTimer, this );
 }
 
 
 ZONE_FILLER_TOOL::~ZONE_FILLER_TOOL()
 {
+    m_draftRefillTimer.Stop();
 }
 
 
 void ZONE_FILLER_TOOL::Reset( RESET_REASON aReason )
 {
+    if( aReason == MODEL_RELOAD )
+        m_draftRefillTimer.Stop();
 }
 
 
@@ -196,13 +202,22 @@ void ZONE_FILLER_TOOL::FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aRepo
 
 int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 {
-    PCB_EDIT_FRAME*    frame = getEditFrame<PCB_EDIT_FRAME>();
-    std::vector<ZONE*> toFill;
+    PCB_EDIT_FRAME*        frame = getEditFrame<PCB_EDIT_FRAME>();
+    std::vector<ZONE*>     toFill;
+    std::map<ZONE*, BOX2I> dirtyAreas;
 
     for( ZONE* zone : board()->Zones() )
     {
         if( !zone->IsFilled() || m_dirtyZoneIDs.count( zone->m_Uuid ) )
             toFill.push_back( zone );
+
+        auto it = m_dirtyZoneAreas.find( zone->m_Uuid );
+
+        if( zone->IsFilled() && it != m_dirtyZoneAreas.end()
+                && ADVANCED_CFG::GetCfg().m_IncrementalZoneRefill )
+        {
+            dirtyAreas[ zone ] = it->second;
+        }
     }
 
     if( toFill.empty() )
@@ -215,6 +230,7 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     m_fillInProgress = true;
 
     m_dirtyZoneIDs.clear();
+    m_dirtyZoneAreas.clear();
 
     board()->IncrementTimeStamp();    // Clear caches
 
@@ -222,7 +238,11 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     std::unique_ptr<WX_PROGRESS_REPORTER> reporter;
     int                                   pts = 0;
 
+    bool draft = ADVANCED_CFG::GetCfg().m_DraftZoneRefill;
+
     m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
+    m_filler->SetDirtyAreas( dirtyAreas );
+    m_filler->SetDraft( draft );
 
     if( !board()->GetDesignSettings().m_DRCEngine->RulesValid() )
     {
@@ -260,9 +280,17 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
     }
 
     if( m_filler->Fill( toFill ) )
+    {
         commit.Push( _( "Auto-fill Zone(s)" ), APPEND_UNDO | SKIP_CONNECTIVITY | ZONE_FILL_OP );
+
+        // Draft fills get their full-precision refill once the user pauses
+        if( draft )
+            m_draftRefillTimer.StartOnce( ADVANCED_CFG::GetCfg().m_DraftZoneRefillDelay );
+    }
     else
+    {
         commit.Revert();
+    }
 
     rebuildConnectivity();
     refresh();
@@ -302,6 +330,63 @@ int ZONE_FILLER_TOOL::ZoneFillDirty( const TOOL_EVENT& aEvent )
 }
 
 
+void ZONE_FILLER_TOOL::RefillDraftZones( wxWindow* aCaller )
+{
+    std::vector<ZONE*> toFill;
+
+    m_draftRefillTimer.Stop();
+
+    for( ZONE* zone : board()->Zones() )
+    {
+        if( zone->IsFilled() && zone->IsDraftFill() )
+            toFill.push_back( zone );
+    }
+
+    if( toFill.empty() || m_fillInProgress )
+        return;
+
+    m_fillInProgress = true;
+
+    board()->IncrementTimeStamp();    // Clear caches
+
+    BOARD_COMMIT                          commit( this );
+    std::unique_ptr<WX_PROGRESS_REPORTER> reporter;
+    wxString title = wxString::Format( _( "Refill %d Zones" ), (int) toFill.size() );
+
+    m_filler = std::make_unique<ZONE_FILLER>( board(), &commit );
+
+    reporter = std::make_unique<WX_PROGRESS_REPORTER>( aCaller, title, 5 );
+    m_filler->SetProgressReporter( reporter.get() );
+
+    // The draft fills were made as part of the last edits, and so are their replacements
+    if( m_filler->Fill( toFill ) )
+        commit.Push( _( "Auto-fill Zone(s)" ), APPEND_UNDO | SKIP_CONNECTIVITY | ZONE_FILL_OP );
+    else
+        commit.Revert();
+
+    rebuildConnectivity();
+    refresh();
+
+    m_fillInProgress = false;
+    m_filler.reset( nullptr );
+}
+
+
+void ZONE_FILLER_TOOL::onDraftRefillTimer( wxTimerEvent& aEvent )
+{
+    PCB_EDIT_FRAME* frame = getEditFrame<PCB_EDIT_FRAME>();
+
+    // Don't refill under the feet of an interactive tool; try again later
+    if( m_fillInProgress || !frame->ToolStackIsEmpty() )
+    {
+        m_draftRefillTimer.StartOnce( ADVANCED_CFG::GetCfg().m_DraftZoneRefillDelay );
+        return;
+    }
+
+    RefillDraftZones( frame );
+}
+
+
 int ZONE_FILLER_TOOL::ZoneFill( const TOOL_EVENT& aEvent )
 {
     if( m_fillInProgress )
@@ -29,6 +29,7 @@
 
 #include <tools/pcb_tool_base.h>
 #include <zone.h>
+#include <wx/timer.h>
 
 
 class PCB_EDIT_FRAME;
@@ -52,6 +53,13 @@ public:
     void CheckAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aReporter = nullptr );
     void FillAllZones( wxWindow* aCaller, PROGRESS_REPORTER* aReporter = nullptr );
 
+    /**
+     * Refill at full precision the zones which only have a draft fill (see
+     * ZONE_FILLER::SetDraft()).  Called before the board is saved or checked, and once the
+     * editor is idle after draft fills were made.
+     */
+    void RefillDraftZones( wxWindow* aCaller );
+
     int ZoneFill( const TOOL_EVENT& aEvent );
     int ZoneFillAll( const TOOL_EVENT& aEvent );
     int ZoneFillDirty( const TOOL_EVENT& aEvent );
@@ -65,6 +73,19 @@ public:
     void DirtyZone( ZONE* aZone )
     {
         m_dirtyZoneIDs.insert( aZone->m_Uuid );
+        m_dirtyZoneAreas.erase( aZone->m_Uuid );
+    }
+
+    /**
+     * Mark the fill of \a aZone dirty around \a aArea only, so that an automatic refill can
+     * recompute it there alone.  Has no effect on a zone which is already dirty as a whole.
+     */
+    void DirtyZoneArea( ZONE* aZone, const BOX2I& aArea )
+    {
+        if( m_dirtyZoneIDs.insert( aZone->m_Uuid ).second )
+            m_dirtyZoneAreas[ aZone->m_Uuid ] = aArea;
+        else if( auto it = m_dirtyZoneAreas.find( aZone->m_Uuid ); it != m_dirtyZoneAreas.end() )
+            it->second.Merge( aArea );
     }
 
     static bool IsZoneFillAction( const TOOL_EVENT* aEvent );
@@ -73,6 +94,8 @@ private:
     ///< Refocus on an idle event (used after the Progress Reporter messes up the focus).
     void singleShotRefocus( wxIdleEvent& );
 
+    void onDraftRefillTimer( wxTimerEvent& aEvent );
+
     void rebuildConnectivity();
     void refresh();
 
@@ -84,6 +107,10 @@ private:
     bool                         m_fillInProgress;
 
     std::set<KIID>               m_dirtyZoneIDs;
+    std::map<KIID, BOX2I>        m_dirtyZoneAreas;    ///< dirty zones which are only dirty
+                                                      ///<   around an area
+
+    wxTimer                      m_draftRefillTimer;  ///< refills draft fills when idle
 };
 
 #endif
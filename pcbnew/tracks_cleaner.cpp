@@ -31,9 +31,13 @@
 #include <tool/tool_manager.h>
 #include <tools/pcb_actions.h>
 #include <tools/global_edit_tool.h>
-#include <drc/drc_rtree.h>
+#include <core/thread_pool.h>
+#include <hash.h>
 #include <tracks_cleaner.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 TRACKS_CLEANER::TRACKS_CLEANER( BOARD* aPcb, BOARD_COMMIT& aCommit ) :
         m_brd( aPcb ),
         m_commit( aCommit ),
@@ -248,67 +252,80 @@ bool TRACKS_CLEANER::testTrackEndpointIsNode( PCB_TRACK* aTrack, bool aTstStart
 
 bool TRACKS_CLEANER::deleteDanglingTracks( bool aTrack, bool aVia )
 {
-    bool item_erased = false;
-    bool modified = false;
-
     if( !aTrack && !aVia )
         return false;
 
-    do // Iterate when at least one track is deleted
-    {
-        item_erased = false;
-        // Ensure the connectivity is up to date, especially after removing a dangling segment
-        m_brd->BuildConnectivity();
+    // Removed tracks are only flagged while searching: the dangling test ignores IS_DELETED
+    // items, so the connectivity doesn't need to be rebuilt after each removal.  Deleting a track
+    // can only make its own neighbours dangling, so only those are tested again.
+    m_brd->BuildConnectivity();
 
-        // Keep a duplicate deque to all deleting in the primary
-        std::deque<PCB_TRACK*> temp_tracks( m_brd->Tracks() );
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
 
-        for( PCB_TRACK* track : temp_tracks )
-        {
-            if( track->IsLocked() || ( track->GetFlags() & IS_DELETED ) > 0 )
-                continue;
+    std::deque<PCB_TRACK*>        queue( m_brd->Tracks().begin(), m_brd->Tracks().end() );
+    std::unordered_set<PCB_TRACK*> queued( queue.begin(), queue.end() );
+    std::vector<BOARD_ITEM*>       removed;
 
-            if( !aVia && track->Type() == PCB_VIA_T )
-                continue;
+    while( !queue.empty() )
+    {
+        PCB_TRACK* track = queue.front();
 
-            if( !aTrack && ( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T ) )
-                continue;
+        queue.pop_front();
+        queued.erase( track );
 
-            // Test if a track (or a via) endpoint is not connected to another track or zone.
-            if( m_brd->GetConnectivity()->TestTrackEndpointDangling( track, false ) )
-            {
-                std::shared_ptr<CLEANUP_ITEM> item;
+        if( track->IsLocked() || ( track->GetFlags() & IS_DELETED ) > 0 )
+            continue;
 
-                if( track->Type() == PCB_VIA_T )
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DANGLING_VIA );
-                else
-                    item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DANGLING_TRACK );
+        if( !aVia && track->Type() == PCB_VIA_T )
+            continue;
 
-                item->SetItems( track );
-                m_itemsList->push_back( item );
-                track->SetFlags( IS_DELETED );
+        if( !aTrack && ( track->Type() == PCB_TRACE_T || track->Type() == PCB_ARC_T ) )
+            continue;
+
+        // Test if a track (or a via) endpoint is not connected to another track or zone.
+        if( connectivity->TestTrackEndpointDangling( track, false ) )
+        {
+            std::shared_ptr<CLEANUP_ITEM> item;
 
-                // keep iterating, because a track connected to the deleted track
-                // now perhaps is not connected and should be deleted
-                item_erased = true;
+            if( track->Type() == PCB_VIA_T )
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DANGLING_VIA );
+            else
+                item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DANGLING_TRACK );
 
-                if( !m_dryRun )
-                {
-                    m_brd->Remove( track );
-                    m_commit.Removed( track );
-                    modified = true;
-                }
+            item->SetItems( track );
+            m_itemsList->push_back( item );
+            track->SetFlags( IS_DELETED );
+            removed.push_back( track );
+
+            // a track connected to the deleted track now perhaps is not connected and should
+            // be deleted
+            for( PCB_TRACK* neighbour : connectivity->GetConnectedTracks( track ) )
+            {
+                if( !neighbour->HasFlag( IS_DELETED ) && queued.insert( neighbour ).second )
+                    queue.push_back( neighbour );
             }
         }
-    } while( item_erased ); // A segment was erased: test for some new dangling segments
+    }
+
+    if( m_dryRun || removed.empty() )
+        return false;
 
-    return modified;
+    removeItems( removed );
+    return true;
 }
 
 
 void TRACKS_CLEANER::deleteTracksInPads()
 {
-    std::set<BOARD_ITEM*> toRemove;
+    struct TRACK_IN_PAD
+    {
+        PCB_TRACK* track;
+        PAD*       pad;
+        bool       inside;
+    };
+
+    std::vector<TRACK_IN_PAD> candidates;
+    std::set<BOARD_ITEM*>     toRemove;
 
     // Delete tracks that start and end on the same pad
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_brd->GetConnectivity();
@@ -325,25 +342,38 @@ void TRACKS_CLEANER::deleteTracksInPads()
         for( PAD* pad : connectivity->GetConnectedPads( track ) )
         {
             if( pad->HitTest( track->GetStart() ) && pad->HitTest( track->GetEnd() ) )
+                candidates.push_back( { track, pad, false } );
+        }
+    }
+
+    // The hit tests above have built the pad polygons, so the boolean operations only read
+    // shared data and can run in parallel
+    ParallelFor( candidates.size(),
+            [&]( size_t ii )
             {
+                TRACK_IN_PAD&  candidate = candidates[ii];
                 SHAPE_POLY_SET poly;
-                track->TransformShapeToPolygon( poly, track->GetLayer(), 0, ARC_HIGH_DEF,
-                                                ERROR_INSIDE );
 
-                poly.BooleanSubtract( *pad->GetEffectivePolygon( ERROR_INSIDE ),
+                candidate.track->TransformShapeToPolygon( poly, candidate.track->GetLayer(), 0,
+                                                          ARC_HIGH_DEF, ERROR_INSIDE );
+
+                poly.BooleanSubtract( *candidate.pad->GetEffectivePolygon( ERROR_INSIDE ),
                                       SHAPE_POLY_SET::PM_FAST );
 
-                if( poly.IsEmpty() )
-                {
-                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_TRACK_IN_PAD );
-                    item->SetItems( track );
-                    m_itemsList->push_back( item );
+                candidate.inside = poly.IsEmpty();
+            } );
 
-                    toRemove.insert( track );
-                    track->SetFlags( IS_DELETED );
-                }
-            }
-        }
+    for( const TRACK_IN_PAD& candidate : candidates )
+    {
+        if( !candidate.inside )
+            continue;
+
+        auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_TRACK_IN_PAD );
+        item->SetItems( candidate.track );
+        m_itemsList->push_back( item );
+
+        toRemove.insert( candidate.track );
+        candidate.track->SetFlags( IS_DELETED );
     }
 
     if( !m_dryRun )
@@ -357,12 +387,31 @@ void TRACKS_CLEANER::deleteTracksInPads()
 void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegments,
                               bool aDeleteDuplicateSegments, bool aMergeSegments )
 {
-    DRC_RTREE rtree;
+    // Duplicates share their exact geometry, so bucketing the tracks by a hash of it finds them
+    // without any spatial search.  The buckets are then compared exactly, as hashes can collide.
+    std::unordered_map<size_t, std::vector<PCB_TRACK*>> viaBuckets;
+    std::unordered_map<size_t, std::vector<PCB_TRACK*>> segmentBuckets;
+
+    auto segmentKey =
+            []( PCB_TRACK* aTrack ) -> size_t
+            {
+                VECTOR2I a = aTrack->GetStart();
+                VECTOR2I b = aTrack->GetEnd();
+
+                if( std::tie( b.x, b.y ) < std::tie( a.x, a.y ) )
+                    std::swap( a, b );
+
+                return hash_val( static_cast<int>( aTrack->GetLayer() ), aTrack->GetWidth(), a, b );
+            };
 
     for( PCB_TRACK* track : m_brd->Tracks() )
     {
         track->ClearFlags( IS_DELETED | SKIP_STRUCT );
-        rtree.Insert( track, track->GetLayer() );
+
+        if( aDeleteDuplicateVias && track->Type() == PCB_VIA_T )
+            viaBuckets[ hash_val( track->GetStart() ) ].push_back( track );
+        else if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T && !track->IsNull() )
+            segmentBuckets[ segmentKey( track ) ].push_back( track );
     }
 
     std::set<BOARD_ITEM*> toRemove;
@@ -379,33 +428,28 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
             if( via->GetStart() != via->GetEnd() )
                 via->SetEnd( via->GetStart() );
 
-            rtree.QueryColliding( via, via->GetLayer(), via->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_VIA_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED );
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        PCB_VIA* other = static_cast<PCB_VIA*>( aItem );
+            for( PCB_TRACK* candidate : viaBuckets[ hash_val( via->GetStart() ) ] )
+            {
+                if( candidate == via || candidate->HasFlag( SKIP_STRUCT )
+                        || candidate->HasFlag( IS_DELETED ) )
+                {
+                    continue;
+                }
 
-                        if( via->GetPosition() == other->GetPosition()
-                                && via->GetViaType() == other->GetViaType()
-                                && via->GetLayerSet() == other->GetLayerSet() )
-                        {
-                            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_REDUNDANT_VIA );
-                            item->SetItems( via );
-                            m_itemsList->push_back( item );
+                PCB_VIA* other = static_cast<PCB_VIA*>( candidate );
 
-                            via->SetFlags( IS_DELETED );
-                            toRemove.insert( via );
-                        }
+                if( via->GetPosition() == other->GetPosition()
+                        && via->GetViaType() == other->GetViaType()
+                        && via->GetLayerSet() == other->GetLayerSet() )
+                {
+                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_REDUNDANT_VIA );
+                    item->SetItems( via );
+                    m_itemsList->push_back( item );
 
-                        return true;
-                    } );
+                    via->SetFlags( IS_DELETED );
+                    toRemove.insert( via );
+                }
+            }
 
             // To delete through Via on THT pads at same location
             // Examine the list of connected pads: if a through pad is found, the via is redundant
@@ -443,35 +487,27 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
 
         if( aDeleteDuplicateSegments && track->Type() == PCB_TRACE_T && !track->IsNull() )
         {
-            rtree.QueryColliding( track, track->GetLayer(), track->GetLayer(),
-                    // Filter:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        return aItem->Type() == PCB_TRACE_T
-                                  && !aItem->HasFlag( SKIP_STRUCT )
-                                  && !aItem->HasFlag( IS_DELETED )
-                                  && !static_cast<PCB_TRACK*>( aItem )->IsNull();
-                    },
-                    // Visitor:
-                    [&]( BOARD_ITEM* aItem ) -> bool
-                    {
-                        PCB_TRACK* other = static_cast<PCB_TRACK*>( aItem );
-
-                        if( track->IsPointOnEnds( other->GetStart() )
-                                && track->IsPointOnEnds( other->GetEnd() )
-                                && track->GetWidth() == other->GetWidth()
-                                && track->GetLayer() == other->GetLayer() )
-                        {
-                            auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_TRACK );
-                            item->SetItems( track );
-                            m_itemsList->push_back( item );
+            for( PCB_TRACK* other : segmentBuckets[ segmentKey( track ) ] )
+            {
+                if( other == track || other->HasFlag( SKIP_STRUCT )
+                        || other->HasFlag( IS_DELETED ) )
+                {
+                    continue;
+                }
 
-                            track->SetFlags( IS_DELETED );
-                            toRemove.insert( track );
-                        }
+                if( track->IsPointOnEnds( other->GetStart() )
+                        && track->IsPointOnEnds( other->GetEnd() )
+                        && track->GetWidth() == other->GetWidth()
+                        && track->GetLayer() == other->GetLayer() )
+                {
+                    auto item = std::make_shared<CLEANUP_ITEM>( CLEANUP_DUPLICATE_TRACK );
+                    item->SetItems( track );
+                    m_itemsList->push_back( item );
 
-                        return true;
-                    } );
+                    track->SetFlags( IS_DELETED );
+                    toRemove.insert( track );
+                }
+            }
 
             track->SetFlags( SKIP_STRUCT );
         }
@@ -480,96 +516,244 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
     if( !m_dryRun )
         removeItems( toRemove );
 
-    auto mergeSegments =
-            [&]( std::shared_ptr<CN_CONNECTIVITY_ALGO> connectivity ) -> bool
+    if( aMergeSegments )
+        mergeSegments();
+
+    for( PCB_TRACK* track : m_brd->Tracks() )
+        track->ClearFlags( IS_DELETED | SKIP_STRUCT );
+}
+
+
+PCB_TRACK* TRACKS_CLEANER::mergeSegment( PCB_TRACK* aSegment )
+{
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> connectivity =
+            m_brd->GetConnectivity()->GetConnectivityAlgo();
+
+    // for each end of the segment:
+    for( CN_ITEM* citem : connectivity->ItemEntry( aSegment ).GetItems() )
+    {
+        // Do not merge an end which has different width tracks attached -- it's a
+        // common use-case for necking-down a track between pads.
+        std::vector<PCB_TRACK*> sameWidthCandidates;
+        std::vector<PCB_TRACK*> differentWidthCandidates;
+
+        for( CN_ITEM* connected : citem->ConnectedItems() )
+        {
+            if( !connected->Valid() )
+                continue;
+
+            BOARD_CONNECTED_ITEM* candidate = connected->Parent();
+
+            if( candidate->Type() == PCB_TRACE_T && !candidate->HasFlag( IS_DELETED ) )
             {
+                PCB_TRACK* candidateSegment = static_cast<PCB_TRACK*>( candidate );
 
-                for( PCB_TRACK* segment : m_brd->Tracks() )
+                if( candidateSegment->GetWidth() == aSegment->GetWidth() )
                 {
-                    // one can merge only collinear segments, not vias or arcs.
-                    if( segment->Type() != PCB_TRACE_T )
-                        continue;
-
-                    if( segment->HasFlag( IS_DELETED ) )  // already taken into account
-                        continue;
+                    sameWidthCandidates.push_back( candidateSegment );
+                }
+                else
+                {
+                    differentWidthCandidates.push_back( candidateSegment );
+                    break;
+                }
+            }
+        }
 
-                    // for each end of the segment:
-                    for( CN_ITEM* citem : connectivity->ItemEntry( segment ).GetItems() )
-                    {
-                        // Do not merge an end which has different width tracks attached -- it's a
-                        // common use-case for necking-down a track between pads.
-                        std::vector<PCB_TRACK*> sameWidthCandidates;
-                        std::vector<PCB_TRACK*> differentWidthCandidates;
+        if( !differentWidthCandidates.empty() )
+            continue;
 
-                        for( CN_ITEM* connected : citem->ConnectedItems() )
-                        {
-                            if( !connected->Valid() )
-                                continue;
+        for( PCB_TRACK* candidate : sameWidthCandidates )
+        {
+            // SKIP_STRUCT marks the segments already changed by this pass
+            if( candidate->HasFlag( SKIP_STRUCT ) )
+                continue;
 
-                            BOARD_CONNECTED_ITEM* candidate = connected->Parent();
+            if( aSegment->ApproxCollinear( *candidate )
+                    && mergeCollinearSegments( aSegment, candidate ) )
+            {
+                return candidate;
+            }
+        }
+    }
 
-                            if( candidate->Type() == PCB_TRACE_T
-                                    && !candidate->HasFlag( IS_DELETED ) )
-                            {
-                                PCB_TRACK* candidateSegment = static_cast<PCB_TRACK*>( candidate );
+    return nullptr;
+}
 
-                                if( candidateSegment->GetWidth() == segment->GetWidth() )
-                                {
-                                    sameWidthCandidates.push_back( candidateSegment );
-                                }
-                                else
-                                {
-                                    differentWidthCandidates.push_back( candidateSegment );
-                                    break;
-                                }
-                            }
-                        }
 
-                        if( !differentWidthCandidates.empty() )
-                            continue;
+void TRACKS_CLEANER::mergeSegments()
+{
+    auto forEachConnectedSegment =
+            [&]( PCB_TRACK* aTrack, const std::function<void( PCB_TRACK* )>& aFunc )
+            {
+                std::shared_ptr<CN_CONNECTIVITY_ALGO> connectivity =
+                        m_brd->GetConnectivity()->GetConnectivityAlgo();
 
-                        for( PCB_TRACK* candidate : sameWidthCandidates )
-                        {
-                            if( segment->ApproxCollinear( *candidate )
-                                    && mergeCollinearSegments( segment, candidate ) )
-                            {
-                                return true;
-                            }
-                        }
+                for( CN_ITEM* citem : connectivity->ItemEntry( aTrack ).GetItems() )
+                {
+                    for( CN_ITEM* connected : citem->ConnectedItems() )
+                    {
+                        if( connected->Parent()->Type() == PCB_TRACE_T )
+                            aFunc( static_cast<PCB_TRACK*>( connected->Parent() ) );
                     }
                 }
-
-                return false;
             };
 
-    if( aMergeSegments )
+    for( PCB_TRACK* track : m_brd->Tracks() )
+        track->ClearFlags( SKIP_STRUCT );
+
+    if( m_dryRun )
     {
+        // Nothing is modified, so the connectivity stays valid and the results must be the same
+        // as when restarting the search from the first segment after each merge.  The only
+        // segments which may have changed their mind are the one just merged, and those attached
+        // to the segment flagged as merged away.
+        while( !m_brd->BuildConnectivity() )
+            wxSafeYield();
+
+        buildClusterCache();
+
+        std::vector<PCB_TRACK*>                tracks( m_brd->Tracks().begin(),
+                                                       m_brd->Tracks().end() );
+        std::unordered_map<PCB_TRACK*, size_t> indices;
+        std::set<size_t>                       recheck;
+        size_t                                 next = 0;
+
+        for( size_t ii = 0; ii < tracks.size(); ++ii )
+            indices[ tracks[ii] ] = ii;
+
+        while( !recheck.empty() || next < tracks.size() )
+        {
+            size_t ii;
+
+            if( !recheck.empty() )
+            {
+                ii = *recheck.begin();
+                recheck.erase( recheck.begin() );
+            }
+            else
+            {
+                ii = next++;
+            }
+
+            PCB_TRACK* segment = tracks[ii];
+
+            // one can merge only collinear segments, not vias or arcs.
+            if( segment->Type() != PCB_TRACE_T || segment->HasFlag( IS_DELETED ) )
+                continue;
+
+            if( PCB_TRACK* merged = mergeSegment( segment ) )
+            {
+                recheck.insert( ii );
+
+                forEachConnectedSegment( merged,
+                        [&]( PCB_TRACK* aNeighbour )
+                        {
+                            auto it = indices.find( aNeighbour );
+
+                            if( it != indices.end() && it->second < next )
+                                recheck.insert( it->second );
+                        } );
+            }
+        }
+    }
+    else
+    {
+        // Merge in passes: a merge only invalidates the connectivity around the two segments,
+        // so the rest of the board can go on merging before rebuilding it once per pass.
+        std::set<BOARD_ITEM*> merged;
+
         do
         {
             while( !m_brd->BuildConnectivity() )
                 wxSafeYield();
 
-            m_connectedItemsCache.clear();
-        } while( mergeSegments( m_brd->GetConnectivity()->GetConnectivityAlgo() ) );
+            buildClusterCache();
+            merged.clear();
+
+            auto touch =
+                    [&]( PCB_TRACK* aTrack )
+                    {
+                        aTrack->SetFlags( SKIP_STRUCT );
+                        forEachConnectedSegment( aTrack,
+                                []( PCB_TRACK* aNeighbour )
+                                {
+                                    aNeighbour->SetFlags( SKIP_STRUCT );
+                                } );
+                    };
+
+            for( PCB_TRACK* segment : m_brd->Tracks() )
+            {
+                // one can merge only collinear segments, not vias or arcs.
+                if( segment->Type() != PCB_TRACE_T )
+                    continue;
+
+                if( segment->HasFlag( IS_DELETED ) || segment->HasFlag( SKIP_STRUCT ) )
+                    continue;
+
+                if( PCB_TRACK* candidate = mergeSegment( segment ) )
+                {
+                    touch( segment );
+                    touch( candidate );
+                    merged.insert( candidate );
+                }
+            }
+
+            // Merged segments have to go away
+            removeItems( merged );
+
+            for( PCB_TRACK* track : m_brd->Tracks() )
+                track->ClearFlags( SKIP_STRUCT );
+
+        } while( !merged.empty() );
     }
 
-    for( PCB_TRACK* track : m_brd->Tracks() )
-        track->ClearFlags( IS_DELETED | SKIP_STRUCT );
+    m_clusterItems.clear();
+    m_clusterIndex.clear();
 }
 
 
-const std::vector<BOARD_CONNECTED_ITEM*>& TRACKS_CLEANER::getConnectedItems( PCB_TRACK* aTrack )
+void TRACKS_CLEANER::buildClusterCache()
 {
-    const std::shared_ptr<CONNECTIVITY_DATA>& connectivity = m_brd->GetConnectivity();
-
-    if( m_connectedItemsCache.count( aTrack ) == 0 )
+    std::shared_ptr<CN_CONNECTIVITY_ALGO> connectivity =
+            m_brd->GetConnectivity()->GetConnectivityAlgo();
+
+    m_clusterItems.clear();
+    m_clusterIndex.clear();
+
+    // A single search over all nets gives the same clusters as one search per segment's net
+    for( const std::shared_ptr<CN_CLUSTER>& cluster :
+         connectivity->SearchClusters( CN_CONNECTIVITY_ALGO::CSM_CONNECTIVITY_CHECK,
+                                       { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T, PCB_PAD_T,
+                                         PCB_ZONE_T },
+                                       -1 ) )
     {
-        m_connectedItemsCache[ aTrack ] =
-                connectivity->GetConnectedItems( aTrack, { PCB_TRACE_T, PCB_ARC_T, PCB_VIA_T,
-                                                           PCB_PAD_T, PCB_ZONE_T } );
+        std::vector<BOARD_CONNECTED_ITEM*>& items = m_clusterItems.emplace_back();
+
+        for( CN_ITEM* citem : *cluster )
+        {
+            if( !citem->Valid() )
+                continue;
+
+            items.push_back( citem->Parent() );
+
+            if( citem->Parent()->Type() == PCB_TRACE_T )
+                m_clusterIndex[ citem->Parent() ] = m_clusterItems.size() - 1;
+        }
     }
+}
+
 
-    return m_connectedItemsCache[ aTrack ];
+const std::vector<BOARD_CONNECTED_ITEM*>& TRACKS_CLEANER::getConnectedItems( PCB_TRACK* aTrack )
+{
+    static const std::vector<BOARD_CONNECTED_ITEM*> empty;
+
+    auto it = m_clusterIndex.find( aTrack );
+
+    if( it == m_clusterIndex.end() )
+        return empty;
+
+    return m_clusterItems[ it->second ];
 }
 
 
@@ -581,9 +765,22 @@ bool TRACKS_CLEANER::mergeCollinearSegments( PCB_TRACK* aSeg1, PCB_TRACK* aSeg2
     // Collect the unique points where the two tracks are connected to other items
     std::set<VECTOR2I> pts;
 
+    // The connected items are the whole cluster of the segments, but only those near their ends
+    // can be hit.  Zones are hit up to twice the (floored) accuracy away from their outline.
+    int   accuracy = std::max( ( aSeg1->GetWidth() + 1 ) / 2, ( aSeg2->GetWidth() + 1 ) / 2 );
+    BOX2I area( aSeg1->GetStart() );
+
+    area.Merge( aSeg1->GetEnd() );
+    area.Merge( aSeg2->GetStart() );
+    area.Merge( aSeg2->GetEnd() );
+    area.Inflate( 2 * std::max( accuracy, pcbIUScale.mmToIU( 0.1 ) ) + 1 );
+
     auto collectPts =
             [&]( BOARD_CONNECTED_ITEM* citem )
             {
+                if( !area.Intersects( citem->GetBoundingBox() ) )
+                    return;
+
                 if( citem->Type() == PCB_TRACE_T || citem->Type() == PCB_ARC_T
                         || citem->Type() == PCB_VIA_T )
                 {
@@ -690,23 +887,25 @@ bool TRACKS_CLEANER::mergeCollinearSegments( PCB_TRACK* aSeg1, PCB_TRACK* aSeg2
     {
         m_commit.Modify( aSeg1 );
         *aSeg1 = dummy_seg;
-
-        m_brd->GetConnectivity()->Update( aSeg1 );
-
-        // Merge successful, seg2 has to go away
-        m_brd->Remove( aSeg2 );
-        m_commit.Removed( aSeg2 );
     }
 
     return true;
 }
 
 
-void TRACKS_CLEANER::removeItems( std::set<BOARD_ITEM*>& aItems )
+void TRACKS_CLEANER::removeItems( const std::set<BOARD_ITEM*>& aItems )
+{
+    removeItems( std::vector<BOARD_ITEM*>( aItems.begin(), aItems.end() ) );
+}
+
+
+void TRACKS_CLEANER::removeItems( const std::vector<BOARD_ITEM*>& aItems )
 {
+    if( aItems.empty() )
+        return;
+
+    m_brd->RemoveItems( aItems );
+
     for( BOARD_ITEM* item : aItems )
-    {
-        m_brd->Remove( item );
         m_commit.Removed( item );
-    }
 }
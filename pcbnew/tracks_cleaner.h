@@ -27,6 +27,8 @@
 #include <pcb_track.h>
 #include <board.h>
 
+#include <unordered_map>
+
 class BOARD_COMMIT;
 class CLEANUP_ITEM;
 class REPORTER;
@@ -78,13 +80,25 @@ private:
     void cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegments,
                   bool aDeleteDuplicateSegments, bool aMergeSegments );
 
+    /**
+     * Merge the collinear segments of the board until no more can be merged.
+     */
+    void mergeSegments();
+
+    /**
+     * Try to merge \a aSegment with one of the segments connected to its ends.
+     * @return the segment merged into \a aSegment, or nullptr if none could be merged.
+     */
+    PCB_TRACK* mergeSegment( PCB_TRACK* aSegment );
+
     /**
      * helper function
      * merge aTrackRef and aCandidate, when possible,
      * i.e. when they are colinear, same width, and obviously same layer
      * @return true if the segments are merged, false if not
      * @param aSeg1 is the reference
-     * @param aSeg2 is the candidate, and after merging, the removed segment
+     * @param aSeg2 is the candidate, and after merging, the segment to remove.  It is flagged
+     *              IS_DELETED; removing it from the board is up to the caller.
      */
     bool mergeCollinearSegments( PCB_TRACK* aSeg1, PCB_TRACK* aSeg2 );
 
@@ -96,8 +110,18 @@ private:
      */
     bool testTrackEndpointIsNode( PCB_TRACK* aTrack, bool aTstStart );
 
-    void removeItems( std::set<BOARD_ITEM*>& aItems );
+    void removeItems( const std::set<BOARD_ITEM*>& aItems );
+    void removeItems( const std::vector<BOARD_ITEM*>& aItems );
+
+    /**
+     * Search the clusters of connected items once for all the segments of the board.
+     */
+    void buildClusterCache();
 
+    /**
+     * @return the items of the cluster holding \a aTrack.  buildClusterCache() must have been
+     *         called since the connectivity was last built.
+     */
     const std::vector<BOARD_CONNECTED_ITEM*>& getConnectedItems( PCB_TRACK* aTrack );
 
 private:
@@ -107,8 +131,9 @@ private:
     std::vector<std::shared_ptr<CLEANUP_ITEM>>* m_itemsList;    // caller owns
     REPORTER*                                   m_reporter;
 
-    // Cache connections.  O(n^2) is awful, but it beats O(2n^3).
-    std::map<PCB_TRACK*, std::vector<BOARD_CONNECTED_ITEM*>> m_connectedItemsCache;
+    // Cache of the connected clusters, shared by all the segments of a cluster
+    std::vector<std::vector<BOARD_CONNECTED_ITEM*>>          m_clusterItems;
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, size_t>  m_clusterIndex;
 };
 
 
@@ -265,6 +265,13 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
     auto connectivity = GetBoard()->GetConnectivity();
 
     GetBoard()->IncrementTimeStamp();   // clear caches
+    GetBoard()->m_AreaTestCache.Clear();
+
+    // Listeners are told about the restored items once, after all of them are restored
+    bool                     bulkNotify = GetModel() == GetBoard();
+    std::vector<BOARD_ITEM*> bulkAddedItems;
+    std::vector<BOARD_ITEM*> bulkRemovedItems;
+    std::vector<BOARD_ITEM*> itemsChanged;
 
     // Undo in the reverse order of list creation: (this can allow stacked changes
     // like the same item can be changes and deleted in the same complex command
@@ -384,13 +391,16 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
             view->Add( item );
             view->Hide( item, false );
             connectivity->Add( item );
-            item->GetBoard()->OnItemChanged( item );
+            itemsChanged.push_back( item );
             break;
         }
 
         case UNDO_REDO::NEWITEM:        /* new items are deleted */
             aList->SetPickedItemStatus( UNDO_REDO::DELETED, ii );
-            GetModel()->Remove( (BOARD_ITEM*) eda_item );
+            GetModel()->Remove( (BOARD_ITEM*) eda_item, REMOVE_MODE::BULK );
+
+            if( bulkNotify )
+                bulkRemovedItems.push_back( (BOARD_ITEM*) eda_item );
 
             if( eda_item->Type() != PCB_NETINFO_T )
                 view->Remove( eda_item );
@@ -404,7 +414,10 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
 
             eda_item->ClearFlags( UR_TRANSIENT );
 
-            GetModel()->Add( (BOARD_ITEM*) eda_item );
+            GetModel()->Add( (BOARD_ITEM*) eda_item, ADD_MODE::BULK_INSERT );
+
+            if( bulkNotify )
+                bulkAddedItems.push_back( (BOARD_ITEM*) eda_item );
 
             if( eda_item->Type() != PCB_NETINFO_T )
                 view->Add( eda_item );
@@ -479,6 +492,15 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList )
         }
     }
 
+    if( !bulkAddedItems.empty() )
+        GetBoard()->FinalizeBulkAdd( bulkAddedItems );
+
+    if( !bulkRemovedItems.empty() )
+        GetBoard()->FinalizeBulkRemove( bulkRemovedItems );
+
+    if( !itemsChanged.empty() )
+        GetBoard()->OnItemsChanged( itemsChanged );
+
     if( not_found )
         wxMessageBox( _( "Incomplete undo/redo operation: some items not found" ) );
 
@@ -30,6 +30,7 @@
 #include <pcb_screen.h>
 #include <board.h>
 #include <board_design_settings.h>
+#include <drc/drc_rtree.h>
 #include <pad.h>
 #include <zone.h>
 #include <footprint.h>
@@ -46,6 +47,7 @@ ZONE::ZONE( BOARD_ITEM_CONTAINER* aParent ) :
         BOARD_CONNECTED_ITEM( aParent, PCB_ZONE_T ),
         m_Poly( nullptr ),
         m_isFilled( false ),
+        m_isDraftFill( false ),
         m_CornerSelection( nullptr ),
         m_area( 0.0 ),
         m_outlinearea( 0.0 )
@@ -113,6 +115,10 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
     // members are expected non initialize in this.
     // InitDataFromSrcInCopyCtor() is expected to be called only from a copy constructor.
 
+    // Copies get the fill itself
+    aZone.loadFill();
+    m_lazyFill.reset();
+
     // Copy only useful EDA_ITEM flags:
     m_flags                   = aZone.m_flags;
     m_forceVisible            = aZone.m_forceVisible;
@@ -142,6 +148,7 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
     m_minIslandArea           = aZone.m_minIslandArea;
 
     m_isFilled                = aZone.m_isFilled;
+    m_isDraftFill             = aZone.m_isDraftFill;
     m_needRefill              = aZone.m_needRefill;
     m_teardropType            = aZone.m_teardropType;
 
@@ -163,10 +170,11 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
 
     for( PCB_LAYER_ID layer : aZone.GetLayerSet().Seq() )
     {
-        std::shared_ptr<SHAPE_POLY_SET> fill = aZone.m_FilledPolysList.at( layer );
+        const std::shared_ptr<SHAPE_POLY_SET>& fill = aZone.m_FilledPolysList.at( layer );
 
+        // Shared until either zone changes it, as most copies never do
         if( fill )
-            m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>( *fill );
+            m_FilledPolysList[layer] = fill;
         else
             m_FilledPolysList[layer] = std::make_shared<SHAPE_POLY_SET>();
 
@@ -174,6 +182,8 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
         m_insulatedIslands[layer] = aZone.m_insulatedIslands.at( layer );
     }
 
+    m_fillInputHashes         = aZone.m_fillInputHashes;
+
     m_borderStyle             = aZone.m_borderStyle;
     m_borderHatchPitch        = aZone.m_borderHatchPitch;
     m_borderHatchLines        = aZone.m_borderHatchLines;
@@ -186,6 +196,30 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
 }
 
 
+void ZONE::SetLazyFill( std::function<void( ZONE& aZone )> aLoader )
+{
+    m_lazyFill = std::make_unique<LAZY_FILL>();
+    m_lazyFill->m_loader = std::move( aLoader );
+}
+
+
+void ZONE::loadLazyFill() const
+{
+    std::lock_guard<std::recursive_mutex> lock( m_lazyFill->m_mutex );
+
+    // Loaded by another thread meanwhile, or being loaded by this one
+    if( !m_lazyFill->m_loader )
+        return;
+
+    std::function<void( ZONE& )> loader = std::move( m_lazyFill->m_loader );
+    m_lazyFill->m_loader = nullptr;
+
+    loader( const_cast<ZONE&>( *this ) );
+
+    m_lazyFill->m_loaded.store( true, std::memory_order_release );
+}
+
+
 EDA_ITEM* ZONE::Clone() const
 {
     return new ZONE( *this );
@@ -217,17 +251,28 @@ bool ZONE::SameNet( const ZONE* aOther ) const
 
 bool ZONE::UnFill()
 {
-    bool change = false;
+    bool change = HasLazyFill();
+
+    m_lazyFill.reset();
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
     {
         change |= !pair.second->IsEmpty();
         m_insulatedIslands[pair.first].clear();
-        pair.second->RemoveAllContours();
+
+        if( pair.second.use_count() > 1 )
+            pair.second = std::make_shared<SHAPE_POLY_SET>();
+        else
+            pair.second->RemoveAllContours();
     }
 
     m_isFilled = false;
+    m_isDraftFill = false;
     m_fillFlags.reset();
+    m_fillRTree.reset();
+    m_fillRTreeSources.clear();
+    m_removedIslands.clear();
+    m_fillInputHashes.clear();
 
     return change;
 }
@@ -417,6 +462,8 @@ static SHAPE_POLY_SET g_nullPoly;
 
 MD5_HASH ZONE::GetHashValue( PCB_LAYER_ID aLayer )
 {
+    loadFill();
+
     if( !m_filledPolysHash.count( aLayer ) )
         return g_nullPoly.GetHash();
     else
@@ -426,6 +473,8 @@ MD5_HASH ZONE::GetHashValue( PCB_LAYER_ID aLayer )
 
 void ZONE::BuildHashValue( PCB_LAYER_ID aLayer )
 {
+    loadFill();
+
     if( !m_FilledPolysList.count( aLayer ) )
         m_filledPolysHash[aLayer] = g_nullPoly.GetHash();
     else
@@ -433,6 +482,106 @@ void ZONE::BuildHashValue( PCB_LAYER_ID aLayer )
 }
 
 
+std::shared_ptr<DRC_RTREE> ZONE::BuildFillRTree()
+{
+    loadFill();
+
+    std::shared_ptr<DRC_RTREE> rtree = std::make_shared<DRC_RTREE>();
+
+    m_fillRTreeSources.clear();
+
+    for( PCB_LAYER_ID layer : GetLayerSet().Seq() )
+    {
+        if( !IsCopperLayer( layer ) )
+            continue;
+
+        rtree->Insert( this, layer );
+
+        if( m_FilledPolysList.count( layer ) )
+        {
+            const SHAPE_POLY_SET* fill = m_FilledPolysList.at( layer ).get();
+
+            m_fillRTreeSources[layer] = { fill, fill->GetHash(), fill->GetTriangulationSerial() };
+        }
+    }
+
+    rtree->Build();
+    m_fillRTree = rtree;
+
+    return rtree;
+}
+
+
+std::shared_ptr<DRC_RTREE> ZONE::GetFillRTree() const
+{
+    loadFill();
+
+    if( !m_fillRTree )
+        return nullptr;
+
+    size_t layers = 0;
+
+    for( PCB_LAYER_ID layer : GetLayerSet().Seq() )
+    {
+        if( !IsCopperLayer( layer ) || !m_FilledPolysList.count( layer ) )
+            continue;
+
+        const SHAPE_POLY_SET* fill = m_FilledPolysList.at( layer ).get();
+        auto                  it = m_fillRTreeSources.find( layer );
+
+        if( it == m_fillRTreeSources.end() || it->second.m_fill != fill
+                || it->second.m_triangulation != fill->GetTriangulationSerial()
+                || !fill->IsTriangulationUpToDate() || it->second.m_hash != fill->GetHash() )
+        {
+            return nullptr;
+        }
+
+        layers++;
+    }
+
+    if( layers != m_fillRTreeSources.size() )
+        return nullptr;
+
+    return m_fillRTree;
+}
+
+
+void ZONE::SetRemovedIslands( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aIslands )
+{
+    loadFill();
+
+    auto it = m_FilledPolysList.find( aLayer );
+
+    if( it == m_FilledPolysList.end() )
+    {
+        m_removedIslands.erase( aLayer );
+        return;
+    }
+
+    m_removedIslands[aLayer] = { it->second->GetHash(), aIslands.CloneDropTriangulation() };
+}
+
+
+const SHAPE_POLY_SET* ZONE::GetRemovedIslands( PCB_LAYER_ID aLayer ) const
+{
+    loadFill();
+
+    auto islandsIt = m_removedIslands.find( aLayer );
+    auto fillIt = m_FilledPolysList.find( aLayer );
+
+    if( islandsIt == m_removedIslands.end() || fillIt == m_FilledPolysList.end() )
+        return nullptr;
+
+    const SHAPE_POLY_SET* fill = fillIt->second.get();
+
+    // As for the rtree, a fill hash is only current once the fill is triangulated
+    if( !fill->IsTriangulationUpToDate() || fill->GetHash() != islandsIt->second.m_fillHash )
+        return nullptr;
+
+    return &islandsIt->second.m_islands;
+}
+
+
 bool ZONE::HitTest( const VECTOR2I& aPosition, int aAccuracy ) const
 {
     // When looking for an "exact" hit aAccuracy will be 0 which works poorly for very thin
@@ -477,20 +626,32 @@ bool ZONE::HitTest( const BOX2I& aRect, bool aContained, int aAccuracy ) const
         if( !arect.Intersects( bbox ) )
             return false;
 
-        int count = m_Poly->TotalVertices();
-
-        for( int ii = 0; ii < count; ii++ )
+        // Walk the contours rather than the global vertex indices, which are found by counting
+        // from the first vertex each time.  Outlines and holes away from the rect are skipped
+        // by their bounding box.
+        for( const SHAPE_POLY_SET::POLYGON& polygon : m_Poly->CPolygons() )
         {
-            VECTOR2I vertex = m_Poly->CVertex( ii );
-            VECTOR2I vertexNext = m_Poly->CVertex( ( ii + 1 ) % count );
+            for( const SHAPE_LINE_CHAIN& contour : polygon )
+            {
+                if( contour.PointCount() == 0 || !arect.Intersects( contour.BBox() ) )
+                    continue;
 
-            // Test if the point is within the rect
-            if( arect.Contains( vertex ) )
-                return true;
+                int count = contour.PointCount();
 
-            // Test if this edge intersects the rect
-            if( arect.Intersects( vertex, vertexNext ) )
-                return true;
+                for( int ii = 0; ii < count; ii++ )
+                {
+                    const VECTOR2I& vertex = contour.CPoint( ii );
+                    const VECTOR2I& vertexNext = contour.CPoint( ( ii + 1 ) % count );
+
+                    // Test if the point is within the rect
+                    if( arect.Contains( vertex ) )
+                        return true;
+
+                    // Test if this edge intersects the rect
+                    if( arect.Intersects( vertex, vertexNext ) )
+                        return true;
+                }
+            }
         }
 
         return false;
@@ -512,6 +673,8 @@ int ZONE::GetLocalClearance( wxString* aSource ) const
 
 bool ZONE::HitTestFilledArea( PCB_LAYER_ID aLayer, const VECTOR2I& aRefPos, int aAccuracy ) const
 {
+    loadFill();
+
     // Rule areas have no filled area, but it's generally nice to treat their interior as if it were
     // filled so that people don't have to select them by their outline (which is min-width)
     if( GetIsRuleArea() )
@@ -532,7 +695,7 @@ bool ZONE::HitTestCutout( const VECTOR2I& aRefPos, int* aOutlineIdx, int* aHoleI
     {
         for( int j = 0; j < m_Poly->HoleCount( i ); j++ )
         {
-            if( m_Poly->Hole( i, j ).PointInside( aRefPos ) )
+            if( m_Poly->CHole( i, j ).PointInside( aRefPos ) )
             {
                 if( aOutlineIdx )
                     *aOutlineIdx = i;
@@ -551,6 +714,8 @@ bool ZONE::HitTestCutout( const VECTOR2I& aRefPos, int* aOutlineIdx, int* aHoleI
 
 void ZONE::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>& aList )
 {
+    loadFill();
+
     wxString msg = GetFriendlyName();
 
     // Display Cutout instead of Outline for holes inside a zone (i.e. when num contour !=0).
@@ -673,6 +838,8 @@ void ZONE::GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>&
 
 void ZONE::Move( const VECTOR2I& offset )
 {
+    loadFill();
+
     /* move outlines */
     m_Poly->Move( offset );
 
@@ -680,7 +847,10 @@ void ZONE::Move( const VECTOR2I& offset )
 
     /* move fills */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
+    {
+        unshareFill( pair.second );
         pair.second->Move( offset );
+    }
 
     /*
      * move boundingbox cache
@@ -728,17 +898,24 @@ void ZONE::MoveEdge( const VECTOR2I& offset, int aEdge )
 
 void ZONE::Rotate( const VECTOR2I& aCentre, const EDA_ANGLE& aAngle )
 {
+    loadFill();
+
     m_Poly->Rotate( aAngle, aCentre );
     HatchBorder();
 
     /* rotate filled areas: */
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
+    {
+        unshareFill( pair.second );
         pair.second->Rotate( aAngle, aCentre );
+    }
 }
 
 
 void ZONE::Flip( const VECTOR2I& aCentre, bool aFlipLeftRight )
 {
+    loadFill();
+
     Mirror( aCentre, aFlipLeftRight );
 
     std::map<PCB_LAYER_ID, SHAPE_POLY_SET> fillsCopy;
@@ -760,12 +937,17 @@ void ZONE::Flip( const VECTOR2I& aCentre, bool aFlipLeftRight )
 
 void ZONE::Mirror( const VECTOR2I& aMirrorRef, bool aMirrorLeftRight )
 {
+    loadFill();
+
     m_Poly->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
 
     HatchBorder();
 
     for( std::pair<const PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>>& pair : m_FilledPolysList )
+    {
+        unshareFill( pair.second );
         pair.second->Mirror( aMirrorLeftRight, !aMirrorLeftRight, aMirrorRef );
+    }
 }
 
 
@@ -775,7 +957,7 @@ void ZONE::RemoveCutout( int aOutlineIdx, int aHoleIdx )
     if( m_Poly->OutlineCount() < aOutlineIdx || m_Poly->HoleCount( aOutlineIdx ) < aHoleIdx )
         return;
 
-    SHAPE_POLY_SET cutPoly( m_Poly->Hole( aOutlineIdx, aHoleIdx ) );
+    SHAPE_POLY_SET cutPoly( m_Poly->CHole( aOutlineIdx, aHoleIdx ) );
 
     // Add the cutout back to the zone
     m_Poly->BooleanAdd( cutPoly, SHAPE_POLY_SET::PM_FAST );
@@ -941,7 +1123,7 @@ void ZONE::HatchBorder()
     int min_y = m_Poly->CVertex( 0 ).y;
     int max_y = m_Poly->CVertex( 0 ).y;
 
-    for( auto iterator = m_Poly->IterateWithHoles(); iterator; iterator++ )
+    for( auto iterator = m_Poly->CIterateWithHoles(); iterator; iterator++ )
     {
         if( iterator->x < min_x )
             min_x = iterator->x;
@@ -1010,7 +1192,7 @@ void ZONE::HatchBorder()
             pointbuffer.clear();
 
             // Iterate through all vertices
-            for( auto iterator = m_Poly->IterateSegmentsWithHoles(); iterator; iterator++ )
+            for( auto iterator = m_Poly->CIterateSegmentsWithHoles(); iterator; iterator++ )
             {
                 const SEG seg = *iterator;
                 double    x, y;
@@ -1087,23 +1269,40 @@ void ZONE::swapData( BOARD_ITEM* aImage )
 
 void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
 {
+    loadFill();
+
     if( aLayer == UNDEFINED_LAYER )
     {
         for( auto& [ layer, poly ] : m_FilledPolysList )
+        {
+            if( !poly->IsTriangulationUpToDate() )
+                unshareFill( poly );
+
             poly->CacheTriangulation();
+        }
 
         m_Poly->CacheTriangulation( false );
     }
     else
     {
-        if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ]->CacheTriangulation();
+        auto it = m_FilledPolysList.find( aLayer );
+
+        if( it != m_FilledPolysList.end() )
+        {
+            // A shared fill may be triangulated by another thread for another zone
+            if( !it->second->IsTriangulationUpToDate() )
+                unshareFill( it->second );
+
+            it->second->CacheTriangulation();
+        }
     }
 }
 
 
 bool ZONE::IsIsland( PCB_LAYER_ID aLayer, int aPolyIdx ) const
 {
+    loadFill();
+
     if( GetNetCode() < 1 )
         return true;
 
@@ -1299,6 +1498,8 @@ bool ZONE::BuildSmoothedPoly( SHAPE_POLY_SET& aSmoothedPoly, PCB_LAYER_ID aLayer
 
 double ZONE::CalculateFilledArea()
 {
+    loadFill();
+
     m_area = 0.0;
 
     // Iterate over each outline polygon in the zone and then iterate over
@@ -1309,10 +1510,10 @@ double ZONE::CalculateFilledArea()
 
         for( int i = 0; i < poly->OutlineCount(); i++ )
         {
-            m_area += poly->Outline( i ).Area();
+            m_area += poly->COutline( i ).Area();
 
             for( int j = 0; j < poly->HoleCount( i ); j++ )
-                m_area -= poly->Hole( i, j ).Area();
+                m_area -= poly->CHole( i, j ).Area();
         }
     }
 
@@ -1360,6 +1561,8 @@ void ZONE::TransformSmoothedOutlineToPolygon( SHAPE_POLY_SET& aBuffer, int aClea
 
 std::shared_ptr<SHAPE> ZONE::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING aFlash ) const
 {
+    loadFill();
+
     if( m_FilledPolysList.find( aLayer ) == m_FilledPolysList.end() )
         return std::make_shared<SHAPE_NULL>();
     else
@@ -1370,6 +1573,8 @@ std::shared_ptr<SHAPE> ZONE::GetEffectiveShape( PCB_LAYER_ID aLayer, FLASHING aF
 void ZONE::TransformShapeToPolygon( SHAPE_POLY_SET& aBuffer, PCB_LAYER_ID aLayer, int aClearance,
                                     int aError, ERROR_LOC aErrorLoc, bool aIgnoreLineWidth ) const
 {
+    loadFill();
+
     wxASSERT_MSG( !aIgnoreLineWidth, wxT( "IgnoreLineWidth has no meaning for zones." ) );
 
     if( !m_FilledPolysList.count( aLayer ) )
@@ -1399,6 +1604,8 @@ void ZONE::TransformShapeToPolygon( SHAPE_POLY_SET& aBuffer, PCB_LAYER_ID aLayer
 
 void ZONE::TransformSolidAreasShapesToPolygon( PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aBuffer ) const
 {
+    loadFill();
+
     if( m_FilledPolysList.count( aLayer ) && !m_FilledPolysList.at( aLayer )->IsEmpty() )
         aBuffer.Append( *m_FilledPolysList.at( aLayer ) );
 }
@@ -26,6 +26,8 @@
 #define ZONE_H
 
 
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <vector>
 #include <gr_basic.h>
@@ -40,6 +42,7 @@
 class LINE_READER;
 class PCB_EDIT_FRAME;
 class BOARD;
+class DRC_RTREE;
 class ZONE;
 class MSG_PANEL_ITEM;
 
@@ -221,6 +224,7 @@ public:
      */
     double GetFilledArea()
     {
+        loadFill();
         return m_area;
     }
 
@@ -249,6 +253,13 @@ public:
     bool IsFilled() const { return m_isFilled; }
     void SetIsFilled( bool isFilled ) { m_isFilled = isFilled; }
 
+    /**
+     * Draft fills are quick approximations made while editing (see ZONE_FILLER::SetDraft()),
+     * to be replaced by a full-precision fill before the board is saved or checked by DRC.
+     */
+    bool IsDraftFill() const { return m_isDraftFill; }
+    void SetIsDraftFill( bool aDraft ) { m_isDraftFill = aDraft; }
+
     bool NeedRefill() const { return m_needRefill; }
     void SetNeedRefill( bool aNeedRefill ) { m_needRefill = aNeedRefill; }
 
@@ -606,22 +617,35 @@ public:
 
     bool HasFilledPolysForLayer( PCB_LAYER_ID aLayer ) const
     {
+        loadFill();
         return m_FilledPolysList.count( aLayer ) > 0;
     }
 
     /**
      * @return a reference to the list of filled polygons.
+     *
+     * @note Copies of a zone share its fills until either one changes them, so the fill must
+     *       not be modified through the returned pointer.  Use GetFill() for that.
      */
     const std::shared_ptr<SHAPE_POLY_SET>& GetFilledPolysList( PCB_LAYER_ID aLayer ) const
     {
+        loadFill();
         wxASSERT( m_FilledPolysList.count( aLayer ) );
         return m_FilledPolysList.at( aLayer );
     }
 
+    /**
+     * @return the filled polygons of a layer, to be modified in place.  A fill shared with
+     *         copies of the zone is copied first.
+     */
     SHAPE_POLY_SET* GetFill( PCB_LAYER_ID aLayer )
     {
+        loadFill();
         wxASSERT( m_FilledPolysList.count( aLayer ) );
-        return m_FilledPolysList.at( aLayer ).get();
+
+        std::shared_ptr<SHAPE_POLY_SET>& fill = m_FilledPolysList.at( aLayer );
+        unshareFill( fill );
+        return fill.get();
     }
 
     /**
@@ -635,9 +659,28 @@ public:
      */
     void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
     {
+        loadFill();
         m_FilledPolysList[aLayer] = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
+    /**
+     * Postpone the creation of the filled polygons until they are first accessed.  File readers
+     * use it to skip parsing fills which are never looked at.
+     *
+     * @param aLoader is called once, from the first thread to access the fill, to set it with
+     *                SetFilledPolysList() and SetIsIsland().  It is dropped unused if the zone
+     *                is unfilled first.
+     */
+    void SetLazyFill( std::function<void( ZONE& aZone )> aLoader );
+
+    /**
+     * @return true if the fill is still to be loaded by the loader given to SetLazyFill().
+     */
+    bool HasLazyFill() const
+    {
+        return m_lazyFill && !m_lazyFill->m_loaded.load( std::memory_order_acquire );
+    }
+
     /**
      * Check if a given filled polygon is an insulated island.
      *
@@ -649,6 +692,7 @@ public:
 
     void SetIsIsland( PCB_LAYER_ID aLayer, int aPolyIdx )
     {
+        loadFill();
         m_insulatedIslands[aLayer].insert( aPolyIdx );
     }
 
@@ -784,6 +828,55 @@ public:
      */
     MD5_HASH GetHashValue( PCB_LAYER_ID aLayer );
 
+    /**
+     * Build the DRC spatial index of the copper fill, and keep it with the fill.  The zone
+     * filler does it as it fills, so that DRC doesn't have to.  The fill must be triangulated
+     * (see CacheTriangulation()).
+     */
+    std::shared_ptr<DRC_RTREE> BuildFillRTree();
+
+    /**
+     * @return the index built by BuildFillRTree(), or nullptr if the fill changed since: it
+     *         is only valid for the same fill polygons, with the same contents (checked with
+     *         their hash) and the same triangles.
+     */
+    std::shared_ptr<DRC_RTREE> GetFillRTree() const;
+
+    /**
+     * Keep the islands the filler removed from the fill of \a aLayer, so that a refill of part
+     * of the zone can re-evaluate the ones it touches.  The record only holds for the current
+     * fill of the layer.
+     */
+    void SetRemovedIslands( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aIslands );
+
+    /**
+     * @return the islands recorded by SetRemovedIslands(), or nullptr if the fill of \a aLayer
+     *         changed since.
+     */
+    const SHAPE_POLY_SET* GetRemovedIslands( PCB_LAYER_ID aLayer ) const;
+
+    /**
+     * Keep the hash of everything the fill of \a aLayer was built from, see ZONE_FILL_HASHER.
+     * It is saved with the fill, so that a loaded board can tell whether its fills are still
+     * valid.
+     */
+    void SetFillInputHash( PCB_LAYER_ID aLayer, const std::string& aHash )
+    {
+        m_fillInputHashes[aLayer] = aHash;
+    }
+
+    /**
+     * @return the hash set by SetFillInputHash(), or an empty string if the fill of \a aLayer
+     *         was built (or loaded) without one.
+     */
+    const std::string& GetFillInputHash( PCB_LAYER_ID aLayer ) const
+    {
+        static const std::string empty;
+
+        auto it = m_fillInputHashes.find( aLayer );
+        return it == m_fillInputHashes.end() ? empty : it->second;
+    }
+
     double Similarity( const BOARD_ITEM& aOther ) const override;
 
     bool operator==( const BOARD_ITEM& aOther ) const override;
@@ -802,6 +895,29 @@ public:
 protected:
     virtual void swapData( BOARD_ITEM* aImage ) override;
 
+    /**
+     * Run the loader given to SetLazyFill(), if it hasn't run yet.  Everything which reads or
+     * changes the fill calls it first.
+     */
+    void loadFill() const
+    {
+        if( HasLazyFill() )
+            loadLazyFill();
+    }
+
+    void loadLazyFill() const;
+
+    /**
+     * Give the zone its own copy of a fill it shares with copies of the zone, before changing
+     * it.  Sharing the fills keeps the copies made for undo and for the commits cheap.
+     */
+    static void unshareFill( std::shared_ptr<SHAPE_POLY_SET>& aFill )
+    {
+        if( aFill.use_count() > 1 )
+            aFill = std::make_shared<SHAPE_POLY_SET>( *aFill );
+    }
+
+
 protected:
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
@@ -854,6 +970,9 @@ protected:
     /** True when a zone was filled, false after deleting the filled areas. */
     bool             m_isFilled;
 
+    /** True when the fill is a draft fill. */
+    bool             m_isDraftFill;
+
     /**
      * False when a zone was refilled, true after changes in zone params.
      * m_needRefill = false does not imply filled areas are up to date, just
@@ -895,7 +1014,8 @@ protected:
      * as m_Poly.  In less simple cases (when m_Poly has holes) m_FilledPolysList is
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
-     * described by m_Poly can have many filled areas
+     * described by m_Poly can have many filled areas.
+     * Copies of the zone share these polygons, see unshareFill().
      */
     std::map<PCB_LAYER_ID, std::shared_ptr<SHAPE_POLY_SET>> m_FilledPolysList;
 
@@ -905,6 +1025,31 @@ protected:
     /// A hash value used in zone filling calculations to see if the filled areas are up to date
     std::map<PCB_LAYER_ID, MD5_HASH>       m_filledPolysHash;
 
+    struct FILL_RTREE_SOURCE
+    {
+        const SHAPE_POLY_SET* m_fill;
+        MD5_HASH              m_hash;
+        uint64_t              m_triangulation;
+    };
+
+    /// DRC spatial index of the copper fill, and the fill it was built from.  Never copied, as
+    /// it points to this zone.
+    std::shared_ptr<DRC_RTREE>                    m_fillRTree;
+    std::map<PCB_LAYER_ID, FILL_RTREE_SOURCE>     m_fillRTreeSources;
+
+    struct REMOVED_ISLANDS
+    {
+        MD5_HASH       m_fillHash;
+        SHAPE_POLY_SET m_islands;
+    };
+
+    /// Islands removed from the fills, and the hash of the fill they were removed from.  Not
+    /// copied either.
+    std::map<PCB_LAYER_ID, REMOVED_ISLANDS>       m_removedIslands;
+
+    /// Hashes of the inputs of the fills (MD5_HASH::Format() digests), by layer
+    std::map<PCB_LAYER_ID, std::string>           m_fillInputHashes;
+
     ZONE_BORDER_DISPLAY_STYLE m_borderStyle;       // border display style, see enum above
     int                       m_borderHatchPitch;  // for DIAGONAL_EDGE, distance between 2 lines
     std::vector<SEG>          m_borderHatchLines;  // hatch lines
@@ -917,6 +1062,17 @@ protected:
 
     /// Lock used for multi-threaded filling on multi-layer zones
     std::mutex m_lock;
+
+    struct LAZY_FILL
+    {
+        /// Recursive, as the loader sets the fill through the same accessors which load it
+        std::recursive_mutex         m_mutex;
+        std::function<void( ZONE& )> m_loader;
+        std::atomic<bool>            m_loaded{ false };
+    };
+
+    /// The fill still to be parsed, see SetLazyFill().  Never copied.
+    std::unique_ptr<LAZY_FILL> m_lazyFill;
 };
 
 
@@ -0,0 +1,236 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <vector>
+
+#include <advanced_config.h>
+#include <board.h>
+#include <board_design_settings.h>
+#include <build_version.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_rule.h>
+#include <footprint.h>
+#include <md5_hash.h>
+#include <netinfo.h>
+#include <pad.h>
+#include <pcb_track.h>
+#include <project/net_settings.h>
+#include <zone.h>
+
+#include "zone_fill_hasher.h"
+
+
+/// Bumped whenever the filler changes in a way which changes fills
+static const int FILL_HASH_VERSION = 1;
+
+
+static std::string digest( const std::vector<std::string>& aParts )
+{
+    MD5_HASH hash;
+
+    for( const std::string& part : aParts )
+    {
+        hash.Hash( (uint8_t*) part.data(), (uint32_t) part.size() );
+
+        // Keep the parts apart, so that moving characters between them changes the hash
+        hash.Hash( (int) part.size() );
+    }
+
+    hash.Finalize();
+
+    return hash.Format( true );
+}
+
+
+ZONE_FILL_HASHER::ZONE_FILL_HASHER( BOARD* aBoard ) :
+        m_board( aBoard ),
+        m_io( CTL_FOR_BOARD | CTL_OMIT_FILLS ),
+        m_margin( 0 )
+{
+    BOARD_DESIGN_SETTINGS&   bds = m_board->GetDesignSettings();
+    std::vector<std::string> parts;
+
+    parts.push_back( std::to_string( FILL_HASH_VERSION ) );
+    parts.push_back( GetMajorMinorVersion().ToStdString() );
+    parts.push_back( bds.FormatAsString() );
+    parts.push_back( m_board->GetEnabledLayers().FmtHex() );
+
+    if( bds.m_DRCEngine )
+        parts.push_back( std::to_string( bds.m_DRCEngine->GetRulesFileHash() ) );
+
+    if( bds.m_NetSettings )
+        parts.push_back( bds.m_NetSettings->FormatAsString() );
+
+    m_formatter.Clear();
+    bds.GetStackupDescriptor().FormatBoardStackup( &m_formatter, m_board, 0 );
+    parts.push_back( m_formatter.GetString() );
+
+    // Zones and pads only store net codes
+    for( NETINFO_ITEM* net : m_board->GetNetInfo() )
+        parts.push_back( std::to_string( net->GetNetCode() ) + net->GetNetname().ToStdString() );
+
+    // Fills are clipped to the board outline
+    for( BOARD_ITEM* item : m_board->Drawings() )
+    {
+        if( item->IsOnLayer( Edge_Cuts ) || item->IsOnLayer( Margin ) )
+            parts.push_back( hashItem( item ) );
+    }
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( BOARD_ITEM* item : footprint->GraphicalItems() )
+        {
+            if( item->IsOnLayer( Edge_Cuts ) || item->IsOnLayer( Margin ) )
+                parts.push_back( hashItem( item ) );
+        }
+    }
+
+    m_signature = digest( parts );
+
+    // How far items may be from a zone and still change its fill: as far as the filler looks
+    // for knockouts, and thermal reliefs reach
+    int            worstThermalGap = 0;
+    DRC_CONSTRAINT constraint;
+
+    if( bds.m_DRCEngine
+            && bds.m_DRCEngine->QueryWorstConstraint( THERMAL_RELIEF_GAP_CONSTRAINT, constraint ) )
+    {
+        worstThermalGap = constraint.GetValue().Min();
+    }
+
+    for( ZONE* zone : m_board->Zones() )
+        worstThermalGap = std::max( worstThermalGap, zone->GetThermalReliefGap() );
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            worstThermalGap = std::max( worstThermalGap, pad->GetThermalGap() );
+    }
+
+    m_margin = m_board->GetMaxClearanceValue() + 2 * worstThermalGap + bds.m_MaxError
+               + pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+}
+
+
+const std::string& ZONE_FILL_HASHER::hashItem( const BOARD_ITEM* aItem )
+{
+    auto it = m_itemHashes.find( aItem );
+
+    if( it != m_itemHashes.end() )
+        return it->second;
+
+    m_formatter.Clear();
+    m_io.SetOutputFormatter( &m_formatter );
+    m_io.Format( aItem );
+
+    return m_itemHashes[aItem] = digest( { m_formatter.GetString() } );
+}
+
+
+std::string ZONE_FILL_HASHER::GetHash( const ZONE* aZone, PCB_LAYER_ID aLayer )
+{
+    auto cached = m_zoneHashes.find( { aZone, aLayer } );
+
+    if( cached != m_zoneHashes.end() )
+        return cached->second;
+
+    BOX2I envelope = aZone->GetBoundingBox();
+    envelope.Inflate( m_margin + aZone->GetMinThickness() );
+
+    std::vector<std::string> items;
+    std::vector<std::string> parts;
+
+    auto addZone =
+            [&]( const ZONE* aOther )
+            {
+                if( aOther == aZone || !aOther->GetBoundingBox().Intersects( envelope ) )
+                    return;
+
+                items.push_back( hashItem( aOther ) );
+
+                // A fill knocks out the fills of the higher priority zones of other nets, so
+                // it depends on whatever they do
+                if( !aOther->GetIsRuleArea() && aOther->IsOnLayer( aLayer )
+                        && !aOther->SameNet( aZone ) && aOther->HigherPriority( aZone ) )
+                {
+                    items.push_back( GetHash( aOther, aLayer ) );
+                }
+            };
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        // Vias are drilled through the layers they don't flash on
+        if( track->Type() != PCB_VIA_T && !track->IsOnLayer( aLayer ) )
+            continue;
+
+        if( track->GetBoundingBox().Intersects( envelope ) )
+            items.push_back( hashItem( track ) );
+    }
+
+    for( FOOTPRINT* footprint : m_board->Footprints() )
+    {
+        if( footprint->GetBoundingBox().Intersects( envelope ) )
+            items.push_back( hashItem( footprint ) );
+
+        for( ZONE* zone : footprint->Zones() )
+            addZone( zone );
+    }
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+    {
+        if( item->IsOnLayer( aLayer ) && item->GetBoundingBox().Intersects( envelope ) )
+            items.push_back( hashItem( item ) );
+    }
+
+    for( ZONE* zone : m_board->Zones() )
+        addZone( zone );
+
+    // Item order isn't kept by edits, nor by saving and loading
+    std::sort( items.begin(), items.end() );
+
+    parts.push_back( m_signature );
+    parts.push_back( LSET::Name( aLayer ).ToStdString() );
+    parts.push_back( hashItem( aZone ) );
+    parts.insert( parts.end(), items.begin(), items.end() );
+
+    return m_zoneHashes[{ aZone, aLayer }] = digest( parts );
+}
+
+
+bool ZONE_FILL_HASHER::IsUpToDate( const ZONE* aZone )
+{
+    // Rule areas and degenerate zones are never filled, so there is nothing to refill
+    if( aZone->GetIsRuleArea() || aZone->GetNumCorners() <= 2 )
+        return true;
+
+    if( !aZone->IsFilled() )
+        return false;
+
+    for( PCB_LAYER_ID layer : aZone->GetLayerSet().Seq() )
+    {
+        const std::string& stored = aZone->GetFillInputHash( layer );
+
+        if( stored.empty() || stored != GetHash( aZone, layer ) )
+            return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,85 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef ZONE_FILL_HASHER_H
+#define ZONE_FILL_HASHER_H
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include <layer_ids.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <richio.h>
+
+class BOARD;
+class BOARD_ITEM;
+class ZONE;
+
+
+/**
+ * Hashes of the inputs of zone fills, which ZONE::SetFillInputHash() keeps with the fills so
+ * that a loaded board can tell which of its fills are still valid.
+ *
+ * The hash of a zone layer covers the zone itself, the board settings and rules, the stackup,
+ * the nets, the board outline, the items which may be knocked out of the layer (those near the
+ * zone), and the hashes of the higher priority zones whose fills it knocks out.  Items are
+ * hashed in the board file format, without the zone fills, so that anything which may change a
+ * fill changes its hash.  Some of the changes which don't (e.g. to a footprint's fields) do too,
+ * which only costs a refill.
+ *
+ * Hashes are MD5 digests.  They depend on the KiCad version, so that fills from another version
+ * are refilled, as its filler may behave differently.
+ */
+class ZONE_FILL_HASHER
+{
+public:
+    ZONE_FILL_HASHER( BOARD* aBoard );
+
+    /**
+     * @return the hash of everything the fill of \a aZone on \a aLayer depends on.
+     */
+    std::string GetHash( const ZONE* aZone, PCB_LAYER_ID aLayer );
+
+    /**
+     * @return true if \a aZone is filled, and was filled on all of its layers from the inputs
+     *         it has now.  Also true for the zones which are never filled (rule areas and
+     *         degenerate zones).
+     */
+    bool IsUpToDate( const ZONE* aZone );
+
+private:
+    /**
+     * @return the digest of \a aItem in the board file format, without the zone fills.
+     */
+    const std::string& hashItem( const BOARD_ITEM* aItem );
+
+    BOARD*                                                      m_board;
+    PCB_IO_KICAD_SEXPR                                          m_io;
+    STRING_FORMATTER                                            m_formatter;
+
+    std::string                                                 m_signature;
+    int                                                         m_margin;
+
+    std::map<const BOARD_ITEM*, std::string>                    m_itemHashes;
+    std::map<std::pair<const ZONE*, PCB_LAYER_ID>, std::string> m_zoneHashes;
+};
+
+#endif // ZONE_FILL_HASHER_H
@@ -23,7 +23,11 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <condition_variable>
+#include <functional>
 #include <future>
+#include <tuple>
 #include <core/kicad_algo.h>
 #include <advanced_config.h>
 #include <board.h>
@@ -40,12 +44,18 @@
 #include <board_commit.h>
 #include <progress_reporter.h>
 #include <geometry/shape_poly_set.h>
+#include <geometry/shape_rect.h>
+#include <geometry/shape_segment.h>
 #include <geometry/convex_hull.h>
+#include <geometry/geometry_arena.h>
 #include <geometry/geometry_utils.h>
+#include <geometry/packed_rtree.h>
 #include <confirm.h>
 #include <core/thread_pool.h>
+#include <core/trace_profiler.h>
 #include <math/util.h>      // for KiROUND
 #include "zone_filler.h"
+#include "zone_fill_hasher.h"
 #include "pcb_dimension.h"
 
 
@@ -55,7 +65,10 @@ ZONE_FILLER::ZONE_FILLER(  BOARD* aBoard, COMMIT* aCommit ) :
         m_commit( aCommit ),
         m_progressReporter( nullptr ),
         m_maxError( ARC_HIGH_DEF ),
-        m_worstClearance( 0 )
+        m_worstClearance( 0 ),
+        m_worstThermalGap( 0 ),
+        m_skipUpToDate( false ),
+        m_draft( false )
 {
     // To enable add "DebugZoneFiller=1" to kicad_advanced settings file.
     m_debugZoneFiller = ADVANCED_CFG::GetCfg().m_DebugZoneFiller;
@@ -87,19 +100,60 @@ void ZONE_FILLER::SetProgressReporter( PROGRESS_REPORTER* aReporter )
  */
 bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aParent )
 {
+    TRACE_SCOPE( "Zone fill" );
+
+    // Don't spin on the lock while a background ratsnest update holds it
+    m_board->GetConnectivity()->WaitForRatsnest();
+
     std::lock_guard<KISPINLOCK> lock( m_board->GetConnectivity()->GetLock() );
 
     std::vector<std::pair<ZONE*, PCB_LAYER_ID>>               toFill;
     std::map<std::pair<ZONE*, PCB_LAYER_ID>, MD5_HASH>        oldFillHashes;
     std::map<ZONE*, std::map<PCB_LAYER_ID, ISOLATED_ISLANDS>> isolatedIslandsMap;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, PARTIAL_REFILL>  partialRefills;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, SHAPE_POLY_SET>  removedIslands;
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, std::string>     fillInputHashes;
 
     std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
 
     // Rebuild (from scratch, ignoring dirty flags) just in case. This really needs to be reliable.
-    connectivity->ClearRatsnest();
-    connectivity->Build( m_board, m_progressReporter );
+    // It is only used to find islands, which draft fills keep.
+    if( !m_draft )
+    {
+        connectivity->ClearRatsnest();
+        connectivity->Build( m_board, m_progressReporter );
+    }
 
     m_worstClearance = m_board->GetMaxClearanceValue();
+    m_worstThermalGap = 0;
+    m_maxError = m_board->GetDesignSettings().m_MaxError;
+
+    // Draft fills trade accuracy for speed
+    if( m_draft )
+    {
+        m_maxError = std::max( m_maxError,
+                               pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_DraftZoneFillMaxError ) );
+    }
+
+    if( !m_dirtyAreas.empty() )
+    {
+        DRC_CONSTRAINT constraint;
+
+        if( m_board->GetDesignSettings().m_DRCEngine->QueryWorstConstraint(
+                    THERMAL_RELIEF_GAP_CONSTRAINT, constraint ) )
+        {
+            m_worstThermalGap = constraint.GetValue().Min();
+        }
+
+        for( ZONE* zone : m_board->Zones() )
+            m_worstThermalGap = std::max( m_worstThermalGap, zone->GetThermalReliefGap() );
+
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            for( PAD* pad : footprint->Pads() )
+                m_worstThermalGap = std::max( m_worstThermalGap, pad->GetThermalGap() );
+        }
+    }
 
     if( m_progressReporter )
     {
@@ -295,7 +349,26 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         }
     }
 
+    // Hash the inputs of the fills, so that a loaded board can tell whether they are current
+    ZONE_FILL_HASHER   hasher( m_board );
+    std::vector<ZONE*> zones;
+
     for( ZONE* zone : aZones )
+    {
+        if( m_skipUpToDate && hasher.IsUpToDate( zone ) )
+            continue;
+
+        zones.push_back( zone );
+
+        // Draft fills are never current
+        if( !zone->GetIsRuleArea() && !m_draft )
+        {
+            for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                fillInputHashes[ { zone, layer } ] = hasher.GetHash( zone, layer );
+        }
+    }
+
+    for( ZONE* zone : zones )
     {
         // Rule areas are not filled
         if( zone->GetIsRuleArea() )
@@ -319,6 +392,16 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             toFill.emplace_back( std::make_pair( zone, layer ) );
 
             isolatedIslandsMap[ zone ][ layer ] = ISOLATED_ISLANDS();
+
+            // Keep what a partial refill reuses before it goes
+            if( m_dirtyAreas.count( zone ) && canRefillPartially( zone, layer ) )
+            {
+                PARTIAL_REFILL& refill = partialRefills[ { zone, layer } ];
+
+                refill.m_dirtyArea = m_dirtyAreas.at( zone );
+                refill.m_oldFill = zone->GetFilledPolysList( layer )->CloneDropTriangulation();
+                refill.m_removedIslands = *zone->GetRemovedIslands( layer );
+            }
         }
 
         // Remove existing fill first to prevent drawing invalid polygons on some platforms
@@ -367,145 +450,152 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                 return aZone->Outline()->Collide( aOtherZone->Outline(), m_worstClearance );
             };
 
-    auto fill_lambda =
-            [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
-            {
-                PCB_LAYER_ID layer = aFillItem.second;
-                ZONE*        zone = aFillItem.first;
-                bool         canFill = true;
-
-                // Check for any fill dependencies.  If our zone needs to be clipped by
-                // another zone then we can't fill until that zone is filled.
-                for( ZONE* otherZone : aZones )
-                {
-                    if( otherZone == zone )
-                        continue;
-
-                    if( check_fill_dependency( zone, layer, otherZone ) )
-                    {
-                        canFill = false;
-                        break;
-                    }
-                }
-
-                if( m_progressReporter && m_progressReporter->IsCancelled() )
-                    return 0;
+    // Turn the fill dependencies into a graph: a (zone, layer) fill waits for the fills of the
+    // zones it has to knock out, and is queued as soon as the last of them is done.  Zone
+    // priorities are a strict order, so the graph has no cycles.
+    struct FILL_NODE
+    {
+        std::vector<size_t> m_dependents;
+        std::vector<size_t> m_blockedBy;
+        std::atomic<int>    m_blockers = 0;
 
-                if( !canFill )
-                    return 0;
+        BOX2I               m_refillArea;     ///< the area refilled, when refilled partially
+        BOX2I               m_changedArea;    ///< where the fill may differ from the previous one
+    };
 
-                // Now we're ready to fill.
-                {
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
+    std::vector<FILL_NODE>                              fillNodes( toFill.size() );
+    std::map<std::pair<ZONE*, PCB_LAYER_ID>, size_t>    fillIndices;
 
-                    if( !zoneLock.owns_lock() )
-                        return 0;
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+        fillIndices[ toFill[ii] ] = ii;
 
-                    SHAPE_POLY_SET fillPolys;
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        ZONE*        zone = toFill[ii].first;
+        PCB_LAYER_ID layer = toFill[ii].second;
 
-                    if( !fillSingleZone( zone, layer, fillPolys ) )
-                        return 0;
+        for( ZONE* otherZone : zones )
+        {
+            if( otherZone == zone )
+                continue;
 
-                    zone->SetFilledPolysList( layer, fillPolys );
-                }
+            auto it = fillIndices.find( { otherZone, layer } );
 
-                if( m_progressReporter )
-                    m_progressReporter->AdvanceProgress();
+            if( it != fillIndices.end() && check_fill_dependency( zone, layer, otherZone ) )
+            {
+                fillNodes[ it->second ].m_dependents.push_back( ii );
+                fillNodes[ ii ].m_blockedBy.push_back( it->second );
+                fillNodes[ ii ].m_blockers++;
+            }
+        }
+    }
 
-                return 1;
-            };
+    thread_pool&            tp = GetKiCadThreadPool();
+    size_t                  finished = 0;
+    std::mutex              finishedLock;
+    std::condition_variable finishedCondition;
+    bool                    cancelled = false;
 
-    auto tesselate_lambda =
-            [&]( std::pair<ZONE*, PCB_LAYER_ID> aFillItem ) -> int
+    std::function<void( size_t )> fill_lambda =
+            [&]( size_t aIndex )
             {
-                if( m_progressReporter && m_progressReporter->IsCancelled() )
-                    return 0;
-
-                PCB_LAYER_ID layer = aFillItem.second;
-                ZONE*        zone = aFillItem.first;
+                ZONE*        zone = toFill[aIndex].first;
+                PCB_LAYER_ID layer = toFill[aIndex].second;
 
+                // Once cancelled, the remaining fills are skipped but still release their
+                // dependents so that the whole graph drains
+                if( !m_progressReporter || !m_progressReporter->IsCancelled() )
                 {
-                    std::unique_lock<std::mutex> zoneLock( zone->GetLock(), std::try_to_lock );
+                    // Other layers of the same zone may be filling at the same time
+                    std::lock_guard<std::mutex> zoneLock( zone->GetLock() );
 
-                    if( !zoneLock.owns_lock() )
-                        return 0;
+                    // Reuse clipper buffers across the many boolean ops of a single fill
+                    GEOMETRY_ARENA arena;
+                    SHAPE_POLY_SET fillPolys;
+                    FILL_NODE&     node = fillNodes[aIndex];
+                    bool           filled = false;
+                    auto           refill = partialRefills.find( toFill[aIndex] );
 
-                    zone->CacheTriangulation( layer );
-                    zone->SetFillFlag( layer, true );
-                }
+                    if( refill != partialRefills.end() )
+                    {
+                        BOX2I area = refill->second.m_dirtyArea;
 
-                return 1;
-            };
+                        // The zones knocked out of this one may have changed elsewhere
+                        for( size_t blocker : node.m_blockedBy )
+                        {
+                            BOX2I changed = fillNodes[blocker].m_changedArea;
 
-    // Calculate the copper fills (NB: this is multi-threaded)
-    //
-    std::vector<std::pair<std::future<int>, int>> returns;
-    returns.reserve( toFill.size() );
-    size_t finished = 0;
-    bool cancelled = false;
+                            if( changed.GetWidth() > 0 || changed.GetHeight() > 0 )
+                            {
+                                changed.Inflate( m_worstClearance );
+                                area.Merge( changed );
+                            }
+                        }
 
-    thread_pool& tp = GetKiCadThreadPool();
+                        area.Inflate( refillMargin( zone ) );
 
-    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
-        returns.emplace_back( std::make_pair( tp.submit( fill_lambda, fillItem ), 0 ) );
+                        // Past some size, refilling a part costs about as much as the whole
+                        if( area.GetArea() < zone->GetBoundingBox().GetArea() / 2 )
+                        {
+                            filled = refillZoneArea( zone, layer, area, refill->second,
+                                                     fillPolys );
 
-    while( !cancelled && finished != 2 * toFill.size() )
-    {
-        for( size_t ii = 0; ii < returns.size(); ++ii )
-        {
-            auto& ret = returns[ii];
+                            if( filled )
+                                node.m_refillArea = area;
+                        }
+                    }
 
-            if( ret.second > 1 )
-                continue;
+                    if( !filled )
+                        filled = fillSingleZone( zone, layer, fillPolys );
 
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
+                    if( node.m_refillArea.GetWidth() > 0 )
+                        node.m_changedArea = node.m_refillArea;
+                    else
+                        node.m_changedArea = zone->GetBoundingBox();
 
-            if( status == std::future_status::ready )
-            {
-                if( ret.first.get() )   // lambda completed
-                {
-                    ++finished;
-                    ret.second++;       // go to next step
+                    if( filled )
+                    {
+                        zone->SetFilledPolysList( layer, fillPolys );
+                        zone->CacheTriangulation( layer );
+                        zone->SetFillFlag( layer, true );
+                    }
+
+                    if( m_progressReporter )
+                        m_progressReporter->AdvanceProgress();
                 }
 
-                if( !cancelled )
+                for( size_t dependent : fillNodes[aIndex].m_dependents )
                 {
-                    // Queue the next step (will re-queue the existing step if it didn't complete)
-                    if( ret.second == 0 )
-                        returns[ii].first = tp.submit( fill_lambda, toFill[ii] );
-                    else if( ret.second == 1 )
-                        returns[ii].first = tp.submit( tesselate_lambda, toFill[ii] );
+                    if( --fillNodes[dependent].m_blockers == 0 )
+                        tp.push_task( fill_lambda, dependent );
                 }
-            }
-        }
-
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
 
+                std::lock_guard<std::mutex> lock( finishedLock );
 
-        if( m_progressReporter )
-        {
-            m_progressReporter->KeepRefreshing();
+                if( ++finished == toFill.size() )
+                    finishedCondition.notify_all();
+            };
 
-            if( m_progressReporter->IsCancelled() )
-                cancelled = true;
-        }
+    // Calculate the copper fills (NB: this is multi-threaded)
+    //
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        if( fillNodes[ii].m_blockers == 0 )
+            tp.push_task( fill_lambda, ii );
     }
 
-    // Make sure that all futures have finished.
-    // This can happen when the user cancels the above operation
-    for( auto& ret : returns )
     {
-        if( ret.first.valid() )
+        std::unique_lock<std::mutex> lock( finishedLock );
+
+        while( !finishedCondition.wait_for( lock, std::chrono::milliseconds( 100 ),
+                                            [&]() { return finished == toFill.size(); } ) )
         {
-            std::future_status status = ret.first.wait_for( std::chrono::seconds( 0 ) );
+            lock.unlock();
 
-            while( status != std::future_status::ready )
-            {
-                if( m_progressReporter )
-                    m_progressReporter->KeepRefreshing();
+            if( m_progressReporter )
+                m_progressReporter->KeepRefreshing();
 
-                status = ret.first.wait_for( std::chrono::milliseconds( 100 ) );
-            }
+            lock.lock();
         }
     }
 
@@ -522,93 +612,87 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         m_progressReporter->KeepRefreshing();
     }
 
-    connectivity->SetProgressReporter( m_progressReporter );
-    connectivity->FillIsolatedIslandsMap( isolatedIslandsMap );
-    connectivity->SetProgressReporter( nullptr );
+    // The islands a partial refill didn't reach stay removed
+    for( size_t ii = 0; ii < toFill.size(); ++ii )
+    {
+        if( fillNodes[ii].m_refillArea.GetWidth() > 0 )
+            removedIslands[ toFill[ii] ] = partialRefills[ toFill[ii] ].m_removedIslands;
+    }
+
+    // Draft fills keep their islands
+    if( !m_draft )
+    {
+        connectivity->SetProgressReporter( m_progressReporter );
+        connectivity->FillIsolatedIslandsMap( isolatedIslandsMap );
+        connectivity->SetProgressReporter( nullptr );
+    }
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    for( ZONE* zone : aZones )
+    for( ZONE* zone : zones )
     {
         // Keepout zones are not filled
         if( zone->GetIsRuleArea() )
             continue;
 
         zone->SetIsFilled( true );
+        zone->SetIsDraftFill( m_draft );
     }
 
-    // Now remove isolated copper islands according to the isolated islands strategy assigned
-    // by the user (always, never, below-certain-size).
-    //
-    for( const auto& [ zone, zoneIslands ] : isolatedIslandsMap )
+    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
     {
-        // If *all* the polygons are islands, do not remove any of them
-        bool allIslands = true;
-
-        for( const auto& [ layer, layerIslands ] : zoneIslands )
-        {
-            if( layerIslands.m_IsolatedOutlines.size()
-                    != static_cast<size_t>( zone->GetFilledPolysList( layer )->OutlineCount() ) )
-            {
-                allIslands = false;
-                break;
-            }
-        }
-
-        if( allIslands )
-            continue;
+        if( !m_draft )
+            fillItem.first->SetFillInputHash( fillItem.second, fillInputHashes[ fillItem ] );
+    }
 
-        for( const auto& [ layer, layerIslands ] : zoneIslands )
-        {
-            if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
-                continue;
+    // Now remove, in a single pass over the fill outlines:
+    //  - isolated copper islands, according to the isolated islands strategy assigned by the
+    //    user (always, never, below-certain-size)
+    //  - outlines which are outside the board edge
+    //
+    struct ISLAND_CHECK
+    {
+        ZONE*                   m_zone;
+        PCB_LAYER_ID            m_layer;
+        const ISOLATED_ISLANDS* m_islands;      ///< null when islands aren't to be removed
+        double                  m_minArea;
+        BOX2I                   m_refillArea;
+
+        std::vector<int>        m_removedIslands;
+        std::vector<int>        m_removedOutlines;
+        std::vector<int>        m_keptIslands;
+    };
 
-            if( layerIslands.m_IsolatedOutlines.empty() )
-                continue;
+    std::vector<ISLAND_CHECK> islandChecks;
 
-            std::vector<int> islands = layerIslands.m_IsolatedOutlines;
+    // rough estimate to save re-allocation time
+    islandChecks.reserve( m_board->GetCopperLayerCount() * zones.size() );
 
-            // The list of polygons to delete must be explored from last to first in list,
-            // to allow deleting a polygon from list without breaking the remaining of the list
-            std::sort( islands.begin(), islands.end(), std::greater<int>() );
+    for( ZONE* zone : zones )
+    {
+        // Nor are draft fills trimmed to the board edge
+        if( m_draft )
+            continue;
 
-            std::shared_ptr<SHAPE_POLY_SET> poly = zone->GetFilledPolysList( layer );
-            long long int                   minArea = zone->GetMinIslandArea();
-            ISLAND_REMOVAL_MODE             mode = zone->GetIslandRemovalMode();
+        LSET zoneCopperLayers = zone->GetLayerSet() & LSET::AllCuMask( MAX_CU_LAYERS );
+        auto zoneIslandsIt = isolatedIslandsMap.find( zone );
+        bool allIslands = true;
 
-            for( int idx : islands )
+        // If *all* the polygons are islands, do not remove any of them
+        if( zoneIslandsIt != isolatedIslandsMap.end() )
+        {
+            for( const auto& [ layer, layerIslands ] : zoneIslandsIt->second )
             {
-                SHAPE_LINE_CHAIN& outline = poly->Outline( idx );
+                int outlineCount = zone->GetFilledPolysList( layer )->OutlineCount();
 
-                if( mode == ISLAND_REMOVAL_MODE::ALWAYS )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
-                else if ( mode == ISLAND_REMOVAL_MODE::AREA && outline.Area( true ) < minArea )
-                    poly->DeletePolygonAndTriangulationData( idx, false );
-                else
-                    zone->SetIsIsland( layer, idx );
+                if( layerIslands.m_IsolatedOutlines.size() != static_cast<size_t>( outlineCount ) )
+                {
+                    allIslands = false;
+                    break;
+                }
             }
-
-            poly->UpdateTriangulationDataHash();
-            zone->CalculateFilledArea();
-
-            if( m_progressReporter && m_progressReporter->IsCancelled() )
-                return false;
         }
-    }
-
-    // Now remove islands which are either outside the board edge or fail to meet the minimum
-    // area requirements
-    using island_check_return = std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, int>>;
-
-    std::vector<std::pair<std::shared_ptr<SHAPE_POLY_SET>, double>> polys_to_check;
-
-    // rough estimate to save re-allocation time
-    polys_to_check.reserve( m_board->GetCopperLayerCount() * aZones.size() );
-
-    for( ZONE* zone : aZones )
-    {
-        LSET   zoneCopperLayers = zone->GetLayerSet() & LSET::AllCuMask( MAX_CU_LAYERS );
 
         // Min-thickness is the web thickness.  On the other hand, a blob min-thickness by
         // min-thickness is not useful.  Since there's no obvious definition of web vs. blob, we
@@ -620,29 +704,81 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
             if( m_debugZoneFiller && LSET::InternalCuMask().Contains( layer ) )
                 continue;
 
-            polys_to_check.emplace_back( zone->GetFilledPolysList( layer ), minArea );
+            ISLAND_CHECK check{ zone, layer, nullptr, minArea, BOX2I() };
+
+            if( !allIslands )
+            {
+                auto layerIslandsIt = zoneIslandsIt->second.find( layer );
+
+                if( layerIslandsIt != zoneIslandsIt->second.end() )
+                    check.m_islands = &layerIslandsIt->second;
+            }
+
+            // Outlines away from the area refilled by a partial refill already passed the
+            // board edge test
+            auto fillIt = fillIndices.find( { zone, layer } );
+
+            if( fillIt != fillIndices.end() )
+                check.m_refillArea = fillNodes[fillIt->second].m_refillArea;
+
+            islandChecks.push_back( std::move( check ) );
         }
     }
 
     auto island_lambda =
-            [&]( int aStart, int aEnd ) -> island_check_return
+            [&]( int aStart, int aEnd )
             {
-                island_check_return retval;
-
                 for( int ii = aStart; ii < aEnd && !cancelled; ++ii )
                 {
-                    auto [poly, minArea] = polys_to_check[ii];
+                    ISLAND_CHECK&                   check = islandChecks[ii];
+                    std::shared_ptr<SHAPE_POLY_SET> poly = check.m_zone->GetFilledPolysList(
+                                                                                check.m_layer );
+                    std::vector<char>               isIsland( poly->OutlineCount(), 0 );
+
+                    if( check.m_islands )
+                    {
+                        long long int       minIslandArea = check.m_zone->GetMinIslandArea();
+                        ISLAND_REMOVAL_MODE mode = check.m_zone->GetIslandRemovalMode();
+
+                        for( int idx : check.m_islands->m_IsolatedOutlines )
+                        {
+                            const SHAPE_LINE_CHAIN& outline = poly->COutline( idx );
+
+                            if( mode == ISLAND_REMOVAL_MODE::ALWAYS
+                                    || ( mode == ISLAND_REMOVAL_MODE::AREA
+                                         && outline.Area( true ) < minIslandArea ) )
+                            {
+                                check.m_removedIslands.push_back( idx );
+                            }
+                            else
+                            {
+                                isIsland[idx] = 1;
+                            }
+                        }
+
+                        for( int idx : check.m_removedIslands )
+                            isIsland[idx] = 2;
+                    }
 
                     for( int jj = poly->OutlineCount() - 1; jj >= 0; jj-- )
                     {
+                        if( isIsland[jj] == 2 )
+                            continue;
+
                         SHAPE_POLY_SET island;
                         SHAPE_POLY_SET intersection;
-                        const SHAPE_LINE_CHAIN& test_poly = poly->Polygon( jj ).front();
+                        const SHAPE_LINE_CHAIN& test_poly = poly->COutline( jj );
                         double island_area = test_poly.Area();
 
-                        if( island_area < minArea )
-                            continue;
+                        if( island_area < check.m_minArea
+                                || ( check.m_refillArea.GetWidth() > 0
+                                     && !test_poly.BBox().Intersects( check.m_refillArea ) ) )
+                        {
+                            if( isIsland[jj] )
+                                check.m_keptIslands.push_back( jj );
 
+                            continue;
+                        }
 
                         island.AddOutline( test_poly );
                         intersection.BooleanIntersection( m_boardOutline, island,
@@ -654,20 +790,21 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                         // slight overlap at the edges, so testing against half-size area acts as
                         // a fail-safe.
                         if( intersection.Area() < island_area / 2.0 )
-                            retval.emplace_back( poly, jj );
+                            check.m_removedOutlines.push_back( jj );
+                        else if( isIsland[jj] )
+                            check.m_keptIslands.push_back( jj );
                     }
                 }
-
-                return retval;
             };
 
-    auto island_returns = tp.parallelize_loop( 0, polys_to_check.size(), island_lambda );
+    auto island_returns = tp.parallelize_loop( 0, islandChecks.size(), island_lambda,
+                                               GetThreadBudget( THREAD_SUBSYSTEM::ZONE_FILL ) );
     cancelled = false;
 
     // Allow island removal threads to finish
     for( size_t ii = 0; ii < island_returns.size(); ++ii )
     {
-        std::future<island_check_return>& ret = island_returns[ii];
+        std::future<void>& ret = island_returns[ii];
 
         if( ret.valid() )
         {
@@ -691,18 +828,46 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
     if( cancelled )
         return false;
 
-    for( size_t ii = 0; ii < island_returns.size(); ++ii )
+    for( ISLAND_CHECK& check : islandChecks )
     {
-        std::future<island_check_return>& ret = island_returns[ii];
+        if( check.m_removedIslands.empty() && check.m_removedOutlines.empty()
+                && check.m_keptIslands.empty() )
+        {
+            continue;
+        }
 
-        if( ret.valid() )
+        SHAPE_POLY_SET*                 poly = check.m_zone->GetFill( check.m_layer );
+        SHAPE_POLY_SET&                 removed = removedIslands[ { check.m_zone, check.m_layer } ];
+        std::vector<int>                toDelete = check.m_removedOutlines;
+
+        for( int idx : check.m_removedIslands )
+        {
+            removed.AddPolygon( poly->CPolygon( idx ) );
+            toDelete.push_back( idx );
+        }
+
+        // The list of polygons to delete must be explored from last to first in list, to allow
+        // deleting a polygon from list without breaking the remaining of the list
+        std::sort( toDelete.begin(), toDelete.end(), std::greater<int>() );
+
+        for( int idx : toDelete )
+            poly->DeletePolygonAndTriangulationData( idx, false );
+
+        poly->UpdateTriangulationDataHash();
+
+        // Kept islands are flagged by their index in the final fill
+        std::sort( toDelete.begin(), toDelete.end() );
+
+        for( int idx : check.m_keptIslands )
         {
-            for( auto& action_item : ret.get() )
-                action_item.first->DeletePolygonAndTriangulationData( action_item.second, true );
+            int shift = std::lower_bound( toDelete.begin(), toDelete.end(), idx )
+                        - toDelete.begin();
+
+            check.m_zone->SetIsIsland( check.m_layer, idx - shift );
         }
     }
 
-    for( ZONE* zone : aZones )
+    for( ZONE* zone : zones )
         zone->CalculateFilledArea();
 
 
@@ -710,7 +875,7 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
     {
         bool outOfDate = false;
 
-        for( ZONE* zone : aZones )
+        for( ZONE* zone : zones )
         {
             // Keepout zones are not filled
             if( zone->GetIsRuleArea() )
@@ -752,6 +917,39 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
         m_progressReporter->KeepRefreshing();
     }
 
+    // Index the copper fills for DRC now that they are final.  DRC reuses the indices for
+    // as long as the fills don't change, rather than build them again.
+    std::vector<std::future<void>> rtreeReturns;
+
+    for( ZONE* zone : zones )
+    {
+        if( zone->GetIsRuleArea() || !zone->IsOnCopperLayer() )
+            continue;
+
+        rtreeReturns.emplace_back( tp.submit(
+                [zone, this]()
+                {
+                    zone->CacheTriangulation();
+
+                    // DRC never runs on draft fills
+                    if( !m_draft )
+                        zone->BuildFillRTree();
+                } ) );
+    }
+
+    for( const std::future<void>& ret : rtreeReturns )
+        ret.wait();
+
+    // Record what island removal took out of the (now triangulated) fills, for later partial
+    // refills
+    for( const std::pair<ZONE*, PCB_LAYER_ID>& fillItem : toFill )
+    {
+        if( fillItem.first->IsOnCopperLayer() && !m_draft )
+            fillItem.first->SetRemovedIslands( fillItem.second, removedIslands[ fillItem ] );
+    }
+
+    m_board->m_ZoneKnockoutCache.RemoveUnused();
+
     return true;
 }
 
@@ -793,7 +991,31 @@ void ZONE_FILLER::addKnockout( PAD* aPad, PCB_LAYER_ID aLayer, int aGap, SHAPE_P
  */
 void ZONE_FILLER::addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles )
 {
-    aPad->TransformHoleToPolygon( aHoles, aGap, m_maxError, ERROR_OUTSIDE );
+    if( !aPad->GetDrillSize().x || !aPad->GetDrillSize().y )
+        return;
+
+    std::shared_ptr<SHAPE_SEGMENT> slot = aPad->GetEffectiveHoleShape();
+
+    addCachedKnockout( { ZONE_KNOCKOUT_KEY::KIND::OVAL, slot->GetSeg().A, VECTOR2I(),
+                         slot->GetSeg().B, slot->GetWidth(), aGap, m_maxError, ERROR_OUTSIDE },
+                       [&]( SHAPE_POLY_SET& aKnockout )
+                       {
+                           aPad->TransformHoleToPolygon( aKnockout, aGap, m_maxError,
+                                                         ERROR_OUTSIDE );
+                       },
+                       aHoles );
+}
+
+
+/**
+ * Append the knockout for \a aKey from the board's knockout cache, building it with
+ * \a aBuilder the first time it is asked for.
+ */
+void ZONE_FILLER::addCachedKnockout( const ZONE_KNOCKOUT_KEY& aKey,
+                                     const std::function<void( SHAPE_POLY_SET& )>& aBuilder,
+                                     SHAPE_POLY_SET& aHoles )
+{
+    aHoles.Append( *m_board->m_ZoneKnockoutCache.Get( aKey, aBuilder ) );
 }
 
 
@@ -867,7 +1089,7 @@ void ZONE_FILLER::addKnockout( BOARD_ITEM* aItem, PCB_LAYER_ID aLayer, int aGap,
  * in spokes, which must be done later.
  */
 void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer,
-                                          SHAPE_POLY_SET& aFill,
+                                          const BOX2I& aArea, SHAPE_POLY_SET& aFill,
                                           std::vector<PAD*>& aThermalConnectionPads,
                                           std::vector<PAD*>& aNoConnectionPads )
 {
@@ -885,7 +1107,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
             BOX2I padBBox = pad->GetBoundingBox();
             padBBox.Inflate( m_worstClearance );
 
-            if( !padBBox.Intersects( aZone->GetBoundingBox() ) )
+            if( !padBBox.Intersects( aArea ) )
                 continue;
 
             if( pad->GetNetCode() != aZone->GetNetCode()
@@ -970,6 +1192,7 @@ void ZONE_FILLER::knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer
  * not connected to it.
  */
 void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+                                             const BOX2I& aArea,
                                              const std::vector<PAD*> aNoConnectionPads,
                                              SHAPE_POLY_SET& aHoles )
 {
@@ -985,7 +1208,7 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
     // A small extra clearance to be sure actual track clearances are not smaller than
     // requested clearance due to many approximations in calculations, like arc to segment
     // approx, rounding issues, etc.
-    BOX2I zone_boundingbox = aZone->GetBoundingBox();
+    BOX2I zone_boundingbox = aArea;
     int   extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
 
     // Items outside the zone bounding box are skipped, so it needs to be inflated by the
@@ -1078,8 +1301,18 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
 
                         if( via->FlashLayer( aLayer ) && gap > 0 )
                         {
-                            via->TransformShapeToPolygon( aHoles, aLayer, gap + extra_margin,
-                                                          m_maxError, ERROR_OUTSIDE );
+                            addCachedKnockout( { ZONE_KNOCKOUT_KEY::KIND::CIRCLE,
+                                                 via->GetPosition(), VECTOR2I(),
+                                                 via->GetPosition(), via->GetWidth(),
+                                                 gap + extra_margin, m_maxError, ERROR_OUTSIDE },
+                                               [&]( SHAPE_POLY_SET& aKnockout )
+                                               {
+                                                   via->TransformShapeToPolygon( aKnockout, aLayer,
+                                                                                 gap + extra_margin,
+                                                                                 m_maxError,
+                                                                                 ERROR_OUTSIDE );
+                                               },
+                                               aHoles );
                         }
 
                         gap = std::max( gap, evalRulesForItems( PHYSICAL_HOLE_CLEARANCE_CONSTRAINT,
@@ -1095,17 +1328,48 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
                         {
                             int radius = via->GetDrillValue() / 2;
 
-                            TransformCircleToPolygon( aHoles, via->GetPosition(),
-                                                      radius + gap + extra_margin,
-                                                      m_maxError, ERROR_OUTSIDE );
+                            addCachedKnockout( { ZONE_KNOCKOUT_KEY::KIND::CIRCLE,
+                                                 via->GetPosition(), VECTOR2I(),
+                                                 via->GetPosition(), via->GetDrillValue(),
+                                                 gap + extra_margin, m_maxError, ERROR_OUTSIDE },
+                                               [&]( SHAPE_POLY_SET& aKnockout )
+                                               {
+                                                   TransformCircleToPolygon( aKnockout,
+                                                                             via->GetPosition(),
+                                                                             radius + gap
+                                                                                 + extra_margin,
+                                                                             m_maxError,
+                                                                             ERROR_OUTSIDE );
+                                               },
+                                               aHoles );
                         }
                     }
                     else
                     {
                         if( gap > 0 )
                         {
-                            aTrack->TransformShapeToPolygon( aHoles, aLayer, gap + extra_margin,
-                                                             m_maxError, ERROR_OUTSIDE );
+                            ZONE_KNOCKOUT_KEY key{ ZONE_KNOCKOUT_KEY::KIND::OVAL,
+                                                   aTrack->GetStart(), VECTOR2I(),
+                                                   aTrack->GetEnd(), aTrack->GetWidth(),
+                                                   gap + extra_margin, m_maxError,
+                                                   ERROR_OUTSIDE };
+
+                            if( aTrack->Type() == PCB_ARC_T )
+                            {
+                                key.m_kind = ZONE_KNOCKOUT_KEY::KIND::ARC;
+                                key.m_mid = static_cast<PCB_ARC*>( aTrack )->GetMid();
+                            }
+
+                            addCachedKnockout( key,
+                                               [&]( SHAPE_POLY_SET& aKnockout )
+                                               {
+                                                   aTrack->TransformShapeToPolygon( aKnockout,
+                                                                                    aLayer,
+                                                                                    gap + extra_margin,
+                                                                                    m_maxError,
+                                                                                    ERROR_OUTSIDE );
+                                               },
+                                               aHoles );
                         }
                     }
                 }
@@ -1305,7 +1569,8 @@ void ZONE_FILLER::buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLa
         }
     }
 
-    aHoles.Simplify( SHAPE_POLY_SET::PM_FAST );
+    // On dense boards this is tens of thousands of pad and track knockouts: merge them in bands
+    aHoles = SHAPE_POLY_SET::ParallelUnion( { &aHoles } );
 }
 
 
@@ -1389,11 +1654,9 @@ void ZONE_FILLER::subtractHigherPriorityZones( const ZONE* aZone, PCB_LAYER_ID a
  * 6 - Adds in the remaining spokes
  */
 bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
-                                  const SHAPE_POLY_SET& aSmoothedOutline,
+                                  const BOX2I& aArea, const SHAPE_POLY_SET& aSmoothedOutline,
                                   const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys )
 {
-    m_maxError = m_board->GetDesignSettings().m_MaxError;
-
     // Features which are min_width should survive pruning; features that are *less* than
     // min_width should not.  Therefore we subtract epsilon from the min_width when
     // deflating/inflating.
@@ -1413,10 +1676,10 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     CORNER_STRATEGY fastCornerStrategy = CORNER_STRATEGY::CHAMFER_ALL_CORNERS;
     CORNER_STRATEGY cornerStrategy = CORNER_STRATEGY::ROUND_ALL_CORNERS;
 
-    std::vector<PAD*>            thermalConnectionPads;
-    std::vector<PAD*>            noConnectionPads;
-    std::deque<SHAPE_LINE_CHAIN> thermalSpokes;
-    SHAPE_POLY_SET               clearanceHoles;
+    std::vector<PAD*>             thermalConnectionPads;
+    std::vector<PAD*>             noConnectionPads;
+    std::vector<SHAPE_LINE_CHAIN> thermalSpokes;
+    SHAPE_POLY_SET                clearanceHoles;
 
     aFillPolys = aSmoothedOutline;
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In1_Cu, wxT( "smoothed-outline" ) );
@@ -1428,7 +1691,8 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout thermal reliefs.
      */
 
-    knockoutThermalReliefs( aZone, aLayer, aFillPolys, thermalConnectionPads, noConnectionPads );
+    knockoutThermalReliefs( aZone, aLayer, aArea, aFillPolys, thermalConnectionPads,
+                            noConnectionPads );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In2_Cu, wxT( "minus-thermal-reliefs" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1438,7 +1702,7 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
      * Knockout electrical clearances.
      */
 
-    buildCopperItemClearances( aZone, aLayer, noConnectionPads, clearanceHoles );
+    buildCopperItemClearances( aZone, aLayer, aArea, noConnectionPads, clearanceHoles );
     DUMP_POLYS_TO_COPPER_LAYER( clearanceHoles, In3_Cu, wxT( "clearance-holes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1476,50 +1740,81 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     // Spoke-end-testing is hugely expensive so we generate cached bounding-boxes to speed
     // things up a bit.
     testAreas.BuildBBoxCaches();
-    int interval = 0;
 
-    SHAPE_POLY_SET debugSpokes;
+    // Spokes whose end isn't in the zone body may still connect to another spoke (e.g. between
+    // two adjacent pads), which we find through an rtree rather than testing every pair.
+    PACKED_RTREE<size_t> spokeTree;
 
-    for( const SHAPE_LINE_CHAIN& spoke : thermalSpokes )
-    {
-        const VECTOR2I& testPt = spoke.CPoint( 3 );
+    for( size_t ii = 0; ii < thermalSpokes.size(); ++ii )
+        spokeTree.Insert( thermalSpokes[ii].BBox(), ii );
 
-        // Hit-test against zone body
-        if( testAreas.Contains( testPt, -1, 1, USE_BBOX_CACHES ) )
-        {
-            if( m_debugZoneFiller )
-                debugSpokes.AddOutline( spoke );
+    spokeTree.Build();
 
-            aFillPolys.AddOutline( spoke );
-            continue;
-        }
+    // The tests only read shared data, so they run in parallel.  The connected spokes are then
+    // all added to the fill at once, in their original order.
+    std::vector<char> connected( thermalSpokes.size(), 0 );
+    std::atomic<bool> cancelled( false );
 
-        if( interval++ > 400 )
-        {
-            if( m_progressReporter && m_progressReporter->IsCancelled() )
-                return false;
+    ParallelFor( thermalSpokes.size(),
+            [&]( size_t aIdx )
+            {
+                if( cancelled )
+                    return;
 
-            interval = 0;
-        }
+                if( ( aIdx % 400 ) == 399 && m_progressReporter
+                        && m_progressReporter->IsCancelled() )
+                {
+                    cancelled = true;
+                    return;
+                }
 
-        // Hit-test against other spokes
-        for( const SHAPE_LINE_CHAIN& other : thermalSpokes )
-        {
-            // Hit test in both directions to avoid interactions with round-off errors.
-            // (See https://gitlab.com/kicad/code/kicad/-/issues/13316.)
-            if( &other != &spoke
-                && other.PointInside( testPt, 1, USE_BBOX_CACHES )
-                && spoke.PointInside( other.CPoint( 3 ), 1, USE_BBOX_CACHES ) )
-            {
-                if( m_debugZoneFiller )
-                    debugSpokes.AddOutline( spoke );
+                const SHAPE_LINE_CHAIN& spoke = thermalSpokes[aIdx];
+                const VECTOR2I&         testPt = spoke.CPoint( 3 );
 
-                aFillPolys.AddOutline( spoke );
-                break;
-            }
-        }
+                // Hit-test against zone body
+                if( testAreas.Contains( testPt, -1, 1, USE_BBOX_CACHES ) )
+                {
+                    connected[aIdx] = 1;
+                    return;
+                }
+
+                // Hit-test against other spokes
+                spokeTree.Search( BOX2I( testPt, VECTOR2I( 0, 0 ) ),
+                        [&]( size_t aOther )
+                        {
+                            const SHAPE_LINE_CHAIN& other = thermalSpokes[aOther];
+
+                            // Hit test in both directions to avoid interactions with round-off
+                            // errors.  (See https://gitlab.com/kicad/code/kicad/-/issues/13316.)
+                            if( aOther != aIdx
+                                && other.PointInside( testPt, 1, USE_BBOX_CACHES )
+                                && spoke.PointInside( other.CPoint( 3 ), 1, USE_BBOX_CACHES ) )
+                            {
+                                connected[aIdx] = 1;
+                                return false;
+                            }
+
+                            return true;
+                        } );
+            } );
+
+    if( cancelled || ( m_progressReporter && m_progressReporter->IsCancelled() ) )
+        return false;
+
+    SHAPE_POLY_SET connectedSpokes;
+    SHAPE_POLY_SET debugSpokes;
+
+    for( size_t ii = 0; ii < thermalSpokes.size(); ++ii )
+    {
+        if( connected[ii] )
+            connectedSpokes.AddOutline( thermalSpokes[ii] );
     }
 
+    if( m_debugZoneFiller )
+        debugSpokes = connectedSpokes;
+
+    aFillPolys.Append( connectedSpokes );
+
     DUMP_POLYS_TO_COPPER_LAYER( debugSpokes, In7_Cu, wxT( "spokes" ) );
 
     if( m_progressReporter && m_progressReporter->IsCancelled() )
@@ -1604,7 +1899,10 @@ bool ZONE_FILLER::fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LA
     subtractHigherPriorityZones( aZone, aLayer, aFillPolys );
     DUMP_POLYS_TO_COPPER_LAYER( aFillPolys, In18_Cu, wxT( "minus-higher-priority-zones" ) );
 
-    aFillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+    // Draft fills are only drawn, and triangulation copes with holes
+    if( !m_draft )
+        aFillPolys.Fracture( SHAPE_POLY_SET::PM_FAST );
+
     return true;
 }
 
@@ -1657,8 +1955,7 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
         knockoutGraphicClearance( item );
     }
 
-    aFillPolys = aSmoothedOutline;
-    aFillPolys.BooleanSubtract( clearanceHoles, SHAPE_POLY_SET::PM_FAST );
+    std::vector<const SHAPE_POLY_SET*> knockouts = { &clearanceHoles };
 
     for( ZONE* keepout : m_board->Zones() )
     {
@@ -1668,10 +1965,13 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
         if( keepout->GetDoNotAllowCopperPour() && keepout->IsOnLayer( aLayer ) )
         {
             if( keepout->GetBoundingBox().Intersects( zone_boundingbox ) )
-                aFillPolys.BooleanSubtract( *keepout->Outline(), SHAPE_POLY_SET::PM_FAST );
+                knockouts.push_back( keepout->Outline() );
         }
     }
 
+    aFillPolys = aSmoothedOutline;
+    aFillPolys.BooleanSubtract( knockouts, SHAPE_POLY_SET::PM_FAST );
+
     // Features which are min_width should survive pruning; features that are *less* than
     // min_width should not.  Therefore we subtract epsilon from the min_width when
     // deflating/inflating.
@@ -1691,7 +1991,9 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
     if( half_min_width - epsilon > epsilon )
         aFillPolys.Inflate( half_min_width - epsilon, CORNER_STRATEGY::ROUND_ALL_CORNERS, m_maxError );
 
-    aFillPolys.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+    if( !m_draft )
+        aFillPolys.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
     return true;
 }
 
@@ -1701,7 +2003,8 @@ bool ZONE_FILLER::fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
  * The solid areas can be more than one on copper layers, and do not have holes
  * ( holes are linked by overlapping segments to the main outline)
  */
-bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys )
+bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys,
+                                  const BOX2I* aClipArea )
 {
     SHAPE_POLY_SET* boardOutline = m_brdOutlinesValid ? &m_boardOutline : nullptr;
     SHAPE_POLY_SET  maxExtents;
@@ -1717,13 +2020,24 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
     if( !aZone->BuildSmoothedPoly( maxExtents, aLayer, boardOutline, &smoothedPoly ) )
         return false;
 
+    if( aClipArea )
+    {
+        SHAPE_POLY_SET clip( SHAPE_RECT( *aClipArea ).Outline() );
+        smoothedPoly.BooleanIntersection( clip, SHAPE_POLY_SET::PM_FAST );
+    }
+
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
     if( aZone->IsOnCopperLayer() )
     {
-        if( fillCopperZone( aZone, aLayer, debugLayer, smoothedPoly, maxExtents, aFillPolys ) )
+        BOX2I area = aClipArea ? *aClipArea : aZone->GetBoundingBox();
+
+        if( fillCopperZone( aZone, aLayer, debugLayer, area, smoothedPoly, maxExtents,
+                            aFillPolys ) )
+        {
             aZone->SetNeedRefill( false );
+        }
     }
     else
     {
@@ -1735,16 +2049,95 @@ bool ZONE_FILLER::fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_S
 }
 
 
+bool ZONE_FILLER::canRefillPartially( const ZONE* aZone, PCB_LAYER_ID aLayer ) const
+{
+    if( m_debugZoneFiller || !aZone->IsOnCopperLayer() || aZone->IsTeardropArea() )
+        return false;
+
+    // The hatch pattern is laid out over the whole fill
+    if( aZone->GetFillMode() == ZONE_FILL_MODE::HATCH_PATTERN )
+        return false;
+
+    // Islands removed from the previous fill need to be known to be put back
+    return aZone->IsFilled() && aZone->GetRemovedIslands( aLayer ) != nullptr;
+}
+
+
+int ZONE_FILLER::refillMargin( const ZONE* aZone ) const
+{
+    int extra_margin = pcbIUScale.mmToIU( ADVANCED_CFG::GetCfg().m_ExtraClearance );
+
+    // A changed item moves the knockouts around it, and the thermal reliefs (spokes included)
+    // of the pads near them.  Pruning to the minimum width then reaches a little further.
+    return m_worstClearance + 2 * m_worstThermalGap + 2 * aZone->GetMinThickness()
+           + extra_margin + m_maxError;
+}
+
+
+bool ZONE_FILLER::refillZoneArea( ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aArea,
+                                  PARTIAL_REFILL& aRefill, SHAPE_POLY_SET& aFillPolys )
+{
+    // The fill is computed a margin past the area, so that the artefacts of clipping it
+    // (necks pruned, spokes dropped at the clip edge) stay out of the part which is kept
+    BOX2I          clipArea = aArea;
+    SHAPE_POLY_SET area( SHAPE_RECT( aArea ).Outline() );
+    SHAPE_POLY_SET refilled;
+
+    clipArea.Inflate( refillMargin( aZone ) );
+
+    if( !fillSingleZone( aZone, aLayer, refilled, &clipArea ) )
+        return false;
+
+    if( m_progressReporter && m_progressReporter->IsCancelled() )
+        return false;
+
+    refilled.BooleanIntersection( area, SHAPE_POLY_SET::PM_FAST );
+
+    // Only the previous copper reaching into the area needs clipping; the rest is kept as is
+    SHAPE_POLY_SET touched;
+    SHAPE_POLY_SET untouchedIslands;
+
+    auto sortOutlines =
+            [&]( const SHAPE_POLY_SET& aSource, SHAPE_POLY_SET& aUntouched )
+            {
+                for( int ii = 0; ii < aSource.OutlineCount(); ++ii )
+                {
+                    if( aSource.COutline( ii ).BBox().Intersects( aArea ) )
+                        touched.AddPolygon( aSource.CPolygon( ii ) );
+                    else
+                        aUntouched.AddPolygon( aSource.CPolygon( ii ) );
+                }
+            };
+
+    aFillPolys.RemoveAllContours();
+    sortOutlines( aRefill.m_oldFill, aFillPolys );
+    sortOutlines( aRefill.m_removedIslands, untouchedIslands );
+
+    // Both sides are cut along the same edges, so they merge back seamlessly
+    touched.BooleanSubtract( area, SHAPE_POLY_SET::PM_FAST );
+    touched.BooleanAdd( refilled, SHAPE_POLY_SET::PM_FAST );
+    touched.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    for( int ii = 0; ii < touched.OutlineCount(); ++ii )
+        aFillPolys.AddPolygon( touched.CPolygon( ii ) );
+
+    // Islands which were removed and aren't touched stay removed; the touched ones are part of
+    // the refill and get evaluated again
+    aRefill.m_removedIslands = std::move( untouchedIslands );
+
+    return true;
+}
+
+
 /**
  * Function buildThermalSpokes
  */
 void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
                                       const std::vector<PAD*>& aSpokedPadsList,
-                                      std::deque<SHAPE_LINE_CHAIN>& aSpokesList )
+                                      std::vector<SHAPE_LINE_CHAIN>& aSpokesList )
 {
     BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
     BOX2I                  zoneBB = aZone->GetBoundingBox();
-    DRC_CONSTRAINT         constraint;
 
     zoneBB.Inflate( std::max( bds.GetBiggestClearanceValue(), aZone->GetLocalClearance() ) );
 
@@ -1752,250 +2145,436 @@ void ZONE_FILLER::buildThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer,
     // MaxError, and we add 1.5 mil for some wiggle room.
     int epsilon = KiROUND( bds.m_MaxError + pcbIUScale.IU_PER_MM * 0.038 ); // 1.5 mil
 
-    for( PAD* pad : aSpokedPadsList )
+    // Pads are independent of each other, so build their spokes in parallel.  They are then
+    // gathered in pad order, which keeps the fill the same from one run to the next.
+    std::vector<std::vector<SHAPE_LINE_CHAIN>> padSpokes( aSpokedPadsList.size() );
+
+    ParallelFor( aSpokedPadsList.size(),
+                 [&]( size_t aIdx )
+                 {
+                     buildPadThermalSpokes( aZone, aLayer, aSpokedPadsList[aIdx], zoneBB,
+                                            epsilon, padSpokes[aIdx] );
+                 } );
+
+    size_t count = 0;
+
+    for( const std::vector<SHAPE_LINE_CHAIN>& spokes : padSpokes )
+        count += spokes.size();
+
+    aSpokesList.reserve( aSpokesList.size() + count );
+
+    for( std::vector<SHAPE_LINE_CHAIN>& spokes : padSpokes )
     {
-        // We currently only connect to pads, not pad holes
-        if( !pad->IsOnLayer( aLayer ) )
-            continue;
+        for( SHAPE_LINE_CHAIN& spoke : spokes )
+            aSpokesList.push_back( std::move( spoke ) );
+    }
+}
 
-        constraint = bds.m_DRCEngine->EvalRules( THERMAL_RELIEF_GAP_CONSTRAINT, pad, aZone, aLayer );
-        int thermalReliefGap = constraint.GetValue().Min();
 
-        constraint = bds.m_DRCEngine->EvalRules( THERMAL_SPOKE_WIDTH_CONSTRAINT, pad, aZone, aLayer );
-        int spoke_w = constraint.GetValue().Opt();
+void ZONE_FILLER::buildPadThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer, PAD* aPad,
+                                         const BOX2I& aZoneBB, int aEpsilon,
+                                         std::vector<SHAPE_LINE_CHAIN>& aSpokes )
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    DRC_CONSTRAINT         constraint;
 
-        // Spoke width should ideally be smaller than the pad minor axis.
-        // Otherwise the thermal shape is not really a thermal relief,
-        // and the algo to count the actual number of spokes can fail
-        int spoke_max_allowed_w = std::min( pad->GetSize().x, pad->GetSize().y );
+    // We currently only connect to pads, not pad holes
+    if( !aPad->IsOnLayer( aLayer ) )
+        return;
 
-        spoke_w = std::max( spoke_w, constraint.Value().Min() );
-        spoke_w = std::min( spoke_w, constraint.Value().Max() );
+    constraint = bds.m_DRCEngine->EvalRules( THERMAL_RELIEF_GAP_CONSTRAINT, aPad, aZone, aLayer );
+    int thermalReliefGap = constraint.GetValue().Min();
 
-        // ensure the spoke width is smaller than the pad minor size
-        spoke_w = std::min( spoke_w, spoke_max_allowed_w );
+    constraint = bds.m_DRCEngine->EvalRules( THERMAL_SPOKE_WIDTH_CONSTRAINT, aPad, aZone, aLayer );
+    int spoke_w = constraint.GetValue().Opt();
 
-        // Cannot create stubs having a width < zone min thickness
-        if( spoke_w < aZone->GetMinThickness() )
-            continue;
+    // Spoke width should ideally be smaller than the pad minor axis.
+    // Otherwise the thermal shape is not really a thermal relief,
+    // and the algo to count the actual number of spokes can fail
+    int spoke_max_allowed_w = std::min( aPad->GetSize().x, aPad->GetSize().y );
 
-        int spoke_half_w = spoke_w / 2;
+    spoke_w = std::max( spoke_w, constraint.Value().Min() );
+    spoke_w = std::min( spoke_w, constraint.Value().Max() );
 
-        // Quick test here to possibly save us some work
-        BOX2I itemBB = pad->GetBoundingBox();
-        itemBB.Inflate( thermalReliefGap + epsilon );
+    // ensure the spoke width is smaller than the pad minor size
+    spoke_w = std::min( spoke_w, spoke_max_allowed_w );
 
-        if( !( itemBB.Intersects( zoneBB ) ) )
-            continue;
+    // Cannot create stubs having a width < zone min thickness
+    if( spoke_w < aZone->GetMinThickness() )
+        return;
+
+    int spoke_half_w = spoke_w / 2;
 
-        bool customSpokes = false;
+    // Quick test here to possibly save us some work
+    BOX2I itemBB = aPad->GetBoundingBox();
+    itemBB.Inflate( thermalReliefGap + aEpsilon );
 
-        if( pad->GetShape() == PAD_SHAPE::CUSTOM )
+    if( !( itemBB.Intersects( aZoneBB ) ) )
+        return;
+
+    bool customSpokes = false;
+
+    if( aPad->GetShape() == PAD_SHAPE::CUSTOM )
+    {
+        for( const std::shared_ptr<PCB_SHAPE>& primitive : aPad->GetPrimitives() )
         {
-            for( const std::shared_ptr<PCB_SHAPE>& primitive : pad->GetPrimitives() )
+            if( primitive->IsProxyItem() && primitive->GetShape() == SHAPE_T::SEGMENT )
             {
-                if( primitive->IsProxyItem() && primitive->GetShape() == SHAPE_T::SEGMENT )
-                {
-                    customSpokes = true;
-                    break;
-                }
+                customSpokes = true;
+                break;
             }
         }
+    }
 
-        // Thermal spokes consist of square-ended segments from the pad center to points just
-        // outside the thermal relief.  The outside end has an extra center point (which must be
-        // at idx 3) which is used for testing whether or not the spoke connects to copper in the
-        // parent zone.
+    // Thermal spokes consist of square-ended segments from the pad center to points just
+    // outside the thermal relief.  The outside end has an extra center point (which must be
+    // at idx 3) which is used for testing whether or not the spoke connects to copper in the
+    // parent zone.
 
-        auto buildSpokesFromOrigin =
-                [&]( const BOX2I& box )
+    auto buildSpokesFromOrigin =
+            [&]( const BOX2I& box )
+            {
+                for( int i = 0; i < 4; i++ )
                 {
-                    for( int i = 0; i < 4; i++ )
+                    SHAPE_LINE_CHAIN spoke;
+
+                    switch( i )
                     {
-                        SHAPE_LINE_CHAIN spoke;
+                    case 0:       // lower stub
+                        spoke.Append( +spoke_half_w, -spoke_half_w );
+                        spoke.Append( -spoke_half_w, -spoke_half_w );
+                        spoke.Append( -spoke_half_w, box.GetBottom() );
+                        spoke.Append( 0,             box.GetBottom() );  // test pt
+                        spoke.Append( +spoke_half_w, box.GetBottom() );
+                        break;
 
-                        switch( i )
-                        {
-                        case 0:       // lower stub
-                            spoke.Append( +spoke_half_w, -spoke_half_w );
-                            spoke.Append( -spoke_half_w, -spoke_half_w );
-                            spoke.Append( -spoke_half_w, box.GetBottom() );
-                            spoke.Append( 0,             box.GetBottom() );  // test pt
-                            spoke.Append( +spoke_half_w, box.GetBottom() );
-                            break;
-
-                        case 1:       // upper stub
-                            spoke.Append( +spoke_half_w, +spoke_half_w );
-                            spoke.Append( -spoke_half_w, +spoke_half_w );
-                            spoke.Append( -spoke_half_w, box.GetTop() );
-                            spoke.Append( 0,             box.GetTop() );     // test pt
-                            spoke.Append( +spoke_half_w, box.GetTop() );
-                            break;
-
-                        case 2:       // right stub
-                            spoke.Append( -spoke_half_w,  +spoke_half_w );
-                            spoke.Append( -spoke_half_w,  -spoke_half_w );
-                            spoke.Append( box.GetRight(), -spoke_half_w );
-                            spoke.Append( box.GetRight(), 0             );   // test pt
-                            spoke.Append( box.GetRight(), +spoke_half_w );
-                            break;
-
-                        case 3:       // left stub
-                            spoke.Append( +spoke_half_w, +spoke_half_w );
-                            spoke.Append( +spoke_half_w, -spoke_half_w );
-                            spoke.Append( box.GetLeft(), -spoke_half_w );
-                            spoke.Append( box.GetLeft(), 0             );    // test pt
-                            spoke.Append( box.GetLeft(), +spoke_half_w );
-                            break;
-                        }
+                    case 1:       // upper stub
+                        spoke.Append( +spoke_half_w, +spoke_half_w );
+                        spoke.Append( -spoke_half_w, +spoke_half_w );
+                        spoke.Append( -spoke_half_w, box.GetTop() );
+                        spoke.Append( 0,             box.GetTop() );     // test pt
+                        spoke.Append( +spoke_half_w, box.GetTop() );
+                        break;
+
+                    case 2:       // right stub
+                        spoke.Append( -spoke_half_w,  +spoke_half_w );
+                        spoke.Append( -spoke_half_w,  -spoke_half_w );
+                        spoke.Append( box.GetRight(), -spoke_half_w );
+                        spoke.Append( box.GetRight(), 0             );   // test pt
+                        spoke.Append( box.GetRight(), +spoke_half_w );
+                        break;
 
-                        spoke.SetClosed( true );
-                        aSpokesList.push_back( std::move( spoke ) );
+                    case 3:       // left stub
+                        spoke.Append( +spoke_half_w, +spoke_half_w );
+                        spoke.Append( +spoke_half_w, -spoke_half_w );
+                        spoke.Append( box.GetLeft(), -spoke_half_w );
+                        spoke.Append( box.GetLeft(), 0             );    // test pt
+                        spoke.Append( box.GetLeft(), +spoke_half_w );
+                        break;
                     }
-                };
 
-        if( customSpokes )
-        {
-            SHAPE_POLY_SET   thermalPoly;
-            SHAPE_LINE_CHAIN thermalOutline;
+                    spoke.SetClosed( true );
+                    aSpokes.push_back( std::move( spoke ) );
+                }
+            };
+
+    if( customSpokes )
+    {
+        SHAPE_POLY_SET   thermalPoly;
+        SHAPE_LINE_CHAIN thermalOutline;
 
-            pad->TransformShapeToPolygon( thermalPoly, aLayer, thermalReliefGap + epsilon,
-                                          m_maxError, ERROR_OUTSIDE );
+        aPad->TransformShapeToPolygon( thermalPoly, aLayer, thermalReliefGap + aEpsilon,
+                                      m_maxError, ERROR_OUTSIDE );
 
-            if( thermalPoly.OutlineCount() )
-                thermalOutline = thermalPoly.Outline( 0 );
+        if( thermalPoly.OutlineCount() )
+            thermalOutline = thermalPoly.Outline( 0 );
 
-            for( const std::shared_ptr<PCB_SHAPE>& primitive : pad->GetPrimitives() )
+        for( const std::shared_ptr<PCB_SHAPE>& primitive : aPad->GetPrimitives() )
+        {
+            if( primitive->IsProxyItem() && primitive->GetShape() == SHAPE_T::SEGMENT )
             {
-                if( primitive->IsProxyItem() && primitive->GetShape() == SHAPE_T::SEGMENT )
-                {
-                    SEG seg( primitive->GetStart(), primitive->GetEnd() );
-                    SHAPE_LINE_CHAIN::INTERSECTIONS intersections;
+                SEG seg( primitive->GetStart(), primitive->GetEnd() );
+                SHAPE_LINE_CHAIN::INTERSECTIONS intersections;
 
-                    RotatePoint( seg.A, pad->GetOrientation() );
-                    RotatePoint( seg.B, pad->GetOrientation() );
-                    seg.A += pad->ShapePos();
-                    seg.B += pad->ShapePos();
+                RotatePoint( seg.A, aPad->GetOrientation() );
+                RotatePoint( seg.B, aPad->GetOrientation() );
+                seg.A += aPad->ShapePos();
+                seg.B += aPad->ShapePos();
 
-                    // Make sure seg.A is the origin
-                    if( !pad->GetEffectivePolygon( ERROR_OUTSIDE )->Contains( seg.A ) )
-                        seg.Reverse();
+                // Make sure seg.A is the origin
+                if( !aPad->GetEffectivePolygon( ERROR_OUTSIDE )->Contains( seg.A ) )
+                    seg.Reverse();
 
-                    // Trim seg.B to the thermal outline
-                    if( thermalOutline.Intersect( seg, intersections ) )
-                    {
-                        seg.B = intersections.front().p;
+                // Trim seg.B to the thermal outline
+                if( thermalOutline.Intersect( seg, intersections ) )
+                {
+                    seg.B = intersections.front().p;
 
-                        VECTOR2I offset = ( seg.B - seg.A ).Perpendicular().Resize( spoke_half_w );
-                        SHAPE_LINE_CHAIN spoke;
+                    VECTOR2I offset = ( seg.B - seg.A ).Perpendicular().Resize( spoke_half_w );
+                    SHAPE_LINE_CHAIN spoke;
 
-                        spoke.Append( seg.A + offset );
-                        spoke.Append( seg.A - offset );
-                        spoke.Append( seg.B - offset );
-                        spoke.Append( seg.B          );  // test pt
-                        spoke.Append( seg.B + offset );
+                    spoke.Append( seg.A + offset );
+                    spoke.Append( seg.A - offset );
+                    spoke.Append( seg.B - offset );
+                    spoke.Append( seg.B          );  // test pt
+                    spoke.Append( seg.B + offset );
 
-                        spoke.SetClosed( true );
-                        aSpokesList.push_back( std::move( spoke ) );
-                    }
+                    spoke.SetClosed( true );
+                    aSpokes.push_back( std::move( spoke ) );
                 }
             }
         }
-        // If the spokes are at a cardinal angle then we can generate them from a bounding box
-        // without trig.
-        else if( ( pad->GetOrientation() + pad->GetThermalSpokeAngle() ).IsCardinal() )
+    }
+    // If the spokes are at a cardinal angle then we can generate them from a bounding box
+    // without trig.
+    else if( ( aPad->GetOrientation() + aPad->GetThermalSpokeAngle() ).IsCardinal() )
+    {
+        BOX2I spokesBox = aPad->GetBoundingBox();
+        spokesBox.Inflate( thermalReliefGap + aEpsilon );
+
+        // Spokes are from center of pad shape, not from hole.
+        spokesBox.Offset( - aPad->ShapePos() );
+
+        buildSpokesFromOrigin( spokesBox );
+
+        auto spokeIter = aSpokes.rbegin();
+
+        for( int ii = 0; ii < 4; ++ii, ++spokeIter )
+            spokeIter->Move( aPad->ShapePos() );
+    }
+    // Even if the spokes are rotated, we can fudge it for round and square pads by rotating
+    // the bounding box to match the spokes.
+    else if( aPad->GetSizeX() == aPad->GetSizeY() && aPad->GetShape() != PAD_SHAPE::CUSTOM )
+    {
+        // Since the bounding-box needs to be correclty rotated we use a dummy pad to keep
+        // from dirtying the real pad's cached shapes.
+        PAD dummy_pad( *aPad );
+        dummy_pad.SetOrientation( aPad->GetThermalSpokeAngle() );
+
+        // Spokes are from center of pad shape, not from hole. So the dummy pad has no shape
+        // offset and is at position 0,0
+        dummy_pad.SetPosition( VECTOR2I( 0, 0 ) );
+        dummy_pad.SetOffset( VECTOR2I( 0, 0 ) );
+
+        BOX2I spokesBox = dummy_pad.GetBoundingBox();
+        spokesBox.Inflate( thermalReliefGap + aEpsilon );
+
+        buildSpokesFromOrigin( spokesBox );
+
+        auto spokeIter = aSpokes.rbegin();
+
+        for( int ii = 0; ii < 4; ++ii, ++spokeIter )
         {
-            BOX2I spokesBox = pad->GetBoundingBox();
-            spokesBox.Inflate( thermalReliefGap + epsilon );
+            spokeIter->Rotate( aPad->GetOrientation() + aPad->GetThermalSpokeAngle() );
+            spokeIter->Move( aPad->ShapePos() );
+        }
+    }
+    // And lastly, even when we have to resort to trig, we can use it only in a post-process
+    // after the rotated-bounding-box trick from above.
+    else
+    {
+        // Since the bounding-box needs to be correclty rotated we use a dummy pad to keep
+        // from dirtying the real pad's cached shapes.
+        PAD dummy_pad( *aPad );
+        dummy_pad.SetOrientation( aPad->GetThermalSpokeAngle() );
+
+        // Spokes are from center of pad shape, not from hole. So the dummy pad has no shape
+        // offset and is at position 0,0
+        dummy_pad.SetPosition( VECTOR2I( 0, 0 ) );
+        dummy_pad.SetOffset( VECTOR2I( 0, 0 ) );
 
-            // Spokes are from center of pad shape, not from hole.
-            spokesBox.Offset( - pad->ShapePos() );
+        BOX2I spokesBox = dummy_pad.GetBoundingBox();
 
-            buildSpokesFromOrigin( spokesBox );
+        // In this case make the box -big-; we're going to clip to the "real" bbox later.
+        spokesBox.Inflate( thermalReliefGap + spokesBox.GetWidth() + spokesBox.GetHeight() );
 
-            auto spokeIter = aSpokesList.rbegin();
+        buildSpokesFromOrigin( spokesBox );
 
-            for( int ii = 0; ii < 4; ++ii, ++spokeIter )
-                spokeIter->Move( pad->ShapePos() );
+        BOX2I realBBox = aPad->GetBoundingBox();
+        realBBox.Inflate( thermalReliefGap + aEpsilon );
+
+        auto spokeIter = aSpokes.rbegin();
+
+        for( int ii = 0; ii < 4; ++ii, ++spokeIter )
+        {
+            spokeIter->Rotate( aPad->GetOrientation() + aPad->GetThermalSpokeAngle() );
+            spokeIter->Move( aPad->ShapePos() );
+
+            VECTOR2I origin_p = spokeIter->GetPoint( 0 );
+            VECTOR2I origin_m = spokeIter->GetPoint( 1 );
+            VECTOR2I origin = ( origin_p + origin_m ) / 2;
+            VECTOR2I end_m = spokeIter->GetPoint( 2 );
+            VECTOR2I end = spokeIter->GetPoint( 3 );
+            VECTOR2I end_p = spokeIter->GetPoint( 4 );
+
+            ClipLine( &realBBox, origin_p.x, origin_p.y, end_p.x, end_p.y );
+            ClipLine( &realBBox, origin_m.x, origin_m.y, end_m.x, end_m.y );
+            ClipLine( &realBBox, origin.x, origin.y, end.x, end.y );
+
+            spokeIter->SetPoint( 2, end_m );
+            spokeIter->SetPoint( 3, end );
+            spokeIter->SetPoint( 4, end_p );
         }
-        // Even if the spokes are rotated, we can fudge it for round and square pads by rotating
-        // the bounding box to match the spokes.
-        else if( pad->GetSizeX() == pad->GetSizeY() && pad->GetShape() != PAD_SHAPE::CUSTOM )
+    }
+
+    for( SHAPE_LINE_CHAIN& spoke : aSpokes )
+        spoke.GenerateBBoxCache();
+}
+
+
+/**
+ * Place the holes of a hatch grid against \a aClipArea, a row of holes at a time.
+ *
+ * A row only meets the clip area edges which cross its band, and between those edges each of
+ * its holes is either all inside or all outside of the area.  Holes found inside go straight to
+ * \a aInnerHoles, and holes found outside are dropped.  Only the holes which meet an edge are
+ * put in \a aEdgeHoles, for the caller to clip.
+ *
+ * @param aOrigin is the position of the first hole of the grid.
+ * @param aColumns and \a aRows are the size of the grid.
+ */
+static void placeHatchHoles( const SHAPE_POLY_SET& aClipArea, const SHAPE_LINE_CHAIN& aHoleBase,
+                             const VECTOR2I& aOrigin, int aHoleSize, int aGridSize, int aColumns,
+                             int aRows, SHAPE_POLY_SET& aInnerHoles, SHAPE_POLY_SET& aEdgeHoles )
+{
+    std::vector<SEG>              edges;
+    std::vector<std::vector<int>> rowEdges( aRows );
+
+    auto addContour =
+            [&]( const SHAPE_LINE_CHAIN& aContour )
+            {
+                for( int ii = 0; ii < aContour.SegmentCount(); ++ii )
+                    edges.push_back( aContour.CSegment( ii ) );
+            };
+
+    for( int ii = 0; ii < aClipArea.OutlineCount(); ++ii )
+    {
+        addContour( aClipArea.COutline( ii ) );
+
+        for( int jj = 0; jj < aClipArea.HoleCount( ii ); ++jj )
+            addContour( aClipArea.CHole( ii, jj ) );
+    }
+
+    // Bucket the edges by the rows whose band they cross
+    for( int ii = 0; ii < (int) edges.size(); ++ii )
+    {
+        int top = std::min( edges[ii].A.y, edges[ii].B.y ) - aOrigin.y;
+        int bottom = std::max( edges[ii].A.y, edges[ii].B.y ) - aOrigin.y;
+
+        // Row rr covers [rr * aGridSize, rr * aGridSize + aHoleSize]
+        int first = std::max( 0, ( top - aHoleSize ) / aGridSize );
+        int last = std::min( aRows - 1, bottom >= 0 ? bottom / aGridSize : -1 );
+
+        for( int rr = first; rr <= last; ++rr )
         {
-            // Since the bounding-box needs to be correclty rotated we use a dummy pad to keep
-            // from dirtying the real pad's cached shapes.
-            PAD dummy_pad( *pad );
-            dummy_pad.SetOrientation( pad->GetThermalSpokeAngle() );
+            if( (long long) rr * aGridSize + aHoleSize >= top
+                    && (long long) rr * aGridSize <= bottom )
+            {
+                rowEdges[rr].push_back( ii );
+            }
+        }
+    }
 
-            // Spokes are from center of pad shape, not from hole. So the dummy pad has no shape
-            // offset and is at position 0,0
-            dummy_pad.SetPosition( VECTOR2I( 0, 0 ) );
-            dummy_pad.SetOffset( VECTOR2I( 0, 0 ) );
+    std::vector<double>                    crossings;
+    std::vector<std::pair<double, double>> blocked;
+
+    for( int rr = 0; rr < aRows; ++rr )
+    {
+        double bandTop = (double) aOrigin.y + (double) rr * aGridSize;
+        double bandBottom = bandTop + aHoleSize;
 
-            BOX2I spokesBox = dummy_pad.GetBoundingBox();
-            spokesBox.Inflate( thermalReliefGap + epsilon );
+        // Coordinates are integers, so the test line never goes through a vertex
+        double testY = bandTop + aHoleSize / 2 + 0.5;
+
+        crossings.clear();
+        blocked.clear();
+
+        for( int ii : rowEdges[rr] )
+        {
+            const VECTOR2I& a = edges[ii].A;
+            const VECTOR2I& b = edges[ii].B;
 
-            buildSpokesFromOrigin( spokesBox );
+            if( ( a.y < testY ) != ( b.y < testY ) )
+                crossings.push_back( a.x + ( testY - a.y ) * ( b.x - a.x ) / ( b.y - a.y ) );
 
-            auto spokeIter = aSpokesList.rbegin();
+            double xMin, xMax;
 
-            for( int ii = 0; ii < 4; ++ii, ++spokeIter )
+            if( a.y == b.y )
             {
-                spokeIter->Rotate( pad->GetOrientation() + pad->GetThermalSpokeAngle() );
-                spokeIter->Move( pad->ShapePos() );
+                xMin = std::min( a.x, b.x );
+                xMax = std::max( a.x, b.x );
             }
+            else
+            {
+                double t0 = ( bandTop - a.y ) / ( b.y - a.y );
+                double t1 = ( bandBottom - a.y ) / ( b.y - a.y );
+                double tMin = std::max( 0.0, std::min( t0, t1 ) );
+                double tMax = std::min( 1.0, std::max( t0, t1 ) );
+
+                double x0 = a.x + tMin * ( b.x - a.x );
+                double x1 = a.x + tMax * ( b.x - a.x );
+
+                xMin = std::min( x0, x1 );
+                xMax = std::max( x0, x1 );
+            }
+
+            // Leave some room for rounding
+            blocked.emplace_back( xMin - 1.0, xMax + 1.0 );
         }
-        // And lastly, even when we have to resort to trig, we can use it only in a post-process
-        // after the rotated-bounding-box trick from above.
-        else
+
+        std::sort( crossings.begin(), crossings.end() );
+        std::sort( blocked.begin(), blocked.end() );
+
+        // Merge the blocked spans so that they can be searched
+        size_t merged = 0;
+
+        for( size_t ii = 0; ii < blocked.size(); ++ii )
         {
-            // Since the bounding-box needs to be correclty rotated we use a dummy pad to keep
-            // from dirtying the real pad's cached shapes.
-            PAD dummy_pad( *pad );
-            dummy_pad.SetOrientation( pad->GetThermalSpokeAngle() );
+            if( merged > 0 && blocked[ii].first <= blocked[merged - 1].second )
+            {
+                blocked[merged - 1].second = std::max( blocked[merged - 1].second,
+                                                       blocked[ii].second );
+            }
+            else
+            {
+                blocked[merged++] = blocked[ii];
+            }
+        }
 
-            // Spokes are from center of pad shape, not from hole. So the dummy pad has no shape
-            // offset and is at position 0,0
-            dummy_pad.SetPosition( VECTOR2I( 0, 0 ) );
-            dummy_pad.SetOffset( VECTOR2I( 0, 0 ) );
+        blocked.resize( merged );
 
-            BOX2I spokesBox = dummy_pad.GetBoundingBox();
+        for( int cc = 0; cc < aColumns; ++cc )
+        {
+            double left = (double) aOrigin.x + (double) cc * aGridSize;
+            double right = left + aHoleSize;
 
-            // In this case make the box -big-; we're going to clip to the "real" bbox later.
-            spokesBox.Inflate( thermalReliefGap + spokesBox.GetWidth() + spokesBox.GetHeight() );
+            // First blocked span which ends to the right of the hole's left side
+            auto it = std::lower_bound( blocked.begin(), blocked.end(), left,
+                                        []( const std::pair<double, double>& aSpan, double aX )
+                                        {
+                                            return aSpan.second < aX;
+                                        } );
 
-            buildSpokesFromOrigin( spokesBox );
+            SHAPE_POLY_SET* target = &aEdgeHoles;
 
-            BOX2I realBBox = pad->GetBoundingBox();
-            realBBox.Inflate( thermalReliefGap + epsilon );
+            if( it == blocked.end() || it->first > right )
+            {
+                // No edge crosses the hole, so it is inside if its center is
+                double center = ( left + right ) / 2;
+                size_t before = std::lower_bound( crossings.begin(), crossings.end(), center )
+                                - crossings.begin();
 
-            auto spokeIter = aSpokesList.rbegin();
+                target = ( before % 2 ) ? &aInnerHoles : nullptr;
+            }
 
-            for( int ii = 0; ii < 4; ++ii, ++spokeIter )
+            if( target )
             {
-                spokeIter->Rotate( pad->GetOrientation() + pad->GetThermalSpokeAngle() );
-                spokeIter->Move( pad->ShapePos() );
-
-                VECTOR2I origin_p = spokeIter->GetPoint( 0 );
-                VECTOR2I origin_m = spokeIter->GetPoint( 1 );
-                VECTOR2I origin = ( origin_p + origin_m ) / 2;
-                VECTOR2I end_m = spokeIter->GetPoint( 2 );
-                VECTOR2I end = spokeIter->GetPoint( 3 );
-                VECTOR2I end_p = spokeIter->GetPoint( 4 );
-
-                ClipLine( &realBBox, origin_p.x, origin_p.y, end_p.x, end_p.y );
-                ClipLine( &realBBox, origin_m.x, origin_m.y, end_m.x, end_m.y );
-                ClipLine( &realBBox, origin.x, origin.y, end.x, end.y );
-
-                spokeIter->SetPoint( 2, end_m );
-                spokeIter->SetPoint( 3, end );
-                spokeIter->SetPoint( 4, end_p );
+                SHAPE_LINE_CHAIN hole( aHoleBase );
+                hole.Move( VECTOR2I( aOrigin.x + cc * aGridSize, aOrigin.y + rr * aGridSize ) );
+                target->AddOutline( hole );
             }
         }
     }
-
-    for( size_t ii = 0; ii < aSpokesList.size(); ++ii )
-        aSpokesList[ii].GenerateBBoxCache();
 }
 
 
@@ -2100,54 +2679,41 @@ bool ZONE_FILLER::addHatchFillTypeOnZone( const ZONE* aZone, PCB_LAYER_ID aLayer
         }
     }
 
-    // Build holes
-    SHAPE_POLY_SET holes;
-
-    for( int xx = 0; ; xx++ )
-    {
-        int xpos = xx * gridsize;
-
-        if( xpos > bbox.GetWidth() )
-            break;
-
-        for( int yy = 0; ; yy++ )
-        {
-            int ypos = yy * gridsize;
+    int outline_margin = aZone->GetMinThickness() * 1.1;
 
-            if( ypos > bbox.GetHeight() )
-                break;
+    // Using GetHatchThickness() can look more consistent than GetMinThickness().
+    if( aZone->GetHatchBorderAlgorithm() && aZone->GetHatchThickness() > outline_margin )
+        outline_margin = aZone->GetHatchThickness();
 
-            // Generate hole
-            SHAPE_LINE_CHAIN hole( hole_base );
-            hole.Move( VECTOR2I( xpos, ypos ) );
-            holes.AddOutline( hole );
-        }
-    }
+    // Holes are clipped to the fill and to the zone outline.  The fill has already been
+    // deflated to ensure GetMinThickness() so we just have to account for anything beyond that.
+    SHAPE_POLY_SET clipArea = aFillPolys.CloneDropTriangulation();
+    clipArea.Deflate( outline_margin - aZone->GetMinThickness(),
+                      CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
 
-    holes.Move( bbox.GetPosition() );
+    SHAPE_POLY_SET deflatedOutline = aZone->Outline()->CloneDropTriangulation();
+    deflatedOutline.Deflate( outline_margin, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
+    clipArea.BooleanIntersection( deflatedOutline, SHAPE_POLY_SET::PM_FAST );
 
+    // The grid is laid out along the hatch orientation
     if( !aZone->GetHatchOrientation().IsZero() )
-        holes.Rotate( aZone->GetHatchOrientation() );
+        clipArea.Rotate( - aZone->GetHatchOrientation() );
 
-    DUMP_POLYS_TO_COPPER_LAYER( holes, In10_Cu, wxT( "hatch-holes" ) );
+    // Build holes.  Only those which meet the edge of the clip area need a boolean operation;
+    // there are far fewer of them than holes in the grid.
+    SHAPE_POLY_SET holes;
+    SHAPE_POLY_SET edgeHoles;
 
-    int outline_margin = aZone->GetMinThickness() * 1.1;
+    placeHatchHoles( clipArea, hole_base, bbox.GetPosition(), hole_size, gridsize,
+                     bbox.GetWidth() / gridsize + 1, bbox.GetHeight() / gridsize + 1, holes,
+                     edgeHoles );
 
-    // Using GetHatchThickness() can look more consistent than GetMinThickness().
-    if( aZone->GetHatchBorderAlgorithm() && aZone->GetHatchThickness() > outline_margin )
-        outline_margin = aZone->GetHatchThickness();
+    edgeHoles.BooleanIntersection( clipArea, SHAPE_POLY_SET::PM_FAST );
+    holes.Append( edgeHoles );
 
-    // The fill has already been deflated to ensure GetMinThickness() so we just have to
-    // account for anything beyond that.
-    SHAPE_POLY_SET deflatedFilledPolys = aFillPolys.CloneDropTriangulation();
-    deflatedFilledPolys.Deflate( outline_margin - aZone->GetMinThickness(),
-                                 CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
-    holes.BooleanIntersection( deflatedFilledPolys, SHAPE_POLY_SET::PM_FAST );
-    DUMP_POLYS_TO_COPPER_LAYER( holes, In11_Cu, wxT( "fill-clipped-hatch-holes" ) );
+    if( !aZone->GetHatchOrientation().IsZero() )
+        holes.Rotate( aZone->GetHatchOrientation() );
 
-    SHAPE_POLY_SET deflatedOutline = aZone->Outline()->CloneDropTriangulation();
-    deflatedOutline.Deflate( outline_margin, CORNER_STRATEGY::CHAMFER_ALL_CORNERS, maxError );
-    holes.BooleanIntersection( deflatedOutline, SHAPE_POLY_SET::PM_FAST );
     DUMP_POLYS_TO_COPPER_LAYER( holes, In12_Cu, wxT( "outline-clipped-hatch-holes" ) );
 
     if( aZone->GetNetCode() != 0 )
@@ -26,6 +26,8 @@
 #ifndef ZONE_FILLER_H
 #define ZONE_FILLER_H
 
+#include <functional>
+#include <map>
 #include <vector>
 #include <zone.h>
 
@@ -34,6 +36,7 @@ class BOARD;
 class COMMIT;
 class SHAPE_POLY_SET;
 class SHAPE_LINE_CHAIN;
+struct ZONE_KNOCKOUT_KEY;
 
 
 class ZONE_FILLER
@@ -57,6 +60,27 @@ public:
      */
     bool Fill( std::vector<ZONE*>& aZones, bool aCheck = false, wxWindow* aParent = nullptr );
 
+    /**
+     * Let Fill() refill some zones only where they may have changed, around the given area of
+     * each, and keep their previous fill elsewhere.  The other zones, and those whose previous
+     * fill can't be reused, are filled from scratch.
+     */
+    void SetDirtyAreas( const std::map<ZONE*, BOX2I>& aAreas ) { m_dirtyAreas = aAreas; }
+
+    /**
+     * Let Fill() leave alone the zones which are filled from the inputs they have now, as
+     * recorded by the hashes it keeps with the fills (see ZONE_FILL_HASHER).
+     */
+    void SetSkipUpToDate( bool aSkip ) { m_skipUpToDate = aSkip; }
+
+    /**
+     * Make quick, approximate fills for interactive editing: arcs are approximated more
+     * coarsely (see the DraftZoneFillMaxError advanced setting), and fills are neither fractured
+     * nor cleared of islands.  The zones are flagged with ZONE::IsDraftFill() until they get a
+     * full-precision fill.
+     */
+    void SetDraft( bool aDraft ) { m_draft = aDraft; }
+
     bool IsDebug() const { return m_debugZoneFiller; }
 
 private:
@@ -68,11 +92,16 @@ private:
 
     void addHoleKnockout( PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
 
-    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFill,
+    void addCachedKnockout( const ZONE_KNOCKOUT_KEY& aKey,
+                            const std::function<void( SHAPE_POLY_SET& )>& aBuilder,
+                            SHAPE_POLY_SET& aHoles );
+
+    void knockoutThermalReliefs( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aArea,
+                                 SHAPE_POLY_SET& aFill,
                                  std::vector<PAD*>& aThermalConnectionPads,
                                  std::vector<PAD*>& aNoConnectionPads );
 
-    void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer,
+    void buildCopperItemClearances( const ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aArea,
                                     const std::vector<PAD*> aNoConnectionPads,
                                     SHAPE_POLY_SET& aHoles );
 
@@ -89,9 +118,10 @@ private:
      * BuildFilledSolidAreasPolygons() call this function just after creating the
      *  filled copper area polygon (without clearance areas
      * @param aPcb: the current board
+     * @param aArea: the part of the zone being filled; items away from it are skipped
      */
     bool fillCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer, PCB_LAYER_ID aDebugLayer,
-                         const SHAPE_POLY_SET& aSmoothedOutline,
+                         const BOX2I& aArea, const SHAPE_POLY_SET& aSmoothedOutline,
                          const SHAPE_POLY_SET& aMaxExtents, SHAPE_POLY_SET& aFillPolys );
 
     bool fillNonCopperZone( const ZONE* aZone, PCB_LAYER_ID aLayer,
@@ -102,7 +132,15 @@ private:
      */
     void buildThermalSpokes( const ZONE* box, PCB_LAYER_ID aLayer,
                              const std::vector<PAD*>& aSpokedPadsList,
-                             std::deque<SHAPE_LINE_CHAIN>& aSpokes );
+                             std::vector<SHAPE_LINE_CHAIN>& aSpokes );
+
+    /**
+     * Append the thermal spokes of \a aPad to \a aSpokes.  Safe to call for several pads of
+     * the same zone concurrently.
+     */
+    void buildPadThermalSpokes( const ZONE* aZone, PCB_LAYER_ID aLayer, PAD* aPad,
+                                const BOX2I& aZoneBB, int aEpsilon,
+                                std::vector<SHAPE_LINE_CHAIN>& aSpokes );
 
     /**
      * Build the filled solid areas polygons from zone outlines (stored in m_Poly)
@@ -115,8 +153,38 @@ private:
      * (holes are linked to main outline by overlapping segments, and these polygons are shrunk
      * by aZone->GetMinThickness() / 2 to be drawn with a outline thickness = aZone->GetMinThickness()
      * aFillPolys are polygons that will be drawn on screen and plotted
+     * @param aClipArea: if not null, only fill the part of the zone within this box
+     */
+    bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys,
+                         const BOX2I* aClipArea = nullptr );
+
+    /// The previous fill of a zone layer, for a refill of part of it
+    struct PARTIAL_REFILL
+    {
+        BOX2I          m_dirtyArea;         ///< around the changed items
+        SHAPE_POLY_SET m_oldFill;
+        SHAPE_POLY_SET m_removedIslands;    ///< from the old fill; the refill leaves those it
+                                            ///<   doesn't reach
+    };
+
+    /**
+     * @return true if the fill of \a aZone on \a aLayer can be recomputed around a part of
+     *         the zone only.
      */
-    bool fillSingleZone( ZONE* aZone, PCB_LAYER_ID aLayer, SHAPE_POLY_SET& aFillPolys );
+    bool canRefillPartially( const ZONE* aZone, PCB_LAYER_ID aLayer ) const;
+
+    /**
+     * @return how far from a changed item the fill of \a aZone may change: clearances,
+     *         thermal reliefs and their spokes, and the minimum width pruning.
+     */
+    int refillMargin( const ZONE* aZone ) const;
+
+    /**
+     * Refill \a aZone on \a aLayer within \a aArea, and stitch the result into the previous
+     * fill (along with the islands removed from it) of \a aRefill outside of it.
+     */
+    bool refillZoneArea( ZONE* aZone, PCB_LAYER_ID aLayer, const BOX2I& aArea,
+                         PARTIAL_REFILL& aRefill, SHAPE_POLY_SET& aFillPolys );
 
     /**
      * for zones having the ZONE_FILL_MODE::ZONE_FILL_MODE::HATCH_PATTERN, create a grid pattern
@@ -136,6 +204,11 @@ private:
 
     int                   m_maxError;
     int                   m_worstClearance;
+    int                   m_worstThermalGap;
+
+    std::map<ZONE*, BOX2I> m_dirtyAreas;
+    bool                  m_skipUpToDate;
+    bool                  m_draft;
 
     bool                  m_debugZoneFiller;
 };
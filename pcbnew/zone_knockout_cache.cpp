@@ -0,0 +1,96 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include "zone_knockout_cache.h"
+
+
+std::shared_ptr<const SHAPE_POLY_SET>
+ZONE_KNOCKOUT_CACHE::Get( const ZONE_KNOCKOUT_KEY& aKey,
+                          const std::function<void( SHAPE_POLY_SET& )>& aBuilder )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        auto                        it = m_knockouts.find( aKey );
+
+        if( it != m_knockouts.end() )
+        {
+            it->second.m_generation = m_generation;
+            return it->second.m_knockout;
+        }
+    }
+
+    // Build outside of the lock, as PAD_SHAPE_CACHE does.  If two threads race on the same key,
+    // the first one to finish wins.
+    std::shared_ptr<SHAPE_POLY_SET> knockout = std::make_shared<SHAPE_POLY_SET>();
+    aBuilder( *knockout );
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_knockouts.emplace( aKey, ENTRY{ std::move( knockout ), m_generation } )
+            .first->second.m_knockout;
+}
+
+
+void ZONE_KNOCKOUT_CACHE::RemoveUnused()
+{
+    const uint64_t MAX_AGE = 8;     // fills
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    for( auto it = m_knockouts.begin(); it != m_knockouts.end(); )
+    {
+        if( m_generation - it->second.m_generation >= MAX_AGE )
+            it = m_knockouts.erase( it );
+        else
+            ++it;
+    }
+
+    m_generation++;
+}
+
+
+void ZONE_KNOCKOUT_CACHE::Clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    m_knockouts.clear();
+}
+
+
+size_t ZONE_KNOCKOUT_CACHE::GetEntryCount() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    return m_knockouts.size();
+}
+
+
+size_t ZONE_KNOCKOUT_CACHE::GetMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    size_t                      bytes = 0;
+
+    for( const auto& [key, entry] : m_knockouts )
+        bytes += sizeof( key ) + sizeof( ENTRY ) + sizeof( SHAPE_POLY_SET )
+                 + entry.m_knockout->GetOutlineMemoryUsage();
+
+    return bytes;
+}
@@ -0,0 +1,137 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ZONE_KNOCKOUT_CACHE_H
+#define ZONE_KNOCKOUT_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <geometry/geometry_utils.h>
+#include <hash.h>
+#include <math/vector2d.h>
+
+class SHAPE_POLY_SET;
+
+
+/**
+ * Everything a zone knockout of a track, an arc, a via or a hole depends on.  The knockouts of
+ * tracks and holes are ovals, the ones of vias (and round holes) circles.
+ *
+ * The geometry is stored rather than a hash of it, so that keys never collide.  The layer
+ * isn't part of the key: in this tree, copper items have the same shape on all their layers.
+ */
+struct ZONE_KNOCKOUT_KEY
+{
+    enum class KIND
+    {
+        OVAL,
+        ARC,
+        CIRCLE
+    };
+
+    KIND      m_kind;
+    VECTOR2I  m_start;
+    VECTOR2I  m_mid;              ///< arcs only
+    VECTOR2I  m_end;
+    int       m_width;            ///< of the item, before the clearance
+    int       m_clearance;
+    int       m_maxError;
+    ERROR_LOC m_errorLoc;
+
+    bool operator==( const ZONE_KNOCKOUT_KEY& aOther ) const
+    {
+        return m_kind == aOther.m_kind && m_start == aOther.m_start && m_mid == aOther.m_mid
+               && m_end == aOther.m_end && m_width == aOther.m_width
+               && m_clearance == aOther.m_clearance && m_maxError == aOther.m_maxError
+               && m_errorLoc == aOther.m_errorLoc;
+    }
+};
+
+
+namespace std
+{
+    template <>
+    struct hash<ZONE_KNOCKOUT_KEY>
+    {
+        std::size_t operator()( const ZONE_KNOCKOUT_KEY& aKey ) const
+        {
+            return hash_val( static_cast<int>( aKey.m_kind ), aKey.m_start.x, aKey.m_start.y,
+                             aKey.m_mid.x, aKey.m_mid.y, aKey.m_end.x, aKey.m_end.y,
+                             aKey.m_width, aKey.m_clearance, aKey.m_maxError,
+                             static_cast<int>( aKey.m_errorLoc ) );
+        }
+    };
+}
+
+
+/**
+ * The knockouts zone fills cut around tracks, vias and holes, shared by all the zones of a board
+ * and kept from one fill to the next.
+ *
+ * Each zone layer otherwise converts the knockouts of every item near it: a via through a stack
+ * of planes is converted once per plane, and again on each refill.  Entries are the knockouts
+ * in board coordinates.
+ *
+ * Keys hold all the geometry, so entries never go stale when items change; RemoveUnused()
+ * drops the ones fills no longer ask for, so that they don't pile up during editing.
+ *
+ * Thread-safe.
+ */
+class ZONE_KNOCKOUT_CACHE
+{
+public:
+    /**
+     * @return the knockout for \a aKey, calling \a aBuilder to build it if it isn't cached yet.
+     */
+    std::shared_ptr<const SHAPE_POLY_SET>
+    Get( const ZONE_KNOCKOUT_KEY& aKey, const std::function<void( SHAPE_POLY_SET& )>& aBuilder );
+
+    /**
+     * Called at the end of each fill: drop the entries which none of the last few fills asked
+     * for.  Partial refills only ask for the knockouts around what changed, so entries are
+     * given a few fills before they go.
+     */
+    void RemoveUnused();
+
+    void Clear();
+
+    size_t GetEntryCount() const;
+
+    /**
+     * @return the estimated memory held by the cached knockouts, in bytes.
+     */
+    size_t GetMemoryUsage() const;
+
+private:
+    struct ENTRY
+    {
+        std::shared_ptr<const SHAPE_POLY_SET> m_knockout;
+        uint64_t                              m_generation;
+    };
+
+    mutable std::mutex                                  m_mutex;
+    std::unordered_map<ZONE_KNOCKOUT_KEY, ENTRY>        m_knockouts;
+    uint64_t                                            m_generation = 0;
+};
+
+#endif // ZONE_KNOCKOUT_CACHE_H
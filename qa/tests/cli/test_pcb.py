@@ -139,3 +139,21 @@ def test_pcb_export_gerber( kitest: KiTestFixture,
         # Comparison DPI = 5080 => 1px == 5um. I.e. allowable error of 15 um after eroding
         assert utils.gerbers_are_equivalent( str( generated_gerber_path ), gbr_source_path, 5080,
                                              originInches, windowsizeInches )
+
+
+def test_fp_convert( kitest: KiTestFixture ):
+    input_file = Path( kitest.get_data_file_path( "pcbnew/plugins/eagle/lbr/SparkFun-GPS.lbr" ) )
+    output_dir = kitest.get_output_path( "cli/fp_convert/" )
+    output_lib = output_dir / "SparkFun-GPS.pretty"
+
+    command = ["kicad-cli", "fp", "convert", "--force", "-o", str( output_dir ), str( input_file )]
+
+    stdout, stderr, exitcode = utils.run_and_capture( command )
+    assert exitcode == 0
+    assert output_lib.is_dir()
+
+    # The same footprints as the reference conversion of the library
+    reference_lib = input_file.with_suffix( ".pretty" )
+    converted = sorted( path.name for path in output_lib.glob( "*.kicad_mod" ) )
+    expected = sorted( path.name for path in reference_lib.glob( "*.kicad_mod" ) )
+    assert converted == expected
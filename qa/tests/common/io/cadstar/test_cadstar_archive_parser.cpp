@@ -33,6 +33,10 @@
 #include <qa_utils/geometry/geometry.h> // For KI_TEST::IsVecWithinTol
 #include <geometry/shape_line_chain.h>
 #include <geometry/shape_arc.h> // For SHAPE_ARC::DefaultAccuracyForPCB()
+#include <xnode.h>
+
+#include <wx/ffile.h>
+#include <wx/filename.h>
 
 
 BOOST_AUTO_TEST_SUITE( CadstartArchiveParser )
@@ -143,5 +147,61 @@ BOOST_AUTO_TEST_CASE( AppendToChain )
 
 }
 
+
+/**
+ * Check the tree read by #CADSTAR_ARCHIVE_PARSER::LoadArchiveFile(): children in file order,
+ * and the names of the children and the values of a node as "attr0", "attr1", etc.
+ */
+BOOST_AUTO_TEST_CASE( LoadArchiveFile )
+{
+    wxString fileName = wxFileName::CreateTempFileName( wxS( "cadstar" ) );
+
+    {
+        // Archives are Windows-1252 encoded: \xE9 is an e acute
+        std::string contents = "(CADSTARPCB (HDR \"Caf\xE9\" 1)\n  (A)\n  (B 2 3))\n";
+        wxFFile     file( fileName, wxS( "wb" ) );
+
+        file.Write( contents.data(), contents.size() );
+    }
+
+    std::unique_ptr<XNODE> root( CADSTAR_ARCHIVE_PARSER::LoadArchiveFile( fileName,
+                                                                          wxS( "CADSTARPCB" ) ) );
+    wxRemoveFile( fileName );
+
+    BOOST_REQUIRE( root );
+    BOOST_CHECK_EQUAL( root->GetName(), wxS( "CADSTARPCB" ) );
+    BOOST_CHECK_EQUAL( CADSTAR_ARCHIVE_PARSER::GetXmlAttributeIDString( root.get(), 0 ), "HDR" );
+    BOOST_CHECK_EQUAL( CADSTAR_ARCHIVE_PARSER::GetXmlAttributeIDString( root.get(), 2 ), "B" );
+    BOOST_CHECK_EQUAL( root->GetAttribute( wxS( "numAttributes" ) ), wxS( "2" ) );
+
+    std::vector<wxString> names;
+
+    for( XNODE* child = root->GetChildren(); child; child = child->GetNext() )
+    {
+        BOOST_CHECK( child->GetParent() == root.get() );
+        names.push_back( child->GetName() );
+    }
+
+    BOOST_REQUIRE_EQUAL( names.size(), 3 );
+    BOOST_CHECK_EQUAL( names[0], wxS( "HDR" ) );
+    BOOST_CHECK_EQUAL( names[1], wxS( "A" ) );
+    BOOST_CHECK_EQUAL( names[2], wxS( "B" ) );
+
+    XNODE* header = root->GetChildren();
+
+    BOOST_CHECK_EQUAL( CADSTAR_ARCHIVE_PARSER::GetXmlAttributeIDString( header, 0 ),
+                       wxString::FromUTF8( "Caf\xC3\xA9" ) );
+    BOOST_CHECK_EQUAL( CADSTAR_ARCHIVE_PARSER::GetXmlAttributeIDLong( header, 1 ), 1 );
+
+    XNODE* empty = header->GetNext();
+
+    BOOST_CHECK( !empty->GetAttributes() );
+
+    XNODE* last = empty->GetNext();
+
+    BOOST_CHECK_EQUAL( CADSTAR_ARCHIVE_PARSER::GetXmlAttributeIDLong( last, 1 ), 3 );
+    BOOST_CHECK_EQUAL( last->GetAttribute( wxS( "numAttributes" ) ), wxS( "1" ) );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,146 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <async_io.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( AsyncIo )
+
+
+static void sleepMs( int aMs )
+{
+    std::this_thread::sleep_for( std::chrono::milliseconds( aMs ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( AwaitReturnsResults )
+{
+    thread_pool        tp( 4 );
+    ASYNC_IO_SCHEDULER io( tp );
+    std::vector<int>   results;
+
+    for( int ii = 0; ii < 10; ++ii )
+    {
+        io.AddJob(
+                [&, ii]( ASYNC_IO_SCHEDULER& aIO )
+                {
+                    results.push_back( aIO.Await( [ii]() { return ii * 2; } ) );
+                } );
+    }
+
+    BOOST_CHECK( io.Run() );
+    BOOST_REQUIRE_EQUAL( results.size(), 10 );
+
+    int sum = 0;
+
+    for( int result : results )
+        sum += result;
+
+    BOOST_CHECK_EQUAL( sum, 90 );
+}
+
+
+BOOST_AUTO_TEST_CASE( FastReadsOvertakeSlowOnes )
+{
+    thread_pool        tp( 2 );
+    ASYNC_IO_SCHEDULER io( tp );
+    std::vector<int>   order;
+
+    // Jobs only run on this thread, so no locking is needed around order
+    io.AddJob(
+            [&]( ASYNC_IO_SCHEDULER& aIO )
+            {
+                aIO.Await( []() { sleepMs( 200 ); } );
+                order.push_back( 0 );
+            } );
+
+    io.AddJob(
+            [&]( ASYNC_IO_SCHEDULER& aIO )
+            {
+                aIO.Await( []() {} );
+                order.push_back( 1 );
+            } );
+
+    BOOST_CHECK( io.Run() );
+    BOOST_REQUIRE_EQUAL( order.size(), 2 );
+    BOOST_CHECK_EQUAL( order[0], 1 );
+    BOOST_CHECK_EQUAL( order[1], 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ExceptionsReachTheCaller )
+{
+    thread_pool        tp( 1 );
+    ASYNC_IO_SCHEDULER io( tp );
+    bool               otherJobRan = false;
+
+    io.AddJob(
+            []( ASYNC_IO_SCHEDULER& aIO )
+            {
+                aIO.Await(
+                        []()
+                        {
+                            throw std::runtime_error( "read failed" );
+                        } );
+            } );
+
+    io.AddJob( [&]( ASYNC_IO_SCHEDULER& aIO ) { otherJobRan = true; } );
+
+    BOOST_CHECK_THROW( io.Run(), std::runtime_error );
+    BOOST_CHECK( otherJobRan );
+}
+
+
+BOOST_AUTO_TEST_CASE( IdleCallbackCancels )
+{
+    thread_pool        tp( 1 );
+    ASYNC_IO_SCHEDULER io( tp );
+    int                started = 0;
+
+    io.SetMaxActiveJobs( 1 );
+
+    for( int ii = 0; ii < 5; ++ii )
+    {
+        io.AddJob(
+                [&]( ASYNC_IO_SCHEDULER& aIO )
+                {
+                    started++;
+                    aIO.Await( []() { sleepMs( 50 ); } );
+                } );
+    }
+
+    BOOST_CHECK( !io.Run( []() { return false; }, std::chrono::milliseconds( 1 ) ) );
+    BOOST_CHECK_EQUAL( started, 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( AwaitOutsideJobRunsSynchronously )
+{
+    ASYNC_IO_SCHEDULER io;
+
+    BOOST_CHECK_EQUAL( io.Await( []() { return 42; } ), 42 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,146 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <dsnlexer.h>
+
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+
+/**
+ * Exposes the protected number parsing of DSNLEXER.
+ */
+struct TEST_DSNLEXER : public DSNLEXER
+{
+    using DSNLEXER::parseScaledDecimal;
+};
+
+
+static bool parse( const char* aText, long long aScale, long long& aResult )
+{
+    return TEST_DSNLEXER::parseScaledDecimal( aText, aText + strlen( aText ), aScale, aResult );
+}
+
+
+BOOST_AUTO_TEST_SUITE( DSNLexer )
+
+
+/**
+ * Plain decimals convert exactly to scaled integers, rounding half away from zero.
+ */
+BOOST_AUTO_TEST_CASE( ScaledDecimal )
+{
+    const std::vector<std::tuple<const char*, long long, long long>> cases = {
+        { "0", 1000000, 0 },
+        { "12", 1000000, 12000000 },
+        { "1.5", 1000000, 1500000 },
+        { "-0.254", 1000000, -254000 },
+        { "+3.", 1000000, 3000000 },
+        { ".25", 10000, 2500 },
+        { "152.400001", 1000000, 152400001 },
+        { "0.0000005", 1000000, 1 },
+        { "-0.0000005", 1000000, -1 },
+        { "0.00000049", 1000000, 0 },
+        { "1.27", 25400, 32258 },
+        { "000000000000000000000001.5", 10, 15 },
+    };
+
+    for( const auto& [text, scale, expected] : cases )
+    {
+        long long result = 0;
+
+        BOOST_TEST_CONTEXT( text )
+        {
+            BOOST_CHECK( parse( text, scale, result ) );
+            BOOST_CHECK_EQUAL( result, expected );
+        }
+    }
+}
+
+
+/**
+ * Anything but a plain decimal is left to parseDouble().
+ */
+BOOST_AUTO_TEST_CASE( ScaledDecimalFallback )
+{
+    long long result = 0;
+
+    for( const char* text : { "", "-", ".", "1e3", "1.0E-2", "12mm", " 1", "0x10", "nan",
+                              "1234567890123456789", "9000000000000.5" } )
+    {
+        BOOST_TEST_CONTEXT( text )
+        {
+            BOOST_CHECK( !parse( text, 1000000, result ) );
+        }
+    }
+
+    // The rest of the text can be handed back instead, e.g. for a unit suffix
+    const char* text = "0.2mm";
+    const char* rest = nullptr;
+
+    BOOST_CHECK( TEST_DSNLEXER::parseScaledDecimal( text, text + 5, 1000000, result, &rest ) );
+    BOOST_CHECK_EQUAL( result, 200000 );
+    BOOST_CHECK_EQUAL( std::string( rest ), "mm" );
+}
+
+
+/**
+ * Lists read ahead as text end at their closing parenthesis, across lines and quoted strings,
+ * and the lexer carries on after it.
+ */
+BOOST_AUTO_TEST_CASE( ReadListText )
+{
+    DSNLEXER lexer( "(top (item \"a)\" (b\n\"c\\\"(\" (d))) e)\n(next)" );
+
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_LEFT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_SYMBOL );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_LEFT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_SYMBOL );
+    BOOST_CHECK_EQUAL( lexer.CurText(), std::string( "item" ) );
+
+    std::string text;
+    lexer.ReadListText( text );
+
+    BOOST_CHECK_EQUAL( text, std::string( " \"a)\" (b\n\"c\\\"(\" (d)))" ) );
+    BOOST_CHECK_EQUAL( lexer.CurTok(), DSN_RIGHT );
+    BOOST_CHECK_EQUAL( lexer.CurLineNumber(), 2 );
+
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_SYMBOL );
+    BOOST_CHECK_EQUAL( lexer.CurText(), std::string( "e" ) );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_RIGHT );
+    BOOST_CHECK_EQUAL( lexer.NextTok(), DSN_LEFT );
+
+    // An unterminated list is an error
+    DSNLEXER unterminated( "(top (item (b)" );
+
+    unterminated.NextTok();
+    unterminated.NextTok();
+    unterminated.NextTok();
+    unterminated.NextTok();
+
+    BOOST_CHECK_THROW( unterminated.ReadListText( text ), IO_ERROR );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <interned_string.h>
+
+#include <set>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( InternedString )
+
+
+BOOST_AUTO_TEST_CASE( EqualStringsShareStorage )
+{
+    INTERNED_STRING a( wxS( "/sheet1/VCC" ) );
+    INTERNED_STRING b( wxString( wxS( "/sheet1/" ) ) + wxS( "VCC" ) );
+    INTERNED_STRING c( wxS( "/sheet1/GND" ) );
+
+    BOOST_CHECK( a == b );
+    BOOST_CHECK( &a.Str() == &b.Str() );
+    BOOST_CHECK( a != c );
+    BOOST_CHECK_EQUAL( a.Hash(), b.Hash() );
+    BOOST_CHECK( a.Str() == wxS( "/sheet1/VCC" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( DefaultIsEmpty )
+{
+    INTERNED_STRING empty;
+
+    BOOST_CHECK( empty.IsEmpty() );
+    BOOST_CHECK( empty == INTERNED_STRING( wxEmptyString ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( LexicalOrdering )
+{
+    std::set<INTERNED_STRING> names;
+
+    names.insert( INTERNED_STRING( wxS( "c" ) ) );
+    names.insert( INTERNED_STRING( wxS( "a" ) ) );
+    names.insert( INTERNED_STRING( wxS( "b" ) ) );
+    names.insert( INTERNED_STRING( wxS( "a" ) ) );
+
+    BOOST_REQUIRE_EQUAL( names.size(), 3 );
+    BOOST_CHECK( names.begin()->Str() == wxS( "a" ) );
+    BOOST_CHECK( names.rbegin()->Str() == wxS( "c" ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( UnorderedMapKey )
+{
+    std::unordered_map<INTERNED_STRING, int> map;
+
+    map[INTERNED_STRING( wxS( "NET1" ) )] = 1;
+    map[INTERNED_STRING( wxS( "NET2" ) )] = 2;
+
+    BOOST_CHECK_EQUAL( map[INTERNED_STRING( wxS( "NET1" ) )], 1 );
+    BOOST_CHECK_EQUAL( map.size(), 2 );
+}
+
+
+BOOST_AUTO_TEST_CASE( HashOfContents )
+{
+    // The hash must not depend on where the string is stored, or the iteration order of
+    // unordered containers keyed on names would change from one run to the next
+    BOOST_CHECK_EQUAL( INTERNED_STRING( wxS( "/sheet1/VCC" ) ).Hash(),
+                       std::hash<wxString>()( wxS( "/sheet1/VCC" ) ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( ConcurrentInterning )
+{
+    const int                    threadCount = 4;
+    std::vector<const wxString*> results( threadCount );
+    std::vector<std::thread>     threads;
+
+    for( int ii = 0; ii < threadCount; ++ii )
+    {
+        threads.emplace_back(
+                [&results, ii]()
+                {
+                    for( int jj = 0; jj < 1000; ++jj )
+                        INTERNED_STRING name( wxString::Format( wxS( "concurrent-%d" ), jj ) );
+
+                    results[ii] = &INTERNED_STRING( wxS( "concurrent-500" ) ).Str();
+                } );
+    }
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( int ii = 1; ii < threadCount; ++ii )
+        BOOST_CHECK( results[ii] == results[0] );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
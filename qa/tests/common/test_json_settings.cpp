@@ -0,0 +1,107 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <settings/json_settings.h>
+#include <settings/parameters.h>
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/utils.h>
+
+
+class TEST_SETTINGS : public JSON_SETTINGS
+{
+public:
+    TEST_SETTINGS() :
+            JSON_SETTINGS( wxS( "test_settings" ), SETTINGS_LOC::NONE, 0 ),
+            m_Value( 0 )
+    {
+        m_params.emplace_back( new PARAM<int>( "value", &m_Value, 0 ) );
+    }
+
+    int m_Value;
+};
+
+
+struct JSON_SETTINGS_FIXTURE
+{
+    JSON_SETTINGS_FIXTURE()
+    {
+        m_dir = wxFileName::GetTempDir() + wxFileName::GetPathSeparator()
+                + wxString::Format( wxS( "qa_json_settings_%lu" ), wxGetProcessId() );
+
+        wxFileName::Mkdir( m_dir, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+    }
+
+    ~JSON_SETTINGS_FIXTURE()
+    {
+        wxFileName::Rmdir( m_dir, wxPATH_RMDIR_RECURSIVE );
+    }
+
+    wxString m_dir;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( JsonSettings, JSON_SETTINGS_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( UnchangedContentsAreNotRewritten )
+{
+    TEST_SETTINGS settings;
+
+    settings.m_Value = 1;
+    BOOST_CHECK( settings.SaveToFile( m_dir, true ) );
+
+    // Same contents, and the file wasn't touched since: nothing to write
+    BOOST_CHECK( !settings.SaveToFile( m_dir, true ) );
+
+    settings.m_Value = 2;
+    BOOST_CHECK( settings.SaveToFile( m_dir ) );
+
+    // The file was removed behind our back, so it has to be written again
+    wxRemoveFile( wxFileName( m_dir, wxS( "test_settings" ), wxS( "json" ) ).GetFullPath() );
+    BOOST_CHECK( settings.SaveToFile( m_dir, true ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( StaleWritesAreDropped )
+{
+    TEST_SETTINGS       settings;
+    JSON_SETTINGS_WRITE older;
+    JSON_SETTINGS_WRITE newer;
+
+    settings.m_Value = 3;
+    BOOST_REQUIRE( settings.PrepareSave( older, m_dir, true ) );
+
+    settings.m_Value = 4;
+    BOOST_REQUIRE( settings.PrepareSave( newer, m_dir, true ) );
+
+    BOOST_CHECK( settings.WriteToFile( newer ) );
+    BOOST_CHECK( !settings.WriteToFile( older ) );
+
+    TEST_SETTINGS reloaded;
+
+    BOOST_REQUIRE( reloaded.LoadFromFile( m_dir ) );
+    BOOST_CHECK_EQUAL( reloaded.m_Value, 4 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -20,6 +20,8 @@
 #include <boost/test/unit_test.hpp>
 #include <kiid.h>
 
+#include <wx/string.h>
+
 
 BOOST_AUTO_TEST_SUITE( Kiid )
 
@@ -49,6 +51,36 @@ BOOST_AUTO_TEST_CASE( Seeding )
 }
 
 
+BOOST_AUTO_TEST_CASE( ParseString )
+{
+    KIID     id;
+    wxString str = id.AsString();
+
+    BOOST_CHECK( KIID( str ) == id );
+    BOOST_CHECK( KIID( str.Upper() ) == id );
+    BOOST_CHECK( KIID( wxS( "{" ) + str + wxS( "}" ) ) == id );
+
+    KIID known( "0f4b4ff1-dd4a-4b2c-8a38-4b3b7a7b12cd" );
+    BOOST_CHECK( known.AsString() == wxS( "0f4b4ff1-dd4a-4b2c-8a38-4b3b7a7b12cd" ) );
+
+    // Legacy timestamps, short and long forms
+    KIID legacy( "5C5F0A40" );
+    KIID longLegacy( "00000000-0000-0000-0000-00005c5f0a40" );
+
+    BOOST_CHECK( legacy.IsLegacyTimestamp() );
+    BOOST_CHECK( longLegacy == legacy );
+    BOOST_CHECK_EQUAL( longLegacy.AsLegacyTimestamp(), 0x5C5F0A40 );
+
+    // Malformed strings get a new random ID
+    KIID malformed( "0f4b4ff1-dd4a-4b2c-8a38-4b3b7a7b12cg" );
+    KIID misplacedDash( "0f4b4ff1d-d4a-4b2c-8a38-4b3b7a7b12cd" );
+
+    BOOST_CHECK( malformed != niluuid );
+    BOOST_CHECK( malformed != known );
+    BOOST_CHECK( misplacedDash != known );
+}
+
+
 BOOST_AUTO_TEST_CASE( KiidPathTest )
 {
     KIID a, b, c, d;
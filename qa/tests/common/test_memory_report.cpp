@@ -0,0 +1,67 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <memory_report.h>
+
+#include <nlohmann/json.hpp>
+
+
+BOOST_AUTO_TEST_SUITE( MemoryReport )
+
+
+BOOST_AUTO_TEST_CASE( Accumulates )
+{
+    MEMORY_REPORT report;
+
+    report.Add( wxT( "Tracks" ), 10, 1000 );
+    report.Add( wxT( "Vias" ), 2, 300 );
+    report.Add( wxT( "Tracks" ), 5, 500 );
+
+    BOOST_REQUIRE_EQUAL( report.GetEntries().size(), 2 );
+    BOOST_CHECK_EQUAL( report.GetEntries()[0].m_count, 15 );
+    BOOST_CHECK_EQUAL( report.GetEntries()[0].m_bytes, 1500 );
+    BOOST_CHECK_EQUAL( report.GetTotalBytes(), 1800 );
+}
+
+
+BOOST_AUTO_TEST_CASE( Json )
+{
+    MEMORY_REPORT report;
+
+    report.Add( wxT( "Zone fills" ), 3, 4096 );
+
+    nlohmann::json json = nlohmann::json::parse( report.FormatJson().ToStdString() );
+
+    BOOST_CHECK_EQUAL( json["total_bytes"].get<size_t>(), 4096 );
+    BOOST_REQUIRE_EQUAL( json["categories"].size(), 1 );
+    BOOST_CHECK_EQUAL( json["categories"][0]["category"].get<std::string>(), "Zone fills" );
+    BOOST_CHECK_EQUAL( json["categories"][0]["count"].get<size_t>(), 3 );
+}
+
+
+BOOST_AUTO_TEST_CASE( FormatBytes )
+{
+    BOOST_CHECK_EQUAL( MEMORY_REPORT::FormatBytes( 512 ), wxT( "512 B" ) );
+    BOOST_CHECK_EQUAL( MEMORY_REPORT::FormatBytes( 2048 ), wxT( "2.0 kB" ) );
+    BOOST_CHECK_EQUAL( MEMORY_REPORT::FormatBytes( 3 * 1024 * 1024 ), wxT( "3.0 MB" ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
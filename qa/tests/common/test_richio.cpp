@@ -31,6 +31,9 @@
 // Code under test
 #include <richio.h>
 
+#include <wx/ffile.h>
+#include <wx/filename.h>
+
 /**
  * Declare the test suite
  */
@@ -74,4 +77,77 @@ BOOST_AUTO_TEST_CASE( VPrint )
     output.clear();
 }
 
+
+/**
+ * #OUTPUTFORMATTER::PrintFmt() must indent and format like #OUTPUTFORMATTER::Print().
+ */
+BOOST_AUTO_TEST_CASE( PrintFmt )
+{
+    STRING_FORMATTER printed;
+    STRING_FORMATTER formatted;
+    std::string      value( "1.25" );
+
+    printed.Print( 3, "(xy %s %s) (net %d)", value.c_str(), "-0.5", 42 );
+    formatted.PrintFmt( 3, "(xy {} {}) (net {})", value, "-0.5", 42 );
+    BOOST_CHECK_EQUAL( formatted.GetString(), printed.GetString() );
+
+    std::string longString( 500, 'A' );
+
+    printed.Print( 0, "%s\n", longString.c_str() );
+    formatted.PrintFmt( 0, "{}\n", longString );
+    BOOST_CHECK_EQUAL( formatted.GetString(), printed.GetString() );
+}
+
+
+/**
+ * A #MAPPED_FILE_LINE_READER must read the same lines as a #STRING_LINE_READER of the
+ * file contents, with or without a trailing newline.
+ */
+BOOST_AUTO_TEST_CASE( MappedFileLineReader )
+{
+    for( const std::string& contents : { std::string( "(kicad_pcb\n  (version 1)\r\n)\n" ),
+                                         std::string( "no trailing newline" ),
+                                         std::string( "\n\n" ),
+                                         std::string() } )
+    {
+        wxString fileName = wxFileName::CreateTempFileName( wxS( "richio" ) );
+
+        {
+            wxFFile file( fileName, wxS( "wb" ) );
+            file.Write( contents.data(), contents.size() );
+        }
+
+        {
+            MAPPED_FILE_LINE_READER mapped( fileName );
+            size_t                  lineCount = 0;
+
+            BOOST_CHECK_EQUAL( mapped.FileLength(), contents.size() );
+
+            for( int pass = 0; pass < 2; ++pass )
+            {
+                STRING_LINE_READER expected( contents, wxS( "test" ) );
+
+                while( expected.ReadLine() )
+                {
+                    BOOST_REQUIRE( mapped.ReadLine() );
+                    BOOST_CHECK_EQUAL( std::string( mapped.Line(), mapped.Length() ),
+                                       std::string( expected.Line(), expected.Length() ) );
+                    BOOST_CHECK_EQUAL( mapped.LineNumber(), expected.LineNumber() );
+
+                    if( pass == 0 )
+                        ++lineCount;
+                }
+
+                BOOST_CHECK( !mapped.ReadLine() );
+
+                mapped.Rewind();
+            }
+
+            BOOST_CHECK_EQUAL( mapped.LineCount(), lineCount );
+        }
+
+        wxRemoveFile( fileName );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <core/small_vector.h>
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( SmallVector )
+
+
+BOOST_AUTO_TEST_CASE( StaysInlineUpToCapacity )
+{
+    SMALL_VECTOR<int, 4> vec;
+
+    for( int ii = 0; ii < 4; ++ii )
+        vec.push_back( ii );
+
+    BOOST_CHECK( vec.IsInline() );
+    BOOST_CHECK_EQUAL( vec.capacity(), 4 );
+
+    vec.push_back( 4 );
+
+    BOOST_CHECK( !vec.IsInline() );
+    BOOST_REQUIRE_EQUAL( vec.size(), 5 );
+
+    for( int ii = 0; ii < 5; ++ii )
+        BOOST_CHECK_EQUAL( vec[ii], ii );
+
+    vec.resize( 2 );
+    vec.shrink_to_fit();
+    BOOST_CHECK( vec.IsInline() );
+    BOOST_CHECK_EQUAL( vec.back(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesStdVector )
+{
+    std::mt19937                   rng( 7 );
+    SMALL_VECTOR<std::string, 3>   vec;
+    std::vector<std::string>       ref;
+
+    for( int trial = 0; trial < 2000; ++trial )
+    {
+        std::string value = std::to_string( trial );
+        size_t      pos = ref.empty() ? 0 : rng() % ( ref.size() + 1 );
+
+        switch( rng() % 6 )
+        {
+        case 0:
+            vec.push_back( value );
+            ref.push_back( value );
+            break;
+
+        case 1:
+            vec.insert( vec.begin() + pos, value );
+            ref.insert( ref.begin() + pos, value );
+            break;
+
+        case 2:
+        {
+            std::vector<std::string> range( rng() % 5, value );
+            vec.insert( vec.begin() + pos, range.begin(), range.end() );
+            ref.insert( ref.begin() + pos, range.begin(), range.end() );
+            break;
+        }
+
+        case 3:
+            if( pos < ref.size() )
+            {
+                size_t last = std::min( ref.size(), pos + rng() % 3 );
+                vec.erase( vec.begin() + pos, vec.begin() + last );
+                ref.erase( ref.begin() + pos, ref.begin() + last );
+            }
+            break;
+
+        case 4:
+            if( !ref.empty() )
+            {
+                // Inserting one of our own elements, possibly while growing
+                vec.insert( vec.begin() + pos, vec.front() );
+                ref.insert( ref.begin() + pos, ref.front() );
+            }
+            break;
+
+        case 5:
+            if( ref.size() > 20 )
+            {
+                vec.resize( 3 );
+                ref.resize( 3 );
+            }
+            break;
+        }
+
+        BOOST_REQUIRE_EQUAL( vec.size(), ref.size() );
+        BOOST_REQUIRE( std::equal( vec.begin(), vec.end(), ref.begin() ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( CopyAndMove )
+{
+    SMALL_VECTOR<std::shared_ptr<int>, 2> inlineVec;
+    SMALL_VECTOR<std::shared_ptr<int>, 2> heapVec;
+    std::shared_ptr<int>                  value = std::make_shared<int>( 1 );
+
+    inlineVec.push_back( value );
+
+    for( int ii = 0; ii < 5; ++ii )
+        heapVec.push_back( value );
+
+    BOOST_CHECK_EQUAL( value.use_count(), 7 );
+
+    SMALL_VECTOR<std::shared_ptr<int>, 2> copy( heapVec );
+    BOOST_CHECK_EQUAL( value.use_count(), 12 );
+    BOOST_CHECK( copy == heapVec );
+
+    SMALL_VECTOR<std::shared_ptr<int>, 2> moved( std::move( inlineVec ) );
+    BOOST_CHECK( inlineVec.empty() );
+    BOOST_CHECK_EQUAL( moved.size(), 1 );
+
+    const std::shared_ptr<int>* heapData = heapVec.data();
+    moved = std::move( heapVec );
+    BOOST_CHECK( moved.data() == heapData );
+    BOOST_CHECK( heapVec.empty() && heapVec.IsInline() );
+
+    copy.swap( moved );
+    copy.clear();
+    moved.clear();
+    BOOST_CHECK_EQUAL( value.use_count(), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,121 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <core/sync_queue.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( SyncQueue )
+
+
+BOOST_AUTO_TEST_CASE( FifoOrder )
+{
+    SYNC_QUEUE<int> queue;
+    int             value = -1;
+
+    BOOST_CHECK( queue.empty() );
+    BOOST_CHECK( !queue.pop( value ) );
+    BOOST_CHECK_EQUAL( value, -1 );
+
+    for( int ii = 0; ii < 10; ++ii )
+        queue.push( ii );
+
+    BOOST_CHECK_EQUAL( queue.size(), 10 );
+
+    for( int ii = 0; ii < 10; ++ii )
+    {
+        BOOST_REQUIRE( queue.pop( value ) );
+        BOOST_CHECK_EQUAL( value, ii );
+    }
+
+    BOOST_CHECK( queue.empty() );
+    BOOST_CHECK_EQUAL( queue.size(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( MoveOnlyAndClear )
+{
+    SYNC_QUEUE<std::unique_ptr<int>> queue;
+
+    queue.move_push( std::make_unique<int>( 42 ) );
+    queue.move_push( std::make_unique<int>( 43 ) );
+
+    std::unique_ptr<int> value;
+    BOOST_REQUIRE( queue.pop( value ) );
+    BOOST_CHECK_EQUAL( *value, 42 );
+
+    queue.clear();
+    BOOST_CHECK( queue.empty() );
+}
+
+
+BOOST_AUTO_TEST_CASE( MultipleProducersAndConsumers )
+{
+    const int producers = 4;
+    const int consumers = 4;
+    const int count = 20000;
+
+    SYNC_QUEUE<std::unique_ptr<int>> queue;
+    std::atomic<int>                 popped( 0 );
+    std::atomic<long long>           sum( 0 );
+    std::vector<std::thread>         threads;
+
+    for( int ii = 0; ii < producers; ++ii )
+    {
+        threads.emplace_back(
+                [&]()
+                {
+                    for( int jj = 0; jj < count; ++jj )
+                        queue.move_push( std::make_unique<int>( jj ) );
+                } );
+    }
+
+    for( int ii = 0; ii < consumers; ++ii )
+    {
+        threads.emplace_back(
+                [&]()
+                {
+                    std::unique_ptr<int> value;
+
+                    while( popped.load() < producers * count )
+                    {
+                        if( queue.pop( value ) )
+                        {
+                            sum += *value;
+                            popped++;
+                        }
+                    }
+                } );
+    }
+
+    for( std::thread& thread : threads )
+        thread.join();
+
+    BOOST_CHECK_EQUAL( popped.load(), producers * count );
+    BOOST_CHECK_EQUAL( sum.load(), (long long) producers * count * ( count - 1 ) / 2 );
+    BOOST_CHECK( queue.empty() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,183 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <core/task_graph.h>
+
+#include <mutex>
+#include <vector>
+
+
+BOOST_AUTO_TEST_SUITE( TaskGraph )
+
+
+BOOST_AUTO_TEST_CASE( RunsAllTasks )
+{
+    thread_pool         tp( 4 );
+    TASK_GRAPH          graph;
+    std::atomic<int>    count( 0 );
+
+    for( int ii = 0; ii < 100; ++ii )
+        graph.AddTask( [&]() { count++; } );
+
+    BOOST_CHECK( graph.Run( tp ) );
+    BOOST_CHECK_EQUAL( count.load(), 100 );
+    BOOST_CHECK_EQUAL( graph.GetFinishedCount(), 100 );
+}
+
+
+BOOST_AUTO_TEST_CASE( RespectsDependencies )
+{
+    thread_pool      tp( 4 );
+    TASK_GRAPH       graph;
+    std::mutex       mutex;
+    std::vector<int> order;
+
+    auto record =
+            [&]( int aValue )
+            {
+                return [&, aValue]()
+                       {
+                           std::lock_guard<std::mutex> lock( mutex );
+                           order.push_back( aValue );
+                       };
+            };
+
+    // Diamond: 0 -> { 1, 2 } -> 3
+    TASK_GRAPH::TASK_ID a = graph.AddTask( record( 0 ) );
+    TASK_GRAPH::TASK_ID b = graph.AddTask( record( 1 ) );
+    TASK_GRAPH::TASK_ID c = graph.AddTask( record( 2 ) );
+    TASK_GRAPH::TASK_ID d = graph.AddTask( record( 3 ) );
+
+    graph.AddDependency( b, a );
+    graph.AddDependency( c, a );
+    graph.AddDependency( d, b );
+    graph.AddDependency( d, c );
+
+    BOOST_CHECK( graph.Run( tp ) );
+    BOOST_REQUIRE_EQUAL( order.size(), 4 );
+    BOOST_CHECK_EQUAL( order.front(), 0 );
+    BOOST_CHECK_EQUAL( order.back(), 3 );
+}
+
+
+BOOST_AUTO_TEST_CASE( CancellationSkipsPendingTasks )
+{
+    thread_pool       tp( 1 );
+    TASK_CANCEL_TOKEN token;
+    TASK_GRAPH        graph( TASK_PRIORITY::NORMAL, token );
+    std::atomic<int>  count( 0 );
+
+    TASK_GRAPH::TASK_ID first = graph.AddTask(
+            [&]()
+            {
+                count++;
+                token.Cancel();
+            } );
+
+    for( int ii = 0; ii < 10; ++ii )
+        graph.AddDependency( graph.AddTask( [&]() { count++; } ), first );
+
+    BOOST_CHECK( !graph.Run( tp ) );
+    BOOST_CHECK_EQUAL( count.load(), 1 );
+    BOOST_CHECK_EQUAL( graph.GetFinishedCount(), graph.GetTaskCount() );
+}
+
+
+BOOST_AUTO_TEST_CASE( WaitCallbackCancels )
+{
+    thread_pool      tp( 1 );
+    TASK_GRAPH       graph;
+    std::atomic<int> count( 0 );
+
+    TASK_GRAPH::TASK_ID first = graph.AddTask(
+            [&]()
+            {
+                std::this_thread::sleep_for( std::chrono::milliseconds( 50 ) );
+                count++;
+            } );
+
+    graph.AddDependency( graph.AddTask( [&]() { count++; } ), first );
+
+    BOOST_CHECK( !graph.Run( tp, []() { return false; }, std::chrono::milliseconds( 1 ) ) );
+    BOOST_CHECK_EQUAL( count.load(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( StartReturnsBeforeCompletion )
+{
+    thread_pool       tp( 2 );
+    TASK_GRAPH        graph;
+    std::atomic<bool> release( false );
+    std::atomic<int>  count( 0 );
+
+    TASK_GRAPH::TASK_ID first = graph.AddTask(
+            [&]()
+            {
+                while( !release.load() )
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+
+                count++;
+            } );
+
+    graph.AddDependency( graph.AddTask( [&]() { count++; } ), first );
+
+    graph.Start( tp );
+
+    // The caller is free to do its own work while the graph runs
+    BOOST_CHECK_EQUAL( count.load(), 0 );
+    release.store( true );
+
+    BOOST_CHECK( graph.Wait() );
+    BOOST_CHECK_EQUAL( count.load(), 2 );
+}
+
+
+BOOST_AUTO_TEST_CASE( MaxConcurrency )
+{
+    thread_pool      tp( 4 );
+    TASK_GRAPH       graph;
+    std::atomic<int> running( 0 );
+    std::atomic<int> peak( 0 );
+
+    graph.SetMaxConcurrency( 2 );
+
+    for( int ii = 0; ii < 20; ++ii )
+    {
+        graph.AddTask(
+                [&]()
+                {
+                    int now = ++running;
+                    int prev = peak.load();
+
+                    while( now > prev && !peak.compare_exchange_weak( prev, now ) )
+                        ;
+
+                    std::this_thread::sleep_for( std::chrono::milliseconds( 2 ) );
+                    running--;
+                } );
+    }
+
+    BOOST_CHECK( graph.Run( tp ) );
+    BOOST_CHECK_LE( peak.load(), 2 );
+    BOOST_CHECK_EQUAL( graph.GetFinishedCount(), 20 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
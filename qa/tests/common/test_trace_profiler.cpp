@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <boost/test/unit_test.hpp>
+#include <core/trace_profiler.h>
+
+#include <sstream>
+#include <thread>
+
+
+static size_t countOccurrences( const std::string& aHaystack, const std::string& aNeedle )
+{
+    size_t count = 0;
+
+    for( size_t pos = aHaystack.find( aNeedle ); pos != std::string::npos;
+         pos = aHaystack.find( aNeedle, pos + 1 ) )
+    {
+        count++;
+    }
+
+    return count;
+}
+
+
+BOOST_AUTO_TEST_SUITE( TraceProfiler )
+
+
+BOOST_AUTO_TEST_CASE( DisabledRecordsNothing )
+{
+    TRACE_PROFILER& profiler = TRACE_PROFILER::Instance();
+
+    profiler.Disable();
+    profiler.Clear();
+
+    {
+        TRACE_SCOPE( "ignored" );
+        TRACE_COUNTER( "ignored counter", 3 );
+    }
+
+    std::stringstream ss;
+    profiler.WriteChromeTrace( ss );
+
+    BOOST_CHECK_EQUAL( countOccurrences( ss.str(), "ignored" ), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ZonesAndCounters )
+{
+    TRACE_PROFILER& profiler = TRACE_PROFILER::Instance();
+
+    profiler.Clear();
+    profiler.Enable();
+
+    {
+        TRACE_SCOPE( "outer" );
+
+        {
+            TRACE_SCOPE( "inner" );
+            TRACE_COUNTER( "depth", 42 );
+        }
+
+        std::thread t( []()
+                       {
+                           TRACE_SCOPE( "worker" );
+                       } );
+        t.join();
+    }
+
+    profiler.Disable();
+
+    std::stringstream ss;
+    profiler.WriteChromeTrace( ss );
+    std::string json = ss.str();
+
+    BOOST_CHECK_EQUAL( countOccurrences( json, "\"name\":\"outer\"" ), 2 );
+    BOOST_CHECK_EQUAL( countOccurrences( json, "\"name\":\"inner\"" ), 2 );
+    BOOST_CHECK_EQUAL( countOccurrences( json, "\"name\":\"worker\"" ), 2 );
+    BOOST_CHECK_EQUAL( countOccurrences( json, "\"args\":{\"value\":42}" ), 1 );
+    BOOST_CHECK_EQUAL( countOccurrences( json, "\"ph\":\"B\"" ), 3 );
+    BOOST_CHECK_EQUAL( countOccurrences( json, "\"ph\":\"E\"" ), 3 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
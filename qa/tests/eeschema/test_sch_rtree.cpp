@@ -293,4 +293,70 @@ BOOST_AUTO_TEST_CASE( SingleElementTree )
         delete item;
 }
 
+/**
+ * A bulk loaded tree must give the same results as one built by insertion, and multi-type
+ * queries the union of the single type ones.
+ */
+BOOST_AUTO_TEST_CASE( BulkLoad )
+{
+    EE_RTREE               inserted;
+    std::vector<SCH_ITEM*> items;
+
+    for( int i = 0; i < 1000; i++ )
+    {
+        VECTOR2I pos( schIUScale.MilsToIU( 50 ) * ( i % 37 ),
+                      schIUScale.MilsToIU( 50 ) * ( i / 37 ) );
+
+        if( i % 3 == 0 )
+            items.push_back( new SCH_NO_CONNECT( pos ) );
+        else
+            items.push_back( new SCH_JUNCTION( pos ) );
+
+        inserted.insert( items.back() );
+    }
+
+    m_tree.assign( items );
+
+    BOOST_CHECK_EQUAL( m_tree.size(), items.size() );
+
+    auto collect =
+            []( auto aRange )
+            {
+                std::set<SCH_ITEM*> result;
+
+                for( SCH_ITEM* item : aRange )
+                    result.insert( item );
+
+                return result;
+            };
+
+    BOX2I bbox( VECTOR2I( schIUScale.MilsToIU( 200 ), schIUScale.MilsToIU( 300 ) ),
+                VECTOR2I( schIUScale.MilsToIU( 400 ), schIUScale.MilsToIU( 250 ) ) );
+
+    for( KICAD_T type : { SCH_JUNCTION_T, SCH_NO_CONNECT_T, SCH_LOCATE_ANY_T } )
+    {
+        BOOST_CHECK( collect( m_tree.OfType( type ) ) == collect( inserted.OfType( type ) ) );
+        BOOST_CHECK( collect( m_tree.Overlapping( type, bbox ) )
+                     == collect( inserted.Overlapping( type, bbox ) ) );
+    }
+
+    BOOST_CHECK( collect( m_tree.OfType( { SCH_JUNCTION_T, SCH_NO_CONNECT_T } ) )
+                 == collect( m_tree ) );
+    BOOST_CHECK( collect( m_tree.Overlapping( { SCH_NO_CONNECT_T, SCH_JUNCTION_T }, bbox ) )
+                 == collect( m_tree.Overlapping( bbox ) ) );
+    BOOST_CHECK( m_tree.OfType( { SCH_SYMBOL_T, SCH_SHEET_T } ).empty() );
+
+    m_tree.rebuild();
+
+    BOOST_CHECK_EQUAL( m_tree.size(), items.size() );
+
+    for( SCH_ITEM* item : items )
+        BOOST_CHECK( m_tree.remove( item ) );
+
+    BOOST_CHECK( m_tree.empty() );
+
+    for( SCH_ITEM* item : items )
+        delete item;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,99 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+// Code under test
+#include <symbol_lib_index.h>
+
+#include <lib_symbol.h>
+#include <symbol_lib_table.h>
+
+#include <wx/ffile.h>
+
+
+BOOST_AUTO_TEST_SUITE( SymbolLibIndex )
+
+
+/**
+ * An index saved and loaded again must list the symbols as they were indexed, and forget a
+ * library once its file changes.
+ */
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    wxString   libFile = wxFileName::CreateTempFileName( wxS( "symbol_lib_index" ) );
+    wxFileName indexFile( wxFileName::CreateTempFileName( wxS( "symbol_lib_index" ) ) );
+
+    {
+        wxFFile file( libFile, wxS( "w" ) );
+        file.Write( wxS( "(kicad_symbol_lib)\n" ) );
+    }
+
+    SYMBOL_LIB_TABLE_ROW row( wxS( "lib" ), libFile, wxS( "KiCad" ) );
+    LIB_SYMBOL           symbol( wxS( "opamp" ), nullptr );
+
+    symbol.SetLibId( LIB_ID( wxS( "lib" ), wxS( "opamp" ) ) );
+    symbol.SetDescription( wxS( "Dual op amp" ) );
+    symbol.SetKeyWords( wxS( "amplifier" ) );
+    symbol.SetUnitCount( 2 );
+    symbol.SetUnitDisplayName( 2, wxS( "second" ) );
+
+    BOOST_REQUIRE( SYMBOL_LIB_INDEX::CanIndex( &row ) );
+
+    {
+        SYMBOL_LIB_INDEX index;
+
+        index.Update( &row, { &symbol }, { wxS( "Manufacturer" ) } );
+        BOOST_REQUIRE( index.Save( indexFile ) );
+    }
+
+    SYMBOL_LIB_INDEX         index;
+    std::vector<SYMBOL_INFO> symbols;
+    std::vector<wxString>    fields;
+
+    BOOST_REQUIRE( index.Load( indexFile ) );
+    BOOST_REQUIRE( index.Find( &row, symbols, fields ) );
+
+    BOOST_REQUIRE_EQUAL( symbols.size(), 1 );
+    BOOST_CHECK( fields == std::vector<wxString>{ wxS( "Manufacturer" ) } );
+
+    SYMBOL_INFO& info = symbols[0];
+
+    BOOST_CHECK( info.GetLibId() == symbol.GetLibId() );
+    BOOST_CHECK_EQUAL( info.GetDescription(), symbol.GetDescription() );
+    BOOST_CHECK_EQUAL( info.GetUnitCount(), 2 );
+    BOOST_CHECK( !info.HasUnitDisplayName( 1 ) );
+    BOOST_CHECK_EQUAL( info.GetUnitDisplayName( 2 ), wxS( "second" ) );
+    BOOST_CHECK_EQUAL( info.GetUnitReference( 2 ), symbol.GetUnitReference( 2 ) );
+    BOOST_CHECK_EQUAL( info.GetSearchTerms().size(), symbol.GetSearchTerms().size() );
+
+    {
+        wxFFile file( libFile, wxS( "a" ) );
+        file.Write( wxS( "\n" ) );
+    }
+
+    BOOST_CHECK( !index.Find( &row, symbols, fields ) );
+
+    wxRemoveFile( libFile );
+    wxRemoveFile( indexFile.GetFullPath() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
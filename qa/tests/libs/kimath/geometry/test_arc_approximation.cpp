@@ -0,0 +1,129 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/geometry_utils.h>
+#include <geometry/shape_arc.h>
+#include <geometry/shape_poly_set.h>
+#include <trigo.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+
+BOOST_AUTO_TEST_SUITE( ArcApproximation )
+
+
+/**
+ * The cached unit circle must give the very corners rotating a point used to give.
+ */
+BOOST_AUTO_TEST_CASE( UnitCircleMatchesRotatePoint )
+{
+    for( int segs = 3; segs < 300; ++segs )
+    {
+        for( bool halfStep : { false, true } )
+        {
+            const std::vector<VECTOR2D>& corners = GetUnitCirclePolygon( segs, halfStep );
+            EDA_ANGLE                    delta = ANGLE_360 / segs;
+            size_t                       ii = 0;
+
+            for( EDA_ANGLE angle = halfStep ? delta / 2 : ANGLE_0; angle < ANGLE_360;
+                 angle += delta, ++ii )
+            {
+                BOOST_REQUIRE( ii < corners.size() );
+
+                for( int radius : { 1, 127, 150000, 12345678 } )
+                {
+                    VECTOR2I expected( radius, 0 );
+                    RotatePoint( expected, angle );
+
+                    BOOST_CHECK_EQUAL( KiROUND( radius * corners[ii].x ), expected.x );
+                    BOOST_CHECK_EQUAL( KiROUND( radius * corners[ii].y ), expected.y );
+                }
+            }
+
+            BOOST_CHECK_EQUAL( ii, corners.size() );
+        }
+    }
+
+    // Same table every time
+    BOOST_CHECK( &GetUnitCirclePolygon( 32 ) == &GetUnitCirclePolygon( 32 ) );
+    BOOST_CHECK( &GetUnitCirclePolygon( 5000 ) == &GetUnitCirclePolygon( 5000 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( StepperMatchesTrig )
+{
+    EDA_ANGLE   start( 17.3, DEGREES_T );
+    EDA_ANGLE   step( -2.9, DEGREES_T );
+    ARC_STEPPER stepper( start, step );
+
+    for( int ii = 0; ii < 1000; ++ii, stepper.Next() )
+    {
+        EDA_ANGLE angle = start + step * ii;
+
+        BOOST_CHECK_SMALL( stepper.Cos() - angle.Cos(), 1e-12 );
+        BOOST_CHECK_SMALL( stepper.Sin() - angle.Sin(), 1e-12 );
+    }
+}
+
+
+/**
+ * Circles and arcs must stay within the requested error of the true curve, on the right side.
+ */
+BOOST_AUTO_TEST_CASE( ErrorBounds )
+{
+    const VECTOR2I center( 123456, -654321 );
+
+    for( int radius : { 10000, 250000, 5000000 } )
+    {
+        for( int error : { 100, 1000, 5000 } )
+        {
+            SHAPE_LINE_CHAIN inside;
+            SHAPE_LINE_CHAIN outside;
+
+            TransformCircleToPolygon( inside, center, radius, error, ERROR_INSIDE );
+            TransformCircleToPolygon( outside, center, radius, error, ERROR_OUTSIDE );
+
+            for( const VECTOR2I& pt : inside.CPoints() )
+                BOOST_CHECK_SMALL( ( pt - center ).EuclideanNorm() - radius, 1 );
+
+            // The segment count is rounded to the nearest integer, so the error can slightly
+            // exceed the requested one
+            for( int ii = 0; ii < outside.SegmentCount(); ++ii )
+            {
+                SEG seg = outside.CSegment( ii );
+
+                BOOST_CHECK_GE( seg.LineDistance( center ), radius - 2 );
+                BOOST_CHECK_LE( ( seg.A - center ).EuclideanNorm(), radius + error * 1.05 + 1 );
+            }
+
+            SHAPE_ARC        arc( center, center + VECTOR2I( radius, 0 ),
+                                  EDA_ANGLE( 137.0, DEGREES_T ) );
+            SHAPE_LINE_CHAIN arcChain = arc.ConvertToPolyline( error );
+
+            BOOST_CHECK_EQUAL( arcChain.CPoint( 0 ), arc.GetP0() );
+            BOOST_CHECK_EQUAL( arcChain.CLastPoint(), arc.GetP1() );
+
+            for( const VECTOR2I& pt : arcChain.CPoints() )
+                BOOST_CHECK_LE( std::abs( ( pt - center ).EuclideanNorm() - radius ),
+                                error * 1.05 + 1 );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,90 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <geometry/geometry_arena.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+
+static SHAPE_POLY_SET makeSquare( int aX, int aY, int aSize )
+{
+    SHAPE_POLY_SET poly;
+
+    poly.NewOutline();
+    poly.Append( aX, aY );
+    poly.Append( aX + aSize, aY );
+    poly.Append( aX + aSize, aY + aSize );
+    poly.Append( aX, aY + aSize );
+
+    return poly;
+}
+
+
+BOOST_AUTO_TEST_SUITE( GeometryArena )
+
+
+BOOST_AUTO_TEST_CASE( NestedLeases )
+{
+    BOOST_CHECK( !GEOMETRY_ARENA::IsActive() );
+
+    {
+        GEOMETRY_ARENA arena;
+        BOOST_CHECK( GEOMETRY_ARENA::IsActive() );
+
+        GEOMETRY_SCRATCH* outerPtr = nullptr;
+
+        {
+            GEOMETRY_ARENA::LEASE outer;
+            outer->m_zValues.resize( 100 );
+            outerPtr = &*outer;
+
+            GEOMETRY_ARENA::LEASE inner;
+            BOOST_CHECK( &*inner != outerPtr );
+            BOOST_CHECK( inner->m_zValues.empty() );
+        }
+
+        // A released set is handed out again, cleared but with its capacity kept
+        GEOMETRY_ARENA::LEASE again;
+        BOOST_CHECK_EQUAL( &*again, outerPtr );
+        BOOST_CHECK( again->m_zValues.empty() );
+        BOOST_CHECK_GE( again->m_zValues.capacity(), 100 );
+    }
+
+    BOOST_CHECK( !GEOMETRY_ARENA::IsActive() );
+}
+
+
+BOOST_AUTO_TEST_CASE( BooleanOpsMatch )
+{
+    SHAPE_POLY_SET withoutArena = makeSquare( 0, 0, 1000 );
+    withoutArena.BooleanSubtract( makeSquare( 250, 250, 500 ), SHAPE_POLY_SET::PM_FAST );
+    withoutArena.BooleanAdd( makeSquare( 900, 900, 500 ), SHAPE_POLY_SET::PM_FAST );
+
+    GEOMETRY_ARENA arena;
+
+    SHAPE_POLY_SET withArena = makeSquare( 0, 0, 1000 );
+    withArena.BooleanSubtract( makeSquare( 250, 250, 500 ), SHAPE_POLY_SET::PM_FAST );
+    withArena.BooleanAdd( makeSquare( 900, 900, 500 ), SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( withArena.OutlineCount(), withoutArena.OutlineCount() );
+    BOOST_CHECK_EQUAL( withArena.HoleCount( 0 ), withoutArena.HoleCount( 0 ) );
+    BOOST_CHECK_EQUAL( withArena.Area(), withoutArena.Area() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
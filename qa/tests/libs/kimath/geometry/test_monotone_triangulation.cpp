@@ -0,0 +1,263 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <geometry/monotone_triangulation.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <random>
+
+
+/**
+ * Twice the total area of a triangulation, exact.
+ */
+static int64_t triangulatedArea( const SHAPE_POLY_SET::TRIANGULATED_POLYGON& aTri )
+{
+    int64_t area = 0;
+
+    for( size_t ii = 0; ii < aTri.GetTriangleCount(); ++ii )
+    {
+        VECTOR2I a, b, c;
+        aTri.GetTriangle( ii, a, b, c );
+
+        int64_t cross = (int64_t) ( b.x - a.x ) * ( c.y - a.y )
+                        - (int64_t) ( b.y - a.y ) * ( c.x - a.x );
+
+        // All triangles come out counterclockwise
+        BOOST_CHECK_GT( cross, 0 );
+        area += cross;
+    }
+
+    return area;
+}
+
+
+static SHAPE_LINE_CHAIN makeRegular( const VECTOR2I& aCenter, int aRadius, int aCount,
+                                     double aPhase )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aCount; ++ii )
+    {
+        double a = aPhase + 2 * M_PI * ii / aCount;
+        chain.Append( aCenter.x + KiROUND( aRadius * std::cos( a ) ),
+                      aCenter.y + KiROUND( aRadius * std::sin( a ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+BOOST_AUTO_TEST_SUITE( MonotoneTriangulation )
+
+
+BOOST_AUTO_TEST_CASE( GridOfHoles )
+{
+    std::mt19937 rng( 42 );
+
+    for( int size : { 1, 2, 7, 20 } )
+    {
+        SHAPE_POLY_SET::POLYGON poly;
+        SHAPE_LINE_CHAIN        outline;
+
+        outline.Append( 0, 0 );
+        outline.Append( size * 1000, 0 );
+        outline.Append( size * 1000, size * 1000 );
+        outline.Append( 0, size * 1000 );
+        outline.SetClosed( true );
+        poly.push_back( outline );
+
+        for( int ii = 0; ii < size; ++ii )
+        {
+            for( int jj = 0; jj < size; ++jj )
+            {
+                poly.push_back( makeRegular( { ii * 1000 + 500, jj * 1000 + 500 }, 300,
+                                             3 + rng() % 10, ( rng() % 100 ) / 100.0 ) );
+            }
+        }
+
+        SHAPE_POLY_SET ref;
+        ref.AddPolygon( poly );
+
+        SHAPE_POLY_SET::TRIANGULATED_POLYGON tri( 0 );
+        MONOTONE_TRIANGULATION               tess( tri );
+
+        BOOST_TEST_CONTEXT( size << "x" << size << " holes" )
+        {
+            BOOST_REQUIRE( tess.TesselatePolygon( poly ) );
+            BOOST_CHECK_EQUAL( triangulatedArea( tri ), KiROUND( 2 * ref.Area() ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( RandomStars )
+{
+    std::mt19937 rng( 7 );
+
+    for( int trial = 0; trial < 500; ++trial )
+    {
+        SHAPE_LINE_CHAIN star;
+        int              count = 3 + rng() % 60;
+
+        for( int ii = 0; ii < count; ++ii )
+        {
+            double a = 2 * M_PI * ii / count;
+            double r = 100 + rng() % 1000;
+            star.Append( KiROUND( r * std::cos( a ) ), KiROUND( r * std::sin( a ) ) );
+        }
+
+        star.SetClosed( true );
+
+        // Either orientation is accepted
+        if( trial % 2 )
+            star = star.Reverse();
+
+        SHAPE_POLY_SET::TRIANGULATED_POLYGON tri( 0 );
+        MONOTONE_TRIANGULATION               tess( tri );
+
+        BOOST_TEST_CONTEXT( "Trial " << trial )
+        {
+            BOOST_REQUIRE( tess.TesselatePolygon( { star } ) );
+            BOOST_CHECK_EQUAL( triangulatedArea( tri ), KiROUND( 2 * std::abs( star.Area() ) ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( HorizontalAndCollinearEdges )
+{
+    // A comb with axis aligned teeth, both ways round
+    SHAPE_LINE_CHAIN comb;
+
+    comb.Append( 0, 0 );
+
+    for( int ii = 0; ii < 20; ++ii )
+    {
+        comb.Append( ii * 10, 100 );
+        comb.Append( ii * 10 + 5, 100 );
+        comb.Append( ii * 10 + 5, 10 );
+        comb.Append( ii * 10 + 10, 10 );
+    }
+
+    comb.Append( 200, 0 );
+    comb.SetClosed( true );
+
+    SHAPE_LINE_CHAIN rotated;
+
+    for( const VECTOR2I& pt : comb.CPoints() )
+        rotated.Append( pt.y, pt.x );
+
+    rotated.SetClosed( true );
+
+    // A square with many collinear points on each side
+    SHAPE_LINE_CHAIN square;
+
+    for( int ii = 0; ii < 10; ++ii )
+        square.Append( ii * 10, 0 );
+
+    for( int ii = 0; ii < 10; ++ii )
+        square.Append( 100, ii * 10 );
+
+    for( int ii = 10; ii > 0; --ii )
+        square.Append( ii * 10, 100 );
+
+    for( int ii = 10; ii > 0; --ii )
+        square.Append( 0, ii * 10 );
+
+    square.SetClosed( true );
+
+    for( const SHAPE_LINE_CHAIN& chain : { comb, rotated, square } )
+    {
+        SHAPE_POLY_SET::TRIANGULATED_POLYGON tri( 0 );
+        MONOTONE_TRIANGULATION               tess( tri );
+
+        BOOST_REQUIRE( tess.TesselatePolygon( { chain } ) );
+        BOOST_CHECK_EQUAL( triangulatedArea( tri ), KiROUND( 2 * std::abs( chain.Area() ) ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( RejectsTouchingContours )
+{
+    SHAPE_LINE_CHAIN outline( { { 0, 0 }, { 100, 0 }, { 100, 100 }, { 0, 100 } }, true );
+    SHAPE_LINE_CHAIN hole( { { 0, 0 }, { 50, 50 }, { 50, 20 } }, true );
+
+    SHAPE_POLY_SET::TRIANGULATED_POLYGON tri( 0 );
+    MONOTONE_TRIANGULATION               tess( tri );
+
+    BOOST_CHECK( !tess.TesselatePolygon( { outline, hole } ) );
+    BOOST_CHECK_EQUAL( tri.GetTriangleCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( CacheTriangulationBackends )
+{
+    std::mt19937   rng( 3 );
+    SHAPE_POLY_SET board;
+    SHAPE_POLY_SET holes;
+    const int      size = 100000000;
+
+    board.NewOutline();
+    board.Append( 0, 0 );
+    board.Append( size, 0 );
+    board.Append( size, size );
+    board.Append( 0, size );
+
+    for( int ii = 0; ii < 500; ++ii )
+    {
+        holes.AddOutline( makeRegular( { (int) ( rng() % size ), (int) ( rng() % size ) },
+                                       200000 + rng() % 800000, 16, 0.0 ) );
+    }
+
+    holes.Simplify( SHAPE_POLY_SET::PM_FAST );
+    board.BooleanSubtract( holes, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+
+    for( SHAPE_POLY_SET::TRIANGULATOR triangulator : { SHAPE_POLY_SET::TRIANGULATOR::EAR_CLIPPING,
+                                                       SHAPE_POLY_SET::TRIANGULATOR::SWEEP_LINE } )
+    {
+        for( bool partition : { true, false } )
+        {
+            SHAPE_POLY_SET poly( board );
+            poly.CacheTriangulation( partition, false, triangulator );
+
+            BOOST_REQUIRE( poly.IsTriangulationUpToDate() );
+
+            double area = 0;
+
+            for( unsigned ii = 0; ii < poly.TriangulatedPolyCount(); ++ii )
+            {
+                const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = poly.TriangulatedPolygon( ii );
+
+                for( size_t jj = 0; jj < tri->GetTriangleCount(); ++jj )
+                {
+                    VECTOR2I a, b, c;
+                    tri->GetTriangle( jj, a, b, c );
+                    area += std::abs( VECTOR2D( b - a ).Cross( VECTOR2D( c - a ) ) ) / 2;
+                }
+            }
+
+            BOOST_CHECK_CLOSE( area, board.Area(), 1e-6 );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,203 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <geometry/packed_rtree.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <random>
+#include <set>
+
+
+static std::vector<BOX2I> randomBoxes( std::mt19937& aRng, int aCount )
+{
+    std::uniform_int_distribution<int> coord( -1000000, 1000000 );
+    std::uniform_int_distribution<int> size( 0, 20000 );
+    std::vector<BOX2I>                 boxes;
+
+    for( int ii = 0; ii < aCount; ++ii )
+        boxes.emplace_back( VECTOR2I( coord( aRng ), coord( aRng ) ),
+                            VECTOR2I( size( aRng ), size( aRng ) ) );
+
+    return boxes;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PackedRTree )
+
+
+BOOST_AUTO_TEST_CASE( Empty )
+{
+    PACKED_RTREE<int> tree;
+
+    BOOST_CHECK( tree.empty() );
+    BOOST_CHECK_EQUAL( tree.Search( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ),
+                                    []( int ) { return true; } ),
+                       0 );
+
+    tree.Insert( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ), 1 );
+
+    // Not visible before the tree is built
+    BOOST_CHECK( tree.NeedsBuild() );
+    BOOST_CHECK( tree.empty() );
+}
+
+
+/**
+ * Search() must return exactly the items a linear scan finds, for all tree sizes around node
+ * and level boundaries and after items were added to a built tree.
+ */
+BOOST_AUTO_TEST_CASE( MatchesLinearScan )
+{
+    std::mt19937 rng( 5 );
+
+    for( int count : { 1, 15, 16, 17, 255, 256, 257, 5000 } )
+    {
+        std::vector<BOX2I> boxes = randomBoxes( rng, count );
+        PACKED_RTREE<int>  tree;
+
+        for( int ii = 0; ii < count / 2; ++ii )
+            tree.Insert( boxes[ii], ii );
+
+        tree.Build();
+
+        for( int ii = count / 2; ii < count; ++ii )
+            tree.Insert( boxes[ii], ii );
+
+        tree.Build();
+        BOOST_REQUIRE_EQUAL( tree.size(), count );
+        BOOST_CHECK_EQUAL( std::set<int>( tree.begin(), tree.end() ).size(), count );
+
+        for( const BOX2I& query : randomBoxes( rng, 200 ) )
+        {
+            BOX2I         big = query;
+            std::set<int> expected;
+            std::set<int> found;
+
+            big.Inflate( 50000 );
+
+            for( int ii = 0; ii < count; ++ii )
+            {
+                if( boxes[ii].Intersects( big ) )
+                    expected.insert( ii );
+            }
+
+            tree.Search( big,
+                         [&]( int aItem )
+                         {
+                             BOOST_CHECK( found.insert( aItem ).second );
+                             return true;
+                         } );
+
+            BOOST_CHECK( found == expected );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( VisitorStops )
+{
+    PACKED_RTREE<int> tree;
+
+    for( int ii = 0; ii < 100; ++ii )
+        tree.Insert( BOX2I( VECTOR2I( ii, 0 ), VECTOR2I( 0, 0 ) ), ii );
+
+    tree.Build();
+
+    int visited = 0;
+    int found = tree.Search( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 100, 0 ) ),
+                             [&]( int )
+                             {
+                                 return ++visited < 3;
+                             } );
+
+    BOOST_CHECK_EQUAL( visited, 3 );
+    BOOST_CHECK_EQUAL( found, 3 );
+
+    // Touching edges count as overlapping
+    BOOST_CHECK_EQUAL( tree.Search( BOX2I( VECTOR2I( 99, 0 ), VECTOR2I( 5, 5 ) ),
+                                    []( int ) { return true; } ),
+                       1 );
+}
+
+
+/**
+ * SearchPairs() must find exactly the pairs a brute force comparison finds, inflation included,
+ * whichever of the two trees is the deeper one.
+ */
+BOOST_AUTO_TEST_CASE( PairsMatchBruteForce )
+{
+    std::mt19937 rng( 11 );
+
+    for( auto [countA, countB] : { std::pair( 1, 1 ), std::pair( 17, 3000 ),
+                                   std::pair( 3000, 17 ), std::pair( 2000, 2500 ) } )
+    {
+        std::vector<BOX2I> boxesA = randomBoxes( rng, countA );
+        std::vector<BOX2I> boxesB = randomBoxes( rng, countB );
+        PACKED_RTREE<int>  treeA;
+        PACKED_RTREE<int>  treeB;
+
+        for( int ii = 0; ii < countA; ++ii )
+            treeA.Insert( boxesA[ii], ii );
+
+        for( int ii = 0; ii < countB; ++ii )
+            treeB.Insert( boxesB[ii], ii );
+
+        treeA.Build();
+        treeB.Build();
+
+        for( int inflate : { 0, 30000 } )
+        {
+            std::set<std::pair<int, int>> expected;
+            std::set<std::pair<int, int>> found;
+
+            for( int ii = 0; ii < countA; ++ii )
+            {
+                BOX2I box = boxesA[ii];
+                box.Inflate( inflate );
+
+                for( int jj = 0; jj < countB; ++jj )
+                {
+                    if( box.Intersects( boxesB[jj] ) )
+                        expected.emplace( ii, jj );
+                }
+            }
+
+            int visited = treeA.SearchPairs( treeB, inflate,
+                                             [&]( int aA, int aB )
+                                             {
+                                                 BOOST_CHECK( found.emplace( aA, aB ).second );
+                                                 return true;
+                                             } );
+
+            BOOST_CHECK_EQUAL( visited, expected.size() );
+            BOOST_CHECK( found == expected );
+        }
+    }
+
+    PACKED_RTREE<int> empty;
+    PACKED_RTREE<int> tree;
+
+    tree.Insert( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ), 1 );
+    tree.Build();
+
+    BOOST_CHECK_EQUAL( tree.SearchPairs( empty, 0, []( int, int ) { return true; } ), 0 );
+    BOOST_CHECK_EQUAL( empty.SearchPairs( tree, 0, []( int, int ) { return true; } ), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,149 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <geometry/polygon_segment_index.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <random>
+
+
+/**
+ * A wobbly ring with @a aPoints vertices, optionally with a wobbly hole.  Big enough to get
+ * an edge index.
+ */
+static SHAPE_POLY_SET makeWobblyRing( int aPoints, bool aWithHole )
+{
+    SHAPE_POLY_SET poly;
+
+    auto ring =
+            [&]( int aRadius, int aAmplitude )
+            {
+                SHAPE_LINE_CHAIN chain;
+
+                for( int ii = 0; ii < aPoints; ++ii )
+                {
+                    double a = 2 * M_PI * ii / aPoints;
+                    double r = aRadius + aAmplitude * std::sin( 7 * a );
+
+                    chain.Append( KiROUND( r * std::cos( a ) ), KiROUND( r * std::sin( a ) ) );
+                }
+
+                chain.SetClosed( true );
+                return chain;
+            };
+
+    poly.AddOutline( ring( 1000000, 100000 ) );
+
+    if( aWithHole )
+        poly.AddHole( ring( 400000, 50000 ) );
+
+    return poly;
+}
+
+
+BOOST_AUTO_TEST_SUITE( PolygonSegmentIndex )
+
+
+/**
+ * A triangulated set uses the index; its answers must match the plain scans of an untouched
+ * copy.
+ */
+BOOST_AUTO_TEST_CASE( MatchesLinearScan )
+{
+    std::mt19937                       rng( 3 );
+    std::uniform_int_distribution<int> coord( -1300000, 1300000 );
+    std::uniform_int_distribution<int> accuracy( 0, 30000 );
+
+    for( bool withHole : { false, true } )
+    {
+        SHAPE_POLY_SET reference = makeWobblyRing( 1000, withHole );
+        SHAPE_POLY_SET indexed = reference;
+
+        indexed.CacheTriangulation( false );
+        BOOST_REQUIRE( indexed.IsTriangulationUpToDate() );
+
+        for( int trial = 0; trial < 2000; ++trial )
+        {
+            VECTOR2I p( coord( rng ), coord( rng ) );
+            VECTOR2I q( coord( rng ), coord( rng ) );
+            int      acc = accuracy( rng );
+
+            BOOST_CHECK_EQUAL( indexed.Contains( p, -1, acc ), reference.Contains( p, -1, acc ) );
+            BOOST_CHECK_EQUAL( indexed.PointInside( p, acc ), reference.PointInside( p, acc ) );
+            BOOST_CHECK_EQUAL( indexed.SquaredDistance( p ), reference.SquaredDistance( p ) );
+            BOOST_CHECK_EQUAL( indexed.SquaredDistanceToSeg( SEG( p, q ) ),
+                               reference.SquaredDistanceToSeg( SEG( p, q ) ) );
+
+            int actualIndexed = -1;
+            int actualReference = -1;
+
+            BOOST_CHECK_EQUAL( indexed.Collide( SEG( p, q ), acc, &actualIndexed ),
+                               reference.Collide( SEG( p, q ), acc, &actualReference ) );
+            BOOST_CHECK_EQUAL( actualIndexed, actualReference );
+        }
+    }
+}
+
+
+/**
+ * Editing through a non-const accessor must drop the index rather than leave it stale.
+ */
+BOOST_AUTO_TEST_CASE( EditInvalidates )
+{
+    SHAPE_POLY_SET poly = makeWobblyRing( 1000, false );
+    VECTOR2I       probe( 3000000, 0 );
+
+    poly.CacheTriangulation( false );
+    BOOST_CHECK( !poly.Contains( probe ) );
+
+    // Pull a vertex far enough out to contain the probe
+    poly.Outline( 0 ).SetPoint( 0, VECTOR2I( 4000000, 0 ) );
+    BOOST_CHECK( poly.Contains( probe ) );
+
+    poly.CacheTriangulation( false );
+    BOOST_CHECK( poly.Contains( probe ) );
+    BOOST_CHECK_EQUAL( poly.SquaredDistance( probe ), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( IndexQueries )
+{
+    SHAPE_POLY_SET        poly = makeWobblyRing( 500, true );
+    POLYGON_SEGMENT_INDEX index( poly.CPolygon( 0 ) );
+
+    BOOST_CHECK_EQUAL( index.GetSegmentCount(), 1000 );
+    BOOST_CHECK( !index.Contains( VECTOR2I( 0, 0 ), 0 ) );
+    BOOST_CHECK( index.OutlineContains( VECTOR2I( 0, 0 ), 0 ) );
+    BOOST_CHECK( index.Contains( VECTOR2I( 700000, 0 ), 0 ) );
+
+    SEG::ecoord expected = VECTOR2I::ECOORD_MAX;
+
+    for( auto it = poly.CIterateSegmentsWithHoles(); it; it++ )
+        expected = std::min( expected, ( *it ).SquaredDistance( VECTOR2I( 0, 0 ) ) );
+
+    VECTOR2I nearest;
+    SEG::ecoord actual = index.SquaredEdgeDistance( VECTOR2I( 0, 0 ), &nearest );
+
+    BOOST_CHECK_EQUAL( actual, expected );
+    BOOST_CHECK_EQUAL( nearest.SquaredEuclideanNorm(), expected );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
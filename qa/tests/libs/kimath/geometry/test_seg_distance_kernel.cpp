@@ -0,0 +1,134 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ */
+
+#include <geometry/seg_distance_kernel.h>
+#include <geometry/seg.h>
+#include <geometry/shape_circle.h>
+#include <geometry/shape_line_chain.h>
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <random>
+
+
+static SHAPE_LINE_CHAIN randomChain( std::mt19937& aRng, int aPoints, int aRange )
+{
+    std::uniform_int_distribution<int> coord( -aRange, aRange );
+    SHAPE_LINE_CHAIN                   chain;
+
+    for( int ii = 0; ii < aPoints; ++ii )
+        chain.Append( VECTOR2I( coord( aRng ), coord( aRng ) ), true );
+
+    return chain;
+}
+
+
+BOOST_AUTO_TEST_SUITE( SegDistanceKernel )
+
+
+/**
+ * Every segment strictly within reach must be reported, in order, whatever the vector width.
+ */
+BOOST_AUTO_TEST_CASE( NeverSkipsNearSegments )
+{
+    std::mt19937                       rng( 42 );
+    std::uniform_int_distribution<int> coord( -1000000, 1000000 );
+    std::uniform_int_distribution<int> radius( 0, 200000 );
+
+    for( int trial = 0; trial < 200; ++trial )
+    {
+        SHAPE_LINE_CHAIN                      chain = randomChain( rng, 2 + trial % 37, 1000000 );
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = chain.CPoints();
+        size_t                                count = pts.size() - 1;
+        VECTOR2I                              p( coord( rng ), coord( rng ) );
+        int                                   r = radius( rng );
+
+        size_t next = FindSegmentNearPoint( pts.data(), count, 0, VECTOR2D( p ), r );
+
+        for( size_t ii = 0; ii < count; ++ii )
+        {
+            bool near = SEG( pts[ii], pts[ii + 1] ).SquaredDistance( p ) < SEG::Square( r );
+
+            if( near )
+                BOOST_REQUIRE_LE( next, ii );
+
+            if( next == ii )
+                next = FindSegmentNearPoint( pts.data(), count, ii + 1, VECTOR2D( p ), r );
+        }
+
+        BOOST_CHECK_EQUAL( next, count );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( EmptyAndOutOfRange )
+{
+    VECTOR2I pts[] = { { 0, 0 }, { 1000, 0 } };
+
+    BOOST_CHECK_EQUAL( FindSegmentNearPoint( pts, 0, 0, VECTOR2D( 0, 0 ), 10 ), 0 );
+    BOOST_CHECK_EQUAL( FindSegmentNearPoint( pts, 1, 1, VECTOR2D( 0, 0 ), 10 ), 1 );
+    BOOST_CHECK_EQUAL( FindSegmentNearPoint( pts, 1, 0, VECTOR2D( 500, 5 ), 10 ), 0 );
+    BOOST_CHECK_EQUAL( FindSegmentNearPoint( pts, 1, 0, VECTOR2D( 500, 50 ), 10 ), 1 );
+}
+
+
+/**
+ * The prefiltered collision routines must agree with the unfiltered SHAPE_LINE_CHAIN_BASE ones.
+ */
+BOOST_AUTO_TEST_CASE( CollideMatchesBruteForce )
+{
+    std::mt19937                       rng( 7 );
+    std::uniform_int_distribution<int> coord( -100000, 100000 );
+    std::uniform_int_distribution<int> clearance( 0, 20000 );
+
+    for( int trial = 0; trial < 500; ++trial )
+    {
+        SHAPE_LINE_CHAIN chain = randomChain( rng, 2 + trial % 23, 100000 );
+        chain.SetClosed( trial % 2 );
+
+        const SHAPE_LINE_CHAIN_BASE& base = chain;
+
+        VECTOR2I p( coord( rng ), coord( rng ) );
+        SEG      seg( p, VECTOR2I( coord( rng ), coord( rng ) ) );
+        int      cl = clearance( rng );
+        int      actual = -1;
+        int      expected = -1;
+
+        BOOST_CHECK_EQUAL( chain.Collide( p, cl, &actual ),
+                           base.SHAPE_LINE_CHAIN_BASE::Collide( p, cl, &expected ) );
+        BOOST_CHECK_EQUAL( actual, expected );
+
+        actual = expected = -1;
+
+        BOOST_CHECK_EQUAL( chain.Collide( seg, cl, &actual ),
+                           base.SHAPE_LINE_CHAIN_BASE::Collide( seg, cl, &expected ) );
+        BOOST_CHECK_EQUAL( actual, expected );
+
+        SHAPE_CIRCLE circle( p, cl / 2 );
+        bool         expectCircle = chain.IsClosed() && chain.PointInside( p );
+
+        for( int ii = 0; ii < chain.SegmentCount(); ++ii )
+            expectCircle |= circle.Collide( chain.CSegment( ii ), cl / 2 );
+
+        const SHAPE* circleShape = &circle;
+
+        BOOST_CHECK_EQUAL( circleShape->Collide( &chain, cl / 2 ), expectCircle );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
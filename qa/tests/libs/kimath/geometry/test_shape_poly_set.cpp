@@ -64,4 +64,227 @@ BOOST_AUTO_TEST_CASE( RemoveNullSegments )
 
 }
 
+
+BOOST_AUTO_TEST_CASE( CacheTriangulationReusesIslands )
+{
+    SHAPE_POLY_SET islands;
+
+    for( int ii = 0; ii < 4; ++ii )
+    {
+        islands.NewOutline();
+        islands.Append( ii * 100, 0 );
+        islands.Append( ii * 100 + 50, 0 );
+        islands.Append( ii * 100 + 50, 50 );
+        islands.Append( ii * 100, 50 );
+    }
+
+    islands.CacheTriangulation();
+    BOOST_REQUIRE( islands.IsTriangulationUpToDate() );
+
+    auto bySource =
+            [&]()
+            {
+                std::map<int, const SHAPE_POLY_SET::TRIANGULATED_POLYGON*> result;
+
+                for( unsigned ii = 0; ii < islands.TriangulatedPolyCount(); ++ii )
+                {
+                    const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri =
+                            islands.TriangulatedPolygon( ii );
+
+                    result[tri->GetSourceOutlineIndex()] = tri;
+                }
+
+                return result;
+            };
+
+    auto before = bySource();
+    BOOST_REQUIRE_EQUAL( before.size(), 4 );
+
+    // Change the first island only: the others must keep their triangulation
+    islands.Outline( 0 ).SetPoint( 2, VECTOR2I( 60, 60 ) );
+    islands.CacheTriangulation();
+    BOOST_REQUIRE( islands.IsTriangulationUpToDate() );
+
+    auto after = bySource();
+    BOOST_REQUIRE_EQUAL( after.size(), 4 );
+
+    for( int ii = 1; ii < 4; ++ii )
+        BOOST_CHECK( after[ii] == before[ii] );
+
+    BOOST_CHECK( after[0]->GetVertexCount() > 0 );
+
+    // Removing an island renumbers the ones after it
+    islands.DeletePolygon( 1 );
+    islands.CacheTriangulation();
+
+    auto renumbered = bySource();
+    BOOST_REQUIRE_EQUAL( renumbered.size(), 3 );
+    BOOST_CHECK( renumbered[1] == after[2] );
+    BOOST_CHECK( renumbered[2] == after[3] );
+}
+
+
+static SHAPE_POLY_SET makeSquare( int aX, int aY, int aSize )
+{
+    SHAPE_POLY_SET square;
+
+    square.NewOutline();
+    square.Append( aX, aY );
+    square.Append( aX + aSize, aY );
+    square.Append( aX + aSize, aY + aSize );
+    square.Append( aX, aY + aSize );
+
+    return square;
+}
+
+
+BOOST_AUTO_TEST_CASE( BatchedBooleans )
+{
+    std::vector<SHAPE_POLY_SET>        squares;
+    std::vector<const SHAPE_POLY_SET*> others;
+
+    // A row of overlapping squares, plus one on its own
+    for( int ii = 0; ii < 10; ++ii )
+        squares.push_back( makeSquare( ii * 50, 0, 100 ) );
+
+    squares.push_back( makeSquare( 0, 1000, 100 ) );
+
+    for( const SHAPE_POLY_SET& square : squares )
+        others.push_back( &square );
+
+    SHAPE_POLY_SET batched;
+    SHAPE_POLY_SET sequential;
+
+    batched.BooleanAdd( others, SHAPE_POLY_SET::PM_FAST );
+
+    for( const SHAPE_POLY_SET& square : squares )
+        sequential.BooleanAdd( square, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( batched.OutlineCount(), 2 );
+    BOOST_CHECK_EQUAL( batched.OutlineCount(), sequential.OutlineCount() );
+    BOOST_CHECK_EQUAL( batched.Area(), sequential.Area() );
+    BOOST_CHECK_EQUAL( batched.Area(), 550.0 * 100 + 100 * 100 );
+
+    // Overlapping knockouts don't need to be merged first
+    SHAPE_POLY_SET plane = makeSquare( -1000, -1000, 3000 );
+    SHAPE_POLY_SET merged = plane;
+
+    plane.BooleanSubtract( others, SHAPE_POLY_SET::PM_FAST );
+    merged.BooleanSubtract( sequential, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( plane.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( plane.HoleCount( 0 ), 2 );
+    BOOST_CHECK_EQUAL( plane.Area(), merged.Area() );
+}
+
+
+BOOST_AUTO_TEST_CASE( ParallelUnionMatchesSimplify )
+{
+    SHAPE_POLY_SET knockouts;
+
+    // Rows of overlapping squares, long enough to cross every band, and a grid of separate ones
+    for( int row = 0; row < 20; ++row )
+    {
+        for( int ii = 0; ii < 100; ++ii )
+            knockouts.Append( makeSquare( ii * 80, row * 300, 100 ) );
+    }
+
+    for( int row = 0; row < 40; ++row )
+    {
+        for( int ii = 0; ii < 40; ++ii )
+            knockouts.Append( makeSquare( ii * 200, 10000 + row * 200, 100 ) );
+    }
+
+    SHAPE_POLY_SET serial = knockouts;
+    serial.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET parallel = SHAPE_POLY_SET::ParallelUnion( { &knockouts }, 100 );
+
+    BOOST_CHECK_EQUAL( parallel.OutlineCount(), 20 + 40 * 40 );
+    BOOST_CHECK_EQUAL( parallel.OutlineCount(), serial.OutlineCount() );
+    BOOST_CHECK_EQUAL( parallel.Area(), serial.Area() );
+    BOOST_CHECK( !parallel.IsSelfIntersecting() );
+}
+
+
+BOOST_AUTO_TEST_CASE( SimplifyOutlines )
+{
+    SHAPE_POLY_SET polySet;
+
+    // A square with small bumps along its bottom edge, and a hole too small to be kept
+    polySet.NewOutline();
+
+    for( int x = 0; x < 10000; x += 100 )
+        polySet.Append( x, ( x / 100 ) % 2 ? 5 : 0 );
+
+    polySet.Append( 10000, 0 );
+    polySet.Append( 10000, 10000 );
+    polySet.Append( 0, 10000 );
+
+    polySet.NewHole();
+    polySet.Append( 5000, 5000 );
+    polySet.Append( 5010, 5000 );
+    polySet.Append( 5010, 5010 );
+
+    polySet.NewOutline();
+    polySet.Append( 20000, 0 );
+    polySet.Append( 20008, 0 );
+    polySet.Append( 20008, 8 );
+
+    polySet.SimplifyOutlines( 10 );
+
+    BOOST_REQUIRE_EQUAL( polySet.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( polySet.HoleCount( 0 ), 0 );
+    BOOST_CHECK_EQUAL( polySet.Outline( 0 ).PointCount(), 4 );
+    BOOST_CHECK_CLOSE( polySet.Area(), 1e8, 0.1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( TransformPoints )
+{
+    SHAPE_POLY_SET polySet;
+
+    polySet.NewOutline();
+    polySet.Append( 0, 0 );
+    polySet.Append( 1000, 0 );
+    polySet.Append( 1000, 1000 );
+    polySet.Append( 0, 1000 );
+
+    polySet.NewHole();
+    polySet.Append( 200, 200 );
+    polySet.Append( 200, 800 );
+    polySet.Append( 800, 800 );
+    polySet.Append( 800, 200 );
+
+    polySet.CacheTriangulation( false );
+    BOOST_REQUIRE( polySet.IsTriangulationUpToDate() );
+
+    // Scaled, mirrored and moved
+    polySet.TransformPoints(
+            []( const VECTOR2I& aPt )
+            {
+                return VECTOR2I( 3 * aPt.x + 500, -2 * aPt.y );
+            } );
+
+    BOOST_CHECK( polySet.IsTriangulationUpToDate() );
+    BOOST_CHECK_EQUAL( polySet.Outline( 0 ).CPoint( 2 ), VECTOR2I( 3500, -2000 ) );
+
+    double triangleArea = 0.0;
+
+    for( unsigned int ii = 0; ii < polySet.TriangulatedPolyCount(); ++ii )
+    {
+        const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = polySet.TriangulatedPolygon( ii );
+
+        for( size_t jj = 0; jj < tri->GetTriangleCount(); ++jj )
+        {
+            VECTOR2I a, b, c;
+            tri->GetTriangle( jj, a, b, c );
+            triangleArea += std::abs( ( b - a ).Cross( c - a ) ) / 2.0;
+        }
+    }
+
+    BOOST_CHECK_CLOSE( triangleArea, 6.0 * ( 1000 * 1000 - 600 * 600 ), 0.01 );
+    BOOST_CHECK_CLOSE( polySet.Area(), triangleArea, 0.01 );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -30,6 +30,9 @@
 #include <pcb_marker.h>
 #include <footprint.h>
 #include <drc/drc_item.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_incremental_scope.h>
+#include <drc/drc_result_cache.h>
 #include <settings/settings_manager.h>
 
 
@@ -191,3 +194,203 @@ BOOST_FIXTURE_TEST_CASE( DRCFalseNegativeRegressions, DRC_REGRESSION_TEST_FIXTUR
         }
     }
 }
+
+
+BOOST_FIXTURE_TEST_CASE( DRCReportsInProviderOrder, DRC_REGRESSION_TEST_FIXTURE )
+{
+    // Providers run concurrently, but their violations must still come out grouped and in
+    // provider order
+
+    for( const wxString& testName : { "issue5750", "issue6879", "issue12109" } )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, testName, m_board );
+
+        BOARD_DESIGN_SETTINGS&              bds = m_board->GetDesignSettings();
+        std::shared_ptr<DRC_ENGINE>         engine = bds.m_DRCEngine;
+        std::vector<DRC_TEST_PROVIDER*>     providers = engine->GetTestProviders();
+        std::vector<std::pair<size_t, int>> reported;
+
+        bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_ISSUES ] = SEVERITY::RPT_SEVERITY_IGNORE;
+        bds.m_DRCSeverities[ DRCE_LIB_FOOTPRINT_MISMATCH ] = SEVERITY::RPT_SEVERITY_IGNORE;
+
+        engine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+                {
+                    auto it = std::find( providers.begin(), providers.end(),
+                                         aItem->GetViolatingTest() );
+
+                    BOOST_REQUIRE( it != providers.end() );
+                    reported.emplace_back( it - providers.begin(), aItem->GetErrorCode() );
+                } );
+
+        engine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+        BOOST_CHECK_MESSAGE( !reported.empty(), testName );
+        BOOST_CHECK_MESSAGE( std::is_sorted( reported.begin(), reported.end(),
+                                             []( const auto& aA, const auto& aB )
+                                             {
+                                                 return aA.first < aB.first;
+                                             } ),
+                             testName );
+
+        std::vector<std::pair<size_t, int>> first = std::move( reported );
+
+        reported.clear();
+        engine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+        std::sort( first.begin(), first.end() );
+        std::sort( reported.begin(), reported.end() );
+        BOOST_CHECK_MESSAGE( first == reported, testName );
+    }
+}
+
+
+BOOST_FIXTURE_TEST_CASE( DRCIncrementalMatchesFullRun, DRC_REGRESSION_TEST_FIXTURE )
+{
+    // An incremental run must find every violation of the full run which involves a changed
+    // item, for the error codes it re-checks
+    int checked = 0;
+
+    for( const wxString& testName : { "issue5750", "issue6879", "issue12109" } )
+    {
+        KI_TEST::LoadBoard( m_settingsManager, testName, m_board );
+
+        BOARD_DESIGN_SETTINGS&      bds = m_board->GetDesignSettings();
+        std::shared_ptr<DRC_ENGINE> engine = bds.m_DRCEngine;
+        std::set<int>               codes = engine->GetIncrementalErrorCodes();
+        std::set<wxString>          reported;
+
+        auto key =
+                []( const std::shared_ptr<DRC_ITEM>& aItem )
+                {
+                    wxString str = wxString::Format( wxT( "%d" ), aItem->GetErrorCode() );
+
+                    for( const KIID& id : aItem->GetIDs() )
+                        str << wxT( "|" ) << id.AsString();
+
+                    return str;
+                };
+
+        engine->SetViolationHandler(
+                [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+                {
+                    if( codes.count( aItem->GetErrorCode() ) )
+                        reported.insert( key( aItem ) );
+                } );
+
+        engine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+        std::set<wxString> full = std::move( reported );
+        int                checkedTracks = 0;
+
+        for( PCB_TRACK* track : m_board->Tracks() )
+        {
+            wxString id = track->m_Uuid.AsString();
+            bool     involved = std::any_of( full.begin(), full.end(),
+                                             [&]( const wxString& aKey )
+                                             {
+                                                 return aKey.Contains( id );
+                                             } );
+
+            if( !involved )
+                continue;
+
+            DRC_INCREMENTAL_SCOPE scope;
+            scope.AddChangedItem( track );
+
+            reported.clear();
+            engine->RunIncrementalTests( EDA_UNITS::MILLIMETRES, scope );
+
+            for( const wxString& violation : full )
+            {
+                if( violation.Contains( id ) )
+                    BOOST_CHECK_MESSAGE( reported.count( violation ), testName + ": " + violation );
+            }
+
+            // Nothing outside the full run's results
+            for( const wxString& violation : reported )
+                BOOST_CHECK_MESSAGE( full.count( violation ), testName + ": " + violation );
+
+            checked++;
+
+            if( ++checkedTracks == 5 )
+                break;
+        }
+    }
+
+    BOOST_CHECK( checked > 0 );
+}
+
+
+BOOST_FIXTURE_TEST_CASE( DRCResultCacheMatchesFullRun, DRC_REGRESSION_TEST_FIXTURE )
+{
+    // A run reusing the stored results must report the same violations as a full run, both
+    // when nothing changed and after an item was modified
+    KI_TEST::LoadBoard( m_settingsManager, "issue5750", m_board );
+
+    BOARD_DESIGN_SETTINGS&      bds = m_board->GetDesignSettings();
+    std::shared_ptr<DRC_ENGINE> engine = bds.m_DRCEngine;
+    wxFileName                  cachePath( wxFileName::CreateTempFileName( wxS( "drc_cache" ) ) );
+    std::set<wxString>          reported;
+
+    wxRemoveFile( cachePath.GetFullPath() );
+
+    engine->SetViolationHandler(
+            [&]( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+            {
+                wxString str = wxString::Format( wxT( "%s|%d|%d" ), aItem->GetSettingsKey(),
+                                                 aPos.x, aPos.y );
+
+                for( const KIID& id : aItem->GetIDs() )
+                    str << wxT( "|" ) << id.AsString();
+
+                reported.insert( str );
+            } );
+
+    auto fullRun =
+            [&]()
+            {
+                reported.clear();
+                engine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+                return reported;
+            };
+
+    auto cachedRun =
+            [&]( bool aExpectReuse )
+            {
+                DRC_RESULT_CACHE cache( engine.get() );
+
+                reported.clear();
+
+                bool reused = cache.RunTests( cachePath, EDA_UNITS::MILLIMETRES, true, false );
+
+                BOOST_CHECK_EQUAL( reused, aExpectReuse );
+                return reported;
+            };
+
+    std::set<wxString> full = fullRun();
+
+    BOOST_CHECK( !full.empty() );
+    BOOST_CHECK( cachedRun( false ) == full );
+    BOOST_CHECK( cachedRun( true ) == full );
+
+    // Widen a track: its violations are re-tested, the others come from the cache
+    PCB_TRACK* track = nullptr;
+
+    for( PCB_TRACK* candidate : m_board->Tracks() )
+    {
+        if( candidate->Type() == PCB_TRACE_T )
+        {
+            track = candidate;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( track );
+    track->SetWidth( track->GetWidth() * 4 );
+
+    full = fullRun();
+    BOOST_CHECK( cachedRun( true ) == full );
+
+    wxRemoveFile( cachePath.GetFullPath() );
+}
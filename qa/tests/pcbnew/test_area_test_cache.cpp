@@ -0,0 +1,142 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <pcb_track.h>
+#include <zone.h>
+#include <area_test_cache.h>
+
+
+BOOST_AUTO_TEST_SUITE( AreaTestCache )
+
+
+using TEST = AREA_TEST_CACHE::TEST;
+
+
+BOOST_AUTO_TEST_CASE( StoresResultsByTestAndLayer )
+{
+    BOARD     board;
+    ZONE      area( &board );
+    PCB_TRACK track( &board );
+
+    AREA_TEST_CACHE& cache = board.m_AreaTestCache;
+
+    cache.Set( TEST::INTERSECTS_AREA, &area, &track, UNDEFINED_LAYER, true );
+    cache.Set( TEST::INTERSECTS_AREA, &area, &track, B_Cu, false );
+
+    BOOST_CHECK( cache.Get( TEST::INTERSECTS_AREA, &area, &track, UNDEFINED_LAYER ) == true );
+    BOOST_CHECK( cache.Get( TEST::INTERSECTS_AREA, &area, &track, B_Cu ) == false );
+    BOOST_CHECK( !cache.Get( TEST::INTERSECTS_AREA, &area, &track, F_Cu ) );
+    BOOST_CHECK( !cache.Get( TEST::ENCLOSED_BY_AREA, &area, &track, UNDEFINED_LAYER ) );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 2 );
+
+    // Results are kept across edits
+    board.IncrementTimeStamp();
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 2 );
+}
+
+
+BOOST_AUTO_TEST_CASE( InvalidatesChangedItems )
+{
+    BOARD     board;
+    ZONE      area( &board );
+    ZONE      otherArea( &board );
+    PCB_TRACK track( &board );
+    PCB_TRACK otherTrack( &board );
+
+    AREA_TEST_CACHE& cache = board.m_AreaTestCache;
+
+    cache.Set( TEST::INTERSECTS_AREA, &area, &track, UNDEFINED_LAYER, true );
+    cache.Set( TEST::INTERSECTS_AREA, &otherArea, &track, UNDEFINED_LAYER, true );
+    cache.Set( TEST::INTERSECTS_AREA, &area, &otherTrack, UNDEFINED_LAYER, false );
+    cache.Set( TEST::INTERSECTS_AREA, &otherArea, &otherTrack, UNDEFINED_LAYER, false );
+
+    // A changed item drops its own results...
+    cache.Invalidate( { &track } );
+
+    BOOST_CHECK( !cache.Get( TEST::INTERSECTS_AREA, &area, &track, UNDEFINED_LAYER ) );
+    BOOST_CHECK( !cache.Get( TEST::INTERSECTS_AREA, &otherArea, &track, UNDEFINED_LAYER ) );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 2 );
+
+    // ... and a changed area the results against it
+    cache.Invalidate( { &area } );
+
+    BOOST_CHECK( !cache.Get( TEST::INTERSECTS_AREA, &area, &otherTrack, UNDEFINED_LAYER ) );
+    BOOST_CHECK( cache.Get( TEST::INTERSECTS_AREA, &otherArea, &otherTrack, UNDEFINED_LAYER )
+                 == false );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( RevalidatesEditsWithoutCommit )
+{
+    BOARD      board;
+    ZONE*      area = new ZONE( &board );
+    PCB_TRACK* track = new PCB_TRACK( &board );
+    PCB_TRACK* otherTrack = new PCB_TRACK( &board );
+
+    board.Add( area );
+    board.Add( track );
+    board.Add( otherTrack );
+
+    AREA_TEST_CACHE& cache = board.m_AreaTestCache;
+
+    cache.Revalidate( &board );
+    cache.Set( TEST::INTERSECTS_AREA, area, track, UNDEFINED_LAYER, true );
+    cache.Set( TEST::INTERSECTS_AREA, area, otherTrack, UNDEFINED_LAYER, false );
+
+    // Nothing changed
+    cache.Revalidate( &board );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 2 );
+
+    // Moved in place, as a script would do
+    track->SetEnd( VECTOR2I( 1000000, 0 ) );
+    cache.Revalidate( &board );
+
+    BOOST_CHECK( !cache.Get( TEST::INTERSECTS_AREA, area, track, UNDEFINED_LAYER ) );
+    BOOST_CHECK( cache.Get( TEST::INTERSECTS_AREA, area, otherTrack, UNDEFINED_LAYER ) == false );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 1 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ClearsOnNewParameters )
+{
+    BOARD     board;
+    ZONE      area( &board );
+    PCB_TRACK track( &board );
+
+    AREA_TEST_CACHE& cache = board.m_AreaTestCache;
+
+    cache.SetParameters( 10, 5000 );
+    cache.Set( TEST::ENCLOSED_BY_AREA, &area, &track, F_Cu, true );
+
+    cache.SetParameters( 10, 5000 );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 1 );
+
+    cache.SetParameters( 10, 2500 );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -307,4 +307,41 @@ BOOST_AUTO_TEST_CASE( FlipUpDown )
 }
 
 
+BOOST_AUTO_TEST_CASE( GetItemById )
+{
+    BOARD      board;
+    FOOTPRINT* footprint = new FOOTPRINT( &board );
+    PAD*       pad = new PAD( footprint );
+    PCB_TRACK* track = new PCB_TRACK( &board );
+
+    footprint->Add( pad );
+    board.Add( footprint );
+    board.Add( track );
+
+    BOOST_CHECK( board.GetItem( footprint->m_Uuid ) == footprint );
+    BOOST_CHECK( board.GetItem( pad->m_Uuid ) == pad );
+    BOOST_CHECK( board.GetItem( footprint->Reference().m_Uuid ) == &footprint->Reference() );
+    BOOST_CHECK( board.GetItem( track->m_Uuid ) == track );
+
+    // Items added to a footprint already on the board
+    PAD* pad2 = new PAD( footprint );
+    footprint->Add( pad2 );
+
+    BOOST_CHECK( board.GetItem( pad2->m_Uuid ) == pad2 );
+
+    KIID padId = pad->m_Uuid;
+    footprint->Remove( pad );
+    delete pad;
+
+    BOOST_CHECK( board.GetItem( padId ) == DELETED_BOARD_ITEM::GetInstance() );
+
+    KIID trackId = track->m_Uuid;
+    board.Remove( track );
+    delete track;
+
+    BOOST_CHECK( board.GetItem( trackId ) == DELETED_BOARD_ITEM::GetInstance() );
+    BOOST_CHECK( board.GetItem( pad2->m_Uuid ) == pad2 );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
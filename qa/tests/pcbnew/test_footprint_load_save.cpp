@@ -21,9 +21,16 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <filesystem>
+#include <fstream>
+
+#include <fmt/format.h>
+#include <fmt/std.h>
+
 #include <board.h>
 #include <kiid.h>
 #include <footprint.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
 #include <pcbnew_utils/board_file_utils.h>
 #include <pcbnew_utils/board_test_utils.h>
 #include <qa_utils/wx_utils/unit_test_utils.h>
@@ -98,4 +105,115 @@ BOOST_FIXTURE_TEST_CASE( FootprintLoadSave, FOOTPRINT_LOAD_TEST_FIXTURE )
 
         KI_TEST::LoadAndTestBoardFile( testCase.m_boardFileRelativePath, true, doBoardTest );
     }
-}
\ No newline at end of file
+}
+
+/**
+ * Footprint summaries from the library index match the ones of the loaded footprints, and
+ * single footprints load without the rest of their library.
+ */
+BOOST_AUTO_TEST_CASE( FootprintLibraryIndex )
+{
+    wxString libPath = KI_TEST::GetPcbnewTestDataDir() + "plugins/eagle/lbr/SparkFun-GPS.pretty";
+
+    PCB_IO_KICAD_SEXPR             loadedIO;
+    std::vector<FOOTPRINT_SUMMARY> expected;
+
+    // Qualified, so that the summaries come from the loaded footprints
+    loadedIO.PCB_IO::FootprintEnumerateSummaries( expected, libPath, false );
+
+    BOOST_REQUIRE( !expected.empty() );
+
+    // Twice, to build the index and then read it back
+    for( int pass = 0; pass < 2; ++pass )
+    {
+        PCB_IO_KICAD_SEXPR             indexIO;
+        std::vector<FOOTPRINT_SUMMARY> summaries;
+
+        indexIO.FootprintEnumerateSummaries( summaries, libPath, false );
+
+        BOOST_REQUIRE_EQUAL( summaries.size(), expected.size() );
+
+        for( size_t ii = 0; ii < summaries.size(); ++ii )
+        {
+            BOOST_CHECK_EQUAL( summaries[ii].m_name, expected[ii].m_name );
+            BOOST_CHECK_EQUAL( summaries[ii].m_description, expected[ii].m_description );
+            BOOST_CHECK_EQUAL( summaries[ii].m_keywords, expected[ii].m_keywords );
+            BOOST_CHECK_EQUAL( summaries[ii].m_padCount, expected[ii].m_padCount );
+            BOOST_CHECK_EQUAL( summaries[ii].m_uniquePadCount, expected[ii].m_uniquePadCount );
+        }
+    }
+
+    PCB_IO_KICAD_SEXPR         singleIO;
+    std::unique_ptr<FOOTPRINT> footprint( singleIO.FootprintLoad( libPath, expected[0].m_name ) );
+
+    BOOST_REQUIRE( footprint );
+    BOOST_CHECK_EQUAL( footprint->GetFPID().GetLibItemName().wx_str(), expected[0].m_name );
+    BOOST_CHECK_EQUAL( footprint->GetPadCount( DO_NOT_INCLUDE_NPTH ), expected[0].m_padCount );
+    BOOST_CHECK( !singleIO.FootprintLoad( libPath, wxS( "no such footprint" ) ) );
+}
+
+
+/**
+ * Reloading a library only parses the footprint files which changed, and drops the ones
+ * which were removed.
+ */
+BOOST_AUTO_TEST_CASE( FootprintCacheIncrementalLoad )
+{
+    std::string srcPath = KI_TEST::GetPcbnewTestDataDir() + "plugins/eagle/lbr/SparkFun-GPS.pretty";
+    std::string libPath = fmt::format( "{}/incremental.pretty",
+                                       std::filesystem::temp_directory_path() );
+
+    std::filesystem::remove_all( libPath );
+    std::filesystem::copy( srcPath, libPath );
+
+    PCB_IO_KICAD_SEXPR io;
+    FP_CACHE           cache( &io, libPath );
+
+    cache.Load();
+
+    std::map<wxString, const FOOTPRINT*> before;
+
+    for( const auto& [name, item] : cache.GetFootprints() )
+        before[name] = item->GetFootprint();
+
+    BOOST_REQUIRE( before.size() >= 3 );
+
+    const wxString changed = before.begin()->first;
+    const wxString removed = std::next( before.begin(), 1 )->first;
+
+    // Change the size, as the modification time may not move within the test
+    {
+        std::ofstream out( fmt::format( "{}/{}.kicad_mod", libPath, changed.ToStdString() ),
+                           std::ios::app );
+        out << "\n";
+    }
+
+    std::filesystem::remove( fmt::format( "{}/{}.kicad_mod", libPath, removed.ToStdString() ) );
+
+    BOOST_CHECK( cache.IsModified() );
+
+    cache.Load();
+
+    FP_CACHE_FOOTPRINT_MAP& after = cache.GetFootprints();
+
+    BOOST_CHECK_EQUAL( after.size(), before.size() - 1 );
+    BOOST_CHECK( after.find( removed ) == after.end() );
+
+    for( const auto& [name, footprint] : before )
+    {
+        if( name == removed )
+            continue;
+
+        BOOST_TEST_CONTEXT( name.ToStdString() )
+        {
+            BOOST_REQUIRE( after.find( name ) != after.end() );
+
+            if( name == changed )
+                BOOST_CHECK( after.find( name )->second->GetFootprint() != footprint );
+            else
+                BOOST_CHECK( after.find( name )->second->GetFootprint() == footprint );
+        }
+    }
+
+    std::filesystem::remove_all( libPath );
+}
@@ -28,6 +28,7 @@
 #include <layer_ids.h>
 #include <pcbnew/pcbexpr_evaluator.h>
 #include <drc/drc_rule.h>
+#include <drc/drc_rule_condition.h>
 #include <pcbnew/board.h>
 #include <pcbnew/pcb_track.h>
 
@@ -82,7 +83,9 @@ const static std::vector<EXPR_TO_TEST> introspectionExpressions = {
     { "A.Netclass + 1.0", false, VAL( 1.0 ) },
     { "A.type == 'Track' && B.type == 'Track' && A.layer == 'F.Cu'", false, VAL( 1.0 ) },
     { "(A.type == 'Track') && (B.type == 'Track') && (A.layer == 'F.Cu')", false, VAL( 1.0 ) },
-    { "A.type == 'Via' && A.isMicroVia()", false, VAL(0.0) }
+    { "A.type == 'Via' && A.isMicroVia()", false, VAL(0.0) },
+    { "A.Locked + 1", false, VAL( 1.0 ) },
+    { "A.layer != 'B.Cu' && B.Layer == 'F.Cu'", false, VAL( 1.0 ) }
 };
 
 
@@ -146,6 +149,21 @@ BOOST_AUTO_TEST_CASE( SimpleExpressions )
 }
 
 
+BOOST_AUTO_TEST_CASE( ConstantFolding )
+{
+    PCBEXPR_COMPILER compiler( new PCBEXPR_UNIT_RESOLVER() );
+    PCBEXPR_UCODE    ucode;
+    PCBEXPR_CONTEXT  context( NULL_CONSTRAINT, UNDEFINED_LAYER );
+    PCBEXPR_CONTEXT  preflightContext( NULL_CONSTRAINT, UNDEFINED_LAYER );
+
+    BOOST_REQUIRE( compiler.Compile( "!(-(1mm + 2mm) * 3 < 10mm)", &ucode, &preflightContext ) );
+
+    // The whole expression is a single constant push
+    BOOST_CHECK_EQUAL( ucode.Dump().Freq( '\n' ), 1 );
+    BOOST_CHECK_EQUAL( ucode.Run( &context )->AsDouble(), 0.0 );
+}
+
+
 BOOST_AUTO_TEST_CASE( IntrospectedProperties )
 {
     PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
@@ -181,4 +199,31 @@ BOOST_AUTO_TEST_CASE( IntrospectedProperties )
     }
 }
 
+
+BOOST_AUTO_TEST_CASE( ConditionDependencies )
+{
+    PROPERTY_MANAGER& propMgr = PROPERTY_MANAGER::Instance();
+    propMgr.Rebuild();
+
+    const std::vector<std::pair<wxString, int>> conditions = {
+        { "A.NetClass == 'HV'", DRC_DEPENDS_ON_NETCLASS },
+        { "A.NetClass == 'HV' && A.inDiffPair('*')", DRC_DEPENDS_ON_NETCLASS | DRC_DEPENDS_ON_NET },
+        { "AB.isCoupledDiffPair()", DRC_DEPENDS_ON_NET },
+        { "A.Via_Type != 'Micro' && B.Type == 'Pad'", DRC_DEPENDS_ON_VIA_TYPE },
+        { "A.NetName == 'Width' || A.Layer == 'F.Cu'", DRC_DEPENDS_ON_NET | DRC_DEPENDS_ON_LAYER },
+        { "A.memberOfFootprint('U1')", DRC_DEPENDS_ON_FOOTPRINT },
+        { "A.Width > 0.2mm", DRC_DEPENDS_ON_ANYTHING },
+        { "A.intersectsArea('Keepout')", DRC_DEPENDS_ON_ANYTHING },
+    };
+
+    for( const auto& [ expression, expected ] : conditions )
+    {
+        DRC_RULE_CONDITION condition( expression );
+
+        BOOST_CHECK_EQUAL( condition.GetDependencies(), DRC_DEPENDS_ON_ANYTHING );
+        BOOST_REQUIRE( condition.Compile( nullptr ) );
+        BOOST_CHECK_MESSAGE( condition.GetDependencies() == expected, expression );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,150 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <geometry/shape_poly_set.h>
+
+struct PAD_SHAPE_CACHE_FIXTURE
+{
+    PAD_SHAPE_CACHE_FIXTURE() :
+            m_board(),
+            m_footprint( &m_board ),
+            m_orphan( nullptr )
+    {
+    }
+
+    static void setupPad( PAD& aPad, PAD_SHAPE aShape, const VECTOR2I& aPos,
+                          const EDA_ANGLE& aAngle )
+    {
+        aPad.SetAttribute( PAD_ATTRIB::SMD );
+        aPad.SetLayerSet( PAD::SMDMask() );
+        aPad.SetShape( aShape );
+        aPad.SetSize( VECTOR2I( 600000, 500000 ) );
+        aPad.SetDelta( VECTOR2I( 0, 100000 ) );
+        aPad.SetOffset( VECTOR2I( 50000, 0 ) );
+        aPad.SetRoundRectRadiusRatio( 0.25 );
+        aPad.SetChamferRectRatio( 0.2 );
+        aPad.SetChamferPositions( RECT_CHAMFER_TOP_LEFT | RECT_CHAMFER_BOTTOM_RIGHT );
+        aPad.SetPosition( aPos );
+        aPad.SetOrientation( aAngle );
+    }
+
+    BOARD     m_board;
+    FOOTPRINT m_footprint;
+    FOOTPRINT m_orphan;     ///< Pads without a board don't use the cache
+};
+
+
+static bool sameOutlines( const SHAPE_POLY_SET& aA, const SHAPE_POLY_SET& aB )
+{
+    if( aA.OutlineCount() != aB.OutlineCount() )
+        return false;
+
+    for( int ii = 0; ii < aA.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& a = aA.COutline( ii );
+        const SHAPE_LINE_CHAIN& b = aB.COutline( ii );
+
+        if( a.PointCount() != b.PointCount() )
+            return false;
+
+        for( int jj = 0; jj < a.PointCount(); ++jj )
+        {
+            if( a.CPoint( jj ) != b.CPoint( jj ) )
+                return false;
+        }
+    }
+
+    return true;
+}
+
+
+BOOST_FIXTURE_TEST_SUITE( PadShapeCache, PAD_SHAPE_CACHE_FIXTURE )
+
+
+/**
+ * A cached outline moved into place must be exactly the outline converted in place.
+ */
+BOOST_AUTO_TEST_CASE( MatchesUncached )
+{
+    for( PAD_SHAPE shape : { PAD_SHAPE::CIRCLE, PAD_SHAPE::OVAL, PAD_SHAPE::RECTANGLE,
+                             PAD_SHAPE::TRAPEZOID, PAD_SHAPE::ROUNDRECT,
+                             PAD_SHAPE::CHAMFERED_RECT } )
+    {
+        for( const EDA_ANGLE& angle : { ANGLE_0, ANGLE_90, EDA_ANGLE( 33.3, DEGREES_T ) } )
+        {
+            for( const VECTOR2I& pos : { VECTOR2I( 0, 0 ), VECTOR2I( 1234567, -7654321 ) } )
+            {
+                for( int clearance : { 0, 200000 } )
+                {
+                    for( ERROR_LOC errorLoc : { ERROR_INSIDE, ERROR_OUTSIDE } )
+                    {
+                        PAD cached( &m_footprint );
+                        PAD uncached( &m_orphan );
+
+                        setupPad( cached, shape, pos, angle );
+                        setupPad( uncached, shape, pos, angle );
+
+                        SHAPE_POLY_SET cachedPoly;
+                        SHAPE_POLY_SET uncachedPoly;
+
+                        cached.TransformShapeToPolygon( cachedPoly, F_Cu, clearance, ARC_HIGH_DEF,
+                                                        errorLoc );
+                        uncached.TransformShapeToPolygon( uncachedPoly, F_Cu, clearance,
+                                                          ARC_HIGH_DEF, errorLoc );
+
+                        BOOST_CHECK( sameOutlines( cachedPoly, uncachedPoly ) );
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( SharedBetweenIdenticalPads )
+{
+    m_board.m_PadShapeCache.Clear();
+
+    for( int ii = 0; ii < 100; ++ii )
+    {
+        PAD            pad( &m_footprint );
+        SHAPE_POLY_SET poly;
+
+        setupPad( pad, PAD_SHAPE::ROUNDRECT, VECTOR2I( ii * 1000000, 0 ),
+                  ( ii % 2 ) ? ANGLE_90 : ANGLE_0 );
+        pad.TransformShapeToPolygon( poly, F_Cu, 0, ARC_HIGH_DEF, ERROR_INSIDE );
+    }
+
+    // One entry per orientation
+    BOOST_CHECK_EQUAL( m_board.m_PadShapeCache.GetEntryCount(), 2 );
+
+    m_board.IncrementTimeStamp();
+    BOOST_CHECK_EQUAL( m_board.m_PadShapeCache.GetEntryCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_poly_set.h>
+#include <plot_geometry_cache.h>
+
+
+BOOST_AUTO_TEST_SUITE( PlotGeometryCache )
+
+
+static PLOT_GEOMETRY_KEY maskKey( PCB_LAYER_ID aLayer, int aMinThickness, int aOptions )
+{
+    return { PLOT_GEOMETRY_KEY::KIND::SOLDER_MASK, nullptr, aLayer, aMinThickness, aOptions,
+             ARC_HIGH_DEF };
+}
+
+
+static void buildCircle( SHAPE_POLY_SET& aGeometry )
+{
+    TransformCircleToPolygon( aGeometry, VECTOR2I(), 500000, ARC_HIGH_DEF, ERROR_OUTSIDE );
+}
+
+
+BOOST_AUTO_TEST_CASE( BuildsOncePerKey )
+{
+    PLOT_GEOMETRY_CACHE cache;
+    int                 builds = 0;
+
+    auto builder =
+            [&]( SHAPE_POLY_SET& aGeometry )
+            {
+                builds++;
+                buildCircle( aGeometry );
+            };
+
+    // Plotting the same layer to several formats asks for the same geometry
+    std::shared_ptr<const SHAPE_POLY_SET> first = cache.Get( maskKey( F_Mask, 100000, 0 ),
+                                                             builder );
+    std::shared_ptr<const SHAPE_POLY_SET> second = cache.Get( maskKey( F_Mask, 100000, 0 ),
+                                                              builder );
+
+    BOOST_CHECK_EQUAL( builds, 1 );
+    BOOST_CHECK( first == second );
+    BOOST_CHECK_EQUAL( first->OutlineCount(), 1 );
+
+    // Other layers and plot options are other geometries
+    cache.Get( maskKey( B_Mask, 100000, 0 ), builder );
+    cache.Get( maskKey( F_Mask, 50000, 0 ), builder );
+    cache.Get( maskKey( F_Mask, 100000, 1 ), builder );
+
+    BOOST_CHECK_EQUAL( builds, 4 );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 4 );
+    BOOST_CHECK( cache.GetMemoryUsage() > 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( ClearedByBoardEdits )
+{
+    BOARD board;
+
+    board.m_PlotGeometryCache.Get( maskKey( F_Mask, 100000, 0 ), buildCircle );
+    BOOST_CHECK_EQUAL( board.m_PlotGeometryCache.GetEntryCount(), 1 );
+
+    // Keys hold item pointers, so entries must not survive edits
+    board.IncrementTimeStamp();
+    BOOST_CHECK_EQUAL( board.m_PlotGeometryCache.GetEntryCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -27,9 +27,13 @@
 #include <pcbnew/pad.h>
 #include <pcbnew/pcb_track.h>
 
+#include <geometry/shape_circle.h>
+
+#include <router/pns_index.h>
 #include <router/pns_node.h>
 #include <router/pns_router.h>
 #include <router/pns_item.h>
+#include <router/pns_segment.h>
 #include <router/pns_via.h>
 #include <router/pns_kicad_iface.h>
 
@@ -410,3 +414,125 @@ BOOST_FIXTURE_TEST_CASE( PNSHoleCollisions, PNS_TEST_FIXTURE )
     }
 }
 
+
+
+/**
+ * Items bulk loaded into a PNS::INDEX, added afterwards or removed from either must be found
+ * exactly like a linear scan finds them, before and after the index repacks itself.
+ */
+BOOST_AUTO_TEST_CASE( PNSIndexBulkLoad )
+{
+    std::vector<std::unique_ptr<PNS::SEGMENT>> segments;
+    std::set<PNS::ITEM*>                       expected;
+    PNS::INDEX                                 index;
+
+    for( int ii = 0; ii < 4000; ++ii )
+    {
+        VECTOR2I a( ( ii % 64 ) * 100000, ( ii / 64 ) * 100000 );
+        VECTOR2I b = a + VECTOR2I( ( ii % 7 ) * 30000, ( ii % 5 ) * 30000 );
+
+        segments.push_back( std::make_unique<PNS::SEGMENT>( SEG( a, b ), nullptr ) );
+        segments.back()->SetLayer( F_Cu );
+        segments.back()->SetWidth( 10000 );
+    }
+
+    auto checkQueries =
+            [&]()
+            {
+                for( int ii = 0; ii < 200; ++ii )
+                {
+                    VECTOR2I             center( ( ii * 37 % 64 ) * 100000,
+                                                 ( ii * 11 % 63 ) * 100000 );
+                    SHAPE_CIRCLE         probe( center, 150000 );
+                    std::set<PNS::ITEM*> found;
+                    std::set<PNS::ITEM*> scanned;
+
+                    auto visitor =
+                            [&]( PNS::ITEM* aItem )
+                            {
+                                found.insert( aItem );
+                                return true;
+                            };
+
+                    index.Query( &probe, 0, visitor );
+
+                    for( PNS::ITEM* item : expected )
+                    {
+                        if( item->Shape()->BBox().Intersects( probe.BBox() ) )
+                            scanned.insert( item );
+                    }
+
+                    BOOST_CHECK( found == scanned );
+                }
+
+                BOOST_CHECK_EQUAL( index.Size(), expected.size() );
+            };
+
+    index.BeginBulkLoad();
+
+    for( int ii = 0; ii < 2000; ++ii )
+    {
+        index.Add( segments[ii].get() );
+        expected.insert( segments[ii].get() );
+    }
+
+    index.EndBulkLoad();
+    checkQueries();
+
+    for( int ii = 2000; ii < 4000; ++ii )
+    {
+        index.Add( segments[ii].get() );
+        expected.insert( segments[ii].get() );
+    }
+
+    checkQueries();
+
+    // Remove packed and dynamic items, and add some of the packed ones back
+    for( int ii = 0; ii < 4000; ii += 3 )
+    {
+        index.Remove( segments[ii].get() );
+        expected.erase( segments[ii].get() );
+    }
+
+    for( int ii = 0; ii < 2000; ii += 6 )
+    {
+        index.Add( segments[ii].get() );
+        expected.insert( segments[ii].get() );
+    }
+
+    checkQueries();
+
+    // Enough removals from the packed trees to repack them
+    for( int ii = 1; ii < 2000; ii += 3 )
+    {
+        index.Remove( segments[ii].get() );
+        expected.erase( segments[ii].get() );
+    }
+
+    checkQueries();
+}
+
+
+/**
+ * Cached hulls must match the ones built by Hull(), and must not outlive a change of geometry.
+ */
+BOOST_AUTO_TEST_CASE( PNSCachedHull )
+{
+    PNS::SEGMENT seg( SEG( VECTOR2I( 0, 0 ), VECTOR2I( 1000000, 0 ) ), nullptr );
+    seg.SetWidth( 200000 );
+
+    const SHAPE_LINE_CHAIN& hull = seg.CachedHull( 100000, 50000 );
+
+    BOOST_CHECK( hull.CPoints() == seg.Hull( 100000, 50000 ).CPoints() );
+
+    // The same parameters return the same cached hull, others a hull of their own
+    BOOST_CHECK_EQUAL( &seg.CachedHull( 100000, 50000 ), &hull );
+    BOOST_CHECK( seg.CachedHull( 200000, 50000 ).CPoints()
+                 == seg.Hull( 200000, 50000 ).CPoints() );
+
+    // Changing the geometry drops the cached hulls
+    seg.SetEnds( VECTOR2I( 0, 0 ), VECTOR2I( 0, 2000000 ) );
+
+    BOOST_CHECK( seg.CachedHull( 100000, 50000 ).CPoints()
+                 == seg.Hull( 100000, 50000 ).CPoints() );
+}
@@ -29,7 +29,16 @@
 #include <pcb_track.h>
 #include <footprint.h>
 #include <zone.h>
+#include <zone_filler.h>
+#include <zone_fill_hasher.h>
+#include <board_commit.h>
+#include <tool/tool_manager.h>
 #include <drc/drc_item.h>
+#include <drc/drc_rtree.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr.h>
+#include <pcb_io/kicad_sexpr/pcb_io_kicad_sexpr_board_cache.h>
+#include <richio.h>
+#include <string_utf8_map.h>
 #include <settings/settings_manager.h>
 
 
@@ -162,6 +171,351 @@ BOOST_FIXTURE_TEST_CASE( NotchedZones, ZONE_FILL_TEST_FIXTURE )
 }
 
 
+/**
+ * The filler leaves the DRC index of each copper fill with its zone.  It must only be handed
+ * out while the fill is the one it was built from.
+ */
+BOOST_FIXTURE_TEST_CASE( FillRTreeHandOff, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "notched_zones", m_board );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( zone->GetIsRuleArea() || !zone->IsOnCopperLayer() )
+            continue;
+
+        std::shared_ptr<DRC_RTREE> rtree = zone->GetFillRTree();
+
+        BOOST_REQUIRE( rtree );
+
+        // Nothing changed: the same index
+        zone->CacheTriangulation();
+        BOOST_CHECK( zone->GetFillRTree() == rtree );
+
+        // Copies are other zones
+        ZONE copy( *zone );
+        BOOST_CHECK( !copy.GetFillRTree() );
+
+        // Moving moves the fill
+        zone->Move( VECTOR2I( pcbIUScale.mmToIU( 1 ), 0 ) );
+        zone->CacheTriangulation();
+        BOOST_CHECK( !zone->GetFillRTree() );
+
+        BOOST_CHECK( zone->BuildFillRTree() == zone->GetFillRTree() );
+
+        zone->UnFill();
+        BOOST_CHECK( !zone->GetFillRTree() );
+    }
+}
+
+
+/**
+ * Refilling the zones only around a moved via must give the fills a refill from scratch gives.
+ */
+BOOST_FIXTURE_TEST_CASE( PartialRefill, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    PCB_TRACK* via = nullptr;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() == PCB_VIA_T )
+        {
+            via = track;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( via );
+
+    BOX2I dirty = via->GetBoundingBox();
+    via->Move( VECTOR2I( pcbIUScale.mmToIU( 0.5 ), pcbIUScale.mmToIU( 0.5 ) ) );
+    dirty.Merge( via->GetBoundingBox() );
+
+    auto refill =
+            [&]( bool aPartial )
+            {
+                TOOL_MANAGER toolMgr;
+                toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+                KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+                toolMgr.RegisterTool( dummyTool );
+
+                BOARD_COMMIT           commit( dummyTool );
+                ZONE_FILLER            filler( m_board.get(), &commit );
+                std::vector<ZONE*>     toFill;
+                std::map<ZONE*, BOX2I> dirtyAreas;
+
+                for( ZONE* zone : m_board->Zones() )
+                {
+                    toFill.push_back( zone );
+
+                    if( aPartial && zone->GetBoundingBox().Intersects( dirty ) )
+                        dirtyAreas[ zone ] = dirty;
+                }
+
+                filler.SetDirtyAreas( dirtyAreas );
+
+                BOOST_REQUIRE( filler.Fill( toFill ) );
+
+                std::map<std::pair<KIID, PCB_LAYER_ID>, double> areas;
+
+                for( ZONE* zone : m_board->Zones() )
+                {
+                    for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                        areas[ { zone->m_Uuid, layer } ] = zone->GetFilledPolysList( layer )->Area();
+                }
+
+                return areas;
+            };
+
+    std::map<std::pair<KIID, PCB_LAYER_ID>, double> partial = refill( true );
+    std::map<std::pair<KIID, PCB_LAYER_ID>, double> full = refill( false );
+
+    BOOST_REQUIRE_EQUAL( partial.size(), full.size() );
+
+    for( const auto& [key, area] : full )
+        BOOST_CHECK_CLOSE( partial[key], area, 0.01 );
+}
+
+
+/**
+ * Fills keep the hash of their inputs through a save and load, and only the zones around an
+ * edit go stale.
+ */
+BOOST_FIXTURE_TEST_CASE( FillInputHash, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    {
+        ZONE_FILL_HASHER hasher( m_board.get() );
+
+        for( ZONE* zone : m_board->Zones() )
+        {
+            if( !zone->GetIsRuleArea() )
+                BOOST_CHECK( hasher.IsUpToDate( zone ) );
+        }
+    }
+
+    PCB_IO_KICAD_SEXPR io;
+    STRING_FORMATTER   formatter;
+
+    io.SetOutputFormatter( &formatter );
+    io.Format( m_board.get() );
+
+    std::unique_ptr<BOARD_ITEM> reloaded( io.Parse( formatter.GetString() ) );
+    BOARD*                      reloadedBoard = dynamic_cast<BOARD*>( reloaded.get() );
+
+    BOOST_REQUIRE( reloadedBoard );
+    BOOST_REQUIRE_EQUAL( reloadedBoard->Zones().size(), m_board->Zones().size() );
+
+    for( size_t ii = 0; ii < m_board->Zones().size(); ++ii )
+    {
+        ZONE* zone = m_board->Zones()[ii];
+        ZONE* reloadedZone = reloadedBoard->Zones()[ii];
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            BOOST_CHECK_EQUAL( reloadedZone->GetFillInputHash( layer ),
+                               zone->GetFillInputHash( layer ) );
+        }
+    }
+
+    PCB_TRACK* via = nullptr;
+
+    for( PCB_TRACK* track : m_board->Tracks() )
+    {
+        if( track->Type() == PCB_VIA_T )
+        {
+            via = track;
+            break;
+        }
+    }
+
+    BOOST_REQUIRE( via );
+
+    via->Move( VECTOR2I( pcbIUScale.mmToIU( 0.5 ), pcbIUScale.mmToIU( 0.5 ) ) );
+
+    ZONE_FILL_HASHER hasher( m_board.get() );
+    int              stale = 0;
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( zone->GetIsRuleArea() )
+            continue;
+
+        BOX2I envelope = zone->GetBoundingBox();
+        envelope.Inflate( m_board->GetMaxClearanceValue() );
+
+        if( !hasher.IsUpToDate( zone ) )
+            stale++;
+        else
+            BOOST_CHECK( !envelope.Intersects( via->GetBoundingBox() ) );
+    }
+
+    BOOST_CHECK( stale > 0 );
+
+    // A refill which skips the current fills brings the stale ones up to date
+    TOOL_MANAGER toolMgr;
+    toolMgr.SetEnvironment( m_board.get(), nullptr, nullptr, nullptr, nullptr );
+
+    KI_TEST::DUMMY_TOOL* dummyTool = new KI_TEST::DUMMY_TOOL();
+    toolMgr.RegisterTool( dummyTool );
+
+    BOARD_COMMIT       commit( dummyTool );
+    ZONE_FILLER        filler( m_board.get(), &commit );
+    std::vector<ZONE*> toFill = m_board->Zones();
+
+    filler.SetSkipUpToDate( true );
+    filler.Fill( toFill );
+
+    ZONE_FILL_HASHER refilled( m_board.get() );
+
+    for( ZONE* zone : m_board->Zones() )
+    {
+        if( !zone->GetIsRuleArea() )
+            BOOST_CHECK( refilled.IsUpToDate( zone ) );
+    }
+}
+
+
+/**
+ * Lazily loaded fills are left unparsed until first accessed, and then match the eager ones.
+ */
+BOOST_FIXTURE_TEST_CASE( LazyZoneFills, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    PCB_IO_KICAD_SEXPR io;
+    STRING_FORMATTER   formatter;
+
+    io.SetOutputFormatter( &formatter );
+    io.Format( m_board.get() );
+
+    STRING_UTF8_MAP    props;
+    STRING_LINE_READER reader( formatter.GetString(), wxS( "lazy" ) );
+
+    props[PROP_LAZY_ZONE_FILLS] = "";
+
+    std::unique_ptr<BOARD> lazyBoard( io.DoLoad( reader, nullptr, &props, nullptr, 0 ) );
+
+    BOOST_REQUIRE( lazyBoard );
+    BOOST_REQUIRE_EQUAL( lazyBoard->Zones().size(), m_board->Zones().size() );
+
+    int lazyZones = 0;
+
+    for( size_t ii = 0; ii < m_board->Zones().size(); ++ii )
+    {
+        ZONE* zone = m_board->Zones()[ii];
+        ZONE* lazyZone = lazyBoard->Zones()[ii];
+
+        if( lazyZone->HasLazyFill() )
+            lazyZones++;
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            BOOST_REQUIRE( lazyZone->HasFilledPolysForLayer( layer ) );
+            BOOST_CHECK( !lazyZone->HasLazyFill() );
+
+            const SHAPE_POLY_SET* fill = zone->GetFilledPolysList( layer ).get();
+            const SHAPE_POLY_SET* lazyFill = lazyZone->GetFilledPolysList( layer ).get();
+
+            BOOST_CHECK_EQUAL( lazyFill->OutlineCount(), fill->OutlineCount() );
+            BOOST_CHECK_EQUAL( lazyFill->FullPointCount(), fill->FullPointCount() );
+
+            for( int jj = 0; jj < fill->OutlineCount(); ++jj )
+                BOOST_CHECK_EQUAL( lazyZone->IsIsland( layer, jj ), zone->IsIsland( layer, jj ) );
+        }
+
+        BOOST_CHECK_CLOSE( lazyZone->GetFilledArea(), zone->CalculateFilledArea(), 1e-6 );
+    }
+
+    BOOST_CHECK( lazyZones > 0 );
+}
+
+
+/**
+ * Fills read back from a board cache match the ones it was written from, and the cache is
+ * only read for the board contents it was written for.
+ */
+BOOST_FIXTURE_TEST_CASE( BoardCacheZoneFills, ZONE_FILL_TEST_FIXTURE )
+{
+    KI_TEST::LoadBoard( m_settingsManager, "zone_filler", m_board );
+
+    KI_TEST::FillZones( m_board.get() );
+
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE         cache;
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE::SOURCE source;
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE::SOURCE otherSource;
+    wxString                               cachePath = wxFileName::CreateTempFileName( "cache" );
+
+    source.m_size = 1234;
+    source.m_modified = 5678;
+    source.m_hash = 0xABCD;
+    otherSource = source;
+    otherSource.m_hash++;
+
+    BOOST_REQUIRE( cache.Collect( m_board.get() ) );
+    BOOST_REQUIRE( cache.Save( cachePath, source ) );
+
+    PCB_IO_KICAD_SEXPR_BOARD_CACHE readCache;
+
+    BOOST_CHECK( !readCache.Load( cachePath, otherSource ) );
+    BOOST_REQUIRE( readCache.Load( cachePath, source ) );
+
+    wxRemoveFile( cachePath );
+
+    PCB_IO_KICAD_SEXPR io;
+    STRING_FORMATTER   formatter;
+
+    io.SetOutputFormatter( &formatter );
+    io.Format( m_board.get() );
+
+    STRING_LINE_READER     reader( formatter.GetString(), wxS( "cached" ) );
+    std::unique_ptr<BOARD> cachedBoard( io.DoLoad( reader, nullptr, nullptr, nullptr, 0, true ) );
+
+    BOOST_REQUIRE( cachedBoard );
+    BOOST_REQUIRE_EQUAL( cachedBoard->Zones().size(), m_board->Zones().size() );
+
+    for( ZONE* zone : cachedBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            BOOST_CHECK( zone->GetFilledPolysList( layer )->IsEmpty() );
+    }
+
+    BOOST_REQUIRE( readCache.Apply( cachedBoard.get() ) );
+
+    for( size_t ii = 0; ii < m_board->Zones().size(); ++ii )
+    {
+        ZONE* zone = m_board->Zones()[ii];
+        ZONE* cachedZone = cachedBoard->Zones()[ii];
+
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            const SHAPE_POLY_SET* fill = zone->GetFilledPolysList( layer ).get();
+            const SHAPE_POLY_SET* cachedFill = cachedZone->GetFilledPolysList( layer ).get();
+
+            BOOST_CHECK_EQUAL( cachedFill->OutlineCount(), fill->OutlineCount() );
+            BOOST_CHECK_EQUAL( cachedFill->FullPointCount(), fill->FullPointCount() );
+
+            for( int jj = 0; jj < fill->OutlineCount(); ++jj )
+                BOOST_CHECK_EQUAL( cachedZone->IsIsland( layer, jj ), zone->IsIsland( layer, jj ) );
+        }
+
+        BOOST_CHECK_CLOSE( cachedZone->GetFilledArea(), zone->CalculateFilledArea(), 1e-6 );
+    }
+}
+
+
 BOOST_FIXTURE_TEST_CASE( RegressionZoneFillTests, ZONE_FILL_TEST_FIXTURE )
 {
     std::vector<wxString> tests = { "issue18",
@@ -0,0 +1,70 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <zone.h>
+
+
+BOOST_AUTO_TEST_SUITE( ZoneHitTest )
+
+
+static void addSquare( ZONE& aZone, const VECTOR2I& aCorner, int aSize )
+{
+    SHAPE_POLY_SET* outline = aZone.Outline();
+
+    outline->NewOutline();
+    outline->Append( aCorner.x, aCorner.y );
+    outline->Append( aCorner.x + aSize, aCorner.y );
+    outline->Append( aCorner.x + aSize, aCorner.y + aSize );
+    outline->Append( aCorner.x, aCorner.y + aSize );
+}
+
+
+BOOST_AUTO_TEST_CASE( RectCrossingOutlines )
+{
+    BOARD board;
+    ZONE  zone( &board );
+
+    addSquare( zone, VECTOR2I( 0, 0 ), 1000 );
+    addSquare( zone, VECTOR2I( 5000, 5000 ), 1000 );
+
+    // Crossing an edge of either outline
+    BOOST_CHECK( zone.HitTest( BOX2I( VECTOR2I( -100, 400 ), VECTOR2I( 200, 200 ) ), false ) );
+    BOOST_CHECK( zone.HitTest( BOX2I( VECTOR2I( 5900, 5900 ), VECTOR2I( 200, 200 ) ), false ) );
+
+    // Between the outlines: there is no edge from one outline to the other
+    BOOST_CHECK( !zone.HitTest( BOX2I( VECTOR2I( 2500, 2900 ), VECTOR2I( 200, 300 ) ), false ) );
+
+    // Inside an outline, away from its edges
+    BOOST_CHECK( !zone.HitTest( BOX2I( VECTOR2I( 400, 400 ), VECTOR2I( 200, 200 ) ), false ) );
+
+    // Enclosing the whole zone
+    BOX2I all( VECTOR2I( -100, -100 ), VECTOR2I( 7000, 7000 ) );
+
+    BOOST_CHECK( zone.HitTest( all, true ) );
+    BOOST_CHECK( !zone.HitTest( BOX2I( VECTOR2I( -100, -100 ), VECTOR2I( 2000, 2000 ) ), true ) );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+#include <board.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_poly_set.h>
+#include <zone_knockout_cache.h>
+
+
+BOOST_AUTO_TEST_SUITE( ZoneKnockoutCache )
+
+
+static ZONE_KNOCKOUT_KEY viaKey( const VECTOR2I& aPos, int aClearance )
+{
+    return { ZONE_KNOCKOUT_KEY::KIND::CIRCLE, aPos, VECTOR2I(), aPos, 600000, aClearance,
+             ARC_HIGH_DEF, ERROR_OUTSIDE };
+}
+
+
+BOOST_AUTO_TEST_CASE( BuildsOncePerKey )
+{
+    ZONE_KNOCKOUT_CACHE cache;
+    int                 builds = 0;
+
+    auto builder =
+            [&]( SHAPE_POLY_SET& aKnockout )
+            {
+                builds++;
+                TransformCircleToPolygon( aKnockout, VECTOR2I(), 500000, ARC_HIGH_DEF,
+                                          ERROR_OUTSIDE );
+            };
+
+    std::shared_ptr<const SHAPE_POLY_SET> first = cache.Get( viaKey( VECTOR2I(), 200000 ),
+                                                             builder );
+    std::shared_ptr<const SHAPE_POLY_SET> second = cache.Get( viaKey( VECTOR2I(), 200000 ),
+                                                              builder );
+
+    BOOST_CHECK_EQUAL( builds, 1 );
+    BOOST_CHECK( first == second );
+    BOOST_CHECK_EQUAL( first->OutlineCount(), 1 );
+
+    // Any change to the geometry is a different knockout
+    cache.Get( viaKey( VECTOR2I(), 250000 ), builder );
+    cache.Get( viaKey( VECTOR2I( 1000, 0 ), 200000 ), builder );
+
+    BOOST_CHECK_EQUAL( builds, 3 );
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 3 );
+}
+
+
+BOOST_AUTO_TEST_CASE( RemovesUnused )
+{
+    ZONE_KNOCKOUT_CACHE cache;
+
+    auto builder =
+            []( SHAPE_POLY_SET& aKnockout )
+            {
+                TransformCircleToPolygon( aKnockout, VECTOR2I(), 500000, ARC_HIGH_DEF,
+                                          ERROR_OUTSIDE );
+            };
+
+    cache.Get( viaKey( VECTOR2I(), 200000 ), builder );
+    cache.Get( viaKey( VECTOR2I( 1000, 0 ), 200000 ), builder );
+
+    // Only the first knockout is asked for by the following fills
+    for( int fill = 0; fill < 20; ++fill )
+    {
+        cache.Get( viaKey( VECTOR2I(), 200000 ), builder );
+        cache.RemoveUnused();
+    }
+
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 1 );
+
+    cache.Clear();
+    BOOST_CHECK_EQUAL( cache.GetEntryCount(), 0 );
+}
+
+
+BOOST_AUTO_TEST_CASE( SurvivesBoardEdits )
+{
+    BOARD board;
+
+    board.m_ZoneKnockoutCache.Get( viaKey( VECTOR2I(), 200000 ),
+                                   []( SHAPE_POLY_SET& aKnockout )
+                                   {
+                                       TransformCircleToPolygon( aKnockout, VECTOR2I(), 500000,
+                                                                 ARC_HIGH_DEF, ERROR_OUTSIDE );
+                                   } );
+
+    // Keys hold all the geometry, so edits don't make entries stale
+    board.IncrementTimeStamp();
+    BOOST_CHECK_EQUAL( board.m_ZoneKnockoutCache.GetEntryCount(), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
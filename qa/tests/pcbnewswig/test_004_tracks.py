@@ -41,3 +41,32 @@ class TestTracks:
 
         dup_via = via.Duplicate()
         assert dup_via.m_Uuid != via.m_Uuid
+
+    def test_track_columns(self):
+        columns = self.pcb.GetTrackColumns()
+        tracks = list(self.pcb.Tracks())
+        assert len(tracks) == len(columns['width'])
+        assert 16 == list(columns['type']).count(pcbnew.PCB_TRACE_T)
+        assert 13 == list(columns['type']).count(pcbnew.PCB_ARC_T)
+        assert 2 == list(columns['type']).count(pcbnew.PCB_VIA_T)
+
+        for ii, track in enumerate(tracks):
+            assert track.GetStart()[0] == columns['start_x'][ii]
+            assert track.GetEnd()[1] == columns['end_y'][ii]
+            assert track.GetWidth() == columns['width'][ii]
+            assert track.GetNetCode() == columns['net'][ii]
+
+    def test_set_track_columns(self):
+        columns = self.pcb.GetTrackColumns()
+        widths = [w + 1000 for w in columns['width']]
+        assert len(widths) == self.pcb.SetTrackColumns({'width': widths})
+        assert widths == [t.GetWidth() for t in self.pcb.Tracks()]
+
+        # Unchanged columns don't modify anything
+        assert 0 == self.pcb.SetTrackColumns(self.pcb.GetTrackColumns())
+
+        with pytest.raises(ValueError):
+            self.pcb.SetTrackColumns({'width': widths[1:]})
+
+        with pytest.raises(ValueError):
+            self.pcb.SetTrackColumns({'net': [-5] * len(widths)})
@@ -1552,4 +1552,43 @@ BOOST_AUTO_TEST_CASE( Fets )
 }
 
 
+BOOST_AUTO_TEST_CASE( LazyModels )
+{
+    LOCALE_IO     toggle;
+    NULL_REPORTER devnull;
+
+    for( const std::string& baseName : { "subckts", "diodes", "bjts", "fets" } )
+    {
+        BOOST_TEST_CONTEXT( "Library: " << baseName )
+        {
+            LoadLibrary( baseName );
+
+            SIM_LIBRARY_SPICE lazyLibrary( false );
+            lazyLibrary.ReadFile( GetLibraryPath( baseName ), devnull );
+
+            // Models are looked up case insensitively, and parsed on the first lookup
+            for( const auto& [modelName, model] : m_library->GetModels() )
+            {
+                SIM_MODEL* lazyModel = lazyLibrary.FindModel( boost::to_lower_copy( modelName ) );
+
+                BOOST_REQUIRE( lazyModel );
+                BOOST_CHECK( lazyModel->GetType() == model.GetType() );
+                BOOST_CHECK_EQUAL( lazyModel->GetParamCount(), model.GetParamCount() );
+
+                for( int i = 0; i < model.GetParamCount(); ++i )
+                {
+                    BOOST_CHECK_EQUAL( lazyModel->GetParamOverride( i ).value,
+                                       model.GetParamOverride( i ).value );
+                }
+
+                BOOST_CHECK_EQUAL( lazyLibrary.FindModel( modelName ), lazyModel );
+            }
+
+            BOOST_CHECK_EQUAL( lazyLibrary.GetModels().size(), m_library->GetModels().size() );
+            BOOST_CHECK( !lazyLibrary.FindModel( "no_such_model" ) );
+        }
+    }
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
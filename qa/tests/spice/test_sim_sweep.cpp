@@ -0,0 +1,157 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <qa_utils/wx_utils/unit_test_utils.h>
+
+#include <cstring>
+
+#include <sim/sim_sweep.h>
+
+
+BOOST_AUTO_TEST_SUITE( SimSweep )
+
+
+BOOST_AUTO_TEST_CASE( StepDirectives )
+{
+    wxString                     command = wxS( ".tran 1u 1m\n"
+                                                ".step param rload 1k 3k 1k\n"
+                                                ".step param cload list 10n 22n" );
+    std::vector<SIM_SWEEP_POINT> points;
+    wxString                     error;
+
+    BOOST_REQUIRE( SIM_SWEEP_RUNNER::ParseStepDirectives( command, points, error ) );
+
+    BOOST_CHECK_EQUAL( command, wxS( ".tran 1u 1m" ) );
+    BOOST_REQUIRE_EQUAL( points.size(), 6 );
+
+    // The first directive is the outer loop
+    BOOST_CHECK_EQUAL( points[0].GetLabel(), wxS( "rload=1k cload=10n" ) );
+    BOOST_CHECK_EQUAL( points[1].GetLabel(), wxS( "rload=1k cload=22n" ) );
+    BOOST_CHECK_EQUAL( points[5].GetLabel(), wxS( "rload=3k cload=22n" ) );
+
+    command = wxS( ".ac dec 10 1 1Meg" );
+    BOOST_CHECK( SIM_SWEEP_RUNNER::ParseStepDirectives( command, points, error ) );
+    BOOST_CHECK( points.empty() );
+
+    for( const wxString& invalid : { wxS( ".tran 1u 1m\n.step V1 1 5 1" ),
+                                     wxS( ".tran 1u 1m\n.step param r 1k 3k" ),
+                                     wxS( ".tran 1u 1m\n.step param r 3k 1k 1k" ),
+                                     wxS( ".tran 1u 1m\n.step param r list" ) } )
+    {
+        command = invalid;
+        BOOST_CHECK( !SIM_SWEEP_RUNNER::ParseStepDirectives( command, points, error ) );
+        BOOST_CHECK( !error.IsEmpty() );
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( ApplyPoint )
+{
+    SIM_SWEEP_POINT point;
+
+    point.m_params = { { wxS( "rload" ), wxS( "2k" ) }, { wxS( "cload" ), wxS( "22n" ) } };
+
+    std::string netlist = SIM_SWEEP_RUNNER::ApplyPoint( "Test\n"
+                                                        ".param vin=5 RLOAD = 1k\n"
+                                                        "R1 out 0 {rload}\n"
+                                                        ".end\n",
+                                                        point, 3 );
+
+    BOOST_CHECK_EQUAL( netlist, "Test\n"
+                                ".param vin=5 RLOAD=2k\n"
+                                "R1 out 0 {rload}\n"
+                                ".param cload=22n\n"
+                                ".options seed=3\n"
+                                ".end\n" );
+}
+
+
+BOOST_AUTO_TEST_CASE( RawFile )
+{
+    std::string ascii = "Title: test\n"
+                        "Plotname: Operating Point\n"
+                        "Flags: real\n"
+                        "No. Variables: 1\n"
+                        "No. Points: 1\n"
+                        "Variables:\n"
+                        "\t0\tv(out)\tvoltage\n"
+                        "Values:\n"
+                        " 0\t1.0\n"
+                        "\n"
+                        "Title: test\n"
+                        "Plotname: AC Analysis\n"
+                        "Flags: complex\n"
+                        "No. Variables: 2\n"
+                        "No. Points: 2\n"
+                        "Variables:\n"
+                        "\t0\tfrequency\tfrequency\n"
+                        "\t1\tv(out)\tvoltage\n"
+                        "Values:\n"
+                        " 0\t1.0e+00,0.0e+00\n"
+                        "\t5.0e-01,-5.0e-01\n"
+                        " 1\t1.0e+01,0.0e+00\n"
+                        "\t2.5e-01,-1.0e-01\n";
+
+    SIM_RAW_PLOT plot;
+
+    BOOST_REQUIRE( SIM_SWEEP_RUNNER::ParseRawFile( ascii, plot ) );
+
+    // The last analysis is kept
+    BOOST_CHECK_EQUAL( plot.m_plotName, wxS( "AC Analysis" ) );
+    BOOST_CHECK( plot.m_complex );
+    BOOST_REQUIRE_EQUAL( plot.m_real.size(), 2 );
+    BOOST_REQUIRE_EQUAL( plot.m_real[1].size(), 2 );
+    BOOST_CHECK_EQUAL( plot.m_real[0][1], 10.0 );
+    BOOST_CHECK_EQUAL( plot.m_real[1][1], 0.25 );
+    BOOST_CHECK_EQUAL( plot.m_imag[1][0], -0.5 );
+
+    BOOST_CHECK_EQUAL( plot.FindVector( wxS( "V(OUT)" ) ), 1 );
+    BOOST_CHECK_EQUAL( plot.FindVector( wxS( "out" ) ), 1 );
+    BOOST_CHECK_EQUAL( plot.FindVector( wxS( "in" ) ), -1 );
+
+    std::string binary = "Title: test\n"
+                         "Plotname: Transient Analysis\n"
+                         "Flags: real\n"
+                         "No. Variables: 2\n"
+                         "No. Points: 3\n"
+                         "Variables:\n"
+                         "\t0\ttime\ttime\n"
+                         "\t1\tv1#branch\tcurrent\n"
+                         "Binary:\n";
+
+    // An interrupted run: the last point is missing
+    for( double value : { 0.0, 1.0, 1e-3, 2.0 } )
+    {
+        char bytes[sizeof( double )];
+        memcpy( bytes, &value, sizeof( double ) );
+        binary.append( bytes, sizeof( double ) );
+    }
+
+    BOOST_REQUIRE( SIM_SWEEP_RUNNER::ParseRawFile( binary, plot ) );
+
+    BOOST_CHECK( !plot.m_complex );
+    BOOST_REQUIRE_EQUAL( plot.m_real.size(), 2 );
+    BOOST_REQUIRE_EQUAL( plot.m_real[0].size(), 2 );
+    BOOST_CHECK_EQUAL( plot.m_real[0][1], 1e-3 );
+    BOOST_CHECK_EQUAL( plot.m_real[1][1], 2.0 );
+    BOOST_CHECK_EQUAL( plot.FindVector( wxS( "I(V1)" ) ), 1 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
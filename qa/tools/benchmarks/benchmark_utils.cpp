@@ -0,0 +1,165 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include "benchmark_utils.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <new>
+
+#include <nlohmann/json.hpp>
+
+#if defined( _WIN32 )
+#define WIN32_LEAN_AND_MEAN 1
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+
+// Count every allocation made by the process.  This is only linked into the benchmark binary.
+static std::atomic<int64_t> s_allocations( 0 );
+static std::atomic<int64_t> s_allocatedBytes( 0 );
+
+
+void* operator new( std::size_t aSize )
+{
+    s_allocations.fetch_add( 1, std::memory_order_relaxed );
+    s_allocatedBytes.fetch_add( static_cast<int64_t>( aSize ), std::memory_order_relaxed );
+
+    if( void* ptr = std::malloc( aSize ? aSize : 1 ) )
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+
+void* operator new[]( std::size_t aSize )
+{
+    return operator new( aSize );
+}
+
+
+void operator delete( void* aPtr ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete[]( void* aPtr ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete( void* aPtr, std::size_t ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+void operator delete[]( void* aPtr, std::size_t ) noexcept
+{
+    std::free( aPtr );
+}
+
+
+static int64_t peakRssKb()
+{
+#if defined( _WIN32 )
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if( GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof( counters ) ) )
+        return static_cast<int64_t>( counters.PeakWorkingSetSize / 1024 );
+
+    return 0;
+#else
+    struct rusage usage;
+
+    if( getrusage( RUSAGE_SELF, &usage ) != 0 )
+        return 0;
+
+#if defined( __APPLE__ )
+    return static_cast<int64_t>( usage.ru_maxrss / 1024 );    // bytes on macOS
+#else
+    return static_cast<int64_t>( usage.ru_maxrss );           // kilobytes elsewhere
+#endif
+#endif
+}
+
+
+KI_BENCH::SAMPLE KI_BENCH::Measure( const std::string& aCorpus, const std::string& aStage,
+                                    const std::function<bool()>& aFunc )
+{
+    SAMPLE sample;
+    sample.m_corpus = aCorpus;
+    sample.m_stage = aStage;
+
+    int64_t allocsBefore = s_allocations.load();
+    int64_t bytesBefore  = s_allocatedBytes.load();
+    std::clock_t cpuBefore = std::clock();
+    auto wallBefore = std::chrono::steady_clock::now();
+
+    try
+    {
+        sample.m_ok = aFunc();
+    }
+    catch( ... )
+    {
+        sample.m_ok = false;
+    }
+
+    auto wallAfter = std::chrono::steady_clock::now();
+    std::clock_t cpuAfter = std::clock();
+
+    sample.m_wallMs = std::chrono::duration<double, std::milli>( wallAfter - wallBefore ).count();
+    sample.m_cpuMs = 1000.0 * static_cast<double>( cpuAfter - cpuBefore ) / CLOCKS_PER_SEC;
+    sample.m_peakRssKb = peakRssKb();
+    sample.m_allocations = s_allocations.load() - allocsBefore;
+    sample.m_allocatedBytes = s_allocatedBytes.load() - bytesBefore;
+
+    return sample;
+}
+
+
+void KI_BENCH::ToJson( nlohmann::json& aJson, const std::vector<SAMPLE>& aSamples )
+{
+    nlohmann::json samples = nlohmann::json::array();
+
+    for( const SAMPLE& sample : aSamples )
+    {
+        samples.push_back( { { "corpus", sample.m_corpus },
+                             { "stage", sample.m_stage },
+                             { "wall_ms", sample.m_wallMs },
+                             { "cpu_ms", sample.m_cpuMs },
+                             { "peak_rss_kb", sample.m_peakRssKb },
+                             { "allocations", sample.m_allocations },
+                             { "allocated_bytes", sample.m_allocatedBytes },
+                             { "ok", sample.m_ok } } );
+    }
+
+    aJson["samples"] = samples;
+}
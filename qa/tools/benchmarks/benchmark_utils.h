@@ -0,0 +1,74 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef QA_BENCHMARK_UTILS_H
+#define QA_BENCHMARK_UTILS_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json_fwd.hpp>
+
+
+namespace KI_BENCH
+{
+
+/**
+ * The cost of one run of one pipeline stage.
+ */
+struct SAMPLE
+{
+    std::string m_corpus;          ///< Name of the input (e.g. "small")
+    std::string m_stage;           ///< Name of the stage (e.g. "zone_fill")
+    double      m_wallMs = 0.0;
+    double      m_cpuMs = 0.0;     ///< Process CPU time, summed over all threads
+    int64_t     m_peakRssKb = 0;   ///< Process peak resident set size after the stage
+    int64_t     m_allocations = 0; ///< Number of operator new calls during the stage
+    int64_t     m_allocatedBytes = 0;
+    bool        m_ok = true;
+};
+
+
+/**
+ * Run \a aStage once and measure it.
+ *
+ * @param aStage returns false if the stage failed.
+ */
+SAMPLE Measure( const std::string& aCorpus, const std::string& aStage,
+                const std::function<bool()>& aFunc );
+
+
+/**
+ * Serialise a set of samples as a JSON document:
+ *
+ * { "samples": [ { "corpus":..., "stage":..., "wall_ms":..., "cpu_ms":...,
+ *                  "peak_rss_kb":..., "allocations":..., "allocated_bytes":...,
+ *                  "ok":... }, ... ] }
+ */
+void ToJson( nlohmann::json& aJson, const std::vector<SAMPLE>& aSamples );
+
+} // namespace KI_BENCH
+
+#endif // QA_BENCHMARK_UTILS_H
@@ -0,0 +1,295 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file pcb_benchmarks.cpp
+ * Time the heavy board pipelines on a fixed corpus and report the results as JSON.
+ *
+ * Each board is loaded and then taken through save, connectivity, ratsnest, zone fill, DRC and
+ * Gerber plotting in that order.  Every stage is run --repeat times; later stages operate on
+ * the output of the earlier ones, as they would in the editor.
+ */
+
+#include <qa_utils/utility_registry.h>
+#include <pcbnew_utils/board_file_utils.h>
+#include <pcbnew_utils/board_test_utils.h>
+
+#include "benchmark_utils.h"
+
+#include <fstream>
+#include <iostream>
+
+#include <nlohmann/json.hpp>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/msgout.h>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <connectivity/connectivity_data.h>
+#include <drc/drc_engine.h>
+#include <drc/drc_item.h>
+#include <pcb_plot_params.h>
+#include <pcbplot.h>
+#include <plotters/plotter.h>
+#include <settings/settings_manager.h>
+
+
+/**
+ * The default corpus, taken from the pcbnew QA data.
+ */
+static const std::vector<std::pair<std::string, std::string>> c_defaultCorpus = {
+    { "small",  "complex_hierarchy" },
+    { "medium", "issue11814" },
+    { "huge",   "issue8909" },
+};
+
+
+static std::unique_ptr<BOARD> loadBoard( SETTINGS_MANAGER& aSettingsManager,
+                                         const std::string& aBoardPath )
+{
+    wxFileName projectFile( aBoardPath );
+    projectFile.SetExt( wxT( "kicad_pro" ) );
+
+    if( projectFile.Exists() )
+        aSettingsManager.LoadProject( projectFile.GetFullPath() );
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( aBoardPath );
+
+    if( board && projectFile.Exists() )
+        board->SetProject( &aSettingsManager.Prj() );
+
+    return board;
+}
+
+
+static bool runDrc( BOARD* aBoard, const std::string& aBoardPath )
+{
+    BOARD_DESIGN_SETTINGS& bds = aBoard->GetDesignSettings();
+    wxFileName             rulesFile( aBoardPath );
+    rulesFile.SetExt( wxT( "kicad_dru" ) );
+
+    auto drcEngine = std::make_shared<DRC_ENGINE>( aBoard, &bds );
+
+    drcEngine->InitEngine( rulesFile.Exists() ? rulesFile : wxFileName() );
+    drcEngine->SetViolationHandler(
+            []( const std::shared_ptr<DRC_ITEM>& aItem, VECTOR2I aPos, int aLayer )
+            {
+            } );
+
+    bds.m_DRCEngine = drcEngine;
+    drcEngine->RunTests( EDA_UNITS::MILLIMETRES, true, false );
+
+    return true;
+}
+
+
+static bool plotGerbers( BOARD* aBoard, const wxString& aOutputDir )
+{
+    PCB_PLOT_PARAMS plotOpts;
+    plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+    plotOpts.SetOutputDirectory( aOutputDir );
+
+    for( PCB_LAYER_ID layer : aBoard->GetEnabledLayers().CuStack() )
+    {
+        wxFileName fn( aOutputDir, aBoard->GetLayerName( layer ), wxT( "gbr" ) );
+        PLOTTER*   plotter = StartPlotBoard( aBoard, &plotOpts, layer, fn.GetFullPath(),
+                                             wxEmptyString, wxEmptyString );
+
+        if( !plotter )
+            return false;
+
+        PlotBoardLayers( aBoard, plotter, { layer }, plotOpts );
+        plotter->EndPlot();
+        delete plotter;
+    }
+
+    return true;
+}
+
+
+static void benchmarkBoard( const std::string& aName, const std::string& aBoardPath,
+                            int aRepeat, std::vector<KI_BENCH::SAMPLE>& aSamples )
+{
+    SETTINGS_MANAGER       settingsManager( true /* headless */ );
+    std::unique_ptr<BOARD> board;
+
+    wxFileName outputDir( wxFileName::GetTempDir(), wxEmptyString );
+    outputDir.AppendDir( wxT( "qa_benchmarks" ) );
+    outputDir.AppendDir( aName );
+    outputDir.Mkdir( wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL );
+
+    auto stage =
+            [&]( const std::string& aStage, const std::function<bool()>& aFunc )
+            {
+                for( int ii = 0; ii < aRepeat; ++ii )
+                    aSamples.push_back( KI_BENCH::Measure( aName, aStage, aFunc ) );
+            };
+
+    stage( "parse",
+           [&]()
+           {
+               if( board )
+                   board->SetProject( nullptr );
+
+               board = loadBoard( settingsManager, aBoardPath );
+               return board != nullptr;
+           } );
+
+    if( !board )
+        return;
+
+    stage( "save",
+           [&]()
+           {
+               wxFileName fn( outputDir.GetPath(), wxT( "saved" ), wxT( "kicad_pcb" ) );
+               KI_TEST::DumpBoardToFile( *board, fn.GetFullPath().ToStdString() );
+               return true;
+           } );
+
+    stage( "connectivity",
+           [&]()
+           {
+               board->BuildListOfNets();
+               return board->BuildConnectivity();
+           } );
+
+    stage( "ratsnest",
+           [&]()
+           {
+               board->GetConnectivity()->RecalculateRatsnest();
+               return true;
+           } );
+
+    stage( "zone_fill",
+           [&]()
+           {
+               KI_TEST::FillZones( board.get() );
+               return true;
+           } );
+
+    stage( "drc",
+           [&]()
+           {
+               return runDrc( board.get(), aBoardPath );
+           } );
+
+    stage( "gerber",
+           [&]()
+           {
+               return plotGerbers( board.get(), outputDir.GetPath() );
+           } );
+
+    board->SetProject( nullptr );
+}
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "o", "output", _( "write the JSON report to this file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_OPTION, "r", "repeat", _( "number of runs of each stage (default 1)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER, wxCMD_LINE_PARAM_OPTIONAL },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board files (default: the QA corpus)" ).mb_str(),
+            wxCMD_LINE_VAL_STRING, wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+int pcb_pipelines_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "Time parse, save, connectivity, ratsnest, zone fill, DRC and "
+                               "Gerber plotting for the given boards (or the QA corpus) and "
+                               "print the wall time, CPU time, peak RSS and allocation count "
+                               "of each stage as JSON." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long repeat = 1;
+    cl_parser.Found( "repeat", &repeat );
+    repeat = std::max( repeat, 1L );
+
+    std::vector<std::pair<std::string, std::string>> boards;
+
+    if( cl_parser.GetParamCount() == 0 )
+    {
+        for( const auto& [name, relPath] : c_defaultCorpus )
+            boards.emplace_back( name, KI_TEST::GetPcbnewTestDataDir() + relPath + ".kicad_pcb" );
+    }
+    else
+    {
+        for( size_t ii = 0; ii < cl_parser.GetParamCount(); ++ii )
+        {
+            wxFileName fn( cl_parser.GetParam( ii ) );
+            boards.emplace_back( fn.GetName().ToStdString(), fn.GetFullPath().ToStdString() );
+        }
+    }
+
+    std::vector<KI_BENCH::SAMPLE> samples;
+
+    for( const auto& [name, path] : boards )
+        benchmarkBoard( name, path, static_cast<int>( repeat ), samples );
+
+    nlohmann::json report;
+    KI_BENCH::ToJson( report, samples );
+
+    wxString outputFile;
+
+    if( cl_parser.Found( "output", &outputFile ) )
+    {
+        std::ofstream out( outputFile.ToStdString() );
+
+        if( !out )
+            return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+        out << report.dump( 2 ) << std::endl;
+    }
+    else
+    {
+        std::cout << report.dump( 2 ) << std::endl;
+    }
+
+    for( const KI_BENCH::SAMPLE& sample : samples )
+    {
+        if( !sample.m_ok )
+            return KI_TEST::RET_CODES::TOOL_SPECIFIC;
+    }
+
+    return samples.empty() ? KI_TEST::RET_CODES::TOOL_SPECIFIC : KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( { "pcb_pipelines",
+                                                       "Benchmark the board pipelines",
+                                                       pcb_pipelines_main_func } );
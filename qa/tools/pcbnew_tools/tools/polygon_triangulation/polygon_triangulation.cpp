@@ -32,11 +32,12 @@
 #include <qa_utils/utility_registry.h>
 
 #include <board.h>
-#include <core/ignore.h>
 #include <zone.h>
 #include <core/profile.h>
 
 #include <atomic>
+#include <cmath>
+#include <cstdio>
 #include <thread>
 #include <unordered_set>
 #include <utility>
@@ -218,65 +219,98 @@ int polygon_triangulation_main( int argc, char *argv[] )
         return POLY_TRI_RET_CODES::LOAD_FAILED;
 
 
-    PROF_TIMER cnt( "allBoard" );
+    std::vector<SHAPE_POLY_SET> fills;
 
+    for( ZONE* zone : brd->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+            fills.push_back( *zone->GetFilledPolysList( layer ) );
+    }
 
-    std::atomic<size_t> zonesToTriangulate( 0 );
-    std::atomic<size_t> threadsFinished( 0 );
+    const std::pair<SHAPE_POLY_SET::TRIANGULATOR, const char*> triangulators[] = {
+        { SHAPE_POLY_SET::TRIANGULATOR::EAR_CLIPPING, "ear clipping" },
+        { SHAPE_POLY_SET::TRIANGULATOR::SWEEP_LINE, "sweep line" }
+    };
 
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    for( const auto& entry : triangulators )
     {
-        std::thread t = std::thread( [&brd, &zonesToTriangulate, &threadsFinished]() {
-            for( size_t areaId = zonesToTriangulate.fetch_add( 1 );
-                        areaId < static_cast<size_t>( brd->GetAreaCount() );
-                        areaId = zonesToTriangulate.fetch_add( 1 ) )
+        SHAPE_POLY_SET::TRIANGULATOR triangulator = entry.first;
+        const char*                  name = entry.second;
+        std::vector<SHAPE_POLY_SET>  polys( fills );
+        std::atomic<size_t>          zonesToTriangulate( 0 );
+        std::atomic<size_t>          threadsFinished( 0 );
+
+        PROF_TIMER cnt( name );
+
+        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        {
+            std::thread t = std::thread(
+                    [&]()
+                    {
+                        for( size_t polyId = zonesToTriangulate.fetch_add( 1 );
+                             polyId < polys.size();
+                             polyId = zonesToTriangulate.fetch_add( 1 ) )
+                        {
+                            polys[polyId].CacheTriangulation( true, false, triangulator );
+                        }
+
+                        threadsFinished++;
+                    } );
+
+            t.detach();
+        }
+
+        while( threadsFinished < parallelThreadCount )
+            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+
+        cnt.Stop();
+
+        // Triangle quality: count slivers, i.e. triangles with an angle below 5 degrees
+        size_t triangles = 0;
+        size_t slivers = 0;
+
+        for( const SHAPE_POLY_SET& poly : polys )
+        {
+            for( unsigned ii = 0; ii < poly.TriangulatedPolyCount(); ++ii )
             {
-                auto zone = brd->GetArea( areaId );
+                const SHAPE_POLY_SET::TRIANGULATED_POLYGON* tri = poly.TriangulatedPolygon( ii );
 
-                // NOTE: this could be refactored to do multiple layers from the same zone in
-                // parallel, but since the test case doesn't have any of these, I'm not bothering
-                // to do that right now.
-                for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                for( size_t jj = 0; jj < tri->GetTriangleCount(); ++jj )
                 {
-                    SHAPE_POLY_SET poly = *zone->GetFilledPolysList( layer );
+                    VECTOR2I pts[3];
+                    tri->GetTriangle( jj, pts[0], pts[1], pts[2] );
 
-                    poly.CacheTriangulation();
+                    double minAngle = 180.0;
 
-                    ignore_unused( poly );
-#if 0
-                PROF_TIMER unfrac("unfrac");
-                poly.Unfracture( SHAPE_POLY_SET::PM_FAST );
-                unfrac.Show();
+                    for( int kk = 0; kk < 3; ++kk )
+                    {
+                        VECTOR2D u = pts[( kk + 1 ) % 3] - pts[kk];
+                        VECTOR2D v = pts[( kk + 2 ) % 3] - pts[kk];
+                        double   angle = std::atan2( std::abs( u.Cross( v ) ), u.Dot( v ) );
 
-                PROF_TIMER triangulate("triangulate");
+                        minAngle = std::min( minAngle, angle * 180.0 / M_PI );
+                    }
 
-                for(int i =0; i< poly.OutlineCount(); i++)
-                {
-                    poly.triangulatePoly( &poly.Polygon(i) );
-                }
-                triangulate.Show();
-#endif
+                    triangles++;
+
+                    if( minAngle < 5.0 )
+                        slivers++;
                 }
             }
+        }
 
-            threadsFinished++;
-        } );
-
-        t.detach();
+        printf( "%-14s %10.1f ms %10zu triangles %10zu slivers\n", name, cnt.msecs(),
+                triangles, slivers );
     }
 
-    while( threadsFinished < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-
-    cnt.Show();
-
     return KI_TEST::RET_CODES::OK;
 }
 
 
 static bool registered = UTILITY_REGISTRY::Register( {
         "polygon_triangulation",
-        "Process polygon triangulation on a PCB",
+        "Compare the polygon triangulation backends on the zone fills of a PCB",
         polygon_triangulation_main,
 } );
@@ -0,0 +1,238 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2024 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/**
+ * Replay P&S logs as a benchmark of the router.
+ *
+ * Reports the latency percentiles of the replayed events for each kind of routing (shove,
+ * walkaround, drag, diff-pair, ...), along with the NODE branches and collision queries they
+ * took, as JSON.  Without arguments, the logs of the pns_regressions test data are replayed.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include <nlohmann/json.hpp>
+
+#include <wx/cmdline.h>
+#include <wx/textfile.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+#include <qa_utils/utility_program.h>
+#include <reporter.h>
+
+#include "pns_log_file.h"
+#include "pns_log_player.h"
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            "displays help on the command line parameters",
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "o",
+            "output",
+            "write the report to this file instead of the standard output",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "r",
+            "repeat",
+            "replay each log this many times (default 1)",
+            wxCMD_LINE_VAL_NUMBER,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    {
+            wxCMD_LINE_PARAM,
+            "logs",
+            "logs",
+            "log file names (no extensions), or directories holding a tests.lst",
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL | wxCMD_LINE_PARAM_MULTIPLE,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+
+/**
+ * Expand a directory with a tests.lst, as in the pns_regressions test data, to its logs.
+ */
+static void addLogs( const wxString& aPath, std::vector<wxString>& aLogs )
+{
+    wxFileName list( aPath, wxT( "tests.lst" ) );
+
+    if( !wxFileName::DirExists( aPath ) || !list.FileExists() )
+    {
+        aLogs.push_back( aPath );
+        return;
+    }
+
+    wxTextFile fp( list.GetFullPath() );
+
+    if( !fp.Open() )
+        return;
+
+    for( size_t i = 0; i < fp.GetLineCount(); i++ )
+    {
+        wxString line = fp.GetLine( i );
+        line.Trim().Trim( false );
+
+        if( !line.IsEmpty() )
+            aLogs.push_back( aPath + wxT( "/" ) + line + wxT( "/pns" ) );
+    }
+}
+
+
+static double percentile( const std::vector<double>& aSorted, double aFraction )
+{
+    if( aSorted.empty() )
+        return 0.0;
+
+    size_t idx = std::min( aSorted.size() - 1, (size_t) ( aFraction * aSorted.size() ) );
+    return aSorted[idx];
+}
+
+
+int main( int argc, char* argv[] )
+{
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( "P&S router benchmark. Replays P&S logs and reports the cost of "
+                            "their events as JSON." );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    long repeat = 1;
+    cl_parser.Found( "repeat", &repeat );
+
+    std::vector<wxString> logs;
+
+    for( size_t i = 0; i < cl_parser.GetParamCount(); i++ )
+        addLogs( cl_parser.GetParam( i ), logs );
+
+    if( cl_parser.GetParamCount() == 0 )
+        addLogs( KI_TEST::GetPcbnewTestDataDir() + std::string( "/pns_regressions" ), logs );
+
+    struct ALGO_STATS
+    {
+        std::vector<double> m_latencies;
+        unsigned long long  m_branches = 0;
+        unsigned long long  m_collisionQueries = 0;
+    };
+
+    std::map<wxString, ALGO_STATS> algos;
+    nlohmann::json                 logReports = nlohmann::json::array();
+    int                            failures = 0;
+
+    for( const wxString& log : logs )
+    {
+        PNS_LOG_FILE logFile;
+
+        if( !logFile.Load( wxFileName( log ), &NULL_REPORTER::GetInstance() ) )
+        {
+            std::cerr << "Failed to load log " << log.ToStdString() << std::endl;
+            logReports.push_back( { { "log", log.ToStdString() }, { "ok", false } } );
+            failures++;
+            continue;
+        }
+
+        double totalUs = 0.0;
+        size_t events = 0;
+
+        for( long run = 0; run < std::max( 1L, repeat ); run++ )
+        {
+            PNS_LOG_PLAYER player;
+
+            player.ReplayLog( &logFile, 0 );
+
+            for( const PNS_LOG_PLAYER::EVENT_STATS& evt : player.GetEventStats() )
+            {
+                ALGO_STATS& stats = algos[evt.m_algo];
+
+                stats.m_latencies.push_back( evt.m_microseconds );
+                stats.m_branches += evt.m_branches;
+                stats.m_collisionQueries += evt.m_collisionQueries;
+                totalUs += evt.m_microseconds;
+            }
+
+            events = player.GetEventStats().size();
+        }
+
+        logReports.push_back( { { "log", log.ToStdString() },
+                                { "ok", true },
+                                { "events", events },
+                                { "mean_replay_us", totalUs / std::max( 1L, repeat ) } } );
+    }
+
+    nlohmann::json algoReports = nlohmann::json::object();
+
+    for( auto& [name, stats] : algos )
+    {
+        std::vector<double>& lat = stats.m_latencies;
+        double               sum = 0.0;
+
+        std::sort( lat.begin(), lat.end() );
+
+        for( double us : lat )
+            sum += us;
+
+        algoReports[name.ToStdString()] = {
+            { "events", lat.size() },
+            { "mean_us", lat.empty() ? 0.0 : sum / lat.size() },
+            { "p50_us", percentile( lat, 0.50 ) },
+            { "p90_us", percentile( lat, 0.90 ) },
+            { "p99_us", percentile( lat, 0.99 ) },
+            { "max_us", lat.empty() ? 0.0 : lat.back() },
+            { "branches", stats.m_branches },
+            { "collision_queries", stats.m_collisionQueries }
+        };
+    }
+
+    nlohmann::json report = { { "repeat", std::max( 1L, repeat ) },
+                              { "logs", logReports },
+                              { "algorithms", algoReports } };
+
+    wxString output;
+
+    if( cl_parser.Found( "output", &output ) )
+    {
+        std::ofstream stream( output.fn_str() );
+        stream << report.dump( 2 ) << std::endl;
+    }
+    else
+    {
+        std::cout << report.dump( 2 ) << std::endl;
+    }
+
+    return failures ? KI_TEST::RET_CODES::TOOL_SPECIFIC : KI_TEST::RET_CODES::OK;
+}
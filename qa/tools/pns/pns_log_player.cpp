@@ -27,6 +27,9 @@
 
 #include <pcbnew_utils/board_test_utils.h>
 
+#include <core/profile.h>
+#include <router/pns_node.h>
+
 #define PNSLOGINFO PNS::DEBUG_DECORATOR::SRC_LOCATION_INFO( __FILE__, __FUNCTION__, __LINE__ )
 
 using namespace PNS;
@@ -94,6 +97,9 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
     createRouter();
 
     m_router->LoadSettings( aLog->GetRoutingSettings() );
+    m_router->SetMode( aLog->GetMode() );
+
+    m_eventStats.clear();
 
     int eventIdx = 0;
     int totalEvents = aLog->Events().size();
@@ -109,6 +115,11 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 
         eventIdx++;
 
+        wxString           algo = currentAlgo();
+        unsigned long long branches = NODE::s_branchCount.Count();
+        unsigned long long queries = NODE::s_collisionQueryCount.Count();
+        PROF_TIMER         timer;
+
         switch( evt.type )
         {
         case LOGGER::EVT_START_ROUTE:
@@ -157,7 +168,8 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
             m_debugDecorator->Message( wxString::Format( "fix (%d, %d)", evt.p.x, evt.p.y ) );
             bool rv = m_router->FixRoute( evt.p, ritem, false, false );
-            printf( "  fix -> (%d, %d) ret %d\n", evt.p.x, evt.p.y, rv ? 1 : 0 );
+            m_reporter->Report( wxString::Format( "  fix -> (%d, %d) ret %d", evt.p.x, evt.p.y,
+                                                  rv ? 1 : 0 ) );
             break;
         }
 
@@ -166,7 +178,7 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
             m_debugDecorator->NewStage( "unfix", 0, PNSLOGINFO );
             m_viewTracker->SetStage( m_debugDecorator->GetStageCount() - 1 );
             m_debugDecorator->Message( wxString::Format( "unfix (%d, %d)", evt.p.x, evt.p.y ) );
-            printf( "  unfix\n" );
+            m_reporter->Report( wxT( "  unfix" ) );
             m_router->UndoLastSegment();
             break;
         }
@@ -203,6 +215,16 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
         default: break;
         }
 
+        timer.Stop();
+
+        // Start events are accounted to the routing they start
+        if( m_router->RoutingInProgress() )
+            algo = currentAlgo();
+
+        m_eventStats.push_back( { evt.type, algo, timer.msecs() * 1000.0,
+                                  NODE::s_branchCount.Count() - branches,
+                                  NODE::s_collisionQueryCount.Count() - queries } );
+
         PNS::NODE* node = nullptr;
 
 #if 0
@@ -254,6 +276,42 @@ void PNS_LOG_PLAYER::ReplayLog( PNS_LOG_FILE* aLog, int aStartEventIndex, int aF
 }
 
 
+wxString PNS_LOG_PLAYER::currentAlgo() const
+{
+    switch( m_router->GetState() )
+    {
+    case ROUTER::DRAG_SEGMENT:
+    case ROUTER::DRAG_COMPONENT:
+        return wxT( "drag" );
+
+    default:
+        break;
+    }
+
+    switch( m_router->Mode() )
+    {
+    case PNS_MODE_ROUTE_DIFF_PAIR:
+        return wxT( "diff-pair" );
+
+    case PNS_MODE_TUNE_SINGLE:
+    case PNS_MODE_TUNE_DIFF_PAIR:
+    case PNS_MODE_TUNE_DIFF_PAIR_SKEW:
+        return wxT( "tuning" );
+
+    default:
+        break;
+    }
+
+    switch( m_router->Settings().Mode() )
+    {
+    case RM_Shove:         return wxT( "shove" );
+    case RM_Walkaround:    return wxT( "walkaround" );
+    case RM_MarkObstacles: return wxT( "mark-obstacles" );
+    default:               return wxT( "unknown" );
+    }
+}
+
+
 bool PNS_LOG_PLAYER::CompareResults( PNS_LOG_FILE* aLog )
 {
     auto cstate = GetRouterUpdatedItems();
@@ -29,6 +29,7 @@
 #include <router/pns_routing_settings.h>
 #include <router/pns_kicad_iface.h>
 #include <router/pns_router.h>
+#include <router/pns_logger.h>
 
 
 class PNS_TEST_DEBUG_DECORATOR;
@@ -83,6 +84,16 @@ private:
 class PNS_LOG_PLAYER
 {
 public:
+    ///< What replaying one event of a log cost
+    struct EVENT_STATS
+    {
+        PNS::LOGGER::EVENT_TYPE m_type;
+        wxString                m_algo;         ///< shove, walkaround, drag, diff-pair, ...
+        double                  m_microseconds;
+        unsigned long long      m_branches;
+        unsigned long long      m_collisionQueries;
+    };
+
     PNS_LOG_PLAYER();
     ~PNS_LOG_PLAYER();
 
@@ -98,9 +109,15 @@ public:
     bool CompareResults( PNS_LOG_FILE* aLog );
     const PNS_LOG_FILE::COMMIT_STATE GetRouterUpdatedItems();
 
+    ///< @return the cost of each event of the last ReplayLog()
+    const std::vector<EVENT_STATS>& GetEventStats() const { return m_eventStats; }
+
 private:
     void createRouter();
 
+    ///< @return the kind of routing going on in the router, as reported in the event stats
+    wxString currentAlgo() const;
+
     std::shared_ptr<PNS_LOG_VIEW_TRACKER> m_viewTracker;
     PNS_TEST_DEBUG_DECORATOR*             m_debugDecorator;
     std::shared_ptr<BOARD>                m_board;
@@ -108,6 +125,7 @@ private:
     std::unique_ptr<PNS::ROUTER>          m_router;
     uint64_t m_timeLimitUs;
     REPORTER* m_reporter;
+    std::vector<EVENT_STATS>              m_eventStats;
 };
 
 #endif
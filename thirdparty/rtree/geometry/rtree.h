@@ -60,6 +60,7 @@
 #include <iterator>
 #include <limits>
 #include <queue>
+#include <utility>
 #include <vector>
 
 #ifdef DEBUG
@@ -212,6 +213,12 @@ public:
     /// Remove all entries from tree
     void    RemoveAll();
 
+    /// Replace the contents of the tree with the given entries, packed into full nodes with
+    /// the Sort-Tile-Recursive algorithm.  This is much faster than inserting the entries one
+    /// by one, and the nodes overlap less.
+    /// \param a_entries Bounding rects and data of the entries
+    void    BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries );
+
     /// Count the data elements in this container.  This is slow as no internal counter is maintained.
     int     Count() const;
 
@@ -605,6 +612,7 @@ protected:
 
     void    RemoveAllRec( Node* a_node ) const;
     void    Reset() const;
+    void    TileBranches( Branch* a_begin, Branch* a_end, int a_axis ) const;
     void    CountRec( const Node* a_node, int& a_count ) const;
 
     bool    SaveRec( const Node* a_node, RTFileStream& a_stream ) const;
@@ -1126,6 +1134,93 @@ void RTREE_QUAL::RemoveAll()
 }
 
 
+RTREE_TEMPLATE
+void RTREE_QUAL::BulkLoad( const std::vector<std::pair<Rect, DATATYPE>>& a_entries )
+{
+    RemoveAll();
+
+    if( a_entries.empty() )
+        return;
+
+    std::vector<Branch> branches( a_entries.size() );
+
+    for( size_t index = 0; index < a_entries.size(); ++index )
+    {
+        branches[index].m_rect = a_entries[index].first;
+        branches[index].m_data = a_entries[index].second;
+    }
+
+    int level = 0;
+
+    // Pack each level into nodes, and the nodes into the next level, until they fit in the root
+    while( branches.size() > (size_t) MAXNODES )
+    {
+        TileBranches( branches.data(), branches.data() + branches.size(), 0 );
+
+        const size_t        count = branches.size();
+        std::vector<Branch> parents;
+
+        parents.reserve( ( count + MAXNODES - 1 ) / MAXNODES );
+
+        for( size_t first = 0; first < count; )
+        {
+            size_t last = std::min( first + MAXNODES, count );
+
+            // Split the last two nodes evenly rather than leaving the last one under-filled
+            if( last < count && count - last < (size_t) MINNODES )
+                last = first + ( count - first ) / 2;
+
+            Node* node = AllocNode();
+            node->m_level = level;
+
+            for( size_t index = first; index < last; ++index )
+                node->m_branch[node->m_count++] = branches[index];
+
+            Branch parent;
+            parent.m_rect = NodeCover( node );
+            parent.m_child = node;
+            parents.push_back( parent );
+
+            first = last;
+        }
+
+        branches.swap( parents );
+        ++level;
+    }
+
+    m_root->m_level = level;
+
+    for( const Branch& branch : branches )
+        m_root->m_branch[m_root->m_count++] = branch;
+}
+
+
+// Sort the branches by their center along a_axis, and recurse on the slabs of the remaining
+// axes so that branches which are near each other end up consecutive
+RTREE_TEMPLATE
+void RTREE_QUAL::TileBranches( Branch* a_begin, Branch* a_end, int a_axis ) const
+{
+    const size_t count = a_end - a_begin;
+
+    std::sort( a_begin, a_end,
+               [a_axis]( const Branch& a_lhs, const Branch& a_rhs )
+               {
+                   return (ELEMTYPEREAL) a_lhs.m_rect.m_min[a_axis] + a_lhs.m_rect.m_max[a_axis]
+                          < (ELEMTYPEREAL) a_rhs.m_rect.m_min[a_axis] + a_rhs.m_rect.m_max[a_axis];
+               } );
+
+    if( a_axis == NUMDIMS - 1 || count <= (size_t) MAXNODES )
+        return;
+
+    const double nodes = std::ceil( double( count ) / MAXNODES );
+    const double slabs = std::ceil( std::pow( nodes, 1.0 / ( NUMDIMS - a_axis ) ) );
+    const size_t slabSize = MAXNODES * (size_t) std::ceil( nodes / slabs );
+
+    for( size_t first = 0; first < count; first += slabSize )
+        TileBranches( a_begin + first, a_begin + std::min( first + slabSize, count ), a_axis + 1 );
+}
+
+
 RTREE_TEMPLATE
 void RTREE_QUAL::Reset() const
 {